@@ -8,6 +8,7 @@
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
 #include "Common/Thread.h"
+#include "Common/ThreadPolicy.h"
 
 AlsaSound::AlsaSound()
     : m_thread_status(ALSAThreadStatus::STOPPED), handle(nullptr),
@@ -46,6 +47,7 @@ bool AlsaSound::Init()
 void AlsaSound::SoundLoop()
 {
   Common::SetCurrentThreadName("Audio thread - alsa");
+  Common::SetCurrentThreadRole(Common::ThreadRole::Audio);
   while (m_thread_status.load() != ALSAThreadStatus::STOPPING)
   {
     while (m_thread_status.load() == ALSAThreadStatus::RUNNING)
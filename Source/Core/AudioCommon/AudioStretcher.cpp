@@ -8,6 +8,8 @@
 #include <cstddef>
 
 #include "Common/Logging/Log.h"
+#include "Common/Thread.h"
+#include "Common/ThreadPolicy.h"
 #include "Core/Config/MainSettings.h"
 
 namespace AudioCommon
@@ -18,14 +20,91 @@ AudioStretcher::AudioStretcher(unsigned int sample_rate) : m_sample_rate(sample_
   m_sound_touch.setSampleRate(sample_rate);
   m_sound_touch.setPitch(1.0);
   m_sound_touch.setTempo(1.0);
+  UpdateWindow();
+
+  m_thread = std::thread(&AudioStretcher::ThreadLoop, this);
+}
+
+AudioStretcher::~AudioStretcher()
+{
+  m_running.Clear();
+  m_wake_event.Set();
+  m_thread.join();
 }
 
 void AudioStretcher::Clear()
 {
-  m_sound_touch.clear();
+  m_output.Drop();
+  m_clear_requested.Set();
+  m_wake_event.Set();
 }
 
 void AudioStretcher::ProcessSamples(const short* in, unsigned int num_in, unsigned int num_out)
+{
+  const u32 pushed = m_input.Push(in, num_in);
+  if (pushed != num_in)
+    DEBUG_LOG_FMT(AUDIO, "Audio stretching: dropped {} samples", num_in - pushed);
+
+  m_requested_samples.fetch_add(num_out);
+  m_wake_event.Set();
+}
+
+void AudioStretcher::ThreadLoop()
+{
+  Common::SetCurrentThreadName("Audio Stretcher");
+  Common::SetCurrentThreadRole(Common::ThreadRole::Audio);
+
+  while (true)
+  {
+    m_wake_event.Wait();
+    if (!m_running.IsSet())
+      break;
+
+    if (m_clear_requested.TestAndClear())
+    {
+      m_sound_touch.clear();
+      m_input.Drop();
+    }
+
+    const u32 num_out = m_requested_samples.exchange(0);
+    const u32 num_in = m_input.Pop(m_work_buffer.data(), StereoRing::SIZE);
+    if (num_out != 0)
+      Stretch(m_work_buffer.data(), num_in, num_out);
+    else
+      m_sound_touch.putSamples(m_work_buffer.data(), num_in);
+
+    while (m_output.Free() != 0)
+    {
+      const u32 received = m_sound_touch.receiveSamples(m_work_buffer.data(), m_output.Free());
+      if (received == 0)
+        break;
+      m_output.Push(m_work_buffer.data(), received);
+    }
+  }
+}
+
+// The stretching window follows how far the emulation is from full speed. Short sequences keep
+// the added latency low near full speed, longer ones avoid audible artifacts during slowdowns.
+void AudioStretcher::UpdateWindow()
+{
+  constexpr int MIN_SEQUENCE_MS = 40;
+  constexpr int MAX_SEQUENCE_MS = 90;
+  constexpr int SEQUENCE_STEP_MS = 10;
+
+  const double deviation = std::min(std::abs(1.0 - m_stretch_ratio), 0.5);
+  const int sequence_ms =
+      MIN_SEQUENCE_MS + static_cast<int>(deviation * 2 * (MAX_SEQUENCE_MS - MIN_SEQUENCE_MS)) /
+                            SEQUENCE_STEP_MS * SEQUENCE_STEP_MS;
+  if (sequence_ms == m_sequence_ms)
+    return;
+
+  m_sequence_ms = sequence_ms;
+  m_sound_touch.setSetting(SETTING_SEQUENCE_MS, sequence_ms);
+  m_sound_touch.setSetting(SETTING_SEEKWINDOW_MS, 15 + (sequence_ms - MIN_SEQUENCE_MS) / 5);
+  m_sound_touch.setSetting(SETTING_OVERLAP_MS, 8);
+}
+
+void AudioStretcher::Stretch(const short* in, unsigned int num_in, unsigned int num_out)
 {
   const double time_delta = static_cast<double>(num_out) / m_sample_rate;  // seconds
 
@@ -34,7 +113,7 @@ void AudioStretcher::ProcessSamples(const short* in, unsigned int num_in, unsign
 
   const double max_latency = Config::Get(Config::MAIN_AUDIO_STRETCH_LATENCY);
   const double max_backlog = m_sample_rate * max_latency / 1000.0 / m_stretch_ratio;
-  const double backlog_fullness = m_sound_touch.numSamples() / max_backlog;
+  const double backlog_fullness = (m_sound_touch.numSamples() + m_output.Available()) / max_backlog;
   if (backlog_fullness > 5.0)
   {
     // Too many samples in backlog: Don't push anymore on
@@ -57,6 +136,7 @@ void AudioStretcher::ProcessSamples(const short* in, unsigned int num_in, unsign
   // many silence samples.  These do not need to be timestretched.
   m_stretch_ratio = std::max(m_stretch_ratio, 0.1);
   m_sound_touch.setTempo(m_stretch_ratio);
+  UpdateWindow();
 
   DEBUG_LOG_FMT(AUDIO, "Audio stretching: samples:{}/{} ratio:{} backlog:{} gain: {}", num_in,
                 num_out, m_stretch_ratio, backlog_fullness, lpf_gain);
@@ -66,7 +146,7 @@ void AudioStretcher::ProcessSamples(const short* in, unsigned int num_in, unsign
 
 void AudioStretcher::GetStretchedSamples(short* out, unsigned int num_out)
 {
-  const size_t samples_received = m_sound_touch.receiveSamples(out, num_out);
+  const size_t samples_received = m_output.Pop(out, num_out);
 
   if (samples_received != 0)
   {
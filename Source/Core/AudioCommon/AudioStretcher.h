@@ -4,24 +4,59 @@
 #pragma once
 
 #include <array>
+#include <atomic>
+#include <thread>
 
 #include <SoundTouch.h>
 
+#include "AudioCommon/SampleRing.h"
+#include "Common/CommonTypes.h"
+#include "Common/Event.h"
+#include "Common/Flag.h"
+
 namespace AudioCommon
 {
+// Time-stretches the mixed audio on its own thread, so that a slow SoundTouch pass can't make the
+// audio callback miss its deadline. The callback and the thread only share two lock-free rings.
 class AudioStretcher
 {
 public:
   explicit AudioStretcher(unsigned int sample_rate);
+  ~AudioStretcher();
+  AudioStretcher(const AudioStretcher&) = delete;
+  AudioStretcher& operator=(const AudioStretcher&) = delete;
+
+  // Called from the audio callback. num_in stereo samples were mixed while num_out are requested.
   void ProcessSamples(const short* in, unsigned int num_in, unsigned int num_out);
   void GetStretchedSamples(short* out, unsigned int num_out);
   void Clear();
 
 private:
+  using StereoRing = SampleRing<short, 2, 32768>;
+
+  void ThreadLoop();
+  void Stretch(const short* in, unsigned int num_in, unsigned int num_out);
+  void UpdateWindow();
+
   unsigned int m_sample_rate;
+
+  // Only accessed by the audio callback.
   std::array<short, 2> m_last_stretched_sample = {};
+
+  // Only accessed by the stretching thread.
   soundtouch::SoundTouch m_sound_touch;
   double m_stretch_ratio = 1.0;
+  int m_sequence_ms = 0;
+  std::array<short, StereoRing::SIZE * 2> m_work_buffer{};
+
+  StereoRing m_input;
+  StereoRing m_output;
+  std::atomic<u32> m_requested_samples{0};
+  Common::Flag m_clear_requested;
+
+  Common::Flag m_running{true};
+  Common::Event m_wake_event;
+  std::thread m_thread;
 };
 
 }  // namespace AudioCommon
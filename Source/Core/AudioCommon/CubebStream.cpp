@@ -19,6 +19,10 @@
 
 // ~10 ms - needs to be at least 240 for surround
 constexpr u32 BUFFER_SAMPLES = 512;
+// Used in low latency mode, the backend's minimum is still respected. Small enough for the
+// quanta PipeWire and JACK typically run at.
+constexpr u32 LOW_LATENCY_BUFFER_SAMPLES_STEREO = 128;
+constexpr u32 LOW_LATENCY_BUFFER_SAMPLES_SURROUND = 256;
 
 long CubebStream::DataCallback(cubeb_stream* stream, void* user_data, const void* /*input_buffer*/,
                                void* output_buffer, long num_frames)
@@ -91,10 +95,20 @@ bool CubebStream::Init()
         ERROR_LOG_FMT(AUDIO, "Error getting minimum latency");
       INFO_LOG_FMT(AUDIO, "Minimum latency: {} frames", minimum_latency);
 
-      return_value =
-          cubeb_stream_init(m_ctx.get(), &m_stream, "Dolphin Audio Output", nullptr, nullptr,
-                            nullptr, &params, std::max(BUFFER_SAMPLES, minimum_latency),
-                            DataCallback, StateCallback, this) == CUBEB_OK;
+      u32 buffer_samples = BUFFER_SAMPLES;
+      if (Config::Get(Config::MAIN_AUDIO_LOW_LATENCY))
+      {
+        buffer_samples =
+            m_stereo ? LOW_LATENCY_BUFFER_SAMPLES_STEREO : LOW_LATENCY_BUFFER_SAMPLES_SURROUND;
+      }
+
+      buffer_samples = std::max(buffer_samples, minimum_latency);
+      if (!m_stereo)
+        m_mixer->SetSurroundOutputPeriod(buffer_samples);
+
+      return_value = cubeb_stream_init(m_ctx.get(), &m_stream, "Dolphin Audio Output", nullptr,
+                                       nullptr, nullptr, &params, buffer_samples, DataCallback,
+                                       StateCallback, this) == CUBEB_OK;
     }
 
 #ifdef _WIN32
@@ -117,7 +131,17 @@ bool CubebStream::SetRunning(bool running)
     Common::ScopeGuard sync_event_guard([&sync_event] { sync_event.Set(); });
 #endif
     if (running)
+    {
       return_value = cubeb_stream_start(m_stream) == CUBEB_OK;
+
+      // Not queried from the data callback as some backends take a lock there
+      u32 latency = 0;
+      if (return_value && cubeb_stream_get_latency(m_stream, &latency) == CUBEB_OK)
+      {
+        INFO_LOG_FMT(AUDIO, "Output latency: {} frames", latency);
+        m_mixer->SetOutputLatency(latency);
+      }
+    }
     else
       return_value = cubeb_stream_stop(m_stream) == CUBEB_OK;
 #ifdef _WIN32
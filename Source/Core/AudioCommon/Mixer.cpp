@@ -4,6 +4,7 @@
 #include "AudioCommon/Mixer.h"
 
 #include <algorithm>
+#include <bit>
 #include <cmath>
 #include <cstring>
 
@@ -14,6 +15,7 @@
 #include "Common/Swap.h"
 #include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
+#include "VideoCommon/FrameTimeReport.h"
 #include "VideoCommon/PerformanceMetrics.h"
 
 static u32 DPL2QualityToFrameBlockSize(AudioCommon::DPL2Quality quality)
@@ -87,6 +89,22 @@ unsigned int Mixer::MixerFifo::Mix(short* samples, unsigned int numSamples,
     u32 low_watermark = (FIXED_SAMPLE_RATE_DIVIDEND * timing_variance) /
                         (static_cast<u64>(m_input_sample_rate_divisor) * 1000);
     low_watermark = std::min(low_watermark, MAX_SAMPLES / 2);
+    if (m_mixer->m_config_low_latency)
+    {
+      low_watermark = std::min(low_watermark, static_cast<u32>(m_low_latency_watermark));
+
+      const float usable = std::max(numLeft - GetLookahead(), 0.0f);
+      if (usable * m_mixer->m_sampleRate < numSamples * aid_sample_rate)
+      {
+        // Not enough input for this callback, aim for an extra millisecond of buffering.
+        m_low_latency_watermark =
+            std::min(m_low_latency_watermark + aid_sample_rate / 1000, MAX_SAMPLES / 2.0f);
+      }
+      else
+      {
+        m_low_latency_watermark *= LOW_LATENCY_WATERMARK_DECAY;
+      }
+    }
 
     m_numLeftI = (numLeft + m_numLeftI * (CONTROL_AVG - 1)) / CONTROL_AVG;
     float offset = (m_numLeftI - low_watermark) * CONTROL_FACTOR;
@@ -100,37 +118,72 @@ unsigned int Mixer::MixerFifo::Mix(short* samples, unsigned int numSamples,
 
   const u32 ratio = (u32)(65536.0f * aid_sample_rate / (float)m_mixer->m_sampleRate);
 
-  s32 lvolume = m_LVolume.load();
-  s32 rvolume = m_RVolume.load();
+  const s32 lvolume = m_LVolume.load();
+  const s32 rvolume = m_RVolume.load();
 
   const auto read_buffer = [this](auto index) {
     return m_little_endian ? m_buffer[index] : Common::swap16(m_buffer[index]);
   };
 
-  // TODO: consider a higher-quality resampling algorithm.
-  for (; currentSample < numSamples * 2 && ((indexW - indexR) & INDEX_MASK) > 2; currentSample += 2)
+  // Work out up front how many samples can be produced from the buffered input, so that the
+  // loops below don't carry the read position from one iteration to the next.
+  const u32 lookahead = GetLookahead();
+  const u32 available = ((indexW - indexR) & INDEX_MASK) / 2;
+  u32 count = 0;
+  if (available > lookahead)
   {
-    u32 indexR2 = indexR + 2;  // next sample
-
-    s16 l1 = read_buffer(indexR & INDEX_MASK);   // current
-    s16 l2 = read_buffer(indexR2 & INDEX_MASK);  // next
-    int sampleL = ((l1 << 16) + (l2 - l1) * (u16)m_frac) >> 16;
-    sampleL = (sampleL * lvolume) >> 8;
-    sampleL += samples[currentSample + 1];
-    samples[currentSample + 1] = std::clamp(sampleL, -32767, 32767);
-
-    s16 r1 = read_buffer((indexR + 1) & INDEX_MASK);   // current
-    s16 r2 = read_buffer((indexR2 + 1) & INDEX_MASK);  // next
-    int sampleR = ((r1 << 16) + (r2 - r1) * (u16)m_frac) >> 16;
-    sampleR = (sampleR * rvolume) >> 8;
-    sampleR += samples[currentSample];
-    samples[currentSample] = std::clamp(sampleR, -32767, 32767);
-
-    m_frac += ratio;
-    indexR += 2 * (u16)(m_frac >> 16);
-    m_frac &= 0xffff;
+    const u64 limit = u64(available - lookahead) << 16;
+    const u64 reachable = ratio == 0 ? numSamples : (limit - m_frac + ratio - 1) / ratio;
+    count = static_cast<u32>(std::min<u64>(numSamples, reachable));
   }
 
+  const auto mix_samples = [&](auto interpolate) {
+    for (u32 i = 0; i < count; i++)
+    {
+      const u64 position = m_frac + u64(i) * ratio;
+      const u32 index = indexR + 2 * static_cast<u32>(position >> 16);
+      const auto [sampleL, sampleR] = interpolate(index, static_cast<u32>(position) & 0xffff);
+
+      const int mixedL = ((sampleL * lvolume) >> 8) + samples[i * 2 + 1];
+      samples[i * 2 + 1] = std::clamp(mixedL, -32767, 32767);
+      const int mixedR = ((sampleR * rvolume) >> 8) + samples[i * 2];
+      samples[i * 2] = std::clamp(mixedR, -32767, 32767);
+    }
+  };
+
+  if (m_mixer->m_config_sinc_resampling)
+  {
+    UpdateSincKernel();
+    mix_samples([&](u32 index, u32 frac) {
+      const float* kernel = &m_sinc_kernel[(frac >> (16 - SINC_PHASE_BITS)) * SINC_TAPS];
+      const u32 first = index - 2 * (SINC_TAPS / 2 - 1);
+      float sampleL = 0.0f;
+      float sampleR = 0.0f;
+      for (u32 tap = 0; tap < SINC_TAPS; tap++)
+      {
+        sampleL += kernel[tap] * read_buffer((first + tap * 2) & INDEX_MASK);
+        sampleR += kernel[tap] * read_buffer((first + tap * 2 + 1) & INDEX_MASK);
+      }
+      return std::pair<int, int>(static_cast<int>(sampleL), static_cast<int>(sampleR));
+    });
+  }
+  else
+  {
+    mix_samples([&](u32 index, u32 frac) {
+      const s16 l1 = read_buffer(index & INDEX_MASK);        // current
+      const s16 l2 = read_buffer((index + 2) & INDEX_MASK);  // next
+      const s16 r1 = read_buffer((index + 1) & INDEX_MASK);  // current
+      const s16 r2 = read_buffer((index + 3) & INDEX_MASK);  // next
+      return std::pair<int, int>(((l1 << 16) + (l2 - l1) * static_cast<int>(frac)) >> 16,
+                                 ((r1 << 16) + (r2 - r1) * static_cast<int>(frac)) >> 16);
+    });
+  }
+
+  const u64 end_position = m_frac + u64(count) * ratio;
+  indexR += 2 * static_cast<u32>(end_position >> 16);
+  m_frac = static_cast<u32>(end_position) & 0xffff;
+  currentSample = count * 2;
+
   // Actual number of samples written to the buffer without padding.
   unsigned int actual_sample_count = currentSample / 2;
 
@@ -178,6 +231,7 @@ unsigned int Mixer::Mix(short* samples, unsigned int num_samples)
 
     m_scratch_buffer.fill(0);
 
+    CountUnderrun(available_samples == 0);
     m_dma_mixer.Mix(m_scratch_buffer.data(), available_samples, false, emulation_speed,
                     timing_variance);
     m_streaming_mixer.Mix(m_scratch_buffer.data(), available_samples, false, emulation_speed,
@@ -202,7 +256,9 @@ unsigned int Mixer::Mix(short* samples, unsigned int num_samples)
   }
   else
   {
-    m_dma_mixer.Mix(samples, num_samples, true, emulation_speed, timing_variance);
+    const unsigned int dma_samples =
+        m_dma_mixer.Mix(samples, num_samples, true, emulation_speed, timing_variance);
+    CountUnderrun(dma_samples < num_samples);
     m_streaming_mixer.Mix(samples, num_samples, true, emulation_speed, timing_variance);
     m_wiimote_speaker_mixer.Mix(samples, num_samples, true, emulation_speed, timing_variance);
     m_skylander_portal_mixer.Mix(samples, num_samples, true, emulation_speed, timing_variance);
@@ -214,6 +270,13 @@ unsigned int Mixer::Mix(short* samples, unsigned int num_samples)
   return num_samples;
 }
 
+void Mixer::CountUnderrun(bool starved)
+{
+  if (starved && !m_is_starved)
+    m_underrun_count.fetch_add(1, std::memory_order_relaxed);
+  m_is_starved = starved;
+}
+
 unsigned int Mixer::MixSurround(float* samples, unsigned int num_samples)
 {
   if (!num_samples)
@@ -253,7 +316,10 @@ void Mixer::MixerFifo::PushSamples(const short* samples, unsigned int num_sample
   // Check if we have enough free space
   // indexW == m_indexR results in empty buffer, so indexR must always be smaller than indexW
   if (num_samples * 2 + ((indexW - m_indexR.load()) & INDEX_MASK) >= MAX_SAMPLES * 2)
+  {
+    g_frame_time_report.FlagCause(StutterCause::AudioBackpressure);
     return;
+  }
 
   // AyuanX: Actual re-sampling work has been moved to sound thread
   // to alleviate the workload on main thread
@@ -458,6 +524,29 @@ void Mixer::RefreshConfig()
   m_config_emulation_speed = Config::Get(Config::MAIN_EMULATION_SPEED);
   m_config_timing_variance = Config::Get(Config::MAIN_TIMING_VARIANCE);
   m_config_audio_stretch = Config::Get(Config::MAIN_AUDIO_STRETCH);
+  m_config_sinc_resampling = Config::Get(Config::MAIN_AUDIO_SINC_RESAMPLING);
+  m_config_low_latency = Config::Get(Config::MAIN_AUDIO_LOW_LATENCY);
+}
+
+void Mixer::SetSurroundOutputPeriod(u32 num_frames)
+{
+  constexpr u32 MIN_SURROUND_BLOCK_SIZE = 512;
+
+  const u32 quality_block_size =
+      DPL2QualityToFrameBlockSize(Config::Get(Config::MAIN_DPL2_QUALITY));
+  u32 block_size = quality_block_size;
+  if (m_config_low_latency)
+  {
+    block_size =
+        std::clamp(std::bit_ceil(num_frames), MIN_SURROUND_BLOCK_SIZE, quality_block_size);
+  }
+  m_surround_decoder.SetFrameBlockSize(block_size);
+}
+
+double Mixer::GetLatencyMs() const
+{
+  const u32 queued = m_dma_mixer.AvailableSamples() + m_output_latency.load();
+  return queued * 1000.0 / m_sampleRate;
 }
 
 void Mixer::MixerFifo::DoState(PointerWrap& p)
@@ -488,11 +577,59 @@ std::pair<s32, s32> Mixer::MixerFifo::GetVolume() const
   return std::make_pair(m_LVolume.load(), m_RVolume.load());
 }
 
+u32 Mixer::MixerFifo::GetLookahead() const
+{
+  return m_mixer->m_config_sinc_resampling ? SINC_TAPS / 2 : 1;
+}
+
+void Mixer::MixerFifo::UpdateSincKernel()
+{
+  const unsigned int sample_rate = m_mixer->m_sampleRate;
+  if (m_sinc_kernel_divisor == m_input_sample_rate_divisor &&
+      m_sinc_kernel_sample_rate == sample_rate)
+  {
+    return;
+  }
+  m_sinc_kernel_divisor = m_input_sample_rate_divisor;
+  m_sinc_kernel_sample_rate = sample_rate;
+
+  // Filter out everything above the lower of the input and output Nyquist frequencies, with a
+  // little headroom for the transition band.
+  const double input_sample_rate =
+      static_cast<double>(FIXED_SAMPLE_RATE_DIVIDEND) / m_input_sample_rate_divisor;
+  const double cutoff = std::min(1.0, sample_rate / input_sample_rate) * 0.9;
+  constexpr double half_width = SINC_TAPS / 2;
+  constexpr double pi = 3.14159265358979323846;
+
+  m_sinc_kernel.resize(SINC_PHASES * SINC_TAPS);
+  for (u32 phase = 0; phase < SINC_PHASES; phase++)
+  {
+    float* kernel = &m_sinc_kernel[phase * SINC_TAPS];
+    const double offset = static_cast<double>(phase) / SINC_PHASES;
+    double sum = 0.0;
+    for (u32 tap = 0; tap < SINC_TAPS; tap++)
+    {
+      // Distance between the input sample and the output position, in input samples.
+      const double x = static_cast<double>(tap) - (SINC_TAPS / 2 - 1) - offset;
+      const double sinc = x == 0.0 ? 1.0 : std::sin(pi * cutoff * x) / (pi * cutoff * x);
+      const double window = 0.42 + 0.5 * std::cos(pi * x / half_width) +
+                            0.08 * std::cos(2.0 * pi * x / half_width);
+      kernel[tap] = static_cast<float>(sinc * window);
+      sum += kernel[tap];
+    }
+
+    // Normalize so that the filter doesn't change the volume.
+    for (u32 tap = 0; tap < SINC_TAPS; tap++)
+      kernel[tap] = static_cast<float>(kernel[tap] / sum);
+  }
+}
+
 unsigned int Mixer::MixerFifo::AvailableSamples() const
 {
+  const u32 lookahead = GetLookahead();
   unsigned int samples_in_fifo = ((m_indexW.load() - m_indexR.load()) & INDEX_MASK) / 2;
-  if (samples_in_fifo <= 1)
-    return 0;  // Mixer::MixerFifo::Mix always keeps one sample in the buffer.
-  return (samples_in_fifo - 1) * static_cast<u64>(m_mixer->m_sampleRate) *
+  if (samples_in_fifo <= lookahead)
+    return 0;  // Mixer::MixerFifo::Mix always keeps the lookahead samples in the buffer.
+  return (samples_in_fifo - lookahead) * static_cast<u64>(m_mixer->m_sampleRate) *
          m_input_sample_rate_divisor / FIXED_SAMPLE_RATE_DIVIDEND;
 }
@@ -5,6 +5,7 @@
 
 #include <array>
 #include <atomic>
+#include <vector>
 
 #include "AudioCommon/AudioStretcher.h"
 #include "AudioCommon/SurroundDecoder.h"
@@ -36,6 +37,20 @@ public:
 
   unsigned int GetSampleRate() const { return m_sampleRate; }
 
+  // Called by backends that can measure how many samples are queued after they have been mixed.
+  void SetOutputLatency(u32 num_samples) { m_output_latency.store(num_samples); }
+
+  // Estimated time it takes for a sample the DSP produced to be played.
+  double GetLatencyMs() const;
+
+  // How many times the DSP samples ran out while mixing. A run of starved mixes counts once.
+  u64 GetUnderrunCount() const { return m_underrun_count.load(std::memory_order_relaxed); }
+
+  // Lets surround output use a smaller DPL2 block in low latency mode, the configured quality
+  // stays the upper bound.
+  void SetSurroundOutputPeriod(u32 num_frames);
+  float GetSurroundDecoderLoad() const { return m_surround_decoder.GetDecodeLoad(); }
+
   void SetDMAInputSampleRateDivisor(unsigned int rate_divisor);
   void SetStreamInputSampleRateDivisor(unsigned int rate_divisor);
   void SetGBAInputSampleRateDivisors(int device_number, unsigned int rate_divisor);
@@ -59,6 +74,12 @@ private:
   static constexpr int MAX_FREQ_SHIFT = 200;  // Per 32000 Hz
   static constexpr float CONTROL_FACTOR = 0.2f;
   static constexpr u32 CONTROL_AVG = 32;  // In freq_shift per FIFO size offset
+  static constexpr float LOW_LATENCY_WATERMARK_DECAY = 0.999f;
+
+  // Windowed sinc resampler, each output sample is computed from SINC_TAPS input samples.
+  static constexpr u32 SINC_TAPS = 16;
+  static constexpr u32 SINC_PHASE_BITS = 8;
+  static constexpr u32 SINC_PHASES = 1 << SINC_PHASE_BITS;
 
   const unsigned int SURROUND_CHANNELS = 6;
 
@@ -81,6 +102,10 @@ private:
     unsigned int AvailableSamples() const;
 
   private:
+    // Number of input samples past the read position that have to be buffered before mixing.
+    u32 GetLookahead() const;
+    void UpdateSincKernel();
+
     Mixer* m_mixer;
     unsigned m_input_sample_rate_divisor;
     bool m_little_endian;
@@ -92,9 +117,19 @@ private:
     std::atomic<s32> m_RVolume{256};
     float m_numLeftI = 0.0f;
     u32 m_frac = 0;
+
+    // In low latency mode, the buffered amount the frame limiter aims for. It grows when the FIFO
+    // runs dry and slowly shrinks back while it doesn't, so it follows the emulation's jitter.
+    float m_low_latency_watermark = 0.0f;
+
+    // SINC_PHASES kernels of SINC_TAPS weights, with a cutoff depending on the sample rates.
+    std::vector<float> m_sinc_kernel;
+    unsigned int m_sinc_kernel_divisor = 0;
+    unsigned int m_sinc_kernel_sample_rate = 0;
   };
 
   void RefreshConfig();
+  void CountUnderrun(bool starved);
 
   MixerFifo m_dma_mixer{this, FIXED_SAMPLE_RATE_DIVIDEND / 32000, false};
   MixerFifo m_streaming_mixer{this, FIXED_SAMPLE_RATE_DIVIDEND / 48000, false};
@@ -120,6 +155,12 @@ private:
   float m_config_emulation_speed;
   int m_config_timing_variance;
   bool m_config_audio_stretch;
+  bool m_config_sinc_resampling;
+  bool m_config_low_latency;
+
+  std::atomic<u32> m_output_latency{0};
+  bool m_is_starved = false;
+  std::atomic<u64> m_underrun_count{0};
 
   Config::ConfigChangedCallbackID m_config_changed_callback_id;
 };
@@ -13,6 +13,7 @@
 #include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
 #include "Common/Thread.h"
+#include "Common/ThreadPolicy.h"
 #include "Core/Config/MainSettings.h"
 
 static HMODULE s_openal_dll = nullptr;
@@ -210,6 +211,7 @@ static bool IsCreativeXFi()
 void OpenALStream::SoundLoop()
 {
   Common::SetCurrentThreadName("Audio thread - openal");
+  Common::SetCurrentThreadRole(Common::ThreadRole::Audio);
 
   bool float32_capable = palIsExtensionPresent("AL_EXT_float32") != 0;
   bool surround_capable = palIsExtensionPresent("AL_EXT_MCFORMATS") || IsCreativeXFi();
@@ -9,6 +9,7 @@
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
 #include "Common/Thread.h"
+#include "Common/ThreadPolicy.h"
 #include "Core/Config/MainSettings.h"
 
 namespace
@@ -41,6 +42,7 @@ PulseAudio::~PulseAudio()
 void PulseAudio::SoundLoop()
 {
   Common::SetCurrentThreadName("Audio thread - pulse");
+  Common::SetCurrentThreadRole(Common::ThreadRole::Audio);
 
   if (PulseInit())
   {
@@ -0,0 +1,62 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+
+#include "Common/CommonTypes.h"
+
+namespace AudioCommon
+{
+// Lock-free ring of interleaved audio frames, written by one thread and read by another.
+template <typename T, u32 Channels, u32 Size>
+class SampleRing
+{
+  static_assert((Size & (Size - 1)) == 0, "Size must be a power of two");
+
+public:
+  static constexpr u32 SIZE = Size;
+
+  u32 Available() const
+  {
+    return (m_write.load(std::memory_order_acquire) - m_read.load(std::memory_order_acquire)) &
+           (Size - 1);
+  }
+  u32 Free() const { return Size - 1 - Available(); }
+
+  // Returns how many frames were written, which is less than requested when the ring is full.
+  u32 Push(const T* in, u32 num_frames)
+  {
+    num_frames = std::min(num_frames, Free());
+    const u32 write = m_write.load(std::memory_order_relaxed);
+    const u32 first = std::min(num_frames, Size - write);
+    std::copy_n(in, first * Channels, &m_buffer[write * Channels]);
+    std::copy_n(in + first * Channels, (num_frames - first) * Channels, m_buffer.data());
+    m_write.store((write + num_frames) & (Size - 1), std::memory_order_release);
+    return num_frames;
+  }
+
+  // Returns how many frames were read, which is less than requested when the ring runs dry.
+  u32 Pop(T* out, u32 num_frames)
+  {
+    num_frames = std::min(num_frames, Available());
+    const u32 read = m_read.load(std::memory_order_relaxed);
+    const u32 first = std::min(num_frames, Size - read);
+    std::copy_n(&m_buffer[read * Channels], first * Channels, out);
+    std::copy_n(m_buffer.data(), (num_frames - first) * Channels, out + first * Channels);
+    m_read.store((read + num_frames) & (Size - 1), std::memory_order_release);
+    return num_frames;
+  }
+
+  // Must be called from the reading thread.
+  void Drop() { m_read.store(m_write.load(std::memory_order_acquire)); }
+
+private:
+  std::array<T, Size * Channels> m_buffer{};
+  std::atomic<u32> m_read{0};
+  std::atomic<u32> m_write{0};
+};
+}  // namespace AudioCommon
@@ -4,89 +4,159 @@
 #include "AudioCommon/SurroundDecoder.h"
 
 #include <FreeSurround/FreeSurroundDecoder.h>
+#include <algorithm>
+#include <chrono>
 #include <limits>
 
+#include "Common/Logging/Log.h"
+#include "Common/Thread.h"
+#include "Common/ThreadPolicy.h"
+
 namespace AudioCommon
 {
 constexpr size_t STEREO_CHANNELS = 2;
 constexpr size_t SURROUND_CHANNELS = 6;
 
+// Weight of the latest block in the reported decoding load.
+constexpr float DECODE_LOAD_SMOOTHING = 0.05f;
+
 SurroundDecoder::SurroundDecoder(u32 sample_rate, u32 frame_block_size)
     : m_sample_rate(sample_rate), m_frame_block_size(frame_block_size)
 {
-  m_fsdecoder = std::make_unique<DPL2FSDecoder>();
-  m_fsdecoder->Init(cs_5point1, m_frame_block_size, m_sample_rate);
+  m_thread = std::thread(&SurroundDecoder::ThreadLoop, this);
 }
 
-SurroundDecoder::~SurroundDecoder() = default;
+SurroundDecoder::~SurroundDecoder()
+{
+  m_running.Clear();
+  m_wake_event.Set();
+  m_thread.join();
+}
 
 void SurroundDecoder::Clear()
 {
-  m_fsdecoder->flush();
-  m_decoded_fifo.clear();
+  m_decoded.Drop();
+  m_clear_requested.Set();
+  m_wake_event.Set();
+}
+
+void SurroundDecoder::SetFrameBlockSize(u32 frame_block_size)
+{
+  if (m_frame_block_size.exchange(frame_block_size) == frame_block_size)
+    return;
+
+  INFO_LOG_FMT(AUDIO, "DPL2 decoder block size set to {} frames", frame_block_size);
+  m_wake_event.Set();
 }
 
 // Currently only 6 channels are supported.
 size_t SurroundDecoder::QueryFramesNeededForSurroundOutput(const size_t output_frames) const
 {
-  if (m_decoded_fifo.size() < output_frames * SURROUND_CHANNELS)
+  // Frames are decoded while the previous period plays, so there must be enough for this request
+  // and the next one, counting the frames that are still waiting to be decoded.
+  const size_t buffered = m_decoded.Available() + m_input.Available() + m_frames_in_flight.load();
+  const size_t target = output_frames * 2;
+  if (buffered < target)
   {
     // Output stereo frames needed to have at least the desired number of surround frames
-    size_t frames_needed = output_frames - m_decoded_fifo.size() / SURROUND_CHANNELS;
-    return frames_needed + m_frame_block_size - frames_needed % m_frame_block_size;
+    const u32 block_size = m_frame_block_size.load();
+    size_t frames_needed = target - buffered;
+    return frames_needed + block_size - frames_needed % block_size;
   }
 
   return 0;
 }
 
-// Receive and decode samples
+// Queue samples for the decoding thread
 void SurroundDecoder::PutFrames(const short* in, const size_t num_frames_in)
 {
-  // Maybe check if it is really power-of-2?
-  s64 remaining_frames = static_cast<s64>(num_frames_in);
-  size_t frame_index = 0;
+  const u32 pushed = m_input.Push(in, static_cast<u32>(num_frames_in));
+  if (pushed != num_frames_in)
+    WARN_LOG_FMT(AUDIO, "DPL2 decoder input overflow, dropped {} frames", num_frames_in - pushed);
+
+  m_wake_event.Set();
+}
+
+void SurroundDecoder::ReceiveFrames(float* out, const size_t num_frames_out)
+{
+  // Copy to output array with desired num_frames_out, the rest stays silent if decoding hasn't
+  // caught up.
+  const u32 received = m_decoded.Pop(out, static_cast<u32>(num_frames_out));
+  std::fill(out + received * SURROUND_CHANNELS, out + num_frames_out * SURROUND_CHANNELS, 0.0f);
+}
+
+void SurroundDecoder::ThreadLoop()
+{
+  Common::SetCurrentThreadName("DPL2 Decoder");
+  Common::SetCurrentThreadRole(Common::ThreadRole::Audio);
 
-  while (remaining_frames > 0)
+  while (true)
   {
-    // Convert to float
-    for (size_t i = 0, end = m_frame_block_size * STEREO_CHANNELS; i < end; ++i)
+    m_wake_event.Wait();
+    if (!m_running.IsSet())
+      break;
+
+    const u32 block_size = m_frame_block_size.load();
+    if (block_size != m_decoder_block_size)
     {
-      m_float_conversion_buffer[i] = in[i + frame_index * STEREO_CHANNELS] /
-                                     static_cast<float>(std::numeric_limits<short>::max());
+      // FreeSurround can't be initialized again with a different block size
+      if (m_fsdecoder)
+        m_input.Drop();
+      m_fsdecoder = std::make_unique<DPL2FSDecoder>();
+      m_fsdecoder->Init(cs_5point1, block_size, m_sample_rate);
+      m_decoder_block_size = block_size;
     }
-
-    // Decode
-    const float* dpl2_fs = m_fsdecoder->decode(m_float_conversion_buffer.data());
-
-    // Add to ring buffer and fix channel mapping
-    // Maybe modify FreeSurround to output the correct mapping?
-    // FreeSurround:
-    // FL | FC | FR | BL | BR | LFE
-    // Most backends:
-    // FL | FR | FC | LFE | BL | BR
-    for (size_t i = 0; i < m_frame_block_size; ++i)
+    else if (m_clear_requested.TestAndClear())
     {
-      m_decoded_fifo.push(dpl2_fs[i * SURROUND_CHANNELS + 0]);  // LEFTFRONT
-      m_decoded_fifo.push(dpl2_fs[i * SURROUND_CHANNELS + 2]);  // RIGHTFRONT
-      m_decoded_fifo.push(dpl2_fs[i * SURROUND_CHANNELS + 1]);  // CENTREFRONT
-      m_decoded_fifo.push(dpl2_fs[i * SURROUND_CHANNELS + 5]);  // sub/lfe
-      m_decoded_fifo.push(dpl2_fs[i * SURROUND_CHANNELS + 3]);  // LEFTREAR
-      m_decoded_fifo.push(dpl2_fs[i * SURROUND_CHANNELS + 4]);  // RIGHTREAR
+      m_fsdecoder->flush();
+      m_input.Drop();
     }
 
-    remaining_frames = remaining_frames - static_cast<int>(m_frame_block_size);
-    frame_index = frame_index + m_frame_block_size;
+    while (m_input.Available() >= block_size)
+    {
+      m_frames_in_flight.store(block_size);
+      m_input.Pop(m_input_block_buffer.data(), block_size);
+      DecodeBlock(m_input_block_buffer.data());
+      m_frames_in_flight.store(0);
+    }
   }
 }
 
-void SurroundDecoder::ReceiveFrames(float* out, const size_t num_frames_out)
+void SurroundDecoder::DecodeBlock(const short* in)
 {
-  // Copy to output array with desired num_frames_out
-  for (size_t i = 0, num_samples_output = num_frames_out * SURROUND_CHANNELS;
-       i < num_samples_output; ++i)
+  const auto start_time = std::chrono::steady_clock::now();
+
+  // Convert to float
+  for (size_t i = 0, end = m_decoder_block_size * STEREO_CHANNELS; i < end; ++i)
   {
-    out[i] = m_decoded_fifo.pop_front();
+    m_float_conversion_buffer[i] = in[i] / static_cast<float>(std::numeric_limits<short>::max());
   }
+
+  // Decode
+  const float* dpl2_fs = m_fsdecoder->decode(m_float_conversion_buffer.data());
+
+  // Fix channel mapping
+  // Maybe modify FreeSurround to output the correct mapping?
+  // FreeSurround:
+  // FL | FC | FR | BL | BR | LFE
+  // Most backends:
+  // FL | FR | FC | LFE | BL | BR
+  for (size_t i = 0; i < m_decoder_block_size; ++i)
+  {
+    float* out = &m_output_block_buffer[i * SURROUND_CHANNELS];
+    out[0] = dpl2_fs[i * SURROUND_CHANNELS + 0];  // LEFTFRONT
+    out[1] = dpl2_fs[i * SURROUND_CHANNELS + 2];  // RIGHTFRONT
+    out[2] = dpl2_fs[i * SURROUND_CHANNELS + 1];  // CENTREFRONT
+    out[3] = dpl2_fs[i * SURROUND_CHANNELS + 5];  // sub/lfe
+    out[4] = dpl2_fs[i * SURROUND_CHANNELS + 3];  // LEFTREAR
+    out[5] = dpl2_fs[i * SURROUND_CHANNELS + 4];  // RIGHTREAR
+  }
+  m_decoded.Push(m_output_block_buffer.data(), m_decoder_block_size);
+
+  const std::chrono::duration<float> decode_time = std::chrono::steady_clock::now() - start_time;
+  const float block_duration = static_cast<float>(m_decoder_block_size) / m_sample_rate;
+  const float load = m_decode_load.load();
+  m_decode_load.store(load + DECODE_LOAD_SMOOTHING * (decode_time.count() / block_duration - load));
 }
 
 }  // namespace AudioCommon
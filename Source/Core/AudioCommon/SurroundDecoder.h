@@ -4,32 +4,66 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 #include <memory>
+#include <thread>
 
+#include "AudioCommon/SampleRing.h"
 #include "Common/CommonTypes.h"
-#include "Common/FixedSizeQueue.h"
+#include "Common/Event.h"
+#include "Common/Flag.h"
 
 class DPL2FSDecoder;
 
 namespace AudioCommon
 {
+// Decodes DPL2 on its own thread. The audio callback hands over stereo frames one period ahead
+// of when their decoded surround frames are needed, so the FFT never runs on the callback.
 class SurroundDecoder
 {
 public:
   explicit SurroundDecoder(u32 sample_rate, u32 frame_block_size);
   ~SurroundDecoder();
+  SurroundDecoder(const SurroundDecoder&) = delete;
+  SurroundDecoder& operator=(const SurroundDecoder&) = delete;
+
   size_t QueryFramesNeededForSurroundOutput(const size_t output_frames) const;
   void PutFrames(const short* in, const size_t num_frames_in);
   void ReceiveFrames(float* out, const size_t num_frames_out);
   void Clear();
 
+  // Takes effect on the decoding thread, the frames that haven't been decoded yet are dropped.
+  void SetFrameBlockSize(u32 frame_block_size);
+
+  // Fraction of the decoded audio's duration spent decoding it.
+  float GetDecodeLoad() const { return m_decode_load.load(); }
+
 private:
+  using StereoRing = SampleRing<short, 2, 16384>;
+  using SurroundRing = SampleRing<float, 6, 16384>;
+
+  void ThreadLoop();
+  void DecodeBlock(const short* in);
+
   u32 m_sample_rate;
-  u32 m_frame_block_size;
+  std::atomic<u32> m_frame_block_size;
 
+  // Only accessed by the decoding thread.
   std::unique_ptr<DPL2FSDecoder> m_fsdecoder;
-  std::array<float, 32768> m_float_conversion_buffer;
-  Common::FixedSizeQueue<float, 32768> m_decoded_fifo;
+  u32 m_decoder_block_size = 0;
+  std::array<short, 4096 * 2> m_input_block_buffer;
+  std::array<float, 4096 * 2> m_float_conversion_buffer;
+  std::array<float, 4096 * 6> m_output_block_buffer;
+
+  StereoRing m_input;
+  SurroundRing m_decoded;
+  std::atomic<u32> m_frames_in_flight{0};
+  std::atomic<float> m_decode_load{0.0f};
+  Common::Flag m_clear_requested;
+
+  Common::Flag m_running{true};
+  Common::Event m_wake_event;
+  std::thread m_thread;
 };
 
 }  // namespace AudioCommon
@@ -20,6 +20,7 @@
 #include "Common/Logging/Log.h"
 #include "Common/StringUtil.h"
 #include "Common/Thread.h"
+#include "Common/ThreadPolicy.h"
 #include "Core/Config/MainSettings.h"
 #include "VideoCommon/OnScreenDisplay.h"
 
@@ -220,9 +221,13 @@ bool WASAPIStream::SetRunning(bool running)
 
     REFERENCE_TIME device_period = 0;
 
+    // Queries the minimum period. Low latency mode runs at it instead of padding it with the
+    // configured latency.
     result = audio_client->GetDevicePeriod(nullptr, &device_period);
 
-    device_period += Config::Get(Config::MAIN_AUDIO_LATENCY) * (10000 / m_format.Format.nChannels);
+    const int extra_latency =
+        Config::Get(Config::MAIN_AUDIO_LOW_LATENCY) ? 0 : Config::Get(Config::MAIN_AUDIO_LATENCY);
+    device_period += extra_latency * (10000 / m_format.Format.nChannels);
     INFO_LOG_FMT(AUDIO, "Audio period set to {}", device_period);
 
     if (!HandleWinAPI("Failed to obtain device period", result))
@@ -258,7 +263,7 @@ bool WASAPIStream::SetRunning(bool running)
       device_period =
           static_cast<REFERENCE_TIME>(
               10000.0 * 1000 * m_frames_in_buffer / m_format.Format.nSamplesPerSec + 0.5) +
-          Config::Get(Config::MAIN_AUDIO_LATENCY) * 10000;
+          extra_latency * 10000;
 
       result = audio_client->Initialize(
           AUDCLNT_SHAREMODE_EXCLUSIVE,
@@ -274,6 +279,14 @@ bool WASAPIStream::SetRunning(bool running)
     if (!HandleWinAPI("Failed to get buffer size from IAudioClient", result))
       return false;
 
+    REFERENCE_TIME stream_latency = 0;
+    if (SUCCEEDED(audio_client->GetStreamLatency(&stream_latency)))
+    {
+      const u64 latency_frames = static_cast<u64>(stream_latency) *
+                                 m_format.Format.nSamplesPerSec / (10000 * 1000);
+      m_mixer->SetOutputLatency(m_frames_in_buffer + static_cast<u32>(latency_frames));
+    }
+
     ComPtr<IAudioRenderClient> audio_renderer;
 
     result = audio_client->GetService(IID_PPV_ARGS(audio_renderer.GetAddressOf()));
@@ -319,6 +332,7 @@ bool WASAPIStream::SetRunning(bool running)
 void WASAPIStream::SoundLoop()
 {
   Common::SetCurrentThreadName("WASAPI Handler");
+  Common::SetCurrentThreadRole(Common::ThreadRole::Audio);
   BYTE* data;
 
   m_audio_renderer->GetBuffer(m_frames_in_buffer, &data);
@@ -68,6 +68,7 @@
 #define LOAD_DIR "Load"
 #define HIRES_TEXTURES_DIR "Textures"
 #define RIIVOLUTION_DIR "Riivolution"
+#define PIPELINE_MANIFESTS_DIR "PipelineManifests"
 #define DUMP_DIR "Dump"
 #define DUMP_TEXTURES_DIR "Textures"
 #define DUMP_FRAMES_DIR "Frames"
@@ -132,6 +133,7 @@
 // Files in the directory returned by GetUserPath(D_MEMORYWATCHER_IDX)
 #define MEMORYWATCHER_LOCATIONS "Locations.txt"
 #define MEMORYWATCHER_SOCKET "MemoryWatcher"
+#define MEMORYWATCHER_RING "MemoryWatcher.ring"
 
 // Sys files
 #define TOTALDB "totaldb.dsy"
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <mutex>
 #include <shared_mutex>
 #include <string>
@@ -19,6 +20,17 @@ namespace detail
 // std::underlying_type may only be used with enum types, so make sure T is an enum type first.
 template <typename T>
 using UnderlyingType = typename std::enable_if_t<std::is_enum<T>{}, std::underlying_type<T>>::type;
+
+// std::atomic may only be instantiated with trivially copyable types, so check that first.
+template <typename T, typename = void>
+struct HasLockFreeAtomic : std::false_type
+{
+};
+template <typename T>
+struct HasLockFreeAtomic<T, std::enable_if_t<std::is_trivially_copyable_v<T>>>
+    : std::bool_constant<std::atomic<T>::is_always_lock_free>
+{
+};
 }  // namespace detail
 
 struct Location
@@ -39,12 +51,92 @@ struct CachedValue
   u64 config_version;
 };
 
+namespace detail
+{
+template <typename T>
+class LockedCachedValue
+{
+public:
+  LockedCachedValue() = default;
+  constexpr explicit LockedCachedValue(const CachedValue<T>& cached_value)
+      : m_cached_value{cached_value}
+  {
+  }
+
+  CachedValue<T> Load() const
+  {
+    std::shared_lock lock(m_mutex);
+    return m_cached_value;
+  }
+
+  void Store(const CachedValue<T>& cached_value)
+  {
+    std::unique_lock lock(m_mutex);
+    if (m_cached_value.config_version < cached_value.config_version)
+      m_cached_value = cached_value;
+  }
+
+  // Not thread-safe
+  void Reset(const CachedValue<T>& cached_value) { m_cached_value = cached_value; }
+
+private:
+  CachedValue<T> m_cached_value{};
+  mutable std::shared_mutex m_mutex;
+};
+
+// Lets readers of small settings, which are most of the hot ones, get away with two atomic loads.
+// The value is stored before the version it belongs to is published, so a reader that sees a
+// version gets that version's value or a newer one.
+template <typename T>
+class AtomicCachedValue
+{
+public:
+  AtomicCachedValue() = default;
+  constexpr explicit AtomicCachedValue(const CachedValue<T>& cached_value)
+      : m_value{cached_value.value}, m_config_version{cached_value.config_version}
+  {
+  }
+
+  CachedValue<T> Load() const
+  {
+    const u64 config_version = m_config_version.load(std::memory_order_acquire);
+    return CachedValue<T>{m_value.load(std::memory_order_relaxed), config_version};
+  }
+
+  void Store(const CachedValue<T>& cached_value)
+  {
+    std::lock_guard lock(m_store_mutex);
+    if (m_config_version.load(std::memory_order_relaxed) < cached_value.config_version)
+    {
+      m_value.store(cached_value.value, std::memory_order_relaxed);
+      m_config_version.store(cached_value.config_version, std::memory_order_release);
+    }
+  }
+
+  // Not thread-safe
+  void Reset(const CachedValue<T>& cached_value)
+  {
+    m_value.store(cached_value.value, std::memory_order_relaxed);
+    m_config_version.store(cached_value.config_version, std::memory_order_release);
+  }
+
+private:
+  std::atomic<T> m_value{};
+  std::atomic<u64> m_config_version{0};
+  std::mutex m_store_mutex;
+};
+
+template <typename T>
+using CachedValueStorage = std::conditional_t<HasLockFreeAtomic<T>::value, AtomicCachedValue<T>,
+                                              LockedCachedValue<T>>;
+}  // namespace detail
+
 template <typename T>
 class Info
 {
 public:
   constexpr Info(const Location& location, const T& default_value)
-      : m_location{location}, m_default_value{default_value}, m_cached_value{default_value, 0}
+      : m_location{location}, m_default_value{default_value}, m_cached_value{CachedValue<T>{default_value, 0}}
   {
   }
 
@@ -66,7 +158,7 @@ public:
   {
     m_location = other.GetLocation();
     m_default_value = other.GetDefaultValue();
-    m_cached_value = other.GetCachedValue();
+    m_cached_value.Reset(other.GetCachedValue());
     return *this;
   }
 
@@ -75,7 +167,7 @@ public:
   {
     m_location = std::move(other.m_location);
     m_default_value = std::move(other.m_default_value);
-    m_cached_value = std::move(other.m_cached_value);
+    m_cached_value.Reset(other.GetCachedValue());
     return *this;
   }
 
@@ -87,38 +179,31 @@ public:
   {
     m_location = other.GetLocation();
     m_default_value = static_cast<T>(other.GetDefaultValue());
-    m_cached_value = other.template GetCachedValueCasted<T>();
+    m_cached_value.Reset(other.template GetCachedValueCasted<T>());
     return *this;
   }
 
   constexpr const Location& GetLocation() const { return m_location; }
   constexpr const T& GetDefaultValue() const { return m_default_value; }
 
-  CachedValue<T> GetCachedValue() const
-  {
-    std::shared_lock lock(m_cached_value_mutex);
-    return m_cached_value;
-  }
+  CachedValue<T> GetCachedValue() const { return m_cached_value.Load(); }
 
   template <typename U>
   CachedValue<U> GetCachedValueCasted() const
   {
-    std::shared_lock lock(m_cached_value_mutex);
-    return CachedValue<U>{static_cast<U>(m_cached_value.value), m_cached_value.config_version};
+    const CachedValue<T> cached_value = m_cached_value.Load();
+    return CachedValue<U>{static_cast<U>(cached_value.value), cached_value.config_version};
   }
 
   void SetCachedValue(const CachedValue<T>& cached_value) const
   {
-    std::unique_lock lock(m_cached_value_mutex);
-    if (m_cached_value.config_version < cached_value.config_version)
-      m_cached_value = cached_value;
+    m_cached_value.Store(cached_value);
   }
 
 private:
   Location m_location;
   T m_default_value;
 
-  mutable CachedValue<T> m_cached_value;
-  mutable std::shared_mutex m_cached_value_mutex;
+  mutable detail::CachedValueStorage<T> m_cached_value;
 };
 }  // namespace Config
@@ -3,7 +3,9 @@
 
 #include "SHA1.h"
 
+#include <algorithm>
 #include <array>
+#include <iterator>
 #include <memory>
 
 #include <mbedtls/sha1.h>
@@ -53,6 +55,24 @@ public:
   }
   virtual bool HwAccelerated() const override { return false; }
 
+  virtual State GetState() const override
+  {
+    State state;
+    std::copy(std::begin(ctx.state), std::end(ctx.state), state.h.begin());
+    std::copy(std::begin(ctx.buffer), std::end(ctx.buffer), state.block.begin());
+    state.msg_len = (u64(ctx.total[1]) << 32) | ctx.total[0];
+    state.block_used = state.msg_len % state.block.size();
+    return state;
+  }
+
+  virtual void SetState(const State& state) override
+  {
+    std::copy(state.h.begin(), state.h.end(), std::begin(ctx.state));
+    std::copy(state.block.begin(), state.block.end(), std::begin(ctx.buffer));
+    ctx.total[0] = static_cast<u32>(state.msg_len);
+    ctx.total[1] = static_cast<u32>(state.msg_len >> 32);
+  }
+
 private:
   mbedtls_sha1_context ctx{};
 };
@@ -66,6 +86,18 @@ protected:
 
   virtual void ProcessBlock(const u8* msg) = 0;
   virtual Digest GetDigest() = 0;
+  virtual std::array<u32, 5> GetH() const = 0;
+  virtual void SetH(const std::array<u32, 5>& h) = 0;
+
+  virtual State GetState() const override { return {GetH(), block, block_used, msg_len}; }
+
+  virtual void SetState(const State& state) override
+  {
+    SetH(state.h);
+    block = state.block;
+    block_used = static_cast<size_t>(state.block_used);
+    msg_len = static_cast<size_t>(state.msg_len);
+  }
 
   virtual void Update(const u8* msg, size_t len) override
   {
@@ -255,6 +287,22 @@ private:
     return digest;
   }
 
+  virtual std::array<u32, 5> GetH() const override
+  {
+    // The registers hold the words in reverse order, with e in the highest lane
+    alignas(16) std::array<u32, 4> abcd;
+    alignas(16) std::array<u32, 4> e;
+    _mm_store_si128(reinterpret_cast<__m128i*>(abcd.data()), state[0]);
+    _mm_store_si128(reinterpret_cast<__m128i*>(e.data()), state[1]);
+    return {abcd[3], abcd[2], abcd[1], abcd[0], e[3]};
+  }
+
+  virtual void SetH(const std::array<u32, 5>& h) override
+  {
+    state[0] = _mm_set_epi32(h[0], h[1], h[2], h[3]);
+    state[1] = _mm_set_epi32(h[4], 0, 0, 0);
+  }
+
   virtual bool HwAccelerated() const override { return true; }
 
   std::array<XmmReg, 2> state{};
@@ -355,6 +403,20 @@ private:
     return digest;
   }
 
+  virtual std::array<u32, 5> GetH() const override
+  {
+    std::array<u32, 5> h;
+    vst1q_u32(h.data(), state.abcd);
+    h[4] = state.e;
+    return h;
+  }
+
+  virtual void SetH(const std::array<u32, 5>& h) override
+  {
+    state.abcd = vld1q_u32(h.data());
+    state.e = h[4];
+  }
+
   virtual bool HwAccelerated() const override { return true; }
 
   State state;
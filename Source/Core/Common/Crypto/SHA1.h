@@ -18,6 +18,16 @@ namespace Common::SHA1
 using Digest = std::array<u8, 160 / 8>;
 static constexpr size_t DIGEST_LEN = sizeof(Digest);
 
+// The intermediate state of a calculation. It's the same for all implementations,
+// so a calculation can be saved and resumed later, even on a different CPU.
+struct State
+{
+  std::array<u32, 5> h;
+  std::array<u8, 64> block;
+  u64 block_used;
+  u64 msg_len;
+};
+
 class Context
 {
 public:
@@ -26,6 +36,9 @@ public:
   void Update(const std::vector<u8>& msg) { return Update(msg.data(), msg.size()); }
   virtual Digest Finish() = 0;
   virtual bool HwAccelerated() const = 0;
+
+  virtual State GetState() const = 0;
+  virtual void SetState(const State& state) = 0;
 };
 
 std::unique_ptr<Context> CreateContext();
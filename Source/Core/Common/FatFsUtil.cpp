@@ -6,6 +6,7 @@
 #include <algorithm>
 #include <cmath>
 #include <cstdlib>
+#include <future>
 #include <mutex>
 #include <string>
 #include <string_view>
@@ -25,6 +26,7 @@
 #include "Common/Logging/Log.h"
 #include "Common/ScopeGuard.h"
 #include "Common/StringUtil.h"
+#include "Common/Thread.h"
 
 #include "Core/Config/MainSettings.h"
 
@@ -36,6 +38,7 @@ enum : u32
 
 static std::mutex s_fatfs_mutex;
 static Common::FatFsCallbacks* s_callbacks;
+static std::shared_future<bool> s_folder_to_image_sync;
 
 namespace
 {
@@ -606,6 +609,21 @@ bool SyncSDFolderToSDImage(const std::function<bool()>& cancelled, bool determin
   return true;
 }
 
+void StartSDFolderToSDImageSync(bool deterministic)
+{
+  s_folder_to_image_sync = std::async(std::launch::async, [deterministic] {
+                             Common::SetCurrentThreadName("SD Card Sync");
+                             return SyncSDFolderToSDImage([] { return false; }, deterministic);
+                           }).share();
+}
+
+bool WaitForSDFolderToSDImageSync()
+{
+  if (!s_folder_to_image_sync.valid())
+    return true;
+  return s_folder_to_image_sync.get();
+}
+
 static bool Unpack(const std::function<bool()>& cancelled, const std::string path,
                    bool is_directory, const char* name, std::vector<u8>& tmp_buffer)
 {
@@ -12,6 +12,12 @@ namespace Common
 bool SyncSDFolderToSDImage(const std::function<bool()>& cancelled, bool deterministic);
 bool SyncSDImageToSDFolder(const std::function<bool()>& cancelled);
 
+// Runs SyncSDFolderToSDImage on its own thread, so that booting doesn't wait for it. The SD image
+// must not be opened before WaitForSDFolderToSDImageSync has returned.
+void StartSDFolderToSDImageSync(bool deterministic);
+// Returns the result of the last started sync, or true if none was started.
+bool WaitForSDFolderToSDImageSync();
+
 class FatFsCallbacks
 {
 public:
@@ -846,6 +846,11 @@ PFNDOLSAMPLERPARAMETERFVPROC dolSamplerParameterfv;
 PFNDOLSAMPLERPARAMETERIPROC dolSamplerParameteri;
 PFNDOLSAMPLERPARAMETERIVPROC dolSamplerParameteriv;
 
+// ARB_timer_query
+PFNDOLQUERYCOUNTERPROC dolQueryCounter;
+PFNDOLGETQUERYOBJECTI64VPROC dolGetQueryObjecti64v;
+PFNDOLGETQUERYOBJECTUI64VPROC dolGetQueryObjectui64v;
+
 // ARB_map_buffer_range
 PFNDOLFLUSHMAPPEDBUFFERRANGEPROC dolFlushMappedBufferRange;
 PFNDOLMAPBUFFERRANGEPROC dolMapBufferRange;
@@ -1904,6 +1909,11 @@ const GLFunc gl_function_array[] = {
     GLFUNC_REQUIRES(glGenVertexArrays, "GL_ARB_vertex_array_object |VERSION_GLES_3"),
     GLFUNC_REQUIRES(glIsVertexArray, "GL_ARB_vertex_array_object |VERSION_GLES_3"),
 
+    // ARB_timer_query
+    GLFUNC_REQUIRES(glQueryCounter, "GL_ARB_timer_query"),
+    GLFUNC_REQUIRES(glGetQueryObjecti64v, "GL_ARB_timer_query"),
+    GLFUNC_REQUIRES(glGetQueryObjectui64v, "GL_ARB_timer_query"),
+
     // APPLE_vertex_array_object
     GLFUNC_SUFFIX(glBindVertexArray, APPLE,
                   "GL_APPLE_vertex_array_object !GL_ARB_vertex_array_object"),
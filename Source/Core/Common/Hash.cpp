@@ -4,9 +4,12 @@
 #include "Common/Hash.h"
 
 #include <algorithm>
+#include <array>
 #include <bit>
 #include <cstring>
 
+#define XXH_STATIC_LINKING_ONLY
+#include <xxhash.h>
 #include <zlib.h>
 
 #include "Common/BitUtils.h"
@@ -401,13 +404,49 @@ static u64 GetHash64_ARMv8_CRC32(const u8* src, u32 len, u32 samples)
 
 #endif
 
+static u64 GetHash64_XXH3(const u8* src, u32 len, u32 samples)
+{
+  const u32 num_words = len / 8;
+  if (samples == 0 || samples >= num_words)
+    return XXH3_64bits_withSeed(src, len, len);
+
+  // Gather the sampled words into a buffer, so that XXH3 can still run its vectorized loop over
+  // them instead of mixing in one word at a time.
+  const u32 step = num_words / samples;
+  std::array<u64, 64> words;
+  size_t num_buffered = 0;
+
+  XXH3_state_t state;
+  XXH3_64bits_reset_withSeed(&state, len);
+  for (u32 i = 0; i < num_words; i += step)
+  {
+    std::memcpy(&words[num_buffered++], src + i * sizeof(u64), sizeof(u64));
+    if (num_buffered == words.size())
+    {
+      XXH3_64bits_update(&state, words.data(), sizeof(words));
+      num_buffered = 0;
+    }
+  }
+  if (num_buffered != 0)
+    XXH3_64bits_update(&state, words.data(), num_buffered * sizeof(u64));
+  if (len & 7)
+    XXH3_64bits_update(&state, src + num_words * sizeof(u64), len & 7);
+
+  return XXH3_64bits_digest(&state);
+}
+
 using TextureHashFunction = u64 (*)(const u8* src, u32 len, u32 samples);
 static u64 SetHash64Function(const u8* src, u32 len, u32 samples);
 static TextureHashFunction s_texture_hash_func = SetHash64Function;
+static TextureHashAlgorithm s_texture_hash_algorithm = TextureHashAlgorithm::XXH3;
 
 static u64 SetHash64Function(const u8* src, u32 len, u32 samples)
 {
-  if (cpu_info.bCRC32)
+  if (s_texture_hash_algorithm == TextureHashAlgorithm::XXH3)
+  {
+    s_texture_hash_func = &GetHash64_XXH3;
+  }
+  else if (cpu_info.bCRC32)
   {
 #if defined(_M_X86_64)
     s_texture_hash_func = &GetHash64_SSE42_CRC32;
@@ -427,6 +466,12 @@ u64 GetHash64(const u8* src, u32 len, u32 samples)
   return s_texture_hash_func(src, len, samples);
 }
 
+void SetTextureHashAlgorithm(TextureHashAlgorithm algorithm)
+{
+  s_texture_hash_algorithm = algorithm;
+  s_texture_hash_func = SetHash64Function;
+}
+
 u32 StartCRC32()
 {
   return crc32_z(0L, Z_NULL, 0);
@@ -437,6 +482,11 @@ u32 UpdateCRC32(u32 crc, const u8* data, size_t len)
   return crc32_z(crc, data, len);
 }
 
+u32 CombineCRC32(u32 crc1, u32 crc2, u64 len2)
+{
+  return static_cast<u32>(crc32_combine64(crc1, crc2, static_cast<z_off64_t>(len2)));
+}
+
 u32 ComputeCRC32(const u8* data, size_t len)
 {
   return UpdateCRC32(StartCRC32(), data, len);
@@ -14,11 +14,23 @@ u32 HashAdler32(const u8* data, size_t len);
 // JUNK. DO NOT USE FOR NEW THINGS
 u32 HashEctor(const u8* data, size_t len);
 
-// Specialized hash function used for the texture cache
+enum class TextureHashAlgorithm : int
+{
+  // CRC32 instructions where available, MurmurHash3 otherwise.
+  Legacy,
+  // XXH3 over the whole range, or over the sampled words in sparse mode.
+  XXH3,
+};
+
+// Specialized hash function used for the texture cache. If samples is non-zero, only that many
+// evenly spaced 64-bit words of the range are hashed.
 u64 GetHash64(const u8* src, u32 len, u32 samples);
+void SetTextureHashAlgorithm(TextureHashAlgorithm algorithm);
 
 u32 StartCRC32();
 u32 UpdateCRC32(u32 crc, const u8* data, size_t len);
+// Returns the CRC32 of the concatenation of two ranges, given their CRC32s and the second length
+u32 CombineCRC32(u32 crc1, u32 crc2, u64 len2);
 u32 ComputeCRC32(const u8* data, size_t len);
 u32 ComputeCRC32(std::string_view data);
 }  // namespace Common
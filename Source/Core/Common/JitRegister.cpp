@@ -3,11 +3,14 @@
 
 #include "Common/JitRegister.h"
 
+#include <atomic>
 #include <cstddef>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <fstream>
 #include <string>
+#include <vector>
 
 #include <fmt/format.h>
 
@@ -21,6 +24,12 @@
 #include <unistd.h>
 #endif
 
+#ifdef __linux__
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <time.h>
+#endif
+
 #if defined USE_OPROFILE && USE_OPROFILE
 #include <opagent.h>
 #endif
@@ -36,11 +45,128 @@ static op_agent_t s_agent = nullptr;
 
 static File::IOFile s_perf_map_file;
 
+#ifdef __linux__
+// Linux perf jitdump format, see tools/perf/Documentation/jitdump-specification.txt.
+// Unlike the perf map, it carries the generated code itself, so `perf inject --jit` can
+// disassemble and annotate JIT blocks even after they have been overwritten.
+namespace
+{
+constexpr u32 JITDUMP_MAGIC = 0x4A695444;
+constexpr u32 JITDUMP_VERSION = 1;
+constexpr u32 JITDUMP_CODE_LOAD = 0;
+
+struct JitDumpHeader
+{
+  u32 magic;
+  u32 version;
+  u32 total_size;
+  u32 elf_mach;
+  u32 pad1;
+  u32 pid;
+  u64 timestamp;
+  u64 flags;
+};
+
+struct JitDumpCodeLoad
+{
+  u32 id;
+  u32 total_size;
+  u64 timestamp;
+  u32 pid;
+  u32 tid;
+  u64 vma;
+  u64 code_addr;
+  u64 code_size;
+  u64 code_index;
+};
+}  // namespace
+
+static File::IOFile s_jitdump_file;
+static void* s_jitdump_marker = nullptr;
+static size_t s_jitdump_marker_size = 0;
+static std::atomic<u64> s_jitdump_code_index = 0;
+
+// perf requires the same clock to be used for the records and for its own samples.
+static u64 GetJitDumpTimestamp()
+{
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return static_cast<u64>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+}
+
+static void OpenJitDump(const std::string& dir)
+{
+  const std::string filename = fmt::format("{}/jit-{}.dump", dir, getpid());
+  if (!s_jitdump_file.Open(filename, "w+b"))
+    return;
+
+  // perf finds the dump through an executable mapping of the file in the recorded process.
+  s_jitdump_marker_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  s_jitdump_marker = mmap(nullptr, s_jitdump_marker_size, PROT_READ | PROT_EXEC, MAP_PRIVATE,
+                          fileno(s_jitdump_file.GetHandle()), 0);
+  if (s_jitdump_marker == MAP_FAILED)
+  {
+    s_jitdump_marker = nullptr;
+    s_jitdump_file.Close();
+    return;
+  }
+
+  std::setvbuf(s_jitdump_file.GetHandle(), nullptr, _IONBF, 0);
+
+  JitDumpHeader header{};
+  header.magic = JITDUMP_MAGIC;
+  header.version = JITDUMP_VERSION;
+  header.total_size = sizeof(header);
+#if defined(_M_X86_64)
+  header.elf_mach = 62;  // EM_X86_64
+#elif defined(_M_ARM_64)
+  header.elf_mach = 183;  // EM_AARCH64
+#endif
+  header.pid = static_cast<u32>(getpid());
+  header.timestamp = GetJitDumpTimestamp();
+  s_jitdump_file.WriteBytes(&header, sizeof(header));
+}
+
+static void CloseJitDump()
+{
+  if (s_jitdump_marker)
+  {
+    munmap(s_jitdump_marker, s_jitdump_marker_size);
+    s_jitdump_marker = nullptr;
+  }
+  if (s_jitdump_file.IsOpen())
+    s_jitdump_file.Close();
+}
+
+static void WriteJitDumpCodeLoad(const void* base_address, u32 code_size,
+                                 const std::string& symbol_name)
+{
+  JitDumpCodeLoad record{};
+  record.id = JITDUMP_CODE_LOAD;
+  record.total_size = static_cast<u32>(sizeof(record) + symbol_name.size() + 1 + code_size);
+  record.timestamp = GetJitDumpTimestamp();
+  record.pid = static_cast<u32>(getpid());
+  record.tid = static_cast<u32>(syscall(SYS_gettid));
+  record.vma = reinterpret_cast<u64>(base_address);
+  record.code_addr = record.vma;
+  record.code_size = code_size;
+  record.code_index = s_jitdump_code_index++;
+
+  // Emit the whole record with a single write so that records from different threads
+  // never interleave.
+  std::vector<u8> buffer(record.total_size);
+  std::memcpy(buffer.data(), &record, sizeof(record));
+  std::memcpy(buffer.data() + sizeof(record), symbol_name.c_str(), symbol_name.size() + 1);
+  std::memcpy(buffer.data() + sizeof(record) + symbol_name.size() + 1, base_address, code_size);
+  s_jitdump_file.WriteBytes(buffer.data(), buffer.size());
+}
+#endif
+
 namespace Common::JitRegister
 {
 static bool s_is_enabled = false;
 
-void Init(const std::string& perf_dir)
+void Init(const std::string& perf_dir, bool jitdump)
 {
 #if defined USE_OPROFILE && USE_OPROFILE
   s_agent = op_open_agent();
@@ -56,6 +182,11 @@ void Init(const std::string& perf_dir)
     // if the event of a crash:
     std::setvbuf(s_perf_map_file.GetHandle(), nullptr, _IONBF, 0);
     s_is_enabled = true;
+
+#ifdef __linux__
+    if (jitdump)
+      OpenJitDump(dir);
+#endif
   }
 }
 
@@ -73,6 +204,10 @@ void Shutdown()
   if (s_perf_map_file.IsOpen())
     s_perf_map_file.Close();
 
+#ifdef __linux__
+  CloseJitDump();
+#endif
+
   s_is_enabled = false;
 }
 
@@ -101,6 +236,11 @@ void Register(const void* base_address, u32 code_size, const std::string& symbol
   iJIT_NotifyEvent(iJVM_EVENT_TYPE_METHOD_LOAD_FINISHED, (void*)&jmethod);
 #endif
 
+#ifdef __linux__
+  if (s_jitdump_file.IsOpen())
+    WriteJitDumpCodeLoad(base_address, code_size, symbol_name);
+#endif
+
   // Linux perf /tmp/perf-$pid.map:
   if (!s_perf_map_file.IsOpen())
     return;
@@ -11,7 +11,7 @@
 
 namespace Common::JitRegister
 {
-void Init(const std::string& perf_dir);
+void Init(const std::string& perf_dir, bool jitdump = false);
 void Shutdown();
 void Register(const void* base_address, u32 code_size, const std::string& symbol_name);
 bool IsEnabled();
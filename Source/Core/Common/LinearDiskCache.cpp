@@ -0,0 +1,30 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Common/LinearDiskCache.h"
+
+#include <zstd.h>
+
+namespace Common::detail
+{
+// Values are decompressed while loading, so favor decompression speed over ratio.
+constexpr int COMPRESSION_LEVEL = 3;
+
+std::vector<u8> CompressDiskCacheValue(const u8* data, size_t size)
+{
+  std::vector<u8> compressed(ZSTD_compressBound(size));
+  const size_t compressed_size =
+      ZSTD_compress(compressed.data(), compressed.size(), data, size, COMPRESSION_LEVEL);
+  if (ZSTD_isError(compressed_size) || compressed_size >= size)
+    return {};
+
+  compressed.resize(compressed_size);
+  return compressed;
+}
+
+bool DecompressDiskCacheValue(const u8* data, size_t size, u8* out, size_t out_size)
+{
+  const size_t result = ZSTD_decompress(out, out_size, data, size);
+  return !ZSTD_isError(result) && result == out_size;
+}
+}  // namespace Common::detail
@@ -4,31 +4,59 @@
 #pragma once
 
 #include <algorithm>
+#include <cstddef>
 #include <cstring>
-#include <memory>
+#include <map>
 #include <string>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
 #include "Common/IOFile.h"
+#include "Common/MappedFile.h"
 #include "Common/Version.h"
 
 // On disk format:
 // header{
 // u32 'DCAC';
-// u32 version;  // svn_rev
+// u32 format_version;
 // u16 sizeof(key_type);
 // u16 sizeof(value_type);
+// char scm_rev[40];
+// u64 index_offset;  // 0 while records are being appended without an index
+// u32 index_entries;
+// u32 record_count;
 //}
 
-// key_value_pair{
-// u32 value_size;
+// record{
+// u32 value_size;   // in units of value_type
+// u32 stored_size;  // in bytes, smaller than value_size * sizeof(value_type) if compressed
 // key_type   key;
-// value_type[value_size]   value;
+// u8[stored_size]   value;
+// u32 record_number;
 //}
 
+// index{
+// u32 INDEX_MARKER;
+// u32 size;  // in bytes
+// index_entry{ key_type key; u64 record_offset; }[index_entries];  // sorted by key bytes
+//}
+
+// Records are only ever appended. Closing the cache writes an index of the latest record of each
+// key after them, so that opening a cache doesn't have to read every record. If the index is
+// missing, e.g. after a crash, it is rebuilt by scanning the records.
+
 namespace Common
 {
+namespace detail
+{
+// Returns an empty vector if compressing doesn't make the value smaller.
+std::vector<u8> CompressDiskCacheValue(const u8* data, size_t size);
+bool DecompressDiskCacheValue(const u8* data, size_t size, u8* out, size_t out_size);
+}  // namespace detail
+
 template <typename K, typename V>
 class LinearDiskCacheReader
 {
@@ -36,14 +64,15 @@ public:
   virtual void Read(const K& key, const V* value, u32 value_size) = 0;
 };
 
-// Dead simple unsorted key-value store with append functionality.
-// No random read functionality, all reading is done in OpenAndRead.
+// Unsorted key-value store with append functionality, backed by a memory mapped file.
+// Values can either all be read in OpenAndRead, or be looked up by key after Open.
 // Keys and values can contain any characters, including \0.
 //
 // Suitable for caching generated shader bytecode between executions.
 // Not tuned for extreme performance but should be reasonably fast.
 // Does not support keys or values larger than 2GB, which should be reasonable.
 // Keys must have non-zero length; values can have zero length.
+// If a key is appended more than once, only the latest value is kept.
 
 // K and V are some POD type
 // K : the key type
@@ -52,8 +81,30 @@ template <typename K, typename V>
 class LinearDiskCache
 {
 public:
+  // Values that are compressed are decompressed when they're read, so this trades load time for
+  // disk space. It's worth it for large values like shader binaries.
+  explicit LinearDiskCache(bool compress_values = false) : m_compress_values(compress_values) {}
+  ~LinearDiskCache() { Close(); }
+
+  LinearDiskCache(const LinearDiskCache&) = delete;
+  LinearDiskCache& operator=(const LinearDiskCache&) = delete;
+
   // return number of read entries
   u32 OpenAndRead(const std::string& filename, LinearDiskCacheReader<K, V>& reader)
+  {
+    const u32 count = Open(filename);
+
+    std::vector<V> value;
+    ForEachEntry([&](const K& key, u64 offset) {
+      if (ReadValue(offset, &value))
+        reader.Read(key, value.data(), static_cast<u32>(value.size()));
+    });
+
+    return count;
+  }
+
+  // Opens the cache without reading any values. Returns the number of entries.
+  u32 Open(const std::string& filename)
   {
     // Since we're reading/writing directly to the storage of K instances,
     // K must be trivially copyable.
@@ -61,108 +112,494 @@ public:
 
     // close any currently opened file
     Close();
-    m_num_entries = 0;
+    m_filename = filename;
 
     // try opening for reading/writing
     m_file.Open(filename, "r+b");
 
-    const u64 file_size = m_file.GetSize();
-
-    m_header.Init();
-    if (m_file.IsOpen() && ValidateHeader())
+    if (m_file.IsOpen() && ReadHeader() && m_mapping.Open(filename))
     {
-      // good header, read some key/value pairs
-      K key;
-
-      std::unique_ptr<V[]> value = nullptr;
-      u32 value_size = 0;
-      u32 entry_number = 0;
-      u64 last_valid_value_start = m_file.Tell();
-
-      while (m_file.ReadArray(&value_size, 1))
-      {
-        const u64 next_extent = m_file.Tell() + sizeof(value_size) + value_size;
-        if (next_extent > file_size)
-          break;
-
-        // TODO: use make_unique_for_overwrite in C++20
-        value = std::unique_ptr<V[]>(new V[value_size]);
-
-        // read key/value and pass to reader
-        if (m_file.ReadArray(&key, 1) && m_file.ReadArray(value.get(), value_size) &&
-            m_file.ReadArray(&entry_number, 1) && entry_number == m_num_entries + 1)
-        {
-          last_valid_value_start = m_file.Tell();
-          reader.Read(key, value.get(), value_size);
-        }
-        else
-        {
-          break;
-        }
+      if (!LoadIndex())
+        RebuildIndex();
 
-        m_num_entries++;
-      }
-      m_file.ClearError();
-      m_file.Seek(last_valid_value_start, File::SeekOrigin::Begin);
-
-      return m_num_entries;
+      m_file.Seek(m_append_offset, File::SeekOrigin::Begin);
+      return GetEntryCount();
     }
 
     // failed to open file for reading or bad header
     // close and recreate file
     Close();
-    m_file.Open(filename, "wb");
+    m_filename = filename;
+    m_file.Open(filename, "w+b");
+    m_header = MakeHeader();
     WriteHeader();
+    m_append_offset = sizeof(Header);
     return 0;
   }
 
+  bool Contains(const K& key) const
+  {
+    return m_new_entries.contains(key) || FindIndexEntry(key) != nullptr;
+  }
+
+  // Reads the value of a key from disk. Returns false if the key isn't in the cache.
+  bool Lookup(const K& key, std::vector<V>* value)
+  {
+    if (const auto it = m_new_entries.find(key); it != m_new_entries.end())
+      return ReadValue(it->second, value);
+
+    const u8* const entry = FindIndexEntry(key);
+    return entry && ReadValue(GetIndexEntryOffset(entry), value);
+  }
+
+  u32 GetEntryCount() const
+  {
+    return static_cast<u32>(m_index_entries - m_replaced_index_entries + m_new_entries.size());
+  }
+
   void Sync() { m_file.Flush(); }
   void Close()
   {
     if (m_file.IsOpen())
+    {
+      if (m_has_appended)
+        WriteIndex();
       m_file.Close();
+    }
+
+    m_mapping.Close();
+    m_index = nullptr;
+    m_index_entries = 0;
+    m_replaced_index_entries = 0;
+    m_new_entries.clear();
+    m_append_offset = 0;
+    m_dead_bytes = 0;
+    m_has_appended = false;
   }
 
   // Appends a key-value pair to the store.
   void Append(const K& key, const V* value, u32 value_size)
   {
-    // TODO: Should do a check that we don't already have "key"? (I think each caller does that
-    // already.)
-    m_file.WriteArray(&value_size, 1);
+    if (!m_file.IsOpen())
+      return;
+
+    if (!m_has_appended)
+    {
+      // Drop the index from the header until a new one is written, so that the records appended
+      // until then aren't lost if Dolphin doesn't get to close the cache.
+      m_has_appended = true;
+      if (m_header.index_offset != 0)
+      {
+        m_dead_bytes += m_append_offset - m_header.index_offset;
+        m_header.index_offset = 0;
+        m_header.index_entries = 0;
+        m_file.Seek(0, File::SeekOrigin::Begin);
+        WriteHeader();
+        m_file.Seek(m_append_offset, File::SeekOrigin::Begin);
+      }
+    }
+
+    const u8* const data = reinterpret_cast<const u8*>(value);
+    const size_t size = static_cast<size_t>(value_size) * sizeof(V);
+    std::vector<u8> compressed;
+    if (m_compress_values && size >= MIN_COMPRESSED_SIZE)
+      compressed = detail::CompressDiskCacheValue(data, size);
+
+    RecordHeader record_header{value_size, static_cast<u32>(size)};
+    if (!compressed.empty())
+      record_header.stored_size = static_cast<u32>(compressed.size());
+
+    const u64 offset = m_append_offset;
+    m_file.WriteArray(&record_header, 1);
     m_file.WriteArray(&key, 1);
-    m_file.WriteArray(value, value_size);
-    m_num_entries++;
-    m_file.WriteArray(&m_num_entries, 1);
+    if (compressed.empty())
+      m_file.WriteBytes(data, size);
+    else
+      m_file.WriteBytes(compressed.data(), compressed.size());
+    m_header.record_count++;
+    m_file.WriteArray(&m_header.record_count, 1);
+    m_append_offset += GetRecordSize(record_header);
+
+    // Remember how much space replaced records waste so that Close knows when to compact.
+    const auto [it, inserted] = m_new_entries.try_emplace(key, offset);
+    if (!inserted)
+    {
+      m_dead_bytes += GetRecordSizeAt(it->second);
+      it->second = offset;
+    }
+    else if (const u8* const entry = FindIndexEntry(key))
+    {
+      m_dead_bytes += GetRecordSizeAt(GetIndexEntryOffset(entry));
+      m_replaced_index_entries++;
+    }
   }
 
 private:
+  static constexpr u32 FORMAT_VERSION = 2;
+  static constexpr u32 INDEX_MARKER = 0xFFFFFFFF;
+  static constexpr size_t INDEX_ENTRY_SIZE = sizeof(K) + sizeof(u64);
+  static constexpr size_t MIN_COMPRESSED_SIZE = 64;
+
+  // The file is rewritten without replaced records once they make up more than a third of it.
+  static constexpr u64 MIN_COMPACTION_DEAD_BYTES = 1024 * 1024;
+  static constexpr u64 COMPACTION_DEAD_FRACTION = 3;
+
+  struct Header
+  {
+    u32 id;
+    u32 format_version;
+    u16 key_t_size;
+    u16 value_t_size;
+    char ver[40];
+    u64 index_offset;
+    u32 index_entries;
+    u32 record_count;
+  };
+  static_assert(std::is_trivially_copyable_v<Header> && sizeof(Header) == 72);
+
+  struct RecordHeader
+  {
+    u32 value_size;
+    u32 stored_size;
+  };
+
+  struct KeyLess
+  {
+    bool operator()(const K& a, const K& b) const { return std::memcmp(&a, &b, sizeof(K)) < 0; }
+  };
+
+  static Header MakeHeader()
+  {
+    Header header{};
+    // Null-terminator is intentionally not copied.
+    std::memcpy(&header.id, "DCAC", sizeof(u32));
+    header.format_version = FORMAT_VERSION;
+    header.key_t_size = sizeof(K);
+    header.value_t_size = sizeof(V);
+    const std::string& scm_rev = Common::GetScmRevGitStr();
+    std::memcpy(header.ver, scm_rev.c_str(), std::min(scm_rev.size(), sizeof(header.ver)));
+    return header;
+  }
+
+  static u64 GetRecordSize(const RecordHeader& record_header)
+  {
+    return sizeof(RecordHeader) + sizeof(K) + record_header.stored_size + sizeof(u32);
+  }
+
   void WriteHeader() { m_file.WriteArray(&m_header, 1); }
-  bool ValidateHeader()
+  bool ReadHeader()
   {
-    char file_header[sizeof(Header)];
+    const Header expected = MakeHeader();
+    return m_file.ReadArray(&m_header, 1) &&
+           !std::memcmp(&m_header, &expected, offsetof(Header, index_offset));
+  }
+
+  bool LoadIndex()
+  {
+    const u64 offset = m_header.index_offset;
+    const u64 size = u64{m_header.index_entries} * INDEX_ENTRY_SIZE;
+    RecordHeader index_header;
+    if (offset < sizeof(Header) || !m_mapping.Contains(offset, sizeof(index_header) + size))
+      return false;
 
-    return (m_file.ReadArray(file_header, sizeof(Header)) &&
-            !memcmp((const char*)&m_header, file_header, sizeof(Header)));
+    std::memcpy(&index_header, m_mapping.GetData() + offset, sizeof(index_header));
+    if (index_header.value_size != INDEX_MARKER || index_header.stored_size != size)
+      return false;
+
+    m_index = m_mapping.GetData() + offset + sizeof(index_header);
+    m_index_entries = m_header.index_entries;
+    m_append_offset = offset + sizeof(index_header) + size;
+    return true;
   }
 
-  struct Header
+  // Scans the records of a cache that wasn't closed properly and keeps the latest of each key,
+  // up to the first record that wasn't completely written.
+  void RebuildIndex()
+  {
+    const u8* const data = m_mapping.GetData();
+    u64 offset = sizeof(Header);
+    u32 record_number = 0;
+    RecordHeader record_header;
+    while (m_mapping.Contains(offset, sizeof(record_header)))
+    {
+      std::memcpy(&record_header, data + offset, sizeof(record_header));
+
+      // Skip indexes that were written before more records were appended.
+      if (record_header.value_size == INDEX_MARKER)
+      {
+        const u64 size = sizeof(record_header) + u64{record_header.stored_size};
+        if (!m_mapping.Contains(offset, size))
+          break;
+        m_dead_bytes += size;
+        offset += size;
+        continue;
+      }
+
+      const u64 size = GetRecordSize(record_header);
+      u32 stored_record_number;
+      if (!m_mapping.Contains(offset, size) || !IsValidRecord(record_header))
+        break;
+      std::memcpy(&stored_record_number, data + offset + size - sizeof(u32), sizeof(u32));
+      if (stored_record_number != record_number + 1)
+        break;
+
+      K key;
+      std::memcpy(&key, data + offset + sizeof(record_header), sizeof(K));
+      const auto [it, inserted] = m_new_entries.try_emplace(key, offset);
+      if (!inserted)
+      {
+        m_dead_bytes += GetRecordSizeAt(it->second);
+        it->second = offset;
+      }
+
+      record_number++;
+      offset += size;
+    }
+
+    m_header.record_count = record_number;
+    m_append_offset = offset;
+    if (m_header.index_offset != 0)
+    {
+      m_header.index_offset = 0;
+      m_header.index_entries = 0;
+      m_file.Seek(0, File::SeekOrigin::Begin);
+      WriteHeader();
+    }
+
+    // Make sure an index is written on close, even if nothing is appended.
+    m_has_appended = true;
+  }
+
+  static bool IsValidRecord(const RecordHeader& record_header)
   {
-    void Init()
+    const u64 size = u64{record_header.value_size} * sizeof(V);
+    return record_header.stored_size == size ||
+           (record_header.stored_size < size && size != 0 && size <= 0x7FFFFFFF);
+  }
+
+  const u8* FindIndexEntry(const K& key) const
+  {
+    size_t first = 0;
+    size_t last = m_index_entries;
+    while (first < last)
     {
-      // Null-terminator is intentionally not copied.
-      std::memcpy(&id, "DCAC", sizeof(u32));
-      std::memcpy(ver, Common::GetScmRevGitStr().c_str(),
-                  std::min(Common::GetScmRevGitStr().size(), sizeof(ver)));
+      const size_t middle = first + (last - first) / 2;
+      const u8* const entry = m_index + middle * INDEX_ENTRY_SIZE;
+      const int result = std::memcmp(entry, &key, sizeof(K));
+      if (result == 0)
+        return entry;
+      if (result < 0)
+        first = middle + 1;
+      else
+        last = middle;
     }
+    return nullptr;
+  }
+
+  static u64 GetIndexEntryOffset(const u8* entry)
+  {
+    u64 offset;
+    std::memcpy(&offset, entry + sizeof(K), sizeof(offset));
+    return offset;
+  }
 
-    u32 id = 0;
-    const u16 key_t_size = sizeof(K);
-    const u16 value_t_size = sizeof(V);
-    char ver[40] = {};
+  // Calls callback(key, offset) for the latest record of every key, in key order.
+  template <typename Callback>
+  void ForEachEntry(Callback callback) const
+  {
+    auto it = m_new_entries.begin();
+    for (size_t i = 0; i < m_index_entries; ++i)
+    {
+      const u8* const entry = m_index + i * INDEX_ENTRY_SIZE;
+      for (; it != m_new_entries.end() && std::memcmp(&it->first, entry, sizeof(K)) < 0; ++it)
+        callback(it->first, it->second);
 
-  } m_header;
+      // Entries that were appended again since the index was written replace the indexed ones.
+      if (it != m_new_entries.end() && std::memcmp(&it->first, entry, sizeof(K)) == 0)
+        continue;
+
+      K key;
+      std::memcpy(&key, entry, sizeof(K));
+      callback(key, GetIndexEntryOffset(entry));
+    }
+    for (; it != m_new_entries.end(); ++it)
+      callback(it->first, it->second);
+  }
+
+  // Records before m_mapping's end are read from the mapping, later ones from the file.
+  bool ReadBytes(u64 offset, void* data, size_t size)
+  {
+    if (m_mapping.Contains(offset, size))
+    {
+      std::memcpy(data, m_mapping.GetData() + offset, size);
+      return true;
+    }
+
+    m_file.Flush();
+    m_file.Seek(offset, File::SeekOrigin::Begin);
+    const bool result = m_file.ReadBytes(data, size);
+    m_file.ClearError();
+    m_file.Seek(m_append_offset, File::SeekOrigin::Begin);
+    return result;
+  }
+
+  u64 GetRecordSizeAt(u64 offset)
+  {
+    RecordHeader record_header;
+    if (!ReadBytes(offset, &record_header, sizeof(record_header)))
+      return 0;
+    return GetRecordSize(record_header);
+  }
+
+  bool ReadValue(u64 offset, std::vector<V>* value)
+  {
+    RecordHeader record_header;
+    if (!ReadBytes(offset, &record_header, sizeof(record_header)) ||
+        !IsValidRecord(record_header))
+    {
+      return false;
+    }
+
+    value->resize(record_header.value_size);
+    const u64 data_offset = offset + sizeof(record_header) + sizeof(K);
+    const size_t size = value->size() * sizeof(V);
+    u8* const out = reinterpret_cast<u8*>(value->data());
+    if (record_header.stored_size == size)
+      return ReadBytes(data_offset, out, size);
+
+    if (m_mapping.Contains(data_offset, record_header.stored_size))
+    {
+      return detail::DecompressDiskCacheValue(m_mapping.GetData() + data_offset,
+                                              record_header.stored_size, out, size);
+    }
+
+    std::vector<u8> compressed(record_header.stored_size);
+    return ReadBytes(data_offset, compressed.data(), compressed.size()) &&
+           detail::DecompressDiskCacheValue(compressed.data(), compressed.size(), out, size);
+  }
+
+  void WriteIndex()
+  {
+    std::vector<std::pair<K, u64>> entries;
+    entries.reserve(GetEntryCount());
+    ForEachEntry([&](const K& key, u64 offset) { entries.emplace_back(key, offset); });
+
+    const u64 live_bytes = m_append_offset - sizeof(Header) - m_dead_bytes;
+    if (m_dead_bytes >= MIN_COMPACTION_DEAD_BYTES &&
+        m_dead_bytes * COMPACTION_DEAD_FRACTION > live_bytes + m_dead_bytes && Compact(entries))
+    {
+      return;
+    }
+
+    WriteIndex(entries);
+  }
+
+  void WriteIndex(const std::vector<std::pair<K, u64>>& entries)
+  {
+    std::vector<u8> index(sizeof(RecordHeader) + entries.size() * INDEX_ENTRY_SIZE);
+    const RecordHeader index_header{INDEX_MARKER,
+                                    static_cast<u32>(index.size() - sizeof(RecordHeader))};
+    std::memcpy(index.data(), &index_header, sizeof(index_header));
+    u8* entry = index.data() + sizeof(index_header);
+    for (const auto& [key, offset] : entries)
+    {
+      std::memcpy(entry, &key, sizeof(K));
+      std::memcpy(entry + sizeof(K), &offset, sizeof(offset));
+      entry += INDEX_ENTRY_SIZE;
+    }
+
+    // The header is only updated once the index is on disk.
+    m_file.Seek(m_append_offset, File::SeekOrigin::Begin);
+    m_file.WriteBytes(index.data(), index.size());
+    m_file.Flush();
+    m_header.index_offset = m_append_offset;
+    m_header.index_entries = static_cast<u32>(entries.size());
+    m_file.Seek(0, File::SeekOrigin::Begin);
+    WriteHeader();
+  }
+
+  // Copies the latest record of every key to a new file, in the order they were appended.
+  bool Compact(const std::vector<std::pair<K, u64>>& entries)
+  {
+    const std::string temp_filename = m_filename + ".tmp";
+    File::IOFile temp_file(temp_filename, "wb");
+    if (!temp_file)
+      return false;
+
+    std::vector<std::pair<K, u64>> new_entries = entries;
+    std::vector<size_t> order(new_entries.size());
+    for (size_t i = 0; i < order.size(); ++i)
+      order[i] = i;
+    std::ranges::sort(order, {}, [&](size_t i) { return new_entries[i].second; });
+
+    Header header = m_header;
+    header.index_offset = 0;
+    header.index_entries = 0;
+    header.record_count = 0;
+    temp_file.WriteArray(&header, 1);
+
+    std::vector<u8> record;
+    u64 offset = sizeof(Header);
+    for (const size_t i : order)
+    {
+      u64& entry_offset = new_entries[i].second;
+      RecordHeader record_header;
+      record.clear();
+      if (ReadBytes(entry_offset, &record_header, sizeof(record_header)))
+        record.resize(GetRecordSize(record_header));
+      if (record.empty() || !ReadBytes(entry_offset, record.data(), record.size()))
+        break;
+
+      header.record_count++;
+      std::memcpy(record.data() + record.size() - sizeof(u32), &header.record_count, sizeof(u32));
+      if (!temp_file.WriteBytes(record.data(), record.size()))
+        break;
+
+      entry_offset = offset;
+      offset += record.size();
+    }
+
+    if (header.record_count != new_entries.size() || !temp_file.Close())
+    {
+      temp_file.Close();
+      File::Delete(temp_filename);
+      return false;
+    }
+
+    m_file.Close();
+    m_mapping.Close();
+    if (!File::Rename(temp_filename, m_filename))
+    {
+      File::Delete(temp_filename);
+      m_file.Open(m_filename, "r+b");
+      return false;
+    }
+
+    m_file.Open(m_filename, "r+b");
+    m_header = header;
+    m_append_offset = offset;
+    WriteIndex(new_entries);
+    return true;
+  }
+
+  Header m_header{};
 
   File::IOFile m_file;
-  u32 m_num_entries = 0;
+  File::MappedFile m_mapping;
+  std::string m_filename;
+  bool m_compress_values;
+
+  // The index that was on disk when the cache was opened, inside m_mapping.
+  const u8* m_index = nullptr;
+  size_t m_index_entries = 0;
+  size_t m_replaced_index_entries = 0;
+
+  // Records that aren't in m_index, either because they were appended since it was written or
+  // because there was no index to load.
+  std::map<K, u64, KeyLess> m_new_entries;
+
+  u64 m_append_offset = 0;
+  u64 m_dead_bytes = 0;
+  bool m_has_appended = false;
 };
 }  // namespace Common
@@ -0,0 +1,254 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+// Bounded lock-free rings. Unlike SPSCQueue and MPSCQueue they never allocate after construction,
+// and pushes fail instead of blocking when the ring is full.
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+namespace Common
+{
+// Indices written by different threads are kept on their own cache lines, so that the producer
+// and the consumer don't invalidate each other's line on every operation.
+constexpr size_t CACHE_LINE_SIZE = 64;
+
+// Single producer, single consumer. Both sides are wait-free.
+template <typename T, size_t Capacity>
+class SPSCRing
+{
+  static_assert(Capacity != 0 && (Capacity & (Capacity - 1)) == 0,
+                "Capacity must be a power of two");
+
+public:
+  SPSCRing() = default;
+  SPSCRing(const SPSCRing&) = delete;
+  SPSCRing& operator=(const SPSCRing&) = delete;
+
+  static constexpr size_t CAPACITY = Capacity;
+
+  // Approximate unless called from the producer or the consumer.
+  size_t Size() const
+  {
+    return m_write.load(std::memory_order_acquire) - m_read.load(std::memory_order_acquire);
+  }
+  bool Empty() const { return Size() == 0; }
+
+  // Producer only. Returns false if the ring is full.
+  template <typename Arg>
+  bool Push(Arg&& t)
+  {
+    const size_t write = m_write.load(std::memory_order_relaxed);
+    if (write - m_read_cache == Capacity)
+    {
+      m_read_cache = m_read.load(std::memory_order_acquire);
+      if (write - m_read_cache == Capacity)
+        return false;
+    }
+
+    m_buffer[write & (Capacity - 1)] = std::forward<Arg>(t);
+    m_write.store(write + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Producer only. Returns how many elements were pushed, which is less than requested when the
+  // ring is full. They are published all at once.
+  size_t PushBatch(const T* items, size_t count)
+  {
+    const size_t write = m_write.load(std::memory_order_relaxed);
+    if (Capacity - (write - m_read_cache) < count)
+      m_read_cache = m_read.load(std::memory_order_acquire);
+    count = std::min(count, Capacity - (write - m_read_cache));
+
+    for (size_t i = 0; i < count; ++i)
+      m_buffer[(write + i) & (Capacity - 1)] = items[i];
+    m_write.store(write + count, std::memory_order_release);
+    return count;
+  }
+
+  // Consumer only. Returns false if the ring is empty.
+  bool Pop(T& t)
+  {
+    const size_t read = m_read.load(std::memory_order_relaxed);
+    if (read == m_write_cache)
+    {
+      m_write_cache = m_write.load(std::memory_order_acquire);
+      if (read == m_write_cache)
+        return false;
+    }
+
+    t = std::move(m_buffer[read & (Capacity - 1)]);
+    m_read.store(read + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Consumer only. Returns how many elements were popped into out, at most max_count.
+  size_t PopBatch(T* out, size_t max_count)
+  {
+    const size_t read = m_read.load(std::memory_order_relaxed);
+    if (m_write_cache - read < max_count)
+      m_write_cache = m_write.load(std::memory_order_acquire);
+    const size_t count = std::min(max_count, m_write_cache - read);
+
+    for (size_t i = 0; i < count; ++i)
+      out[i] = std::move(m_buffer[(read + i) & (Capacity - 1)]);
+    m_read.store(read + count, std::memory_order_release);
+    return count;
+  }
+
+  // Consumer only.
+  void Clear()
+  {
+    T t;
+    while (Pop(t))
+    {
+    }
+  }
+
+private:
+  std::array<T, Capacity> m_buffer{};
+
+  // Written by the producer. m_read_cache is the producer's last view of m_read, which only needs
+  // to be refreshed when the ring looks full.
+  alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_write = 0;
+  size_t m_read_cache = 0;
+
+  // Written by the consumer.
+  alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_read = 0;
+  size_t m_write_cache = 0;
+};
+
+// Multiple producers, single consumer. The consumer is wait-free. Producers are lock-free: they
+// claim slots with a compare-exchange, which only retries when another producer claimed the same
+// slot first.
+template <typename T, size_t Capacity>
+class MPSCRing
+{
+  static_assert(Capacity != 0 && (Capacity & (Capacity - 1)) == 0,
+                "Capacity must be a power of two");
+
+public:
+  MPSCRing()
+  {
+    for (size_t i = 0; i < Capacity; ++i)
+      m_slots[i].sequence.store(i, std::memory_order_relaxed);
+  }
+  MPSCRing(const MPSCRing&) = delete;
+  MPSCRing& operator=(const MPSCRing&) = delete;
+
+  static constexpr size_t CAPACITY = Capacity;
+
+  // Approximate unless called from the consumer with no producer running. Counts slots that
+  // producers have claimed but not yet filled.
+  size_t Size() const
+  {
+    return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire);
+  }
+  bool Empty() const { return Size() == 0; }
+
+  // Returns false if the ring is full.
+  template <typename Arg>
+  bool Push(Arg&& t)
+  {
+    return Claim(1, [&](size_t) -> Arg&& { return std::forward<Arg>(t); }) == 1;
+  }
+
+  // Returns how many elements were pushed, which is less than requested when the ring is full.
+  // The elements are claimed at once, so they stay contiguous even with other producers running.
+  size_t PushBatch(const T* items, size_t count)
+  {
+    return Claim(count, [&](size_t i) -> const T& { return items[i]; });
+  }
+
+  // Consumer only. Returns false if the ring is empty, or if the oldest element is still being
+  // written by its producer.
+  bool Pop(T& t)
+  {
+    const size_t head = m_head.load(std::memory_order_relaxed);
+    Slot& slot = m_slots[head & (Capacity - 1)];
+    if (slot.sequence.load(std::memory_order_acquire) != head + 1)
+      return false;
+
+    t = std::move(slot.value);
+    slot.sequence.store(head + Capacity, std::memory_order_release);
+    m_head.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Consumer only. Returns how many elements were popped into out, at most max_count.
+  size_t PopBatch(T* out, size_t max_count)
+  {
+    size_t count = 0;
+    while (count < max_count && Pop(out[count]))
+      ++count;
+    return count;
+  }
+
+  // Consumer only.
+  void Clear()
+  {
+    T t;
+    while (Pop(t))
+    {
+    }
+  }
+
+private:
+  struct Slot
+  {
+    // Equal to the slot's position when it's free, and to the position plus one once the producer
+    // that claimed it has filled it.
+    std::atomic<size_t> sequence;
+    T value{};
+  };
+
+  template <typename Get>
+  size_t Claim(size_t count, Get get)
+  {
+    size_t tail = m_tail.load(std::memory_order_relaxed);
+    while (true)
+    {
+      // The consumer frees slots in order, so if the last slot needed is free, all of them are.
+      const size_t free = Capacity - (tail - m_head.load(std::memory_order_acquire));
+      const size_t claimed = std::min({count, free, Capacity});
+      if (claimed == 0)
+        return 0;
+
+      const size_t last = tail + claimed - 1;
+      if (m_slots[last & (Capacity - 1)].sequence.load(std::memory_order_acquire) != last)
+      {
+        // Another producer moved the tail, or the consumer hasn't freed the slot yet.
+        const size_t new_tail = m_tail.load(std::memory_order_relaxed);
+        if (new_tail == tail)
+          return 0;
+        tail = new_tail;
+        continue;
+      }
+
+      if (m_tail.compare_exchange_weak(tail, tail + claimed, std::memory_order_relaxed))
+      {
+        for (size_t i = 0; i < claimed; ++i)
+        {
+          Slot& slot = m_slots[(tail + i) & (Capacity - 1)];
+          slot.value = get(i);
+          slot.sequence.store(tail + i + 1, std::memory_order_release);
+        }
+        return claimed;
+      }
+    }
+  }
+
+  std::array<Slot, Capacity> m_slots;
+
+  // Written by the producers.
+  alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_tail = 0;
+
+  // Written by the consumer.
+  alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_head = 0;
+};
+}  // namespace Common
@@ -11,6 +11,7 @@
 #include <mutex>
 #include <ostream>
 #include <string>
+#include <utility>
 
 #include <fmt/chrono.h>
 #include <fmt/format.h>
@@ -18,9 +19,12 @@
 #include "Common/CommonPaths.h"
 #include "Common/Config/Config.h"
 #include "Common/FileUtil.h"
+#include "Common/LockFreeRing.h"
 #include "Common/Logging/ConsoleListener.h"
 #include "Common/Logging/Log.h"
 #include "Common/StringUtil.h"
+#include "Common/Thread.h"
+#include "Common/ThreadPolicy.h"
 
 namespace Common::Log
 {
@@ -32,6 +36,27 @@ const Config::Info<bool> LOGGER_WRITE_TO_WINDOW{
     {Config::System::Logger, "Options", "WriteToWindow"}, true};
 const Config::Info<LogLevel> LOGGER_VERBOSITY{{Config::System::Logger, "Options", "Verbosity"},
                                               LogLevel::LNOTICE};
+const Config::Info<bool> LOGGER_ASYNC{{Config::System::Logger, "Options", "Async"}, false};
+
+constexpr size_t MAX_QUEUED_RECORDS_PER_THREAD = 1024;
+constexpr auto ASYNC_FLUSH_INTERVAL = std::chrono::milliseconds(5);
+
+struct LogRecord
+{
+  std::chrono::system_clock::time_point time;
+  LogLevel level;
+  LogType type;
+  const char* file;
+  int line;
+  std::string message;
+};
+
+struct LogRecordQueue
+{
+  SPSCRing<LogRecord, MAX_QUEUED_RECORDS_PER_THREAD> records;
+};
+
+static std::atomic<u32> s_log_manager_generation = 0;
 
 class FileLogListener : public LogListener
 {
@@ -169,10 +194,25 @@ LogManager::LogManager()
   }
 
   m_path_cutoff_point = DeterminePathCutOffPoint();
+
+  m_generation = ++s_log_manager_generation;
+  m_async = Config::Get(LOGGER_ASYNC);
+  if (m_async)
+  {
+    m_async_running.Set();
+    m_async_thread = std::thread(&LogManager::AsyncLogThread, this);
+  }
 }
 
 LogManager::~LogManager()
 {
+  if (m_async_thread.joinable())
+  {
+    m_async_running.Clear();
+    m_async_wake.Set();
+    m_async_thread.join();
+  }
+
   // The log window listener pointer is owned by the GUI code.
   delete m_listeners[LogListener::CONSOLE_LISTENER];
   delete m_listeners[LogListener::FILE_LISTENER];
@@ -206,23 +246,31 @@ void LogManager::Log(LogLevel level, LogType type, const char* file, int line, c
   LogWithFullPath(level, type, file + m_path_cutoff_point, line, message);
 }
 
-std::string LogManager::GetTimestamp()
+std::string LogManager::GetTimestamp(std::chrono::system_clock::time_point time)
 {
   // NOTE: the Qt LogWidget hardcodes the expected length of the timestamp portion of the log line,
   // so ensure they stay in sync
 
   // We want milliseconds *and not hours*, so can't directly use STL formatters
-  const auto now = std::chrono::system_clock::now();
-  const auto now_s = std::chrono::floor<std::chrono::seconds>(now);
-  const auto now_ms = std::chrono::floor<std::chrono::milliseconds>(now);
-  return fmt::format("{:%M:%S}:{:03}", now_s, (now_ms - now_s).count());
+  const auto time_s = std::chrono::floor<std::chrono::seconds>(time);
+  const auto time_ms = std::chrono::floor<std::chrono::milliseconds>(time);
+  return fmt::format("{:%M:%S}:{:03}", time_s, (time_ms - time_s).count());
 }
 
 void LogManager::LogWithFullPath(LogLevel level, LogType type, const char* file, int line,
                                  const char* message)
+{
+  if (m_async)
+    QueueRecord(level, type, file, line, message);
+  else
+    Dispatch(std::chrono::system_clock::now(), level, type, file, line, message);
+}
+
+void LogManager::Dispatch(std::chrono::system_clock::time_point time, LogLevel level,
+                          LogType type, const char* file, int line, const char* message)
 {
   const std::string msg =
-      fmt::format("{} {}:{} {}[{}]: {}\n", GetTimestamp(), file, line,
+      fmt::format("{} {}:{} {}[{}]: {}\n", GetTimestamp(time), file, line,
                   LOG_LEVEL_TO_CHAR[static_cast<int>(level)], GetShortName(type), message);
 
   for (const auto listener_id : m_listener_ids)
@@ -232,6 +280,79 @@ void LogManager::LogWithFullPath(LogLevel level, LogType type, const char* file,
   }
 }
 
+void LogManager::QueueRecord(LogLevel level, LogType type, const char* file, int line,
+                             const char* message)
+{
+  static thread_local std::shared_ptr<LogRecordQueue> t_queue;
+  static thread_local u32 t_queue_generation = 0;
+  if (t_queue_generation != m_generation)
+  {
+    t_queue = std::make_shared<LogRecordQueue>();
+    t_queue_generation = m_generation;
+    std::lock_guard lk(m_queues_lock);
+    m_queues.push_back(t_queue);
+  }
+
+  if (!t_queue->records.Push(
+          LogRecord{std::chrono::system_clock::now(), level, type, file, line, message}))
+  {
+    m_dropped_records.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+void LogManager::FlushQueuedRecords()
+{
+  std::vector<std::shared_ptr<LogRecordQueue>> queues;
+  {
+    std::lock_guard lk(m_queues_lock);
+    // Only the manager is left holding the queues of threads that have exited.
+    std::erase_if(m_queues, [](const std::shared_ptr<LogRecordQueue>& queue) {
+      return queue.use_count() == 1 && queue->records.Empty();
+    });
+    queues = m_queues;
+  }
+
+  std::vector<LogRecord> records;
+  for (const auto& queue : queues)
+  {
+    LogRecord record;
+    while (queue->records.Pop(record))
+      records.push_back(std::move(record));
+  }
+
+  // Interleave the threads' messages in the order they were logged in.
+  std::stable_sort(records.begin(), records.end(),
+                   [](const LogRecord& a, const LogRecord& b) { return a.time < b.time; });
+  for (const LogRecord& record : records)
+  {
+    Dispatch(record.time, record.level, record.type, record.file, record.line,
+             record.message.c_str());
+  }
+
+  const u64 dropped_records = m_dropped_records.load(std::memory_order_relaxed);
+  if (dropped_records != m_reported_dropped_records)
+  {
+    const std::string message = fmt::format("Dropped {} log messages that were queued too quickly",
+                                            dropped_records - m_reported_dropped_records);
+    Dispatch(std::chrono::system_clock::now(), LogLevel::LWARNING, LogType::COMMON,
+             __FILE__ + m_path_cutoff_point, __LINE__, message.c_str());
+    m_reported_dropped_records = dropped_records;
+  }
+}
+
+void LogManager::AsyncLogThread()
+{
+  Common::SetCurrentThreadName("Log Writer");
+  Common::SetCurrentThreadRole(Common::ThreadRole::Background);
+
+  while (m_async_running.IsSet())
+  {
+    m_async_wake.WaitFor(ASYNC_FLUSH_INTERVAL);
+    FlushQueuedRecords();
+  }
+  FlushQueuedRecords();
+}
+
 LogLevel LogManager::GetLogLevel() const
 {
   return m_level;
@@ -4,16 +4,27 @@
 #pragma once
 
 #include <array>
+#include <atomic>
+#include <chrono>
 #include <cstdarg>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "Common/BitSet.h"
+#include "Common/CommonTypes.h"
 #include "Common/EnumMap.h"
+#include "Common/Event.h"
+#include "Common/Flag.h"
 #include "Common/Logging/Log.h"
 
 namespace Common::Log
 {
+struct LogRecordQueue;
+
 // pure virtual interface
 class LogListener
 {
@@ -38,6 +49,8 @@ public:
   static void Init();
   static void Shutdown();
 
+  // In async mode, file must outlive the call (it is normally __FILE__). The messages are handed
+  // to the listeners by a background thread, and dropped when a thread queues them too quickly.
   void Log(LogLevel level, LogType type, const char* file, int line, const char* message);
   void LogWithFullPath(LogLevel level, LogType type, const char* file, int line,
                        const char* message);
@@ -75,12 +88,29 @@ private:
   LogManager(LogManager&&) = delete;
   LogManager& operator=(LogManager&&) = delete;
 
-  static std::string GetTimestamp();
+  static std::string GetTimestamp(std::chrono::system_clock::time_point time);
+
+  void Dispatch(std::chrono::system_clock::time_point time, LogLevel level, LogType type,
+                const char* file, int line, const char* message);
+  void QueueRecord(LogLevel level, LogType type, const char* file, int line, const char* message);
+  void FlushQueuedRecords();
+  void AsyncLogThread();
 
   LogLevel m_level;
   EnumMap<LogContainer, LAST_LOG_TYPE> m_log{};
   std::array<LogListener*, LogListener::NUMBER_OF_LISTENERS> m_listeners{};
   BitSet32 m_listener_ids;
   size_t m_path_cutoff_point = 0;
+
+  // Each logging thread gets its own queue, since they only support a single producer.
+  u32 m_generation;
+  bool m_async = false;
+  std::mutex m_queues_lock;
+  std::vector<std::shared_ptr<LogRecordQueue>> m_queues;
+  std::atomic<u64> m_dropped_records{0};
+  u64 m_reported_dropped_records = 0;
+  Common::Flag m_async_running;
+  Common::Event m_async_wake;
+  std::thread m_async_thread;
 };
 }  // namespace Common::Log
@@ -0,0 +1,76 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+// a lockless thread-safe,
+// multiple producer, single consumer queue
+
+#include <atomic>
+#include <utility>
+
+namespace Common
+{
+template <typename T>
+class MPSCQueue
+{
+public:
+  MPSCQueue() = default;
+  MPSCQueue(const MPSCQueue&) = delete;
+  MPSCQueue& operator=(const MPSCQueue&) = delete;
+  ~MPSCQueue() { Clear(); }
+
+  // Producers push onto an intrusive stack with a single compare-exchange.
+  template <typename Arg>
+  void Push(Arg&& t)
+  {
+    Node* const node = new Node{std::forward<Arg>(t), m_head.load(std::memory_order_relaxed)};
+    while (!m_head.compare_exchange_weak(node->next, node, std::memory_order_release,
+                                         std::memory_order_relaxed))
+    {
+    }
+  }
+
+  bool Empty() const { return m_head.load(std::memory_order_relaxed) == nullptr; }
+
+  // Consumer only. Takes everything pushed so far and calls f on each element, preserving the
+  // order in which each producer pushed them.
+  template <typename F>
+  void PopAll(F&& f)
+  {
+    Node* node = m_head.exchange(nullptr, std::memory_order_acquire);
+
+    Node* reversed = nullptr;
+    while (node)
+    {
+      Node* const next = node->next;
+      node->next = reversed;
+      reversed = node;
+      node = next;
+    }
+
+    while (reversed)
+    {
+      Node* const next = reversed->next;
+      f(std::move(reversed->value));
+      delete reversed;
+      reversed = next;
+    }
+  }
+
+  // Consumer only.
+  void Clear()
+  {
+    PopAll([](T&&) {});
+  }
+
+private:
+  struct Node
+  {
+    T value;
+    Node* next;
+  };
+
+  std::atomic<Node*> m_head = nullptr;
+};
+}  // namespace Common
@@ -0,0 +1,114 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Common/MappedFile.h"
+
+#ifdef _WIN32
+#include <windows.h>
+
+#include "Common/StringUtil.h"
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "Common/CommonFuncs.h"
+#include "Common/Logging/Log.h"
+
+namespace File
+{
+MappedFile::~MappedFile()
+{
+  Close();
+}
+
+bool MappedFile::Open(const std::string& filename)
+{
+  Close();
+
+#ifdef _WIN32
+  const HANDLE file = CreateFileW(UTF8ToWString(filename).c_str(), GENERIC_READ | GENERIC_WRITE,
+                                  FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING,
+                                  FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE)
+  {
+    WARN_LOG_FMT(COMMON, "Failed to open {} for mapping: {}", filename,
+                 Common::GetLastErrorString());
+    return false;
+  }
+
+  LARGE_INTEGER size;
+  HANDLE mapping = nullptr;
+  if (GetFileSizeEx(file, &size) && size.QuadPart != 0)
+    mapping = CreateFileMappingW(file, nullptr, PAGE_READWRITE, 0, 0, nullptr);
+  CloseHandle(file);
+  if (!mapping)
+  {
+    WARN_LOG_FMT(COMMON, "Failed to map {}: {}", filename, Common::GetLastErrorString());
+    return false;
+  }
+
+  // The view keeps the mapping and the file alive.
+  void* data = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, 0);
+  CloseHandle(mapping);
+  if (!data)
+  {
+    WARN_LOG_FMT(COMMON, "Failed to map {}: {}", filename, Common::GetLastErrorString());
+    return false;
+  }
+  m_size = static_cast<u64>(size.QuadPart);
+#else
+  const int fd = open(filename.c_str(), O_RDWR | O_CLOEXEC);
+  if (fd < 0)
+  {
+    WARN_LOG_FMT(COMMON, "Failed to open {} for mapping: {}", filename,
+                 Common::LastStrerrorString());
+    return false;
+  }
+
+  struct stat st;
+  void* data = MAP_FAILED;
+  if (fstat(fd, &st) == 0 && st.st_size != 0)
+    data = mmap(nullptr, st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  // The mapping keeps the file alive.
+  close(fd);
+  if (data == MAP_FAILED)
+  {
+    WARN_LOG_FMT(COMMON, "Failed to map {}: {}", filename, Common::LastStrerrorString());
+    return false;
+  }
+  m_size = static_cast<u64>(st.st_size);
+#endif
+
+  m_data = static_cast<u8*>(data);
+  return true;
+}
+
+void MappedFile::Close()
+{
+  if (!m_data)
+    return;
+
+#ifdef _WIN32
+  UnmapViewOfFile(m_data);
+#else
+  munmap(m_data, m_size);
+#endif
+  m_data = nullptr;
+  m_size = 0;
+}
+
+bool MappedFile::Flush()
+{
+  if (!m_data)
+    return false;
+
+#ifdef _WIN32
+  return FlushViewOfFile(m_data, 0) != 0;
+#else
+  return msync(m_data, m_size, MS_SYNC) == 0;
+#endif
+}
+}  // namespace File
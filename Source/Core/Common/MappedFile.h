@@ -0,0 +1,43 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <string>
+
+#include "Common/CommonTypes.h"
+
+namespace File
+{
+// Maps an existing file into memory for reading and writing. The file's size can't change while
+// it is mapped.
+class MappedFile
+{
+public:
+  MappedFile() = default;
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  bool Open(const std::string& filename);
+  void Close();
+
+  // Writes modified pages back to the file.
+  bool Flush();
+
+  bool IsOpen() const { return m_data != nullptr; }
+  u8* GetData() const { return m_data; }
+  u64 GetSize() const { return m_size; }
+
+  // Checks that [offset, offset + length) is inside the mapping.
+  bool Contains(u64 offset, u64 length) const
+  {
+    return offset <= m_size && length <= m_size - offset;
+  }
+
+private:
+  u8* m_data = nullptr;
+  u64 m_size = 0;
+};
+}  // namespace File
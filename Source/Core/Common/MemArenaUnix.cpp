@@ -16,10 +16,12 @@
 #include <sys/mman.h>
 #include <unistd.h>
 
+#include "Common/Align.h"
 #include "Common/Assert.h"
 #include "Common/CommonFuncs.h"
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
+#include "Common/MemoryUtil.h"
 #include "Common/MsgHandler.h"
 #include "Common/StringUtil.h"
 
@@ -30,6 +32,22 @@ MemArena::~MemArena() = default;
 
 void MemArena::GrabSHMSegment(size_t size, std::string_view base_name)
 {
+#ifdef __linux__
+  // Segments from shm_open live on /dev/shm, whose huge page policy is fixed by its mount options,
+  // while memfds follow transparent_hugepage/shmem_enabled and so honor MADV_HUGEPAGE.
+  if (AreHugePagesEnabled())
+  {
+    m_shm_fd = memfd_create(std::string(base_name).c_str(), MFD_CLOEXEC);
+    if (m_shm_fd != -1)
+    {
+      if (ftruncate(m_shm_fd, size) < 0)
+        ERROR_LOG_FMT(MEMMAP, "Failed to allocate low memory space");
+      return;
+    }
+    WARN_LOG_FMT(MEMMAP, "memfd_create failed: {}", strerror(errno));
+  }
+#endif
+
   const std::string file_name = fmt::format("/{}.{}", base_name, getpid());
   m_shm_fd = shm_open(file_name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
   if (m_shm_fd == -1)
@@ -57,6 +75,8 @@ void* MemArena::CreateView(s64 offset, size_t size)
   }
   else
   {
+    if (AreHugePagesEnabled())
+      AdviseHugePages(retval, size);
     return retval;
   }
 }
@@ -68,13 +88,26 @@ void MemArena::ReleaseView(void* view, size_t size)
 
 u8* MemArena::ReserveMemoryRegion(size_t memory_size)
 {
+  // Views can only be backed by huge pages where their host addresses are as aligned as their
+  // offsets into the segment, so align the region by over-reserving and trimming it.
+  const size_t padding = AreHugePagesEnabled() ? HUGE_PAGE_SIZE : 0;
   const int flags = MAP_ANON | MAP_PRIVATE;
-  void* base = mmap(nullptr, memory_size, PROT_NONE, flags, -1, 0);
+  void* base = mmap(nullptr, memory_size + padding, PROT_NONE, flags, -1, 0);
   if (base == MAP_FAILED)
   {
     PanicAlertFmt("Failed to map enough memory space: {}", LastStrerrorString());
     return nullptr;
   }
+  if (padding != 0)
+  {
+    u8* const start = static_cast<u8*>(base);
+    u8* const aligned =
+        reinterpret_cast<u8*>(AlignUp(reinterpret_cast<uintptr_t>(base), HUGE_PAGE_SIZE));
+    if (aligned != start)
+      munmap(start, aligned - start);
+    munmap(aligned + memory_size, start + memory_size + padding - (aligned + memory_size));
+    base = aligned;
+  }
   m_reserved_region = base;
   m_reserved_region_size = memory_size;
   return static_cast<u8*>(base);
@@ -99,6 +132,10 @@ void* MemArena::MapInMemoryRegion(s64 offset, size_t size, void* base)
   }
   else
   {
+    // Adjacent views of consecutive offsets are merged by the kernel as long as their flags match,
+    // so mappings made one BAT page at a time can still end up backed by huge pages.
+    if (AreHugePagesEnabled())
+      AdviseHugePages(retval, size);
     return retval;
   }
 }
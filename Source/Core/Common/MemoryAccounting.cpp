@@ -0,0 +1,83 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Common/MemoryAccounting.h"
+
+#include <array>
+#include <atomic>
+
+namespace Common::MemoryAccounting
+{
+namespace
+{
+struct Counters
+{
+  std::atomic<u64> current = 0;
+  std::atomic<u64> peak = 0;
+  std::atomic<u64> budget = 0;
+};
+
+std::array<Counters, static_cast<size_t>(Subsystem::NumSubsystems)> s_counters;
+
+Counters& GetCounters(Subsystem subsystem)
+{
+  return s_counters[static_cast<size_t>(subsystem)];
+}
+
+void UpdatePeak(Counters& counters, u64 current)
+{
+  u64 peak = counters.peak.load(std::memory_order_relaxed);
+  while (current > peak &&
+         !counters.peak.compare_exchange_weak(peak, current, std::memory_order_relaxed))
+  {
+  }
+}
+}  // namespace
+
+void Add(Subsystem subsystem, u64 bytes)
+{
+  Counters& counters = GetCounters(subsystem);
+  UpdatePeak(counters, counters.current.fetch_add(bytes, std::memory_order_relaxed) + bytes);
+}
+
+void Remove(Subsystem subsystem, u64 bytes)
+{
+  GetCounters(subsystem).current.fetch_sub(bytes, std::memory_order_relaxed);
+}
+
+void Set(Subsystem subsystem, u64 bytes)
+{
+  Counters& counters = GetCounters(subsystem);
+  counters.current.store(bytes, std::memory_order_relaxed);
+  UpdatePeak(counters, bytes);
+}
+
+void SetBudget(Subsystem subsystem, u64 bytes)
+{
+  GetCounters(subsystem).budget.store(bytes, std::memory_order_relaxed);
+}
+
+Usage GetUsage(Subsystem subsystem)
+{
+  const Counters& counters = GetCounters(subsystem);
+  return {counters.current.load(std::memory_order_relaxed),
+          counters.peak.load(std::memory_order_relaxed),
+          counters.budget.load(std::memory_order_relaxed)};
+}
+
+std::string_view GetName(Subsystem subsystem)
+{
+  static constexpr std::array<std::string_view, static_cast<size_t>(Subsystem::NumSubsystems)>
+      names{"JIT code", "Texture pool", "Custom assets", "Disc cache", "Rewind"};
+  return names[static_cast<size_t>(subsystem)];
+}
+
+void ResetPeaks()
+{
+  for (Counters& counters : s_counters)
+  {
+    const u64 current = counters.current.load(std::memory_order_relaxed);
+    counters.peak.store(current, std::memory_order_relaxed);
+  }
+}
+}  // namespace Common::MemoryAccounting
@@ -0,0 +1,44 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <string_view>
+
+#include "Common/CommonTypes.h"
+
+// Keeps track of how much host memory the larger caches and buffers use, so that it can be shown
+// in the performance overlay and the metrics endpoint. Each subsystem reports its own usage, and
+// the budget it evicts against if it has one. The functions are thread-safe.
+namespace Common::MemoryAccounting
+{
+enum class Subsystem
+{
+  JitCode,
+  TexturePool,
+  CustomAssets,
+  DiscCache,
+  Rewind,
+  NumSubsystems,
+};
+
+struct Usage
+{
+  u64 current = 0;
+  u64 peak = 0;
+  // 0 if the subsystem has no budget.
+  u64 budget = 0;
+};
+
+void Add(Subsystem subsystem, u64 bytes);
+void Remove(Subsystem subsystem, u64 bytes);
+// For subsystems that keep their own total.
+void Set(Subsystem subsystem, u64 bytes);
+void SetBudget(Subsystem subsystem, u64 bytes);
+
+Usage GetUsage(Subsystem subsystem);
+std::string_view GetName(Subsystem subsystem);
+
+// Starts measuring peaks from the current usage, e.g. when a new game is started.
+void ResetPeaks();
+}  // namespace Common::MemoryAccounting
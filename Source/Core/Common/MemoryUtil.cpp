@@ -3,10 +3,12 @@
 
 #include "Common/MemoryUtil.h"
 
+#include <atomic>
 #include <cstddef>
 #include <cstdlib>
 #include <string>
 
+#include "Common/Align.h"
 #include "Common/CommonFuncs.h"
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
@@ -20,6 +22,7 @@
 #include <stdio.h>
 #include <sys/mman.h>
 #include <sys/types.h>
+#include <unistd.h>
 #if defined __APPLE__ || defined __FreeBSD__ || defined __OpenBSD__ || defined __NetBSD__
 #include <sys/sysctl.h>
 #elif defined __HAIKU__
@@ -34,18 +37,114 @@ namespace Common
 // This is purposely not a full wrapper for virtualalloc/mmap, but it
 // provides exactly the primitive operations that Dolphin needs.
 
+static std::atomic<bool> s_huge_pages_enabled = false;
+
+void SetHugePagesEnabled(bool enabled)
+{
+  s_huge_pages_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool AreHugePagesEnabled()
+{
+  return s_huge_pages_enabled.load(std::memory_order_relaxed);
+}
+
+bool AdviseHugePages(void* ptr, size_t size)
+{
+#ifdef MADV_HUGEPAGE
+  if (madvise(ptr, size, MADV_HUGEPAGE) == 0)
+    return true;
+  WARN_LOG_FMT(MEMMAP, "madvise(MADV_HUGEPAGE) failed: {}", LastStrerrorString());
+#endif
+  return false;
+}
+
+#ifdef _WIN32
+// Large pages need SeLockMemoryPrivilege, which is only enabled in the process token on request.
+static bool EnableLockMemoryPrivilege()
+{
+  HANDLE token;
+  if (!OpenProcessToken(GetCurrentProcess(), TOKEN_ADJUST_PRIVILEGES | TOKEN_QUERY, &token))
+    return false;
+
+  TOKEN_PRIVILEGES privileges{};
+  privileges.PrivilegeCount = 1;
+  privileges.Privileges[0].Attributes = SE_PRIVILEGE_ENABLED;
+  bool result = LookupPrivilegeValue(nullptr, SE_LOCK_MEMORY_NAME, &privileges.Privileges[0].Luid);
+  if (result)
+  {
+    // AdjustTokenPrivileges succeeds even when the privilege isn't held, so check the last error.
+    result = AdjustTokenPrivileges(token, FALSE, &privileges, 0, nullptr, nullptr) &&
+             GetLastError() == ERROR_SUCCESS;
+  }
+  CloseHandle(token);
+  return result;
+}
+
+static void* AllocateLargePageExecutableMemory(size_t size)
+{
+  static const bool has_privilege = EnableLockMemoryPrivilege();
+  const size_t large_page_size = GetLargePageMinimum();
+  if (!has_privilege || large_page_size == 0)
+    return nullptr;
+
+  // Large page allocations are committed up front, and the caller only frees them as a whole.
+  return VirtualAlloc(nullptr, AlignUp(size, large_page_size),
+                      MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_EXECUTE_READWRITE);
+}
+#elif defined(MADV_HUGEPAGE)
+static void* AllocateHugePageExecutableMemory(size_t size)
+{
+  // Only ranges aligned to the huge page size can be promoted, so over-allocate and trim.
+  const size_t padded_size = size + HUGE_PAGE_SIZE;
+  void* ptr = mmap(nullptr, padded_size, PROT_READ | PROT_WRITE | PROT_EXEC, MAP_ANON | MAP_PRIVATE,
+                   -1, 0);
+  if (ptr == MAP_FAILED)
+    return nullptr;
+
+  u8* const start = static_cast<u8*>(ptr);
+  u8* const aligned = reinterpret_cast<u8*>(AlignUp(reinterpret_cast<uintptr_t>(ptr),
+                                                    HUGE_PAGE_SIZE));
+  if (aligned != start)
+    munmap(start, aligned - start);
+  munmap(aligned + size, start + padded_size - (aligned + size));
+
+  AdviseHugePages(aligned, size);
+  return aligned;
+}
+#endif
+
 void* AllocateExecutableMemory(size_t size)
 {
+  void* ptr = nullptr;
+  const bool huge_pages = AreHugePagesEnabled() && size >= HUGE_PAGE_SIZE;
+
 #if defined(_WIN32)
-  void* ptr = VirtualAlloc(nullptr, size, MEM_COMMIT, PAGE_EXECUTE_READWRITE);
+  if (huge_pages)
+  {
+    ptr = AllocateLargePageExecutableMemory(size);
+    if (!ptr)
+      WARN_LOG_FMT(MEMMAP, "Failed to allocate executable memory with large pages");
+  }
+  if (!ptr)
+    ptr = VirtualAlloc(nullptr, size, MEM_COMMIT, PAGE_EXECUTE_READWRITE);
+#else
+#ifdef MADV_HUGEPAGE
+  if (huge_pages && size % PageSize() == 0)
+    ptr = AllocateHugePageExecutableMemory(size);
 #else
-  int map_flags = MAP_ANON | MAP_PRIVATE;
+  (void)huge_pages;
+#endif
+  if (!ptr)
+  {
+    int map_flags = MAP_ANON | MAP_PRIVATE;
 #if defined(__APPLE__)
-  map_flags |= MAP_JIT;
+    map_flags |= MAP_JIT;
 #endif
-  void* ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE | PROT_EXEC, map_flags, -1, 0);
-  if (ptr == MAP_FAILED)
-    ptr = nullptr;
+    ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE | PROT_EXEC, map_flags, -1, 0);
+    if (ptr == MAP_FAILED)
+      ptr = nullptr;
+  }
 #endif
 
   if (ptr == nullptr)
@@ -289,4 +388,16 @@ size_t MemPhysical()
 #endif
 }
 
+size_t PageSize()
+{
+#ifdef _WIN32
+  SYSTEM_INFO sys_info;
+  GetSystemInfo(&sys_info);
+  return sys_info.dwPageSize;
+#else
+  static const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  return page_size;
+#endif
+}
+
 }  // namespace Common
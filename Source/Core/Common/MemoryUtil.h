@@ -8,6 +8,15 @@
 
 namespace Common
 {
+constexpr size_t HUGE_PAGE_SIZE = 0x200000;
+
+// Huge pages are opt-in, since they raise the memory use of sparsely touched regions. When enabled,
+// executable memory and the emulated RAM views are backed by them where the host supports it.
+void SetHugePagesEnabled(bool enabled);
+bool AreHugePagesEnabled();
+// Hints that a HUGE_PAGE_SIZE aligned range should be backed by transparent huge pages.
+bool AdviseHugePages(void* ptr, size_t size);
+
 void* AllocateExecutableMemory(size_t size);
 
 // These two functions control the executable/writable state of the W^X memory
@@ -34,5 +43,7 @@ bool ReadProtectMemory(void* ptr, size_t size);
 bool WriteProtectMemory(void* ptr, size_t size, bool executable = false);
 bool UnWriteProtectMemory(void* ptr, size_t size, bool allowExecute = false);
 size_t MemPhysical();
+// Returns the granularity of the protection functions above.
+size_t PageSize();
 
 }  // namespace Common
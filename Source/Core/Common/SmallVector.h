@@ -4,6 +4,7 @@
 
 #include <array>
 #include <cstddef>
+#include <stdexcept>
 #include <utility>
 
 namespace Common
@@ -29,6 +30,19 @@ public:
   T& operator[](size_t i) { return m_array[i]; }
   const T& operator[](size_t i) const { return m_array[i]; }
 
+  T& at(size_t i)
+  {
+    if (i >= m_size)
+      throw std::out_of_range("SmallVector::at");
+    return m_array[i];
+  }
+  const T& at(size_t i) const
+  {
+    if (i >= m_size)
+      throw std::out_of_range("SmallVector::at");
+    return m_array[i];
+  }
+
   auto data() { return m_array.data(); }
   auto begin() { return m_array.begin(); }
   auto end() { return m_array.begin() + m_size; }
@@ -39,6 +53,7 @@ public:
 
   size_t size() const { return m_size; }
   bool empty() const { return m_size == 0; }
+  static constexpr size_t capacity() { return MaxSize; }
 
 private:
   std::array<T, MaxSize> m_array{};
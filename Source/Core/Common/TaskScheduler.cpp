@@ -0,0 +1,201 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Common/TaskScheduler.h"
+
+#include <algorithm>
+#include <bit>
+#include <string>
+
+#include <fmt/format.h>
+
+#ifdef _WIN32
+#include <Windows.h>
+#elif defined(__linux__)
+#include <sched.h>
+#endif
+
+#include "Common/CommonTypes.h"
+#include "Common/Logging/Log.h"
+#include "Common/Thread.h"
+#include "Common/ThreadPolicy.h"
+
+namespace Common
+{
+static thread_local const TaskScheduler* t_worker_scheduler = nullptr;
+static thread_local size_t t_worker_index = 0;
+
+// Counts the cores the process is allowed to run on, which can be fewer than the host has.
+static size_t GetAvailableCoreCount()
+{
+#ifdef _WIN32
+  DWORD_PTR process_mask, system_mask;
+  if (GetProcessAffinityMask(GetCurrentProcess(), &process_mask, &system_mask) && process_mask)
+    return std::popcount(static_cast<u64>(process_mask));
+#elif defined(__linux__)
+  cpu_set_t cpu_set;
+  if (sched_getaffinity(0, sizeof(cpu_set), &cpu_set) == 0)
+    return CPU_COUNT(&cpu_set);
+#endif
+  return std::max(1U, std::thread::hardware_concurrency());
+}
+
+TaskScheduler& TaskScheduler::GetInstance()
+{
+  static TaskScheduler scheduler;
+  return scheduler;
+}
+
+TaskScheduler::TaskScheduler()
+{
+  // Leave a core for the emulated CPU thread, which is the one thread that must never wait.
+  const size_t cores = GetAvailableCoreCount();
+  const size_t worker_count = std::max<size_t>(1, cores - 1);
+  m_max_background_workers = std::max<size_t>(1, worker_count - 1);
+
+  m_workers.reserve(worker_count);
+  for (size_t i = 0; i < worker_count; ++i)
+    m_workers.push_back(std::make_unique<Worker>());
+  for (size_t i = 0; i < worker_count; ++i)
+    m_workers[i]->thread = std::thread(&TaskScheduler::WorkerThread, this, i);
+
+  INFO_LOG_FMT(COMMON, "Task scheduler started {} workers for {} available cores", worker_count,
+               cores);
+}
+
+TaskScheduler::~TaskScheduler()
+{
+  {
+    std::lock_guard lk(m_sleep_lock);
+    m_shutting_down = true;
+  }
+  m_wake.notify_all();
+
+  for (auto& worker : m_workers)
+    worker->thread.join();
+}
+
+void TaskScheduler::Submit(TaskPriority priority, std::function<void()> task)
+{
+  const size_t priority_index = static_cast<size_t>(priority);
+  const size_t index = t_worker_scheduler == this ?
+                           t_worker_index :
+                           m_next_worker.fetch_add(1, std::memory_order_relaxed) % m_workers.size();
+  {
+    Worker& worker = *m_workers[index];
+    std::lock_guard lk(worker.lock);
+    worker.queues[priority_index].push_back(std::move(task));
+  }
+  {
+    std::lock_guard lk(m_sleep_lock);
+    ++m_pending_tasks[priority_index];
+  }
+  m_wake.notify_one();
+}
+
+bool TaskScheduler::HasRunnableTask() const
+{
+  return m_pending_tasks[static_cast<size_t>(TaskPriority::RealtimeAdjacent)] != 0 ||
+         m_pending_tasks[static_cast<size_t>(TaskPriority::Interactive)] != 0 ||
+         (m_pending_tasks[static_cast<size_t>(TaskPriority::Background)] != 0 &&
+          m_background_workers < m_max_background_workers);
+}
+
+std::function<void()> TaskScheduler::TakeTask(size_t index, TaskPriority priority)
+{
+  const size_t priority_index = static_cast<size_t>(priority);
+  const size_t worker_count = m_workers.size();
+
+  // A task of this priority was reserved, so one is queued somewhere. Keep looking if another
+  // worker wins a race for the one we found, since that worker reserved another task then.
+  while (true)
+  {
+    {
+      Worker& worker = *m_workers[index];
+      std::lock_guard lk(worker.lock);
+      auto& queue = worker.queues[priority_index];
+      if (!queue.empty())
+      {
+        std::function<void()> task = std::move(queue.back());
+        queue.pop_back();
+        return task;
+      }
+    }
+
+    for (size_t i = 1; i < worker_count; ++i)
+    {
+      Worker& victim = *m_workers[(index + i) % worker_count];
+      std::lock_guard lk(victim.lock);
+      auto& queue = victim.queues[priority_index];
+      if (!queue.empty())
+      {
+        std::function<void()> task = std::move(queue.front());
+        queue.pop_front();
+        return task;
+      }
+    }
+
+    std::this_thread::yield();
+  }
+}
+
+void TaskScheduler::WorkerThread(size_t index)
+{
+  Common::SetCurrentThreadName(fmt::format("Task Worker {}", index).c_str());
+  t_worker_scheduler = this;
+  t_worker_index = index;
+
+  ThreadPolicy current_policy = ThreadPolicy::Default;
+
+  while (true)
+  {
+    TaskPriority priority;
+    {
+      std::unique_lock lk(m_sleep_lock);
+      m_wake.wait(lk, [this] { return m_shutting_down || HasRunnableTask(); });
+
+      // Queued tasks are finished before shutting down.
+      if (m_pending_tasks[static_cast<size_t>(TaskPriority::RealtimeAdjacent)] != 0)
+        priority = TaskPriority::RealtimeAdjacent;
+      else if (m_pending_tasks[static_cast<size_t>(TaskPriority::Interactive)] != 0)
+        priority = TaskPriority::Interactive;
+      else if (m_pending_tasks[static_cast<size_t>(TaskPriority::Background)] != 0 &&
+               m_background_workers < m_max_background_workers)
+        priority = TaskPriority::Background;
+      else
+        return;
+
+      --m_pending_tasks[static_cast<size_t>(priority)];
+      if (priority == TaskPriority::Background)
+        ++m_background_workers;
+    }
+
+    // Background work follows the policy of the background role, so that it keeps off the cores
+    // the emulation threads prefer.
+    ThreadPolicy policy = ThreadPolicy::Default;
+    if (priority == TaskPriority::RealtimeAdjacent)
+      policy = ThreadPolicy::Performance;
+    else if (priority == TaskPriority::Background)
+      policy = GetThreadRolePolicy(ThreadRole::Background);
+    if (policy != current_policy)
+    {
+      SetCurrentThreadPolicy(policy);
+      current_policy = policy;
+    }
+
+    TakeTask(index, priority)();
+
+    if (priority == TaskPriority::Background)
+    {
+      bool has_runnable_task;
+      {
+        std::lock_guard lk(m_sleep_lock);
+        --m_background_workers;
+        has_runnable_task = HasRunnableTask();
+      }
+      if (has_runnable_task)
+        m_wake.notify_one();
+    }
+  }
+}
+}  // namespace Common
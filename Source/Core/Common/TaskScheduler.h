@@ -0,0 +1,91 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// A process-wide pool of worker threads, sized to the cores the process may run on, that
+// subsystems share instead of each starting their own threads.
+
+namespace Common
+{
+enum class TaskPriority
+{
+  // Work that emulation is waiting on, e.g. something needed before the next frame.
+  RealtimeAdjacent,
+  // Work that the user is waiting on.
+  Interactive,
+  // Bulk work like disc conversion or verification. Never gets every worker, so that there's
+  // always one left for the other classes.
+  Background,
+};
+
+class TaskScheduler
+{
+public:
+  static TaskScheduler& GetInstance();
+
+  TaskScheduler(const TaskScheduler&) = delete;
+  TaskScheduler& operator=(const TaskScheduler&) = delete;
+
+  // Tasks submitted from a worker go to that worker's own queue, where they're run
+  // last-in-first-out unless idle workers steal them.
+  void Submit(TaskPriority priority, std::function<void()> task);
+
+  template <typename F>
+  auto SubmitWithFuture(TaskPriority priority, F&& function)
+      -> std::future<std::invoke_result_t<std::decay_t<F>>>
+  {
+    using Result = std::invoke_result_t<std::decay_t<F>>;
+    auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(function));
+    std::future<Result> future = task->get_future();
+    Submit(priority, [task] { (*task)(); });
+    return future;
+  }
+
+  size_t GetWorkerCount() const { return m_workers.size(); }
+
+private:
+  static constexpr size_t NUM_PRIORITIES = 3;
+
+  struct Worker
+  {
+    std::thread thread;
+    std::mutex lock;
+    std::array<std::deque<std::function<void()>>, NUM_PRIORITIES> queues;
+  };
+
+  TaskScheduler();
+  ~TaskScheduler();
+
+  void WorkerThread(size_t index);
+  // Must be called with m_sleep_lock held.
+  bool HasRunnableTask() const;
+  std::function<void()> TakeTask(size_t index, TaskPriority priority);
+
+  std::vector<std::unique_ptr<Worker>> m_workers;
+  size_t m_max_background_workers = 1;
+  std::atomic<size_t> m_next_worker = 0;
+
+  // Tasks are counted when they're queued and reserved by a worker before it looks for one, so
+  // that idle workers can sleep until there's something they're allowed to run.
+  std::mutex m_sleep_lock;
+  std::condition_variable m_wake;
+  std::array<size_t, NUM_PRIORITIES> m_pending_tasks{};
+  size_t m_background_workers = 0;
+  bool m_shutting_down = false;
+};
+}  // namespace Common
@@ -0,0 +1,268 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Common/ThreadPolicy.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+#include <fmt/ranges.h>
+
+#ifdef _WIN32
+#include <Windows.h>
+#elif defined(__APPLE__)
+#include <pthread.h>
+#include <sys/qos.h>
+#elif defined(__linux__)
+#include <sched.h>
+#endif
+
+#include "Common/CommonFuncs.h"
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/Logging/Log.h"
+
+namespace Common
+{
+static std::array<std::atomic<ThreadPolicy>, 4> s_role_policies{
+    ThreadPolicy::Performance, ThreadPolicy::Performance, ThreadPolicy::Default,
+    ThreadPolicy::Efficiency};
+
+void SetThreadRolePolicy(ThreadRole role, ThreadPolicy policy)
+{
+  s_role_policies[static_cast<size_t>(role)].store(policy, std::memory_order_relaxed);
+}
+
+ThreadPolicy GetThreadRolePolicy(ThreadRole role)
+{
+  return s_role_policies[static_cast<size_t>(role)].load(std::memory_order_relaxed);
+}
+
+void SetCurrentThreadRole(ThreadRole role)
+{
+  SetCurrentThreadPolicy(GetThreadRolePolicy(role));
+}
+
+#if defined(_WIN32) || defined(__linux__)
+#ifdef _WIN32
+using ProcessorId = ULONG;
+#else
+using ProcessorId = int;
+#endif
+
+struct ProcessorSets
+{
+  std::vector<ProcessorId> performance;
+  std::vector<ProcessorId> efficiency;
+  std::vector<ProcessorId> all;
+};
+
+struct ProcessorInfo
+{
+  ProcessorId id;
+  u32 performance_class;
+  bool is_first_sibling;
+};
+
+// Higher performance classes are faster. The efficiency set stays empty on CPUs with one class.
+static ProcessorSets SortProcessors(const std::vector<ProcessorInfo>& processors)
+{
+  ProcessorSets sets;
+  if (processors.empty())
+    return sets;
+
+  const auto [min, max] = std::ranges::minmax(processors, {}, &ProcessorInfo::performance_class);
+  for (const ProcessorInfo& processor : processors)
+  {
+    sets.all.push_back(processor.id);
+    if (processor.performance_class == max.performance_class && processor.is_first_sibling)
+      sets.performance.push_back(processor.id);
+    else if (processor.performance_class != max.performance_class)
+      sets.efficiency.push_back(processor.id);
+  }
+
+  INFO_LOG_FMT(COMMON, "Performance processors: {}, efficiency processors: {}",
+               fmt::join(sets.performance, ","), fmt::join(sets.efficiency, ","));
+  return sets;
+}
+#endif
+
+#ifdef _WIN32
+static ProcessorSets DetectProcessorSets()
+{
+  ULONG size = 0;
+  GetSystemCpuSetInformation(nullptr, 0, &size, GetCurrentProcess(), 0);
+  std::vector<u8> buffer(size);
+  auto* const first = reinterpret_cast<SYSTEM_CPU_SET_INFORMATION*>(buffer.data());
+  if (size == 0 || !GetSystemCpuSetInformation(first, size, &size, GetCurrentProcess(), 0))
+    return {};
+
+  std::vector<ProcessorInfo> processors;
+  std::vector<std::pair<BYTE, BYTE>> seen_cores;
+  for (ULONG offset = 0; offset < size;)
+  {
+    const auto* info = reinterpret_cast<const SYSTEM_CPU_SET_INFORMATION*>(&buffer[offset]);
+    offset += info->Size;
+    if (info->Type != CpuSetInformation)
+      continue;
+
+    // Logical processors of the same physical core share a core index within their group.
+    const std::pair<BYTE, BYTE> core{info->CpuSet.Group, info->CpuSet.CoreIndex};
+    const bool is_first_sibling =
+        std::find(seen_cores.begin(), seen_cores.end(), core) == seen_cores.end();
+    if (is_first_sibling)
+      seen_cores.push_back(core);
+
+    processors.push_back({info->CpuSet.Id, info->CpuSet.EfficiencyClass, is_first_sibling});
+  }
+
+  return SortProcessors(processors);
+}
+#elif defined(__linux__)
+// Parses lists like "0-3,8,10-11" from sysfs.
+static std::vector<int> ParseProcessorList(const std::string& list)
+{
+  std::vector<int> result;
+  const char* str = list.c_str();
+  while (*str >= '0' && *str <= '9')
+  {
+    char* end;
+    const int first = static_cast<int>(std::strtol(str, &end, 10));
+    int last = first;
+    if (*end == '-')
+      last = static_cast<int>(std::strtol(end + 1, &end, 10));
+    for (int i = first; i <= last; ++i)
+      result.push_back(i);
+    str = *end == ',' ? end + 1 : end;
+  }
+  return result;
+}
+
+static std::vector<int> ReadProcessorList(const std::string& path)
+{
+  std::string list;
+  if (!File::ReadFileToString(path, list))
+    return {};
+  return ParseProcessorList(list);
+}
+
+static ProcessorSets DetectProcessorSets()
+{
+  cpu_set_t allowed;
+  if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0)
+    return {};
+
+  // Intel hybrid CPUs expose a PMU per core type, while on ARM the scheduler's capacity of each
+  // processor tells the clusters apart.
+  const std::vector<int> intel_performance_cores = ReadProcessorList("/sys/devices/cpu_core/cpus");
+
+  std::vector<ProcessorInfo> processors;
+  for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+  {
+    if (!CPU_ISSET(cpu, &allowed))
+      continue;
+
+    const std::string cpu_path = fmt::format("/sys/devices/system/cpu/cpu{}/", cpu);
+
+    u32 performance_class = 0;
+    std::string capacity;
+    if (!intel_performance_cores.empty())
+    {
+      const bool is_performance_core =
+          std::ranges::find(intel_performance_cores, cpu) != intel_performance_cores.end();
+      performance_class = is_performance_core ? 1 : 0;
+    }
+    else if (File::ReadFileToString(cpu_path + "cpu_capacity", capacity))
+    {
+      performance_class = static_cast<u32>(std::strtoul(capacity.c_str(), nullptr, 10));
+    }
+
+    const std::vector<int> siblings = ReadProcessorList(cpu_path + "topology/thread_siblings_list");
+    const bool is_first_sibling = siblings.empty() || siblings.front() == cpu;
+
+    processors.push_back({cpu, performance_class, is_first_sibling});
+  }
+
+  return SortProcessors(processors);
+}
+#endif
+
+#if defined(_WIN32) || defined(__linux__)
+static const ProcessorSets& GetProcessorSets()
+{
+  static const ProcessorSets sets = DetectProcessorSets();
+  return sets;
+}
+
+static const std::vector<ProcessorId>& GetProcessorsForPolicy(ThreadPolicy policy)
+{
+  const ProcessorSets& sets = GetProcessorSets();
+  if (policy == ThreadPolicy::Performance && !sets.performance.empty())
+    return sets.performance;
+  if (policy == ThreadPolicy::Efficiency && !sets.efficiency.empty())
+    return sets.efficiency;
+  return sets.all;
+}
+#endif
+
+void SetCurrentThreadPolicy(ThreadPolicy policy)
+{
+#ifdef _WIN32
+  // An empty selection lets the thread run on any processor again.
+  static const std::vector<ProcessorId> no_processors;
+  const std::vector<ProcessorId>& processors =
+      policy == ThreadPolicy::Default ? no_processors : GetProcessorsForPolicy(policy);
+  if (!SetThreadSelectedCpuSets(GetCurrentThread(), processors.data(),
+                                static_cast<ULONG>(processors.size())))
+  {
+    WARN_LOG_FMT(COMMON, "SetThreadSelectedCpuSets failed: {}", GetLastError());
+  }
+
+  // Turning execution speed throttling off explicitly opts out of EcoQoS, while leaving it out of
+  // the control mask lets the OS decide.
+  THREAD_POWER_THROTTLING_STATE state{};
+  state.Version = THREAD_POWER_THROTTLING_CURRENT_VERSION;
+  if (policy != ThreadPolicy::Default)
+    state.ControlMask = THREAD_POWER_THROTTLING_EXECUTION_SPEED;
+  if (policy == ThreadPolicy::Efficiency)
+    state.StateMask = THREAD_POWER_THROTTLING_EXECUTION_SPEED;
+  SetThreadInformation(GetCurrentThread(), ThreadPowerThrottling, &state, sizeof(state));
+#elif defined(__APPLE__)
+  // macOS doesn't support affinity, but picks the cluster based on the QoS class.
+  qos_class_t qos_class = QOS_CLASS_DEFAULT;
+  if (policy == ThreadPolicy::Performance)
+    qos_class = QOS_CLASS_USER_INTERACTIVE;
+  else if (policy == ThreadPolicy::Efficiency)
+    qos_class = QOS_CLASS_UTILITY;
+  pthread_set_qos_class_self_np(qos_class, 0);
+#elif defined(__linux__)
+  const std::vector<ProcessorId>& processors = GetProcessorsForPolicy(policy);
+  if (!processors.empty())
+  {
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    for (const ProcessorId processor : processors)
+      CPU_SET(processor, &cpu_set);
+    if (sched_setaffinity(0, sizeof(cpu_set), &cpu_set) != 0)
+      WARN_LOG_FMT(COMMON, "sched_setaffinity failed: {}", LastStrerrorString());
+  }
+
+  // SCHED_BATCH tells the scheduler that the thread isn't latency sensitive. Raising the priority
+  // of the other policies would need privileges that Dolphin doesn't have.
+  const int current_policy = sched_getscheduler(0);
+  const int new_policy = policy == ThreadPolicy::Efficiency ? SCHED_BATCH : SCHED_OTHER;
+  if ((current_policy == SCHED_OTHER || current_policy == SCHED_BATCH) &&
+      current_policy != new_policy)
+  {
+    const sched_param param{};
+    sched_setscheduler(0, new_policy, &param);
+  }
+#endif
+}
+}  // namespace Common
@@ -0,0 +1,37 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+// Maps what a thread does to where and how eagerly the OS should schedule it, so that the
+// emulation threads end up on the fast cores of hybrid CPUs and bulk work stays off them.
+
+namespace Common
+{
+enum class ThreadRole
+{
+  EmulatedCPU,
+  GPU,
+  Audio,
+  Background,
+};
+
+enum class ThreadPolicy
+{
+  // Clears any affinity and QoS hint, leaving the thread to the OS.
+  Default,
+  // Prefers the highest performance class of cores, one logical processor per physical core so
+  // that the thread doesn't share a core with its SMT sibling, and asks for high QoS.
+  Performance,
+  // Prefers the efficiency cores of hybrid CPUs and asks for low QoS.
+  Efficiency,
+};
+
+// Sets the policy that SetCurrentThreadRole applies to threads of the given role.
+void SetThreadRolePolicy(ThreadRole role, ThreadPolicy policy);
+ThreadPolicy GetThreadRolePolicy(ThreadRole role);
+
+// Applies the policy of the given role to the calling thread.
+void SetCurrentThreadRole(ThreadRole role);
+void SetCurrentThreadPolicy(ThreadPolicy policy);
+}  // namespace Common
@@ -0,0 +1,192 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Common/TraceZone.h"
+
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
+
+namespace Common::Trace
+{
+namespace
+{
+struct ZoneRecord
+{
+  const char* name;
+  std::chrono::steady_clock::time_point start;
+  std::chrono::steady_clock::time_point end;
+};
+
+struct ThreadRecords
+{
+  u32 id = 0;
+  std::mutex lock;
+  std::string name;
+  std::vector<ZoneRecord> zones;
+};
+
+// Bounds the memory that a long capture can take, at 24 MiB per thread.
+constexpr size_t MAX_ZONES_PER_THREAD = 1 << 20;
+
+std::mutex s_threads_lock;
+std::vector<std::shared_ptr<ThreadRecords>> s_threads;
+u32 s_next_thread_id = 1;
+std::chrono::steady_clock::time_point s_capture_start;
+std::atomic<u64> s_dropped_zones = 0;
+
+ThreadRecords& GetThreadRecords()
+{
+  static thread_local const std::shared_ptr<ThreadRecords> t_records = [] {
+    auto records = std::make_shared<ThreadRecords>();
+    std::lock_guard lk(s_threads_lock);
+    records->id = s_next_thread_id++;
+    s_threads.push_back(records);
+    return records;
+  }();
+  return *t_records;
+}
+
+std::string EscapeJson(std::string_view str)
+{
+  std::string result;
+  result.reserve(str.size());
+  for (const char c : str)
+  {
+    if (c == '"' || c == '\\')
+      result += '\\';
+    if (static_cast<unsigned char>(c) >= 0x20)
+      result += c;
+  }
+  return result;
+}
+}  // namespace
+
+std::atomic<bool> detail::s_capturing = false;
+
+void StartCapture()
+{
+  std::lock_guard lk(s_threads_lock);
+
+  // Only the capture is left holding the records of threads that have exited.
+  std::erase_if(s_threads, [](const std::shared_ptr<ThreadRecords>& records) {
+    return records.use_count() == 1;
+  });
+  for (const auto& records : s_threads)
+  {
+    std::lock_guard records_lk(records->lock);
+    records->zones.clear();
+  }
+
+  s_dropped_zones.store(0, std::memory_order_relaxed);
+  s_capture_start = std::chrono::steady_clock::now();
+  detail::s_capturing.store(true, std::memory_order_release);
+  INFO_LOG_FMT(COMMON, "Started capturing trace zones");
+}
+
+bool StopCapture(const std::string& path)
+{
+  std::vector<std::shared_ptr<ThreadRecords>> threads;
+  std::chrono::steady_clock::time_point capture_start;
+  {
+    std::lock_guard lk(s_threads_lock);
+    if (!detail::s_capturing.exchange(false, std::memory_order_acq_rel))
+      return false;
+    threads = s_threads;
+    capture_start = s_capture_start;
+  }
+
+  File::IOFile file(path, "wb");
+  if (!file)
+  {
+    ERROR_LOG_FMT(COMMON, "Failed to open {} for writing the trace", path);
+    return false;
+  }
+
+  const auto to_microseconds = [capture_start](std::chrono::steady_clock::time_point time) {
+    return std::chrono::duration<double, std::micro>(time - capture_start).count();
+  };
+
+  bool success = file.WriteString("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+  bool first_event = true;
+  size_t zone_count = 0;
+  for (const auto& records : threads)
+  {
+    std::string name;
+    std::vector<ZoneRecord> zones;
+    {
+      std::lock_guard lk(records->lock);
+      name = records->name;
+      zones.swap(records->zones);
+    }
+    if (zones.empty())
+      continue;
+
+    std::string events;
+    if (!name.empty())
+    {
+      events += fmt::format("{}{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":{},"
+                            "\"args\":{{\"name\":\"{}\"}}}}",
+                            first_event ? "" : ",\n", records->id, EscapeJson(name));
+      first_event = false;
+    }
+
+    for (const ZoneRecord& zone : zones)
+    {
+      // Zones that started before this capture belong to an earlier one.
+      if (zone.start < capture_start)
+        continue;
+
+      events += fmt::format(
+          "{}{{\"name\":\"{}\",\"ph\":\"X\",\"pid\":1,\"tid\":{},\"ts\":{:.3f},\"dur\":{:.3f}}}",
+          first_event ? "" : ",\n", zone.name, records->id, to_microseconds(zone.start),
+          to_microseconds(zone.end) - to_microseconds(zone.start));
+      first_event = false;
+      ++zone_count;
+    }
+    success &= file.WriteString(events);
+  }
+  success &= file.WriteString("\n]}\n");
+
+  const u64 dropped_zones = s_dropped_zones.load(std::memory_order_relaxed);
+  if (dropped_zones != 0)
+    WARN_LOG_FMT(COMMON, "Dropped {} trace zones after a thread's buffer filled up", dropped_zones);
+  INFO_LOG_FMT(COMMON, "Wrote {} trace zones to {}", zone_count, path);
+  return success;
+}
+
+bool IsCapturing()
+{
+  return detail::s_capturing.load(std::memory_order_relaxed);
+}
+
+void SetCurrentThreadName(const char* name)
+{
+  ThreadRecords& records = GetThreadRecords();
+  std::lock_guard lk(records.lock);
+  records.name = name;
+}
+
+void detail::RecordZone(const char* name, std::chrono::steady_clock::time_point start)
+{
+  const auto end = std::chrono::steady_clock::now();
+  if (!s_capturing.load(std::memory_order_relaxed))
+    return;
+
+  ThreadRecords& records = GetThreadRecords();
+  std::lock_guard lk(records.lock);
+  if (records.zones.size() >= MAX_ZONES_PER_THREAD)
+  {
+    s_dropped_zones.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  records.zones.push_back({name, start, end});
+}
+}  // namespace Common::Trace
@@ -0,0 +1,67 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+// Instrumentation zones that are recorded per thread and written out as a Chrome trace, which
+// chrome://tracing, Perfetto and Tracy's importer can show as a timeline of every thread.
+//
+// Zones are only compiled in when building with USE_TRACE_ZONES (the ENABLE_TRACE_ZONES CMake
+// option). Even then, they cost a relaxed atomic load unless a capture is running.
+
+#include <atomic>
+#include <chrono>
+#include <string>
+
+namespace Common::Trace
+{
+// Starts recording zones. Any previous capture that wasn't stopped is discarded.
+void StartCapture();
+// Stops recording and writes what was recorded to the given file.
+bool StopCapture(const std::string& path);
+bool IsCapturing();
+
+// Called by Common::SetCurrentThreadName, so that the trace shows what each thread is.
+void SetCurrentThreadName(const char* name);
+
+namespace detail
+{
+extern std::atomic<bool> s_capturing;
+void RecordZone(const char* name, std::chrono::steady_clock::time_point start);
+}  // namespace detail
+
+class Zone
+{
+public:
+  // name must be a string literal, since it's only read when the capture is written.
+  explicit Zone(const char* name) : m_name(name)
+  {
+    if (detail::s_capturing.load(std::memory_order_relaxed))
+      m_start = std::chrono::steady_clock::now();
+  }
+  ~Zone()
+  {
+    if (m_start != std::chrono::steady_clock::time_point{})
+      detail::RecordZone(m_name, m_start);
+  }
+
+  Zone(const Zone&) = delete;
+  Zone& operator=(const Zone&) = delete;
+
+private:
+  const char* m_name;
+  std::chrono::steady_clock::time_point m_start{};
+};
+}  // namespace Common::Trace
+
+#ifdef USE_TRACE_ZONES
+#define TRACE_ZONE_CONCAT_IMPL(a, b) a##b
+#define TRACE_ZONE_CONCAT(a, b) TRACE_ZONE_CONCAT_IMPL(a, b)
+// Records the time from this point to the end of the enclosing scope.
+#define TRACE_ZONE(name) const Common::Trace::Zone TRACE_ZONE_CONCAT(trace_zone_, __LINE__)(name)
+#else
+#define TRACE_ZONE(name)                                                                           \
+  do                                                                                               \
+  {                                                                                                \
+  } while (0)
+#endif
@@ -1860,12 +1860,11 @@ static int GetVEXpp(u8 opPrefix)
 }
 
 void XEmitter::WriteVEXOp(u8 opPrefix, u16 op, X64Reg regOp1, X64Reg regOp2, const OpArg& arg,
-                          int W, int extrabytes)
+                          int W, int extrabytes, int L)
 {
   int mmmmm = GetVEXmmmmm(op);
   int pp = GetVEXpp(opPrefix);
-  // FIXME: we currently don't support 256-bit instructions, and "size" is not the vector size here
-  arg.WriteVEX(this, regOp1, regOp2, 0, pp, mmmmm, W);
+  arg.WriteVEX(this, regOp1, regOp2, L, pp, mmmmm, W);
   Write8(op & 0xFF);
   arg.WriteRest(this, extrabytes, regOp1);
 }
@@ -1893,6 +1892,14 @@ void XEmitter::WriteAVXOp4(u8 opPrefix, u16 op, X64Reg regOp1, X64Reg regOp2, co
   WriteVEXOp4(opPrefix, op, regOp1, regOp2, arg, regOp3, W);
 }
 
+void XEmitter::WriteAVX2Op(u8 opPrefix, u16 op, X64Reg regOp1, X64Reg regOp2, const OpArg& arg,
+                           int L, int extrabytes)
+{
+  if (!cpu_info.bAVX2)
+    PanicAlertFmt("Trying to use AVX2 on a system that doesn't support it. Bad programmer.");
+  WriteVEXOp(opPrefix, op, regOp1, regOp2, arg, 0, extrabytes, L);
+}
+
 void XEmitter::WriteFMA3Op(u8 op, X64Reg regOp1, X64Reg regOp2, const OpArg& arg, int W)
 {
   if (!cpu_info.bFMA)
@@ -3049,6 +3056,70 @@ void XEmitter::VPXOR(X64Reg regOp1, X64Reg regOp2, const OpArg& arg)
   WriteAVXOp(0x66, 0xEF, regOp1, regOp2, arg);
 }
 
+void XEmitter::VMOVD_xmm(X64Reg dest, const OpArg& arg)
+{
+  WriteAVXOp(0x66, 0x6E, dest, INVALID_REG, arg);
+}
+void XEmitter::VMOVQ_xmm(X64Reg dest, const OpArg& arg)
+{
+  WriteAVXOp(0xF3, 0x7E, dest, INVALID_REG, arg);
+}
+void XEmitter::VMOVDQU(X64Reg dest, const OpArg& arg)
+{
+  WriteAVXOp(0xF3, 0x6F, dest, INVALID_REG, arg);
+}
+void XEmitter::VMOVSS(const OpArg& arg, X64Reg src)
+{
+  WriteAVXOp(0xF3, 0x11, src, INVALID_REG, arg);
+}
+void XEmitter::VMOVLPS(const OpArg& arg, X64Reg src)
+{
+  WriteAVXOp(0x00, 0x13, src, INVALID_REG, arg);
+}
+void XEmitter::VMOVUPS(const OpArg& arg, X64Reg src)
+{
+  WriteAVXOp(0x00, 0x11, src, INVALID_REG, arg);
+}
+void XEmitter::VZEROUPPER()
+{
+  Write8(0xC5);
+  Write8(0xF8);
+  Write8(0x77);
+}
+
+void XEmitter::VINSERTI128(X64Reg regOp1, X64Reg regOp2, const OpArg& arg, u8 lane)
+{
+  WriteAVX2Op(0x66, 0x3A38, regOp1, regOp2, arg, 1, 1);
+  Write8(lane);
+}
+void XEmitter::VEXTRACTI128(const OpArg& arg, X64Reg src, u8 lane)
+{
+  WriteAVX2Op(0x66, 0x3A39, src, INVALID_REG, arg, 1, 1);
+  Write8(lane);
+}
+void XEmitter::VBROADCASTI128(X64Reg dest, const OpArg& arg)
+{
+  ASSERT_MSG(DYNA_REC, !arg.IsSimpleReg(), "VBROADCASTI128 only takes a memory operand");
+  WriteAVX2Op(0x66, 0x385A, dest, INVALID_REG, arg, 1);
+}
+void XEmitter::VPSHUFB_256(X64Reg regOp1, X64Reg regOp2, const OpArg& arg)
+{
+  WriteAVX2Op(0x66, 0x3800, regOp1, regOp2, arg, 1);
+}
+void XEmitter::VPSRAD_256(X64Reg dest, X64Reg src, u8 shift)
+{
+  WriteAVX2Op(0x66, 0x72, (X64Reg)4, dest, R(src), 1, 1);
+  Write8(shift);
+}
+void XEmitter::VCVTDQ2PS_256(X64Reg dest, const OpArg& arg)
+{
+  WriteAVX2Op(0x00, 0x5B, dest, INVALID_REG, arg, 1);
+}
+void XEmitter::VMULPS_256(X64Reg regOp1, X64Reg regOp2, const OpArg& arg)
+{
+  WriteAVX2Op(0x00, sseMUL, regOp1, regOp2, arg, 1);
+}
+
 void XEmitter::VFMADD132PS(X64Reg regOp1, X64Reg regOp2, const OpArg& arg)
 {
   WriteFMA3Op(0x98, regOp1, regOp2, arg);
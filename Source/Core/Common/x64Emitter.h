@@ -357,13 +357,15 @@ private:
   void WriteSSSE3Op(u8 opPrefix, u16 op, X64Reg regOp, const OpArg& arg, int extrabytes = 0);
   void WriteSSE41Op(u8 opPrefix, u16 op, X64Reg regOp, const OpArg& arg, int extrabytes = 0);
   void WriteVEXOp(u8 opPrefix, u16 op, X64Reg regOp1, X64Reg regOp2, const OpArg& arg, int W = 0,
-                  int extrabytes = 0);
+                  int extrabytes = 0, int L = 0);
   void WriteVEXOp4(u8 opPrefix, u16 op, X64Reg regOp1, X64Reg regOp2, const OpArg& arg,
                    X64Reg regOp3, int W = 0);
   void WriteAVXOp(u8 opPrefix, u16 op, X64Reg regOp1, X64Reg regOp2, const OpArg& arg, int W = 0,
                   int extrabytes = 0);
   void WriteAVXOp4(u8 opPrefix, u16 op, X64Reg regOp1, X64Reg regOp2, const OpArg& arg,
                    X64Reg regOp3, int W = 0);
+  void WriteAVX2Op(u8 opPrefix, u16 op, X64Reg regOp1, X64Reg regOp2, const OpArg& arg, int L,
+                   int extrabytes = 0);
   void WriteFMA3Op(u8 op, X64Reg regOp1, X64Reg regOp2, const OpArg& arg, int W = 0);
   void WriteFMA4Op(u8 op, X64Reg dest, X64Reg regOp1, X64Reg regOp2, const OpArg& arg, int W = 0);
   void WriteBMIOp(int size, u8 opPrefix, u16 op, X64Reg regOp1, X64Reg regOp2, const OpArg& arg,
@@ -877,6 +879,25 @@ public:
   void VPOR(X64Reg regOp1, X64Reg regOp2, const OpArg& arg);
   void VPXOR(X64Reg regOp1, X64Reg regOp2, const OpArg& arg);
 
+  // VEX-encoded moves, for use in code which keeps the upper halves of the YMM registers dirty.
+  void VMOVD_xmm(X64Reg dest, const OpArg& arg);
+  void VMOVQ_xmm(X64Reg dest, const OpArg& arg);
+  void VMOVDQU(X64Reg dest, const OpArg& arg);
+  void VMOVSS(const OpArg& arg, X64Reg src);
+  void VMOVLPS(const OpArg& arg, X64Reg src);
+  void VMOVUPS(const OpArg& arg, X64Reg src);
+  void VZEROUPPER();
+
+  // AVX2: 256-bit forms. The registers are the YMM registers aliasing the given XMM registers,
+  // except for the 128-bit operands of VINSERTI128/VEXTRACTI128.
+  void VINSERTI128(X64Reg regOp1, X64Reg regOp2, const OpArg& arg, u8 lane);
+  void VEXTRACTI128(const OpArg& arg, X64Reg src, u8 lane);
+  void VBROADCASTI128(X64Reg dest, const OpArg& arg);
+  void VPSHUFB_256(X64Reg regOp1, X64Reg regOp2, const OpArg& arg);
+  void VPSRAD_256(X64Reg dest, X64Reg src, u8 shift);
+  void VCVTDQ2PS_256(X64Reg dest, const OpArg& arg);
+  void VMULPS_256(X64Reg regOp1, X64Reg regOp2, const OpArg& arg);
+
   // FMA3
   void VFMADD132PS(X64Reg regOp1, X64Reg regOp2, const OpArg& arg);
   void VFMADD213PS(X64Reg regOp1, X64Reg regOp2, const OpArg& arg);
@@ -6,7 +6,9 @@
 #include "Core/AchievementManager.h"
 
 #include <cctype>
+#include <cstring>
 #include <memory>
+#include <span>
 
 #include <fmt/format.h>
 
@@ -227,7 +229,11 @@ void AchievementManager::DoFrame()
     return;
   {
     std::lock_guard lg{m_lock};
+    // The conditions are evaluated on this thread, so memory can be peeked at directly.
+    auto& memory = Core::System::GetInstance().GetMemory();
+    m_frame_ram = {memory.GetRAM(), memory.GetRamSizeReal()};
     rc_client_do_frame(m_client);
+    m_frame_ram = {};
   }
   if (!m_system)
     return;
@@ -943,6 +949,17 @@ u32 AchievementManager::MemoryPeeker(u32 address, u8* buffer, u32 num_bytes, rc_
 {
   if (buffer == nullptr)
     return 0u;
+
+  // rc_client peeks at every memory reference once per frame, so the common case of reading RAM
+  // during DoFrame mustn't go through the MMU byte by byte.
+  const std::span<const u8> frame_ram = GetInstance().m_frame_ram;
+  if (address < frame_ram.size() && num_bytes <= frame_ram.size() - address &&
+      Core::IsCPUThread())
+  {
+    std::memcpy(buffer, frame_ram.data() + address, num_bytes);
+    return num_bytes;
+  }
+
   auto& system = Core::System::GetInstance();
   if (!(Core::IsHostThread() || Core::IsCPUThread()))
   {
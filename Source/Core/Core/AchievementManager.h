@@ -12,6 +12,7 @@
 #include <memory>
 #include <mutex>
 #include <set>
+#include <span>
 #include <string>
 #include <string_view>
 #include <thread>
@@ -186,6 +187,8 @@ private:
   rc_runtime_t m_runtime{};
   rc_client_t* m_client{};
   Core::System* m_system{};
+  // Emulated RAM, while DoFrame is evaluating the conditions
+  std::span<const u8> m_frame_ram;
   bool m_is_runtime_initialized = false;
   UpdateCallback m_update_callback = [](const UpdatedItems&) {};
   std::unique_ptr<DiscIO::Volume> m_loading_volume;
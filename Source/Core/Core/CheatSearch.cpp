@@ -3,18 +3,24 @@
 
 #include "Core/CheatSearch.h"
 
+#include <algorithm>
+#include <atomic>
 #include <bit>
+#include <cstring>
 #include <functional>
 #include <memory>
 #include <optional>
 #include <string>
+#include <thread>
 #include <type_traits>
+#include <utility>
 #include <variant>
 #include <vector>
 
 #include "Common/Align.h"
 #include "Common/Assert.h"
 #include "Common/StringUtil.h"
+#include "Common/Swap.h"
 
 #include "Core/AchievementManager.h"
 #include "Core/Core.h"
@@ -200,17 +206,151 @@ TryReadValueFromEmulatedMemory(const Core::CPUThreadGuard& guard, u32 addr,
 }
 }  // namespace
 
+namespace
+{
+// Searches go through memory one page at a time, reading directly from RAM whenever the page is
+// backed by it in the requested address space.
+constexpr u32 SEARCH_PAGE_SIZE = PowerPC::HW_PAGE_SIZE;
+// Number of values that each thread filters at a time.
+constexpr u64 VALUES_PER_CHUNK = 1 << 18;
+
+// Returns the host pointer to the page of RAM or EXRAM that contains the given page-aligned
+// address, or nullptr if reads from the page have to go through the MMU.
+const u8* GetHostPage(const Core::CPUThreadGuard& guard, u32 address,
+                      PowerPC::RequestedAddressSpace address_space)
+{
+  auto& system = guard.GetSystem();
+  const auto& ppc_state = system.GetPPCState();
+
+  // Reads from RAM go through the data cache when it's emulated.
+  if (ppc_state.m_enable_dcache)
+    return nullptr;
+
+  if (address_space == PowerPC::RequestedAddressSpace::Virtual ||
+      (address_space == PowerPC::RequestedAddressSpace::Effective && ppc_state.msr.DR))
+  {
+    const std::optional<u32> physical_address = system.GetMMU().GetTranslatedAddress(address);
+    if (!physical_address)
+      return nullptr;
+    address = *physical_address;
+  }
+
+  auto& memory = system.GetMemory();
+  if (memory.GetRAM() && address < memory.GetRamSizeReal())
+    return memory.GetRAM() + address;
+  if (memory.GetEXRAM() && (address >> 28) == 0x1 &&
+      (address & 0x0FFFFFFF) < memory.GetExRamSizeReal())
+  {
+    return memory.GetEXRAM() + (address & 0x0FFFFFFF);
+  }
+  return nullptr;
+}
+
+Cheats::SearchResultValueState GetReadValueState(const Core::CPUThreadGuard& guard,
+                                                 PowerPC::RequestedAddressSpace address_space)
+{
+  const bool translated =
+      address_space == PowerPC::RequestedAddressSpace::Virtual ||
+      (address_space == PowerPC::RequestedAddressSpace::Effective &&
+       guard.GetSystem().GetPPCState().msr.DR);
+  return translated ? Cheats::SearchResultValueState::ValueFromVirtualMemory :
+                      Cheats::SearchResultValueState::ValueFromPhysicalMemory;
+}
+
 template <typename T>
-Common::Result<Cheats::SearchErrorCode, std::vector<Cheats::SearchResult<T>>>
-Cheats::NewSearch(const Core::CPUThreadGuard& guard,
-                  const std::vector<Cheats::MemoryRange>& memory_ranges,
-                  PowerPC::RequestedAddressSpace address_space, bool aligned,
-                  const std::function<bool(const T& value)>& validator)
+T ReadBigEndian(const u8* pointer)
+{
+  T value;
+  std::memcpy(&value, pointer, sizeof(T));
+  return Common::FromBigEndian(value);
+}
+
+// Copies the given range of emulated memory, if all of it is backed by RAM.
+bool SnapshotRange(const Core::CPUThreadGuard& guard, u32 start_address, u64 length,
+                   PowerPC::RequestedAddressSpace address_space, std::vector<u8>* snapshot)
+{
+  std::vector<std::pair<const u8*, u32>> pages;
+  for (u64 offset = 0; offset < length;)
+  {
+    const u32 address = static_cast<u32>(start_address + offset);
+    const u32 page_offset = address & (SEARCH_PAGE_SIZE - 1);
+    const u32 size =
+        static_cast<u32>(std::min<u64>(SEARCH_PAGE_SIZE - page_offset, length - offset));
+    const u8* page = GetHostPage(guard, address - page_offset, address_space);
+    if (!page)
+      return false;
+    pages.emplace_back(page + page_offset, size);
+    offset += size;
+  }
+
+  snapshot->resize(length);
+  u8* destination = snapshot->data();
+  for (const auto& [pointer, size] : pages)
+  {
+    std::memcpy(destination, pointer, size);
+    destination += size;
+  }
+  return true;
+}
+
+// Calls function for every index in [0, count) using a few threads.
+template <typename Function>
+void ParallelFor(size_t count, const Function& function)
+{
+  std::atomic<size_t> next_index = 0;
+  const auto work = [&] {
+    for (size_t i = next_index++; i < count; i = next_index++)
+      function(i);
+  };
+
+  const size_t thread_count =
+      std::min<size_t>(count, std::max(1U, std::thread::hardware_concurrency()));
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < thread_count; ++i)
+    threads.emplace_back(work);
+  work();
+  for (std::thread& thread : threads)
+    thread.join();
+}
+
+// Adds the values in the snapshot with indices in [begin, end) that the validator accepts. The
+// values are compared in groups of 64 that are recorded in a bitmask, which keeps the comparisons
+// free of branches so that the compiler can vectorize them.
+template <typename T, typename Validator>
+void FilterSnapshot(const u8* snapshot, u32 start_address, u32 increment, u64 begin, u64 end,
+                    Cheats::SearchResultValueState value_state, const Validator& validator,
+                    Cheats::SearchResults<T>* results)
+{
+  for (u64 group = begin; group < end; group += 64)
+  {
+    const u32 group_size = static_cast<u32>(std::min<u64>(64, end - group));
+    u64 matches = 0;
+    for (u32 i = 0; i < group_size; ++i)
+    {
+      const T value = ReadBigEndian<T>(snapshot + (group + i) * increment);
+      matches |= u64{validator(value)} << i;
+    }
+
+    for (; matches != 0; matches &= matches - 1)
+    {
+      const u64 offset = (group + std::countr_zero(matches)) * increment;
+      results->Add(static_cast<u32>(start_address + offset), ReadBigEndian<T>(snapshot + offset),
+                   value_state);
+    }
+  }
+}
+
+template <typename T, typename Validator>
+Common::Result<Cheats::SearchErrorCode, Cheats::SearchResults<T>>
+NewSearchImpl(const Core::CPUThreadGuard& guard,
+              const std::vector<Cheats::MemoryRange>& memory_ranges,
+              PowerPC::RequestedAddressSpace address_space, bool aligned,
+              const Validator& validator)
 {
   if (AchievementManager::GetInstance().IsHardcoreModeActive())
     return Cheats::SearchErrorCode::DisabledInHardcoreMode;
   auto& system = guard.GetSystem();
-  std::vector<Cheats::SearchResult<T>> results;
+  Cheats::SearchResults<T> results;
   const Core::State core_state = Core::GetState(system);
   if (core_state != Core::State::Running && core_state != Core::State::Paused)
     return Cheats::SearchErrorCode::NoEmulationActive;
@@ -219,6 +359,8 @@ Cheats::NewSearch(const Core::CPUThreadGuard& guard,
   if (address_space == PowerPC::RequestedAddressSpace::Virtual && !ppc_state.msr.DR)
     return Cheats::SearchErrorCode::VirtualAddressesCurrentlyNotAccessible;
 
+  const Cheats::SearchResultValueState value_state = GetReadValueState(guard, address_space);
+  std::vector<u8> snapshot;
   for (const Cheats::MemoryRange& range : memory_ranges)
   {
     if (range.m_length < sizeof(T))
@@ -232,6 +374,25 @@ Cheats::NewSearch(const Core::CPUThreadGuard& guard,
       continue;
 
     const u64 length = aligned_length - (sizeof(T) - 1);
+
+    // Ranges of RAM are copied while the CPU thread is paused and then filtered on all cores.
+    if (SnapshotRange(guard, start_address, aligned_length, address_space, &snapshot))
+    {
+      const u64 value_count = (length + increment_per_loop - 1) / increment_per_loop;
+      const size_t chunk_count =
+          static_cast<size_t>((value_count + VALUES_PER_CHUNK - 1) / VALUES_PER_CHUNK);
+      std::vector<Cheats::SearchResults<T>> chunk_results(chunk_count);
+      ParallelFor(chunk_count, [&](size_t chunk) {
+        const u64 begin = chunk * VALUES_PER_CHUNK;
+        FilterSnapshot<T>(snapshot.data(), start_address, increment_per_loop, begin,
+                          std::min(begin + VALUES_PER_CHUNK, value_count), value_state, validator,
+                          &chunk_results[chunk]);
+      });
+      for (const Cheats::SearchResults<T>& chunk : chunk_results)
+        results.Append(chunk, 0, chunk.Size());
+      continue;
+    }
+
     for (u64 i = 0; i < length; i += increment_per_loop)
     {
       const u32 addr = start_address + i;
@@ -241,29 +402,25 @@ Cheats::NewSearch(const Core::CPUThreadGuard& guard,
 
       if (validator(current_value->value))
       {
-        auto& r = results.emplace_back();
-        r.m_value = current_value->value;
-        r.m_value_state = current_value->translated ?
-                              Cheats::SearchResultValueState::ValueFromVirtualMemory :
-                              Cheats::SearchResultValueState::ValueFromPhysicalMemory;
-        r.m_address = addr;
+        results.Add(addr, current_value->value,
+                    current_value->translated ?
+                        Cheats::SearchResultValueState::ValueFromVirtualMemory :
+                        Cheats::SearchResultValueState::ValueFromPhysicalMemory);
       }
     }
   }
   return results;
 }
 
-template <typename T>
-Common::Result<Cheats::SearchErrorCode, std::vector<Cheats::SearchResult<T>>>
-Cheats::NextSearch(const Core::CPUThreadGuard& guard,
-                   const std::vector<Cheats::SearchResult<T>>& previous_results,
-                   PowerPC::RequestedAddressSpace address_space,
-                   const std::function<bool(const T& new_value, const T& old_value)>& validator)
+template <typename T, typename Validator>
+Common::Result<Cheats::SearchErrorCode, Cheats::SearchResults<T>>
+NextSearchImpl(const Core::CPUThreadGuard& guard, const Cheats::SearchResults<T>& previous_results,
+               PowerPC::RequestedAddressSpace address_space, const Validator& validator)
 {
   if (AchievementManager::GetInstance().IsHardcoreModeActive())
     return Cheats::SearchErrorCode::DisabledInHardcoreMode;
   auto& system = guard.GetSystem();
-  std::vector<Cheats::SearchResult<T>> results;
+  Cheats::SearchResults<T> results;
   const Core::State core_state = Core::GetState(system);
   if (core_state != Core::State::Running && core_state != Core::State::Paused)
     return Cheats::SearchErrorCode::NoEmulationActive;
@@ -272,33 +429,100 @@ Cheats::NextSearch(const Core::CPUThreadGuard& guard,
   if (address_space == PowerPC::RequestedAddressSpace::Virtual && !ppc_state.msr.DR)
     return Cheats::SearchErrorCode::VirtualAddressesCurrentlyNotAccessible;
 
-  for (const auto& previous_result : previous_results)
+  // Previous results are sorted by address within each range, so consecutive results usually
+  // share a page and only need it to be translated once.
+  const Cheats::SearchResultValueState value_state = GetReadValueState(guard, address_space);
+  u32 current_page = 0;
+  const u8* current_host_page = GetHostPage(guard, current_page, address_space);
+
+  for (size_t i = 0; i < previous_results.Size(); ++i)
   {
-    const u32 addr = previous_result.m_address;
-    const auto current_value = TryReadValueFromEmulatedMemory<T>(guard, addr, address_space);
+    const u32 addr = previous_results.m_addresses[i];
+    const u32 page_offset = addr & (SEARCH_PAGE_SIZE - 1);
+
+    std::optional<PowerPC::ReadResult<T>> current_value;
+    if (page_offset + sizeof(T) <= SEARCH_PAGE_SIZE)
+    {
+      if (addr - page_offset != current_page)
+      {
+        current_page = addr - page_offset;
+        current_host_page = GetHostPage(guard, current_page, address_space);
+      }
+      if (current_host_page)
+      {
+        current_value.emplace(value_state == Cheats::SearchResultValueState::ValueFromVirtualMemory,
+                              ReadBigEndian<T>(current_host_page + page_offset));
+      }
+    }
+    if (!current_value)
+      current_value = TryReadValueFromEmulatedMemory<T>(guard, addr, address_space);
+
     if (!current_value)
     {
-      auto& r = results.emplace_back();
-      r.m_address = addr;
-      r.m_value_state = Cheats::SearchResultValueState::AddressNotAccessible;
+      results.Add(addr, T{}, Cheats::SearchResultValueState::AddressNotAccessible);
       continue;
     }
 
     // if the previous state was invalid we always update the value to avoid getting stuck in an
     // invalid state
-    if (!previous_result.IsValueValid() || validator(current_value->value, previous_result.m_value))
+    if (!previous_results.IsValueValid(i) ||
+        validator(current_value->value, previous_results.m_values[i]))
     {
-      auto& r = results.emplace_back();
-      r.m_value = current_value->value;
-      r.m_value_state = current_value->translated ?
-                            Cheats::SearchResultValueState::ValueFromVirtualMemory :
-                            Cheats::SearchResultValueState::ValueFromPhysicalMemory;
-      r.m_address = addr;
+      results.Add(addr, current_value->value,
+                  current_value->translated ?
+                      Cheats::SearchResultValueState::ValueFromVirtualMemory :
+                      Cheats::SearchResultValueState::ValueFromPhysicalMemory);
     }
   }
   return results;
 }
 
+// Calls the given function with the std:: comparison function object for the given CompareType.
+template <typename T, typename Function>
+Common::Result<Cheats::SearchErrorCode, Cheats::SearchResults<T>>
+WithCompareFunction(Cheats::CompareType op, const Function& function)
+{
+  switch (op)
+  {
+  case Cheats::CompareType::Equal:
+    return function(std::equal_to<T>());
+  case Cheats::CompareType::NotEqual:
+    return function(std::not_equal_to<T>());
+  case Cheats::CompareType::Less:
+    return function(std::less<T>());
+  case Cheats::CompareType::LessOrEqual:
+    return function(std::less_equal<T>());
+  case Cheats::CompareType::Greater:
+    return function(std::greater<T>());
+  case Cheats::CompareType::GreaterOrEqual:
+    return function(std::greater_equal<T>());
+  default:
+    DEBUG_ASSERT(false);
+    return Cheats::SearchErrorCode::InvalidParameters;
+  }
+}
+}  // namespace
+
+template <typename T>
+Common::Result<Cheats::SearchErrorCode, Cheats::SearchResults<T>>
+Cheats::NewSearch(const Core::CPUThreadGuard& guard,
+                  const std::vector<Cheats::MemoryRange>& memory_ranges,
+                  PowerPC::RequestedAddressSpace address_space, bool aligned,
+                  const std::function<bool(const T& value)>& validator)
+{
+  return NewSearchImpl<T>(guard, memory_ranges, address_space, aligned, validator);
+}
+
+template <typename T>
+Common::Result<Cheats::SearchErrorCode, Cheats::SearchResults<T>>
+Cheats::NextSearch(const Core::CPUThreadGuard& guard,
+                   const Cheats::SearchResults<T>& previous_results,
+                   PowerPC::RequestedAddressSpace address_space,
+                   const std::function<bool(const T& new_value, const T& old_value)>& validator)
+{
+  return NextSearchImpl<T>(guard, previous_results, address_space, validator);
+}
+
 Cheats::CheatSearchSessionBase::~CheatSearchSessionBase() = default;
 
 template <typename T>
@@ -371,55 +595,7 @@ template <typename T>
 void Cheats::CheatSearchSession<T>::ResetResults()
 {
   m_first_search_done = false;
-  m_search_results.clear();
-}
-
-template <typename T>
-static std::function<bool(const T& new_value)>
-MakeCompareFunctionForSpecificValue(Cheats::CompareType op, const T& old_value)
-{
-  switch (op)
-  {
-  case Cheats::CompareType::Equal:
-    return [&](const T& new_value) { return new_value == old_value; };
-  case Cheats::CompareType::NotEqual:
-    return [&](const T& new_value) { return new_value != old_value; };
-  case Cheats::CompareType::Less:
-    return [&](const T& new_value) { return new_value < old_value; };
-  case Cheats::CompareType::LessOrEqual:
-    return [&](const T& new_value) { return new_value <= old_value; };
-  case Cheats::CompareType::Greater:
-    return [&](const T& new_value) { return new_value > old_value; };
-  case Cheats::CompareType::GreaterOrEqual:
-    return [&](const T& new_value) { return new_value >= old_value; };
-  default:
-    DEBUG_ASSERT(false);
-    return nullptr;
-  }
-}
-
-template <typename T>
-static std::function<bool(const T& old_value, const T& new_value)>
-MakeCompareFunctionForLastValue(Cheats::CompareType op)
-{
-  switch (op)
-  {
-  case Cheats::CompareType::Equal:
-    return std::equal_to<T>();
-  case Cheats::CompareType::NotEqual:
-    return std::not_equal_to<T>();
-  case Cheats::CompareType::Less:
-    return std::less<T>();
-  case Cheats::CompareType::LessOrEqual:
-    return std::less_equal<T>();
-  case Cheats::CompareType::Greater:
-    return std::greater<T>();
-  case Cheats::CompareType::GreaterOrEqual:
-    return std::greater_equal<T>();
-  default:
-    DEBUG_ASSERT(false);
-    return nullptr;
-  }
+  m_search_results.Clear();
 }
 
 template <typename T>
@@ -427,44 +603,45 @@ Cheats::SearchErrorCode Cheats::CheatSearchSession<T>::RunSearch(const Core::CPU
 {
   if (AchievementManager::GetInstance().IsHardcoreModeActive())
     return Cheats::SearchErrorCode::DisabledInHardcoreMode;
-  Common::Result<SearchErrorCode, std::vector<SearchResult<T>>> result =
-      Cheats::SearchErrorCode::InvalidParameters;
+  using Result = Common::Result<SearchErrorCode, SearchResults<T>>;
+  Result result = Cheats::SearchErrorCode::InvalidParameters;
   if (m_filter_type == FilterType::CompareAgainstSpecificValue)
   {
     if (!m_value)
       return Cheats::SearchErrorCode::InvalidParameters;
 
-    auto func = MakeCompareFunctionForSpecificValue<T>(m_compare_type, *m_value);
-    if (m_first_search_done)
-    {
-      result = Cheats::NextSearch<T>(
-          guard, m_search_results, m_address_space,
-          [&func](const T& new_value, const T& old_value) { return func(new_value); });
-    }
-    else
-    {
-      result = Cheats::NewSearch<T>(guard, m_memory_ranges, m_address_space, m_aligned, func);
-    }
+    const T value = *m_value;
+    result = WithCompareFunction<T>(m_compare_type, [&](const auto& compare) -> Result {
+      if (m_first_search_done)
+      {
+        return NextSearchImpl<T>(
+            guard, m_search_results, m_address_space,
+            [&](const T& new_value, const T& old_value) { return compare(new_value, value); });
+      }
+      return NewSearchImpl<T>(guard, m_memory_ranges, m_address_space, m_aligned,
+                              [&](const T& new_value) { return compare(new_value, value); });
+    });
   }
   else if (m_filter_type == FilterType::CompareAgainstLastValue)
   {
     if (!m_first_search_done)
       return Cheats::SearchErrorCode::InvalidParameters;
 
-    result = Cheats::NextSearch<T>(guard, m_search_results, m_address_space,
-                                   MakeCompareFunctionForLastValue<T>(m_compare_type));
+    result = WithCompareFunction<T>(m_compare_type, [&](const auto& compare) -> Result {
+      return NextSearchImpl<T>(guard, m_search_results, m_address_space, compare);
+    });
   }
   else if (m_filter_type == FilterType::DoNotFilter)
   {
     if (m_first_search_done)
     {
-      result = Cheats::NextSearch<T>(guard, m_search_results, m_address_space,
-                                     [](const T& v1, const T& v2) { return true; });
+      result = NextSearchImpl<T>(guard, m_search_results, m_address_space,
+                                 [](const T& v1, const T& v2) { return true; });
     }
     else
     {
-      result = Cheats::NewSearch<T>(guard, m_memory_ranges, m_address_space, m_aligned,
-                                    [](const T& v) { return true; });
+      result = NewSearchImpl<T>(guard, m_memory_ranges, m_address_space, m_aligned,
+                                [](const T& v) { return true; });
     }
   }
 
@@ -523,17 +700,16 @@ bool Cheats::CheatSearchSession<T>::IsFloatingType() const
 template <typename T>
 size_t Cheats::CheatSearchSession<T>::GetResultCount() const
 {
-  return m_search_results.size();
+  return m_search_results.Size();
 }
 
 template <typename T>
 size_t Cheats::CheatSearchSession<T>::GetValidValueCount() const
 {
-  const auto& results = m_search_results;
   size_t count = 0;
-  for (const auto& r : results)
+  for (size_t i = 0; i < m_search_results.Size(); ++i)
   {
-    if (r.IsValueValid())
+    if (m_search_results.IsValueValid(i))
       ++count;
   }
   return count;
@@ -542,19 +718,19 @@ size_t Cheats::CheatSearchSession<T>::GetValidValueCount() const
 template <typename T>
 u32 Cheats::CheatSearchSession<T>::GetResultAddress(size_t index) const
 {
-  return m_search_results[index].m_address;
+  return m_search_results.m_addresses[index];
 }
 
 template <typename T>
 T Cheats::CheatSearchSession<T>::GetResultValue(size_t index) const
 {
-  return m_search_results[index].m_value;
+  return m_search_results.m_values[index];
 }
 
 template <typename T>
 Cheats::SearchValue Cheats::CheatSearchSession<T>::GetResultValueAsSearchValue(size_t index) const
 {
-  return Cheats::SearchValue{m_search_results[index].m_value};
+  return Cheats::SearchValue{m_search_results.m_values[index]};
 }
 
 template <typename T>
@@ -567,28 +743,28 @@ std::string Cheats::CheatSearchSession<T>::GetResultValueAsString(size_t index,
   {
     if constexpr (std::is_same_v<T, float>)
     {
-      return fmt::format("0x{0:08x}", std::bit_cast<s32>(m_search_results[index].m_value));
+      return fmt::format("0x{0:08x}", std::bit_cast<s32>(m_search_results.m_values[index]));
     }
     else if constexpr (std::is_same_v<T, double>)
     {
-      return fmt::format("0x{0:016x}", std::bit_cast<s64>(m_search_results[index].m_value));
+      return fmt::format("0x{0:016x}", std::bit_cast<s64>(m_search_results.m_values[index]));
     }
     else
     {
       return fmt::format("0x{0:0{1}x}",
-                         std::bit_cast<std::make_unsigned_t<T>>(m_search_results[index].m_value),
+                         std::bit_cast<std::make_unsigned_t<T>>(m_search_results.m_values[index]),
                          sizeof(T) * 2);
     }
   }
 
-  return fmt::format("{}", m_search_results[index].m_value);
+  return fmt::format("{}", m_search_results.m_values[index]);
 }
 
 template <typename T>
 Cheats::SearchResultValueState
 Cheats::CheatSearchSession<T>::GetResultValueState(size_t index) const
 {
-  return m_search_results[index].m_value_state;
+  return m_search_results.m_value_states[index];
 }
 
 template <typename T>
@@ -607,13 +783,12 @@ template <typename T>
 std::unique_ptr<Cheats::CheatSearchSessionBase>
 Cheats::CheatSearchSession<T>::ClonePartial(const size_t begin_index, const size_t end_index) const
 {
-  if (begin_index == 0 && end_index >= m_search_results.size())
+  if (begin_index == 0 && end_index >= m_search_results.Size())
     return Clone();
 
   auto c =
       std::make_unique<Cheats::CheatSearchSession<T>>(m_memory_ranges, m_address_space, m_aligned);
-  c->m_search_results.assign(m_search_results.begin() + begin_index,
-                             m_search_results.begin() + end_index);
+  c->m_search_results.Append(m_search_results, begin_index, end_index);
   c->m_compare_type = this->m_compare_type;
   c->m_filter_type = this->m_filter_type;
   c->m_value = this->m_value;
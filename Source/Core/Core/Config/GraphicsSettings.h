@@ -16,6 +16,11 @@ enum class ColorCorrectionRegion : int;
 enum class TriState : int;
 enum class FrameDumpResolutionType : int;
 
+namespace Common
+{
+enum class TextureHashAlgorithm : int;
+}
+
 namespace Config
 {
 // Configuration Information
@@ -24,6 +29,7 @@ namespace Config
 
 extern const Info<bool> GFX_VSYNC;
 extern const Info<int> GFX_ADAPTER;
+extern const Info<bool> GFX_LOW_LATENCY_PRESENT;
 
 // Graphics.Settings
 
@@ -38,13 +44,17 @@ extern const Info<float> GFX_WIDESCREEN_HEURISTIC_STANDARD_RATIO;
 extern const Info<float> GFX_WIDESCREEN_HEURISTIC_WIDESCREEN_RATIO;
 extern const Info<bool> GFX_CROP;
 extern const Info<int> GFX_SAFE_TEXTURE_CACHE_COLOR_SAMPLES;
+extern const Info<Common::TextureHashAlgorithm> GFX_TEXTURE_HASH_ALGORITHM;
 extern const Info<bool> GFX_SHOW_FPS;
 extern const Info<bool> GFX_SHOW_FTIMES;
 extern const Info<bool> GFX_SHOW_VPS;
 extern const Info<bool> GFX_SHOW_VTIMES;
 extern const Info<bool> GFX_SHOW_GRAPHS;
+extern const Info<bool> GFX_SHOW_GPU_PASS_TIMES;
+extern const Info<bool> GFX_SHOW_MEMORY_USAGE;
 extern const Info<bool> GFX_SHOW_SPEED;
 extern const Info<bool> GFX_SHOW_SPEED_COLORS;
+extern const Info<bool> GFX_SHOW_AUDIO_LATENCY;
 extern const Info<int> GFX_PERF_SAMP_WINDOW;
 extern const Info<bool> GFX_SHOW_NETPLAY_PING;
 extern const Info<bool> GFX_SHOW_NETPLAY_MESSAGES;
@@ -58,6 +68,10 @@ extern const Info<bool> GFX_DUMP_BASE_TEXTURES;
 extern const Info<int> GFX_TEXTURE_PNG_COMPRESSION_LEVEL;
 extern const Info<bool> GFX_HIRES_TEXTURES;
 extern const Info<bool> GFX_CACHE_HIRES_TEXTURES;
+// Memory limit for loaded custom assets in MiB, 0 picks a limit based on the system memory.
+extern const Info<int> GFX_HIRES_TEXTURE_MEMORY_LIMIT;
+// Memory limit for unused textures that are kept for reuse in MiB, 0 uses the default of 512 MiB.
+extern const Info<int> GFX_TEXTURE_POOL_MEMORY_LIMIT;
 extern const Info<bool> GFX_DUMP_EFB_TARGET;
 extern const Info<bool> GFX_DUMP_XFB_TARGET;
 extern const Info<bool> GFX_DUMP_FRAMES_AS_IMAGES;
@@ -71,6 +85,7 @@ extern const Info<int> GFX_BITRATE_KBPS;
 extern const Info<FrameDumpResolutionType> GFX_FRAME_DUMPS_RESOLUTION_TYPE;
 extern const Info<int> GFX_PNG_COMPRESSION_LEVEL;
 extern const Info<bool> GFX_ENABLE_GPU_TEXTURE_DECODING;
+extern const Info<u32> GFX_GPU_TEXTURE_DECODING_MIN_TEXELS;
 extern const Info<bool> GFX_ENABLE_PIXEL_LIGHTING;
 extern const Info<bool> GFX_FAST_DEPTH_CALC;
 extern const Info<u32> GFX_MSAA;
@@ -84,15 +99,19 @@ extern const Info<bool> GFX_DISABLE_FOG;
 extern const Info<bool> GFX_BORDERLESS_FULLSCREEN;
 extern const Info<bool> GFX_ENABLE_VALIDATION_LAYER;
 extern const Info<bool> GFX_BACKEND_MULTITHREADING;
+extern const Info<bool> GFX_PARALLEL_COMMAND_RECORDING;
 extern const Info<int> GFX_COMMAND_BUFFER_EXECUTE_INTERVAL;
 extern const Info<bool> GFX_SHADER_CACHE;
 extern const Info<bool> GFX_WAIT_FOR_SHADERS_BEFORE_STARTING;
+extern const Info<bool> GFX_EXPORT_PIPELINE_MANIFEST;
 extern const Info<ShaderCompilationMode> GFX_SHADER_COMPILATION_MODE;
+extern const Info<int> GFX_HYBRID_UBERSHADER_SPECIALIZATION_FRAMES;
 extern const Info<int> GFX_SHADER_COMPILER_THREADS;
 extern const Info<int> GFX_SHADER_PRECOMPILER_THREADS;
 extern const Info<bool> GFX_SAVE_TEXTURE_CACHE_TO_STATE;
 extern const Info<bool> GFX_PREFER_VS_FOR_LINE_POINT_EXPANSION;
 extern const Info<bool> GFX_CPU_CULL;
+extern const Info<bool> GFX_CPU_CULL_TRIANGLES;
 
 extern const Info<TriState> GFX_MTL_MANUALLY_UPLOAD_BUFFERS;
 extern const Info<TriState> GFX_MTL_USE_PRESENT_DRAWABLE;
@@ -100,6 +119,8 @@ extern const Info<TriState> GFX_MTL_USE_PRESENT_DRAWABLE;
 extern const Info<bool> GFX_SW_DUMP_OBJECTS;
 extern const Info<bool> GFX_SW_DUMP_TEV_STAGES;
 extern const Info<bool> GFX_SW_DUMP_TEV_TEX_FETCHES;
+// Number of threads rasterizing EFB tiles next to the GPU thread, -1 for automatic.
+extern const Info<int> GFX_SW_RASTERIZER_THREADS;
 
 extern const Info<bool> GFX_PREFER_GLES;
 
@@ -161,6 +182,8 @@ extern const Info<bool> GFX_HACK_SKIP_EFB_COPY_TO_RAM;
 extern const Info<bool> GFX_HACK_SKIP_XFB_COPY_TO_RAM;
 extern const Info<bool> GFX_HACK_DISABLE_COPY_TO_VRAM;
 extern const Info<bool> GFX_HACK_DEFER_EFB_COPIES;
+extern const Info<int> GFX_HACK_EFB_COPY_READBACK_LAG;
+extern const Info<int> GFX_HACK_PERF_QUERY_READBACK_LAG;
 extern const Info<bool> GFX_HACK_IMMEDIATE_XFB;
 extern const Info<bool> GFX_HACK_SKIP_DUPLICATE_XFBS;
 extern const Info<bool> GFX_HACK_EARLY_XFB_OUTPUT;
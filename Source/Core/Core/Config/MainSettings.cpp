@@ -41,6 +41,11 @@ const Info<bool> MAIN_JIT_FOLLOW_BRANCH{{System::Main, "Core", "JITFollowBranch"
 const Info<bool> MAIN_FASTMEM{{System::Main, "Core", "Fastmem"}, true};
 const Info<bool> MAIN_FASTMEM_ARENA{{System::Main, "Core", "FastmemArena"}, true};
 const Info<bool> MAIN_LARGE_ENTRY_POINTS_MAP{{System::Main, "Core", "LargeEntryPointsMap"}, true};
+const Info<bool> MAIN_JIT_PERSISTENT_CACHE{{System::Main, "Core", "JITPersistentCache"}, false};
+const Info<bool> MAIN_JIT_TIERED_COMPILATION{{System::Main, "Core", "JITTieredCompilation"},
+                                             false};
+const Info<bool> MAIN_JIT_CROSS_BLOCK_LIVENESS{{System::Main, "Core", "JITCrossBlockLiveness"},
+                                               false};
 const Info<bool> MAIN_ACCURATE_CPU_CACHE{{System::Main, "Core", "AccurateCPUCache"}, false};
 const Info<bool> MAIN_DSP_HLE{{System::Main, "Core", "DSPHLE"}, true};
 const Info<int> MAIN_MAX_FALLBACK{{System::Main, "Core", "MaxFallback"}, 100};
@@ -58,6 +63,8 @@ const Info<AudioCommon::DPL2Quality> MAIN_DPL2_QUALITY{{System::Main, "Core", "D
 const Info<int> MAIN_AUDIO_LATENCY{{System::Main, "Core", "AudioLatency"}, 20};
 const Info<bool> MAIN_AUDIO_STRETCH{{System::Main, "Core", "AudioStretch"}, false};
 const Info<int> MAIN_AUDIO_STRETCH_LATENCY{{System::Main, "Core", "AudioStretchMaxLatency"}, 80};
+const Info<bool> MAIN_AUDIO_SINC_RESAMPLING{{System::Main, "Core", "AudioSincResampling"}, false};
+const Info<bool> MAIN_AUDIO_LOW_LATENCY{{System::Main, "Core", "AudioLowLatency"}, false};
 const Info<std::string> MAIN_MEMCARD_A_PATH{{System::Main, "Core", "MemcardAPath"}, ""};
 const Info<std::string> MAIN_MEMCARD_B_PATH{{System::Main, "Core", "MemcardBPath"}, ""};
 const Info<std::string>& GetInfoForMemcardPath(ExpansionInterface::Slot slot)
@@ -191,13 +198,21 @@ const Info<bool> MAIN_WIIMOTE_ENABLE_SPEAKER{{System::Main, "Core", "WiimoteEnab
 const Info<bool> MAIN_CONNECT_WIIMOTES_FOR_CONTROLLER_INTERFACE{
     {System::Main, "Core", "WiimoteControllerInterface"}, false};
 const Info<bool> MAIN_MMU{{System::Main, "Core", "MMU"}, false};
+const Info<bool> MAIN_HLE_SDK_FUNCTIONS{{System::Main, "Core", "HLESDKFunctions"}, false};
 const Info<bool> MAIN_PAUSE_ON_PANIC{{System::Main, "Core", "PauseOnPanic"}, false};
 const Info<int> MAIN_BB_DUMP_PORT{{System::Main, "Core", "BBDumpPort"}, -1};
 const Info<bool> MAIN_SYNC_GPU{{System::Main, "Core", "SyncGPU"}, false};
+const Info<bool> MAIN_PREPARSE_GPU_FIFO{{System::Main, "Core", "PreparseGPUFifo"}, false};
 const Info<int> MAIN_SYNC_GPU_MAX_DISTANCE{{System::Main, "Core", "SyncGpuMaxDistance"}, 200000};
 const Info<int> MAIN_SYNC_GPU_MIN_DISTANCE{{System::Main, "Core", "SyncGpuMinDistance"}, -200000};
 const Info<float> MAIN_SYNC_GPU_OVERCLOCK{{System::Main, "Core", "SyncGpuOverclock"}, 1.0f};
+const Info<bool> MAIN_SYNC_GPU_ADAPTIVE{{System::Main, "Core", "SyncGpuAdaptive"}, false};
 const Info<bool> MAIN_FAST_DISC_SPEED{{System::Main, "Core", "FastDiscSpeed"}, false};
+const Info<int> MAIN_WIA_READ_AHEAD_CACHE_SIZE{{System::Main, "Core", "WIAReadAheadCacheSize"}, 64};
+const Info<int> MAIN_DVD_PREFETCH_CACHE_SIZE{{System::Main, "Core", "DVDPrefetchCacheSize"}, 32};
+const Info<int> MAIN_WII_ENCRYPTION_CACHE_SIZE{{System::Main, "Core", "WiiEncryptionCacheSize"},
+                                               8};
+const Info<bool> MAIN_MAP_DISC_IMAGES{{System::Main, "Core", "MapDiscImages"}, true};
 const Info<bool> MAIN_LOW_DCBZ_HACK{{System::Main, "Core", "LowDCBZHack"}, false};
 const Info<bool> MAIN_FLOAT_EXCEPTIONS{{System::Main, "Core", "FloatExceptions"}, false};
 const Info<bool> MAIN_DIVIDE_BY_ZERO_EXCEPTIONS{{System::Main, "Core", "DivByZeroExceptions"},
@@ -211,6 +226,21 @@ const Info<bool> MAIN_OVERCLOCK_ENABLE{{System::Main, "Core", "OverclockEnable"}
 const Info<bool> MAIN_RAM_OVERRIDE_ENABLE{{System::Main, "Core", "RAMOverrideEnable"}, false};
 const Info<u32> MAIN_MEM1_SIZE{{System::Main, "Core", "MEM1Size"}, Memory::MEM1_SIZE_RETAIL};
 const Info<u32> MAIN_MEM2_SIZE{{System::Main, "Core", "MEM2Size"}, Memory::MEM2_SIZE_RETAIL};
+const Info<bool> MAIN_TEXTURE_WRITE_TRACKING{{System::Main, "Core", "TextureWriteTracking"},
+                                             false};
+const Info<bool> MAIN_HUGE_PAGES{{System::Main, "Core", "HugePages"}, false};
+const Info<bool> MAIN_CAPTURE_TRACE_ZONES{{System::Main, "Core", "CaptureTraceZones"}, false};
+const Info<bool> MAIN_FRAME_TIME_REPORT{{System::Main, "Core", "FrameTimeReport"}, false};
+const Info<bool> MAIN_MEMORY_WATCHER_SHARED_MEMORY{
+    {System::Main, "Core", "MemoryWatcherSharedMemory"}, false};
+const Info<Common::ThreadPolicy> MAIN_CPU_THREAD_POLICY{{System::Main, "Core", "CPUThreadPolicy"},
+                                                        Common::ThreadPolicy::Performance};
+const Info<Common::ThreadPolicy> MAIN_GPU_THREAD_POLICY{{System::Main, "Core", "GPUThreadPolicy"},
+                                                        Common::ThreadPolicy::Performance};
+const Info<Common::ThreadPolicy> MAIN_AUDIO_THREAD_POLICY{
+    {System::Main, "Core", "AudioThreadPolicy"}, Common::ThreadPolicy::Default};
+const Info<Common::ThreadPolicy> MAIN_BACKGROUND_THREAD_POLICY{
+    {System::Main, "Core", "BackgroundThreadPolicy"}, Common::ThreadPolicy::Efficiency};
 const Info<std::string> MAIN_GFX_BACKEND{{System::Main, "Core", "GFXBackend"},
                                          VideoBackendBase::GetDefaultBackendName()};
 const Info<HSP::HSPDeviceType> MAIN_HSP_DEVICE{{System::Main, "Core", "HSPDevice"},
@@ -236,6 +266,12 @@ GPUDeterminismMode GetGPUDeterminismMode()
 }
 
 const Info<std::string> MAIN_PERF_MAP_DIR{{System::Main, "Core", "PerfMapDir"}, ""};
+const Info<bool> MAIN_PERF_JITDUMP{{System::Main, "Core", "PerfJitDump"}, false};
+const Info<bool> MAIN_JIT_SAMPLING_PROFILER{{System::Main, "Core", "JITSamplingProfiler"}, false};
+const Info<u32> MAIN_JIT_SAMPLING_PROFILER_INTERVAL{
+    {System::Main, "Core", "JITSamplingProfilerInterval"}, 1000};
+const Info<bool> MAIN_CORETIMING_EVENT_STATS{{System::Main, "Core", "CoreTimingEventStats"},
+                                             false};
 const Info<bool> MAIN_CUSTOM_RTC_ENABLE{{System::Main, "Core", "EnableCustomRTC"}, false};
 // Measured in seconds since the unix epoch (1.1.1970).  Default is 1.1.2000; there are 7 leap years
 // between those dates.
@@ -246,6 +282,14 @@ const Info<DiscIO::Region> MAIN_FALLBACK_REGION{{System::Main, "Core", "Fallback
 const Info<bool> MAIN_AUTO_DISC_CHANGE{{System::Main, "Core", "AutoDiscChange"}, false};
 const Info<bool> MAIN_ALLOW_SD_WRITES{{System::Main, "Core", "WiiSDCardAllowWrites"}, true};
 const Info<bool> MAIN_ENABLE_SAVESTATES{{System::Main, "Core", "EnableSaveStates"}, false};
+const Info<bool> MAIN_INCREMENTAL_SAVESTATES{{System::Main, "Core", "IncrementalSaveStates"},
+                                             false};
+const Info<bool> MAIN_SAVESTATE_ZSTD{{System::Main, "Core", "SaveStateZstd"}, false};
+const Info<int> MAIN_SAVESTATE_ZSTD_LEVEL{{System::Main, "Core", "SaveStateZstdLevel"}, 3};
+const Info<bool> MAIN_REWIND_ENABLE{{System::Main, "Core", "EnableRewind"}, false};
+const Info<u32> MAIN_REWIND_INTERVAL{{System::Main, "Core", "RewindInterval"}, 30};
+const Info<u32> MAIN_REWIND_MEMORY_LIMIT_MB{{System::Main, "Core", "RewindMemoryLimitMB"}, 256};
+const Info<u32> MAIN_REWIND_FRAME_BUDGET{{System::Main, "Core", "RewindFrameBudget"}, 4000};
 const Info<bool> MAIN_REAL_WII_REMOTE_REPEAT_REPORTS{
     {System::Main, "Core", "RealWiiRemoteRepeatReports"}, true};
 const Info<bool> MAIN_WII_WIILINK_ENABLE{{System::Main, "Core", "EnableWiiLink"}, false};
@@ -271,6 +315,7 @@ const Info<bool> MAIN_DISABLE_SCREENSAVER{{System::Main, "Display", "DisableScre
 // Main.DSP
 
 const Info<bool> MAIN_DSP_THREAD{{System::Main, "DSP", "DSPThread"}, false};
+const Info<bool> MAIN_DSP_HLE_THREAD{{System::Main, "DSP", "HLEThread"}, false};
 const Info<bool> MAIN_DSP_CAPTURE_LOG{{System::Main, "DSP", "CaptureLog"}, false};
 const Info<bool> MAIN_DSP_JIT{{System::Main, "DSP", "EnableJIT"}, true};
 const Info<bool> MAIN_DUMP_AUDIO{{System::Main, "DSP", "DumpAudio"}, false};
@@ -304,6 +349,9 @@ const Info<bool> MAIN_SHOW_FRAME_COUNT{{System::Main, "General", "ShowFrameCount
 const Info<std::string> MAIN_WIRELESS_MAC{{System::Main, "General", "WirelessMac"}, ""};
 const Info<std::string> MAIN_GDB_SOCKET{{System::Main, "General", "GDBSocket"}, ""};
 const Info<int> MAIN_GDB_PORT{{System::Main, "General", "GDBPort"}, -1};
+const Info<std::string> MAIN_METRICS_SERVER_SOCKET{
+    {System::Main, "General", "MetricsServerSocket"}, ""};
+const Info<int> MAIN_METRICS_SERVER_PORT{{System::Main, "General", "MetricsServerPort"}, -1};
 const Info<int> MAIN_ISO_PATH_COUNT{{System::Main, "General", "ISOPaths"}, 0};
 const Info<std::string> MAIN_SKYLANDERS_PATH{{System::Main, "General", "SkylandersCollectionPath"},
                                              ""};
@@ -481,10 +529,13 @@ const Info<bool> MAIN_MOVIE_DUMP_FRAMES_SILENT{{System::Main, "Movie", "DumpFram
 const Info<bool> MAIN_MOVIE_SHOW_INPUT_DISPLAY{{System::Main, "Movie", "ShowInputDisplay"}, false};
 const Info<bool> MAIN_MOVIE_SHOW_RTC{{System::Main, "Movie", "ShowRTC"}, false};
 const Info<bool> MAIN_MOVIE_SHOW_RERECORD{{System::Main, "Movie", "ShowRerecord"}, false};
+const Info<bool> MAIN_MOVIE_WRITE_RECOVERY_FILE{{System::Main, "Movie", "WriteRecoveryFile"},
+                                                true};
 
 // Main.Input
 
 const Info<bool> MAIN_INPUT_BACKGROUND_INPUT{{System::Main, "Input", "BackgroundInput"}, false};
+const Info<bool> MAIN_INPUT_POLLING_THREAD{{System::Main, "Input", "PollingThread"}, false};
 
 // Main.Debug
 
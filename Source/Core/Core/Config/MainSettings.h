@@ -11,6 +11,7 @@
 #include "Common/Common.h"
 #include "Common/CommonTypes.h"
 #include "Common/Config/Config.h"
+#include "Common/ThreadPolicy.h"
 #include "DiscIO/Enums.h"
 
 // DSP Backend Types
@@ -58,6 +59,9 @@ extern const Info<bool> MAIN_JIT_FOLLOW_BRANCH;
 extern const Info<bool> MAIN_FASTMEM;
 extern const Info<bool> MAIN_FASTMEM_ARENA;
 extern const Info<bool> MAIN_LARGE_ENTRY_POINTS_MAP;
+extern const Info<bool> MAIN_JIT_PERSISTENT_CACHE;
+extern const Info<bool> MAIN_JIT_TIERED_COMPILATION;
+extern const Info<bool> MAIN_JIT_CROSS_BLOCK_LIVENESS;
 extern const Info<bool> MAIN_ACCURATE_CPU_CACHE;
 // Should really be in the DSP section, but we're kind of stuck with bad decisions made in the past.
 extern const Info<bool> MAIN_DSP_HLE;
@@ -74,6 +78,8 @@ extern const Info<AudioCommon::DPL2Quality> MAIN_DPL2_QUALITY;
 extern const Info<int> MAIN_AUDIO_LATENCY;
 extern const Info<bool> MAIN_AUDIO_STRETCH;
 extern const Info<int> MAIN_AUDIO_STRETCH_LATENCY;
+extern const Info<bool> MAIN_AUDIO_SINC_RESAMPLING;
+extern const Info<bool> MAIN_AUDIO_LOW_LATENCY;
 extern const Info<std::string> MAIN_MEMCARD_A_PATH;
 extern const Info<std::string> MAIN_MEMCARD_B_PATH;
 const Info<std::string>& GetInfoForMemcardPath(ExpansionInterface::Slot slot);
@@ -109,13 +115,29 @@ extern const Info<bool> MAIN_WIIMOTE_CONTINUOUS_SCANNING;
 extern const Info<bool> MAIN_WIIMOTE_ENABLE_SPEAKER;
 extern const Info<bool> MAIN_CONNECT_WIIMOTES_FOR_CONTROLLER_INTERFACE;
 extern const Info<bool> MAIN_MMU;
+// Replaces some of the SDK's memory, cache and matrix functions with faster host versions.
+extern const Info<bool> MAIN_HLE_SDK_FUNCTIONS;
 extern const Info<bool> MAIN_PAUSE_ON_PANIC;
 extern const Info<int> MAIN_BB_DUMP_PORT;
 extern const Info<bool> MAIN_SYNC_GPU;
+extern const Info<bool> MAIN_PREPARSE_GPU_FIFO;
 extern const Info<int> MAIN_SYNC_GPU_MAX_DISTANCE;
 extern const Info<int> MAIN_SYNC_GPU_MIN_DISTANCE;
 extern const Info<float> MAIN_SYNC_GPU_OVERCLOCK;
+// Lets the GPU thread fall further behind than SyncGpuMaxDistance while the game doesn't read
+// back GPU state, and returns to it when it does. Meant to be enabled in game INIs.
+extern const Info<bool> MAIN_SYNC_GPU_ADAPTIVE;
 extern const Info<bool> MAIN_FAST_DISC_SPEED;
+// Memory in MiB used to decompress WIA/RVZ chunks ahead of sequential reads, 0 disables it.
+extern const Info<int> MAIN_WIA_READ_AHEAD_CACHE_SIZE;
+// Memory in MiB used to prefetch disc data the game is predicted to read next. Only used when
+// MAIN_FAST_DISC_SPEED is enabled, 0 disables it.
+extern const Info<int> MAIN_DVD_PREFETCH_CACHE_SIZE;
+// Memory in MiB used to cache re-encrypted Wii groups of WIA/RVZ images and game folders.
+// At least one group is always cached.
+extern const Info<int> MAIN_WII_ENCRYPTION_CACHE_SIZE;
+// Memory-map uncompressed disc images so that DVD reads can be copied to RAM without a buffer.
+extern const Info<bool> MAIN_MAP_DISC_IMAGES;
 extern const Info<bool> MAIN_LOW_DCBZ_HACK;
 extern const Info<bool> MAIN_FLOAT_EXCEPTIONS;
 extern const Info<bool> MAIN_DIVIDE_BY_ZERO_EXCEPTIONS;
@@ -128,6 +150,17 @@ extern const Info<bool> MAIN_OVERCLOCK_ENABLE;
 extern const Info<bool> MAIN_RAM_OVERRIDE_ENABLE;
 extern const Info<u32> MAIN_MEM1_SIZE;
 extern const Info<u32> MAIN_MEM2_SIZE;
+extern const Info<bool> MAIN_TEXTURE_WRITE_TRACKING;
+extern const Info<bool> MAIN_HUGE_PAGES;
+// Only has an effect in builds with USE_TRACE_ZONES.
+extern const Info<bool> MAIN_CAPTURE_TRACE_ZONES;
+extern const Info<bool> MAIN_FRAME_TIME_REPORT;
+// Only has an effect in builds with USE_MEMORYWATCHER.
+extern const Info<bool> MAIN_MEMORY_WATCHER_SHARED_MEMORY;
+extern const Info<Common::ThreadPolicy> MAIN_CPU_THREAD_POLICY;
+extern const Info<Common::ThreadPolicy> MAIN_GPU_THREAD_POLICY;
+extern const Info<Common::ThreadPolicy> MAIN_AUDIO_THREAD_POLICY;
+extern const Info<Common::ThreadPolicy> MAIN_BACKGROUND_THREAD_POLICY;
 // Should really be part of System::GFX, but again, we're stuck with past mistakes.
 extern const Info<std::string> MAIN_GFX_BACKEND;
 extern const Info<HSP::HSPDeviceType> MAIN_HSP_DEVICE;
@@ -145,11 +178,30 @@ extern const Info<std::string> MAIN_GPU_DETERMINISM_MODE;
 GPUDeterminismMode GetGPUDeterminismMode();
 
 extern const Info<std::string> MAIN_PERF_MAP_DIR;
+// Also write a Linux perf jitdump file (jit-<pid>.dump) next to the perf map.
+extern const Info<bool> MAIN_PERF_JITDUMP;
+extern const Info<bool> MAIN_JIT_SAMPLING_PROFILER;
+// In microseconds of host time.
+extern const Info<u32> MAIN_JIT_SAMPLING_PROFILER_INTERVAL;
+extern const Info<bool> MAIN_CORETIMING_EVENT_STATS;
 extern const Info<bool> MAIN_CUSTOM_RTC_ENABLE;
 extern const Info<u32> MAIN_CUSTOM_RTC_VALUE;
 extern const Info<bool> MAIN_AUTO_DISC_CHANGE;
 extern const Info<bool> MAIN_ALLOW_SD_WRITES;
 extern const Info<bool> MAIN_ENABLE_SAVESTATES;
+// Savestates only store the blocks that changed since a full base state, which is shared between
+// them and stored in the StateSaves/Base folder.
+extern const Info<bool> MAIN_INCREMENTAL_SAVESTATES;
+// Keeps an in-memory ring buffer of snapshots, taken every MAIN_REWIND_INTERVAL frames, that the
+// rewind hotkey steps back through.
+// Compresses savestates using zstd at the given level instead of LZ4.
+extern const Info<bool> MAIN_SAVESTATE_ZSTD;
+extern const Info<int> MAIN_SAVESTATE_ZSTD_LEVEL;
+extern const Info<bool> MAIN_REWIND_ENABLE;
+extern const Info<u32> MAIN_REWIND_INTERVAL;
+extern const Info<u32> MAIN_REWIND_MEMORY_LIMIT_MB;
+// In microseconds of host time. Snapshots that take longer are taken less often.
+extern const Info<u32> MAIN_REWIND_FRAME_BUDGET;
 extern const Info<DiscIO::Region> MAIN_FALLBACK_REGION;
 extern const Info<bool> MAIN_REAL_WII_REMOTE_REPEAT_REPORTS;
 extern const Info<s32> MAIN_OVERRIDE_BOOT_IOS;
@@ -159,6 +211,7 @@ extern const Info<bool> MAIN_WII_WIILINK_ENABLE;
 // Main.DSP
 
 extern const Info<bool> MAIN_DSP_THREAD;
+extern const Info<bool> MAIN_DSP_HLE_THREAD;
 extern const Info<bool> MAIN_DSP_CAPTURE_LOG;
 extern const Info<bool> MAIN_DSP_JIT;
 extern const Info<bool> MAIN_DUMP_AUDIO;
@@ -200,6 +253,8 @@ extern const Info<bool> MAIN_SHOW_FRAME_COUNT;
 extern const Info<std::string> MAIN_WIRELESS_MAC;
 extern const Info<std::string> MAIN_GDB_SOCKET;
 extern const Info<int> MAIN_GDB_PORT;
+extern const Info<std::string> MAIN_METRICS_SERVER_SOCKET;
+extern const Info<int> MAIN_METRICS_SERVER_PORT;
 extern const Info<int> MAIN_ISO_PATH_COUNT;
 extern const Info<std::string> MAIN_SKYLANDERS_PATH;
 std::vector<std::string> GetIsoPaths();
@@ -315,10 +370,14 @@ extern const Info<bool> MAIN_MOVIE_DUMP_FRAMES_SILENT;
 extern const Info<bool> MAIN_MOVIE_SHOW_INPUT_DISPLAY;
 extern const Info<bool> MAIN_MOVIE_SHOW_RTC;
 extern const Info<bool> MAIN_MOVIE_SHOW_RERECORD;
+// Writes the input of the current recording to StateSaves/recovery.dtm every few seconds.
+extern const Info<bool> MAIN_MOVIE_WRITE_RECOVERY_FILE;
 
 // Main.Input
 
 extern const Info<bool> MAIN_INPUT_BACKGROUND_INPUT;
+// Polls the controllers that allow it on a thread of their own instead of on every input channel.
+extern const Info<bool> MAIN_INPUT_POLLING_THREAD;
 
 // Main.Debug
 
@@ -5,8 +5,10 @@
 
 #include <algorithm>
 #include <array>
+#include <filesystem>
 #include <list>
 #include <map>
+#include <mutex>
 #include <optional>
 #include <sstream>
 #include <string>
@@ -60,6 +62,79 @@ std::vector<std::string> GetGameIniFilenames(const std::string& id, std::optiona
   return filenames;
 }
 
+namespace
+{
+struct IniFileStamp
+{
+  bool exists = false;
+  std::uintmax_t size = 0;
+  std::filesystem::file_time_type time{};
+
+  bool operator==(const IniFileStamp&) const = default;
+};
+
+IniFileStamp GetIniFileStamp(const std::string& path)
+{
+  const std::filesystem::path fs_path = StringToPath(path);
+  std::error_code error;
+  IniFileStamp stamp;
+  stamp.time = std::filesystem::last_write_time(fs_path, error);
+  if (error)
+    return {};
+  stamp.size = std::filesystem::file_size(fs_path, error);
+  stamp.exists = !error;
+  return stamp;
+}
+
+struct CachedGameIni
+{
+  std::vector<IniFileStamp> stamps;
+  Common::IniFile ini;
+};
+
+constexpr size_t MAX_CACHED_GAME_INIS = 16;
+}  // namespace
+
+Common::IniFile LoadGameIniFiles(const std::string& directory,
+                                 const std::vector<std::string>& filenames)
+{
+  static std::mutex s_mutex;
+  static std::map<std::vector<std::string>, CachedGameIni> s_cache;
+
+  std::vector<std::string> paths;
+  std::vector<IniFileStamp> stamps;
+  paths.reserve(filenames.size());
+  stamps.reserve(filenames.size());
+  for (const std::string& filename : filenames)
+  {
+    paths.push_back(directory + filename);
+    stamps.push_back(GetIniFileStamp(paths.back()));
+  }
+
+  std::lock_guard lk(s_mutex);
+  const auto it = s_cache.find(paths);
+  if (it != s_cache.end() && it->second.stamps == stamps)
+    return it->second.ini;
+
+  Common::IniFile ini;
+  for (size_t i = 0; i < paths.size(); ++i)
+  {
+    if (stamps[i].exists)
+      ini.Load(paths[i], true);
+  }
+
+  if (s_cache.size() >= MAX_CACHED_GAME_INIS && it == s_cache.end())
+    s_cache.clear();
+  s_cache.insert_or_assign(std::move(paths), CachedGameIni{std::move(stamps), ini});
+  return ini;
+}
+
+Common::IniFile LoadGameIniFiles(const std::string& directory, const std::string& id,
+                                 std::optional<u16> revision)
+{
+  return LoadGameIniFiles(directory, GetGameIniFilenames(id, revision));
+}
+
 using Location = Config::Location;
 using INIToLocationMap = std::map<std::pair<std::string, std::string>, Location>;
 using INIToSectionMap = std::map<std::string, std::pair<Config::System, std::string>>;
@@ -175,17 +250,11 @@ public:
 
   void Load(Config::Layer* layer) override
   {
-    Common::IniFile ini;
-    if (layer->GetLayer() == Config::LayerType::GlobalGame)
-    {
-      for (const std::string& filename : GetGameIniFilenames(m_id, m_revision))
-        ini.Load(File::GetSysDirectory() + GAMESETTINGS_DIR DIR_SEP + filename, true);
-    }
-    else
-    {
-      for (const std::string& filename : GetGameIniFilenames(m_id, m_revision))
-        ini.Load(File::GetUserPath(D_GAMESETTINGS_IDX) + filename, true);
-    }
+    const Common::IniFile ini = LoadGameIniFiles(
+        layer->GetLayer() == Config::LayerType::GlobalGame ?
+            File::GetSysDirectory() + GAMESETTINGS_DIR DIR_SEP :
+            File::GetUserPath(D_GAMESETTINGS_IDX),
+        m_id, m_revision);
 
     const auto& system_sections = ini.GetSections();
 
@@ -11,6 +11,10 @@
 
 #include "Common/CommonTypes.h"
 
+namespace Common
+{
+class IniFile;
+}
 namespace Config
 {
 class ConfigLayerLoader;
@@ -20,6 +24,14 @@ namespace ConfigLoaders
 {
 std::vector<std::string> GetGameIniFilenames(const std::string& id, std::optional<u16> revision);
 
+// Loads the INIs with these names from the directory, merged in the given order. The result is
+// kept and returned again until one of the files changes, since the same INIs are loaded by
+// several subsystems on every boot.
+Common::IniFile LoadGameIniFiles(const std::string& directory,
+                                 const std::vector<std::string>& filenames);
+Common::IniFile LoadGameIniFiles(const std::string& directory, const std::string& id,
+                                 std::optional<u16> revision);
+
 std::unique_ptr<Config::ConfigLayerLoader> GenerateGlobalGameConfigLoader(const std::string& id,
                                                                           u16 revision);
 std::unique_ptr<Config::ConfigLayerLoader> GenerateLocalGameConfigLoader(const std::string& id,
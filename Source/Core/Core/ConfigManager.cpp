@@ -422,28 +422,24 @@ Common::IniFile SConfig::LoadGameIni() const
 
 Common::IniFile SConfig::LoadDefaultGameIni(const std::string& id, std::optional<u16> revision)
 {
-  Common::IniFile game_ini;
-  for (const std::string& filename : ConfigLoaders::GetGameIniFilenames(id, revision))
-    game_ini.Load(File::GetSysDirectory() + GAMESETTINGS_DIR DIR_SEP + filename, true);
-  return game_ini;
+  return ConfigLoaders::LoadGameIniFiles(File::GetSysDirectory() + GAMESETTINGS_DIR DIR_SEP, id,
+                                         revision);
 }
 
 Common::IniFile SConfig::LoadLocalGameIni(const std::string& id, std::optional<u16> revision)
 {
-  Common::IniFile game_ini;
-  for (const std::string& filename : ConfigLoaders::GetGameIniFilenames(id, revision))
-    game_ini.Load(File::GetUserPath(D_GAMESETTINGS_IDX) + filename, true);
-  return game_ini;
+  return ConfigLoaders::LoadGameIniFiles(File::GetUserPath(D_GAMESETTINGS_IDX), id, revision);
 }
 
 Common::IniFile SConfig::LoadGameIni(const std::string& id, std::optional<u16> revision)
 {
-  Common::IniFile game_ini;
-  for (const std::string& filename : ConfigLoaders::GetGameIniFilenames(id, revision))
-    game_ini.Load(File::GetSysDirectory() + GAMESETTINGS_DIR DIR_SEP + filename, true);
-  for (const std::string& filename : ConfigLoaders::GetGameIniFilenames(id, revision))
-    game_ini.Load(File::GetUserPath(D_GAMESETTINGS_IDX) + filename, true);
-  return game_ini;
+  const std::vector<std::string> filenames = ConfigLoaders::GetGameIniFilenames(id, revision);
+  std::vector<std::string> paths;
+  for (const std::string& filename : filenames)
+    paths.push_back(File::GetSysDirectory() + GAMESETTINGS_DIR DIR_SEP + filename);
+  for (const std::string& filename : filenames)
+    paths.push_back(File::GetUserPath(D_GAMESETTINGS_IDX) + filename);
+  return ConfigLoaders::LoadGameIniFiles("", paths);
 }
 
 std::string SConfig::GetGameTDBImageRegionCode(bool wii, DiscIO::Region region) const
@@ -31,12 +31,15 @@
 #include "Common/FileUtil.h"
 #include "Common/Flag.h"
 #include "Common/Logging/Log.h"
+#include "Common/MemoryAccounting.h"
 #include "Common/MemoryUtil.h"
 #include "Common/MsgHandler.h"
 #include "Common/ScopeGuard.h"
 #include "Common/StringUtil.h"
 #include "Common/Thread.h"
+#include "Common/ThreadPolicy.h"
 #include "Common/Timer.h"
+#include "Common/TraceZone.h"
 #include "Common/Version.h"
 
 #include "Core/AchievementManager.h"
@@ -65,6 +68,7 @@
 #include "Core/Host.h"
 #include "Core/IOS/IOS.h"
 #include "Core/MemTools.h"
+#include "Core/MetricsServer.h"
 #include "Core/Movie.h"
 #include "Core/NetPlayClient.h"
 #include "Core/NetPlayProto.h"
@@ -90,6 +94,7 @@
 #include "VideoCommon/AsyncRequests.h"
 #include "VideoCommon/Fifo.h"
 #include "VideoCommon/FrameDumper.h"
+#include "VideoCommon/FrameTimeReport.h"
 #include "VideoCommon/OnScreenDisplay.h"
 #include "VideoCommon/PerformanceMetrics.h"
 #include "VideoCommon/Present.h"
@@ -177,6 +182,8 @@ void OnFrameEnd(Core::System& system)
     s_memory_watcher->Step(guard);
   }
 #endif
+
+  ::State::OnFrameEnd();
 }
 
 // Display messages and return values
@@ -370,6 +377,7 @@ static void CpuThread(Core::System& system, const std::optional<std::string>& sa
                       bool delete_savestate)
 {
   DeclareAsCPUThread();
+  Common::SetCurrentThreadRole(Common::ThreadRole::EmulatedCPU);
 
   if (system.IsDualCoreMode())
     Common::SetCurrentThreadName("CPU thread");
@@ -381,6 +389,7 @@ static void CpuThread(Core::System& system, const std::optional<std::string>& sa
 
   // Clear performance data collected from previous threads.
   g_perf_metrics.Reset();
+  Common::MemoryAccounting::ResetPeaks();
 
   // The JIT need to be able to intercept faults, both for fastmem and for the BLR optimization.
   const bool exception_handler = EMM::IsExceptionHandlerSupported();
@@ -449,6 +458,7 @@ static void FifoPlayerThread(Core::System& system, const std::optional<std::stri
                              bool delete_savestate)
 {
   DeclareAsCPUThread();
+  Common::SetCurrentThreadRole(Common::ThreadRole::EmulatedCPU);
 
   if (system.IsDualCoreMode())
     Common::SetCurrentThreadName("FIFO player thread");
@@ -506,6 +516,39 @@ static void EmuThread(Core::System& system, std::unique_ptr<BootParameters> boot
   // If settings have changed since the previous run, notify callbacks.
   CPUThreadConfigCallback::CheckForConfigChanges();
 
+  Common::SetThreadRolePolicy(Common::ThreadRole::EmulatedCPU,
+                              Config::Get(Config::MAIN_CPU_THREAD_POLICY));
+  Common::SetThreadRolePolicy(Common::ThreadRole::GPU, Config::Get(Config::MAIN_GPU_THREAD_POLICY));
+  Common::SetThreadRolePolicy(Common::ThreadRole::Audio,
+                              Config::Get(Config::MAIN_AUDIO_THREAD_POLICY));
+  Common::SetThreadRolePolicy(Common::ThreadRole::Background,
+                              Config::Get(Config::MAIN_BACKGROUND_THREAD_POLICY));
+
+#ifdef USE_TRACE_ZONES
+  // The capture covers the whole session, including shutting down.
+  if (Config::Get(Config::MAIN_CAPTURE_TRACE_ZONES))
+    Common::Trace::StartCapture();
+  Common::ScopeGuard trace_guard{[] {
+    if (!Common::Trace::IsCapturing())
+      return;
+    const std::string path = fmt::format("{}trace_{:%Y-%m-%d_%H-%M-%S}.json",
+                                         File::GetUserPath(D_DUMP_IDX),
+                                         fmt::localtime(std::time(nullptr)));
+    Common::Trace::StopCapture(path);
+  }};
+#endif
+
+  if (Config::Get(Config::MAIN_FRAME_TIME_REPORT))
+    g_frame_time_report.Start();
+  Common::ScopeGuard frame_time_report_guard{[] {
+    if (!g_frame_time_report.IsEnabled())
+      return;
+    const std::string path = fmt::format("{}frame_times_{:%Y-%m-%d_%H-%M-%S}.txt",
+                                         File::GetUserPath(D_LOGS_IDX),
+                                         fmt::localtime(std::time(nullptr)));
+    g_frame_time_report.StopAndWrite(path);
+  }};
+
   // Switch the window used for inputs to the render window. This way, the cursor position
   // is relative to the render window, instead of the main window.
   ASSERT(g_controller_interface.IsInit());
@@ -520,16 +563,16 @@ static void EmuThread(Core::System& system, std::unique_ptr<BootParameters> boot
   const bool delete_savestate =
       boot_session_data.GetDeleteSavestate() == DeleteSavestateAfterBoot::Yes;
 
-  bool sync_sd_folder = system.IsWii() && Config::Get(Config::MAIN_WII_SD_CARD) &&
-                        Config::Get(Config::MAIN_WII_SD_CARD_ENABLE_FOLDER_SYNC);
+  const bool sync_sd_folder = system.IsWii() && Config::Get(Config::MAIN_WII_SD_CARD) &&
+                              Config::Get(Config::MAIN_WII_SD_CARD_ENABLE_FOLDER_SYNC);
+  // The SD card device waits for the image when it is opened.
   if (sync_sd_folder)
-  {
-    sync_sd_folder =
-        Common::SyncSDFolderToSDImage([]() { return false; }, Core::WantsDeterminism());
-  }
+    Common::StartSDFolderToSDImageSync(Core::WantsDeterminism());
 
   Common::ScopeGuard sd_folder_sync_guard{[sync_sd_folder] {
-    if (sync_sd_folder && Config::Get(Config::MAIN_ALLOW_SD_WRITES))
+    // Don't overwrite the folder with an image that failed to be created.
+    if (sync_sd_folder && Common::WaitForSDFolderToSDImageSync() &&
+        Config::Get(Config::MAIN_ALLOW_SD_WRITES))
     {
       const bool sync_ok = Common::SyncSDImageToSDFolder([]() { return false; });
       if (!sync_ok)
@@ -559,6 +602,7 @@ static void EmuThread(Core::System& system, std::unique_ptr<BootParameters> boot
   AudioCommon::InitSoundStream(system);
   Common::ScopeGuard audio_guard([&system] { AudioCommon::ShutdownSoundStream(system); });
 
+  Common::SetHugePagesEnabled(Config::Get(Config::MAIN_HUGE_PAGES));
   HW::Init(system,
            NetPlay::IsNetPlayRunning() ? &(boot_session_data.GetNetplaySettings()->sram) : nullptr);
 
@@ -606,6 +650,9 @@ static void EmuThread(Core::System& system, std::unique_ptr<BootParameters> boot
 
   AudioCommon::PostInitSoundStream(system);
 
+  // Declared after the audio and video guards, so that it stops before they shut down.
+  const std::unique_ptr<MetricsServer> metrics_server = MetricsServer::Create(system);
+
   // Set execution state to known values (CPU/FIFO/Audio Paused)
   system.GetCPU().Break();
 
@@ -664,6 +711,7 @@ static void EmuThread(Core::System& system, std::unique_ptr<BootParameters> boot
     // This thread, after creating the EmuWindow, spawns a CPU
     // thread, and then takes over and becomes the video thread
     Common::SetCurrentThreadName("Video thread");
+    Common::SetCurrentThreadRole(Common::ThreadRole::GPU);
     UndeclareAsCPUThread();
     Common::FPU::LoadDefaultSIMDState();
 
@@ -871,6 +919,7 @@ void RunOnCPUThread(Core::System& system, std::function<void()> function, bool w
 void Callback_FramePresented(double actual_emulation_speed)
 {
   g_perf_metrics.CountFrame();
+  g_frame_time_report.CountFrame();
 
   s_last_actual_emulation_speed = actual_emulation_speed;
   s_stop_frame_step.store(true);
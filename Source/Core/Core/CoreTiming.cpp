@@ -4,7 +4,8 @@
 #include "Core/CoreTiming.h"
 
 #include <algorithm>
-#include <mutex>
+#include <bit>
+#include <functional>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -13,14 +14,16 @@
 
 #include "Common/Assert.h"
 #include "Common/ChunkFile.h"
+#include "Common/JsonUtil.h"
 #include "Common/Logging/Log.h"
-#include "Common/SPSCQueue.h"
+#include "Common/TraceZone.h"
 
 #include "Core/AchievementManager.h"
 #include "Core/CPUThreadConfigCallback.h"
 #include "Core/Config/AchievementSettings.h"
 #include "Core/Config/MainSettings.h"
 #include "Core/Core.h"
+#include "Core/PowerPC/JitInterface.h"
 #include "Core/PowerPC/PowerPC.h"
 #include "Core/System.h"
 
@@ -44,6 +47,123 @@ static bool operator<(const Event& left, const Event& right)
 
 static constexpr int MAX_SLICE_LENGTH = 20000;
 
+size_t EventQueue::FrontBucket() const
+{
+  const size_t base_bucket = BucketOf(m_base_slot);
+  const u64 mask = std::rotr(m_wheel_mask, static_cast<int>(base_bucket));
+  return (base_bucket + std::countr_zero(mask)) % NUM_WHEEL_SLOTS;
+}
+
+void EventQueue::Insert(const Event& ev)
+{
+  // Events that are already due share the first slot; the bucket order keeps them sorted.
+  const s64 slot = std::max(SlotOf(ev.time), m_base_slot);
+  if (slot - m_base_slot >= static_cast<s64>(NUM_WHEEL_SLOTS))
+  {
+    m_far_events.push_back(ev);
+    std::push_heap(m_far_events.begin(), m_far_events.end(), std::greater<Event>());
+    return;
+  }
+
+  const size_t bucket_index = BucketOf(slot);
+  std::vector<Event>& bucket = m_wheel[bucket_index];
+  bucket.insert(std::upper_bound(bucket.begin(), bucket.end(), ev, std::greater<Event>()), ev);
+  m_wheel_mask |= u64(1) << bucket_index;
+}
+
+const Event& EventQueue::Front() const
+{
+  // Everything in the wheel is due before anything in the heap.
+  if (m_wheel_mask != 0)
+    return m_wheel[FrontBucket()].back();
+  return m_far_events.front();
+}
+
+Event EventQueue::PopFront()
+{
+  if (m_wheel_mask != 0)
+  {
+    const size_t bucket_index = FrontBucket();
+    std::vector<Event>& bucket = m_wheel[bucket_index];
+    Event ev = bucket.back();
+    bucket.pop_back();
+    if (bucket.empty())
+      m_wheel_mask &= ~(u64(1) << bucket_index);
+    return ev;
+  }
+
+  std::pop_heap(m_far_events.begin(), m_far_events.end(), std::greater<Event>());
+  Event ev = m_far_events.back();
+  m_far_events.pop_back();
+  return ev;
+}
+
+void EventQueue::AdvanceTo(s64 global_timer)
+{
+  s64 new_base_slot = SlotOf(global_timer);
+  if (m_wheel_mask != 0)
+  {
+    const size_t offset = (FrontBucket() - BucketOf(m_base_slot)) % NUM_WHEEL_SLOTS;
+    new_base_slot = std::min(new_base_slot, m_base_slot + static_cast<s64>(offset));
+  }
+  if (new_base_slot <= m_base_slot)
+    return;
+
+  m_base_slot = new_base_slot;
+
+  const s64 horizon = (m_base_slot + static_cast<s64>(NUM_WHEEL_SLOTS)) << WHEEL_SLOT_SHIFT;
+  while (!m_far_events.empty() && m_far_events.front().time < horizon)
+  {
+    std::pop_heap(m_far_events.begin(), m_far_events.end(), std::greater<Event>());
+    Insert(m_far_events.back());
+    m_far_events.pop_back();
+  }
+}
+
+void EventQueue::RemoveAll(const EventType* type)
+{
+  const auto matches = [type](const Event& e) { return e.type == type; };
+
+  for (size_t i = 0; i < NUM_WHEEL_SLOTS; ++i)
+  {
+    if ((m_wheel_mask & (u64(1) << i)) == 0)
+      continue;
+
+    // Erasing preserves the relative order, so the bucket stays sorted.
+    std::erase_if(m_wheel[i], matches);
+    if (m_wheel[i].empty())
+      m_wheel_mask &= ~(u64(1) << i);
+  }
+
+  // Removing random items breaks the invariant so we have to re-establish it.
+  if (std::erase_if(m_far_events, matches) != 0)
+    std::make_heap(m_far_events.begin(), m_far_events.end(), std::greater<Event>());
+}
+
+std::vector<Event> EventQueue::GetAll() const
+{
+  std::vector<Event> events = m_far_events;
+  for (const std::vector<Event>& bucket : m_wheel)
+    events.insert(events.end(), bucket.begin(), bucket.end());
+  return events;
+}
+
+void EventQueue::Assign(std::vector<Event> events, s64 global_timer)
+{
+  Clear();
+  m_base_slot = SlotOf(global_timer);
+  for (const Event& ev : events)
+    Insert(ev);
+}
+
+void EventQueue::Clear()
+{
+  for (std::vector<Event>& bucket : m_wheel)
+    bucket.clear();
+  m_wheel_mask = 0;
+  m_far_events.clear();
+}
+
 static void EmptyTimedCallback(Core::System& system, u64 userdata, s64 cyclesLate)
 {
 }
@@ -78,6 +198,7 @@ EventType* CoreTimingManager::RegisterEvent(const std::string& name, TimedCallba
              "during Init to avoid breaking save states.",
              name);
 
+  std::lock_guard lk(m_event_stats_lock);
   auto info = m_event_types.emplace(name, EventType{callback, nullptr});
   EventType* event_type = &info.first->second;
   event_type->name = &info.first->first;
@@ -86,7 +207,8 @@ EventType* CoreTimingManager::RegisterEvent(const std::string& name, TimedCallba
 
 void CoreTimingManager::UnregisterAllEvents()
 {
-  ASSERT_MSG(POWERPC, m_event_queue.empty(), "Cannot unregister events with events pending");
+  ASSERT_MSG(POWERPC, m_event_queue.Empty(), "Cannot unregister events with events pending");
+  std::lock_guard lk(m_event_stats_lock);
   m_event_types.clear();
 }
 
@@ -118,7 +240,6 @@ void CoreTimingManager::Init()
 
 void CoreTimingManager::Shutdown()
 {
-  std::lock_guard lk(m_ts_write_lock);
   MoveEvents();
   ClearPendingEvents();
   UnregisterAllEvents();
@@ -132,6 +253,11 @@ void CoreTimingManager::RefreshConfig()
   m_config_oc_inv_factor = 1.0f / m_config_oc_factor;
   m_config_sync_on_skip_idle = Config::Get(Config::MAIN_SYNC_ON_SKIP_IDLE);
 
+  const bool event_stats = Config::Get(Config::MAIN_CORETIMING_EVENT_STATS);
+  if (m_config_event_stats && !event_stats)
+    ResetEventStats();
+  m_config_event_stats = event_stats;
+
   // A maximum fallback is used to prevent the system from sleeping for
   // too long or going full speed in an attempt to catch up to timings.
   m_max_fallback = std::chrono::duration_cast<DT>(DT_ms(Config::Get(Config::MAIN_MAX_FALLBACK)));
@@ -152,7 +278,6 @@ void CoreTimingManager::RefreshConfig()
 
 void CoreTimingManager::DoState(PointerWrap& p)
 {
-  std::lock_guard lk(m_ts_write_lock);
   p.Do(m_globals.slice_length);
   p.Do(m_globals.global_timer);
   p.Do(m_idled_cycles);
@@ -167,7 +292,8 @@ void CoreTimingManager::DoState(PointerWrap& p)
   p.DoMarker("CoreTimingData");
 
   MoveEvents();
-  p.DoEachElement(m_event_queue, [this](PointerWrap& pw, Event& ev) {
+  std::vector<Event> events = m_event_queue.GetAll();
+  p.DoEachElement(events, [this](PointerWrap& pw, Event& ev) {
     pw.Do(ev.time);
     pw.Do(ev.fifo_order);
 
@@ -203,9 +329,8 @@ void CoreTimingManager::DoState(PointerWrap& p)
   if (p.IsReadMode())
   {
     // When loading from a save state, we must assume the Event order is random and meaningless.
-    // The exact layout of the heap in memory is implementation defined, therefore it is platform
-    // and library version specific.
-    std::make_heap(m_event_queue.begin(), m_event_queue.end(), std::greater<Event>());
+    // The layout of the queue in memory depends on when each event was scheduled.
+    m_event_queue.Assign(std::move(events), m_globals.global_timer);
 
     // The stave state has changed the time, so our previous Throttle targets are invalid.
     // Especially when global_time goes down; So we create a fake throttle update.
@@ -233,7 +358,7 @@ u64 CoreTimingManager::GetIdleTicks() const
 
 void CoreTimingManager::ClearPendingEvents()
 {
-  m_event_queue.clear();
+  m_event_queue.Clear();
 }
 
 void CoreTimingManager::ScheduleEvent(s64 cycles_into_future, EventType* event_type, u64 userdata,
@@ -262,8 +387,7 @@ void CoreTimingManager::ScheduleEvent(s64 cycles_into_future, EventType* event_t
     if (!m_is_global_timer_sane)
       ForceExceptionCheck(cycles_into_future);
 
-    m_event_queue.emplace_back(Event{timeout, m_event_fifo_id++, userdata, event_type});
-    std::push_heap(m_event_queue.begin(), m_event_queue.end(), std::greater<Event>());
+    m_event_queue.Insert(Event{timeout, m_event_fifo_id++, userdata, event_type});
   }
   else
   {
@@ -275,22 +399,13 @@ void CoreTimingManager::ScheduleEvent(s64 cycles_into_future, EventType* event_t
                     *event_type->name);
     }
 
-    std::lock_guard lk(m_ts_write_lock);
     m_ts_queue.Push(Event{m_globals.global_timer + cycles_into_future, 0, userdata, event_type});
   }
 }
 
 void CoreTimingManager::RemoveEvent(EventType* event_type)
 {
-  auto itr = std::remove_if(m_event_queue.begin(), m_event_queue.end(),
-                            [&](const Event& e) { return e.type == event_type; });
-
-  // Removing random items breaks the invariant so we have to re-establish it.
-  if (itr != m_event_queue.end())
-  {
-    m_event_queue.erase(itr, m_event_queue.end());
-    std::make_heap(m_event_queue.begin(), m_event_queue.end(), std::greater<Event>());
-  }
+  m_event_queue.RemoveAll(event_type);
 }
 
 void CoreTimingManager::RemoveAllEvents(EventType* event_type)
@@ -314,16 +429,18 @@ void CoreTimingManager::ForceExceptionCheck(s64 cycles)
 
 void CoreTimingManager::MoveEvents()
 {
-  for (Event ev; m_ts_queue.Pop(ev);)
-  {
+  if (m_ts_queue.Empty())
+    return;
+
+  m_ts_queue.PopAll([this](Event&& ev) {
     ev.fifo_order = m_event_fifo_id++;
-    m_event_queue.emplace_back(std::move(ev));
-    std::push_heap(m_event_queue.begin(), m_event_queue.end(), std::greater<Event>());
-  }
+    m_event_queue.Insert(ev);
+  });
 }
 
 void CoreTimingManager::Advance()
 {
+  TRACE_ZONE("CoreTiming::Advance");
   CPUThreadConfigCallback::CheckForConfigChanges();
 
   MoveEvents();
@@ -331,6 +448,8 @@ void CoreTimingManager::Advance()
   auto& power_pc = m_system.GetPowerPC();
   auto& ppc_state = power_pc.GetPPCState();
 
+  m_system.GetJitInterface().OnDispatch(ppc_state.pc, ppc_state.feature_flags);
+
   int cyclesExecuted = m_globals.slice_length - DowncountToCycles(ppc_state.downcount);
   m_globals.global_timer += cyclesExecuted;
   m_last_oc_factor = m_config_oc_factor;
@@ -339,23 +458,34 @@ void CoreTimingManager::Advance()
 
   m_is_global_timer_sane = true;
 
-  while (!m_event_queue.empty() && m_event_queue.front().time <= m_globals.global_timer)
+  while (!m_event_queue.Empty() && m_event_queue.Front().time <= m_globals.global_timer)
   {
-    Event evt = std::move(m_event_queue.front());
-    std::pop_heap(m_event_queue.begin(), m_event_queue.end(), std::greater<Event>());
-    m_event_queue.pop_back();
+    Event evt = m_event_queue.PopFront();
 
     Throttle(evt.time);
-    evt.type->callback(m_system, evt.userdata, m_globals.global_timer - evt.time);
+
+    const s64 cycles_late = m_globals.global_timer - evt.time;
+    if (m_config_event_stats)
+    {
+      const TimePoint start = Clock::now();
+      evt.type->callback(m_system, evt.userdata, cycles_late);
+      RecordEventStats(evt.type, cycles_late, Clock::now() - start);
+    }
+    else
+    {
+      evt.type->callback(m_system, evt.userdata, cycles_late);
+    }
   }
 
   m_is_global_timer_sane = false;
 
+  m_event_queue.AdvanceTo(m_globals.global_timer);
+
   // Still events left (scheduled in the future)
-  if (!m_event_queue.empty())
+  if (!m_event_queue.Empty())
   {
     m_globals.slice_length = static_cast<int>(
-        std::min<s64>(m_event_queue.front().time - m_globals.global_timer, MAX_SLICE_LENGTH));
+        std::min<s64>(m_event_queue.Front().time - m_globals.global_timer, MAX_SLICE_LENGTH));
   }
 
   ppc_state.downcount = CyclesToDowncount(m_globals.slice_length);
@@ -440,7 +570,7 @@ bool CoreTimingManager::UseSyncOnSkipIdle() const
 
 void CoreTimingManager::LogPendingEvents() const
 {
-  auto clone = m_event_queue;
+  auto clone = m_event_queue.GetAll();
   std::sort(clone.begin(), clone.end());
   for (const Event& ev : clone)
   {
@@ -455,11 +585,74 @@ void CoreTimingManager::AdjustEventQueueTimes(u32 new_ppc_clock, u32 old_ppc_clo
   m_throttle_clock_per_sec = new_ppc_clock;
   m_throttle_min_clock_per_sleep = new_ppc_clock / 1200;
 
-  for (Event& ev : m_event_queue)
+  std::vector<Event> events = m_event_queue.GetAll();
+  for (Event& ev : events)
   {
     const s64 ticks = (ev.time - m_globals.global_timer) * new_ppc_clock / old_ppc_clock;
     ev.time = m_globals.global_timer + ticks;
   }
+  m_event_queue.Assign(std::move(events), m_globals.global_timer);
+}
+
+void CoreTimingManager::RecordEventStats(EventType* event_type, s64 cycles_late, DT host_time)
+{
+  const size_t bucket =
+      std::min<size_t>(std::bit_width(static_cast<u64>(std::max<s64>(cycles_late, 0))),
+                       EventStats::NUM_LATENESS_BUCKETS - 1);
+
+  std::lock_guard lk(m_event_stats_lock);
+  EventStats& stats = event_type->stats;
+  ++stats.invocations;
+  stats.host_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(host_time).count();
+  ++stats.lateness_histogram[bucket];
+}
+
+void CoreTimingManager::RecordNestedEventStats(EventType* event_type, DT host_time)
+{
+  RecordEventStats(event_type, 0, host_time);
+}
+
+std::vector<std::pair<std::string, EventStats>> CoreTimingManager::GetEventStats() const
+{
+  std::vector<std::pair<std::string, EventStats>> result;
+  {
+    std::lock_guard lk(m_event_stats_lock);
+    for (const auto& [name, event_type] : m_event_types)
+    {
+      if (event_type.stats.invocations != 0)
+        result.emplace_back(name, event_type.stats);
+    }
+  }
+
+  std::sort(result.begin(), result.end(), [](const auto& a, const auto& b) {
+    return a.second.host_ns > b.second.host_ns;
+  });
+  return result;
+}
+
+void CoreTimingManager::ResetEventStats()
+{
+  std::lock_guard lk(m_event_stats_lock);
+  for (auto& [name, event_type] : m_event_types)
+    event_type.stats = {};
+}
+
+bool CoreTimingManager::DumpEventStats(const std::string& path) const
+{
+  picojson::array events;
+  for (const auto& [name, stats] : GetEventStats())
+  {
+    picojson::object event;
+    event["name"] = picojson::value(name);
+    event["invocations"] = picojson::value(static_cast<double>(stats.invocations));
+    event["host_ns"] = picojson::value(static_cast<double>(stats.host_ns));
+    event["lateness_histogram"] = picojson::value(ToJsonArray(stats.lateness_histogram));
+    events.emplace_back(std::move(event));
+  }
+
+  picojson::object root;
+  root["events"] = picojson::value(std::move(events));
+  return JsonToFile(path, picojson::value(std::move(root)), true);
 }
 
 void CoreTimingManager::Idle()
@@ -483,7 +676,7 @@ std::string CoreTimingManager::GetScheduledEventsSummary() const
   std::string text = "Scheduled events\n";
   text.reserve(1000);
 
-  auto clone = m_event_queue;
+  auto clone = m_event_queue.GetAll();
   std::sort(clone.begin(), clone.end());
   for (const Event& ev : clone)
   {
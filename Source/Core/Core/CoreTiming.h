@@ -16,13 +16,15 @@
 // inside callback:
 //   ScheduleEvent(periodInCycles - cyclesLate, callback, "whatever")
 
+#include <array>
 #include <mutex>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "Common/CommonTypes.h"
-#include "Common/SPSCQueue.h"
+#include "Common/MPSCQueue.h"
 #include "Core/CPUThreadConfigCallback.h"
 
 class PointerWrap;
@@ -46,10 +48,22 @@ struct Globals
 
 typedef void (*TimedCallback)(Core::System& system, u64 userdata, s64 cyclesLate);
 
+// Host cost of an event type's callback. Only collected while MAIN_CORETIMING_EVENT_STATS is set.
+struct EventStats
+{
+  // Bucket 0 counts callbacks that ran on time, bucket n those that ran [2^(n-1), 2^n) cycles late.
+  static constexpr size_t NUM_LATENESS_BUCKETS = 24;
+
+  u64 invocations = 0;
+  u64 host_ns = 0;
+  std::array<u64, NUM_LATENESS_BUCKETS> lateness_histogram{};
+};
+
 struct EventType
 {
   TimedCallback callback;
   const std::string* name;
+  EventStats stats;
 };
 
 struct Event
@@ -60,6 +74,51 @@ struct Event
   EventType* type;
 };
 
+// Pending events ordered by (time, fifo_order).
+// Most events are scheduled less than a few frames of VI/SI/DSP/AI work into the future, so those
+// are kept in a timing wheel of NUM_WHEEL_SLOTS buckets, each covering 2^WHEEL_SLOT_SHIFT cycles.
+// Inserting into or popping from a bucket only touches the handful of events sharing that slot.
+// Events beyond the wheel's horizon go into a min-heap and migrate into the wheel as time advances.
+class EventQueue
+{
+public:
+  static constexpr int WHEEL_SLOT_SHIFT = 12;
+  static constexpr size_t NUM_WHEEL_SLOTS = 64;
+
+  bool Empty() const { return m_wheel_mask == 0 && m_far_events.empty(); }
+  void Insert(const Event& ev);
+
+  // Only valid if the queue is not empty.
+  const Event& Front() const;
+  Event PopFront();
+
+  // Moves the wheel forward to the slot containing global_timer. Never skips an occupied slot.
+  void AdvanceTo(s64 global_timer);
+
+  void RemoveAll(const EventType* type);
+
+  // All events in an unspecified order.
+  std::vector<Event> GetAll() const;
+  // Replaces the contents of the queue. The events may be in any order.
+  void Assign(std::vector<Event> events, s64 global_timer);
+  void Clear();
+
+private:
+  static s64 SlotOf(s64 time) { return time >> WHEEL_SLOT_SHIFT; }
+  static size_t BucketOf(s64 slot) { return static_cast<size_t>(slot) % NUM_WHEEL_SLOTS; }
+  size_t FrontBucket() const;
+
+  // Each bucket is sorted in descending order so that its earliest event is at the back.
+  std::array<std::vector<Event>, NUM_WHEEL_SLOTS> m_wheel;
+  // Bit n is set if m_wheel[n] is non-empty.
+  u64 m_wheel_mask = 0;
+  // The slot whose events are due first. The wheel covers [m_base_slot, m_base_slot + 64).
+  s64 m_base_slot = 0;
+
+  // A min-heap using std::make_heap/push_heap/pop_heap.
+  std::vector<Event> m_far_events;
+};
+
 enum class FromThread
 {
   CPU,
@@ -129,6 +188,17 @@ public:
 
   void AdjustEventQueueTimes(u32 new_ppc_clock, u32 old_ppc_clock);
 
+  // Safe to call from any thread. Only event types that have run are returned, most expensive
+  // first.
+  std::vector<std::pair<std::string, EventStats>> GetEventStats() const;
+  void ResetEventStats();
+  bool DumpEventStats(const std::string& path) const;
+
+  // For work that runs inside another event's callback but is worth measuring on its own. The
+  // time is counted against event_type (which is never scheduled) as well as the outer event.
+  bool AreEventStatsEnabled() const { return m_config_event_stats; }
+  void RecordNestedEventStats(EventType* event_type, DT host_time);
+
   u32 GetFakeDecStartValue() const;
   void SetFakeDecStartValue(u32 val);
   u64 GetFakeDecStartTicks() const;
@@ -161,16 +231,14 @@ private:
   // unordered_map stores each element separately as a linked list node so pointers to elements
   // remain stable regardless of rehashes/resizing.
   std::unordered_map<std::string, EventType> m_event_types;
+  // Guards m_event_types and their stats against GetEventStats() on other threads.
+  mutable std::mutex m_event_stats_lock;
 
   // STATE_TO_SAVE
-  // The queue is a min-heap using std::make_heap/push_heap/pop_heap.
-  // We don't use std::priority_queue because we need to be able to serialize, unserialize and
-  // erase arbitrary events (RemoveEvent()) regardless of the queue order. These aren't accomodated
-  // by the standard adaptor class.
-  std::vector<Event> m_event_queue;
+  EventQueue m_event_queue;
   u64 m_event_fifo_id = 0;
-  std::mutex m_ts_write_lock;
-  Common::SPSCQueue<Event, false> m_ts_queue;
+  // Events scheduled from other threads, moved into m_event_queue by MoveEvents().
+  Common::MPSCQueue<Event> m_ts_queue;
 
   float m_last_oc_factor = 0.0f;
 
@@ -187,6 +255,7 @@ private:
   float m_config_oc_factor = 0.0f;
   float m_config_oc_inv_factor = 0.0f;
   bool m_config_sync_on_skip_idle = false;
+  bool m_config_event_stats = false;
 
   s64 m_throttle_last_cycle = 0;
   TimePoint m_throttle_deadline = Clock::now();
@@ -199,6 +268,7 @@ private:
   double m_emulation_speed = 1.0;
 
   void ResetThrottle(s64 cycle);
+  void RecordEventStats(EventType* event_type, s64 cycles_late, DT host_time);
 
   int DowncountToCycles(int downcount) const;
   int CyclesToDowncount(int cycles) const;
@@ -419,8 +419,11 @@ bool DSPCore::Initialize(const DSPInitOptions& opts)
   m_init_hax = false;
 
   // Initialize JIT, if necessary
-  if (opts.core_type == DSPInitOptions::CoreType::JIT64)
+  if (opts.core_type == DSPInitOptions::CoreType::JIT64 ||
+      opts.core_type == DSPInitOptions::CoreType::JITARM64)
+  {
     m_dsp_jit = JIT::CreateDSPEmitter(*this);
+  }
 
   m_dsp_cap.reset(opts.capture_logger);
 
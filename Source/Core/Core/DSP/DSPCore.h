@@ -298,6 +298,7 @@ struct DSPInitOptions
   {
     Interpreter,
     JIT64,
+    JITARM64,
   };
   CoreType core_type = CoreType::JIT64;
 
@@ -0,0 +1,437 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/DSP/Jit/Arm64/DSPEmitter.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <optional>
+
+#include "Common/Assert.h"
+#include "Common/BitSet.h"
+#include "Common/ChunkFile.h"
+#include "Common/CommonTypes.h"
+#include "Common/Logging/Log.h"
+#include "Common/MemoryUtil.h"
+
+#include "Core/DSP/DSPAnalyzer.h"
+#include "Core/DSP/DSPCore.h"
+#include "Core/DSP/DSPHost.h"
+#include "Core/DSP/DSPTables.h"
+#include "Core/DSP/Interpreter/DSPIntTables.h"
+#include "Core/DSP/Interpreter/DSPInterpreter.h"
+
+using namespace Arm64Gen;
+
+#ifdef __GNUC__
+#pragma GCC diagnostic ignored "-Winvalid-offsetof"
+#endif
+#define SDSP_OFF(elem) (static_cast<s32>(offsetof(SDSP, elem)))
+#define SDSP_OFF_ST(index) (SDSP_OFF(r.st) + static_cast<s32>(sizeof(u16) * (index)))
+
+namespace DSP::JIT::Arm64
+{
+constexpr size_t COMPILED_CODE_SIZE = 2097152;
+constexpr size_t MAX_BLOCK_SIZE = 250;
+constexpr u16 DSP_IDLE_SKIP_CYCLES = 0x1000;
+
+// Holds the SDSP pointer for the whole time the dispatcher runs.
+constexpr ARM64Reg DSP_REG = ARM64Reg::X28;
+
+// Opcodes of unconditional JMP and CALL, whose destination is the immediate following them.
+constexpr UDSPInstruction OPCODE_JMP = 0x029f;
+constexpr UDSPInstruction OPCODE_CALL = 0x02bf;
+
+DSPEmitter::DSPEmitter(DSPCore& dsp)
+    : m_blocks(MAX_BLOCKS), m_block_size(MAX_BLOCKS), m_block_links(MAX_BLOCKS), m_dsp_core{dsp}
+{
+  AllocCodeSpace(COMPILED_CODE_SIZE);
+
+  const Common::ScopedJITPageWriteAndNoExecute enable_jit_page_writes;
+  CompileDispatcher();
+  m_stub_entry_point = CompileStub();
+  FlushIcache();
+
+  // Clear all of the block references
+  std::fill(m_blocks.begin(), m_blocks.end(), m_stub_entry_point);
+}
+
+DSPEmitter::~DSPEmitter()
+{
+  FreeCodeSpace();
+}
+
+u16 DSPEmitter::RunCycles(u16 cycles)
+{
+  if (m_dsp_core.DSPState().external_interrupt_waiting.exchange(false, std::memory_order_acquire))
+  {
+    m_dsp_core.CheckExternalInterrupt();
+    m_dsp_core.CheckExceptions();
+  }
+
+  m_cycles_left = cycles;
+  reinterpret_cast<void (*)()>(m_enter_dispatcher)();
+
+  if (m_dsp_core.DSPState().reset_dspjit_codespace)
+    ClearIRAMandDSPJITCodespaceReset();
+
+  return m_cycles_left;
+}
+
+void DSPEmitter::DoState(PointerWrap& p)
+{
+  p.Do(m_cycles_left);
+}
+
+void DSPEmitter::ClearIRAM()
+{
+  for (size_t i = 0; i < DSP_IRAM_SIZE; i++)
+  {
+    m_blocks[i] = m_stub_entry_point;
+    m_block_links[i] = nullptr;
+    m_block_size[i] = 0;
+    m_unresolved_jumps[i].clear();
+  }
+  m_dsp_core.DSPState().reset_dspjit_codespace = true;
+}
+
+void DSPEmitter::ClearIRAMandDSPJITCodespaceReset()
+{
+  {
+    const Common::ScopedJITPageWriteAndNoExecute enable_jit_page_writes;
+    ClearCodeSpace();
+    CompileDispatcher();
+    m_stub_entry_point = CompileStub();
+    FlushIcache();
+  }
+
+  for (size_t i = 0; i < MAX_BLOCKS; i++)
+  {
+    m_blocks[i] = m_stub_entry_point;
+    m_block_links[i] = nullptr;
+    m_block_size[i] = 0;
+    m_unresolved_jumps[i].clear();
+  }
+  m_dsp_core.DSPState().reset_dspjit_codespace = false;
+}
+
+static void CheckExceptionsThunk(DSPCore& dsp)
+{
+  dsp.CheckExceptions();
+}
+
+// Must go out of block if exception is detected
+void DSPEmitter::checkExceptions(u32 retval)
+{
+  // Check for interrupts and exceptions
+  LDRB(IndexType::Unsigned, ARM64Reg::W8, DSP_REG, SDSP_OFF(exceptions));
+  FixupBranch skip_check = CBZ(ARM64Reg::W8);
+
+  MOVI2R(ARM64Reg::W8, m_compile_pc);
+  STRH(IndexType::Unsigned, ARM64Reg::W8, DSP_REG, SDSP_OFF(pc));
+  ABI_CallFunction(&CheckExceptionsThunk, &m_dsp_core);
+  MOVI2R(ARM64Reg::W0, retval);
+  B(m_return_dispatcher);
+
+  SetJumpTarget(skip_check);
+}
+
+static void FallbackThunk(Interpreter::Interpreter& interpreter, UDSPInstruction inst)
+{
+  (interpreter.*Interpreter::GetOp(inst))(inst);
+}
+
+static void FallbackExtendedThunk(Interpreter::Interpreter& interpreter, UDSPInstruction inst)
+{
+  (interpreter.*Interpreter::GetExtOp(inst))(inst);
+  (interpreter.*Interpreter::GetOp(inst))(inst);
+  interpreter.ApplyWriteBackLog();
+}
+
+void DSPEmitter::FallBackToInterpreter(UDSPInstruction inst)
+{
+  const DSPOPCTemplate* const op_template = GetOpTemplate(inst);
+
+  // Fallbacks to interpreter need the PC for fetching immediate values, and branches compare
+  // against it afterwards to tell if they were taken.
+  if (op_template->reads_pc || op_template->branch)
+  {
+    MOVI2R(ARM64Reg::W8, static_cast<u16>(m_compile_pc + 1));
+    STRH(IndexType::Unsigned, ARM64Reg::W8, DSP_REG, SDSP_OFF(pc));
+  }
+
+  ASSERT_MSG(DSPLLE, Interpreter::GetOp(inst) != nullptr, "No function for {:04x}", inst);
+  if (op_template->extended)
+    ABI_CallFunction(&FallbackExtendedThunk, &m_dsp_core.GetInterpreter(), inst);
+  else
+    ABI_CallFunction(&FallbackThunk, &m_dsp_core.GetInterpreter(), inst);
+}
+
+void DSPEmitter::EmitInstruction(UDSPInstruction inst)
+{
+  FallBackToInterpreter(inst);
+}
+
+u16 DSPEmitter::GetBlockCycles() const
+{
+  if (!Host::OnThread() && m_dsp_core.DSPState().GetAnalyzer().IsIdleSkip(m_start_address))
+    return DSP_IDLE_SKIP_CYCLES;
+  return m_block_size[m_start_address];
+}
+
+void DSPEmitter::WriteBranchExit()
+{
+  MOVI2R(ARM64Reg::W0, GetBlockCycles());
+  B(m_return_dispatcher);
+}
+
+void DSPEmitter::WriteBlockLink(u16 dest)
+{
+  // Jump directly to the called block if it has already been compiled.
+  if (dest >= m_start_address && dest <= m_compile_pc)
+    return;
+
+  if (m_block_links[dest] != nullptr)
+  {
+    // Check if we have enough cycles to execute the next block
+    MOVP2R(ARM64Reg::X9, &m_cycles_left);
+    LDRH(IndexType::Unsigned, ARM64Reg::W8, ARM64Reg::X9, 0);
+    CMPI2R(ARM64Reg::W8, m_block_size[m_start_address] + m_block_size[dest], ARM64Reg::W10);
+    FixupBranch not_enough_cycles = B(CC_LS);
+
+    SUBI2R(ARM64Reg::W8, ARM64Reg::W8, m_block_size[m_start_address], ARM64Reg::W10);
+    STRH(IndexType::Unsigned, ARM64Reg::W8, ARM64Reg::X9, 0);
+    B(m_block_links[dest]);
+    SetJumpTarget(not_enough_cycles);
+  }
+  else
+  {
+    // The destination has not been compiled yet.  Add it to the list
+    // of blocks that this block is waiting on.
+    m_unresolved_jumps[m_start_address].push_back(dest);
+  }
+}
+
+static void HandleLoopThunk(SDSP& state, u16 loop_end)
+{
+  if (state.r.st[3] == 0 || state.r.st[2] != loop_end)
+    return;
+
+  if (--state.r.st[3] != 0)
+  {
+    state.pc = state.r.st[0];
+  }
+  else
+  {
+    // end of loop
+    state.PopStack(StackRegister::Call);
+    state.PopStack(StackRegister::LoopAddress);
+    state.PopStack(StackRegister::LoopCounter);
+  }
+}
+
+void DSPEmitter::WriteLoopEnd(const DSPOPCTemplate* opcode)
+{
+  LDRH(IndexType::Unsigned, ARM64Reg::W8, DSP_REG, SDSP_OFF_ST(2));
+  FixupBranch no_loop_address = CBZ(ARM64Reg::W8);
+  LDRH(IndexType::Unsigned, ARM64Reg::W8, DSP_REG, SDSP_OFF_ST(3));
+  FixupBranch no_loop_counter = CBZ(ARM64Reg::W8);
+
+  if (!opcode->branch)
+  {
+    // branch insns update the g_dsp.pc
+    MOVI2R(ARM64Reg::W8, m_compile_pc);
+    STRH(IndexType::Unsigned, ARM64Reg::W8, DSP_REG, SDSP_OFF(pc));
+  }
+
+  ABI_CallFunction(&HandleLoopThunk, &m_dsp_core.DSPState(), static_cast<u16>(m_compile_pc - 1));
+  WriteBranchExit();
+
+  SetJumpTarget(no_loop_address);
+  SetJumpTarget(no_loop_counter);
+}
+
+void DSPEmitter::Compile(u16 start_addr)
+{
+  // Remember the current block address for later
+  m_start_address = start_addr;
+  m_unresolved_jumps[start_addr].clear();
+
+  u8* const entry_point = AlignCode16();
+
+  m_compile_pc = start_addr;
+  bool fixup_pc = false;
+  std::optional<u16> link_dest;
+  m_block_size[start_addr] = 0;
+
+  auto& analyzer = m_dsp_core.DSPState().GetAnalyzer();
+  while (m_compile_pc < start_addr + MAX_BLOCK_SIZE)
+  {
+    if (analyzer.IsCheckExceptions(m_compile_pc))
+      checkExceptions(m_block_size[start_addr]);
+
+    const UDSPInstruction inst = m_dsp_core.DSPState().ReadIMEM(m_compile_pc);
+    const DSPOPCTemplate* opcode = GetOpTemplate(inst);
+
+    EmitInstruction(inst);
+    if (inst == OPCODE_JMP || inst == OPCODE_CALL)
+      link_dest = m_dsp_core.DSPState().ReadIMEM(m_compile_pc + 1);
+
+    m_block_size[start_addr]++;
+    m_compile_pc += opcode->size;
+
+    // If the block was trying to link into itself, remove the link
+    m_unresolved_jumps[start_addr].remove(m_compile_pc);
+
+    fixup_pc = true;
+
+    // Handle loop condition, only if current instruction was flagged as a loop destination
+    // by the analyzer.
+    if (analyzer.IsLoopEnd(static_cast<u16>(m_compile_pc - 1u)))
+      WriteLoopEnd(opcode);
+
+    if (opcode->branch)
+    {
+      // don't update g_dsp.pc -- the branch insn already did
+      fixup_pc = false;
+      if (opcode->uncond_branch)
+        break;
+
+      // look at g_dsp.pc if we actually branched
+      LDRH(IndexType::Unsigned, ARM64Reg::W8, DSP_REG, SDSP_OFF(pc));
+      CMPI2R(ARM64Reg::W8, m_compile_pc, ARM64Reg::W9);
+      FixupBranch no_branch = B(CC_EQ);
+      WriteBranchExit();
+      SetJumpTarget(no_branch);
+    }
+
+    // End the block if we're before an idle skip address
+    if (analyzer.IsIdleSkip(m_compile_pc))
+      break;
+  }
+
+  if (fixup_pc)
+  {
+    MOVI2R(ARM64Reg::W8, m_compile_pc);
+    STRH(IndexType::Unsigned, ARM64Reg::W8, DSP_REG, SDSP_OFF(pc));
+  }
+
+  if (m_block_size[start_addr] == 0)
+  {
+    // just a safeguard, should never happen anymore.
+    // if it does we might get stuck over in RunForCycles.
+    ERROR_LOG_FMT(DSPLLE, "Block at {:#06x} has zero size", start_addr);
+    m_block_size[start_addr] = 1;
+  }
+
+  if (link_dest)
+    WriteBlockLink(*link_dest);
+  WriteBranchExit();
+
+  FlushIcacheSection(entry_point, GetWritableCodePtr());
+  m_blocks[start_addr] = entry_point;
+
+  // Mark this block as a linkable destination if it does not contain
+  // any unresolved CALL's
+  if (m_unresolved_jumps[start_addr].empty())
+  {
+    m_block_links[start_addr] = entry_point;
+
+    for (size_t i = 0; i < 0xffff; ++i)
+    {
+      if (!m_unresolved_jumps[i].empty())
+      {
+        // Check if there were any blocks waiting for this block to be linkable
+        size_t size = m_unresolved_jumps[i].size();
+        m_unresolved_jumps[i].remove(start_addr);
+        if (m_unresolved_jumps[i].size() < size)
+        {
+          // Mark the block to be recompiled again
+          m_blocks[i] = m_stub_entry_point;
+          m_block_links[i] = nullptr;
+          m_block_size[i] = 0;
+        }
+      }
+    }
+  }
+}
+
+void DSPEmitter::CompileCurrent(DSPEmitter& emitter)
+{
+  const Common::ScopedJITPageWriteAndNoExecute enable_jit_page_writes;
+
+  emitter.Compile(emitter.m_dsp_core.DSPState().pc);
+
+  bool retry = true;
+
+  while (retry)
+  {
+    retry = false;
+    for (size_t i = 0; i < 0xffff; ++i)
+    {
+      if (!emitter.m_unresolved_jumps[i].empty())
+      {
+        const u16 address_to_compile = emitter.m_unresolved_jumps[i].front();
+        emitter.Compile(address_to_compile);
+        if (!emitter.m_unresolved_jumps[i].empty())
+          retry = true;
+      }
+    }
+  }
+}
+
+DSPEmitter::Block DSPEmitter::CompileStub()
+{
+  const u8* entry_point = AlignCode16();
+  ABI_CallFunction(&CompileCurrent, this);
+  MOVI2R(ARM64Reg::W0, 0);  // Return 0 cycles executed
+  B(m_return_dispatcher);
+  return entry_point;
+}
+
+void DSPEmitter::CompileDispatcher()
+{
+  m_enter_dispatcher = AlignCode16();
+  const BitSet32 registers_used{DecodeReg(DSP_REG), DecodeReg(ARM64Reg::X30)};
+  ABI_PushRegisters(registers_used);
+
+  MOVP2R(DSP_REG, &m_dsp_core.DSPState());
+
+  const u8* dispatcher_loop = GetCodePtr();
+
+  FixupBranch exception_exit;
+  if (Host::OnThread())
+  {
+    LDRB(IndexType::Unsigned, ARM64Reg::W8, DSP_REG, SDSP_OFF(external_interrupt_waiting));
+    exception_exit = CBNZ(ARM64Reg::W8);
+  }
+
+  // Check for DSP halt
+  LDRH(IndexType::Unsigned, ARM64Reg::W8, DSP_REG, SDSP_OFF(control_reg));
+  FixupBranch halt = TBNZ(ARM64Reg::W8, std::countr_zero<u16>(CR_HALT));
+
+  // Execute block. Cycles executed returned in W0.
+  LDRH(IndexType::Unsigned, ARM64Reg::W8, DSP_REG, SDSP_OFF(pc));
+  MOVP2R(ARM64Reg::X9, m_blocks.data());
+  LDR(ARM64Reg::X9, ARM64Reg::X9, ArithOption(ARM64Reg::X8, true));
+  BR(ARM64Reg::X9);
+
+  m_return_dispatcher = GetCodePtr();
+
+  // Decrement cyclesLeft
+  MOVP2R(ARM64Reg::X9, &m_cycles_left);
+  LDRH(IndexType::Unsigned, ARM64Reg::W8, ARM64Reg::X9, 0);
+  SUBS(ARM64Reg::W8, ARM64Reg::W8, ARM64Reg::W0);
+  STRH(IndexType::Unsigned, ARM64Reg::W8, ARM64Reg::X9, 0);
+  B(CC_HI, dispatcher_loop);
+
+  // DSP gave up the remaining cycles.
+  SetJumpTarget(halt);
+  if (Host::OnThread())
+    SetJumpTarget(exception_exit);
+
+  ABI_PopRegisters(registers_used);
+  RET();
+}
+}  // namespace DSP::JIT::Arm64
@@ -0,0 +1,87 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <list>
+#include <vector>
+
+#include "Common/Arm64Emitter.h"
+#include "Common/CommonTypes.h"
+
+#include "Core/DSP/DSPCommon.h"
+#include "Core/DSP/Jit/DSPEmitterBase.h"
+
+class PointerWrap;
+
+namespace DSP
+{
+class DSPCore;
+struct DSPOPCTemplate;
+
+namespace JIT::Arm64
+{
+// Block based recompiler for AArch64 hosts.
+//
+// Blocks are found with the same analyzer information as the x64 recompiler and are linked
+// together when they end in an unconditional jump or call to a known address. Instructions are
+// emitted as direct calls into the interpreter, which removes the fetch, decode and dispatch
+// overhead of DSPInterpreter while keeping its behaviour. All guest state stays in SDSP, so there
+// is no register cache to flush at block exits.
+class DSPEmitter final : public JIT::DSPEmitter, public Arm64Gen::ARM64CodeBlock
+{
+public:
+  explicit DSPEmitter(DSPCore& dsp);
+  ~DSPEmitter() override;
+
+  u16 RunCycles(u16 cycles) override;
+  void DoState(PointerWrap& p) override;
+  void ClearIRAM() override;
+
+private:
+  using Block = const u8*;
+
+  // The emitter emits calls to this function. It's present here
+  // within the class itself to allow access to member variables.
+  static void CompileCurrent(DSPEmitter& emitter);
+
+  void EmitInstruction(UDSPInstruction inst);
+  void ClearIRAMandDSPJITCodespaceReset();
+
+  void CompileDispatcher();
+  Block CompileStub();
+  void Compile(u16 start_addr);
+
+  void FallBackToInterpreter(UDSPInstruction inst);
+
+  u16 GetBlockCycles() const;
+  void WriteBranchExit();
+  void WriteBlockLink(u16 dest);
+  void WriteLoopEnd(const DSPOPCTemplate* opcode);
+
+  void checkExceptions(u32 retval);
+
+  static constexpr size_t MAX_BLOCKS = 0x10000;
+
+  u16 m_compile_pc = 0;
+  u16 m_start_address = 0;
+
+  std::vector<Block> m_blocks;
+  std::vector<u16> m_block_size;
+  std::vector<Block> m_block_links;
+
+  std::array<std::list<u16>, MAX_BLOCKS> m_unresolved_jumps;
+
+  u16 m_cycles_left = 0;
+
+  // CALL this to start the dispatcher
+  const u8* m_enter_dispatcher = nullptr;
+  const u8* m_return_dispatcher = nullptr;
+  const u8* m_stub_entry_point = nullptr;
+
+  DSPCore& m_dsp_core;
+};
+}  // namespace JIT::Arm64
+}  // namespace DSP
@@ -11,6 +11,7 @@
 #include "Common/BitSet.h"
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
+#include "Common/Hash.h"
 #include "Common/Logging/Log.h"
 
 #include "Core/DSP/DSPAnalyzer.h"
@@ -73,14 +74,80 @@ void DSPEmitter::DoState(PointerWrap& p)
 
 void DSPEmitter::ClearIRAM()
 {
-  for (size_t i = 0; i < DSP_IRAM_SIZE; i++)
+  SaveBlocksToCache();
+  ResetBlocks();
+
+  const auto* iram = reinterpret_cast<const u8*>(m_dsp_core.DSPState().iram);
+  m_iram_crc = Common::ComputeCRC32(iram, DSP_IRAM_BYTE_SIZE);
+
+  // The code space can't be cleared here since this may be called from a block that is running.
+  // Once half of it is used up, drop the cache and let RunCycles reset it.
+  if (GetSpaceLeft() < COMPILED_CODE_SIZE / 2)
+  {
+    m_dsp_core.DSPState().reset_dspjit_codespace = true;
+    return;
+  }
+
+  LoadBlocksFromCache();
+}
+
+void DSPEmitter::ResetBlocks()
+{
+  for (size_t i = 0; i < MAX_BLOCKS; i++)
   {
     m_blocks[i] = (DSPCompiledCode)m_stub_entry_point;
     m_block_links[i] = nullptr;
     m_block_size[i] = 0;
     m_unresolved_jumps[i].clear();
   }
-  m_dsp_core.DSPState().reset_dspjit_codespace = true;
+}
+
+void DSPEmitter::SaveBlocksToCache()
+{
+  if (!m_iram_crc || m_dsp_core.DSPState().reset_dspjit_codespace)
+    return;
+
+  CachedCode& cached = m_code_cache[*m_iram_crc];
+  cached.blocks.clear();
+  cached.unresolved_jumps.clear();
+  for (size_t i = 0; i < MAX_BLOCKS; i++)
+  {
+    if (m_blocks[i] != (DSPCompiledCode)m_stub_entry_point)
+    {
+      cached.blocks.push_back(
+          {static_cast<u16>(i), m_blocks[i], m_block_size[i], m_block_links[i]});
+    }
+    if (!m_unresolved_jumps[i].empty())
+      cached.unresolved_jumps.emplace_back(static_cast<u16>(i), m_unresolved_jumps[i]);
+  }
+}
+
+void DSPEmitter::LoadBlocksFromCache()
+{
+  const u16* iram = m_dsp_core.DSPState().iram;
+  CachedCode& cached = m_code_cache[*m_iram_crc];
+
+  // Only entries that were saved from the same IRAM contents can be used.
+  if (cached.iram.size() != DSP_IRAM_SIZE ||
+      std::memcmp(cached.iram.data(), iram, DSP_IRAM_BYTE_SIZE) != 0)
+  {
+    cached.iram.assign(iram, iram + DSP_IRAM_SIZE);
+    cached.blocks.clear();
+    cached.unresolved_jumps.clear();
+    return;
+  }
+
+  for (const CachedBlock& block : cached.blocks)
+  {
+    m_blocks[block.address] = block.code;
+    m_block_size[block.address] = block.size;
+    m_block_links[block.address] = block.link;
+  }
+  for (const auto& [address, jumps] : cached.unresolved_jumps)
+    m_unresolved_jumps[address] = jumps;
+
+  DEBUG_LOG_FMT(DSPLLE, "Reusing {} cached blocks for IRAM {:08x}", cached.blocks.size(),
+                *m_iram_crc);
 }
 
 void DSPEmitter::ClearIRAMandDSPJITCodespaceReset()
@@ -89,13 +156,8 @@ void DSPEmitter::ClearIRAMandDSPJITCodespaceReset()
   CompileDispatcher();
   m_stub_entry_point = CompileStub();
 
-  for (size_t i = 0; i < MAX_BLOCKS; i++)
-  {
-    m_blocks[i] = (DSPCompiledCode)m_stub_entry_point;
-    m_block_links[i] = nullptr;
-    m_block_size[i] = 0;
-    m_unresolved_jumps[i].clear();
-  }
+  ResetBlocks();
+  m_code_cache.clear();
   m_dsp_core.DSPState().reset_dspjit_codespace = false;
 }
 
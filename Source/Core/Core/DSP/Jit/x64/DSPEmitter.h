@@ -6,6 +6,9 @@
 #include <array>
 #include <cstddef>
 #include <list>
+#include <map>
+#include <optional>
+#include <utility>
 #include <vector>
 
 #include "Common/CommonTypes.h"
@@ -200,7 +203,26 @@ private:
   static u16 ReadIFXRegisterHelper(DSPEmitter& emitter, u16 address);
   static void WriteIFXRegisterHelper(DSPEmitter& emitter, u16 address, u16 value);
 
+  // Blocks compiled from one IRAM image. Games switch between a few uCodes, this avoids
+  // recompiling all of their blocks every time one is uploaded again.
+  struct CachedBlock
+  {
+    u16 address;
+    DSPCompiledCode code;
+    u16 size;
+    Block link;
+  };
+  struct CachedCode
+  {
+    std::vector<u16> iram;
+    std::vector<CachedBlock> blocks;
+    std::vector<std::pair<u16, std::list<u16>>> unresolved_jumps;
+  };
+
   void EmitInstruction(UDSPInstruction inst);
+  void ResetBlocks();
+  void SaveBlocksToCache();
+  void LoadBlocksFromCache();
   void ClearIRAMandDSPJITCodespaceReset();
 
   void CompileDispatcher();
@@ -323,6 +345,11 @@ private:
 
   std::array<std::list<u16>, MAX_BLOCKS> m_unresolved_jumps;
 
+  // Keyed by the CRC32 of the IRAM image. The code of cached blocks stays in the code space until
+  // it is reset.
+  std::map<u32, CachedCode> m_code_cache;
+  std::optional<u32> m_iram_crc;
+
   u16 m_cycles_left = 0;
 
   // The index of the last stored ext value (compile time).
@@ -20,6 +20,9 @@ namespace Core
 {
 void BranchWatch::Clear(const CPUThreadGuard&)
 {
+  // The slots have to stay, since compiled code points at their counters.
+  for (BranchWatchHitSlot& slot : m_hit_slots)
+    slot.resolved_hits = slot.hits;
   m_selection.clear();
   m_collection_vt.clear();
   m_collection_vf.clear();
@@ -29,6 +32,29 @@ void BranchWatch::Clear(const CPUThreadGuard&)
   m_blacklist_size = 0;
 }
 
+u64* BranchWatch::GetHitCounter(u32 origin, u32 destination, UGeckoInstruction inst,
+                                bool is_virtual, bool condition)
+{
+  const BranchWatchCollectionKey key{{origin, destination}, inst};
+  const auto [iter, inserted] = m_hit_slot_indices[GetCollectionIndex(is_virtual, condition)]
+                                    .try_emplace(key, m_hit_slots.size());
+  if (inserted)
+    m_hit_slots.push_back({key, is_virtual, condition});
+  return &m_hit_slots[iter->second].hits;
+}
+
+void BranchWatch::ResolveHits(const CPUThreadGuard&)
+{
+  for (BranchWatchHitSlot& slot : m_hit_slots)
+  {
+    if (slot.hits == slot.resolved_hits)
+      continue;
+    GetCollection(slot.is_virtual, slot.condition)[slot.key].total_hits +=
+        slot.hits - slot.resolved_hits;
+    slot.resolved_hits = slot.hits;
+  }
+}
+
 // This is a bitfield aggregate of metadata required to reconstruct a BranchWatch's Collections and
 // Selection from a text file (a snapshot). For maximum forward compatibility, should that ever be
 // required, the StorageType is an unsigned long long instead of something more reasonable like an
@@ -59,7 +85,7 @@ union USnapshotMetadata
   }
 };
 
-void BranchWatch::Save(const CPUThreadGuard& guard, std::FILE* file) const
+void BranchWatch::Save(const CPUThreadGuard& guard, std::FILE* file)
 {
   if (!CanSave())
   {
@@ -69,6 +95,8 @@ void BranchWatch::Save(const CPUThreadGuard& guard, std::FILE* file) const
   if (file == nullptr)
     return;
 
+  ResolveHits(guard);
+
   const auto routine = [&](const Collection& collection, bool is_virtual, bool condition) {
     for (const Collection::value_type& kv : collection)
     {
@@ -129,8 +157,9 @@ void BranchWatch::Load(const CPUThreadGuard& guard, std::FILE* file)
     m_recording_phase = Phase::Reduction;
 }
 
-void BranchWatch::IsolateHasExecuted(const CPUThreadGuard&)
+void BranchWatch::IsolateHasExecuted(const CPUThreadGuard& guard)
 {
+  ResolveHits(guard);
   switch (m_recording_phase)
   {
   case Phase::Blacklist:
@@ -167,8 +196,9 @@ void BranchWatch::IsolateHasExecuted(const CPUThreadGuard&)
   }
 }
 
-void BranchWatch::IsolateNotExecuted(const CPUThreadGuard&)
+void BranchWatch::IsolateNotExecuted(const CPUThreadGuard& guard)
 {
+  ResolveHits(guard);
   switch (m_recording_phase)
   {
   case Phase::Blacklist:
@@ -203,6 +233,7 @@ void BranchWatch::IsolateWasOverwritten(const CPUThreadGuard& guard)
     ASSERT_MSG(CORE, false, "Core is uninitialized.");
     return;
   }
+  ResolveHits(guard);
   switch (m_recording_phase)
   {
   case Phase::Blacklist:
@@ -251,6 +282,7 @@ void BranchWatch::IsolateNotOverwritten(const CPUThreadGuard& guard)
     ASSERT_MSG(CORE, false, "Core is uninitialized.");
     return;
   }
+  ResolveHits(guard);
   switch (m_recording_phase)
   {
   case Phase::Blacklist:
@@ -288,8 +320,9 @@ void BranchWatch::IsolateNotOverwritten(const CPUThreadGuard& guard)
   }
 }
 
-void BranchWatch::UpdateHitsSnapshot()
+void BranchWatch::UpdateHitsSnapshot(const CPUThreadGuard& guard)
 {
+  ResolveHits(guard);
   switch (m_recording_phase)
   {
   case Phase::Reduction:
@@ -3,9 +3,11 @@
 
 #pragma once
 
+#include <array>
 #include <bit>
 #include <cstddef>
 #include <cstdio>
+#include <deque>
 #include <functional>
 #include <unordered_map>
 #include <vector>
@@ -37,6 +39,14 @@ struct BranchWatchCollectionValue
   std::size_t total_hits = 0;
   std::size_t hits_snapshot = 0;
 };
+struct BranchWatchHitSlot
+{
+  BranchWatchCollectionKey key;
+  bool is_virtual;
+  bool condition;
+  u64 hits = 0;
+  u64 resolved_hits = 0;
+};
 }  // namespace Core
 
 template <>
@@ -122,14 +132,20 @@ public:
   void Pause() { SetRecordingActive(false); }
   void Clear(const CPUThreadGuard& guard);
 
-  void Save(const CPUThreadGuard& guard, std::FILE* file) const;
+  void Save(const CPUThreadGuard& guard, std::FILE* file);
   void Load(const CPUThreadGuard& guard, std::FILE* file);
 
   void IsolateHasExecuted(const CPUThreadGuard& guard);
   void IsolateNotExecuted(const CPUThreadGuard& guard);
   void IsolateWasOverwritten(const CPUThreadGuard& guard);
   void IsolateNotOverwritten(const CPUThreadGuard& guard);
-  void UpdateHitsSnapshot();
+  void UpdateHitsSnapshot(const CPUThreadGuard& guard);
+
+  // The JITs give every branch they compile a slot with a hit counter, which the compiled code
+  // increments directly. This adds the hits counted since the last call to the collections, and
+  // must be called before the collections are looked at. Everything above that takes a
+  // CPUThreadGuard calls it.
+  void ResolveHits(const CPUThreadGuard& guard);
   void ClearSelectionInspection();
   void SetSelectedInspected(std::size_t idx, SelectionInspection inspection);
 
@@ -147,11 +163,17 @@ public:
   // An empty selection in reduction mode can't be reconstructed when loading from a file.
   bool CanSave() const { return !(m_recording_phase == Phase::Reduction && m_selection.empty()); }
 
+  // Returns the hit counter of the slot for the given branch, which stays valid for as long as this
+  // BranchWatch exists. For the CPUThread only.
+  u64* GetHitCounter(u32 origin, u32 destination, UGeckoInstruction inst, bool is_virtual,
+                     bool condition);
+
   // All Hit member functions are for the CPUThread only. The static ones are static to remain
   // compatible with the JITs' ABI_CallFunction function, which doesn't support non-static member
-  // functions. HitXX_fk are optimized for when origin and destination can be passed in one register
-  // easily as a Core::FakeBranchWatchCollectionKey (abbreviated as "fk"). HitXX_fk_n are the same,
-  // but also increment the total_hits by N (see dcbx JIT code).
+  // functions. They are only used for branches with a destination that isn't known when compiling,
+  // since all other branches count their hits in a slot. HitXX_fk are optimized for when origin and
+  // destination can be passed in one register easily as a Core::FakeBranchWatchCollectionKey
+  // (abbreviated as "fk").
   static void HitVirtualTrue_fk(BranchWatch* branch_watch, u64 fake_key, u32 inst)
   {
     branch_watch->m_collection_vt[{std::bit_cast<FakeBranchWatchCollectionKey>(fake_key), inst}]
@@ -176,20 +198,6 @@ public:
         .total_hits += 1;
   }
 
-  static void HitVirtualTrue_fk_n(BranchWatch* branch_watch, u64 fake_key, u32 inst, u32 n)
-  {
-    branch_watch->m_collection_vt[{std::bit_cast<FakeBranchWatchCollectionKey>(fake_key), inst}]
-        .total_hits += n;
-  }
-
-  static void HitPhysicalTrue_fk_n(BranchWatch* branch_watch, u64 fake_key, u32 inst, u32 n)
-  {
-    branch_watch->m_collection_pt[{std::bit_cast<FakeBranchWatchCollectionKey>(fake_key), inst}]
-        .total_hits += n;
-  }
-
-  // HitVirtualFalse_fk_n and HitPhysicalFalse_fk_n are never used, so they are omitted here.
-
   static void HitVirtualTrue(BranchWatch* branch_watch, u32 origin, u32 destination, u32 inst)
   {
     HitVirtualTrue_fk(branch_watch, FakeBranchWatchCollectionKey{origin, destination}, inst);
@@ -261,6 +269,11 @@ private:
     return GetCollectionP(condition);
   }
 
+  static std::size_t GetCollectionIndex(bool is_virtual, bool condition)
+  {
+    return (is_virtual ? 2 : 0) + (condition ? 1 : 0);
+  }
+
   std::size_t m_blacklist_size = 0;
   Phase m_recording_phase = Phase::Blacklist;
   bool m_recording_active = false;
@@ -269,6 +282,10 @@ private:
   Collection m_collection_pt;  // physical address space | true path
   Collection m_collection_pf;  // physical address space | false path
   Selection m_selection;
+  // A deque, so that the counters don't move when slots are added.
+  std::deque<BranchWatchHitSlot> m_hit_slots;
+  // Indices of the slots in m_hit_slots, for each collection in the order of GetCollectionIndex.
+  std::array<std::unordered_map<BranchWatchCollectionKey, std::size_t>, 4> m_hit_slot_indices;
 };
 
 #if _M_X86_64
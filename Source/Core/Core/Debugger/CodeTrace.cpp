@@ -4,13 +4,28 @@
 #include "Core/Debugger/CodeTrace.h"
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
 #include <chrono>
+#include <cstring>
+#include <memory>
 #include <regex>
+#include <utility>
+#include <vector>
+
+#include <zstd.h>
 
 #include "Common/Event.h"
+#include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
+#include "Common/WorkQueueThread.h"
 #include "Core/Core.h"
 #include "Core/Debugger/PPCDebugInterface.h"
 #include "Core/HW/CPU.h"
+#include "Core/PowerPC/Gekko.h"
+#include "Core/PowerPC/MMU.h"
+#include "Core/PowerPC/PPCTables.h"
 #include "Core/PowerPC/PowerPC.h"
 #include "Core/System.h"
 
@@ -63,6 +78,162 @@ bool CompareMemoryTargetToTracked(const std::string& instr, const u32 mem_target
   // If the base value doesn't hit, still need to check if longer values overlap.
   return *it_lower < mem_target + GetMemoryTargetSize(instr);
 }
+
+// Compresses the trace on a worker thread, which is what keeps up with the interpreter.
+class BinaryTraceWriter
+{
+public:
+  bool Open(const std::string& path)
+  {
+    m_file.Open(path, "wb");
+    m_cctx.reset(ZSTD_createCCtx());
+    if (!m_file || !m_cctx ||
+        ZSTD_isError(ZSTD_CCtx_setParameter(m_cctx.get(), ZSTD_c_compressionLevel, 1)))
+    {
+      ERROR_LOG_FMT(POWERPC, "Failed to open {} for writing the binary trace", path);
+      return false;
+    }
+
+    m_out.resize(ZSTD_CStreamOutSize());
+    m_buffer.reserve(CHUNK_SIZE);
+    m_thread.Reset("Binary Trace Compression", [this](std::vector<u8> chunk) {
+      Compress(chunk.data(), chunk.size(), ZSTD_e_continue);
+      m_queued_bytes.fetch_sub(chunk.size(), std::memory_order_relaxed);
+    });
+    return true;
+  }
+
+  void Write(const void* data, size_t size)
+  {
+    const u8* const bytes = static_cast<const u8*>(data);
+    m_buffer.insert(m_buffer.end(), bytes, bytes + size);
+    if (m_buffer.size() >= CHUNK_SIZE)
+      Flush();
+  }
+
+  bool Finish()
+  {
+    Flush();
+    m_thread.Shutdown();
+    Compress(nullptr, 0, ZSTD_e_end);
+    return !m_error && m_file.Close();
+  }
+
+private:
+  static constexpr size_t CHUNK_SIZE = 1 << 20;
+  // Stepping waits for the compressor once this much is queued up.
+  static constexpr size_t MAX_QUEUED_BYTES = 64 * CHUNK_SIZE;
+
+  void Flush()
+  {
+    if (m_buffer.empty())
+      return;
+
+    if (m_queued_bytes.fetch_add(m_buffer.size(), std::memory_order_relaxed) > MAX_QUEUED_BYTES)
+      m_thread.WaitForCompletion();
+    m_thread.Push(std::exchange(m_buffer, {}));
+    m_buffer.reserve(CHUNK_SIZE);
+  }
+
+  void Compress(const u8* data, size_t size, ZSTD_EndDirective mode)
+  {
+    if (m_error)
+      return;
+
+    ZSTD_inBuffer in_buffer{data, size, 0};
+    size_t remaining;
+    do
+    {
+      ZSTD_outBuffer out_buffer{m_out.data(), m_out.size(), 0};
+      remaining = ZSTD_compressStream2(m_cctx.get(), &out_buffer, &in_buffer, mode);
+      if (ZSTD_isError(remaining) || !m_file.WriteBytes(m_out.data(), out_buffer.pos))
+      {
+        ERROR_LOG_FMT(POWERPC, "Failed to write the binary trace");
+        m_error = true;
+        return;
+      }
+    } while (mode == ZSTD_e_end ? remaining != 0 : in_buffer.pos != in_buffer.size);
+  }
+
+  File::IOFile m_file;
+  std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)> m_cctx{nullptr, ZSTD_freeCCtx};
+  std::vector<u8> m_out;
+  std::vector<u8> m_buffer;
+  std::atomic<size_t> m_queued_bytes = 0;
+  bool m_error = false;
+  Common::WorkQueueThread<std::vector<u8>> m_thread;
+};
+
+struct BinaryTraceRegisters
+{
+  std::array<u32, BINARY_TRACE_REGISTER_COUNT> regs;
+  std::array<u64, BINARY_TRACE_FPR_COUNT> fprs;
+};
+
+BinaryTraceRegisters GetBinaryTraceRegisters(const PowerPC::PowerPCState& ppc_state)
+{
+  BinaryTraceRegisters state;
+  std::copy(std::begin(ppc_state.gpr), std::end(ppc_state.gpr), state.regs.begin());
+  state.regs[32] = ppc_state.cr.Get();
+  state.regs[33] = LR(ppc_state);
+  state.regs[34] = CTR(ppc_state);
+  state.regs[35] = ppc_state.GetXER().Hex;
+  state.regs[36] = ppc_state.msr.Hex;
+  state.regs[37] = ppc_state.fpscr.Hex;
+  state.regs[38] = SRR0(ppc_state);
+  state.regs[39] = SRR1(ppc_state);
+  for (size_t i = 0; i < 32; ++i)
+  {
+    state.fprs[i] = ppc_state.ps[i].PS0AsU64();
+    state.fprs[i + 32] = ppc_state.ps[i].PS1AsU64();
+  }
+  return state;
+}
+
+// Appends a mask of the values that differ and their new values. Returns the new end of out.
+template <typename T, size_t N>
+u8* WriteChangedValues(u8* out, const std::array<T, N>& before, const std::array<T, N>& after)
+{
+  static_assert(N <= 64);
+  u64 mask = 0;
+  for (size_t i = 0; i < N; ++i)
+    mask |= u64{before[i] != after[i]} << i;
+  if (mask == 0)
+    return out;
+
+  std::memcpy(out, &mask, sizeof(mask));
+  out += sizeof(mask);
+  for (; mask != 0; mask &= mask - 1)
+  {
+    std::memcpy(out, &after[std::countr_zero(mask)], sizeof(T));
+    out += sizeof(T);
+  }
+  return out;
+}
+
+// Works out the address a load or store is going to access from the registers before it runs.
+std::optional<u32> GetEffectiveAddress(const PowerPC::PowerPCState& ppc_state,
+                                       UGeckoInstruction inst)
+{
+  const u32 base = inst.RA == 0 ? 0 : ppc_state.gpr[inst.RA];
+  switch (inst.OPCD)
+  {
+  case 4:  // psq_lx and psq_stx
+    return base + ppc_state.gpr[inst.RB];
+  case 31:
+    // lswi and stswi take a byte count instead of rB.
+    if (inst.SUBOP10 == 597 || inst.SUBOP10 == 725)
+      return base;
+    return base + ppc_state.gpr[inst.RB];
+  case 56:  // psq_l
+  case 57:  // psq_lu
+  case 60:  // psq_st
+  case 61:  // psq_stu
+    return base + inst.SIMM_12;
+  default:
+    return base + inst.SIMM_16;
+  }
+}
 }  // namespace
 
 void CodeTrace::SetRegTracked(const std::string& reg)
@@ -391,3 +562,89 @@ HitType CodeTrace::TraceLogic(const TraceOutput& current_instr, bool first_hit)
   // Should not reach this
   return HitType::SKIP;
 }
+
+BinaryTraceResults CodeTrace::RecordBinaryTrace(const Core::CPUThreadGuard& guard,
+                                                const std::string& path, u64 instruction_count)
+{
+  BinaryTraceResults results;
+
+  if (m_recording)
+    return results;
+
+  BinaryTraceWriter writer;
+  if (!writer.Open(path))
+    return results;
+
+  m_recording = true;
+
+  auto& power_pc = guard.GetSystem().GetPowerPC();
+  auto& ppc_state = power_pc.GetPPCState();
+
+  BinaryTraceRegisters registers = GetBinaryTraceRegisters(ppc_state);
+  const std::array<u32, 2> header{BINARY_TRACE_MAGIC, BINARY_TRACE_VERSION};
+  writer.Write(header.data(), sizeof(header));
+  writer.Write(&registers, sizeof(registers));
+
+  power_pc.GetBreakPoints().ClearAllTemporary();
+  PowerPC::CoreMode old_mode = power_pc.GetMode();
+  power_pc.SetMode(PowerPC::CoreMode::Interpreter);
+
+  // Large enough for a record with every register changed.
+  std::array<u8, 13 + sizeof(u64) * 2 + sizeof(BinaryTraceRegisters)> record;
+  for (; results.count < instruction_count; ++results.count)
+  {
+    const u32 pc = ppc_state.pc;
+    const UGeckoInstruction inst{PowerPC::MMU::HostRead_Instruction(guard, pc)};
+
+    u8 flags = 0;
+    std::optional<u32> effective_address;
+    const GekkoOPInfo* const info = PPCTables::GetOpInfo(inst, pc);
+    switch (info->type)
+    {
+    case OpType::Store:
+    case OpType::StoreFP:
+    case OpType::StorePS:
+      flags |= BINARY_TRACE_STORE;
+      [[fallthrough]];
+    case OpType::Load:
+    case OpType::LoadFP:
+    case OpType::LoadPS:
+      flags |= BINARY_TRACE_MEMORY_ACCESS;
+      effective_address = GetEffectiveAddress(ppc_state, inst);
+      break;
+    default:
+      break;
+    }
+
+    power_pc.SingleStep();
+
+    const BinaryTraceRegisters new_registers = GetBinaryTraceRegisters(ppc_state);
+    u8* out = record.data() + 9;
+    if (effective_address)
+    {
+      std::memcpy(out, &*effective_address, sizeof(u32));
+      out += sizeof(u32);
+    }
+    u8* const registers_start = out;
+    out = WriteChangedValues(out, registers.regs, new_registers.regs);
+    if (out != registers_start)
+      flags |= BINARY_TRACE_REGISTERS_CHANGED;
+    u8* const fprs_start = out;
+    out = WriteChangedValues(out, registers.fprs, new_registers.fprs);
+    if (out != fprs_start)
+      flags |= BINARY_TRACE_FPRS_CHANGED;
+
+    std::memcpy(record.data(), &pc, sizeof(u32));
+    std::memcpy(record.data() + 4, &inst.hex, sizeof(u32));
+    record[8] = flags;
+    writer.Write(record.data(), out - record.data());
+    registers = new_registers;
+  }
+
+  power_pc.SetMode(old_mode);
+  m_recording = false;
+
+  results.success = writer.Finish();
+  INFO_LOG_FMT(POWERPC, "Wrote a binary trace of {} instructions to {}", results.count, path);
+  return results;
+}
@@ -45,6 +45,35 @@ struct AutoStepResults
   bool trackers_empty = false;
 };
 
+struct BinaryTraceResults
+{
+  u64 count = 0;
+  bool success = false;
+};
+
+// A binary trace file is a zstd stream of a header followed by one record per instruction. All
+// values are in host byte order.
+//
+// Header: u32 BINARY_TRACE_MAGIC, u32 BINARY_TRACE_VERSION, then the starting register state as
+// BINARY_TRACE_REGISTER_COUNT u32s (r0-r31, CR, LR, CTR, XER, MSR, FPSCR, SRR0, SRR1) and
+// BINARY_TRACE_FPR_COUNT u64s (ps0 of f0-f31, then ps1 of f0-f31).
+//
+// Record: u32 PC, u32 instruction, u8 BinaryTraceFlags, then the u32 effective address if the
+// instruction accessed memory, then for each register file that changed a u64 mask of the
+// registers that did and their new values, in ascending order.
+constexpr u32 BINARY_TRACE_MAGIC = 0x43525444;  // "DTRC"
+constexpr u32 BINARY_TRACE_VERSION = 1;
+constexpr u32 BINARY_TRACE_REGISTER_COUNT = 40;
+constexpr u32 BINARY_TRACE_FPR_COUNT = 64;
+
+enum BinaryTraceFlags : u8
+{
+  BINARY_TRACE_MEMORY_ACCESS = 1 << 0,
+  BINARY_TRACE_STORE = 1 << 1,
+  BINARY_TRACE_REGISTERS_CHANGED = 1 << 2,
+  BINARY_TRACE_FPRS_CHANGED = 1 << 3,
+};
+
 enum class HitType : u32
 {
   SKIP = (1 << 0),       // Not a hit
@@ -71,6 +100,12 @@ public:
   AutoStepResults AutoStepping(const Core::CPUThreadGuard& guard, bool continue_previous = false,
                                AutoStop stop_on = AutoStop::Always);
 
+  // Steps the interpreter for up to instruction_count instructions and writes them to path in the
+  // binary trace format. Nothing is disassembled and the compression runs on another thread, so
+  // this is suited to long traces that are analyzed offline.
+  BinaryTraceResults RecordBinaryTrace(const Core::CPUThreadGuard& guard, const std::string& path,
+                                       u64 instruction_count);
+
 private:
   InstructionAttributes GetInstructionAttributes(const TraceOutput& line) const;
   TraceOutput SaveCurrentInstruction(const Core::CPUThreadGuard& guard) const;
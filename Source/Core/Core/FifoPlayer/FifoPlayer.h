@@ -133,6 +133,10 @@ public:
   u32 GetObjectRangeEnd() const { return m_ObjectRangeEnd; }
   void SetObjectRangeEnd(u32 end) { m_ObjectRangeEnd = end; }
 
+  // Stops playback once the frame range has been played this many times.
+  // 0 loops or stops according to the loop replay setting.
+  void SetLoopCount(u32 count) { m_LoopCount = count; }
+
   // Callbacks
   void SetFileLoadedCallback(CallbackFunc callback);
   void SetFrameWrittenCallback(CallbackFunc callback) { m_FrameWrittenCb = std::move(callback); }
@@ -184,6 +188,8 @@ private:
   Core::System& m_system;
 
   bool m_Loop = true;
+  u32 m_LoopCount = 0;
+  u32 m_LoopsPlayed = 0;
   // If enabled then all memory updates happen at once before the first frame
   bool m_EarlyMemoryUpdates = false;
 
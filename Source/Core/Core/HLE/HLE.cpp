@@ -6,7 +6,11 @@
 #include <algorithm>
 #include <array>
 #include <map>
+#include <string_view>
+#include <utility>
+#include <vector>
 
+#include "Common/Assert.h"
 #include "Common/CommonTypes.h"
 #include "Common/Config/Config.h"
 
@@ -15,6 +19,7 @@
 #include "Core/GeckoCode.h"
 #include "Core/HLE/HLE_Misc.h"
 #include "Core/HLE/HLE_OS.h"
+#include "Core/HLE/HLE_SDK.h"
 #include "Core/HW/Memmap.h"
 #include "Core/IOS/ES/ES.h"
 #include "Core/PowerPC/PPCSymbolDB.h"
@@ -27,7 +32,7 @@ namespace HLE
 static std::map<u32, u32> s_hooked_addresses;
 
 // clang-format off
-constexpr std::array<Hook, 23> os_patches{{
+constexpr std::array<Hook, 32> os_patches{{
     // Placeholder, os_patches[0] is the "non-existent function" index
     {"FAKE_TO_SKIP_0",               HLE_Misc::UnimplementedFunction,       HookType::Replace, HookFlag::Generic},
 
@@ -57,6 +62,17 @@ constexpr std::array<Hook, 23> os_patches{{
     {"___blank",                     HLE_OS::HLE_GeneralDebugPrint,         HookType::Start,   HookFlag::Debug}, // used for early init things (normally)
     {"__write_console",              HLE_OS::HLE_write_console,             HookType::Start,   HookFlag::Debug}, // used by sysmenu (+more?)
 
+    // SDK functions that games spend a lot of time in, see MAIN_HLE_SDK_FUNCTIONS
+    {"memcpy",                       HLE_SDK::Memcpy,                       HookType::Replace, HookFlag::SDK},
+    {"__fill_mem",                   HLE_SDK::FillMem,                      HookType::Replace, HookFlag::SDK}, // does the work of memset
+    {"DCFlushRange",                 HLE_SDK::DCFlushRange,                 HookType::Replace, HookFlag::SDK},
+    {"DCFlushRangeNoSync",           HLE_SDK::DCFlushRangeNoSync,           HookType::Replace, HookFlag::SDK},
+    {"DCStoreRange",                 HLE_SDK::DCStoreRange,                 HookType::Replace, HookFlag::SDK},
+    {"DCStoreRangeNoSync",           HLE_SDK::DCStoreRangeNoSync,           HookType::Replace, HookFlag::SDK},
+    {"DCInvalidateRange",            HLE_SDK::DCInvalidateRange,            HookType::Replace, HookFlag::SDK},
+    {"PSMTXIdentity",                HLE_SDK::PSMTXIdentity,                HookType::Replace, HookFlag::SDK},
+    {"PSMTXCopy",                    HLE_SDK::PSMTXCopy,                    HookType::Replace, HookFlag::SDK},
+
     {"GeckoCodehandler",             HLE_Misc::GeckoCodeHandlerICacheFlush, HookType::Start,   HookFlag::Fixed},
     {"GeckoHandlerReturnTrampoline", HLE_Misc::GeckoReturnTrampoline,       HookType::Replace, HookFlag::Fixed},
     {"AppLoaderReport",              HLE_OS::HLE_GeneralDebugPrint,         HookType::Start,   HookFlag::Fixed} // apploader needs OSReport-like function
@@ -128,21 +144,44 @@ void PatchFunctions(Core::System& system)
     }
   }
 
+  // Fixed hooks don't map to symbols
+  std::map<std::string_view, u32> hook_names;
   for (u32 i = 1; i < os_patches.size(); ++i)
   {
-    // Fixed hooks don't map to symbols
-    if (os_patches[i].flags == HookFlag::Fixed)
+    if (os_patches[i].flags != HookFlag::Fixed)
+      hook_names.emplace(os_patches[i].name, i);
+  }
+
+  // Go through the symbols once instead of once per hook, but still install the hooks in their
+  // order in os_patches.
+  std::vector<std::pair<u32, const Common::Symbol*>> matches;
+  for (const auto& [address, symbol] : ppc_symbol_db.Symbols())
+  {
+    const auto it = hook_names.find(symbol.function_name);
+    if (it == hook_names.end())
       continue;
 
-    for (const auto& symbol : ppc_symbol_db.GetSymbolsFromName(os_patches[i].name))
+    // Only replace SDK functions if their code does exactly what the replacement does
+    if (os_patches[it->second].flags == HookFlag::SDK &&
+        !HLE_SDK::IsKnownImplementation(it->first, symbol.hash, symbol.size))
     {
-      for (u32 addr = symbol->address; addr < symbol->address + symbol->size; addr += 4)
-      {
-        s_hooked_addresses[addr] = i;
-        ppc_state.iCache.Invalidate(memory, jit_interface, addr);
-      }
-      INFO_LOG_FMT(OSHLE, "Patching {} {:08x}", os_patches[i].name, symbol->address);
+      DEBUG_LOG_FMT(OSHLE, "Not patching {} {:08x}, unknown hash {:08x}", it->first,
+                    symbol.address, symbol.hash);
+      continue;
     }
+    matches.emplace_back(it->second, &symbol);
+  }
+  std::stable_sort(matches.begin(), matches.end(),
+                   [](const auto& a, const auto& b) { return a.first < b.first; });
+
+  for (const auto& [i, symbol] : matches)
+  {
+    for (u32 addr = symbol->address; addr < symbol->address + symbol->size; addr += 4)
+    {
+      s_hooked_addresses[addr] = i;
+      ppc_state.iCache.Invalidate(memory, jit_interface, addr);
+    }
+    INFO_LOG_FMT(OSHLE, "Patching {} {:08x}", os_patches[i].name, symbol->address);
   }
 }
 
@@ -171,11 +210,30 @@ void Execute(const Core::CPUThreadGuard& guard, u32 current_pc, u32 hook_index)
   }
 }
 
-void ExecuteFromJIT(u32 current_pc, u32 hook_index, Core::System& system)
+// One of these is generated for every hook, so that the JIT can call the hook's function
+// directly instead of looking the hook up by its index on every call.
+template <size_t Index>
+static void ExecuteFromJIT(Core::System& system)
 {
-  ASSERT(Core::IsCPUThread());
+  DEBUG_ASSERT(Core::IsCPUThread());
   Core::CPUThreadGuard guard(system);
-  Execute(guard, current_pc, hook_index);
+  os_patches[Index].function(guard);
+}
+
+template <size_t... Indices>
+static constexpr auto MakeJITHookFunctions(std::index_sequence<Indices...>)
+{
+  return std::array<JITHookFunction, sizeof...(Indices)>{&ExecuteFromJIT<Indices>...};
+}
+
+static constexpr auto s_jit_hook_functions =
+    MakeJITHookFunctions(std::make_index_sequence<os_patches.size()>());
+
+JITHookFunction GetJITHookFunction(u32 hook_index)
+{
+  hook_index &= 0xFFFFF;
+  ASSERT(hook_index > 0 && hook_index < s_jit_hook_functions.size());
+  return s_jit_hook_functions[hook_index];
 }
 
 u32 GetHookByAddress(u32 address)
@@ -225,8 +283,18 @@ TryReplaceFunctionResult TryReplaceFunction(PPCSymbolDB& ppc_symbol_db, u32 addr
 
 bool IsEnabled(HookFlag flag, PowerPC::CoreMode mode)
 {
-  return flag != HLE::HookFlag::Debug || Config::IsDebuggingEnabled() ||
-         mode == PowerPC::CoreMode::Interpreter;
+  switch (flag)
+  {
+  case HookFlag::Debug:
+    return Config::IsDebuggingEnabled() || mode == PowerPC::CoreMode::Interpreter;
+  case HookFlag::SDK:
+    // The replacements access memory directly, so they would bypass the emulated data cache and
+    // memory breakpoints.
+    return Config::Get(Config::MAIN_HLE_SDK_FUNCTIONS) &&
+           !Config::Get(Config::MAIN_ACCURATE_CPU_CACHE) && !Config::IsDebuggingEnabled();
+  default:
+    return true;
+  }
 }
 
 u32 UnPatch(Core::System& system, std::string_view patch_name)
@@ -23,6 +23,7 @@ class PPCSymbolDB;
 namespace HLE
 {
 using HookFunction = void (*)(const Core::CPUThreadGuard&);
+using JITHookFunction = void (*)(Core::System&);
 
 enum class HookType
 {
@@ -36,6 +37,7 @@ enum class HookFlag
   Generic,  // Miscellaneous function
   Debug,    // Debug output function
   Fixed,    // An arbitrary hook mapped to a fixed address instead of a symbol
+  SDK,      // Faster version of an SDK function, only installed over known implementations
 };
 
 struct Hook
@@ -63,7 +65,8 @@ void Patch(Core::System& system, u32 pc, std::string_view func_name);
 u32 UnPatch(Core::System& system, std::string_view patch_name);
 u32 UnpatchRange(Core::System& system, u32 start_addr, u32 end_addr);
 void Execute(const Core::CPUThreadGuard& guard, u32 current_pc, u32 hook_index);
-void ExecuteFromJIT(u32 current_pc, u32 hook_index, Core::System& system);
+// Returns a function that runs the hook, for the JITs to call directly.
+JITHookFunction GetJITHookFunction(u32 hook_index);
 
 // Returns the HLE hook index of the address
 u32 GetHookByAddress(u32 address);
@@ -0,0 +1,335 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/HLE/HLE_SDK.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <climits>
+#include <cstring>
+#include <span>
+#include <tuple>
+
+#include "Common/CommonTypes.h"
+#include "Common/Swap.h"
+#include "Core/Core.h"
+#include "Core/HW/Memmap.h"
+#include "Core/PowerPC/Interpreter/Interpreter_FPUtils.h"
+#include "Core/PowerPC/JitInterface.h"
+#include "Core/PowerPC/MMU.h"
+#include "Core/PowerPC/PowerPC.h"
+#include "Core/System.h"
+
+namespace HLE_SDK
+{
+namespace
+{
+// The checksums and sizes of the implementations that the replacements match, from totaldb.dsy.
+constexpr std::array<std::tuple<std::string_view, u32, u32>, 11> KNOWN_IMPLEMENTATIONS{{
+    {"memcpy", 0xc0437c6b, 80},
+    {"__fill_mem", 0x6135bf56, 184},
+    {"__fill_mem", 0x7d3b05ae, 180},
+    {"DCFlushRange", 0xf93836a7, 48},
+    {"DCFlushRangeNoSync", 0x1343dabc, 44},
+    {"DCStoreRange", 0xf9383aa7, 48},
+    {"DCStoreRangeNoSync", 0x1543dabc, 44},
+    {"DCInvalidateRange", 0x0b43dabc, 44},
+    {"PSMTXIdentity", 0x918c27e0, 44},
+    {"PSMTXIdentity", 0x95902fd8, 44},
+    {"PSMTXCopy", 0xca006d75, 52},
+}};
+
+// What the SDK's implementations would have cost, in the units of the downcount. These add up
+// the cycle counts in PPCTables of the instructions that the functions execute.
+constexpr u64 MEMCPY_CYCLES = 8;
+constexpr u64 MEMCPY_CYCLES_PER_BYTE = 4;
+constexpr u64 FILL_MEM_CYCLES = 12;
+constexpr u64 FILL_MEM_CYCLES_PER_BYTE = 3;
+constexpr u64 FILL_MEM_CYCLES_PER_WORD = 3;
+constexpr u64 FILL_MEM_CYCLES_PER_BLOCK = 10;
+constexpr u64 DC_RANGE_CYCLES = 10;
+constexpr u64 DC_RANGE_CYCLES_PER_LINE = 7;
+// The variants that synchronize end with a system call, which goes through the OS's handler.
+constexpr u64 DC_RANGE_SYNC_CYCLES = 12;
+constexpr u64 PSMTX_IDENTITY_CYCLES = 11;
+constexpr u64 PSMTX_COPY_CYCLES = 13;
+
+constexpr size_t MTX_SIZE = 12 * sizeof(float);
+
+void Return(PowerPC::PowerPCState& ppc_state, u64 cycles)
+{
+  // Large copies make the downcount very negative, which CoreTiming accounts for like it does for
+  // any block that overruns it.
+  ppc_state.downcount -= static_cast<int>(std::min<u64>(cycles, INT_MAX / 2));
+  ppc_state.npc = LR(ppc_state);
+}
+
+bool IsBackedByRAM(PowerPC::MMU& mmu, u32 address, u32 size)
+{
+  if (u64{address} + size > 0x1'0000'0000)
+    return false;
+
+  u32 done = 0;
+  while (done < size)
+  {
+    const std::span<u8> page = mmu.GetHostSpanForPage(address + done);
+    if (page.empty())
+      return false;
+    done += static_cast<u32>(std::min<size_t>(page.size(), size - done));
+  }
+  return true;
+}
+
+// Copies like memmove a page at a time, starting from the end when the destination is above the
+// source, like the SDK's memcpy does. Both ranges have to be backed by RAM.
+void MoveRAM(Core::System& system, u32 dst, u32 src, u32 size)
+{
+  auto& mmu = system.GetMMU();
+  auto& memory = system.GetMemory();
+  const bool backwards = src < dst;
+
+  u32 done = 0;
+  while (done < size)
+  {
+    const u32 left = size - done;
+    u32 offset;
+    u32 length;
+    if (backwards)
+    {
+      length = std::min({left, static_cast<u32>(((dst + left - 1) & PowerPC::HW_PAGE_MASK) + 1),
+                         static_cast<u32>(((src + left - 1) & PowerPC::HW_PAGE_MASK) + 1)});
+      offset = left - length;
+    }
+    else
+    {
+      offset = done;
+      length = std::min(
+          {left, static_cast<u32>(PowerPC::HW_PAGE_SIZE - ((dst + offset) & PowerPC::HW_PAGE_MASK)),
+           static_cast<u32>(PowerPC::HW_PAGE_SIZE - ((src + offset) & PowerPC::HW_PAGE_MASK))});
+    }
+
+    u32 physical_dst;
+    const std::span<u8> dst_page = mmu.GetHostSpanForPage(dst + offset, &physical_dst);
+    const std::span<u8> src_page = mmu.GetHostSpanForPage(src + offset);
+    std::memmove(dst_page.data(), src_page.data(), length);
+    memory.MarkRangeWritten(physical_dst, length);
+    done += length;
+  }
+}
+
+void MoveThroughMMU(const Core::CPUThreadGuard& guard, u32 dst, u32 src, u32 size)
+{
+  if (src < dst)
+  {
+    for (u32 i = size; i-- > 0;)
+      PowerPC::MMU::HostWrite_U8(guard, PowerPC::MMU::HostRead_U8(guard, src + i), dst + i);
+  }
+  else
+  {
+    for (u32 i = 0; i < size; ++i)
+      PowerPC::MMU::HostWrite_U8(guard, PowerPC::MMU::HostRead_U8(guard, src + i), dst + i);
+  }
+}
+
+void Move(const Core::CPUThreadGuard& guard, u32 dst, u32 src, u32 size)
+{
+  auto& system = guard.GetSystem();
+  auto& mmu = system.GetMMU();
+  if (IsBackedByRAM(mmu, dst, size) && IsBackedByRAM(mmu, src, size))
+    MoveRAM(system, dst, src, size);
+  else
+    MoveThroughMMU(guard, dst, src, size);
+}
+
+void Read(const Core::CPUThreadGuard& guard, u32 address, std::span<u8> data)
+{
+  for (u32 i = 0; i < data.size(); ++i)
+    data[i] = PowerPC::MMU::HostRead_U8(guard, address + i);
+}
+
+void Write(const Core::CPUThreadGuard& guard, u32 address, std::span<const u8> data)
+{
+  auto& system = guard.GetSystem();
+  auto& mmu = system.GetMMU();
+  const u32 size = static_cast<u32>(data.size());
+  if (!IsBackedByRAM(mmu, address, size))
+  {
+    for (u32 i = 0; i < size; ++i)
+      PowerPC::MMU::HostWrite_U8(guard, data[i], address + i);
+    return;
+  }
+
+  u32 done = 0;
+  while (done < size)
+  {
+    u32 physical_address;
+    const std::span<u8> page = mmu.GetHostSpanForPage(address + done, &physical_address);
+    const u32 length = static_cast<u32>(std::min<size_t>(page.size(), size - done));
+    std::memcpy(page.data(), data.data() + done, length);
+    system.GetMemory().MarkRangeWritten(physical_address, length);
+    done += length;
+  }
+}
+
+void Fill(const Core::CPUThreadGuard& guard, u32 dst, u8 value, u32 size)
+{
+  auto& system = guard.GetSystem();
+  auto& mmu = system.GetMMU();
+  if (!IsBackedByRAM(mmu, dst, size))
+  {
+    for (u32 i = 0; i < size; ++i)
+      PowerPC::MMU::HostWrite_U8(guard, value, dst + i);
+    return;
+  }
+
+  u32 done = 0;
+  while (done < size)
+  {
+    u32 physical_address;
+    const std::span<u8> page = mmu.GetHostSpanForPage(dst + done, &physical_address);
+    const u32 length = static_cast<u32>(std::min<size_t>(page.size(), size - done));
+    std::memset(page.data(), value, length);
+    system.GetMemory().MarkRangeWritten(physical_address, length);
+    done += length;
+  }
+}
+
+u64 GetFillMemCycles(u32 dst, u32 size)
+{
+  // __fill_mem aligns the destination with single bytes, fills 32 byte blocks and then words,
+  // and finishes with single bytes again.
+  u64 cycles = FILL_MEM_CYCLES;
+  if (size >= 32)
+  {
+    const u32 align = (0u - dst) & 3;
+    size -= align;
+    cycles += FILL_MEM_CYCLES_PER_BYTE * align + FILL_MEM_CYCLES_PER_BLOCK * (size >> 5) +
+              FILL_MEM_CYCLES_PER_WORD * ((size & 31) >> 2);
+    size &= 3;
+  }
+  return cycles + FILL_MEM_CYCLES_PER_BYTE * size;
+}
+
+void InvalidateRange(const Core::CPUThreadGuard& guard, u64 extra_cycles)
+{
+  auto& system = guard.GetSystem();
+  auto& ppc_state = system.GetPPCState();
+  const u32 address = ppc_state.gpr[3];
+  const u32 size = ppc_state.gpr[4];
+
+  // The SDK goes over a line more than needed when the address isn't aligned, which can be past
+  // the end of the range.
+  u32 lines = 0;
+  if (size != 0)
+    lines = static_cast<u32>((u64{size} + ((address & 31) != 0 ? 32 : 0) + 31) >> 5);
+
+  // The replacements aren't used with an emulated data cache, so like in Interpreter::dcbf, the
+  // only effect of dcbf, dcbst and dcbi is invalidating the JIT's code for the lines.
+  if (lines != 0)
+    system.GetJitInterface().InvalidateICacheLines(address, lines);
+
+  Return(ppc_state, DC_RANGE_CYCLES + extra_cycles + DC_RANGE_CYCLES_PER_LINE * lines);
+}
+}  // namespace
+
+bool IsKnownImplementation(std::string_view name, u32 hash, u32 size)
+{
+  return std::find(KNOWN_IMPLEMENTATIONS.begin(), KNOWN_IMPLEMENTATIONS.end(),
+                   std::make_tuple(name, hash, size)) != KNOWN_IMPLEMENTATIONS.end();
+}
+
+void Memcpy(const Core::CPUThreadGuard& guard)
+{
+  auto& ppc_state = guard.GetSystem().GetPPCState();
+  const u32 dst = ppc_state.gpr[3];
+  const u32 src = ppc_state.gpr[4];
+  const u32 size = ppc_state.gpr[5];
+
+  // memcpy returns the destination, which is already in r3.
+  Move(guard, dst, src, size);
+  Return(ppc_state, MEMCPY_CYCLES + MEMCPY_CYCLES_PER_BYTE * size);
+}
+
+void FillMem(const Core::CPUThreadGuard& guard)
+{
+  auto& ppc_state = guard.GetSystem().GetPPCState();
+  const u32 dst = ppc_state.gpr[3];
+  const u8 value = static_cast<u8>(ppc_state.gpr[4]);
+  const u32 size = ppc_state.gpr[5];
+
+  Fill(guard, dst, value, size);
+  Return(ppc_state, GetFillMemCycles(dst, size));
+}
+
+void DCFlushRange(const Core::CPUThreadGuard& guard)
+{
+  InvalidateRange(guard, DC_RANGE_SYNC_CYCLES);
+}
+
+void DCFlushRangeNoSync(const Core::CPUThreadGuard& guard)
+{
+  InvalidateRange(guard, 0);
+}
+
+void DCStoreRange(const Core::CPUThreadGuard& guard)
+{
+  InvalidateRange(guard, DC_RANGE_SYNC_CYCLES);
+}
+
+void DCStoreRangeNoSync(const Core::CPUThreadGuard& guard)
+{
+  InvalidateRange(guard, 0);
+}
+
+void DCInvalidateRange(const Core::CPUThreadGuard& guard)
+{
+  InvalidateRange(guard, 0);
+}
+
+// Like the rest of the SDK's paired single code, the matrix functions assume that GQR0 is left
+// at its default of loading and storing unscaled floats.
+
+void PSMTXIdentity(const Core::CPUThreadGuard& guard)
+{
+  static constexpr std::array<float, 12> identity{1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0};
+
+  std::array<u8, MTX_SIZE> data;
+  for (size_t i = 0; i < identity.size(); ++i)
+  {
+    const u32 value = Common::swap32(std::bit_cast<u32>(identity[i]));
+    std::memcpy(data.data() + i * sizeof(u32), &value, sizeof(u32));
+  }
+
+  auto& ppc_state = guard.GetSystem().GetPPCState();
+  Write(guard, ppc_state.gpr[3], data);
+  Return(ppc_state, PSMTX_IDENTITY_CYCLES);
+}
+
+void PSMTXCopy(const Core::CPUThreadGuard& guard)
+{
+  auto& ppc_state = guard.GetSystem().GetPPCState();
+  const u32 src = ppc_state.gpr[3];
+  const u32 dst = ppc_state.gpr[4];
+
+  // The SDK loads and stores one pair at a time, which matters if the matrices overlap.
+  for (u32 offset = 0; offset < MTX_SIZE; offset += 2 * sizeof(u32))
+  {
+    std::array<u8, 2 * sizeof(u32)> pair;
+    Read(guard, src + offset, pair);
+
+    // Going through the registers flushes denormals to zero, see psq_st.
+    for (size_t i = 0; i < pair.size(); i += sizeof(u32))
+    {
+      u32 value;
+      std::memcpy(&value, pair.data() + i, sizeof(u32));
+      value = Common::swap32(ConvertToSingleFTZ(ConvertToDouble(Common::swap32(value))));
+      std::memcpy(pair.data() + i, &value, sizeof(u32));
+    }
+
+    Write(guard, dst + offset, pair);
+  }
+
+  Return(ppc_state, PSMTX_COPY_CYCLES);
+}
+}  // namespace HLE_SDK
@@ -0,0 +1,35 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <string_view>
+
+#include "Common/CommonTypes.h"
+
+namespace Core
+{
+class CPUThreadGuard;
+};
+
+// Host versions of SDK functions that games spend a lot of time in. They are only installed in
+// place of code that is known to behave exactly like them, see IsKnownImplementation, and only
+// with MAIN_HLE_SDK_FUNCTIONS enabled.
+namespace HLE_SDK
+{
+// Whether the function with this name and checksum (see HashSignatureDB::ComputeCodeChecksum)
+// is an implementation that the replacement matches.
+bool IsKnownImplementation(std::string_view name, u32 hash, u32 size);
+
+void Memcpy(const Core::CPUThreadGuard& guard);
+void FillMem(const Core::CPUThreadGuard& guard);
+
+void DCFlushRange(const Core::CPUThreadGuard& guard);
+void DCFlushRangeNoSync(const Core::CPUThreadGuard& guard);
+void DCStoreRange(const Core::CPUThreadGuard& guard);
+void DCStoreRangeNoSync(const Core::CPUThreadGuard& guard);
+void DCInvalidateRange(const Core::CPUThreadGuard& guard);
+
+void PSMTXIdentity(const Core::CPUThreadGuard& guard);
+void PSMTXCopy(const Core::CPUThreadGuard& guard);
+}  // namespace HLE_SDK
@@ -10,6 +10,7 @@
 #include "AudioCommon/AudioCommon.h"
 #include "Common/CommonTypes.h"
 #include "Common/Event.h"
+#include "Common/TraceZone.h"
 #include "Core/CPUThreadConfigCallback.h"
 #include "Core/Core.h"
 #include "Core/Host.h"
@@ -104,7 +105,10 @@ void CPUManager::Run()
       }
 
       // Enter a fast runloop
-      power_pc.RunLoop();
+      {
+        TRACE_ZONE("CPU::RunLoop");
+        power_pc.RunLoop();
+      }
 
       state_lock.lock();
       m_state_cpu_thread_active = false;
@@ -527,6 +527,18 @@ void DSPManager::Do_ARAM_DMA()
 
     if (m_aram_dma.ARAddr < m_aram.size)
     {
+      // On Wii, ARAM is EXRAM, and the stores below don't go through the memory manager.
+      if (m_aram.wii_mode)
+      {
+        memory.MarkRangeWritten(0x10000000 | (m_aram_dma.ARAddr & m_aram.mask),
+                                m_aram_dma.Cnt.count);
+        if ((m_aram_info.Hex & 0xf) == 4 && m_aram_dma.ARAddr < 0x400000)
+        {
+          memory.MarkRangeWritten(0x10000000 | ((m_aram_dma.ARAddr + 0x400000) & m_aram.mask),
+                                  m_aram_dma.Cnt.count);
+        }
+      }
+
       while (m_aram_dma.Cnt.count)
       {
         if ((m_aram_info.Hex & 0xf) == 3)
@@ -596,6 +608,8 @@ void DSPManager::WriteARAM(u8 value, u32 address)
 {
   // TODO: verify this on Wii
   m_aram.ptr[address & m_aram.mask] = value;
+  if (m_aram.wii_mode)
+    m_system.GetMemory().MarkRangeWritten(0x10000000 | (address & m_aram.mask), 1);
 }
 
 u8* DSPManager::GetARAMPtr() const
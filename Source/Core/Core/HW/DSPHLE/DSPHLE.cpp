@@ -6,6 +6,7 @@
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
 #include "Common/MsgHandler.h"
+#include "Core/Config/MainSettings.h"
 #include "Core/Core.h"
 #include "Core/CoreTiming.h"
 #include "Core/HW/DSPHLE/UCodes/UCodes.h"
@@ -23,6 +24,7 @@ DSPHLE::~DSPHLE() = default;
 bool DSPHLE::Initialize(bool wii, bool dsp_thread)
 {
   m_wii = wii;
+  m_hle_thread = Config::Get(Config::MAIN_DSP_HLE_THREAD);
   m_ucode = nullptr;
   m_last_ucode = nullptr;
 
@@ -44,6 +46,7 @@ void DSPHLE::DSP_StopSoundStream()
 
 void DSPHLE::Shutdown()
 {
+  WaitForUCode();
   m_ucode = nullptr;
 }
 
@@ -65,12 +68,20 @@ void DSPHLE::SendMailToDSP(u32 mail)
   if (m_ucode != nullptr)
   {
     DEBUG_LOG_FMT(DSP_MAIL, "CPU writes {:#010x}", mail);
+    WaitForUCode();
     m_ucode->HandleMail(mail);
   }
 }
 
+void DSPHLE::WaitForUCode()
+{
+  if (m_ucode != nullptr)
+    m_ucode->WaitForPendingWork();
+}
+
 void DSPHLE::SetUCode(u32 crc)
 {
+  WaitForUCode();
   m_mail_handler.ClearPending();
   m_ucode = UCodeFactory(crc, this, m_wii);
   m_ucode->Initialize();
@@ -81,6 +92,7 @@ void DSPHLE::SetUCode(u32 crc)
 // Even callers are deleted.
 void DSPHLE::SwapUCode(u32 crc)
 {
+  WaitForUCode();
   m_mail_handler.ClearPending();
 
   if (m_last_ucode && UCodeInterface::GetCRC(m_last_ucode.get()) == crc)
@@ -112,6 +124,7 @@ void DSPHLE::DoState(PointerWrap& p)
   p.Do(m_control_reg_init_code_clear_time);
   p.Do(m_dsp_state);
 
+  WaitForUCode();
   int ucode_crc = UCodeInterface::GetCRC(m_ucode.get());
   int ucode_crc_before_load = ucode_crc;
   int last_ucode_crc = UCodeInterface::GetCRC(m_last_ucode.get());
@@ -148,6 +161,7 @@ u16 DSPHLE::DSP_ReadMailBoxHigh(bool cpu_mailbox)
   }
   else
   {
+    WaitForUCode();
     return AccessMailHandler().ReadDSPMailboxHigh();
   }
 }
@@ -160,6 +174,7 @@ u16 DSPHLE::DSP_ReadMailBoxLow(bool cpu_mailbox)
   }
   else
   {
+    WaitForUCode();
     return AccessMailHandler().ReadDSPMailboxLow();
   }
 }
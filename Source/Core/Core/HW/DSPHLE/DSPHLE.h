@@ -52,8 +52,12 @@ public:
 
   Core::System& GetSystem() const { return m_system; }
 
+  // Whether uCodes may process command lists on a worker thread.
+  bool IsHLEThreadEnabled() const { return m_hle_thread; }
+
 private:
   void SendMailToDSP(u32 mail);
+  void WaitForUCode();
 
   // Fake mailbox utility
   struct DSPState
@@ -78,6 +82,8 @@ private:
   u64 m_control_reg_init_code_clear_time = 0;
   CMailHandler m_mail_handler;
 
+  bool m_hle_thread = false;
+
   Core::System& m_system;
 };
 }  // namespace DSP::HLE
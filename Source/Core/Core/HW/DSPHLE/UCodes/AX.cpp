@@ -700,7 +700,21 @@ void AXUCode::HandleMail(u32 mail)
 
   case MailState::WaitingForCmdListAddress:
     CopyCmdList(mail, m_cmdlist_size);
-    HandleCommandList();
+    // The game can't tell when the command list has been processed until it reads the mail sent by
+    // SignalWorkEnd, and DSPHLE waits for pending work before any mail is read.
+    if (m_dsphle->IsHLEThreadEnabled() && CanHandleCommandListAsync() && !Core::WantsDeterminism())
+    {
+      if (!m_command_list_thread_started)
+      {
+        m_command_list_thread.Reset("AX Command List", [this](int) { HandleCommandList(); });
+        m_command_list_thread_started = true;
+      }
+      m_command_list_thread.Push(0);
+    }
+    else
+    {
+      HandleCommandList();
+    }
     m_cmdlist_size = 0;
     SignalWorkEnd();
     m_mail_state = MailState::WaitingForNextTask;
@@ -806,6 +820,12 @@ void AXUCode::DoAXState(PointerWrap& p)
   m_accelerator->DoState(p);
 }
 
+void AXUCode::WaitForPendingWork()
+{
+  if (m_command_list_thread_started)
+    m_command_list_thread.WaitForCompletion();
+}
+
 void AXUCode::DoState(PointerWrap& p)
 {
   DoStateShared(p);
@@ -18,6 +18,7 @@
 #include "Common/BitUtils.h"
 #include "Common/CommonTypes.h"
 #include "Common/Swap.h"
+#include "Common/WorkQueueThread.h"
 #include "Core/HW/DSPHLE/DSPHLE.h"
 #include "Core/HW/DSPHLE/UCodes/UCodes.h"
 #include "Core/HW/Memmap.h"
@@ -80,6 +81,7 @@ public:
   void HandleMail(u32 mail) override;
   void Update() override;
   void DoState(PointerWrap& p) override;
+  void WaitForPendingWork() override;
 
 protected:
   // CPU sends 0xBABE0000 | cmdlist_size to the DSP
@@ -149,6 +151,10 @@ protected:
   virtual void HandleCommandList();
   void SignalWorkEnd();
 
+  // Command lists can only be processed on the worker thread if they don't send any mail, since
+  // the timing of those mails has to be the same as when processing them on the CPU thread.
+  virtual bool CanHandleCommandListAsync() const { return true; }
+
   struct BufferDesc
   {
     int* ptr;
@@ -227,5 +233,9 @@ private:
   };
 
   MailState m_mail_state = MailState::WaitingForCmdListSize;
+
+  // Processes command lists when the DSP HLE thread is enabled. Started on first use.
+  Common::WorkQueueThread<int> m_command_list_thread;
+  bool m_command_list_thread_started = false;
 };
 }  // namespace DSP::HLE
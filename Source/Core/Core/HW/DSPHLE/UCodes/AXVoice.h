@@ -12,7 +12,6 @@
 #endif
 
 #include <algorithm>
-#include <functional>
 #include <memory>
 
 #include "Common/CommonTypes.h"
@@ -238,7 +237,11 @@ u16 AcceleratorGetSample(HLEAccelerator* accelerator)
 // We start getting samples not from sample 0, but 0.<curr_pos_frac>. This
 // avoids discontinuities in the audio stream, especially with very low ratios
 // which interpolate a lot of values between two "real" samples.
-u32 ResampleAudio(std::function<s16(u32)> input_callback, s16* output, u32 count, s16* last_samples,
+//
+// The input callback is a template parameter rather than a std::function so that it can be inlined
+// into the per-sample loops.
+template <typename InputCallback>
+u32 ResampleAudio(InputCallback input_callback, s16* output, u32 count, s16* last_samples,
                   u32 curr_pos, u32 ratio, int srctype, const s16* coeffs)
 {
   int read_samples_count = 0;
@@ -372,30 +375,34 @@ void GetInputSamples(HLEAccelerator* accelerator, PB_TYPE& pb, s16* samples, u16
   pb.adpcm.pred_scale = accelerator->GetPredScale();
 }
 
+// Scales a sample by a volume and clamps the result. The product of an s16 sample and a u16 volume
+// always fits in an s32, so this matches computing it with 64-bit intermediates.
+s16 ApplyVolume(s16 sample, s32 volume)
+{
+  return static_cast<s16>(std::clamp((sample * volume) >> 15, -32767, 32767));  // -32768 ?
+}
+
 // Add samples to an output buffer, with optional volume ramping.
 void MixAdd(int* out, const s16* input, u32 count, VolumeData* vd, s16* dpop, bool ramp)
 {
-  u16& volume = vd->volume;
-  u16 volume_delta = vd->volume_delta;
+  const u16 start_volume = vd->volume;
 
   // If volume ramping is disabled, set volume_delta to 0. That way, the
-  // mixing loop can avoid testing if volume ramping is enabled at each step,
-  // and just add volume_delta.
-  if (!ramp)
-    volume_delta = 0;
+  // mixing loop can avoid testing if volume ramping is enabled at each step.
+  const u16 volume_delta = ramp ? vd->volume_delta : 0;
 
+  // The volume of each sample is derived from its index instead of being accumulated, and the
+  // last sample is only stored to dpop after the loop. Without any loop-carried state, the
+  // compiler can vectorize this loop.
   for (u32 i = 0; i < count; ++i)
-  {
-    s64 sample = input[i];
-    sample *= volume;
-    sample >>= 15;
-    sample = std::clamp((s32)sample, -32767, 32767);  // -32768 ?
-
-    out[i] += (s16)sample;
-    volume += volume_delta;
+    out[i] += ApplyVolume(input[i], static_cast<u16>(start_volume + i * volume_delta));
 
-    *dpop = (s16)sample;
+  if (count != 0)
+  {
+    const u32 last = count - 1;
+    *dpop = ApplyVolume(input[last], static_cast<u16>(start_volume + last * volume_delta));
   }
+  vd->volume = static_cast<u16>(start_volume + count * volume_delta);
 }
 
 // Execute a low pass filter on the samples using one history value. Returns
@@ -420,20 +427,23 @@ void ProcessVoice(HLEAccelerator* accelerator, PB_TYPE& pb, const AXBuffers& buf
   s16 samples[MAX_SAMPLES_PER_FRAME];
   GetInputSamples(accelerator, pb, samples, count, coeffs);
 
-  // Apply a global volume ramp using the volume envelope parameters.
+  // Apply a global volume ramp using the volume envelope parameters. As in MixAdd, the volume is
+  // computed from the sample index so that the loop can be vectorized.
+  const u16 start_volume = pb.vol_env.cur_volume;
+  const u16 volume_delta = pb.vol_env.cur_volume_delta;
   for (u32 i = 0; i < count; ++i)
   {
+    const u16 raw_volume = static_cast<u16>(start_volume + i * volume_delta);
 #ifdef AX_GC
     // signed on GameCube
-    const s32 volume = (s16)pb.vol_env.cur_volume;
+    const s32 volume = static_cast<s16>(raw_volume);
 #else
     // unsigned on Wii
-    const s32 volume = (u16)pb.vol_env.cur_volume;
+    const s32 volume = raw_volume;
 #endif
-    const s32 sample = ((s32)samples[i] * volume) >> 15;
-    samples[i] = std::clamp(sample, -32767, 32767);  // -32768 ?
-    pb.vol_env.cur_volume += pb.vol_env.cur_volume_delta;
+    samples[i] = ApplyVolume(samples[i], volume);
   }
+  pb.vol_env.cur_volume = static_cast<s16>(start_volume + count * volume_delta);
 
   // Optionally, execute a low pass filter
   if (pb.lpf.enabled)
@@ -39,6 +39,14 @@ constexpr bool ExramRead(u32 address)
   return (address & 0x10000000) != 0;
 }
 
+static void MarkHLEMemoryWritten(Memory::MemoryManager& memory, u32 address, u32 size)
+{
+  if (ExramRead(address))
+    memory.MarkRangeWritten(0x10000000 | (address & memory.GetExRamMask()), size);
+  else
+    memory.MarkRangeWritten(address & memory.GetRamMask(), size);
+}
+
 u8 HLEMemory_Read_U8(Memory::MemoryManager& memory, u32 address)
 {
   if (ExramRead(address))
@@ -49,6 +57,8 @@ u8 HLEMemory_Read_U8(Memory::MemoryManager& memory, u32 address)
 
 void HLEMemory_Write_U8(Memory::MemoryManager& memory, u32 address, u8 value)
 {
+  MarkHLEMemoryWritten(memory, address, 1);
+
   if (ExramRead(address))
     memory.GetEXRAM()[address & memory.GetExRamMask()] = value;
   else
@@ -74,6 +84,8 @@ u16 HLEMemory_Read_U16(Memory::MemoryManager& memory, u32 address)
 
 void HLEMemory_Write_U16LE(Memory::MemoryManager& memory, u32 address, u16 value)
 {
+  MarkHLEMemoryWritten(memory, address, sizeof(u16));
+
   if (ExramRead(address))
     std::memcpy(&memory.GetEXRAM()[address & memory.GetExRamMask()], &value, sizeof(u16));
   else
@@ -104,6 +116,8 @@ u32 HLEMemory_Read_U32(Memory::MemoryManager& memory, u32 address)
 
 void HLEMemory_Write_U32LE(Memory::MemoryManager& memory, u32 address, u32 value)
 {
+  MarkHLEMemoryWritten(memory, address, sizeof(u32));
+
   if (ExramRead(address))
     std::memcpy(&memory.GetEXRAM()[address & memory.GetExRamMask()], &value, sizeof(u32));
   else
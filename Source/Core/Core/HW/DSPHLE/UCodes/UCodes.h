@@ -51,6 +51,11 @@ public:
   virtual void Update() = 0;
 
   virtual void DoState(PointerWrap& p) = 0;
+
+  // Blocks until work the uCode is doing on another thread has finished. Called before any state
+  // that the emulated CPU can observe is accessed.
+  virtual void WaitForPendingWork() {}
+
   static u32 GetCRC(UCodeInterface* ucode) { return ucode ? ucode->m_crc : UCODE_NULL; }
 
 protected:
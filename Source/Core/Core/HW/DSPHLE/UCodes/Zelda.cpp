@@ -1086,15 +1086,18 @@ void ZeldaAudioRenderer::ApplyReverb(bool post_rendering)
         (*last8_samples_buffers[rpb_idx])[i] = buffer[0x50 + i];
 
       auto ApplyFilter = [&]() {
-        // Filter the buffer using provided coefficients.
+        // Filter the buffer using provided coefficients. The output goes to a separate buffer so
+        // that the compiler can tell the samples are independent of each other.
+        std::array<s16, 0x50> filtered;
         for (u16 i = 0; i < 0x50; ++i)
         {
           s32 sample = 0;
           for (u16 j = 0; j < 8; ++j)
             sample += (s32)buffer[i + j] * rpb.filter_coeffs[j];
           sample >>= 15;
-          buffer[i] = std::clamp(sample, -0x8000, 0x7FFF);
+          filtered[i] = std::clamp(sample, -0x8000, 0x7FFF);
         }
+        std::copy(filtered.begin(), filtered.end(), buffer.begin());
       };
 
       // LSB set -> pre-filtering.
@@ -1519,8 +1522,12 @@ void ZeldaAudioRenderer::Resample(VPB* vpb, const s16* src, MixingBuffer* dst)
   }
   else
   {
-    for (auto& dst_sample : *dst)
+    const u32 start_pos = pos;
+    for (u32 n = 0; n < dst->size(); ++n)
     {
+      // Computed from the index so that iterations don't depend on each other.
+      pos = start_pos + n * ratio;
+
       // We have 0x40 * 4 coeffs that need to be selected based on the
       // most significant bits of the fractional part of the position. 12
       // bits >> 6 = 6 bits = 0x40. Multiply by 4 since there are 4
@@ -1534,10 +1541,9 @@ void ZeldaAudioRenderer::Resample(VPB* vpb, const s16* src, MixingBuffer* dst)
         dst_sample_unclamped += (s64)2 * coeffs[i] * input[i];
       dst_sample_unclamped >>= 16;
 
-      dst_sample = (s16)std::clamp<s64>(dst_sample_unclamped, -0x8000, 0x7FFF);
-
-      pos += ratio;
+      (*dst)[n] = (s16)std::clamp<s64>(dst_sample_unclamped, -0x8000, 0x7FFF);
     }
+    pos = start_pos + static_cast<u32>(dst->size()) * ratio;
   }
 
   for (u32 i = 0; i < 4; ++i)
@@ -89,23 +89,25 @@ private:
     if (!vol && !step)
       return vol;
 
+    // The volume of each sample is computed from its index rather than accumulated, so that the
+    // loop has no dependency between iterations and can be vectorized.
     for (size_t i = 0; i < N; ++i)
     {
-      (*dst)[i] += ((vol >> 16) * src[i]) >> 16;
-      vol += step;
+      const s32 sample_vol = static_cast<s32>(static_cast<u32>(vol) + static_cast<u32>(i * step));
+      (*dst)[i] += ((sample_vol >> 16) * src[i]) >> 16;
     }
 
-    return vol;
+    return static_cast<s32>(static_cast<u32>(vol) + static_cast<u32>(N * step));
   }
 
   // Does not use std::array because it needs to be able to process partial
   // buffers. Volume is in 1.15 format.
   void AddBuffersWithVolume(s16* dst, const s16* src, size_t count, u16 vol)
   {
-    while (count--)
+    for (size_t i = 0; i < count; ++i)
     {
-      s32 vol_src = ((s32)*src++ * (s32)vol) >> 15;
-      *dst++ += std::clamp(vol_src, -0x8000, 0x7FFF);
+      s32 vol_src = ((s32)src[i] * (s32)vol) >> 15;
+      dst[i] += std::clamp(vol_src, -0x8000, 0x7FFF);
     }
   }
 
@@ -120,9 +120,12 @@ static bool FillDSPInitOptions(DSPInitOptions* opts)
     return false;
 
   opts->core_type = DSPInitOptions::CoreType::Interpreter;
-#ifdef _M_X86_64
+#if defined(_M_X86_64)
   if (Config::Get(Config::MAIN_DSP_JIT))
     opts->core_type = DSPInitOptions::CoreType::JIT64;
+#elif defined(_M_ARM_64)
+  if (Config::Get(Config::MAIN_DSP_JIT))
+    opts->core_type = DSPInitOptions::CoreType::JITARM64;
 #endif
 
   if (Config::Get(Config::MAIN_DSP_CAPTURE_LOG))
@@ -127,25 +127,12 @@ void DVDInterface::DoState(PointerWrap& p)
 }
 
 size_t DVDInterface::ProcessDTKSamples(s16* target_samples, size_t target_block_count,
-                                       const std::vector<u8>& audio_data)
+                                       std::span<const u8> audio_data)
 {
   const size_t block_count_to_process =
       std::min(target_block_count, audio_data.size() / StreamADPCM::ONE_BLOCK_SIZE);
-  size_t samples_processed = 0;
-  size_t bytes_processed = 0;
-  for (size_t i = 0; i < block_count_to_process; ++i)
-  {
-    m_adpcm_decoder.DecodeBlock(&target_samples[samples_processed * 2],
-                                &audio_data[bytes_processed]);
-    for (size_t j = 0; j < StreamADPCM::SAMPLES_PER_BLOCK * 2; ++j)
-    {
-      // TODO: Fix the mixer so it can accept non-byte-swapped samples.
-      s16* sample = &target_samples[samples_processed * 2 + j];
-      *sample = Common::swap16(*sample);
-    }
-    samples_processed += StreamADPCM::SAMPLES_PER_BLOCK;
-    bytes_processed += StreamADPCM::ONE_BLOCK_SIZE;
-  }
+  // TODO: Fix the mixer so it can accept non-byte-swapped samples.
+  m_adpcm_decoder.DecodeBlocksBigEndian(target_samples, audio_data.data(), block_count_to_process);
   return block_count_to_process;
 }
 
@@ -186,7 +173,7 @@ u32 DVDInterface::AdvanceDTK(u32 maximum_blocks, u32* blocks_to_process)
 }
 
 void DVDInterface::DTKStreamingCallback(DIInterruptType interrupt_type,
-                                        const std::vector<u8>& audio_data, s64 cycles_late)
+                                        std::span<const u8> audio_data, s64 cycles_late)
 {
   auto& ai = m_system.GetAudioInterface();
 
@@ -198,10 +185,11 @@ void DVDInterface::DTKStreamingCallback(DIInterruptType interrupt_type,
 
   // Determine which audio data to read next.
 
-  // 3.5 ms of samples
-  constexpr u32 MAX_POSSIBLE_BLOCKS = 6;
+  // 14 ms of samples. The drive streams in much smaller pieces, but reading and mixing several of
+  // them at once keeps streaming audio from sending a request to the DVD thread every 3.5 ms.
+  constexpr u32 MAX_POSSIBLE_BLOCKS = 24;
   constexpr u32 MAX_POSSIBLE_SAMPLES = MAX_POSSIBLE_BLOCKS * StreamADPCM::SAMPLES_PER_BLOCK;
-  const u32 maximum_blocks = sample_rate == AudioInterface::SampleRate::AI32KHz ? 4 : 6;
+  const u32 maximum_blocks = sample_rate == AudioInterface::SampleRate::AI32KHz ? 16 : 24;
   u64 read_offset = 0;
   u32 read_length = 0;
 
@@ -1257,7 +1245,7 @@ void DVDInterface::SetDriveError(DriveError error)
 }
 
 void DVDInterface::FinishExecutingCommand(ReplyType reply_type, DIInterruptType interrupt_type,
-                                          s64 cycles_late, const std::vector<u8>& data)
+                                          s64 cycles_late, std::span<const u8> data)
 {
   // The data parameter contains the requested data iff this was called from DVDThread, and is
   // empty otherwise. DVDThread is the only source of ReplyType::NoReply and ReplyType::DTK.
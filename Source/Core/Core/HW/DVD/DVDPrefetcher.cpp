@@ -0,0 +1,182 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/HW/DVD/DVDPrefetcher.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "Common/Align.h"
+#include "Common/Logging/Log.h"
+#include "Core/Config/MainSettings.h"
+#include "DiscIO/Volume.h"
+
+namespace DVD
+{
+void Prefetcher::Reset(const DiscIO::Volume* disc)
+{
+  m_access_trace.Save();
+  m_access_trace.Clear();
+  m_current_file.reset();
+  m_queue.clear();
+  m_pending.clear();
+  m_chunks.clear();
+  m_chunk_order.clear();
+  m_cached_bytes = 0;
+  m_budget = 0;
+
+  if (!disc || !Config::Get(Config::MAIN_FAST_DISC_SPEED))
+    return;
+
+  m_budget = static_cast<u64>(std::max(Config::Get(Config::MAIN_DVD_PREFETCH_CACHE_SIZE), 0))
+             << 20;
+  if (m_budget != 0)
+    m_access_trace.Load(disc->GetGameID());
+}
+
+bool Prefetcher::Read(const DiscIO::Partition& partition, u64 offset, u32 length,
+                      std::vector<u8>* buffer) const
+{
+  if (!IsEnabled() || length == 0)
+    return false;
+
+  // Check that all of the data is available before copying anything
+  const u64 end = offset + length;
+  for (u64 chunk = Common::AlignDown(offset, CHUNK_SIZE); chunk < end; chunk += CHUNK_SIZE)
+  {
+    const auto it = m_chunks.find({partition.offset, chunk});
+    if (it == m_chunks.end() || chunk + it->second.size() < std::min(end, chunk + CHUNK_SIZE))
+      return false;
+  }
+
+  buffer->resize(length);
+  u8* out_ptr = buffer->data();
+  while (offset < end)
+  {
+    const u64 chunk = Common::AlignDown(offset, CHUNK_SIZE);
+    const u64 copy_size = std::min(end, chunk + CHUNK_SIZE) - offset;
+    std::memcpy(out_ptr, m_chunks.at({partition.offset, chunk}).data() + (offset - chunk),
+                copy_size);
+    out_ptr += copy_size;
+    offset += copy_size;
+  }
+
+  return true;
+}
+
+void Prefetcher::OnRead(const DiscIO::Volume& disc, const DiscIO::Partition& partition,
+                        u64 offset, u32 length)
+{
+  if (!IsEnabled())
+    return;
+
+  const std::optional<FileMonitor::FileAccess> file =
+      m_access_trace.Record(disc, partition, offset);
+  if (!file || file == m_current_file)
+    return;
+
+  // The game moved on to another file, so the old predictions are no longer useful
+  m_current_file = file;
+  m_queue.clear();
+
+  u64 queued_bytes = 0;
+  QueueRange(file->partition_offset, offset + length, file->offset + file->size, &queued_bytes);
+  for (const FileMonitor::FileAccess& next : m_access_trace.Predict(*file, m_budget))
+  {
+    QueueRange(next.partition_offset, next.offset, next.offset + next.size, &queued_bytes);
+    if (queued_bytes >= m_budget)
+      break;
+  }
+}
+
+void Prefetcher::QueueRange(u64 partition_offset, u64 offset, u64 end, u64* queued_bytes)
+{
+  if (offset >= end || *queued_bytes >= m_budget)
+    return;
+
+  // Never queue more than fits in the cache, or the first chunks would be evicted again
+  end = std::min(end, offset + (m_budget - *queued_bytes));
+  m_queue.push_back({partition_offset, offset, end});
+  *queued_bytes += end - offset;
+}
+
+bool Prefetcher::PrefetchChunk(const DiscIO::Volume& disc)
+{
+  // Reads that can't be submitted asynchronously are done synchronously by SubmitNextChunk
+  while (m_pending.size() < MAX_PENDING_CHUNKS && SubmitNextChunk(disc))
+  {
+  }
+
+  if (m_pending.empty())
+    return false;
+
+  CompleteOldestChunk(disc);
+  return true;
+}
+
+void Prefetcher::CompletePendingReads(const DiscIO::Volume& disc)
+{
+  while (!m_pending.empty())
+    CompleteOldestChunk(disc);
+}
+
+bool Prefetcher::SubmitNextChunk(const DiscIO::Volume& disc)
+{
+  while (!m_queue.empty())
+  {
+    Range& range = m_queue.front();
+    const ChunkKey key{range.partition_offset, Common::AlignDown(range.offset, CHUNK_SIZE)};
+    const u64 range_end = range.end;
+    range.offset = key.second + CHUNK_SIZE;
+    if (range.offset >= range.end)
+      m_queue.pop_front();
+
+    if (m_chunks.contains(key) || IsPending(key))
+      continue;
+
+    // Don't read past the end of the range, since it may also be the end of the disc
+    const DiscIO::Partition partition(key.first);
+    PendingChunk& chunk = m_pending.emplace_back();
+    chunk.key = key;
+    chunk.data.resize(std::min(range_end - key.second, CHUNK_SIZE));
+    chunk.async = disc.SubmitRead(key.second, chunk.data.size(), chunk.data.data(), partition);
+    if (!chunk.async)
+      chunk.success = disc.Read(key.second, chunk.data.size(), chunk.data.data(), partition);
+
+    return true;
+  }
+
+  return false;
+}
+
+void Prefetcher::CompleteOldestChunk(const DiscIO::Volume& disc)
+{
+  PendingChunk chunk = std::move(m_pending.front());
+  m_pending.pop_front();
+
+  // Asynchronous reads complete in submission order, so this is the read of this chunk
+  if (chunk.async)
+    chunk.success = disc.CompleteRead();
+
+  if (!chunk.success)
+    return;
+
+  m_cached_bytes += chunk.data.size();
+  m_chunks.emplace(chunk.key, std::move(chunk.data));
+  m_chunk_order.push_back(chunk.key);
+
+  while (m_cached_bytes > m_budget && !m_chunk_order.empty())
+  {
+    const auto it = m_chunks.find(m_chunk_order.front());
+    m_cached_bytes -= it->second.size();
+    m_chunks.erase(it);
+    m_chunk_order.pop_front();
+  }
+}
+
+bool Prefetcher::IsPending(const ChunkKey& key) const
+{
+  return std::any_of(m_pending.begin(), m_pending.end(),
+                     [&key](const PendingChunk& chunk) { return chunk.key == key; });
+}
+}  // namespace DVD
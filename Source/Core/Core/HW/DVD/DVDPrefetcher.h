@@ -0,0 +1,90 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <map>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Core/HW/DVD/FileMonitor.h"
+
+namespace DiscIO
+{
+struct Partition;
+class Volume;
+}  // namespace DiscIO
+
+namespace DVD
+{
+// Reads data the game is predicted to need next into memory while the DVD thread is idle.
+// Predictions are the rest of the file currently being read, followed by the files that were
+// read after it the last time the game was played (see FileMonitor::AccessTrace).
+//
+// Only used when emulated disc speed is disabled, since the data then has to be available
+// as soon as the game asks for it. All functions except Reset are called on the DVD thread.
+class Prefetcher
+{
+public:
+  // Must only be called while the DVD thread is idle
+  void Reset(const DiscIO::Volume* disc);
+
+  bool IsEnabled() const { return m_budget != 0; }
+
+  // Copies the data into the buffer if all of it has been prefetched
+  bool Read(const DiscIO::Partition& partition, u64 offset, u32 length,
+            std::vector<u8>* buffer) const;
+
+  // Informs the prefetcher that the game requested this data
+  void OnRead(const DiscIO::Volume& disc, const DiscIO::Partition& partition, u64 offset,
+              u32 length);
+
+  // Keeps up to MAX_PENDING_CHUNKS reads of predicted data in flight and waits for the oldest.
+  // Returns false if there is nothing left to prefetch.
+  bool PrefetchChunk(const DiscIO::Volume& disc);
+
+  // Must be called before the DVD thread exits, since pending reads write to the prefetcher
+  void CompletePendingReads(const DiscIO::Volume& disc);
+
+private:
+  static constexpr u64 CHUNK_SIZE = 0x20000;
+  static constexpr size_t MAX_PENDING_CHUNKS = 4;
+
+  struct Range
+  {
+    u64 partition_offset;
+    u64 offset;
+    u64 end;
+  };
+
+  using ChunkKey = std::pair<u64, u64>;
+
+  struct PendingChunk
+  {
+    ChunkKey key;
+    std::vector<u8> data;
+    // Whether the read was submitted asynchronously, otherwise it's already done
+    bool async;
+    bool success;
+  };
+
+  void QueueRange(u64 partition_offset, u64 offset, u64 end, u64* queued_bytes);
+  bool SubmitNextChunk(const DiscIO::Volume& disc);
+  void CompleteOldestChunk(const DiscIO::Volume& disc);
+  bool IsPending(const ChunkKey& key) const;
+
+  FileMonitor::AccessTrace m_access_trace;
+  std::optional<FileMonitor::FileAccess> m_current_file;
+
+  std::deque<Range> m_queue;
+  std::deque<PendingChunk> m_pending;
+  std::map<ChunkKey, std::vector<u8>> m_chunks;
+  std::deque<ChunkKey> m_chunk_order;
+  u64 m_cached_bytes = 0;
+  u64 m_budget = 0;
+};
+}  // namespace DVD
@@ -7,6 +7,7 @@
 #include <memory>
 #include <mutex>
 #include <optional>
+#include <span>
 #include <thread>
 #include <utility>
 #include <vector>
@@ -34,8 +35,13 @@
 #include "DiscIO/Enums.h"
 #include "DiscIO/Volume.h"
 
+#include "VideoCommon/FrameTimeReport.h"
+
 namespace DVD
 {
+// Smallest page size of the supported platforms
+constexpr u32 PREFAULT_STRIDE = 0x1000;
+
 DVDThread::DVDThread(Core::System& system) : m_system(system)
 {
 }
@@ -68,6 +74,7 @@ void DVDThread::StartDVDThread()
 void DVDThread::Stop()
 {
   StopDVDThread();
+  m_prefetcher.Reset(nullptr);
   m_disc.reset();
 }
 
@@ -91,12 +98,8 @@ void DVDThread::DoState(PointerWrap& p)
   // won't be touching anything while this function runs.
   WaitUntilIdle();
 
-  // Move all results from result_queue to result_map because
-  // PointerWrap::Do supports std::map but not Common::SPSCQueue.
-  // This won't affect the behavior of FinishRead.
-  ReadResult result;
-  while (m_result_queue.Pop(result))
-    m_result_map.emplace(result.first.id, std::move(result));
+  // Mapped data can't be savestated, so this fills in the buffers of those results.
+  BufferMappedResults();
 
   // Both queues are now empty, so we don't need to savestate them.
   p.Do(m_result_map);
@@ -131,7 +134,12 @@ void DVDThread::DoState(PointerWrap& p)
 void DVDThread::SetDisc(std::unique_ptr<DiscIO::Volume> disc)
 {
   WaitUntilIdle();
+
+  // Pending results may point into the mapping of the old disc
+  BufferMappedResults();
+
   m_disc = std::move(disc);
+  m_prefetcher.Reset(m_disc.get());
 }
 
 bool DVDThread::HasDisc() const
@@ -278,6 +286,7 @@ void DVDThread::FinishRead(u64 id, s64 cycles_late)
   }
   else
   {
+    const FrameTimeReport::CauseScope stutter_scope(StutterCause::DVDRead);
     while (true)
     {
       while (!m_result_queue.Pop(result))
@@ -292,7 +301,12 @@ void DVDThread::FinishRead(u64 id, s64 cycles_late)
   // We have now obtained the right ReadResult.
 
   const ReadRequest& request = result.first;
-  const std::vector<u8>& buffer = result.second;
+  std::span<const u8> data = result.second;
+  if (data.empty())
+  {
+    if (const u8* mapped_data = GetMappedData(request))
+      data = std::span<const u8>(mapped_data, request.length);
+  }
 
   DEBUG_LOG_FMT(DVDINTERFACE,
                 "Disc has been read. Real time: {} us. "
@@ -305,7 +319,7 @@ void DVDThread::FinishRead(u64 id, s64 cycles_late)
 
   auto& dvd_interface = m_system.GetDVDInterface();
   DVD::DIInterruptType interrupt;
-  if (buffer.size() != request.length)
+  if (data.size() != request.length)
   {
     PanicAlertFmtT("The disc could not be read (at {0:#x} - {1:#x}).", request.dvd_offset,
                    request.dvd_offset + request.length);
@@ -318,14 +332,44 @@ void DVDThread::FinishRead(u64 id, s64 cycles_late)
     if (request.copy_to_ram)
     {
       auto& memory = m_system.GetMemory();
-      memory.CopyToEmu(request.output_address, buffer.data(), request.length);
+      memory.CopyToEmu(request.output_address, data.data(), request.length);
     }
 
     interrupt = DVD::DIInterruptType::TCINT;
   }
 
   // Notify the emulated software that the command has been executed
-  dvd_interface.FinishExecutingCommand(request.reply_type, interrupt, cycles_late, buffer);
+  dvd_interface.FinishExecutingCommand(request.reply_type, interrupt, cycles_late, data);
+}
+
+const u8* DVDThread::GetMappedData(const ReadRequest& request) const
+{
+  // Only data that gets copied to RAM is worth reading in place, since other
+  // results have to be kept around in the buffer anyway
+  if (!request.copy_to_ram || !m_disc)
+    return nullptr;
+
+  return m_disc->GetMappedData(request.dvd_offset, request.length, request.partition);
+}
+
+void DVDThread::BufferMappedResults()
+{
+  // Must only be called while the DVD thread is idle. Results are moved from result_queue
+  // to result_map, which won't affect the behavior of FinishRead.
+  ReadResult result;
+  while (m_result_queue.Pop(result))
+    m_result_map.emplace(result.first.id, std::move(result));
+
+  for (auto& [id, map_result] : m_result_map)
+  {
+    const ReadRequest& request = map_result.first;
+    std::vector<u8>& buffer = map_result.second;
+    if (buffer.empty())
+    {
+      if (const u8* mapped_data = GetMappedData(request))
+        buffer.assign(mapped_data, mapped_data + request.length);
+    }
+  }
 }
 
 void DVDThread::DVDThreadMain()
@@ -337,16 +381,36 @@ void DVDThread::DVDThreadMain()
     m_request_queue_expanded.Wait();
 
     if (m_dvd_thread_exiting.IsSet())
-      return;
+      break;
 
     ReadRequest request;
     while (m_request_queue.Pop(request))
     {
       m_file_logger.Log(*m_disc, request.partition, request.dvd_offset);
 
-      std::vector<u8> buffer(request.length);
-      if (!m_disc->Read(request.dvd_offset, request.length, buffer.data(), request.partition))
-        buffer.resize(0);
+      std::vector<u8> buffer;
+      if (m_prefetcher.Read(request.partition, request.dvd_offset, request.length, &buffer))
+      {
+        // The data was prefetched while the DVD thread was idle
+      }
+      else if (const u8* mapped_data = GetMappedData(request))
+      {
+        // FinishRead copies straight from the mapping. Touching every page here makes sure
+        // that it's this thread and not the CPU thread that waits for the disc image.
+        volatile u8 sink = 0;
+        for (u32 i = 0; i < request.length; i += PREFAULT_STRIDE)
+          sink = sink + mapped_data[i];
+        if (request.length != 0)
+          sink = sink + mapped_data[request.length - 1];
+      }
+      else
+      {
+        buffer.resize(request.length);
+        if (!m_disc->Read(request.dvd_offset, request.length, buffer.data(), request.partition))
+          buffer.resize(0);
+      }
+
+      m_prefetcher.OnRead(*m_disc, request.partition, request.dvd_offset, request.length);
 
       request.realtime_done_us = Common::Timer::NowUs();
 
@@ -354,8 +418,20 @@ void DVDThread::DVDThreadMain()
       m_result_queue_expanded.Set();
 
       if (m_dvd_thread_exiting.IsSet())
-        return;
+        break;
+    }
+
+    if (m_dvd_thread_exiting.IsSet())
+      break;
+
+    // Use the time until the next request to read ahead
+    while (m_disc && m_request_queue.Empty() && !m_dvd_thread_exiting.IsSet() &&
+           m_prefetcher.PrefetchChunk(*m_disc))
+    {
     }
   }
+
+  if (m_disc)
+    m_prefetcher.CompletePendingReads(*m_disc);
 }
 }  // namespace DVD
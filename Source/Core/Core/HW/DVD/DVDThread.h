@@ -16,6 +16,7 @@
 #include "Common/SPSCQueue.h"
 
 #include "Core/HW/DVD/DVDInterface.h"
+#include "Core/HW/DVD/DVDPrefetcher.h"
 #include "Core/HW/DVD/FileMonitor.h"
 
 #include "DiscIO/Volume.h"
@@ -124,8 +125,13 @@ private:
     u64 realtime_done_us = 0;
   };
 
+  // The buffer of a ReadResult is left empty when the data can be copied straight from the
+  // disc image's memory mapping (see GetMappedData), and also when the read failed.
   using ReadResult = std::pair<ReadRequest, std::vector<u8>>;
 
+  const u8* GetMappedData(const ReadRequest& request) const;
+  void BufferMappedResults();
+
   CoreTiming::EventType* m_finish_read = nullptr;
 
   u64 m_next_id = 0;
@@ -142,6 +148,7 @@ private:
   std::unique_ptr<DiscIO::Volume> m_disc;
 
   FileMonitor::FileLogger m_file_logger;
+  Prefetcher m_prefetcher;
 
   Core::System& m_system;
 };
@@ -5,12 +5,17 @@
 
 #include <algorithm>
 #include <memory>
+#include <set>
+#include <sstream>
 #include <string>
 #include <unordered_set>
 
 #include <fmt/format.h>
 
+#include "Common/CommonPaths.h"
 #include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
 #include "Common/Logging/Log.h"
 #include "Common/Logging/LogManager.h"
 #include "Common/StringUtil.h"
@@ -90,4 +95,111 @@ void FileLogger::Log(const DiscIO::Volume& volume, const DiscIO::Partition& part
   m_previous_file_offset = file_offset;
 }
 
+void AccessTrace::Load(const std::string& game_id)
+{
+  Clear();
+  if (game_id.empty())
+    return;
+
+  m_path = File::GetUserPath(D_CACHE_IDX) + game_id + ".dvdtrace";
+
+  std::string contents;
+  if (!File::ReadFileToString(m_path, contents))
+    return;
+
+  // Each line is "partition offset next_partition next_offset next_size"
+  std::istringstream stream(contents);
+  std::string line;
+  while (std::getline(stream, line))
+  {
+    const std::vector<std::string> values = SplitString(line, ' ');
+    if (values.size() != 5)
+      continue;
+
+    u64 parsed[5];
+    bool valid = true;
+    for (size_t i = 0; i < values.size(); ++i)
+      valid = valid && TryParse(values[i], &parsed[i]);
+
+    if (valid)
+      m_successors[{parsed[0], parsed[1]}] = FileAccess{parsed[2], parsed[3], parsed[4]};
+  }
+
+  INFO_LOG_FMT(FILEMON, "Loaded {} file transitions from {}", m_successors.size(), m_path);
+}
+
+void AccessTrace::Save()
+{
+  if (!m_dirty || m_path.empty())
+    return;
+
+  std::string contents;
+  for (const auto& [key, next] : m_successors)
+  {
+    contents += fmt::format("{:#x} {:#x} {:#x} {:#x} {:#x}\n", key.first, key.second,
+                            next.partition_offset, next.offset, next.size);
+  }
+
+  if (!File::WriteStringToFile(m_path, contents))
+    WARN_LOG_FMT(FILEMON, "Failed to write DVD access trace to {}", m_path);
+
+  m_dirty = false;
+}
+
+void AccessTrace::Clear()
+{
+  m_path.clear();
+  m_successors.clear();
+  m_previous_file.reset();
+  m_dirty = false;
+}
+
+std::optional<FileAccess> AccessTrace::Record(const DiscIO::Volume& volume,
+                                              const DiscIO::Partition& partition, u64 offset)
+{
+  const DiscIO::FileSystem* file_system = volume.GetFileSystem(partition);
+  if (!file_system)
+    return std::nullopt;
+
+  const std::unique_ptr<DiscIO::FileInfo> file_info = file_system->FindFileInfo(offset);
+  if (!file_info)
+    return std::nullopt;
+
+  const FileAccess file{partition.offset, file_info->GetOffset(), file_info->GetSize()};
+  if (m_previous_file && *m_previous_file != file)
+  {
+    FileAccess& successor = m_successors[{m_previous_file->partition_offset,
+                                          m_previous_file->offset}];
+    if (successor != file)
+    {
+      successor = file;
+      m_dirty = true;
+    }
+  }
+
+  m_previous_file = file;
+  return file;
+}
+
+std::vector<FileAccess> AccessTrace::Predict(const FileAccess& file, u64 max_bytes) const
+{
+  std::vector<FileAccess> result;
+  std::set<FileKey> visited{{file.partition_offset, file.offset}};
+  u64 total_bytes = 0;
+
+  auto it = m_successors.find({file.partition_offset, file.offset});
+  while (it != m_successors.end() && total_bytes < max_bytes)
+  {
+    const FileAccess& next = it->second;
+    if (!visited.emplace(next.partition_offset, next.offset).second)
+      break;
+
+    result.push_back(next);
+    total_bytes += next.size;
+    it = m_successors.find({next.partition_offset, next.offset});
+  }
+
+  return result;
+}
+
 }  // namespace FileMonitor
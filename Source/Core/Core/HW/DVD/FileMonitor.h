@@ -3,11 +3,52 @@
 
 #pragma once
 
+#include <map>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
 #include "Common/CommonTypes.h"
 #include "DiscIO/Volume.h"
 
 namespace FileMonitor
 {
+struct FileAccess
+{
+  u64 partition_offset = 0;
+  u64 offset = 0;
+  u64 size = 0;
+
+  bool operator==(const FileAccess&) const = default;
+};
+
+// Learns which file a title reads after each of its files. The trace is kept per game ID in the
+// cache directory, so that the DVD thread can prefetch files before the game asks for them.
+class AccessTrace
+{
+public:
+  void Load(const std::string& game_id);
+  void Save();
+  void Clear();
+
+  // Returns the file on the disc that contains the offset, if any
+  std::optional<FileAccess> Record(const DiscIO::Volume& volume, const DiscIO::Partition& partition,
+                                   u64 offset);
+
+  // Returns the files that followed the given one last time, in the order they were read,
+  // until their total size reaches max_bytes
+  std::vector<FileAccess> Predict(const FileAccess& file, u64 max_bytes) const;
+
+private:
+  using FileKey = std::pair<u64, u64>;
+
+  std::string m_path;
+  std::map<FileKey, FileAccess> m_successors;
+  std::optional<FileAccess> m_previous_file;
+  bool m_dirty = false;
+};
+
 class FileLogger
 {
 public:
@@ -705,8 +705,13 @@ void CEXIETHERNET::BuiltInBBAInterface::ReadThreadHandler(CEXIETHERNET::BuiltInB
       std::this_thread::sleep_for(std::chrono::milliseconds(1));
     }
 
+    // Nothing is delivered in these cases, so sleep on the next iteration instead of spinning
+    // until receiving is enabled or the emulated software has made room.
     if (!self->m_read_enabled.IsSet())
+    {
+      datasize = 0;
       continue;
+    }
 
     u8 wp = self->m_eth_ref->page_ptr(BBA_RWP);
     const u8 rp = self->m_eth_ref->page_ptr(BBA_RRP);
@@ -714,7 +719,10 @@ void CEXIETHERNET::BuiltInBBAInterface::ReadThreadHandler(CEXIETHERNET::BuiltInB
       wp += 16;
 
     if ((wp - rp) >= 8)
+    {
+      datasize = 0;
       continue;
+    }
 
     std::lock_guard<std::mutex> lock(self->m_mtx);
     // process queue file first
@@ -3,6 +3,7 @@
 
 #include "Core/HW/EXI/EXI_DeviceEthernet.h"
 
+#include <cerrno>
 #include <cstring>
 
 #ifndef _WIN32
@@ -71,6 +72,8 @@ bool CEXIETHERNET::TAPNetworkInterface::Activate()
     }
   }
   ioctl(fd, TUNSETNOCSUM, 1);
+  // The read thread drains every queued frame after being woken up.
+  fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
 
   INFO_LOG_FMT(SP1, "BBA initialized with associated tap {}", ifr.ifr_name);
   return RecvInit();
@@ -130,6 +133,10 @@ bool CEXIETHERNET::TAPNetworkInterface::SendFrame(const u8* frame, u32 size)
 #ifdef __linux__
 void CEXIETHERNET::TAPNetworkInterface::ReadThreadHandler(TAPNetworkInterface* self)
 {
+  // Frames that arrive in a burst are read without going back to select() and are signalled
+  // to the emulated software with a single interrupt.
+  constexpr int MAX_FRAMES_PER_WAKEUP = 8;
+
   while (!self->readThreadShutdown.IsSet())
   {
     fd_set rfds;
@@ -142,18 +149,28 @@ void CEXIETHERNET::TAPNetworkInterface::ReadThreadHandler(TAPNetworkInterface* s
     if (select(self->fd + 1, &rfds, nullptr, nullptr, &timeout) <= 0)
       continue;
 
-    int readBytes = read(self->fd, self->m_eth_ref->mRecvBuffer.get(), BBA_RECV_SIZE);
-    if (readBytes < 0)
-    {
-      ERROR_LOG_FMT(SP1, "Failed to read from BBA, err={}", readBytes);
-    }
-    else if (self->readEnabled.IsSet())
+    bool raise_interrupt = false;
+    for (int i = 0; i < MAX_FRAMES_PER_WAKEUP; ++i)
     {
-      DEBUG_LOG_FMT(SP1, "Read data: {}",
-                    ArrayToString(self->m_eth_ref->mRecvBuffer.get(), readBytes, 0x10));
-      self->m_eth_ref->mRecvBufferLength = readBytes;
-      self->m_eth_ref->RecvHandlePacket();
+      const int readBytes = read(self->fd, self->m_eth_ref->mRecvBuffer.get(), BBA_RECV_SIZE);
+      if (readBytes < 0)
+      {
+        if (errno != EAGAIN && errno != EWOULDBLOCK)
+          ERROR_LOG_FMT(SP1, "Failed to read from BBA, err={}", errno);
+        break;
+      }
+
+      if (self->readEnabled.IsSet())
+      {
+        DEBUG_LOG_FMT(SP1, "Read data: {}",
+                      ArrayToString(self->m_eth_ref->mRecvBuffer.get(), readBytes, 0x10));
+        self->m_eth_ref->mRecvBufferLength = readBytes;
+        raise_interrupt |= self->m_eth_ref->RecvWriteFrame();
+      }
     }
+
+    if (raise_interrupt)
+      self->m_eth_ref->RecvScheduleInterrupt();
   }
 }
 #endif
@@ -542,6 +542,14 @@ inline void CEXIETHERNET::set_rwp(u16 value)
 // Be very careful about calling into the logger and other slow things
 bool CEXIETHERNET::RecvHandlePacket()
 {
+  if (RecvWriteFrame())
+    RecvScheduleInterrupt();
+  return true;
+}
+
+bool CEXIETHERNET::RecvWriteFrame()
+{
+  bool raised_interrupt = false;
   u8* write_ptr;
   Descriptor* descriptor;
   u32 status = 0;
@@ -635,7 +643,7 @@ bool CEXIETHERNET::RecvHandlePacket()
     mBbaMem[BBA_IR] |= INT_R;
 
     exi_status.interrupt |= exi_status.TRANSFER;
-    m_system.GetExpansionInterface().ScheduleUpdateInterrupts(CoreTiming::FromThread::NON_CPU, 0);
+    raised_interrupt = true;
   }
   else
   {
@@ -647,6 +655,11 @@ wait_for_next:
   if ((mBbaMem[BBA_NCRA] & NCRA_SR) != 0)
     m_network_interface->RecvStart();
 
-  return true;
+  return raised_interrupt;
+}
+
+void CEXIETHERNET::RecvScheduleInterrupt()
+{
+  m_system.GetExpansionInterface().ScheduleUpdateInterrupts(CoreTiming::FromThread::NON_CPU, 0);
 }
 }  // namespace ExpansionInterface
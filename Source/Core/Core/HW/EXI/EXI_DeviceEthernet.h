@@ -309,6 +309,11 @@ private:
   void inc_rwp();
   void set_rwp(u16 value);
   bool RecvHandlePacket();
+  // Writes the frame in mRecvBuffer to the receive buffer and returns whether the receive
+  // interrupt was raised. Readers that get several frames at once call RecvScheduleInterrupt once
+  // after the last of them instead of updating the EXI interrupts for every frame.
+  bool RecvWriteFrame();
+  void RecvScheduleInterrupt();
 
   std::unique_ptr<u8[]> mBbaMem;
   std::unique_ptr<u8[]> tx_fifo;
@@ -3,6 +3,7 @@
 
 #include "Core/HW/EXI/EXI_DeviceMemoryCard.h"
 
+#include <algorithm>
 #include <array>
 #include <cstring>
 #include <functional>
@@ -310,15 +311,21 @@ void CEXIMemoryCard::SetCS(int cs)
     case Command::PageProgram:
       if (m_position >= 5)
       {
-        int count = m_position - 5;
-        int i = 0;
+        u32 count = m_position - 5;
+        u32 i = 0;
         m_status &= ~MC_STATUS_BUSY;
 
-        while (count--)
+        // The buffer wraps around after 128 bytes and the address within the sector after 512,
+        // so write the runs in between at once instead of a byte at a time.
+        while (count != 0)
         {
-          m_memory_card->Write(m_address, 1, &(m_programming_buffer[i++]));
-          i &= 127;
-          m_address = (m_address & ~0x1FF) | ((m_address + 1) & 0x1FF);
+          const u32 sector_offset = m_address & 0x1FF;
+          const u32 length = std::min({count, static_cast<u32>(m_programming_buffer.size()) - i,
+                                       0x200 - sector_offset});
+          m_memory_card->Write(m_address, length, &m_programming_buffer[i]);
+          i = (i + length) & 127;
+          m_address = (m_address & ~0x1FF) | ((sector_offset + length) & 0x1FF);
+          count -= length;
         }
 
         CmdDoneLater(5000);
@@ -525,7 +532,10 @@ void CEXIMemoryCard::DoState(PointerWrap& p)
 void CEXIMemoryCard::DMARead(u32 addr, u32 size)
 {
   auto& memory = m_system.GetMemory();
-  m_memory_card->Read(m_address, size, memory.GetPointerForRange(addr, size));
+  if (u8* const pointer = memory.GetPointerForRange(addr, size))
+    m_memory_card->Read(m_address, size, pointer);
+  else
+    ERROR_LOG_FMT(EXPANSIONINTERFACE, "Memory card DMA read to invalid address {:08x}", addr);
 
   if ((m_address + size) % Memcard::BLOCK_SIZE == 0)
   {
@@ -543,7 +553,10 @@ void CEXIMemoryCard::DMARead(u32 addr, u32 size)
 void CEXIMemoryCard::DMAWrite(u32 addr, u32 size)
 {
   auto& memory = m_system.GetMemory();
-  m_memory_card->Write(m_address, size, memory.GetPointerForRange(addr, size));
+  if (const u8* const pointer = memory.GetReadOnlyPointerForRange(addr, size))
+    m_memory_card->Write(m_address, size, pointer);
+  else
+    ERROR_LOG_FMT(EXPANSIONINTERFACE, "Memory card DMA write from invalid address {:08x}", addr);
 
   if (((m_address + size) % Memcard::BLOCK_SIZE) == 0)
   {
@@ -3,6 +3,8 @@
 
 #include "Core/HW/GBACore.h"
 
+#include <utility>
+
 #define PYCPARSE  // Remove static functions from the header
 #include <mgba/core/interface.h>
 #undef PYCPARSE
@@ -43,6 +45,9 @@ mLogger s_stub_logger = {
 constexpr auto SAMPLES = 512;
 constexpr auto SAMPLE_RATE = 48000;
 
+// How many frames are skipped between the ones that are still rendered while the video is hidden
+constexpr int HIDDEN_FRAMESKIP = 30;
+
 // libmGBA does not return the correct frequency for some GB models
 static u32 GetCoreFrequency(mCore* core)
 {
@@ -228,6 +233,7 @@ bool Core::Start(u64 gc_ticks)
   m_last_gc_ticks = gc_ticks;
   m_gc_ticks_remainder = 0;
   m_keys = 0;
+  m_skipping_frames = false;
 
   SetSIODriver();
   SetVideoBuffer();
@@ -285,6 +291,8 @@ void Core::Reset()
     return;
 
   m_core->reset(m_core);
+  // Reapply the frameskip in case resetting the core changed it
+  m_skipping_frames = false;
 }
 
 bool Core::IsStarted() const
@@ -321,6 +329,11 @@ void Core::SetForceDisconnect(bool force_disconnect)
   m_force_disconnect = force_disconnect;
 }
 
+void Core::SetVideoHidden(bool hidden)
+{
+  m_video_hidden.store(hidden, std::memory_order_relaxed);
+}
+
 void Core::EReaderQueueCard(std::string_view card_path)
 {
   Flush();
@@ -421,6 +434,8 @@ void Core::AddCallbacks()
   };
   callbacks.videoFrameEnded = [](void* context) {
     auto core = static_cast<Core*>(context);
+    if (core->m_skipping_frames)
+      return;
     if (auto host = core->m_host.lock())
       host->FrameEnded(core->m_video_buffer);
   };
@@ -479,8 +494,10 @@ void Core::SendJoybusCommand(u64 gc_ticks, int transfer_time, u8* buffer, u16 ke
   {
     std::lock_guard<std::mutex> lock(m_queue_mutex);
     m_command_queue.push(command);
-    m_idle = false;
-    m_command_cv.notify_one();
+    // The thread only waits for commands once it has run all of them, so it only needs waking
+    // when it was idle.
+    if (std::exchange(m_idle, false))
+      m_command_cv.notify_one();
   }
   else
   {
@@ -527,13 +544,16 @@ void Core::ThreadLoop()
 
     queue_lock.lock();
     if (m_command_queue.empty())
+    {
       m_idle = true;
-    m_response_cv.notify_one();
+      m_response_cv.notify_one();
+    }
   }
 }
 
 void Core::RunCommand(Command& command)
 {
+  UpdateFrameskip();
   m_keys = command.keys;
   RunUntil(command.ticks);
   if (!command.sync_only)
@@ -562,6 +582,29 @@ void Core::RunCommand(Command& command)
     RunFor(command.transfer_time);
 }
 
+// Frameskip only affects what the renderer draws, not the emulation.
+void Core::UpdateFrameskip()
+{
+  const bool hidden = m_video_hidden.load(std::memory_order_relaxed);
+  if (hidden == m_skipping_frames)
+    return;
+  m_skipping_frames = hidden;
+
+  const int frameskip = hidden ? HIDDEN_FRAMESKIP : 0;
+  if (m_core->platform(m_core) == mPLATFORM_GBA)
+  {
+    auto& video = static_cast<::GBA*>(m_core->board)->video;
+    video.frameskip = frameskip;
+    video.frameskipCounter = 0;
+  }
+  else if (m_core->platform(m_core) == mPLATFORM_GB)
+  {
+    auto& video = static_cast<::GB*>(m_core->board)->video;
+    video.frameskip = frameskip;
+    video.frameskipCounter = 0;
+  }
+}
+
 void Core::RunUntil(u64 gc_ticks)
 {
   if (static_cast<s64>(gc_ticks - m_last_gc_ticks) <= 0)
@@ -630,6 +673,7 @@ void Core::ImportSave(std::string_view save_path)
 
   m_core->savedataRestore(m_core, save_file.data(), save_file.size(), true);
   m_core->reset(m_core);
+  m_skipping_frames = false;
 }
 
 void Core::ExportSave(std::string_view save_path)
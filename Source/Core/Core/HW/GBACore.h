@@ -4,6 +4,7 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 #include <condition_variable>
 #include <memory>
 #include <mutex>
@@ -69,6 +70,9 @@ public:
 
   void SetHost(std::weak_ptr<GBAHostInterface> host);
   void SetForceDisconnect(bool force_disconnect);
+  // While the core's output isn't shown, frames are rarely rendered and not sent to the host.
+  // Can be called from any thread.
+  void SetVideoHidden(bool hidden);
   void EReaderQueueCard(std::string_view card_path);
 
   void SendJoybusCommand(u64 gc_ticks, int transfer_time, u8* buffer, u16 keys);
@@ -98,6 +102,7 @@ private:
     u16 keys;
   };
   void RunCommand(Command& command);
+  void UpdateFrameskip();
 
   bool LoadBIOS(const char* bios_path);
   bool LoadSave(const char* save_path);
@@ -129,6 +134,8 @@ private:
   u16 m_keys = 0;
   bool m_link_enabled = false;
   bool m_force_disconnect = false;
+  std::atomic<bool> m_video_hidden = false;
+  bool m_skipping_frames = false;
 
   std::weak_ptr<GBAHostInterface> m_host;
 
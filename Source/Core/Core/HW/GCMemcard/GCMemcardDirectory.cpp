@@ -6,8 +6,11 @@
 #include <algorithm>
 #include <chrono>
 #include <cstring>
+#include <filesystem>
+#include <map>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -40,6 +43,58 @@
 
 static const char* MC_HDR = "MC_SYSTEM_AREA";
 
+namespace
+{
+struct CachedGCIHeader
+{
+  std::uintmax_t file_size;
+  std::filesystem::file_time_type time;
+  Memcard::DEntry header;
+};
+
+// The headers of the GCI files that have been read, so that booting again only has to read the
+// files that changed in the meantime.
+std::mutex s_gci_header_cache_mutex;
+std::map<std::string, CachedGCIHeader> s_gci_header_cache;
+}  // namespace
+
+// Reads the header of a GCI file, and returns the size of the file.
+static std::optional<std::uintmax_t> ReadGCIHeader(const std::string& filename,
+                                                   Memcard::DEntry* header)
+{
+  const std::filesystem::path path = StringToPath(filename);
+  std::error_code error;
+  const std::filesystem::file_time_type time = std::filesystem::last_write_time(path, error);
+  if (error)
+    return std::nullopt;
+  const std::uintmax_t file_size = std::filesystem::file_size(path, error);
+  if (error)
+    return std::nullopt;
+
+  std::lock_guard lk(s_gci_header_cache_mutex);
+  const auto it = s_gci_header_cache.find(filename);
+  if (it != s_gci_header_cache.end() && it->second.file_size == file_size &&
+      it->second.time == time)
+  {
+    *header = it->second.header;
+    return file_size;
+  }
+
+  Memcard::GCIFile gci;
+  gci.m_filename = filename;
+  if (!gci.LoadHeader())
+    return std::nullopt;
+
+  s_gci_header_cache.insert_or_assign(filename, CachedGCIHeader{file_size, time, gci.m_gci_header});
+  *header = gci.m_gci_header;
+  return file_size;
+}
+
+static bool HasValidFileSize(const Memcard::DEntry& header, std::uintmax_t file_size)
+{
+  return file_size == header.m_block_count * Memcard::BLOCK_SIZE + Memcard::DENTRY_SIZE;
+}
+
 static std::string GenerateDefaultGCIFilename(const Memcard::DEntry& entry,
                                               bool card_encoding_is_shift_jis)
 {
@@ -90,7 +145,8 @@ bool GCMemcardDirectory::LoadGCI(Memcard::GCIFile gci)
     return false;
   }
 
-  if (!gci.LoadSaveBlocks())
+  // The save data is only read once it's accessed, except for saves that have to be modified
+  if (gci.HasCopyProtection() && !gci.LoadSaveBlocks())
   {
     ERROR_LOG_FMT(EXPANSIONINTERFACE, "Failed to load data of {}", gci.m_filename);
     return false;
@@ -136,14 +192,11 @@ std::vector<std::string> GCMemcardDirectory::GetFileNamesForGameID(const std::st
   std::vector<Memcard::DEntry> loaded_saves;
   for (const std::string& file_name : Common::DoFileSearch({directory}, {".gci"}))
   {
-    File::IOFile gci_file(file_name, "rb");
-    if (!gci_file)
-      continue;
-
     Memcard::GCIFile gci;
     gci.m_filename = file_name;
     gci.m_dirty = false;
-    if (!gci_file.ReadBytes(&gci.m_gci_header, Memcard::DENTRY_SIZE))
+    const std::optional<std::uintmax_t> file_size = ReadGCIHeader(file_name, &gci.m_gci_header);
+    if (!file_size)
       continue;
 
     const auto same_identity_save_it = std::find_if(
@@ -159,9 +212,7 @@ std::vector<std::string> GCMemcardDirectory::GetFileNamesForGameID(const std::st
     if (num_blocks > 2043)
       continue;
 
-    const u32 size = num_blocks * Memcard::BLOCK_SIZE;
-    const u64 file_size = gci_file.GetSize();
-    if (file_size != size + Memcard::DENTRY_SIZE)
+    if (!HasValidFileSize(gci.m_gci_header, *file_size))
       continue;
 
     // There's technically other available block checks to prevent overfilling the virtual memory
@@ -192,6 +243,10 @@ GCMemcardDirectory::GCMemcardDirectory(const std::string& directory, ExpansionIn
   const bool current_game_only = Config::Get(Config::SESSION_GCI_FOLDER_CURRENT_GAME_ONLY);
   std::vector<std::string> filenames = Common::DoFileSearch({m_save_directory}, {".gci"});
 
+  // keep track of how many files failed to load for the current game so we can display a
+  // message to the user informing them why some of their saves may not be loaded
+  size_t failed_loads_current_game = 0;
+
   // split up into files for current games we should definitely load,
   // and files for other games that we don't care too much about
   std::vector<Memcard::GCIFile> gci_current_game;
@@ -201,13 +256,26 @@ GCMemcardDirectory::GCMemcardDirectory(const std::string& directory, ExpansionIn
     Memcard::GCIFile gci;
     gci.m_filename = filename;
     gci.m_dirty = false;
-    if (!gci.LoadHeader())
+    const std::optional<std::uintmax_t> file_size = ReadGCIHeader(filename, &gci.m_gci_header);
+    if (!file_size)
     {
       ERROR_LOG_FMT(EXPANSIONINTERFACE, "Failed to load header of {}", filename);
       continue;
     }
 
-    if (m_game_id == Common::swap32(gci.m_gci_header.m_gamecode.data()))
+    const bool is_current_game = m_game_id == Common::swap32(gci.m_gci_header.m_gamecode.data());
+    if (!HasValidFileSize(gci.m_gci_header, *file_size))
+    {
+      ERROR_LOG_FMT(EXPANSIONINTERFACE,
+                    "{}\nwas not loaded because it is an invalid GCI.\n File size ({:#x}) does not "
+                    "match the size recorded in the header",
+                    filename, *file_size);
+      if (is_current_game)
+        ++failed_loads_current_game;
+      continue;
+    }
+
+    if (is_current_game)
       gci_current_game.emplace_back(std::move(gci));
     else if (!current_game_only)
       gci_other_games.emplace_back(std::move(gci));
@@ -216,15 +284,10 @@ GCMemcardDirectory::GCMemcardDirectory(const std::string& directory, ExpansionIn
   m_saves.reserve(Memcard::DIRLEN);
 
   // load files for current game
-  size_t failed_loads_current_game = 0;
   for (Memcard::GCIFile& gci : gci_current_game)
   {
     if (!LoadGCI(std::move(gci)))
-    {
-      // keep track of how many files failed to load for the current game so we can display a
-      // message to the user informing them why some of their saves may not be loaded
       ++failed_loads_current_game;
-    }
   }
 
   // leave about 10% of free space on the card if possible
@@ -298,6 +361,8 @@ GCMemcardDirectory::~GCMemcardDirectory()
 
 s32 GCMemcardDirectory::Read(u32 src_address, s32 length, u8* dest_address)
 {
+  // Reads can load save data, and the flush thread unloads it.
+  std::unique_lock l(m_write_mutex);
   s32 block = src_address / Memcard::BLOCK_SIZE;
   u32 offset = src_address % Memcard::BLOCK_SIZE;
   s32 extra = 0;  // used for read calls that are across multiple blocks
@@ -348,6 +413,8 @@ s32 GCMemcardDirectory::Read(u32 src_address, s32 length, u8* dest_address)
   }
 
   memcpy(dest_address, m_last_block_address + offset, length);
+
+  l.unlock();
   if (extra)
     extra = Read(src_address + length, extra, dest_address + length);
   return length + extra;
@@ -386,7 +453,9 @@ s32 GCMemcardDirectory::Write(u32 dest_address, s32 length, const u8* src_addres
       s32 bytes_written = 0;
       while (length > 0)
       {
-        s32 to_write = std::min<s32>(Memcard::DENTRY_SIZE, length);
+        // Split multi-byte writes at entry boundaries, so that writing the last one syncs the saves
+        const u32 entry_offset = (dest_address + bytes_written) % Memcard::DENTRY_SIZE;
+        s32 to_write = std::min<s32>(Memcard::DENTRY_SIZE - entry_offset, length);
         bytes_written +=
             DirectoryWrite(dest_address + bytes_written, to_write, src_address + bytes_written);
         length -= to_write;
@@ -429,6 +498,7 @@ void GCMemcardDirectory::ClearBlock(u32 address)
     return;
   }
 
+  std::lock_guard l(m_write_mutex);
   const u32 block = address / Memcard::BLOCK_SIZE;
   INFO_LOG_FMT(EXPANSIONINTERFACE, "Clearing block {}", block);
   switch (block)
@@ -620,93 +690,115 @@ bool GCMemcardDirectory::SetUsedBlocks(int save_index)
 
 void GCMemcardDirectory::FlushToFile()
 {
-  std::unique_lock l(m_write_mutex);
-  Memcard::DEntry invalid;
-  for (Memcard::GCIFile& save : m_saves)
+  // Flushes write files one after another, so an older version of a save can't replace a newer one
+  std::lock_guard flush_lock(m_flush_mutex);
+
+  // The files are written after the lock is released, so that the emulated memory card doesn't
+  // have to wait for the disk.
+  std::vector<Memcard::GCIFile> writes;
+  std::vector<std::string> deletions;
   {
-    if (save.m_dirty)
+    std::unique_lock l(m_write_mutex);
+    for (Memcard::GCIFile& save : m_saves)
     {
-      if (save.m_gci_header.m_gamecode != Memcard::DEntry::UNINITIALIZED_GAMECODE)
+      bool written = false;
+      if (save.m_dirty)
       {
-        save.m_dirty = false;
-        if (save.m_save_data.empty())
+        if (save.m_gci_header.m_gamecode != Memcard::DEntry::UNINITIALIZED_GAMECODE)
         {
-          // The save's header has been changed but the actual save blocks haven't been read/written
-          // to
-          // skip flushing this file until actual save data is modified
-          ERROR_LOG_FMT(EXPANSIONINTERFACE,
-                        "GCI header modified without corresponding save data changes");
-          continue;
-        }
-        if (save.m_filename.empty())
-        {
-          std::string default_save_name =
-              m_save_directory + GenerateDefaultGCIFilename(save.m_gci_header, m_hdr.IsShiftJIS());
-
-          // Check to see if another file is using the same name
-          // This seems unlikely except in the case of file corruption
-          // otherwise what user would name another file this way?
-          for (int j = 0; File::Exists(default_save_name) && j < 10; ++j)
+          save.m_dirty = false;
+          // Save data is loaded lazily, so the header may have changed before the data was read
+          if (save.m_save_data.empty() && !save.LoadSaveBlocks())
           {
-            default_save_name.insert(default_save_name.end() - 4, '0');
+            // The save's header has been changed but its blocks couldn't be read
+            // skip flushing this file until actual save data is modified
+            ERROR_LOG_FMT(EXPANSIONINTERFACE,
+                          "GCI header modified without corresponding save data changes");
+            continue;
           }
-          if (File::Exists(default_save_name))
+          if (save.m_filename.empty())
           {
-            PanicAlertFmtT("Failed to find new filename.\n{0}\n will be overwritten",
-                           default_save_name);
+            std::string default_save_name =
+                m_save_directory +
+                GenerateDefaultGCIFilename(save.m_gci_header, m_hdr.IsShiftJIS());
+
+            // Check to see if another file is using the same name
+            // This seems unlikely except in the case of file corruption
+            // otherwise what user would name another file this way?
+            for (int j = 0; File::Exists(default_save_name) && j < 10; ++j)
+            {
+              default_save_name.insert(default_save_name.end() - 4, '0');
+            }
+            if (File::Exists(default_save_name))
+            {
+              PanicAlertFmtT("Failed to find new filename.\n{0}\n will be overwritten",
+                             default_save_name);
+            }
+            save.m_filename = default_save_name;
           }
-          save.m_filename = default_save_name;
+          writes.push_back(save);
+          written = true;
         }
-        File::IOFile gci(save.m_filename, "wb");
-        if (gci)
+        else if (save.m_filename.length() != 0)
         {
-          gci.WriteBytes(&save.m_gci_header, Memcard::DENTRY_SIZE);
-          for (const Memcard::GCMBlock& block : save.m_save_data)
-            gci.WriteBytes(block.m_block.data(), Memcard::BLOCK_SIZE);
-
-          if (gci.IsGood())
-          {
-            Core::DisplayMessage("Wrote save contents to GCI Folder", 4000);
-          }
-          else
-          {
-            Core::DisplayMessage(
-                fmt::format("Failed to write save contents to {}", save.m_filename), 10000);
-            ERROR_LOG_FMT(EXPANSIONINTERFACE, "Failed to save data to {}", save.m_filename);
-          }
-        }
-        else
-        {
-          Core::DisplayMessage(
-              fmt::format("Failed to open file at {} for writing", save.m_filename), 10000);
-          ERROR_LOG_FMT(EXPANSIONINTERFACE, "Failed to open file at {} for writing",
-                        save.m_filename);
+          save.m_dirty = false;
+          deletions.push_back(std::move(save.m_filename));
+          save.m_filename.clear();
+          save.m_save_data.clear();
+          save.m_used_blocks.clear();
         }
       }
-      else if (save.m_filename.length() != 0)
+
+      // Unload the save data for any game that is not running
+      // we could use !m_dirty, but some games have multiple gci files and may not write to them
+      // simultaneously
+      // this ensures that the save data for all of the current games gci files are stored in the
+      // savestate
+      // Saves that are being written stay loaded until the next flush, so they can't be read back
+      // from a file that's only partially written.
+      const u32 gamecode = Common::swap32(save.m_gci_header.m_gamecode.data());
+      if (gamecode != m_game_id && gamecode != 0xFFFFFFFF && !save.m_save_data.empty() &&
+          !written)
       {
-        save.m_dirty = false;
-        std::string& old_name = save.m_filename;
-        std::string deleted_name = old_name + ".deleted";
-        if (File::Exists(deleted_name))
-          File::Delete(deleted_name);
-        File::Rename(old_name, deleted_name);
-        save.m_filename.clear();
+        INFO_LOG_FMT(EXPANSIONINTERFACE, "Flushing savedata to disk for {}", save.m_filename);
         save.m_save_data.clear();
-        save.m_used_blocks.clear();
       }
     }
+  }
+
+  for (const std::string& old_name : deletions)
+  {
+    const std::string deleted_name = old_name + ".deleted";
+    if (File::Exists(deleted_name))
+      File::Delete(deleted_name);
+    File::Rename(old_name, deleted_name);
+  }
 
-    // Unload the save data for any game that is not running
-    // we could use !m_dirty, but some games have multiple gci files and may not write to them
-    // simultaneously
-    // this ensures that the save data for all of the current games gci files are stored in the
-    // savestate
-    const u32 gamecode = Common::swap32(save.m_gci_header.m_gamecode.data());
-    if (gamecode != m_game_id && gamecode != 0xFFFFFFFF && !save.m_save_data.empty())
+  for (const Memcard::GCIFile& save : writes)
+  {
+    File::IOFile gci(save.m_filename, "wb");
+    if (gci)
+    {
+      gci.WriteBytes(&save.m_gci_header, Memcard::DENTRY_SIZE);
+      for (const Memcard::GCMBlock& block : save.m_save_data)
+        gci.WriteBytes(block.m_block.data(), Memcard::BLOCK_SIZE);
+
+      if (gci.IsGood())
+      {
+        Core::DisplayMessage("Wrote save contents to GCI Folder", 4000);
+      }
+      else
+      {
+        Core::DisplayMessage(fmt::format("Failed to write save contents to {}", save.m_filename),
+                             10000);
+        ERROR_LOG_FMT(EXPANSIONINTERFACE, "Failed to save data to {}", save.m_filename);
+      }
+    }
+    else
     {
-      INFO_LOG_FMT(EXPANSIONINTERFACE, "Flushing savedata to disk for {}", save.m_filename);
-      save.m_save_data.clear();
+      Core::DisplayMessage(fmt::format("Failed to open file at {} for writing", save.m_filename),
+                           10000);
+      ERROR_LOG_FMT(EXPANSIONINTERFACE, "Failed to open file at {} for writing", save.m_filename);
     }
   }
 #if _WRITE_MC_HEADER
@@ -722,6 +814,17 @@ void GCMemcardDirectory::DoState(PointerWrap& p)
   std::unique_lock l(m_write_mutex);
   m_last_block = -1;
   m_last_block_address = nullptr;
+
+  // The save data of the current game is only loaded once it's accessed, but savestates need it.
+  if (!p.IsReadMode())
+  {
+    for (Memcard::GCIFile& save : m_saves)
+    {
+      if (Common::swap32(save.m_gci_header.m_gamecode.data()) == m_game_id)
+        save.LoadSaveBlocks();
+    }
+  }
+
   p.Do(m_save_directory);
   p.Do(m_hdr);
   p.Do(m_dir1);
@@ -62,7 +62,9 @@ private:
 
   std::string m_save_directory;
   Common::Event m_flush_trigger;
+  // Guards the card's contents, which the flush thread copies the dirty saves out of.
   std::mutex m_write_mutex;
+  std::mutex m_flush_mutex;
   Common::Flag m_exiting;
   std::thread m_flush_thread;
 };
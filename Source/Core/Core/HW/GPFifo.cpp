@@ -3,6 +3,7 @@
 
 #include "Core/HW/GPFifo.h"
 
+#include <algorithm>
 #include <cstddef>
 #include <cstring>
 
@@ -89,21 +90,33 @@ void GPFifoManager::UpdateGatherPipe()
   auto& processor_interface = system.GetProcessorInterface();
 
   size_t pipe_count = GetGatherPipeCount();
-  size_t processed;
-  for (processed = 0; pipe_count >= GATHER_PIPE_SIZE; processed += GATHER_PIPE_SIZE)
+  size_t processed = 0;
+  while (pipe_count >= GATHER_PIPE_SIZE)
   {
+    // Bursts up to the end of the FIFO are contiguous in memory, so they're copied all at once.
+    const u32 write_pointer = processor_interface.m_fifo_cpu_write_pointer;
+    const u32 end = processor_interface.m_fifo_cpu_end;
+    const bool can_wrap = end >= write_pointer;
+    const size_t bursts_until_wrap = can_wrap ? (end - write_pointer) / GATHER_PIPE_SIZE + 1 : 1;
+    const size_t bursts = std::min(pipe_count / GATHER_PIPE_SIZE, bursts_until_wrap);
+    const size_t size = bursts * GATHER_PIPE_SIZE;
+
     // copy the GatherPipe
-    memory.CopyToEmu(processor_interface.m_fifo_cpu_write_pointer, m_gather_pipe + processed,
-                     GATHER_PIPE_SIZE);
-    pipe_count -= GATHER_PIPE_SIZE;
+    memory.CopyToEmu(write_pointer, m_gather_pipe + processed, size);
+    processed += size;
+    pipe_count -= size;
 
     // increase the CPUWritePointer
-    if (processor_interface.m_fifo_cpu_write_pointer == processor_interface.m_fifo_cpu_end)
+    if (can_wrap && bursts == bursts_until_wrap)
       processor_interface.m_fifo_cpu_write_pointer = processor_interface.m_fifo_cpu_base;
     else
-      processor_interface.m_fifo_cpu_write_pointer += GATHER_PIPE_SIZE;
+      processor_interface.m_fifo_cpu_write_pointer += static_cast<u32>(size);
+  }
 
-    system.GetCommandProcessor().GatherPipeBursted();
+  if (processed != 0)
+  {
+    system.GetCommandProcessor().GatherPipeBursted(
+        static_cast<u32>(processed / GATHER_PIPE_SIZE));
   }
 
   // move back the spill bytes
@@ -189,9 +202,4 @@ void UpdateGatherPipe(GPFifoManager& gpfifo)
 {
   gpfifo.UpdateGatherPipe();
 }
-
-void FastCheckGatherPipe(GPFifoManager& gpfifo)
-{
-  gpfifo.FastCheckGatherPipe();
-}
 }  // namespace GPFifo
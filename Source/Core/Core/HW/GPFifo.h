@@ -21,6 +21,11 @@ constexpr u32 GATHER_PIPE_PHYSICAL_ADDRESS = 0x0C008000;
 constexpr u32 GATHER_PIPE_SIZE = 32;
 constexpr u32 GATHER_PIPE_EXTRA_SIZE = GATHER_PIPE_SIZE * 16;
 
+// The JITs only check the gather pipe once this many bytes have been written to it since the last
+// check in a block, and at the end of the block. That leaves enough room in the extra space for
+// the bytes left over from before the block, even if an exit skipped its check.
+constexpr u32 GATHER_PIPE_JIT_CHECK_SIZE = GATHER_PIPE_SIZE * 4;
+
 class GPFifoManager final
 {
 public:
@@ -64,5 +69,4 @@ private:
 
 // For use from the JIT.
 void UpdateGatherPipe(GPFifoManager& gpfifo);
-void FastCheckGatherPipe(GPFifoManager& gpfifo);
 }  // namespace GPFifo
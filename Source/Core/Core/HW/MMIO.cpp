@@ -4,6 +4,7 @@
 #include "Core/HW/MMIO.h"
 
 #include <functional>
+#include <utility>
 
 #include "Common/Assert.h"
 #include "Common/CommonTypes.h"
@@ -105,86 +106,130 @@ WriteHandlingMethod<T>* DirectWrite(T* addr, u32 mask)
   return new DirectHandlingMethod<T>(addr, mask);
 }
 
-// Complex: holds a lambda that is called when a read or a write is executed.
-// This gives complete control to the user as to what is going to happen during
-// that read or write, but reduces the optimization potential.
+// Complex: holds a function that is called when a read or a write is executed,
+// along with the context it gets passed. This gives complete control to the
+// user as to what is going to happen during that read or write, but reduces
+// the optimization potential.
 template <typename T>
 class ComplexHandlingMethod : public ReadHandlingMethod<T>, public WriteHandlingMethod<T>
 {
 public:
+  ComplexHandlingMethod(ReadFunction<T> read_function, const void* context)
+      : read_function_(read_function), write_function_(UnusedWriteFunction), context_(context)
+  {
+  }
+
+  ComplexHandlingMethod(WriteFunction<T> write_function, const void* context)
+      : read_function_(UnusedReadFunction), write_function_(write_function), context_(context)
+  {
+  }
+
+  // The std::function is kept here, and is what the context points to.
   explicit ComplexHandlingMethod(std::function<T(Core::System&, u32)> read_lambda)
-      : read_lambda_(read_lambda), write_lambda_(InvalidWriteLambda())
+      : ComplexHandlingMethod(CallReadLambda, nullptr)
   {
+    read_lambda_ = std::move(read_lambda);
+    context_ = &read_lambda_;
   }
 
   explicit ComplexHandlingMethod(std::function<void(Core::System&, u32, T)> write_lambda)
-      : read_lambda_(InvalidReadLambda()), write_lambda_(write_lambda)
+      : ComplexHandlingMethod(CallWriteLambda, nullptr)
   {
+    write_lambda_ = std::move(write_lambda);
+    context_ = &write_lambda_;
   }
 
+  ComplexHandlingMethod(const ComplexHandlingMethod&) = delete;
+  ComplexHandlingMethod& operator=(const ComplexHandlingMethod&) = delete;
+
   virtual ~ComplexHandlingMethod() = default;
   void AcceptReadVisitor(ReadHandlingMethodVisitor<T>& v) const override
   {
-    v.VisitComplex(&read_lambda_);
+    v.VisitComplex(read_function_, context_);
   }
 
   void AcceptWriteVisitor(WriteHandlingMethodVisitor<T>& v) const override
   {
-    v.VisitComplex(&write_lambda_);
+    v.VisitComplex(write_function_, context_);
   }
 
 private:
-  std::function<T(Core::System&, u32)> InvalidReadLambda() const
+  static T CallReadLambda(const void* context, Core::System& system, u32 addr)
+  {
+    return (*static_cast<const std::function<T(Core::System&, u32)>*>(context))(system, addr);
+  }
+
+  static void CallWriteLambda(const void* context, Core::System& system, u32 addr, T val)
+  {
+    (*static_cast<const std::function<void(Core::System&, u32, T)>*>(context))(system, addr, val);
+  }
+
+  static T UnusedReadFunction(const void*, Core::System&, u32)
   {
-    return [](Core::System&, u32) {
-      DEBUG_ASSERT_MSG(MEMMAP, 0,
-                       "Called the read lambda on a write "
-                       "complex handler.");
-      return 0;
-    };
+    DEBUG_ASSERT_MSG(MEMMAP, 0,
+                     "Called the read function on a write "
+                     "complex handler.");
+    return 0;
   }
 
-  std::function<void(Core::System&, u32, T)> InvalidWriteLambda() const
+  static void UnusedWriteFunction(const void*, Core::System&, u32, T)
   {
-    return [](Core::System&, u32, T) {
-      DEBUG_ASSERT_MSG(MEMMAP, 0,
-                       "Called the write lambda on a read "
-                       "complex handler.");
-    };
+    DEBUG_ASSERT_MSG(MEMMAP, 0,
+                     "Called the write function on a read "
+                     "complex handler.");
   }
 
+  ReadFunction<T> read_function_;
+  WriteFunction<T> write_function_;
+  const void* context_;
   std::function<T(Core::System&, u32)> read_lambda_;
   std::function<void(Core::System&, u32, T)> write_lambda_;
 };
 template <typename T>
 ReadHandlingMethod<T>* ComplexRead(std::function<T(Core::System&, u32)> lambda)
 {
-  return new ComplexHandlingMethod<T>(lambda);
+  return new ComplexHandlingMethod<T>(std::move(lambda));
 }
 template <typename T>
 WriteHandlingMethod<T>* ComplexWrite(std::function<void(Core::System&, u32, T)> lambda)
 {
-  return new ComplexHandlingMethod<T>(lambda);
+  return new ComplexHandlingMethod<T>(std::move(lambda));
+}
+template <typename T>
+ReadHandlingMethod<T>* ComplexRead(ReadFunction<T> function, const void* context)
+{
+  return new ComplexHandlingMethod<T>(function, context);
+}
+template <typename T>
+WriteHandlingMethod<T>* ComplexWrite(WriteFunction<T> function, const void* context)
+{
+  return new ComplexHandlingMethod<T>(function, context);
 }
 
-// Invalid: specialization of the complex handling type with lambdas that
+// Invalid: specialization of the complex handling type with functions that
 // display error messages.
 template <typename T>
+T InvalidReadFunction(const void*, Core::System&, u32 addr)
+{
+  ERROR_LOG_FMT(MEMMAP, "Trying to read {} bits from an invalid MMIO (addr={:08x})", 8 * sizeof(T),
+                addr);
+  return static_cast<T>(-1);
+}
+template <typename T>
+void InvalidWriteFunction(const void*, Core::System&, u32 addr, T val)
+{
+  ERROR_LOG_FMT(MEMMAP, "Trying to write {} bits to an invalid MMIO (addr={:08x}, val={:08x})",
+                8 * sizeof(T), addr, val);
+}
+template <typename T>
 ReadHandlingMethod<T>* InvalidRead()
 {
-  return ComplexRead<T>([](Core::System&, u32 addr) {
-    ERROR_LOG_FMT(MEMMAP, "Trying to read {} bits from an invalid MMIO (addr={:08x})",
-                  8 * sizeof(T), addr);
-    return -1;
-  });
+  return ComplexRead<T>(InvalidReadFunction<T>, nullptr);
 }
 template <typename T>
 WriteHandlingMethod<T>* InvalidWrite()
 {
-  return ComplexWrite<T>([](Core::System&, u32 addr, T val) {
-    ERROR_LOG_FMT(MEMMAP, "Trying to write {} bits to an invalid MMIO (addr={:08x}, val={:08x})",
-                  8 * sizeof(T), addr, val);
-  });
+  return ComplexWrite<T>(InvalidWriteFunction<T>, nullptr);
 }
 
 // Converters to larger and smaller size. Probably the most complex of these
@@ -220,59 +265,130 @@ struct LargerAccessSize<u16>
   typedef u32 value;
 };
 
+// The size converters are complex handlers whose context is the handling method
+// itself, so that the JITs can call them without going through a std::function.
 template <typename T>
-ReadHandlingMethod<T>* ReadToSmaller(Mapping* mmio, u32 high_part_addr, u32 low_part_addr)
+class ReadToSmallerHandlingMethod : public ReadHandlingMethod<T>
 {
-  typedef typename SmallerAccessSize<T>::value ST;
+public:
+  using ST = typename SmallerAccessSize<T>::value;
 
-  ReadHandler<ST>* high_part = &mmio->GetHandlerForRead<ST>(high_part_addr);
-  ReadHandler<ST>* low_part = &mmio->GetHandlerForRead<ST>(low_part_addr);
+  ReadToSmallerHandlingMethod(Mapping* mmio, u32 high_part_addr, u32 low_part_addr)
+      : high_part_(&mmio->GetHandlerForRead<ST>(high_part_addr)),
+        low_part_(&mmio->GetHandlerForRead<ST>(low_part_addr)), high_part_addr_(high_part_addr),
+        low_part_addr_(low_part_addr)
+  {
+  }
 
-  // TODO(delroth): optimize
-  return ComplexRead<T>([=](Core::System& system, u32 addr) {
-    return ((T)high_part->Read(system, high_part_addr) << (8 * sizeof(ST))) |
-           low_part->Read(system, low_part_addr);
-  });
-}
+  void AcceptReadVisitor(ReadHandlingMethodVisitor<T>& v) const override
+  {
+    v.VisitComplex(Read, this);
+  }
+
+private:
+  static T Read(const void* context, Core::System& system, u32)
+  {
+    const auto* method = static_cast<const ReadToSmallerHandlingMethod*>(context);
+    return (static_cast<T>(method->high_part_->Read(system, method->high_part_addr_))
+            << (8 * sizeof(ST))) |
+           method->low_part_->Read(system, method->low_part_addr_);
+  }
+
+  const ReadHandler<ST>* high_part_;
+  const ReadHandler<ST>* low_part_;
+  u32 high_part_addr_;
+  u32 low_part_addr_;
+};
 
 template <typename T>
-WriteHandlingMethod<T>* WriteToSmaller(Mapping* mmio, u32 high_part_addr, u32 low_part_addr)
+class WriteToSmallerHandlingMethod : public WriteHandlingMethod<T>
 {
-  typedef typename SmallerAccessSize<T>::value ST;
+public:
+  using ST = typename SmallerAccessSize<T>::value;
 
-  WriteHandler<ST>* high_part = &mmio->GetHandlerForWrite<ST>(high_part_addr);
-  WriteHandler<ST>* low_part = &mmio->GetHandlerForWrite<ST>(low_part_addr);
+  WriteToSmallerHandlingMethod(Mapping* mmio, u32 high_part_addr, u32 low_part_addr)
+      : high_part_(&mmio->GetHandlerForWrite<ST>(high_part_addr)),
+        low_part_(&mmio->GetHandlerForWrite<ST>(low_part_addr)), high_part_addr_(high_part_addr),
+        low_part_addr_(low_part_addr)
+  {
+  }
 
-  // TODO(delroth): optimize
-  return ComplexWrite<T>([=](Core::System& system, u32 addr, T val) {
-    high_part->Write(system, high_part_addr, val >> (8 * sizeof(ST)));
-    low_part->Write(system, low_part_addr, (ST)val);
-  });
-}
+  void AcceptWriteVisitor(WriteHandlingMethodVisitor<T>& v) const override
+  {
+    v.VisitComplex(Write, this);
+  }
+
+private:
+  static void Write(const void* context, Core::System& system, u32, T val)
+  {
+    const auto* method = static_cast<const WriteToSmallerHandlingMethod*>(context);
+    method->high_part_->Write(system, method->high_part_addr_, val >> (8 * sizeof(ST)));
+    method->low_part_->Write(system, method->low_part_addr_, static_cast<ST>(val));
+  }
+
+  const WriteHandler<ST>* high_part_;
+  const WriteHandler<ST>* low_part_;
+  u32 high_part_addr_;
+  u32 low_part_addr_;
+};
 
 template <typename T>
-ReadHandlingMethod<T>* ReadToLarger(Mapping* mmio, u32 larger_addr, u32 shift)
+class ReadToLargerHandlingMethod : public ReadHandlingMethod<T>
 {
-  typedef typename LargerAccessSize<T>::value LT;
+public:
+  using LT = typename LargerAccessSize<T>::value;
+
+  ReadToLargerHandlingMethod(Mapping* mmio, u32 larger_addr, u32 shift)
+      : large_(&mmio->GetHandlerForRead<LT>(larger_addr)), shift_(shift)
+  {
+  }
+
+  void AcceptReadVisitor(ReadHandlingMethodVisitor<T>& v) const override
+  {
+    v.VisitComplex(Read, this);
+  }
+
+private:
+  static T Read(const void* context, Core::System& system, u32 addr)
+  {
+    const auto* method = static_cast<const ReadToLargerHandlingMethod*>(context);
+    return static_cast<T>(method->large_->Read(system, addr & ~(sizeof(LT) - 1)) >>
+                          method->shift_);
+  }
 
-  ReadHandler<LT>* large = &mmio->GetHandlerForRead<LT>(larger_addr);
+  const ReadHandler<LT>* large_;
+  u32 shift_;
+};
 
-  // TODO(delroth): optimize
-  return ComplexRead<T>([large, shift](Core::System& system, u32 addr) {
-    return large->Read(system, addr & ~(sizeof(LT) - 1)) >> shift;
-  });
+template <typename T>
+ReadHandlingMethod<T>* ReadToSmaller(Mapping* mmio, u32 high_part_addr, u32 low_part_addr)
+{
+  return new ReadToSmallerHandlingMethod<T>(mmio, high_part_addr, low_part_addr);
+}
+
+template <typename T>
+WriteHandlingMethod<T>* WriteToSmaller(Mapping* mmio, u32 high_part_addr, u32 low_part_addr)
+{
+  return new WriteToSmallerHandlingMethod<T>(mmio, high_part_addr, low_part_addr);
+}
+
+template <typename T>
+ReadHandlingMethod<T>* ReadToLarger(Mapping* mmio, u32 larger_addr, u32 shift)
+{
+  return new ReadToLargerHandlingMethod<T>(mmio, larger_addr, shift);
 }
 
 // Inplementation of the ReadHandler and WriteHandler class. There is a lot of
 // redundant code between these two classes but trying to abstract it away
 // brings more trouble than it fixes.
 template <typename T>
-ReadHandler<T>::ReadHandler()
+ReadHandler<T>::ReadHandler() : m_function(InvalidReadFunction<T>)
 {
 }
 
 template <typename T>
-ReadHandler<T>::ReadHandler(ReadHandlingMethod<T>* method) : m_Method(nullptr)
+ReadHandler<T>::ReadHandler(ReadHandlingMethod<T>* method)
+    : m_Method(nullptr), m_function(InvalidReadFunction<T>)
 {
   ResetMethod(method);
 }
@@ -291,48 +407,41 @@ void ReadHandler<T>::Visit(ReadHandlingMethodVisitor<T>& visitor)
   m_Method->AcceptReadVisitor(visitor);
 }
 
-template <typename T>
-T ReadHandler<T>::Read(Core::System& system, u32 addr)
-{
-  // Check if the handler has already been initialized. For real
-  // handlers, this will always be the case, so this branch should be
-  // easily predictable.
-  if (!m_Method)
-    InitializeInvalid();
-
-  return m_ReadFunc(system, addr);
-}
-
 template <typename T>
 void ReadHandler<T>::ResetMethod(ReadHandlingMethod<T>* method)
 {
   m_Method.reset(method);
 
-  struct FuncCreatorVisitor : public ReadHandlingMethodVisitor<T>
+  struct FlattenVisitor : public ReadHandlingMethodVisitor<T>
   {
-    virtual ~FuncCreatorVisitor() = default;
+    explicit FlattenVisitor(ReadHandler* handler_) : handler(handler_) {}
+    virtual ~FlattenVisitor() = default;
 
-    std::function<T(Core::System&, u32)> ret;
+    ReadHandler* handler;
 
     void VisitConstant(T value) override
     {
-      ret = [value](Core::System&, u32) { return value; };
+      handler->m_constant = value;
+      handler->m_direct = &handler->m_constant;
+      handler->m_mask = 0xFFFFFFFF;
     }
 
     void VisitDirect(const T* addr, u32 mask) override
     {
-      ret = [addr, mask](Core::System&, u32) { return *addr & mask; };
+      handler->m_direct = addr;
+      handler->m_mask = mask;
     }
 
-    void VisitComplex(const std::function<T(Core::System&, u32)>* lambda) override
+    void VisitComplex(ReadFunction<T> function, const void* context) override
     {
-      ret = *lambda;
+      handler->m_direct = nullptr;
+      handler->m_function = function;
+      handler->m_context = context;
     }
   };
 
-  FuncCreatorVisitor v;
+  FlattenVisitor v(this);
   Visit(v);
-  m_ReadFunc = v.ret;
 }
 
 template <typename T>
@@ -342,12 +451,13 @@ void ReadHandler<T>::InitializeInvalid()
 }
 
 template <typename T>
-WriteHandler<T>::WriteHandler()
+WriteHandler<T>::WriteHandler() : m_function(InvalidWriteFunction<T>)
 {
 }
 
 template <typename T>
-WriteHandler<T>::WriteHandler(WriteHandlingMethod<T>* method) : m_Method(nullptr)
+WriteHandler<T>::WriteHandler(WriteHandlingMethod<T>* method)
+    : m_Method(nullptr), m_function(InvalidWriteFunction<T>)
 {
   ResetMethod(method);
 }
@@ -366,48 +476,40 @@ void WriteHandler<T>::Visit(WriteHandlingMethodVisitor<T>& visitor)
   m_Method->AcceptWriteVisitor(visitor);
 }
 
-template <typename T>
-void WriteHandler<T>::Write(Core::System& system, u32 addr, T val)
-{
-  // Check if the handler has already been initialized. For real
-  // handlers, this will always be the case, so this branch should be
-  // easily predictable.
-  if (!m_Method)
-    InitializeInvalid();
-
-  m_WriteFunc(system, addr, val);
-}
-
 template <typename T>
 void WriteHandler<T>::ResetMethod(WriteHandlingMethod<T>* method)
 {
   m_Method.reset(method);
 
-  struct FuncCreatorVisitor : public WriteHandlingMethodVisitor<T>
+  struct FlattenVisitor : public WriteHandlingMethodVisitor<T>
   {
-    virtual ~FuncCreatorVisitor() = default;
+    explicit FlattenVisitor(WriteHandler* handler_) : handler(handler_) {}
+    virtual ~FlattenVisitor() = default;
 
-    std::function<void(Core::System&, u32, T)> ret;
+    WriteHandler* handler;
 
     void VisitNop() override
     {
-      ret = [](Core::System&, u32, T) {};
+      handler->m_direct = nullptr;
+      handler->m_function = [](const void*, Core::System&, u32, T) {};
     }
 
     void VisitDirect(T* ptr, u32 mask) override
     {
-      ret = [ptr, mask](Core::System&, u32, T val) { *ptr = val & mask; };
+      handler->m_direct = ptr;
+      handler->m_mask = mask;
     }
 
-    void VisitComplex(const std::function<void(Core::System&, u32, T)>* lambda) override
+    void VisitComplex(WriteFunction<T> function, const void* context) override
     {
-      ret = *lambda;
+      handler->m_direct = nullptr;
+      handler->m_function = function;
+      handler->m_context = context;
     }
   };
 
-  FuncCreatorVisitor v;
+  FlattenVisitor v(this);
   Visit(v);
-  m_WriteFunc = v.ret;
 }
 
 template <typename T>
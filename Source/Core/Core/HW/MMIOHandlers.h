@@ -5,6 +5,7 @@
 
 #include <functional>
 #include <memory>
+#include <type_traits>
 
 #include "Common/CommonTypes.h"
 
@@ -34,6 +35,13 @@ class ReadHandlingMethod;
 template <typename T>
 class WriteHandlingMethod;
 
+// Complex handlers end up being called through these, with a context pointer that is owned by the
+// handling method. The JITs call them directly from the generated code.
+template <typename T>
+using ReadFunction = T (*)(const void* context, Core::System& system, u32 addr);
+template <typename T>
+using WriteFunction = void (*)(const void* context, Core::System& system, u32 addr, T val);
+
 // Constant: use when the value read on this MMIO is always the same. This is
 // only for reads.
 template <typename T>
@@ -54,10 +62,36 @@ WriteHandlingMethod<T>* DirectWrite(T* addr, u32 mask = 0xFFFFFFFF);
 // Complex: use when no other handling method fits your needs. These allow you
 // to directly provide a function that will be called when a read/write needs
 // to be done.
+//
+// Lambdas without captures get a function of their own, so calling them doesn't go through a
+// std::function.
 template <typename T>
 ReadHandlingMethod<T>* ComplexRead(std::function<T(Core::System&, u32)>);
 template <typename T>
 WriteHandlingMethod<T>* ComplexWrite(std::function<void(Core::System&, u32, T)>);
+template <typename T>
+ReadHandlingMethod<T>* ComplexRead(ReadFunction<T> function, const void* context);
+template <typename T>
+WriteHandlingMethod<T>* ComplexWrite(WriteFunction<T> function, const void* context);
+
+template <typename F>
+concept StatelessHandler = std::is_empty_v<F> && std::is_default_constructible_v<F>;
+
+template <typename T, typename F>
+  requires(StatelessHandler<F> && std::is_invocable_r_v<T, const F&, Core::System&, u32>)
+ReadHandlingMethod<T>* ComplexRead(F)
+{
+  return ComplexRead<T>(
+      [](const void*, Core::System& system, u32 addr) { return static_cast<T>(F{}(system, addr)); },
+      nullptr);
+}
+template <typename T, typename F>
+  requires(StatelessHandler<F> && std::is_invocable_v<const F&, Core::System&, u32, T>)
+WriteHandlingMethod<T>* ComplexWrite(F)
+{
+  return ComplexWrite<T>(
+      [](const void*, Core::System& system, u32 addr, T val) { F{}(system, addr, val); }, nullptr);
+}
 
 // Invalid: log an error and return -1 in case of a read. These are the default
 // handlers set for all MMIO types.
@@ -101,7 +135,7 @@ class ReadHandlingMethodVisitor
 public:
   virtual void VisitConstant(T value) = 0;
   virtual void VisitDirect(const T* addr, u32 mask) = 0;
-  virtual void VisitComplex(const std::function<T(Core::System&, u32)>* lambda) = 0;
+  virtual void VisitComplex(ReadFunction<T> function, const void* context) = 0;
 };
 template <typename T>
 class WriteHandlingMethodVisitor
@@ -109,7 +143,7 @@ class WriteHandlingMethodVisitor
 public:
   virtual void VisitNop() = 0;
   virtual void VisitDirect(T* addr, u32 mask) = 0;
-  virtual void VisitComplex(const std::function<void(Core::System&, u32, T)>* lambda) = 0;
+  virtual void VisitComplex(WriteFunction<T> function, const void* context) = 0;
 };
 
 // These classes are INTERNAL. Do not use outside of the MMIO implementation
@@ -130,7 +164,12 @@ public:
   // Entry point for read handling method visitors.
   void Visit(ReadHandlingMethodVisitor<T>& visitor);
 
-  T Read(Core::System& system, u32 addr);
+  T Read(Core::System& system, u32 addr) const
+  {
+    if (m_direct)
+      return static_cast<T>(*m_direct & m_mask);
+    return m_function(m_context, system, addr);
+  }
 
   // Internal method called when changing the internal method object. Its
   // main role is to make sure the read function is updated at the same time.
@@ -141,7 +180,14 @@ private:
   // useless initialization of thousands of unused handler objects.
   void InitializeInvalid();
   std::unique_ptr<ReadHandlingMethod<T>> m_Method;
-  std::function<T(Core::System&, u32)> m_ReadFunc;
+
+  // Flattened from m_Method, so that reads don't have to go through a virtual call or a
+  // std::function. Constants are read from m_constant like a direct handler.
+  const T* m_direct = nullptr;
+  u32 m_mask = 0xFFFFFFFF;
+  T m_constant = 0;
+  ReadFunction<T> m_function;
+  const void* m_context = nullptr;
 };
 template <typename T>
 class WriteHandler
@@ -157,7 +203,13 @@ public:
   // Entry point for write handling method visitors.
   void Visit(WriteHandlingMethodVisitor<T>& visitor);
 
-  void Write(Core::System& system, u32 addr, T val);
+  void Write(Core::System& system, u32 addr, T val) const
+  {
+    if (m_direct)
+      *m_direct = static_cast<T>(val & m_mask);
+    else
+      m_function(m_context, system, addr, val);
+  }
 
   // Internal method called when changing the internal method object. Its
   // main role is to make sure the write function is updated at the same
@@ -169,7 +221,12 @@ private:
   // useless initialization of thousands of unused handler objects.
   void InitializeInvalid();
   std::unique_ptr<WriteHandlingMethod<T>> m_Method;
-  std::function<void(Core::System&, u32, T)> m_WriteFunc;
+
+  // Flattened from m_Method, see ReadHandler.
+  T* m_direct = nullptr;
+  u32 m_mask = 0xFFFFFFFF;
+  WriteFunction<T> m_function;
+  const void* m_context = nullptr;
 };
 
 // Boilerplate boilerplate boilerplate.
@@ -190,6 +247,8 @@ private:
       std::function<T(Core::System&, u32)>);                                                       \
   MaybeExtern template WriteHandlingMethod<T>* ComplexWrite<T>(                                    \
       std::function<void(Core::System&, u32, T)>);                                                 \
+  MaybeExtern template ReadHandlingMethod<T>* ComplexRead<T>(ReadFunction<T>, const void*);        \
+  MaybeExtern template WriteHandlingMethod<T>* ComplexWrite<T>(WriteFunction<T>, const void*);     \
   MaybeExtern template ReadHandlingMethod<T>* InvalidRead<T>();                                    \
   MaybeExtern template WriteHandlingMethod<T>* InvalidWrite<T>();                                  \
   MaybeExtern template class ReadHandler<T>;                                                       \
@@ -10,15 +10,20 @@
 
 #include <algorithm>
 #include <array>
+#include <bit>
 #include <cstring>
 #include <memory>
+#include <set>
 #include <span>
 #include <tuple>
+#include <utility>
 
+#include "Common/Align.h"
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
 #include "Common/MemArena.h"
+#include "Common/MemoryUtil.h"
 #include "Common/MsgHandler.h"
 #include "Common/Swap.h"
 #include "Core/Config/MainSettings.h"
@@ -109,6 +114,9 @@ void MemoryManager::Init()
   // If MMU is turned off in GameCube mode, turn on fake VMEM hack.
   const bool fake_vmem = !wii && !mmu;
 
+  // A view can only be backed by huge pages if its offset into the segment is aligned to them.
+  const u32 shm_alignment = Common::AreHugePagesEnabled() ? Common::HUGE_PAGE_SIZE : 1;
+
   u32 mem_size = 0;
   for (PhysicalMemoryRegion& region : m_physical_regions)
   {
@@ -117,6 +125,7 @@ void MemoryManager::Init()
     if (!fake_vmem && (region.flags & PhysicalMemoryRegion::FAKE_VMEM))
       continue;
 
+    mem_size = Common::AlignUp(mem_size, shm_alignment);
     region.shm_position = mem_size;
     region.active = true;
     mem_size += region.size;
@@ -152,6 +161,7 @@ void MemoryManager::Init()
   m_logical_page_mappings_base = reinterpret_cast<u8*>(m_logical_page_mappings.data());
 
   InitMMIO(wii);
+  InitWriteTracking(wii);
 
   Clear();
 
@@ -159,6 +169,41 @@ void MemoryManager::Init()
   m_is_initialized = true;
 }
 
+void MemoryManager::InitWriteTracking(bool is_wii)
+{
+  m_write_tracking_enabled = false;
+  m_page_write_stamps.reset();
+  m_watched_pages.clear();
+
+  if (!Config::Get(Config::MAIN_TEXTURE_WRITE_TRACKING))
+    return;
+
+#if defined(__APPLE__) && defined(_M_ARM_64)
+  // Memory protection can't be changed on these hosts (see Common::WriteProtectMemory).
+  WARN_LOG_FMT(MEMMAP, "Texture write tracking is not supported on this host.");
+  return;
+#else
+  const size_t page_size = Common::PageSize();
+  if (!std::has_single_bit(page_size) || page_size > PowerPC::BAT_PAGE_SIZE)
+  {
+    WARN_LOG_FMT(MEMMAP, "Texture write tracking does not support a host page size of {}.",
+                 page_size);
+    return;
+  }
+
+  m_write_tracking_page_shift = static_cast<u32>(std::countr_zero(page_size));
+  m_write_tracking_ram_pages = GetRamSize() >> m_write_tracking_page_shift;
+  const u32 exram_pages = is_wii ? GetExRamSize() >> m_write_tracking_page_shift : 0;
+  const u32 total_pages = m_write_tracking_ram_pages + exram_pages;
+
+  m_page_write_stamps = std::make_unique<std::atomic<u64>[]>(total_pages);
+  m_watched_pages.assign(total_pages, false);
+  m_write_stamp.store(1, std::memory_order_relaxed);
+  m_write_tracking_enabled = true;
+  INFO_LOG_FMT(MEMMAP, "Texture write tracking enabled with {} byte pages.", page_size);
+#endif
+}
+
 bool MemoryManager::IsAddressInFastmemArea(const u8* address) const
 {
   return address >= m_fastmem_arena && address < m_fastmem_arena + m_fastmem_arena_size;
@@ -230,11 +275,17 @@ bool MemoryManager::InitFastmemArena()
 
   m_is_fastmem_arena_initialized = true;
   m_fastmem_arena_size = memory_size;
+  UpdateMemCheckProtection();
   return true;
 }
 
 void MemoryManager::UpdateLogicalMemory(const PowerPC::BatTable& dbat_table)
 {
+  std::unique_lock<std::mutex> watch_lock;
+  if (m_write_tracking_enabled)
+    watch_lock = std::unique_lock(m_write_watch_lock);
+
+  UnmapLogicalPages(0, 0);
   for (auto& entry : m_logical_mapped_entries)
   {
     m_arena.UnmapFromMemoryRegion(entry.mapped_pointer, entry.mapped_size);
@@ -279,7 +330,7 @@ void MemoryManager::UpdateLogicalMemory(const PowerPC::BatTable& dbat_table)
                   intersection_start, mapped_size, logical_address);
               exit(0);
             }
-            m_logical_mapped_entries.push_back({mapped_pointer, mapped_size});
+            m_logical_mapped_entries.push_back({mapped_pointer, mapped_size, intersection_start});
           }
 
           m_logical_page_mappings[i] =
@@ -288,6 +339,107 @@ void MemoryManager::UpdateLogicalMemory(const PowerPC::BatTable& dbat_table)
       }
     }
   }
+
+  // The new views start out writable, so protect the pages which are still being watched.
+  if (m_write_tracking_enabled && !m_logical_mapped_entries.empty())
+  {
+    const u32 page_size = 1U << m_write_tracking_page_shift;
+    for (const auto& entry : m_logical_mapped_entries)
+    {
+      for (u32 offset = 0; offset < entry.mapped_size; offset += page_size)
+      {
+        const std::optional<u32> page = GetWriteTrackingPage(entry.physical_address + offset);
+        if (page && m_watched_pages[*page])
+          Common::WriteProtectMemory(static_cast<u8*>(entry.mapped_pointer) + offset, page_size);
+      }
+    }
+  }
+}
+
+bool MemoryManager::CanMapLogicalPages() const
+{
+#if defined(_WIN32)
+  // Views of the shared memory can't be placed at offsets finer than the allocation granularity.
+  return false;
+#elif defined(__APPLE__) && defined(_M_ARM_64)
+  // Memory protection can't be changed on these hosts (see Common::WriteProtectMemory).
+  return false;
+#else
+  return m_is_fastmem_arena_initialized && Common::PageSize() == PowerPC::HW_PAGE_SIZE;
+#endif
+}
+
+std::optional<bool> MemoryManager::IsLogicalPageWritable(u32 logical_address) const
+{
+  const auto it = m_logical_page_views.find(logical_address & ~PowerPC::HW_PAGE_MASK);
+  if (it == m_logical_page_views.end())
+    return std::nullopt;
+  return it->second;
+}
+
+bool MemoryManager::MapLogicalPage(u32 logical_address, u32 physical_address, bool writable)
+{
+  // Every view is a separate host mapping, so don't let them grow without bounds.
+  constexpr size_t MAX_LOGICAL_PAGE_VIEWS = 8192;
+
+  logical_address &= ~PowerPC::HW_PAGE_MASK;
+  physical_address &= ~PowerPC::HW_PAGE_MASK;
+  u8* const base = m_logical_base + logical_address;
+
+  const auto it = m_logical_page_views.find(logical_address);
+  if (it != m_logical_page_views.end())
+  {
+    // The only change that can be made to an existing view is making it writable.
+    if (!writable || it->second || !Common::UnWriteProtectMemory(base, PowerPC::HW_PAGE_SIZE))
+      return false;
+    it->second = true;
+    return true;
+  }
+
+  if (m_logical_page_views.size() >= MAX_LOGICAL_PAGE_VIEWS)
+    UnmapLogicalPages(0, 0);
+
+  for (const auto& physical_region : m_physical_regions)
+  {
+    if (!physical_region.active || physical_address < physical_region.physical_address ||
+        physical_address - physical_region.physical_address >= physical_region.size)
+    {
+      continue;
+    }
+
+    const u32 position =
+        physical_region.shm_position + physical_address - physical_region.physical_address;
+    void* mapped_pointer = m_arena.MapInMemoryRegion(position, PowerPC::HW_PAGE_SIZE, base);
+    if (!mapped_pointer)
+      return false;
+
+    if (!writable && !Common::WriteProtectMemory(mapped_pointer, PowerPC::HW_PAGE_SIZE))
+    {
+      m_arena.UnmapFromMemoryRegion(mapped_pointer, PowerPC::HW_PAGE_SIZE);
+      return false;
+    }
+
+    m_logical_page_views.emplace(logical_address, writable);
+    return true;
+  }
+
+  return false;
+}
+
+void MemoryManager::UnmapLogicalPages(u32 page_index, u32 page_index_mask)
+{
+  for (auto it = m_logical_page_views.begin(); it != m_logical_page_views.end();)
+  {
+    if (((it->first >> PowerPC::HW_PAGE_INDEX_SHIFT) & page_index_mask) !=
+        (page_index & page_index_mask))
+    {
+      ++it;
+      continue;
+    }
+
+    m_arena.UnmapFromMemoryRegion(m_logical_base + it->first, PowerPC::HW_PAGE_SIZE);
+    it = m_logical_page_views.erase(it);
+  }
 }
 
 void MemoryManager::DoState(PointerWrap& p)
@@ -337,6 +489,9 @@ void MemoryManager::DoState(PointerWrap& p)
   if (current_have_exram)
     p.DoArray(m_exram, current_exram_size);
   p.DoMarker("Memory EXRAM");
+
+  if (p.IsReadMode())
+    MarkAllPagesWritten();
 }
 
 void MemoryManager::Shutdown()
@@ -362,6 +517,18 @@ void MemoryManager::ShutdownFastmemArena()
   if (!m_is_fastmem_arena_initialized)
     return;
 
+  // The protection goes away with the views, so nothing is being watched anymore.
+  if (m_write_tracking_enabled)
+  {
+    std::lock_guard lock(m_write_watch_lock);
+    m_watched_pages.assign(m_watched_pages.size(), false);
+    MarkAllPagesWritten();
+  }
+  {
+    std::lock_guard lock(m_write_watch_lock);
+    m_memcheck_pages.clear();
+  }
+
   for (const PhysicalMemoryRegion& region : m_physical_regions)
   {
     if (!region.active)
@@ -371,6 +538,7 @@ void MemoryManager::ShutdownFastmemArena()
     m_arena.UnmapFromMemoryRegion(base, region.size);
   }
 
+  UnmapLogicalPages(0, 0);
   for (auto& entry : m_logical_mapped_entries)
   {
     m_arena.UnmapFromMemoryRegion(entry.mapped_pointer, entry.mapped_size);
@@ -397,9 +565,19 @@ void MemoryManager::Clear()
     memset(m_fake_vmem, 0, GetFakeVMemSize());
   if (m_exram)
     memset(m_exram, 0, GetExRamSize());
+
+  MarkAllPagesWritten();
 }
 
 u8* MemoryManager::GetPointerForRange(u32 address, size_t size) const
+{
+  u8* pointer = const_cast<u8*>(GetReadOnlyPointerForRange(address, size));
+  if (pointer)
+    MarkRangeWritten(address, size);
+  return pointer;
+}
+
+const u8* MemoryManager::GetReadOnlyPointerForRange(u32 address, size_t size) const
 {
   std::span<u8> span = GetSpanForAddress(address);
 
@@ -425,7 +603,7 @@ void MemoryManager::CopyFromEmu(void* data, u32 address, size_t size) const
   if (size == 0)
     return;
 
-  void* pointer = GetPointerForRange(address, size);
+  const void* pointer = GetReadOnlyPointerForRange(address, size);
   if (!pointer)
   {
     PanicAlertFmt("Invalid range in CopyFromEmu. {:x} bytes from {:#010x}", size, address);
@@ -462,6 +640,251 @@ void MemoryManager::Memset(u32 address, u8 value, size_t size)
   memset(pointer, value, size);
 }
 
+bool MemoryManager::IsWriteTrackingActive() const
+{
+  return m_write_tracking_enabled && !m_cpu_writes_untracked.load(std::memory_order_relaxed);
+}
+
+void MemoryManager::SetCPUWritesUntracked(bool untracked)
+{
+  if (m_write_tracking_enabled && untracked != m_cpu_writes_untracked.exchange(untracked))
+    MarkAllPagesWritten();
+}
+
+std::optional<u32> MemoryManager::GetWriteTrackingPage(u32 address) const
+{
+  address &= 0x3FFFFFFF;
+  if (address < GetRamSizeReal())
+    return address >> m_write_tracking_page_shift;
+
+  if (m_exram && (address >> 28) == 0x1 && (address & 0x0fffffff) < GetExRamSizeReal())
+    return m_write_tracking_ram_pages + ((address & 0x0fffffff) >> m_write_tracking_page_shift);
+
+  return std::nullopt;
+}
+
+void MemoryManager::SetPageWriteProtected(u32 page, bool write_protected)
+{
+  m_watched_pages[page] = write_protected;
+  if (!m_is_fastmem_arena_initialized)
+    return;
+
+  const u32 page_size = 1U << m_write_tracking_page_shift;
+  const auto set_protection = [&](void* pointer) {
+    if (write_protected)
+      Common::WriteProtectMemory(pointer, page_size);
+    else
+      Common::UnWriteProtectMemory(pointer, page_size);
+  };
+
+  const u32 physical_address =
+      page < m_write_tracking_ram_pages ?
+          page << m_write_tracking_page_shift :
+          0x10000000 | ((page - m_write_tracking_ram_pages) << m_write_tracking_page_shift);
+  if (!m_memcheck_pages.contains(physical_address))
+    set_protection(m_physical_base + physical_address);
+
+  for (const auto& entry : m_logical_mapped_entries)
+  {
+    if (physical_address >= entry.physical_address &&
+        physical_address - entry.physical_address < entry.mapped_size)
+    {
+      set_protection(static_cast<u8*>(entry.mapped_pointer) + physical_address -
+                     entry.physical_address);
+    }
+  }
+}
+
+u64 MemoryManager::WatchRange(u32 address, size_t size)
+{
+  if (!IsWriteTrackingActive() || size == 0)
+    return 0;
+
+  const std::optional<u32> first_page = GetWriteTrackingPage(address);
+  const std::optional<u32> last_page = GetWriteTrackingPage(address + static_cast<u32>(size - 1));
+  if (!first_page || !last_page || *last_page < *first_page)
+    return 0;
+
+  // Writes made from now on get a stamp at least as new as the returned one.
+  const u64 stamp = m_write_stamp.fetch_add(1, std::memory_order_relaxed) + 1;
+
+  std::lock_guard lock(m_write_watch_lock);
+  for (u32 page = *first_page; page <= *last_page; ++page)
+  {
+    if (!m_watched_pages[page])
+      SetPageWriteProtected(page, true);
+  }
+
+  return stamp;
+}
+
+bool MemoryManager::WasRangeWrittenSince(u32 address, size_t size, u64 stamp) const
+{
+  if (stamp == 0 || !IsWriteTrackingActive())
+    return true;
+
+  const std::optional<u32> first_page = GetWriteTrackingPage(address);
+  const std::optional<u32> last_page = GetWriteTrackingPage(address + static_cast<u32>(size - 1));
+  if (!first_page || !last_page || *last_page < *first_page)
+    return true;
+
+  for (u32 page = *first_page; page <= *last_page; ++page)
+  {
+    if (m_page_write_stamps[page].load(std::memory_order_relaxed) >= stamp)
+      return true;
+  }
+
+  return false;
+}
+
+void MemoryManager::MarkRangeWritten(u32 address, size_t size) const
+{
+  if (!m_write_tracking_enabled || size == 0)
+    return;
+
+  const std::optional<u32> first_page = GetWriteTrackingPage(address);
+  const std::optional<u32> last_page = GetWriteTrackingPage(address + static_cast<u32>(size - 1));
+  if (!first_page || !last_page || *last_page < *first_page)
+    return;
+
+  const u64 stamp = m_write_stamp.load(std::memory_order_relaxed);
+  for (u32 page = *first_page; page <= *last_page; ++page)
+    m_page_write_stamps[page].store(stamp, std::memory_order_relaxed);
+}
+
+void MemoryManager::MarkAllPagesWritten()
+{
+  if (!m_write_tracking_enabled)
+    return;
+
+  const u64 stamp = m_write_stamp.fetch_add(1, std::memory_order_relaxed) + 1;
+  for (size_t page = 0; page < m_watched_pages.size(); ++page)
+    m_page_write_stamps[page].store(stamp, std::memory_order_relaxed);
+}
+
+bool MemoryManager::HandleWriteWatchFault(uintptr_t fault_address)
+{
+  if (!m_write_tracking_enabled)
+    return false;
+
+  u8* const fault_pointer = reinterpret_cast<u8*>(fault_address);
+  if (!IsAddressInFastmemArea(fault_pointer))
+    return false;
+
+  std::lock_guard lock(m_write_watch_lock);
+
+  std::optional<u32> physical_address;
+  if (fault_pointer >= m_physical_base && fault_pointer < m_physical_base + 0x1'0000'0000)
+  {
+    physical_address = static_cast<u32>(fault_pointer - m_physical_base);
+  }
+  else
+  {
+    for (const auto& entry : m_logical_mapped_entries)
+    {
+      u8* const mapped_pointer = static_cast<u8*>(entry.mapped_pointer);
+      if (fault_pointer >= mapped_pointer && fault_pointer < mapped_pointer + entry.mapped_size)
+      {
+        physical_address =
+            entry.physical_address + static_cast<u32>(fault_pointer - mapped_pointer);
+        break;
+      }
+    }
+  }
+
+  // Faults on the mirrors of RAM can't be caused by the write protection.
+  if (!physical_address || (*physical_address & 0x3FFFFFFF) != *physical_address)
+    return false;
+
+  // Accesses to pages protected for memchecks have to be backpatched instead.
+  const u8* const physical_end = m_physical_base + 0x1'0000'0000;
+  if (fault_pointer >= m_physical_base && fault_pointer < physical_end &&
+      m_memcheck_pages.contains(*physical_address &
+                                ~static_cast<u32>((1U << m_write_tracking_page_shift) - 1)))
+  {
+    return false;
+  }
+
+  const std::optional<u32> page = GetWriteTrackingPage(*physical_address);
+  if (!page || !m_watched_pages[*page])
+    return false;
+
+  // Let the faulting store run again now that the page is writable.
+  SetPageWriteProtected(*page, false);
+  m_page_write_stamps[*page].store(m_write_stamp.load(std::memory_order_relaxed),
+                                   std::memory_order_relaxed);
+  return true;
+}
+
+bool MemoryManager::CanProtectMemCheckPages() const
+{
+#if defined(__APPLE__) && defined(_M_ARM_64)
+  // Memory protection can't be changed on these hosts (see Common::WriteProtectMemory).
+  return false;
+#else
+  return m_is_fastmem_arena_initialized && Common::PageSize() <= PowerPC::BAT_PAGE_SIZE;
+#endif
+}
+
+void MemoryManager::UpdateMemCheckProtection()
+{
+  if (!CanProtectMemCheckPages())
+    return;
+
+  const auto& mem_checks = m_system.GetPowerPC().GetMemChecks();
+  const u32 page_size = static_cast<u32>(Common::PageSize());
+
+  std::set<u32> pages;
+  if (mem_checks.HasAny())
+  {
+    for (const PhysicalMemoryRegion& region : m_physical_regions)
+    {
+      if (!region.active)
+        continue;
+
+      for (u32 offset = 0; offset < region.size; offset += page_size)
+      {
+        if (mem_checks.OverlapsMemcheck(region.physical_address + offset, page_size))
+          pages.insert(region.physical_address + offset);
+      }
+    }
+  }
+
+  std::lock_guard lock(m_write_watch_lock);
+  for (const u32 physical_address : m_memcheck_pages)
+  {
+    if (!pages.contains(physical_address))
+      RestorePhysicalPageProtection(physical_address);
+  }
+  for (const u32 physical_address : pages)
+  {
+    if (!m_memcheck_pages.contains(physical_address))
+      Common::ReadProtectMemory(m_physical_base + physical_address, page_size);
+  }
+
+  if (pages.size() != m_memcheck_pages.size())
+  {
+    DEBUG_LOG_FMT(MEMMAP, "Protecting {} host pages of the physical view for memchecks",
+                  pages.size());
+  }
+  m_memcheck_pages = std::move(pages);
+}
+
+void MemoryManager::RestorePhysicalPageProtection(u32 physical_address)
+{
+  const u32 page_size = static_cast<u32>(Common::PageSize());
+  u8* const pointer = m_physical_base + physical_address;
+
+  std::optional<u32> page;
+  if (m_write_tracking_enabled && (physical_address & 0x3FFFFFFF) == physical_address)
+    page = GetWriteTrackingPage(physical_address);
+
+  if (page && m_watched_pages[*page])
+    Common::WriteProtectMemory(pointer, page_size);
+  else
+    Common::UnWriteProtectMemory(pointer, page_size);
+}
+
 std::string MemoryManager::GetString(u32 em_address, size_t size)
 {
   std::string result;
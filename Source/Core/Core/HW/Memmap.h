@@ -4,7 +4,12 @@
 #pragma once
 
 #include <array>
+#include <atomic>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
 #include <span>
 #include <string>
 #include <vector>
@@ -54,6 +59,7 @@ struct LogicalMemoryView
 {
   void* mapped_pointer;
   u32 mapped_size;
+  u32 physical_address;
 };
 
 class MemoryManager
@@ -101,6 +107,16 @@ public:
 
   void UpdateLogicalMemory(const PowerPC::BatTable& dbat_table);
 
+  // Page table translations are mapped into the logical view one page at a time, when a fastmem
+  // access faults on them (see MMU::MapPageTableTranslation). Pages start out read-only so that
+  // the first store to them still faults and sets the C bit. UpdateLogicalMemory unmaps them all.
+  bool CanMapLogicalPages() const;
+  std::optional<bool> IsLogicalPageWritable(u32 logical_address) const;
+  bool MapLogicalPage(u32 logical_address, u32 physical_address, bool writable);
+  // Unmaps the pages whose page index (logical_address >> 12) matches page_index in the bits set
+  // in page_index_mask.
+  void UnmapLogicalPages(u32 page_index, u32 page_index_mask);
+
   void Clear();
 
   // Routines to access physically addressed memory, designed for use by
@@ -114,7 +130,29 @@ public:
 
   // If the specified range is within a single valid memory region, returns a pointer to the start
   // of the corresponding range in host memory. Otherwise, returns nullptr.
+  // Writes through the returned pointer are assumed, so the range is marked as written.
   u8* GetPointerForRange(u32 address, size_t size) const;
+  // Same as GetPointerForRange, but for callers that only read from the range.
+  const u8* GetReadOnlyPointerForRange(u32 address, size_t size) const;
+
+  // Page-granular tracking of writes to RAM and EXRAM. WatchRange returns a stamp which can later
+  // be passed to WasRangeWrittenSince to find out whether any page of the range has been written
+  // in the meantime; a stamp of 0 means that the range can't be tracked. Pages being watched are
+  // write-protected in the fastmem views so that JIT stores fault into HandleWriteWatchFault.
+  bool IsWriteTrackingEnabled() const { return m_write_tracking_enabled; }
+  bool IsWriteTrackingActive() const;
+  void SetCPUWritesUntracked(bool untracked);
+  u64 WatchRange(u32 address, size_t size);
+  bool WasRangeWrittenSince(u32 address, size_t size, u64 stamp) const;
+  void MarkRangeWritten(u32 address, size_t size) const;
+  bool HandleWriteWatchFault(uintptr_t fault_address);
+
+  // Memchecks are enforced in the physical fastmem view by making the host pages they touch
+  // inaccessible, so that the JIT backpatches the accesses to them into slow accesses which check
+  // the exact range. This lets fastmem stay enabled for the rest of memory when address
+  // translation is off. (With it on, UpdateBATs leaves the watched pages out of the logical view.)
+  bool CanProtectMemCheckPages() const;
+  void UpdateMemCheckProtection();
 
   void CopyFromEmu(void* data, u32 address, size_t size) const;
   void CopyToEmu(u32 address, const void* data, size_t size);
@@ -134,7 +172,7 @@ public:
   template <typename T>
   void CopyFromEmuSwapped(T* data, u32 address, size_t size) const
   {
-    const T* src = reinterpret_cast<T*>(GetPointerForRange(address, size));
+    const T* src = reinterpret_cast<const T*>(GetReadOnlyPointerForRange(address, size));
 
     if (src == nullptr)
       return;
@@ -249,11 +287,35 @@ private:
 
   std::vector<LogicalMemoryView> m_logical_mapped_entries;
 
+  // Pages mapped by MapLogicalPage, by logical address, and whether they are writable.
+  std::map<u32, bool> m_logical_page_views;
+
   std::array<void*, PowerPC::BAT_PAGE_COUNT> m_physical_page_mappings{};
   std::array<void*, PowerPC::BAT_PAGE_COUNT> m_logical_page_mappings{};
 
+  // Write tracking state. The stamps hold the value of m_write_stamp at the time of the last
+  // tracked write of each host page of RAM followed by EXRAM. m_watched_pages holds which pages
+  // are currently write-protected in the fastmem views and is guarded by m_write_watch_lock.
+  bool m_write_tracking_enabled = false;
+  std::atomic<bool> m_cpu_writes_untracked = false;
+  u32 m_write_tracking_page_shift = 0;
+  u32 m_write_tracking_ram_pages = 0;
+  mutable std::atomic<u64> m_write_stamp = 1;
+  std::unique_ptr<std::atomic<u64>[]> m_page_write_stamps;
+  std::vector<bool> m_watched_pages;
+  std::mutex m_write_watch_lock;
+
+  // Host pages of the physical view that are protected for memchecks, by physical address.
+  // Guarded by m_write_watch_lock.
+  std::set<u32> m_memcheck_pages;
+
   Core::System& m_system;
 
   void InitMMIO(bool is_wii);
+  void InitWriteTracking(bool is_wii);
+  std::optional<u32> GetWriteTrackingPage(u32 address) const;
+  void SetPageWriteProtected(u32 page, bool write_protected);
+  void RestorePhysicalPageProtection(u32 physical_address);
+  void MarkAllPagesWritten();
 };
 }  // namespace Memory
@@ -135,6 +135,12 @@ void SerialInterfaceManager::GlobalRunSIBuffer(Core::System& system, u64 user_da
   system.GetSerialInterface().RunSIBuffer(user_data, cycles_late);
 }
 
+void SerialInterfaceManager::PollEventStatsCallback(Core::System& system, u64 user_data,
+                                                    s64 cycles_late)
+{
+  // Only used to attribute UpdateDevices time in the event stats, never scheduled.
+}
+
 void SerialInterfaceManager::RunSIBuffer(u64 user_data, s64 cycles_late)
 {
   if (m_com_csr.TSTART)
@@ -228,6 +234,7 @@ void SerialInterfaceManager::RegisterEvents()
   auto& core_timing = m_system.GetCoreTiming();
   m_event_type_change_device = core_timing.RegisterEvent("ChangeSIDevice", ChangeDeviceCallback);
   m_event_type_tranfer_pending = core_timing.RegisterEvent("SITransferPending", GlobalRunSIBuffer);
+  m_event_type_poll = core_timing.RegisterEvent("SIPoll", PollEventStatsCallback);
 
   constexpr std::array<CoreTiming::TimedCallback, MAX_SI_CHANNELS> event_callbacks = {
       DeviceEventCallback<0>,
@@ -531,6 +538,21 @@ void SerialInterfaceManager::ChangeDeviceDeterministic(SIDevices device, int cha
 }
 
 void SerialInterfaceManager::UpdateDevices()
+{
+  auto& core_timing = m_system.GetCoreTiming();
+  if (!core_timing.AreEventStatsEnabled())
+  {
+    PollDevices();
+    return;
+  }
+
+  // Polls run from the VI event, count them separately so that input cost can be told apart.
+  const TimePoint start = Clock::now();
+  PollDevices();
+  core_timing.RecordNestedEventStats(m_event_type_poll, Clock::now() - start);
+}
+
+void SerialInterfaceManager::PollDevices()
 {
   // Check for device change requests:
   for (int i = 0; i != MAX_SI_CHANNELS; ++i)
@@ -553,15 +575,16 @@ void SerialInterfaceManager::UpdateDevices()
   g_controller_interface.SetCurrentInputChannel(ciface::InputChannel::SerialInterface);
   g_controller_interface.UpdateInput();
 
-  // Update channels and set the status bit if there's new data
-  m_status_reg.RDST0 =
-      !!m_channel[0].device->GetData(m_channel[0].in_hi.hex, m_channel[0].in_lo.hex);
-  m_status_reg.RDST1 =
-      !!m_channel[1].device->GetData(m_channel[1].in_hi.hex, m_channel[1].in_lo.hex);
-  m_status_reg.RDST2 =
-      !!m_channel[2].device->GetData(m_channel[2].in_hi.hex, m_channel[2].in_lo.hex);
-  m_status_reg.RDST3 =
-      !!m_channel[3].device->GetData(m_channel[3].in_hi.hex, m_channel[3].in_lo.hex);
+  // Update channels and set the status bit if there's new data. All of them read the input
+  // state updated above.
+  std::array<bool, MAX_SI_CHANNELS> new_data{};
+  for (int i = 0; i != MAX_SI_CHANNELS; ++i)
+    new_data[i] = m_channel[i].device->GetData(m_channel[i].in_hi.hex, m_channel[i].in_lo.hex);
+
+  m_status_reg.RDST0 = new_data[0];
+  m_status_reg.RDST1 = new_data[1];
+  m_status_reg.RDST2 = new_data[2];
+  m_status_reg.RDST3 = new_data[3];
 
   UpdateInterrupts();
 
@@ -85,6 +85,8 @@ private:
   void RunSIBuffer(u64 user_data, s64 cycles_late);
   static void GlobalRunSIBuffer(Core::System& system, u64 user_data, s64 cycles_late);
   static void ChangeDeviceCallback(Core::System& system, u64 user_data, s64 cycles_late);
+  static void PollEventStatsCallback(Core::System& system, u64 user_data, s64 cycles_late);
+  void PollDevices();
   template <int device_number>
   static void DeviceEventCallback(Core::System& system, u64 userdata, s64 cyclesLate);
 
@@ -230,6 +232,7 @@ private:
 
   CoreTiming::EventType* m_event_type_change_device = nullptr;
   CoreTiming::EventType* m_event_type_tranfer_pending = nullptr;
+  CoreTiming::EventType* m_event_type_poll = nullptr;
   std::array<CoreTiming::EventType*, MAX_SI_CHANNELS> m_event_types_device{};
 
   // User-configured device type. possibly overridden by TAS/Netplay
@@ -6,41 +6,46 @@
 #include "Core/HW/StreamADPCM.h"
 
 #include <algorithm>
+#include <array>
 
 #include "Common/ChunkFile.h"
+#include "Common/Swap.h"
 #include "Common/CommonTypes.h"
 
 namespace StreamADPCM
 {
-static s16 ADPDecodeSample(s32 bits, s32 q, s32& hist1, s32& hist2)
+// The filter and scale only change per block, so they're looked up once instead of per sample.
+// Each channel only depends on its own history, the two channels are decoded in separate passes.
+template <bool swap_output>
+static void DecodeChannel(s16* pcm, const u8* adpcm, u32 nibble_shift, u8 q, s32& hist1,
+                          s32& hist2)
 {
-  s32 hist = 0;
-  switch (q >> 4)
-  {
-  case 0:
-    hist = 0;
-    break;
-  case 1:
-    hist = (hist1 * 0x3c);
-    break;
-  case 2:
-    hist = (hist1 * 0x73) - (hist2 * 0x34);
-    break;
-  case 3:
-    hist = (hist1 * 0x62) - (hist2 * 0x37);
-    break;
-  }
-  hist = std::clamp((hist + 0x20) >> 6, -0x200000, 0x1fffff);
-
-  s32 cur = (((s16)(bits << 12) >> (q & 0xf)) << 6) + hist;
+  static constexpr std::array<std::array<s32, 2>, 4> coefficients = {{
+      {0, 0},
+      {0x3c, 0},
+      {0x73, -0x34},
+      {0x62, -0x37},
+  }};
+  const s32 coef1 = coefficients[q >> 4][0];
+  const s32 coef2 = coefficients[q >> 4][1];
+  const u32 scale = q & 0xf;
 
-  hist2 = hist1;
-  hist1 = cur;
+  s32 h1 = hist1;
+  s32 h2 = hist2;
+  for (int i = 0; i < SAMPLES_PER_BLOCK; i++)
+  {
+    const s32 bits = adpcm[i + (ONE_BLOCK_SIZE - SAMPLES_PER_BLOCK)] >> nibble_shift;
+    const s32 hist = std::clamp((h1 * coef1 + h2 * coef2 + 0x20) >> 6, -0x200000, 0x1fffff);
+    const s32 cur = ((static_cast<s16>(bits << 12) >> scale) << 6) + hist;
 
-  cur >>= 6;
-  cur = std::clamp(cur, -0x8000, 0x7fff);
+    h2 = h1;
+    h1 = cur;
 
-  return (s16)cur;
+    const s16 sample = static_cast<s16>(std::clamp(cur >> 6, -0x8000, 0x7fff));
+    pcm[i * 2] = swap_output ? static_cast<s16>(Common::swap16(sample)) : sample;
+  }
+  hist1 = h1;
+  hist2 = h2;
 }
 
 void ADPCMDecoder::ResetFilter()
@@ -61,12 +66,18 @@ void ADPCMDecoder::DoState(PointerWrap& p)
 
 void ADPCMDecoder::DecodeBlock(s16* pcm, const u8* adpcm)
 {
-  for (int i = 0; i < SAMPLES_PER_BLOCK; i++)
+  DecodeChannel<false>(pcm, adpcm, 0, adpcm[0], m_histl1, m_histl2);
+  DecodeChannel<false>(pcm + 1, adpcm, 4, adpcm[1], m_histr1, m_histr2);
+}
+
+void ADPCMDecoder::DecodeBlocksBigEndian(s16* pcm, const u8* adpcm, size_t num_blocks)
+{
+  for (size_t i = 0; i < num_blocks; i++)
   {
-    pcm[i * 2] = ADPDecodeSample(adpcm[i + (ONE_BLOCK_SIZE - SAMPLES_PER_BLOCK)] & 0xf, adpcm[0],
-                                 m_histl1, m_histl2);
-    pcm[i * 2 + 1] = ADPDecodeSample(adpcm[i + (ONE_BLOCK_SIZE - SAMPLES_PER_BLOCK)] >> 4, adpcm[1],
-                                     m_histr1, m_histr2);
+    DecodeChannel<true>(pcm, adpcm, 0, adpcm[0], m_histl1, m_histl2);
+    DecodeChannel<true>(pcm + 1, adpcm, 4, adpcm[1], m_histr1, m_histr2);
+    pcm += SAMPLES_PER_BLOCK * 2;
+    adpcm += ONE_BLOCK_SIZE;
   }
 }
 }  // namespace StreamADPCM
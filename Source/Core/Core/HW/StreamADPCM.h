@@ -5,6 +5,8 @@
 
 #pragma once
 
+#include <cstddef>
+
 #include "Common/CommonTypes.h"
 
 class PointerWrap;
@@ -23,6 +25,8 @@ public:
   void ResetFilter();
   void DoState(PointerWrap& p);
   void DecodeBlock(s16* pcm, const u8* adpcm);
+  // Decodes consecutive blocks into byte-swapped samples, as the mixer's streaming FIFO takes them.
+  void DecodeBlocksBigEndian(s16* pcm, const u8* adpcm, size_t num_blocks);
 
 private:
   s32 m_histl1 = 0;
@@ -69,18 +69,20 @@ IOCtlVRequest::IOCtlVRequest(Core::System& system, const u32 address_) : Request
   const u32 out_number = memory.Read_U32(address + 0x14);
   const u32 vectors_base = memory.Read_U32(address + 0x18);  // address to vectors
 
-  u32 offset = 0;
-  for (size_t i = 0; i < (in_number + out_number); ++i)
+  if (in_number > MAX_VECTORS || out_number > MAX_VECTORS)
   {
-    IOVector vector;
-    vector.address = memory.Read_U32(vectors_base + offset);
-    vector.size = memory.Read_U32(vectors_base + offset + 4);
-    offset += 8;
-    if (i < in_number)
-      in_vectors.emplace_back(vector);
-    else
-      io_vectors.emplace_back(vector);
+    ERROR_LOG_FMT(IOS, "IOCtlV {:#x} has {} in and {} io vectors, only using the first {}",
+                  request, in_number, out_number, MAX_VECTORS);
   }
+
+  const auto read_vector = [&memory, vectors_base](u32 i) {
+    const u32 vector_address = vectors_base + i * 8;
+    return IOVector{memory.Read_U32(vector_address), memory.Read_U32(vector_address + 4)};
+  };
+  for (u32 i = 0; i < std::min<u32>(in_number, MAX_VECTORS); ++i)
+    in_vectors.push_back(read_vector(i));
+  for (u32 i = 0; i < std::min<u32>(out_number, MAX_VECTORS); ++i)
+    io_vectors.push_back(read_vector(in_number + i));
 }
 
 const IOCtlVRequest::IOVector* IOCtlVRequest::GetVector(size_t index) const
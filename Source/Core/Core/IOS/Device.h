@@ -11,6 +11,7 @@
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
+#include "Common/SmallVector.h"
 #include "Core/IOS/IOS.h"
 
 namespace Core
@@ -160,8 +161,11 @@ struct IOCtlVRequest final : Request
   // they're also used as input buffers.
   // So both of them are technically IO vectors. But we're keeping them separated because
   // merging them into a single std::vector would make using the first out vector more complicated.
-  std::vector<IOVector> in_vectors;
-  std::vector<IOVector> io_vectors;
+  // They are stored inline so that decoding a request doesn't allocate. No module uses more than
+  // a handful; vectors beyond the limit are dropped.
+  static constexpr size_t MAX_VECTORS = 32;
+  Common::SmallVector<IOVector, MAX_VECTORS> in_vectors;
+  Common::SmallVector<IOVector, MAX_VECTORS> io_vectors;
 
   /// Returns the specified vector or nullptr if the index is out of bounds.
   const IOVector* GetVector(size_t index) const;
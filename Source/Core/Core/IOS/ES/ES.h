@@ -5,7 +5,9 @@
 
 #include <array>
 #include <map>
+#include <optional>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "Common/CommonTypes.h"
@@ -216,8 +218,32 @@ private:
     u32 m_uid = 0;
   };
 
+  // Parsed copies of the NAND files that title queries read over and over (the System Menu reads
+  // every TMD and ticket several times when listing channels). Everything is dropped as soon as
+  // the file system has changed, which includes titles being installed or deleted. Lookups that
+  // are served from the cache still charge the ticks that reading the files took.
+  struct NandCache
+  {
+    struct CachedTMD
+    {
+      ES::TMDReader tmd;
+      u64 ticks = 0;
+    };
+
+    u64 fs_modification_count = 0;
+    std::map<u64, CachedTMD> installed_tmds;
+    std::map<std::pair<u64, std::optional<u8>>, ES::TicketReader> tickets;
+    std::optional<std::vector<u64>> installed_titles;
+    std::optional<std::vector<u64>> titles_with_tickets;
+    std::optional<ES::SharedContentMap> shared_content_map;
+  };
+  NandCache& GetNandCache() const;
+  const ES::SharedContentMap& GetCachedSharedContentMap() const;
+
   Kernel& m_ios;
 
+  mutable NandCache m_nand_cache;
+
   using ContentTable = std::array<OpenedContent, 16>;
   ContentTable m_content_table;
 
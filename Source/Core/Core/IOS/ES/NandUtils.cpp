@@ -46,14 +46,25 @@ ES::TMDReader ESCore::FindImportTMD(u64 title_id, Ticks ticks) const
 
 ES::TMDReader ESCore::FindInstalledTMD(u64 title_id, Ticks ticks) const
 {
-  return FindTMD(m_ios.GetFSCore(), Common::GetTMDFileName(title_id), ticks);
+  NandCache& cache = GetNandCache();
+  auto it = cache.installed_tmds.find(title_id);
+  if (it == cache.installed_tmds.end())
+  {
+    u64 read_ticks = 0;
+    ES::TMDReader tmd = FindTMD(m_ios.GetFSCore(), Common::GetTMDFileName(title_id), &read_ticks);
+    it = cache.installed_tmds.emplace(title_id, NandCache::CachedTMD{std::move(tmd), read_ticks})
+             .first;
+  }
+  ticks.Add(it->second.ticks);
+  return it->second.tmd;
 }
 
-ES::TicketReader ESCore::FindSignedTicket(u64 title_id, std::optional<u8> desired_version) const
+static ES::TicketReader ReadSignedTicket(FS::FileSystem* fs, u64 title_id,
+                                         std::optional<u8> desired_version)
 {
   std::string path = desired_version == 1 ? Common::GetV1TicketFileName(title_id) :
                                             Common::GetTicketFileName(title_id);
-  auto ticket_file = m_ios.GetFS()->OpenFile(PID_KERNEL, PID_KERNEL, path, FS::Mode::Read);
+  auto ticket_file = fs->OpenFile(PID_KERNEL, PID_KERNEL, path, FS::Mode::Read);
   if (!ticket_file)
   {
     if (desired_version)
@@ -62,7 +73,7 @@ ES::TicketReader ESCore::FindSignedTicket(u64 title_id, std::optional<u8> desire
 
     // Check if we are dealing with a v1 ticket
     path = Common::GetV1TicketFileName(title_id);
-    ticket_file = m_ios.GetFS()->OpenFile(PID_KERNEL, PID_KERNEL, path, FS::Mode::Read);
+    ticket_file = fs->OpenFile(PID_KERNEL, PID_KERNEL, path, FS::Mode::Read);
 
     if (!ticket_file)
       return {};
@@ -75,6 +86,19 @@ ES::TicketReader ESCore::FindSignedTicket(u64 title_id, std::optional<u8> desire
   return ES::TicketReader{std::move(signed_ticket)};
 }
 
+ES::TicketReader ESCore::FindSignedTicket(u64 title_id, std::optional<u8> desired_version) const
+{
+  NandCache& cache = GetNandCache();
+  const auto key = std::make_pair(title_id, desired_version);
+  auto it = cache.tickets.find(key);
+  if (it == cache.tickets.end())
+  {
+    ES::TicketReader ticket = ReadSignedTicket(m_ios.GetFS().get(), title_id, desired_version);
+    it = cache.tickets.emplace(key, std::move(ticket)).first;
+  }
+  return it->second;
+}
+
 static bool IsValidPartOfTitleID(const std::string& string)
 {
   if (string.length() != 8)
@@ -127,7 +151,10 @@ static std::vector<u64> GetTitlesInTitleOrImport(FS::FileSystem* fs, const std::
 
 std::vector<u64> ESCore::GetInstalledTitles() const
 {
-  return GetTitlesInTitleOrImport(m_ios.GetFS().get(), "/title");
+  NandCache& cache = GetNandCache();
+  if (!cache.installed_titles)
+    cache.installed_titles = GetTitlesInTitleOrImport(m_ios.GetFS().get(), "/title");
+  return *cache.installed_titles;
 }
 
 std::vector<u64> ESCore::GetTitleImports() const
@@ -135,9 +162,8 @@ std::vector<u64> ESCore::GetTitleImports() const
   return GetTitlesInTitleOrImport(m_ios.GetFS().get(), "/import");
 }
 
-std::vector<u64> ESCore::GetTitlesWithTickets() const
+static std::vector<u64> GetTitlesInTicketDirectory(FS::FileSystem* fs)
 {
-  const auto fs = m_ios.GetFS();
   const auto entries = fs->ReadDirectory(PID_KERNEL, PID_KERNEL, "/ticket");
   if (!entries)
   {
@@ -178,6 +204,14 @@ std::vector<u64> ESCore::GetTitlesWithTickets() const
   return title_ids;
 }
 
+std::vector<u64> ESCore::GetTitlesWithTickets() const
+{
+  NandCache& cache = GetNandCache();
+  if (!cache.titles_with_tickets)
+    cache.titles_with_tickets = GetTitlesInTicketDirectory(m_ios.GetFS().get());
+  return *cache.titles_with_tickets;
+}
+
 std::vector<ES::Content>
 ESCore::GetStoredContentsFromTMD(const ES::TMDReader& tmd,
                                  CheckContentHashes check_content_hashes) const
@@ -228,8 +262,30 @@ u32 ESCore::GetSharedContentsCount() const
 
 std::vector<std::array<u8, 20>> ESCore::GetSharedContents() const
 {
-  const ES::SharedContentMap map{m_ios.GetFSCore()};
-  return map.GetHashes();
+  return GetCachedSharedContentMap().GetHashes();
+}
+
+ESCore::NandCache& ESCore::GetNandCache() const
+{
+  const u64 modification_count = m_ios.GetFS()->GetModificationCount();
+  if (modification_count != m_nand_cache.fs_modification_count)
+  {
+    m_nand_cache.fs_modification_count = modification_count;
+    m_nand_cache.installed_tmds.clear();
+    m_nand_cache.tickets.clear();
+    m_nand_cache.installed_titles.reset();
+    m_nand_cache.titles_with_tickets.reset();
+    m_nand_cache.shared_content_map.reset();
+  }
+  return m_nand_cache;
+}
+
+const ES::SharedContentMap& ESCore::GetCachedSharedContentMap() const
+{
+  NandCache& cache = GetNandCache();
+  if (!cache.shared_content_map)
+    cache.shared_content_map.emplace(m_ios.GetFSCore());
+  return *cache.shared_content_map;
 }
 
 static bool DeleteDirectoriesIfEmpty(FS::FileSystem* fs, const std::string& path)
@@ -397,7 +453,7 @@ std::string ESCore::GetContentPath(const u64 title_id, const ES::Content& conten
 {
   if (content.IsShared())
   {
-    ES::SharedContentMap content_map{m_ios.GetFSCore()};
+    const ES::SharedContentMap& content_map = GetCachedSharedContentMap();
     ticks.Add(content_map.GetTicks());
     return content_map.GetFilenameFromSHA1(content.sha1).value_or("");
   }
@@ -374,11 +374,6 @@ IPCReply ESDevice::ImportContentData(Context& context, const IOCtlVRequest& requ
   return IPCReply(m_core.ImportContentData(context, content_fd, data_start, data_size));
 }
 
-static bool CheckIfContentHashMatches(const std::vector<u8>& content, const ES::Content& info)
-{
-  return Common::SHA1::CalculateDigest(content.data(), info.size) == info.sha1;
-}
-
 static std::string GetImportContentPath(u64 title_id, u32 content_id)
 {
   return fmt::format("{}/content/{:08x}.app", Common::GetImportTitlePath(title_id), content_id);
@@ -391,18 +386,29 @@ ReturnCode ESCore::ImportContentEnd(Context& context, u32 content_fd)
   if (!context.title_import_export.valid || !context.title_import_export.content.valid)
     return ES_EINVAL;
 
-  std::vector<u8> decrypted_data(context.title_import_export.content.buffer.size());
-  const ReturnCode decrypt_ret = m_ios.GetIOSC().Decrypt(
-      context.title_import_export.key_handle, context.title_import_export.content.iv.data(),
-      context.title_import_export.content.buffer.data(),
-      context.title_import_export.content.buffer.size(), decrypted_data.data(), PID_ES);
-  if (decrypt_ret != IPC_SUCCESS)
-    return decrypt_ret;
-
   ES::Content content_info;
   context.title_import_export.tmd.FindContentById(context.title_import_export.content.id,
                                                   &content_info);
-  if (!CheckIfContentHashMatches(decrypted_data, content_info))
+
+  // The content is decrypted in place, and each chunk is hashed right after it has been decrypted
+  // while it's still in cache, rather than making a decrypted copy of the whole content.
+  std::vector<u8>& data = context.title_import_export.content.buffer;
+  constexpr size_t CHUNK_SIZE = 0x100000;
+  const auto sha1 = Common::SHA1::CreateContext();
+  for (size_t offset = 0; offset < data.size(); offset += CHUNK_SIZE)
+  {
+    const size_t size = std::min(CHUNK_SIZE, data.size() - offset);
+    const ReturnCode decrypt_ret = m_ios.GetIOSC().Decrypt(
+        context.title_import_export.key_handle, context.title_import_export.content.iv.data(),
+        data.data() + offset, size, data.data() + offset, PID_ES);
+    if (decrypt_ret != IPC_SUCCESS)
+      return decrypt_ret;
+
+    if (offset < content_info.size)
+      sha1->Update(data.data() + offset, std::min<u64>(size, content_info.size - offset));
+  }
+
+  if (data.size() < content_info.size || sha1->Finish() != content_info.sha1)
   {
     ERROR_LOG_FMT(IOS_ES, "ImportContentEnd: Hash for content {:08x} doesn't match",
                   content_info.id);
@@ -428,7 +434,7 @@ ReturnCode ESCore::ImportContentEnd(Context& context, u32 content_fd)
   {
     constexpr FS::Modes content_modes{FS::Mode::ReadWrite, FS::Mode::ReadWrite, FS::Mode::None};
     const auto file = fs->CreateAndOpenFile(PID_KERNEL, PID_KERNEL, temp_path, content_modes);
-    if (!file || !file->Write(decrypted_data.data(), content_info.size))
+    if (!file || !file->Write(data.data(), content_info.size))
     {
       ERROR_LOG_FMT(IOS_ES, "ImportContentEnd: Failed to write to {}", temp_path);
       return ES_EIO;
@@ -291,6 +291,10 @@ public:
   virtual Result<ExtendedDirectoryStats> GetExtendedDirectoryStats(const std::string& path) = 0;
 
   virtual void SetNandRedirects(std::vector<NandRedirect> nand_redirects) = 0;
+
+  /// Changes whenever the contents of the file system may have changed, so that callers which keep
+  /// data derived from files can tell when it is stale.
+  virtual u64 GetModificationCount() const = 0;
 };
 
 template <typename T>
@@ -153,9 +153,21 @@ HostFileSystem::HostFileSystem(const std::string& root_path,
   File::CreateFullPath(m_root_path + '/');
   ResetFst();
   LoadFst();
+
+  m_write_thread.Reset("IOS FS Writer", [](PendingWrite write) {
+    write.file->Seek(write.offset, File::SeekOrigin::Begin);
+    if (!write.file->WriteBytes(write.data.data(), write.data.size()))
+    {
+      ERROR_LOG_FMT(IOS_FS, "Failed to write {} bytes at offset {}", write.data.size(),
+                    write.offset);
+    }
+  });
 }
 
-HostFileSystem::~HostFileSystem() = default;
+HostFileSystem::~HostFileSystem()
+{
+  FlushPendingWrites();
+}
 
 std::string HostFileSystem::GetFstFilePath() const
 {
@@ -270,6 +282,8 @@ HostFileSystem::FstEntry* HostFileSystem::GetFstEntryForPath(const std::string&
       entry = &entry->children.emplace_back();
       entry->name = component;
       entry->data.modes = {Mode::ReadWrite, Mode::ReadWrite, Mode::ReadWrite};
+      // The new entry changes where this file is sorted in its parent's listing.
+      m_directory_listing_cache.erase(SplitPathAndBasename(complete_path).parent);
     }
   }
 
@@ -283,6 +297,40 @@ HostFileSystem::FstEntry* HostFileSystem::GetFstEntryForPath(const std::string&
   return entry;
 }
 
+void HostFileSystem::InvalidateDirectoryCaches(const std::string& wii_path, bool listing_changed)
+{
+  ++m_modification_count;
+
+  const auto erase_path_and_children = [&wii_path](auto& cache) {
+    const std::string prefix = wii_path + '/';
+    auto it = cache.lower_bound(wii_path);
+    while (it != cache.end() && (it->first == wii_path || it->first.starts_with(prefix)))
+      it = cache.erase(it);
+  };
+
+  // Stats include everything below a directory, so every parent is affected.
+  erase_path_and_children(m_directory_stats_cache);
+  std::string parent = wii_path;
+  while (parent != "/")
+  {
+    parent = SplitPathAndBasename(parent).parent;
+    m_directory_stats_cache.erase(parent);
+  }
+
+  if (listing_changed)
+  {
+    erase_path_and_children(m_directory_listing_cache);
+    m_directory_listing_cache.erase(SplitPathAndBasename(wii_path).parent);
+  }
+}
+
+void HostFileSystem::ClearDirectoryCaches()
+{
+  ++m_modification_count;
+  m_directory_listing_cache.clear();
+  m_directory_stats_cache.clear();
+}
+
 void HostFileSystem::DoStateRead(PointerWrap& p, std::string start_directory_path)
 {
   std::string path = BuildFilename(start_directory_path).host_path;
@@ -373,10 +421,15 @@ void HostFileSystem::DoStateWriteOrMeasure(PointerWrap& p, std::string start_dir
 
 void HostFileSystem::DoState(PointerWrap& p)
 {
+  FlushPendingWrites();
+
   // Temporarily close the file, to prevent any issues with the savestating of files/folders.
   for (Handle& handle : m_handles)
     handle.host_file.reset();
 
+  if (p.IsReadMode())
+    ClearDirectoryCaches();
+
   // The format for the next part of the save state is follows:
   // 1. bool Movie::WasMovieActiveWhenStateSaved() &&
   // WiiRoot::WasWiiRootTemporaryDirectoryWhenStateSaved()
@@ -449,6 +502,8 @@ ResultCode HostFileSystem::Format(Uid uid)
   if (m_root_path.empty())
     return ResultCode::AccessDenied;
   const std::string root = BuildFilename("/").host_path;
+  FlushPendingWrites();
+  ClearDirectoryCaches();
   if (!File::DeleteDirRecursively(root) || !File::CreateDir(root))
     return ResultCode::UnknownError;
   ResetFst();
@@ -484,6 +539,7 @@ ResultCode HostFileSystem::CreateFileOrDirectory(Uid uid, Gid gid, const std::st
     return ResultCode::AlreadyExists;
 
   const bool ok = is_file ? File::CreateEmptyFile(host_path) : File::CreateDir(host_path);
+  InvalidateDirectoryCaches(path, true);
   if (!ok)
   {
     ERROR_LOG_FMT(IOS_FS, "Failed to create file or directory: {}", host_path);
@@ -552,6 +608,7 @@ ResultCode HostFileSystem::Delete(Uid uid, Gid gid, const std::string& path)
     File::DeleteDirRecursively(host_path);
   else
     return ResultCode::InUse;
+  InvalidateDirectoryCaches(path, true);
 
   const auto it = std::find_if(parent->children.begin(), parent->children.end(),
                                GetNamePredicate(split_path.file_name));
@@ -596,6 +653,9 @@ ResultCode HostFileSystem::Rename(Uid uid, Gid gid, const std::string& old_path,
     return ResultCode::InUse;
   }
 
+  InvalidateDirectoryCaches(old_path, true);
+  InvalidateDirectoryCaches(new_path, true);
+
   const auto host_old_info = BuildFilename(old_path);
   const auto host_new_info = BuildFilename(new_path);
   const std::string& host_old_path = host_old_info.host_path;
@@ -674,6 +734,9 @@ Result<std::vector<std::string>> HostFileSystem::ReadDirectory(Uid uid, Gid gid,
   if (entry->data.is_file)
     return ResultCode::Invalid;
 
+  if (const auto it = m_directory_listing_cache.find(path); it != m_directory_listing_cache.end())
+    return it->second;
+
   const std::string host_path = BuildFilename(path).host_path;
   File::FSTEntry host_entry = File::ScanDirectoryTree(host_path, false);
   FixupDirectoryEntries(&host_entry, path == "/");
@@ -709,6 +772,7 @@ Result<std::vector<std::string>> HostFileSystem::ReadDirectory(Uid uid, Gid gid,
   std::vector<std::string> output;
   for (const File::FSTEntry& child : host_entry.children)
     output.emplace_back(child.virtualName);
+  m_directory_listing_cache.emplace(path, output);
   return output;
 }
 
@@ -736,6 +800,7 @@ Result<Metadata> HostFileSystem::GetMetadata(Uid uid, Gid gid, const std::string
   if (!entry)
     return ResultCode::NotFound;
 
+  FlushPendingWrites();
   Metadata metadata = entry->data;
   metadata.size = File::GetSize(BuildFilename(path).host_path);
   return metadata;
@@ -756,6 +821,7 @@ ResultCode HostFileSystem::SetMetadata(Uid caller_uid, const std::string& path,
   if (caller_uid != 0 && uid != entry->data.uid)
     return ResultCode::AccessDenied;
 
+  FlushPendingWrites();
   const bool is_empty = File::GetSize(BuildFilename(path).host_path) == 0;
   if (entry->data.uid != uid && entry->data.is_file && !is_empty)
     return ResultCode::FileNotEmpty;
@@ -822,6 +888,10 @@ HostFileSystem::GetExtendedDirectoryStats(const std::string& wii_path)
   if (!IsValidPath(wii_path))
     return ResultCode::Invalid;
 
+  if (const auto it = m_directory_stats_cache.find(wii_path); it != m_directory_stats_cache.end())
+    return it->second;
+
+  FlushPendingWrites();
   ExtendedDirectoryStats stats{};
   std::string path(BuildFilename(wii_path).host_path);
   File::FileInfo info(path);
@@ -842,11 +912,13 @@ HostFileSystem::GetExtendedDirectoryStats(const std::string& wii_path)
   {
     return ResultCode::Invalid;
   }
+  m_directory_stats_cache.emplace(wii_path, stats);
   return stats;
 }
 
 void HostFileSystem::SetNandRedirects(std::vector<NandRedirect> nand_redirects)
 {
   m_nand_redirects = std::move(nand_redirects);
+  ClearDirectoryCaches();
 }
 }  // namespace IOS::HLE::FS
@@ -11,6 +11,7 @@
 
 #include "Common/CommonTypes.h"
 #include "Common/IOFile.h"
+#include "Common/WorkQueueThread.h"
 #include "Core/IOS/FS/FileSystem.h"
 
 namespace IOS::HLE::FS
@@ -59,6 +60,8 @@ public:
 
   void SetNandRedirects(std::vector<NandRedirect> nand_redirects) override;
 
+  u64 GetModificationCount() const override { return m_modification_count; }
+
 private:
   void DoStateWriteOrMeasure(PointerWrap& p, std::string start_directory_path);
   void DoStateRead(PointerWrap& p, std::string start_directory_path);
@@ -88,6 +91,16 @@ private:
   Handle* GetHandleFromFd(Fd fd);
   Fd ConvertHandleToFd(const Handle* handle) const;
 
+  struct PendingWrite
+  {
+    std::shared_ptr<File::IOFile> file;
+    u32 offset = 0;
+    std::vector<u8> data;
+  };
+  u64 GetHostFileSize(const Handle& handle) const;
+  /// Blocks until all queued host writes have been done.
+  void FlushPendingWrites();
+
   struct HostFilename
   {
     std::string host_path;
@@ -110,6 +123,10 @@ private:
   /// Returns nullptr if the path is invalid or the file does not exist.
   FstEntry* GetFstEntryForPath(const std::string& path);
 
+  /// Drops the cached listings and stats that a change to the given path can affect.
+  void InvalidateDirectoryCaches(const std::string& wii_path, bool listing_changed);
+  void ClearDirectoryCaches();
+
   /// FST entry for the filesystem root.
   ///
   /// Note that unlike a real Wii's FST, ours is the single source of truth only for
@@ -125,6 +142,23 @@ private:
 
   FstEntry m_redirect_fst{};
   std::vector<NandRedirect> m_nand_redirects;
+
+  /// Directory listings and stats, keyed by Wii path. Scanning the host directories is slow and
+  /// some titles query them in tight loops, so they're cached and invalidated by our own writes.
+  /// Changes made to the NAND folder from outside of Dolphin while emulation is running will
+  /// not be seen until the cache is cleared.
+  std::map<std::string, std::vector<std::string>, std::less<>> m_directory_listing_cache;
+  std::map<std::string, ExtendedDirectoryStats, std::less<>> m_directory_stats_cache;
+  /// Incremented along with every cache invalidation.
+  u64 m_modification_count = 0;
+
+  /// Host writes are done on a worker thread so that large savegame writes don't stall the CPU
+  /// thread. Files that have writes queued are listed with the size they will have once the
+  /// writes are done. Anything that looks at their contents or size on the host must call
+  /// FlushPendingWrites first.
+  std::map<const File::IOFile*, u64> m_pending_write_sizes;
+  size_t m_pending_write_bytes = 0;
+  Common::WorkQueueThread<PendingWrite> m_write_thread;
 };
 
 }  // namespace IOS::HLE::FS
@@ -13,6 +13,8 @@
 
 namespace IOS::HLE::FS
 {
+constexpr size_t MAX_PENDING_WRITE_BYTES = 16 * 1024 * 1024;
+
 // This isn't theadsafe, but it's only called from the CPU thread.
 std::shared_ptr<File::IOFile> HostFileSystem::OpenHostFile(const std::string& host_path)
 {
@@ -106,6 +108,10 @@ ResultCode HostFileSystem::Close(Fd fd)
   if (!handle)
     return ResultCode::Invalid;
 
+  // The writer thread must not be the one to drop the last reference.
+  if (m_pending_write_sizes.contains(handle->host_file.get()))
+    FlushPendingWrites();
+
   // Let go of our pointer to the file, it will automatically close if we are the last handle
   // accessing it.
   *handle = Handle{};
@@ -121,6 +127,9 @@ Result<u32> HostFileSystem::ReadBytesFromFile(Fd fd, u8* ptr, u32 count)
   if ((u8(handle->mode) & u8(Mode::Read)) == 0)
     return ResultCode::AccessDenied;
 
+  if (m_pending_write_sizes.contains(handle->host_file.get()))
+    FlushPendingWrites();
+
   const u32 file_size = static_cast<u32>(handle->host_file->GetSize());
   // IOS has this check in the read request handler.
   if (count + handle->file_offset > file_size)
@@ -148,10 +157,18 @@ Result<u32> HostFileSystem::WriteBytesToFile(Fd fd, const u8* ptr, u32 count)
   if ((u8(handle->mode) & u8(Mode::Write)) == 0)
     return ResultCode::AccessDenied;
 
-  // File might be opened twice, need to seek before we read
-  handle->host_file->Seek(handle->file_offset, File::SeekOrigin::Begin);
-  if (!handle->host_file->WriteBytes(ptr, count))
-    return ResultCode::AccessDenied;
+  // The write is done by the writer thread. Errors can't be reported to the title anymore, but
+  // they are logged, and IOS only fails writes here when the NAND is full or broken anyway.
+  const u64 new_size = std::max<u64>(GetHostFileSize(*handle), handle->file_offset + count);
+  m_pending_write_sizes[handle->host_file.get()] = new_size;
+  m_write_thread.Push(PendingWrite{handle->host_file, handle->file_offset,
+                                   std::vector<u8>(ptr, ptr + count)});
+  InvalidateDirectoryCaches(handle->wii_path, false);
+
+  // Don't let a title that writes faster than the host can keep up queue up unbounded memory.
+  m_pending_write_bytes += count;
+  if (m_pending_write_bytes >= MAX_PENDING_WRITE_BYTES)
+    FlushPendingWrites();
 
   handle->file_offset += count;
   return count;
@@ -173,14 +190,14 @@ Result<u32> HostFileSystem::SeekFile(Fd fd, std::uint32_t offset, SeekMode mode)
     new_position = handle->file_offset + offset;
     break;
   case SeekMode::End:
-    new_position = handle->host_file->GetSize() + offset;
+    new_position = GetHostFileSize(*handle) + offset;
     break;
   default:
     return ResultCode::Invalid;
   }
 
   // This differs from POSIX behaviour which allows seeking past the end of the file.
-  if (handle->host_file->GetSize() < new_position)
+  if (GetHostFileSize(*handle) < new_position)
     return ResultCode::Invalid;
 
   handle->file_offset = new_position;
@@ -194,11 +211,30 @@ Result<FileStatus> HostFileSystem::GetFileStatus(Fd fd)
     return ResultCode::Invalid;
 
   FileStatus status;
-  status.size = handle->host_file->GetSize();
+  status.size = GetHostFileSize(*handle);
   status.offset = handle->file_offset;
   return status;
 }
 
+u64 HostFileSystem::GetHostFileSize(const Handle& handle) const
+{
+  // Querying the size of a file that the writer thread is using would race with it.
+  const auto it = m_pending_write_sizes.find(handle.host_file.get());
+  if (it != m_pending_write_sizes.end())
+    return it->second;
+  return handle.host_file->GetSize();
+}
+
+void HostFileSystem::FlushPendingWrites()
+{
+  if (m_pending_write_sizes.empty())
+    return;
+
+  m_write_thread.WaitForCompletion();
+  m_pending_write_sizes.clear();
+  m_pending_write_bytes = 0;
+}
+
 HostFileSystem::Handle* HostFileSystem::AssignFreeHandle()
 {
   const auto it = std::find_if(m_handles.begin(), m_handles.end(),
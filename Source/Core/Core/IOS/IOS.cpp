@@ -974,6 +974,9 @@ void Init(Core::System& system)
   DIDevice::s_finish_executing_di_command =
       core_timing.RegisterEvent("FinishDICommand", DIDevice::FinishDICommandCallback);
 
+  WiiSockMan::s_sockets_ready_event =
+      core_timing.RegisterEvent("IOSNetSocketsReady", WiiSockMan::SocketsReadyCallback);
+
   // Start with IOS80 to simulate part of the Wii boot process.
   system.SetIOS(std::make_unique<EmulationKernel>(system, Titles::SYSTEM_MENU_IOS));
   // On a Wii, boot2 launches the system menu IOS, which then launches the system menu
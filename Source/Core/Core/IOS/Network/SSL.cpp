@@ -5,7 +5,10 @@
 
 #include <array>
 #include <cstring>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <utility>
 #include <vector>
 
 #include <mbedtls/md.h>
@@ -86,8 +89,61 @@ int SSLRecv(void* ctx, unsigned char* buf, size_t len)
 
   return ret;
 }
+
+class SSLSessionCache
+{
+public:
+  ~SSLSessionCache()
+  {
+    for (auto& [key, session] : m_sessions)
+      mbedtls_ssl_session_free(&session);
+  }
+
+  void Store(const WII_SSL& ssl)
+  {
+    std::lock_guard lk(m_lock);
+    mbedtls_ssl_session& session = m_sessions[GetKey(ssl)];
+    mbedtls_ssl_session_free(&session);
+    if (mbedtls_ssl_get_session(&ssl.ctx, &session) != 0)
+    {
+      mbedtls_ssl_session_free(&session);
+      m_sessions.erase(GetKey(ssl));
+    }
+  }
+
+  void Restore(WII_SSL& ssl)
+  {
+    std::lock_guard lk(m_lock);
+    const auto it = m_sessions.find(GetKey(ssl));
+    if (it != m_sessions.end() && mbedtls_ssl_set_session(&ssl.ctx, &it->second) == 0)
+      INFO_LOG_FMT(IOS_SSL, "Resuming SSL session with {}", ssl.hostname);
+  }
+
+private:
+  // A session that was established without verifying the certificate must not be reused by a
+  // connection that would have verified it.
+  static std::pair<std::string, int> GetKey(const WII_SSL& ssl)
+  {
+    return {ssl.hostname, ssl.config.authmode};
+  }
+
+  std::mutex m_lock;
+  std::map<std::pair<std::string, int>, mbedtls_ssl_session> m_sessions;
+};
+
+SSLSessionCache s_session_cache;
 }  // namespace
 
+void NetSSLDevice::StoreSession(const WII_SSL& ssl)
+{
+  s_session_cache.Store(ssl);
+}
+
+void NetSSLDevice::RestoreSession(WII_SSL& ssl)
+{
+  s_session_cache.Restore(ssl);
+}
+
 NetSSLDevice::NetSSLDevice(EmulationKernel& ios, const std::string& device_name)
     : EmulationDevice(ios, device_name)
 {
@@ -99,6 +155,9 @@ NetSSLDevice::NetSSLDevice(EmulationKernel& ios, const std::string& device_name)
 
 NetSSLDevice::~NetSSLDevice()
 {
+  if (const auto socket_manager = GetEmulationKernel().GetSocketManager())
+    socket_manager->WaitForSSLJobs();
+
   // Cleanup sessions
   for (WII_SSL& ssl : _SSL)
   {
@@ -236,6 +295,13 @@ std::optional<IPCReply> NetSSLDevice::IOCtlV(const IOCtlVRequest& request)
   auto& system = Core::System::GetInstance();
   auto& memory = system.GetMemory();
 
+  // Handshakes, reads and writes run on the SSL workers, everything else uses the contexts here.
+  if (request.request != IOCTLV_NET_SSL_DOHANDSHAKE && request.request != IOCTLV_NET_SSL_READ &&
+      request.request != IOCTLV_NET_SSL_WRITE)
+  {
+    GetEmulationKernel().GetSocketManager()->WaitForSSLJobs();
+  }
+
   switch (request.request)
   {
   case IOCTLV_NET_SSL_NEW:
@@ -271,7 +337,6 @@ std::optional<IPCReply> NetSSLDevice::IOCtlV(const IOCtlVRequest& request)
       mbedtls_ssl_conf_max_version(&ssl->config, MBEDTLS_SSL_MAJOR_VERSION_3,
                                    MBEDTLS_SSL_MINOR_VERSION_2);
       mbedtls_ssl_conf_cert_profile(&ssl->config, &mbedtls_x509_crt_profile_wii);
-      mbedtls_ssl_set_session(&ssl->ctx, &ssl->session);
 
       if (Config::Get(Config::MAIN_NETWORK_SSL_VERIFY_CERTIFICATES) && verifyOption)
         mbedtls_ssl_conf_authmode(&ssl->config, MBEDTLS_SSL_VERIFY_REQUIRED);
@@ -501,6 +566,7 @@ std::optional<IPCReply> NetSSLDevice::IOCtlV(const IOCtlVRequest& request)
       ssl->hostfd = GetEmulationKernel().GetSocketManager()->GetHostSocket(ssl->sockfd);
       INFO_LOG_FMT(IOS_SSL, "IOCTLV_NET_SSL_CONNECT socket = {}", ssl->sockfd);
       mbedtls_ssl_set_bio(&ssl->ctx, ssl, SSLSendWithoutSNI, SSLRecv, nullptr);
+      RestoreSession(*ssl);
       WriteReturnValue(memory, SSL_OK, BufferIn);
     }
     else
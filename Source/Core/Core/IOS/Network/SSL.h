@@ -91,6 +91,11 @@ public:
 
   int GetSSLFreeID() const;
 
+  // Sessions are remembered per host so that reconnecting can resume them instead of doing a full
+  // handshake again. StoreSession may be called from the SSL workers.
+  static void StoreSession(const WII_SSL& ssl);
+  static void RestoreSession(WII_SSL& ssl);
+
   static WII_SSL _SSL[NET_SSL_MAXINSTANCES];
 
 private:
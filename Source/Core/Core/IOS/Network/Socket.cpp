@@ -7,6 +7,7 @@
 #include <algorithm>
 #include <numeric>
 
+#include <fmt/format.h>
 #include <mbedtls/error.h>
 #ifndef _WIN32
 #include <arpa/inet.h>
@@ -21,8 +22,10 @@
 #include "Common/IOFile.h"
 #include "Common/Network.h"
 #include "Common/ScopeGuard.h"
+#include "Common/Thread.h"
 #include "Core/Config/MainSettings.h"
 #include "Core/Core.h"
+#include "Core/CoreTiming.h"
 #include "Core/IOS/Device.h"
 #include "Core/IOS/IOS.h"
 #include "Core/PowerPC/PowerPC.h"
@@ -88,9 +91,24 @@ static s32 TranslateErrorCode(s32 native_error, bool is_rw)
 
 WiiSockMan::WiiSockMan(EmulationKernel& ios) : m_ios(ios)
 {
+  for (size_t i = 0; i < m_ssl_workers.size(); ++i)
+  {
+    m_ssl_workers[i].Reset(fmt::format("IOS SSL {}", i),
+                           [this](std::shared_ptr<SSLJob> job) { RunSSLJob(*job); });
+  }
 }
 
-WiiSockMan::~WiiSockMan() = default;
+WiiSockMan::~WiiSockMan()
+{
+  for (auto& worker : m_ssl_workers)
+    worker.Shutdown();
+
+  if (m_poll_thread_running.TestAndClear())
+  {
+    m_poll_interest_event.Set();
+    m_poll_thread.join();
+  }
+}
 
 // Don't use string! (see https://github.com/dolphin-emu/dolphin/pull/3143)
 s32 WiiSockMan::GetNetErrorCode(s32 ret, std::string_view caller, bool is_rw)
@@ -261,7 +279,44 @@ s32 WiiSocket::FCntl(u32 cmd, u32 arg)
   return ret;
 }
 
-void WiiSocket::Update(bool read, bool write, bool except)
+s16 WiiSocket::GetPendingEvents() const
+{
+  s16 events = 0;
+  for (const sockop& op : pending_sockops)
+  {
+    if (op.is_ssl)
+    {
+      // The SSL worker does the host I/O of operations it is running.
+      if (op.ssl_job)
+        continue;
+      if (op.ssl_type == IOCTLV_NET_SSL_READ)
+        events |= POLLIN;
+      else if (op.ssl_type == IOCTLV_NET_SSL_WRITE)
+        events |= POLLOUT;
+      else
+        events |= POLLIN | POLLOUT;
+      continue;
+    }
+
+    switch (op.net_type)
+    {
+    case IOCTL_SO_ACCEPT:
+    case IOCTLV_SO_RECVFROM:
+      events |= POLLIN;
+      break;
+    case IOCTL_SO_CONNECT:
+    case IOCTLV_SO_SENDTO:
+      events |= POLLOUT;
+      break;
+    default:
+      events |= POLLIN | POLLOUT;
+      break;
+    }
+  }
+  return events;
+}
+
+void WiiSocket::Update()
 {
   auto& system = m_socket_manager.m_ios.GetSystem();
   auto& memory = system.GetMemory();
@@ -271,6 +326,7 @@ void WiiSocket::Update(bool read, bool write, bool except)
   {
     s32 ReturnValue = 0;
     bool forceNonBlock = false;
+    bool ssl_job_pending = false;
     IPCCommandType ct = it->request.command;
     if (!it->is_ssl && ct == IPC_CMD_IOCTL)
     {
@@ -408,29 +464,31 @@ void WiiSocket::Update(bool read, bool write, bool except)
             // The Wii allows a socket with an in-progress connection to
             // perform the SSL handshake. MbedTLS doesn't support it so
             // we have to check it manually.
-            connecting_state = GetConnectingState();
-            if (connecting_state == ConnectingState::Connecting)
+            if (!it->ssl_job)
             {
-              WriteReturnValue(memory, SSL_ERR_RAGAIN, BufferIn);
-              ReturnValue = SSL_ERR_RAGAIN;
-              break;
-            }
-            else if (connecting_state == ConnectingState::None ||
-                     connecting_state == ConnectingState::Error)
-            {
-              WriteReturnValue(memory, SSL_ERR_SYSCALL, BufferIn);
-              ReturnValue = SSL_ERR_SYSCALL;
-              break;
+              connecting_state = GetConnectingState();
+              if (connecting_state == ConnectingState::Connecting)
+              {
+                WriteReturnValue(memory, SSL_ERR_RAGAIN, BufferIn);
+                ReturnValue = SSL_ERR_RAGAIN;
+                break;
+              }
+              else if (connecting_state == ConnectingState::None ||
+                       connecting_state == ConnectingState::Error)
+              {
+                WriteReturnValue(memory, SSL_ERR_SYSCALL, BufferIn);
+                ReturnValue = SSL_ERR_SYSCALL;
+                break;
+              }
             }
 
-            mbedtls_ssl_context* ctx = &NetSSLDevice::_SSL[sslID].ctx;
-            const int ret = mbedtls_ssl_handshake(ctx);
-            if (ret != 0)
+            if (StartSSLJob(*it, sslID, nullptr, 0, 0))
             {
-              char error_buffer[256] = "";
-              mbedtls_strerror(ret, error_buffer, sizeof(error_buffer));
-              ERROR_LOG_FMT(IOS_SSL, "IOCTLV_NET_SSL_DOHANDSHAKE: {}", error_buffer);
+              ssl_job_pending = true;
+              break;
             }
+            const std::shared_ptr<SSLJob> job = std::move(it->ssl_job);
+            const int ret = job->result;
             switch (ret)
             {
             case 0:
@@ -449,8 +507,9 @@ void WiiSocket::Update(bool read, bool write, bool except)
             case MBEDTLS_ERR_X509_CERT_VERIFY_FAILED:
             {
               char error_buffer[256] = "";
-              int res = mbedtls_ssl_get_verify_result(ctx);
-              mbedtls_x509_crt_verify_info(error_buffer, sizeof(error_buffer), "", res);
+              int res = static_cast<int>(job->verify_result);
+              mbedtls_x509_crt_verify_info(error_buffer, sizeof(error_buffer), "",
+                                           job->verify_result);
               ERROR_LOG_FMT(IOS_SSL, "MBEDTLS_ERR_X509_CERT_VERIFY_FAILED (verify_result = {}): {}",
                             res, error_buffer);
 
@@ -475,21 +534,6 @@ void WiiSocket::Update(bool read, bool write, bool except)
               break;
             }
 
-            // mbedtls_ssl_get_peer_cert(ctx) seems not to work if handshake failed
-            // Below is an alternative to dump the peer certificate
-            if (Config::Get(Config::MAIN_NETWORK_SSL_DUMP_PEER_CERT) &&
-                ctx->session_negotiate != nullptr)
-            {
-              const mbedtls_x509_crt* cert = ctx->session_negotiate->peer_cert;
-              if (cert != nullptr)
-              {
-                std::string filename = File::GetUserPath(D_DUMPSSL_IDX) +
-                                       ((ctx->hostname != nullptr) ? ctx->hostname : "") +
-                                       "_peercert.der";
-                File::IOFile(filename, "wb").WriteBytes(cert->raw.p, cert->raw.len);
-              }
-            }
-
             INFO_LOG_FMT(IOS_SSL,
                          "IOCTLV_NET_SSL_DOHANDSHAKE = ({}) "
                          "BufferIn: ({:08x}, {}), BufferIn2: ({:08x}, {}), "
@@ -500,14 +544,20 @@ void WiiSocket::Update(bool read, bool write, bool except)
           }
           case IOCTLV_NET_SSL_WRITE:
           {
-            WII_SSL* ssl = &NetSSLDevice::_SSL[sslID];
-            const int ret = mbedtls_ssl_write(
-                &ssl->ctx, memory.GetPointerForRange(BufferOut2, BufferOutSize2), BufferOutSize2);
+            if (StartSSLJob(*it, sslID, memory.GetPointerForRange(BufferOut2, BufferOutSize2),
+                            BufferOutSize2, 0))
+            {
+              ssl_job_pending = true;
+              break;
+            }
+            const std::shared_ptr<SSLJob> job = std::move(it->ssl_job);
+            const int ret = job->result;
 
             if (ret >= 0)
             {
+              WII_SSL* ssl = &NetSSLDevice::_SSL[sslID];
               system.GetPowerPC().GetDebugInterface().NetworkLogger()->LogSSLWrite(
-                  memory.GetPointerForRange(BufferOut2, ret), ret, ssl->hostfd);
+                  job->data.data(), ret, ssl->hostfd);
               // Return bytes written or SSL_ERR_ZERO if none
               WriteReturnValue(memory, (ret == 0) ? SSL_ERR_ZERO : ret, BufferIn);
             }
@@ -534,14 +584,20 @@ void WiiSocket::Update(bool read, bool write, bool except)
           }
           case IOCTLV_NET_SSL_READ:
           {
-            WII_SSL* ssl = &NetSSLDevice::_SSL[sslID];
-            const int ret = mbedtls_ssl_read(
-                &ssl->ctx, memory.GetPointerForRange(BufferIn2, BufferInSize2), BufferInSize2);
+            if (StartSSLJob(*it, sslID, nullptr, 0, BufferInSize2))
+            {
+              ssl_job_pending = true;
+              break;
+            }
+            const std::shared_ptr<SSLJob> job = std::move(it->ssl_job);
+            const int ret = job->result;
 
             if (ret >= 0)
             {
+              WII_SSL* ssl = &NetSSLDevice::_SSL[sslID];
+              memory.CopyToEmu(BufferIn2, job->data.data(), ret);
               system.GetPowerPC().GetDebugInterface().NetworkLogger()->LogSSLRead(
-                  memory.GetPointerForRange(BufferIn2, ret), ret, ssl->hostfd);
+                  job->data.data(), ret, ssl->hostfd);
               // Return bytes read or SSL_ERR_ZERO if none
               WriteReturnValue(memory, (ret == 0) ? SSL_ERR_ZERO : ret, BufferIn);
             }
@@ -711,6 +767,12 @@ void WiiSocket::Update(bool read, bool write, bool except)
       continue;
     }
 
+    if (ssl_job_pending)
+    {
+      ++it;
+      continue;
+    }
+
     if (nonBlock || forceNonBlock ||
         (!it->is_ssl && ReturnValue != -SO_EAGAIN && ReturnValue != -SO_EINPROGRESS &&
          ReturnValue != -SO_EALREADY) ||
@@ -731,6 +793,30 @@ void WiiSocket::Update(bool read, bool write, bool except)
   }
 }
 
+bool WiiSocket::StartSSLJob(sockop& op, int ssl_id, const u8* write_data, u32 write_size,
+                            u32 read_size)
+{
+  if (op.ssl_job)
+    return !op.ssl_job->done.IsSet();
+
+  op.ssl_job = std::make_shared<SSLJob>();
+  op.ssl_job->type = op.ssl_type;
+  op.ssl_job->ssl_id = ssl_id;
+  if (write_data)
+    op.ssl_job->data.assign(write_data, write_data + write_size);
+  else
+    op.ssl_job->data.resize(read_size);
+  m_socket_manager.m_ssl_workers[ssl_id].Push(op.ssl_job);
+  return true;
+}
+
+bool WiiSocket::HasFinishedSSLJob() const
+{
+  return std::ranges::any_of(pending_sockops, [](const sockop& op) {
+    return op.ssl_job && op.ssl_job->done.IsSet();
+  });
+}
+
 void WiiSocket::UpdateConnectingState(s32 connect_rv)
 {
   if (connect_rv == -SO_EAGAIN || connect_rv == -SO_EALREADY || connect_rv == -SO_EINPROGRESS)
@@ -994,55 +1080,214 @@ void WiiSockMan::EnqueueIPCReply(const Request& request, s32 return_value) const
   m_ios.EnqueueIPCReply(request, return_value);
 }
 
+CoreTiming::EventType* WiiSockMan::s_sockets_ready_event;
+
+void WiiSockMan::SocketsReadyCallback(Core::System& system, u64 userdata, s64 cycles_late)
+{
+  auto* ios = system.GetIOS();
+  if (!ios)
+    return;
+
+  const auto socket_manager = ios->GetSocketManager();
+  if (socket_manager)
+  {
+    socket_manager->m_sockets_ready_scheduled.Clear();
+    socket_manager->UpdateSockets(true);
+  }
+}
+
 void WiiSockMan::Update()
 {
-  s32 nfds = 0;
-  fd_set read_fds, write_fds, except_fds;
-  struct timeval t = {0, 0};
-  FD_ZERO(&read_fds);
-  FD_ZERO(&write_fds);
-  FD_ZERO(&except_fds);
+  UpdateSockets(false);
+}
+
+void WiiSockMan::UpdateSockets(bool ready_only)
+{
+  std::vector<s32> ready_fds;
+  s32 ready_fd;
+  while (m_ready_sockets.Pop(ready_fd))
+    ready_fds.push_back(ready_fd);
 
   auto socket_iter = WiiSockets.begin();
-  auto end_socks = WiiSockets.end();
+  while (socket_iter != WiiSockets.end())
+  {
+    WiiSocket& sock = socket_iter->second;
+    if (!sock.IsValid())
+    {
+      // Good time to clean up invalid sockets.
+      socket_iter = WiiSockets.erase(socket_iter);
+      continue;
+    }
 
-  while (socket_iter != end_socks)
+    // Operations are retried on every periodic update, just like before the poll thread existed.
+    // Sockets that became ready get an extra update right away.
+    if (!sock.pending_sockops.empty() &&
+        (!ready_only || std::ranges::find(ready_fds, sock.fd) != ready_fds.end() ||
+         sock.HasFinishedSSLJob()))
+    {
+      sock.Update();
+    }
+    ++socket_iter;
+  }
+  UpdatePollCommands();
+  PublishPollInterest();
+}
+
+void WiiSockMan::PublishPollInterest()
+{
+  std::vector<pollfd_t> interest;
+  for (const auto& [wii_fd, sock] : WiiSockets)
   {
-    const WiiSocket& sock = socket_iter->second;
-    if (sock.IsValid())
+    if (sock.IsValid() && !sock.pending_sockops.empty())
     {
-      FD_SET(sock.fd, &read_fds);
-      FD_SET(sock.fd, &write_fds);
-      FD_SET(sock.fd, &except_fds);
-      nfds = std::max(nfds, sock.fd + 1);
-      ++socket_iter;
+      pollfd_t pfd{};
+      pfd.fd = sock.fd;
+      pfd.events = sock.GetPendingEvents();
+      interest.push_back(pfd);
     }
-    else
+  }
+  for (const PollCommand& pcmd : pending_polls)
+  {
+    for (const pollfd_t& pfd : pcmd.wii_fds)
     {
-      // Good time to clean up invalid sockets.
-      socket_iter = WiiSockets.erase(socket_iter);
+      if (pfd.fd >= 0 && pfd.events != 0)
+        interest.push_back(pfd);
     }
   }
 
-  const s32 ret = select(nfds, &read_fds, &write_fds, &except_fds, &t);
+  const auto same_pollfd = [](const pollfd_t& a, const pollfd_t& b) {
+    return a.fd == b.fd && a.events == b.events;
+  };
+  const bool changed = !std::ranges::equal(interest, m_last_poll_interest, same_pollfd);
+  if (!changed && !m_poll_rearm_needed.TestAndClear())
+    return;
 
-  if (ret >= 0)
+  if (!interest.empty() && !m_poll_thread_running.IsSet() && !Core::WantsDeterminism())
   {
-    for (auto& pair : WiiSockets)
+    m_poll_thread_running.Set();
+    m_poll_thread = std::thread(&WiiSockMan::PollThread, this);
+  }
+
+  m_last_poll_interest = interest;
+  {
+    std::lock_guard lk(m_poll_interest_lock);
+    m_poll_interest = std::move(interest);
+    m_poll_interest_changed = true;
+  }
+  m_poll_interest_event.Set();
+}
+
+void WiiSockMan::PollThread()
+{
+  Common::SetCurrentThreadName("IOS Socket Poll");
+
+  // Short enough that changes to the interest set are picked up quickly without a wakeup socket.
+  constexpr int POLL_TIMEOUT_MS = 10;
+
+  std::vector<pollfd_t> pfds;
+  while (m_poll_thread_running.IsSet())
+  {
+    {
+      std::lock_guard lk(m_poll_interest_lock);
+      if (m_poll_interest_changed)
+      {
+        pfds = m_poll_interest;
+        m_poll_interest_changed = false;
+      }
+    }
+
+    if (pfds.empty())
+    {
+      m_poll_interest_event.Wait();
+      continue;
+    }
+
+    const int ret = poll(pfds.data(), static_cast<u32>(pfds.size()), POLL_TIMEOUT_MS);
+    if (ret == 0)
+      continue;
+
+    // An error most likely means that a socket was closed in the meantime, the CPU thread will
+    // publish the new set of sockets on its next update.
+    if (ret > 0)
     {
-      WiiSocket& sock = pair.second;
-      sock.Update(FD_ISSET(sock.fd, &read_fds) != 0, FD_ISSET(sock.fd, &write_fds) != 0,
-                  FD_ISSET(sock.fd, &except_fds) != 0);
+      for (const pollfd_t& pfd : pfds)
+      {
+        if (pfd.revents != 0)
+          m_ready_sockets.Push(pfd.fd);
+      }
+
+      ScheduleSocketsReady();
     }
+
+    // Level triggered, so stop polling these until the CPU thread has handled them.
+    pfds.clear();
+    m_poll_rearm_needed.Set();
   }
-  else
+}
+
+void WiiSockMan::ScheduleSocketsReady()
+{
+  if (m_sockets_ready_scheduled.TestAndSet())
+  {
+    m_ios.GetSystem().GetCoreTiming().ScheduleEvent(0, s_sockets_ready_event, 0,
+                                                    CoreTiming::FromThread::NON_CPU);
+  }
+}
+
+void WiiSockMan::RunSSLJob(SSLJob& job)
+{
+  WII_SSL* ssl = &NetSSLDevice::_SSL[job.ssl_id];
+  switch (job.type)
+  {
+  case IOCTLV_NET_SSL_DOHANDSHAKE:
   {
-    for (auto& elem : WiiSockets)
+    mbedtls_ssl_context* ctx = &ssl->ctx;
+    job.result = mbedtls_ssl_handshake(ctx);
+    if (job.result != 0)
+    {
+      char error_buffer[256] = "";
+      mbedtls_strerror(job.result, error_buffer, sizeof(error_buffer));
+      ERROR_LOG_FMT(IOS_SSL, "IOCTLV_NET_SSL_DOHANDSHAKE: {}", error_buffer);
+    }
+
+    if (job.result == 0)
+      NetSSLDevice::StoreSession(*ssl);
+    else if (job.result == MBEDTLS_ERR_X509_CERT_VERIFY_FAILED)
+      job.verify_result = mbedtls_ssl_get_verify_result(ctx);
+
+    // mbedtls_ssl_get_peer_cert(ctx) seems not to work if handshake failed
+    // Below is an alternative to dump the peer certificate
+    if (Config::Get(Config::MAIN_NETWORK_SSL_DUMP_PEER_CERT) && ctx->session_negotiate != nullptr)
     {
-      elem.second.Update(false, false, false);
+      const mbedtls_x509_crt* cert = ctx->session_negotiate->peer_cert;
+      if (cert != nullptr)
+      {
+        std::string filename = File::GetUserPath(D_DUMPSSL_IDX) +
+                               ((ctx->hostname != nullptr) ? ctx->hostname : "") +
+                               "_peercert.der";
+        File::IOFile(filename, "wb").WriteBytes(cert->raw.p, cert->raw.len);
+      }
     }
+    break;
   }
-  UpdatePollCommands();
+  case IOCTLV_NET_SSL_WRITE:
+    job.result = mbedtls_ssl_write(&ssl->ctx, job.data.data(), job.data.size());
+    break;
+  case IOCTLV_NET_SSL_READ:
+    job.result = mbedtls_ssl_read(&ssl->ctx, job.data.data(), job.data.size());
+    break;
+  default:
+    break;
+  }
+
+  job.done.Set();
+  ScheduleSocketsReady();
+}
+
+void WiiSockMan::WaitForSSLJobs()
+{
+  for (auto& worker : m_ssl_workers)
+    worker.WaitForCompletion();
 }
 
 void WiiSockMan::UpdatePollCommands()
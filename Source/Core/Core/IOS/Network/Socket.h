@@ -42,23 +42,41 @@ typedef struct pollfd pollfd_t;
 #endif
 
 #include <algorithm>
+#include <array>
 #include <chrono>
 #include <cstdio>
 #include <list>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/EnumUtils.h"
+#include "Common/Event.h"
+#include "Common/Flag.h"
 #include "Common/Logging/Log.h"
+#include "Common/SPSCQueue.h"
+#include "Common/WorkQueueThread.h"
 #include "Core/HW/Memmap.h"
 #include "Core/IOS/IOS.h"
 #include "Core/IOS/Network/IP/Top.h"
 #include "Core/IOS/Network/SSL.h"
 
+namespace Core
+{
+class System;
+}
+namespace CoreTiming
+{
+struct EventType;
+}
+
 namespace IOS::HLE
 {
 constexpr int WII_SOCKET_FD_MAX = 24;
@@ -177,6 +195,19 @@ struct WiiSockAddrIn
 
 class WiiSockMan;
 
+// An mbedTLS call that runs on the SSL worker of its context. The result is handed back to the
+// CPU thread, which does everything that touches emulated memory.
+struct SSLJob
+{
+  SSL_IOCTL type;
+  int ssl_id;
+  // Data to write, or the buffer that receives the data that was read.
+  std::vector<u8> data;
+  int result = 0;
+  u32 verify_result = 0;
+  Common::Flag done;
+};
+
 class WiiSocket
 {
 public:
@@ -199,6 +230,8 @@ private:
       NET_IOCTL net_type;
       SSL_IOCTL ssl_type;
     };
+    // Set while an SSL operation runs on a worker, accessed by the CPU thread only.
+    std::shared_ptr<SSLJob> ssl_job;
   };
 
   enum class ConnectingState
@@ -222,7 +255,12 @@ private:
 
   void DoSock(Request request, NET_IOCTL type);
   void DoSock(Request request, SSL_IOCTL type);
-  void Update(bool read, bool write, bool except);
+  void Update();
+  // Returns true if the SSL operation was handed to a worker and its result isn't available yet.
+  bool StartSSLJob(sockop& op, int ssl_id, const u8* write_data, u32 write_size, u32 read_size);
+  bool HasFinishedSSLJob() const;
+  // Host events that can let one of the pending operations make progress.
+  s16 GetPendingEvents() const;
   void UpdateConnectingState(s32 connect_rv);
   ConnectingState GetConnectingState() const;
   bool IsValid() const { return fd >= 0; }
@@ -302,9 +340,23 @@ public:
 
   void UpdateWantDeterminism(bool want);
 
+  // Must be called before the CPU thread touches the mbedTLS context of an SSL instance.
+  void WaitForSSLJobs();
+
+  static void SocketsReadyCallback(Core::System& system, u64 userdata, s64 cycles_late);
+  static CoreTiming::EventType* s_sockets_ready_event;
+
 private:
+  void UpdateSockets(bool ready_only);
   void UpdatePollCommands();
 
+  // The poll thread waits for host sockets with pending operations to become ready, so that
+  // they are handled as soon as data arrives instead of on the next periodic update.
+  void PublishPollInterest();
+  void PollThread();
+  void RunSSLJob(SSLJob& job);
+  void ScheduleSocketsReady();
+
   friend class WiiSocket;
 
   EmulationKernel& m_ios;
@@ -313,5 +365,25 @@ private:
   std::vector<PollCommand> pending_polls;
   std::chrono::time_point<std::chrono::high_resolution_clock> last_time =
       std::chrono::high_resolution_clock::now();
+
+  std::thread m_poll_thread;
+  Common::Flag m_poll_thread_running;
+  Common::Event m_poll_interest_event;
+  std::mutex m_poll_interest_lock;
+  std::vector<pollfd_t> m_poll_interest;
+  bool m_poll_interest_changed = false;
+  // Set by the poll thread after reporting, it then waits for the interest to be published again.
+  Common::Flag m_poll_rearm_needed;
+  // Only accessed by the CPU thread.
+  std::vector<pollfd_t> m_last_poll_interest;
+  // Host fds reported ready by the poll thread, drained on the CPU thread.
+  Common::SPSCQueue<s32, false> m_ready_sockets;
+  Common::Flag m_sockets_ready_scheduled;
+
+  // Handshakes and record encryption are too slow to run on the CPU thread. Each SSL instance
+  // has its own worker, so operations on one context stay in order while several connections
+  // can make progress at the same time.
+  std::array<Common::WorkQueueThread<std::shared_ptr<SSLJob>>, NET_SSL_MAXINSTANCES>
+      m_ssl_workers;
 };
 }  // namespace IOS::HLE
@@ -10,6 +10,7 @@
 
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
+#include "Common/FatFsUtil.h"
 #include "Common/FileUtil.h"
 #include "Common/IOFile.h"
 #include "Common/Logging/Log.h"
@@ -88,6 +89,9 @@ void SDIOSlot0Device::EventNotify()
 
 void SDIOSlot0Device::OpenInternal()
 {
+  if (!Common::WaitForSDFolderToSDImageSync())
+    WARN_LOG_FMT(IOS_SD, "Failed to sync the SD card folder, using the previous SD card image");
+
   const std::string filename = File::GetUserPath(F_WIISDCARDIMAGE_IDX);
   m_card.Open(filename, "r+b");
   if (!m_card)
@@ -104,6 +108,9 @@ void SDIOSlot0Device::OpenInternal()
                             "from a read-only directory?");
     }
   }
+
+  if (m_card && !m_card_mapping.Open(filename))
+    WARN_LOG_FMT(IOS_SD, "Failed to map SD Card image, falling back to file I/O");
 }
 
 std::optional<IPCReply> SDIOSlot0Device::Open(const OpenRequest& request)
@@ -118,6 +125,9 @@ std::optional<IPCReply> SDIOSlot0Device::Open(const OpenRequest& request)
 
 std::optional<IPCReply> SDIOSlot0Device::Close(u32 fd)
 {
+  if (m_card_mapping.IsOpen() && !m_card_mapping.Flush())
+    ERROR_LOG_FMT(IOS_SD, "Failed to flush SD Card image");
+  m_card_mapping.Close();
   m_card.Close();
   m_block_length = 0;
   m_bus_width = 0;
@@ -284,19 +294,10 @@ s32 SDIOSlot0Device::ExecuteCommand(const Request& request, u32 buffer_in, u32 b
       const u32 size = req.bsize * req.blocks;
       const u64 address = GetAddressFromRequest(req.arg);
 
-      if (!m_card.Seek(address, File::SeekOrigin::Begin))
-        ERROR_LOG_FMT(IOS_SD, "Seek failed");
-
-      if (m_card.ReadBytes(memory.GetPointerForRange(req.addr, size), size))
-      {
+      if (ReadFromCard(address, memory.GetPointerForRange(req.addr, size), size))
         DEBUG_LOG_FMT(IOS_SD, "Outbuffer size {} got {}", rw_buffer_size, size);
-      }
       else
-      {
-        ERROR_LOG_FMT(IOS_SD, "Read Failed - error: {}, eof: {}", std::ferror(m_card.GetHandle()),
-                      std::feof(m_card.GetHandle()));
         ret = RET_FAIL;
-      }
     }
   }
     memory.Write_U32(0x900, buffer_out);
@@ -314,15 +315,8 @@ s32 SDIOSlot0Device::ExecuteCommand(const Request& request, u32 buffer_in, u32 b
       const u32 size = req.bsize * req.blocks;
       const u64 address = GetAddressFromRequest(req.arg);
 
-      if (!m_card.Seek(address, File::SeekOrigin::Begin))
-        ERROR_LOG_FMT(IOS_SD, "Seek failed");
-
-      if (!m_card.WriteBytes(memory.GetPointerForRange(req.addr, size), size))
-      {
-        ERROR_LOG_FMT(IOS_SD, "Write Failed - error: {}, eof: {}", std::ferror(m_card.GetHandle()),
-                      std::feof(m_card.GetHandle()));
+      if (!WriteToCard(address, memory.GetReadOnlyPointerForRange(req.addr, size), size))
         ret = RET_FAIL;
-      }
     }
   }
     memory.Write_U32(0x900, buffer_out);
@@ -462,6 +456,58 @@ std::optional<IPCReply> SDIOSlot0Device::SendCommand(const IOCtlRequest& request
   return IPCReply(IPC_SUCCESS);
 }
 
+bool SDIOSlot0Device::ReadFromCard(u64 address, u8* buffer, u32 size)
+{
+  if (m_card_mapping.IsOpen())
+  {
+    if (!m_card_mapping.Contains(address, size))
+    {
+      ERROR_LOG_FMT(IOS_SD, "Read of {} bytes from {:#x} is past the end of the card", size,
+                    address);
+      return false;
+    }
+    std::memcpy(buffer, m_card_mapping.GetData() + address, size);
+    return true;
+  }
+
+  if (!m_card.Seek(address, File::SeekOrigin::Begin))
+    ERROR_LOG_FMT(IOS_SD, "Seek failed");
+
+  if (!m_card.ReadBytes(buffer, size))
+  {
+    ERROR_LOG_FMT(IOS_SD, "Read Failed - error: {}, eof: {}", std::ferror(m_card.GetHandle()),
+                  std::feof(m_card.GetHandle()));
+    return false;
+  }
+  return true;
+}
+
+bool SDIOSlot0Device::WriteToCard(u64 address, const u8* buffer, u32 size)
+{
+  if (m_card_mapping.IsOpen())
+  {
+    if (!m_card_mapping.Contains(address, size))
+    {
+      ERROR_LOG_FMT(IOS_SD, "Write of {} bytes to {:#x} is past the end of the card", size,
+                    address);
+      return false;
+    }
+    std::memcpy(m_card_mapping.GetData() + address, buffer, size);
+    return true;
+  }
+
+  if (!m_card.Seek(address, File::SeekOrigin::Begin))
+    ERROR_LOG_FMT(IOS_SD, "Seek failed");
+
+  if (!m_card.WriteBytes(buffer, size))
+  {
+    ERROR_LOG_FMT(IOS_SD, "Write Failed - error: {}, eof: {}", std::ferror(m_card.GetHandle()),
+                  std::feof(m_card.GetHandle()));
+    return false;
+  }
+  return true;
+}
+
 IPCReply SDIOSlot0Device::GetStatus(const IOCtlRequest& request)
 {
   // Since IOS does the SD initialization itself, we just say we're always initialized.
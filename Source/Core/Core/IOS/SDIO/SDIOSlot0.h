@@ -10,6 +10,7 @@
 
 #include "Common/CommonTypes.h"
 #include "Common/IOFile.h"
+#include "Common/MappedFile.h"
 #include "Core/CPUThreadConfigCallback.h"
 #include "Core/IOS/Device.h"
 #include "Core/IOS/IOS.h"
@@ -141,6 +142,8 @@ private:
   s32 ExecuteCommand(const Request& request, u32 buffer_in, u32 buffer_in_size, u32 rw_buffer,
                      u32 rw_buffer_size, u32 buffer_out, u32 buffer_out_size);
   void OpenInternal();
+  bool ReadFromCard(u64 address, u8* buffer, u32 size);
+  bool WriteToCard(u64 address, const u8* buffer, u32 size);
 
   u32 GetOCRegister() const;
 
@@ -166,6 +169,8 @@ private:
   std::array<u32, 0x200 / sizeof(u32)> m_registers{};
 
   File::IOFile m_card;
+  // Block commands copy straight from and to the mapped image when mapping it succeeded.
+  File::MappedFile m_card_mapping;
 
   CPUThreadConfigCallback::ConfigChangedCallbackID m_config_callback_id;
   bool m_sd_card_inserted = false;
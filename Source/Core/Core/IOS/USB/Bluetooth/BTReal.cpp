@@ -71,6 +71,7 @@ BluetoothRealDevice::~BluetoothRealDevice()
 {
   if (m_handle != nullptr)
   {
+    StopPrefetching();
     SendHCIResetCommand();
     WaitForHCICommandComplete(HCI_CMD_RESET);
     const int ret = libusb_release_interface(m_handle, 0);
@@ -188,6 +189,7 @@ std::optional<IPCReply> BluetoothRealDevice::Close(u32 fd)
 {
   if (m_handle)
   {
+    StopPrefetching();
     const int ret = libusb_release_interface(m_handle, 0);
     if (ret != LIBUSB_SUCCESS)
       WARN_LOG_FMT(IOS_WIIMOTE, "libusb_release_interface failed: {}", LibusbUtils::ErrorWrap(ret));
@@ -203,11 +205,14 @@ std::optional<IPCReply> BluetoothRealDevice::IOCtlV(const IOCtlVRequest& request
 {
   if (!m_is_wii_bt_module && m_need_reset_keys.TestAndClear())
   {
-    // Do this now before transferring any more data, so that this is fully transparent to games
+    // Do this now before transferring any more data, so that this is fully transparent to games.
+    // The prefetch transfers would otherwise receive the command complete events.
+    PausePrefetching();
     SendHCIDeleteLinkKeyCommand();
     WaitForHCICommandComplete(HCI_CMD_DELETE_STORED_LINK_KEY);
     if (SendHCIStoreLinkKeyCommand())
       WaitForHCICommandComplete(HCI_CMD_WRITE_STORED_LINK_KEY);
+    ResumePrefetching();
   }
 
   switch (request.request)
@@ -290,6 +295,23 @@ std::optional<IPCReply> BluetoothRealDevice::IOCtlV(const IOCtlVRequest& request
         return std::nullopt;
       }
     }
+    if (cmd->endpoint == HCI_EVENT || cmd->endpoint == ACL_DATA_IN)
+    {
+      SubmitPrefetchTransfers(cmd->endpoint, cmd->length);
+      PrefetchEndpoint& endpoint = m_prefetch_endpoints[cmd->endpoint];
+      if (!endpoint.completed.empty())
+      {
+        PrefetchTransfer* transfer = endpoint.completed.front();
+        endpoint.completed.pop_front();
+        DeliverPacket(*transfer, std::move(cmd));
+      }
+      else
+      {
+        endpoint.waiting_requests.push_back(std::move(cmd));
+      }
+      break;
+    }
+
     auto buffer = cmd->MakeBuffer(cmd->length);
     libusb_transfer* transfer = libusb_alloc_transfer(0);
     transfer->buffer = buffer.get();
@@ -341,6 +363,11 @@ void BluetoothRealDevice::DoState(PointerWrap& p)
     // Save addresses of transfer commands to discard on savestate load.
     for (const auto& transfer : m_current_transfers)
       addresses_to_discard.push_back(transfer.second.command->ios_request.address);
+    for (const auto& [endpoint_address, endpoint] : m_prefetch_endpoints)
+    {
+      for (const auto& request : endpoint.waiting_requests)
+        addresses_to_discard.push_back(request->ios_request.address);
+    }
   }
   p.Do(addresses_to_discard);
   if (p.IsReadMode())
@@ -354,6 +381,15 @@ void BluetoothRealDevice::DoState(PointerWrap& p)
 
     // Prevent the callbacks from replying to a request that has already been discarded.
     m_current_transfers.clear();
+    {
+      // Packets that were received before the state was loaded don't belong to it either.
+      std::lock_guard lk(m_transfers_mutex);
+      for (auto& [endpoint_address, endpoint] : m_prefetch_endpoints)
+      {
+        endpoint.completed.clear();
+        endpoint.waiting_requests.clear();
+      }
+    }
 
     OSD::AddMessage("If the savestate does not load correctly, disconnect all Wii Remotes "
                     "and reload it.",
@@ -726,30 +762,242 @@ void BluetoothRealDevice::HandleBulkOrIntrTransfer(libusb_transfer* tr)
     m_showed_failed_transfer.Clear();
   }
 
-  if (tr->status == LIBUSB_TRANSFER_COMPLETED && tr->endpoint == HCI_EVENT)
+  const auto& command = m_current_transfers.at(tr).command;
+  command->FillBuffer(tr->buffer, tr->actual_length);
+  GetEmulationKernel().EnqueueIPCReply(command->ios_request, tr->actual_length, 0,
+                                       CoreTiming::FromThread::ANY);
+  m_current_transfers.erase(tr);
+}
+
+void BluetoothRealDevice::HandlePrefetchTransfer(libusb_transfer* tr)
+{
+  std::lock_guard lk(m_transfers_mutex);
+  const auto endpoint_iter = m_prefetch_endpoints.find(tr->endpoint);
+  if (endpoint_iter == m_prefetch_endpoints.end())
+    return;
+  PrefetchEndpoint& endpoint = endpoint_iter->second;
+  const auto transfer_iter =
+      std::ranges::find(endpoint.transfers, tr, [](const auto& t) { return t.transfer; });
+  if (transfer_iter == endpoint.transfers.end())
+    return;
+  PrefetchTransfer& transfer = *transfer_iter;
+
+  transfer.in_flight = false;
+  --m_prefetch_transfers_in_flight;
+  if (m_prefetch_paused)
+    m_prefetch_stopped.notify_all();
+
+  if (tr->status != LIBUSB_TRANSFER_COMPLETED && tr->status != LIBUSB_TRANSFER_TIMED_OUT &&
+      tr->status != LIBUSB_TRANSFER_NO_DEVICE && tr->status != LIBUSB_TRANSFER_CANCELLED)
   {
-    const u8 event = tr->buffer[0];
-    if (event == HCI_EVENT_LINK_KEY_NOTIFICATION)
+    ERROR_LOG_FMT(IOS_WIIMOTE, "libusb transfer failed, status: {:#04x}",
+                  Common::ToUnderlying(tr->status));
+    if (!m_showed_failed_transfer.IsSet())
     {
-      hci_link_key_notification_ep notification;
-      std::memcpy(&notification, tr->buffer + sizeof(hci_event_hdr_t), sizeof(notification));
-      linkkey_t key;
-      std::copy(std::begin(notification.key), std::end(notification.key), std::begin(key));
-      m_link_keys[notification.bdaddr] = key;
+      Core::DisplayMessage("Failed to transfer to or from to the Bluetooth adapter.", 10000);
+      Core::DisplayMessage("It may not be compatible with passthrough mode.", 10000);
+      m_showed_failed_transfer.Set();
     }
-    else if (event == HCI_EVENT_COMMAND_COMPL)
+  }
+  else if (tr->status != LIBUSB_TRANSFER_CANCELLED)
+  {
+    m_showed_failed_transfer.Clear();
+  }
+
+  if (tr->actual_length > 0 &&
+      (tr->status == LIBUSB_TRANSFER_COMPLETED || tr->status == LIBUSB_TRANSFER_TIMED_OUT ||
+       tr->status == LIBUSB_TRANSFER_CANCELLED))
+  {
+    if (tr->endpoint == HCI_EVENT)
     {
-      hci_command_compl_ep complete_event;
-      std::memcpy(&complete_event, tr->buffer + sizeof(hci_event_hdr_t), sizeof(complete_event));
-      if (complete_event.opcode == HCI_CMD_RESET)
-        m_need_reset_keys.Set();
+      const u8 event = transfer.buffer[0];
+      if (event == HCI_EVENT_LINK_KEY_NOTIFICATION)
+      {
+        hci_link_key_notification_ep notification;
+        std::memcpy(&notification, transfer.buffer.data() + sizeof(hci_event_hdr_t),
+                    sizeof(notification));
+        linkkey_t key;
+        std::copy(std::begin(notification.key), std::end(notification.key), std::begin(key));
+        m_link_keys[notification.bdaddr] = key;
+      }
+      else if (event == HCI_EVENT_COMMAND_COMPL)
+      {
+        hci_command_compl_ep complete_event;
+        std::memcpy(&complete_event, transfer.buffer.data() + sizeof(hci_event_hdr_t),
+                    sizeof(complete_event));
+        if (complete_event.opcode == HCI_CMD_RESET)
+          m_need_reset_keys.Set();
+      }
     }
+
+    transfer.completion_time = std::chrono::steady_clock::now();
+    if (!endpoint.waiting_requests.empty())
+    {
+      std::unique_ptr<USB::V0IntrMessage> request = std::move(endpoint.waiting_requests.front());
+      endpoint.waiting_requests.pop_front();
+      DeliverPacket(transfer, std::move(request));
+    }
+    else
+    {
+      endpoint.completed.push_back(&transfer);
+    }
+    return;
   }
 
-  const auto& command = m_current_transfers.at(tr).command;
-  command->FillBuffer(tr->buffer, tr->actual_length);
-  GetEmulationKernel().EnqueueIPCReply(command->ios_request, tr->actual_length, 0,
+  // Cancelled transfers are submitted again on the next request.
+  if (tr->status == LIBUSB_TRANSFER_CANCELLED)
+    return;
+
+  // Like before there was prefetching, a request is completed without data when nothing arrived
+  // in time, so that the emulated stack gets a chance to send other requests.
+  if (!endpoint.waiting_requests.empty())
+  {
+    const auto request = std::move(endpoint.waiting_requests.front());
+    endpoint.waiting_requests.pop_front();
+    GetEmulationKernel().EnqueueIPCReply(request->ios_request, 0, 0, CoreTiming::FromThread::ANY);
+  }
+
+  // Failed transfers are only retried on the next request, so that a broken adapter can't keep
+  // the event thread busy.
+  if (tr->status == LIBUSB_TRANSFER_TIMED_OUT && !m_prefetch_paused)
+    SubmitPrefetchTransfer(transfer);
+}
+
+void BluetoothRealDevice::SubmitPrefetchTransfers(u8 endpoint_address, u16 length)
+{
+  if (m_prefetch_paused)
+    return;
+
+  PrefetchEndpoint& endpoint = m_prefetch_endpoints[endpoint_address];
+  for (PrefetchTransfer& transfer : endpoint.transfers)
+  {
+    if (!transfer.transfer)
+    {
+      // The emulated stack always uses the same length for the requests on an endpoint.
+      transfer.buffer.resize(length);
+      libusb_transfer* tr = libusb_alloc_transfer(0);
+      tr->buffer = transfer.buffer.data();
+      tr->callback = [](libusb_transfer* finished_transfer) {
+        static_cast<BluetoothRealDevice*>(finished_transfer->user_data)
+            ->HandlePrefetchTransfer(finished_transfer);
+      };
+      tr->dev_handle = m_handle;
+      tr->endpoint = endpoint_address;
+      tr->length = static_cast<int>(transfer.buffer.size());
+      tr->timeout = TIMEOUT;
+      tr->type = endpoint_address == HCI_EVENT ? LIBUSB_TRANSFER_TYPE_INTERRUPT :
+                                                 LIBUSB_TRANSFER_TYPE_BULK;
+      tr->user_data = this;
+      transfer.transfer = tr;
+    }
+
+    if (!transfer.in_flight && std::ranges::find(endpoint.completed, &transfer) ==
+                                   endpoint.completed.end())
+    {
+      SubmitPrefetchTransfer(transfer);
+    }
+  }
+}
+
+void BluetoothRealDevice::SubmitPrefetchTransfer(PrefetchTransfer& transfer)
+{
+  const int ret = libusb_submit_transfer(transfer.transfer);
+  if (ret != LIBUSB_SUCCESS)
+  {
+    WARN_LOG_FMT(IOS_WIIMOTE, "libusb_submit_transfer failed: {}", LibusbUtils::ErrorWrap(ret));
+    return;
+  }
+  transfer.in_flight = true;
+  ++m_prefetch_transfers_in_flight;
+}
+
+void BluetoothRealDevice::DeliverPacket(PrefetchTransfer& transfer,
+                                        std::unique_ptr<USB::V0IntrMessage> request)
+{
+  const u32 packet_length = static_cast<u32>(transfer.transfer->actual_length);
+  const u32 length = std::min<u32>(packet_length, request->length);
+  if (length != packet_length)
+  {
+    WARN_LOG_FMT(IOS_WIIMOTE, "Truncated a {} byte packet to fit a {} byte request",
+                 packet_length, length);
+  }
+  request->FillBuffer(transfer.buffer.data(), length);
+  GetEmulationKernel().EnqueueIPCReply(request->ios_request, static_cast<s32>(length), 0,
                                        CoreTiming::FromThread::ANY);
-  m_current_transfers.erase(tr);
+
+  const auto delay = std::chrono::steady_clock::now() - transfer.completion_time;
+  ++m_delivered_packets;
+  m_total_delivery_delay += delay;
+  m_max_delivery_delay = std::max(m_max_delivery_delay, delay);
+  ReportDeliveryLatency();
+
+  if (!m_prefetch_paused)
+    SubmitPrefetchTransfer(transfer);
+}
+
+void BluetoothRealDevice::ReportDeliveryLatency()
+{
+  constexpr auto REPORT_INTERVAL = std::chrono::seconds(10);
+  const auto now = std::chrono::steady_clock::now();
+  if (now - m_last_latency_report < REPORT_INTERVAL)
+    return;
+
+  using Microseconds = std::chrono::duration<double, std::micro>;
+  INFO_LOG_FMT(IOS_WIIMOTE, "Delivered {} packets, delay avg {:.0f} us, max {:.0f} us",
+               m_delivered_packets,
+               Microseconds(m_total_delivery_delay).count() / m_delivered_packets,
+               Microseconds(m_max_delivery_delay).count());
+  m_delivered_packets = 0;
+  m_total_delivery_delay = {};
+  m_max_delivery_delay = {};
+  m_last_latency_report = now;
+}
+
+void BluetoothRealDevice::PausePrefetching()
+{
+  std::unique_lock lk(m_transfers_mutex);
+  m_prefetch_paused = true;
+  for (auto& [endpoint_address, endpoint] : m_prefetch_endpoints)
+  {
+    for (PrefetchTransfer& transfer : endpoint.transfers)
+    {
+      if (transfer.in_flight)
+        libusb_cancel_transfer(transfer.transfer);
+    }
+  }
+
+  if (!m_prefetch_stopped.wait_for(lk, std::chrono::seconds(1),
+                                   [this] { return m_prefetch_transfers_in_flight == 0; }))
+  {
+    WARN_LOG_FMT(IOS_WIIMOTE, "Timed out waiting for {} transfers to be cancelled",
+                 m_prefetch_transfers_in_flight);
+  }
+}
+
+void BluetoothRealDevice::ResumePrefetching()
+{
+  std::lock_guard lk(m_transfers_mutex);
+  m_prefetch_paused = false;
+}
+
+void BluetoothRealDevice::StopPrefetching()
+{
+  PausePrefetching();
+
+  std::lock_guard lk(m_transfers_mutex);
+  // Transfers that libusb still owns can't be freed, so they are leaked in that case.
+  if (m_prefetch_transfers_in_flight != 0)
+    return;
+
+  for (auto& [endpoint_address, endpoint] : m_prefetch_endpoints)
+  {
+    for (PrefetchTransfer& transfer : endpoint.transfers)
+    {
+      if (transfer.transfer)
+        libusb_free_transfer(transfer.transfer);
+    }
+  }
+  m_prefetch_endpoints.clear();
+  m_prefetch_paused = false;
 }
 }  // namespace IOS::HLE
@@ -6,10 +6,14 @@
 #if defined(__LIBUSB__)
 #include <array>
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/Flag.h"
@@ -56,6 +60,7 @@ public:
 
   void HandleCtrlTransfer(libusb_transfer* finished_transfer);
   void HandleBulkOrIntrTransfer(libusb_transfer* finished_transfer);
+  void HandlePrefetchTransfer(libusb_transfer* finished_transfer);
 
 private:
   static constexpr u8 INTERFACE = 0x00;
@@ -86,6 +91,37 @@ private:
   };
   std::map<libusb_transfer*, PendingTransfer> m_current_transfers;
 
+  // The IN endpoints (HCI events and incoming ACL data) always have a few transfers submitted,
+  // so that packets are already waiting on the host when the emulated stack asks for them rather
+  // than only being requested from the adapter then. A transfer holding a packet is resubmitted
+  // once the packet has been handed to a request.
+  static constexpr size_t PREFETCH_TRANSFERS = 4;
+  struct PrefetchTransfer
+  {
+    libusb_transfer* transfer = nullptr;
+    std::vector<u8> buffer;
+    bool in_flight = false;
+    std::chrono::steady_clock::time_point completion_time;
+  };
+  struct PrefetchEndpoint
+  {
+    std::array<PrefetchTransfer, PREFETCH_TRANSFERS> transfers;
+    // Transfers holding packets that haven't been read yet, oldest first.
+    std::deque<PrefetchTransfer*> completed;
+    // Requests waiting for a packet, oldest first.
+    std::deque<std::unique_ptr<USB::V0IntrMessage>> waiting_requests;
+  };
+  std::map<u8, PrefetchEndpoint> m_prefetch_endpoints;
+  u32 m_prefetch_transfers_in_flight = 0;
+  bool m_prefetch_paused = false;
+  std::condition_variable m_prefetch_stopped;
+
+  // Time between a packet arriving from the adapter and it being handed to the emulated stack.
+  u64 m_delivered_packets = 0;
+  std::chrono::steady_clock::duration m_total_delivery_delay{};
+  std::chrono::steady_clock::duration m_max_delivery_delay{};
+  std::chrono::steady_clock::time_point m_last_latency_report;
+
   // Set when we received a command to which we need to fake a reply
   Common::Flag m_fake_read_buffer_size_reply;
   Common::Flag m_fake_vendor_command_reply;
@@ -117,6 +153,17 @@ private:
   void SaveLinkKeys();
 
   bool OpenDevice(libusb_device* device);
+
+  // These must be called with m_transfers_mutex held.
+  void SubmitPrefetchTransfers(u8 endpoint, u16 length);
+  void SubmitPrefetchTransfer(PrefetchTransfer& transfer);
+  void DeliverPacket(PrefetchTransfer& transfer, std::unique_ptr<USB::V0IntrMessage> request);
+  void ReportDeliveryLatency();
+
+  // Cancels the prefetch transfers and waits for libusb to give them back.
+  void PausePrefetching();
+  void ResumePrefetching();
+  void StopPrefetching();
 };
 }  // namespace IOS::HLE
 
@@ -4,6 +4,7 @@
 #include "Core/IOS/USB/LibusbDevice.h"
 
 #include <algorithm>
+#include <chrono>
 #include <cstddef>
 #include <cstring>
 #include <functional>
@@ -50,6 +51,9 @@ LibusbDevice::LibusbDevice(EmulationKernel& ios, libusb_device* device,
 
 LibusbDevice::~LibusbDevice()
 {
+  for (auto& [endpoint, transfer_endpoint] : m_transfer_endpoints)
+    transfer_endpoint.LogLatencyStats(m_vid, m_pid, endpoint);
+
   if (m_handle != nullptr)
   {
     ReleaseAllInterfacesForCurrentConfig();
@@ -245,19 +249,21 @@ int LibusbDevice::SubmitTransfer(std::unique_ptr<CtrlMessage> cmd)
   }
 
   const size_t size = cmd->length + LIBUSB_CONTROL_SETUP_SIZE;
-  auto buffer = std::make_unique<u8[]>(size);
-  libusb_fill_control_setup(buffer.get(), cmd->request_type, cmd->request, cmd->value, cmd->index,
+  TransferEndpoint& endpoint = m_transfer_endpoints[0];
+  PooledTransfer* transfer = endpoint.GetTransfer(0);
+  transfer->zero_copy = false;
+  transfer->buffer.resize(size);
+  u8* buffer = transfer->buffer.data();
+  libusb_fill_control_setup(buffer, cmd->request_type, cmd->request, cmd->value, cmd->index,
                             cmd->length);
 
   auto& system = m_ios.GetSystem();
   auto& memory = system.GetMemory();
-  memory.CopyFromEmu(buffer.get() + LIBUSB_CONTROL_SETUP_SIZE, cmd->data_address, cmd->length);
+  memory.CopyFromEmu(buffer + LIBUSB_CONTROL_SETUP_SIZE, cmd->data_address, cmd->length);
 
-  libusb_transfer* transfer = libusb_alloc_transfer(0);
-  transfer->flags |= LIBUSB_TRANSFER_FREE_TRANSFER;
-  libusb_fill_control_transfer(transfer, m_handle, buffer.release(), CtrlTransferCallback, this, 0);
-  m_transfer_endpoints[0].AddTransfer(std::move(cmd), transfer);
-  return libusb_submit_transfer(transfer);
+  libusb_fill_control_transfer(transfer->transfer, m_handle, buffer, CtrlTransferCallback, this,
+                               0);
+  return endpoint.SubmitTransfer(std::move(cmd), transfer);
 }
 
 int LibusbDevice::SubmitTransfer(std::unique_ptr<BulkMessage> cmd)
@@ -268,13 +274,12 @@ int LibusbDevice::SubmitTransfer(std::unique_ptr<BulkMessage> cmd)
   DEBUG_LOG_FMT(IOS_USB, "[{:04x}:{:04x} {}] Bulk: length={:04x} endpoint={:02x}", m_vid, m_pid,
                 m_active_interface, cmd->length, cmd->endpoint);
 
-  libusb_transfer* transfer = libusb_alloc_transfer(0);
-  libusb_fill_bulk_transfer(transfer, m_handle, cmd->endpoint,
-                            cmd->MakeBuffer(cmd->length).release(), cmd->length, TransferCallback,
-                            this, 0);
-  transfer->flags |= LIBUSB_TRANSFER_FREE_TRANSFER;
-  m_transfer_endpoints[transfer->endpoint].AddTransfer(std::move(cmd), transfer);
-  return libusb_submit_transfer(transfer);
+  TransferEndpoint& endpoint = m_transfer_endpoints[cmd->endpoint];
+  PooledTransfer* transfer = endpoint.GetTransfer(0);
+  libusb_fill_bulk_transfer(transfer->transfer, m_handle, cmd->endpoint,
+                            PrepareTransferBuffer(transfer, *cmd, cmd->length), cmd->length,
+                            TransferCallback, this, 0);
+  return endpoint.SubmitTransfer(std::move(cmd), transfer);
 }
 
 int LibusbDevice::SubmitTransfer(std::unique_ptr<IntrMessage> cmd)
@@ -285,13 +290,12 @@ int LibusbDevice::SubmitTransfer(std::unique_ptr<IntrMessage> cmd)
   DEBUG_LOG_FMT(IOS_USB, "[{:04x}:{:04x} {}] Interrupt: length={:04x} endpoint={:02x}", m_vid,
                 m_pid, m_active_interface, cmd->length, cmd->endpoint);
 
-  libusb_transfer* transfer = libusb_alloc_transfer(0);
-  libusb_fill_interrupt_transfer(transfer, m_handle, cmd->endpoint,
-                                 cmd->MakeBuffer(cmd->length).release(), cmd->length,
+  TransferEndpoint& endpoint = m_transfer_endpoints[cmd->endpoint];
+  PooledTransfer* transfer = endpoint.GetTransfer(0);
+  libusb_fill_interrupt_transfer(transfer->transfer, m_handle, cmd->endpoint,
+                                 PrepareTransferBuffer(transfer, *cmd, cmd->length), cmd->length,
                                  TransferCallback, this, 0);
-  transfer->flags |= LIBUSB_TRANSFER_FREE_TRANSFER;
-  m_transfer_endpoints[transfer->endpoint].AddTransfer(std::move(cmd), transfer);
-  return libusb_submit_transfer(transfer);
+  return endpoint.SubmitTransfer(std::move(cmd), transfer);
 }
 
 int LibusbDevice::SubmitTransfer(std::unique_ptr<IsoMessage> cmd)
@@ -303,12 +307,13 @@ int LibusbDevice::SubmitTransfer(std::unique_ptr<IsoMessage> cmd)
                 "[{:04x}:{:04x} {}] Isochronous: length={:04x} endpoint={:02x} num_packets={:02x}",
                 m_vid, m_pid, m_active_interface, cmd->length, cmd->endpoint, cmd->num_packets);
 
-  libusb_transfer* transfer = libusb_alloc_transfer(cmd->num_packets);
-  transfer->buffer = cmd->MakeBuffer(cmd->length).release();
+  TransferEndpoint& endpoint = m_transfer_endpoints[cmd->endpoint];
+  PooledTransfer* pooled_transfer = endpoint.GetTransfer(cmd->num_packets);
+  libusb_transfer* transfer = pooled_transfer->transfer;
+  transfer->buffer = PrepareTransferBuffer(pooled_transfer, *cmd, cmd->length);
   transfer->callback = TransferCallback;
   transfer->dev_handle = m_handle;
   transfer->endpoint = cmd->endpoint;
-  transfer->flags |= LIBUSB_TRANSFER_FREE_TRANSFER;
   for (size_t i = 0; i < cmd->num_packets; ++i)
     transfer->iso_packet_desc[i].length = cmd->packet_sizes[i];
   transfer->length = cmd->length;
@@ -316,14 +321,31 @@ int LibusbDevice::SubmitTransfer(std::unique_ptr<IsoMessage> cmd)
   transfer->timeout = 0;
   transfer->type = LIBUSB_TRANSFER_TYPE_ISOCHRONOUS;
   transfer->user_data = this;
-  m_transfer_endpoints[transfer->endpoint].AddTransfer(std::move(cmd), transfer);
-  return libusb_submit_transfer(transfer);
+  return endpoint.SubmitTransfer(std::move(cmd), pooled_transfer);
+}
+
+u8* LibusbDevice::PrepareTransferBuffer(PooledTransfer* transfer, const TransferCommand& cmd,
+                                        size_t length) const
+{
+  ASSERT_MSG(IOS_USB, cmd.data_address != 0, "Invalid data_address");
+  auto& memory = m_ios.GetSystem().GetMemory();
+
+  // Data for IN transfers is written by the event thread, just like FillBuffer would have done
+  // after a copy. The written range is marked once the transfer is complete.
+  u8* data = const_cast<u8*>(memory.GetReadOnlyPointerForRange(cmd.data_address, length));
+  transfer->zero_copy = data != nullptr;
+  if (data)
+    return data;
+
+  transfer->buffer.resize(length);
+  memory.CopyFromEmu(transfer->buffer.data(), cmd.data_address, length);
+  return transfer->buffer.data();
 }
 
 void LibusbDevice::CtrlTransferCallback(libusb_transfer* transfer)
 {
   auto* device = static_cast<LibusbDevice*>(transfer->user_data);
-  device->m_transfer_endpoints[0].HandleTransfer(transfer, [&](const auto& cmd) {
+  device->m_transfer_endpoints[0].HandleTransfer(transfer, [&](const auto& cmd, bool) {
     cmd.FillBuffer(libusb_control_transfer_get_data(transfer), transfer->actual_length);
     // The return code is the total transfer length -- *including* the setup packet.
     return transfer->length;
@@ -333,24 +355,31 @@ void LibusbDevice::CtrlTransferCallback(libusb_transfer* transfer)
 void LibusbDevice::TransferCallback(libusb_transfer* transfer)
 {
   auto* device = static_cast<LibusbDevice*>(transfer->user_data);
-  device->m_transfer_endpoints[transfer->endpoint].HandleTransfer(transfer, [&](const auto& cmd) {
-    switch (transfer->type)
-    {
-    case LIBUSB_TRANSFER_TYPE_ISOCHRONOUS:
-    {
-      auto& iso_msg = static_cast<const IsoMessage&>(cmd);
-      cmd.FillBuffer(transfer->buffer, iso_msg.length);
-      for (size_t i = 0; i < iso_msg.num_packets; ++i)
-        iso_msg.SetPacketReturnValue(i, transfer->iso_packet_desc[i].actual_length);
-      // Note: isochronous transfers *must* return 0 as the return value. Anything else
-      // (such as the number of bytes transferred) is considered as a failure.
-      return static_cast<s32>(IPC_SUCCESS);
-    }
-    default:
-      cmd.FillBuffer(transfer->buffer, transfer->actual_length);
-      return static_cast<s32>(transfer->actual_length);
-    }
-  });
+  const auto fill_buffer = [&](const TransferCommand& cmd, size_t size, bool zero_copy) {
+    if (zero_copy)
+      device->m_ios.GetSystem().GetMemory().MarkRangeWritten(cmd.data_address, size);
+    else
+      cmd.FillBuffer(transfer->buffer, size);
+  };
+  device->m_transfer_endpoints[transfer->endpoint].HandleTransfer(
+      transfer, [&](const auto& cmd, bool zero_copy) {
+        switch (transfer->type)
+        {
+        case LIBUSB_TRANSFER_TYPE_ISOCHRONOUS:
+        {
+          auto& iso_msg = static_cast<const IsoMessage&>(cmd);
+          fill_buffer(cmd, iso_msg.length, zero_copy);
+          for (size_t i = 0; i < iso_msg.num_packets; ++i)
+            iso_msg.SetPacketReturnValue(i, transfer->iso_packet_desc[i].actual_length);
+          // Note: isochronous transfers *must* return 0 as the return value. Anything else
+          // (such as the number of bytes transferred) is considered as a failure.
+          return static_cast<s32>(IPC_SUCCESS);
+        }
+        default:
+          fill_buffer(cmd, transfer->actual_length, zero_copy);
+          return static_cast<s32>(transfer->actual_length);
+        }
+      });
 }
 
 static const std::map<u8, const char*> s_transfer_types = {
@@ -360,15 +389,66 @@ static const std::map<u8, const char*> s_transfer_types = {
     {LIBUSB_TRANSFER_TYPE_INTERRUPT, "Interrupt"},
 };
 
-void LibusbDevice::TransferEndpoint::AddTransfer(std::unique_ptr<TransferCommand> command,
-                                                 libusb_transfer* transfer)
+LibusbDevice::TransferEndpoint::~TransferEndpoint()
 {
   std::lock_guard lk{m_transfers_mutex};
-  m_transfers.emplace(transfer, std::move(command));
+  for (std::unique_ptr<PooledTransfer>& transfer : m_pool)
+  {
+    // libusb still owns transfers that are in flight, so they can't be freed here.
+    if (m_transfers.contains(transfer->transfer))
+      transfer.release();
+    else
+      libusb_free_transfer(transfer->transfer);
+  }
+}
+
+LibusbDevice::PooledTransfer* LibusbDevice::TransferEndpoint::GetTransfer(int iso_packets)
+{
+  std::lock_guard lk{m_transfers_mutex};
+  PooledTransfer* transfer = nullptr;
+  const auto it = std::find_if(m_free_transfers.rbegin(), m_free_transfers.rend(),
+                               [&](const PooledTransfer* free_transfer) {
+                                 return free_transfer->iso_packets >= iso_packets;
+                               });
+  if (it != m_free_transfers.rend())
+  {
+    transfer = *it;
+    m_free_transfers.erase(std::next(it).base());
+  }
+  else
+  {
+    auto& new_transfer = m_pool.emplace_back(std::make_unique<PooledTransfer>());
+    new_transfer->transfer = libusb_alloc_transfer(iso_packets);
+    new_transfer->iso_packets = iso_packets;
+    transfer = new_transfer.get();
+  }
+
+  transfer->transfer->flags = 0;
+  transfer->transfer->num_iso_packets = 0;
+  return transfer;
 }
 
-void LibusbDevice::TransferEndpoint::HandleTransfer(libusb_transfer* transfer,
-                                                    std::function<s32(const TransferCommand&)> fn)
+int LibusbDevice::TransferEndpoint::SubmitTransfer(std::unique_ptr<TransferCommand> command,
+                                                   PooledTransfer* transfer)
+{
+  {
+    std::lock_guard lk{m_transfers_mutex};
+    transfer->submit_time = std::chrono::steady_clock::now();
+    m_transfers.emplace(transfer->transfer, std::make_pair(transfer, std::move(command)));
+  }
+
+  const int ret = libusb_submit_transfer(transfer->transfer);
+  if (ret < LIBUSB_SUCCESS)
+  {
+    std::lock_guard lk{m_transfers_mutex};
+    m_transfers.erase(transfer->transfer);
+    m_free_transfers.push_back(transfer);
+  }
+  return ret;
+}
+
+void LibusbDevice::TransferEndpoint::HandleTransfer(
+    libusb_transfer* transfer, std::function<s32(const TransferCommand&, bool zero_copy)> fn)
 {
   std::lock_guard lk{m_transfers_mutex};
   const auto iterator = m_transfers.find(transfer);
@@ -378,14 +458,14 @@ void LibusbDevice::TransferEndpoint::HandleTransfer(libusb_transfer* transfer,
     return;
   }
 
-  const std::unique_ptr<u8[]> buffer(transfer->buffer);
-  const auto& cmd = *iterator->second.get();
+  PooledTransfer* pooled_transfer = iterator->second.first;
+  const auto& cmd = *iterator->second.second;
   const auto* device = static_cast<LibusbDevice*>(transfer->user_data);
   s32 return_value = LIBUSB_SUCCESS;
   switch (transfer->status)
   {
   case LIBUSB_TRANSFER_COMPLETED:
-    return_value = fn(cmd);
+    return_value = fn(cmd, pooled_transfer->zero_copy);
     break;
   case LIBUSB_TRANSFER_ERROR:
   case LIBUSB_TRANSFER_CANCELLED:
@@ -402,8 +482,15 @@ void LibusbDevice::TransferEndpoint::HandleTransfer(libusb_transfer* transfer,
     return_value = IPC_ENOENT;
     break;
   }
+
+  const auto latency = std::chrono::steady_clock::now() - pooled_transfer->submit_time;
+  ++m_completed_transfers;
+  m_total_latency += latency;
+  m_max_latency = std::max(m_max_latency, latency);
+
   cmd.OnTransferComplete(return_value);
-  m_transfers.erase(transfer);
+  m_transfers.erase(iterator);
+  m_free_transfers.push_back(pooled_transfer);
 }
 
 void LibusbDevice::TransferEndpoint::CancelTransfers()
@@ -416,6 +503,21 @@ void LibusbDevice::TransferEndpoint::CancelTransfers()
     libusb_cancel_transfer(pending_transfer.first);
 }
 
+void LibusbDevice::TransferEndpoint::LogLatencyStats(u16 vid, u16 pid, u8 endpoint)
+{
+  std::lock_guard lk(m_transfers_mutex);
+  if (m_completed_transfers == 0)
+    return;
+
+  using Microseconds = std::chrono::duration<double, std::micro>;
+  INFO_LOG_FMT(IOS_USB,
+               "[{:04x}:{:04x}] Endpoint {:#04x}: {} transfers, {} pooled, latency avg {:.0f} us, "
+               "max {:.0f} us",
+               vid, pid, endpoint, m_completed_transfers, m_pool.size(),
+               Microseconds(m_total_latency).count() / m_completed_transfers,
+               Microseconds(m_max_latency).count());
+}
+
 int LibusbDevice::GetNumberOfAltSettings(const u8 interface_number)
 {
   return m_config_descriptors[0]->interface[interface_number].num_altsetting;
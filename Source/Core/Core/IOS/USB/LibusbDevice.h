@@ -4,6 +4,7 @@
 #pragma once
 
 #if defined(__LIBUSB__)
+#include <chrono>
 #include <cstddef>
 #include <functional>
 #include <map>
@@ -57,20 +58,51 @@ private:
   libusb_device* m_device = nullptr;
   libusb_device_handle* m_handle = nullptr;
 
+  // libusb transfers are kept in a pool per endpoint and reused, so that a device that keeps
+  // several transfers in flight doesn't allocate a transfer and a buffer for every one of them.
+  struct PooledTransfer
+  {
+    libusb_transfer* transfer = nullptr;
+    int iso_packets = 0;
+    // Only used when the data can't be transferred to or from emulated memory directly.
+    std::vector<u8> buffer;
+    bool zero_copy = false;
+    std::chrono::steady_clock::time_point submit_time;
+  };
+
   class TransferEndpoint final
   {
   public:
-    void AddTransfer(std::unique_ptr<TransferCommand> command, libusb_transfer* transfer);
-    void HandleTransfer(libusb_transfer* tr, std::function<s32(const TransferCommand&)> function);
+    TransferEndpoint() = default;
+    TransferEndpoint(const TransferEndpoint&) = delete;
+    TransferEndpoint& operator=(const TransferEndpoint&) = delete;
+    ~TransferEndpoint();
+
+    PooledTransfer* GetTransfer(int iso_packets);
+    int SubmitTransfer(std::unique_ptr<TransferCommand> command, PooledTransfer* transfer);
+    void HandleTransfer(libusb_transfer* tr,
+                        std::function<s32(const TransferCommand&, bool zero_copy)> function);
     void CancelTransfers();
+    void LogLatencyStats(u16 vid, u16 pid, u8 endpoint);
 
   private:
     std::mutex m_transfers_mutex;
-    std::map<libusb_transfer*, std::unique_ptr<TransferCommand>> m_transfers;
+    std::map<libusb_transfer*, std::pair<PooledTransfer*, std::unique_ptr<TransferCommand>>>
+        m_transfers;
+    std::vector<std::unique_ptr<PooledTransfer>> m_pool;
+    std::vector<PooledTransfer*> m_free_transfers;
+
+    u64 m_completed_transfers = 0;
+    std::chrono::steady_clock::duration m_total_latency{};
+    std::chrono::steady_clock::duration m_max_latency{};
   };
   std::map<u8, TransferEndpoint> m_transfer_endpoints;
   static void CtrlTransferCallback(libusb_transfer* transfer);
   static void TransferCallback(libusb_transfer* transfer);
+  // Returns the data in emulated memory if it can be transferred directly, or copies it to the
+  // transfer's own buffer otherwise.
+  u8* PrepareTransferBuffer(PooledTransfer* transfer, const TransferCommand& cmd,
+                            size_t length) const;
 
   int ClaimAllInterfaces(u8 config_num) const;
   int ReleaseAllInterfaces(u8 config_num) const;
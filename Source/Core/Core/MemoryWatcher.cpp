@@ -3,33 +3,88 @@
 
 #include "Core/MemoryWatcher.h"
 
+#include <algorithm>
+#include <array>
 #include <cstring>
+#include <fcntl.h>
 #include <fstream>
-#include <iostream>
+#include <iterator>
+#include <new>
+#include <optional>
+#include <span>
 #include <sstream>
+#include <sys/mman.h>
 #include <unistd.h>
 
+#include <fmt/format.h>
+
+#include "Common/Config/Config.h"
 #include "Common/FileUtil.h"
+#include "Common/Logging/Log.h"
+#include "Core/Config/MainSettings.h"
+#include "Core/Core.h"
+#include "Core/HW/Memmap.h"
 #include "Core/HW/SystemTimers.h"
 #include "Core/PowerPC/MMU.h"
+#include "Core/System.h"
+
+namespace
+{
+constexpr u32 RING_DATA_OFFSET = 4096;
+constexpr u32 RING_CAPACITY = 16 * 1024 * 1024;
+static_assert(sizeof(MemoryWatcherRingHeader) <= RING_DATA_OFFSET);
+
+// Every batch has to fit into the ring, with room to spare for the reader to consume another.
+constexpr size_t MAX_WATCHED_BYTES = RING_CAPACITY / 4;
+
+constexpr size_t BATCH_HEADER_SIZE = 16;
+constexpr size_t RECORD_HEADER_SIZE = 12;
+
+// Regions are compared in blocks of this many bytes, and changes are sent in whole blocks.
+constexpr size_t DIFF_BLOCK_SIZE = 64;
+
+// Compares a whole block at once, which compilers turn into a few vector instructions.
+bool BlockDiffers(const u8* a, const u8* b)
+{
+  std::array<u64, DIFF_BLOCK_SIZE / sizeof(u64)> a_words, b_words;
+  std::memcpy(a_words.data(), a, DIFF_BLOCK_SIZE);
+  std::memcpy(b_words.data(), b, DIFF_BLOCK_SIZE);
+
+  u64 diff = 0;
+  for (size_t i = 0; i < a_words.size(); ++i)
+    diff |= a_words[i] ^ b_words[i];
+  return diff != 0;
+}
+}  // namespace
 
 MemoryWatcher::MemoryWatcher()
 {
   m_running = false;
   if (!LoadAddresses(File::GetUserPath(F_MEMORYWATCHERLOCATIONS_IDX)))
     return;
-  if (!OpenSocket(File::GetUserPath(F_MEMORYWATCHERSOCKET_IDX)))
-    return;
+
+  if (Config::Get(Config::MAIN_MEMORY_WATCHER_SHARED_MEMORY))
+  {
+    if (!OpenRing(File::GetUserPath(F_MEMORYWATCHERRING_IDX)))
+      return;
+  }
+  else
+  {
+    if (!m_regions.empty())
+      WARN_LOG_FMT(CORE, "MemoryWatcher: Regions are only watched with the shared memory ring");
+    if (!OpenSocket(File::GetUserPath(F_MEMORYWATCHERSOCKET_IDX)))
+      return;
+  }
   m_running = true;
 }
 
 MemoryWatcher::~MemoryWatcher()
 {
-  if (!m_running)
-    return;
-
   m_running = false;
-  close(m_fd);
+  if (m_ring)
+    munmap(m_ring, m_ring_size);
+  if (m_fd >= 0)
+    close(m_fd);
 }
 
 bool MemoryWatcher::LoadAddresses(const std::string& path)
@@ -43,19 +98,51 @@ bool MemoryWatcher::LoadAddresses(const std::string& path)
   while (std::getline(locations, line))
     ParseLine(line);
 
-  return !m_values.empty();
+  return !m_addresses.empty() || !m_regions.empty();
 }
 
 void MemoryWatcher::ParseLine(const std::string& line)
 {
-  m_values[line] = 0;
-  m_addresses[line] = std::vector<u32>();
+  const u32 index = m_line_count++;
+
+  if (line.starts_with("region "))
+  {
+    std::istringstream fields(line.substr(7));
+    fields >> std::hex;
+    u32 address, size;
+    if (!(fields >> address >> size) || size == 0)
+    {
+      WARN_LOG_FMT(CORE, "MemoryWatcher: Invalid region \"{}\"", line);
+      return;
+    }
+    if (m_watched_bytes + size > MAX_WATCHED_BYTES)
+    {
+      WARN_LOG_FMT(CORE, "MemoryWatcher: Region \"{}\" is too large to be watched", line);
+      return;
+    }
+
+    m_watched_bytes += size;
+    m_regions.push_back({address, index, std::vector<u8>(size)});
+    return;
+  }
+
+  if (std::any_of(m_addresses.begin(), m_addresses.end(),
+                  [&line](const AddressWatch& watch) { return watch.line == line; }))
+  {
+    return;
+  }
+
+  AddressWatch& watch = m_addresses.emplace_back();
+  watch.line = line;
+  watch.index = index;
 
   std::istringstream offsets(line);
   offsets >> std::hex;
   u32 offset;
   while (offsets >> offset)
-    m_addresses[line].push_back(offset);
+    watch.offsets.push_back(offset);
+
+  m_watched_bytes += RECORD_HEADER_SIZE + sizeof(u32);
 }
 
 bool MemoryWatcher::OpenSocket(const std::string& path)
@@ -67,10 +154,45 @@ bool MemoryWatcher::OpenSocket(const std::string& path)
   return m_fd >= 0;
 }
 
-u32 MemoryWatcher::ChasePointer(const Core::CPUThreadGuard& guard, const std::string& line)
+bool MemoryWatcher::OpenRing(const std::string& path)
+{
+  const int fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0)
+  {
+    ERROR_LOG_FMT(CORE, "MemoryWatcher: Failed to create {}", path);
+    return false;
+  }
+
+  const size_t size = RING_DATA_OFFSET + RING_CAPACITY;
+  void* ring = MAP_FAILED;
+  if (ftruncate(fd, size) == 0)
+    ring = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (ring == MAP_FAILED)
+  {
+    ERROR_LOG_FMT(CORE, "MemoryWatcher: Failed to map {}", path);
+    return false;
+  }
+
+  m_ring = static_cast<u8*>(ring);
+  m_ring_size = size;
+
+  auto* header = new (m_ring) MemoryWatcherRingHeader();
+  header->version = MemoryWatcherRingHeader::VERSION;
+  header->data_offset = RING_DATA_OFFSET;
+  header->capacity = RING_CAPACITY;
+  std::atomic_thread_fence(std::memory_order_release);
+  header->magic = MemoryWatcherRingHeader::MAGIC;
+
+  m_batch.reserve(BATCH_HEADER_SIZE + m_watched_bytes);
+  return true;
+}
+
+u32 MemoryWatcher::ChasePointer(const Core::CPUThreadGuard& guard,
+                                const AddressWatch& watch) const
 {
   u32 value = 0;
-  for (u32 offset : m_addresses[line])
+  for (u32 offset : watch.offsets)
   {
     value = PowerPC::MMU::HostRead_U32(guard, value + offset);
     if (!PowerPC::MMU::HostIsRAMAddress(guard, value))
@@ -79,26 +201,140 @@ u32 MemoryWatcher::ChasePointer(const Core::CPUThreadGuard& guard, const std::st
   return value;
 }
 
-std::string MemoryWatcher::ComposeMessages(const Core::CPUThreadGuard& guard)
+void MemoryWatcher::ComposeMessages(const Core::CPUThreadGuard& guard)
 {
-  std::ostringstream message_stream;
-  message_stream << std::hex;
+  m_message.clear();
 
-  for (auto& entry : m_values)
+  for (AddressWatch& watch : m_addresses)
   {
-    std::string address = entry.first;
-    u32& current_value = entry.second;
-
-    u32 new_value = ChasePointer(guard, address);
-    if (new_value != current_value)
+    const u32 new_value = ChasePointer(guard, watch);
+    if (new_value != watch.value)
     {
       // Update the value
-      current_value = new_value;
-      message_stream << address << '\n' << new_value << '\n';
+      watch.value = new_value;
+      fmt::format_to(std::back_inserter(m_message), "{}\n{:x}\n", watch.line, new_value);
+    }
+  }
+}
+
+void MemoryWatcher::AddRecord(u32 index, u32 offset, const void* data, u32 size,
+                              PendingUpdate update)
+{
+  const std::array<u32, 3> record_header{index, offset, size};
+  const size_t record_start = m_batch.size();
+  m_batch.resize(record_start + RECORD_HEADER_SIZE + ((size + 3) & ~3u));
+  std::memcpy(m_batch.data() + record_start, record_header.data(), RECORD_HEADER_SIZE);
+  std::memcpy(m_batch.data() + record_start + RECORD_HEADER_SIZE, data, size);
+
+  update.offset = offset;
+  update.size = size;
+  update.data = record_start + RECORD_HEADER_SIZE;
+  m_pending_updates.push_back(update);
+}
+
+void MemoryWatcher::DiffRegion(const Core::CPUThreadGuard& guard, u32 region)
+{
+  RegionWatch& watch = m_regions[region];
+  auto& memory = guard.GetSystem().GetMemory();
+  const size_t size = watch.snapshot.size();
+
+  const std::span<u8> span = memory.GetSpanForAddress(watch.address);
+  if (span.size() < size)
+    return;
+
+  // Nothing needs comparing if the guest hasn't written to the region since it was last compared.
+  if (watch.write_stamp != 0 &&
+      !memory.WasRangeWrittenSince(watch.address, size, watch.write_stamp))
+  {
+    return;
+  }
+  watch.write_stamp = memory.WatchRange(watch.address, size);
+
+  const u8* const live = span.data();
+  const u8* const snapshot = watch.snapshot.data();
+  const auto add_run = [&](size_t begin, size_t end) {
+    AddRecord(watch.index, static_cast<u32>(begin), live + begin, static_cast<u32>(end - begin),
+              {true, region});
+  };
+
+  // Adjacent blocks that changed are sent as one record.
+  std::optional<size_t> run_start;
+  size_t block = 0;
+  for (; block + DIFF_BLOCK_SIZE <= size; block += DIFF_BLOCK_SIZE)
+  {
+    if (BlockDiffers(live + block, snapshot + block))
+    {
+      if (!run_start)
+        run_start = block;
     }
+    else if (run_start)
+    {
+      add_run(*run_start, block);
+      run_start.reset();
+    }
+  }
+  if (block != size && std::memcmp(live + block, snapshot + block, size - block) != 0)
+  {
+    if (!run_start)
+      run_start = block;
+    block = size;
+  }
+  if (run_start)
+    add_run(*run_start, block);
+}
+
+void MemoryWatcher::ComposeBatch(const Core::CPUThreadGuard& guard)
+{
+  m_batch.resize(BATCH_HEADER_SIZE);
+  m_pending_updates.clear();
+
+  for (u32 i = 0; i < m_addresses.size(); ++i)
+  {
+    const u32 new_value = ChasePointer(guard, m_addresses[i]);
+    if (new_value != m_addresses[i].value)
+      AddRecord(m_addresses[i].index, 0, &new_value, sizeof(new_value), {false, i});
   }
 
-  return message_stream.str();
+  for (u32 i = 0; i < m_regions.size(); ++i)
+    DiffRegion(guard, i);
+}
+
+bool MemoryWatcher::WriteBatch()
+{
+  auto* header = reinterpret_cast<MemoryWatcherRingHeader*>(m_ring);
+  u8* const data = m_ring + RING_DATA_OFFSET;
+
+  const u32 size = static_cast<u32>(m_batch.size());
+  const u32 record_count = static_cast<u32>(m_pending_updates.size());
+  std::memcpy(m_batch.data(), &size, sizeof(size));
+  std::memcpy(m_batch.data() + 4, &record_count, sizeof(record_count));
+  std::memcpy(m_batch.data() + 8, &m_frame, sizeof(m_frame));
+
+  const u64 write_position = header->write_position.load(std::memory_order_relaxed);
+  const u64 read_position = header->read_position.load(std::memory_order_acquire);
+  if (write_position - read_position > RING_CAPACITY - size)
+  {
+    header->delayed_batches.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  const size_t start = write_position & (RING_CAPACITY - 1);
+  const size_t first_part = std::min<size_t>(size, RING_CAPACITY - start);
+  std::memcpy(data + start, m_batch.data(), first_part);
+  std::memcpy(data, m_batch.data() + first_part, size - first_part);
+
+  header->write_position.store(write_position + size, std::memory_order_release);
+  return true;
+}
+
+void MemoryWatcher::ApplyBatch()
+{
+  for (const PendingUpdate& update : m_pending_updates)
+  {
+    u8* const dest = update.is_region ? m_regions[update.watch].snapshot.data() + update.offset :
+                                        reinterpret_cast<u8*>(&m_addresses[update.watch].value);
+    std::memcpy(dest, m_batch.data() + update.data, update.size);
+  }
 }
 
 void MemoryWatcher::Step(const Core::CPUThreadGuard& guard)
@@ -106,7 +342,27 @@ void MemoryWatcher::Step(const Core::CPUThreadGuard& guard)
   if (!m_running)
     return;
 
-  std::string message = ComposeMessages(guard);
-  sendto(m_fd, message.c_str(), message.size() + 1, 0, reinterpret_cast<sockaddr*>(&m_addr),
-         sizeof(m_addr));
+  if (!m_ring)
+  {
+    ComposeMessages(guard);
+    sendto(m_fd, m_message.c_str(), m_message.size() + 1, 0,
+           reinterpret_cast<sockaddr*>(&m_addr), sizeof(m_addr));
+    return;
+  }
+
+  ++m_frame;
+  ComposeBatch(guard);
+  if (m_pending_updates.empty())
+    return;
+
+  if (WriteBatch())
+  {
+    ApplyBatch();
+  }
+  else
+  {
+    // The changes are sent with a later batch instead, so the regions must be compared again.
+    for (RegionWatch& watch : m_regions)
+      watch.write_stamp = 0;
+  }
 }
@@ -5,7 +5,7 @@
 
 #include "Common/CommonTypes.h"
 
-#include <map>
+#include <atomic>
 #include <string>
 #include <sys/socket.h>
 #include <sys/un.h>
@@ -24,6 +24,10 @@ class CPUThreadGuard;
 // "ABCD EF" will watch the address at (*0xABCD) + 0xEF.
 // The output to the socket is two lines. The first is the address from the
 // input file, and the second is the new value in hex.
+//
+// With MAIN_MEMORY_WATCHER_SHARED_MEMORY, changes are instead written as binary records to a ring
+// in a shared memory file, see MemoryWatcherRingHeader. That also supports lines of the form
+// "region ADDRESS SIZE" (in hex), which watch a whole range of physical memory.
 class MemoryWatcher final
 {
 public:
@@ -32,20 +36,92 @@ public:
   void Step(const Core::CPUThreadGuard& guard);
 
 private:
+  struct AddressWatch
+  {
+    // The line from the input file
+    std::string line;
+    std::vector<u32> offsets;
+    u32 index;
+    u32 value = 0;
+  };
+
+  struct RegionWatch
+  {
+    u32 address;
+    u32 index;
+    // The memory as of the last batch that was sent
+    std::vector<u8> snapshot;
+    u64 write_stamp = 0;
+  };
+
+  // A change in the batch being composed, which is only applied to the watch once the batch has
+  // been written to the ring.
+  struct PendingUpdate
+  {
+    bool is_region;
+    u32 watch;
+    u32 offset = 0;
+    u32 size = 0;
+    // Offset of the new data in the batch
+    size_t data = 0;
+  };
+
   bool LoadAddresses(const std::string& path);
   bool OpenSocket(const std::string& path);
+  bool OpenRing(const std::string& path);
 
   void ParseLine(const std::string& line);
-  u32 ChasePointer(const Core::CPUThreadGuard& guard, const std::string& line);
-  std::string ComposeMessages(const Core::CPUThreadGuard& guard);
+  u32 ChasePointer(const Core::CPUThreadGuard& guard, const AddressWatch& watch) const;
+  void ComposeMessages(const Core::CPUThreadGuard& guard);
+
+  void ComposeBatch(const Core::CPUThreadGuard& guard);
+  void AddRecord(u32 index, u32 offset, const void* data, u32 size, PendingUpdate update);
+  void DiffRegion(const Core::CPUThreadGuard& guard, u32 region);
+  bool WriteBatch();
+  void ApplyBatch();
 
   bool m_running = false;
 
-  int m_fd;
+  int m_fd = -1;
   sockaddr_un m_addr{};
+  std::string m_message;
+
+  u8* m_ring = nullptr;
+  size_t m_ring_size = 0;
+  u64 m_frame = 0;
+  std::vector<u8> m_batch;
+  std::vector<PendingUpdate> m_pending_updates;
+
+  std::vector<AddressWatch> m_addresses;
+  std::vector<RegionWatch> m_regions;
+  u32 m_line_count = 0;
+  size_t m_watched_bytes = 0;
+};
+
+// The shared memory file starts with this header, and the ring of batches follows at data_offset.
+// Positions count bytes from the start of the session, and wrap around the ring modulo capacity,
+// which is a power of two. Batches are only appended if there's room for them, so a reader that
+// falls behind misses no changes; they are merged into later batches instead.
+//
+// Batch: u32 size in bytes including this header, u32 record count, u64 frame number.
+// Record: u32 index of the line in the input file, u32 offset into the watch, u32 size in bytes,
+// then the data, padded to a multiple of 4 bytes. Addresses send their new value as a u32 in host
+// byte order, and regions send the bytes that changed as they are in emulated memory.
+struct MemoryWatcherRingHeader
+{
+  static constexpr u32 MAGIC = 0x52574d44;  // "DMWR"
+  static constexpr u32 VERSION = 1;
+
+  u32 magic;
+  u32 version;
+  u32 data_offset;
+  u32 capacity;
 
-  // Address as stored in the file -> list of offsets to follow
-  std::map<std::string, std::vector<u32>> m_addresses;
-  // Address as stored in the file -> current value
-  std::map<std::string, u32> m_values;
+  // Written by Dolphin after a batch has been appended.
+  alignas(64) std::atomic<u64> write_position;
+  // Written by the reader after it has consumed batches.
+  alignas(64) std::atomic<u64> read_position;
+  // Frames on which a batch didn't fit.
+  alignas(64) std::atomic<u64> delayed_batches;
 };
+static_assert(std::atomic<u64>::is_always_lock_free);
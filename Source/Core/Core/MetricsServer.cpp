@@ -0,0 +1,426 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/MetricsServer.h"
+
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iterator>
+#include <string>
+#include <string_view>
+
+#ifdef _WIN32
+#include <WinSock2.h>
+#include <ws2tcpip.h>
+typedef SSIZE_T ssize_t;
+#define SHUT_RDWR SD_BOTH
+#else
+#include <netinet/in.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+#include <fmt/format.h>
+#include <picojson.h>
+
+#include "AudioCommon/Mixer.h"
+#include "AudioCommon/SoundStream.h"
+#include "Common/Logging/Log.h"
+#include "Common/MemoryAccounting.h"
+#include "Common/Thread.h"
+#include "Core/Config/MainSettings.h"
+#include "Core/System.h"
+#include "VideoCommon/PerformanceMetrics.h"
+#include "VideoCommon/Statistics.h"
+
+#ifdef __linux__
+#define SEND_FLAGS MSG_NOSIGNAL
+#else
+#define SEND_FLAGS 0
+#endif
+
+namespace Core
+{
+namespace
+{
+// How often the server thread checks whether it should stop.
+constexpr long POLL_INTERVAL_US = 250'000;
+// How long a client may take to send its request.
+constexpr long REQUEST_TIMEOUT_US = 1'000'000;
+constexpr size_t MAX_REQUEST_SIZE = 4096;
+// How long after the last request the GPU thread stops being timed.
+constexpr auto SAMPLING_IDLE_TIMEOUT = std::chrono::seconds(10);
+
+constexpr std::array<double, 3> FRAME_TIME_QUANTILES = {0.5, 0.9, 0.99};
+
+struct MetricsSnapshot
+{
+  double fps;
+  double vps;
+  double speed;
+  double max_speed;
+  std::array<double, FRAME_TIME_QUANTILES.size()> frame_time_s;
+  double cpu_busy_s;
+  double gpu_busy_s;
+  int vertex_shaders_created;
+  int pixel_shaders_created;
+  u64 audio_underruns;
+  std::array<Common::MemoryAccounting::Usage,
+             static_cast<size_t>(Common::MemoryAccounting::Subsystem::NumSubsystems)>
+      memory;
+};
+
+void CloseSocket(int socket)
+{
+#ifdef _WIN32
+  closesocket(socket);
+#else
+  close(socket);
+#endif
+}
+
+MetricsSnapshot TakeSnapshot(System& system)
+{
+  MetricsSnapshot snapshot;
+  snapshot.fps = g_perf_metrics.GetFPS();
+  snapshot.vps = g_perf_metrics.GetVPS();
+  snapshot.speed = g_perf_metrics.GetSpeed();
+  snapshot.max_speed = g_perf_metrics.GetMaxSpeed();
+  for (size_t i = 0; i < FRAME_TIME_QUANTILES.size(); ++i)
+  {
+    snapshot.frame_time_s[i] =
+        DT_s(g_perf_metrics.GetFrameTimePercentile(FRAME_TIME_QUANTILES[i])).count();
+  }
+  snapshot.cpu_busy_s = DT_s(g_perf_metrics.GetCPUBusyTime()).count();
+  snapshot.gpu_busy_s = DT_s(g_perf_metrics.GetGPUBusyTime()).count();
+  snapshot.vertex_shaders_created = g_stats.num_vertex_shaders_created;
+  snapshot.pixel_shaders_created = g_stats.num_pixel_shaders_created;
+
+  const SoundStream* sound_stream = system.GetSoundStream();
+  snapshot.audio_underruns =
+      sound_stream && sound_stream->GetMixer() ? sound_stream->GetMixer()->GetUnderrunCount() : 0;
+
+  for (size_t i = 0; i < snapshot.memory.size(); ++i)
+  {
+    snapshot.memory[i] =
+        Common::MemoryAccounting::GetUsage(static_cast<Common::MemoryAccounting::Subsystem>(i));
+  }
+  return snapshot;
+}
+
+std::string FormatPrometheus(const MetricsSnapshot& snapshot)
+{
+  std::string out;
+  const auto add_header = [&out](std::string_view name, std::string_view type,
+                                 std::string_view help) {
+    fmt::format_to(std::back_inserter(out), "# HELP {} {}\n# TYPE {} {}\n", name, help, name, type);
+  };
+  const auto add_metric = [&](std::string_view name, std::string_view type, std::string_view help,
+                              double value) {
+    add_header(name, type, help);
+    fmt::format_to(std::back_inserter(out), "{} {}\n", name, value);
+  };
+
+  add_metric("dolphin_fps", "gauge", "Rendered frames per second.", snapshot.fps);
+  add_metric("dolphin_vps", "gauge", "Emulated vertical blanks per second.", snapshot.vps);
+  add_metric("dolphin_speed_ratio", "gauge", "Emulation speed relative to the console.",
+             snapshot.speed);
+  add_metric("dolphin_max_speed_ratio", "gauge",
+             "Emulation speed that could be reached without throttling.", snapshot.max_speed);
+
+  add_header("dolphin_frame_time_seconds", "gauge",
+             "Frame time percentiles over the performance sample window.");
+  for (size_t i = 0; i < FRAME_TIME_QUANTILES.size(); ++i)
+  {
+    fmt::format_to(std::back_inserter(out), "dolphin_frame_time_seconds{{quantile=\"{}\"}} {}\n",
+                   FRAME_TIME_QUANTILES[i], snapshot.frame_time_s[i]);
+  }
+
+  add_metric("dolphin_cpu_thread_busy_seconds_total", "counter",
+             "Time the CPU thread spent not throttling since boot.", snapshot.cpu_busy_s);
+  add_metric("dolphin_gpu_thread_busy_seconds_total", "counter",
+             "Time the GPU thread spent processing, only counted while metrics are polled.",
+             snapshot.gpu_busy_s);
+
+  add_header("dolphin_shaders_created_total", "counter",
+             "Shaders compiled since the shader cache was last reloaded.");
+  fmt::format_to(std::back_inserter(out),
+                 "dolphin_shaders_created_total{{stage=\"vertex\"}} {}\n"
+                 "dolphin_shaders_created_total{{stage=\"pixel\"}} {}\n",
+                 snapshot.vertex_shaders_created, snapshot.pixel_shaders_created);
+
+  add_metric("dolphin_audio_underruns_total", "counter",
+             "Times the audio backend ran out of DSP samples.",
+             static_cast<double>(snapshot.audio_underruns));
+
+  const auto add_memory_metric = [&](std::string_view name, std::string_view help,
+                                     u64 Common::MemoryAccounting::Usage::*field) {
+    add_header(name, "gauge", help);
+    for (size_t i = 0; i < snapshot.memory.size(); ++i)
+    {
+      fmt::format_to(
+          std::back_inserter(out), "{}{{subsystem=\"{}\"}} {}\n", name,
+          Common::MemoryAccounting::GetName(static_cast<Common::MemoryAccounting::Subsystem>(i)),
+          snapshot.memory[i].*field);
+    }
+  };
+  add_memory_metric("dolphin_memory_bytes", "Host memory used by caches and buffers.",
+                    &Common::MemoryAccounting::Usage::current);
+  add_memory_metric("dolphin_memory_peak_bytes", "Most host memory used since the game started.",
+                    &Common::MemoryAccounting::Usage::peak);
+  add_memory_metric("dolphin_memory_budget_bytes", "Memory budget, 0 if there is none.",
+                    &Common::MemoryAccounting::Usage::budget);
+  return out;
+}
+
+std::string FormatJson(const MetricsSnapshot& snapshot)
+{
+  picojson::object frame_time_ms;
+  for (size_t i = 0; i < FRAME_TIME_QUANTILES.size(); ++i)
+  {
+    frame_time_ms[fmt::format("p{}", std::lround(FRAME_TIME_QUANTILES[i] * 100))] =
+        picojson::value(snapshot.frame_time_s[i] * 1000.0);
+  }
+
+  picojson::object shaders_created;
+  shaders_created["vertex"] = picojson::value(static_cast<double>(snapshot.vertex_shaders_created));
+  shaders_created["pixel"] = picojson::value(static_cast<double>(snapshot.pixel_shaders_created));
+
+  picojson::object memory;
+  for (size_t i = 0; i < snapshot.memory.size(); ++i)
+  {
+    picojson::object usage;
+    usage["current_bytes"] = picojson::value(static_cast<double>(snapshot.memory[i].current));
+    usage["peak_bytes"] = picojson::value(static_cast<double>(snapshot.memory[i].peak));
+    usage["budget_bytes"] = picojson::value(static_cast<double>(snapshot.memory[i].budget));
+    memory[std::string(
+        Common::MemoryAccounting::GetName(static_cast<Common::MemoryAccounting::Subsystem>(i)))] =
+        picojson::value(std::move(usage));
+  }
+
+  picojson::object root;
+  root["fps"] = picojson::value(snapshot.fps);
+  root["vps"] = picojson::value(snapshot.vps);
+  root["speed"] = picojson::value(snapshot.speed);
+  root["max_speed"] = picojson::value(snapshot.max_speed);
+  root["frame_time_ms"] = picojson::value(std::move(frame_time_ms));
+  root["cpu_thread_busy_seconds"] = picojson::value(snapshot.cpu_busy_s);
+  root["gpu_thread_busy_seconds"] = picojson::value(snapshot.gpu_busy_s);
+  root["shaders_created"] = picojson::value(std::move(shaders_created));
+  root["audio_underruns"] = picojson::value(static_cast<double>(snapshot.audio_underruns));
+  root["memory"] = picojson::value(std::move(memory));
+  return picojson::value(std::move(root)).serialize() + '\n';
+}
+
+bool WaitForReadable(int socket, long timeout_us)
+{
+  fd_set read_fds;
+  FD_ZERO(&read_fds);
+  FD_SET(socket, &read_fds);
+  timeval timeout{timeout_us / 1'000'000, timeout_us % 1'000'000};
+  return select(socket + 1, &read_fds, nullptr, nullptr, &timeout) > 0;
+}
+
+void SendAll(int socket, std::string_view data)
+{
+  while (!data.empty())
+  {
+    const ssize_t sent = send(socket, data.data(), static_cast<int>(data.size()), SEND_FLAGS);
+    if (sent <= 0)
+      return;
+    data.remove_prefix(static_cast<size_t>(sent));
+  }
+}
+
+void SendResponse(int socket, std::string_view status, std::string_view content_type,
+                  std::string_view body)
+{
+  SendAll(socket, fmt::format("HTTP/1.1 {}\r\nContent-Type: {}\r\nContent-Length: {}\r\n"
+                              "Connection: close\r\n\r\n",
+                              status, content_type, body.size()));
+  SendAll(socket, body);
+}
+}  // namespace
+
+std::unique_ptr<MetricsServer> MetricsServer::Create(System& system)
+{
+#ifndef _WIN32
+  if (Config::Get(Config::MAIN_METRICS_SERVER_SOCKET).empty() &&
+      Config::Get(Config::MAIN_METRICS_SERVER_PORT) <= 0)
+#else
+  if (Config::Get(Config::MAIN_METRICS_SERVER_PORT) <= 0)
+#endif
+  {
+    return nullptr;
+  }
+
+  auto server = std::make_unique<MetricsServer>(system);
+  if (!server->Listen())
+    return nullptr;
+
+  server->m_running.store(true);
+  server->m_thread = std::thread(&MetricsServer::ThreadFunc, server.get());
+  return server;
+}
+
+MetricsServer::MetricsServer(System& system) : m_system(system)
+{
+}
+
+MetricsServer::~MetricsServer()
+{
+  m_running.store(false);
+  if (m_thread.joinable())
+    m_thread.join();
+
+  if (m_socket != -1)
+    CloseSocket(m_socket);
+  g_perf_metrics.SetBusySamplingEnabled(false);
+}
+
+bool MetricsServer::Listen()
+{
+#ifndef _WIN32
+  const std::string socket_path = Config::Get(Config::MAIN_METRICS_SERVER_SOCKET);
+  if (!socket_path.empty())
+  {
+    sockaddr_un addr = {};
+    addr.sun_family = AF_UNIX;
+    if (socket_path.size() >= sizeof(addr.sun_path))
+    {
+      ERROR_LOG_FMT(CORE, "Metrics server socket path is too long: {}", socket_path);
+      return false;
+    }
+    std::memcpy(addr.sun_path, socket_path.c_str(), socket_path.size());
+    unlink(socket_path.c_str());
+
+    m_socket = socket(PF_LOCAL, SOCK_STREAM, 0);
+    if (m_socket == -1 ||
+        bind(m_socket, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) < 0 ||
+        listen(m_socket, 4) < 0)
+    {
+      ERROR_LOG_FMT(CORE, "Failed to listen for metrics clients on {}", socket_path);
+      return false;
+    }
+
+    NOTICE_LOG_FMT(CORE, "Serving metrics on {}", socket_path);
+    return true;
+  }
+#endif
+
+  const int port = Config::Get(Config::MAIN_METRICS_SERVER_PORT);
+  sockaddr_in addr = {};
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(static_cast<u16>(port));
+  // Metrics are only meant for the local machine.
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+  m_socket = static_cast<int>(socket(PF_INET, SOCK_STREAM, 0));
+  if (m_socket == -1)
+  {
+    ERROR_LOG_FMT(CORE, "Failed to create the metrics server socket");
+    return false;
+  }
+
+  int on = 1;
+  setsockopt(m_socket, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&on), sizeof(on));
+  if (bind(m_socket, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) < 0 ||
+      listen(m_socket, 4) < 0)
+  {
+    ERROR_LOG_FMT(CORE, "Failed to listen for metrics clients on port {}", port);
+    return false;
+  }
+
+  NOTICE_LOG_FMT(CORE, "Serving metrics on http://127.0.0.1:{}/metrics", port);
+  return true;
+}
+
+void MetricsServer::ThreadFunc()
+{
+  Common::SetCurrentThreadName("Metrics server");
+
+  auto last_request = std::chrono::steady_clock::time_point{};
+  while (m_running.load(std::memory_order_relaxed))
+  {
+    if (WaitForReadable(m_socket, POLL_INTERVAL_US))
+    {
+      const int client = static_cast<int>(accept(m_socket, nullptr, nullptr));
+      if (client != -1)
+      {
+#ifdef SO_NOSIGPIPE
+        // Clients that hang up early mustn't kill the process.
+        int on = 1;
+        setsockopt(client, SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on));
+#endif
+        g_perf_metrics.SetBusySamplingEnabled(true);
+        last_request = std::chrono::steady_clock::now();
+
+        HandleClient(client);
+        shutdown(client, SHUT_RDWR);
+        CloseSocket(client);
+      }
+    }
+
+    if (g_perf_metrics.IsBusySamplingEnabled() &&
+        std::chrono::steady_clock::now() - last_request > SAMPLING_IDLE_TIMEOUT)
+    {
+      g_perf_metrics.SetBusySamplingEnabled(false);
+    }
+  }
+}
+
+void MetricsServer::HandleClient(int client)
+{
+  std::string request;
+  while (request.find("\r\n\r\n") == std::string::npos && request.size() < MAX_REQUEST_SIZE)
+  {
+    if (!WaitForReadable(client, REQUEST_TIMEOUT_US))
+      return;
+
+    char buffer[512];
+    const ssize_t received = recv(client, buffer, sizeof(buffer), 0);
+    if (received <= 0)
+      return;
+    request.append(buffer, static_cast<size_t>(received));
+  }
+
+  // Only the request line matters: "GET /metrics HTTP/1.1".
+  const std::string_view request_line =
+      std::string_view(request).substr(0, request.find_first_of("\r\n"));
+  const size_t method_end = request_line.find(' ');
+  const size_t path_end = request_line.find(' ', method_end + 1);
+  if (method_end == std::string_view::npos || path_end == std::string_view::npos)
+  {
+    SendResponse(client, "400 Bad Request", "text/plain", "Bad request\n");
+    return;
+  }
+
+  const std::string_view method = request_line.substr(0, method_end);
+  std::string_view path = request_line.substr(method_end + 1, path_end - method_end - 1);
+  path = path.substr(0, path.find('?'));
+
+  if (method != "GET")
+  {
+    SendResponse(client, "405 Method Not Allowed", "text/plain", "Only GET is supported\n");
+    return;
+  }
+
+  if (path == "/metrics")
+  {
+    SendResponse(client, "200 OK", "text/plain; version=0.0.4",
+                 FormatPrometheus(TakeSnapshot(m_system)));
+  }
+  else if (path == "/metrics.json")
+  {
+    SendResponse(client, "200 OK", "application/json", FormatJson(TakeSnapshot(m_system)));
+  }
+  else
+  {
+    SendResponse(client, "404 Not Found", "text/plain", "Try /metrics or /metrics.json\n");
+  }
+}
+}  // namespace Core
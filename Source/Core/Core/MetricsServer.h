@@ -0,0 +1,46 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <thread>
+
+#include "Common/CommonTypes.h"
+#include "Common/SocketContext.h"
+
+namespace Core
+{
+class System;
+
+// Serves performance metrics over HTTP on a local TCP port or UNIX socket, for monitoring headless
+// runs. GET /metrics returns the Prometheus text format and GET /metrics.json returns JSON.
+//
+// Nothing is sampled until a client asks for metrics. Timing the GPU thread is then enabled, and
+// disabled again once no client has asked for a while.
+class MetricsServer final
+{
+public:
+  // Returns nullptr if the server isn't enabled in the config or the socket couldn't be opened.
+  static std::unique_ptr<MetricsServer> Create(System& system);
+
+  explicit MetricsServer(System& system);
+  ~MetricsServer();
+
+  MetricsServer(const MetricsServer&) = delete;
+  MetricsServer& operator=(const MetricsServer&) = delete;
+
+private:
+  bool Listen();
+  void ThreadFunc();
+  void HandleClient(int client);
+
+  System& m_system;
+  Common::SocketContext m_socket_context;
+  int m_socket = -1;
+
+  std::thread m_thread;
+  std::atomic<bool> m_running = false;
+};
+}  // namespace Core
@@ -28,6 +28,7 @@
 #include "Common/FileUtil.h"
 #include "Common/Hash.h"
 #include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
 #include "Common/NandPaths.h"
 #include "Common/StringUtil.h"
@@ -118,8 +119,12 @@ static std::array<u8, 20> ConvertGitRevisionToBytes(const std::string& revision)
   return revision_bytes;
 }
 
+// Number of frames between writes to the recovery file
+constexpr u64 JOURNAL_INTERVAL = 300;
+
 MovieManager::MovieManager(Core::System& system) : m_system(system)
 {
+  m_journal_thread.Reset("Movie Journal", [this](JournalChunk chunk) { WriteJournalChunk(chunk); });
 }
 
 MovieManager::~MovieManager() = default;
@@ -193,11 +198,66 @@ void MovieManager::FrameUpdate()
   {
     m_total_frames = m_current_frame;
     m_total_lag_count = m_current_lag_count;
+
+    if (m_current_frame - m_journal_frame >= JOURNAL_INTERVAL)
+      UpdateJournal();
   }
 
   m_polled = false;
 }
 
+static std::string GetJournalPath()
+{
+  return File::GetUserPath(D_STATESAVES_IDX) + "recovery.dtm";
+}
+
+// Queues the input recorded since the last update. After m_temp_input has been replaced or
+// truncated by loading a state, the whole input log is written again.
+void MovieManager::UpdateJournal()
+{
+  if (!Config::Get(Config::MAIN_MOVIE_WRITE_RECOVERY_FILE))
+    return;
+
+  m_journal_frame = m_current_frame;
+  if (m_journal_bytes > m_temp_input.size())
+    m_journal_bytes = 0;
+
+  JournalChunk chunk{CreateHeader(), m_journal_bytes, {}};
+  chunk.data.assign(m_temp_input.begin() + m_journal_bytes, m_temp_input.end());
+  m_journal_bytes = m_temp_input.size();
+  m_journal_thread.Push(std::move(chunk));
+}
+
+// NOTE: Journal Thread
+void MovieManager::WriteJournalChunk(const JournalChunk& chunk)
+{
+  if (chunk.offset == 0)
+  {
+    if (!m_journal_file.Open(GetJournalPath(), "wb"))
+    {
+      ERROR_LOG_FMT(CORE, "Failed to create movie recovery file {}", GetJournalPath());
+      return;
+    }
+  }
+  else if (!m_journal_file)
+  {
+    return;
+  }
+
+  // The input is written before the header, so that the header never refers to input that isn't
+  // in the file yet.
+  const bool success =
+      m_journal_file.Seek(sizeof(DTMHeader) + chunk.offset, File::SeekOrigin::Begin) &&
+      m_journal_file.WriteBytes(chunk.data.data(), chunk.data.size()) &&
+      m_journal_file.Seek(0, File::SeekOrigin::Begin) &&
+      m_journal_file.WriteArray(&chunk.header, 1) && m_journal_file.Flush();
+  if (!success)
+  {
+    ERROR_LOG_FMT(CORE, "Failed to write movie recovery file {}", GetJournalPath());
+    m_journal_file.Close();
+  }
+}
+
 // called when game is booting up, even if no movie is active,
 // but potentially after BeginRecordingInput or PlayInput has been called.
 // NOTE: EmuThread
@@ -562,6 +622,8 @@ bool MovieManager::BeginRecordingInput(const ControllerTypeArray& controllers,
     m_temp_input.clear();
 
     m_current_byte = 0;
+    m_journal_bytes = 0;
+    m_journal_frame = 0;
 
     // This is a bit of a hack, SYSCONF movie code expects the movie layer active for both recording
     // and playback. That layer is really only designed for playback, not recording. Also, we can't
@@ -1059,6 +1121,7 @@ void MovieManager::LoadInput(const std::string& movie_path)
 
     m_temp_input.resize(static_cast<size_t>(totalSavedBytes));
     t_record.ReadBytes(m_temp_input.data(), m_temp_input.size());
+    m_journal_bytes = 0;
   }
   else if (m_current_byte > 0)
   {
@@ -1358,11 +1421,8 @@ void MovieManager::EndPlayInput(bool cont)
   }
 }
 
-// NOTE: Save State + Host Thread
-void MovieManager::SaveRecording(const std::string& filename)
+DTMHeader MovieManager::CreateHeader() const
 {
-  File::IOFile save_record(filename, "wb");
-  // Create the real header now and write it
   DTMHeader header;
   memset(&header, 0, sizeof(DTMHeader));
 
@@ -1409,6 +1469,15 @@ void MovieManager::SaveRecording(const std::string& filename)
   header.uniqueID = 0;
   // header.audioEmulator;
 
+  return header;
+}
+
+// NOTE: Save State + Host Thread
+void MovieManager::SaveRecording(const std::string& filename)
+{
+  File::IOFile save_record(filename, "wb");
+  // Create the real header now and write it
+  const DTMHeader header = CreateHeader();
   save_record.WriteArray(&header, 1);
 
   bool success = save_record.WriteBytes(m_temp_input.data(), m_temp_input.size());
@@ -1550,6 +1619,10 @@ void MovieManager::GetMD5()
 // NOTE: EmuThread
 void MovieManager::Shutdown()
 {
+  if (IsRecordingInput())
+    UpdateJournal();
+  m_journal_thread.WaitForCompletion();
+
   m_current_input_count = m_total_input_count = m_total_frames = m_tick_count_at_last_input = 0;
   m_temp_input.clear();
 }
@@ -12,6 +12,8 @@
 #include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Common/IOFile.h"
+#include "Common/WorkQueueThread.h"
 
 struct BootParameters;
 
@@ -226,6 +228,18 @@ public:
   std::string GetRerecords() const;
 
 private:
+  // A piece of the input log, written to the recovery file on the journal thread.
+  struct JournalChunk
+  {
+    DTMHeader header;
+    u64 offset;
+    std::vector<u8> data;
+  };
+
+  DTMHeader CreateHeader() const;
+  void UpdateJournal();
+  void WriteJournalChunk(const JournalChunk& chunk);
+
   void GetSettings();
   void CheckInputEnd();
 
@@ -274,6 +288,13 @@ private:
   std::mutex m_input_display_lock;
   std::array<std::string, 8> m_input_display;
 
+  // The recording is continuously written to a recovery file, so that it isn't lost on a crash.
+  // m_journal_bytes is the amount of m_temp_input that has been queued for writing so far.
+  u64 m_journal_bytes = 0;
+  u64 m_journal_frame = 0;
+  File::IOFile m_journal_file;
+  Common::WorkQueueThread<JournalChunk> m_journal_thread;
+
   Core::System& m_system;
 };
 
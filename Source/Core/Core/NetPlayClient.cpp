@@ -4,8 +4,10 @@
 #include "Core/NetPlayClient.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cstddef>
 #include <cstring>
+#include <filesystem>
 #include <fstream>
 #include <functional>
 #include <memory>
@@ -24,6 +26,7 @@
 #include "Common/Crypto/SHA1.h"
 #include "Common/ENet.h"
 #include "Common/FileUtil.h"
+#include "Common/Hash.h"
 #include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
 #include "Common/NandPaths.h"
@@ -49,6 +52,7 @@
 #include "Core/HW/GBAPad.h"
 #include "Core/HW/GCMemcard/GCMemcard.h"
 #include "Core/HW/GCPad.h"
+#include "Core/HW/Memmap.h"
 #include "Core/HW/SI/SI.h"
 #include "Core/HW/SI/SI_Device.h"
 #include "Core/HW/SI/SI_DeviceGCController.h"
@@ -399,6 +403,14 @@ void NetPlayClient::OnData(sf::Packet& packet)
     OnWiimoteData(packet);
     break;
 
+  case MessageID::InputBundle:
+    OnInputBundle(packet);
+    break;
+
+  case MessageID::InputAck:
+    OnInputAck(packet);
+    break;
+
   case MessageID::PadBuffer:
     OnPadBuffer(packet);
     break;
@@ -723,6 +735,26 @@ void NetPlayClient::OnPadHostData(sf::Packet& packet)
   }
 }
 
+void NetPlayClient::OnInputBundle(sf::Packet& packet)
+{
+  for (sf::Packet& message : m_input_receiver.Receive(packet, m_current_game))
+    OnData(message);
+
+  sf::Packet ack_packet;
+  ack_packet << MessageID::InputAck;
+  m_input_receiver.AppendAcknowledgement(ack_packet);
+  Common::ENet::SendPacket(m_server, ack_packet, INPUT_CHANNEL, false);
+}
+
+void NetPlayClient::OnInputAck(sf::Packet& packet)
+{
+  u32 game, next_sequence;
+  packet >> game >> next_sequence;
+
+  std::lock_guard lk(m_crit.input_stream);
+  m_input_sender.Acknowledge(game, next_sequence);
+}
+
 void NetPlayClient::OnWiimoteData(sf::Packet& packet)
 {
   while (!packet.endOfPacket())
@@ -1037,6 +1069,28 @@ void NetPlayClient::OnSyncSaveData(sf::Packet& packet)
   }
 }
 
+// The save data of the previous session gets replaced by the new one, which usually only differs
+// from it in a few places.
+static ChunkStore IndexPreviousSaveData()
+{
+  ChunkStore store;
+  const auto add_netplay_entries = [&store](const std::string& folder, std::string_view prefix) {
+    for (const File::FSTEntry& entry : File::ScanDirectoryTree(folder, false).children)
+    {
+      if (entry.virtualName.starts_with(prefix))
+        AddChunksToStore(entry.physicalName, store);
+    }
+  };
+
+  // Raw memory cards and the GCI folders
+  add_netplay_entries(File::GetUserPath(D_GCUSER_IDX), GC_MEMCARD_NETPLAY);
+  add_netplay_entries(File::GetUserPath(D_GBAUSER_IDX), GBA_SAVE_NETPLAY);
+  AddChunksToStore(File::GetUserPath(D_USER_IDX) + "Wii" GC_MEMCARD_NETPLAY, store);
+  AddChunksToStore(File::GetUserPath(D_USER_IDX) + "Redirect" GC_MEMCARD_NETPLAY, store);
+
+  return store;
+}
+
 void NetPlayClient::OnSyncSaveDataNotify(sf::Packet& packet)
 {
   packet >> m_sync_save_data_count;
@@ -1045,9 +1099,25 @@ void NetPlayClient::OnSyncSaveDataNotify(sf::Packet& packet)
   INFO_LOG_FMT(NETPLAY, "Initializing wait for {} savegame chunks.", m_sync_save_data_count);
 
   if (m_sync_save_data_count == 0)
+  {
     SyncSaveDataResponse(true);
-  else
-    m_dialog->AppendChat(Common::GetStringT("Synchronizing save data..."));
+    return;
+  }
+
+  m_dialog->AppendChat(Common::GetStringT("Synchronizing save data..."));
+
+  // Tell the server which chunks we have, it only sends the others.
+  m_sync_save_data_chunks = IndexPreviousSaveData();
+  INFO_LOG_FMT(NETPLAY, "Found {} chunks of previous save data.", m_sync_save_data_chunks.size());
+
+  sf::Packet response_packet;
+  response_packet << MessageID::SyncSaveData;
+  response_packet << SyncSaveDataID::ChunkDigests;
+  response_packet << static_cast<u32>(m_sync_save_data_chunks.size());
+  for (const auto& [digest, chunk] : m_sync_save_data_chunks)
+    response_packet.append(digest.data(), digest.size());
+
+  Send(response_packet);
 }
 
 void NetPlayClient::OnSyncSaveDataRaw(sf::Packet& packet)
@@ -1084,7 +1154,7 @@ void NetPlayClient::OnSyncSaveDataRaw(sf::Packet& packet)
     return;
   }
 
-  const bool success = DecompressPacketIntoFile(packet, path);
+  const bool success = DecompressPacketIntoFile(packet, path, &m_sync_save_data_chunks);
   SyncSaveDataResponse(success);
 }
 
@@ -1116,7 +1186,7 @@ void NetPlayClient::OnSyncSaveDataGCI(sf::Packet& packet)
     INFO_LOG_FMT(NETPLAY, "Received GCI: {}", file_name);
 
     if (!Common::IsFileNameSafe(file_name) ||
-        !DecompressPacketIntoFile(packet, path + DIR_SEP + file_name))
+        !DecompressPacketIntoFile(packet, path + DIR_SEP + file_name, &m_sync_save_data_chunks))
     {
       WARN_LOG_FMT(NETPLAY, "Received invalid GCI.");
       SyncSaveDataResponse(false);
@@ -1161,7 +1231,7 @@ void NetPlayClient::OnSyncSaveDataWii(sf::Packet& packet)
   {
     INFO_LOG_FMT(NETPLAY, "Received Mii data.");
 
-    auto buffer = DecompressPacketIntoBuffer(packet);
+    auto buffer = DecompressPacketIntoBuffer(packet, &m_sync_save_data_chunks);
 
     temp_fs->CreateFullPath(IOS::PID_KERNEL, IOS::PID_KERNEL, "/shared2/menu/FaceLib/", 0,
                             fs_modes);
@@ -1240,7 +1310,7 @@ void NetPlayClient::OnSyncSaveDataWii(sf::Packet& packet)
 
       if (file.type == WiiSave::Storage::SaveFile::Type::File)
       {
-        auto buffer = DecompressPacketIntoBuffer(packet);
+        auto buffer = DecompressPacketIntoBuffer(packet, &m_sync_save_data_chunks);
         if (!buffer)
         {
           SyncSaveDataResponse(false);
@@ -1266,7 +1336,7 @@ void NetPlayClient::OnSyncSaveDataWii(sf::Packet& packet)
   if (has_redirected_save)
   {
     INFO_LOG_FMT(NETPLAY, "Received redirected save.");
-    if (!DecompressPacketIntoFolder(packet, redirect_path))
+    if (!DecompressPacketIntoFolder(packet, redirect_path, &m_sync_save_data_chunks))
     {
       PanicAlertFmtT("Failed to write redirected save.");
       SyncSaveDataResponse(false);
@@ -1295,7 +1365,7 @@ void NetPlayClient::OnSyncSaveDataGBA(sf::Packet& packet)
     return;
   }
 
-  const bool success = DecompressPacketIntoFile(packet, path);
+  const bool success = DecompressPacketIntoFile(packet, path, &m_sync_save_data_chunks);
   SyncSaveDataResponse(success);
 }
 
@@ -1525,6 +1595,44 @@ void NetPlayClient::Send(const sf::Packet& packet, const u8 channel_id)
   Common::ENet::SendPacket(m_server, packet, channel_id);
 }
 
+// called from ---CPU--- thread
+void NetPlayClient::SendInputAsync(sf::Packet&& packet)
+{
+  // Golf mode relies on the input staying in order with the other messages
+  if (m_host_input_authority)
+  {
+    SendAsync(std::move(packet));
+    return;
+  }
+
+  {
+    std::lock_guard lk(m_crit.input_stream);
+    m_input_sender.Push(m_current_game, std::move(packet));
+    m_input_sender_has_new_messages = true;
+  }
+  Common::ENet::WakeupThread(m_client);
+}
+
+// called from ---NETPLAY--- thread
+void NetPlayClient::FlushInputStream()
+{
+  std::lock_guard lk(m_crit.input_stream);
+  if (!m_input_sender.HasUnacknowledged())
+    return;
+
+  const auto now = std::chrono::steady_clock::now();
+  if (!m_input_sender_has_new_messages && now - m_input_last_sent < INPUT_RESEND_INTERVAL)
+    return;
+
+  sf::Packet packet;
+  packet << MessageID::InputBundle;
+  m_input_sender.AppendToPacket(packet);
+  Common::ENet::SendPacket(m_server, packet, INPUT_CHANNEL, false);
+
+  m_input_sender_has_new_messages = false;
+  m_input_last_sent = now;
+}
+
 void NetPlayClient::DisplayPlayersPing()
 {
   if (!g_ActiveConfig.bShowNetPlayPing)
@@ -1607,7 +1715,15 @@ void NetPlayClient::ThreadFunc()
     int net;
     if (m_traversal_client)
       m_traversal_client->HandleResends();
-    net = enet_host_service(m_client, &netEvent, 250);
+
+    // Wake up in time to send unacknowledged input again
+    bool input_pending;
+    {
+      std::lock_guard lk(m_crit.input_stream);
+      input_pending = m_input_sender.HasUnacknowledged();
+    }
+    net = enet_host_service(m_client, &netEvent,
+                            input_pending ? static_cast<u32>(INPUT_RESEND_INTERVAL.count()) : 250);
     while (!m_async_queue.Empty())
     {
       INFO_LOG_FMT(NETPLAY, "Processing async queue event.");
@@ -1618,6 +1734,7 @@ void NetPlayClient::ThreadFunc()
       INFO_LOG_FMT(NETPLAY, "Processing async queue event done.");
       m_async_queue.Pop();
     }
+    FlushInputStream();
     if (net > 0)
     {
       sf::Packet rpac;
@@ -1751,6 +1868,7 @@ bool NetPlayClient::StartGame(const std::string& path)
   }
 
   m_timebase_frame = 0;
+  m_state_hash = Common::StartCRC32();
   m_current_golfer = 1;
   m_wait_on_input = false;
 
@@ -1827,6 +1945,8 @@ void NetPlayClient::SyncSaveDataResponse(const bool success)
   {
     if (++m_sync_save_data_success_count >= m_sync_save_data_count)
     {
+      m_sync_save_data_chunks.clear();
+
       sf::Packet response_packet;
       response_packet << MessageID::SyncSaveData;
       response_packet << SyncSaveDataID::Success;
@@ -1836,6 +1956,8 @@ void NetPlayClient::SyncSaveDataResponse(const bool success)
   }
   else
   {
+    m_sync_save_data_chunks.clear();
+
     sf::Packet response_packet;
     response_packet << MessageID::SyncSaveData;
     response_packet << SyncSaveDataID::Failure;
@@ -2053,7 +2175,7 @@ bool NetPlayClient::GetNetPads(const int pad_nb, const bool batching, GCPadStatu
     }
 
     if (send_packet)
-      SendAsync(std::move(packet));
+      SendInputAsync(std::move(packet));
 
     if (m_host_input_authority)
       SendPadHostPoll(-1);
@@ -2067,7 +2189,7 @@ bool NetPlayClient::GetNetPads(const int pad_nb, const bool batching, GCPadStatu
       sf::Packet packet;
       packet << MessageID::PadData;
       if (PollLocalPad(local_pad, packet))
-        SendAsync(std::move(packet));
+        SendInputAsync(std::move(packet));
     }
 
     if (m_host_input_authority)
@@ -2149,7 +2271,7 @@ bool NetPlayClient::WiimoteUpdate(const std::span<WiimoteDataBatchEntry>& entrie
       sf::Packet packet;
       packet << MessageID::WiimoteData;
       if (AddLocalWiimoteToBuffer(local_wiimote, *entry.state, packet))
-        SendAsync(std::move(packet));
+        SendInputAsync(std::move(packet));
     }
 
     // Now, we either use the data pushed earlier, or wait for the
@@ -2518,20 +2640,57 @@ void NetPlayClient::SendGameStatus()
   Send(packet);
 }
 
+// The players compare their state every DESYNC_CHECK_INTERVAL frames. Memory is hashed one slice
+// per frame, so that all of it is covered once per interval without spiking the frame time.
+constexpr u32 DESYNC_CHECK_INTERVAL = 60;
+
+static u32 UpdateStateHash(Core::System& system, u32 slice, u32 hash)
+{
+  const auto hash_slice = [slice, &hash](const u8* data, u32 size) {
+    const u32 begin = static_cast<u32>(u64{size} * slice / DESYNC_CHECK_INTERVAL);
+    const u32 end = static_cast<u32>(u64{size} * (slice + 1) / DESYNC_CHECK_INTERVAL);
+    hash = Common::UpdateCRC32(hash, data + begin, end - begin);
+  };
+
+  auto& memory = system.GetMemory();
+  hash_slice(memory.GetRAM(), memory.GetRamSizeReal());
+  if (memory.GetEXRAM())
+    hash_slice(memory.GetEXRAM(), memory.GetExRamSizeReal());
+
+  const auto& ppc_state = system.GetPPCState();
+  hash = Common::UpdateCRC32(hash, reinterpret_cast<const u8*>(&ppc_state.pc),
+                             sizeof(ppc_state.pc));
+  hash = Common::UpdateCRC32(hash, reinterpret_cast<const u8*>(ppc_state.gpr),
+                             sizeof(ppc_state.gpr));
+  hash = Common::UpdateCRC32(hash, reinterpret_cast<const u8*>(ppc_state.ps), sizeof(ppc_state.ps));
+
+  return hash;
+}
+
 void NetPlayClient::SendTimeBase()
 {
   std::lock_guard lk(crit_netplay_client);
 
-  if (netplay_client->m_timebase_frame % 60 == 0)
+  auto& system = Core::System::GetInstance();
+  const u32 slice = netplay_client->m_timebase_frame % DESYNC_CHECK_INTERVAL;
+
+  // In dual core mode the GPU thread writes EFB copies to memory whenever it gets to them, so the
+  // state at a given frame differs between players even when they're in sync.
+  if (!system.IsDualCoreMode())
+    netplay_client->m_state_hash = UpdateStateHash(system, slice, netplay_client->m_state_hash);
+
+  if (slice == 0)
   {
-    const sf::Uint64 timebase = Core::System::GetInstance().GetSystemTimers().GetFakeTimeBase();
+    const sf::Uint64 timebase = system.GetSystemTimers().GetFakeTimeBase();
 
     sf::Packet packet;
     packet << MessageID::TimeBase;
     packet << timebase;
     packet << netplay_client->m_timebase_frame;
+    packet << netplay_client->m_state_hash;
 
     netplay_client->SendAsync(std::move(packet));
+    netplay_client->m_state_hash = Common::StartCRC32();
   }
 
   netplay_client->m_timebase_frame++;
@@ -2546,35 +2705,154 @@ bool NetPlayClient::DoAllPlayersHaveGame()
   });
 }
 
+// The image is split into ranges which are hashed on several threads. The digest is the SHA-1 of
+// the ranges' SHA-1s, so it doesn't depend on the number of threads.
+constexpr u64 GAME_DIGEST_RANGE_SIZE = 64 * 1024 * 1024;
+constexpr u64 GAME_DIGEST_READ_SIZE = 8 * 1024 * 1024;
+
 static std::string SHA1Sum(const std::string& file_path, std::function<bool(int)> report_progress)
 {
-  std::vector<u8> data(8 * 1024 * 1024);
-  u64 read_offset = 0;
-
   std::unique_ptr<DiscIO::BlobReader> file(DiscIO::CreateBlobReader(file_path));
-  u64 game_size = file->GetDataSize();
+  if (!file)
+    return "";
 
-  auto ctx = Common::SHA1::CreateContext();
+  const u64 game_size = file->GetDataSize();
+  const u64 range_count = (game_size + GAME_DIGEST_RANGE_SIZE - 1) / GAME_DIGEST_RANGE_SIZE;
 
-  while (read_offset < game_size)
-  {
-    size_t read_size = std::min(static_cast<u64>(data.size()), game_size - read_offset);
-    if (!file->Read(read_offset, read_size, data.data()))
-      return "";
+  std::vector<Common::SHA1::Digest> range_digests(range_count);
+  std::atomic<u64> next_range = 0;
+  std::atomic<u64> bytes_hashed = 0;
+  std::atomic<bool> failed = false;
 
-    ctx->Update(data.data(), read_size);
-    read_offset += read_size;
+  // Only the calling thread reports the progress, report_progress isn't threadsafe
+  const auto hash_ranges = [&](DiscIO::BlobReader* reader, bool report) {
+    std::vector<u8> data(GAME_DIGEST_READ_SIZE);
+    for (u64 range = next_range++; range < range_count && !failed; range = next_range++)
+    {
+      const u64 range_end = std::min(game_size, (range + 1) * GAME_DIGEST_RANGE_SIZE);
+      auto ctx = Common::SHA1::CreateContext();
 
-    int progress =
-        static_cast<int>(static_cast<float>(read_offset) / static_cast<float>(game_size) * 100);
-    if (!report_progress(progress))
-      return "";
+      for (u64 offset = range * GAME_DIGEST_RANGE_SIZE; offset < range_end;)
+      {
+        const u64 read_size = std::min(GAME_DIGEST_READ_SIZE, range_end - offset);
+        if (!reader->Read(offset, read_size, data.data()))
+        {
+          failed = true;
+          return;
+        }
+
+        ctx->Update(data.data(), read_size);
+        offset += read_size;
+
+        const u64 total_hashed = bytes_hashed += read_size;
+        const float fraction = static_cast<float>(total_hashed) / static_cast<float>(game_size);
+        const int progress = static_cast<int>(fraction * 100);
+        if (report && !report_progress(progress))
+        {
+          failed = true;
+          return;
+        }
+      }
+
+      range_digests[range] = ctx->Finish();
+    }
+  };
+
+  const u64 thread_count =
+      std::min<u64>(range_count, std::max(std::thread::hardware_concurrency(), 1u));
+  std::vector<std::unique_ptr<DiscIO::BlobReader>> readers;
+  std::vector<std::thread> threads;
+  for (u64 i = 1; i < thread_count; ++i)
+  {
+    // Blob readers can't be shared between threads
+    std::unique_ptr<DiscIO::BlobReader> reader = file->CopyReader();
+    if (!reader)
+      break;
+    threads.emplace_back(hash_ranges, reader.get(), false);
+    readers.push_back(std::move(reader));
   }
 
+  hash_ranges(file.get(), true);
+  for (std::thread& thread : threads)
+    thread.join();
+
+  if (failed)
+    return "";
+
+  auto ctx = Common::SHA1::CreateContext();
+  for (const Common::SHA1::Digest& digest : range_digests)
+    ctx->Update(digest.data(), digest.size());
+
   // Convert to hex
   return fmt::format("{:02x}", fmt::join(ctx->Finish(), ""));
 }
 
+// Digests are cached along with the size and modification time of the file they were computed
+// for, one "digest size mtime path" line per file.
+static std::string GetGameDigestCachePath()
+{
+  return File::GetUserPath(D_CACHE_IDX) + "netplay_digests.cache";
+}
+
+static std::string GetGameDigestCacheKey(const std::string& file_path)
+{
+  const std::filesystem::path fs_path = StringToPath(file_path);
+  std::error_code error;
+
+  const std::uintmax_t size = std::filesystem::file_size(fs_path, error);
+  if (error)
+    return "";
+
+  const std::filesystem::file_time_type mtime = std::filesystem::last_write_time(fs_path, error);
+  if (error)
+    return "";
+
+  return fmt::format("{} {} {}", size, mtime.time_since_epoch().count(), file_path);
+}
+
+static std::vector<std::pair<std::string, std::string>> ReadGameDigestCache()
+{
+  std::vector<std::pair<std::string, std::string>> entries;
+
+  std::string contents;
+  if (!File::ReadFileToString(GetGameDigestCachePath(), contents))
+    return entries;
+
+  for (const std::string& line : SplitString(contents, '\n'))
+  {
+    const size_t separator = line.find(' ');
+    if (separator != std::string::npos)
+      entries.emplace_back(line.substr(0, separator), line.substr(separator + 1));
+  }
+
+  return entries;
+}
+
+static std::string LookUpCachedGameDigest(const std::string& key)
+{
+  for (const auto& [digest, entry_key] : ReadGameDigestCache())
+  {
+    if (entry_key == key)
+      return digest;
+  }
+  return "";
+}
+
+static void CacheGameDigest(const std::string& file_path, const std::string& key,
+                            const std::string& digest)
+{
+  std::string contents = fmt::format("{} {}\n", digest, key);
+  for (const auto& [entry_digest, entry_key] : ReadGameDigestCache())
+  {
+    // Drop the outdated digests of the same file
+    if (!entry_key.ends_with(" " + file_path))
+      contents += fmt::format("{} {}\n", entry_digest, entry_key);
+  }
+
+  if (!File::WriteStringToFile(GetGameDigestCachePath(), contents))
+    WARN_LOG_FMT(NETPLAY, "Failed to write the game digest cache.");
+}
+
 void NetPlayClient::ComputeGameDigest(const SyncIdentifier& sync_identifier)
 {
   if (m_should_compute_game_digest)
@@ -2601,14 +2879,26 @@ void NetPlayClient::ComputeGameDigest(const SyncIdentifier& sync_identifier)
   if (m_game_digest_thread.joinable())
     m_game_digest_thread.join();
   m_game_digest_thread = std::thread([this, file]() {
-    std::string sum = SHA1Sum(file, [&](int progress) {
-      sf::Packet packet;
-      packet << MessageID::GameDigestProgress;
-      packet << progress;
-      SendAsync(std::move(packet));
+    const std::string cache_key = GetGameDigestCacheKey(file);
+    std::string sum = cache_key.empty() ? "" : LookUpCachedGameDigest(cache_key);
+    if (!sum.empty())
+    {
+      INFO_LOG_FMT(NETPLAY, "Using the cached digest of {}.", file);
+    }
+    else
+    {
+      sum = SHA1Sum(file, [&](int progress) {
+        sf::Packet packet;
+        packet << MessageID::GameDigestProgress;
+        packet << progress;
+        SendAsync(std::move(packet));
 
-      return m_should_compute_game_digest;
-    });
+        return m_should_compute_game_digest;
+      });
+
+      if (!sum.empty() && !cache_key.empty())
+        CacheGameDigest(file, cache_key, sum);
+    }
 
     sf::Packet packet;
     packet << MessageID::GameDigestResult;
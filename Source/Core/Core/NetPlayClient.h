@@ -20,6 +20,7 @@
 #include "Common/Event.h"
 #include "Common/SPSCQueue.h"
 #include "Common/TraversalClient.h"
+#include "Core/NetPlayCommon.h"
 #include "Core/NetPlayProto.h"
 #include "Core/SyncIdentifier.h"
 #include "InputCommon/GCPadStatus.h"
@@ -194,10 +195,18 @@ protected:
     // lock order
     std::recursive_mutex players;
     std::recursive_mutex async_queue_write;
+    std::recursive_mutex input_stream;
   } m_crit;
 
   Common::SPSCQueue<AsyncQueueEntry, false> m_async_queue;
 
+  // Pad and Wii Remote data outside of host input authority mode. The receiver and the time of the
+  // last send are only accessed by the net thread.
+  InputStreamSender m_input_sender;
+  bool m_input_sender_has_new_messages = false;
+  InputStreamReceiver m_input_receiver;
+  std::chrono::steady_clock::time_point m_input_last_sent;
+
   std::array<Common::SPSCQueue<GCPadStatus>, 4> m_pad_buffer;
   std::array<Common::SPSCQueue<WiimoteEmu::SerializedWiimoteState>, 4> m_wiimote_buffer;
 
@@ -267,6 +276,8 @@ private:
   void AddWiimoteStateToPacket(int in_game_pad, const WiimoteEmu::SerializedWiimoteState& np,
                                sf::Packet& packet);
   void Send(const sf::Packet& packet, u8 channel_id = DEFAULT_CHANNEL);
+  void SendInputAsync(sf::Packet&& packet);
+  void FlushInputStream();
   void Disconnect();
   bool Connect();
   void SendGameStatus();
@@ -287,6 +298,8 @@ private:
   void OnGBAConfig(sf::Packet& packet);
   void OnPadData(sf::Packet& packet);
   void OnPadHostData(sf::Packet& packet);
+  void OnInputBundle(sf::Packet& packet);
+  void OnInputAck(sf::Packet& packet);
   void OnWiimoteData(sf::Packet& packet);
   void OnPadBuffer(sf::Packet& packet);
   void OnHostInputAuthority(sf::Packet& packet);
@@ -336,6 +349,8 @@ private:
   Common::Event m_wait_on_input_event;
   u8 m_sync_save_data_count = 0;
   u8 m_sync_save_data_success_count = 0;
+  // Chunks of the previous session's save data, which the server doesn't need to send again.
+  ChunkStore m_sync_save_data_chunks;
   u16 m_sync_gecko_codes_count = 0;
   u16 m_sync_gecko_codes_success_count = 0;
   bool m_sync_gecko_codes_complete = false;
@@ -346,6 +361,8 @@ private:
 
   u64 m_initial_rtc = 0;
   u32 m_timebase_frame = 0;
+  // Hash of the memory and CPU state since the last desync check, only accessed by the CPU thread
+  u32 m_state_hash = 0;
 
   std::unique_ptr<IOS::HLE::FS::FileSystem> m_wii_sync_fs;
   std::vector<u64> m_wii_sync_titles;
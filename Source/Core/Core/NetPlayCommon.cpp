@@ -4,10 +4,14 @@
 #include "Core/NetPlayCommon.h"
 
 #include <algorithm>
+#include <atomic>
+#include <functional>
+#include <thread>
 
 #include <fmt/format.h>
 #include <lzo/lzo1x.h>
 
+#include "Common/Crypto/SHA1.h"
 #include "Common/FileUtil.h"
 #include "Common/IOFile.h"
 #include "Common/MsgHandler.h"
@@ -18,76 +22,134 @@ namespace NetPlay
 constexpr u32 LZO_IN_LEN = 1024 * 64;
 constexpr u32 LZO_OUT_LEN = LZO_IN_LEN + (LZO_IN_LEN / 16) + 64 + 3;
 
-bool CompressFileIntoPacket(const std::string& file_path, sf::Packet& packet)
+// Sent instead of a compressed chunk's length when the chunk is replaced by its digest.
+constexpr u32 CHUNK_REFERENCE = 0xFFFFFFFF;
+
+// Compresses the chunks on all cores. Chunks in known_chunks are left empty and get their digest
+// stored instead.
+static bool CompressChunks(const u8* data, size_t size, const ChunkDigests* known_chunks,
+                           std::vector<std::vector<u8>>& compressed,
+                           std::vector<std::optional<Common::SHA1::Digest>>& references)
 {
-  File::IOFile file(file_path, "rb");
-  if (!file)
+  const size_t chunk_count = (size + LZO_IN_LEN - 1) / LZO_IN_LEN;
+  compressed.assign(chunk_count, {});
+  references.assign(chunk_count, std::nullopt);
+
+  std::atomic<size_t> next_chunk = 0;
+  std::atomic<bool> failed = false;
+  const auto worker = [&] {
+    std::vector<u8> wrkmem(LZO1X_1_MEM_COMPRESS);
+    for (size_t i = next_chunk++; i < chunk_count && !failed; i = next_chunk++)
+    {
+      const u8* const chunk = data + i * LZO_IN_LEN;
+      const size_t chunk_size = std::min<size_t>(LZO_IN_LEN, size - i * LZO_IN_LEN);
+
+      if (known_chunks)
+      {
+        const Common::SHA1::Digest digest = Common::SHA1::CalculateDigest(chunk, chunk_size);
+        if (known_chunks->contains(digest))
+        {
+          references[i] = digest;
+          continue;
+        }
+      }
+
+      std::vector<u8>& out_buffer = compressed[i];
+      out_buffer.resize(LZO_OUT_LEN);
+      lzo_uint out_len = 0;
+      if (lzo1x_1_compress(chunk, static_cast<lzo_uint>(chunk_size), out_buffer.data(), &out_len,
+                           wrkmem.data()) != LZO_E_OK)
+      {
+        failed = true;
+        return;
+      }
+      out_buffer.resize(out_len);
+    }
+  };
+
+  const size_t thread_count =
+      std::min<size_t>(chunk_count, std::max(std::thread::hardware_concurrency(), 1u));
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < thread_count; ++i)
+    threads.emplace_back(worker);
+  worker();
+  for (std::thread& thread : threads)
+    thread.join();
+
+  if (failed)
   {
-    PanicAlertFmtT("Failed to open file \"{0}\".", file_path);
+    PanicAlertFmtT("Internal LZO Error - compression failed");
     return false;
   }
 
-  const sf::Uint64 size = file.GetSize();
-  packet << size;
+  return true;
+}
+
+static bool CompressDataIntoPacket(const u8* data, size_t size, sf::Packet& packet,
+                                   const ChunkDigests* known_chunks)
+{
+  packet << sf::Uint64{size};
 
   if (size == 0)
     return true;
 
-  std::vector<u8> in_buffer(LZO_IN_LEN);
-  std::vector<u8> out_buffer(LZO_OUT_LEN);
-  std::vector<u8> wrkmem(LZO1X_1_MEM_COMPRESS);
+  std::vector<std::vector<u8>> compressed;
+  std::vector<std::optional<Common::SHA1::Digest>> references;
+  if (!CompressChunks(data, size, known_chunks, compressed, references))
+    return false;
 
-  lzo_uint i = 0;
-  while (true)
+  for (size_t i = 0; i < compressed.size(); ++i)
   {
-    lzo_uint32 cur_len = 0;  // number of bytes to read
-    lzo_uint out_len = 0;    // number of bytes to write
-
-    if ((i + LZO_IN_LEN) >= size)
+    if (references[i])
     {
-      cur_len = static_cast<lzo_uint32>(size - i);
+      packet << CHUNK_REFERENCE;
+      packet.append(references[i]->data(), references[i]->size());
     }
     else
     {
-      cur_len = LZO_IN_LEN;
-    }
-
-    if (cur_len <= 0)
-      break;  // EOF
-
-    if (!file.ReadBytes(in_buffer.data(), cur_len))
-    {
-      PanicAlertFmtT("Error reading file: {0}", file_path.c_str());
-      return false;
+      // The size of the data to write is the compressed size
+      packet << static_cast<u32>(compressed[i].size());
+      packet.append(compressed[i].data(), compressed[i].size());
     }
+  }
 
-    if (lzo1x_1_compress(in_buffer.data(), cur_len, out_buffer.data(), &out_len, wrkmem.data()) !=
-        LZO_E_OK)
-    {
-      PanicAlertFmtT("Internal LZO Error - compression failed");
-      return false;
-    }
+  // Mark end of data
+  packet << static_cast<u32>(0);
 
-    // The size of the data to write is 'out_len'
-    packet << static_cast<u32>(out_len);
-    for (size_t j = 0; j < out_len; j++)
-    {
-      packet << out_buffer[j];
-    }
+  return true;
+}
 
-    if (cur_len != LZO_IN_LEN)
-      break;
+static std::optional<std::vector<u8>> ReadWholeFile(const std::string& file_path)
+{
+  File::IOFile file(file_path, "rb");
+  if (!file)
+  {
+    PanicAlertFmtT("Failed to open file \"{0}\".", file_path);
+    return std::nullopt;
+  }
 
-    i += cur_len;
+  std::vector<u8> data(file.GetSize());
+  if (!file.ReadBytes(data.data(), data.size()))
+  {
+    PanicAlertFmtT("Error reading file: {0}", file_path.c_str());
+    return std::nullopt;
   }
 
-  // Mark end of data
-  packet << static_cast<u32>(0);
+  return data;
+}
 
-  return true;
+bool CompressFileIntoPacket(const std::string& file_path, sf::Packet& packet,
+                            const ChunkDigests* known_chunks)
+{
+  const std::optional<std::vector<u8>> data = ReadWholeFile(file_path);
+  if (!data)
+    return false;
+
+  return CompressDataIntoPacket(data->data(), data->size(), packet, known_chunks);
 }
 
-static bool CompressFolderIntoPacketInternal(const File::FSTEntry& folder, sf::Packet& packet)
+static bool CompressFolderIntoPacketInternal(const File::FSTEntry& folder, sf::Packet& packet,
+                                             const ChunkDigests* known_chunks)
 {
   const sf::Uint64 size = folder.children.size();
   packet << size;
@@ -96,15 +158,17 @@ static bool CompressFolderIntoPacketInternal(const File::FSTEntry& folder, sf::P
     const bool is_folder = child.isDirectory;
     packet << child.virtualName;
     packet << is_folder;
-    const bool success = is_folder ? CompressFolderIntoPacketInternal(child, packet) :
-                                     CompressFileIntoPacket(child.physicalName, packet);
+    const bool success =
+        is_folder ? CompressFolderIntoPacketInternal(child, packet, known_chunks) :
+                    CompressFileIntoPacket(child.physicalName, packet, known_chunks);
     if (!success)
       return false;
   }
   return true;
 }
 
-bool CompressFolderIntoPacket(const std::string& folder_path, sf::Packet& packet)
+bool CompressFolderIntoPacket(const std::string& folder_path, sf::Packet& packet,
+                              const ChunkDigests* known_chunks)
 {
   if (!File::IsDirectory(folder_path))
   {
@@ -113,65 +177,77 @@ bool CompressFolderIntoPacket(const std::string& folder_path, sf::Packet& packet
   }
 
   packet << true;
-  return CompressFolderIntoPacketInternal(File::ScanDirectoryTree(folder_path, true), packet);
+  return CompressFolderIntoPacketInternal(File::ScanDirectoryTree(folder_path, true), packet,
+                                          known_chunks);
 }
 
-bool CompressBufferIntoPacket(const std::vector<u8>& in_buffer, sf::Packet& packet)
+bool CompressBufferIntoPacket(const std::vector<u8>& in_buffer, sf::Packet& packet,
+                              const ChunkDigests* known_chunks)
 {
-  const sf::Uint64 size = in_buffer.size();
-  packet << size;
-
-  if (size == 0)
-    return true;
+  return CompressDataIntoPacket(in_buffer.data(), in_buffer.size(), packet, known_chunks);
+}
 
-  std::vector<u8> out_buffer(LZO_OUT_LEN);
-  std::vector<u8> wrkmem(LZO1X_1_MEM_COMPRESS);
+// Reads the chunks written by CompressDataIntoPacket and passes them to write in order.
+static bool DecompressChunksFromPacket(sf::Packet& packet, const ChunkStore* local_chunks,
+                                       const std::function<bool(const u8*, size_t)>& write)
+{
+  std::vector<u8> in_buffer(LZO_OUT_LEN);
+  std::vector<u8> out_buffer(LZO_IN_LEN);
 
-  lzo_uint i = 0;
   while (true)
   {
-    lzo_uint32 cur_len = 0;  // number of bytes to read
-    lzo_uint out_len = 0;    // number of bytes to write
+    u32 cur_len = 0;  // number of bytes to read
 
-    if ((i + LZO_IN_LEN) >= size)
-    {
-      cur_len = static_cast<lzo_uint32>(size - i);
-    }
-    else
+    packet >> cur_len;
+    if (!cur_len)
+      break;  // We reached the end of the data stream
+
+    if (cur_len == CHUNK_REFERENCE)
     {
-      cur_len = LZO_IN_LEN;
+      Common::SHA1::Digest digest;
+      for (u8& byte : digest)
+        packet >> byte;
+
+      const auto it = local_chunks ? local_chunks->find(digest) : ChunkStore::const_iterator{};
+      if (!local_chunks || it == local_chunks->end())
+      {
+        PanicAlertFmtT("Received a reference to save data that isn't available locally.");
+        return false;
+      }
+
+      if (!write(it->second.data(), it->second.size()))
+        return false;
+      continue;
     }
 
-    if (cur_len <= 0)
-      break;  // end of buffer
-
-    if (lzo1x_1_compress(&in_buffer[i], cur_len, out_buffer.data(), &out_len, wrkmem.data()) !=
-        LZO_E_OK)
+    if (cur_len > LZO_OUT_LEN)
     {
-      PanicAlertFmtT("Internal LZO Error - compression failed");
+      PanicAlertFmtT("Internal LZO Error - decompression failed");
       return false;
     }
 
-    // The size of the data to write is 'out_len'
-    packet << static_cast<u32>(out_len);
-    for (size_t j = 0; j < out_len; j++)
+    for (size_t j = 0; j < cur_len; j++)
     {
-      packet << out_buffer[j];
+      packet >> in_buffer[j];
     }
 
-    if (cur_len != LZO_IN_LEN)
-      break;
+    lzo_uint new_len = LZO_IN_LEN;  // number of bytes to write
+    if (lzo1x_decompress_safe(in_buffer.data(), cur_len, out_buffer.data(), &new_len, nullptr) !=
+        LZO_E_OK)
+    {
+      PanicAlertFmtT("Internal LZO Error - decompression failed");
+      return false;
+    }
 
-    i += cur_len;
+    if (!write(out_buffer.data(), new_len))
+      return false;
   }
 
-  // Mark end of data
-  packet << static_cast<u32>(0);
-
   return true;
 }
 
-bool DecompressPacketIntoFile(sf::Packet& packet, const std::string& file_path)
+bool DecompressPacketIntoFile(sf::Packet& packet, const std::string& file_path,
+                              const ChunkStore* local_chunks)
 {
   u64 file_size = Common::PacketReadU64(packet);
 
@@ -185,41 +261,18 @@ bool DecompressPacketIntoFile(sf::Packet& packet, const std::string& file_path)
     return false;
   }
 
-  std::vector<u8> in_buffer(LZO_OUT_LEN);
-  std::vector<u8> out_buffer(LZO_IN_LEN);
-
-  while (true)
-  {
-    u32 cur_len = 0;       // number of bytes to read
-    lzo_uint new_len = 0;  // number of bytes to write
-
-    packet >> cur_len;
-    if (!cur_len)
-      break;  // We reached the end of the data stream
-
-    for (size_t j = 0; j < cur_len; j++)
-    {
-      packet >> in_buffer[j];
-    }
-
-    if (lzo1x_decompress(in_buffer.data(), cur_len, out_buffer.data(), &new_len, nullptr) !=
-        LZO_E_OK)
-    {
-      PanicAlertFmtT("Internal LZO Error - decompression failed");
-      return false;
-    }
-
-    if (!file.WriteBytes(out_buffer.data(), new_len))
+  return DecompressChunksFromPacket(packet, local_chunks, [&](const u8* data, size_t size) {
+    if (!file.WriteBytes(data, size))
     {
       PanicAlertFmtT("Error writing file: {0}", file_path);
       return false;
     }
-  }
-
-  return true;
+    return true;
+  });
 }
 
-static bool DecompressPacketIntoFolderInternal(sf::Packet& packet, const std::string& folder_path)
+static bool DecompressPacketIntoFolderInternal(sf::Packet& packet, const std::string& folder_path,
+                                               const ChunkStore* local_chunks)
 {
   if (!File::CreateFullPath(folder_path + "/"))
     return false;
@@ -243,24 +296,27 @@ static bool DecompressPacketIntoFolderInternal(sf::Packet& packet, const std::st
     bool is_folder;
     packet >> is_folder;
     std::string path = fmt::format("{}/{}", folder_path, name);
-    const bool success = is_folder ? DecompressPacketIntoFolderInternal(packet, path) :
-                                     DecompressPacketIntoFile(packet, path);
+    const bool success = is_folder ?
+                             DecompressPacketIntoFolderInternal(packet, path, local_chunks) :
+                             DecompressPacketIntoFile(packet, path, local_chunks);
     if (!success)
       return false;
   }
   return true;
 }
 
-bool DecompressPacketIntoFolder(sf::Packet& packet, const std::string& folder_path)
+bool DecompressPacketIntoFolder(sf::Packet& packet, const std::string& folder_path,
+                                const ChunkStore* local_chunks)
 {
   bool folder_existed;
   packet >> folder_existed;
   if (!folder_existed)
     return true;
-  return DecompressPacketIntoFolderInternal(packet, folder_path);
+  return DecompressPacketIntoFolderInternal(packet, folder_path, local_chunks);
 }
 
-std::optional<std::vector<u8>> DecompressPacketIntoBuffer(sf::Packet& packet)
+std::optional<std::vector<u8>> DecompressPacketIntoBuffer(sf::Packet& packet,
+                                                          const ChunkStore* local_chunks)
 {
   u64 size = Common::PacketReadU64(packet);
 
@@ -269,32 +325,145 @@ std::optional<std::vector<u8>> DecompressPacketIntoBuffer(sf::Packet& packet)
   if (size == 0)
     return out_buffer;
 
-  std::vector<u8> in_buffer(LZO_OUT_LEN);
+  size_t i = 0;
+  const bool success =
+      DecompressChunksFromPacket(packet, local_chunks, [&](const u8* data, size_t chunk_size) {
+        if (chunk_size > out_buffer.size() - i)
+        {
+          PanicAlertFmtT("Internal LZO Error - decompression failed");
+          return false;
+        }
+        std::copy_n(data, chunk_size, out_buffer.begin() + i);
+        i += chunk_size;
+        return true;
+      });
+  if (!success)
+    return {};
 
-  lzo_uint i = 0;
-  while (true)
+  return out_buffer;
+}
+
+static void AddFolderChunksToStore(const File::FSTEntry& folder, ChunkStore& store)
+{
+  for (const File::FSTEntry& child : folder.children)
+  {
+    if (child.isDirectory)
+      AddFolderChunksToStore(child, store);
+    else
+      AddChunksToStore(child.physicalName, store);
+  }
+}
+
+void AddChunksToStore(const std::string& path, ChunkStore& store)
+{
+  if (File::IsDirectory(path))
   {
-    u32 cur_len = 0;       // number of bytes to read
-    lzo_uint new_len = 0;  // number of bytes to write
+    AddFolderChunksToStore(File::ScanDirectoryTree(path, true), store);
+    return;
+  }
 
-    packet >> cur_len;
-    if (!cur_len)
-      break;  // We reached the end of the data stream
+  File::IOFile file(path, "rb");
+  if (!file)
+    return;
 
-    for (size_t j = 0; j < cur_len; j++)
+  std::vector<u8> chunk(LZO_IN_LEN);
+  for (u64 remaining = file.GetSize(); remaining != 0;)
+  {
+    chunk.resize(std::min<u64>(remaining, LZO_IN_LEN));
+    if (!file.ReadBytes(chunk.data(), chunk.size()))
+      return;
+    remaining -= chunk.size();
+
+    store.try_emplace(Common::SHA1::CalculateDigest(chunk), chunk);
+  }
+}
+
+// Bounds the size of a packet when the receiver stops acknowledging for a while.
+constexpr u32 INPUT_STREAM_MAX_MESSAGES = 32;
+
+void InputStreamSender::Push(u32 game, sf::Packet message)
+{
+  if (game != m_game)
+  {
+    m_game = game;
+    m_first_sequence = 0;
+    m_messages.clear();
+  }
+
+  m_messages.push_back(std::move(message));
+}
+
+void InputStreamSender::Acknowledge(u32 game, u32 next_sequence)
+{
+  if (game != m_game)
+    return;
+
+  while (!m_messages.empty() && static_cast<s32>(next_sequence - m_first_sequence) > 0)
+  {
+    m_messages.pop_front();
+    ++m_first_sequence;
+  }
+}
+
+void InputStreamSender::AppendToPacket(sf::Packet& packet) const
+{
+  const u32 count = std::min<u32>(static_cast<u32>(m_messages.size()), INPUT_STREAM_MAX_MESSAGES);
+  packet << m_game << m_first_sequence << count;
+  for (u32 i = 0; i < count; ++i)
+  {
+    const sf::Packet& message = m_messages[i];
+    packet << static_cast<u16>(message.getDataSize());
+    packet.append(message.getData(), message.getDataSize());
+  }
+}
+
+std::vector<sf::Packet> InputStreamReceiver::Receive(sf::Packet& packet, u32 current_game)
+{
+  u32 game, first_sequence, count;
+  packet >> game >> first_sequence >> count;
+  if (!packet || game != current_game)
+    return {};
+
+  if (game != m_game)
+  {
+    m_game = game;
+    m_next_sequence = 0;
+  }
+
+  std::vector<sf::Packet> messages;
+  for (u32 i = 0; i < count; ++i)
+  {
+    u16 size;
+    packet >> size;
+    sf::Packet message;
+    for (u16 j = 0; j < size; ++j)
     {
-      packet >> in_buffer[j];
+      u8 byte;
+      packet >> byte;
+      message << byte;
     }
+    if (!packet)
+      break;
 
-    if (lzo1x_decompress(in_buffer.data(), cur_len, &out_buffer[i], &new_len, nullptr) != LZO_E_OK)
+    // Older messages were already received, and a newer one can't be used before the missing ones
+    // arrive in a later packet.
+    const u32 sequence = first_sequence + i;
+    if (sequence == m_next_sequence)
     {
-      PanicAlertFmtT("Internal LZO Error - decompression failed");
-      return {};
+      messages.push_back(std::move(message));
+      ++m_next_sequence;
+    }
+    else if (static_cast<s32>(sequence - m_next_sequence) > 0)
+    {
+      break;
     }
-
-    i += new_len;
   }
 
-  return out_buffer;
+  return messages;
+}
+
+void InputStreamReceiver::AppendAcknowledgement(sf::Packet& packet) const
+{
+  packet << m_game << m_next_sequence;
 }
 }  // namespace NetPlay
@@ -7,11 +7,15 @@
 
 #include <array>
 #include <chrono>
+#include <deque>
+#include <map>
 #include <optional>
+#include <set>
 #include <string>
 #include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Common/Crypto/SHA1.h"
 
 namespace NetPlay
 {
@@ -19,11 +23,63 @@ using namespace std::chrono_literals;
 // An arbitrary amount of time of no acknowledgement of sent packets before netplay decides a
 // connection is disconnected
 constexpr std::chrono::milliseconds PEER_TIMEOUT = 30s;
+// How long to wait for the acknowledgement of input before sending it again
+constexpr std::chrono::milliseconds INPUT_RESEND_INTERVAL = 8ms;
 
-bool CompressFileIntoPacket(const std::string& file_path, sf::Packet& packet);
-bool CompressFolderIntoPacket(const std::string& folder_path, sf::Packet& packet);
-bool CompressBufferIntoPacket(const std::vector<u8>& in_buffer, sf::Packet& packet);
-bool DecompressPacketIntoFile(sf::Packet& packet, const std::string& file_path);
-bool DecompressPacketIntoFolder(sf::Packet& packet, const std::string& folder_path);
-std::optional<std::vector<u8>> DecompressPacketIntoBuffer(sf::Packet& packet);
+// Data is split into chunks that are compressed separately. When the receiver already has some
+// of the chunks (e.g. from the save data of the previous session), their digests can be passed
+// as known_chunks to send the digests instead of the data, and the receiver has to pass the
+// matching chunks as local_chunks.
+using ChunkDigests = std::set<Common::SHA1::Digest>;
+using ChunkStore = std::map<Common::SHA1::Digest, std::vector<u8>>;
+
+bool CompressFileIntoPacket(const std::string& file_path, sf::Packet& packet,
+                            const ChunkDigests* known_chunks = nullptr);
+bool CompressFolderIntoPacket(const std::string& folder_path, sf::Packet& packet,
+                              const ChunkDigests* known_chunks = nullptr);
+bool CompressBufferIntoPacket(const std::vector<u8>& in_buffer, sf::Packet& packet,
+                              const ChunkDigests* known_chunks = nullptr);
+bool DecompressPacketIntoFile(sf::Packet& packet, const std::string& file_path,
+                              const ChunkStore* local_chunks = nullptr);
+bool DecompressPacketIntoFolder(sf::Packet& packet, const std::string& folder_path,
+                                const ChunkStore* local_chunks = nullptr);
+std::optional<std::vector<u8>> DecompressPacketIntoBuffer(sf::Packet& packet,
+                                                          const ChunkStore* local_chunks = nullptr);
+
+// Splits a file, or all the files of a folder, into chunks the same way as the functions above.
+void AddChunksToStore(const std::string& path, ChunkStore& store);
+
+// Input messages are sent over an unreliable channel. Every packet carries all the messages that
+// the receiver hasn't acknowledged yet, so a lost packet is made up for by the next one instead of
+// stalling everything behind it until ENet retransmits it. Messages are numbered per game, so that
+// stale packets of a previous game are ignored.
+class InputStreamSender
+{
+public:
+  void Push(u32 game, sf::Packet message);
+  void Acknowledge(u32 game, u32 next_sequence);
+  bool HasUnacknowledged() const { return !m_messages.empty(); }
+
+  // Appends the oldest unacknowledged messages.
+  void AppendToPacket(sf::Packet& packet) const;
+
+private:
+  u32 m_game = 0;
+  u32 m_first_sequence = 0;
+  std::deque<sf::Packet> m_messages;
+};
+
+class InputStreamReceiver
+{
+public:
+  // Returns the messages of the current game that haven't been received before, in order.
+  std::vector<sf::Packet> Receive(sf::Packet& packet, u32 current_game);
+
+  // The acknowledgement is the game and the sequence number of the next expected message.
+  void AppendAcknowledgement(sf::Packet& packet) const;
+
+private:
+  u32 m_game = 0;
+  u32 m_next_sequence = 0;
+};
 }  // namespace NetPlay
@@ -150,6 +150,8 @@ enum class MessageID : u8
   PadBuffer = 0x62,
   PadHostData = 0x63,
   GBAConfig = 0x64,
+  InputBundle = 0x65,
+  InputAck = 0x66,
 
   WiimoteData = 0x70,
   WiimoteMapping = 0x71,
@@ -206,7 +208,8 @@ enum class SyncSaveDataID : u8
   RawData = 3,
   GCIData = 4,
   WiiData = 5,
-  GBAData = 6
+  GBAData = 6,
+  ChunkDigests = 7,
 };
 
 enum class SyncCodeID : u8
@@ -228,6 +231,8 @@ enum : u8
 {
   DEFAULT_CHANNEL,
   CHUNKED_DATA_CHANNEL,
+  // Unreliable, see InputStreamSender
+  INPUT_CHANNEL,
   CHANNEL_COUNT
 };
 
@@ -86,6 +86,17 @@
 
 namespace NetPlay
 {
+struct SaveSyncInfo
+{
+  u8 save_count = 0;
+  std::shared_ptr<const UICommon::GameFile> game;
+  bool has_wii_save = false;
+  std::unique_ptr<IOS::HLE::FS::FileSystem> configured_fs;
+  std::optional<std::vector<u8>> mii_data;
+  std::vector<std::pair<u64, WiiSave::StoragePointer>> wii_saves;
+  std::optional<DiscIO::Riivolution::SavegameRedirect> redirected_save;
+};
+
 NetPlayServer::~NetPlayServer()
 {
   if (is_connected)
@@ -273,7 +284,14 @@ void NetPlayServer::ThreadFunc()
     int net;
     if (m_traversal_client)
       m_traversal_client->HandleResends();
-    net = enet_host_service(m_server, &netEvent, 1000);
+
+    // Wake up in time to send unacknowledged input again
+    const bool input_pending = std::any_of(m_players.begin(), m_players.end(), [](const auto& p) {
+      return p.second.input_sender.HasUnacknowledged();
+    });
+    net = enet_host_service(m_server, &netEvent,
+                            input_pending ? static_cast<u32>(INPUT_RESEND_INTERVAL.count()) : 1000);
+    ResendInput();
     while (!m_async_queue.Empty())
     {
       INFO_LOG_FMT(NETPLAY, "Processing async queue event.");
@@ -837,7 +855,7 @@ unsigned int NetPlayServer::OnData(sf::Packet& packet, Client& player)
     }
     else
     {
-      SendToClients(spac, player.pid);
+      SendInputToClients(spac, player.pid);
     }
   }
   break;
@@ -907,7 +925,37 @@ unsigned int NetPlayServer::OnData(sf::Packet& packet, Client& player)
         spac << pad.data[i];
     }
 
-    SendToClients(spac, player.pid);
+    if (m_host_input_authority)
+      SendToClients(spac, player.pid);
+    else
+      SendInputToClients(spac, player.pid);
+  }
+  break;
+
+  case MessageID::InputBundle:
+  {
+    // Ignore the input until the player reports being in the current game, it gets sent again
+    if (player.current_game != m_current_game)
+      break;
+
+    for (sf::Packet& message : player.input_receiver.Receive(packet, m_current_game))
+    {
+      if (OnData(message, player) != 0)
+        return 1;
+    }
+
+    sf::Packet spac;
+    spac << MessageID::InputAck;
+    player.input_receiver.AppendAcknowledgement(spac);
+    Common::ENet::SendPacket(player.socket, spac, INPUT_CHANNEL, false);
+  }
+  break;
+
+  case MessageID::InputAck:
+  {
+    u32 game, next_sequence;
+    packet >> game >> next_sequence;
+    player.input_sender.Acknowledge(game, next_sequence);
   }
   break;
 
@@ -1045,27 +1093,29 @@ unsigned int NetPlayServer::OnData(sf::Packet& packet, Client& player)
 
   case MessageID::TimeBase:
   {
-    u64 timebase = Common::PacketReadU64(packet);
+    SyncState sync_state;
+    sync_state.timebase = Common::PacketReadU64(packet);
     u32 frame;
     packet >> frame;
+    packet >> sync_state.state_hash;
 
     if (m_desync_detected)
       break;
 
-    std::vector<std::pair<PlayerId, u64>>& timebases = m_timebase_by_frame[frame];
-    timebases.emplace_back(player.pid, timebase);
+    std::vector<std::pair<PlayerId, SyncState>>& timebases = m_timebase_by_frame[frame];
+    timebases.emplace_back(player.pid, sync_state);
     if (timebases.size() >= m_players.size())
     {
       // we have all records for this frame
 
-      if (!std::all_of(timebases.begin(), timebases.end(), [&](std::pair<PlayerId, u64> pair) {
+      if (!std::all_of(timebases.begin(), timebases.end(), [&](const auto& pair) {
             return pair.second == timebases[0].second;
           }))
       {
         int pid_to_blame = 0;
-        for (auto pair : timebases)
+        for (const auto& pair : timebases)
         {
-          if (std::all_of(timebases.begin(), timebases.end(), [&](std::pair<PlayerId, u64> other) {
+          if (std::all_of(timebases.begin(), timebases.end(), [&](const auto& other) {
                 return other.first == pair.first || other.second != pair.second;
               }))
           {
@@ -1168,6 +1218,10 @@ unsigned int NetPlayServer::OnData(sf::Packet& packet, Client& player)
     }
     break;
 
+    case SyncSaveDataID::ChunkDigests:
+      OnSaveDataChunkDigests(packet);
+      break;
+
     case SyncSaveDataID::Failure:
     {
       m_dialog->AppendChat(Common::FmtFormatT("{0} failed to synchronize.", player.name));
@@ -1474,17 +1528,6 @@ bool NetPlayServer::DoAllPlayersHaveHardwareFMA() const
                      [](const auto& p) { return p.second.has_hardware_fma; });
 }
 
-struct SaveSyncInfo
-{
-  u8 save_count = 0;
-  std::shared_ptr<const UICommon::GameFile> game;
-  bool has_wii_save = false;
-  std::unique_ptr<IOS::HLE::FS::FileSystem> configured_fs;
-  std::optional<std::vector<u8>> mii_data;
-  std::vector<std::pair<u64, WiiSave::StoragePointer>> wii_saves;
-  std::optional<DiscIO::Riivolution::SavegameRedirect> redirected_save;
-};
-
 // called from ---GUI--- thread
 bool NetPlayServer::RequestStartGame()
 {
@@ -1520,7 +1563,7 @@ bool NetPlayServer::RequestStartGame()
     {
       start_now = false;
       m_start_pending = true;
-      if (!SyncSaveData(*save_sync_info))
+      if (!SyncSaveData(std::move(*save_sync_info)))
       {
         PanicAlertFmtT("Error synchronizing save data!");
         m_start_pending = false;
@@ -1789,7 +1832,7 @@ std::optional<SaveSyncInfo> NetPlayServer::CollectSaveSyncInfo()
 }
 
 // called from ---GUI--- thread
-bool NetPlayServer::SyncSaveData(const SaveSyncInfo& sync_info)
+bool NetPlayServer::SyncSaveData(SaveSyncInfo sync_info)
 {
   INFO_LOG_FMT(NETPLAY, "Sending {} savegame chunks to clients.", sync_info.save_count);
 
@@ -1798,19 +1841,76 @@ bool NetPlayServer::SyncSaveData(const SaveSyncInfo& sync_info)
 
   m_save_data_synced_players = 0;
 
+  const u8 save_count = sync_info.save_count;
+
+  std::lock_guard lk(m_save_sync_mutex);
+  m_pending_save_sync.reset();
+  m_save_sync_common_chunks.reset();
+  m_save_sync_digests_received = 0;
+
+  // The clients answer with the digests of the chunks they already have, see
+  // OnSaveDataChunkDigests.
+  if (save_count != 0)
+    m_pending_save_sync = std::make_unique<SaveSyncInfo>(std::move(sync_info));
+
+  sf::Packet pac;
+  pac << MessageID::SyncSaveData;
+  pac << SyncSaveDataID::Notify;
+  pac << save_count;
+
+  // send this on the chunked data channel to ensure it's sequenced properly
+  SendAsyncToClients(std::move(pac), 0, CHUNKED_DATA_CHANNEL);
+
+  return true;
+}
+
+void NetPlayServer::OnSaveDataChunkDigests(sf::Packet& packet)
+{
+  std::lock_guard lk(m_save_sync_mutex);
+  if (!m_pending_save_sync)
+    return;
+
+  u32 count;
+  packet >> count;
+
+  ChunkDigests digests;
+  for (u32 i = 0; i < count && !packet.endOfPacket(); ++i)
   {
-    sf::Packet pac;
-    pac << MessageID::SyncSaveData;
-    pac << SyncSaveDataID::Notify;
-    pac << sync_info.save_count;
+    Common::SHA1::Digest digest;
+    for (u8& byte : digest)
+      packet >> byte;
+    digests.insert(digest);
+  }
 
-    // send this on the chunked data channel to ensure it's sequenced properly
-    SendAsyncToClients(std::move(pac), 0, CHUNKED_DATA_CHANNEL);
+  // Only chunks that all the clients have can be skipped, the data is sent to everyone at once.
+  if (!m_save_sync_common_chunks)
+  {
+    m_save_sync_common_chunks = std::move(digests);
   }
+  else
+  {
+    std::erase_if(*m_save_sync_common_chunks,
+                  [&digests](const auto& digest) { return !digests.contains(digest); });
+  }
+
+  if (++m_save_sync_digests_received < m_players.size() - 1)
+    return;
+
+  INFO_LOG_FMT(NETPLAY, "Clients already have {} save data chunks.",
+               m_save_sync_common_chunks->size());
 
-  if (sync_info.save_count == 0)
-    return true;
+  const std::unique_ptr<SaveSyncInfo> sync_info = std::move(m_pending_save_sync);
+  if (!SendSaveData(*sync_info, *m_save_sync_common_chunks))
+  {
+    m_dialog->AppendChat(Common::GetStringT("Error synchronizing save data!"));
+    m_dialog->OnGameStartAborted();
+    ChunkedDataAbort();
+    m_start_pending = false;
+  }
+}
 
+bool NetPlayServer::SendSaveData(const SaveSyncInfo& sync_info, const ChunkDigests& known_chunks)
+{
   const auto game_region = sync_info.game->GetRegion();
   const auto gamecube_region = Config::ToGameCubeRegion(game_region);
   const std::string region = Config::GetDirectoryForRegion(gamecube_region);
@@ -1837,7 +1937,7 @@ bool NetPlayServer::SyncSaveData(const SaveSyncInfo& sync_info)
       {
         INFO_LOG_FMT(NETPLAY, "Sending data of raw memcard {} in slot {}.", path,
                      is_slot_a ? 'A' : 'B');
-        if (!CompressFileIntoPacket(path, pac))
+        if (!CompressFileIntoPacket(path, pac, &known_chunks))
           return false;
       }
       else
@@ -1876,7 +1976,7 @@ bool NetPlayServer::SyncSaveData(const SaveSyncInfo& sync_info)
           const std::string filename = file.substr(file.find_last_of('/') + 1);
           INFO_LOG_FMT(NETPLAY, "Sending GCI {}.", filename);
           pac << filename;
-          if (!CompressFileIntoPacket(file, pac))
+          if (!CompressFileIntoPacket(file, pac, &known_chunks))
             return false;
         }
       }
@@ -1904,7 +2004,7 @@ bool NetPlayServer::SyncSaveData(const SaveSyncInfo& sync_info)
     {
       INFO_LOG_FMT(NETPLAY, "Sending Mii data.");
       pac << true;
-      if (!CompressBufferIntoPacket(*sync_info.mii_data, pac))
+      if (!CompressBufferIntoPacket(*sync_info.mii_data, pac, &known_chunks))
         return false;
     }
     else
@@ -1965,7 +2065,7 @@ bool NetPlayServer::SyncSaveData(const SaveSyncInfo& sync_info)
           if (file.type == WiiSave::Storage::SaveFile::Type::File)
           {
             const std::optional<std::vector<u8>>& data = *file.data;
-            if (!data || !CompressBufferIntoPacket(*data, pac))
+            if (!data || !CompressBufferIntoPacket(*data, pac, &known_chunks))
               return false;
           }
         }
@@ -1982,7 +2082,8 @@ bool NetPlayServer::SyncSaveData(const SaveSyncInfo& sync_info)
       INFO_LOG_FMT(NETPLAY, "Sending redirected save at {}.",
                    sync_info.redirected_save->m_target_path);
       pac << true;
-      if (!CompressFolderIntoPacket(sync_info.redirected_save->m_target_path, pac))
+      if (!CompressFolderIntoPacket(sync_info.redirected_save->m_target_path, pac,
+                                    &known_chunks))
         return false;
     }
     else
@@ -2011,7 +2112,7 @@ bool NetPlayServer::SyncSaveData(const SaveSyncInfo& sync_info)
       if (File::Exists(path))
       {
         INFO_LOG_FMT(NETPLAY, "Sending data of GBA save at {} for slot {}.", path, i);
-        if (!CompressFileIntoPacket(path, pac))
+        if (!CompressFileIntoPacket(path, pac, &known_chunks))
           return false;
       }
       else
@@ -2206,6 +2307,45 @@ void NetPlayServer::Send(ENetPeer* socket, const sf::Packet& packet, const u8 ch
   Common::ENet::SendPacket(socket, packet, channel_id);
 }
 
+void NetPlayServer::SendInput(Client& player, const sf::Packet& packet)
+{
+  player.input_sender.Push(m_current_game, packet);
+  SendInputBundle(player);
+}
+
+void NetPlayServer::SendInputToClients(const sf::Packet& packet, const PlayerId skip_pid)
+{
+  for (auto& p : m_players)
+  {
+    if (p.second.pid && p.second.pid != skip_pid)
+      SendInput(p.second, packet);
+  }
+}
+
+void NetPlayServer::SendInputBundle(Client& player)
+{
+  sf::Packet packet;
+  packet << MessageID::InputBundle;
+  player.input_sender.AppendToPacket(packet);
+  Common::ENet::SendPacket(player.socket, packet, INPUT_CHANNEL, false);
+  player.input_last_sent = std::chrono::steady_clock::now();
+}
+
+// called from ---NETPLAY--- thread
+void NetPlayServer::ResendInput()
+{
+  std::lock_guard lkp(m_crit.players);
+  const auto now = std::chrono::steady_clock::now();
+  for (auto& p : m_players)
+  {
+    if (p.second.input_sender.HasUnacknowledged() &&
+        now - p.second.input_last_sent >= INPUT_RESEND_INTERVAL)
+    {
+      SendInputBundle(p.second);
+    }
+  }
+}
+
 void NetPlayServer::KickPlayer(PlayerId player)
 {
   for (auto& current_player : m_players)
@@ -21,6 +21,7 @@
 #include "Common/SPSCQueue.h"
 #include "Common/Timer.h"
 #include "Common/TraversalClient.h"
+#include "Core/NetPlayCommon.h"
 #include "Core/NetPlayProto.h"
 #include "Core/SyncIdentifier.h"
 #include "InputCommon/GCPadStatus.h"
@@ -93,6 +94,11 @@ private:
     u32 ping = 0;
     u32 current_game = 0;
 
+    // Pad and Wii Remote data outside of host input authority mode
+    InputStreamSender input_sender;
+    InputStreamReceiver input_receiver;
+    std::chrono::steady_clock::time_point input_last_sent;
+
     Common::QoSSession qos_session;
 
     bool operator==(const Client& other) const { return this == &other; }
@@ -121,9 +127,20 @@ private:
     std::string title;
   };
 
+  // What each player reports every few frames, see NetPlayClient::SendTimeBase
+  struct SyncState
+  {
+    u64 timebase = 0;
+    u32 state_hash = 0;
+
+    bool operator==(const SyncState&) const = default;
+  };
+
   bool SetupNetSettings();
   std::optional<SaveSyncInfo> CollectSaveSyncInfo();
-  bool SyncSaveData(const SaveSyncInfo& sync_info);
+  bool SyncSaveData(SaveSyncInfo sync_info);
+  void OnSaveDataChunkDigests(sf::Packet& packet);
+  bool SendSaveData(const SaveSyncInfo& sync_info, const ChunkDigests& known_chunks);
   bool SyncCodes();
   void CheckSyncAndStartGame();
 
@@ -137,6 +154,10 @@ private:
   void SendToClients(const sf::Packet& packet, PlayerId skip_pid = 0,
                      u8 channel_id = DEFAULT_CHANNEL);
   void Send(ENetPeer* socket, const sf::Packet& packet, u8 channel_id = DEFAULT_CHANNEL);
+  void SendInput(Client& player, const sf::Packet& packet);
+  void SendInputToClients(const sf::Packet& packet, PlayerId skip_pid);
+  void SendInputBundle(Client& player);
+  void ResendInput();
   ConnectionError OnConnect(ENetPeer* socket, sf::Packet& received_packet);
   unsigned int OnDisconnect(const Client& player);
   unsigned int OnData(sf::Packet& packet, Client& player);
@@ -175,6 +196,11 @@ private:
   GBAConfigArray m_gba_config;
   PadMappingArray m_wiimote_map;
   unsigned int m_save_data_synced_players = 0;
+  // The save data is only sent once every client has told which chunks it already has.
+  std::mutex m_save_sync_mutex;
+  std::unique_ptr<SaveSyncInfo> m_pending_save_sync;
+  std::optional<ChunkDigests> m_save_sync_common_chunks;
+  unsigned int m_save_sync_digests_received = 0;
   unsigned int m_codes_synced_players = 0;
   bool m_saves_synced = true;
   bool m_codes_synced = true;
@@ -185,7 +211,7 @@ private:
 
   std::map<PlayerId, Client> m_players;
 
-  std::unordered_map<u32, std::vector<std::pair<PlayerId, u64>>> m_timebase_by_frame;
+  std::unordered_map<u32, std::vector<std::pair<PlayerId, SyncState>>> m_timebase_by_frame;
   bool m_desync_detected = false;
 
   struct
@@ -7,12 +7,14 @@
 #include <cstddef>
 #include <sstream>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
 #include "Core/Core.h"
 #include "Core/Debugger/DebugInterface.h"
+#include "Core/HW/Memmap.h"
 #include "Core/PowerPC/Expression.h"
 #include "Core/PowerPC/JitInterface.h"
 #include "Core/PowerPC/MMU.h"
@@ -27,32 +29,43 @@ BreakPoints::~BreakPoints() = default;
 
 bool BreakPoints::IsAddressBreakPoint(u32 address) const
 {
-  return std::any_of(m_breakpoints.begin(), m_breakpoints.end(),
-                     [address](const auto& bp) { return bp.address == address; });
+  return m_breakpoint_indices.contains(address);
 }
 
 bool BreakPoints::IsBreakPointEnable(u32 address) const
 {
-  return std::any_of(m_breakpoints.begin(), m_breakpoints.end(),
-                     [address](const auto& bp) { return bp.is_enabled && bp.address == address; });
+  const TBreakPoint* bp = Find(address);
+  return bp && bp->is_enabled;
 }
 
 bool BreakPoints::IsTempBreakPoint(u32 address) const
 {
-  return std::any_of(m_breakpoints.begin(), m_breakpoints.end(), [address](const auto& bp) {
-    return bp.address == address && bp.is_temporary;
-  });
+  const TBreakPoint* bp = Find(address);
+  return bp && bp->is_temporary;
 }
 
 const TBreakPoint* BreakPoints::GetBreakpoint(u32 address) const
 {
-  auto bp = std::find_if(m_breakpoints.begin(), m_breakpoints.end(),
-                         [address](const auto& bp_) { return bp_.address == address; });
+  return Find(address);
+}
 
-  if (bp == m_breakpoints.end())
-    return nullptr;
+TBreakPoint* BreakPoints::Find(u32 address)
+{
+  const auto iter = m_breakpoint_indices.find(address);
+  return iter != m_breakpoint_indices.end() ? &m_breakpoints[iter->second] : nullptr;
+}
+
+const TBreakPoint* BreakPoints::Find(u32 address) const
+{
+  const auto iter = m_breakpoint_indices.find(address);
+  return iter != m_breakpoint_indices.end() ? &m_breakpoints[iter->second] : nullptr;
+}
 
-  return &*bp;
+void BreakPoints::RebuildIndex()
+{
+  m_breakpoint_indices.clear();
+  for (size_t i = 0; i < m_breakpoints.size(); ++i)
+    m_breakpoint_indices.emplace(m_breakpoints[i].address, i);
 }
 
 BreakPoints::TBreakPointsStr BreakPoints::GetStrings() const
@@ -115,6 +128,7 @@ void BreakPoints::Add(TBreakPoint bp)
 
   m_system.GetJitInterface().InvalidateICache(bp.address, 4, true);
 
+  m_breakpoint_indices.emplace(bp.address, m_breakpoints.size());
   m_breakpoints.emplace_back(std::move(bp));
 }
 
@@ -128,8 +142,7 @@ void BreakPoints::Add(u32 address, bool temp, bool break_on_hit, bool log_on_hit
 {
   // Check for existing breakpoint, and overwrite with new info.
   // This is assuming we usually want the new breakpoint over an old one.
-  auto iter = std::find_if(m_breakpoints.begin(), m_breakpoints.end(),
-                           [address](const auto& bp) { return bp.address == address; });
+  TBreakPoint* const existing_bp = Find(address);
 
   TBreakPoint bp;  // breakpoint settings
   bp.is_enabled = true;
@@ -139,13 +152,14 @@ void BreakPoints::Add(u32 address, bool temp, bool break_on_hit, bool log_on_hit
   bp.address = address;
   bp.condition = std::move(condition);
 
-  if (iter != m_breakpoints.end())  // We found an existing breakpoint
+  if (existing_bp)  // We found an existing breakpoint
   {
-    bp.is_enabled = iter->is_enabled;
-    *iter = std::move(bp);
+    bp.is_enabled = existing_bp->is_enabled;
+    *existing_bp = std::move(bp);
   }
   else
   {
+    m_breakpoint_indices.emplace(address, m_breakpoints.size());
     m_breakpoints.emplace_back(std::move(bp));
   }
 
@@ -154,25 +168,24 @@ void BreakPoints::Add(u32 address, bool temp, bool break_on_hit, bool log_on_hit
 
 bool BreakPoints::ToggleBreakPoint(u32 address)
 {
-  auto iter = std::find_if(m_breakpoints.begin(), m_breakpoints.end(),
-                           [address](const auto& bp) { return bp.address == address; });
-
-  if (iter == m_breakpoints.end())
+  TBreakPoint* const bp = Find(address);
+  if (!bp)
     return false;
 
-  iter->is_enabled = !iter->is_enabled;
+  bp->is_enabled = !bp->is_enabled;
+  // The JITs only check the breakpoints that are enabled.
+  m_system.GetJitInterface().InvalidateICache(address, 4, true);
   return true;
 }
 
 void BreakPoints::Remove(u32 address)
 {
-  const auto iter = std::find_if(m_breakpoints.begin(), m_breakpoints.end(),
-                                 [address](const auto& bp) { return bp.address == address; });
-
-  if (iter == m_breakpoints.cend())
+  const auto index = m_breakpoint_indices.find(address);
+  if (index == m_breakpoint_indices.end())
     return;
 
-  m_breakpoints.erase(iter);
+  m_breakpoints.erase(m_breakpoints.begin() + index->second);
+  RebuildIndex();
   m_system.GetJitInterface().InvalidateICache(address, 4, true);
 }
 
@@ -184,6 +197,7 @@ void BreakPoints::Clear()
   }
 
   m_breakpoints.clear();
+  m_breakpoint_indices.clear();
 }
 
 void BreakPoints::ClearAllTemporary()
@@ -201,6 +215,7 @@ void BreakPoints::ClearAllTemporary()
       ++bp;
     }
   }
+  RebuildIndex();
 }
 
 MemChecks::MemChecks(Core::System& system) : m_system(system)
@@ -270,8 +285,6 @@ void MemChecks::AddFromStrings(const TMemChecksStr& mc_strings)
 
 void MemChecks::Add(TMemCheck memory_check)
 {
-  bool had_any = HasAny();
-
   const Core::CPUThreadGuard guard(m_system);
   // Check for existing breakpoint, and overwrite with new info.
   // This is assuming we usually want the new breakpoint over an old one.
@@ -290,11 +303,9 @@ void MemChecks::Add(TMemCheck memory_check)
   {
     m_mem_checks.emplace_back(std::move(memory_check));
   }
-  // If this is the first one, clear the JIT cache so it can switch to
-  // watchpoint-compatible code.
-  if (!had_any)
-    m_system.GetJitInterface().ClearCache(guard);
-  m_system.GetMMU().DBATUpdated();
+  // Clear the JIT cache so that code which accesses the newly watched addresses directly is
+  // recompiled to check them.
+  Update(guard, true);
 }
 
 bool MemChecks::ToggleBreakPoint(u32 address)
@@ -320,47 +331,124 @@ void MemChecks::Remove(u32 address)
 
   const Core::CPUThreadGuard guard(m_system);
   m_mem_checks.erase(iter);
-  if (!HasAny())
-    m_system.GetJitInterface().ClearCache(guard);
-  m_system.GetMMU().DBATUpdated();
+  Update(guard, !HasAny());
 }
 
 void MemChecks::Clear()
 {
   const Core::CPUThreadGuard guard(m_system);
   m_mem_checks.clear();
-  m_system.GetJitInterface().ClearCache(guard);
+  Update(guard, true);
+}
+
+void MemChecks::Update(const Core::CPUThreadGuard& guard, bool clear_jit_cache)
+{
+  RebuildIndex();
+  if (clear_jit_cache)
+    m_system.GetJitInterface().ClearCache(guard);
   m_system.GetMMU().DBATUpdated();
+  m_system.GetMemory().UpdateMemCheckProtection();
+}
+
+void MemChecks::RebuildIndex()
+{
+  m_page_index.clear();
+  m_wide_mem_checks.clear();
+  m_watched_ranges.clear();
+
+  for (size_t i = 0; i < m_mem_checks.size(); ++i)
+  {
+    const TMemCheck& mc = m_mem_checks[i];
+    const u32 first_page = mc.start_address >> INDEX_PAGE_SHIFT;
+    const u32 last_page = mc.end_address >> INDEX_PAGE_SHIFT;
+    if (last_page < first_page || last_page - first_page >= MAX_INDEXED_PAGES)
+    {
+      m_wide_mem_checks.push_back(i);
+    }
+    else
+    {
+      for (u32 page = first_page; page <= last_page; ++page)
+        m_page_index[page].push_back(i);
+    }
+
+    if (mc.start_address <= mc.end_address)
+      m_watched_ranges.emplace_back(mc.start_address, mc.end_address);
+  }
+
+  std::sort(m_watched_ranges.begin(), m_watched_ranges.end());
+  size_t merged = 0;
+  for (size_t i = 0; i < m_watched_ranges.size(); ++i)
+  {
+    if (merged != 0 && m_watched_ranges[i].first <= m_watched_ranges[merged - 1].second + u64{1})
+    {
+      m_watched_ranges[merged - 1].second =
+          std::max(m_watched_ranges[merged - 1].second, m_watched_ranges[i].second);
+    }
+    else
+    {
+      m_watched_ranges[merged++] = m_watched_ranges[i];
+    }
+  }
+  m_watched_ranges.resize(merged);
 }
 
 TMemCheck* MemChecks::GetMemCheck(u32 address, size_t size)
 {
-  const auto iter =
-      std::find_if(m_mem_checks.begin(), m_mem_checks.end(), [address, size](const auto& mc) {
-        return mc.end_address >= address && address + size - 1 >= mc.start_address;
-      });
+  if (m_mem_checks.empty())
+    return nullptr;
+
+  const u32 last_address = address + static_cast<u32>(size - 1);
+  const u32 first_page = address >> INDEX_PAGE_SHIFT;
+  const u32 last_page = last_address >> INDEX_PAGE_SHIFT;
+
+  // The first matching memcheck wins, as it did when they were searched in order.
+  size_t found = m_mem_checks.size();
+  const auto consider = [&](size_t i) {
+    const TMemCheck& mc = m_mem_checks[i];
+    if (i < found && mc.end_address >= address && last_address >= mc.start_address)
+      found = i;
+  };
+
+  if (last_page < first_page || last_page - first_page >= MAX_INDEXED_PAGES)
+  {
+    for (size_t i = 0; i < m_mem_checks.size(); ++i)
+      consider(i);
+  }
+  else
+  {
+    for (const size_t i : m_wide_mem_checks)
+      consider(i);
+    for (u32 page = first_page; page <= last_page; ++page)
+    {
+      const auto iter = m_page_index.find(page);
+      if (iter == m_page_index.end())
+        continue;
+      for (const size_t i : iter->second)
+        consider(i);
+    }
+  }
 
   // None found
-  if (iter == m_mem_checks.cend())
+  if (found == m_mem_checks.size())
     return nullptr;
 
-  return &*iter;
+  return &m_mem_checks[found];
 }
 
 bool MemChecks::OverlapsMemcheck(u32 address, u32 length) const
 {
-  if (!HasAny())
+  if (!HasAny() || length == 0)
     return false;
 
-  const u32 page_end_suffix = length - 1;
-  const u32 page_end_address = address | page_end_suffix;
+  const u32 last_address = address + (length - 1);
+  if (last_address < address)
+    return OverlapsMemcheck(address, 0u - address) || OverlapsMemcheck(0, last_address + 1);
 
-  return std::any_of(m_mem_checks.cbegin(), m_mem_checks.cend(), [&](const auto& mc) {
-    return ((mc.start_address | page_end_suffix) == page_end_address ||
-            (mc.end_address | page_end_suffix) == page_end_address) ||
-           ((mc.start_address | page_end_suffix) < page_end_address &&
-            (mc.end_address | page_end_suffix) > page_end_address);
-  });
+  // The first range that ends at or after the address is the only one that can overlap it.
+  const auto iter = std::lower_bound(
+      m_watched_ranges.cbegin(), m_watched_ranges.cend(), address,
+      [](const std::pair<u32, u32>& range, u32 value) { return range.second < value; });
+  return iter != m_watched_ranges.cend() && iter->first <= last_address;
 }
 
 bool TMemCheck::Action(Core::System& system, u64 value, u32 addr, bool write, size_t size, u32 pc)
@@ -6,6 +6,8 @@
 #include <cstddef>
 #include <optional>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "Common/CommonTypes.h"
@@ -13,8 +15,9 @@
 
 namespace Core
 {
+class CPUThreadGuard;
 class System;
-}
+}  // namespace Core
 
 struct TBreakPoint
 {
@@ -87,7 +90,14 @@ public:
   void ClearAllTemporary();
 
 private:
+  TBreakPoint* Find(u32 address);
+  const TBreakPoint* Find(u32 address) const;
+  void RebuildIndex();
+
   TBreakPoints m_breakpoints;
+  // Index of the breakpoint at each address in m_breakpoints, since these are looked up for every
+  // instruction that gets compiled or interpreted while debugging.
+  std::unordered_map<u32, size_t> m_breakpoint_indices;
   Core::System& m_system;
 };
 
@@ -122,6 +132,19 @@ public:
   bool HasAny() const { return !m_mem_checks.empty(); }
 
 private:
+  // Memchecks are looked up on every slow memory access, so they are indexed by 4 KiB page. The
+  // ones that span too many pages to index are searched linearly instead.
+  static constexpr u32 INDEX_PAGE_SHIFT = 12;
+  static constexpr u32 MAX_INDEXED_PAGES = 256;
+
+  void RebuildIndex();
+  // Updates everything that depends on the set of watched addresses.
+  void Update(const Core::CPUThreadGuard& guard, bool clear_jit_cache);
+
   TMemChecks m_mem_checks;
+  std::unordered_map<u32, std::vector<size_t>> m_page_index;
+  std::vector<size_t> m_wide_mem_checks;
+  // Sorted and disjoint [start, end] ranges that are covered by any memcheck.
+  std::vector<std::pair<u32, u32>> m_watched_ranges;
   Core::System& m_system;
 };
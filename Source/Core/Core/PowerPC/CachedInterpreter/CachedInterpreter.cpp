@@ -3,6 +3,9 @@
 
 #include "Core/PowerPC/CachedInterpreter/CachedInterpreter.h"
 
+#include <algorithm>
+#include <array>
+
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
 #include "Core/ConfigManager.h"
@@ -23,6 +26,14 @@ struct CachedInterpreter::Instruction
   using InterpreterCallback = void (*)(Interpreter&, UGeckoInstruction);
   using CachedInterpreterCallback = void (*)(CachedInterpreter&, UGeckoInstruction);
   using ConditionalCachedInterpreterCallback = bool (*)(CachedInterpreter&, u32);
+  using InterpreterPairCallback = void (*)(Interpreter&, UGeckoInstruction, UGeckoInstruction);
+  using InterpreterTripleCallback = void (*)(Interpreter&, UGeckoInstruction, UGeckoInstruction,
+                                             UGeckoInstruction);
+
+  // Tags the entries that carry the second and third instruction of a fused group.
+  struct PayloadTag
+  {
+  };
 
   Instruction() {}
   Instruction(const CommonCallback c, UGeckoInstruction i)
@@ -51,6 +62,18 @@ struct CachedInterpreter::Instruction
   {
   }
 
+  Instruction(const InterpreterPairCallback c, UGeckoInstruction i)
+      : interpreter_pair_callback(c), data(i.hex), type(Type::InterpreterPair)
+  {
+  }
+
+  Instruction(const InterpreterTripleCallback c, UGeckoInstruction i)
+      : interpreter_triple_callback(c), data(i.hex), type(Type::InterpreterTriple)
+  {
+  }
+
+  Instruction(PayloadTag, UGeckoInstruction i) : data(i.hex), type(Type::Payload) {}
+
   enum class Type
   {
     Abort,
@@ -59,6 +82,9 @@ struct CachedInterpreter::Instruction
     Interpreter,
     CachedInterpreter,
     ConditionalCachedInterpreter,
+    InterpreterPair,
+    InterpreterTriple,
+    Payload,
   };
 
   union
@@ -68,12 +94,82 @@ struct CachedInterpreter::Instruction
     const InterpreterCallback interpreter_callback;
     const CachedInterpreterCallback cached_interpreter_callback;
     const ConditionalCachedInterpreterCallback conditional_cached_interpreter_callback;
+    const InterpreterPairCallback interpreter_pair_callback;
+    const InterpreterTripleCallback interpreter_triple_callback;
   };
 
   u32 data = 0;
   Type type = Type::Abort;
 };
 
+namespace
+{
+// Superinstructions for common sequences. Calling the interpreter functions directly lets the
+// compiler inline them, and the group only goes through the dispatch loop once.
+template <Interpreter::Instruction First, Interpreter::Instruction Second>
+void FusedPair(Interpreter& interpreter, UGeckoInstruction first, UGeckoInstruction second)
+{
+  First(interpreter, first);
+  Second(interpreter, second);
+}
+
+template <Interpreter::Instruction First, Interpreter::Instruction Second,
+          Interpreter::Instruction Third>
+void FusedTriple(Interpreter& interpreter, UGeckoInstruction first, UGeckoInstruction second,
+                 UGeckoInstruction third)
+{
+  First(interpreter, first);
+  Second(interpreter, second);
+  Third(interpreter, third);
+}
+
+struct FusedPairPattern
+{
+  std::array<Interpreter::Instruction, 2> ops;
+  void (*callback)(Interpreter&, UGeckoInstruction, UGeckoInstruction);
+};
+
+struct FusedTriplePattern
+{
+  std::array<Interpreter::Instruction, 3> ops;
+  void (*callback)(Interpreter&, UGeckoInstruction, UGeckoInstruction, UGeckoInstruction);
+};
+
+template <Interpreter::Instruction First, Interpreter::Instruction Second>
+constexpr FusedPairPattern Pair()
+{
+  return {{First, Second}, FusedPair<First, Second>};
+}
+
+template <Interpreter::Instruction First, Interpreter::Instruction Second,
+          Interpreter::Instruction Third>
+constexpr FusedTriplePattern Triple()
+{
+  return {{First, Second, Third}, FusedTriple<First, Second, Third>};
+}
+
+constexpr std::array s_fused_triples{
+    Triple<Interpreter::lwz, Interpreter::cmpi, Interpreter::bcx>(),
+    Triple<Interpreter::lwz, Interpreter::cmpli, Interpreter::bcx>(),
+    Triple<Interpreter::lbz, Interpreter::cmpli, Interpreter::bcx>(),
+    Triple<Interpreter::lhz, Interpreter::cmpli, Interpreter::bcx>(),
+};
+
+constexpr std::array s_fused_pairs{
+    Pair<Interpreter::cmpi, Interpreter::bcx>(),
+    Pair<Interpreter::cmpli, Interpreter::bcx>(),
+    Pair<Interpreter::cmp, Interpreter::bcx>(),
+    Pair<Interpreter::cmpl, Interpreter::bcx>(),
+    Pair<Interpreter::addi, Interpreter::stw>(),
+    Pair<Interpreter::addi, Interpreter::lwz>(),
+    Pair<Interpreter::lwz, Interpreter::stw>(),
+    Pair<Interpreter::psq_l, Interpreter::ps_madd>(),
+    Pair<Interpreter::psq_l, Interpreter::ps_mul>(),
+    Pair<Interpreter::psq_l, Interpreter::ps_add>(),
+    Pair<Interpreter::lfs, Interpreter::fmaddsx>(),
+};
+}  // namespace
+
 CachedInterpreter::CachedInterpreter(Core::System& system) : JitBase(system)
 {
 }
@@ -143,6 +239,19 @@ void CachedInterpreter::ExecuteOneBlock()
         return;
       break;
 
+    case Instruction::Type::InterpreterPair:
+      code->interpreter_pair_callback(interpreter, UGeckoInstruction(code->data),
+                                      UGeckoInstruction(code[1].data));
+      code += 1;
+      break;
+
+    case Instruction::Type::InterpreterTriple:
+      code->interpreter_triple_callback(interpreter, UGeckoInstruction(code->data),
+                                        UGeckoInstruction(code[1].data),
+                                        UGeckoInstruction(code[2].data));
+      code += 2;
+      break;
+
     default:
       ERROR_LOG_FMT(POWERPC, "Unknown CachedInterpreter Instruction: {}",
                     static_cast<int>(code->type));
@@ -286,6 +395,93 @@ bool CachedInterpreter::HandleFunctionHooking(u32 address)
   return true;
 }
 
+bool CachedInterpreter::CanFuse(const PPCAnalyst::CodeOp& op, bool last_in_group)
+{
+  // Fused instructions can't have any of the checks Jit emits around an instruction, and only the
+  // last one may end the block, since its WritePC is hoisted above the whole group.
+  const bool endblock = (op.opinfo->flags & FL_ENDBLOCK) != 0;
+  return !op.skip && !op.branchIsIdleLoop && (last_in_group || !endblock) &&
+         !(m_enable_debugging &&
+           m_system.GetPowerPC().GetBreakPoints().IsBreakPointEnable(op.address)) &&
+         !((op.opinfo->flags & FL_USE_FPU) && !js.firstFPInstructionFound) &&
+         !((op.opinfo->flags & FL_LOADSTORE) && jo.memcheck) &&
+         (endblock || !ShouldHandleFPExceptionForInstruction(&op));
+}
+
+u32 CachedInterpreter::EmitFusedGroup(u32 index)
+{
+  const auto matches = [&](const auto& ops) {
+    if (index + ops.size() > code_block.m_num_instructions)
+      return false;
+
+    for (size_t i = 0; i < ops.size(); i++)
+    {
+      const PPCAnalyst::CodeOp& op = m_code_buffer[index + i];
+      if (Interpreter::GetInterpreterOp(op.inst) != ops[i] || !CanFuse(op, i == ops.size() - 1))
+        return false;
+
+      // Hooked functions start at the first instruction of the group or not at all.
+      if (i != 0 &&
+          HLE::TryReplaceFunction(m_ppc_symbol_db, op.address, PowerPC::CoreMode::JIT))
+      {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  const auto find_pattern = [&](const auto& patterns) {
+    const auto it = std::find_if(patterns.begin(), patterns.end(),
+                                 [&](const auto& pattern) { return matches(pattern.ops); });
+    return it != patterns.end() ? &*it : nullptr;
+  };
+
+  const FusedTriplePattern* triple = find_pattern(s_fused_triples);
+  const FusedPairPattern* pair = triple ? nullptr : find_pattern(s_fused_pairs);
+  if (!triple && !pair)
+    return 0;
+
+  const u32 length = triple ? 3 : 2;
+
+  // The caller has already accounted for the first instruction.
+  for (u32 i = 1; i < length; i++)
+  {
+    const PPCAnalyst::CodeOp& op = m_code_buffer[index + i];
+    js.downcountAmount += op.opinfo->num_cycles;
+    if (op.opinfo->flags & FL_LOADSTORE)
+      ++js.numLoadStoreInst;
+    if (op.opinfo->flags & FL_USE_FPU)
+      ++js.numFloatingPointInst;
+  }
+
+  const PPCAnalyst::CodeOp& last = m_code_buffer[index + length - 1];
+  const bool endblock = (last.opinfo->flags & FL_ENDBLOCK) != 0;
+  if (endblock)
+    m_code.emplace_back(WritePC, last.address);
+
+  const UGeckoInstruction first_inst = m_code_buffer[index].inst;
+  if (triple)
+    m_code.emplace_back(triple->callback, first_inst);
+  else
+    m_code.emplace_back(pair->callback, first_inst);
+  for (u32 i = 1; i < length; i++)
+    m_code.emplace_back(Instruction::PayloadTag{}, m_code_buffer[index + i].inst);
+
+  if (endblock)
+    WriteEndBlock();
+
+  return length;
+}
+
+void CachedInterpreter::WriteEndBlock()
+{
+  m_code.emplace_back(EndBlock, js.downcountAmount);
+  if (js.numLoadStoreInst != 0)
+    m_code.emplace_back(UpdateNumLoadStoreInstructions, js.numLoadStoreInst);
+  if (js.numFloatingPointInst != 0)
+    m_code.emplace_back(UpdateNumFloatingPointInstructions, js.numFloatingPointInst);
+}
+
 void CachedInterpreter::Jit(u32 address)
 {
   if (m_code.size() >= CODE_SIZE / sizeof(Instruction) - 0x1000 ||
@@ -331,11 +527,17 @@ void CachedInterpreter::Jit(u32 address)
     if (HandleFunctionHooking(op.address))
       break;
 
+    if (const u32 fused = EmitFusedGroup(i); fused != 0)
+    {
+      i += fused - 1;
+      continue;
+    }
+
     if (!op.skip)
     {
       const bool breakpoint =
           m_enable_debugging &&
-          m_system.GetPowerPC().GetBreakPoints().IsAddressBreakPoint(op.address);
+          m_system.GetPowerPC().GetBreakPoints().IsBreakPointEnable(op.address);
       const bool check_fpu = (op.opinfo->flags & FL_USE_FPU) && !js.firstFPInstructionFound;
       const bool endblock = (op.opinfo->flags & FL_ENDBLOCK) != 0;
       const bool memcheck = (op.opinfo->flags & FL_LOADSTORE) && jo.memcheck;
@@ -360,25 +562,15 @@ void CachedInterpreter::Jit(u32 address)
       if (check_program_exception)
         m_code.emplace_back(CheckProgramException, js.downcountAmount);
       if (idle_loop)
-        m_code.emplace_back(CheckIdle, js.blockStart);
+        m_code.emplace_back(CheckIdle, op.branchTo);
       if (endblock)
-      {
-        m_code.emplace_back(EndBlock, js.downcountAmount);
-        if (js.numLoadStoreInst != 0)
-          m_code.emplace_back(UpdateNumLoadStoreInstructions, js.numLoadStoreInst);
-        if (js.numFloatingPointInst != 0)
-          m_code.emplace_back(UpdateNumFloatingPointInstructions, js.numFloatingPointInst);
-      }
+        WriteEndBlock();
     }
   }
   if (code_block.m_broken)
   {
     m_code.emplace_back(WriteBrokenBlockNPC, nextPC);
-    m_code.emplace_back(EndBlock, js.downcountAmount);
-    if (js.numLoadStoreInst != 0)
-      m_code.emplace_back(UpdateNumLoadStoreInstructions, js.numLoadStoreInst);
-    if (js.numFloatingPointInst != 0)
-      m_code.emplace_back(UpdateNumFloatingPointInstructions, js.numFloatingPointInst);
+    WriteEndBlock();
   }
   m_code.emplace_back();
 
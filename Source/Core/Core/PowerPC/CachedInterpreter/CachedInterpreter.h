@@ -42,6 +42,11 @@ private:
   void ExecuteOneBlock();
 
   bool HandleFunctionHooking(u32 address);
+  bool CanFuse(const PPCAnalyst::CodeOp& op, bool last_in_group);
+  // Emits a superinstruction for the group starting at m_code_buffer[index] if there is one.
+  // Returns the number of guest instructions it covers, or 0.
+  u32 EmitFusedGroup(u32 index);
+  void WriteEndBlock();
 
   static void EndBlock(CachedInterpreter& cached_interpreter, UGeckoInstruction data);
   static void UpdateNumLoadStoreInstructions(CachedInterpreter& cached_interpreter,
@@ -5,8 +5,11 @@
 
 #include "Core/PowerPC/GDBStub.h"
 
+#include <algorithm>
 #include <fmt/format.h>
 #include <optional>
+#include <span>
+#include <string>
 #include <signal.h>
 #include <stdint.h>
 #include <stdio.h>
@@ -36,6 +39,7 @@ typedef SSIZE_T ssize_t;
 #include "Core/Host.h"
 #include "Core/PowerPC/BreakPoints.h"
 #include "Core/PowerPC/Gekko.h"
+#include "Core/PowerPC/MMU.h"
 #include "Core/PowerPC/PPCCache.h"
 #include "Core/PowerPC/PowerPC.h"
 #include "Core/System.h"
@@ -48,6 +52,8 @@ static std::optional<Common::SocketContext> s_socket_context;
 
 #define GDB_STUB_START '$'
 #define GDB_STUB_END '#'
+#define GDB_STUB_NOTIFY '%'
+#define GDB_STUB_ESCAPE '}'
 #define GDB_STUB_ACK '+'
 #define GDB_STUB_NAK '-'
 
@@ -70,6 +76,9 @@ const s64 GDB_UPDATE_CYCLES = 100000;
 
 static bool s_has_control = false;
 static bool s_just_connected = false;
+// In non-stop mode, gdb keeps sending packets while the target is running, which are answered
+// from UpdateCallback without stopping emulation, and stops are reported with notifications.
+static bool s_non_stop = false;
 
 static int s_tmpsock = -1;
 static int s_sock = -1;
@@ -257,7 +266,7 @@ static void ReadCommand()
   Ack();
 }
 
-static bool IsDataAvailable()
+static bool IsDataAvailable(int timeout_us)
 {
   struct timeval t;
   fd_set _fds, *fds = &_fds;
@@ -266,7 +275,7 @@ static bool IsDataAvailable()
   FD_SET(s_sock, fds);
 
   t.tv_sec = 0;
-  t.tv_usec = 20;
+  t.tv_usec = timeout_us;
 
   if (select(s_sock + 1, fds, nullptr, nullptr, &t) < 0)
   {
@@ -279,7 +288,7 @@ static bool IsDataAvailable()
   return false;
 }
 
-static void SendReply(const char* reply)
+static void SendPacket(u8 start, const char* reply)
 {
   if (!IsActive())
     return;
@@ -295,7 +304,7 @@ static void SendReply(const char* reply)
   s_cmd_len++;
   const u8 chk = CalculateChecksum();
   s_cmd_len--;
-  s_cmd_bfr[0] = GDB_STUB_START;
+  s_cmd_bfr[0] = start;
   s_cmd_bfr[s_cmd_len + 1] = GDB_STUB_END;
   s_cmd_bfr[s_cmd_len + 2] = Nibble2hex(chk >> 4);
   s_cmd_bfr[s_cmd_len + 3] = Nibble2hex(chk);
@@ -317,6 +326,16 @@ static void SendReply(const char* reply)
   }
 }
 
+static void SendReply(const char* reply)
+{
+  SendPacket(GDB_STUB_START, reply);
+}
+
+static void SendNotification(const char* notification)
+{
+  SendPacket(GDB_STUB_NOTIFY, notification);
+}
+
 static void WriteHostInfo()
 {
   return SendReply(
@@ -342,7 +361,25 @@ static void HandleQuery()
   else if (!strncmp((const char*)(s_cmd_bfr), "qHostInfo", strlen("qHostInfo")))
     return WriteHostInfo();
   else if (!strncmp((const char*)(s_cmd_bfr), "qSupported", strlen("qSupported")))
-    return SendReply("swbreak+;hwbreak+");
+  {
+    return SendReply(
+        fmt::format("swbreak+;hwbreak+;QNonStop+;PacketSize={:x}", GDB_BFR_MAX - 4).c_str());
+  }
+
+  SendReply("");
+}
+
+static void HandleSet()
+{
+  DEBUG_LOG_FMT(GDB_STUB, "gdb: set '{}'", CommandBufferAsString());
+
+  if (!strcmp((const char*)(s_cmd_bfr), "QNonStop:0") ||
+      !strcmp((const char*)(s_cmd_bfr), "QNonStop:1"))
+  {
+    s_non_stop = s_cmd_bfr[9] == '1';
+    INFO_LOG_FMT(GDB_STUB, "gdb: non-stop mode {}", s_non_stop ? "enabled" : "disabled");
+    return SendReply("OK");
+  }
 
   SendReply("");
 }
@@ -806,9 +843,78 @@ static void WriteRegister()
   SendReply("OK");
 }
 
+// Copies memory a page at a time where it's backed by RAM, and only goes through the MMU for
+// the rest. Returns how many bytes were read before reaching an address that isn't RAM.
+static u32 CopyFromGuest(const Core::CPUThreadGuard& guard, u8* dst, u32 addr, u32 len)
+{
+  auto& mmu = guard.GetSystem().GetMMU();
+
+  u32 done = 0;
+  while (done < len)
+  {
+    const u32 address = addr + done;
+    const std::span<u8> page = mmu.GetHostSpanForPage(address);
+    if (!page.empty())
+    {
+      const u32 size = static_cast<u32>(std::min<size_t>(page.size(), len - done));
+      memcpy(dst + done, page.data(), size);
+      done += size;
+      continue;
+    }
+
+    // Don't read from MMIO, since that can have side effects.
+    if (!PowerPC::MMU::HostIsRAMAddress(guard, address))
+      break;
+    const auto result = PowerPC::MMU::HostTryReadU8(guard, address);
+    if (!result)
+      break;
+    dst[done++] = result->value;
+  }
+  return done;
+}
+
+static bool CopyToGuest(const Core::CPUThreadGuard& guard, u32 addr, const u8* src, u32 len)
+{
+  auto& system = guard.GetSystem();
+  auto& memory = system.GetMemory();
+
+  u32 done = 0;
+  while (done < len)
+  {
+    const u32 address = addr + done;
+    u32 physical_address;
+    const std::span<u8> page = system.GetMMU().GetHostSpanForPage(address, &physical_address);
+    if (!page.empty())
+    {
+      const u32 size = static_cast<u32>(std::min<size_t>(page.size(), len - done));
+      memcpy(page.data(), src + done, size);
+      memory.MarkRangeWritten(physical_address, size);
+      done += size;
+      continue;
+    }
+
+    if (!PowerPC::MMU::HostIsRAMAddress(guard, address) ||
+        !PowerPC::MMU::HostTryWriteU8(guard, src[done], address))
+    {
+      break;
+    }
+    ++done;
+  }
+
+  // Only the cache lines that were written need to be invalidated, not the whole JIT cache.
+  auto& ppc_state = system.GetPPCState();
+  auto& jit_interface = system.GetJitInterface();
+  const u32 line_count = ((addr & 31) + done + 31) / 32;
+  for (u32 line = 0; line < line_count; ++line)
+    ppc_state.iCache.Invalidate(memory, jit_interface, (addr & ~31u) + line * 32);
+
+  return done == len;
+}
+
 static void ReadMemory(const Core::CPUThreadGuard& guard)
 {
   static u8 reply[GDB_BFR_MAX - 4];
+  static u8 data[sizeof(reply) / 2];
   u32 addr, len;
   u32 i;
 
@@ -823,22 +929,22 @@ static void ReadMemory(const Core::CPUThreadGuard& guard)
     len = (len << 4) | Hex2char(s_cmd_bfr[i++]);
   INFO_LOG_FMT(GDB_STUB, "gdb: read memory: {:08x} bytes from {:08x}", len, addr);
 
-  if (len * 2 > sizeof reply)
-    SendReply("E01");
+  if (len >= sizeof data)
+    return SendReply("E01");
 
-  if (!PowerPC::MMU::HostIsRAMAddress(guard, addr))
+  // gdb accepts a shorter reply if only the start of the range could be read.
+  const u32 read = CopyFromGuest(guard, data, addr, len);
+  if (read == 0 && len != 0)
     return SendReply("E00");
 
-  auto& system = Core::System::GetInstance();
-  auto& memory = system.GetMemory();
-  u8* data = memory.GetPointerForRange(addr, len);
-  Mem2hex(reply, data, len);
-  reply[len * 2] = '\0';
+  Mem2hex(reply, data, read);
+  reply[read * 2] = '\0';
   SendReply((char*)reply);
 }
 
 static void WriteMemory(const Core::CPUThreadGuard& guard)
 {
+  static u8 data[GDB_BFR_MAX / 2];
   u32 addr, len;
   u32 i;
 
@@ -853,23 +959,145 @@ static void WriteMemory(const Core::CPUThreadGuard& guard)
     len = (len << 4) | Hex2char(s_cmd_bfr[i++]);
   INFO_LOG_FMT(GDB_STUB, "gdb: write memory: {:08x} bytes to {:08x}", len, addr);
 
-  if (!PowerPC::MMU::HostIsRAMAddress(guard, addr))
+  if (len > (s_cmd_len - i - 1) / 2)
+    return SendReply("E01");
+
+  Hex2mem(data, s_cmd_bfr + i + 1, len);
+  if (!CopyToGuest(guard, addr, data, len))
     return SendReply("E00");
+  SendReply("OK");
+}
 
-  auto& system = Core::System::GetInstance();
-  auto& memory = system.GetMemory();
-  u8* dst = memory.GetPointerForRange(addr, len);
-  Hex2mem(dst, s_cmd_bfr + i + 1, len);
+// Same as WriteMemory, but the data is sent as binary instead of hex, with '#', '$', '}' and '*'
+// escaped as '}' followed by the byte xored with 0x20.
+static void WriteBinaryMemory(const Core::CPUThreadGuard& guard)
+{
+  static u8 data[GDB_BFR_MAX];
+  u32 addr, len;
+  u32 i;
+
+  i = 1;
+  addr = 0;
+  while (s_cmd_bfr[i] != ',')
+    addr = (addr << 4) | Hex2char(s_cmd_bfr[i++]);
+  i++;
+
+  len = 0;
+  while (s_cmd_bfr[i] != ':')
+    len = (len << 4) | Hex2char(s_cmd_bfr[i++]);
+  i++;
+  INFO_LOG_FMT(GDB_STUB, "gdb: write binary memory: {:08x} bytes to {:08x}", len, addr);
+
+  u32 decoded = 0;
+  while (i < s_cmd_len && decoded < sizeof data)
+  {
+    u8 c = s_cmd_bfr[i++];
+    if (c == GDB_STUB_ESCAPE && i < s_cmd_len)
+      c = s_cmd_bfr[i++] ^ 0x20;
+    data[decoded++] = c;
+  }
+
+  if (decoded != len)
+    return SendReply("E01");
+
+  if (!CopyToGuest(guard, addr, data, len))
+    return SendReply("E00");
   SendReply("OK");
 }
 
+static std::string FormatStopReply(Signal signal)
+{
+  auto& ppc_state = Core::System::GetInstance().GetPPCState();
+  return fmt::format("T{:02x}{:02x}:{:08x};{:02x}:{:08x};", static_cast<u8>(signal), 64,
+                     ppc_state.pc, 1, ppc_state.gpr[1]);
+}
+
 static void Step()
 {
+  // In non-stop mode, the stop is only reported later, with a notification.
+  if (s_non_stop)
+    SendReply("OK");
+
   auto& system = Core::System::GetInstance();
   system.GetCPU().EnableStepping(true);
   Core::CallOnStateChangedCallbacks(Core::State::Paused);
 }
 
+static void Continue()
+{
+  if (s_non_stop)
+    SendReply("OK");
+
+  auto& system = Core::System::GetInstance();
+  system.GetCPU().Continue();
+  s_has_control = false;
+}
+
+static void HandleStopReason()
+{
+  if (!s_non_stop)
+    return SendSignal(Signal::Sigterm);
+
+  // There's only one thread, so either it's stopped or there's nothing to report.
+  if (!s_has_control)
+    return SendReply("OK");
+
+  SendReply(FormatStopReply(Signal::Sigtrap).c_str());
+}
+
+// Returns whether the target was resumed, in which case ProcessCommands has to return.
+static bool HandleVCommand()
+{
+  const char* command = CommandBufferAsString();
+
+  if (!strcmp(command, "vCont?"))
+  {
+    SendReply("vCont;c;C;s;S;t");
+    return false;
+  }
+  if (!strcmp(command, "vStopped"))
+  {
+    // Every stop is reported on its own, so there are never more of them queued.
+    SendReply("OK");
+    return false;
+  }
+  if (strncmp(command, "vCont;", strlen("vCont;")))
+  {
+    SendReply("");
+    return false;
+  }
+
+  // There's only one thread, so only the first action matters.
+  switch (s_cmd_bfr[strlen("vCont;")])
+  {
+  case 'c':
+  case 'C':
+    Continue();
+    return true;
+  case 's':
+  case 'S':
+    Step();
+    return true;
+  case 't':
+  {
+    SendReply("OK");
+    if (s_has_control)
+    {
+      SendSignal(Signal::Sigtrap);
+      return false;
+    }
+    auto& system = Core::System::GetInstance();
+    system.GetCPU().Break();
+    s_has_control = true;
+    INFO_LOG_FMT(GDB_STUB, "gdb: CPU::Break due to vCont;t");
+    return true;
+  }
+  default:
+    SendReply("E01");
+    return false;
+  }
+}
+
 static bool AddBreakpoint(BreakpointType type, u32 addr, u32 len)
 {
   if (type == BreakpointType::ExecuteHard || type == BreakpointType::ExecuteSoft)
@@ -959,7 +1187,8 @@ void ProcessCommands(bool loop_until_continue)
       return;
     }
 
-    if (!IsDataAvailable())
+    // Don't wait for data when polling from UpdateCallback, which would stall emulation.
+    if (!IsDataAvailable(loop_until_continue ? 20 : 0))
     {
       if (loop_until_continue)
         continue;
@@ -976,6 +1205,9 @@ void ProcessCommands(bool loop_until_continue)
     case 'q':
       HandleQuery();
       break;
+    case 'Q':
+      HandleSet();
+      break;
     case 'H':
       HandleSetThread();
       break;
@@ -983,7 +1215,7 @@ void ProcessCommands(bool loop_until_continue)
       HandleIsThreadAlive();
       break;
     case '?':
-      SendSignal(Signal::Sigterm);
+      HandleStopReason();
       break;
     case 'k':
       Deinit();
@@ -1015,9 +1247,15 @@ void ProcessCommands(bool loop_until_continue)
       Core::CPUThreadGuard guard(system);
 
       WriteMemory(guard);
-      auto& ppc_state = system.GetPPCState();
-      auto& jit_interface = system.GetJitInterface();
-      ppc_state.iCache.Reset(jit_interface);
+      Host_UpdateDisasmDialog();
+      break;
+    }
+    case 'X':
+    {
+      ASSERT(Core::IsCPUThread());
+      Core::CPUThreadGuard guard(system);
+
+      WriteBinaryMemory(guard);
       Host_UpdateDisasmDialog();
       break;
     }
@@ -1026,9 +1264,12 @@ void ProcessCommands(bool loop_until_continue)
       return;
     case 'C':
     case 'c':
-      cpu.Continue();
-      s_has_control = false;
+      Continue();
       return;
+    case 'v':
+      if (HandleVCommand())
+        return;
+      break;
     case 'z':
       HandleRemoveBreakpoint();
       break;
@@ -1103,6 +1344,7 @@ static void InitGeneric(int domain, const sockaddr* server_addr, socklen_t serve
     ERROR_LOG_FMT(GDB_STUB, "Failed to accept gdb client");
   INFO_LOG_FMT(GDB_STUB, "Client connected.");
   s_just_connected = true;
+  s_non_stop = false;
 
 #ifdef _WIN32
   closesocket(s_tmpsock);
@@ -1133,6 +1375,7 @@ void Deinit()
 
   s_socket_context.reset();
   s_has_control = false;
+  s_non_stop = false;
 }
 
 bool IsActive()
@@ -1157,12 +1400,9 @@ bool JustConnected()
 
 void SendSignal(Signal signal)
 {
-  auto& system = Core::System::GetInstance();
-  auto& ppc_state = system.GetPPCState();
-
-  char bfr[128] = {};
-  fmt::format_to(bfr, "T{:02x}{:02x}:{:08x};{:02x}:{:08x};", static_cast<u8>(signal), 64,
-                 ppc_state.pc, 1, ppc_state.gpr[1]);
-  SendReply(bfr);
+  if (s_non_stop)
+    SendNotification(("Stop:" + FormatStopReply(signal)).c_str());
+  else
+    SendReply(FormatStopReply(signal).c_str());
 }
 }  // namespace GDBStub
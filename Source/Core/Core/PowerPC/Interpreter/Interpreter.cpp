@@ -118,6 +118,24 @@ bool Interpreter::HandleFunctionHooking(u32 address)
   return result.type != HLE::HookType::Start;
 }
 
+Interpreter::DecodedInstruction Interpreter::Decode(UGeckoInstruction inst, u32 address)
+{
+  DecodedInstruction& entry = m_decode_cache[(address >> 2) % DECODE_CACHE_SIZE];
+  if (entry.hex == inst.hex && entry.op != nullptr)
+    return entry;
+
+  const DecodedInstruction decoded{inst.hex, GetInterpreterOp(inst),
+                                   PPCTables::GetOpInfo(inst, address)};
+
+  // Invalid instructions aren't cached, so that GetOpInfo keeps reporting them.
+  if (inst.hex != 0 && decoded.opinfo->type != OpType::Invalid &&
+      decoded.opinfo->type != OpType::Unknown)
+  {
+    entry = decoded;
+  }
+  return decoded;
+}
+
 int Interpreter::SingleStepInner()
 {
   if (HandleFunctionHooking(m_ppc_state.pc))
@@ -132,7 +150,8 @@ int Interpreter::SingleStepInner()
   m_ppc_state.npc = m_ppc_state.pc + sizeof(UGeckoInstruction);
   m_prev_inst.hex = m_mmu.Read_Opcode(m_ppc_state.pc);
 
-  const GekkoOPInfo* opinfo = PPCTables::GetOpInfo(m_prev_inst, m_ppc_state.pc);
+  const DecodedInstruction decoded = Decode(m_prev_inst, m_ppc_state.pc);
+  const GekkoOPInfo* opinfo = decoded.opinfo;
 
   // Uncomment to trace the interpreter
   // if ((m_ppc_state.pc & 0x00FFFFFF) >= 0x000AB54C &&
@@ -159,7 +178,7 @@ int Interpreter::SingleStepInner()
     }
     else if (m_ppc_state.msr.FP)
     {
-      RunInterpreterOp(*this, m_prev_inst);
+      decoded.op(*this, m_prev_inst);
       if ((m_ppc_state.Exceptions & EXCEPTION_DSI) != 0)
       {
         CheckExceptions();
@@ -175,7 +194,7 @@ int Interpreter::SingleStepInner()
       }
       else
       {
-        RunInterpreterOp(*this, m_prev_inst);
+        decoded.op(*this, m_prev_inst);
         if ((m_ppc_state.Exceptions & EXCEPTION_DSI) != 0)
         {
           CheckExceptions();
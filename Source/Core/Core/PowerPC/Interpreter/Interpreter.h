@@ -20,6 +20,7 @@ class MMU;
 struct PowerPCState;
 }  // namespace PowerPC
 class PPCSymbolDB;
+struct GekkoOPInfo;
 
 class Interpreter : public CPUCoreBase
 {
@@ -295,8 +296,22 @@ public:
   static u32 Helper_Carry(u32 value1, u32 value2);
 
 private:
+  // An instruction that was decoded at an address. Entries are only used while the instruction
+  // fetched from that address is the same, so they never have to be invalidated.
+  struct DecodedInstruction
+  {
+    u32 hex = 0;
+    Instruction op = nullptr;
+    const GekkoOPInfo* opinfo = nullptr;
+  };
+
+  // Covers 4 KiB of code, indexed by address.
+  static constexpr u32 DECODE_CACHE_SIZE = 1024;
+
   void CheckExceptions();
 
+  DecodedInstruction Decode(UGeckoInstruction inst, u32 address);
+
   bool HandleFunctionHooking(u32 address);
 
   // flag helper
@@ -321,6 +336,7 @@ private:
   PPCSymbolDB& m_ppc_symbol_db;
 
   UGeckoInstruction m_prev_inst{};
+  std::array<DecodedInstruction, DECODE_CACHE_SIZE> m_decode_cache{};
   u32 m_last_pc = 0;
   bool m_end_block = false;
   bool m_start_trace = false;
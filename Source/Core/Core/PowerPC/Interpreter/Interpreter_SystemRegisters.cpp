@@ -204,6 +204,7 @@ void Interpreter::mtsr(Interpreter& interpreter, UGeckoInstruction inst)
   const u32 index = inst.SR;
   const u32 value = ppc_state.gpr[inst.RS];
   ppc_state.SetSR(index, value);
+  interpreter.m_mmu.SRUpdated(index);
 }
 
 void Interpreter::mtsrin(Interpreter& interpreter, UGeckoInstruction inst)
@@ -218,6 +219,7 @@ void Interpreter::mtsrin(Interpreter& interpreter, UGeckoInstruction inst)
   const u32 index = (ppc_state.gpr[inst.RB] >> 28) & 0xF;
   const u32 value = ppc_state.gpr[inst.RS];
   ppc_state.SetSR(index, value);
+  interpreter.m_mmu.SRUpdated(index);
 }
 
 void Interpreter::mftb(Interpreter& interpreter, UGeckoInstruction inst)
@@ -3,6 +3,7 @@
 
 #include "Core/PowerPC/Jit64/Jit.h"
 
+#include <chrono>
 #include <map>
 #include <sstream>
 #include <string>
@@ -22,6 +23,7 @@
 #include "Common/Logging/Log.h"
 #include "Common/StringUtil.h"
 #include "Common/Swap.h"
+#include "Common/TraceZone.h"
 #include "Common/x64ABI.h"
 #include "Core/Core.h"
 #include "Core/CoreTiming.h"
@@ -44,10 +46,16 @@
 #include "Core/PowerPC/PPCAnalyst.h"
 #include "Core/PowerPC/PowerPC.h"
 #include "Core/System.h"
+#include "VideoCommon/FrameTimeReport.h"
 
 using namespace Gen;
 using namespace PowerPC;
 
+static constexpr int RETURN_STACK_GUEST_OFF =
+    PPCSTATE_OFF(return_stack) + static_cast<int>(offsetof(ReturnStackEntry, guest_address));
+static constexpr int RETURN_STACK_HOST_OFF =
+    PPCSTATE_OFF(return_stack) + static_cast<int>(offsetof(ReturnStackEntry, host_address));
+
 // Dolphin's PowerPC->x86_64 JIT dynamic recompiler
 // Written mostly by ector (hrydgard)
 // Features:
@@ -152,13 +160,14 @@ bool Jit64::HandleFault(uintptr_t access_address, SContext* ctx)
                    ctx->CTX_PC, access_address, memory_base, ppc_state.msr.DR);
     }
 
-    return BackPatch(ctx);
+    ++m_statistics.fastmem_faults;
+    return BackPatch(access_address, ctx);
   }
 
   return false;
 }
 
-bool Jit64::BackPatch(SContext* ctx)
+bool Jit64::BackPatch(uintptr_t access_address, SContext* ctx)
 {
   u8* codePtr = reinterpret_cast<u8*>(ctx->CTX_PC);
 
@@ -174,6 +183,12 @@ bool Jit64::BackPatch(SContext* ctx)
 
   TrampolineInfo& info = it->second;
 
+  // Faults on page table translations that haven't been mapped yet go away once they are.
+  if (m_mmu.MapPageTableTranslation(access_address))
+    return true;
+
+  RecordFastmemFault(info.pc);
+
   u8* exceptionHandler = nullptr;
   if (jo.memcheck)
   {
@@ -298,8 +313,10 @@ void Jit64::Init()
 
 void Jit64::ClearCache()
 {
+  ++m_statistics.cache_clears;
   blocks.Clear();
   blocks.ClearRangesToFree();
+  m_ppc_state.ResetReturnStack();
   trampolines.ClearCodeSpace();
   m_far_code.ClearCodeSpace();
   m_const_pool.Clear();
@@ -395,7 +412,7 @@ void Jit64::HLEFunction(u32 hook_index)
   gpr.Flush();
   fpr.Flush();
   ABI_PushRegistersAndAdjustStack({}, 0);
-  ABI_CallFunctionCCP(HLE::ExecuteFromJIT, js.compilerPC, hook_index, &m_system);
+  ABI_CallFunctionP(HLE::GetJITHookFunction(hook_index), &m_system);
   ABI_PopRegistersAndAdjustStack({}, 0);
 }
 
@@ -526,8 +543,26 @@ void Jit64::MSRUpdated(const OpArg& msr, X64Reg scratch_reg)
   }
 }
 
+void Jit64::FlushRegistersForExit(u32 destination)
+{
+  // Registers that the destination overwrites before reading don't need to be written back.
+  if (destination == code_block.m_dead_on_exit_address)
+  {
+    gpr.Discard(code_block.m_gpr_dead_on_exit);
+    fpr.Discard(code_block.m_fpr_dead_on_exit);
+    gpr.Flush(~code_block.m_gpr_dead_on_exit);
+    fpr.Flush(~code_block.m_fpr_dead_on_exit);
+  }
+  else
+  {
+    gpr.Flush();
+    fpr.Flush();
+  }
+}
+
 void Jit64::WriteExit(u32 destination, bool bl, u32 after)
 {
+  const bool push_return_stack = bl && UseReturnStack();
   if (!m_enable_blr_optimization)
     bl = false;
 
@@ -539,9 +574,38 @@ void Jit64::WriteExit(u32 destination, bool bl, u32 after)
     PUSH(RSCRATCH2);
   }
 
+  FixupBranch continuation;
+  if (push_return_stack)
+    continuation = WriteReturnStackPush(after);
+
   SUB(32, PPCSTATE(downcount), Imm32(js.downcountAmount));
 
   JustWriteExit(destination, bl, after);
+
+  if (push_return_stack)
+  {
+    SetJumpTarget(continuation);
+    JustWriteExit(after, false, 0);
+  }
+}
+
+FixupBranch Jit64::WriteReturnStackPush(u32 after)
+{
+  // The continuation is emitted after the exit, so load its address with a RIP-relative LEA whose
+  // displacement gets patched like the one of a 32-bit jump.
+  LEA(64, RSCRATCH, M(GetCodePtr()));
+  const FixupBranch continuation{GetWritableCodePtr(), FixupBranch::Type::Branch32Bit};
+
+  MOV(32, R(RSCRATCH2), PPCSTATE(return_stack_index));
+  ADD(32, R(RSCRATCH2), Imm8(1));
+  AND(32, R(RSCRATCH2), Imm32(PowerPC::RETURN_STACK_SIZE - 1));
+  MOV(32, PPCSTATE(return_stack_index), R(RSCRATCH2));
+  SHL(32, R(RSCRATCH2), Imm8(4));
+  MOV(64, MComplex(RPPCSTATE, RSCRATCH2, SCALE_1, RETURN_STACK_HOST_OFF), R(RSCRATCH));
+  MOV(64, R(RSCRATCH), Imm64(u64(m_ppc_state.feature_flags) << 32 | after));
+  MOV(64, MComplex(RPPCSTATE, RSCRATCH2, SCALE_1, RETURN_STACK_GUEST_OFF), R(RSCRATCH));
+
+  return continuation;
 }
 
 void Jit64::JustWriteExit(u32 destination, bool bl, u32 after)
@@ -585,6 +649,7 @@ void Jit64::JustWriteExit(u32 destination, bool bl, u32 after)
 
 void Jit64::WriteExitDestInRSCRATCH(bool bl, u32 after)
 {
+  const bool push_return_stack = bl && UseReturnStack();
   if (!m_enable_blr_optimization)
     bl = false;
   MOV(32, PPCSTATE(pc), R(RSCRATCH));
@@ -596,6 +661,10 @@ void Jit64::WriteExitDestInRSCRATCH(bool bl, u32 after)
     PUSH(RSCRATCH2);
   }
 
+  FixupBranch continuation;
+  if (push_return_stack)
+    continuation = WriteReturnStackPush(after);
+
   SUB(32, PPCSTATE(downcount), Imm32(js.downcountAmount));
   if (bl)
   {
@@ -607,13 +676,58 @@ void Jit64::WriteExitDestInRSCRATCH(bool bl, u32 after)
   {
     JMP(asm_routines.dispatcher, Jump::Near);
   }
+
+  if (push_return_stack)
+  {
+    SetJumpTarget(continuation);
+    JustWriteExit(after, false, 0);
+  }
+}
+
+void Jit64::WriteIndirectBranchExit()
+{
+  const u32 branch_address = js.compilerPC;
+  const auto targets_it = js.indirectBranchTargets.find(branch_address);
+  const size_t num_targets =
+      targets_it != js.indirectBranchTargets.end() ? targets_it->second.size() : 0;
+
+  MOV(32, PPCSTATE(pc), R(RSCRATCH));
+  bool disturbed = Cleanup();
+  if (disturbed && num_targets != 0)
+    MOV(32, R(RSCRATCH), PPCSTATE(pc));
+
+  // Inline cache: compare against the destinations this branch has taken before, each of which
+  // gets a regular linkable exit.
+  for (size_t i = 0; i < num_targets; i++)
+  {
+    const u32 target = targets_it->second[i];
+    CMP(32, R(RSCRATCH), Imm32(target));
+    FixupBranch miss = J_CC(CC_NE);
+    SUB(32, PPCSTATE(downcount), Imm32(js.downcountAmount));
+    JustWriteExit(target, false, 0);
+    SetJumpTarget(miss);
+  }
+
+  SUB(32, PPCSTATE(downcount), Imm32(js.downcountAmount));
+  if (num_targets < MAX_INDIRECT_BRANCH_TARGETS)
+  {
+    // Learn the new destination. This recompiles the block, so it only happens a few times.
+    ABI_PushRegistersAndAdjustStack({}, 0);
+    ABI_CallFunctionPC(JitInterface::RecordIndirectBranchTargetFromJIT,
+                       &m_system.GetJitInterface(), branch_address);
+    ABI_PopRegistersAndAdjustStack({}, 0);
+  }
+  JMP(asm_routines.dispatcher, Jump::Near);
 }
 
 void Jit64::WriteBLRExit()
 {
   if (!m_enable_blr_optimization)
   {
-    WriteExitDestInRSCRATCH();
+    if (UseReturnStack())
+      WriteReturnStackExit();
+    else
+      WriteExitDestInRSCRATCH();
     return;
   }
   MOV(32, PPCSTATE(pc), R(RSCRATCH));
@@ -633,6 +747,39 @@ void Jit64::WriteBLRExit()
   RET();
 }
 
+void Jit64::WriteReturnStackExit()
+{
+  MOV(32, PPCSTATE(pc), R(RSCRATCH));
+  bool disturbed = Cleanup();
+  if (disturbed)
+    MOV(32, R(RSCRATCH), PPCSTATE(pc));
+  if (m_ppc_state.feature_flags != 0)
+  {
+    MOV(32, R(RSCRATCH2), Imm32(m_ppc_state.feature_flags));
+    SHL(64, R(RSCRATCH2), Imm8(32));
+    OR(64, R(RSCRATCH), R(RSCRATCH2));
+  }
+
+  // Compare against the top of the return stack. On a match, pop it and jump straight to the
+  // continuation of the bl that pushed it, which finishes the downcount check and exits to the
+  // return address.
+  MOV(32, R(RSCRATCH2), PPCSTATE(return_stack_index));
+  SHL(32, R(RSCRATCH2), Imm8(4));
+  CMP(64, R(RSCRATCH), MComplex(RPPCSTATE, RSCRATCH2, SCALE_1, RETURN_STACK_GUEST_OFF));
+  FixupBranch mispredicted = J_CC(CC_NE);
+  MOV(64, R(RSCRATCH), MComplex(RPPCSTATE, RSCRATCH2, SCALE_1, RETURN_STACK_HOST_OFF));
+  SHR(32, R(RSCRATCH2), Imm8(4));
+  SUB(32, R(RSCRATCH2), Imm8(1));
+  AND(32, R(RSCRATCH2), Imm32(PowerPC::RETURN_STACK_SIZE - 1));
+  MOV(32, PPCSTATE(return_stack_index), R(RSCRATCH2));
+  SUB(32, PPCSTATE(downcount), Imm32(js.downcountAmount));
+  JMPptr(R(RSCRATCH));
+
+  SetJumpTarget(mispredicted);
+  SUB(32, PPCSTATE(downcount), Imm32(js.downcountAmount));
+  JMP(asm_routines.dispatcher, Jump::Near);
+}
+
 void Jit64::WriteRfiExitDestInRSCRATCH()
 {
   MOV(32, PPCSTATE(pc), R(RSCRATCH));
@@ -731,11 +878,16 @@ void Jit64::Trace()
 
 void Jit64::Jit(u32 em_address)
 {
+  const auto start = std::chrono::steady_clock::now();
+  PrecompilePersistentBlocks(em_address);
   Jit(em_address, true);
+  CountCompile(std::chrono::steady_clock::now() - start);
 }
 
 void Jit64::Jit(u32 em_address, bool clear_cache_and_retry_on_failure)
 {
+  TRACE_ZONE("Jit64::Jit");
+  const FrameTimeReport::CauseScope stutter_scope(StutterCause::JitCompile);
   CleanUpAfterStackFault();
 
   if (trampolines.IsAlmostFull() || SConfig::GetInstance().bJITNoBlockCache)
@@ -749,6 +901,9 @@ void Jit64::Jit(u32 em_address, bool clear_cache_and_retry_on_failure)
 
   // Check if any code blocks have been freed in the block cache and transfer this information to
   // the local rangesets to allow overwriting them with new code.
+  // Return stack entries may point into the freed code, so forget them before it gets reused.
+  if (!blocks.GetRangesToFreeNear().empty() || !blocks.GetRangesToFreeFar().empty())
+    m_ppc_state.ResetReturnStack();
   for (auto range : blocks.GetRangesToFreeNear())
     m_free_ranges_near.insert(range.first, range.second);
   for (auto range : blocks.GetRangesToFreeFar())
@@ -825,12 +980,22 @@ void Jit64::Jit(u32 em_address, bool clear_cache_and_retry_on_failure)
       blocks.FinalizeBlock(*b, jo.enableBlocklink, code_block.m_physical_addresses);
       return;
     }
+
+    blocks.DiscardBlock(*b);
   }
 
   if (clear_cache_and_retry_on_failure)
   {
     // Code generation failed due to not enough free space in either the near or far code regions.
-    // Clear the entire JIT cache and retry.
+    // Evict the oldest blocks and retry. Once there are too few blocks left for that to be worth
+    // it, clear the entire JIT cache and retry.
+    if (blocks.EvictOldestBlocks())
+    {
+      INFO_LOG_FMT(DYNA_REC, "evicted old blocks to make room in the code caches");
+      Jit(em_address, true);
+      return;
+    }
+
     WARN_LOG_FMT(DYNA_REC, "flushing code caches, please report if this happens a lot");
     ClearCache();
     Jit(em_address, false);
@@ -875,6 +1040,7 @@ bool Jit64::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
   js.curBlock = b;
   js.numLoadStoreInst = 0;
   js.numFloatingPointInst = 0;
+  js.coldBlock = ShouldCompileCold(em_address);
 
   // TODO: Test if this or AlignCode16 make a difference from GetCodePtr
   b->normalEntry = AlignCode4();
@@ -891,6 +1057,26 @@ bool Jit64::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
   if (IsProfilingEnabled())
     ABI_CallFunctionP(&JitBlock::ProfileData::BeginProfiling, b->profile_data.get());
 
+  // Cold blocks count their runs and ask to be recompiled with optimizations once they are hot.
+  if (js.coldBlock)
+  {
+    b->tier_up_countdown = TIER_UP_THRESHOLD;
+
+    SwitchToFarCode();
+    const u8* target = GetCodePtr();
+    MOV(32, PPCSTATE(pc), Imm32(js.blockStart));
+    ABI_PushRegistersAndAdjustStack({}, 0);
+    ABI_CallFunctionPC(JitInterface::CompileExceptionCheckFromJIT, &m_system.GetJitInterface(),
+                       static_cast<u32>(JitInterface::ExceptionType::TierUp));
+    ABI_PopRegistersAndAdjustStack({}, 0);
+    JMP(asm_routines.dispatcher_no_check, Jump::Near);
+    SwitchToNearCode();
+
+    MOV(64, R(RSCRATCH), ImmPtr(&b->tier_up_countdown));
+    SUB(32, MatR(RSCRATCH), Imm8(1));
+    J_CC(CC_Z, target);
+  }
+
 #if defined(_DEBUG) || defined(DEBUGFAST) || defined(NAN_CHECK)
   // should help logged stack-traces become more accurate
   MOV(32, PPCSTATE(pc), Imm32(js.blockStart));
@@ -912,7 +1098,7 @@ bool Jit64::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
   if (js.pairedQuantizeAddresses.find(js.blockStart) == js.pairedQuantizeAddresses.end())
   {
     // If there are GQRs used but not set, we'll treat those as constant and optimize them
-    BitSet8 gqr_static = ComputeStaticGQRs(code_block);
+    BitSet8 gqr_static = code_block.m_gqr_static;
     if (gqr_static)
     {
       SwitchToFarCode();
@@ -975,14 +1161,21 @@ bool Jit64::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
 
       // Gather pipe writes using an immediate address are explicitly tracked.
       if (jo.optimizeGatherPipe &&
-          (js.fifoBytesSinceCheck >= GPFifo::GATHER_PIPE_SIZE || js.mustCheckFifo))
+          (js.fifoBytesSinceCheck >= GPFifo::GATHER_PIPE_JIT_CHECK_SIZE || js.mustCheckFifo))
       {
         js.fifoBytesSinceCheck = 0;
         js.mustCheckFifo = false;
+
+        // Only call out when there's a whole burst to copy.
+        MOV(64, R(RSCRATCH), PPCSTATE(gather_pipe_ptr));
+        SUB(64, R(RSCRATCH), PPCSTATE(gather_pipe_base_ptr));
+        CMP(64, R(RSCRATCH), Imm32(GPFifo::GATHER_PIPE_SIZE));
+        FixupBranch no_burst = J_CC(CC_L);
         BitSet32 registersInUse = CallerSavedRegistersInUse();
         ABI_PushRegistersAndAdjustStack(registersInUse, 0);
-        ABI_CallFunctionP(GPFifo::FastCheckGatherPipe, &m_system.GetGPFifo());
+        ABI_CallFunctionP(GPFifo::UpdateGatherPipe, &m_system.GetGPFifo());
         ABI_PopRegistersAndAdjustStack(registersInUse, 0);
+        SetJumpTarget(no_burst);
         gatherPipeIntCheck = true;
       }
 
@@ -1038,7 +1231,7 @@ bool Jit64::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
     {
       auto& cpu = m_system.GetCPU();
       auto& power_pc = m_system.GetPowerPC();
-      if (m_enable_debugging && power_pc.GetBreakPoints().IsAddressBreakPoint(op.address) &&
+      if (m_enable_debugging && power_pc.GetBreakPoints().IsBreakPointEnable(op.address) &&
           !cpu.IsStepping())
       {
         gpr.Flush();
@@ -1178,8 +1371,7 @@ bool Jit64::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
 
   if (code_block.m_broken)
   {
-    gpr.Flush();
-    fpr.Flush();
+    FlushRegistersForExit(nextPC);
     WriteExit(nextPC);
   }
 
@@ -1203,11 +1395,6 @@ bool Jit64::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
   return true;
 }
 
-BitSet8 Jit64::ComputeStaticGQRs(const PPCAnalyst::CodeBlock& cb) const
-{
-  return cb.m_gqr_used & ~cb.m_gqr_modified;
-}
-
 BitSet32 Jit64::CallerSavedRegistersInUse() const
 {
   BitSet32 in_use = gpr.RegistersInUse() | (fpr.RegistersInUse() << 16);
@@ -54,7 +54,7 @@ public:
   void Shutdown() override;
 
   bool HandleFault(uintptr_t access_address, SContext* ctx) override;
-  bool BackPatch(SContext* ctx);
+  bool BackPatch(uintptr_t access_address, SContext* ctx);
 
   void EnableOptimization();
   void EnableBlockLink();
@@ -70,7 +70,6 @@ public:
   bool SetEmitterStateToFreeCodeRegion();
 
   BitSet32 CallerSavedRegistersInUse() const;
-  BitSet8 ComputeStaticGQRs(const PPCAnalyst::CodeBlock&) const;
 
   void IntializeSpeculativeConstants();
 
@@ -90,10 +89,14 @@ public:
   void EmitUpdateMembase();
   void MSRUpdated(const Gen::OpArg& msr, Gen::X64Reg scratch_reg);
   void FakeBLCall(u32 after);
+  void FlushRegistersForExit(u32 destination);
   void WriteExit(u32 destination, bool bl = false, u32 after = 0);
   void JustWriteExit(u32 destination, bool bl, u32 after);
   void WriteExitDestInRSCRATCH(bool bl = false, u32 after = 0);
+  void WriteIndirectBranchExit();
   void WriteBLRExit();
+  Gen::FixupBranch WriteReturnStackPush(u32 after);
+  void WriteReturnStackExit();
   void WriteExceptionExit();
   void WriteExternalExceptionExit();
   void WriteRfiExitDestInRSCRATCH();
@@ -71,6 +71,9 @@ template <bool condition>
 void Jit64::WriteBranchWatch(u32 origin, u32 destination, UGeckoInstruction inst, X64Reg reg_a,
                              X64Reg reg_b, BitSet32 caller_save)
 {
+  u64* const hit_counter =
+      m_branch_watch.GetHitCounter(origin, destination, inst, m_ppc_state.msr.IR, condition);
+
   MOV(64, R(reg_a), ImmPtr(&m_branch_watch));
   MOVZX(32, 8, reg_b, MDisp(reg_a, Core::BranchWatch::GetOffsetOfRecordingActive()));
   TEST(32, R(reg_b), R(reg_b));
@@ -79,17 +82,9 @@ void Jit64::WriteBranchWatch(u32 origin, u32 destination, UGeckoInstruction inst
   SwitchToFarCode();
   SetJumpTarget(branch_in);
 
-  ABI_PushRegistersAndAdjustStack(caller_save, 0);
-  // Some call sites have an optimization to use ABI_PARAM1 as a scratch register.
-  if (reg_a != ABI_PARAM1)
-    MOV(64, R(ABI_PARAM1), R(reg_a));
-  MOV(64, R(ABI_PARAM2), Imm64(Core::FakeBranchWatchCollectionKey{origin, destination}));
-  MOV(32, R(ABI_PARAM3), Imm32(inst.hex));
-  ABI_CallFunction(m_ppc_state.msr.IR ? (condition ? &Core::BranchWatch::HitVirtualTrue_fk :
-                                                     &Core::BranchWatch::HitVirtualFalse_fk) :
-                                        (condition ? &Core::BranchWatch::HitPhysicalTrue_fk :
-                                                     &Core::BranchWatch::HitPhysicalFalse_fk));
-  ABI_PopRegistersAndAdjustStack(caller_save, 0);
+  // Nothing is called, so caller_save doesn't need to be saved.
+  MOV(64, R(reg_a), ImmPtr(hit_counter));
+  ADD(64, MatR(reg_a), Imm8(1));
 
   FixupBranch branch_out = J(Jump::Near);
   SwitchToNearCode();
@@ -159,8 +154,7 @@ void Jit64::bx(UGeckoInstruction inst)
     return;
   }
 
-  gpr.Flush();
-  fpr.Flush();
+  FlushRegistersForExit(js.op->branchTo);
 
   if (IsDebuggingEnabled())
   {
@@ -303,7 +297,10 @@ void Jit64::bcctrx(UGeckoInstruction inst)
       WriteBranchWatchDestInRSCRATCH(js.compilerPC, inst, ABI_PARAM1, RSCRATCH2,
                                      BitSet32{RSCRATCH});
     }
-    WriteExitDestInRSCRATCH(inst.LK_3, js.compilerPC + 4);
+    if (!inst.LK_3 && jo.enableBlocklink)
+      WriteIndirectBranchExit();
+    else
+      WriteExitDestInRSCRATCH(inst.LK_3, js.compilerPC + 4);
   }
   else
   {
@@ -331,7 +328,10 @@ void Jit64::bcctrx(UGeckoInstruction inst)
         WriteBranchWatchDestInRSCRATCH(js.compilerPC, inst, ABI_PARAM1, RSCRATCH2,
                                        BitSet32{RSCRATCH});
       }
-      WriteExitDestInRSCRATCH(inst.LK_3, js.compilerPC + 4);
+      if (!inst.LK_3 && jo.enableBlocklink)
+        WriteIndirectBranchExit();
+      else
+        WriteExitDestInRSCRATCH(inst.LK_3, js.compilerPC + 4);
       // Would really like to continue the block here, but it ends. TODO.
     }
     SetJumpTarget(b);
@@ -3,6 +3,8 @@
 
 #include "Core/PowerPC/Jit64Common/EmuCodeBlock.h"
 
+#include <array>
+#include <cstddef>
 #include <functional>
 #include <limits>
 
@@ -131,6 +133,82 @@ FixupBranch EmuCodeBlock::CheckIfSafeAddress(const OpArg& reg_value, X64Reg reg_
   return J_CC(CC_Z, m_far_code.Enabled() ? Jump::Near : Jump::Short);
 }
 
+bool EmuCodeBlock::UseHostTLB(bool dr_set) const
+{
+  // Memchecks need every access to go through the MMU, and the host TLB bypasses the dcache.
+  return dr_set && !m_jit.jo.memcheck && !m_jit.m_ppc_state.m_enable_dcache;
+}
+
+bool EmuCodeBlock::HostTLBAccess(bool write, const OpArg& reg_value, X64Reg reg_addr,
+                                 int accessSize, bool signExtend, bool swap,
+                                 BitSet32 registers_in_use, FixupBranch* hit)
+{
+  // Everything the slow path's call doesn't preserve is ours to clobber, except the address and
+  // (for stores) the value. For loads, the destination can double as a temporary.
+  BitSet32 unavailable = registers_in_use;
+  unavailable[reg_addr] = true;
+  if (write && reg_value.IsSimpleReg())
+    unavailable[reg_value.GetSimpleReg()] = true;
+
+  std::array<X64Reg, 2> temps;
+  size_t num_temps = 0;
+  if (!write && !unavailable[reg_value.GetSimpleReg()])
+    temps[num_temps++] = reg_value.GetSimpleReg();
+  for (X64Reg reg : {RSCRATCH2, RSCRATCH, RSCRATCH_EXTRA})
+  {
+    if (num_temps < temps.size() && !unavailable[reg] && (num_temps == 0 || temps[0] != reg))
+      temps[num_temps++] = reg;
+  }
+  if (num_temps < temps.size())
+    return false;
+
+  const X64Reg index_reg = temps[0];
+  const X64Reg tag_reg = temps[1];
+  const size_t table = write ? PowerPC::HOST_TLB_WRITE_INDEX : PowerPC::HOST_TLB_READ_INDEX;
+  const int table_offset =
+      PPCSTATE_OFF(host_tlb) +
+      static_cast<int>(table * PowerPC::HOST_TLB_SIZE * sizeof(PowerPC::HostTLBEntry));
+
+  // index_reg = host TLB index * sizeof(HostTLBEntry). Misaligned accesses never match the tag, so
+  // a hit can't cross into the next page.
+  MOV(32, R(index_reg), R(reg_addr));
+  SHR(32, R(index_reg), Imm8(PowerPC::HW_PAGE_INDEX_SHIFT - 4));
+  AND(32, R(index_reg), Imm32((PowerPC::HOST_TLB_SIZE - 1) << 4));
+  MOV(32, R(tag_reg), R(reg_addr));
+  AND(32, R(tag_reg), Imm32(static_cast<u32>(~PowerPC::HW_PAGE_MASK) | ((accessSize >> 3) - 1)));
+  CMP(32, R(tag_reg),
+      MComplex(RPPCSTATE, index_reg, SCALE_1,
+               table_offset + static_cast<int>(offsetof(PowerPC::HostTLBEntry, tag))));
+  FixupBranch miss = J_CC(CC_NE);
+  MOV(64, R(index_reg),
+      MComplex(RPPCSTATE, index_reg, SCALE_1,
+               table_offset + static_cast<int>(offsetof(PowerPC::HostTLBEntry, host_offset))));
+
+  const OpArg host_address = MRegSum(index_reg, reg_addr);
+  if (!write)
+  {
+    LoadAndSwap(accessSize, reg_value.GetSimpleReg(), host_address, signExtend);
+  }
+  else if (reg_value.IsImm())
+  {
+    MOV(accessSize, host_address, swap ? SwapImmediate(accessSize, reg_value) : reg_value);
+  }
+  else if (swap && accessSize > 8)
+  {
+    // Swap a copy, as the caller may expect the value to survive the slow path.
+    MOV(accessSize, R(tag_reg), reg_value);
+    SwapAndStore(accessSize, host_address, tag_reg);
+  }
+  else
+  {
+    MOV(accessSize, host_address, reg_value);
+  }
+
+  *hit = J(Jump::Near);
+  SetJumpTarget(miss);
+  return true;
+}
+
 void EmuCodeBlock::UnsafeWriteRegToReg(OpArg reg_value, X64Reg reg_addr, int accessSize, s32 offset,
                                        bool swap, MovInfo* info)
 {
@@ -221,9 +299,9 @@ public:
   {
     LoadAddrMaskToReg(8 * sizeof(T), addr, mask);
   }
-  void VisitComplex(const std::function<T(Core::System&, u32)>* lambda) override
+  void VisitComplex(MMIO::ReadFunction<T> function, const void* context) override
   {
-    CallLambda(8 * sizeof(T), lambda);
+    CallFunction(8 * sizeof(T), function, context);
   }
 
 private:
@@ -270,10 +348,10 @@ private:
     }
   }
 
-  void CallLambda(int sbits, const std::function<T(Core::System&, u32)>* lambda)
+  void CallFunction(int sbits, MMIO::ReadFunction<T> function, const void* context)
   {
     m_code->ABI_PushRegistersAndAdjustStack(m_registers_in_use, 0);
-    m_code->ABI_CallLambdaPC(lambda, m_system, m_address);
+    m_code->ABI_CallFunctionPPC(function, context, m_system, m_address);
     m_code->ABI_PopRegistersAndAdjustStack(m_registers_in_use, 0);
     MoveOpArgToReg(sbits, R(ABI_RETURN));
   }
@@ -324,7 +402,7 @@ void EmuCodeBlock::SafeLoadToReg(X64Reg reg_value, const Gen::OpArg& opAddress,
   auto& js = m_jit.js;
   registersInUse[reg_value] = false;
   if (m_jit.jo.fastmem && !(flags & (SAFE_LOADSTORE_NO_FASTMEM | SAFE_LOADSTORE_NO_UPDATE_PC)) &&
-      !force_slow_access)
+      !force_slow_access && !m_jit.ShouldCompileSlowmem(js.compilerPC))
   {
     u8* backpatchStart = GetWritableCodePtr();
     MovInfo mov;
@@ -391,6 +469,11 @@ void EmuCodeBlock::SafeLoadToReg(X64Reg reg_value, const Gen::OpArg& opAddress,
   //
   // In the case of Jit64AsmCommon routines, we don't know the PC here,
   // so the caller has to store the PC themselves.
+  FixupBranch host_tlb_hit;
+  const bool host_tlb =
+      UseHostTLB(dr_set) && HostTLBAccess(false, R(reg_value), reg_addr, accessSize, signExtend,
+                                          true, registersInUse, &host_tlb_hit);
+
   if (!(flags & SAFE_LOADSTORE_NO_UPDATE_PC))
   {
     MOV(32, PPCSTATE(pc), Imm32(js.compilerPC));
@@ -426,6 +509,9 @@ void EmuCodeBlock::SafeLoadToReg(X64Reg reg_value, const Gen::OpArg& opAddress,
     MOVZX(64, accessSize, reg_value, R(ABI_RETURN));
   }
 
+  if (host_tlb)
+    SetJumpTarget(host_tlb_hit);
+
   if (fast_check_address)
   {
     if (m_far_code.Enabled())
@@ -502,7 +588,7 @@ void EmuCodeBlock::SafeWriteRegToReg(OpArg reg_value, X64Reg reg_addr, int acces
 
   auto& js = m_jit.js;
   if (m_jit.jo.fastmem && !(flags & (SAFE_LOADSTORE_NO_FASTMEM | SAFE_LOADSTORE_NO_UPDATE_PC)) &&
-      !force_slow_access)
+      !force_slow_access && !m_jit.ShouldCompileSlowmem(js.compilerPC))
   {
     u8* backpatchStart = GetWritableCodePtr();
     MovInfo mov;
@@ -565,6 +651,11 @@ void EmuCodeBlock::SafeWriteRegToReg(OpArg reg_value, X64Reg reg_addr, int acces
   //
   // In the case of Jit64AsmCommon routines, we don't know the PC here,
   // so the caller has to store the PC themselves.
+  FixupBranch host_tlb_hit;
+  const bool host_tlb = UseHostTLB(dr_set) && HostTLBAccess(true, reg_value, reg_addr, accessSize,
+                                                            false, swap, registersInUse,
+                                                            &host_tlb_hit);
+
   if (!(flags & SAFE_LOADSTORE_NO_UPDATE_PC))
   {
     MOV(32, PPCSTATE(pc), Imm32(js.compilerPC));
@@ -607,6 +698,9 @@ void EmuCodeBlock::SafeWriteRegToReg(OpArg reg_value, X64Reg reg_addr, int acces
 
   MemoryExceptionCheck();
 
+  if (host_tlb)
+    SetJumpTarget(host_tlb_hit);
+
   if (fast_check_address)
   {
     if (m_far_code.Enabled())
@@ -55,6 +55,11 @@ public:
 
   Gen::FixupBranch CheckIfSafeAddress(const Gen::OpArg& reg_value, Gen::X64Reg reg_addr,
                                       BitSet32 registers_in_use);
+  bool UseHostTLB(bool dr_set) const;
+  // Probes the host TLB and performs the access on a hit, then jumps to *hit. Returns false without
+  // emitting anything if there are not enough free registers for the probe.
+  bool HostTLBAccess(bool write, const Gen::OpArg& reg_value, Gen::X64Reg reg_addr, int accessSize,
+                     bool signExtend, bool swap, BitSet32 registers_in_use, Gen::FixupBranch* hit);
   // these return the address of the MOV, for backpatching
   void UnsafeWriteRegToReg(Gen::OpArg reg_value, Gen::X64Reg reg_addr, int accessSize,
                            s32 offset = 0, bool swap = true, Gen::MovInfo* info = nullptr);
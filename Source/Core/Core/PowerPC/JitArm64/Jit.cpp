@@ -3,6 +3,7 @@
 
 #include "Core/PowerPC/JitArm64/Jit.h"
 
+#include <chrono>
 #include <cstdio>
 #include <optional>
 
@@ -13,6 +14,7 @@
 #include "Common/MathUtil.h"
 #include "Common/MsgHandler.h"
 #include "Common/StringUtil.h"
+#include "Common/TraceZone.h"
 
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
@@ -28,6 +30,7 @@
 #include "Core/PowerPC/JitInterface.h"
 #include "Core/PowerPC/PowerPC.h"
 #include "Core/System.h"
+#include "VideoCommon/FrameTimeReport.h"
 
 using namespace Arm64Gen;
 
@@ -142,7 +145,8 @@ bool JitArm64::HandleFault(uintptr_t access_address, SContext* ctx)
       }
       else
       {
-        success = HandleFastmemFault(ctx);
+        ++m_statistics.fastmem_faults;
+        success = HandleFastmemFault(access_address, ctx);
       }
     }
   }
@@ -157,10 +161,12 @@ bool JitArm64::HandleFault(uintptr_t access_address, SContext* ctx)
 
 void JitArm64::ClearCache()
 {
+  ++m_statistics.cache_clears;
   m_fault_to_handler.clear();
 
   blocks.Clear();
   blocks.ClearRangesToFree();
+  m_ppc_state.ResetReturnStack();
   const Common::ScopedJITPageWriteAndNoExecute enable_jit_page_writes;
   m_far_code_0.ClearCodeSpace();
   m_near_code_0.ClearCodeSpace();
@@ -280,7 +286,7 @@ void JitArm64::HLEFunction(u32 hook_index)
   gpr.Flush(FlushMode::All, ARM64Reg::INVALID_REG);
   fpr.Flush(FlushMode::All, ARM64Reg::INVALID_REG);
 
-  ABI_CallFunction(&HLE::ExecuteFromJIT, js.compilerPC, hook_index, &m_system);
+  ABI_CallFunction(HLE::GetJITHookFunction(hook_index), &m_system);
 }
 
 void JitArm64::DoNothing(UGeckoInstruction inst)
@@ -436,6 +442,24 @@ void JitArm64::MSRUpdated(ARM64Reg msr)
   gpr.Unlock(WA);
 }
 
+void JitArm64::FlushRegistersForExit(u32 destination)
+{
+  // Registers that the destination overwrites before reading don't need to be written back.
+  if (destination == code_block.m_dead_on_exit_address)
+  {
+    gpr.DiscardRegisters(code_block.m_gpr_dead_on_exit);
+    gpr.DiscardCRRegisters(code_block.m_cr_dead_on_exit);
+    fpr.DiscardRegisters(code_block.m_fpr_dead_on_exit);
+    gpr.StoreRegisters(~code_block.m_gpr_dead_on_exit);
+    gpr.StoreCRRegisters(~code_block.m_cr_dead_on_exit);
+  }
+  else
+  {
+    gpr.Flush(FlushMode::All, ARM64Reg::INVALID_REG);
+  }
+  fpr.Flush(FlushMode::All, ARM64Reg::INVALID_REG);
+}
+
 void JitArm64::WriteExit(u32 destination, bool LK, u32 exit_address_after_return,
                          ARM64Reg exit_address_after_return_reg)
 {
@@ -447,10 +471,17 @@ void JitArm64::WriteExit(u32 destination, bool LK, u32 exit_address_after_return
   }
   DoDownCount();
 
+  const bool push_return_stack = LK && UseReturnStack();
   LK &= m_enable_blr_optimization;
+  const bool write_return_exit = LK || push_return_stack;
 
   const u8* host_address_after_return = nullptr;
-  if (LK)
+  if (push_return_stack)
+  {
+    constexpr s32 adr_offset = JitArm64BlockCache::BLOCK_LINK_SIZE + sizeof(u32) * 2;
+    host_address_after_return = WriteReturnStackPush(exit_address_after_return, adr_offset);
+  }
+  else if (LK)
   {
     // Push {ARM_PC (64-bit); PPC_PC (32-bit); feature_flags (32-bit)} on the stack
     ARM64Reg reg_to_push = ARM64Reg::X1;
@@ -486,7 +517,7 @@ void JitArm64::WriteExit(u32 destination, bool LK, u32 exit_address_after_return
   else
   {
     primary_farcode_addr = GetCodePtr() + JitArm64BlockCache::BLOCK_LINK_SIZE +
-                           (LK ? JitArm64BlockCache::BLOCK_LINK_SIZE : 0);
+                           (write_return_exit ? JitArm64BlockCache::BLOCK_LINK_SIZE : 0);
   }
   const u8* return_farcode_addr = primary_farcode_addr + primary_farcode_size;
 
@@ -501,7 +532,7 @@ void JitArm64::WriteExit(u32 destination, bool LK, u32 exit_address_after_return
 
   blocks.WriteLinkBlock(*this, linkData);
 
-  if (LK)
+  if (write_return_exit)
   {
     DEBUG_ASSERT(GetCodePtr() == host_address_after_return || HasWriteFailed());
 
@@ -525,7 +556,7 @@ void JitArm64::WriteExit(u32 destination, bool LK, u32 exit_address_after_return
   else
     B(GetAsmRoutines()->do_timing);
 
-  if (LK)
+  if (write_return_exit)
   {
     if (GetCodePtr() == return_farcode_addr - sizeof(u32))
       BRK(101);
@@ -552,36 +583,46 @@ void JitArm64::WriteExit(Arm64Gen::ARM64Reg dest, bool LK, u32 exit_address_afte
   }
   DoDownCount();
 
+  const bool push_return_stack = LK && UseReturnStack();
   LK &= m_enable_blr_optimization;
 
-  if (!LK)
+  if (!LK && !push_return_stack)
   {
     B(dispatcher);
   }
   else
   {
-    // Push {ARM_PC (64-bit); PPC_PC (32-bit); feature_flags (32-bit)} on the stack
-    ARM64Reg reg_to_push = ARM64Reg::X1;
-    const u64 feature_flags = m_ppc_state.feature_flags;
-    if (exit_address_after_return_reg == ARM64Reg::INVALID_REG)
-    {
-      MOVI2R(ARM64Reg::X1, feature_flags << 32 | exit_address_after_return);
-    }
-    else if (feature_flags == 0)
+    constexpr s32 adr_offset = sizeof(u32) * 3;
+    const u8* host_address_after_return;
+    if (push_return_stack)
     {
-      reg_to_push = EncodeRegTo64(exit_address_after_return_reg);
+      host_address_after_return = WriteReturnStackPush(exit_address_after_return, adr_offset);
+      B(dispatcher);
     }
     else
     {
-      ORRI2R(ARM64Reg::X1, EncodeRegTo64(exit_address_after_return_reg), feature_flags << 32,
-             ARM64Reg::X1);
-    }
-    constexpr s32 adr_offset = sizeof(u32) * 3;
-    const u8* host_address_after_return = GetCodePtr() + adr_offset;
-    ADR(ARM64Reg::X0, adr_offset);
-    STP(IndexType::Pre, ARM64Reg::X0, reg_to_push, ARM64Reg::SP, -16);
+      // Push {ARM_PC (64-bit); PPC_PC (32-bit); feature_flags (32-bit)} on the stack
+      ARM64Reg reg_to_push = ARM64Reg::X1;
+      const u64 feature_flags = m_ppc_state.feature_flags;
+      if (exit_address_after_return_reg == ARM64Reg::INVALID_REG)
+      {
+        MOVI2R(ARM64Reg::X1, feature_flags << 32 | exit_address_after_return);
+      }
+      else if (feature_flags == 0)
+      {
+        reg_to_push = EncodeRegTo64(exit_address_after_return_reg);
+      }
+      else
+      {
+        ORRI2R(ARM64Reg::X1, EncodeRegTo64(exit_address_after_return_reg), feature_flags << 32,
+               ARM64Reg::X1);
+      }
+      host_address_after_return = GetCodePtr() + adr_offset;
+      ADR(ARM64Reg::X0, adr_offset);
+      STP(IndexType::Pre, ARM64Reg::X0, reg_to_push, ARM64Reg::SP, -16);
 
-    BL(dispatcher);
+      BL(dispatcher);
+    }
     DEBUG_ASSERT(GetCodePtr() == host_address_after_return || HasWriteFailed());
 
     // Write the regular exit node after the return.
@@ -615,6 +656,37 @@ void JitArm64::WriteExit(Arm64Gen::ARM64Reg dest, bool LK, u32 exit_address_afte
   }
 }
 
+void JitArm64::WriteIndirectBranchExit(ARM64Reg dest)
+{
+  if (dest != DISPATCHER_PC)
+    MOV(DISPATCHER_PC, dest);
+
+  const u32 branch_address = js.compilerPC;
+  const auto targets_it = js.indirectBranchTargets.find(branch_address);
+  const size_t num_targets =
+      targets_it != js.indirectBranchTargets.end() ? targets_it->second.size() : 0;
+
+  // Inline cache: compare against the destinations this branch has taken before, each of which
+  // gets a regular linkable exit.
+  for (size_t i = 0; i < num_targets; i++)
+  {
+    const u32 target = targets_it->second[i];
+    CMPI2R(DISPATCHER_PC, target, ARM64Reg::W0);
+    FixupBranch miss = B(CC_NEQ);
+    WriteExit(target);
+    SetJumpTarget(miss);
+  }
+
+  if (num_targets < MAX_INDIRECT_BRANCH_TARGETS)
+  {
+    // Learn the new destination. This recompiles the block, so it only happens a few times.
+    STR(IndexType::Unsigned, DISPATCHER_PC, PPC_REG, PPCSTATE_OFF(pc));
+    ABI_CallFunction(&JitInterface::RecordIndirectBranchTargetFromJIT, &m_system.GetJitInterface(),
+                     branch_address);
+  }
+  WriteExit(DISPATCHER_PC);
+}
+
 void JitArm64::FakeLKExit(u32 exit_address_after_return, ARM64Reg exit_address_after_return_reg)
 {
   if (!m_enable_blr_optimization)
@@ -700,11 +772,77 @@ void JitArm64::FakeLKExit(u32 exit_address_after_return, ARM64Reg exit_address_a
   SetJumpTarget(skip_exit);
 }
 
+const u8* JitArm64::WriteReturnStackPush(u32 exit_address_after_return, s32 adr_offset)
+{
+  // Must not touch the flags, since they still hold the result of DoDownCount. The ADR must be
+  // the second to last instruction, adr_offset bytes before the continuation.
+  LDR(IndexType::Unsigned, ARM64Reg::W0, PPC_REG, PPCSTATE_OFF(return_stack_index));
+  ADD(ARM64Reg::W0, ARM64Reg::W0, 1);
+  ANDI2R(ARM64Reg::W0, ARM64Reg::W0, PowerPC::RETURN_STACK_SIZE - 1, ARM64Reg::W1);
+  STR(IndexType::Unsigned, ARM64Reg::W0, PPC_REG, PPCSTATE_OFF(return_stack_index));
+  ADD(ARM64Reg::X0, PPC_REG, ARM64Reg::X0, ArithOption(ARM64Reg::X0, ShiftType::LSL, 4));
+  ADDI2R(ARM64Reg::X0, ARM64Reg::X0, PPCSTATE_OFF(return_stack), ARM64Reg::X1);
+  MOVI2R(ARM64Reg::X1, u64(m_ppc_state.feature_flags) << 32 | exit_address_after_return);
+
+  const u8* host_address_after_return = GetCodePtr() + adr_offset;
+  ADR(ARM64Reg::X2, adr_offset);
+  STP(IndexType::Signed, ARM64Reg::X1, ARM64Reg::X2, ARM64Reg::X0, 0);
+  return host_address_after_return;
+}
+
+void JitArm64::WriteReturnStackExit(Arm64Gen::ARM64Reg dest)
+{
+  if (dest != DISPATCHER_PC)
+    MOV(DISPATCHER_PC, dest);
+
+  Cleanup();
+  if (IsProfilingEnabled())
+  {
+    ABI_CallFunction(&JitBlock::ProfileData::EndProfiling, js.curBlock->profile_data.get(),
+                     js.downcountAmount);
+  }
+
+  ARM64Reg key = EncodeRegTo64(DISPATCHER_PC);
+  const u64 feature_flags = m_ppc_state.feature_flags;
+  if (feature_flags != 0)
+  {
+    ORRI2R(ARM64Reg::X0, EncodeRegTo64(DISPATCHER_PC), feature_flags << 32, ARM64Reg::X0);
+    key = ARM64Reg::X0;
+  }
+
+  // Check if the top of the return stack matches {PPC_PC, feature_flags}, then pop it and branch to
+  // the continuation of the bl that pushed it.
+  LDR(IndexType::Unsigned, ARM64Reg::W2, PPC_REG, PPCSTATE_OFF(return_stack_index));
+  ADDI2R(ARM64Reg::X1, PPC_REG, PPCSTATE_OFF(return_stack), ARM64Reg::X1);
+  ADD(ARM64Reg::X1, ARM64Reg::X1, ARM64Reg::X2, ArithOption(ARM64Reg::X2, ShiftType::LSL, 4));
+  LDP(IndexType::Signed, ARM64Reg::X1, ARM64Reg::X2, ARM64Reg::X1, 0);
+  CMP(ARM64Reg::X1, key);
+  FixupBranch no_match = B(CC_NEQ);
+
+  LDR(IndexType::Unsigned, ARM64Reg::W1, PPC_REG, PPCSTATE_OFF(return_stack_index));
+  SUB(ARM64Reg::W1, ARM64Reg::W1, 1);
+  ANDI2R(ARM64Reg::W1, ARM64Reg::W1, PowerPC::RETURN_STACK_SIZE - 1, ARM64Reg::W0);
+  STR(IndexType::Unsigned, ARM64Reg::W1, PPC_REG, PPCSTATE_OFF(return_stack_index));
+
+  DoDownCount();  // overwrites X0 + X1
+
+  BR(ARM64Reg::X2);
+
+  SetJumpTarget(no_match);
+
+  DoDownCount();
+
+  B(dispatcher);
+}
+
 void JitArm64::WriteBLRExit(Arm64Gen::ARM64Reg dest)
 {
   if (!m_enable_blr_optimization)
   {
-    WriteExit(dest);
+    if (UseReturnStack())
+      WriteReturnStackExit(dest);
+    else
+      WriteExit(dest);
     return;
   }
 
@@ -902,11 +1040,16 @@ void JitArm64::Trace()
 
 void JitArm64::Jit(u32 em_address)
 {
+  const auto start = std::chrono::steady_clock::now();
+  PrecompilePersistentBlocks(em_address);
   Jit(em_address, true);
+  CountCompile(std::chrono::steady_clock::now() - start);
 }
 
 void JitArm64::Jit(u32 em_address, bool clear_cache_and_retry_on_failure)
 {
+  TRACE_ZONE("JitArm64::Jit");
+  const FrameTimeReport::CauseScope stutter_scope(StutterCause::JitCompile);
   CleanUpAfterStackFault();
 
   if (SConfig::GetInstance().bJITNoBlockCache)
@@ -914,14 +1057,12 @@ void JitArm64::Jit(u32 em_address, bool clear_cache_and_retry_on_failure)
 
   // Check if any code blocks have been freed in the block cache and transfer this information to
   // the local rangesets to allow overwriting them with new code.
+  // Return stack entries may point into the freed code, so forget them before it gets reused.
+  if (!blocks.GetRangesToFreeNear().empty() || !blocks.GetRangesToFreeFar().empty())
+    m_ppc_state.ResetReturnStack();
   for (auto range : blocks.GetRangesToFreeNear())
   {
-    auto first_fastmem_area = m_fault_to_handler.upper_bound(range.first);
-    auto last_fastmem_area = first_fastmem_area;
-    auto end = m_fault_to_handler.end();
-    while (last_fastmem_area != end && last_fastmem_area->first <= range.second)
-      ++last_fastmem_area;
-    m_fault_to_handler.erase(first_fastmem_area, last_fastmem_area);
+    EraseFastmemAreas(range.first, range.second);
 
     if (range.first < m_near_code_0.GetCodeEnd())
       m_free_ranges_near_0.insert(range.first, range.second);
@@ -1013,12 +1154,24 @@ void JitArm64::Jit(u32 em_address, bool clear_cache_and_retry_on_failure)
       blocks.FinalizeBlock(*b, jo.enableBlocklink, code_block.m_physical_addresses);
       return;
     }
+
+    // The partially emitted code stays in the free range, so forget about its fastmem areas.
+    EraseFastmemAreas(near_start, GetWritableCodePtr());
+    blocks.DiscardBlock(*b);
   }
 
   if (clear_cache_and_retry_on_failure)
   {
     // Code generation failed due to not enough free space in either the near or far code regions.
-    // Clear the entire JIT cache and retry.
+    // Evict the oldest blocks and retry. Once there are too few blocks left for that to be worth
+    // it, clear the entire JIT cache and retry.
+    if (blocks.EvictOldestBlocks())
+    {
+      INFO_LOG_FMT(DYNA_REC, "evicted old blocks to make room in the code caches");
+      Jit(em_address, true);
+      return;
+    }
+
     WARN_LOG_FMT(DYNA_REC, "flushing code caches, please report if this happens a lot");
     ClearCache();
     Jit(em_address, false);
@@ -1030,6 +1183,16 @@ void JitArm64::Jit(u32 em_address, bool clear_cache_and_retry_on_failure)
   exit(-1);
 }
 
+void JitArm64::EraseFastmemAreas(const u8* begin, const u8* end)
+{
+  auto first_fastmem_area = m_fault_to_handler.upper_bound(begin);
+  auto last_fastmem_area = first_fastmem_area;
+  const auto map_end = m_fault_to_handler.end();
+  while (last_fastmem_area != map_end && last_fastmem_area->first <= end)
+    ++last_fastmem_area;
+  m_fault_to_handler.erase(first_fastmem_area, last_fastmem_area);
+}
+
 std::optional<size_t> JitArm64::SetEmitterStateToFreeCodeRegion()
 {
   // Find some large free memory blocks and set code emitters to point at them. If we can't find
@@ -1084,7 +1247,7 @@ bool JitArm64::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
 
   js.isLastInstruction = false;
   js.firstFPInstructionFound = false;
-  js.assumeNoPairedQuantize = false;
+  js.constantGqrValid = BitSet8();
   js.blockStart = em_address;
   js.fifoBytesSinceCheck = 0;
   js.mustCheckFifo = false;
@@ -1094,6 +1257,7 @@ bool JitArm64::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
   js.carryFlag = CarryFlag::InPPCState;
   js.numLoadStoreInst = 0;
   js.numFloatingPointInst = 0;
+  js.coldBlock = ShouldCompileCold(em_address);
 
   b->normalEntry = GetWritableCodePtr();
 
@@ -1101,26 +1265,65 @@ bool JitArm64::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
   if (IsProfilingEnabled())
     ABI_CallFunction(&JitBlock::ProfileData::BeginProfiling, b->profile_data.get());
 
-  if (code_block.m_gqr_used.Count() == 1 &&
+  // Cold blocks count their runs and ask to be recompiled with optimizations once they are hot.
+  if (js.coldBlock)
+  {
+    b->tier_up_countdown = TIER_UP_THRESHOLD;
+
+    MOVP2R(ARM64Reg::X1, &b->tier_up_countdown);
+    LDR(IndexType::Unsigned, ARM64Reg::W0, ARM64Reg::X1, 0);
+    SUBS(ARM64Reg::W0, ARM64Reg::W0, 1);
+    STR(IndexType::Unsigned, ARM64Reg::W0, ARM64Reg::X1, 0);
+    FixupBranch not_hot = B(CC_NEQ);
+    FixupBranch hot = B();
+    SwitchToFarCode();
+    SetJumpTarget(hot);
+    MOVI2R(DISPATCHER_PC, js.blockStart);
+    STR(IndexType::Unsigned, DISPATCHER_PC, PPC_REG, PPCSTATE_OFF(pc));
+    ABI_CallFunction(&JitInterface::CompileExceptionCheckFromJIT, &m_system.GetJitInterface(),
+                     static_cast<u32>(JitInterface::ExceptionType::TierUp));
+    B(dispatcher_no_check);
+    SwitchToNearCode();
+    SetJumpTarget(not_hot);
+  }
+
+  // Assume that GQR values don't change often at runtime, and specialize the paired loads and
+  // stores on the values of the GQRs that the block reads but doesn't write.
+  if (code_block.m_gqr_static &&
       js.pairedQuantizeAddresses.find(js.blockStart) == js.pairedQuantizeAddresses.end())
   {
-    int gqr = *code_block.m_gqr_used.begin();
-    if (!code_block.m_gqr_modified[gqr] && !GQR(m_ppc_state, gqr))
+    // Accumulate the difference from the expected values so that a single branch covers all GQRs.
+    constexpr ARM64Reg mismatch = ARM64Reg::W2;
+    bool first = true;
+    for (int gqr : code_block.m_gqr_static)
     {
-      LDR(IndexType::Unsigned, ARM64Reg::W0, PPC_REG, PPCSTATE_OFF_SPR(SPR_GQR0 + gqr));
-      FixupBranch no_fail = CBZ(ARM64Reg::W0);
-      FixupBranch fail = B();
-      SwitchToFarCode();
-      SetJumpTarget(fail);
-      MOVI2R(DISPATCHER_PC, js.blockStart);
-      STR(IndexType::Unsigned, DISPATCHER_PC, PPC_REG, PPCSTATE_OFF(pc));
-      ABI_CallFunction(&JitInterface::CompileExceptionCheckFromJIT, &m_system.GetJitInterface(),
-                       static_cast<u32>(JitInterface::ExceptionType::PairedQuantize));
-      B(dispatcher_no_check);
-      SwitchToNearCode();
-      SetJumpTarget(no_fail);
-      js.assumeNoPairedQuantize = true;
+      const u32 value = GQR(m_ppc_state, gqr);
+      js.constantGqr[gqr] = value;
+
+      const ARM64Reg reg = first ? mismatch : ARM64Reg::W0;
+      LDR(IndexType::Unsigned, reg, PPC_REG, PPCSTATE_OFF_SPR(SPR_GQR0 + gqr));
+      if (value != 0)
+      {
+        MOVI2R(ARM64Reg::W1, value);
+        EOR(reg, reg, ARM64Reg::W1);
+      }
+      if (!first)
+        ORR(mismatch, mismatch, reg);
+      first = false;
     }
+
+    FixupBranch no_fail = CBZ(mismatch);
+    FixupBranch fail = B();
+    SwitchToFarCode();
+    SetJumpTarget(fail);
+    MOVI2R(DISPATCHER_PC, js.blockStart);
+    STR(IndexType::Unsigned, DISPATCHER_PC, PPC_REG, PPCSTATE_OFF(pc));
+    ABI_CallFunction(&JitInterface::CompileExceptionCheckFromJIT, &m_system.GetJitInterface(),
+                     static_cast<u32>(JitInterface::ExceptionType::PairedQuantize));
+    B(dispatcher_no_check);
+    SwitchToNearCode();
+    SetJumpTarget(no_fail);
+    js.constantGqrValid = code_block.m_gqr_static;
   }
 
   gpr.Start(js.gpa);
@@ -1165,11 +1368,23 @@ bool JitArm64::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
           js.fifoWriteAddresses.find(prev_address) != js.fifoWriteAddresses.end();
 
       if (jo.optimizeGatherPipe &&
-          (js.fifoBytesSinceCheck >= GPFifo::GATHER_PIPE_SIZE || js.mustCheckFifo))
+          (js.fifoBytesSinceCheck >= GPFifo::GATHER_PIPE_JIT_CHECK_SIZE || js.mustCheckFifo))
       {
         js.fifoBytesSinceCheck = 0;
         js.mustCheckFifo = false;
 
+        // Only call out when there's a whole burst to copy.
+        {
+          ARM64Reg WA = gpr.GetReg();
+          ARM64Reg WB = gpr.GetReg();
+          LDP(IndexType::Signed, EncodeRegTo64(WA), EncodeRegTo64(WB), PPC_REG,
+              PPCSTATE_OFF(gather_pipe_ptr));
+          SUB(EncodeRegTo64(WA), EncodeRegTo64(WA), EncodeRegTo64(WB));
+          CMP(EncodeRegTo64(WA), GPFifo::GATHER_PIPE_SIZE);
+          gpr.Unlock(WA, WB);
+        }
+        FixupBranch no_burst = B(CC_LT);
+
         gpr.Lock(ARM64Reg::W30);
         BitSet32 regs_in_use = gpr.GetCallerSavedUsed();
         BitSet32 fprs_in_use = fpr.GetCallerSavedUsed();
@@ -1177,11 +1392,12 @@ bool JitArm64::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
 
         ABI_PushRegisters(regs_in_use);
         m_float_emit.ABI_PushRegisters(fprs_in_use, ARM64Reg::X30);
-        ABI_CallFunction(&GPFifo::FastCheckGatherPipe, &m_system.GetGPFifo());
+        ABI_CallFunction(&GPFifo::UpdateGatherPipe, &m_system.GetGPFifo());
         m_float_emit.ABI_PopRegisters(fprs_in_use, ARM64Reg::X30);
         ABI_PopRegisters(regs_in_use);
 
         gpr.Unlock(ARM64Reg::W30);
+        SetJumpTarget(no_burst);
         gatherPipeIntCheck = true;
       }
       // Gather pipe writes can generate an exception; add an exception check.
@@ -1241,7 +1457,7 @@ bool JitArm64::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
     else
     {
       if (m_enable_debugging && !cpu.IsStepping() &&
-          m_system.GetPowerPC().GetBreakPoints().IsAddressBreakPoint(op.address))
+          m_system.GetPowerPC().GetBreakPoints().IsBreakPointEnable(op.address))
       {
         FlushCarry();
         gpr.Flush(FlushMode::All, ARM64Reg::INVALID_REG);
@@ -1338,8 +1554,7 @@ bool JitArm64::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
 
   if (code_block.m_broken)
   {
-    gpr.Flush(FlushMode::All, ARM64Reg::INVALID_REG);
-    fpr.Flush(FlushMode::All, ARM64Reg::INVALID_REG);
+    FlushRegistersForExit(nextPC);
     WriteExit(nextPC);
   }
 
@@ -37,7 +37,7 @@ public:
   bool IsInCodeSpace(const u8* ptr) const { return IsInSpace(ptr); }
   bool HandleFault(uintptr_t access_address, SContext* ctx) override;
   void DoBacktrace(uintptr_t access_address, SContext* ctx);
-  bool HandleFastmemFault(SContext* ctx);
+  bool HandleFastmemFault(uintptr_t access_address, SContext* ctx);
 
   void ClearCache() override;
 
@@ -190,6 +190,7 @@ protected:
   {
     const u8* fast_access_code;
     const u8* slow_access_code;
+    u32 pc;
   };
 
   void SetBlockLinkingEnabled(bool enabled);
@@ -290,6 +291,9 @@ protected:
   // If either near code or far code is full, returns std::nullopt.
   std::optional<size_t> SetEmitterStateToFreeCodeRegion();
 
+  // Forgets the slowmem handlers of all fastmem accesses within the given range of near code.
+  void EraseFastmemAreas(const u8* begin, const u8* end);
+
   void DoDownCount();
   void Cleanup();
   void ResetStack();
@@ -331,6 +335,7 @@ protected:
   void
   WriteExit(Arm64Gen::ARM64Reg dest, bool LK = false, u32 exit_address_after_return = 0,
             Arm64Gen::ARM64Reg exit_address_after_return_reg = Arm64Gen::ARM64Reg::INVALID_REG);
+  void WriteIndirectBranchExit(Arm64Gen::ARM64Reg dest);
   void WriteExceptionExit(u32 destination, bool only_external = false,
                           bool always_exception = false);
   void WriteExceptionExit(Arm64Gen::ARM64Reg dest, bool only_external = false,
@@ -343,6 +348,9 @@ protected:
   FakeLKExit(u32 exit_address_after_return,
              Arm64Gen::ARM64Reg exit_address_after_return_reg = Arm64Gen::ARM64Reg::INVALID_REG);
   void WriteBLRExit(Arm64Gen::ARM64Reg dest);
+  void FlushRegistersForExit(u32 destination);
+  const u8* WriteReturnStackPush(u32 exit_address_after_return, s32 adr_offset);
+  void WriteReturnStackExit(Arm64Gen::ARM64Reg dest);
 
   Arm64Gen::FixupBranch JumpIfCRFieldBit(int field, int bit, bool jump_if_set);
   void FixGTBeforeSettingCRFieldBit(Arm64Gen::ARM64Reg reg);
@@ -3,6 +3,7 @@
 
 #include "Core/PowerPC/JitArm64/Jit.h"
 
+#include <array>
 #include <cstddef>
 #include <optional>
 #include <string>
@@ -62,6 +63,13 @@ void JitArm64::EmitBackpatchRoutine(u32 flags, MemAccessMode mode, ARM64Reg RS,
   if (m_accurate_cpu_cache_enabled)
     mode = MemAccessMode::AlwaysSlowAccess;
 
+  // With MSR.DR set, the slow access code checks the host TLB inline before calling the MMU.
+  if (mode == MemAccessMode::Auto && jo.fastmem && !emitting_routine &&
+      ShouldCompileSlowmem(js.compilerPC))
+  {
+    mode = MemAccessMode::AlwaysSlowAccess;
+  }
+
   const bool emit_fast_access = mode != MemAccessMode::AlwaysSlowAccess;
   const bool emit_slow_access = mode != MemAccessMode::AlwaysFastAccess;
 
@@ -163,6 +171,7 @@ void JitArm64::EmitBackpatchRoutine(u32 flags, MemAccessMode mode, ARM64Reg RS,
         FastmemArea* fastmem_area = &m_fault_to_handler[fast_access_end];
         fastmem_area->fast_access_code = fast_access_start;
         fastmem_area->slow_access_code = GetCodePtr();
+        fastmem_area->pc = js.compilerPC;
       }
     }
 
@@ -200,6 +209,99 @@ void JitArm64::EmitBackpatchRoutine(u32 flags, MemAccessMode mode, ARM64Reg RS,
       STR(IndexType::Unsigned, ARM64Reg::W30, PPC_REG, PPCSTATE_OFF(pc));
     }
 
+    // JitAsm routines can't know whether MSR.DR is set, and the host TLB is only valid if it is.
+    const bool use_host_tlb = !emitting_routine && !jo.memcheck &&
+                              !m_ppc_state.m_enable_dcache &&
+                              (m_ppc_state.feature_flags & FEATURE_FLAG_MSR_DR) &&
+                              !(flags & BackPatchInfo::FLAG_ZERO_256);
+    std::optional<FixupBranch> host_tlb_hit;
+
+    // Performs the access the MMU call below would on a host TLB hit, leaving any loaded value in
+    // X0 like the call does. The call clobbers every caller-saved register that hasn't been pushed,
+    // so apart from the address and the value, those are free to use here.
+    const auto emit_host_tlb_access = [&](ARM64Reg value) {
+      std::array<ARM64Reg, 3> temps;
+      size_t num_temps = 0;
+      for (int i : {0, 3, 4, 5, 6})
+      {
+        if (num_temps < temps.size() && i != DecodeReg(addr) &&
+            (value == ARM64Reg::INVALID_REG || i != DecodeReg(value)))
+        {
+          temps[num_temps++] = static_cast<ARM64Reg>(i);
+        }
+      }
+      const ARM64Reg XE = EncodeRegTo64(temps[0]);
+      const ARM64Reg WA = temps[1];
+      const ARM64Reg WB = temps[2];
+      const ARM64Reg addr_w = EncodeRegTo32(addr);
+      const size_t table = (flags & BackPatchInfo::FLAG_STORE) ? PowerPC::HOST_TLB_WRITE_INDEX :
+                                                                 PowerPC::HOST_TLB_READ_INDEX;
+
+      UBFX(EncodeRegTo32(XE), addr_w, PowerPC::HW_PAGE_INDEX_SHIFT,
+           MathUtil::IntLog2(PowerPC::HOST_TLB_SIZE));
+      ADD(XE, PPC_REG, XE, ArithOption(XE, ShiftType::LSL, 4));
+      ADDI2R(XE, XE,
+             PPCSTATE_OFF(host_tlb) + table * PowerPC::HOST_TLB_SIZE * sizeof(PowerPC::HostTLBEntry),
+             EncodeRegTo64(WA));
+
+      // Misaligned accesses never match the tag, so a hit can't cross into the next page.
+      AND(WA, addr_w,
+          LogicalImm(static_cast<u32>(~PowerPC::HW_PAGE_MASK) | (access_size / 8 - 1),
+                     GPRSize::B32));
+      LDR(IndexType::Unsigned, WB, XE, offsetof(PowerPC::HostTLBEntry, tag));
+      CMP(WA, WB);
+      FixupBranch miss = B(CC_NEQ);
+      LDR(IndexType::Unsigned, XE, XE, offsetof(PowerPC::HostTLBEntry, host_offset));
+
+      const ArithOption offset(EncodeRegTo64(addr));
+      if (flags & BackPatchInfo::FLAG_STORE)
+      {
+        ARM64Reg src = value;
+        if (!(flags & BackPatchInfo::FLAG_REVERSE) && access_size != 8)
+        {
+          src = access_size == 64 ? EncodeRegTo64(WA) : WA;
+          if (access_size == 64)
+            REV64(src, value);
+          else if (access_size == 32)
+            REV32(src, value);
+          else
+            REV16(src, value);
+        }
+
+        if (access_size >= 32)
+          STR(src, XE, offset);
+        else if (access_size == 16)
+          STRH(src, XE, offset);
+        else
+          STRB(src, XE, offset);
+      }
+      else
+      {
+        if (access_size == 64)
+        {
+          LDR(ARM64Reg::X0, XE, offset);
+          REV64(ARM64Reg::X0, ARM64Reg::X0);
+        }
+        else if (access_size == 32)
+        {
+          LDR(ARM64Reg::W0, XE, offset);
+          REV32(ARM64Reg::W0, ARM64Reg::W0);
+        }
+        else if (access_size == 16)
+        {
+          LDRH(ARM64Reg::W0, XE, offset);
+          REV16(ARM64Reg::W0, ARM64Reg::W0);
+        }
+        else
+        {
+          LDRB(ARM64Reg::W0, XE, offset);
+        }
+      }
+
+      host_tlb_hit = B();
+      SetJumpTarget(miss);
+    };
+
     if (flags & BackPatchInfo::FLAG_STORE)
     {
       ARM64Reg src_reg = RS;
@@ -224,6 +326,9 @@ void JitArm64::EmitBackpatchRoutine(u32 flags, MemAccessMode mode, ARM64Reg RS,
 
       const bool reverse = (flags & BackPatchInfo::FLAG_REVERSE) != 0;
 
+      if (use_host_tlb)
+        emit_host_tlb_access(src_reg);
+
       if (access_size == 64)
       {
         ABI_CallFunction(reverse ? &PowerPC::WriteU64SwapFromJit : &PowerPC::WriteU64FromJit,
@@ -250,6 +355,9 @@ void JitArm64::EmitBackpatchRoutine(u32 flags, MemAccessMode mode, ARM64Reg RS,
     }
     else
     {
+      if (use_host_tlb)
+        emit_host_tlb_access(ARM64Reg::INVALID_REG);
+
       if (access_size == 64)
         ABI_CallFunction(&PowerPC::ReadU64FromJit, &m_mmu, ARM64Reg::W1);
       else if (access_size == 32)
@@ -260,6 +368,9 @@ void JitArm64::EmitBackpatchRoutine(u32 flags, MemAccessMode mode, ARM64Reg RS,
         ABI_CallFunction(&PowerPC::ReadU8FromJit, &m_mmu, ARM64Reg::W1);
     }
 
+    if (host_tlb_hit)
+      SetJumpTarget(*host_tlb_hit);
+
     m_float_emit.ABI_PopRegisters(fprs_to_push, ARM64Reg::X30);
     ABI_PopRegisters(gprs_to_push & ~gprs_to_push_early);
 
@@ -316,7 +427,7 @@ void JitArm64::EmitBackpatchRoutine(u32 flags, MemAccessMode mode, ARM64Reg RS,
   }
 }
 
-bool JitArm64::HandleFastmemFault(SContext* ctx)
+bool JitArm64::HandleFastmemFault(uintptr_t access_address, SContext* ctx)
 {
   const u8* pc = reinterpret_cast<const u8*>(ctx->CTX_PC);
   auto slow_handler_iter = m_fault_to_handler.upper_bound(pc);
@@ -332,6 +443,12 @@ bool JitArm64::HandleFastmemFault(SContext* ctx)
   if (pc < fastmem_area_start)
     return false;
 
+  // Faults on page table translations that haven't been mapped yet go away once they are.
+  if (m_mmu.MapPageTableTranslation(access_address))
+    return true;
+
+  RecordFastmemFault(slow_handler_iter->second.pc);
+
   const Common::ScopedJITPageWriteAndNoExecute enable_jit_page_writes;
   ARM64XEmitter emitter(const_cast<u8*>(fastmem_area_start), const_cast<u8*>(fastmem_area_end));
 
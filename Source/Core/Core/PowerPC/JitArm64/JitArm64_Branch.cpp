@@ -79,6 +79,9 @@ template <bool condition>
 void JitArm64::WriteBranchWatch(u32 origin, u32 destination, UGeckoInstruction inst, ARM64Reg reg_a,
                                 ARM64Reg reg_b, BitSet32 gpr_caller_save, BitSet32 fpr_caller_save)
 {
+  u64* const hit_counter =
+      m_branch_watch.GetHitCounter(origin, destination, inst, m_ppc_state.msr.IR, condition);
+
   const ARM64Reg branch_watch = EncodeRegTo64(reg_a);
   MOVP2R(branch_watch, &m_branch_watch);
   LDRB(IndexType::Unsigned, reg_b, branch_watch, Core::BranchWatch::GetOffsetOfRecordingActive());
@@ -88,16 +91,12 @@ void JitArm64::WriteBranchWatch(u32 origin, u32 destination, UGeckoInstruction i
   SwitchToFarCode();
   SetJumpTarget(branch_in);
 
-  const ARM64Reg float_emit_tmp = EncodeRegTo64(reg_b);
-  ABI_PushRegisters(gpr_caller_save);
-  m_float_emit.ABI_PushRegisters(fpr_caller_save, float_emit_tmp);
-  ABI_CallFunction(m_ppc_state.msr.IR ? (condition ? &Core::BranchWatch::HitVirtualTrue_fk :
-                                                     &Core::BranchWatch::HitVirtualFalse_fk) :
-                                        (condition ? &Core::BranchWatch::HitPhysicalTrue_fk :
-                                                     &Core::BranchWatch::HitPhysicalFalse_fk),
-                   branch_watch, Core::FakeBranchWatchCollectionKey{origin, destination}, inst.hex);
-  m_float_emit.ABI_PopRegisters(fpr_caller_save, float_emit_tmp);
-  ABI_PopRegisters(gpr_caller_save);
+  // Nothing is called, so the caller saved registers don't need to be saved.
+  const ARM64Reg counter = EncodeRegTo64(reg_b);
+  MOVP2R(branch_watch, hit_counter);
+  LDR(IndexType::Unsigned, counter, branch_watch, 0);
+  ADD(counter, counter, 1);
+  STR(IndexType::Unsigned, counter, branch_watch, 0);
 
   FixupBranch branch_out = B();
   SwitchToNearCode();
@@ -178,8 +177,7 @@ void JitArm64::bx(UGeckoInstruction inst)
     return;
   }
 
-  gpr.Flush(FlushMode::All, ARM64Reg::INVALID_REG);
-  fpr.Flush(FlushMode::All, ARM64Reg::INVALID_REG);
+  FlushRegistersForExit(js.op->branchTo);
 
   if (js.op->branchIsIdleLoop)
   {
@@ -360,7 +358,10 @@ void JitArm64::bcctrx(UGeckoInstruction inst)
     WriteBranchWatchDestInRegister(js.compilerPC, WA, inst, WC, WD, gpr_caller_save, {});
     gpr.Unlock(WC, WD);
   }
-  WriteExit(WA, inst.LK_3, js.compilerPC + 4, WB);
+  if (!inst.LK_3 && jo.enableBlocklink)
+    WriteIndirectBranchExit(WA);
+  else
+    WriteExit(WA, inst.LK_3, js.compilerPC + 4, WB);
 
   if (WB != ARM64Reg::INVALID_REG)
     gpr.Unlock(WB);
@@ -22,10 +22,6 @@ void JitArm64::psq_lXX(UGeckoInstruction inst)
   INSTRUCTION_START
   JITDISABLE(bJITLoadStorePairedOff);
 
-  // If fastmem is enabled, the asm routines assume address translation is on.
-  FALLBACK_IF(!js.assumeNoPairedQuantize && jo.fastmem &&
-              !(m_ppc_state.feature_flags & FEATURE_FLAG_MSR_DR));
-
   // X30 is LR
   // X0 is a temporary
   // X1 is the address
@@ -38,9 +34,18 @@ void JitArm64::psq_lXX(UGeckoInstruction inst)
   const int i = indexed ? inst.Ix : inst.I;
   const int w = indexed ? inst.Wx : inst.W;
 
+  // The block entry checked that this GQR still has the value it had at compile time.
+  const bool gqr_is_constant = js.constantGqrValid[i];
+  const u32 gqr_value = js.constantGqr[i] >> 16;
+  const bool assume_no_quantize = gqr_is_constant && (gqr_value & 0x7) == 0;
+
+  // If fastmem is enabled, the asm routines assume address translation is on.
+  FALLBACK_IF(!assume_no_quantize && jo.fastmem &&
+              !(m_ppc_state.feature_flags & FEATURE_FLAG_MSR_DR));
+
   gpr.Lock(ARM64Reg::W1, ARM64Reg::W30);
   fpr.Lock(ARM64Reg::Q0);
-  if (!js.assumeNoPairedQuantize)
+  if (!assume_no_quantize)
   {
     gpr.Lock(ARM64Reg::W0, ARM64Reg::W2, ARM64Reg::W3);
     fpr.Lock(ARM64Reg::Q1);
@@ -77,7 +82,7 @@ void JitArm64::psq_lXX(UGeckoInstruction inst)
     MOV(gpr.R(inst.RA), addr_reg);
   }
 
-  if (js.assumeNoPairedQuantize)
+  if (assume_no_quantize)
   {
     BitSet32 gprs_in_use = gpr.GetCallerSavedUsed();
     BitSet32 fprs_in_use = fpr.GetCallerSavedUsed();
@@ -100,18 +105,30 @@ void JitArm64::psq_lXX(UGeckoInstruction inst)
   }
   else
   {
-    LDR(IndexType::Unsigned, scale_reg, PPC_REG, PPCSTATE_OFF_SPR(SPR_GQR0 + i));
+    if (!gqr_is_constant)
+      LDR(IndexType::Unsigned, scale_reg, PPC_REG, PPCSTATE_OFF_SPR(SPR_GQR0 + i));
 
     // Stash PC in case asm routine needs to call into C++
     MOVI2R(ARM64Reg::W30, js.compilerPC);
     STR(IndexType::Unsigned, ARM64Reg::W30, PPC_REG, PPCSTATE_OFF(pc));
 
-    UBFM(type_reg, scale_reg, 16, 18);   // Type
-    UBFM(scale_reg, scale_reg, 24, 29);  // Scale
+    const u8** routines = w ? single_load_quantized : paired_load_quantized;
+    if (gqr_is_constant)
+    {
+      // Call the routine for this type directly instead of going through the lookup table.
+      MOVI2R(scale_reg, (gqr_value >> 8) & 0x3F);
+      MOVP2R(ARM64Reg::X30, routines[gqr_value & 0x7]);
+      BLR(ARM64Reg::X30);
+    }
+    else
+    {
+      UBFM(type_reg, scale_reg, 16, 18);   // Type
+      UBFM(scale_reg, scale_reg, 24, 29);  // Scale
 
-    MOVP2R(ARM64Reg::X30, w ? single_load_quantized : paired_load_quantized);
-    LDR(EncodeRegTo64(type_reg), ARM64Reg::X30, ArithOption(EncodeRegTo64(type_reg), true));
-    BLR(EncodeRegTo64(type_reg));
+      MOVP2R(ARM64Reg::X30, routines);
+      LDR(EncodeRegTo64(type_reg), ARM64Reg::X30, ArithOption(EncodeRegTo64(type_reg), true));
+      BLR(EncodeRegTo64(type_reg));
+    }
 
     WriteConditionalExceptionExit(EXCEPTION_DSI, ARM64Reg::W30, ARM64Reg::Q1);
 
@@ -135,7 +152,7 @@ void JitArm64::psq_lXX(UGeckoInstruction inst)
 
   gpr.Unlock(ARM64Reg::W1, ARM64Reg::W30);
   fpr.Unlock(ARM64Reg::Q0);
-  if (!js.assumeNoPairedQuantize)
+  if (!assume_no_quantize)
   {
     gpr.Unlock(ARM64Reg::W0, ARM64Reg::W2, ARM64Reg::W3);
     fpr.Unlock(ARM64Reg::Q1);
@@ -151,10 +168,6 @@ void JitArm64::psq_stXX(UGeckoInstruction inst)
   INSTRUCTION_START
   JITDISABLE(bJITLoadStorePairedOff);
 
-  // If fastmem is enabled, the asm routines assume address translation is on.
-  FALLBACK_IF(!js.assumeNoPairedQuantize && jo.fastmem &&
-              !(m_ppc_state.feature_flags & FEATURE_FLAG_MSR_DR));
-
   // X30 is LR
   // X0 is a temporary
   // X1 is the scale
@@ -167,15 +180,24 @@ void JitArm64::psq_stXX(UGeckoInstruction inst)
   const int i = indexed ? inst.Ix : inst.I;
   const int w = indexed ? inst.Wx : inst.W;
 
+  // The block entry checked that this GQR still has the value it had at compile time.
+  const bool gqr_is_constant = js.constantGqrValid[i];
+  const u32 gqr_value = js.constantGqr[i] & 0xFFFF;
+  const bool assume_no_quantize = gqr_is_constant && (gqr_value & 0x7) == 0;
+
+  // If fastmem is enabled, the asm routines assume address translation is on.
+  FALLBACK_IF(!assume_no_quantize && jo.fastmem &&
+              !(m_ppc_state.feature_flags & FEATURE_FLAG_MSR_DR));
+
   fpr.Lock(ARM64Reg::Q0);
-  if (!js.assumeNoPairedQuantize)
+  if (!assume_no_quantize)
     fpr.Lock(ARM64Reg::Q1);
 
   const bool have_single = fpr.IsSingle(inst.RS);
 
   ARM64Reg VS = fpr.R(inst.RS, have_single ? RegType::Single : RegType::Register);
 
-  if (js.assumeNoPairedQuantize)
+  if (assume_no_quantize)
   {
     if (!have_single)
     {
@@ -205,9 +227,9 @@ void JitArm64::psq_stXX(UGeckoInstruction inst)
   }
 
   gpr.Lock(ARM64Reg::W1, ARM64Reg::W2, ARM64Reg::W30);
-  if (!js.assumeNoPairedQuantize || !jo.fastmem)
+  if (!assume_no_quantize || !jo.fastmem)
     gpr.Lock(ARM64Reg::W0);
-  if (!js.assumeNoPairedQuantize && !jo.fastmem)
+  if (!assume_no_quantize && !jo.fastmem)
     gpr.Lock(ARM64Reg::W3);
 
   constexpr ARM64Reg type_reg = ARM64Reg::W0;
@@ -236,7 +258,7 @@ void JitArm64::psq_stXX(UGeckoInstruction inst)
     MOV(gpr.R(inst.RA), addr_reg);
   }
 
-  if (js.assumeNoPairedQuantize)
+  if (assume_no_quantize)
   {
     BitSet32 gprs_in_use = gpr.GetCallerSavedUsed();
     BitSet32 fprs_in_use = fpr.GetCallerSavedUsed();
@@ -257,18 +279,30 @@ void JitArm64::psq_stXX(UGeckoInstruction inst)
   }
   else
   {
-    LDR(IndexType::Unsigned, scale_reg, PPC_REG, PPCSTATE_OFF_SPR(SPR_GQR0 + i));
+    if (!gqr_is_constant)
+      LDR(IndexType::Unsigned, scale_reg, PPC_REG, PPCSTATE_OFF_SPR(SPR_GQR0 + i));
 
     // Stash PC in case asm routine needs to call into C++
     MOVI2R(ARM64Reg::W30, js.compilerPC);
     STR(IndexType::Unsigned, ARM64Reg::W30, PPC_REG, PPCSTATE_OFF(pc));
 
-    UBFM(type_reg, scale_reg, 0, 2);    // Type
-    UBFM(scale_reg, scale_reg, 8, 13);  // Scale
+    const u8** routines = w ? single_store_quantized : paired_store_quantized;
+    if (gqr_is_constant)
+    {
+      // Call the routine for this type directly instead of going through the lookup table.
+      MOVI2R(scale_reg, (gqr_value >> 8) & 0x3F);
+      MOVP2R(ARM64Reg::X30, routines[gqr_value & 0x7]);
+      BLR(ARM64Reg::X30);
+    }
+    else
+    {
+      UBFM(type_reg, scale_reg, 0, 2);    // Type
+      UBFM(scale_reg, scale_reg, 8, 13);  // Scale
 
-    MOVP2R(ARM64Reg::X30, w ? single_store_quantized : paired_store_quantized);
-    LDR(EncodeRegTo64(type_reg), ARM64Reg::X30, ArithOption(EncodeRegTo64(type_reg), true));
-    BLR(EncodeRegTo64(type_reg));
+      MOVP2R(ARM64Reg::X30, routines);
+      LDR(EncodeRegTo64(type_reg), ARM64Reg::X30, ArithOption(EncodeRegTo64(type_reg), true));
+      BLR(EncodeRegTo64(type_reg));
+    }
 
     WriteConditionalExceptionExit(EXCEPTION_DSI, ARM64Reg::W30, ARM64Reg::Q1);
   }
@@ -279,15 +313,15 @@ void JitArm64::psq_stXX(UGeckoInstruction inst)
     MOV(gpr.R(inst.RA), addr_reg);
   }
 
-  if (js.assumeNoPairedQuantize && !have_single)
+  if (assume_no_quantize && !have_single)
     fpr.Unlock(VS);
 
   gpr.Unlock(ARM64Reg::W1, ARM64Reg::W2, ARM64Reg::W30);
   fpr.Unlock(ARM64Reg::Q0);
-  if (!js.assumeNoPairedQuantize || !jo.fastmem)
+  if (!assume_no_quantize || !jo.fastmem)
     gpr.Unlock(ARM64Reg::W0);
-  if (!js.assumeNoPairedQuantize && !jo.fastmem)
+  if (!assume_no_quantize && !jo.fastmem)
     gpr.Unlock(ARM64Reg::W3);
-  if (!js.assumeNoPairedQuantize)
+  if (!assume_no_quantize)
     fpr.Unlock(ARM64Reg::Q1);
 }
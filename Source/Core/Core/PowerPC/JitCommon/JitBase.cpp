@@ -6,6 +6,7 @@
 #include <algorithm>
 #include <array>
 #include <utility>
+#include <vector>
 
 #include "Common/Align.h"
 #include "Common/CommonTypes.h"
@@ -18,6 +19,8 @@
 #include "Core/Core.h"
 #include "Core/CoreTiming.h"
 #include "Core/HW/CPU.h"
+#include "Core/HW/Memmap.h"
+#include "Core/HW/SystemTimers.h"
 #include "Core/MemTools.h"
 #include "Core/PowerPC/PPCAnalyst.h"
 #include "Core/PowerPC/PowerPC.h"
@@ -57,7 +60,7 @@
 // After resetting the stack to the top, we call _resetstkoflw() to restore
 // the guard page at the 256kb mark.
 
-const std::array<std::pair<bool JitBase::*, const Config::Info<bool>*>, 23> JitBase::JIT_SETTINGS{{
+const std::array<std::pair<bool JitBase::*, const Config::Info<bool>*>, 25> JitBase::JIT_SETTINGS{{
     {&JitBase::bJITOff, &Config::MAIN_DEBUG_JIT_OFF},
     {&JitBase::bJITLoadStoreOff, &Config::MAIN_DEBUG_JIT_LOAD_STORE_OFF},
     {&JitBase::bJITLoadStorelXzOff, &Config::MAIN_DEBUG_JIT_LOAD_STORE_LXZ_OFF},
@@ -81,6 +84,8 @@ const std::array<std::pair<bool JitBase::*, const Config::Info<bool>*>, 23> JitB
     {&JitBase::m_accurate_nans, &Config::MAIN_ACCURATE_NANS},
     {&JitBase::m_fastmem_enabled, &Config::MAIN_FASTMEM},
     {&JitBase::m_accurate_cpu_cache_enabled, &Config::MAIN_ACCURATE_CPU_CACHE},
+    {&JitBase::m_enable_tiered_compilation, &Config::MAIN_JIT_TIERED_COMPILATION},
+    {&JitBase::m_enable_cross_block_liveness, &Config::MAIN_JIT_CROSS_BLOCK_LIVENESS},
 }};
 
 const u8* JitBase::Dispatch(JitBase& jit)
@@ -133,10 +138,15 @@ void JitBase::RefreshConfig()
   analyzer.SetBranchFollowingEnabled(m_enable_branch_following);
   analyzer.SetFloatExceptionsEnabled(m_enable_float_exceptions);
   analyzer.SetDivByZeroExceptionsEnabled(m_enable_div_by_zero_exceptions);
+  analyzer.SetCrossBlockLivenessEnabled(m_enable_cross_block_liveness && !bJITRegisterCacheOff);
 
+  // Watched pages are made inaccessible in the fastmem views, so that accesses to them get
+  // backpatched. Only the logical view can do this on hosts without memory protection.
   bool any_watchpoints = m_system.GetPowerPC().GetMemChecks().HasAny();
-  jo.fastmem = m_fastmem_enabled && jo.fastmem_arena && (m_ppc_state.msr.DR || !any_watchpoints) &&
-               EMM::IsExceptionHandlerSupported();
+  const bool memchecks_in_fastmem =
+      m_ppc_state.msr.DR || m_system.GetMemory().CanProtectMemCheckPages();
+  jo.fastmem = m_fastmem_enabled && jo.fastmem_arena &&
+               (memchecks_in_fastmem || !any_watchpoints) && EMM::IsExceptionHandlerSupported();
   jo.memcheck = m_system.IsMMUMode() || m_system.IsPauseOnPanicMode() || any_watchpoints;
   jo.fp_exceptions = m_enable_float_exceptions;
   jo.div_by_zero_exceptions = m_enable_div_by_zero_exceptions;
@@ -260,6 +270,63 @@ void JitBase::CleanUpAfterStackFault()
   }
 }
 
+void JitBase::PrecompilePersistentBlocks(u32 em_address)
+{
+  JitBaseBlockCache* block_cache = GetBlockCache();
+  const CPUEmuFeatureFlags feature_flags = m_ppc_state.feature_flags;
+  const std::vector<u32> addresses = block_cache->TakePersistentBlocks(em_address, feature_flags);
+  if (addresses.empty())
+    return;
+
+  INFO_LOG_FMT(DYNA_REC, "Precompiling {} blocks from the persistent block index",
+               addresses.size());
+
+  for (u32 address : addresses)
+  {
+    if (address != em_address && !block_cache->GetBlockFromStartAddress(address, feature_flags))
+      Jit(address);
+  }
+}
+
+bool JitBase::ShouldCompileCold(u32 em_address) const
+{
+  // Most blocks only ever run a handful of times (boot code, level loading), so with tiered
+  // compilation we don't spend time optimizing a block until it has proven to be hot.
+  return m_enable_tiered_compilation && !m_enable_debugging && !IsProfilingEnabled() &&
+         !js.hotBlockAddresses.contains(em_address);
+}
+
+void JitBase::RecordFastmemFault(u32 pc)
+{
+  FastmemSite& site = m_fastmem_sites[pc];
+  ++site.faults;
+  site.last_fault_ticks = m_system.GetCoreTiming().GetTicks();
+}
+
+bool JitBase::ShouldCompileSlowmem(u32 pc)
+{
+  // A single fault only costs one backpatch, so that doesn't make the site slow for good. Sites
+  // which stopped faulting a long time ago get another chance to use fastmem.
+  const auto it = m_fastmem_sites.find(pc);
+  if (it == m_fastmem_sites.end() || it->second.faults < SLOWMEM_FAULT_THRESHOLD)
+    return false;
+
+  const u64 decay_ticks =
+      u64{m_system.GetSystemTimers().GetTicksPerSecond()} * FASTMEM_SITE_DECAY_SECONDS;
+  if (m_system.GetCoreTiming().GetTicks() - it->second.last_fault_ticks > decay_ticks)
+    return false;
+
+  ++m_statistics.slowmem_sites_compiled;
+  return true;
+}
+
+bool JitBase::UseReturnStack() const
+{
+  // The BLR optimization already predicts returns through the host stack. Without it, bl pushes
+  // onto the return stack in PowerPCState so that blr can still skip the dispatcher's lookup.
+  return !m_enable_blr_optimization && jo.enableBlocklink;
+}
+
 bool JitBase::CanMergeNextInstructions(int count) const
 {
   if (m_system.GetCPU().IsStepping() || js.instructionsLeft < count)
@@ -268,7 +335,7 @@ bool JitBase::CanMergeNextInstructions(int count) const
   for (int i = 1; i <= count; i++)
   {
     if (m_enable_debugging &&
-        m_system.GetPowerPC().GetBreakPoints().IsAddressBreakPoint(js.op[i].address))
+        m_system.GetPowerPC().GetBreakPoints().IsBreakPointEnable(js.op[i].address))
     {
       return false;
     }
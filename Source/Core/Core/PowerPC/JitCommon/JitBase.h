@@ -4,10 +4,13 @@
 #pragma once
 
 #include <array>
+#include <chrono>
 #include <cstddef>
 #include <map>
+#include <unordered_map>
 #include <unordered_set>
 #include <utility>
+#include <vector>
 
 #include "Common/BitSet.h"
 #include "Common/CommonTypes.h"
@@ -19,6 +22,7 @@
 #include "Core/PowerPC/CPUCoreBase.h"
 #include "Core/PowerPC/JitCommon/JitAsmCommon.h"
 #include "Core/PowerPC/JitCommon/JitCache.h"
+#include "Core/PowerPC/JitInterface.h"
 #include "Core/PowerPC/PPCAnalyst.h"
 
 namespace Core
@@ -52,7 +56,7 @@ class PPCSymbolDB;
     }                                                                                              \
   } while (0)
 
-#define JITDISABLE(setting) FALLBACK_IF(bJITOff || setting)
+#define JITDISABLE(setting) FALLBACK_IF(bJITOff || js.coldBlock || setting)
 
 class JitBase : public CPUCoreBase
 {
@@ -76,6 +80,21 @@ protected:
   static constexpr size_t GUARD_SIZE = 64 * 1024;
   static constexpr size_t GUARD_OFFSET = SAFE_STACK_SIZE - GUARD_SIZE;
 
+  // With tiered compilation, this is how many times a cold block runs before it gets recompiled.
+  static constexpr u32 TIER_UP_THRESHOLD = 64;
+
+  // A fastmem access that faults this many times, each time in a newly compiled block, gets
+  // compiled as a slow access from then on, until it hasn't faulted for FASTMEM_SITE_DECAY_SECONDS
+  // of emulated time.
+  static constexpr u32 SLOWMEM_FAULT_THRESHOLD = 2;
+  static constexpr u32 FASTMEM_SITE_DECAY_SECONDS = 10;
+
+  struct FastmemSite
+  {
+    u32 faults = 0;
+    u64 last_fault_ticks = 0;
+  };
+
   struct JitOptions
   {
     bool enableBlocklink;
@@ -102,7 +121,6 @@ protected:
     bool fixupExceptionHandler;
     Gen::FixupBranch exceptionHandler;
 
-    bool assumeNoPairedQuantize;
     BitSet8 constantGqrValid;
     std::array<u32, 8> constantGqr;
     bool firstFPInstructionFound;
@@ -110,6 +128,10 @@ protected:
     int skipInstructions;
     CarryFlag carryFlag;
 
+    // Whether the current block is compiled as a cheap sequence of interpreter calls, which gets
+    // replaced with a fully optimized block once it has run TIER_UP_THRESHOLD times.
+    bool coldBlock = false;
+
     bool generatingTrampoline = false;
     u8* trampolineExceptionHandler;
 
@@ -127,6 +149,9 @@ protected:
     std::unordered_set<u32> fifoWriteAddresses;
     std::unordered_set<u32> pairedQuantizeAddresses;
     std::unordered_set<u32> noSpeculativeConstantsAddresses;
+    std::unordered_set<u32> hotBlockAddresses;
+    // Destinations seen so far by each indirect branch, keyed by the address of the branch.
+    std::unordered_map<u32, std::vector<u32>> indirectBranchTargets;
   };
 
   PPCAnalyst::CodeBlock code_block;
@@ -157,12 +182,17 @@ protected:
   bool m_accurate_nans = false;
   bool m_fastmem_enabled = false;
   bool m_accurate_cpu_cache_enabled = false;
+  bool m_enable_tiered_compilation = false;
+  bool m_enable_cross_block_liveness = false;
 
   bool m_enable_blr_optimization = false;
   bool m_cleanup_after_stackfault = false;
   u8* m_stack_guard = nullptr;
 
-  static const std::array<std::pair<bool JitBase::*, const Config::Info<bool>*>, 23> JIT_SETTINGS;
+  JitInterface::Statistics m_statistics;
+  std::map<u32, FastmemSite> m_fastmem_sites;
+
+  static const std::array<std::pair<bool JitBase::*, const Config::Info<bool>*>, 25> JIT_SETTINGS;
 
   bool DoesConfigNeedRefresh();
   void RefreshConfig();
@@ -174,6 +204,22 @@ protected:
   void UnprotectStack();
   void CleanUpAfterStackFault();
 
+  void PrecompilePersistentBlocks(u32 em_address);
+
+  void CountCompile(std::chrono::steady_clock::duration time)
+  {
+    ++m_statistics.blocks_compiled;
+    m_statistics.compile_time_ns +=
+        std::chrono::duration_cast<std::chrono::nanoseconds>(time).count();
+  }
+
+  bool ShouldCompileCold(u32 em_address) const;
+
+  // Called when the fastmem access of the instruction at pc is backpatched.
+  void RecordFastmemFault(u32 pc);
+
+  bool UseReturnStack() const;
+
   bool CanMergeNextInstructions(int count) const;
 
   bool ShouldHandleFPExceptionForInstruction(const PPCAnalyst::CodeOp* op);
@@ -188,6 +234,14 @@ public:
 
   bool IsProfilingEnabled() const { return m_enable_profiling; }
   bool IsDebuggingEnabled() const { return m_enable_debugging; }
+  const JitInterface::Statistics& GetStatistics() const { return m_statistics; }
+
+  // Instructions whose fastmem accesses have faulted, by address.
+  const std::map<u32, FastmemSite>& GetFastmemSites() const { return m_fastmem_sites; }
+
+  // Whether the memory accesses of the instruction at pc should skip fastmem. Instead of
+  // backpatching, they then check inline whether the address can be accessed directly.
+  bool ShouldCompileSlowmem(u32 pc);
 
   static const u8* Dispatch(JitBase& jit);
   virtual JitBaseBlockCache* GetBlockCache() = 0;
@@ -201,6 +255,10 @@ public:
 
   static constexpr std::size_t code_buffer_size = 32000;
 
+  // How many destinations the inline cache of an indirect branch (bcctr) compares against before
+  // falling back to the dispatcher.
+  static constexpr std::size_t MAX_INDIRECT_BRANCH_TARGETS = 4;
+
   // This should probably be removed from public:
   JitOptions jo{};
   JitState js{};
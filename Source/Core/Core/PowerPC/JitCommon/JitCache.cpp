@@ -8,17 +8,31 @@
 #include <cstring>
 #include <functional>
 #include <map>
+#include <optional>
 #include <set>
+#include <span>
+#include <string>
 #include <utility>
+#include <vector>
 
+#include <fmt/format.h>
+
+#include "Common/CommonPaths.h"
 #include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/Hash.h"
 #include "Common/JitRegister.h"
+#include "Common/Logging/Log.h"
+#include "Common/MemoryAccounting.h"
 #include "Core/Config/MainSettings.h"
+#include "Core/ConfigManager.h"
 #include "Core/Core.h"
+#include "Core/HW/Memmap.h"
 #include "Core/PowerPC/JitCommon/JitBase.h"
 #include "Core/PowerPC/MMU.h"
 #include "Core/PowerPC/PPCSymbolDB.h"
 #include "Core/PowerPC/PowerPC.h"
+#include "Core/System.h"
 
 #ifdef _WIN32
 #include <windows.h>
@@ -26,6 +40,57 @@
 
 using namespace Gen;
 
+namespace
+{
+// Hashes the guest instructions at the given physical addresses. A collision only costs us a
+// needless compile, since blocks are always compiled from the current contents of guest memory.
+template <typename Range>
+std::optional<u32> HashGuestCode(const Memory::MemoryManager& memory, const Range& addresses)
+{
+  std::vector<u32> code;
+  code.reserve(addresses.size());
+  for (u32 address : addresses)
+  {
+    const std::span<u8> span = memory.GetSpanForAddress(address);
+    if (span.size() < sizeof(u32))
+      return std::nullopt;
+
+    u32 inst;
+    std::memcpy(&inst, span.data(), sizeof(u32));
+    code.push_back(inst);
+  }
+  return Common::HashAdler32(reinterpret_cast<const u8*>(code.data()), code.size() * sizeof(u32));
+}
+
+class PersistentIndexReader final : public Common::LinearDiskCacheReader<JitBlockIndexKey, u32>
+{
+public:
+  PersistentIndexReader(std::set<JitBlockIndexKey>& keys,
+                        std::multimap<u32, JitBlockIndexEntry>& entries)
+      : m_keys(keys), m_entries(entries)
+  {
+  }
+
+  void Read(const JitBlockIndexKey& key, const u32* value, u32 value_size) override
+  {
+    if (!m_keys.insert(key).second)
+      return;
+
+    m_entries.emplace(key.effective_address,
+                      JitBlockIndexEntry{key, std::vector<u32>(value, value + value_size)});
+  }
+
+private:
+  std::set<JitBlockIndexKey>& m_keys;
+  std::multimap<u32, JitBlockIndexEntry>& m_entries;
+};
+
+u64 GetCodeSize(const JitBlock& block)
+{
+  return (block.near_end - block.near_begin) + (block.far_end - block.far_begin);
+}
+}  // namespace
+
 bool JitBlock::OverlapsPhysicalRange(u32 address, u32 length) const
 {
   return physical_addresses.lower_bound(address) !=
@@ -52,7 +117,8 @@ JitBaseBlockCache::~JitBaseBlockCache() = default;
 
 void JitBaseBlockCache::Init()
 {
-  Common::JitRegister::Init(Config::Get(Config::MAIN_PERF_MAP_DIR));
+  Common::JitRegister::Init(Config::Get(Config::MAIN_PERF_MAP_DIR),
+                            Config::Get(Config::MAIN_PERF_JITDUMP));
 
   m_entry_points_ptr = nullptr;
 #ifdef _ARCH_64
@@ -60,6 +126,8 @@ void JitBaseBlockCache::Init()
     m_entry_points_ptr = reinterpret_cast<u8**>(m_entry_points_arena.Create(FAST_BLOCK_MAP_SIZE));
 #endif
 
+  m_persistent_index_enabled = Config::Get(Config::MAIN_JIT_PERSISTENT_CACHE);
+
   Clear();
 }
 
@@ -67,6 +135,16 @@ void JitBaseBlockCache::Shutdown()
 {
   Common::JitRegister::Shutdown();
 
+  if (m_persistent_index_open)
+  {
+    m_persistent_index_file.Sync();
+    m_persistent_index_file.Close();
+    m_persistent_index_open = false;
+  }
+  m_persistent_index_game_id.clear();
+  m_persistent_index_keys.clear();
+  m_persistent_index_pending.clear();
+
   m_entry_points_arena.Release();
 }
 
@@ -80,18 +158,24 @@ void JitBaseBlockCache::Clear()
   m_jit.js.fifoWriteAddresses.clear();
   m_jit.js.pairedQuantizeAddresses.clear();
   m_jit.js.noSpeculativeConstantsAddresses.clear();
+  m_jit.js.hotBlockAddresses.clear();
+  m_jit.js.indirectBranchTargets.clear();
   for (auto& e : block_map)
   {
     DestroyBlock(e.second);
   }
   block_map.clear();
   links_to.clear();
-  block_range_map.clear();
+  for (auto& chunk : block_range_map)
+    chunk.reset();
 
   valid_block.ClearAll();
 
   if (m_entry_points_ptr)
     m_entry_points_arena.Clear();
+
+  // All of the code space is free again.
+  Common::MemoryAccounting::Set(Common::MemoryAccounting::Subsystem::JitCode, 0);
 }
 
 void JitBaseBlockCache::Reset()
@@ -126,6 +210,7 @@ JitBlock* JitBaseBlockCache::AllocateBlock(u32 em_address)
   b.feature_flags = m_jit.m_ppc_state.feature_flags;
   b.linkData.clear();
   b.fast_block_map_index = 0;
+  b.compile_index = 0;
   return &b;
 }
 
@@ -143,14 +228,24 @@ void JitBaseBlockCache::FinalizeBlock(JitBlock& block, bool block_link,
     m_fast_block_map_fallback[index] = &block;
   }
   block.fast_block_map_index = index;
+  block.compile_index = ++m_next_compile_index;
 
   block.physical_addresses = physical_addresses;
 
-  u32 range_mask = ~(BLOCK_RANGE_MAP_ELEMENTS - 1);
+  Common::MemoryAccounting::Add(Common::MemoryAccounting::Subsystem::JitCode, GetCodeSize(block));
+
+  // physical_addresses is sorted, so each page only needs to be compared against the last one.
+  u32 last_page = 0;
+  bool first = true;
   for (u32 addr : physical_addresses)
   {
     valid_block.Set(addr / 32);
-    block_range_map[addr & range_mask].insert(&block);
+
+    const u32 page = addr >> BLOCK_RANGE_PAGE_SHIFT;
+    if (first || page != last_page)
+      GetOrCreateBlockRangePage(addr).push_back(&block);
+    last_page = page;
+    first = false;
   }
 
   if (block_link)
@@ -175,6 +270,9 @@ void JitBaseBlockCache::FinalizeBlock(JitBlock& block, bool block_link,
     Common::JitRegister::Register(block.normalEntry, block.codeSize, "JIT_PPC_{:08x}",
                                   block.physicalAddress);
   }
+
+  if (IsPersistentIndexEnabled())
+    RecordPersistentBlock(block);
 }
 
 JitBlock* JitBaseBlockCache::GetBlockFromStartAddress(u32 addr, CPUEmuFeatureFlags feature_flags)
@@ -316,6 +414,8 @@ void JitBaseBlockCache::InvalidateICacheInternal(u32 physical_address, u32 addre
         m_jit.js.fifoWriteAddresses.erase(i);
         m_jit.js.pairedQuantizeAddresses.erase(i);
         m_jit.js.noSpeculativeConstantsAddresses.erase(i);
+        m_jit.js.hotBlockAddresses.erase(i);
+        m_jit.js.indirectBranchTargets.erase(i);
       }
     }
   }
@@ -323,51 +423,124 @@ void JitBaseBlockCache::InvalidateICacheInternal(u32 physical_address, u32 addre
 
 void JitBaseBlockCache::ErasePhysicalRange(u32 address, u32 length)
 {
-  // Iterate over all macro blocks which overlap the given range.
-  u32 range_mask = ~(BLOCK_RANGE_MAP_ELEMENTS - 1);
-  auto start = block_range_map.lower_bound(address & range_mask);
-  auto end = block_range_map.lower_bound(address + length);
-  while (start != end)
+  if (length == 0)
+    return;
+
+  // Iterate over all pages which overlap the given range.
+  const u64 first_page = address >> BLOCK_RANGE_PAGE_SHIFT;
+  const u64 last_page = (u64{address} + length - 1) >> BLOCK_RANGE_PAGE_SHIFT;
+  for (u64 page = first_page; page <= last_page; ++page)
   {
-    // Iterate over all blocks in the macro block.
-    auto iter = start->second.begin();
-    while (iter != start->second.end())
+    const u32 page_address = static_cast<u32>(page << BLOCK_RANGE_PAGE_SHIFT);
+    if (!block_range_map[page_address >> BLOCK_RANGE_CHUNK_SHIFT])
+    {
+      // Skip the rest of a chunk which has never contained any blocks.
+      page |= BLOCK_RANGE_PAGES_PER_CHUNK - 1;
+      continue;
+    }
+
+    std::vector<JitBlock*>& blocks = *GetBlockRangePage(page_address);
+    size_t i = 0;
+    while (i < blocks.size())
     {
-      JitBlock* block = *iter;
+      JitBlock* block = blocks[i];
       if (block->OverlapsPhysicalRange(address, length))
       {
-        // If the block overlaps, also remove all other occupied slots in the other macro blocks.
-        // This will leak empty macro blocks, but they may be reused or cleared later on.
-        for (u32 addr : block->physical_addresses)
-          if ((addr & range_mask) != start->first)
-            block_range_map[addr & range_mask].erase(block);
-
-        // And remove the block.
-        DestroyBlock(*block);
-        auto block_map_iter = block_map.equal_range(block->physicalAddress);
-        while (block_map_iter.first != block_map_iter.second)
-        {
-          if (&block_map_iter.first->second == block)
-          {
-            block_map.erase(block_map_iter.first);
-            break;
-          }
-          block_map_iter.first++;
-        }
-        iter = start->second.erase(iter);
+        // This also removes the block from the current page, moving another block into slot i.
+        EraseBlock(*block);
       }
       else
       {
-        iter++;
+        ++i;
       }
     }
+  }
+}
 
-    // If the macro block is empty, drop it.
-    if (start->second.empty())
-      start = block_range_map.erase(start);
-    else
-      start++;
+bool JitBaseBlockCache::EvictOldestBlocks()
+{
+  if (block_map.size() < MIN_BLOCKS_FOR_EVICTION)
+    return false;
+
+  std::vector<JitBlock*> blocks;
+  blocks.reserve(block_map.size());
+  for (auto& e : block_map)
+    blocks.push_back(&e.second);
+
+  const size_t count = blocks.size() / EVICTION_DIVISOR;
+  std::nth_element(blocks.begin(), blocks.begin() + count, blocks.end(),
+                   [](const JitBlock* a, const JitBlock* b) {
+                     return a->compile_index < b->compile_index;
+                   });
+
+  for (size_t i = 0; i < count; ++i)
+    EraseBlock(*blocks[i]);
+
+  return true;
+}
+
+void JitBaseBlockCache::DiscardBlock(JitBlock& block)
+{
+  auto block_map_iter = block_map.equal_range(block.physicalAddress);
+  while (block_map_iter.first != block_map_iter.second)
+  {
+    if (&block_map_iter.first->second == &block)
+    {
+      block_map.erase(block_map_iter.first);
+      break;
+    }
+    block_map_iter.first++;
+  }
+}
+
+void JitBaseBlockCache::EraseBlock(JitBlock& block)
+{
+  // Remove all occupied slots in the pages covered by the block.
+  // physical_addresses is sorted, so each page only needs to be compared against the last one.
+  u32 last_page = 0;
+  bool first = true;
+  for (u32 addr : block.physical_addresses)
+  {
+    const u32 page = addr >> BLOCK_RANGE_PAGE_SHIFT;
+    if (!first && page == last_page)
+      continue;
+    last_page = page;
+    first = false;
+
+    std::vector<JitBlock*>* blocks = GetBlockRangePage(addr);
+    if (!blocks)
+      continue;
+    const auto it = std::find(blocks->begin(), blocks->end(), &block);
+    if (it != blocks->end())
+    {
+      // The order of blocks within a page doesn't matter.
+      *it = blocks->back();
+      blocks->pop_back();
+    }
   }
+
+  // And remove the block.
+  DestroyBlock(block);
+  DiscardBlock(block);
+}
+
+std::vector<JitBlock*>* JitBaseBlockCache::GetBlockRangePage(u32 physical_address)
+{
+  BlockRangeChunk* chunk = block_range_map[physical_address >> BLOCK_RANGE_CHUNK_SHIFT].get();
+  if (!chunk)
+    return nullptr;
+
+  return &(*chunk)[(physical_address >> BLOCK_RANGE_PAGE_SHIFT) % BLOCK_RANGE_PAGES_PER_CHUNK];
+}
+
+std::vector<JitBlock*>& JitBaseBlockCache::GetOrCreateBlockRangePage(u32 physical_address)
+{
+  std::unique_ptr<BlockRangeChunk>& chunk =
+      block_range_map[physical_address >> BLOCK_RANGE_CHUNK_SHIFT];
+  if (!chunk)
+    chunk = std::make_unique<BlockRangeChunk>();
+
+  return (*chunk)[(physical_address >> BLOCK_RANGE_PAGE_SHIFT) % BLOCK_RANGE_PAGES_PER_CHUNK];
 }
 
 u32* JitBaseBlockCache::GetBlockBitSet() const
@@ -375,6 +548,106 @@ u32* JitBaseBlockCache::GetBlockBitSet() const
   return valid_block.m_valid_block.get();
 }
 
+std::vector<u32> JitBaseBlockCache::TakePersistentBlocks(u32 em_address,
+                                                         CPUEmuFeatureFlags feature_flags)
+{
+  if (!IsPersistentIndexEnabled())
+    return {};
+
+  UpdatePersistentIndex();
+
+  const auto [first, last] = m_persistent_index_pending.equal_range(em_address);
+  if (std::none_of(first, last, [&](const auto& e) {
+        return IsPersistentBlockValid(e.second, feature_flags);
+      }))
+  {
+    return {};
+  }
+
+  // Entries which don't match at this point are most likely stale or belong to code which gets
+  // loaded later on, so they are dropped and compiled on demand as usual.
+  std::vector<u32> addresses;
+  for (const auto& [address, entry] : m_persistent_index_pending)
+  {
+    if (IsPersistentBlockValid(entry, feature_flags))
+      addresses.push_back(address);
+  }
+  m_persistent_index_pending.clear();
+
+  return addresses;
+}
+
+bool JitBaseBlockCache::IsPersistentIndexEnabled() const
+{
+  return m_persistent_index_enabled && !m_jit.IsDebuggingEnabled();
+}
+
+void JitBaseBlockCache::UpdatePersistentIndex()
+{
+  // The running title can change after the JIT has been initialized, e.g. when launching a game
+  // from the Wii Menu, so the index is (re)opened lazily whenever the game ID changes.
+  const std::string& game_id = SConfig::GetInstance().GetGameID();
+  if (game_id == m_persistent_index_game_id)
+    return;
+
+  if (m_persistent_index_open)
+  {
+    m_persistent_index_file.Sync();
+    m_persistent_index_file.Close();
+    m_persistent_index_open = false;
+  }
+  m_persistent_index_keys.clear();
+  m_persistent_index_pending.clear();
+  m_persistent_index_game_id = game_id;
+
+  if (game_id.empty() || game_id == "00000000")
+    return;
+
+  const std::string filename =
+      fmt::format("{}JIT" DIR_SEP "{}.jitidx", File::GetUserPath(D_CACHE_IDX), game_id);
+  File::CreateFullPath(filename);
+
+  PersistentIndexReader reader(m_persistent_index_keys, m_persistent_index_pending);
+  const u32 count = m_persistent_index_file.OpenAndRead(filename, reader);
+  m_persistent_index_open = true;
+  INFO_LOG_FMT(DYNA_REC, "Loaded {} blocks from persistent block index {}", count, filename);
+}
+
+void JitBaseBlockCache::RecordPersistentBlock(const JitBlock& block)
+{
+  UpdatePersistentIndex();
+  if (!m_persistent_index_open || m_persistent_index_keys.size() >= PERSISTENT_INDEX_MAX_BLOCKS)
+    return;
+
+  const std::optional<u32> code_hash =
+      HashGuestCode(m_jit.m_system.GetMemory(), block.physical_addresses);
+  if (!code_hash)
+    return;
+
+  const JitBlockIndexKey key{block.effectiveAddress, block.physicalAddress, block.feature_flags,
+                             *code_hash};
+  if (!m_persistent_index_keys.insert(key).second)
+    return;
+
+  const std::vector<u32> physical_addresses(block.physical_addresses.begin(),
+                                            block.physical_addresses.end());
+  m_persistent_index_file.Append(key, physical_addresses.data(),
+                                 static_cast<u32>(physical_addresses.size()));
+}
+
+bool JitBaseBlockCache::IsPersistentBlockValid(const JitBlockIndexEntry& entry,
+                                               CPUEmuFeatureFlags feature_flags) const
+{
+  if (entry.key.feature_flags != feature_flags || entry.physical_addresses.empty())
+    return false;
+
+  const auto translated = m_jit.m_mmu.JitCache_TranslateAddress(entry.key.effective_address);
+  if (!translated.valid || translated.address != entry.key.physical_address)
+    return false;
+
+  return HashGuestCode(m_jit.m_system.GetMemory(), entry.physical_addresses) == entry.key.code_hash;
+}
+
 void JitBaseBlockCache::WriteDestroyBlock(const JitBlock& block)
 {
 }
@@ -475,6 +748,9 @@ void JitBaseBlockCache::DestroyBlock(JitBlock& block)
 
   // Raise an signal if we are going to call this block again
   WriteDestroyBlock(block);
+
+  Common::MemoryAccounting::Remove(Common::MemoryAccounting::Subsystem::JitCode,
+                                   GetCodeSize(block));
 }
 
 JitBlock* JitBaseBlockCache::MoveBlockIntoFastCache(u32 addr, CPUEmuFeatureFlags feature_flags)
@@ -11,12 +11,14 @@
 #include <map>
 #include <memory>
 #include <set>
+#include <string>
 #include <type_traits>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Common/LinearDiskCache.h"
 #include "Core/HW/Memmap.h"
 #include "Core/PowerPC/Gekko.h"
 
@@ -88,6 +90,9 @@ struct JitBlock : public JitBlockData
 
   bool OverlapsPhysicalRange(u32 address, u32 length) const;
 
+  // Remaining runs of a cold block before it asks to be recompiled. Decremented by the block itself.
+  u32 tier_up_countdown = 0;
+
   // Information about exits to a known address from this block.
   // This is used to implement block linking.
   struct LinkData
@@ -105,11 +110,34 @@ struct JitBlock : public JitBlockData
   // This set stores all physical addresses of all occupied instructions.
   std::set<u32> physical_addresses;
 
+  // Position of the block in the order blocks were finalized in, so that the oldest blocks can be
+  // evicted first when running out of code space. Zero for blocks which aren't finalized yet.
+  u64 compile_index = 0;
+
   std::unique_ptr<ProfileData> profile_data;
 };
 
 typedef void (*CompiledCode)();
 
+// Key of an entry in the persistent block index. The guest code of a block is identified by a hash
+// of the instructions at its physical addresses, which are stored as the value of the entry.
+struct JitBlockIndexKey
+{
+  u32 effective_address;
+  u32 physical_address;
+  u32 feature_flags;
+  u32 code_hash;
+
+  auto operator<=>(const JitBlockIndexKey&) const = default;
+};
+static_assert(std::is_trivially_copyable_v<JitBlockIndexKey>);
+
+struct JitBlockIndexEntry
+{
+  JitBlockIndexKey key;
+  std::vector<u32> physical_addresses;
+};
+
 // This is essentially just an std::bitset, but Visual Studia 2013's
 // implementation of std::bitset is slow.
 class ValidBlockBitSet final
@@ -180,8 +208,20 @@ public:
   void InvalidateICacheLine(u32 address);
   void ErasePhysicalRange(u32 address, u32 length);
 
+  // Destroys the oldest quarter of all blocks to make room in the code space, which is much cheaper
+  // than throwing away the whole cache. Returns false if there were too few blocks to bother.
+  bool EvictOldestBlocks();
+
+  // Drops a block returned by AllocateBlock whose code generation failed before FinalizeBlock.
+  void DiscardBlock(JitBlock& block);
+
   u32* GetBlockBitSet() const;
 
+  // Returns the effective addresses of all blocks from the persistent block index which still match
+  // guest memory, but only once em_address is one of them. The index is consumed by this, so the
+  // caller is expected to compile the returned blocks right away.
+  std::vector<u32> TakePersistentBlocks(u32 em_address, CPUEmuFeatureFlags feature_flags);
+
 protected:
   virtual void DestroyBlock(JitBlock& block);
 
@@ -195,12 +235,19 @@ private:
   void LinkBlock(JitBlock& block);
   void UnlinkBlock(const JitBlock& block);
   void InvalidateICacheInternal(u32 physical_address, u32 address, u32 length, bool forced);
+  void EraseBlock(JitBlock& block);
 
   JitBlock* MoveBlockIntoFastCache(u32 em_address, CPUEmuFeatureFlags feature_flags);
 
   // Fast but risky block lookup based on fast_block_map.
   size_t FastLookupIndexForAddress(u32 address, u32 msr);
 
+  bool IsPersistentIndexEnabled() const;
+  void UpdatePersistentIndex();
+  void RecordPersistentBlock(const JitBlock& block);
+  bool IsPersistentBlockValid(const JitBlockIndexEntry& entry,
+                              CPUEmuFeatureFlags feature_flags) const;
+
   // links_to hold all exit points of all valid blocks in a reverse way.
   // It is used to query all blocks which links to an address.
   std::unordered_map<u32, std::unordered_set<JitBlock*>> links_to;  // destination_PC -> number
@@ -209,11 +256,24 @@ private:
   // This is used to query the block based on the current PC in a slow way.
   std::multimap<u32, JitBlock> block_map;  // start_addr -> block
 
-  // Range of overlapping code indexed by a masked physical address.
-  // This is used for invalidation of memory regions. The range is grouped
-  // in macro blocks of each 0x100 bytes.
-  static constexpr u32 BLOCK_RANGE_MAP_ELEMENTS = 0x100;
-  std::map<u32, std::unordered_set<JitBlock*>> block_range_map;
+  // Blocks overlapping each 4 KiB page of the physical address space.
+  // This is used for invalidation of memory regions. The pages are allocated lazily in chunks of
+  // 4 MiB, since only a small part of the address space ever contains any code.
+  static constexpr u32 BLOCK_RANGE_PAGE_SHIFT = 12;
+  static constexpr u32 BLOCK_RANGE_CHUNK_SHIFT = 22;
+  static constexpr u32 BLOCK_RANGE_PAGES_PER_CHUNK =
+      1u << (BLOCK_RANGE_CHUNK_SHIFT - BLOCK_RANGE_PAGE_SHIFT);
+  static constexpr u32 BLOCK_RANGE_CHUNKS = 1u << (32 - BLOCK_RANGE_CHUNK_SHIFT);
+  using BlockRangeChunk = std::array<std::vector<JitBlock*>, BLOCK_RANGE_PAGES_PER_CHUNK>;
+
+  std::vector<JitBlock*>* GetBlockRangePage(u32 physical_address);
+  std::vector<JitBlock*>& GetOrCreateBlockRangePage(u32 physical_address);
+
+  std::array<std::unique_ptr<BlockRangeChunk>, BLOCK_RANGE_CHUNKS> block_range_map;
+
+  static constexpr size_t MIN_BLOCKS_FOR_EVICTION = 64;
+  static constexpr size_t EVICTION_DIVISOR = 4;
+  u64 m_next_compile_index = 0;
 
   // This bitsets shows which cachelines overlap with any blocks.
   // It is used to provide a fast way to query if no icache invalidation is needed.
@@ -229,4 +289,16 @@ private:
   // in case the shm memory region couldn't be allocated.
   std::array<JitBlock*, FAST_BLOCK_MAP_FALLBACK_ELEMENTS>
       m_fast_block_map_fallback{};  // start_addr & mask -> number
+
+  // Opt-in per-title record of the blocks which have been compiled in earlier sessions. Host code
+  // isn't stored, as emitted code references host addresses which differ between runs, but knowing
+  // which blocks are going to be needed lets us compile them in one go rather than throughout the
+  // first minutes of play.
+  static constexpr size_t PERSISTENT_INDEX_MAX_BLOCKS = 0x40000;
+  bool m_persistent_index_enabled = false;
+  bool m_persistent_index_open = false;
+  std::string m_persistent_index_game_id;
+  Common::LinearDiskCache<JitBlockIndexKey, u32> m_persistent_index_file;
+  std::set<JitBlockIndexKey> m_persistent_index_keys;
+  std::multimap<u32, JitBlockIndexEntry> m_persistent_index_pending;  // effective_address -> entry
 };
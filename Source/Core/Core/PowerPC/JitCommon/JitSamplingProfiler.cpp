@@ -0,0 +1,113 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/PowerPC/JitCommon/JitSamplingProfiler.h"
+
+#include <algorithm>
+#include <map>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "Common/Logging/Log.h"
+#include "Common/Thread.h"
+#include "Core/PowerPC/Gekko.h"
+#include "Core/PowerPC/JitCommon/JitCache.h"
+#include "Core/PowerPC/PPCSymbolDB.h"
+
+JitSamplingProfiler::~JitSamplingProfiler()
+{
+  Stop();
+}
+
+void JitSamplingProfiler::Start(std::chrono::microseconds interval)
+{
+  if (IsRunning())
+    return;
+
+  m_stop_requested.store(false, std::memory_order_relaxed);
+  m_stop_event.Reset();
+  m_timer_thread = std::thread(&JitSamplingProfiler::TimerThread, this, interval);
+  INFO_LOG_FMT(DYNA_REC, "JIT sampling profiler started ({} us interval)", interval.count());
+}
+
+void JitSamplingProfiler::Stop()
+{
+  if (!IsRunning())
+    return;
+
+  m_stop_requested.store(true, std::memory_order_relaxed);
+  m_stop_event.Set();
+  m_timer_thread.join();
+  m_sample_requested.store(false, std::memory_order_relaxed);
+}
+
+void JitSamplingProfiler::Clear()
+{
+  m_samples.clear();
+  m_total_samples = 0;
+}
+
+void JitSamplingProfiler::TimerThread(std::chrono::microseconds interval)
+{
+  Common::SetCurrentThreadName("JIT Sampling Profiler");
+
+  while (!m_stop_requested.load(std::memory_order_relaxed))
+  {
+    if (!m_stop_event.WaitFor(interval))
+      m_sample_requested.store(true, std::memory_order_relaxed);
+  }
+}
+
+void JitSamplingProfiler::TakeSample(u32 pc, u32 feature_flags)
+{
+  m_sample_requested.store(false, std::memory_order_relaxed);
+  ++m_samples[(u64{feature_flags} << 32) | pc];
+  ++m_total_samples;
+}
+
+void JitSamplingProfiler::LogDump(std::FILE* file, JitBaseBlockCache* block_cache,
+                                  PPCSymbolDB& symbol_db) const
+{
+  std::fputs("samples\tpercent\tppcAddress\tppcSize\thostSize\tsymbol\n", file);
+
+  std::vector<std::pair<u64, u64>> sorted(m_samples.begin(), m_samples.end());
+  std::ranges::sort(sorted, std::greater{}, &std::pair<u64, u64>::second);
+
+  const auto percent = [this](u64 count) {
+    return m_total_samples == 0 ? double{} : 100.0 * count / m_total_samples;
+  };
+
+  std::map<std::string_view, u64> symbol_totals;
+  for (const auto& [key, count] : sorted)
+  {
+    const u32 pc = static_cast<u32>(key);
+    const auto feature_flags = static_cast<CPUEmuFeatureFlags>(key >> 32);
+    const Common::Symbol* const symbol = symbol_db.GetSymbolFromAddr(pc);
+    const std::string_view symbol_name = symbol ? std::string_view{symbol->name} : "";
+    symbol_totals[symbol_name] += count;
+
+    const JitBlock* const block =
+        block_cache ? block_cache->GetBlockFromStartAddress(pc, feature_flags) : nullptr;
+    if (block)
+    {
+      fmt::print(file, "{}\t{:.6f}\t{:08x}\t{}\t{}\t\"{}\"\n", count, percent(count), pc,
+                 block->originalSize * sizeof(UGeckoInstruction), block->codeSize, symbol_name);
+    }
+    else
+    {
+      fmt::print(file, "{}\t{:.6f}\t{:08x}\t-\t-\t\"{}\"\n", count, percent(count), pc,
+                 symbol_name);
+    }
+  }
+
+  std::vector<std::pair<std::string_view, u64>> sorted_symbols(symbol_totals.begin(),
+                                                               symbol_totals.end());
+  std::ranges::sort(sorted_symbols, std::greater{}, &std::pair<std::string_view, u64>::second);
+
+  std::fputs("\nsamples\tpercent\tsymbol\n", file);
+  for (const auto& [name, count] : sorted_symbols)
+    fmt::print(file, "{}\t{:.6f}\t\"{}\"\n", count, percent(count), name);
+}
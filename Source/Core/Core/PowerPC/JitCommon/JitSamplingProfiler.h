@@ -0,0 +1,62 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <unordered_map>
+
+#include "Common/CommonTypes.h"
+#include "Common/Event.h"
+
+class JitBaseBlockCache;
+class PPCSymbolDB;
+
+// Statistical profiler for guest code. A host timer thread periodically requests a sample, and the
+// CPU thread takes it the next time it reaches the dispatcher, where ppc_state.pc is exact (linked
+// JIT blocks do not keep it up to date). Unlike JitBlock::ProfileData this adds no code to the
+// blocks themselves, so it can be left running in regular builds.
+class JitSamplingProfiler
+{
+public:
+  JitSamplingProfiler() = default;
+  JitSamplingProfiler(const JitSamplingProfiler&) = delete;
+  JitSamplingProfiler(JitSamplingProfiler&&) = delete;
+  JitSamplingProfiler& operator=(const JitSamplingProfiler&) = delete;
+  JitSamplingProfiler& operator=(JitSamplingProfiler&&) = delete;
+  ~JitSamplingProfiler();
+
+  void Start(std::chrono::microseconds interval);
+  void Stop();
+  bool IsRunning() const { return m_timer_thread.joinable(); }
+
+  // Must only be called on the CPU thread.
+  void OnDispatch(u32 pc, u32 feature_flags)
+  {
+    if (m_sample_requested.load(std::memory_order_relaxed)) [[unlikely]]
+      TakeSample(pc, feature_flags);
+  }
+
+  void Clear();
+  u64 GetSampleCount() const { return m_total_samples; }
+
+  // Writes one line per sampled address, attributed to its JIT block and symbol, followed by the
+  // per-symbol totals. block_cache may be null when no JIT is active.
+  void LogDump(std::FILE* file, JitBaseBlockCache* block_cache, PPCSymbolDB& symbol_db) const;
+
+private:
+  void TakeSample(u32 pc, u32 feature_flags);
+  void TimerThread(std::chrono::microseconds interval);
+
+  std::thread m_timer_thread;
+  Common::Event m_stop_event;
+  std::atomic<bool> m_stop_requested{false};
+  std::atomic<bool> m_sample_requested{false};
+
+  // Keyed by (feature_flags << 32) | pc. Only accessed from the CPU thread.
+  std::unordered_map<u64, u64> m_samples;
+  u64 m_total_samples = 0;
+};
@@ -12,8 +12,13 @@
 #include "Common/Assert.h"
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
 
+#include "Core/Config/MainSettings.h"
+#include "Core/ConfigManager.h"
 #include "Core/Core.h"
 #include "Core/PowerPC/CPUCoreBase.h"
 #include "Core/PowerPC/CachedInterpreter/CachedInterpreter.h"
@@ -73,6 +78,14 @@ CPUCoreBase* JitInterface::InitJitCore(PowerPC::CPUCore core)
     return nullptr;
   }
   m_jit->Init();
+
+  if (Config::Get(Config::MAIN_JIT_SAMPLING_PROFILER) && !m_sampling_profiler.IsRunning())
+  {
+    m_sampling_profiler.Clear();
+    m_sampling_profiler.Start(
+        std::chrono::microseconds(Config::Get(Config::MAIN_JIT_SAMPLING_PROFILER_INTERVAL)));
+  }
+
   return m_jit.get();
 }
 
@@ -83,17 +96,22 @@ CPUCoreBase* JitInterface::GetCore() const
 
 void JitInterface::UpdateMembase()
 {
+  auto& memory = m_system.GetMemory();
   if (!m_jit)
+  {
+    memory.SetCPUWritesUntracked(false);
     return;
+  }
 
   auto& ppc_state = m_system.GetPPCState();
-  auto& memory = m_system.GetMemory();
 #ifdef _M_ARM_64
   // JitArm64 is currently using the no fastmem arena code path even when only fastmem is off.
   const bool fastmem_arena = m_jit->jo.fastmem;
 #else
   const bool fastmem_arena = m_jit->jo.fastmem_arena;
 #endif
+  // Stores through the page mappings can't be caught by write protection.
+  memory.SetCPUWritesUntracked(!fastmem_arena);
   if (ppc_state.msr.DR)
   {
     ppc_state.mem_ptr =
@@ -115,6 +133,13 @@ static std::string_view GetDescription(const CPUEmuFeatureFlags flags)
   return descriptions[flags];
 }
 
+JitInterface::Statistics JitInterface::GetStatistics() const
+{
+  if (!m_jit)
+    return {};
+  return m_jit->GetStatistics();
+}
+
 void JitInterface::JitBlockLogDump(const Core::CPUThreadGuard& guard, std::FILE* file) const
 {
   std::fputs(
@@ -182,6 +207,48 @@ void JitInterface::JitBlockLogDump(const Core::CPUThreadGuard& guard, std::FILE*
   }
 }
 
+void JitInterface::JitSampleLogDump(const Core::CPUThreadGuard&, std::FILE* file) const
+{
+  m_sampling_profiler.LogDump(file, m_jit ? m_jit->GetBlockCache() : nullptr,
+                              m_system.GetPPCSymbolDB());
+}
+
+void JitInterface::FastmemSiteLogDump(const Core::CPUThreadGuard&, std::FILE* file) const
+{
+  std::fputs("ppcAddress\tfaults\tlastFaultTicks\tsymbol\n", file);
+
+  if (!m_jit)
+    return;
+
+  for (const auto& [address, site] : m_jit->GetFastmemSites())
+  {
+    const Common::Symbol* const symbol = m_jit->m_ppc_symbol_db.GetSymbolFromAddr(address);
+    fmt::println(file, "{:08x}\t{}\t{}\t\"{}\"", address, site.faults, site.last_fault_ticks,
+                 symbol ? std::string_view{symbol->name} : "");
+  }
+}
+
+void JitInterface::WriteSamplingProfile() const
+{
+  if (m_sampling_profiler.GetSampleCount() == 0)
+    return;
+
+  const std::string filename =
+      fmt::format("{}{}_samples.txt", File::GetUserPath(D_DUMPDEBUG_JITBLOCKS_IDX),
+                  SConfig::GetInstance().GetGameID());
+  File::IOFile f(filename, "w");
+  if (!f)
+  {
+    ERROR_LOG_FMT(DYNA_REC, "Failed to open \"{}\" for writing the JIT sampling profile",
+                  filename);
+    return;
+  }
+  m_sampling_profiler.LogDump(f.GetHandle(), m_jit ? m_jit->GetBlockCache() : nullptr,
+                              m_system.GetPPCSymbolDB());
+  NOTICE_LOG_FMT(DYNA_REC, "Wrote {} JIT profiler samples to \"{}\"",
+                 m_sampling_profiler.GetSampleCount(), filename);
+}
+
 std::variant<JitInterface::GetHostCodeError, JitInterface::GetHostCodeResult>
 JitInterface::GetHostCode(u32 address) const
 {
@@ -226,6 +293,10 @@ JitInterface::GetHostCode(u32 address) const
 
 bool JitInterface::HandleFault(uintptr_t access_address, SContext* ctx)
 {
+  // Stores to pages watched for texture invalidation just need to be let through.
+  if (m_system.GetMemory().HandleWriteWatchFault(access_address))
+    return true;
+
   // Prevent nullptr dereference on a crash with no JIT present
   if (!m_jit)
   {
@@ -313,6 +384,9 @@ void JitInterface::CompileExceptionCheck(ExceptionType type)
   case ExceptionType::SpeculativeConstants:
     exception_addresses = &m_jit->js.noSpeculativeConstantsAddresses;
     break;
+  case ExceptionType::TierUp:
+    exception_addresses = &m_jit->js.hotBlockAddresses;
+    break;
   }
 
   auto& ppc_state = m_system.GetPPCState();
@@ -343,8 +417,38 @@ void JitInterface::CompileExceptionCheckFromJIT(JitInterface& jit_interface, Exc
   jit_interface.CompileExceptionCheck(type);
 }
 
+void JitInterface::RecordIndirectBranchTarget(u32 branch_address)
+{
+  if (!m_jit)
+    return;
+
+  std::vector<u32>& targets = m_jit->js.indirectBranchTargets[branch_address];
+  const u32 target = m_system.GetPPCState().pc;
+  if (targets.size() >= JitBase::MAX_INDIRECT_BRANCH_TARGETS ||
+      std::ranges::find(targets, target) != targets.end())
+  {
+    return;
+  }
+  targets.push_back(target);
+
+  m_jit->GetBlockCache()->InvalidateICache(branch_address, 4, true);
+}
+
+void JitInterface::RecordIndirectBranchTargetFromJIT(JitInterface& jit_interface,
+                                                     u32 branch_address)
+{
+  jit_interface.RecordIndirectBranchTarget(branch_address);
+}
+
 void JitInterface::Shutdown()
 {
+  if (m_sampling_profiler.IsRunning())
+  {
+    m_sampling_profiler.Stop();
+    WriteSamplingProfile();
+    m_sampling_profiler.Clear();
+  }
+
   if (m_jit)
   {
     m_jit->Shutdown();
@@ -12,6 +12,7 @@
 
 #include "Common/CommonTypes.h"
 #include "Core/MachineContext.h"
+#include "Core/PowerPC/JitCommon/JitSamplingProfiler.h"
 
 class CPUCoreBase;
 class PointerWrap;
@@ -55,8 +56,25 @@ public:
     u32 entry_address;
   };
 
+  // Counted by the JITs since they were created, for benchmarks.
+  struct Statistics
+  {
+    u64 blocks_compiled = 0;
+    u64 compile_time_ns = 0;
+    u64 cache_clears = 0;
+    u64 fastmem_faults = 0;
+    // Memory accesses compiled as slow accesses because they kept faulting with fastmem.
+    u64 slowmem_sites_compiled = 0;
+  };
+  Statistics GetStatistics() const;
+
   void UpdateMembase();
   void JitBlockLogDump(const Core::CPUThreadGuard& guard, std::FILE* file) const;
+  void JitSampleLogDump(const Core::CPUThreadGuard& guard, std::FILE* file) const;
+  void FastmemSiteLogDump(const Core::CPUThreadGuard& guard, std::FILE* file) const;
+
+  // Called by CoreTiming at every slice boundary, where ppc_state.pc is exact.
+  void OnDispatch(u32 pc, u32 feature_flags) { m_sampling_profiler.OnDispatch(pc, feature_flags); }
   std::variant<GetHostCodeError, GetHostCodeResult> GetHostCode(u32 address) const;
 
   // Memory Utilities
@@ -82,17 +100,26 @@ public:
   {
     FIFOWrite,
     PairedQuantize,
-    SpeculativeConstants
+    SpeculativeConstants,
+    TierUp
   };
   void CompileExceptionCheck(ExceptionType type);
   static void CompileExceptionCheckFromJIT(JitInterface& jit_interface, ExceptionType type);
 
+  // Records ppc_state.pc as a destination of the indirect branch at branch_address and recompiles
+  // the block containing it, so that its inline cache jumps to that destination directly.
+  void RecordIndirectBranchTarget(u32 branch_address);
+  static void RecordIndirectBranchTargetFromJIT(JitInterface& jit_interface, u32 branch_address);
+
   /// used for the page fault unit test, don't use outside of tests!
   void SetJit(std::unique_ptr<JitBase> jit);
 
   void Shutdown();
 
 private:
+  void WriteSamplingProfile() const;
+
   std::unique_ptr<JitBase> m_jit;
+  JitSamplingProfiler m_sampling_profiler;
   Core::System& m_system;
 };
@@ -170,6 +170,8 @@ T MMU::ReadFromHardware(u32 em_address)
   }
 
   bool wi = false;
+  bool translated = false;
+  const u32 effective_address = em_address;
 
   if (!never_translate &&
       (IsOpcodeFlag(flag) ? m_ppc_state.msr.IR.Value() : m_ppc_state.msr.DR.Value()))
@@ -183,6 +185,7 @@ T MMU::ReadFromHardware(u32 em_address)
     }
     em_address = translated_addr.address;
     wi = translated_addr.wi;
+    translated = true;
   }
 
   if (flag == XCheckTLBFlag::Read && (em_address & 0xF8000000) == 0x08000000)
@@ -217,6 +220,11 @@ T MMU::ReadFromHardware(u32 em_address)
     if (!m_ppc_state.m_enable_dcache || wi)
     {
       std::memcpy(&value, &m_memory.GetRAM()[em_address], sizeof(T));
+      if (flag == XCheckTLBFlag::Read && translated && !m_ppc_state.m_enable_dcache)
+      {
+        UpdateHostTLBEntry(PowerPC::HOST_TLB_READ_INDEX, effective_address,
+                           &m_memory.GetRAM()[em_address]);
+      }
     }
     else
     {
@@ -236,6 +244,11 @@ T MMU::ReadFromHardware(u32 em_address)
     if (!m_ppc_state.m_enable_dcache || wi)
     {
       std::memcpy(&value, &m_memory.GetEXRAM()[em_address], sizeof(T));
+      if (flag == XCheckTLBFlag::Read && translated && !m_ppc_state.m_enable_dcache)
+      {
+        UpdateHostTLBEntry(PowerPC::HOST_TLB_READ_INDEX, effective_address,
+                           &m_memory.GetEXRAM()[em_address]);
+      }
     }
     else
     {
@@ -289,6 +302,8 @@ void MMU::WriteToHardware(u32 em_address, const u32 data, const u32 size)
   }
 
   bool wi = false;
+  bool translated = false;
+  const u32 effective_address = em_address;
 
   if (!never_translate && m_ppc_state.msr.DR)
   {
@@ -301,6 +316,7 @@ void MMU::WriteToHardware(u32 em_address, const u32 data, const u32 size)
     }
     em_address = translated_addr.address;
     wi = translated_addr.wi;
+    translated = true;
   }
 
   // Check for a gather pipe write (which are not implemented through the MMIO system).
@@ -415,7 +431,18 @@ void MMU::WriteToHardware(u32 em_address, const u32 data, const u32 size)
       m_ppc_state.dCache.Write(m_memory, em_address, &swapped_data, size, HID0(m_ppc_state).DLOCK);
 
     if (!m_ppc_state.m_enable_dcache || wi || flag != XCheckTLBFlag::Write)
+    {
       std::memcpy(&m_memory.GetRAM()[em_address], &swapped_data, size);
+      m_memory.MarkRangeWritten(em_address, size);
+    }
+
+    // Stores through the host TLB would bypass write tracking.
+    if (flag == XCheckTLBFlag::Write && translated && !wi && !m_ppc_state.m_enable_dcache &&
+        !m_memory.IsWriteTrackingEnabled())
+    {
+      UpdateHostTLBEntry(PowerPC::HOST_TLB_WRITE_INDEX, effective_address,
+                         &m_memory.GetRAM()[em_address]);
+    }
 
     return;
   }
@@ -432,7 +459,17 @@ void MMU::WriteToHardware(u32 em_address, const u32 data, const u32 size)
     }
 
     if (!m_ppc_state.m_enable_dcache || wi || flag != XCheckTLBFlag::Write)
+    {
       std::memcpy(&m_memory.GetEXRAM()[em_address], &swapped_data, size);
+      m_memory.MarkRangeWritten(em_address + 0x10000000, size);
+    }
+
+    if (flag == XCheckTLBFlag::Write && translated && !wi && !m_ppc_state.m_enable_dcache &&
+        !m_memory.IsWriteTrackingEnabled())
+    {
+      UpdateHostTLBEntry(PowerPC::HOST_TLB_WRITE_INDEX, effective_address,
+                         &m_memory.GetEXRAM()[em_address]);
+    }
 
     return;
   }
@@ -920,7 +957,7 @@ std::optional<ReadResult<std::string>> MMU::HostTryReadString(const Core::CPUThr
 
 bool MMU::IsOptimizableRAMAddress(const u32 address, const u32 access_size) const
 {
-  if (m_power_pc.GetMemChecks().HasAny())
+  if (m_power_pc.GetMemChecks().OverlapsMemcheck(address, access_size >> 3))
     return false;
 
   if (!m_ppc_state.msr.DR)
@@ -1324,6 +1361,8 @@ void MMU::SDRUpdated()
 
   m_ppc_state.pagetable_base = htaborg << 16;
   m_ppc_state.pagetable_hashmask = ((htabmask << 10) | 0x3ff);
+  m_ppc_state.ResetHostTLB();
+  m_memory.UnmapLogicalPages(0, 0);
 }
 
 enum class TLBLookupResult
@@ -1400,6 +1439,16 @@ static void UpdateTLBEntry(PowerPC::PowerPCState& ppc_state, const XCheckTLBFlag
   const size_t tlb_index = IsOpcodeFlag(flag) ? PowerPC::INST_TLB_INDEX : PowerPC::DATA_TLB_INDEX;
   TLBEntry& tlbe = ppc_state.tlb[tlb_index][tag & HW_PAGE_INDEX_MASK];
   const u32 index = tlbe.recent == 0 && tlbe.tag[0] != TLBEntry::INVALID_TAG;
+
+  // The host TLB must never outlive the entry it was filled from, or its hits would skip the R and
+  // C bit updates of the next page table walk.
+  if (tlb_index == PowerPC::DATA_TLB_INDEX && tlbe.tag[index] != TLBEntry::INVALID_TAG)
+  {
+    const size_t host_index = tlbe.tag[index] & (PowerPC::HOST_TLB_SIZE - 1);
+    for (auto& host_tlb : ppc_state.host_tlb)
+      host_tlb[host_index] = {};
+  }
+
   tlbe.recent = index;
   tlbe.paddr[index] = pte2.RPN << HW_PAGE_INDEX_SHIFT;
   tlbe.pte[index] = pte2.Hex;
@@ -1413,6 +1462,76 @@ void MMU::InvalidateTLBEntry(u32 address)
 
   m_ppc_state.tlb[PowerPC::DATA_TLB_INDEX][entry_index].Invalidate();
   m_ppc_state.tlb[PowerPC::INST_TLB_INDEX][entry_index].Invalidate();
+
+  // tlbie invalidates a whole congruence class, so drop every host TLB entry that maps into it.
+  for (auto& host_tlb : m_ppc_state.host_tlb)
+  {
+    for (size_t i = entry_index; i < PowerPC::HOST_TLB_SIZE; i += HW_PAGE_INDEX_MASK + 1)
+      host_tlb[i] = {};
+  }
+  m_memory.UnmapLogicalPages(entry_index, HW_PAGE_INDEX_MASK);
+}
+
+void MMU::SRUpdated(u32 index)
+{
+  // Segment registers select bits 16-19 of the page index.
+  m_memory.UnmapLogicalPages(index << 16, 0xF0000);
+}
+
+bool MMU::MapPageTableTranslation(uintptr_t access_address)
+{
+  const uintptr_t logical_base = reinterpret_cast<uintptr_t>(m_memory.GetLogicalBase());
+  if (!m_ppc_state.msr.DR || access_address < logical_base ||
+      access_address - logical_base >= 0x1'0000'0000)
+  {
+    return false;
+  }
+
+  // Accesses through the views would bypass the data cache and write tracking.
+  if (m_ppc_state.m_enable_dcache || m_memory.IsWriteTrackingEnabled() ||
+      !m_memory.CanMapLogicalPages())
+  {
+    return false;
+  }
+
+  // BAT translations take priority, and are already in the view if they can be.
+  const u32 address = static_cast<u32>(access_address - logical_base);
+  if (m_dbat_table[address >> BAT_INDEX_SHIFT] & BAT_MAPPED_BIT)
+    return false;
+
+  if (m_power_pc.GetMemChecks().OverlapsMemcheck(address & ~HW_PAGE_MASK, HW_PAGE_SIZE))
+    return false;
+
+  // New views are read-only, so a fault on one that exists is the first store to its page.
+  // Either way, the translation sets the R and C bits the access would have set.
+  const std::optional<bool> writable = m_memory.IsLogicalPageWritable(address);
+  if (writable && *writable)
+    return false;
+
+  bool wi = false;
+  const TranslateAddressResult result =
+      writable ? TranslatePageAddress<XCheckTLBFlag::Write>(EffectiveAddress{address}, &wi) :
+                 TranslatePageAddress<XCheckTLBFlag::Read>(EffectiveAddress{address}, &wi);
+  if (result.result != TranslateAddressResultEnum::PAGE_TABLE_TRANSLATED)
+    return false;
+
+  const u32 physical_address = result.address;
+  const bool is_ram =
+      (physical_address & 0xF8000000) == 0 && physical_address < m_memory.GetRamSizeReal();
+  const bool is_exram = m_memory.GetEXRAM() && (physical_address >> 28) == 0x1 &&
+                        (physical_address & 0x0FFFFFFF) < m_memory.GetExRamSizeReal();
+  if (!is_ram && !is_exram)
+    return false;
+
+  return m_memory.MapLogicalPage(address, physical_address, writable.has_value());
+}
+
+void MMU::UpdateHostTLBEntry(size_t host_tlb_index, u32 effective_address, u8* host_address)
+{
+  const size_t index = (effective_address >> HW_PAGE_INDEX_SHIFT) & (PowerPC::HOST_TLB_SIZE - 1);
+  PowerPC::HostTLBEntry& entry = m_ppc_state.host_tlb[host_tlb_index][index];
+  entry.tag = effective_address & ~HW_PAGE_MASK;
+  entry.host_offset = reinterpret_cast<uintptr_t>(host_address) - effective_address;
 }
 
 // Page Address Translation
@@ -1643,6 +1762,8 @@ void MMU::DBATUpdated()
   m_memory.UpdateLogicalMemory(m_dbat_table);
 #endif
 
+  m_ppc_state.ResetHostTLB();
+
   // IsOptimizable*Address and dcbz depends on the BAT mapping, so we need a flush here.
   m_system.GetJitInterface().ClearSafe();
 }
@@ -1688,52 +1809,91 @@ std::optional<u32> MMU::GetTranslatedAddress(u32 address)
   return std::optional<u32>(result.address);
 }
 
+std::span<u8> MMU::GetHostSpanForPage(u32 address, u32* physical_address_out)
+{
+  // Accesses to RAM go through the data cache when it's emulated.
+  if (m_ppc_state.m_enable_dcache)
+    return {};
+
+  u32 physical_address = address;
+  if (m_ppc_state.msr.DR)
+  {
+    const std::optional<u32> translated = GetTranslatedAddress(address);
+    if (!translated)
+      return {};
+    physical_address = *translated;
+  }
+  if (physical_address_out)
+    *physical_address_out = physical_address;
+
+  const size_t page_left = HW_PAGE_SIZE - (address & HW_PAGE_MASK);
+  if (m_memory.GetRAM() && physical_address < m_memory.GetRamSizeReal())
+    return {m_memory.GetRAM() + physical_address, page_left};
+  if (m_memory.GetEXRAM() && (physical_address >> 28) == 0x1 &&
+      (physical_address & 0x0FFFFFFF) < m_memory.GetExRamSizeReal())
+  {
+    return {m_memory.GetEXRAM() + (physical_address & 0x0FFFFFFF), page_left};
+  }
+  return {};
+}
+
 void ClearDCacheLineFromJit(MMU& mmu, u32 address)
 {
   mmu.ClearDCacheLine(address);
 }
 u32 ReadU8FromJit(MMU& mmu, u32 address)
 {
+  mmu.CountJitSlowAccess();
   return mmu.Read_U8(address);
 }
 u32 ReadU16FromJit(MMU& mmu, u32 address)
 {
+  mmu.CountJitSlowAccess();
   return mmu.Read_U16(address);
 }
 u32 ReadU32FromJit(MMU& mmu, u32 address)
 {
+  mmu.CountJitSlowAccess();
   return mmu.Read_U32(address);
 }
 u64 ReadU64FromJit(MMU& mmu, u32 address)
 {
+  mmu.CountJitSlowAccess();
   return mmu.Read_U64(address);
 }
 void WriteU8FromJit(MMU& mmu, u32 var, u32 address)
 {
+  mmu.CountJitSlowAccess();
   mmu.Write_U8(var, address);
 }
 void WriteU16FromJit(MMU& mmu, u32 var, u32 address)
 {
+  mmu.CountJitSlowAccess();
   mmu.Write_U16(var, address);
 }
 void WriteU32FromJit(MMU& mmu, u32 var, u32 address)
 {
+  mmu.CountJitSlowAccess();
   mmu.Write_U32(var, address);
 }
 void WriteU64FromJit(MMU& mmu, u64 var, u32 address)
 {
+  mmu.CountJitSlowAccess();
   mmu.Write_U64(var, address);
 }
 void WriteU16SwapFromJit(MMU& mmu, u32 var, u32 address)
 {
+  mmu.CountJitSlowAccess();
   mmu.Write_U16_Swap(var, address);
 }
 void WriteU32SwapFromJit(MMU& mmu, u32 var, u32 address)
 {
+  mmu.CountJitSlowAccess();
   mmu.Write_U32_Swap(var, address);
 }
 void WriteU64SwapFromJit(MMU& mmu, u64 var, u32 address)
 {
+  mmu.CountJitSlowAccess();
   mmu.Write_U64_Swap(var, address);
 }
 }  // namespace PowerPC
@@ -6,6 +6,7 @@
 #include <array>
 #include <cstddef>
 #include <optional>
+#include <span>
 #include <string>
 
 #include "Common/BitField.h"
@@ -227,6 +228,11 @@ public:
   void Write_U32_Swap(u32 var, u32 address);
   void Write_U64_Swap(u64 var, u32 address);
 
+  // Loads and stores that JIT code passed to the *FromJit functions below instead of accessing
+  // memory directly, for benchmarks.
+  u64 GetJitSlowAccessCount() const { return m_jit_slow_accesses; }
+  void CountJitSlowAccess() { ++m_jit_slow_accesses; }
+
   void DMA_LCToMemory(u32 mem_address, u32 cache_address, u32 num_blocks);
   void DMA_MemoryToLC(u32 cache_address, u32 mem_address, u32 num_blocks);
 
@@ -241,6 +247,11 @@ public:
   void InvalidateTLBEntry(u32 address);
   void DBATUpdated();
   void IBATUpdated();
+  void SRUpdated(u32 index);
+
+  // Called when a fastmem access to the logical view faults. Maps the page into the view if it's
+  // translated through the page table, in which case the access can simply be retried.
+  bool MapPageTableTranslation(uintptr_t access_address);
 
   // Result changes based on the BAT registers and MSR.DR.  Returns whether
   // it's safe to optimize a read or write to this address to an unguarded
@@ -253,6 +264,10 @@ public:
 
   std::optional<u32> GetTranslatedAddress(u32 address);
 
+  // Returns the host memory that backs the given effective address, up to the end of its page, or
+  // an empty span if accesses to it have to go through the MMU.
+  std::span<u8> GetHostSpanForPage(u32 address, u32* physical_address_out = nullptr);
+
   BatTable& GetIBATTable() { return m_ibat_table; }
   BatTable& GetDBATTable() { return m_dbat_table; }
 
@@ -305,6 +320,8 @@ private:
   void UpdateBATs(BatTable& bat_table, u32 base_spr);
   void UpdateFakeMMUBat(BatTable& bat_table, u32 start_addr);
 
+  void UpdateHostTLBEntry(size_t host_tlb_index, u32 effective_address, u8* host_address);
+
   template <XCheckTLBFlag flag, typename T, bool never_translate = false>
   T ReadFromHardware(u32 em_address);
   template <XCheckTLBFlag flag, bool never_translate = false>
@@ -326,6 +343,8 @@ private:
 
   BatTable m_ibat_table;
   BatTable m_dbat_table;
+
+  u64 m_jit_slow_accesses = 0;
 };
 
 void ClearDCacheLineFromJit(MMU& mmu, u32 address);
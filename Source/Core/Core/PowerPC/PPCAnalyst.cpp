@@ -46,6 +46,9 @@ constexpr u32 BRANCH_FOLLOWING_THRESHOLD = 2;
 
 constexpr u32 INVALID_BRANCH_TARGET = 0xFFFFFFFF;
 
+// How many instructions of a block's successor are scanned for registers it overwrites.
+constexpr u32 CROSS_BLOCK_LIVENESS_SCAN_LENGTH = 16;
+
 static u32 EvaluateBranchTarget(UGeckoInstruction instr, u32 pc)
 {
   switch (instr.OPCD)
@@ -569,6 +572,77 @@ void PPCAnalyzer::ReorderInstructions(u32 instructions, CodeOp* code) const
     ReorderInstructionsCore(instructions, code, true, ReorderType::CROR);
 }
 
+void PPCAnalyzer::FindRegistersDeadOnExit(CodeBlock* block, u32 successor) const
+{
+  auto& system = Core::System::GetInstance();
+  auto& mmu = system.GetMMU();
+  auto& power_pc = system.GetPowerPC();
+  auto& ppc_symbol_db = power_pc.GetSymbolDB();
+  const auto ppc_mode = power_pc.GetMode();
+
+  // The FPU is known to be enabled at the exit if this block already used it.
+  BlockStats stats{};
+  BlockRegStats gpa{true};
+  BlockRegStats fpa{block->m_fpa->any};
+  CodeBlock successor_block;
+  successor_block.m_stats = &stats;
+  successor_block.m_gpa = &gpa;
+  successor_block.m_fpa = &fpa;
+
+  BitSet32 gpr_read, fpr_read, gpr_dead, fpr_dead;
+  BitSet8 cr_read, cr_dead;
+  bool fprf_read = false, fprf_dead = false, ca_read = false, ca_dead = false;
+  u32 address = successor;
+  for (u32 i = 0; i < CROSS_BLOCK_LIVENESS_SCAN_LENGTH; ++i, address += 4)
+  {
+    if (HLE::TryReplaceFunction(ppc_symbol_db, address, ppc_mode) ||
+        power_pc.GetBreakPoints().IsAddressBreakPoint(address))
+    {
+      break;
+    }
+
+    const auto result = mmu.TryReadInstruction(address);
+    if (!result.valid)
+      break;
+
+    CodeOp op;
+    op.inst = result.hex;
+    op.opinfo = PPCTables::GetOpInfo(op.inst, address);
+    op.address = address;
+    SetInstructionStats(&successor_block, &op, op.opinfo);
+
+    // The block now depends on this code too, so that it gets invalidated along with it.
+    block->m_physical_addresses.insert(result.physical_address);
+
+    gpr_read |= op.regsIn;
+    fpr_read |= op.fregsIn;
+    cr_read |= op.crIn;
+    fprf_read |= op.wantsFPRF;
+    ca_read |= op.wantsCA;
+
+    // Like the discard analysis within a block, stop at anything that could observe the registers
+    // before they are overwritten.
+    if (op.canEndBlock || op.canCauseException)
+      break;
+
+    gpr_dead |= op.regsOut & ~gpr_read;
+    fpr_dead |= op.GetFregsOut() & ~fpr_read;
+    cr_dead |= op.crOut & ~cr_read;
+    fprf_dead |= op.outputFPRF && !fprf_read;
+    ca_dead |= op.outputCA && !ca_read;
+  }
+
+  if (gpr_dead || fpr_dead || cr_dead)
+  {
+    block->m_dead_on_exit_address = successor;
+    block->m_gpr_dead_on_exit = gpr_dead;
+    block->m_fpr_dead_on_exit = fpr_dead;
+    block->m_cr_dead_on_exit = cr_dead;
+  }
+  block->m_fprf_dead_on_exit = fprf_dead;
+  block->m_ca_dead_on_exit = ca_dead;
+}
+
 void PPCAnalyzer::SetInstructionStats(CodeBlock* block, CodeOp* code,
                                       const GekkoOPInfo* opinfo) const
 {
@@ -731,57 +805,93 @@ void PPCAnalyzer::SetInstructionStats(CodeBlock* block, CodeOp* code,
   }
 }
 
-bool PPCAnalyzer::IsBusyWaitLoop(CodeBlock* block, CodeOp* code, size_t instructions) const
+// Instructions that can appear in a busy wait loop. Apart from writing registers they must not
+// have any effect, so that skipping ahead to the next event is indistinguishable from spinning.
+static bool CanAppearInBusyWaitLoop(const CodeOp& op)
 {
-  // Very basic algorithm to detect busy wait loops:
-  //   * It loops to itself and does not contain any other branches.
-  //   * It does not write to memory.
-  //   * It only reads from registers it wrote to earlier in the loop, or it
-  //     does not write to these registers.
-  //
-  // Would benefit a lot from basic inlining support - a lot of the most
-  // used busy loops are DSP register interactions, which are bl/cmp/bne
-  // (with the bl target a pure function that follows the above rules). We
-  // don't detect these at the moment.
-  std::bitset<32> write_disallowed_regs;
-  std::bitset<32> written_regs;
-  for (size_t i = 0; i <= instructions; ++i)
+  switch (op.opinfo->type)
+  {
+  case OpType::Integer:
+  case OpType::Load:
+  case OpType::CR:
+    return true;
+  case OpType::System:
+    // mcrf, mfcr and mftb only copy the condition register or the time base into a register.
+    return (op.inst.OPCD == 19 && op.inst.SUBOP10 == 0) ||
+           (op.inst.OPCD == 31 && (op.inst.SUBOP10 == 19 || op.inst.SUBOP10 == 371));
+  case OpType::SPR:
+  {
+    // mfspr of the time base or the decrementer, as used by OSGetTime and friends.
+    if (op.inst.OPCD != 31 || op.inst.SUBOP10 != 339)
+      return false;
+    const u32 index = (op.inst.SPRU << 5) | (op.inst.SPRL & 0x1F);
+    return index == SPR_TL || index == SPR_TU || index == SPR_DEC;
+  }
+  default:
+    return false;
+  }
+}
+
+bool PPCAnalyzer::IsBusyWaitLoop(CodeOp* code, size_t instructions) const
+{
+  // Detects busy wait loops, i.e. loops that poll memory (usually a flag or a hardware register
+  // such as the DSP mailbox or the VI beam position) or the time base until it changes:
+  //   * It branches back to an earlier instruction of the block, which need not be the first one.
+  //     Together with branch following this also catches loops spanning two PPC basic blocks,
+  //     and loops calling a small leaf function that reads the polled value.
+  //   * It does not branch through CTR.
+  //   * It only contains instructions without side effects (see CanAppearInBusyWaitLoop).
+  //   * It only reads registers and CR fields it wrote to earlier in the loop, or it does not
+  //     write to them. Otherwise every iteration would compute something different.
+  const CodeOp& branch = code[instructions];
+  if (branch.opinfo->type != OpType::Branch || branch.branchUsesCtr ||
+      branch.branchTo == UINT32_MAX)
+  {
+    return false;
+  }
+
+  size_t loop_start = instructions + 1;
+  for (size_t i = instructions + 1; i-- > 0;)
+  {
+    if (code[i].address == branch.branchTo)
+    {
+      loop_start = i;
+      break;
+    }
+  }
+  if (loop_start > instructions)
+    return false;
+
+  BitSet32 write_disallowed_regs;
+  BitSet32 written_regs;
+  BitSet8 write_disallowed_crs;
+  BitSet8 written_crs;
+  for (size_t i = loop_start; i <= instructions; ++i)
   {
-    if (code[i].opinfo->type == OpType::Branch)
+    const CodeOp& op = code[i];
+    if (op.opinfo->type == OpType::Branch)
     {
-      if (code[i].branchUsesCtr)
+      if (op.branchUsesCtr)
         return false;
-      if (code[i].branchTo == block->m_address && i == instructions)
-        return true;
     }
-    else if (code[i].opinfo->type != OpType::Integer && code[i].opinfo->type != OpType::Load)
+    else if (!CanAppearInBusyWaitLoop(op))
     {
-      // In the future, some subsets of other instruction types might get
-      // supported. Right now, only try loops that have this very
-      // restricted instruction set.
       return false;
     }
     else
     {
-      for (int reg : code[i].regsIn)
-      {
-        if (reg == -1)
-          continue;
-        if (written_regs[reg])
-          continue;
-        write_disallowed_regs[reg] = true;
-      }
-      for (int reg : code[i].regsOut)
-      {
-        if (reg == -1)
-          continue;
-        if (write_disallowed_regs[reg])
-          return false;
-        written_regs[reg] = true;
-      }
+      write_disallowed_regs |= op.regsIn & ~written_regs;
+      if (op.regsOut & write_disallowed_regs)
+        return false;
+      written_regs |= op.regsOut;
     }
+
+    write_disallowed_crs |= op.crIn & ~written_crs;
+    if (op.crOut & write_disallowed_crs)
+      return false;
+    written_crs |= op.crOut;
   }
-  return false;
+  return true;
 }
 
 static bool CanCauseGatherPipeInterruptCheck(const CodeOp& op)
@@ -813,6 +923,12 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer,
   block->m_num_instructions = 0;
   block->m_gqr_used = BitSet8(0);
   block->m_physical_addresses.clear();
+  block->m_dead_on_exit_address = UINT32_MAX;
+  block->m_gpr_dead_on_exit = BitSet32{};
+  block->m_fpr_dead_on_exit = BitSet32{};
+  block->m_cr_dead_on_exit = BitSet8{};
+  block->m_fprf_dead_on_exit = false;
+  block->m_ca_dead_on_exit = false;
 
   CodeOp* const code = buffer->data();
 
@@ -942,8 +1058,7 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer,
       }
     }
 
-    code[i].branchIsIdleLoop =
-        code[i].branchTo == block->m_address && IsBusyWaitLoop(block, code, i);
+    code[i].branchIsIdleLoop = IsBusyWaitLoop(code, i);
 
     if (follow && numFollows < BRANCH_FOLLOWING_THRESHOLD)
     {
@@ -974,6 +1089,17 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer,
   if (block->m_num_instructions > 1)
     ReorderInstructions(block->m_num_instructions, code);
 
+  if (m_enable_cross_block_liveness && !m_is_debugging_enabled && num_inst > 0)
+  {
+    // Only the final exit of the block is considered. An unconditional branch always leaves to its
+    // target, and a block that didn't end on a branch falls through to the next instruction.
+    const CodeOp& last_op = code[num_inst - 1];
+    if (last_op.inst.OPCD == 18 && !last_op.branchIsIdleLoop)
+      FindRegistersDeadOnExit(block, last_op.branchTo);
+    else if (!found_exit)
+      FindRegistersDeadOnExit(block, address);
+  }
+
   if ((!found_exit && num_inst > 0) || block_size == 1)
   {
     // We couldn't find an exit
@@ -983,9 +1109,10 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer,
   auto& power_pc = system.GetPowerPC();
   auto& ppc_symbol_db = power_pc.GetSymbolDB();
   // Scan for flag dependencies; assume the next block (or any branch that can leave the block)
-  // wants flags, to be safe.
-  bool wantsFPRF = true;
-  bool wantsCA = true;
+  // wants flags, to be safe, unless the code the block ends in is known to overwrite them first.
+  // Flags are then only computed by the instruction whose result actually gets read.
+  bool wantsFPRF = !block->m_fprf_dead_on_exit;
+  bool wantsCA = !block->m_ca_dead_on_exit;
   BitSet8 crInUse, crDiscardable;
   BitSet32 gprBlockInputs, gprInUse, fprInUse, gprDiscardable, fprDiscardable, fprInXmm;
   for (int i = block->m_num_instructions - 1; i >= 0; i--)
@@ -1151,6 +1278,7 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer,
   }
   block->m_gqr_used = gqrUsed;
   block->m_gqr_modified = gqrModified;
+  block->m_gqr_static = gqrUsed & ~gqrModified;
   block->m_gpr_inputs = gprBlockInputs;
   return address;
 }
@@ -125,11 +125,27 @@ struct CodeBlock
   // Which GQRs this block modifies, if any.
   BitSet8 m_gqr_modified;
 
+  // Which GQRs this block uses without modifying them. The JITs specialize quantized loads and
+  // stores on the current values of these, guarded by a check at the start of the block.
+  BitSet8 m_gqr_static;
+
   // Which GPRs this block reads from before defining, if any.
   BitSet32 m_gpr_inputs;
 
   // Which memory locations are occupied by this block.
   std::set<u32> m_physical_addresses;
+
+  // If m_dead_on_exit_address isn't UINT32_MAX, the code there overwrites these registers before
+  // reading them, so the final exit to that address doesn't have to write them back.
+  u32 m_dead_on_exit_address = UINT32_MAX;
+  BitSet32 m_gpr_dead_on_exit;
+  BitSet32 m_fpr_dead_on_exit;
+  BitSet8 m_cr_dead_on_exit;
+
+  // Whether the code after the final exit overwrites FPRF/CA before reading them, in which case
+  // the last instructions producing them don't have to compute them.
+  bool m_fprf_dead_on_exit = false;
+  bool m_ca_dead_on_exit = false;
 };
 
 class PPCAnalyzer
@@ -181,6 +197,7 @@ public:
   void SetBranchFollowingEnabled(bool enabled) { m_enable_branch_following = enabled; }
   void SetFloatExceptionsEnabled(bool enabled) { m_enable_float_exceptions = enabled; }
   void SetDivByZeroExceptionsEnabled(bool enabled) { m_enable_div_by_zero_exceptions = enabled; }
+  void SetCrossBlockLivenessEnabled(bool enabled) { m_enable_cross_block_liveness = enabled; }
   u32 Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer, std::size_t block_size) const;
 
 private:
@@ -196,7 +213,8 @@ private:
                                ReorderType type) const;
   void ReorderInstructions(u32 instructions, CodeOp* code) const;
   void SetInstructionStats(CodeBlock* block, CodeOp* code, const GekkoOPInfo* opinfo) const;
-  bool IsBusyWaitLoop(CodeBlock* block, CodeOp* code, size_t instructions) const;
+  bool IsBusyWaitLoop(CodeOp* code, size_t instructions) const;
+  void FindRegistersDeadOnExit(CodeBlock* block, u32 successor) const;
 
   // Options
   u32 m_options = 0;
@@ -205,6 +223,7 @@ private:
   bool m_enable_branch_following = false;
   bool m_enable_float_exceptions = false;
   bool m_enable_div_by_zero_exceptions = false;
+  bool m_enable_cross_block_liveness = false;
 };
 
 void FindFunctions(const Core::CPUThreadGuard& guard, u32 startAddr, u32 endAddr,
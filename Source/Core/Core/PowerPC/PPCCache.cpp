@@ -97,6 +97,7 @@ InstructionCache::~InstructionCache()
 
 void Cache::Reset()
 {
+  ++epoch;
   valid.fill(0);
   plru.fill(0);
   modified.fill(0);
@@ -172,6 +173,7 @@ void Cache::Invalidate(Memory::MemoryManager& memory, u32 addr)
     else
       lookup_table[(addrs[set][way] & memory.GetRamMask()) >> 5] = 0xff;
 
+    ++epoch;
     valid[set] &= ~(1U << way);
     modified[set] &= ~(1U << way);
   }
@@ -196,6 +198,7 @@ void Cache::Flush(Memory::MemoryManager& memory, u32 addr)
     else
       lookup_table[(addrs[set][way] & memory.GetRamMask()) >> 5] = 0xff;
 
+    ++epoch;
     valid[set] &= ~(1U << way);
     modified[set] &= ~(1U << way);
   }
@@ -249,6 +252,7 @@ std::pair<u32, u32> Cache::GetCache(Memory::MemoryManager& memory, u32 addr, boo
     }
 
     // load
+    ++epoch;
     memory.CopyFromEmu(data[set][way].data(), (addr & ~0x1f), 32);
 
     if (addr & CACHE_VMEM_BIT)
@@ -356,6 +360,8 @@ void Cache::DoState(Memory::MemoryManager& memory, PointerWrap& p)
 
   if (p.IsReadMode())
   {
+    ++epoch;
+
     // Recompute lookup tables
     for (u32 set = 0; set < CACHE_SETS; set++)
     {
@@ -381,9 +387,24 @@ u32 InstructionCache::ReadInstruction(Memory::MemoryManager& memory,
   if (!HID0(ppc_state).ICE || m_disable_icache)  // instruction cache is disabled
     return memory.Read_U32(addr);
 
-  u32 value;
-  Read(memory, addr, &value, sizeof(value), HID0(ppc_state).ILOCK);
-  return Common::swap32(value);
+  const u32 block = addr & ~31;
+  if (block != m_last_fetch_block || epoch != m_last_fetch_epoch)
+  {
+    const auto [set, way] = GetCache(memory, addr, HID0(ppc_state).ILOCK);
+    if (way == 0xff)
+    {
+      u32 value;
+      memory.CopyFromEmu(&value, addr, sizeof(value));
+      return Common::swap32(value);
+    }
+
+    m_last_fetch_block = block;
+    m_last_fetch_set = set;
+    m_last_fetch_way = way;
+    m_last_fetch_epoch = epoch;
+  }
+
+  return Common::swap32(data[m_last_fetch_set][m_last_fetch_way][(addr >> 2) & 7]);
 }
 
 void InstructionCache::Invalidate(Memory::MemoryManager& memory, JitInterface& jit_interface,
@@ -410,6 +431,7 @@ void InstructionCache::Invalidate(Memory::MemoryManager& memory, JitInterface& j
   }
   valid[set] = 0;
   modified[set] = 0;
+  ++epoch;
 
   // Also tell the JIT that the corresponding address has been invalidated
   jit_interface.InvalidateICacheLine(addr);
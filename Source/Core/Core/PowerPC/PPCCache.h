@@ -51,6 +51,10 @@ struct Cache
   std::vector<u8> lookup_table_ex{};
   std::vector<u8> lookup_table_vmem{};
 
+  // Incremented whenever a block is loaded, evicted or invalidated, so that callers can remember
+  // where an address was found and skip the lookup while nothing has changed.
+  u32 epoch = 0;
+
   void Store(Memory::MemoryManager& memory, u32 addr);
   void Invalidate(Memory::MemoryManager& memory, u32 addr);
   void Flush(Memory::MemoryManager& memory, u32 addr);
@@ -75,6 +79,14 @@ struct InstructionCache : public Cache
 
   bool m_disable_icache = false;
 
+  // The block that the last instruction fetch hit. Fetches usually stay in the same block for
+  // several instructions, and those are read straight from it while the epoch is unchanged. That
+  // is exact, as repeating the PLRU update of a hit doesn't change it.
+  u32 m_last_fetch_block = UINT32_MAX;
+  u32 m_last_fetch_set = 0;
+  u32 m_last_fetch_way = 0;
+  u32 m_last_fetch_epoch = 0;
+
   InstructionCache() = default;
   ~InstructionCache();
   u32 ReadInstruction(Memory::MemoryManager& memory, PowerPC::PowerPCState& ppc_state, u32 addr);
@@ -4,8 +4,12 @@
 #include "Core/PowerPC/PPCSymbolDB.h"
 
 #include <algorithm>
+#include <array>
 #include <cstring>
 #include <map>
+#include <mutex>
+#include <optional>
+#include <span>
 #include <sstream>
 #include <string>
 #include <string_view>
@@ -14,18 +18,88 @@
 
 #include <fmt/format.h>
 
+#include "Common/CommonPaths.h"
 #include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/Hash.h"
 #include "Common/IOFile.h"
 #include "Common/Logging/Log.h"
 #include "Common/StringUtil.h"
+#include "Core/ConfigManager.h"
 #include "Core/Core.h"
 #include "Core/Debugger/DebugInterface.h"
+#include "Core/HW/Memmap.h"
 #include "Core/PowerPC/MMU.h"
 #include "Core/PowerPC/PPCAnalyst.h"
 #include "Core/PowerPC/PowerPC.h"
 #include "Core/PowerPC/SignatureDB/SignatureDB.h"
 #include "Core/System.h"
 
+namespace
+{
+// The physical memory that the functions of a symbol map cover, in MEM1 and EXRAM.
+struct CodeRange
+{
+  u32 start = 0;
+  u32 end = 0;
+  u32 crc = 0;
+
+  bool operator==(const CodeRange&) const = default;
+};
+using CodeRanges = std::array<CodeRange, 2>;
+
+struct CachedMap
+{
+  std::string path;
+  u32 file_crc = 0;
+  CodeRanges code;
+  Common::SymbolDB::XFuncMap symbols;
+};
+
+std::mutex s_map_cache_mutex;
+std::optional<CachedMap> s_map_cache;
+
+std::optional<CodeRanges> GetCodeRanges(Core::System& system,
+                                        const Common::SymbolDB::XFuncMap& symbols)
+{
+  auto& memory = system.GetMemory();
+  CodeRanges ranges;
+  for (const auto& [address, symbol] : symbols)
+  {
+    if (symbol.type != Common::Symbol::Type::Function)
+      continue;
+
+    // Functions are expected to be in the usual BAT mappings. Maps with others aren't cached.
+    const u32 physical = address & 0x3FFFFFFF;
+    const u32 end = physical + std::max<u32>(symbol.size, 4);
+    size_t region;
+    if (end <= memory.GetRamSizeReal())
+      region = 0;
+    else if (memory.GetEXRAM() && physical >= 0x10000000 &&
+             end <= 0x10000000 + memory.GetExRamSizeReal())
+      region = 1;
+    else
+      return std::nullopt;
+
+    CodeRange& range = ranges[region];
+    if (range.start == range.end)
+      range = {physical, end};
+    range.start = std::min(range.start, physical);
+    range.end = std::max(range.end, end);
+  }
+
+  for (CodeRange& range : ranges)
+  {
+    if (range.start != range.end)
+    {
+      range.crc = Common::ComputeCRC32(memory.GetSpanForAddress(range.start).data(),
+                                       range.end - range.start);
+    }
+  }
+  return ranges;
+}
+}  // namespace
+
 PPCSymbolDB::PPCSymbolDB() = default;
 
 PPCSymbolDB::~PPCSymbolDB() = default;
@@ -217,6 +291,44 @@ void PPCSymbolDB::LogFunctionCall(u32 addr)
 // https://forums.oculus.com/viewtopic.php?f=42&t=11241&start=580
 // https://m2k2.taigaforum.com/post/metroid_prime_hacking_help_25.html#metroid_prime_hacking_help_25
 
+bool PPCSymbolDB::GenerateFromSignatureDB(const Core::CPUThreadGuard& guard, u32 start_addr,
+                                          u32 end_addr, const std::string& db_path)
+{
+  std::string db_contents;
+  const bool db_found = File::ReadFileToString(db_path, db_contents);
+
+  // Finding the functions takes far longer than hashing the memory that's searched, so the
+  // generated map is kept, keyed by everything that went into it.
+  std::string cache_path;
+  const std::span<u8> memory = guard.GetSystem().GetMemory().GetSpanForAddress(start_addr);
+  if (db_found && IsEmpty() && end_addr > start_addr && memory.size() >= end_addr - start_addr)
+  {
+    cache_path = fmt::format("{}SymbolMaps" DIR_SEP "{}_{:08x}_{:08x}{:08x}.map",
+                             File::GetUserPath(D_CACHE_IDX),
+                             SConfig::GetInstance().m_debugger_game_id, start_addr,
+                             Common::ComputeCRC32(memory.data(), end_addr - start_addr),
+                             Common::ComputeCRC32(db_contents));
+    if (File::Exists(cache_path) && LoadMap(guard, cache_path))
+    {
+      INFO_LOG_FMT(SYMBOLS, "Loaded the generated symbols from {}", cache_path);
+      return true;
+    }
+  }
+
+  PPCAnalyst::FindFunctions(guard, start_addr, end_addr, this);
+  if (!db_found)
+    return false;
+
+  SignatureDB db(SignatureDB::HandlerType::DSY);
+  if (!db.Load(db_path))
+    return false;
+  db.Apply(guard, this);
+
+  if (!cache_path.empty() && File::CreateFullPath(cache_path))
+    SaveSymbolMap(cache_path);
+  return true;
+}
+
 // This one can load both leftover map files on game discs (like Zelda), and mapfiles
 // produced by SaveSymbolMap below.
 // bad=true means carefully load map files that might not be from exactly the right version
@@ -226,6 +338,18 @@ bool PPCSymbolDB::LoadMap(const Core::CPUThreadGuard& guard, const std::string&
   if (!f)
     return false;
 
+  // Analyzing every function takes most of the time it takes to load a map. That happens on every
+  // boot of a title, so the result is kept for as long as neither the map nor the code changes.
+  std::optional<u32> file_crc;
+  if (!bad && IsEmpty())
+  {
+    std::string contents;
+    if (File::ReadFileToString(filename, contents))
+      file_crc = Common::ComputeCRC32(contents);
+    if (file_crc && LoadCachedMap(guard, filename, *file_crc))
+      return true;
+  }
+
   // Two columns are used by Super Smash Bros. Brawl Korean map file
   // Three columns are commonly used
   // Four columns are used in American Mensa Academy map files and perhaps other games
@@ -446,6 +570,35 @@ bool PPCSymbolDB::LoadMap(const Core::CPUThreadGuard& guard, const std::string&
 
   Index();
   NOTICE_LOG_FMT(SYMBOLS, "{} symbols loaded, {} symbols ignored.", good_count, bad_count);
+
+  if (file_crc)
+  {
+    if (std::optional<CodeRanges> code = GetCodeRanges(guard.GetSystem(), m_functions))
+    {
+      std::lock_guard lk(s_map_cache_mutex);
+      s_map_cache = CachedMap{filename, *file_crc, *code, m_functions};
+    }
+  }
+  return true;
+}
+
+bool PPCSymbolDB::LoadCachedMap(const Core::CPUThreadGuard& guard, const std::string& filename,
+                                u32 file_crc)
+{
+  std::lock_guard lk(s_map_cache_mutex);
+  if (!s_map_cache || s_map_cache->path != filename || s_map_cache->file_crc != file_crc ||
+      GetCodeRanges(guard.GetSystem(), s_map_cache->symbols) != s_map_cache->code)
+  {
+    return false;
+  }
+
+  m_functions = s_map_cache->symbols;
+  for (auto& [address, symbol] : m_functions)
+  {
+    if (symbol.type == Common::Symbol::Type::Function)
+      m_checksum_to_function[symbol.hash].insert(&symbol);
+  }
+  NOTICE_LOG_FMT(SYMBOLS, "{} symbols loaded from the cached {}", m_functions.size(), filename);
   return true;
 }
 
@@ -33,10 +33,19 @@ public:
   void FillInCallers();
 
   bool LoadMap(const Core::CPUThreadGuard& guard, const std::string& filename, bool bad = false);
+  // Scans [start_addr, end_addr) for functions and names the ones the DSY signature database at
+  // db_path knows, returning false if it couldn't be loaded. If there are no symbols yet, the
+  // result is cached by a hash of the scanned memory and the database, and loaded from the cache
+  // instead when neither has changed.
+  bool GenerateFromSignatureDB(const Core::CPUThreadGuard& guard, u32 start_addr, u32 end_addr,
+                               const std::string& db_path);
   bool SaveSymbolMap(const std::string& filename) const;
   bool SaveCodeMap(const Core::CPUThreadGuard& guard, const std::string& filename) const;
 
   void PrintCalls(u32 funcAddr) const;
   void PrintCallers(u32 funcAddr) const;
   void LogFunctionCall(u32 addr);
+
+private:
+  bool LoadCachedMap(const Core::CPUThreadGuard& guard, const std::string& filename, u32 file_crc);
 };
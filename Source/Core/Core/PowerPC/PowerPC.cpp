@@ -280,6 +280,7 @@ void PowerPCManager::Reset()
   m_ppc_state.pagetable_base = 0;
   m_ppc_state.pagetable_hashmask = 0;
   m_ppc_state.tlb = {};
+  m_ppc_state.ResetHostTLB();
 
   ResetRegisters();
   m_ppc_state.iCache.Reset(m_system.GetJitInterface());
@@ -660,6 +661,7 @@ void PowerPCState::SetSR(u32 index, u32 value)
 {
   DEBUG_LOG_FMT(POWERPC, "{:08x}: MMU: Segment register {} set to {:08x}", pc, index, value);
   sr[index] = value;
+  ResetHostTLB();
 }
 
 // FPSCR update functions
@@ -68,6 +68,39 @@ struct TLBEntry
   void Invalidate() { tag.fill(INVALID_TAG); }
 };
 
+// Host-side software TLB, probed inline by the JITs' slow-path loads and stores before they fall
+// back to the C++ MMU. It is direct-mapped by effective page and holds only translations to RAM
+// and EXRAM, so a hit can be turned into a host pointer without any further checks.
+constexpr size_t HOST_TLB_SIZE = 256;
+constexpr size_t NUM_HOST_TLBS = 2;
+constexpr size_t HOST_TLB_READ_INDEX = 0;
+constexpr size_t HOST_TLB_WRITE_INDEX = 1;
+static_assert((HOST_TLB_SIZE & (HOST_TLB_SIZE - 1)) == 0, "The JITs mask the host TLB index");
+
+struct HostTLBEntry
+{
+  // The low bits are set, so this never matches a page-aligned effective address.
+  static constexpr u32 INVALID_TAG = 0xffffffff;
+
+  u32 tag = INVALID_TAG;
+  // Host address of the page minus its effective address.
+  u64 host_offset = 0;
+};
+static_assert(sizeof(HostTLBEntry) == 16, "JIT code indexes the host TLB with a shift");
+
+// An entry of the return address predictor the JITs use for blr when the BLR optimization is
+// disabled. guest_address holds the feature flags in its upper 32 bits, like the BLR optimization's
+// host stack entries, so that an empty entry can never match.
+struct ReturnStackEntry
+{
+  u64 guest_address = ~u64(0);
+  const u8* host_address = nullptr;
+};
+static_assert(sizeof(ReturnStackEntry) == 16, "JIT code indexes the return stack with a shift");
+
+constexpr size_t RETURN_STACK_SIZE = 16;
+static_assert((RETURN_STACK_SIZE & (RETURN_STACK_SIZE - 1)) == 0);
+
 struct PairedSingle
 {
   u64 PS0AsU64() const { return ps0; }
@@ -175,8 +208,15 @@ struct PowerPCState
   u8* stored_stack_pointer = nullptr;
   u8* mem_ptr = nullptr;
 
+  // Return address predictor, pushed by bl and checked by blr. return_stack_index is the top.
+  std::array<ReturnStackEntry, RETURN_STACK_SIZE> return_stack{};
+  u32 return_stack_index = 0;
+
   std::array<std::array<TLBEntry, TLB_SIZE / TLB_WAYS>, NUM_TLBS> tlb;
 
+  // Not saved in savestates; everything that can change a translation flushes it.
+  std::array<std::array<HostTLBEntry, HOST_TLB_SIZE>, NUM_HOST_TLBS> host_tlb;
+
   u32 pagetable_base = 0;
   u32 pagetable_hashmask = 0;
 
@@ -188,6 +228,14 @@ struct PowerPCState
   bool reserve;
   u32 reserve_address;
 
+  void ResetReturnStack()
+  {
+    return_stack.fill({});
+    return_stack_index = 0;
+  }
+
+  void ResetHostTLB() { host_tlb = {}; }
+
   void UpdateCR1()
   {
     cr.SetField(1, (fpscr.FX << 3) | (fpscr.FEX << 2) | (fpscr.VX << 1) | fpscr.OX);
@@ -3,10 +3,13 @@
 
 #include "Core/PowerPC/SignatureDB/MEGASignatureDB.h"
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdlib>
 #include <fstream>
+#include <future>
 #include <limits>
+#include <span>
 #include <sstream>
 #include <string>
 #include <utility>
@@ -14,6 +17,7 @@
 #include "Common/FileUtil.h"
 #include "Common/Logging/Log.h"
 #include "Common/StringUtil.h"
+#include "Common/TaskScheduler.h"
 
 #include "Core/PowerPC/MMU.h"
 #include "Core/PowerPC/PPCSymbolDB.h"
@@ -101,21 +105,18 @@ bool GetRefs(MEGASignature* sig, std::istringstream* iss)
   return true;
 }
 
-bool Compare(const Core::CPUThreadGuard& guard, u32 address, u32 size, const MEGASignature& sig)
+bool Compare(std::span<const u32> code, const MEGASignature& sig)
 {
-  if (size != sig.code.size() * sizeof(u32))
-    return false;
-
   for (size_t i = 0; i < sig.code.size(); ++i)
   {
-    if (sig.code[i] != 0 && PowerPC::MMU::HostRead_U32(
-                                guard, static_cast<u32>(address + i * sizeof(u32))) != sig.code[i])
-    {
+    if (sig.code[i] != 0 && code[i] != sig.code[i])
       return false;
-    }
   }
   return true;
 }
+
+// Symbols are compared in batches of this many on the task scheduler's workers.
+constexpr size_t SYMBOLS_PER_TASK = 256;
 }  // Anonymous namespace
 
 MEGASignatureDB::MEGASignatureDB() = default;
@@ -124,6 +125,12 @@ MEGASignatureDB::~MEGASignatureDB() = default;
 void MEGASignatureDB::Clear()
 {
   m_signatures.clear();
+  m_index.clear();
+}
+
+u64 MEGASignatureDB::GetIndexKey(size_t word_count, u32 first_word)
+{
+  return (static_cast<u64>(word_count) << 32) | first_word;
 }
 
 bool MEGASignatureDB::Load(const std::string& file_path)
@@ -142,6 +149,8 @@ bool MEGASignatureDB::Load(const std::string& file_path)
 
     if (GetCode(&sig, &iss) && GetName(&sig, &iss) && GetRefs(&sig, &iss))
     {
+      if (!sig.code.empty())
+        m_index[GetIndexKey(sig.code.size(), sig.code[0])].push_back(m_signatures.size());
       m_signatures.push_back(std::move(sig));
     }
     else
@@ -160,19 +169,91 @@ bool MEGASignatureDB::Save(const std::string& file_path) const
 
 void MEGASignatureDB::Apply(const Core::CPUThreadGuard& guard, PPCSymbolDB* symbol_db) const
 {
-  for (auto& it : symbol_db->AccessSymbols())
+  static constexpr size_t NO_MATCH = std::numeric_limits<size_t>::max();
+  struct Candidate
+  {
+    Common::Symbol* symbol;
+    // The signatures of the symbol's size that start with its first instruction or a wildcard
+    const std::vector<size_t>* exact;
+    const std::vector<size_t>* wildcard;
+    size_t code_offset;
+    size_t match = NO_MATCH;
+  };
+
+  const auto find_bucket = [this](u64 key) -> const std::vector<size_t>* {
+    const auto it = m_index.find(key);
+    return it != m_index.end() ? &it->second : nullptr;
+  };
+
+  // Memory is only read on this thread. Only symbols that some signature could match are read in
+  // full.
+  std::vector<Candidate> candidates;
+  std::vector<u32> code;
+  for (auto& [address, symbol] : symbol_db->AccessSymbols())
   {
-    auto& symbol = it.second;
-    for (const auto& sig : m_signatures)
+    if (symbol.size == 0 || symbol.size % sizeof(u32) != 0)
+      continue;
+
+    const size_t word_count = symbol.size / sizeof(u32);
+    const u32 first_word = PowerPC::MMU::HostRead_U32(guard, symbol.address);
+    const std::vector<size_t>* exact =
+        first_word != 0 ? find_bucket(GetIndexKey(word_count, first_word)) : nullptr;
+    const std::vector<size_t>* wildcard = find_bucket(GetIndexKey(word_count, 0));
+    if (!exact && !wildcard)
+      continue;
+
+    candidates.push_back({&symbol, exact, wildcard, code.size()});
+    code.push_back(first_word);
+    for (size_t i = 1; i < word_count; ++i)
+    {
+      code.push_back(
+          PowerPC::MMU::HostRead_U32(guard, static_cast<u32>(symbol.address + i * sizeof(u32))));
+    }
+  }
+
+  // Finds the first signature in file order that matches each candidate.
+  const auto match_candidates = [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i)
     {
-      if (Compare(guard, symbol.address, symbol.size, sig))
+      Candidate& candidate = candidates[i];
+      const std::span<const u32> symbol_code(code.data() + candidate.code_offset,
+                                             candidate.symbol->size / sizeof(u32));
+      for (const std::vector<size_t>* bucket : {candidate.exact, candidate.wildcard})
       {
-        symbol.name = sig.name;
-        INFO_LOG_FMT(SYMBOLS, "Found {} at {:08x} (size: {:08x})!", sig.name, symbol.address,
-                     symbol.size);
-        break;
+        if (!bucket)
+          continue;
+        for (const size_t index : *bucket)
+        {
+          if (index >= candidate.match)
+            break;
+          if (Compare(symbol_code, m_signatures[index]))
+            candidate.match = index;
+        }
       }
     }
+  };
+
+  auto& scheduler = Common::TaskScheduler::GetInstance();
+  std::vector<std::future<void>> tasks;
+  for (size_t begin = SYMBOLS_PER_TASK; begin < candidates.size(); begin += SYMBOLS_PER_TASK)
+  {
+    const size_t end = std::min(begin + SYMBOLS_PER_TASK, candidates.size());
+    tasks.push_back(scheduler.SubmitWithFuture(Common::TaskPriority::Interactive,
+                                               [&, begin, end] { match_candidates(begin, end); }));
+  }
+  match_candidates(0, std::min(SYMBOLS_PER_TASK, candidates.size()));
+  for (std::future<void>& task : tasks)
+    task.wait();
+
+  for (const Candidate& candidate : candidates)
+  {
+    if (candidate.match == NO_MATCH)
+      continue;
+
+    Common::Symbol& symbol = *candidate.symbol;
+    symbol.name = m_signatures[candidate.match].name;
+    INFO_LOG_FMT(SYMBOLS, "Found {} at {:08x} (size: {:08x})!", symbol.name, symbol.address,
+                 symbol.size);
   }
   symbol_db->Index();
 }
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "Common/CommonTypes.h"
@@ -58,5 +59,10 @@ public:
            const std::string& name) override;
 
 private:
+  static u64 GetIndexKey(size_t word_count, u32 first_word);
+
   std::vector<MEGASignature> m_signatures;
+  // Indices of the signatures by their size and first instruction, in file order. The first
+  // instruction of signatures that start with a wildcard is 0.
+  std::unordered_map<u64, std::vector<size_t>> m_index;
 };
@@ -5,12 +5,16 @@
 
 #include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <cstring>
+#include <deque>
 #include <filesystem>
 #include <locale>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <string>
 #include <thread>
 #include <utility>
@@ -21,12 +25,15 @@
 
 #include <lz4.h>
 #include <lzo/lzo1x.h>
+#include <zstd.h>
 
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
 #include "Common/Event.h"
 #include "Common/FileUtil.h"
+#include "Common/Hash.h"
 #include "Common/IOFile.h"
+#include "Common/MemoryAccounting.h"
 #include "Common/MsgHandler.h"
 #include "Common/Thread.h"
 #include "Common/TimeUtil.h"
@@ -36,12 +43,14 @@
 
 #include "Core/AchievementManager.h"
 #include "Core/Config/AchievementSettings.h"
+#include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
 #include "Core/CoreTiming.h"
 #include "Core/GeckoCode.h"
 #include "Core/HW/HW.h"
 #include "Core/HW/Memmap.h"
+#include "Core/HW/VideoInterface.h"
 #include "Core/HW/Wiimote.h"
 #include "Core/Host.h"
 #include "Core/Movie.h"
@@ -50,6 +59,7 @@
 #include "Core/System.h"
 
 #include "VideoCommon/FrameDumpFFMpeg.h"
+#include "VideoCommon/FrameTimeReport.h"
 #include "VideoCommon/OnScreenDisplay.h"
 #include "VideoCommon/VideoBackendBase.h"
 
@@ -73,13 +83,46 @@ static AfterLoadCallbackFunc s_on_after_load_callback;
 static std::vector<u8> s_undo_load_buffer;
 static std::mutex s_undo_load_buffer_mutex;
 
+// How long the in-memory saves take compared to an emulated frame. Features that keep a snapshot
+// every few frames (rewind, or rollback netcode eventually) need this to stay well below one
+// frame. Only accessed on the CPU thread.
+struct SaveToBufferBudget
+{
+  u32 saves = 0;
+  u32 saves_over_budget = 0;
+  std::chrono::steady_clock::duration total_time{};
+  std::chrono::steady_clock::duration max_time{};
+  std::chrono::steady_clock::time_point last_report;
+};
+static SaveToBufferBudget s_save_to_buffer_budget;
+
 static std::mutex s_load_or_save_in_progress_mutex;
 
+// A state that was read and decompressed ahead of time, so that loading it only has to pause the
+// CPU thread for the DoState call.
+struct PrefetchedState
+{
+  std::string filename;
+  u64 generation = 0;
+  std::vector<u8> buffer;
+};
+
+static std::mutex s_prefetch_mutex;
+static std::condition_variable s_prefetch_done;
+static Common::WorkQueueThread<std::string> s_prefetch_thread;
+// Only the most recently requested file is prefetched, older requests are skipped.
+static std::string s_prefetch_pending;
+static PrefetchedState s_prefetched_state;
+// Incremented whenever a state file is written, which makes any prefetched data stale.
+static u64 s_state_file_generation = 0;
+
 struct CompressAndDumpState_args
 {
   std::vector<u8> buffer_vector;
   std::string filename;
   std::shared_ptr<Common::Event> state_write_done_event;
+  bool incremental = false;
+  std::optional<int> zstd_level;
 };
 
 // Protects against simultaneous reads and writes to the final savestate location from multiple
@@ -133,6 +176,55 @@ enum
 
 static bool s_use_compression = true;
 
+// Incremental savestates compare the state against their base state in blocks of this size.
+constexpr u32 DELTA_BLOCK_SIZE = 0x1000;
+
+// Follows the extended header of DeltaLZ4 states, and is followed by a bitmap of the blocks which
+// changed and then the LZ4 compressed contents of those blocks.
+struct StateDeltaHeader
+{
+  u64 base_size;
+  u32 base_crc32;
+  u32 block_size;
+};
+static_assert(sizeof(StateDeltaHeader) == 16);
+
+// The base state of incremental saves. Only accessed from the save thread.
+static std::vector<u8> s_delta_base;
+static u32 s_delta_base_crc32 = 0;
+
+// Rewind snapshots are XORed against the last keyframe and LZ4 compressed, which makes the
+// snapshots between two keyframes very small since most of the state doesn't change.
+struct RewindSnapshot
+{
+  std::vector<u8> data;
+  u64 size;
+  bool keyframe;
+};
+
+constexpr u32 REWIND_KEYFRAME_INTERVAL = 30;
+constexpr u32 REWIND_MAX_INTERVAL_SCALE = 8;
+
+static std::mutex s_rewind_mutex;
+static std::deque<RewindSnapshot> s_rewind_buffer;
+static u64 s_rewind_buffer_bytes = 0;
+// Handed back by the rewind thread so that snapshots don't have to allocate a new buffer.
+static std::vector<u8> s_rewind_spare_buffer;
+
+// Snapshots are taken and compressed on their own thread, so the CPU thread is only paused for
+// as long as it takes to serialize the state.
+static Common::WorkQueueThread<int> s_rewind_thread;
+static std::atomic<bool> s_rewind_snapshot_in_flight = false;
+static std::atomic<bool> s_rewind_force_keyframe = true;
+static std::atomic<u32> s_rewind_frame_counter = 0;
+static std::atomic<u32> s_rewind_interval_scale = 1;
+
+// Only accessed from the rewind thread.
+static std::vector<u8> s_rewind_keyframe;
+static u32 s_rewind_snapshots_since_keyframe = 0;
+
+static void LoadFileStateData(const std::string& filename, std::vector<u8>& ret_data);
+
 void EnableCompression(bool compression)
 {
   s_use_compression = compression;
@@ -228,11 +320,42 @@ void LoadFromBuffer(Core::System& system, std::vector<u8>& buffer)
       true);
 }
 
+static void ReportSaveToBufferTime(Core::System& system,
+                                   std::chrono::steady_clock::duration save_time)
+{
+  auto& budget = s_save_to_buffer_budget;
+  const std::chrono::duration<double> frame_time(
+      1.0 / system.GetVideoInterface().GetTargetRefreshRate());
+
+  ++budget.saves;
+  if (save_time > frame_time)
+    ++budget.saves_over_budget;
+  budget.total_time += save_time;
+  budget.max_time = std::max(budget.max_time, save_time);
+
+  constexpr auto REPORT_INTERVAL = std::chrono::seconds(10);
+  const auto now = std::chrono::steady_clock::now();
+  if (now - budget.last_report < REPORT_INTERVAL)
+    return;
+
+  using Milliseconds = std::chrono::duration<double, std::milli>;
+  const Milliseconds average_time = Milliseconds(budget.total_time) / budget.saves;
+  INFO_LOG_FMT(CORE,
+               "Saved {} states to memory, avg {:.2f} ms ({:.0f}% of a frame), max {:.2f} ms, "
+               "{} over a frame",
+               budget.saves, average_time.count(), 100.0 * average_time / frame_time,
+               Milliseconds(budget.max_time).count(), budget.saves_over_budget);
+  budget = {};
+  budget.last_report = now;
+}
+
 void SaveToBuffer(Core::System& system, std::vector<u8>& buffer)
 {
   Core::RunOnCPUThread(
       system,
       [&] {
+        const auto start_time = std::chrono::steady_clock::now();
+
         u8* ptr = nullptr;
         PointerWrap p_measure(&ptr, 0, PointerWrap::Mode::Measure);
 
@@ -243,6 +366,8 @@ void SaveToBuffer(Core::System& system, std::vector<u8>& buffer)
         ptr = buffer.data();
         PointerWrap p(&ptr, buffer_size, PointerWrap::Mode::Write);
         DoState(system, p);
+
+        ReportSaveToBufferTime(system, std::chrono::steady_clock::now() - start_time);
       },
       true);
 }
@@ -350,19 +475,66 @@ static void CompressBufferToFile(const u8* raw_buffer, u64 size, File::IOFile& f
   }
 }
 
-static void CreateExtendedHeader(StateExtendedHeader& extended_header, size_t uncompressed_size)
+// Lets zstd find matches across the whole of Wii MEM2, where most of a state's data lives.
+constexpr int ZSTD_WINDOW_LOG = 27;
+
+// States that are larger than this are compressed using multiple threads if the zstd library
+// supports it.
+constexpr u64 ZSTD_MULTITHREAD_THRESHOLD = 16 * 1024 * 1024;
+
+static void CompressBufferToFileZstd(const u8* raw_buffer, u64 size, int level, File::IOFile& f)
+{
+  std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)> cctx(ZSTD_createCCtx(), ZSTD_freeCCtx);
+  if (!cctx ||
+      ZSTD_isError(ZSTD_CCtx_setParameter(cctx.get(), ZSTD_c_compressionLevel,
+                                          std::clamp(level, ZSTD_minCLevel(), ZSTD_maxCLevel()))) ||
+      ZSTD_isError(ZSTD_CCtx_setParameter(cctx.get(), ZSTD_c_windowLog, ZSTD_WINDOW_LOG)) ||
+      ZSTD_isError(ZSTD_CCtx_setParameter(cctx.get(), ZSTD_c_enableLongDistanceMatching, 1)) ||
+      ZSTD_isError(ZSTD_CCtx_setPledgedSrcSize(cctx.get(), size)))
+  {
+    PanicAlertFmtT("Internal Zstandard Error - initialization failed");
+    return;
+  }
+
+  // This fails if the library was built without multithreading support, in which case the state
+  // is simply compressed on this thread.
+  if (size > ZSTD_MULTITHREAD_THRESHOLD)
+  {
+    ZSTD_CCtx_setParameter(cctx.get(), ZSTD_c_nbWorkers,
+                           static_cast<int>(std::thread::hardware_concurrency()));
+  }
+
+  ZSTD_inBuffer in_buffer{raw_buffer, size, 0};
+  std::vector<u8> out(ZSTD_CStreamOutSize());
+  size_t remaining;
+  do
+  {
+    ZSTD_outBuffer out_buffer{out.data(), out.size(), 0};
+    remaining = ZSTD_compressStream2(cctx.get(), &out_buffer, &in_buffer, ZSTD_e_end);
+    if (ZSTD_isError(remaining))
+    {
+      PanicAlertFmtT("Internal Zstandard Error - compression failed");
+      return;
+    }
+
+    f.WriteBytes(out.data(), out_buffer.pos);
+  } while (remaining != 0);
+}
+
+static void CreateExtendedHeader(StateExtendedHeader& extended_header, size_t uncompressed_size,
+                                 CompressionType compression_type)
 {
   StateExtendedBaseHeader& base_header = extended_header.base_header;
   base_header.header_version = EXTENDED_HEADER_VERSION;
-  base_header.compression_type =
-      s_use_compression ? CompressionType::LZ4 : CompressionType::Uncompressed;
+  base_header.compression_type = compression_type;
   base_header.payload_offset = COMPRESSED_DATA_OFFSET;
   base_header.uncompressed_size = uncompressed_size;
 
   // If more fields are added to StateExtendedHeader, set them here.
 }
 
-static void WriteHeadersToFile(size_t uncompressed_size, File::IOFile& f)
+static void WriteHeadersToFile(size_t uncompressed_size, CompressionType compression_type,
+                               File::IOFile& f)
 {
   StateHeader header{};
   SConfig::GetInstance().GetGameID().copy(header.legacy_header.game_id,
@@ -374,7 +546,7 @@ static void WriteHeadersToFile(size_t uncompressed_size, File::IOFile& f)
   header.version_header.version_string_length = static_cast<u32>(header.version_string.length());
 
   StateExtendedHeader extended_header{};
-  CreateExtendedHeader(extended_header, uncompressed_size);
+  CreateExtendedHeader(extended_header, uncompressed_size, compression_type);
 
   f.WriteArray(&header.legacy_header, 1);
   f.WriteArray(&header.version_header, 1);
@@ -384,6 +556,103 @@ static void WriteHeadersToFile(size_t uncompressed_size, File::IOFile& f)
   // If StateExtendedHeader is amended to include more than the base, add WriteBytes() calls here.
 }
 
+static void WriteFullState(const u8* buffer_data, size_t buffer_size,
+                           std::optional<int> zstd_level, File::IOFile& f)
+{
+  if (!s_use_compression)
+  {
+    WriteHeadersToFile(buffer_size, CompressionType::Uncompressed, f);
+    f.WriteBytes(buffer_data, buffer_size);
+  }
+  else if (zstd_level)
+  {
+    WriteHeadersToFile(buffer_size, CompressionType::Zstd, f);
+    CompressBufferToFileZstd(buffer_data, buffer_size, *zstd_level, f);
+  }
+  else
+  {
+    WriteHeadersToFile(buffer_size, CompressionType::LZ4, f);
+    CompressBufferToFile(buffer_data, buffer_size, f);
+  }
+}
+
+static std::optional<int> GetZstdLevel()
+{
+  if (!Config::Get(Config::MAIN_SAVESTATE_ZSTD))
+    return std::nullopt;
+  return Config::Get(Config::MAIN_SAVESTATE_ZSTD_LEVEL);
+}
+
+static std::string GetDeltaBasePath(u64 size, u32 crc32)
+{
+  return fmt::format("{}Base/{:08x}-{:x}.sav", File::GetUserPath(D_STATESAVES_IDX), crc32, size);
+}
+
+// Base states are named after their contents, so they are never overwritten while incremental
+// states still refer to them.
+static bool SetDeltaBase(const std::vector<u8>& buffer)
+{
+  const u32 crc32 = Common::ComputeCRC32(buffer.data(), buffer.size());
+  const std::string path = GetDeltaBasePath(buffer.size(), crc32);
+  if (!File::Exists(path))
+  {
+    const std::string temp_path = path + ".tmp";
+    File::CreateFullPath(path);
+    File::IOFile f(temp_path, "wb");
+    WriteFullState(buffer.data(), buffer.size(), std::nullopt, f);
+    if (!f.Close() || !File::Rename(temp_path, path))
+    {
+      File::Delete(temp_path);
+      Core::DisplayMessage("Failed to write base state", 2000);
+      return false;
+    }
+  }
+
+  s_delta_base = buffer;
+  s_delta_base_crc32 = crc32;
+  return true;
+}
+
+// Returns false without writing anything if there is no base state or if so much has changed
+// since the base state that a new one should be written.
+static bool WriteDeltaState(const std::vector<u8>& buffer, File::IOFile& f)
+{
+  if (s_delta_base.empty() || !File::Exists(GetDeltaBasePath(s_delta_base.size(),
+                                                             s_delta_base_crc32)))
+  {
+    return false;
+  }
+
+  const size_t num_blocks = (buffer.size() + DELTA_BLOCK_SIZE - 1) / DELTA_BLOCK_SIZE;
+  std::vector<u8> bitmap((num_blocks + 7) / 8);
+  std::vector<u8> changed_blocks;
+  for (size_t i = 0; i < num_blocks; ++i)
+  {
+    const size_t offset = i * DELTA_BLOCK_SIZE;
+    const size_t size = std::min<size_t>(DELTA_BLOCK_SIZE, buffer.size() - offset);
+    if (offset + size <= s_delta_base.size() &&
+        std::memcmp(buffer.data() + offset, s_delta_base.data() + offset, size) == 0)
+    {
+      continue;
+    }
+
+    bitmap[i / 8] |= 1 << (i % 8);
+    changed_blocks.insert(changed_blocks.end(), buffer.begin() + offset,
+                          buffer.begin() + offset + size);
+  }
+
+  if (changed_blocks.size() > buffer.size() / 2)
+    return false;
+
+  WriteHeadersToFile(buffer.size(), CompressionType::DeltaLZ4, f);
+  const StateDeltaHeader delta_header{s_delta_base.size(), s_delta_base_crc32, DELTA_BLOCK_SIZE};
+  f.WriteArray(&delta_header, 1);
+  f.WriteBytes(bitmap.data(), bitmap.size());
+  if (!changed_blocks.empty())
+    CompressBufferToFile(changed_blocks.data(), changed_blocks.size(), f);
+  return true;
+}
+
 static void CompressAndDumpState(Core::System& system, CompressAndDumpState_args& save_args)
 {
   const u8* const buffer_data = save_args.buffer_vector.data();
@@ -408,12 +677,16 @@ static void CompressAndDumpState(Core::System& system, CompressAndDumpState_args
     return;
   }
 
-  WriteHeadersToFile(buffer_size, f);
+  bool wrote_delta = false;
+  if (save_args.incremental)
+  {
+    wrote_delta = WriteDeltaState(save_args.buffer_vector, f);
+    if (!wrote_delta && SetDeltaBase(save_args.buffer_vector))
+      wrote_delta = WriteDeltaState(save_args.buffer_vector, f);
+  }
 
-  if (s_use_compression)
-    CompressBufferToFile(buffer_data, buffer_size, f);
-  else
-    f.WriteBytes(buffer_data, buffer_size);
+  if (!wrote_delta)
+    WriteFullState(buffer_data, buffer_size, save_args.zstd_level, f);
 
   if (!f.IsGood())
     Core::DisplayMessage("Failed to write state file", 2000);
@@ -467,6 +740,11 @@ static void CompressAndDumpState(Core::System& system, CompressAndDumpState_args
     }
   }
 
+  {
+    std::lock_guard lk(s_prefetch_mutex);
+    s_state_file_generation++;
+  }
+
   Host_UpdateMainFrame();
 }
 
@@ -479,6 +757,7 @@ void SaveAs(Core::System& system, const std::string& filename, bool wait)
   Core::RunOnCPUThread(
       system,
       [&] {
+        const FrameTimeReport::CauseScope stutter_scope(StutterCause::SaveState);
         {
           std::lock_guard lk_(s_state_writes_in_queue_mutex);
           ++s_state_writes_in_queue;
@@ -506,6 +785,8 @@ void SaveAs(Core::System& system, const std::string& filename, bool wait)
           CompressAndDumpState_args save_args;
           save_args.buffer_vector = std::move(current_buffer);
           save_args.filename = filename;
+          save_args.incremental = Config::Get(Config::MAIN_INCREMENTAL_SAVESTATES);
+          save_args.zstd_level = GetZstdLevel();
           if (wait)
           {
             sync_event = std::make_shared<Common::Event>();
@@ -723,6 +1004,114 @@ static bool DecompressLZ4(std::vector<u8>& raw_buffer, u64 size, File::IOFile& f
   }
 }
 
+static bool DecompressZstd(std::vector<u8>& raw_buffer, u64 size, File::IOFile& f)
+{
+  std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)> dctx(ZSTD_createDCtx(), ZSTD_freeDCtx);
+  if (!dctx || ZSTD_isError(ZSTD_DCtx_setParameter(dctx.get(), ZSTD_d_windowLogMax,
+                                                   ZSTD_WINDOW_LOG)))
+  {
+    PanicAlertFmtT("Internal Zstandard Error - initialization failed");
+    return false;
+  }
+
+  raw_buffer.resize(size);
+  ZSTD_outBuffer out_buffer{raw_buffer.data(), raw_buffer.size(), 0};
+  std::vector<u8> in(ZSTD_DStreamInSize());
+  size_t result = 1;
+  while (result != 0)
+  {
+    size_t bytes_read;
+    if (!f.ReadArray(in.data(), in.size(), &bytes_read) && bytes_read == 0)
+    {
+      PanicAlertFmt("Could not read state data");
+      return false;
+    }
+
+    ZSTD_inBuffer in_buffer{in.data(), bytes_read, 0};
+    while (in_buffer.pos < in_buffer.size && result != 0)
+    {
+      result = ZSTD_decompressStream(dctx.get(), &out_buffer, &in_buffer);
+      if (ZSTD_isError(result))
+      {
+        PanicAlertFmtT("Internal Zstandard Error - decompression failed ({0})",
+                       ZSTD_getErrorName(result));
+        return false;
+      }
+    }
+  }
+
+  if (out_buffer.pos != size)
+  {
+    PanicAlertFmtT("Internal Zstandard Error - payload size mismatch ({0} / {1})", out_buffer.pos,
+                   size);
+    return false;
+  }
+
+  return true;
+}
+
+static bool ReadDeltaState(std::vector<u8>& raw_buffer, u64 size, File::IOFile& f)
+{
+  StateDeltaHeader delta_header;
+  if (!f.ReadArray(&delta_header, 1) || delta_header.block_size == 0)
+  {
+    PanicAlertFmt("Could not read state delta header");
+    return false;
+  }
+
+  const u64 block_size = delta_header.block_size;
+  const u64 num_blocks = (size + block_size - 1) / block_size;
+  std::vector<u8> bitmap((num_blocks + 7) / 8);
+  if (!f.ReadBytes(bitmap.data(), bitmap.size()))
+  {
+    PanicAlertFmt("Could not read state delta bitmap");
+    return false;
+  }
+
+  const auto is_changed = [&bitmap](u64 block) { return (bitmap[block / 8] >> (block % 8)) & 1; };
+
+  u64 changed_size = 0;
+  for (u64 i = 0; i < num_blocks; ++i)
+  {
+    if (is_changed(i))
+      changed_size += std::min(block_size, size - i * block_size);
+  }
+
+  std::vector<u8> changed_blocks;
+  if (changed_size != 0 && !DecompressLZ4(changed_blocks, changed_size, f))
+    return false;
+
+  std::vector<u8> base;
+  LoadFileStateData(GetDeltaBasePath(delta_header.base_size, delta_header.base_crc32), base);
+  if (base.size() != delta_header.base_size ||
+      Common::ComputeCRC32(base.data(), base.size()) != delta_header.base_crc32)
+  {
+    Core::DisplayMessage("The base state of this incremental state is missing or corrupted", 4000);
+    return false;
+  }
+
+  raw_buffer = std::move(base);
+  raw_buffer.resize(size);
+  auto changed_it = changed_blocks.begin();
+  for (u64 i = 0; i < num_blocks; ++i)
+  {
+    const u64 offset = i * block_size;
+    const u64 bytes = std::min(block_size, size - offset);
+    if (is_changed(i))
+    {
+      std::copy_n(changed_it, bytes, raw_buffer.begin() + offset);
+      changed_it += bytes;
+    }
+    else if (offset + bytes > delta_header.base_size)
+    {
+      PanicAlertFmt("State delta is missing data past the end of its base state");
+      return false;
+    }
+  }
+
+  return true;
+}
+
 static bool ValidateHeaders(const StateHeader& header)
 {
   bool success = true;
@@ -820,6 +1209,22 @@ static void LoadFileStateData(const std::string& filename, std::vector<u8>& ret_
 
     break;
   }
+  case CompressionType::DeltaLZ4:
+  {
+    Core::DisplayMessage("Decompressing State...", 500);
+    if (!ReadDeltaState(buffer, extended_header.base_header.uncompressed_size, f))
+      return;
+
+    break;
+  }
+  case CompressionType::Zstd:
+  {
+    Core::DisplayMessage("Decompressing State...", 500);
+    if (!DecompressZstd(buffer, extended_header.base_header.uncompressed_size, f))
+      return;
+
+    break;
+  }
   case CompressionType::Uncompressed:
   {
     u64 header_len = sizeof(StateHeaderLegacy) + sizeof(StateHeaderVersion) +
@@ -852,6 +1257,93 @@ static void LoadFileStateData(const std::string& filename, std::vector<u8>& ret_
   ret_data.swap(buffer);
 }
 
+bool FlattenState(const std::string& filename)
+{
+  std::vector<u8> buffer;
+  LoadFileStateData(filename, buffer);
+  if (buffer.empty())
+    return false;
+
+  std::lock_guard lk(s_save_thread_mutex);
+
+  const std::string temp_filename = filename + ".flatten.tmp";
+  File::IOFile f(temp_filename, "wb");
+  WriteFullState(buffer.data(), buffer.size(), GetZstdLevel(), f);
+  if (!f.Close() || !File::Rename(temp_filename, filename))
+  {
+    File::Delete(temp_filename);
+    return false;
+  }
+
+  {
+    std::lock_guard prefetch_lk(s_prefetch_mutex);
+    s_state_file_generation++;
+  }
+
+  return true;
+}
+
+static void PrefetchStateData(const std::string& filename)
+{
+  u64 generation;
+  {
+    std::lock_guard lk(s_prefetch_mutex);
+    if (s_prefetch_pending != filename)
+      return;
+    generation = s_state_file_generation;
+  }
+
+  std::vector<u8> buffer;
+  LoadFileStateData(filename, buffer);
+
+  std::lock_guard lk(s_prefetch_mutex);
+  if (s_prefetch_pending == filename)
+  {
+    s_prefetched_state = {filename, generation, std::move(buffer)};
+    s_prefetch_pending.clear();
+  }
+  s_prefetch_done.notify_all();
+}
+
+void PrefetchState(const std::string& filename)
+{
+  if (!File::Exists(filename))
+    return;
+
+  std::lock_guard lk(s_prefetch_mutex);
+  if (s_prefetch_pending == filename ||
+      (s_prefetched_state.filename == filename &&
+       s_prefetched_state.generation == s_state_file_generation))
+  {
+    return;
+  }
+
+  s_prefetch_pending = filename;
+  s_prefetch_thread.Push(filename);
+}
+
+void PrefetchSlot(int slot)
+{
+  PrefetchState(MakeStateFilename(slot));
+}
+
+// Returns the data of the given state if it has been prefetched, waiting for the prefetch to
+// finish if it is still in progress.
+static std::vector<u8> TakePrefetchedState(const std::string& filename)
+{
+  std::unique_lock lk(s_prefetch_mutex);
+  s_prefetch_done.wait(lk, [&] { return s_prefetch_pending != filename; });
+
+  std::vector<u8> buffer;
+  if (s_prefetched_state.filename == filename &&
+      s_prefetched_state.generation == s_state_file_generation)
+  {
+    buffer = std::move(s_prefetched_state.buffer);
+  }
+  s_prefetched_state = {};
+  return buffer;
+}
+
 void LoadAs(Core::System& system, const std::string& filename)
 {
   if (!Core::IsRunningOrStarting(system))
@@ -873,9 +1365,16 @@ void LoadAs(Core::System& system, const std::string& filename)
   if (!lk)
     return;
 
+  // Reading and decompressing the state doesn't need the CPU thread to be paused.
+  std::vector<u8> buffer = TakePrefetchedState(filename);
+  if (buffer.empty())
+    LoadFileStateData(filename, buffer);
+
   Core::RunOnCPUThread(
       system,
       [&] {
+        const FrameTimeReport::CauseScope stutter_scope(StutterCause::SaveState);
+
         // Save temp buffer for undo load state
         auto& movie = system.GetMovie();
         if (!movie.IsJustStartingRecordingInputFromSaveState())
@@ -894,13 +1393,11 @@ void LoadAs(Core::System& system, const std::string& filename)
 
         // brackets here are so buffer gets freed ASAP
         {
-          std::vector<u8> buffer;
-          LoadFileStateData(filename, buffer);
-
-          if (!buffer.empty())
+          std::vector<u8> state_buffer = std::move(buffer);
+          if (!state_buffer.empty())
           {
-            u8* ptr = buffer.data();
-            PointerWrap p(&ptr, buffer.size(), PointerWrap::Mode::Read);
+            u8* ptr = state_buffer.data();
+            PointerWrap p(&ptr, state_buffer.size(), PointerWrap::Mode::Read);
             DoState(system, p);
             loaded = true;
             loadedSuccessfully = p.IsReadMode();
@@ -940,8 +1437,14 @@ void SetOnAfterLoadCallback(AfterLoadCallbackFunc callback)
   s_on_after_load_callback = std::move(callback);
 }
 
+static void TakeRewindSnapshot(Core::System& system);
+
 void Init(Core::System& system)
 {
+  ClearRewindBuffer();
+  s_prefetch_thread.Reset("Savestate Prefetch", PrefetchStateData);
+  s_rewind_thread.Reset("Rewind Worker", [&system](int) { TakeRewindSnapshot(system); });
+
   s_save_thread.Reset("Savestate Worker", [&system](CompressAndDumpState_args args) {
     CompressAndDumpState(system, args);
 
@@ -959,6 +1462,15 @@ void Init(Core::System& system)
 void Shutdown()
 {
   s_save_thread.Shutdown();
+  s_rewind_thread.Shutdown(true);
+  ClearRewindBuffer();
+
+  s_prefetch_thread.Shutdown(true);
+  {
+    std::lock_guard lk(s_prefetch_mutex);
+    s_prefetch_pending.clear();
+    s_prefetched_state = {};
+  }
 
   // swapping with an empty vector, rather than clear()ing
   // this gives a better guarantee to free the allocated memory right NOW (as opposed to, actually,
@@ -1057,4 +1569,202 @@ void UndoSaveState(Core::System& system)
   LoadAs(system, File::GetUserPath(D_STATESAVES_IDX) + "lastState.sav");
 }
 
+static bool CompressRewindSnapshot(const std::vector<u8>& state, RewindSnapshot& snapshot)
+{
+  snapshot.size = state.size();
+  snapshot.data.resize(LZ4_compressBound(static_cast<int>(state.size())));
+  const int compressed_size = LZ4_compress_default(
+      reinterpret_cast<const char*>(state.data()), reinterpret_cast<char*>(snapshot.data.data()),
+      static_cast<int>(state.size()), static_cast<int>(snapshot.data.size()));
+  if (compressed_size <= 0)
+    return false;
+
+  snapshot.data.resize(compressed_size);
+  snapshot.data.shrink_to_fit();
+  return true;
+}
+
+static bool DecompressRewindSnapshot(const RewindSnapshot& snapshot, std::vector<u8>& state)
+{
+  state.resize(snapshot.size);
+  const int size = LZ4_decompress_safe(reinterpret_cast<const char*>(snapshot.data.data()),
+                                       reinterpret_cast<char*>(state.data()),
+                                       static_cast<int>(snapshot.data.size()),
+                                       static_cast<int>(state.size()));
+  return size == static_cast<int>(snapshot.size);
+}
+
+static void XorRewindState(std::vector<u8>& state, const std::vector<u8>& keyframe)
+{
+  for (size_t i = 0; i < state.size(); i++)
+    state[i] ^= keyframe[i];
+}
+
+// Drops the oldest keyframes, along with the snapshots that depend on them, until the buffer
+// fits in the memory limit again. The newest keyframe is always kept.
+static void TrimRewindBuffer(u64 memory_limit)
+{
+  while (s_rewind_buffer_bytes > memory_limit)
+  {
+    const auto next_keyframe =
+        std::find_if(s_rewind_buffer.begin() + 1, s_rewind_buffer.end(),
+                     [](const RewindSnapshot& snapshot) { return snapshot.keyframe; });
+    if (next_keyframe == s_rewind_buffer.end())
+      break;
+
+    for (auto it = s_rewind_buffer.begin(); it != next_keyframe; ++it)
+      s_rewind_buffer_bytes -= it->data.size();
+    s_rewind_buffer.erase(s_rewind_buffer.begin(), next_keyframe);
+  }
+
+  Common::MemoryAccounting::Set(Common::MemoryAccounting::Subsystem::Rewind,
+                                s_rewind_buffer_bytes);
+  Common::MemoryAccounting::SetBudget(Common::MemoryAccounting::Subsystem::Rewind, memory_limit);
+}
+
+static void TakeRewindSnapshot(Core::System& system)
+{
+  if (Core::GetState(system) != Core::State::Running)
+  {
+    s_rewind_snapshot_in_flight.store(false);
+    return;
+  }
+
+  std::vector<u8> state;
+  {
+    std::lock_guard lk(s_rewind_mutex);
+    state.swap(s_rewind_spare_buffer);
+  }
+
+  const u64 start_us = Common::Timer::NowUs();
+  SaveToBuffer(system, state);
+  const u64 elapsed_us = Common::Timer::NowUs() - start_us;
+
+  // Keep the time the CPU thread spends paused for snapshots within the budget by taking them less
+  // often when serializing the state is slow.
+  const u64 budget_us = Config::Get(Config::MAIN_REWIND_FRAME_BUDGET);
+  const u32 scale = s_rewind_interval_scale.load();
+  if (elapsed_us > budget_us && scale < REWIND_MAX_INTERVAL_SCALE)
+    s_rewind_interval_scale.store(scale * 2);
+  else if (elapsed_us < budget_us / 2 && scale > 1)
+    s_rewind_interval_scale.store(scale / 2);
+
+  RewindSnapshot snapshot;
+  snapshot.keyframe = s_rewind_force_keyframe.exchange(false) ||
+                      state.size() != s_rewind_keyframe.size() ||
+                      s_rewind_snapshots_since_keyframe >= REWIND_KEYFRAME_INTERVAL;
+  bool success;
+  if (snapshot.keyframe)
+  {
+    s_rewind_keyframe.swap(state);
+    s_rewind_snapshots_since_keyframe = 0;
+    success = CompressRewindSnapshot(s_rewind_keyframe, snapshot);
+  }
+  else
+  {
+    XorRewindState(state, s_rewind_keyframe);
+    s_rewind_snapshots_since_keyframe++;
+    success = CompressRewindSnapshot(state, snapshot);
+  }
+
+  if (!success)
+  {
+    ERROR_LOG_FMT(CORE, "Failed to compress rewind snapshot");
+    s_rewind_force_keyframe.store(true);
+  }
+
+  {
+    std::lock_guard lk(s_rewind_mutex);
+    if (success)
+    {
+      s_rewind_buffer_bytes += snapshot.data.size();
+      s_rewind_buffer.push_back(std::move(snapshot));
+      TrimRewindBuffer(u64(Config::Get(Config::MAIN_REWIND_MEMORY_LIMIT_MB)) * 1024 * 1024);
+    }
+    s_rewind_spare_buffer = std::move(state);
+  }
+
+  s_rewind_snapshot_in_flight.store(false);
+}
+
+void OnFrameEnd()
+{
+  if (!Config::Get(Config::MAIN_REWIND_ENABLE) || NetPlay::IsNetPlayRunning() ||
+      AchievementManager::GetInstance().IsHardcoreModeActive())
+  {
+    return;
+  }
+
+  const u32 interval = std::max(Config::Get(Config::MAIN_REWIND_INTERVAL), 1u) *
+                       s_rewind_interval_scale.load();
+  if (s_rewind_frame_counter.fetch_add(1) + 1 < interval)
+    return;
+
+  // Never wait for the previous snapshot, just try again on the next frame.
+  if (s_rewind_snapshot_in_flight.exchange(true))
+    return;
+
+  s_rewind_frame_counter.store(0);
+  s_rewind_thread.Push(0);
+}
+
+bool Rewind(Core::System& system)
+{
+  if (NetPlay::IsNetPlayRunning() || AchievementManager::GetInstance().IsHardcoreModeActive())
+    return false;
+
+  s_rewind_thread.WaitForCompletion();
+
+  std::vector<u8> state;
+  {
+    std::lock_guard lk(s_rewind_mutex);
+    if (s_rewind_buffer.empty())
+    {
+      Core::DisplayMessage("Nothing to rewind", 2000);
+      return false;
+    }
+
+    const auto keyframe =
+        std::find_if(s_rewind_buffer.rbegin(), s_rewind_buffer.rend(),
+                     [](const RewindSnapshot& snapshot) { return snapshot.keyframe; });
+    bool success = keyframe != s_rewind_buffer.rend() && DecompressRewindSnapshot(*keyframe, state);
+    if (success && keyframe != s_rewind_buffer.rbegin())
+    {
+      std::vector<u8> delta;
+      success = DecompressRewindSnapshot(s_rewind_buffer.back(), delta) &&
+                delta.size() == state.size();
+      if (success)
+      {
+        XorRewindState(delta, state);
+        state.swap(delta);
+      }
+    }
+
+    s_rewind_buffer_bytes -= s_rewind_buffer.back().data.size();
+    s_rewind_buffer.pop_back();
+    Common::MemoryAccounting::Set(Common::MemoryAccounting::Subsystem::Rewind,
+                                  s_rewind_buffer_bytes);
+    if (!success)
+    {
+      ERROR_LOG_FMT(CORE, "Failed to decompress rewind snapshot");
+      return false;
+    }
+  }
+
+  // The keyframe the rewind thread is diffing against might have just been removed.
+  s_rewind_force_keyframe.store(true);
+  s_rewind_frame_counter.store(0);
+  LoadFromBuffer(system, state);
+  return true;
+}
+
+void ClearRewindBuffer()
+{
+  std::lock_guard lk(s_rewind_mutex);
+  s_rewind_buffer.clear();
+  s_rewind_buffer_bytes = 0;
+  Common::MemoryAccounting::Set(Common::MemoryAccounting::Subsystem::Rewind, 0);
+  std::vector<u8>().swap(s_rewind_spare_buffer);
+  s_rewind_force_keyframe.store(true);
+}
 }  // namespace State
@@ -55,6 +55,10 @@ enum CompressionType : u16
 {
   Uncompressed = 0,
   LZ4 = 1,
+  // Only the blocks which differ from a full base state, LZ4 compressed.
+  DeltaLZ4 = 2,
+  // A single zstd frame.
+  Zstd = 3,
   // Add new compression types after this, as the compression type
   // is numerically stored in the state file.
 };
@@ -106,6 +110,14 @@ void Load(Core::System& system, int slot);
 void SaveAs(Core::System& system, const std::string& filename, bool wait = false);
 void LoadAs(Core::System& system, const std::string& filename);
 
+// Rewrites an incremental savestate as a full one, so that it no longer needs its base state.
+bool FlattenState(const std::string& filename);
+
+// Reads and decompresses a state on a worker thread, so that a following load of the same state
+// only has to pause emulation for deserializing it.
+void PrefetchState(const std::string& filename);
+void PrefetchSlot(int slot);
+
 void SaveToBuffer(Core::System& system, std::vector<u8>& buffer);
 void LoadFromBuffer(Core::System& system, std::vector<u8>& buffer);
 
@@ -114,6 +126,12 @@ void SaveFirstSaved(Core::System& system);
 void UndoSaveState(Core::System& system);
 void UndoLoadState(Core::System& system);
 
+// Called by the CPU thread at the end of every frame to take rewind snapshots.
+void OnFrameEnd();
+// Loads the most recent rewind snapshot and removes it from the ring buffer.
+bool Rewind(Core::System& system);
+void ClearRewindBuffer();
+
 // for calling back into UI code without introducing a dependency on it in core
 using AfterLoadCallbackFunc = std::function<void()>;
 void SetOnAfterLoadCallback(AfterLoadCallbackFunc callback);
@@ -6,6 +6,7 @@
 #include <algorithm>
 #include <bitset>
 #include <cstddef>
+#include <future>
 #include <map>
 #include <memory>
 #include <optional>
@@ -85,13 +86,58 @@ static bool ImportWAD(IOS::HLE::Kernel& ios, const DiscIO::VolumeWAD& wad,
 
   const bool contents_imported = [&]() {
     const u64 title_id = tmd.GetTitleId();
-    for (const IOS::ES::Content& content : tmd.GetContents())
+    const std::vector<IOS::ES::Content> contents = tmd.GetContents();
+    const std::vector<u64> offsets = wad.GetContentOffsets();
+
+    // Contents are passed to ES in chunks, so that no more than one copy of the content being
+    // imported is held in memory.
+    struct Chunk
+    {
+      size_t content;
+      u64 offset;
+      u64 size;
+    };
+    constexpr u64 CHUNK_SIZE = 0x800000;
+    std::vector<Chunk> chunks;
+    for (size_t i = 0; i < contents.size(); ++i)
     {
-      const std::vector<u8> data = wad.GetContent(content.index);
+      const u64 aligned_size = Common::AlignUp(contents[i].size, 0x40);
+      u64 position = 0;
+      do
+      {
+        const u64 size = std::min(CHUNK_SIZE, aligned_size - position);
+        chunks.push_back({i, offsets[i] + position, size});
+        position += size;
+      } while (position < aligned_size);
+    }
 
-      if (es.ImportContentBegin(context, title_id, content.id) < 0 ||
-          es.ImportContentData(context, 0, data.data(), static_cast<u32>(data.size())) < 0 ||
-          es.ImportContentEnd(context, 0) < 0)
+    // Read the next chunk from the WAD while ES handles the current one, which includes decrypting
+    // and hashing a content after its last chunk.
+    const auto read_chunk = [&wad](const Chunk& chunk) {
+      return std::async(std::launch::async, [&wad, chunk]() -> std::optional<std::vector<u8>> {
+        std::vector<u8> data(chunk.size);
+        if (!wad.Read(chunk.offset, chunk.size, data.data(), DiscIO::PARTITION_NONE))
+          return std::nullopt;
+        return data;
+      });
+    };
+    std::future<std::optional<std::vector<u8>>> next_data;
+    if (!chunks.empty())
+      next_data = read_chunk(chunks.front());
+
+    for (size_t i = 0; i < chunks.size(); ++i)
+    {
+      const Chunk& chunk = chunks[i];
+      const IOS::ES::Content& content = contents[chunk.content];
+      const std::optional<std::vector<u8>> data = next_data.get();
+      if (i + 1 < chunks.size())
+        next_data = read_chunk(chunks[i + 1]);
+
+      const bool is_first_chunk = i == 0 || chunks[i - 1].content != chunk.content;
+      const bool is_last_chunk = i + 1 == chunks.size() || chunks[i + 1].content != chunk.content;
+      if (!data || (is_first_chunk && es.ImportContentBegin(context, title_id, content.id) < 0) ||
+          es.ImportContentData(context, 0, data->data(), static_cast<u32>(data->size())) < 0 ||
+          (is_last_chunk && es.ImportContentEnd(context, 0) < 0))
       {
         PanicAlertFmtT("WAD installation failed: Could not import content {0:08x}.", content.id);
         return false;
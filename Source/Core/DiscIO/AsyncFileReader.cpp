@@ -0,0 +1,349 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DiscIO/AsyncFileReader.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <utility>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <io.h>
+#elif defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define HAS_IO_URING
+#include <atomic>
+#include <cerrno>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "Common/CommonTypes.h"
+#include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
+
+namespace DiscIO
+{
+#if defined(_WIN32)
+class AsyncFileReader::Backend
+{
+public:
+  static std::unique_ptr<Backend> Create(File::IOFile& file)
+  {
+    const HANDLE file_handle =
+        reinterpret_cast<HANDLE>(_get_osfhandle(_fileno(file.GetHandle())));
+
+    // The handle of the IOFile wasn't opened for overlapped I/O, so a second one is needed
+    constexpr DWORD share_mode = FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE;
+    const HANDLE handle =
+        ReOpenFile(file_handle, GENERIC_READ, share_mode, FILE_FLAG_OVERLAPPED);
+    if (handle == INVALID_HANDLE_VALUE)
+      return nullptr;
+
+    return std::unique_ptr<Backend>(new Backend(handle));
+  }
+
+  ~Backend() { CloseHandle(m_handle); }
+
+  bool Submit(u64 id, u64 offset, u32 size, u8* out_ptr)
+  {
+    auto overlapped = std::make_unique<OVERLAPPED>();
+    if (!StartRead(overlapped.get(), offset, size, out_ptr))
+      return false;
+
+    m_reads.emplace(id, std::move(overlapped));
+    return true;
+  }
+
+  s64 Wait(u64 id)
+  {
+    const auto it = m_reads.find(id);
+    const s64 result = FinishRead(it->second.get());
+    m_reads.erase(it);
+    return result;
+  }
+
+  s64 ReadAt(u64 offset, u32 size, u8* out_ptr)
+  {
+    OVERLAPPED overlapped;
+    if (!StartRead(&overlapped, offset, size, out_ptr))
+      return -1;
+
+    return FinishRead(&overlapped);
+  }
+
+private:
+  explicit Backend(HANDLE handle) : m_handle(handle) {}
+
+  bool StartRead(OVERLAPPED* overlapped, u64 offset, u32 size, u8* out_ptr)
+  {
+    *overlapped = {};
+    overlapped->Offset = static_cast<DWORD>(offset);
+    overlapped->OffsetHigh = static_cast<DWORD>(offset >> 32);
+    overlapped->hEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+    if (!overlapped->hEvent)
+      return false;
+
+    if (!ReadFile(m_handle, out_ptr, size, nullptr, overlapped) &&
+        GetLastError() != ERROR_IO_PENDING)
+    {
+      CloseHandle(overlapped->hEvent);
+      return false;
+    }
+
+    return true;
+  }
+
+  s64 FinishRead(OVERLAPPED* overlapped)
+  {
+    DWORD bytes_read = 0;
+    const bool success = GetOverlappedResult(m_handle, overlapped, &bytes_read, TRUE);
+    CloseHandle(overlapped->hEvent);
+    return success ? bytes_read : -1;
+  }
+
+  HANDLE m_handle;
+  std::map<u64, std::unique_ptr<OVERLAPPED>> m_reads;
+};
+#elif defined(HAS_IO_URING)
+class AsyncFileReader::Backend
+{
+public:
+  static std::unique_ptr<Backend> Create(File::IOFile& file)
+  {
+    // This fails on kernels older than 5.1 and where io_uring is blocked, e.g. by seccomp
+    io_uring_params params{};
+    const int ring_fd =
+        static_cast<int>(syscall(__NR_io_uring_setup, u32(MAX_PENDING_READS), &params));
+    if (ring_fd < 0)
+      return nullptr;
+
+    auto backend = std::unique_ptr<Backend>(new Backend(ring_fd));
+    if (!backend->MapRings(params))
+      return nullptr;
+
+    backend->m_file_fd = dup(fileno(file.GetHandle()));
+    if (backend->m_file_fd < 0)
+      return nullptr;
+
+    return backend;
+  }
+
+  ~Backend()
+  {
+    if (m_sqes)
+      munmap(m_sqes, m_sqes_size);
+    if (m_cq_ring && m_cq_ring != m_sq_ring)
+      munmap(m_cq_ring, m_cq_ring_size);
+    if (m_sq_ring)
+      munmap(m_sq_ring, m_sq_ring_size);
+    if (m_file_fd >= 0)
+      close(m_file_fd);
+    close(m_ring_fd);
+  }
+
+  bool Submit(u64 id, u64 offset, u32 size, u8* out_ptr)
+  {
+    // Only this thread writes to the tail of the submission queue
+    const u32 tail = *m_sq_tail;
+    const u32 index = tail & *m_sq_mask;
+
+    io_uring_sqe& sqe = m_sqes[index];
+    std::memset(&sqe, 0, sizeof(sqe));
+    sqe.opcode = IORING_OP_READ;
+    sqe.fd = m_file_fd;
+    sqe.addr = reinterpret_cast<u64>(out_ptr);
+    sqe.len = size;
+    sqe.off = offset;
+    sqe.user_data = id;
+    m_sq_array[index] = index;
+
+    std::atomic_ref<u32>(*m_sq_tail).store(tail + 1, std::memory_order_release);
+    if (syscall(__NR_io_uring_enter, m_ring_fd, 1, 0, 0, nullptr, 0) != 1)
+    {
+      // The kernel didn't consume the entry, so it can be taken back
+      std::atomic_ref<u32>(*m_sq_tail).store(tail, std::memory_order_release);
+      return false;
+    }
+
+    return true;
+  }
+
+  s64 Wait(u64 id)
+  {
+    while (true)
+    {
+      ReapCompletions();
+
+      const auto it = m_completed.find(id);
+      if (it != m_completed.end())
+      {
+        const s64 result = it->second;
+        m_completed.erase(it);
+        return result;
+      }
+
+      if (syscall(__NR_io_uring_enter, m_ring_fd, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0) < 0 &&
+          errno != EINTR)
+      {
+        ERROR_LOG_FMT(DISCIO, "Failed to wait for io_uring completion: {}", errno);
+        return -1;
+      }
+    }
+  }
+
+  s64 ReadAt(u64 offset, u32 size, u8* out_ptr)
+  {
+    return pread(m_file_fd, out_ptr, size, static_cast<off_t>(offset));
+  }
+
+private:
+  explicit Backend(int ring_fd) : m_ring_fd(ring_fd) {}
+
+  bool MapRings(const io_uring_params& params)
+  {
+    m_sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(u32);
+    m_cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    const bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (single_mmap)
+      m_sq_ring_size = m_cq_ring_size = std::max(m_sq_ring_size, m_cq_ring_size);
+
+    m_sq_ring = MapRing(m_sq_ring_size, IORING_OFF_SQ_RING);
+    if (!m_sq_ring)
+      return false;
+
+    m_cq_ring = single_mmap ? m_sq_ring : MapRing(m_cq_ring_size, IORING_OFF_CQ_RING);
+    if (!m_cq_ring)
+      return false;
+
+    m_sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+    m_sqes = static_cast<io_uring_sqe*>(MapRing(m_sqes_size, IORING_OFF_SQES));
+    if (!m_sqes)
+      return false;
+
+    u8* const sq = static_cast<u8*>(m_sq_ring);
+    m_sq_tail = reinterpret_cast<u32*>(sq + params.sq_off.tail);
+    m_sq_mask = reinterpret_cast<u32*>(sq + params.sq_off.ring_mask);
+    m_sq_array = reinterpret_cast<u32*>(sq + params.sq_off.array);
+
+    u8* const cq = static_cast<u8*>(m_cq_ring);
+    m_cq_head = reinterpret_cast<u32*>(cq + params.cq_off.head);
+    m_cq_tail = reinterpret_cast<u32*>(cq + params.cq_off.tail);
+    m_cq_mask = reinterpret_cast<u32*>(cq + params.cq_off.ring_mask);
+    m_cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+    return true;
+  }
+
+  void* MapRing(size_t size, off_t offset)
+  {
+    void* const ptr =
+        mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_ring_fd, offset);
+    return ptr == MAP_FAILED ? nullptr : ptr;
+  }
+
+  void ReapCompletions()
+  {
+    u32 head = *m_cq_head;
+    const u32 tail = std::atomic_ref<u32>(*m_cq_tail).load(std::memory_order_acquire);
+    for (; head != tail; ++head)
+    {
+      const io_uring_cqe& cqe = m_cqes[head & *m_cq_mask];
+      m_completed.emplace(cqe.user_data, cqe.res);
+    }
+    std::atomic_ref<u32>(*m_cq_head).store(head, std::memory_order_release);
+  }
+
+  int m_ring_fd;
+  int m_file_fd = -1;
+
+  void* m_sq_ring = nullptr;
+  void* m_cq_ring = nullptr;
+  io_uring_sqe* m_sqes = nullptr;
+  size_t m_sq_ring_size = 0;
+  size_t m_cq_ring_size = 0;
+  size_t m_sqes_size = 0;
+
+  u32* m_sq_tail = nullptr;
+  u32* m_sq_mask = nullptr;
+  u32* m_sq_array = nullptr;
+  u32* m_cq_head = nullptr;
+  u32* m_cq_tail = nullptr;
+  u32* m_cq_mask = nullptr;
+  io_uring_cqe* m_cqes = nullptr;
+
+  std::map<u64, s64> m_completed;
+};
+#else
+class AsyncFileReader::Backend
+{
+public:
+  static std::unique_ptr<Backend> Create(File::IOFile&) { return nullptr; }
+  bool Submit(u64, u64, u32, u8*) { return false; }
+  s64 Wait(u64) { return -1; }
+  s64 ReadAt(u64, u32, u8*) { return -1; }
+};
+#endif
+
+AsyncFileReader::AsyncFileReader(std::unique_ptr<Backend> backend) : m_backend(std::move(backend))
+{
+}
+
+AsyncFileReader::~AsyncFileReader()
+{
+  while (!m_pending.empty())
+    Complete();
+}
+
+std::unique_ptr<AsyncFileReader> AsyncFileReader::Create(File::IOFile& file)
+{
+  if (!file)
+    return nullptr;
+
+  std::unique_ptr<Backend> backend = Backend::Create(file);
+  if (!backend)
+  {
+    INFO_LOG_FMT(DISCIO, "Asynchronous file reads aren't available");
+    return nullptr;
+  }
+
+  return std::unique_ptr<AsyncFileReader>(new AsyncFileReader(std::move(backend)));
+}
+
+bool AsyncFileReader::Submit(u64 offset, u32 size, u8* out_ptr)
+{
+  if (m_pending.size() >= MAX_PENDING_READS)
+    return false;
+
+  const u64 id = m_next_id++;
+  if (!m_backend->Submit(id, offset, size, out_ptr))
+    return false;
+
+  m_pending.push_back({id, offset, size, out_ptr});
+  return true;
+}
+
+bool AsyncFileReader::Complete()
+{
+  const PendingRead read = m_pending.front();
+  m_pending.pop_front();
+
+  // Short reads and reads the backend turned down (e.g. io_uring on a kernel without
+  // IORING_OP_READ) are finished synchronously
+  s64 bytes_read = std::max<s64>(m_backend->Wait(read.id), 0);
+  while (bytes_read < read.size)
+  {
+    const s64 result = m_backend->ReadAt(read.offset + bytes_read, read.size - u32(bytes_read),
+                                         read.out_ptr + bytes_read);
+    if (result <= 0)
+      return false;
+    bytes_read += result;
+  }
+
+  return true;
+}
+}  // namespace DiscIO
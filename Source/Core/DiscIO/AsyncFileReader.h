@@ -0,0 +1,58 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <memory>
+
+#include "Common/CommonTypes.h"
+
+namespace File
+{
+class IOFile;
+}
+
+namespace DiscIO
+{
+// Keeps several reads from a file in flight at once, using io_uring on Linux and overlapped I/O
+// on Windows. Reads complete in the order they were submitted. Not thread-safe.
+class AsyncFileReader
+{
+public:
+  static constexpr size_t MAX_PENDING_READS = 8;
+
+  // Returns nullptr if asynchronous reads aren't available on this system
+  static std::unique_ptr<AsyncFileReader> Create(File::IOFile& file);
+
+  // Waits for all pending reads, since they write to memory owned by the caller
+  ~AsyncFileReader();
+
+  // Returns false if the read couldn't be submitted, for instance because too many are pending.
+  // out_ptr must remain valid until the read has been completed.
+  bool Submit(u64 offset, u32 size, u8* out_ptr);
+
+  // Waits for the oldest pending read. Returns whether all of its bytes were read.
+  bool Complete();
+
+  size_t GetPendingCount() const { return m_pending.size(); }
+
+private:
+  class Backend;
+
+  struct PendingRead
+  {
+    u64 id;
+    u64 offset;
+    u32 size;
+    u8* out_ptr;
+  };
+
+  explicit AsyncFileReader(std::unique_ptr<Backend> backend);
+
+  std::unique_ptr<Backend> m_backend;
+  std::deque<PendingRead> m_pending;
+  u64 m_next_id = 0;
+};
+}  // namespace DiscIO
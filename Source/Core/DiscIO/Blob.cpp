@@ -4,10 +4,12 @@
 #include "DiscIO/Blob.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cstddef>
 #include <limits>
 #include <memory>
 #include <string>
+#include <thread>
 #include <utility>
 
 #include "Common/CommonTypes.h"
@@ -255,4 +257,17 @@ std::unique_ptr<BlobReader> CreateBlobReader(const std::string& filename)
   }
 }
 
+static std::atomic<unsigned int> s_compression_thread_count = 0;
+
+void SetCompressionThreadCount(unsigned int threads)
+{
+  s_compression_thread_count.store(threads);
+}
+
+unsigned int GetCompressionThreadCount()
+{
+  const unsigned int threads = s_compression_thread_count.load();
+  return threads != 0 ? threads : std::max(1U, std::thread::hardware_concurrency());
+}
+
 }  // namespace DiscIO
@@ -87,6 +87,20 @@ public:
     return Common::FromBigEndian(temp);
   }
 
+  // Returns a pointer to the data if the whole range can be accessed in place (for instance
+  // because the file is memory-mapped), or nullptr if it has to be read using Read.
+  // The pointer remains valid for the lifetime of the BlobReader. Thread-safe.
+  virtual const u8* GetMappedData(u64 offset, u64 size) { return nullptr; }
+
+  // Asynchronous reads, which let the caller keep several reads in flight against slow storage.
+  // SubmitRead returns false if the read can't be performed asynchronously, in which case Read
+  // has to be used instead. Otherwise, out_ptr must remain valid until CompleteRead has been
+  // called for the read. Reads complete in the order they were submitted.
+  // NOT thread-safe, and must be called from the same thread as Read.
+  virtual bool SubmitRead(u64 offset, u64 size, u8* out_ptr) { return false; }
+  // Waits for the oldest submitted read and returns whether it succeeded
+  virtual bool CompleteRead() { return false; }
+
   virtual bool SupportsReadWiiDecrypted(u64 offset, u64 size, u64 partition_data_offset) const
   {
     return false;
@@ -194,6 +208,12 @@ std::unique_ptr<BlobReader> CreateBlobReader(const std::string& filename);
 
 using CompressCB = std::function<bool(const std::string& text, float percent)>;
 
+// How many compression threads each GCZ/WIA/RVZ conversion uses. 0, the default, means one per
+// CPU thread. Lower it when running several conversions at once, so that they don't oversubscribe
+// the CPU together.
+void SetCompressionThreadCount(unsigned int threads);
+unsigned int GetCompressionThreadCount();
+
 bool ConvertToGCZ(BlobReader* infile, const std::string& infile_path,
                   const std::string& outfile_path, u32 sub_type, int sector_size,
                   CompressCB callback);
@@ -202,6 +222,6 @@ bool ConvertToPlain(BlobReader* infile, const std::string& infile_path,
 bool ConvertToWIAOrRVZ(BlobReader* infile, const std::string& infile_path,
                        const std::string& outfile_path, bool rvz,
                        WIARVZCompressionType compression_type, int compression_level,
-                       int chunk_size, CompressCB callback);
+                       int chunk_size, bool use_zstd_dictionary, CompressCB callback);
 
 }  // namespace DiscIO
@@ -72,6 +72,9 @@ std::unique_ptr<CompressedBlobReader> CompressedBlobReader::Create(File::IOFile
 
 CompressedBlobReader::~CompressedBlobReader()
 {
+  // Don't wait for blocks that nobody is going to read anymore.
+  if (m_read_ahead)
+    m_read_ahead->worker.Shutdown(true);
 }
 
 std::unique_ptr<BlobReader> CompressedBlobReader::CopyReader() const
@@ -92,7 +95,8 @@ u64 CompressedBlobReader::GetBlockCompressedSize(u64 block_num) const
   return 0;
 }
 
-bool CompressedBlobReader::GetBlock(u64 block_num, u8* out_ptr)
+bool CompressedBlobReader::DecompressBlock(File::IOFile* file, std::vector<u8>* zlib_buffer,
+                                           u64 block_num, u8* out_ptr) const
 {
   bool uncompressed = false;
   u32 comp_block_size = (u32)GetBlockCompressedSize(block_num);
@@ -107,19 +111,19 @@ bool CompressedBlobReader::GetBlock(u64 block_num, u8* out_ptr)
   }
 
   // clear unused part of zlib buffer. maybe this can be deleted when it works fully.
-  memset(&m_zlib_buffer[comp_block_size], 0, m_zlib_buffer.size() - comp_block_size);
+  memset(zlib_buffer->data() + comp_block_size, 0, zlib_buffer->size() - comp_block_size);
 
-  m_file.Seek(offset, File::SeekOrigin::Begin);
-  if (!m_file.ReadBytes(m_zlib_buffer.data(), comp_block_size))
+  file->Seek(offset, File::SeekOrigin::Begin);
+  if (!file->ReadBytes(zlib_buffer->data(), comp_block_size))
   {
     ERROR_LOG_FMT(DISCIO, "The disc image \"{}\" is truncated, some of the data is missing.",
                   m_file_name);
-    m_file.ClearError();
+    file->ClearError();
     return false;
   }
 
   // First, check hash.
-  const u32 block_hash = Common::HashAdler32(m_zlib_buffer.data(), comp_block_size);
+  const u32 block_hash = Common::HashAdler32(zlib_buffer->data(), comp_block_size);
   if (block_hash != m_hashes[block_num])
   {
     ERROR_LOG_FMT(DISCIO,
@@ -130,12 +134,12 @@ bool CompressedBlobReader::GetBlock(u64 block_num, u8* out_ptr)
 
   if (uncompressed)
   {
-    std::copy(m_zlib_buffer.begin(), m_zlib_buffer.begin() + comp_block_size, out_ptr);
+    std::copy(zlib_buffer->begin(), zlib_buffer->begin() + comp_block_size, out_ptr);
   }
   else
   {
     z_stream z = {};
-    z.next_in = m_zlib_buffer.data();
+    z.next_in = zlib_buffer->data();
     z.avail_in = comp_block_size;
     if (z.avail_in > m_header.block_size)
     {
@@ -162,6 +166,88 @@ bool CompressedBlobReader::GetBlock(u64 block_num, u8* out_ptr)
   return true;
 }
 
+bool CompressedBlobReader::GetBlock(u64 block_num, u8* out_ptr)
+{
+  // Reading the block after the previous one means we're in a sequential read stream, so start
+  // decompressing the blocks after it in the background.
+  if (block_num == m_last_block_num + 1)
+    QueueReadAhead(block_num + 1);
+  m_last_block_num = block_num;
+
+  if (m_read_ahead)
+  {
+    std::unique_lock lk(m_read_ahead->mutex);
+    m_read_ahead->block_ready.wait(lk,
+                                   [&] { return !m_read_ahead->pending.contains(block_num); });
+
+    const auto it = m_read_ahead->blocks.find(block_num);
+    if (it != m_read_ahead->blocks.end())
+    {
+      std::copy(it->second.begin(), it->second.end(), out_ptr);
+      m_read_ahead->blocks.erase(it);
+      return true;
+    }
+  }
+
+  return DecompressBlock(&m_file, &m_zlib_buffer, block_num, out_ptr);
+}
+
+void CompressedBlobReader::QueueReadAhead(u64 first_block_num)
+{
+  if (!m_read_ahead)
+  {
+    m_read_ahead = std::make_unique<ReadAheadCache>();
+    if (!m_read_ahead->file.Open(m_file_name, "rb"))
+    {
+      WARN_LOG_FMT(DISCIO, "Failed to open {} for read-ahead, disabling it", m_file_name);
+      return;
+    }
+    m_read_ahead->zlib_buffer.resize(m_zlib_buffer.size());
+    m_read_ahead->worker.Reset("GCZ Read-Ahead",
+                               [this](u64 block_num) { ReadAheadWorker(block_num); });
+  }
+
+  if (!m_read_ahead->file.IsOpen())
+    return;
+
+  const u64 last_block_num =
+      std::min<u64>(first_block_num + READ_AHEAD_DISTANCE, m_header.num_blocks);
+
+  std::lock_guard lk(m_read_ahead->mutex);
+
+  // Blocks before the read position won't be read by this stream anymore.
+  auto& blocks = m_read_ahead->blocks;
+  blocks.erase(blocks.begin(), blocks.lower_bound(first_block_num - 1));
+
+  for (u64 i = first_block_num; i < last_block_num; ++i)
+  {
+    if (m_read_ahead->pending.size() + blocks.size() >= READ_AHEAD_DISTANCE)
+      break;
+    if (m_read_ahead->pending.contains(i) || blocks.contains(i))
+      continue;
+
+    m_read_ahead->pending.insert(i);
+    m_read_ahead->worker.Push(i);
+  }
+}
+
+void CompressedBlobReader::ReadAheadWorker(u64 block_num)
+{
+  std::vector<u8> data(m_header.block_size);
+  const bool success =
+      DecompressBlock(&m_read_ahead->file, &m_read_ahead->zlib_buffer, block_num, data.data());
+
+  {
+    std::lock_guard lk(m_read_ahead->mutex);
+    m_read_ahead->pending.erase(block_num);
+
+    // A failed block is decompressed again (and reported) by the reading thread.
+    if (success)
+      m_read_ahead->blocks.emplace(block_num, std::move(data));
+  }
+  m_read_ahead->block_ready.notify_all();
+}
+
 struct CompressThreadState
 {
   CompressThreadState() : z{} {}
@@ -328,7 +414,7 @@ bool ConvertToGCZ(BlobReader* infile, const std::string& infile_path,
   };
 
   MultithreadedCompressor<CompressThreadState, CompressParameters, OutputParameters> compressor(
-      SetUpCompressThreadState, compress, output);
+      SetUpCompressThreadState, compress, output, GetCompressionThreadCount());
 
   std::vector<u8> in_buf(block_size);
   for (u32 i = 0; i < header.num_blocks; i++)
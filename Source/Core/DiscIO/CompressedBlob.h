@@ -12,12 +12,18 @@
 
 #pragma once
 
+#include <condition_variable>
+#include <limits>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <set>
 #include <string>
 #include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/IOFile.h"
+#include "Common/WorkQueueThread.h"
 #include "DiscIO/Blob.h"
 
 namespace DiscIO
@@ -67,6 +73,25 @@ public:
 private:
   CompressedBlobReader(File::IOFile file, const std::string& filename);
 
+  bool DecompressBlock(File::IOFile* file, std::vector<u8>* zlib_buffer, u64 block_num,
+                       u8* out_ptr) const;
+  void QueueReadAhead(u64 first_block_num);
+  void ReadAheadWorker(u64 block_num);
+
+  // Blocks following a sequential read are decompressed on a worker thread, which is only started
+  // once the first sequential read happens.
+  static constexpr u32 READ_AHEAD_DISTANCE = 16;
+  struct ReadAheadCache
+  {
+    std::mutex mutex;
+    std::condition_variable block_ready;
+    std::set<u64> pending;
+    std::map<u64, std::vector<u8>> blocks;
+    File::IOFile file;
+    std::vector<u8> zlib_buffer;
+    Common::WorkQueueThread<u64> worker;
+  };
+
   CompressedBlobHeader m_header;
   std::vector<u64> m_block_pointers;
   std::vector<u32> m_hashes;
@@ -75,6 +100,9 @@ private:
   u64 m_file_size;
   std::vector<u8> m_zlib_buffer;
   std::string m_file_name;
+
+  std::unique_ptr<ReadAheadCache> m_read_ahead;
+  u64 m_last_block_num = std::numeric_limits<u64>::max() - 1;
 };
 
 }  // namespace DiscIO
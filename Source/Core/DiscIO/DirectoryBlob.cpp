@@ -6,6 +6,8 @@
 #include <algorithm>
 #include <array>
 #include <cstring>
+#include <filesystem>
+#include <list>
 #include <locale>
 #include <map>
 #include <memory>
@@ -15,11 +17,14 @@
 #include <variant>
 #include <vector>
 
+#include <fmt/format.h>
+
 #include "Common/Align.h"
 #include "Common/Assert.h"
 #include "Common/CommonPaths.h"
 #include "Common/CommonTypes.h"
 #include "Common/FileUtil.h"
+#include "Common/Hash.h"
 #include "Common/IOFile.h"
 #include "Common/Logging/Log.h"
 #include "Common/StringUtil.h"
@@ -58,6 +63,27 @@ constexpr u8 ENTRY_SIZE = 0x0c;
 constexpr u8 FILE_ENTRY = 0;
 constexpr u8 DIRECTORY_ENTRY = 1;
 
+// A directory tree that was loaded from the cache instead of being scanned. Only the modification
+// times of the directories are checked when loading, so the sizes and modification times of the
+// files are kept to check them when the files are first opened.
+struct CachedDirectoryTree
+{
+  std::string cache_path;
+  std::map<std::string, std::pair<u64, s64>> file_stamps;
+};
+
+constexpr u32 DIRECTORY_TREE_CACHE_MAGIC = 0x43544244;  // "DBTC"
+constexpr u32 DIRECTORY_TREE_CACHE_VERSION = 1;
+
+static std::optional<s64> GetLastWriteTime(const std::string& path)
+{
+  std::error_code error;
+  const auto time = std::filesystem::last_write_time(StringToPath(path), error);
+  if (error)
+    return std::nullopt;
+  return static_cast<s64>(time.time_since_epoch().count());
+}
+
 DiscContent::DiscContent(u64 offset, u64 size, ContentSource source)
     : m_offset(offset), m_size(size), m_content_source(std::move(source))
 {
@@ -97,9 +123,9 @@ bool DiscContent::Read(u64* offset, u64* length, u8** buffer, DirectoryBlobReade
     if (std::holds_alternative<ContentFile>(m_content_source))
     {
       const auto& content = std::get<ContentFile>(m_content_source);
-      File::IOFile file(content.m_filename, "rb");
-      if (!file.Seek(content.m_offset + offset_in_content, File::SeekOrigin::Begin) ||
-          !file.ReadBytes(*buffer, bytes_to_read))
+      File::IOFile* file = blob->GetOpenFile(content.m_filename);
+      if (!file || !file->Seek(content.m_offset + offset_in_content, File::SeekOrigin::Begin) ||
+          !file->ReadBytes(*buffer, bytes_to_read))
       {
         return false;
       }
@@ -539,6 +565,56 @@ bool DirectoryBlobReader::EncryptPartitionData(u64 offset, u64 size, u8* buffer,
                                           partition_data_decrypted_size, it->second.GetKey());
 }
 
+File::IOFile* DirectoryBlobReader::GetOpenFile(const std::string& path)
+{
+  const auto it = std::find_if(m_open_files.begin(), m_open_files.end(),
+                               [&path](const auto& open_file) { return open_file.first == path; });
+  if (it != m_open_files.end())
+  {
+    m_open_files.splice(m_open_files.begin(), m_open_files, it);
+    return &m_open_files.front().second;
+  }
+
+  File::IOFile file(path, "rb");
+  if (!file)
+  {
+    ERROR_LOG_FMT(DISCIO, "Failed to open {}", path);
+    return nullptr;
+  }
+
+  CheckCachedFileStamp(path);
+
+  if (m_open_files.size() >= MAX_OPEN_FILES)
+    m_open_files.pop_back();
+  m_open_files.emplace_front(path, std::move(file));
+  return &m_open_files.front().second;
+}
+
+void DirectoryBlobReader::CheckCachedFileStamp(const std::string& path) const
+{
+  const auto check = [&path](const DirectoryBlobPartition& partition) {
+    const std::shared_ptr<const CachedDirectoryTree>& cache = partition.GetCachedDirectoryTree();
+    if (!cache)
+      return;
+
+    const auto it = cache->file_stamps.find(path);
+    if (it == cache->file_stamps.end())
+      return;
+
+    if (File::GetSize(path) != it->second.first || GetLastWriteTime(path) != it->second.second)
+    {
+      WARN_LOG_FMT(DISCIO, "{} was modified after the directory tree was cached. "
+                           "The change will be picked up the next time the game is booted.",
+                   path);
+      File::Delete(cache->cache_path, File::IfAbsentBehavior::NoConsoleWarning);
+    }
+  };
+
+  check(m_gamecube_pseudopartition);
+  for (const auto& [offset, partition] : m_partitions)
+    check(partition);
+}
+
 BlobType DirectoryBlobReader::GetBlobType() const
 {
   return BlobType::DIRECTORY;
@@ -1081,11 +1157,204 @@ static std::vector<FSTBuilderNode> ConvertFSTEntriesToBuilderNodes(const File::F
   return nodes;
 }
 
+static std::string GetDirectoryTreeCachePath(const std::string& directory)
+{
+  const std::string& cache_directory = File::GetUserPath(D_CACHE_IDX);
+  if (cache_directory.empty())
+    return {};
+  return fmt::format("{}DirectoryBlob/{:08x}.cache", cache_directory,
+                     Common::ComputeCRC32(directory));
+}
+
+static std::string JoinPhysicalName(const std::string& parent, const std::string& name)
+{
+  if (!parent.empty() && IsDirectorySeparator(parent.back()))
+    return parent + name;
+  return parent + '/' + name;
+}
+
+template <typename T>
+static void AppendToCache(std::vector<u8>* data, T value)
+{
+  const u8* bytes = reinterpret_cast<const u8*>(&value);
+  data->insert(data->end(), bytes, bytes + sizeof(T));
+}
+
+static void AppendToCache(std::vector<u8>* data, const std::string& string)
+{
+  AppendToCache(data, static_cast<u32>(string.size()));
+  data->insert(data->end(), string.begin(), string.end());
+}
+
+static bool SerializeDirectoryTree(const File::FSTEntry& entry, std::vector<u8>* data)
+{
+  const std::optional<s64> mtime = GetLastWriteTime(entry.physicalName);
+  if (!mtime)
+    return false;
+
+  AppendToCache(data, static_cast<u8>(entry.isDirectory));
+  AppendToCache(data, entry.virtualName);
+  AppendToCache(data, *mtime);
+  if (!entry.isDirectory)
+  {
+    AppendToCache(data, entry.size);
+    return true;
+  }
+
+  AppendToCache(data, static_cast<u32>(entry.children.size()));
+  for (const File::FSTEntry& child : entry.children)
+  {
+    if (!SerializeDirectoryTree(child, data))
+      return false;
+  }
+  return true;
+}
+
+static void SaveDirectoryTreeCache(const std::string& cache_path, const std::string& directory,
+                                   const File::FSTEntry& root)
+{
+  std::vector<u8> data;
+  AppendToCache(&data, DIRECTORY_TREE_CACHE_MAGIC);
+  AppendToCache(&data, DIRECTORY_TREE_CACHE_VERSION);
+  AppendToCache(&data, directory);
+  if (!SerializeDirectoryTree(root, &data))
+    return;
+
+  File::CreateFullPath(cache_path);
+  File::IOFile file(cache_path, "wb");
+  if (!file.WriteBytes(data.data(), data.size()))
+    ERROR_LOG_FMT(DISCIO, "Failed to write directory tree cache {}", cache_path);
+}
+
+class DirectoryTreeCacheReader
+{
+public:
+  explicit DirectoryTreeCacheReader(std::vector<u8> data) : m_data(std::move(data)) {}
+
+  template <typename T>
+  bool Read(T* value)
+  {
+    if (m_data.size() - m_position < sizeof(T))
+      return false;
+    std::memcpy(value, m_data.data() + m_position, sizeof(T));
+    m_position += sizeof(T);
+    return true;
+  }
+
+  bool Read(std::string* string)
+  {
+    u32 size;
+    if (!Read(&size) || m_data.size() - m_position < size)
+      return false;
+    string->assign(reinterpret_cast<const char*>(m_data.data() + m_position), size);
+    m_position += size;
+    return true;
+  }
+
+  bool AtEnd() const { return m_position == m_data.size(); }
+
+private:
+  std::vector<u8> m_data;
+  size_t m_position = 0;
+};
+
+// Returns false if the cache is malformed or if the modification time of a directory changed,
+// which is the case when a file or directory inside it was added, removed or renamed.
+static bool DeserializeDirectoryTree(DirectoryTreeCacheReader* reader, const std::string* parent,
+                                     File::FSTEntry* entry, CachedDirectoryTree* cache)
+{
+  u8 is_directory;
+  s64 mtime;
+  if (!reader->Read(&is_directory) || !reader->Read(&entry->virtualName) || !reader->Read(&mtime))
+    return false;
+
+  if (parent)
+    entry->physicalName = JoinPhysicalName(*parent, entry->virtualName);
+
+  entry->isDirectory = is_directory != 0;
+  if (!entry->isDirectory)
+  {
+    if (!reader->Read(&entry->size))
+      return false;
+    cache->file_stamps.emplace(entry->physicalName, std::make_pair(entry->size, mtime));
+    return true;
+  }
+
+  u32 children_count;
+  if (GetLastWriteTime(entry->physicalName) != mtime || !reader->Read(&children_count))
+    return false;
+
+  entry->size = children_count;
+  entry->children.resize(children_count);
+  for (File::FSTEntry& child : entry->children)
+  {
+    if (!DeserializeDirectoryTree(reader, &entry->physicalName, &child, cache))
+      return false;
+    if (child.isDirectory)
+      entry->size += child.size;
+  }
+  return true;
+}
+
+static std::optional<File::FSTEntry> LoadDirectoryTreeCache(const std::string& cache_path,
+                                                          const std::string& directory,
+                                                          CachedDirectoryTree* cache)
+{
+  File::IOFile file(cache_path, "rb");
+  if (!file)
+    return std::nullopt;
+
+  std::vector<u8> data(file.GetSize());
+  if (!file.ReadBytes(data.data(), data.size()))
+    return std::nullopt;
+
+  DirectoryTreeCacheReader reader(std::move(data));
+  u32 magic, version;
+  std::string cached_directory;
+  if (!reader.Read(&magic) || magic != DIRECTORY_TREE_CACHE_MAGIC || !reader.Read(&version) ||
+      version != DIRECTORY_TREE_CACHE_VERSION || !reader.Read(&cached_directory) ||
+      cached_directory != directory)
+  {
+    return std::nullopt;
+  }
+
+  File::FSTEntry root;
+  root.physicalName = directory;
+  if (!DeserializeDirectoryTree(&reader, nullptr, &root, cache) || !reader.AtEnd() ||
+      !root.isDirectory)
+  {
+    return std::nullopt;
+  }
+
+  return root;
+}
+
 void DirectoryBlobPartition::BuildFSTFromFolder(const std::string& fst_root_path, u64 fst_address,
                                                 std::vector<u8>* disc_header)
 {
-  auto nodes = ConvertFSTEntriesToBuilderNodes(File::ScanDirectoryTree(fst_root_path, true));
-  BuildFST(std::move(nodes), fst_address, disc_header);
+  // Scanning the whole tree is slow for discs with many files, so the result of the scan is
+  // cached between boots.
+  const std::string cache_path = GetDirectoryTreeCachePath(fst_root_path);
+  std::optional<File::FSTEntry> root;
+  if (!cache_path.empty())
+  {
+    auto cache = std::make_shared<CachedDirectoryTree>();
+    root = LoadDirectoryTreeCache(cache_path, fst_root_path, cache.get());
+    if (root)
+    {
+      cache->cache_path = cache_path;
+      m_cached_directory_tree = std::move(cache);
+    }
+  }
+
+  if (!root)
+  {
+    root = File::ScanDirectoryTree(fst_root_path, true);
+    if (!cache_path.empty())
+      SaveDirectoryTreeCache(cache_path, fst_root_path, *root);
+  }
+
+  BuildFST(ConvertFSTEntriesToBuilderNodes(*root), fst_address, disc_header);
 }
 
 static void ConvertUTF8NamesToSHIFTJIS(std::vector<FSTBuilderNode>* fst)
@@ -6,6 +6,7 @@
 #include <array>
 #include <cstddef>
 #include <functional>
+#include <list>
 #include <map>
 #include <memory>
 #include <optional>
@@ -16,6 +17,7 @@
 
 #include "Common/CommonTypes.h"
 #include "Common/FileUtil.h"
+#include "Common/IOFile.h"
 #include "DiscIO/Blob.h"
 #include "DiscIO/Volume.h"
 #include "DiscIO/WiiEncryptionCache.h"
@@ -23,7 +25,6 @@
 namespace File
 {
 struct FSTEntry;
-class IOFile;
 }  // namespace File
 
 namespace DiscIO
@@ -32,6 +33,7 @@ enum class PartitionType : u32;
 
 class DirectoryBlobReader;
 class VolumeDisc;
+struct CachedDirectoryTree;
 
 // Returns true if the path is inside a DirectoryBlob and doesn't represent the DirectoryBlob itself
 bool ShouldHideFromGameList(const std::string& volume_path);
@@ -205,6 +207,12 @@ public:
   const std::array<u8, VolumeWii::AES_KEY_SIZE>& GetKey() const { return m_key; }
   void SetKey(std::array<u8, VolumeWii::AES_KEY_SIZE> key) { m_key = key; }
 
+  // Set if the FST was built from a cached directory tree instead of scanning the files directory
+  const std::shared_ptr<const CachedDirectoryTree>& GetCachedDirectoryTree() const
+  {
+    return m_cached_directory_tree;
+  }
+
 private:
   void SetDiscType(std::optional<bool> is_wii, const std::vector<u8>& disc_header);
   void SetBI2FromFile(const std::string& bi2_path);
@@ -243,6 +251,8 @@ private:
   u64 m_data_size = 0;
 
   std::optional<DiscIO::Partition> m_wrapped_partition = std::nullopt;
+
+  std::shared_ptr<const CachedDirectoryTree> m_cached_directory_tree;
 };
 
 class DirectoryBlobReader : public BlobReader
@@ -313,6 +323,12 @@ private:
 
   DiscIO::VolumeDisc* GetWrappedVolume() { return m_wrapped_volume.get(); }
 
+  // Files are opened when their content is first read and kept open for later reads
+  File::IOFile* GetOpenFile(const std::string& path);
+  void CheckCachedFileStamp(const std::string& path) const;
+
+  static constexpr size_t MAX_OPEN_FILES = 64;
+
   // For GameCube:
   DirectoryBlobPartition m_gamecube_pseudopartition;
 
@@ -327,6 +343,9 @@ private:
   u64 m_data_size;
 
   std::unique_ptr<DiscIO::VolumeDisc> m_wrapped_volume;
+
+  // Most recently used first
+  std::list<std::pair<std::string, File::IOFile>> m_open_files;
 };
 
 }  // namespace DiscIO
@@ -5,15 +5,22 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <filesystem>
 #include <memory>
 #include <optional>
 #include <string>
 #include <vector>
 
+#include <fmt/format.h>
+
 #include "Common/Align.h"
 #include "Common/Assert.h"
 #include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/Hash.h"
+#include "Common/IOFile.h"
 #include "Common/Logging/Log.h"
+#include "Common/StringUtil.h"
 
 #include "DiscIO/DiscUtils.h"
 #include "DiscIO/Filesystem.h"
@@ -21,6 +28,47 @@
 
 namespace DiscIO
 {
+constexpr u32 SCRUB_CACHE_MAGIC = 0x42435344;  // "DSCB"
+constexpr u32 SCRUB_CACHE_VERSION = 1;
+
+struct ScrubCacheHeader
+{
+  u32 magic;
+  u32 version;
+  u64 image_size;
+  s64 image_mtime;
+  u64 data_size;
+  u32 has_wii_hashes;
+  u32 path_size;
+  u64 num_clusters;
+};
+static_assert(sizeof(ScrubCacheHeader) == 0x30);
+
+static std::string GetScrubCachePath(const std::string& image_path)
+{
+  const std::string& cache_directory = File::GetUserPath(D_CACHE_IDX);
+  if (cache_directory.empty())
+    return {};
+  return fmt::format("{}Scrub/{:08x}.bin", cache_directory, Common::ComputeCRC32(image_path));
+}
+
+static bool GetImageSizeAndMTime(const std::string& image_path, u64* size, s64* mtime)
+{
+  const std::filesystem::path path = StringToPath(image_path);
+  std::error_code error;
+
+  const std::uintmax_t file_size = std::filesystem::file_size(path, error);
+  if (error)
+    return false;
+  const std::filesystem::file_time_type file_time = std::filesystem::last_write_time(path, error);
+  if (error)
+    return false;
+
+  *size = static_cast<u64>(file_size);
+  *mtime = static_cast<s64>(file_time.time_since_epoch().count());
+  return true;
+}
+
 DiscScrubber::DiscScrubber() = default;
 
 bool DiscScrubber::SetupScrub(const Volume& disc)
@@ -41,6 +89,75 @@ bool DiscScrubber::SetupScrub(const Volume& disc)
   return success;
 }
 
+bool DiscScrubber::LoadFromCache(const std::string& image_path)
+{
+  const std::string cache_path = GetScrubCachePath(image_path);
+  u64 image_size;
+  s64 image_mtime;
+  if (cache_path.empty() || !GetImageSizeAndMTime(image_path, &image_size, &image_mtime))
+    return false;
+
+  File::IOFile file(cache_path, "rb");
+  ScrubCacheHeader header;
+  if (!file.ReadArray(&header, 1) || header.magic != SCRUB_CACHE_MAGIC ||
+      header.version != SCRUB_CACHE_VERSION || header.image_size != image_size ||
+      header.image_mtime != image_mtime || header.path_size != image_path.size() ||
+      header.num_clusters != (header.data_size + CLUSTER_SIZE - 1) / CLUSTER_SIZE)
+  {
+    return false;
+  }
+
+  std::string cached_path(header.path_size, '\0');
+  std::vector<u8> bits((header.num_clusters + 7) / 8);
+  if (!file.ReadBytes(cached_path.data(), cached_path.size()) || cached_path != image_path ||
+      !file.ReadBytes(bits.data(), bits.size()))
+  {
+    return false;
+  }
+
+  m_file_size = header.data_size;
+  m_has_wii_hashes = header.has_wii_hashes != 0;
+  m_free_table.resize(header.num_clusters);
+  for (size_t i = 0; i < m_free_table.size(); ++i)
+    m_free_table[i] = (bits[i / 8] >> (i % 8)) & 1;
+
+  m_is_scrubbing = true;
+  return true;
+}
+
+void DiscScrubber::SaveToCache(const std::string& image_path) const
+{
+  const std::string cache_path = GetScrubCachePath(image_path);
+  u64 image_size;
+  s64 image_mtime;
+  if (!m_is_scrubbing || cache_path.empty() ||
+      !GetImageSizeAndMTime(image_path, &image_size, &image_mtime))
+  {
+    return;
+  }
+
+  const ScrubCacheHeader header{SCRUB_CACHE_MAGIC,
+                                SCRUB_CACHE_VERSION,
+                                image_size,
+                                image_mtime,
+                                m_file_size,
+                                m_has_wii_hashes,
+                                static_cast<u32>(image_path.size()),
+                                m_free_table.size()};
+
+  std::vector<u8> bits((m_free_table.size() + 7) / 8);
+  for (size_t i = 0; i < m_free_table.size(); ++i)
+    bits[i / 8] |= (m_free_table[i] & 1) << (i % 8);
+
+  File::CreateFullPath(cache_path);
+  File::IOFile file(cache_path, "wb");
+  if (!file.WriteArray(&header, 1) || !file.WriteBytes(image_path.data(), image_path.size()) ||
+      !file.WriteBytes(bits.data(), bits.size()))
+  {
+    ERROR_LOG_FMT(DISCIO, "Failed to write scrub cache {}", cache_path);
+  }
+}
+
 bool DiscScrubber::CanBlockBeScrubbed(u64 offset) const
 {
   if (!m_is_scrubbing)
@@ -30,6 +30,12 @@ public:
 
   bool SetupScrub(const Volume& disc);
 
+  // The table of used clusters can be cached in the user cache directory, keyed by the path, size
+  // and modification time of the image, so that scrubbing the same image again doesn't have to
+  // walk all partitions and file systems.
+  bool LoadFromCache(const std::string& image_path);
+  void SaveToCache(const std::string& image_path) const;
+
   // Returns true if the specified 32 KiB block only contains unused data
   bool CanBlockBeScrubbed(u64 offset) const;
 
@@ -4,14 +4,27 @@
 #include "DiscIO/FileBlob.h"
 
 #include <algorithm>
+#include <cstring>
+#include <limits>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
 
+#ifdef _WIN32
+#include <windows.h>
+#include <io.h>
+#else
+#include <sys/mman.h>
+#endif
+
 #include "Common/Assert.h"
+#include "Common/CommonFuncs.h"
 #include "Common/FileUtil.h"
+#include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
+#include "Core/Config/MainSettings.h"
 
 namespace DiscIO
 {
@@ -20,6 +33,11 @@ PlainFileReader::PlainFileReader(File::IOFile file) : m_file(std::move(file))
   m_size = m_file.GetSize();
 }
 
+PlainFileReader::~PlainFileReader()
+{
+  UnmapFile();
+}
+
 std::unique_ptr<PlainFileReader> PlainFileReader::Create(File::IOFile file)
 {
   if (file)
@@ -35,6 +53,12 @@ std::unique_ptr<BlobReader> PlainFileReader::CopyReader() const
 
 bool PlainFileReader::Read(u64 offset, u64 nbytes, u8* out_ptr)
 {
+  if (m_mapped_data && offset <= m_size && nbytes <= m_size - offset)
+  {
+    std::memcpy(out_ptr, m_mapped_data + offset, nbytes);
+    return true;
+  }
+
   if (m_file.Seek(offset, File::SeekOrigin::Begin) && m_file.ReadBytes(out_ptr, nbytes))
   {
     return true;
@@ -46,6 +70,87 @@ bool PlainFileReader::Read(u64 offset, u64 nbytes, u8* out_ptr)
   }
 }
 
+const u8* PlainFileReader::GetMappedData(u64 offset, u64 size)
+{
+  std::call_once(m_map_once, [this] { MapFile(); });
+
+  if (!m_mapped_data || offset > m_size || size > m_size - offset)
+    return nullptr;
+
+  return m_mapped_data + offset;
+}
+
+bool PlainFileReader::SubmitRead(u64 offset, u64 size, u8* out_ptr)
+{
+  if (!m_async_reader_created)
+  {
+    m_async_reader = AsyncFileReader::Create(m_file);
+    m_async_reader_created = true;
+  }
+
+  if (!m_async_reader || offset > m_size || size > m_size - offset ||
+      size > std::numeric_limits<u32>::max())
+  {
+    return false;
+  }
+
+  return m_async_reader->Submit(offset, static_cast<u32>(size), out_ptr);
+}
+
+bool PlainFileReader::CompleteRead()
+{
+  return m_async_reader && m_async_reader->GetPendingCount() != 0 && m_async_reader->Complete();
+}
+
+void PlainFileReader::MapFile()
+{
+  if (!Config::Get(Config::MAIN_MAP_DISC_IMAGES) || m_size == 0)
+    return;
+
+#ifdef _WIN32
+  const HANDLE file_handle =
+      reinterpret_cast<HANDLE>(_get_osfhandle(_fileno(m_file.GetHandle())));
+  const HANDLE mapping = CreateFileMappingW(file_handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (!mapping)
+  {
+    WARN_LOG_FMT(DISCIO, "Failed to map disc image: {}", Common::GetLastErrorString());
+    return;
+  }
+
+  // The view keeps the mapping object alive
+  void* const view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  CloseHandle(mapping);
+  if (!view)
+  {
+    WARN_LOG_FMT(DISCIO, "Failed to map disc image: {}", Common::GetLastErrorString());
+    return;
+  }
+#else
+  void* const view = mmap(nullptr, static_cast<size_t>(m_size), PROT_READ, MAP_SHARED,
+                          fileno(m_file.GetHandle()), 0);
+  if (view == MAP_FAILED)
+  {
+    WARN_LOG_FMT(DISCIO, "Failed to map disc image: {}", Common::LastStrerrorString());
+    return;
+  }
+#endif
+
+  m_mapped_data = static_cast<const u8*>(view);
+}
+
+void PlainFileReader::UnmapFile()
+{
+  if (!m_mapped_data)
+    return;
+
+#ifdef _WIN32
+  UnmapViewOfFile(m_mapped_data);
+#else
+  munmap(const_cast<u8*>(m_mapped_data), static_cast<size_t>(m_size));
+#endif
+  m_mapped_data = nullptr;
+}
+
 bool ConvertToPlain(BlobReader* infile, const std::string& infile_path,
                     const std::string& outfile_path, CompressCB callback)
 {
@@ -5,10 +5,12 @@
 
 #include <cstdio>
 #include <memory>
+#include <mutex>
 #include <string>
 
 #include "Common/CommonTypes.h"
 #include "Common/IOFile.h"
+#include "DiscIO/AsyncFileReader.h"
 #include "DiscIO/Blob.h"
 
 namespace DiscIO
@@ -17,6 +19,7 @@ class PlainFileReader : public BlobReader
 {
 public:
   static std::unique_ptr<PlainFileReader> Create(File::IOFile file);
+  ~PlainFileReader() override;
 
   BlobType GetBlobType() const override { return BlobType::PLAIN; }
   std::unique_ptr<BlobReader> CopyReader() const override;
@@ -31,12 +34,26 @@ public:
   std::optional<int> GetCompressionLevel() const override { return std::nullopt; }
 
   bool Read(u64 offset, u64 nbytes, u8* out_ptr) override;
+  const u8* GetMappedData(u64 offset, u64 size) override;
+  bool SubmitRead(u64 offset, u64 size, u8* out_ptr) override;
+  bool CompleteRead() override;
 
 private:
   PlainFileReader(File::IOFile file);
+  // Maps the whole file into memory the first time mapped data is requested,
+  // so that readers which are only used for e.g. the game list never get mapped.
+  void MapFile();
+  void UnmapFile();
 
   File::IOFile m_file;
   u64 m_size;
+
+  std::once_flag m_map_once;
+  const u8* m_mapped_data = nullptr;
+
+  // Created the first time an asynchronous read is submitted
+  std::unique_ptr<AsyncFileReader> m_async_reader;
+  bool m_async_reader_created = false;
 };
 
 }  // namespace DiscIO
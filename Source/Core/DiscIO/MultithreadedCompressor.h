@@ -3,17 +3,22 @@
 
 #pragma once
 
+#include <algorithm>
 #include <atomic>
+#include <condition_variable>
 #include <functional>
+#include <map>
 #include <memory>
-#include <thread>
+#include <mutex>
+#include <optional>
 #include <utility>
 #include <variant>
 #include <vector>
 
 #include "Common/Assert.h"
-#include "Common/Event.h"
+#include "Common/CommonTypes.h"
 #include "Common/Result.h"
+#include "Common/TaskScheduler.h"
 
 namespace DiscIO
 {
@@ -29,12 +34,12 @@ enum class ConversionResultCode
 template <typename T>
 using ConversionResult = Common::Result<ConversionResultCode, T>;
 
-// This class starts a number of compression threads and one output thread.
-// The set_up_compress_thread_state function is called at the start of each compression thread.
-// When CompressAndWrite is called, the compress function will be called on one of the
-// compression threads, and then the output function will be called on the output thread.
-// The output thread handles data in the order that data was submitted using CompressAndWrite,
-// but the compression threads are not guaranteed to handle data in a predictable order.
+// This class runs the compress function on the shared task scheduler and the output function
+// on whichever task finishes the data that is next in line, one call at a time.
+// The set_up_compress_thread_state function is called once for every compression state, and a
+// state is only used by one compress call at a time.
+// The output function handles data in the order that data was submitted using CompressAndWrite,
+// but the compress function is not guaranteed to handle data in a predictable order.
 // Remember to check GetStatus regularly and cancel if it doesn't return Success,
 // and call Shutdown when you want to ensure that everything finishes.
 template <typename CompressThreadState, typename CompressParameters, typename OutputParameters>
@@ -45,22 +50,11 @@ public:
       std::function<ConversionResultCode(CompressThreadState*)> set_up_compress_thread_state,
       std::function<ConversionResult<OutputParameters>(CompressThreadState*, CompressParameters)>
           compress,
-      std::function<ConversionResultCode(OutputParameters)> output)
+      std::function<ConversionResultCode(OutputParameters)> output, size_t threads)
       : m_set_up_compress_thread_state(std::move(set_up_compress_thread_state)),
         m_compress(std::move(compress)), m_output(std::move(output)),
-        m_threads(std::max<unsigned int>(1, std::thread::hardware_concurrency()))
+        m_threads(std::max<size_t>(1, threads))
   {
-    m_compress_threads = std::make_unique<CompressThread[]>(m_threads);
-
-    for (size_t i = 0; i < m_threads; ++i)
-    {
-      m_compress_threads[i].thread =
-          std::thread(std::mem_fn(&MultithreadedCompressor::CompressThreadFunction), this,
-                      &m_compress_threads[i]);
-    }
-
-    m_output_thread =
-        std::thread(std::mem_fn(&MultithreadedCompressor::OutputThreadFunction), this);
   }
 
   ~MultithreadedCompressor()
@@ -74,15 +68,20 @@ public:
     if (GetStatus() != ConversionResultCode::Success)
       return;
 
-    CompressThread& compress_thread = m_compress_threads[m_current_index];
-
-    compress_thread.compress_ready_event.Wait();
-    compress_thread.compress_parameters = std::move(parameters);
-    compress_thread.compress_event.Set();
+    u64 index;
+    {
+      // Like the dedicated threads this replaced, allow a compressed block per thread to wait
+      // for output while the next ones are compressed.
+      std::unique_lock lk(m_lock);
+      m_cond.wait(lk, [this] { return m_next_index - m_next_output_index < m_threads * 2; });
+      index = m_next_index++;
+    }
 
-    ++m_current_index;
-    if (m_current_index >= m_threads)
-      m_current_index -= m_threads;
+    Common::TaskScheduler::GetInstance().Submit(
+        Common::TaskPriority::Background,
+        [this, index, parameters = std::move(parameters)]() mutable {
+          Compress(index, std::move(parameters));
+        });
   }
 
   void SetError(ConversionResultCode result)
@@ -98,111 +97,75 @@ public:
 
   void Shutdown()
   {
-    for (size_t i = 0; i < m_threads; ++i)
-      m_compress_threads[i].compress_ready_event.Wait();
-    for (size_t i = 0; i < m_threads; ++i)
-      m_compress_threads[i].compress_done_event.Wait();
-    for (size_t i = 0; i < m_threads; ++i)
-      m_compress_threads[i].output_ready_event.Wait();
-
+    std::unique_lock lk(m_lock);
+    m_cond.wait(lk, [this] { return m_next_output_index == m_next_index && !m_outputting; });
     m_shutting_down.store(true);
-
-    for (size_t i = 0; i < m_threads; ++i)
-      m_compress_threads[i].compress_event.Set();
-    for (size_t i = 0; i < m_threads; ++i)
-      m_compress_threads[i].output_event.Set();
-
-    for (size_t i = 0; i < m_threads; ++i)
-      m_compress_threads[i].thread.join();
-
-    m_output_thread.join();
   }
 
 private:
-  struct CompressThread
+  void Compress(u64 index, CompressParameters parameters)
   {
-    std::thread thread;
-
-    Common::Event compress_ready_event;
-    Common::Event compress_event;
-    Common::Event compress_done_event;
-    Common::Event output_ready_event;
-    Common::Event output_event;
+    std::unique_ptr<CompressThreadState> state = AcquireCompressThreadState();
 
-    CompressParameters compress_parameters;
-    OutputParameters output_parameters;
-  };
-
-  void CompressThreadFunction(CompressThread* state)
-  {
-    CompressThreadState compress_thread_state;
-
-    ConversionResultCode setup_result = m_set_up_compress_thread_state(&compress_thread_state);
-    if (setup_result != ConversionResultCode::Success)
-      SetError(setup_result);
-
-    state->compress_ready_event.Set();
-    state->compress_done_event.Set();
-
-    while (true)
+    std::optional<OutputParameters> output_parameters;
+    if (state)
     {
-      state->compress_event.Wait();
-
-      if (m_shutting_down.load())
-        return;
+      ConversionResult<OutputParameters> result = m_compress(state.get(), std::move(parameters));
+      if (result)
+        output_parameters = std::move(*result);
+      else
+        SetError(result.Error());
 
-      CompressParameters parameters = std::move(state->compress_parameters);
+      std::lock_guard lk(m_lock);
+      m_compress_thread_states.push_back(std::move(state));
+    }
 
-      state->compress_done_event.Reset();
-      state->compress_ready_event.Set();
+    std::unique_lock lk(m_lock);
+    m_pending_output.emplace(index, std::move(output_parameters));
 
-      ConversionResult<OutputParameters> result =
-          m_compress(&compress_thread_state, std::move(parameters));
+    // Whoever finishes the next block in line writes out every block that is ready after it.
+    while (!m_outputting && !m_pending_output.empty() &&
+           m_pending_output.begin()->first == m_next_output_index)
+    {
+      std::optional<OutputParameters> next = std::move(m_pending_output.begin()->second);
+      m_pending_output.erase(m_pending_output.begin());
+      m_outputting = true;
+      lk.unlock();
 
-      if (result)
-      {
-        state->output_ready_event.Wait();
-        state->output_parameters = std::move(*result);
-        state->output_event.Set();
-      }
-      else
+      if (next && GetStatus() == ConversionResultCode::Success)
       {
-        SetError(result.Error());
+        const ConversionResultCode result = m_output(std::move(*next));
+        if (result != ConversionResultCode::Success)
+          SetError(result);
       }
 
-      state->compress_done_event.Set();
+      lk.lock();
+      m_outputting = false;
+      ++m_next_output_index;
+      m_cond.notify_all();
     }
   }
 
-  void OutputThreadFunction()
+  std::unique_ptr<CompressThreadState> AcquireCompressThreadState()
   {
-    for (size_t i = 0; i < m_threads; ++i)
-      m_compress_threads[i].output_ready_event.Set();
-
-    size_t index = 0;
-
-    while (true)
     {
-      CompressThread& compress_thread = m_compress_threads[index];
-
-      compress_thread.output_event.Wait();
-
-      if (m_shutting_down.load())
-        return;
-
-      OutputParameters parameters = std::move(compress_thread.output_parameters);
-
-      compress_thread.output_ready_event.Set();
-
-      const ConversionResultCode result = m_output(std::move(parameters));
-
-      if (result != ConversionResultCode::Success)
-        SetError(result);
+      std::lock_guard lk(m_lock);
+      if (!m_compress_thread_states.empty())
+      {
+        std::unique_ptr<CompressThreadState> state = std::move(m_compress_thread_states.back());
+        m_compress_thread_states.pop_back();
+        return state;
+      }
+    }
 
-      ++index;
-      if (index >= m_threads)
-        index -= m_threads;
+    auto state = std::make_unique<CompressThreadState>();
+    const ConversionResultCode setup_result = m_set_up_compress_thread_state(state.get());
+    if (setup_result != ConversionResultCode::Success)
+    {
+      SetError(setup_result);
+      return nullptr;
     }
+    return state;
   }
 
   std::function<ConversionResultCode(CompressThreadState*)> m_set_up_compress_thread_state;
@@ -210,12 +173,15 @@ private:
       m_compress;
   std::function<ConversionResultCode(OutputParameters)> m_output;
 
-  // We can't use std::vector for this, because Common::Event is not movable
-  std::unique_ptr<CompressThread[]> m_compress_threads;
-  std::thread m_output_thread;
-
   const size_t m_threads;
-  size_t m_current_index = 0;
+
+  std::mutex m_lock;
+  std::condition_variable m_cond;
+  std::vector<std::unique_ptr<CompressThreadState>> m_compress_thread_states;
+  std::map<u64, std::optional<OutputParameters>> m_pending_output;
+  u64 m_next_index = 0;
+  u64 m_next_output_index = 0;
+  bool m_outputting = false;
 
   std::atomic<ConversionResultCode> m_result = ConversionResultCode::Success;
   std::atomic<bool> m_shutting_down = false;
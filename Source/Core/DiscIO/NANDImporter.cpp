@@ -5,6 +5,8 @@
 
 #include <algorithm>
 #include <cstring>
+#include <thread>
+#include <utility>
 
 #include "Common/Crypto/AES.h"
 #include "Common/FileUtil.h"
@@ -12,6 +14,7 @@
 #include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
 #include "Core/IOS/ES/Formats.h"
+#include "DiscIO/MultithreadedCompressor.h"
 
 namespace DiscIO
 {
@@ -35,7 +38,9 @@ void NANDImporter::ImportNANDBin(const std::string& path_to_bin,
     return;
 
   ExportKeys();
-  ProcessEntry(0, "");
+  std::vector<FileToExtract> files;
+  ProcessEntry(0, "", &files);
+  ExtractFiles(std::move(files));
   ExtractCertificates();
 }
 
@@ -131,7 +136,8 @@ std::string NANDImporter::GetPath(const NANDFSTEntry& entry, const std::string&
   return parent_path + '/' + name;
 }
 
-void NANDImporter::ProcessEntry(u16 entry_number, const std::string& parent_path)
+void NANDImporter::ProcessEntry(u16 entry_number, const std::string& parent_path,
+                                std::vector<FileToExtract>* files)
 {
   while (entry_number != 0xffff)
   {
@@ -145,19 +151,17 @@ void NANDImporter::ProcessEntry(u16 entry_number, const std::string& parent_path
 
     const std::string path = GetPath(entry, parent_path);
     INFO_LOG_FMT(DISCIO, "Entry: {} Path: {}", entry, path);
-    m_update_callback();
 
     Type type = static_cast<Type>(entry.mode & 3);
     if (type == Type::File)
     {
-      std::vector<u8> data = GetEntryData(entry);
-      File::IOFile file(m_nand_root + path, "wb");
-      file.WriteBytes(data.data(), data.size());
+      files->push_back({path, entry});
     }
     else if (type == Type::Directory)
     {
+      m_update_callback();
       File::CreateDir(m_nand_root + path);
-      ProcessEntry(entry.sub, path);
+      ProcessEntry(entry.sub, path, files);
     }
     else
     {
@@ -168,7 +172,50 @@ void NANDImporter::ProcessEntry(u16 entry_number, const std::string& parent_path
   }
 }
 
-std::vector<u8> NANDImporter::GetEntryData(const NANDFSTEntry& entry)
+namespace
+{
+struct ExtractThreadState
+{
+};
+
+struct ExtractedFile
+{
+  std::string path;
+  std::vector<u8> data;
+};
+}  // namespace
+
+void NANDImporter::ExtractFiles(std::vector<FileToExtract> files)
+{
+  // Decrypting is done on all CPU threads, while the files are written from a single thread in
+  // the order of the FST.
+  const auto set_up = [](ExtractThreadState*) { return ConversionResultCode::Success; };
+
+  const auto decrypt = [this](ExtractThreadState*,
+                              FileToExtract file) -> ConversionResult<ExtractedFile> {
+    return ExtractedFile{std::move(file.path), GetEntryData(file.entry)};
+  };
+
+  const auto write = [this](ExtractedFile file) {
+    File::IOFile out(m_nand_root + file.path, "wb");
+    if (!out.WriteBytes(file.data.data(), file.data.size()))
+      ERROR_LOG_FMT(DISCIO, "Unable to write to file {}", file.path);
+    return ConversionResultCode::Success;
+  };
+
+  MultithreadedCompressor<ExtractThreadState, FileToExtract, ExtractedFile> extractor(
+      set_up, decrypt, write, std::thread::hardware_concurrency());
+
+  for (FileToExtract& file : files)
+  {
+    m_update_callback();
+    extractor.CompressAndWrite(std::move(file));
+  }
+
+  extractor.Shutdown();
+}
+
+std::vector<u8> NANDImporter::GetEntryData(const NANDFSTEntry& entry) const
 {
   constexpr size_t NAND_FAT_BLOCK_SIZE = 0x4000;
 
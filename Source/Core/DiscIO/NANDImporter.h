@@ -68,8 +68,18 @@ private:
   bool FindSuperblock();
   std::string GetPath(const NANDFSTEntry& entry, const std::string& parent_path);
   std::string FormatDebugString(const NANDFSTEntry& entry);
-  void ProcessEntry(u16 entry_number, const std::string& parent_path);
-  std::vector<u8> GetEntryData(const NANDFSTEntry& entry);
+
+  struct FileToExtract
+  {
+    std::string path;
+    NANDFSTEntry entry;
+  };
+
+  // Creates the directories right away and collects the files, which are extracted afterwards
+  void ProcessEntry(u16 entry_number, const std::string& parent_path,
+                    std::vector<FileToExtract>* files);
+  void ExtractFiles(std::vector<FileToExtract> files);
+  std::vector<u8> GetEntryData(const NANDFSTEntry& entry) const;
   void ExportKeys();
 
   std::string m_nand_root;
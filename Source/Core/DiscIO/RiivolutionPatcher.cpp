@@ -4,13 +4,17 @@
 #include "DiscIO/RiivolutionPatcher.h"
 
 #include <algorithm>
+#include <functional>
 #include <locale>
+#include <optional>
 #include <string>
 #include <string_view>
+#include <unordered_map>
 #include <vector>
 
 #include <fmt/format.h>
 
+#include "Common/Align.h"
 #include "Common/FileUtil.h"
 #include "Common/IOFile.h"
 #include "Common/StringUtil.h"
@@ -398,35 +402,91 @@ static FSTBuilderNode* FindFileNodeInFST(std::string_view path, std::vector<FSTB
                            create_if_not_exists);
 }
 
-static DiscIO::FSTBuilderNode* FindFilenameNodeInFST(std::string_view filename,
-                                                     std::vector<FSTBuilderNode>& fst)
+static std::string ToLowerCopy(std::string_view str)
 {
-  for (FSTBuilderNode& node : fst)
+  std::string result(str);
+  Common::ToLower(&result);
+  return result;
+}
+
+// Lookup tables for the FST that's being patched, so that applying a file patch doesn't have to
+// walk the tree. The tables are built on first use and dropped whenever a patch adds a node,
+// because adding a node can move the existing nodes in memory.
+class FSTIndex
+{
+public:
+  explicit FSTIndex(std::vector<FSTBuilderNode>* fst) : m_fst(fst) {}
+
+  std::vector<FSTBuilderNode>* GetFST() const { return m_fst; }
+
+  // Same result as FindFileNodeInFST without creating nodes, except that folders are returned too
+  FSTBuilderNode* FindByPath(std::string_view path)
   {
-    if (node.IsFolder())
-    {
-      DiscIO::FSTBuilderNode* result = FindFilenameNodeInFST(filename, node.GetFolderContent());
-      if (result)
-        return result;
-    }
-    else if (Common::CaseInsensitiveEquals(node.m_filename, filename))
+    BuildIfNeeded();
+    const auto it = m_paths.find(ToLowerCopy(path));
+    return it != m_paths.end() ? it->second : nullptr;
+  }
+
+  // The first file with the given name in the same order FindFilenameNodeInFST searched in
+  FSTBuilderNode* FindFirstFileByName(std::string_view filename)
+  {
+    BuildIfNeeded();
+    const auto it = m_file_names.find(ToLowerCopy(filename));
+    return it != m_file_names.end() ? it->second : nullptr;
+  }
+
+  void Invalidate()
+  {
+    m_built = false;
+    m_paths.clear();
+    m_file_names.clear();
+  }
+
+private:
+  void BuildIfNeeded()
+  {
+    if (m_built)
+      return;
+    m_built = true;
+    Add(m_fst, {}, true);
+  }
+
+  // Nodes that are hidden behind an earlier sibling with the same name can't be found by path,
+  // but files in them can still be found by name.
+  void Add(std::vector<FSTBuilderNode>* nodes, const std::string& prefix, bool reachable)
+  {
+    for (FSTBuilderNode& node : *nodes)
     {
-      return &node;
+      const std::string name = ToLowerCopy(node.m_filename);
+      const bool node_reachable = reachable && m_paths.emplace(prefix + name, &node).second;
+      if (node.IsFolder())
+        Add(&node.GetFolderContent(), prefix + name + '/', node_reachable);
+      else
+        m_file_names.emplace(name, &node);
     }
   }
 
-  return nullptr;
-}
+  std::vector<FSTBuilderNode>* m_fst;
+  bool m_built = false;
+  std::unordered_map<std::string, FSTBuilderNode*> m_paths;
+  std::unordered_map<std::string, FSTBuilderNode*> m_file_names;
+};
 
-static void ApplyFilePatchToFST(const Patch& patch, const File& file,
-                                std::vector<DiscIO::FSTBuilderNode>* fst,
+static void ApplyFilePatchToFST(const Patch& patch, const File& file, FSTIndex* fst,
                                 DiscIO::FSTBuilderNode* dol_node)
 {
   if (!file.m_disc.empty() && file.m_disc[0] == '/')
   {
     // If the disc path starts with a / then we should patch that specific disc path.
-    DiscIO::FSTBuilderNode* node =
-        FindFileNodeInFST(std::string_view(file.m_disc).substr(1), fst, file.m_create);
+    const std::string_view path = std::string_view(file.m_disc).substr(1);
+    DiscIO::FSTBuilderNode* node = fst->FindByPath(path);
+    if (node && !node->IsFile())
+      return;
+    if (!node && file.m_create)
+    {
+      node = FindFileNodeInFST(path, fst->GetFST(), true);
+      fst->Invalidate();
+    }
     if (node)
       ApplyPatchToFile(patch, file, node);
   }
@@ -438,14 +498,13 @@ static void ApplyFilePatchToFST(const Patch& patch, const File& file,
   else
   {
     // Otherwise we want to patch the first file in the FST that matches that filename.
-    DiscIO::FSTBuilderNode* node = FindFilenameNodeInFST(file.m_disc, *fst);
+    DiscIO::FSTBuilderNode* node = fst->FindFirstFileByName(file.m_disc);
     if (node)
       ApplyPatchToFile(patch, file, node);
   }
 }
 
-static void ApplyFolderPatchToFST(const Patch& patch, const Folder& folder,
-                                  std::vector<DiscIO::FSTBuilderNode>* fst,
+static void ApplyFolderPatchToFST(const Patch& patch, const Folder& folder, FSTIndex* fst,
                                   DiscIO::FSTBuilderNode* dol_node, std::string_view disc_path,
                                   std::string_view external_path)
 {
@@ -484,8 +543,7 @@ static void ApplyFolderPatchToFST(const Patch& patch, const Folder& folder,
   }
 }
 
-static void ApplyFolderPatchToFST(const Patch& patch, const Folder& folder,
-                                  std::vector<DiscIO::FSTBuilderNode>* fst,
+static void ApplyFolderPatchToFST(const Patch& patch, const Folder& folder, FSTIndex* fst,
                                   DiscIO::FSTBuilderNode* dol_node)
 {
   ApplyFolderPatchToFST(patch, folder, fst, dol_node, folder.m_disc, folder.m_external);
@@ -494,6 +552,7 @@ static void ApplyFolderPatchToFST(const Patch& patch, const Folder& folder,
 void ApplyPatchesToFiles(std::span<const Patch> patches, PatchIndex index,
                          std::vector<FSTBuilderNode>* fst, FSTBuilderNode* dol_node)
 {
+  FSTIndex fst_index(fst);
   for (const auto& patch : patches)
   {
     const auto& file_patches =
@@ -502,10 +561,10 @@ void ApplyPatchesToFiles(std::span<const Patch> patches, PatchIndex index,
         index == PatchIndex::DolphinSysFiles ? patch.m_sys_folder_patches : patch.m_folder_patches;
 
     for (const auto& file : file_patches)
-      ApplyFilePatchToFST(patch, file, fst, dol_node);
+      ApplyFilePatchToFST(patch, file, &fst_index, dol_node);
 
     for (const auto& folder : folder_patches)
-      ApplyFolderPatchToFST(patch, folder, fst, dol_node);
+      ApplyFolderPatchToFST(patch, folder, &fst_index, dol_node);
   }
 }
 
@@ -521,6 +580,41 @@ static bool MemoryMatchesAt(const Core::CPUThreadGuard& guard, u32 offset,
   return true;
 }
 
+// Returns the offset from ram_start of the first match of the pattern that starts at a multiple of
+// the stride and before the given limit. When the range is backed by RAM, the search runs directly
+// over host memory instead of reading every candidate address through the MMU.
+static std::optional<u32> FindInMemory(const Core::CPUThreadGuard& guard, u32 ram_start,
+                                       u32 limit, std::span<const u8> pattern, u32 stride)
+{
+  const std::span<const u8> ram = guard.GetSystem().GetMemory().GetSpanForAddress(ram_start);
+  if (ram.size() < limit)
+  {
+    for (u32 i = 0; i < limit; i += stride)
+    {
+      if (MemoryMatchesAt(guard, ram_start + i, pattern))
+        return i;
+    }
+    return std::nullopt;
+  }
+
+  const std::boyer_moore_horspool_searcher searcher(pattern.begin(), pattern.end());
+  auto it = ram.begin();
+  while (true)
+  {
+    it = std::search(it, ram.end(), searcher);
+    if (it == ram.end())
+      return std::nullopt;
+
+    const u32 offset = static_cast<u32>(it - ram.begin());
+    if (offset >= limit)
+      return std::nullopt;
+    if (offset % stride == 0)
+      return offset;
+
+    it = ram.begin() + Common::AlignUp(offset, stride);
+  }
+}
+
 static void ApplyMemoryPatch(const Core::CPUThreadGuard& guard, u32 offset,
                              std::span<const u8> value, std::span<const u8> original)
 {
@@ -569,15 +663,10 @@ static void ApplySearchMemoryPatch(const Core::CPUThreadGuard& guard, const Patc
     return;
 
   const u32 stride = memory_patch.m_align;
-  for (u32 i = 0; i < length - (stride - 1); i += stride)
-  {
-    const u32 address = ram_start + i;
-    if (MemoryMatchesAt(guard, address, memory_patch.m_original))
-    {
-      ApplyMemoryPatch(guard, address, GetMemoryPatchValue(patch, memory_patch), {});
-      break;
-    }
-  }
+  const std::optional<u32> offset =
+      FindInMemory(guard, ram_start, length - (stride - 1), memory_patch.m_original, stride);
+  if (offset)
+    ApplyMemoryPatch(guard, ram_start + *offset, GetMemoryPatchValue(patch, memory_patch), {});
 }
 
 static void ApplyOcarinaMemoryPatch(const Core::CPUThreadGuard& guard, const Patch& patch,
@@ -590,31 +679,26 @@ static void ApplyOcarinaMemoryPatch(const Core::CPUThreadGuard& guard, const Pat
     return;
 
   auto& system = guard.GetSystem();
-  for (u32 i = 0; i < length; i += 4)
+  // first find the pattern
+  const std::optional<u32> offset = FindInMemory(guard, ram_start, length, value, 4);
+  if (!offset)
+    return;
+
+  for (u32 i = *offset; i < length; i += 4)
   {
-    // first find the pattern
-    const u32 address = ram_start + i;
-    if (MemoryMatchesAt(guard, address, value))
+    // from the pattern find the next blr instruction
+    const u32 blr_address = ram_start + i;
+    auto blr = PowerPC::MMU::HostTryReadU32(guard, blr_address);
+    if (blr && blr->value == 0x4e800020)
     {
-      for (; i < length; i += 4)
+      // and replace it with a jump to the given offset
+      const u32 target = memory_patch.m_offset | 0x80000000;
+      const u32 jmp = ((target - blr_address) & 0x03fffffc) | 0x48000000;
+      PowerPC::MMU::HostTryWriteU32(guard, jmp, blr_address);
+      const u32 overlapping_hook_count = HLE::UnpatchRange(system, blr_address, blr_address + 4);
+      if (overlapping_hook_count != 0)
       {
-        // from the pattern find the next blr instruction
-        const u32 blr_address = ram_start + i;
-        auto blr = PowerPC::MMU::HostTryReadU32(guard, blr_address);
-        if (blr && blr->value == 0x4e800020)
-        {
-          // and replace it with a jump to the given offset
-          const u32 target = memory_patch.m_offset | 0x80000000;
-          const u32 jmp = ((target - blr_address) & 0x03fffffc) | 0x48000000;
-          PowerPC::MMU::HostTryWriteU32(guard, jmp, blr_address);
-          const u32 overlapping_hook_count =
-              HLE::UnpatchRange(system, blr_address, blr_address + 4);
-          if (overlapping_hook_count != 0)
-          {
-            WARN_LOG_FMT(OSHLE, "Riivolution ocarina patch overlaps HLE hook at {}", blr_address);
-          }
-          return;
-        }
+        WARN_LOG_FMT(OSHLE, "Riivolution ocarina patch overlaps HLE hook at {}", blr_address);
       }
       return;
     }
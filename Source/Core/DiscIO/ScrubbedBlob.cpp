@@ -22,13 +22,21 @@ ScrubbedBlob::ScrubbedBlob(std::unique_ptr<BlobReader> blob_reader, DiscScrubber
 
 std::unique_ptr<ScrubbedBlob> ScrubbedBlob::Create(const std::string& path)
 {
-  std::unique_ptr<VolumeDisc> disc = CreateDisc(path);
-  if (!disc)
-    return nullptr;
-
+  // Parsing the disc is only needed when the table of used clusters isn't cached yet
   DiscScrubber scrubber;
-  if (!scrubber.SetupScrub(*disc))
-    return nullptr;
+  if (!scrubber.LoadFromCache(path))
+  {
+    std::unique_ptr<VolumeDisc> disc = CreateDisc(path);
+    if (!disc)
+      return nullptr;
+
+    if (!scrubber.SetupScrub(*disc))
+      return nullptr;
+
+    // The files of a directory blob can change without the path changing
+    if (disc->GetBlobType() != BlobType::DIRECTORY)
+      scrubber.SaveToCache(path);
+  }
 
   std::unique_ptr<BlobReader> blob = CreateBlobReader(path);
   if (!blob)
@@ -48,6 +48,19 @@ public:
   Volume() {}
   virtual ~Volume() {}
   virtual bool Read(u64 offset, u64 length, u8* buffer, const Partition& partition) const = 0;
+  // Returns a pointer to the data if it can be accessed without copying it,
+  // see BlobReader::GetMappedData. Returns nullptr otherwise.
+  virtual const u8* GetMappedData(u64 offset, u64 length, const Partition& partition) const
+  {
+    return nullptr;
+  }
+  // Asynchronous reads, see BlobReader::SubmitRead. Only possible for data that is stored as is
+  // in the blob. If SubmitRead returns false, Read has to be used instead.
+  virtual bool SubmitRead(u64 offset, u64 length, u8* buffer, const Partition& partition) const
+  {
+    return false;
+  }
+  virtual bool CompleteRead() const { return false; }
   template <typename T>
   std::optional<T> ReadSwapped(u64 offset, const Partition& partition) const
   {
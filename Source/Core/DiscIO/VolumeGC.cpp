@@ -53,6 +53,27 @@ bool VolumeGC::Read(u64 offset, u64 length, u8* buffer, const Partition& partiti
   return m_reader->Read(offset, length, buffer);
 }
 
+const u8* VolumeGC::GetMappedData(u64 offset, u64 length, const Partition& partition) const
+{
+  if (partition != PARTITION_NONE)
+    return nullptr;
+
+  return m_reader->GetMappedData(offset, length);
+}
+
+bool VolumeGC::SubmitRead(u64 offset, u64 length, u8* buffer, const Partition& partition) const
+{
+  if (partition != PARTITION_NONE)
+    return false;
+
+  return m_reader->SubmitRead(offset, length, buffer);
+}
+
+bool VolumeGC::CompleteRead() const
+{
+  return m_reader->CompleteRead();
+}
+
 const FileSystem* VolumeGC::GetFileSystem(const Partition& partition) const
 {
   return m_file_system->get();
@@ -32,6 +32,11 @@ public:
   ~VolumeGC();
   bool Read(u64 offset, u64 length, u8* buffer,
             const Partition& partition = PARTITION_NONE) const override;
+  const u8* GetMappedData(u64 offset, u64 length,
+                          const Partition& partition = PARTITION_NONE) const override;
+  bool SubmitRead(u64 offset, u64 length, u8* buffer,
+                  const Partition& partition = PARTITION_NONE) const override;
+  bool CompleteRead() const override;
   const FileSystem* GetFileSystem(const Partition& partition = PARTITION_NONE) const override;
   std::string GetGameTDBID(const Partition& partition = PARTITION_NONE) const override;
   std::map<Language, std::string> GetShortNames() const override;
@@ -5,11 +5,14 @@
 
 #include <algorithm>
 #include <future>
+#include <mutex>
 #include <limits>
 #include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
+#include <thread>
+#include <type_traits>
 #include <unordered_set>
 
 #include <mbedtls/md5.h>
@@ -32,6 +35,7 @@
 #include "Common/ScopeGuard.h"
 #include "Common/StringUtil.h"
 #include "Common/Swap.h"
+#include "Common/TaskScheduler.h"
 #include "Common/Version.h"
 #include "Core/IOS/Device.h"
 #include "Core/IOS/ES/ES.h"
@@ -358,6 +362,49 @@ RedumpVerifier::Result RedumpVerifier::Finish(const Hashes<std::vector<u8>>& has
 }
 
 constexpr u64 DEFAULT_READ_SIZE = 0x20000;  // Arbitrary value
+constexpr size_t MAX_READER_THREADS = 4;
+constexpr size_t MAX_CHUNKS_AHEAD = 16;
+constexpr u64 CHECKPOINT_INTERVAL = 0x10000000;
+
+constexpr u32 CHECKPOINT_MAGIC = 0x4B435256;  // "VRCK"
+constexpr u32 CHECKPOINT_VERSION = 1;
+
+// A checkpoint file contains a CheckpointHeader, followed by the block errors, the unused block
+// errors and the IDs of the corrupt contents. It's only meant to be read by the same build.
+struct CheckpointHeader
+{
+  u32 magic;
+  u32 version;
+  u64 raw_size;
+  u64 data_size;
+  u64 chunk_count;
+  u64 chunk_index;
+  u64 progress;
+  u64 biggest_verified_offset;
+  u32 crc32;
+  u8 hashes;
+  u8 calculating_any_hash;
+  u8 read_errors_occurred;
+  u8 padding;
+  u32 block_error_count;
+  u32 unused_block_error_count;
+  u32 corrupt_content_count;
+  mbedtls_md5_context md5;
+  Common::SHA1::State sha1;
+};
+
+struct CheckpointBlockErrors
+{
+  u64 partition_offset;
+  u64 count;
+};
+
+static_assert(std::is_trivially_copyable_v<CheckpointHeader>);
+
+static u8 GetHashesBits(const Hashes<bool>& hashes)
+{
+  return (hashes.crc32 ? 1 : 0) | (hashes.md5 ? 2 : 0) | (hashes.sha1 ? 4 : 0);
+}
 
 VolumeVerifier::VolumeVerifier(const Volume& volume, bool redump_verification,
                                Hashes<bool> hashes_to_calculate)
@@ -373,9 +420,16 @@ VolumeVerifier::VolumeVerifier(const Volume& volume, bool redump_verification,
 
 VolumeVerifier::~VolumeVerifier()
 {
+  StopReaderThreads();
   WaitForAsyncOperations();
 }
 
+void VolumeVerifier::SetCheckpointPath(std::string path)
+{
+  ASSERT(!m_started);
+  m_checkpoint_path = std::move(path);
+}
+
 Hashes<bool> VolumeVerifier::GetDefaultHashesToCalculate()
 {
   Hashes<bool> hashes_to_calculate{.crc32 = true, .md5 = true, .sha1 = true};
@@ -415,6 +469,12 @@ void VolumeVerifier::Start()
   CheckMisc();
 
   SetUpHashing();
+  PlanChunks();
+
+  if (!m_checkpoint_path.empty())
+    LoadCheckpoint();
+
+  StartReaderThreads();
 }
 
 std::vector<Partition> VolumeVerifier::CheckPartitions()
@@ -1080,201 +1140,434 @@ void VolumeVerifier::SetUpHashing()
   }
 }
 
-void VolumeVerifier::WaitForAsyncOperations() const
+void VolumeVerifier::PlanChunks()
 {
-  if (m_crc32_future.valid())
-    m_crc32_future.wait();
-  if (m_md5_future.valid())
-    m_md5_future.wait();
-  if (m_sha1_future.valid())
-    m_sha1_future.wait();
-  if (m_content_future.valid())
-    m_content_future.wait();
-  if (m_group_future.valid())
-    m_group_future.wait();
-}
+  // Chunks never span more than one content or group, so that the reader threads can check the
+  // integrity of each content and group using only the data of one chunk.
+  u64 progress = 0;
+  u16 content_index = 0;
+  size_t group_index = 0;
+  while (progress < m_max_progress)
+  {
+    ChunkToVerify chunk{.offset = progress, .bytes_to_read = DEFAULT_READ_SIZE};
+    u64 excess_bytes = 0;
+    if (content_index < m_content_offsets.size() && m_content_offsets[content_index] == progress)
+    {
+      IOS::ES::Content content{};
+      m_volume.GetTMD(PARTITION_NONE).GetContent(content_index, &content);
+      chunk.bytes_to_read = Common::AlignUp(content.size, 0x40);
+      chunk.content_index = content_index;
+
+      const u16 next_content_index = content_index + 1;
+      if (next_content_index < m_content_offsets.size() &&
+          m_content_offsets[next_content_index] < progress + chunk.bytes_to_read)
+      {
+        excess_bytes = progress + chunk.bytes_to_read - m_content_offsets[next_content_index];
+      }
+    }
+    else if (content_index < m_content_offsets.size() &&
+             m_content_offsets[content_index] > progress)
+    {
+      chunk.bytes_to_read =
+          std::min(chunk.bytes_to_read, m_content_offsets[content_index] - progress);
+    }
+    else if (group_index < m_groups.size() && m_groups[group_index].offset == progress)
+    {
+      const size_t blocks =
+          m_groups[group_index].block_index_end - m_groups[group_index].block_index_start;
+      chunk.bytes_to_read = VolumeWii::BLOCK_TOTAL_SIZE * blocks;
+      chunk.group_index = group_index;
 
-bool VolumeVerifier::ReadChunkAndWaitForAsyncOperations(u64 bytes_to_read)
-{
-  std::vector<u8> data(bytes_to_read);
+      if (group_index + 1 < m_groups.size() &&
+          m_groups[group_index + 1].offset < progress + chunk.bytes_to_read)
+      {
+        excess_bytes = progress + chunk.bytes_to_read - m_groups[group_index + 1].offset;
+      }
+    }
+    else if (group_index < m_groups.size() && m_groups[group_index].offset > progress)
+    {
+      chunk.bytes_to_read = std::min(chunk.bytes_to_read, m_groups[group_index].offset - progress);
+    }
 
-  const u64 bytes_to_copy = std::min(m_excess_bytes, bytes_to_read);
-  if (bytes_to_copy > 0)
-    std::memcpy(data.data(), m_data.data() + m_data.size() - m_excess_bytes, bytes_to_copy);
-  bytes_to_read -= bytes_to_copy;
+    if (chunk.content_index)
+      ++content_index;
+    if (chunk.group_index)
+      ++group_index;
 
-  if (bytes_to_read > 0)
-  {
-    if (!m_volume.Read(m_progress + bytes_to_copy, bytes_to_read, data.data() + bytes_to_copy,
-                       PARTITION_NONE))
+    if (progress + chunk.bytes_to_read > m_max_progress)
     {
-      return false;
+      const u64 bytes_over_max = progress + chunk.bytes_to_read - m_max_progress;
+
+      if (m_data_size_type == DataSizeType::LowerBound)
+      {
+        // Disc images in NFS format can have the last referenced block be past m_max_progress.
+        // For NFS, reading beyond m_max_progress doesn't return an error, so let's read beyond it.
+        excess_bytes = std::max(excess_bytes, bytes_over_max);
+      }
+      else
+      {
+        // Don't read beyond the end of the disc.
+        chunk.bytes_to_read -= bytes_over_max;
+        excess_bytes -= std::min(excess_bytes, bytes_over_max);
+        chunk.content_index = std::nullopt;
+        chunk.group_index = std::nullopt;
+      }
     }
-  }
 
-  WaitForAsyncOperations();
-  m_data = std::move(data);
-  return true;
+    chunk.byte_increment = chunk.bytes_to_read - excess_bytes;
+    chunk.is_data_needed = m_calculating_any_hash || chunk.content_index || chunk.group_index;
+    m_chunks.push_back(chunk);
+    progress += chunk.byte_increment;
+  }
 }
 
-void VolumeVerifier::Process()
+VolumeVerifier::ChunkResult VolumeVerifier::ReadChunk(const Volume& volume,
+                                                      const ChunkToVerify& chunk) const
 {
-  ASSERT(m_started);
-  ASSERT(!m_done);
+  ChunkResult result;
+  if (!chunk.is_data_needed)
+  {
+    result.read_succeeded = true;
+    return result;
+  }
 
-  if (m_progress >= m_max_progress)
-    return;
+  std::vector<u8> data(chunk.bytes_to_read);
+  if (!volume.Read(chunk.offset, chunk.bytes_to_read, data.data(), PARTITION_NONE))
+    return result;
+  result.read_succeeded = true;
 
-  IOS::ES::Content content{};
-  bool content_read = false;
-  bool group_read = false;
-  u64 bytes_to_read = DEFAULT_READ_SIZE;
-  u64 excess_bytes = 0;
-  if (m_content_index < m_content_offsets.size() &&
-      m_content_offsets[m_content_index] == m_progress)
-  {
-    m_volume.GetTMD(PARTITION_NONE).GetContent(m_content_index, &content);
-    bytes_to_read = Common::AlignUp(content.size, 0x40);
-    content_read = true;
-
-    const u16 next_content_index = m_content_index + 1;
-    if (next_content_index < m_content_offsets.size() &&
-        m_content_offsets[next_content_index] < m_progress + bytes_to_read)
-    {
-      excess_bytes = m_progress + bytes_to_read - m_content_offsets[next_content_index];
-    }
-  }
-  else if (m_content_index < m_content_offsets.size() &&
-           m_content_offsets[m_content_index] > m_progress)
+  // Everything that only depends on this chunk's data is done here rather than in Process
+  if (m_hashes_to_calculate.crc32)
   {
-    bytes_to_read = std::min(bytes_to_read, m_content_offsets[m_content_index] - m_progress);
+    result.crc32 = Common::UpdateCRC32(Common::StartCRC32(), data.data(),
+                                       static_cast<size_t>(chunk.byte_increment));
   }
-  else if (m_group_index < m_groups.size() && m_groups[m_group_index].offset == m_progress)
+
+  if (chunk.content_index)
   {
-    const size_t blocks =
-        m_groups[m_group_index].block_index_end - m_groups[m_group_index].block_index_start;
-    bytes_to_read = VolumeWii::BLOCK_TOTAL_SIZE * blocks;
-    group_read = true;
+    IOS::ES::Content content{};
+    volume.GetTMD(PARTITION_NONE).GetContent(*chunk.content_index, &content);
+    result.content_ok = volume.CheckContentIntegrity(content, data, m_ticket);
+  }
 
-    if (m_group_index + 1 < m_groups.size() &&
-        m_groups[m_group_index + 1].offset < m_progress + bytes_to_read)
+  if (chunk.group_index)
+  {
+    const GroupToVerify& group = m_groups[*chunk.group_index];
+    result.blocks_ok.reserve(group.block_index_end - group.block_index_start);
+    u64 offset_in_group = 0;
+    for (u64 block_index = group.block_index_start; block_index < group.block_index_end;
+         ++block_index, offset_in_group += VolumeWii::BLOCK_TOTAL_SIZE)
     {
-      excess_bytes = m_progress + bytes_to_read - m_groups[m_group_index + 1].offset;
+      result.blocks_ok.push_back(
+          volume.CheckBlockIntegrity(block_index, data.data() + offset_in_group, group.partition));
     }
   }
-  else if (m_group_index < m_groups.size() && m_groups[m_group_index].offset > m_progress)
+
+  if (m_hashes_to_calculate.md5 || m_hashes_to_calculate.sha1)
+    result.data = std::move(data);
+
+  return result;
+}
+
+void VolumeVerifier::StartReaderThreads()
+{
+  m_next_chunk_to_read = m_chunk_index;
+  m_stop_readers = false;
+
+  const size_t thread_count = std::clamp<size_t>(std::thread::hardware_concurrency(), 1,
+                                                 MAX_READER_THREADS);
+  for (size_t i = 0; i < thread_count; ++i)
   {
-    bytes_to_read = std::min(bytes_to_read, m_groups[m_group_index].offset - m_progress);
+    // Each reader thread needs its own volume, since volumes can't be read from concurrently
+    std::unique_ptr<BlobReader> reader = m_volume.GetBlobReader().CopyReader();
+    std::unique_ptr<Volume> volume = reader ? CreateVolume(std::move(reader)) : nullptr;
+    if (!volume)
+      break;
+    m_reader_threads.emplace_back(&VolumeVerifier::ReaderThread, this, std::move(volume));
   }
 
-  if (m_progress + bytes_to_read > m_max_progress)
+  if (m_reader_threads.empty())
+    WARN_LOG_FMT(DISCIO, "Could not copy the blob reader, reading on the calling thread");
+}
+
+void VolumeVerifier::StopReaderThreads()
+{
   {
-    const u64 bytes_over_max = m_progress + bytes_to_read - m_max_progress;
+    std::lock_guard lk(m_reader_mutex);
+    m_stop_readers = true;
+  }
+  m_chunk_consumed_cv.notify_all();
 
-    if (m_data_size_type == DataSizeType::LowerBound)
-    {
-      // Disc images in NFS format can have the last referenced block be past m_max_progress.
-      // For NFS, reading beyond m_max_progress doesn't return an error, so let's read beyond it.
-      excess_bytes = std::max(excess_bytes, bytes_over_max);
-    }
-    else
-    {
-      // Don't read beyond the end of the disc.
-      bytes_to_read -= bytes_over_max;
-      excess_bytes -= std::min(excess_bytes, bytes_over_max);
-      content_read = false;
-      group_read = false;
-    }
+  for (std::thread& thread : m_reader_threads)
+    thread.join();
+  m_reader_threads.clear();
+  m_read_chunks.clear();
+}
+
+void VolumeVerifier::ReaderThread(std::unique_ptr<Volume> volume)
+{
+  std::unique_lock lk(m_reader_mutex);
+  while (true)
+  {
+    m_chunk_consumed_cv.wait(lk, [this] {
+      return m_stop_readers || (m_next_chunk_to_read < m_chunks.size() &&
+                                m_next_chunk_to_read < m_chunk_index + MAX_CHUNKS_AHEAD);
+    });
+    if (m_stop_readers)
+      return;
+
+    const size_t chunk_index = m_next_chunk_to_read++;
+    lk.unlock();
+    ChunkResult result = ReadChunk(*volume, m_chunks[chunk_index]);
+    lk.lock();
+
+    m_read_chunks.emplace(chunk_index, std::move(result));
+    m_chunk_read_cv.notify_all();
   }
+}
+
+VolumeVerifier::ChunkResult VolumeVerifier::GetNextChunkResult()
+{
+  if (m_reader_threads.empty())
+    return ReadChunk(m_volume, m_chunks[m_chunk_index]);
 
-  const bool is_data_needed = m_calculating_any_hash || content_read || group_read;
-  const bool read_failed = is_data_needed && !ReadChunkAndWaitForAsyncOperations(bytes_to_read);
+  std::unique_lock lk(m_reader_mutex);
+  m_chunk_read_cv.wait(lk, [this] { return m_read_chunks.contains(m_chunk_index); });
+  auto node = m_read_chunks.extract(m_chunk_index);
+  return std::move(node.mapped());
+}
 
+void VolumeVerifier::WaitForAsyncOperations() const
+{
+  if (m_md5_future.valid())
+    m_md5_future.wait();
+  if (m_sha1_future.valid())
+    m_sha1_future.wait();
+}
+
+void VolumeVerifier::Process()
+{
+  ASSERT(m_started);
+  ASSERT(!m_done);
+
+  if (m_progress >= m_max_progress)
+    return;
+
+  const ChunkToVerify& chunk = m_chunks[m_chunk_index];
+  ChunkResult result = GetNextChunkResult();
+  {
+    std::lock_guard lk(m_reader_mutex);
+    ++m_chunk_index;
+  }
+  m_chunk_consumed_cv.notify_all();
+
+  const bool read_failed = chunk.is_data_needed && !result.read_succeeded;
   if (read_failed)
   {
-    ERROR_LOG_FMT(DISCIO, "Read failed at {:#x} to {:#x}", m_progress, m_progress + bytes_to_read);
+    ERROR_LOG_FMT(DISCIO, "Read failed at {:#x} to {:#x}", chunk.offset,
+                  chunk.offset + chunk.bytes_to_read);
 
     m_read_errors_occurred = true;
     m_calculating_any_hash = false;
   }
 
-  m_excess_bytes = excess_bytes;
-  const u64 byte_increment = bytes_to_read - excess_bytes;
-
   if (m_calculating_any_hash)
   {
     if (m_hashes_to_calculate.crc32)
+      m_crc32_context = Common::CombineCRC32(m_crc32_context, result.crc32, chunk.byte_increment);
+
+    // MD5 and SHA-1 can't be split up, so they are calculated here in order
+    if (m_hashes_to_calculate.md5 || m_hashes_to_calculate.sha1)
     {
-      m_crc32_future = std::async(std::launch::async, [this, byte_increment] {
-        m_crc32_context = Common::UpdateCRC32(m_crc32_context, m_data.data(),
-                                              static_cast<size_t>(byte_increment));
-      });
+      WaitForAsyncOperations();
+      m_data = std::move(result.data);
     }
 
     if (m_hashes_to_calculate.md5)
     {
-      m_md5_future = std::async(std::launch::async, [this, byte_increment] {
-        mbedtls_md5_update_ret(&m_md5_context, m_data.data(), byte_increment);
-      });
+      m_md5_future = Common::TaskScheduler::GetInstance().SubmitWithFuture(
+          Common::TaskPriority::Background, [this, byte_increment = chunk.byte_increment] {
+            mbedtls_md5_update_ret(&m_md5_context, m_data.data(), byte_increment);
+          });
     }
 
     if (m_hashes_to_calculate.sha1)
     {
-      m_sha1_future = std::async(std::launch::async, [this, byte_increment] {
-        m_sha1_context->Update(m_data.data(), byte_increment);
-      });
+      m_sha1_future = Common::TaskScheduler::GetInstance().SubmitWithFuture(
+          Common::TaskPriority::Background, [this, byte_increment = chunk.byte_increment] {
+            m_sha1_context->Update(m_data.data(), byte_increment);
+          });
     }
   }
 
-  if (content_read)
+  if (chunk.content_index)
   {
-    m_content_future = std::async(std::launch::async, [this, read_failed, content] {
-      if (read_failed || !m_volume.CheckContentIntegrity(content, m_data, m_ticket))
-      {
-        AddProblem(Severity::High, Common::FmtFormatT("Content {0:08x} is corrupt.", content.id));
-      }
-    });
+    if (read_failed || !result.content_ok)
+    {
+      IOS::ES::Content content{};
+      m_volume.GetTMD(PARTITION_NONE).GetContent(*chunk.content_index, &content);
+      AddProblem(Severity::High, Common::FmtFormatT("Content {0:08x} is corrupt.", content.id));
+      m_corrupt_contents.push_back(content.id);
+    }
 
     m_content_index++;
   }
 
-  if (group_read)
+  if (chunk.group_index)
   {
-    m_group_future = std::async(std::launch::async, [this, read_failed,
-                                                     group_index = m_group_index] {
-      const GroupToVerify& group = m_groups[group_index];
-      u64 offset_in_group = 0;
-      for (u64 block_index = group.block_index_start; block_index < group.block_index_end;
-           ++block_index, offset_in_group += VolumeWii::BLOCK_TOTAL_SIZE)
-      {
-        const u64 block_offset = group.offset + offset_in_group;
+    const GroupToVerify& group = m_groups[*chunk.group_index];
+    for (size_t i = 0; i < group.block_index_end - group.block_index_start; ++i)
+    {
+      const u64 block_offset = group.offset + i * VolumeWii::BLOCK_TOTAL_SIZE;
 
-        if (!read_failed && m_volume.CheckBlockIntegrity(
-                                block_index, m_data.data() + offset_in_group, group.partition))
+      if (!read_failed && result.blocks_ok[i])
+      {
+        m_biggest_verified_offset =
+            std::max(m_biggest_verified_offset, block_offset + VolumeWii::BLOCK_TOTAL_SIZE);
+      }
+      else
+      {
+        if (m_scrubber.CanBlockBeScrubbed(block_offset))
         {
-          m_biggest_verified_offset =
-              std::max(m_biggest_verified_offset, block_offset + VolumeWii::BLOCK_TOTAL_SIZE);
+          WARN_LOG_FMT(DISCIO, "Integrity check failed for unused block at {:#x}", block_offset);
+          m_unused_block_errors[group.partition]++;
         }
         else
         {
-          if (m_scrubber.CanBlockBeScrubbed(block_offset))
-          {
-            WARN_LOG_FMT(DISCIO, "Integrity check failed for unused block at {:#x}", block_offset);
-            m_unused_block_errors[group.partition]++;
-          }
-          else
-          {
-            WARN_LOG_FMT(DISCIO, "Integrity check failed for block at {:#x}", block_offset);
-            m_block_errors[group.partition]++;
-          }
+          WARN_LOG_FMT(DISCIO, "Integrity check failed for block at {:#x}", block_offset);
+          m_block_errors[group.partition]++;
         }
       }
-    });
+    }
 
     m_group_index++;
   }
 
-  m_progress += byte_increment;
+  m_progress += chunk.byte_increment;
+
+  if (!m_checkpoint_path.empty() && m_progress < m_max_progress &&
+      m_progress - m_last_checkpoint_progress >= CHECKPOINT_INTERVAL)
+  {
+    SaveCheckpoint();
+  }
+}
+
+bool VolumeVerifier::LoadCheckpoint()
+{
+  File::IOFile file(m_checkpoint_path, "rb");
+  if (!file)
+    return false;
+
+  CheckpointHeader header;
+  if (!file.ReadArray(&header, 1) || header.magic != CHECKPOINT_MAGIC ||
+      header.version != CHECKPOINT_VERSION)
+  {
+    WARN_LOG_FMT(DISCIO, "Ignoring invalid verification checkpoint {}", m_checkpoint_path);
+    return false;
+  }
+
+  if (header.raw_size != m_volume.GetRawSize() || header.data_size != m_max_progress ||
+      header.chunk_count != m_chunks.size() || header.chunk_index > m_chunks.size() ||
+      header.hashes != GetHashesBits(m_hashes_to_calculate))
+  {
+    WARN_LOG_FMT(DISCIO, "Verification checkpoint {} is for a different verification",
+                 m_checkpoint_path);
+    return false;
+  }
+
+  std::vector<CheckpointBlockErrors> block_errors(header.block_error_count);
+  std::vector<CheckpointBlockErrors> unused_block_errors(header.unused_block_error_count);
+  std::vector<u32> corrupt_contents(header.corrupt_content_count);
+  if (!file.ReadArray(block_errors.data(), block_errors.size()) ||
+      !file.ReadArray(unused_block_errors.data(), unused_block_errors.size()) ||
+      !file.ReadArray(corrupt_contents.data(), corrupt_contents.size()))
+  {
+    WARN_LOG_FMT(DISCIO, "Verification checkpoint {} is truncated", m_checkpoint_path);
+    return false;
+  }
+
+  m_chunk_index = header.chunk_index;
+  m_progress = header.progress;
+  m_last_checkpoint_progress = header.progress;
+  m_biggest_verified_offset = header.biggest_verified_offset;
+  m_read_errors_occurred = header.read_errors_occurred != 0;
+  m_calculating_any_hash = header.calculating_any_hash != 0;
+  m_crc32_context = header.crc32;
+  m_md5_context = header.md5;
+  if (m_sha1_context)
+    m_sha1_context->SetState(header.sha1);
+
+  for (const CheckpointBlockErrors& errors : block_errors)
+    m_block_errors[Partition(errors.partition_offset)] = errors.count;
+  for (const CheckpointBlockErrors& errors : unused_block_errors)
+    m_unused_block_errors[Partition(errors.partition_offset)] = errors.count;
+  for (u32 content_id : corrupt_contents)
+    AddProblem(Severity::High, Common::FmtFormatT("Content {0:08x} is corrupt.", content_id));
+  m_corrupt_contents = std::move(corrupt_contents);
+
+  for (size_t i = 0; i < m_chunk_index; ++i)
+  {
+    if (m_chunks[i].content_index)
+      m_content_index++;
+    if (m_chunks[i].group_index)
+      m_group_index++;
+  }
+
+  NOTICE_LOG_FMT(DISCIO, "Resuming verification at {:#x} from {}", m_progress,
+                 m_checkpoint_path);
+  return true;
+}
+
+void VolumeVerifier::SaveCheckpoint()
+{
+  // The hash contexts must contain everything up to m_progress
+  WaitForAsyncOperations();
+
+  const auto to_entries = [](const std::map<Partition, size_t>& errors) {
+    std::vector<CheckpointBlockErrors> entries;
+    for (const auto& [partition, count] : errors)
+      entries.push_back({partition.offset, count});
+    return entries;
+  };
+  const std::vector<CheckpointBlockErrors> block_errors = to_entries(m_block_errors);
+  const std::vector<CheckpointBlockErrors> unused_block_errors = to_entries(m_unused_block_errors);
+
+  CheckpointHeader header{};
+  header.magic = CHECKPOINT_MAGIC;
+  header.version = CHECKPOINT_VERSION;
+  header.raw_size = m_volume.GetRawSize();
+  header.data_size = m_max_progress;
+  header.chunk_count = m_chunks.size();
+  header.chunk_index = m_chunk_index;
+  header.progress = m_progress;
+  header.biggest_verified_offset = m_biggest_verified_offset;
+  header.crc32 = m_crc32_context;
+  header.hashes = GetHashesBits(m_hashes_to_calculate);
+  header.calculating_any_hash = m_calculating_any_hash;
+  header.read_errors_occurred = m_read_errors_occurred;
+  header.block_error_count = static_cast<u32>(block_errors.size());
+  header.unused_block_error_count = static_cast<u32>(unused_block_errors.size());
+  header.corrupt_content_count = static_cast<u32>(m_corrupt_contents.size());
+  header.md5 = m_md5_context;
+  if (m_sha1_context)
+    header.sha1 = m_sha1_context->GetState();
+
+  // Write to a temporary file first so that an interruption can't leave a broken checkpoint
+  const std::string temp_path = m_checkpoint_path + ".tmp";
+  {
+    File::IOFile file(temp_path, "wb");
+    if (!file.WriteArray(&header, 1) ||
+        !file.WriteArray(block_errors.data(), block_errors.size()) ||
+        !file.WriteArray(unused_block_errors.data(), unused_block_errors.size()) ||
+        !file.WriteArray(m_corrupt_contents.data(), m_corrupt_contents.size()))
+    {
+      ERROR_LOG_FMT(DISCIO, "Failed to write verification checkpoint {}", temp_path);
+      return;
+    }
+  }
+
+  if (File::Rename(temp_path, m_checkpoint_path))
+    m_last_checkpoint_progress = m_progress;
 }
 
 u64 VolumeVerifier::GetBytesProcessed() const
@@ -1293,8 +1586,18 @@ void VolumeVerifier::Finish()
     return;
   m_done = true;
 
+  StopReaderThreads();
   WaitForAsyncOperations();
 
+  if (!m_checkpoint_path.empty())
+  {
+    // Keep the checkpoint if verification was cancelled, so that it can be resumed
+    if (m_progress < m_max_progress)
+      SaveCheckpoint();
+    else
+      File::Delete(m_checkpoint_path);
+  }
+
   if (m_calculating_any_hash)
   {
     if (m_hashes_to_calculate.crc32)
@@ -3,11 +3,14 @@
 
 #pragma once
 
+#include <condition_variable>
 #include <future>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include <mbedtls/md5.h>
@@ -128,6 +131,9 @@ public:
   ~VolumeVerifier();
 
   static Hashes<bool> GetDefaultHashesToCalculate();
+  // If set before Start is called, progress is regularly saved to this file, and a verification
+  // that was interrupted earlier is resumed from it. The file is deleted once verification is done.
+  void SetCheckpointPath(std::string path);
   void Start();
   void Process();
   u64 GetBytesProcessed() const;
@@ -144,6 +150,27 @@ private:
     size_t block_index_end;
   };
 
+  // A range of the volume that Process handles in one call. Chunks are planned up front so that
+  // reader threads can work ahead of the hashing.
+  struct ChunkToVerify
+  {
+    u64 offset;
+    u64 bytes_to_read;
+    u64 byte_increment;  // bytes_to_read minus the bytes that the next chunk also reads
+    bool is_data_needed;
+    std::optional<u16> content_index;
+    std::optional<size_t> group_index;
+  };
+
+  struct ChunkResult
+  {
+    bool read_succeeded = false;
+    std::vector<u8> data;  // Only kept if MD5 or SHA-1 is being calculated
+    u32 crc32 = 0;         // Of the first byte_increment bytes
+    bool content_ok = false;
+    std::vector<bool> blocks_ok;
+  };
+
   std::vector<Partition> CheckPartitions();
   bool CheckPartition(const Partition& partition);  // Returns false if partition should be ignored
   std::string GetPartitionName(std::optional<u32> type) const;
@@ -156,8 +183,15 @@ private:
   void CheckMisc();
   void CheckSuperPaperMario();
   void SetUpHashing();
+  void PlanChunks();
+  ChunkResult ReadChunk(const Volume& volume, const ChunkToVerify& chunk) const;
+  void StartReaderThreads();
+  void StopReaderThreads();
+  void ReaderThread(std::unique_ptr<Volume> volume);
+  ChunkResult GetNextChunkResult();
   void WaitForAsyncOperations() const;
-  bool ReadChunkAndWaitForAsyncOperations(u64 bytes_to_read);
+  bool LoadCheckpoint();
+  void SaveCheckpoint();
 
   void AddProblem(Severity severity, std::string text);
 
@@ -178,13 +212,23 @@ private:
   mbedtls_md5_context m_md5_context{};
   std::unique_ptr<Common::SHA1::Context> m_sha1_context;
 
-  u64 m_excess_bytes = 0;
   std::vector<u8> m_data;
-  std::future<void> m_crc32_future;
   std::future<void> m_md5_future;
   std::future<void> m_sha1_future;
-  std::future<void> m_content_future;
-  std::future<void> m_group_future;
+
+  std::vector<ChunkToVerify> m_chunks;
+  size_t m_chunk_index = 0;
+  std::vector<std::thread> m_reader_threads;
+  std::mutex m_reader_mutex;
+  std::condition_variable m_chunk_read_cv;
+  std::condition_variable m_chunk_consumed_cv;
+  std::map<size_t, ChunkResult> m_read_chunks;
+  size_t m_next_chunk_to_read = 0;
+  bool m_stop_readers = false;
+
+  std::string m_checkpoint_path;
+  u64 m_last_checkpoint_progress = 0;
+  std::vector<u32> m_corrupt_contents;
 
   DiscScrubber m_scrubber;
   IOS::ES::TicketReader m_ticket;
@@ -5,11 +5,14 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
+#include <condition_variable>
 #include <cstddef>
 #include <cstring>
-#include <future>
+#include <functional>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <thread>
@@ -23,6 +26,7 @@
 #include "Common/Crypto/SHA1.h"
 #include "Common/Logging/Log.h"
 #include "Common/Swap.h"
+#include "Common/Thread.h"
 
 #include "DiscIO/Blob.h"
 #include "DiscIO/DiscExtractor.h"
@@ -35,6 +39,124 @@
 
 namespace DiscIO
 {
+namespace
+{
+// Hashing and encrypting a group is split into one task per block. Reusing the same threads
+// for every group is much cheaper than spawning a thread per block for every group.
+class GroupWorkers
+{
+public:
+  static GroupWorkers& GetInstance()
+  {
+    static GroupWorkers instance;
+    return instance;
+  }
+
+  // Calls function(i) for every i in [0, count), on the calling thread and the worker threads
+  void ParallelFor(size_t count, const std::function<void(size_t)>& function)
+  {
+    std::unique_lock job_lock(m_job_mutex, std::defer_lock);
+    if (s_running_tasks || m_threads.empty() || !job_lock.try_lock())
+    {
+      // Another thread is using the workers. This happens when converting a disc image,
+      // which already processes several groups in parallel.
+      for (size_t i = 0; i < count; ++i)
+        function(i);
+      return;
+    }
+
+    {
+      std::lock_guard lk(m_mutex);
+      m_function = &function;
+      m_count = count;
+      m_next_index = 0;
+      m_busy_workers = m_threads.size();
+      ++m_generation;
+    }
+    m_work_cv.notify_all();
+
+    RunTasks();
+
+    std::unique_lock lk(m_mutex);
+    m_done_cv.wait(lk, [this] { return m_busy_workers == 0; });
+    m_function = nullptr;
+  }
+
+private:
+  GroupWorkers()
+  {
+    const unsigned int threads = std::min<unsigned int>(
+        VolumeWii::BLOCKS_PER_GROUP, std::max(1U, std::thread::hardware_concurrency()));
+
+    // The calling thread also runs tasks
+    for (unsigned int i = 1; i < threads; ++i)
+      m_threads.emplace_back(&GroupWorkers::WorkerMain, this);
+  }
+
+  ~GroupWorkers()
+  {
+    {
+      std::lock_guard lk(m_mutex);
+      m_exiting = true;
+    }
+    m_work_cv.notify_all();
+
+    for (std::thread& thread : m_threads)
+      thread.join();
+  }
+
+  void WorkerMain()
+  {
+    Common::SetCurrentThreadName("Wii group hashing");
+
+    u64 last_generation = 0;
+    while (true)
+    {
+      {
+        std::unique_lock lk(m_mutex);
+        m_work_cv.wait(lk, [&] { return m_exiting || m_generation != last_generation; });
+        if (m_exiting)
+          return;
+        last_generation = m_generation;
+      }
+
+      RunTasks();
+
+      std::lock_guard lk(m_mutex);
+      if (--m_busy_workers == 0)
+        m_done_cv.notify_one();
+    }
+  }
+
+  void RunTasks()
+  {
+    s_running_tasks = true;
+    size_t i;
+    while ((i = m_next_index.fetch_add(1)) < m_count)
+      (*m_function)(i);
+    s_running_tasks = false;
+  }
+
+  // Lets tasks that use ParallelFor themselves run serially instead of deadlocking
+  static thread_local bool s_running_tasks;
+
+  std::vector<std::thread> m_threads;
+  std::mutex m_job_mutex;
+
+  std::mutex m_mutex;
+  std::condition_variable m_work_cv;
+  std::condition_variable m_done_cv;
+  const std::function<void(size_t)>* m_function = nullptr;
+  size_t m_count = 0;
+  std::atomic<size_t> m_next_index = 0;
+  size_t m_busy_workers = 0;
+  u64 m_generation = 0;
+  bool m_exiting = false;
+};
+
+thread_local bool GroupWorkers::s_running_tasks = false;
+}  // namespace
+
 VolumeWii::VolumeWii(std::unique_ptr<BlobReader> reader)
     : m_reader(std::move(reader)), m_game_partition(PARTITION_NONE),
       m_last_decrypted_block(UINT64_MAX)
@@ -240,6 +362,56 @@ bool VolumeWii::Read(u64 offset, u64 length, u8* buffer, const Partition& partit
   return true;
 }
 
+const u8* VolumeWii::GetMappedData(u64 offset, u64 length, const Partition& partition) const
+{
+  if (partition == PARTITION_NONE)
+    return m_reader->GetMappedData(offset, length);
+
+  // Encrypted data has to be decrypted into a buffer, so it can never be accessed in place
+  if (m_has_encryption)
+    return nullptr;
+
+  auto it = m_partitions.find(partition);
+  if (it == m_partitions.end())
+    return nullptr;
+
+  const u64 partition_data_offset = partition.offset + *it->second.data_offset;
+  if (!m_has_hashes)
+    return m_reader->GetMappedData(partition_data_offset + offset, length);
+
+  // With hashes, the data is only contiguous on the disc if it doesn't cross a block boundary
+  const u64 data_offset_in_block = offset % BLOCK_DATA_SIZE;
+  if (data_offset_in_block + length > BLOCK_DATA_SIZE)
+    return nullptr;
+
+  const u64 block_offset_on_disc =
+      partition_data_offset + offset / BLOCK_DATA_SIZE * BLOCK_TOTAL_SIZE;
+  return m_reader->GetMappedData(block_offset_on_disc + BLOCK_HEADER_SIZE + data_offset_in_block,
+                                 length);
+}
+
+bool VolumeWii::SubmitRead(u64 offset, u64 length, u8* buffer, const Partition& partition) const
+{
+  if (partition == PARTITION_NONE)
+    return m_reader->SubmitRead(offset, length, buffer);
+
+  // Partitions with hashes or encryption have to be read through the decryption buffer
+  if (m_has_hashes || m_has_encryption)
+    return false;
+
+  auto it = m_partitions.find(partition);
+  if (it == m_partitions.end())
+    return false;
+
+  const u64 partition_data_offset = partition.offset + *it->second.data_offset;
+  return m_reader->SubmitRead(partition_data_offset + offset, length, buffer);
+}
+
+bool VolumeWii::CompleteRead() const
+{
+  return m_reader->CompleteRead();
+}
+
 bool VolumeWii::HasWiiHashes() const
 {
   return m_has_hashes;
@@ -512,71 +684,63 @@ bool VolumeWii::HashGroup(const std::array<u8, BLOCK_DATA_SIZE> in[BLOCKS_PER_GR
                           HashBlock out[BLOCKS_PER_GROUP],
                           const std::function<bool(size_t block)>& read_function)
 {
-  std::array<std::future<void>, BLOCKS_PER_GROUP> hash_futures;
-  bool success = true;
-
-  for (size_t i = 0; i < BLOCKS_PER_GROUP; ++i)
-  {
-    if (read_function && success)
-      success = read_function(i);
-
-    hash_futures[i] = std::async(std::launch::async, [&in, &out, &hash_futures, success, i]() {
-      const size_t h1_base = Common::AlignDown(i, 8);
-
-      if (success)
-      {
-        // H0 hashes
-        for (size_t j = 0; j < 31; ++j)
-          out[i].h0[j] = Common::SHA1::CalculateDigest(in[i].data() + j * 0x400, 0x400);
+  // Blocks are claimed in order, so the reads happen in order even though each one is done by
+  // whichever thread is going to hash the block
+  std::mutex read_mutex;
+  std::condition_variable read_cv;
+  size_t blocks_read = 0;
+  std::atomic<bool> success = true;
 
-        // H0 padding
-        out[i].padding_0 = {};
+  GroupWorkers::GetInstance().ParallelFor(BLOCKS_PER_GROUP, [&](size_t i) {
+    if (read_function)
+    {
+      std::unique_lock lk(read_mutex);
+      read_cv.wait(lk, [&] { return blocks_read == i; });
+      if (success && !read_function(i))
+        success = false;
+      ++blocks_read;
+      read_cv.notify_all();
+    }
 
-        // H1 hash
-        out[h1_base].h1[i - h1_base] = Common::SHA1::CalculateDigest(out[i].h0);
-      }
+    if (!success)
+      return;
 
-      if (i % 8 == 7)
-      {
-        for (size_t j = 0; j < 7; ++j)
-          hash_futures[h1_base + j].get();
+    // H0 hashes
+    for (size_t j = 0; j < 31; ++j)
+      out[i].h0[j] = Common::SHA1::CalculateDigest(in[i].data() + j * 0x400, 0x400);
 
-        if (success)
-        {
-          // H1 padding
-          out[h1_base].padding_1 = {};
+    // H0 padding
+    out[i].padding_0 = {};
 
-          // H1 copies
-          for (size_t j = 1; j < 8; ++j)
-            out[h1_base + j].h1 = out[h1_base].h1;
+    // H1 hash
+    const size_t h1_base = Common::AlignDown(i, 8);
+    out[h1_base].h1[i - h1_base] = Common::SHA1::CalculateDigest(out[i].h0);
+  });
 
-          // H2 hash
-          out[0].h2[h1_base / 8] = Common::SHA1::CalculateDigest(out[i].h1);
-        }
+  if (!success)
+    return false;
 
-        if (i == BLOCKS_PER_GROUP - 1)
-        {
-          for (size_t j = 0; j < 7; ++j)
-            hash_futures[j * 8 + 7].get();
+  for (size_t h1_base = 0; h1_base < BLOCKS_PER_GROUP; h1_base += 8)
+  {
+    // H1 padding
+    out[h1_base].padding_1 = {};
 
-          if (success)
-          {
-            // H2 padding
-            out[0].padding_2 = {};
+    // H1 copies
+    for (size_t j = 1; j < 8; ++j)
+      out[h1_base + j].h1 = out[h1_base].h1;
 
-            // H2 copies
-            for (size_t j = 1; j < BLOCKS_PER_GROUP; ++j)
-              out[j].h2 = out[0].h2;
-          }
-        }
-      }
-    });
+    // H2 hash
+    out[0].h2[h1_base / 8] = Common::SHA1::CalculateDigest(out[h1_base].h1);
   }
 
-  // Wait for all the async tasks to finish
-  hash_futures.back().get();
+  // H2 padding
+  out[0].padding_2 = {};
 
-  return success;
+  // H2 copies
+  for (size_t j = 1; j < BLOCKS_PER_GROUP; ++j)
+    out[j].h2 = out[0].h2;
+
+  return true;
 }
 
 bool VolumeWii::EncryptGroup(
@@ -611,34 +775,17 @@ bool VolumeWii::EncryptGroup(
   if (hash_exception_callback)
     hash_exception_callback(unencrypted_hashes.data());
 
-  const unsigned int threads =
-      std::min(BLOCKS_PER_GROUP, std::max<unsigned int>(1, std::thread::hardware_concurrency()));
-
-  std::vector<std::future<void>> encryption_futures(threads);
-
   auto aes_context = Common::AES::CreateContextEncrypt(key.data());
 
-  for (size_t i = 0; i < threads; ++i)
-  {
-    encryption_futures[i] = std::async(
-        std::launch::async,
-        [&unencrypted_data, &unencrypted_hashes, &aes_context, &out](size_t start, size_t end) {
-          for (size_t j = start; j < end; ++j)
-          {
-            u8* out_ptr = out->data() + j * BLOCK_TOTAL_SIZE;
-
-            aes_context->CryptIvZero(reinterpret_cast<u8*>(&unencrypted_hashes[j]), out_ptr,
-                                     BLOCK_HEADER_SIZE);
+  GroupWorkers::GetInstance().ParallelFor(BLOCKS_PER_GROUP, [&](size_t i) {
+    u8* out_ptr = out->data() + i * BLOCK_TOTAL_SIZE;
 
-            aes_context->Crypt(out_ptr + 0x3D0, unencrypted_data[j].data(),
-                               out_ptr + BLOCK_HEADER_SIZE, BLOCK_DATA_SIZE);
-          }
-        },
-        i * BLOCKS_PER_GROUP / threads, (i + 1) * BLOCKS_PER_GROUP / threads);
-  }
+    aes_context->CryptIvZero(reinterpret_cast<u8*>(&unencrypted_hashes[i]), out_ptr,
+                             BLOCK_HEADER_SIZE);
 
-  for (std::future<void>& future : encryption_futures)
-    future.get();
+    aes_context->Crypt(out_ptr + 0x3D0, unencrypted_data[i].data(), out_ptr + BLOCK_HEADER_SIZE,
+                       BLOCK_DATA_SIZE);
+  });
 
   return true;
 }
@@ -60,6 +60,9 @@ public:
   VolumeWii(std::unique_ptr<BlobReader> reader);
   ~VolumeWii();
   bool Read(u64 offset, u64 length, u8* buffer, const Partition& partition) const override;
+  const u8* GetMappedData(u64 offset, u64 length, const Partition& partition) const override;
+  bool SubmitRead(u64 offset, u64 length, u8* buffer, const Partition& partition) const override;
+  bool CompleteRead() const override;
   bool HasWiiHashes() const override;
   bool HasWiiEncryption() const override;
   std::vector<Partition> GetPartitions() const override;
@@ -94,7 +97,8 @@ public:
 
   // The in parameter can either contain all the data to begin with,
   // or read_function can write data into the in parameter when called.
-  // The latter lets reading run in parallel with hashing.
+  // The latter lets reading run in parallel with hashing. read_function is called once per
+  // block in order, but not necessarily on the calling thread.
   // This function returns false iff read_function returns false.
   static bool HashGroup(const std::array<u8, BLOCK_DATA_SIZE> in[BLOCKS_PER_GROUP],
                         HashBlock out[BLOCKS_PER_GROUP],
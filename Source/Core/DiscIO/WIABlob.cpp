@@ -24,10 +24,13 @@
 #include "Common/FileUtil.h"
 #include "Common/IOFile.h"
 #include "Common/Logging/Log.h"
+#include "Common/MemoryAccounting.h"
 #include "Common/MsgHandler.h"
 #include "Common/ScopeGuard.h"
 #include "Common/Swap.h"
 
+#include "Core/Config/MainSettings.h"
+
 #include "DiscIO/Blob.h"
 #include "DiscIO/DiscUtils.h"
 #include "DiscIO/Filesystem.h"
@@ -82,10 +85,29 @@ WIARVZFileReader<RVZ>::WIARVZFileReader(File::IOFile file, const std::string& pa
     : m_file(std::move(file)), m_path(path), m_encryption_cache(this)
 {
   m_valid = Initialize(path);
+
+  const int read_ahead_cache_size = Config::Get(Config::MAIN_WIA_READ_AHEAD_CACHE_SIZE);
+  if (m_valid && read_ahead_cache_size > 0)
+  {
+    m_read_ahead = std::make_unique<ReadAheadCache>();
+    m_read_ahead->memory_limit = static_cast<size_t>(read_ahead_cache_size) * 1024 * 1024;
+    Common::MemoryAccounting::SetBudget(Common::MemoryAccounting::Subsystem::DiscCache,
+                                        m_read_ahead->memory_limit);
+  }
 }
 
 template <bool RVZ>
-WIARVZFileReader<RVZ>::~WIARVZFileReader() = default;
+WIARVZFileReader<RVZ>::~WIARVZFileReader()
+{
+  // Don't wait for chunks that nobody is going to read anymore.
+  if (m_read_ahead)
+  {
+    for (auto& worker : m_read_ahead->workers)
+      worker.Shutdown(true);
+    Common::MemoryAccounting::Remove(Common::MemoryAccounting::Subsystem::DiscCache,
+                                     m_read_ahead->memory_usage);
+  }
+}
 
 template <bool RVZ>
 bool WIARVZFileReader<RVZ>::Initialize(const std::string& path)
@@ -158,6 +180,29 @@ bool WIARVZFileReader<RVZ>::Initialize(const std::string& path)
     return false;
   }
 
+  if (RVZ && m_compression_type == WIARVZCompressionType::Zstd &&
+      file_version >= RVZ_VERSION_DICTIONARY_WRITE_COMPATIBLE &&
+      header_2_size >= sizeof(WIAHeader2) + sizeof(RVZDictionaryHeader))
+  {
+    RVZDictionaryHeader dictionary_header;
+    std::memcpy(&dictionary_header, header_2.data() + sizeof(WIAHeader2),
+                sizeof(RVZDictionaryHeader));
+
+    std::vector<u8> dictionary(Common::swap32(dictionary_header.dictionary_size));
+    if (!m_file.Seek(Common::swap64(dictionary_header.dictionary_offset),
+                     File::SeekOrigin::Begin) ||
+        !m_file.ReadBytes(dictionary.data(), dictionary.size()) ||
+        Common::SHA1::CalculateDigest(dictionary) != dictionary_header.dictionary_hash)
+    {
+      ERROR_LOG_FMT(DISCIO, "Failed to read the Zstandard dictionary of {}", path);
+      return false;
+    }
+
+    m_zstd_dictionary.reset(ZSTD_createDDict(dictionary.data(), dictionary.size()));
+    if (!m_zstd_dictionary)
+      return false;
+  }
+
   const size_t number_of_partition_entries = Common::swap32(m_header_2.number_of_partition_entries);
   const size_t partition_entry_size = Common::swap32(m_header_2.partition_entry_size);
   std::vector<u8> partition_entries(partition_entry_size * number_of_partition_entries);
@@ -507,38 +552,48 @@ bool WIARVZFileReader<RVZ>::ReadFromGroups(u64* offset, u64* size, u8** out_ptr,
     if (total_group_index >= m_group_entries.size())
       return false;
 
-    const GroupEntry group = m_group_entries[total_group_index];
     const u64 group_offset_in_data = i * chunk_size;
     const u64 offset_in_group = *offset - group_offset_in_data - data_offset;
 
+    const u64 full_chunk_size = chunk_size;
     chunk_size = std::min(chunk_size, data_size - group_offset_in_data);
 
     const u64 bytes_to_read = std::min(chunk_size - offset_in_group, *size);
-    u32 group_data_size = Common::swap32(group.data_size);
 
-    WIARVZCompressionType compression_type = m_compression_type;
-    u32 rvz_packed_size = 0;
-    if constexpr (RVZ)
+    // Moving on to the following group means we're in a sequential read stream, so start
+    // decompressing the groups after it in the background.
+    if (m_read_ahead && total_group_index != m_last_read_group_index)
     {
-      if ((group_data_size & 0x80000000) == 0)
-        compression_type = WIARVZCompressionType::None;
-
-      group_data_size &= 0x7FFFFFFF;
-
-      rvz_packed_size = Common::swap32(group.rvz_packed_size);
+      if (total_group_index == m_last_read_group_index + 1)
+      {
+        const u64 last_index = std::min<u64>(i + READ_AHEAD_DISTANCE, number_of_groups - 1);
+        for (u64 j = i + 1; j <= last_index; ++j)
+        {
+          const u64 offset_in_data = j * full_chunk_size;
+          ChunkParameters parameters;
+          if (GetGroupChunkParameters(group_index + j, offset_in_data,
+                                      std::min(full_chunk_size, data_size - offset_in_data),
+                                      exception_lists, &parameters))
+          {
+            QueueReadAhead(parameters);
+          }
+        }
+      }
+      m_last_read_group_index = total_group_index;
     }
 
-    if (group_data_size == 0)
+    ChunkParameters parameters;
+    if (!GetGroupChunkParameters(total_group_index, group_offset_in_data, chunk_size,
+                                 exception_lists, &parameters))
     {
       std::memset(*out_ptr, 0, bytes_to_read);
     }
     else
     {
-      const u64 group_offset_in_file = static_cast<u64>(Common::swap32(group.data_offset)) << 2;
-
-      Chunk& chunk =
-          ReadCompressedData(group_offset_in_file, group_data_size, chunk_size, compression_type,
-                             exception_lists, rvz_packed_size, group_offset_in_data);
+      Chunk& chunk = ReadCompressedData(
+          parameters.offset_in_file, parameters.compressed_size, parameters.decompressed_size,
+          parameters.compression_type, parameters.exception_lists, parameters.rvz_packed_size,
+          parameters.data_offset);
 
       if (!chunk.Read(offset_in_group, bytes_to_read, *out_ptr))
       {
@@ -565,6 +620,39 @@ bool WIARVZFileReader<RVZ>::ReadFromGroups(u64* offset, u64* size, u8** out_ptr,
   return true;
 }
 
+template <bool RVZ>
+bool WIARVZFileReader<RVZ>::GetGroupChunkParameters(u64 total_group_index,
+                                                    u64 group_offset_in_data, u64 chunk_size,
+                                                    u32 exception_lists,
+                                                    ChunkParameters* parameters) const
+{
+  if (total_group_index >= m_group_entries.size())
+    return false;
+
+  const GroupEntry& group = m_group_entries[total_group_index];
+  u32 group_data_size = Common::swap32(group.data_size);
+
+  WIARVZCompressionType compression_type = m_compression_type;
+  u32 rvz_packed_size = 0;
+  if constexpr (RVZ)
+  {
+    if ((group_data_size & 0x80000000) == 0)
+      compression_type = WIARVZCompressionType::None;
+
+    group_data_size &= 0x7FFFFFFF;
+
+    rvz_packed_size = Common::swap32(group.rvz_packed_size);
+  }
+
+  if (group_data_size == 0)
+    return false;
+
+  const u64 group_offset_in_file = static_cast<u64>(Common::swap32(group.data_offset)) << 2;
+  *parameters = {group_offset_in_file, group_data_size, chunk_size,         compression_type,
+                 exception_lists,      rvz_packed_size, group_offset_in_data};
+  return true;
+}
+
 template <bool RVZ>
 typename WIARVZFileReader<RVZ>::Chunk&
 WIARVZFileReader<RVZ>::ReadCompressedData(u64 offset_in_file, u64 compressed_size,
@@ -575,8 +663,55 @@ WIARVZFileReader<RVZ>::ReadCompressedData(u64 offset_in_file, u64 compressed_siz
   if (offset_in_file == m_cached_chunk_offset)
     return m_cached_chunk;
 
+  const ChunkParameters parameters{offset_in_file,   compressed_size, decompressed_size,
+                                   compression_type, exception_lists, rvz_packed_size,
+                                   data_offset};
+
+  if (m_read_ahead)
+  {
+    std::unique_lock lk(m_read_ahead->mutex);
+
+    // Wait for a worker which is already decompressing this chunk instead of doing it twice.
+    m_read_ahead->chunk_ready.wait(
+        lk, [&] { return !m_read_ahead->pending.contains(offset_in_file); });
+
+    // Keep the previous chunk around for re-reads, but prefer evicting it over read-ahead chunks.
+    if (m_cached_chunk_offset != std::numeric_limits<u64>::max())
+    {
+      InsertReadAheadChunk(m_cached_chunk_offset,
+                           std::make_unique<Chunk>(std::move(m_cached_chunk)), false);
+      m_cached_chunk_offset = std::numeric_limits<u64>::max();
+    }
+
+    auto& chunks = m_read_ahead->chunks;
+    const auto it = std::find_if(chunks.begin(), chunks.end(),
+                                 [&](const auto& entry) { return entry.first == offset_in_file; });
+    if (it != chunks.end())
+    {
+      m_read_ahead->memory_usage -= it->second->GetMemoryUsage();
+      Common::MemoryAccounting::Remove(Common::MemoryAccounting::Subsystem::DiscCache,
+                                       it->second->GetMemoryUsage());
+      m_cached_chunk = std::move(*it->second);
+      chunks.erase(it);
+      m_cached_chunk_offset = offset_in_file;
+      return m_cached_chunk;
+    }
+  }
+
+  m_cached_chunk = CreateChunk(&m_file, parameters);
+  m_cached_chunk_offset = offset_in_file;
+  return m_cached_chunk;
+}
+
+template <bool RVZ>
+typename WIARVZFileReader<RVZ>::Chunk
+WIARVZFileReader<RVZ>::CreateChunk(File::IOFile* file, const ChunkParameters& parameters) const
+{
+  const u64 decompressed_size = parameters.decompressed_size;
+  const u32 rvz_packed_size = parameters.rvz_packed_size;
+
   std::unique_ptr<Decompressor> decompressor;
-  switch (compression_type)
+  switch (parameters.compression_type)
   {
   case WIARVZCompressionType::None:
     decompressor = std::make_unique<NoneDecompressor>();
@@ -597,17 +732,104 @@ WIARVZFileReader<RVZ>::ReadCompressedData(u64 offset_in_file, u64 compressed_siz
                                                       m_header_2.compressor_data_size);
     break;
   case WIARVZCompressionType::Zstd:
-    decompressor = std::make_unique<ZstdDecompressor>();
+    decompressor = std::make_unique<ZstdDecompressor>(m_zstd_dictionary.get());
     break;
   }
 
-  const bool compressed_exception_lists = compression_type > WIARVZCompressionType::Purge;
+  const bool compressed_exception_lists =
+      parameters.compression_type > WIARVZCompressionType::Purge;
 
-  m_cached_chunk =
-      Chunk(&m_file, offset_in_file, compressed_size, decompressed_size, exception_lists,
-            compressed_exception_lists, rvz_packed_size, data_offset, std::move(decompressor));
-  m_cached_chunk_offset = offset_in_file;
-  return m_cached_chunk;
+  return Chunk(file, parameters.offset_in_file, parameters.compressed_size, decompressed_size,
+               parameters.exception_lists, compressed_exception_lists, rvz_packed_size,
+               parameters.data_offset, std::move(decompressor));
+}
+
+template <bool RVZ>
+void WIARVZFileReader<RVZ>::QueueReadAhead(const ChunkParameters& parameters)
+{
+  const u64 offset_in_file = parameters.offset_in_file;
+  if (offset_in_file == m_cached_chunk_offset)
+    return;
+
+  std::lock_guard lk(m_read_ahead->mutex);
+  if (m_read_ahead->pending.contains(offset_in_file) ||
+      std::any_of(m_read_ahead->chunks.begin(), m_read_ahead->chunks.end(),
+                  [&](const auto& entry) { return entry.first == offset_in_file; }))
+  {
+    return;
+  }
+
+  // Only fill the cache with chunks which fit next to the ones already being decompressed.
+  const size_t chunk_memory_usage = parameters.compressed_size + parameters.decompressed_size;
+  if ((m_read_ahead->pending.size() + 1) * chunk_memory_usage > m_read_ahead->memory_limit)
+    return;
+
+  // The workers are started on the first sequential read, so that readers which are only used
+  // for a few random accesses (e.g. by the game list) don't spawn any threads.
+  if (!m_read_ahead->files[0].IsOpen())
+  {
+    for (size_t i = 0; i < NUM_READ_AHEAD_WORKERS; ++i)
+    {
+      if (!m_read_ahead->files[i].Open(m_path, "rb"))
+      {
+        WARN_LOG_FMT(DISCIO, "Failed to open {} for read-ahead, disabling it", m_path);
+        for (File::IOFile& file : m_read_ahead->files)
+          file.Close();
+        m_read_ahead->memory_limit = 0;
+        return;
+      }
+
+      File::IOFile* file = &m_read_ahead->files[i];
+      m_read_ahead->workers[i].Reset("WIA/RVZ Read-Ahead",
+                                     [this, file](ChunkParameters chunk_parameters) {
+                                       ReadAheadWorker(file, chunk_parameters);
+                                     });
+    }
+  }
+
+  m_read_ahead->pending.insert(offset_in_file);
+  m_read_ahead->workers[m_read_ahead->next_worker].Push(parameters);
+  m_read_ahead->next_worker = (m_read_ahead->next_worker + 1) % NUM_READ_AHEAD_WORKERS;
+}
+
+template <bool RVZ>
+void WIARVZFileReader<RVZ>::ReadAheadWorker(File::IOFile* file, const ChunkParameters& parameters)
+{
+  auto chunk = std::make_unique<Chunk>(CreateChunk(file, parameters));
+  const bool success = chunk->DecompressAll();
+
+  {
+    std::lock_guard lk(m_read_ahead->mutex);
+    m_read_ahead->pending.erase(parameters.offset_in_file);
+
+    // A failed chunk is decompressed again (and reported) by the reading thread.
+    if (success)
+      InsertReadAheadChunk(parameters.offset_in_file, std::move(chunk), true);
+  }
+
+  m_read_ahead->chunk_ready.notify_all();
+}
+
+template <bool RVZ>
+void WIARVZFileReader<RVZ>::InsertReadAheadChunk(u64 offset_in_file, std::unique_ptr<Chunk> chunk,
+                                                 bool most_recent)
+{
+  auto& chunks = m_read_ahead->chunks;
+  m_read_ahead->memory_usage += chunk->GetMemoryUsage();
+  Common::MemoryAccounting::Add(Common::MemoryAccounting::Subsystem::DiscCache,
+                                chunk->GetMemoryUsage());
+  if (most_recent)
+    chunks.emplace_front(offset_in_file, std::move(chunk));
+  else
+    chunks.emplace_back(offset_in_file, std::move(chunk));
+
+  while (!chunks.empty() && m_read_ahead->memory_usage > m_read_ahead->memory_limit)
+  {
+    m_read_ahead->memory_usage -= chunks.back().second->GetMemoryUsage();
+    Common::MemoryAccounting::Remove(Common::MemoryAccounting::Subsystem::DiscCache,
+                                     chunks.back().second->GetMemoryUsage());
+    chunks.pop_back();
+  }
 }
 
 template <bool RVZ>
@@ -657,10 +879,29 @@ bool WIARVZFileReader<RVZ>::Chunk::Read(u64 offset, u64 size, u8* out_ptr)
     return false;
   }
 
-  while (offset + size > GetOutBytesWrittenExcludingExceptions())
+  if (!DecompressUntil(offset + size))
+    return false;
+
+  std::memcpy(out_ptr, m_out.data.data() + offset + m_out_bytes_used_for_exceptions, size);
+  return true;
+}
+
+template <bool RVZ>
+bool WIARVZFileReader<RVZ>::Chunk::DecompressAll()
+{
+  if (!m_decompressor || !m_file)
+    return false;
+
+  return DecompressUntil(m_out.data.size() - m_out_bytes_allocated_for_exceptions);
+}
+
+template <bool RVZ>
+bool WIARVZFileReader<RVZ>::Chunk::DecompressUntil(u64 end_offset)
+{
+  while (end_offset > GetOutBytesWrittenExcludingExceptions())
   {
     u64 bytes_to_read;
-    if (offset + size == m_out.data.size())
+    if (end_offset == m_out.data.size())
     {
       // Read all the remaining data.
       bytes_to_read = m_in.data.size() - m_in.bytes_written;
@@ -673,7 +914,7 @@ bool WIARVZFileReader<RVZ>::Chunk::Read(u64 offset, u64 size, u8* out_ptr)
 
       // The compressed data is probably not much bigger than the decompressed data.
       // Add a few bytes for possible compression overhead and for any hash exceptions.
-      bytes_to_read = offset + size - GetOutBytesWrittenExcludingExceptions() + 0x100;
+      bytes_to_read = end_offset - GetOutBytesWrittenExcludingExceptions() + 0x100;
 
       // Align the access in an attempt to gain speed. But we don't actually know the
       // block size of the underlying storage device, so we just use the Wii block size.
@@ -753,7 +994,6 @@ bool WIARVZFileReader<RVZ>::Chunk::Read(u64 offset, u64 size, u8* out_ptr)
     }
   }
 
-  std::memcpy(out_ptr, m_out.data.data() + offset + m_out_bytes_used_for_exceptions, size);
   return true;
 }
 
@@ -1061,7 +1301,8 @@ std::optional<std::vector<u8>> WIARVZFileReader<RVZ>::Compress(Compressor* compr
 template <bool RVZ>
 void WIARVZFileReader<RVZ>::SetUpCompressor(std::unique_ptr<Compressor>* compressor,
                                             WIARVZCompressionType compression_type,
-                                            int compression_level, WIAHeader2* header_2)
+                                            int compression_level,
+                                            const ZSTD_CDict* zstd_dictionary, WIAHeader2* header_2)
 {
   switch (compression_type)
   {
@@ -1092,11 +1333,117 @@ void WIARVZFileReader<RVZ>::SetUpCompressor(std::unique_ptr<Compressor>* compres
     break;
   }
   case WIARVZCompressionType::Zstd:
-    *compressor = std::make_unique<ZstdCompressor>(compression_level);
+    *compressor = std::make_unique<ZstdCompressor>(compression_level, zstd_dictionary);
     break;
   }
 }
 
+template <bool RVZ>
+std::vector<u8>
+WIARVZFileReader<RVZ>::BuildZstdDictionary(BlobReader* infile,
+                                           const std::vector<PartitionEntry>& partition_entries,
+                                           const std::vector<RawDataEntry>& raw_data_entries)
+{
+  // The bundled zstd doesn't include the dictionary trainer, so the dictionary is raw content:
+  // samples of the data as it will be compressed (that is, decrypted for Wii partitions) taken
+  // evenly spread over the disc, which chunks can then refer back to.
+  struct SampleRange
+  {
+    u64 offset_in_file;
+    u64 size;
+    const PartitionEntry* partition_entry;
+  };
+
+  std::vector<SampleRange> ranges;
+  u64 total_size = 0;
+  for (const PartitionEntry& partition_entry : partition_entries)
+  {
+    for (const PartitionDataEntry& data_entry : partition_entry.data_entries)
+    {
+      const u64 size = u64(Common::swap32(data_entry.number_of_sectors)) *
+                       VolumeWii::BLOCK_DATA_SIZE;
+      if (size == 0)
+        continue;
+
+      ranges.push_back({u64(Common::swap32(data_entry.first_sector)) * VolumeWii::BLOCK_TOTAL_SIZE,
+                        size, &partition_entry});
+      total_size += size;
+    }
+  }
+  for (const RawDataEntry& raw_data_entry : raw_data_entries)
+  {
+    const u64 size = Common::swap64(raw_data_entry.data_size);
+    if (size < ZSTD_DICTIONARY_SAMPLE_SIZE)
+      continue;
+
+    ranges.push_back({Common::swap64(raw_data_entry.data_offset), size, nullptr});
+    total_size += size;
+  }
+
+  // Consider more positions than needed, since some of them will be skipped
+  const u64 candidates = ZSTD_DICTIONARY_MAX_SAMPLES * 4;
+  const u64 stride = total_size / candidates;
+  if (stride < ZSTD_DICTIONARY_SAMPLE_SIZE)
+    return {};
+
+  std::vector<u8> dictionary;
+  std::vector<u8> sample(ZSTD_DICTIONARY_SAMPLE_SIZE);
+  std::vector<u8> block(VolumeWii::BLOCK_TOTAL_SIZE);
+  std::vector<u8> block_data(VolumeWii::BLOCK_DATA_SIZE);
+  std::vector<u8> compressed(ZSTD_compressBound(sample.size()));
+
+  size_t range_index = 0;
+  u64 range_start = 0;
+  for (u64 i = 0; i < candidates; ++i)
+  {
+    if (dictionary.size() >= ZSTD_DICTIONARY_MAX_SAMPLES * ZSTD_DICTIONARY_SAMPLE_SIZE)
+      break;
+
+    const u64 position = i * stride;
+    while (position >= range_start + ranges[range_index].size)
+      range_start += ranges[range_index++].size;
+
+    const SampleRange& range = ranges[range_index];
+    const u64 offset_in_range = position - range_start;
+    if (range.partition_entry)
+    {
+      const u64 block_index = offset_in_range / VolumeWii::BLOCK_DATA_SIZE;
+      const u64 offset_in_block = std::min<u64>(offset_in_range % VolumeWii::BLOCK_DATA_SIZE,
+                                                VolumeWii::BLOCK_DATA_SIZE - sample.size());
+      if (!infile->Read(range.offset_in_file + block_index * VolumeWii::BLOCK_TOTAL_SIZE,
+                        block.size(), block.data()))
+      {
+        continue;
+      }
+
+      const auto aes_context =
+          Common::AES::CreateContextDecrypt(range.partition_entry->partition_key.data());
+      VolumeWii::DecryptBlockData(block.data(), block_data.data(), aes_context.get());
+      std::copy_n(block_data.data() + offset_in_block, sample.size(), sample.data());
+    }
+    else
+    {
+      const u64 offset = std::min<u64>(offset_in_range, range.size - sample.size());
+      if (!infile->Read(range.offset_in_file + offset, sample.size(), sample.data()))
+        continue;
+    }
+
+    // Skip samples that barely compress (junk data or already compressed files) as well as
+    // samples that compress very well on their own (such as zeroes)
+    const size_t compressed_size =
+        ZSTD_compress(compressed.data(), compressed.size(), sample.data(), sample.size(), 1);
+    if (ZSTD_isError(compressed_size) || compressed_size > sample.size() * 3 / 4 ||
+        compressed_size < sample.size() / 64)
+    {
+      continue;
+    }
+
+    dictionary.insert(dictionary.end(), sample.begin(), sample.end());
+  }
+
+  return dictionary;
+}
+
 template <bool RVZ>
 bool WIARVZFileReader<RVZ>::TryReuse(std::map<ReuseID, GroupEntry>* reusable_groups,
                                      std::mutex* reusable_groups_mutex,
@@ -1735,7 +2082,8 @@ template <bool RVZ>
 ConversionResultCode
 WIARVZFileReader<RVZ>::Convert(BlobReader* infile, const VolumeDisc* infile_volume,
                                File::IOFile* outfile, WIARVZCompressionType compression_type,
-                               int compression_level, int chunk_size, CompressCB callback)
+                               int compression_level, int chunk_size, bool use_zstd_dictionary,
+                               CompressCB callback)
 {
   ASSERT(infile->GetDataSizeType() == DataSizeType::Accurate);
   ASSERT(chunk_size > 0);
@@ -1771,6 +2119,23 @@ WIARVZFileReader<RVZ>::Convert(BlobReader* infile, const VolumeDisc* infile_volu
 
   group_entries.resize(total_groups);
 
+  // Chunks are compressed independently, so small chunks compress poorly without a dictionary
+  std::vector<u8> zstd_dictionary_data;
+  ZstdCompressionDictionary zstd_dictionary;
+  if (RVZ && use_zstd_dictionary && compression_type == WIARVZCompressionType::Zstd)
+  {
+    zstd_dictionary_data = BuildZstdDictionary(infile, partition_entries, raw_data_entries);
+    if (!zstd_dictionary_data.empty())
+    {
+      zstd_dictionary.reset(ZSTD_createCDict(zstd_dictionary_data.data(),
+                                             zstd_dictionary_data.size(), compression_level));
+      if (!zstd_dictionary)
+        return ConversionResultCode::InternalError;
+    }
+  }
+  const u32 header_2_size =
+      sizeof(WIAHeader2) + (zstd_dictionary ? sizeof(RVZDictionaryHeader) : 0);
+
   const size_t partition_entries_size = partition_entries.size() * sizeof(PartitionEntry);
   const size_t raw_data_entries_size = raw_data_entries.size() * sizeof(RawDataEntry);
   const size_t group_entries_size = group_entries.size() * sizeof(GroupEntry);
@@ -1780,8 +2145,8 @@ WIARVZFileReader<RVZ>::Convert(BlobReader* infile, const VolumeDisc* infile_volu
   // fit in that space, we will need to write them at the end of the file instead.
   const u64 headers_size_upper_bound = [&] {
     // 0x100 is added to account for compression overhead (in particular for Purge).
-    u64 upper_bound = sizeof(WIAHeader1) + sizeof(WIAHeader2) + partition_entries_size +
-                      raw_data_entries_size + 0x100;
+    u64 upper_bound = sizeof(WIAHeader1) + header_2_size + zstd_dictionary_data.size() +
+                      partition_entries_size + raw_data_entries_size + 0x100;
 
     // Compared to WIA, RVZ adds an extra member to the GroupEntry struct. This added data usually
     // compresses well, so we'll assume the compression ratio for RVZ GroupEntries is 9 / 16 or
@@ -1811,7 +2176,8 @@ WIARVZFileReader<RVZ>::Convert(BlobReader* infile, const VolumeDisc* infile_volu
   std::mutex reusable_groups_mutex;
 
   const auto set_up_compress_thread_state = [&](CompressThreadState* state) {
-    SetUpCompressor(&state->compressor, compression_type, compression_level, nullptr);
+    SetUpCompressor(&state->compressor, compression_type, compression_level,
+                    zstd_dictionary.get(), nullptr);
     return ConversionResultCode::Success;
   };
 
@@ -1842,7 +2208,7 @@ WIARVZFileReader<RVZ>::Convert(BlobReader* infile, const VolumeDisc* infile_volu
   };
 
   MultithreadedCompressor<CompressThreadState, CompressParameters, OutputParameters> mt_compressor(
-      set_up_compress_thread_state, process_and_compress, output);
+      set_up_compress_thread_state, process_and_compress, output, GetCompressionThreadCount());
 
   for (const DataEntry& data_entry : data_entries)
   {
@@ -1940,7 +2306,8 @@ WIARVZFileReader<RVZ>::Convert(BlobReader* infile, const VolumeDisc* infile_volu
     return status;
 
   std::unique_ptr<Compressor> compressor;
-  SetUpCompressor(&compressor, compression_type, compression_level, &header_2);
+  SetUpCompressor(&compressor, compression_type, compression_level, zstd_dictionary.get(),
+                  &header_2);
 
   const std::optional<std::vector<u8>> compressed_raw_data_entries = Compress(
       compressor.get(), reinterpret_cast<u8*>(raw_data_entries.data()), raw_data_entries_size);
@@ -1952,10 +2319,26 @@ WIARVZFileReader<RVZ>::Convert(BlobReader* infile, const VolumeDisc* infile_volu
   if (!compressed_group_entries)
     return ConversionResultCode::InternalError;
 
-  bytes_written = sizeof(WIAHeader1) + sizeof(WIAHeader2);
-  if (!outfile->Seek(sizeof(WIAHeader1) + sizeof(WIAHeader2), File::SeekOrigin::Begin))
+  bytes_written = sizeof(WIAHeader1) + header_2_size;
+  if (!outfile->Seek(sizeof(WIAHeader1) + header_2_size, File::SeekOrigin::Begin))
     return ConversionResultCode::WriteFailed;
 
+  RVZDictionaryHeader dictionary_header{};
+  if (zstd_dictionary)
+  {
+    u64 dictionary_offset;
+    if (!WriteHeader(outfile, zstd_dictionary_data.data(), zstd_dictionary_data.size(),
+                     headers_size_upper_bound, &bytes_written, &dictionary_offset))
+    {
+      return ConversionResultCode::WriteFailed;
+    }
+
+    dictionary_header.dictionary_offset = Common::swap64(dictionary_offset);
+    dictionary_header.dictionary_size =
+        Common::swap32(static_cast<u32>(zstd_dictionary_data.size()));
+    dictionary_header.dictionary_hash = Common::SHA1::CalculateDigest(zstd_dictionary_data);
+  }
+
   u64 partition_entries_offset;
   if (!WriteHeader(outfile, reinterpret_cast<u8*>(partition_entries.data()), partition_entries_size,
                    headers_size_upper_bound, &bytes_written, &partition_entries_offset))
@@ -2010,11 +2393,22 @@ WIARVZFileReader<RVZ>::Convert(BlobReader* infile, const VolumeDisc* infile_volu
 
   header_1.magic = RVZ ? RVZ_MAGIC : WIA_MAGIC;
   header_1.version = Common::swap32(RVZ ? RVZ_VERSION : WIA_VERSION);
-  header_1.version_compatible =
-      Common::swap32(RVZ ? RVZ_VERSION_WRITE_COMPATIBLE : WIA_VERSION_WRITE_COMPATIBLE);
-  header_1.header_2_size = Common::swap32(sizeof(WIAHeader2));
-  header_1.header_2_hash =
-      Common::SHA1::CalculateDigest(reinterpret_cast<const u8*>(&header_2), sizeof(header_2));
+  if (zstd_dictionary)
+    header_1.version_compatible = Common::swap32(RVZ_VERSION_DICTIONARY_WRITE_COMPATIBLE);
+  else
+    header_1.version_compatible =
+        Common::swap32(RVZ ? RVZ_VERSION_WRITE_COMPATIBLE : WIA_VERSION_WRITE_COMPATIBLE);
+  header_1.header_2_size = Common::swap32(header_2_size);
+  {
+    auto header_2_hash_context = Common::SHA1::CreateContext();
+    header_2_hash_context->Update(reinterpret_cast<const u8*>(&header_2), sizeof(header_2));
+    if (zstd_dictionary)
+    {
+      header_2_hash_context->Update(reinterpret_cast<const u8*>(&dictionary_header),
+                                    sizeof(dictionary_header));
+    }
+    header_1.header_2_hash = header_2_hash_context->Finish();
+  }
   header_1.iso_file_size = Common::swap64(infile->GetDataSize());
   header_1.wia_file_size = Common::swap64(outfile->GetSize());
   header_1.header_1_hash = Common::SHA1::CalculateDigest(reinterpret_cast<const u8*>(&header_1),
@@ -2027,6 +2421,8 @@ WIARVZFileReader<RVZ>::Convert(BlobReader* infile, const VolumeDisc* infile_volu
     return ConversionResultCode::WriteFailed;
   if (!outfile->WriteArray(&header_2, 1))
     return ConversionResultCode::WriteFailed;
+  if (zstd_dictionary && !outfile->WriteArray(&dictionary_header, 1))
+    return ConversionResultCode::WriteFailed;
 
   return ConversionResultCode::Success;
 }
@@ -2034,7 +2430,7 @@ WIARVZFileReader<RVZ>::Convert(BlobReader* infile, const VolumeDisc* infile_volu
 bool ConvertToWIAOrRVZ(BlobReader* infile, const std::string& infile_path,
                        const std::string& outfile_path, bool rvz,
                        WIARVZCompressionType compression_type, int compression_level,
-                       int chunk_size, CompressCB callback)
+                       int chunk_size, bool use_zstd_dictionary, CompressCB callback)
 {
   File::IOFile outfile(outfile_path, "wb");
   if (!outfile)
@@ -2052,7 +2448,7 @@ bool ConvertToWIAOrRVZ(BlobReader* infile, const std::string& infile_path,
   const auto convert = rvz ? RVZFileReader::Convert : WIAFileReader::Convert;
   const ConversionResultCode result =
       convert(infile, infile_volume.get(), &outfile, compression_type, compression_level,
-              chunk_size, callback);
+              chunk_size, use_zstd_dictionary, callback);
 
   if (result == ConversionResultCode::ReadFailed)
     PanicAlertFmtT("Failed to read from the input file \"{0}\".", infile_path);
@@ -4,10 +4,13 @@
 #pragma once
 
 #include <array>
+#include <condition_variable>
 #include <limits>
+#include <list>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <set>
 #include <type_traits>
 #include <utility>
 
@@ -15,6 +18,7 @@
 #include "Common/Crypto/SHA1.h"
 #include "Common/IOFile.h"
 #include "Common/Swap.h"
+#include "Common/WorkQueueThread.h"
 #include "DiscIO/Blob.h"
 #include "DiscIO/MultithreadedCompressor.h"
 #include "DiscIO/WIACompression.h"
@@ -69,7 +73,8 @@ public:
 
   static ConversionResultCode Convert(BlobReader* infile, const VolumeDisc* infile_volume,
                                       File::IOFile* outfile, WIARVZCompressionType compression_type,
-                                      int compression_level, int chunk_size, CompressCB callback);
+                                      int compression_level, int chunk_size,
+                                      bool use_zstd_dictionary, CompressCB callback);
 
 private:
   using WiiKey = std::array<u8, 16>;
@@ -117,6 +122,15 @@ private:
   };
   static_assert(sizeof(WIAHeader2) == 0xdc, "Wrong size for WIA header 2");
 
+  // Appended to WIAHeader2 in RVZ files that use a Zstandard dictionary
+  struct RVZDictionaryHeader
+  {
+    u64 dictionary_offset;
+    u32 dictionary_size;
+    Common::SHA1::Digest dictionary_hash;
+  };
+  static_assert(sizeof(RVZDictionaryHeader) == 0x20, "Wrong size for RVZ dictionary header");
+
   struct PartitionDataEntry
   {
     u32 first_sector;
@@ -194,6 +208,11 @@ private:
 
     bool Read(u64 offset, u64 size, u8* out_ptr);
 
+    // Decompresses the whole chunk, after which it no longer accesses the file
+    bool DecompressAll();
+
+    size_t GetMemoryUsage() const { return m_in.data.size() + m_out.data.size(); }
+
     // This can only be called once at least one byte of data has been read
     void GetHashExceptions(std::vector<HashExceptionEntry>* exception_list,
                            u64 exception_list_index, u16 additional_offset) const;
@@ -205,6 +224,7 @@ private:
     }
 
   private:
+    bool DecompressUntil(u64 end_offset);
     bool Decompress();
     bool HandleExceptions(const u8* data, size_t bytes_allocated, size_t bytes_written,
                           size_t* bytes_used, bool align);
@@ -228,6 +248,37 @@ private:
     u64 m_data_offset = 0;
   };
 
+  struct ChunkParameters
+  {
+    u64 offset_in_file;
+    u64 compressed_size;
+    u64 decompressed_size;
+    WIARVZCompressionType compression_type;
+    u32 exception_lists;
+    u32 rvz_packed_size;
+    u64 data_offset;
+  };
+
+  // Chunks decompressed ahead of a sequential read stream by worker threads, plus previously
+  // used chunks as long as they fit in the memory limit.
+  static constexpr size_t NUM_READ_AHEAD_WORKERS = 2;
+  static constexpr u32 READ_AHEAD_DISTANCE = 4;
+  struct ReadAheadCache
+  {
+    std::mutex mutex;
+    std::condition_variable chunk_ready;
+
+    // Ordered from the most to the least recently used
+    std::list<std::pair<u64, std::unique_ptr<Chunk>>> chunks;
+    std::set<u64> pending;
+    size_t memory_usage = 0;
+    size_t memory_limit = 0;
+
+    std::array<File::IOFile, NUM_READ_AHEAD_WORKERS> files;
+    std::array<Common::WorkQueueThread<ChunkParameters>, NUM_READ_AHEAD_WORKERS> workers;
+    size_t next_worker = 0;
+  };
+
   explicit WIARVZFileReader(File::IOFile file, const std::string& path);
   bool Initialize(const std::string& path);
   bool HasDataOverlap() const;
@@ -240,6 +291,14 @@ private:
   Chunk& ReadCompressedData(u64 offset_in_file, u64 compressed_size, u64 decompressed_size,
                             WIARVZCompressionType compression_type, u32 exception_lists = 0,
                             u32 rvz_packed_size = 0, u64 data_offset = 0);
+  Chunk CreateChunk(File::IOFile* file, const ChunkParameters& parameters) const;
+
+  // Returns false if the group contains no stored data
+  bool GetGroupChunkParameters(u64 total_group_index, u64 group_offset_in_data, u64 chunk_size,
+                               u32 exception_lists, ChunkParameters* parameters) const;
+  void QueueReadAhead(const ChunkParameters& parameters);
+  void ReadAheadWorker(File::IOFile* file, const ChunkParameters& parameters);
+  void InsertReadAheadChunk(u64 offset_in_file, std::unique_ptr<Chunk> chunk, bool most_recent);
 
   static bool ApplyHashExceptions(const std::vector<HashExceptionEntry>& exception_list,
                                   VolumeWii::HashBlock hash_blocks[VolumeWii::BLOCKS_PER_GROUP]);
@@ -343,7 +402,10 @@ private:
 
   static void SetUpCompressor(std::unique_ptr<Compressor>* compressor,
                               WIARVZCompressionType compression_type, int compression_level,
-                              WIAHeader2* header_2);
+                              const ZSTD_CDict* zstd_dictionary, WIAHeader2* header_2);
+  static std::vector<u8> BuildZstdDictionary(BlobReader* infile,
+                                             const std::vector<PartitionEntry>& partition_entries,
+                                             const std::vector<RawDataEntry>& raw_data_entries);
   static bool TryReuse(std::map<ReuseID, GroupEntry>* reusable_groups,
                        std::mutex* reusable_groups_mutex, OutputParametersEntry* entry);
   static ConversionResult<OutputParameters>
@@ -369,6 +431,7 @@ private:
   std::string m_path;
   Chunk m_cached_chunk;
   u64 m_cached_chunk_offset = std::numeric_limits<u64>::max();
+  u64 m_last_read_group_index = std::numeric_limits<u64>::max();
   WiiEncryptionCache m_encryption_cache;
 
   std::vector<HashExceptionEntry> m_exception_list;
@@ -377,12 +440,16 @@ private:
 
   WIAHeader1 m_header_1;
   WIAHeader2 m_header_2;
+  ZstdDecompressionDictionary m_zstd_dictionary;
   std::vector<PartitionEntry> m_partition_entries;
   std::vector<RawDataEntry> m_raw_data_entries;
   std::vector<GroupEntry> m_group_entries;
 
   std::map<u64, DataEntry> m_data_entries;
 
+  // Null if read-ahead is disabled. Declared last so that the workers are stopped first.
+  std::unique_ptr<ReadAheadCache> m_read_ahead;
+
   // Perhaps we could set WIA_VERSION_WRITE_COMPATIBLE to 0.9, but WIA version 0.9 was never in
   // any official release of wit, and interim versions (either source or binaries) are hard to find.
   // Since we've been unable to check if we're write compatible with 0.9, we set it 1.0 to be safe.
@@ -391,9 +458,14 @@ private:
   static constexpr u32 WIA_VERSION_WRITE_COMPATIBLE = 0x01000000;
   static constexpr u32 WIA_VERSION_READ_COMPATIBLE = 0x00080000;
 
-  static constexpr u32 RVZ_VERSION = 0x01000000;
+  static constexpr u32 RVZ_VERSION = 0x01010000;
   static constexpr u32 RVZ_VERSION_WRITE_COMPATIBLE = 0x00030000;
   static constexpr u32 RVZ_VERSION_READ_COMPATIBLE = 0x00030000;
+  // Older versions can't read files that use a Zstandard dictionary
+  static constexpr u32 RVZ_VERSION_DICTIONARY_WRITE_COMPATIBLE = 0x01010000;
+
+  static constexpr u32 ZSTD_DICTIONARY_SAMPLE_SIZE = 0x1000;
+  static constexpr u32 ZSTD_DICTIONARY_MAX_SAMPLES = 32;
 };
 
 using WIAFileReader = WIARVZFileReader<false>;
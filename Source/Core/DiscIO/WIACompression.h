@@ -18,6 +18,14 @@
 
 namespace DiscIO
 {
+struct ZstdDictionaryDeleter
+{
+  void operator()(ZSTD_CDict* dictionary) const { ZSTD_freeCDict(dictionary); }
+  void operator()(ZSTD_DDict* dictionary) const { ZSTD_freeDDict(dictionary); }
+};
+using ZstdCompressionDictionary = std::unique_ptr<ZSTD_CDict, ZstdDictionaryDeleter>;
+using ZstdDecompressionDictionary = std::unique_ptr<ZSTD_DDict, ZstdDictionaryDeleter>;
+
 struct DecompressionBuffer
 {
   std::vector<u8> data;
@@ -105,7 +113,8 @@ private:
 class ZstdDecompressor final : public Decompressor
 {
 public:
-  ZstdDecompressor();
+  // The dictionary may be null, and must otherwise outlive the decompressor
+  explicit ZstdDecompressor(const ZSTD_DDict* dictionary);
   ~ZstdDecompressor();
 
   bool Decompress(const DecompressionBuffer& in, DecompressionBuffer* out,
@@ -228,7 +237,8 @@ private:
 class ZstdCompressor final : public Compressor
 {
 public:
-  ZstdCompressor(int compression_level);
+  // The dictionary may be null, and must otherwise outlive the compressor
+  ZstdCompressor(int compression_level, const ZSTD_CDict* dictionary);
   ~ZstdCompressor();
 
   bool Start(std::optional<u64> size) override;
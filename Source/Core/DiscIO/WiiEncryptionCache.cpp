@@ -3,13 +3,17 @@
 
 #include "DiscIO/WiiEncryptionCache.h"
 
+#include <algorithm>
 #include <array>
 #include <cstring>
+#include <iterator>
 #include <limits>
 #include <memory>
 
 #include "Common/Align.h"
+#include "Common/Assert.h"
 #include "Common/CommonTypes.h"
+#include "Core/Config/MainSettings.h"
 #include "DiscIO/Blob.h"
 #include "DiscIO/VolumeWii.h"
 
@@ -26,43 +30,61 @@ WiiEncryptionCache::EncryptGroup(u64 offset, u64 partition_data_offset,
                                  u64 partition_data_decrypted_size, const Key& key,
                                  const HashExceptionCallback& hash_exception_callback)
 {
-  // Only allocate memory if this function actually ends up getting called
-  if (!m_cache)
-  {
-    m_cache = std::make_unique<std::array<u8, VolumeWii::GROUP_TOTAL_SIZE>>();
-    m_cached_offset = std::numeric_limits<u64>::max();
-  }
-
   ASSERT(offset % VolumeWii::GROUP_TOTAL_SIZE == 0);
   const u64 group_offset_in_partition =
       offset / VolumeWii::GROUP_TOTAL_SIZE * VolumeWii::GROUP_DATA_SIZE;
   const u64 group_offset_on_disc = partition_data_offset + offset;
 
-  if (m_cached_offset != group_offset_on_disc)
+  const auto it = std::find_if(m_cache.begin(), m_cache.end(), [&](const CachedGroup& group) {
+    return group.offset_on_disc == group_offset_on_disc;
+  });
+  if (it != m_cache.end())
+  {
+    m_cache.splice(m_cache.begin(), m_cache, it);
+    return m_cache.front().data.get();
+  }
+
+  // Only allocate memory if this function actually ends up getting called
+  if (m_max_cached_groups == 0)
+  {
+    const u64 cache_size = static_cast<u64>(
+        std::max(Config::Get(Config::MAIN_WII_ENCRYPTION_CACHE_SIZE), 0)) << 20;
+    m_max_cached_groups = std::max<size_t>(1, cache_size / VolumeWii::GROUP_TOTAL_SIZE);
+  }
+
+  if (m_cache.size() < m_max_cached_groups)
+  {
+    m_cache.push_front({0, std::make_unique<std::array<u8, VolumeWii::GROUP_TOTAL_SIZE>>()});
+  }
+  else
+  {
+    // Reuse the memory of the least recently used group
+    m_cache.splice(m_cache.begin(), m_cache, std::prev(m_cache.end()));
+  }
+
+  CachedGroup& group = m_cache.front();
+
+  std::function<void(VolumeWii::HashBlock * hash_blocks)> hash_exception_callback_2;
+
+  if (hash_exception_callback)
+  {
+    hash_exception_callback_2 =
+        [offset, &hash_exception_callback](
+            VolumeWii::HashBlock hash_blocks[VolumeWii::BLOCKS_PER_GROUP]) {
+          return hash_exception_callback(hash_blocks, offset);
+        };
+  }
+
+  if (!VolumeWii::EncryptGroup(group_offset_in_partition, partition_data_offset,
+                               partition_data_decrypted_size, key, m_blob, group.data.get(),
+                               hash_exception_callback_2))
   {
-    std::function<void(VolumeWii::HashBlock * hash_blocks)> hash_exception_callback_2;
-
-    if (hash_exception_callback)
-    {
-      hash_exception_callback_2 =
-          [offset, &hash_exception_callback](
-              VolumeWii::HashBlock hash_blocks[VolumeWii::BLOCKS_PER_GROUP]) {
-            return hash_exception_callback(hash_blocks, offset);
-          };
-    }
-
-    if (!VolumeWii::EncryptGroup(group_offset_in_partition, partition_data_offset,
-                                 partition_data_decrypted_size, key, m_blob, m_cache.get(),
-                                 hash_exception_callback_2))
-    {
-      m_cached_offset = std::numeric_limits<u64>::max();  // Invalidate the cache
-      return nullptr;
-    }
-
-    m_cached_offset = group_offset_on_disc;
+    m_cache.pop_front();
+    return nullptr;
   }
 
-  return m_cache.get();
+  group.offset_on_disc = group_offset_on_disc;
+  return group.data.get();
 }
 
 bool WiiEncryptionCache::EncryptGroups(u64 offset, u64 size, u8* out_ptr, u64 partition_data_offset,
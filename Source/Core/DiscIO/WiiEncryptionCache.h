@@ -4,7 +4,9 @@
 #pragma once
 
 #include <array>
+#include <cstddef>
 #include <limits>
+#include <list>
 #include <memory>
 
 #include "Common/CommonTypes.h"
@@ -37,6 +39,7 @@ public:
   // If the returned pointer is nullptr, reading from the blob failed.
   // If the returned pointer is not nullptr, it is guaranteed to be valid until
   // the next call of this function or the destruction of this object.
+  // The most recently used groups are kept, up to MAIN_WII_ENCRYPTION_CACHE_SIZE.
   const std::array<u8, VolumeWii::GROUP_TOTAL_SIZE>*
   EncryptGroup(u64 offset, u64 partition_data_offset, u64 partition_data_decrypted_size,
                const Key& key, const HashExceptionCallback& hash_exception_callback = {});
@@ -48,9 +51,16 @@ public:
                      const HashExceptionCallback& hash_exception_callback = {});
 
 private:
+  struct CachedGroup
+  {
+    u64 offset_on_disc;
+    std::unique_ptr<std::array<u8, VolumeWii::GROUP_TOTAL_SIZE>> data;
+  };
+
   BlobReader* m_blob;
-  std::unique_ptr<std::array<u8, VolumeWii::GROUP_TOTAL_SIZE>> m_cache;
-  u64 m_cached_offset = 0;
+  // Ordered from most recently used to least recently used
+  std::list<CachedGroup> m_cache;
+  size_t m_max_cached_groups = 0;
 };
 
 }  // namespace DiscIO
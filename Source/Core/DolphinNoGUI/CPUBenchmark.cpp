@@ -0,0 +1,105 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DolphinNoGUI/CPUBenchmark.h"
+
+#include <utility>
+
+#include <picojson.h>
+
+#include "Common/Version.h"
+#include "Core/Config/MainSettings.h"
+#include "Core/CoreTiming.h"
+#include "Core/HW/SystemTimers.h"
+#include "Core/Movie.h"
+#include "Core/PowerPC/MMU.h"
+#include "Core/PowerPC/PowerPC.h"
+#include "Core/System.h"
+#include "VideoCommon/VideoEvents.h"
+
+CPUBenchmark::CPUBenchmark(int frames, bool until_movie_end, std::function<void()> on_finished)
+    : m_frames(frames), m_until_movie_end(until_movie_end), m_on_finished(std::move(on_finished))
+{
+  m_end_field_event = VIEndFieldEvent::Register([this] { OnEndField(); }, "CPUBenchmark");
+}
+
+CPUBenchmark::Sample CPUBenchmark::TakeSample(Core::System& system)
+{
+  return {
+      .time = Clock::now(),
+      .ticks = system.GetCoreTiming().GetTicks(),
+      .jit = system.GetJitInterface().GetStatistics(),
+      .jit_slow_accesses = system.GetMMU().GetJitSlowAccessCount(),
+  };
+}
+
+void CPUBenchmark::OnEndField()
+{
+  auto& system = Core::System::GetInstance();
+
+  {
+    std::lock_guard lk(m_lock);
+    if (m_end)
+      return;
+
+    // Booting isn't measured, so the first field only starts the clock.
+    if (!m_start)
+    {
+      m_start = TakeSample(system);
+      m_ticks_per_second = system.GetSystemTimers().GetTicksPerSecond();
+      return;
+    }
+
+    ++m_frames_seen;
+    const bool movie_ended = m_until_movie_end && !system.GetMovie().IsPlayingInput();
+    if (!movie_ended && (m_frames == 0 || m_frames_seen < m_frames))
+      return;
+
+    m_end = TakeSample(system);
+  }
+
+  m_on_finished();
+}
+
+std::string CPUBenchmark::GetResultsJSON(const std::string& file_path) const
+{
+  std::lock_guard lk(m_lock);
+
+  picojson::object results;
+  results.emplace("frames", static_cast<double>(m_frames_seen));
+  results.emplace("completed", m_end.has_value());
+  if (m_start && m_end)
+  {
+    const double seconds = std::chrono::duration<double>(m_end->time - m_start->time).count();
+    const double cycles = static_cast<double>(m_end->ticks - m_start->ticks);
+    results.emplace("wall_time_s", seconds);
+    results.emplace("emulated_cycles", cycles);
+    results.emplace("emulated_mhz", seconds > 0 ? cycles / seconds / 1e6 : 0.0);
+    results.emplace("speed_percent",
+                    seconds > 0 ? cycles / seconds / m_ticks_per_second * 100 : 0.0);
+    results.emplace("fps", seconds > 0 ? m_frames_seen / seconds : 0.0);
+
+    const JitInterface::Statistics& start = m_start->jit;
+    const JitInterface::Statistics& end = m_end->jit;
+    results.emplace("jit_blocks_compiled",
+                    static_cast<double>(end.blocks_compiled - start.blocks_compiled));
+    results.emplace("jit_compile_time_ms",
+                    (end.compile_time_ns - start.compile_time_ns) / 1e6);
+    results.emplace("jit_cache_clears", static_cast<double>(end.cache_clears - start.cache_clears));
+    results.emplace("fastmem_faults",
+                    static_cast<double>(end.fastmem_faults - start.fastmem_faults));
+    results.emplace("slowmem_sites_compiled",
+                    static_cast<double>(end.slowmem_sites_compiled - start.slowmem_sites_compiled));
+    results.emplace("mmu_slow_path_accesses",
+                    static_cast<double>(m_end->jit_slow_accesses - m_start->jit_slow_accesses));
+  }
+
+  picojson::object root;
+  root.emplace("format_version", 1.0);
+  root.emplace("dolphin_version", Common::GetScmRevStr());
+  root.emplace("cpu_core", static_cast<double>(Config::Get(Config::MAIN_CPU_CORE)));
+  root.emplace("file", file_path);
+  root.emplace("target_frames", static_cast<double>(m_frames));
+  root.emplace("results", std::move(results));
+  return picojson::value(std::move(root)).serialize(true);
+}
@@ -0,0 +1,59 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+
+#include "Common/CommonTypes.h"
+#include "Common/HookableEvent.h"
+#include "Core/PowerPC/JitInterface.h"
+
+namespace Core
+{
+class System;
+}
+
+// Measures how fast the emulated CPU runs over a number of emulated frames, or until an input
+// movie ends, so that results can be compared between builds.
+class CPUBenchmark
+{
+public:
+  // on_finished is called on the CPU thread once the benchmark is over. With a frame count of 0,
+  // it only ends with the movie being played.
+  CPUBenchmark(int frames, bool until_movie_end, std::function<void()> on_finished);
+
+  // Returns the results as a JSON document. Fields are only ever added, never renamed or removed,
+  // so that scripts parsing older results keep working.
+  std::string GetResultsJSON(const std::string& file_path) const;
+
+private:
+  using Clock = std::chrono::steady_clock;
+
+  struct Sample
+  {
+    Clock::time_point time;
+    u64 ticks;
+    JitInterface::Statistics jit;
+    u64 jit_slow_accesses;
+  };
+
+  void OnEndField();
+  static Sample TakeSample(Core::System& system);
+
+  const int m_frames;
+  const bool m_until_movie_end;
+  std::function<void()> m_on_finished;
+
+  mutable std::mutex m_lock;
+  int m_frames_seen = 0;
+  std::optional<Sample> m_start;
+  std::optional<Sample> m_end;
+  u32 m_ticks_per_second = 0;
+
+  Common::EventHook m_end_field_event;
+};
@@ -0,0 +1,99 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DolphinNoGUI/FifoBenchmark.h"
+
+#include <algorithm>
+
+#include <picojson.h>
+
+#include "Common/Version.h"
+#include "Core/Config/MainSettings.h"
+#include "VideoCommon/Statistics.h"
+#include "VideoCommon/VideoEvents.h"
+
+FifoBenchmark::FifoBenchmark()
+{
+  m_after_frame_event =
+      AfterFrameEvent::Register([this](Core::System&) { OnFrameEnd(); }, "FifoBenchmark");
+}
+
+void FifoBenchmark::OnFrameEnd()
+{
+  const Clock::time_point now = Clock::now();
+
+  std::lock_guard lk(m_lock);
+
+  // The first frame also includes the time spent loading the initial state, so it only starts
+  // the clock.
+  if (m_last_frame_end)
+  {
+    const auto& frame = g_stats.this_frame;
+    m_frames.push_back({
+        .frame_time_ms = std::chrono::duration<double, std::milli>(now - *m_last_frame_end).count(),
+        .draw_calls = frame.num_draw_calls,
+        .primitives = frame.num_prims + frame.num_dl_prims,
+        .shader_changes = frame.num_shader_changes,
+        .textures_created = frame.num_textures_created,
+        .textures_uploaded = g_stats.num_textures_uploaded - m_last_textures_uploaded,
+        .bytes_vertex_streamed = frame.bytes_vertex_streamed,
+        .bytes_index_streamed = frame.bytes_index_streamed,
+        .bytes_uniform_streamed = frame.bytes_uniform_streamed,
+    });
+  }
+
+  m_last_frame_end = now;
+  m_last_textures_uploaded = g_stats.num_textures_uploaded;
+}
+
+std::string FifoBenchmark::GetResultsJSON(const std::string& file_path, int loops) const
+{
+  std::lock_guard lk(m_lock);
+
+  picojson::array frames;
+  std::vector<double> frame_times;
+  frames.reserve(m_frames.size());
+  frame_times.reserve(m_frames.size());
+  for (const FrameSample& sample : m_frames)
+  {
+    picojson::object frame;
+    frame.emplace("frame_time_ms", sample.frame_time_ms);
+    frame.emplace("draw_calls", static_cast<double>(sample.draw_calls));
+    frame.emplace("primitives", static_cast<double>(sample.primitives));
+    frame.emplace("shader_changes", static_cast<double>(sample.shader_changes));
+    frame.emplace("textures_created", static_cast<double>(sample.textures_created));
+    frame.emplace("textures_uploaded", static_cast<double>(sample.textures_uploaded));
+    frame.emplace("bytes_vertex_streamed", static_cast<double>(sample.bytes_vertex_streamed));
+    frame.emplace("bytes_index_streamed", static_cast<double>(sample.bytes_index_streamed));
+    frame.emplace("bytes_uniform_streamed", static_cast<double>(sample.bytes_uniform_streamed));
+    frames.emplace_back(std::move(frame));
+    frame_times.push_back(sample.frame_time_ms);
+  }
+
+  picojson::object summary;
+  summary.emplace("frames", static_cast<double>(frame_times.size()));
+  if (!frame_times.empty())
+  {
+    double total_time = 0;
+    for (const double time : frame_times)
+      total_time += time;
+
+    std::sort(frame_times.begin(), frame_times.end());
+    summary.emplace("total_time_ms", total_time);
+    summary.emplace("mean_frame_time_ms", total_time / frame_times.size());
+    summary.emplace("min_frame_time_ms", frame_times.front());
+    summary.emplace("median_frame_time_ms", frame_times[frame_times.size() / 2]);
+    summary.emplace("p99_frame_time_ms", frame_times[frame_times.size() * 99 / 100]);
+    summary.emplace("max_frame_time_ms", frame_times.back());
+  }
+
+  picojson::object root;
+  root.emplace("format_version", 1.0);
+  root.emplace("dolphin_version", Common::GetScmRevStr());
+  root.emplace("video_backend", Config::Get(Config::MAIN_GFX_BACKEND));
+  root.emplace("file", file_path);
+  root.emplace("loops", static_cast<double>(loops));
+  root.emplace("summary", std::move(summary));
+  root.emplace("frames", std::move(frames));
+  return picojson::value(std::move(root)).serialize(true);
+}
@@ -0,0 +1,49 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <chrono>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "Common/HookableEvent.h"
+
+// Collects per-frame statistics while a fifo log is replayed, so that the results can be compared
+// between builds and backends.
+class FifoBenchmark
+{
+public:
+  FifoBenchmark();
+
+  // Returns the results as a JSON document. Fields are only ever added, never renamed or removed,
+  // so that scripts parsing older results keep working.
+  std::string GetResultsJSON(const std::string& file_path, int loops) const;
+
+private:
+  using Clock = std::chrono::steady_clock;
+
+  struct FrameSample
+  {
+    double frame_time_ms;
+    int draw_calls;
+    int primitives;
+    int shader_changes;
+    int textures_created;
+    int textures_uploaded;
+    int bytes_vertex_streamed;
+    int bytes_index_streamed;
+    int bytes_uniform_streamed;
+  };
+
+  void OnFrameEnd();
+
+  mutable std::mutex m_lock;
+  std::vector<FrameSample> m_frames;
+  std::optional<Clock::time_point> m_last_frame_end;
+  int m_last_textures_uploaded = 0;
+
+  Common::EventHook m_after_frame_event;
+};
@@ -7,8 +7,10 @@
 #include <cstddef>
 #include <cstdio>
 #include <cstring>
+#include <memory>
 #include <signal.h>
 #include <string>
+#include <variant>
 #include <vector>
 
 #ifndef _WIN32
@@ -17,14 +19,21 @@
 #include <Windows.h>
 #endif
 
+#include "Common/FileUtil.h"
 #include "Common/ScopeGuard.h"
 #include "Common/StringUtil.h"
 #include "Core/Boot/Boot.h"
 #include "Core/BootManager.h"
+#include "Core/Config/GraphicsSettings.h"
+#include "Core/Config/MainSettings.h"
 #include "Core/Core.h"
 #include "Core/DolphinAnalytics.h"
+#include "Core/FifoPlayer/FifoPlayer.h"
 #include "Core/Host.h"
+#include "Core/Movie.h"
 #include "Core/System.h"
+#include "DolphinNoGUI/CPUBenchmark.h"
+#include "DolphinNoGUI/FifoBenchmark.h"
 
 #include "UICommon/CommandLineParse.h"
 #ifdef USE_DISCORD_PRESENCE
@@ -34,6 +43,7 @@
 
 #include "InputCommon/GCAdapter.h"
 
+#include "VideoBackends/Null/VideoBackend.h"
 #include "VideoCommon/VideoBackendBase.h"
 
 static std::unique_ptr<Platform> s_platform;
@@ -216,6 +226,23 @@ int main(int argc, char* argv[])
             "macos"
 #endif
       });
+  parser->add_option("--fifo_benchmark")
+      .type("int")
+      .action("store")
+      .metavar("LOOPS")
+      .help("Replay the given fifo log LOOPS times as fast as possible, then print per-frame "
+            "statistics as JSON");
+  parser->add_option("--cpu_benchmark")
+      .type("int")
+      .action("store")
+      .metavar("FRAMES")
+      .help("Run the game for FRAMES emulated frames as fast as possible, without video or audio "
+            "output, then print CPU emulation statistics as JSON. With a movie, 0 runs until the "
+            "movie ends");
+  parser->add_option("--benchmark_output")
+      .action("store")
+      .metavar("FILE")
+      .help("Write the benchmark results to FILE instead of stdout");
 
   optparse::Values& options = CommandLineParse::ParseArguments(parser.get(), argc, argv);
   std::vector<std::string> args = parser->args();
@@ -228,6 +255,7 @@ int main(int argc, char* argv[])
 
   std::unique_ptr<BootParameters> boot;
   bool game_specified = false;
+  std::string game_path;
   if (options.is_set("exec"))
   {
     const std::list<std::string> paths_list = options.all("exec");
@@ -236,6 +264,7 @@ int main(int argc, char* argv[])
     boot = BootParameters::GenerateFromFile(
         paths, BootSessionData(save_state_path, DeleteSavestateAfterBoot::No));
     game_specified = true;
+    game_path = paths.front();
   }
   else if (options.is_set("nand_title"))
   {
@@ -251,6 +280,7 @@ int main(int argc, char* argv[])
   }
   else if (args.size())
   {
+    game_path = args.front();
     boot = BootParameters::GenerateFromFile(
         args.front(), BootSessionData(save_state_path, DeleteSavestateAfterBoot::No));
     args.erase(args.begin());
@@ -290,6 +320,19 @@ int main(int argc, char* argv[])
     return 1;
   }
 
+  if (options.is_set("movie"))
+  {
+    std::optional<std::string> movie_savestate_path;
+    const std::string movie_path = static_cast<const char*>(options.get("movie"));
+    if (!Core::System::GetInstance().GetMovie().PlayInput(movie_path, &movie_savestate_path))
+    {
+      fprintf(stderr, "Could not play the movie %s\n", movie_path.c_str());
+      return 1;
+    }
+    boot->boot_session_data.SetSavestateData(std::move(movie_savestate_path),
+                                             DeleteSavestateAfterBoot::No);
+  }
+
   Core::AddOnStateChangedCallback([](Core::State state) {
     if (state == Core::State::Uninitialized)
       s_platform->Stop();
@@ -310,6 +353,47 @@ int main(int argc, char* argv[])
 
   DolphinAnalytics::Instance().ReportDolphinStart("nogui");
 
+  std::unique_ptr<FifoBenchmark> benchmark;
+  std::string benchmark_file_path;
+  int benchmark_loops = 0;
+  if (options.is_set("fifo_benchmark"))
+  {
+    const auto* dff = boot ? std::get_if<BootParameters::DFF>(&boot->parameters) : nullptr;
+    benchmark_loops = static_cast<int>(options.get("fifo_benchmark"));
+    if (!dff || benchmark_loops <= 0)
+    {
+      fprintf(stderr, "A fifo benchmark requires a fifo log and a positive loop count.\n");
+      return 1;
+    }
+    benchmark_file_path = dff->dff_path;
+
+    // Measure how fast frames can be rendered, not how fast they can be shown
+    Config::SetCurrent(Config::MAIN_EMULATION_SPEED, 0.0f);
+    Config::SetCurrent(Config::GFX_VSYNC, false);
+    Core::System::GetInstance().GetFifoPlayer().SetLoopCount(benchmark_loops);
+    benchmark = std::make_unique<FifoBenchmark>();
+  }
+
+  std::unique_ptr<CPUBenchmark> cpu_benchmark;
+  if (options.is_set("cpu_benchmark"))
+  {
+    const int frames = static_cast<int>(options.get("cpu_benchmark"));
+    const bool has_movie = options.is_set("movie");
+    if (!game_specified || benchmark || frames < 0 || (frames == 0 && !has_movie))
+    {
+      fprintf(stderr, "A CPU benchmark requires a game and a positive frame count, or a movie.\n");
+      return 1;
+    }
+    // Only the CPU is measured, so nothing is shown, played or throttled
+    Config::SetCurrent(Config::MAIN_EMULATION_SPEED, 0.0f);
+    Config::SetCurrent(Config::MAIN_GFX_BACKEND, Null::VideoBackend::NAME);
+    Config::SetCurrent(Config::MAIN_AUDIO_BACKEND, BACKEND_NULLSOUND);
+    Config::SetCurrent(Config::GFX_VSYNC, false);
+    cpu_benchmark = std::make_unique<CPUBenchmark>(frames, has_movie, [] {
+      Core::QueueHostJob([](Core::System&) { s_platform->Stop(); });
+    });
+  }
+
   if (!BootManager::BootCore(Core::System::GetInstance(), std::move(boot), wsi))
   {
     fprintf(stderr, "Could not boot the specified file\n");
@@ -326,6 +410,26 @@ int main(int argc, char* argv[])
   Core::Shutdown(Core::System::GetInstance());
   s_platform.reset();
 
+  if (benchmark || cpu_benchmark)
+  {
+    const std::string results =
+        benchmark ? benchmark->GetResultsJSON(benchmark_file_path, benchmark_loops) :
+                    cpu_benchmark->GetResultsJSON(game_path);
+    if (options.is_set("benchmark_output"))
+    {
+      const std::string output_path = static_cast<const char*>(options.get("benchmark_output"));
+      if (!File::WriteStringToFile(output_path, results))
+      {
+        fprintf(stderr, "Failed to write the benchmark results to %s\n", output_path.c_str());
+        return 1;
+      }
+    }
+    else
+    {
+      puts(results.c_str());
+    }
+  }
+
   return 0;
 }
 
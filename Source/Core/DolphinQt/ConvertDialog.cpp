@@ -510,7 +510,7 @@ void ConvertDialog::Convert()
           const bool good =
               DiscIO::ConvertToWIAOrRVZ(blob_reader.get(), original_path, dst_path.toStdString(),
                                         format == DiscIO::BlobType::RVZ, compression,
-                                        compression_level, block_size, callback);
+                                        compression_level, block_size, false, callback);
           progress_dialog.Reset();
           return good;
         });
@@ -674,7 +674,7 @@ void BranchWatchDialog::OnBranchNotOverwritten()
 
 void BranchWatchDialog::OnWipeRecentHits()
 {
-  m_table_model->OnWipeRecentHits();
+  m_table_model->OnWipeRecentHits(Core::CPUThreadGuard{m_system});
 }
 
 void BranchWatchDialog::OnWipeInspection()
@@ -911,6 +911,7 @@ void BranchWatchDialog::SaveSettings()
 
 void BranchWatchDialog::Update()
 {
+  m_branch_watch.ResolveHits(Core::CPUThreadGuard{m_system});
   if (m_branch_watch.GetRecordingPhase() == Core::BranchWatch::Phase::Blacklist)
     UpdateStatus();
   m_table_model->UpdateHits();
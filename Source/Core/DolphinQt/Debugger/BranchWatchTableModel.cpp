@@ -120,13 +120,13 @@ void BranchWatchTableModel::OnBranchNotOverwritten(const Core::CPUThreadGuard& g
   emit layoutChanged();
 }
 
-void BranchWatchTableModel::OnWipeRecentHits()
+void BranchWatchTableModel::OnWipeRecentHits(const Core::CPUThreadGuard& guard)
 {
   const int row_count = rowCount();
   if (row_count <= 0)
     return;
   static const QList<int> roles = {Qt::DisplayRole};
-  m_branch_watch.UpdateHitsSnapshot();
+  m_branch_watch.UpdateHitsSnapshot(guard);
   const int last = row_count - 1;
   emit dataChanged(createIndex(0, Column::RecentHits), createIndex(last, Column::RecentHits),
                    roles);
@@ -95,7 +95,7 @@ public:
   void OnCodePathNotTaken(const Core::CPUThreadGuard& guard);
   void OnBranchWasOverwritten(const Core::CPUThreadGuard& guard);
   void OnBranchNotOverwritten(const Core::CPUThreadGuard& guard);
-  void OnWipeRecentHits();
+  void OnWipeRecentHits(const Core::CPUThreadGuard& guard);
   void OnWipeInspection();
 
   void Save(const Core::CPUThreadGuard& guard, std::FILE* file) const;
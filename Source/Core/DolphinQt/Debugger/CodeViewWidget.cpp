@@ -5,6 +5,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <limits>
 
 #include <fmt/format.h>
 
@@ -25,6 +26,7 @@
 #include <QWheelEvent>
 
 #include "Common/Assert.h"
+#include "Common/FileUtil.h"
 #include "Common/GekkoDisassembler.h"
 #include "Common/StringUtil.h"
 #include "Core/Core.h"
@@ -38,7 +40,9 @@
 #include "DolphinQt/Debugger/AssembleInstructionDialog.h"
 #include "DolphinQt/Debugger/PatchInstructionDialog.h"
 #include "DolphinQt/Host.h"
+#include "DolphinQt/QtUtils/DolphinFileDialog.h"
 #include "DolphinQt/QtUtils/FromStdString.h"
+#include "DolphinQt/QtUtils/ModalMessageBox.h"
 #include "DolphinQt/QtUtils/SetWindowDecorations.h"
 #include "DolphinQt/Resources.h"
 #include "DolphinQt/Settings.h"
@@ -642,6 +646,10 @@ void CodeViewWidget::OnContextMenu()
                             [this] { AutoStep(CodeTrace::AutoStop::Changed); });
 
   run_until_menu->setEnabled(!target.isEmpty());
+
+  auto* record_trace_action =
+      menu->addAction(tr("Record binary trace..."), this, &CodeViewWidget::RecordBinaryTrace);
+  record_trace_action->setEnabled(paused);
   follow_branch_action->setEnabled(follow_branch_enabled);
 
   for (auto* action :
@@ -748,6 +756,38 @@ void CodeViewWidget::AutoStep(CodeTrace::AutoStop option)
   } while (msgbox.clickedButton() == (QAbstractButton*)run_button);
 }
 
+void CodeViewWidget::RecordBinaryTrace()
+{
+  bool good;
+  const int count = QInputDialog::getInt(
+      this, tr("Record binary trace"), tr("Number of instructions to step:"), 1000000, 1,
+      std::numeric_limits<int>::max(), 1, &good, Qt::WindowCloseButtonHint);
+  if (!good)
+    return;
+
+  const QString filepath = DolphinFileDialog::getSaveFileName(
+      this, tr("Save binary trace"), QString::fromStdString(File::GetUserPath(D_DUMPDEBUG_IDX)),
+      tr("Zstandard-compressed trace (*.trace.zst);;All Files (*)"));
+  if (filepath.isEmpty())
+    return;
+
+  BinaryTraceResults results;
+  {
+    Core::CPUThreadGuard guard(m_system);
+    results = CodeTrace().RecordBinaryTrace(guard, filepath.toStdString(), count);
+  }
+  emit Host::GetInstance()->UpdateDisasmDialog();
+
+  if (!results.success)
+  {
+    ModalMessageBox::warning(this, tr("Error"), tr("Failed to write the binary trace."));
+    return;
+  }
+  ModalMessageBox::information(
+      this, tr("Record binary trace"),
+      tr("Instructions executed:   %1").arg(QString::number(results.count)));
+}
+
 void CodeViewWidget::OnDebugFontChanged(const QFont& font)
 {
   setFont(font);
@@ -78,6 +78,7 @@ private:
   void OnContextMenu();
 
   void AutoStep(CodeTrace::AutoStop option = CodeTrace::AutoStop::Always);
+  void RecordBinaryTrace();
   void OnDebugFontChanged(const QFont& font);
   void OnFollowBranch();
   void OnCopyAddress();
@@ -11,11 +11,13 @@
 #include <QDragEnterEvent>
 #include <QDropEvent>
 #include <QFileDialog>
+#include <QHideEvent>
 #include <QIcon>
 #include <QMenu>
 #include <QMimeData>
 #include <QMouseEvent>
 #include <QPainter>
+#include <QShowEvent>
 
 #include "AudioCommon/AudioCommon.h"
 #include "Core/Config/MainSettings.h"
@@ -86,6 +88,9 @@ GBAWidget::GBAWidget(std::weak_ptr<HW::GBA::Core> core, const HW::GBA::CoreInfo&
   setAcceptDrops(true);
   resize(m_core_info.width, m_core_info.height);
   setVisible(visible);
+  // A window that is created hidden never gets a hide event.
+  if (auto core_ptr = m_core.lock())
+    core_ptr->SetVideoHidden(!visible);
 
   SetVolume(100);
   if (!visible)
@@ -559,6 +564,20 @@ void GBAWidget::paintEvent(QPaintEvent* event)
   }
 }
 
+void GBAWidget::showEvent(QShowEvent* event)
+{
+  QWidget::showEvent(event);
+  if (auto core_ptr = m_core.lock())
+    core_ptr->SetVideoHidden(false);
+}
+
+void GBAWidget::hideEvent(QHideEvent* event)
+{
+  QWidget::hideEvent(event);
+  if (auto core_ptr = m_core.lock())
+    core_ptr->SetVideoHidden(true);
+}
+
 void GBAWidget::dragEnterEvent(QDragEnterEvent* event)
 {
   if (CanControlCore() && event->mimeData()->hasUrls())
@@ -21,8 +21,10 @@ class QCloseEvent;
 class QContextMenuEvent;
 class QDragEnterEvent;
 class QDropEvent;
+class QHideEvent;
 class QMouseEvent;
 class QPaintEvent;
+class QShowEvent;
 
 namespace NetPlay
 {
@@ -79,6 +81,8 @@ private:
   void mouseReleaseEvent(QMouseEvent* event) override;
   void mouseMoveEvent(QMouseEvent* event) override;
   void paintEvent(QPaintEvent* event) override;
+  void showEvent(QShowEvent* event) override;
+  void hideEvent(QHideEvent* event) override;
 
   void dragEnterEvent(QDragEnterEvent* event) override;
   void dropEvent(QDropEvent* event) override;
@@ -3,6 +3,8 @@
 
 #include "DolphinQt/GameList/GridProxyModel.h"
 
+#include <algorithm>
+
 #include <QImage>
 #include <QPainter>
 #include <QPixmap>
@@ -16,7 +18,11 @@
 
 const QSize LARGE_BANNER_SIZE(144, 48);
 
-GridProxyModel::GridProxyModel(QObject* parent) : QSortFilterProxyModel(parent)
+// Enough for the covers of a few screens worth of games.
+constexpr qsizetype DECORATION_CACHE_SIZE_KIB = 64 * 1024;
+
+GridProxyModel::GridProxyModel(QObject* parent)
+    : QSortFilterProxyModel(parent), m_decoration_cache(DECORATION_CACHE_SIZE_KIB)
 {
   setSortCaseSensitivity(Qt::CaseInsensitive);
   sort(static_cast<int>(GameListModel::Column::Title));
@@ -34,41 +40,62 @@ QVariant GridProxyModel::data(const QModelIndex& i, int role) const
   else if (role == Qt::DecorationRole)
   {
     auto* model = static_cast<GameListModel*>(sourceModel());
+    const std::shared_ptr<const UICommon::GameFile> game =
+        model->GetGameFile(source_index.row());
+    const bool use_covers = Config::Get(Config::MAIN_USE_GAME_COVERS);
+    const QString key = QString::fromStdString(game->GetFilePath());
+
+    const CachedDecoration* cached = m_decoration_cache.object(key);
+    if (cached && cached->game == game && cached->scale == model->GetScale() &&
+        cached->use_covers == use_covers)
+    {
+      return cached->pixmap;
+    }
 
-    const auto& buffer = model->GetGameFile(source_index.row())->GetCoverImage().buffer;
+    QPixmap pixmap = CreateDecoration(*model, source_index.row(), use_covers);
+    const qsizetype cost_kib = qsizetype(pixmap.width()) * pixmap.height() * 4 / 1024;
+    m_decoration_cache.insert(
+        key, new CachedDecoration{game, model->GetScale(), use_covers, pixmap},
+        std::max<qsizetype>(1, cost_kib));
+    return pixmap;
+  }
+  return QVariant();
+}
 
-    QSize size = Config::Get(Config::MAIN_USE_GAME_COVERS) ? QSize(160, 224) : LARGE_BANNER_SIZE;
-    QPixmap pixmap(size * model->GetScale() * QPixmap().devicePixelRatio());
+QPixmap GridProxyModel::CreateDecoration(const GameListModel& model, int source_row,
+                                         bool use_covers) const
+{
+  const auto& buffer = model.GetGameFile(source_row)->GetCoverImage().buffer;
 
-    if (buffer.empty() || !Config::Get(Config::MAIN_USE_GAME_COVERS))
-    {
-      QPixmap banner = model
-                           ->data(model->index(source_index.row(),
-                                               static_cast<int>(GameListModel::Column::Banner)),
-                                  Qt::DecorationRole)
-                           .value<QPixmap>();
+  QSize size = use_covers ? QSize(160, 224) : LARGE_BANNER_SIZE;
+  QPixmap pixmap(size * model.GetScale() * QPixmap().devicePixelRatio());
 
-      banner = banner.scaled(pixmap.size(), Qt::KeepAspectRatio, Qt::SmoothTransformation);
+  if (buffer.empty() || !use_covers)
+  {
+    QPixmap banner =
+        model.data(model.index(source_row, static_cast<int>(GameListModel::Column::Banner)),
+                   Qt::DecorationRole)
+            .value<QPixmap>();
 
-      pixmap.fill();
+    banner = banner.scaled(pixmap.size(), Qt::KeepAspectRatio, Qt::SmoothTransformation);
 
-      QPainter painter(&pixmap);
+    pixmap.fill();
 
-      painter.drawPixmap(0, pixmap.height() / 2 - banner.height() / 2, banner.width(),
-                         banner.height(), banner);
+    QPainter painter(&pixmap);
 
-      return pixmap;
-    }
-    else
-    {
-      pixmap = QPixmap::fromImage(QImage::fromData(
-          reinterpret_cast<const unsigned char*>(&buffer[0]), static_cast<int>(buffer.size())));
+    painter.drawPixmap(0, pixmap.height() / 2 - banner.height() / 2, banner.width(),
+                       banner.height(), banner);
 
-      return pixmap.scaled(QSize(160, 224) * model->GetScale() * pixmap.devicePixelRatio(),
-                           Qt::KeepAspectRatio, Qt::SmoothTransformation);
-    }
+    return pixmap;
+  }
+  else
+  {
+    pixmap = QPixmap::fromImage(QImage::fromData(
+        reinterpret_cast<const unsigned char*>(&buffer[0]), static_cast<int>(buffer.size())));
+
+    return pixmap.scaled(QSize(160, 224) * model.GetScale() * pixmap.devicePixelRatio(),
+                         Qt::KeepAspectRatio, Qt::SmoothTransformation);
   }
-  return QVariant();
 }
 
 bool GridProxyModel::filterAcceptsRow(int source_row, const QModelIndex& source_parent) const
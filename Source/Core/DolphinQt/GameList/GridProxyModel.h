@@ -3,7 +3,19 @@
 
 #pragma once
 
+#include <memory>
+
+#include <QCache>
+#include <QPixmap>
 #include <QSortFilterProxyModel>
+#include <QString>
+
+class GameListModel;
+
+namespace UICommon
+{
+class GameFile;
+}
 
 // This subclass of QSortFilterProxyModel transforms the raw data into a
 // single-column large icon + name to be displayed in a QListView.
@@ -15,4 +27,19 @@ public:
   explicit GridProxyModel(QObject* parent = nullptr);
   QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
   bool filterAcceptsRow(int source_row, const QModelIndex& source_parent) const override;
+
+private:
+  // Decoding and scaling a cover is slow, and the view asks for the decoration of every visible
+  // item whenever it repaints, so the scaled pixmaps are kept until the game or scale changes.
+  struct CachedDecoration
+  {
+    std::shared_ptr<const UICommon::GameFile> game;
+    float scale;
+    bool use_covers;
+    QPixmap pixmap;
+  };
+
+  QPixmap CreateDecoration(const GameListModel& model, int source_row, bool use_covers) const;
+
+  mutable QCache<QString, CachedDecoration> m_decoration_cache;
 };
@@ -621,6 +621,7 @@ void MainWindow::ConnectHotkeys()
           &MainWindow::StateLoadLastSavedAt);
   connect(m_hotkey_scheduler, &HotkeyScheduler::StateLoadUndo, this, &MainWindow::StateLoadUndo);
   connect(m_hotkey_scheduler, &HotkeyScheduler::StateSaveUndo, this, &MainWindow::StateSaveUndo);
+  connect(m_hotkey_scheduler, &HotkeyScheduler::StateRewind, this, &MainWindow::StateRewind);
   connect(m_hotkey_scheduler, &HotkeyScheduler::StateSaveOldest, this,
           &MainWindow::StateSaveOldest);
   connect(m_hotkey_scheduler, &HotkeyScheduler::StateSaveFile, this, &MainWindow::StateSave);
@@ -1462,6 +1463,11 @@ void MainWindow::StateSaveUndo()
   State::UndoSaveState(Core::System::GetInstance());
 }
 
+void MainWindow::StateRewind()
+{
+  State::Rewind(Core::System::GetInstance());
+}
+
 void MainWindow::StateSaveOldest()
 {
   State::SaveFirstSaved(Core::System::GetInstance());
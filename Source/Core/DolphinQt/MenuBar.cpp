@@ -209,7 +209,15 @@ void MenuBar::OnWriteJitBlockLogDump()
     return;
   }
   auto& system = Core::System::GetInstance();
-  system.GetJitInterface().JitBlockLogDump(Core::CPUThreadGuard{system}, f.GetHandle());
+  const Core::CPUThreadGuard guard(system);
+  system.GetJitInterface().JitBlockLogDump(guard, f.GetHandle());
+
+  // The memory accesses which had to be backpatched go next to it.
+  const std::string fastmem_filename =
+      fmt::format("{}{}_fastmem.txt", File::GetUserPath(D_DUMPDEBUG_JITBLOCKS_IDX),
+                  SConfig::GetInstance().GetGameID());
+  if (File::IOFile fastmem_file(fastmem_filename, "w"); fastmem_file)
+    system.GetJitInterface().FastmemSiteLogDump(guard, fastmem_file.GetHandle());
   if (static bool ignore = false; ignore == false)
   {
     const int button_pressed = ModalMessageBox::information(
@@ -380,6 +388,7 @@ void MenuBar::AddStateLoadMenu(QMenu* emu_menu)
     QAction* action = m_state_load_slots_menu->addAction(QString{});
 
     connect(action, &QAction::triggered, this, [=, this]() { emit StateLoadSlotAt(i); });
+    connect(action, &QAction::hovered, this, [i] { State::PrefetchSlot(i); });
   }
 }
 
@@ -1330,16 +1339,13 @@ void MenuBar::GenerateSymbolsFromSignatureDB()
 
   const Core::CPUThreadGuard guard(system);
 
-  PPCAnalyst::FindFunctions(guard, Memory::MEM1_BASE_ADDR,
-                            Memory::MEM1_BASE_ADDR + memory.GetRamSizeReal(), &ppc_symbol_db);
-  SignatureDB db(SignatureDB::HandlerType::DSY);
-  if (db.Load(File::GetSysDirectory() + TOTALDB))
+  if (ppc_symbol_db.GenerateFromSignatureDB(guard, Memory::MEM1_BASE_ADDR,
+                                            Memory::MEM1_BASE_ADDR + memory.GetRamSizeReal(),
+                                            File::GetSysDirectory() + TOTALDB))
   {
-    db.Apply(guard, &ppc_symbol_db);
     ModalMessageBox::information(
         this, tr("Information"),
         tr("Generated symbol names from '%1'").arg(QString::fromStdString(TOTALDB)));
-    db.List();
   }
   else
   {
@@ -1562,11 +1568,9 @@ void MenuBar::LoadSymbolMap()
     {
       const Core::CPUThreadGuard guard(system);
 
-      PPCAnalyst::FindFunctions(guard, Memory::MEM1_BASE_ADDR + 0x1300000,
-                                Memory::MEM1_BASE_ADDR + memory.GetRamSizeReal(), &ppc_symbol_db);
-      SignatureDB db(SignatureDB::HandlerType::DSY);
-      if (db.Load(File::GetSysDirectory() + TOTALDB))
-        db.Apply(guard, &ppc_symbol_db);
+      ppc_symbol_db.GenerateFromSignatureDB(guard, Memory::MEM1_BASE_ADDR + 0x1300000,
+                                            Memory::MEM1_BASE_ADDR + memory.GetRamSizeReal(),
+                                            File::GetSysDirectory() + TOTALDB);
     }
 
     ModalMessageBox::warning(this, tr("Warning"),
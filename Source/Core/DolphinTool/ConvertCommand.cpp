@@ -3,11 +3,16 @@
 
 #include "DolphinTool/ConvertCommand.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cstdlib>
 #include <iostream>
 #include <limits>
+#include <memory>
 #include <optional>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include <OptionParser.h>
@@ -15,6 +20,9 @@
 #include <fmt/ostream.h>
 
 #include "Common/CommonTypes.h"
+#include "Common/FileSearch.h"
+#include "Common/FileUtil.h"
+#include "Common/StringUtil.h"
 #include "DiscIO/Blob.h"
 #include "DiscIO/DiscUtils.h"
 #include "DiscIO/ScrubbedBlob.h"
@@ -56,11 +64,267 @@ static std::optional<DiscIO::BlobType> ParseFormatString(const std::string& form
   return std::nullopt;
 }
 
+static std::string GetFormatExtension(DiscIO::BlobType format)
+{
+  switch (format)
+  {
+  case DiscIO::BlobType::GCZ:
+    return ".gcz";
+  case DiscIO::BlobType::WIA:
+    return ".wia";
+  case DiscIO::BlobType::RVZ:
+    return ".rvz";
+  default:
+    return ".iso";
+  }
+}
+
+namespace
+{
+struct ConvertSettings
+{
+  DiscIO::BlobType format;
+  bool scrub;
+  std::optional<int> block_size;
+  std::optional<DiscIO::WIARVZCompressionType> compression;
+  std::optional<int> compression_level;
+  bool zstd_dictionary;
+};
+}  // namespace
+
+// Messages are prefixed with message_prefix, so that they can be told apart in batch mode
+static bool ConvertFile(const ConvertSettings& settings, const std::string& input_file_path,
+                        const std::string& output_file_path, const std::string& message_prefix,
+                        const DiscIO::CompressCB& callback)
+{
+  const DiscIO::BlobType format = settings.format;
+  const bool scrub = settings.scrub;
+
+  // Open the blob reader
+  std::unique_ptr<DiscIO::BlobReader> blob_reader = DiscIO::CreateBlobReader(input_file_path);
+  if (!blob_reader)
+  {
+    fmt::print(std::cerr, "{}Error: The input file could not be opened.\n", message_prefix);
+    return false;
+  }
+
+  // Open the volume
+  std::unique_ptr<DiscIO::Volume> volume = DiscIO::CreateDisc(input_file_path);
+  if (!volume)
+  {
+    if (scrub)
+    {
+      fmt::print(std::cerr, "{}Error: Scrubbing is only supported for GC/Wii disc images.\n",
+                 message_prefix);
+      return false;
+    }
+
+    fmt::print(std::cerr,
+               "{}Warning: The input file is not a GC/Wii disc image. Continuing anyway.\n",
+               message_prefix);
+  }
+
+  if (scrub)
+  {
+    if (volume->IsDatelDisc())
+    {
+      fmt::print(std::cerr, "{}Error: Scrubbing a Datel disc is not supported.\n",
+                 message_prefix);
+      return false;
+    }
+
+    blob_reader = DiscIO::ScrubbedBlob::Create(input_file_path);
+
+    if (!blob_reader)
+    {
+      fmt::print(std::cerr,
+                 "{}Error: Unable to process disc image. Try again without --scrub.\n",
+                 message_prefix);
+      return false;
+    }
+  }
+
+  if (!scrub && format == DiscIO::BlobType::GCZ && volume &&
+      volume->GetVolumeType() == DiscIO::Platform::WiiDisc && !volume->IsDatelDisc())
+  {
+    fmt::print(std::cerr,
+               "{}Warning: Converting Wii disc images to GCZ without scrubbing may not offer "
+               "space advantages over ISO. Continuing anyway.\n",
+               message_prefix);
+  }
+
+  if (volume && volume->IsNKit())
+  {
+    fmt::print(std::cerr,
+               "{}Warning: Converting an NKit file, output will still be NKit! Continuing "
+               "anyway.\n",
+               message_prefix);
+  }
+
+  if (format == DiscIO::BlobType::GCZ && volume &&
+      !DiscIO::IsGCZBlockSizeLegacyCompatible(settings.block_size.value(), volume->GetDataSize()))
+  {
+    fmt::print(std::cerr,
+               "{}Warning: For GCZs to be compatible with Dolphin < 5.0-11893, the file size "
+               "must be an integer multiple of the block size and must not be an integer "
+               "multiple of the block size multiplied by 32. Continuing anyway.\n",
+               message_prefix);
+  }
+
+  // Perform the conversion
+  bool success = false;
+
+  switch (format)
+  {
+  case DiscIO::BlobType::PLAIN:
+  {
+    success =
+        DiscIO::ConvertToPlain(blob_reader.get(), input_file_path, output_file_path, callback);
+    break;
+  }
+
+  case DiscIO::BlobType::GCZ:
+  {
+    u32 sub_type = std::numeric_limits<u32>::max();
+    if (volume)
+    {
+      if (volume->GetVolumeType() == DiscIO::Platform::GameCubeDisc)
+        sub_type = 0;
+      else if (volume->GetVolumeType() == DiscIO::Platform::WiiDisc)
+        sub_type = 1;
+    }
+    success = DiscIO::ConvertToGCZ(blob_reader.get(), input_file_path, output_file_path, sub_type,
+                                   settings.block_size.value(), callback);
+    break;
+  }
+
+  case DiscIO::BlobType::WIA:
+  case DiscIO::BlobType::RVZ:
+  {
+    success = DiscIO::ConvertToWIAOrRVZ(
+        blob_reader.get(), input_file_path, output_file_path, format == DiscIO::BlobType::RVZ,
+        settings.compression.value(), settings.compression_level.value(),
+        settings.block_size.value(), settings.zstd_dictionary, callback);
+    break;
+  }
+
+  default:
+  {
+    ASSERT(false);
+    break;
+  }
+  }
+
+  if (!success)
+    fmt::print(std::cerr, "{}Error: Conversion failed\n", message_prefix);
+
+  return success;
+}
+
+// Converts several files at once. The conversions share the CPU threads between them, rather than
+// each starting one compression thread per CPU thread.
+static int ConvertBatch(const ConvertSettings& settings,
+                        const std::vector<std::string>& input_file_paths,
+                        const std::string& output_directory, size_t jobs)
+{
+  if (!File::IsDirectory(output_directory) && !File::CreateFullPath(output_directory + '/'))
+  {
+    fmt::print(std::cerr, "Error: The output directory could not be created\n");
+    return EXIT_FAILURE;
+  }
+
+  std::vector<std::string> output_file_paths;
+  std::vector<u64> input_sizes;
+  u64 total_size = 0;
+  for (const std::string& input_file_path : input_file_paths)
+  {
+    std::string name;
+    SplitPath(input_file_path, nullptr, &name, nullptr);
+    output_file_paths.push_back(output_directory + '/' + name +
+                                GetFormatExtension(settings.format));
+    if (output_file_paths.back() == input_file_path)
+    {
+      fmt::print(std::cerr, "Error: {} would be overwritten by its own output\n", input_file_path);
+      return EXIT_FAILURE;
+    }
+
+    input_sizes.push_back(File::GetSize(input_file_path));
+    total_size += input_sizes.back();
+  }
+
+  jobs = std::clamp<size_t>(jobs, 1, input_file_paths.size());
+  const unsigned int cpu_threads = std::max(1U, std::thread::hardware_concurrency());
+  DiscIO::SetCompressionThreadCount(std::max<unsigned int>(1, cpu_threads / jobs));
+
+  // Bytes of each input file that have been converted so far
+  const auto progress = std::make_unique<std::atomic<u64>[]>(input_file_paths.size());
+  std::atomic<size_t> next_file = 0;
+  std::atomic<size_t> files_done = 0;
+  std::atomic<size_t> files_failed = 0;
+
+  std::vector<std::thread> workers;
+  for (size_t i = 0; i < jobs; ++i)
+  {
+    workers.emplace_back([&] {
+      for (size_t index = next_file++; index < input_file_paths.size(); index = next_file++)
+      {
+        const auto callback = [&, index](const std::string&, float completion) {
+          progress[index].store(static_cast<u64>(completion * input_sizes[index]));
+          return true;
+        };
+
+        if (!ConvertFile(settings, input_file_paths[index], output_file_paths[index],
+                         input_file_paths[index] + ": ", callback))
+        {
+          ++files_failed;
+        }
+
+        progress[index].store(input_sizes[index]);
+        ++files_done;
+      }
+    });
+  }
+
+  // Report the throughput of all conversions together
+  const auto start_time = std::chrono::steady_clock::now();
+  const auto print_progress = [&] {
+    u64 bytes_done = 0;
+    for (size_t i = 0; i < input_file_paths.size(); ++i)
+      bytes_done += progress[i].load();
+
+    const double seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+    fmt::print(std::cout, "{}/{} files, {}/{} MiB, {:.1f} MiB/s\n", files_done.load(),
+               input_file_paths.size(), bytes_done >> 20, total_size >> 20,
+               seconds > 0 ? bytes_done / seconds / (1 << 20) : 0.0);
+  };
+
+  while (files_done.load() < input_file_paths.size())
+  {
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+    print_progress();
+  }
+
+  for (std::thread& worker : workers)
+    worker.join();
+
+  if (files_failed.load() != 0)
+  {
+    fmt::print(std::cerr, "Error: {} of {} conversions failed\n", files_failed.load(),
+               input_file_paths.size());
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
 int ConvertCommand(const std::vector<std::string>& args)
 {
   optparse::OptionParser parser;
 
   parser.usage("usage: convert [options]... [FILE]...");
+  parser.description("Converts a disc image. To convert several disc images at once, pass them "
+                     "as FILEs or pass a directory as --input, and pass a directory as --output.");
 
   parser.add_option("-u", "--user")
       .type("string")
@@ -72,13 +336,14 @@ int ConvertCommand(const std::vector<std::string>& args)
   parser.add_option("-i", "--input")
       .type("string")
       .action("store")
-      .help("Path to disc image FILE.")
+      .help("Path to disc image FILE, or to a directory of disc images.")
       .metavar("FILE");
 
   parser.add_option("-o", "--output")
       .type("string")
       .action("store")
-      .help("Path to the destination FILE.")
+      .help("Path to the destination FILE, or to the destination directory when converting "
+            "several disc images.")
       .metavar("FILE");
 
   parser.add_option("-f", "--format")
@@ -110,6 +375,19 @@ int ConvertCommand(const std::vector<std::string>& args)
       .help("Level of compression for the selected method. Ignored if 'none'. Suggested value for "
             "zstd: 5");
 
+  parser.add_option("-d", "--dictionary")
+      .action("store_true")
+      .help("Compress all chunks using a dictionary made from samples of the disc, which improves "
+            "the compression of small block sizes. Only for RVZ with zstd. Files made with this "
+            "option can't be read by older versions of Dolphin.");
+
+  parser.add_option("-j", "--jobs")
+      .type("int")
+      .action("store")
+      .help("Number of disc images to convert at the same time when converting several. The CPU "
+            "threads are divided between them. Default is 2.")
+      .set_default(2);
+
   const optparse::Values& options = parser.parse_args(args);
 
   // Initialize the dolphin user directory, required for temporary processing files
@@ -120,12 +398,27 @@ int ConvertCommand(const std::vector<std::string>& args)
   // Validate options
 
   // --input
-  if (!options.is_set("input"))
+  std::vector<std::string> input_file_paths = parser.args();
+  if (options.is_set("input"))
+  {
+    if (File::IsDirectory(options["input"]))
+    {
+      const std::vector<std::string> found = Common::DoFileSearch(
+          {options["input"]},
+          {".gcm", ".tgc", ".iso", ".ciso", ".gcz", ".wbfs", ".wia", ".rvz", ".nfs"});
+      input_file_paths.insert(input_file_paths.end(), found.begin(), found.end());
+    }
+    else
+    {
+      input_file_paths.insert(input_file_paths.begin(), options["input"]);
+    }
+  }
+  if (input_file_paths.empty())
   {
     fmt::print(std::cerr, "Error: No input set\n");
     return EXIT_FAILURE;
   }
-  const std::string& input_file_path = options["input"];
+  const bool batch = input_file_paths.size() > 1 || File::IsDirectory(options["input"]);
 
   // --output
   if (!options.is_set("output"))
@@ -144,48 +437,9 @@ int ConvertCommand(const std::vector<std::string>& args)
   }
   const DiscIO::BlobType format = format_o.value();
 
-  // Open the blob reader
-  std::unique_ptr<DiscIO::BlobReader> blob_reader = DiscIO::CreateBlobReader(input_file_path);
-  if (!blob_reader)
-  {
-    fmt::print(std::cerr, "Error: The input file could not be opened.\n");
-    return EXIT_FAILURE;
-  }
-
   // --scrub
   const bool scrub = static_cast<bool>(options.get("scrub"));
 
-  // Open the volume
-  std::unique_ptr<DiscIO::Volume> volume = DiscIO::CreateDisc(input_file_path);
-  if (!volume)
-  {
-    if (scrub)
-    {
-      fmt::print(std::cerr, "Error: Scrubbing is only supported for GC/Wii disc images.\n");
-      return EXIT_FAILURE;
-    }
-
-    fmt::print(std::cerr,
-               "Warning: The input file is not a GC/Wii disc image. Continuing anyway.\n");
-  }
-
-  if (scrub)
-  {
-    if (volume->IsDatelDisc())
-    {
-      fmt::print(std::cerr, "Error: Scrubbing a Datel disc is not supported.\n");
-      return EXIT_FAILURE;
-    }
-
-    blob_reader = DiscIO::ScrubbedBlob::Create(input_file_path);
-
-    if (!blob_reader)
-    {
-      fmt::print(std::cerr, "Error: Unable to process disc image. Try again without --scrub.\n");
-      return EXIT_FAILURE;
-    }
-  }
-
   if (scrub && format == DiscIO::BlobType::RVZ)
   {
     fmt::print(std::cerr, "Warning: Scrubbing an RVZ container does not offer significant space "
@@ -198,19 +452,6 @@ int ConvertCommand(const std::vector<std::string>& args)
                           "using external compression. Continuing anyway.\n");
   }
 
-  if (!scrub && format == DiscIO::BlobType::GCZ && volume &&
-      volume->GetVolumeType() == DiscIO::Platform::WiiDisc && !volume->IsDatelDisc())
-  {
-    fmt::print(std::cerr, "Warning: Converting Wii disc images to GCZ without scrubbing may not "
-                          "offer space advantages over ISO. Continuing anyway.\n");
-  }
-
-  if (volume && volume->IsNKit())
-  {
-    fmt::print(std::cerr,
-               "Warning: Converting an NKit file, output will still be NKit! Continuing anyway.\n");
-  }
-
   // --block_size
   std::optional<int> block_size_o;
   if (options.is_set("block_size"))
@@ -237,15 +478,6 @@ int ConvertCommand(const std::vector<std::string>& args)
       fmt::print(std::cerr,
                  "Warning: Block size is not ideal for performance. Continuing anyway.\n");
     }
-
-    if (format == DiscIO::BlobType::GCZ && volume &&
-        !DiscIO::IsGCZBlockSizeLegacyCompatible(block_size_o.value(), volume->GetDataSize()))
-    {
-      fmt::print(std::cerr,
-                 "Warning: For GCZs to be compatible with Dolphin < 5.0-11893, the file size "
-                 "must be an integer multiple of the block size and must not be an integer "
-                 "multiple of the block size multiplied by 32. Continuing anyway.\n");
-    }
   }
 
   // --compress, --compress_level
@@ -296,57 +528,27 @@ int ConvertCommand(const std::vector<std::string>& args)
     }
   }
 
-  // Perform the conversion
-  const auto NOOP_STATUS_CALLBACK = [](const std::string& text, float percent) { return true; };
-
-  bool success = false;
-
-  switch (format)
+  // --dictionary
+  const bool zstd_dictionary = static_cast<bool>(options.get("dictionary"));
+  if (zstd_dictionary && (format != DiscIO::BlobType::RVZ ||
+                          compression_o != DiscIO::WIARVZCompressionType::Zstd))
   {
-  case DiscIO::BlobType::PLAIN:
-  {
-    success = DiscIO::ConvertToPlain(blob_reader.get(), input_file_path, output_file_path,
-                                     NOOP_STATUS_CALLBACK);
-    break;
-  }
-
-  case DiscIO::BlobType::GCZ:
-  {
-    u32 sub_type = std::numeric_limits<u32>::max();
-    if (volume)
-    {
-      if (volume->GetVolumeType() == DiscIO::Platform::GameCubeDisc)
-        sub_type = 0;
-      else if (volume->GetVolumeType() == DiscIO::Platform::WiiDisc)
-        sub_type = 1;
-    }
-    success = DiscIO::ConvertToGCZ(blob_reader.get(), input_file_path, output_file_path, sub_type,
-                                   block_size_o.value(), NOOP_STATUS_CALLBACK);
-    break;
+    fmt::print(std::cerr, "Error: A dictionary can only be used for RVZ with zstd compression\n");
+    return EXIT_FAILURE;
   }
 
-  case DiscIO::BlobType::WIA:
-  case DiscIO::BlobType::RVZ:
-  {
-    success = DiscIO::ConvertToWIAOrRVZ(blob_reader.get(), input_file_path, output_file_path,
-                                        format == DiscIO::BlobType::RVZ, compression_o.value(),
-                                        compression_level_o.value(), block_size_o.value(),
-                                        NOOP_STATUS_CALLBACK);
-    break;
-  }
+  const ConvertSettings settings{format, scrub, block_size_o, compression_o,
+                                 compression_level_o, zstd_dictionary};
 
-  default:
+  if (batch)
   {
-    ASSERT(false);
-    break;
-  }
+    return ConvertBatch(settings, input_file_paths, output_file_path,
+                        static_cast<size_t>(std::max(1, static_cast<int>(options.get("jobs")))));
   }
 
-  if (!success)
-  {
-    fmt::print(std::cerr, "Error: Conversion failed\n");
+  const auto NOOP_STATUS_CALLBACK = [](const std::string& text, float percent) { return true; };
+  if (!ConvertFile(settings, input_file_paths.front(), output_file_path, "", NOOP_STATUS_CALLBACK))
     return EXIT_FAILURE;
-  }
 
   return EXIT_SUCCESS;
 }
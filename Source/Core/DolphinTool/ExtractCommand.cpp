@@ -3,9 +3,14 @@
 
 #include "DolphinTool/ExtractCommand.h"
 
+#include <algorithm>
+#include <atomic>
 #include <filesystem>
 #include <future>
 #include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 #include <fmt/format.h>
 #include <fmt/ostream.h>
@@ -21,6 +26,22 @@
 
 namespace DolphinTool
 {
+struct ExtractSettings
+{
+  // Every worker thread opens the image again, since volumes can't be read from several threads.
+  std::string input_path;
+  int jobs;
+  bool quiet;
+};
+
+struct ExtractJob
+{
+  std::string path;
+  std::string export_path;
+  u64 offset;
+  u64 size;
+};
+
 static void ExtractFile(const DiscIO::Volume& disc_volume, const DiscIO::Partition& partition,
                         const std::string& path, const std::string& out)
 {
@@ -63,22 +84,110 @@ static bool VolumeSupported(const DiscIO::Volume& disc_volume)
   }
 }
 
+// Creates the directories of the tree and lists the files that have to be extracted into it,
+// the same way DiscIO::ExportDirectory walks it.
+static void CollectFiles(const DiscIO::FileInfo& directory, const std::string& filesystem_path,
+                         const std::string& export_folder, std::vector<ExtractJob>* jobs)
+{
+  std::string export_root = export_folder + '/';
+  if (directory.IsDirectory() && !directory.IsRoot())
+    export_root += directory.GetName() + '/';
+
+  File::CreateFullPath(export_root);
+
+  for (const DiscIO::FileInfo& file_info : directory)
+  {
+    const std::string name = file_info.GetName() + (file_info.IsDirectory() ? "/" : "");
+    const std::string export_path = export_root + name;
+
+    if (file_info.IsDirectory())
+      CollectFiles(file_info, filesystem_path + name, export_root, jobs);
+    else if (File::Exists(export_path))
+      fmt::println(std::cerr, "Warning: {} already exists.", export_path);
+    else
+    {
+      jobs->push_back(
+          {filesystem_path + name, export_path, file_info.GetOffset(), file_info.GetSize()});
+    }
+  }
+}
+
+static void ExtractFilesInParallel(const DiscIO::Partition& partition,
+                                   std::vector<ExtractJob> jobs, const ExtractSettings& settings)
+{
+  // Handing out the files in disc order keeps the reads of each worker mostly sequential, and
+  // the workers close together, which matters for compressed images and Wii partition clusters.
+  std::sort(jobs.begin(), jobs.end(),
+            [](const ExtractJob& a, const ExtractJob& b) { return a.offset < b.offset; });
+
+  std::atomic<size_t> next_job = 0;
+  size_t finished_jobs = 0;
+  std::mutex output_mutex;
+
+  const auto worker = [&] {
+    const std::unique_ptr<DiscIO::Volume> volume = DiscIO::CreateVolume(settings.input_path);
+    if (!volume)
+    {
+      std::lock_guard lk(output_mutex);
+      fmt::println(std::cerr, "Error: Unable to open volume");
+      return;
+    }
+
+    for (size_t i = next_job++; i < jobs.size(); i = next_job++)
+    {
+      const ExtractJob& job = jobs[i];
+      const bool success =
+          DiscIO::ExportData(*volume, partition, job.offset, job.size, job.export_path);
+
+      std::lock_guard lk(output_mutex);
+      ++finished_jobs;
+      if (!success)
+      {
+        fmt::println(std::cerr, "Error: Could not extract {}", job.export_path);
+      }
+      else if (!settings.quiet)
+      {
+        fmt::println(std::cerr, "Extracting: {} | {}%", job.path,
+                     static_cast<int>(finished_jobs * 100 / jobs.size()));
+      }
+    }
+  };
+
+  const size_t thread_count = std::min<size_t>(settings.jobs, jobs.size());
+  std::vector<std::thread> threads;
+  threads.reserve(thread_count);
+  for (size_t i = 0; i < thread_count; ++i)
+    threads.emplace_back(worker);
+  for (std::thread& thread : threads)
+    thread.join();
+}
+
 static void ExtractDirectory(const DiscIO::Volume& disc_volume, const DiscIO::Partition& partition,
-                             const std::string& path, const std::string& out, bool quiet)
+                             const std::string& path, const std::string& out,
+                             const ExtractSettings& settings)
 {
   const DiscIO::FileSystem* filesystem = disc_volume.GetFileSystem(partition);
   if (!filesystem)
     return;
 
   const std::unique_ptr<DiscIO::FileInfo> info = filesystem->FindFileInfo(path);
+
+  if (settings.jobs > 1)
+  {
+    std::vector<ExtractJob> jobs;
+    CollectFiles(*info, "", out, &jobs);
+    ExtractFilesInParallel(partition, std::move(jobs), settings);
+    return;
+  }
+
   u32 size = info->GetTotalChildren();
   u32 files = 0;
   ExportDirectory(
       disc_volume, partition, *info, true, "", out,
-      [&files, &size, &quiet](const std::string& current) {
+      [&files, &size, &settings](const std::string& current) {
         files++;
         const float progress = static_cast<float>(files) / static_cast<float>(size) * 100;
-        if (!quiet)
+        if (!settings.quiet)
           fmt::println(std::cerr, "Extracting: {} | {}%", current, static_cast<int>(progress));
         return false;
       });
@@ -91,9 +200,9 @@ static bool ExtractSystemData(const DiscIO::Volume& disc_volume, const DiscIO::P
 }
 
 static void ExtractPartition(const DiscIO::Volume& disc_volume, const DiscIO::Partition& partition,
-                             const std::string& out, bool quiet)
+                             const std::string& out, const ExtractSettings& settings)
 {
-  ExtractDirectory(disc_volume, partition, "", out + "/files", quiet);
+  ExtractDirectory(disc_volume, partition, "", out + "/files", settings);
   ExtractSystemData(disc_volume, partition, out);
 }
 
@@ -162,14 +271,15 @@ static bool ListVolume(const DiscIO::Volume& disc_volume, const std::string& pat
 
 static bool HandleExtractPartition(const std::string& output, const std::string& single_file_path,
                                    const std::string& partition_name, DiscIO::Volume& disc_volume,
-                                   const DiscIO::Partition& partition, bool quiet, bool single)
+                                   const DiscIO::Partition& partition,
+                                   const ExtractSettings& settings, bool single)
 {
   std::string file;
   file.append(output).append("/");
   file.append(partition_name).append("/");
   if (!single)
   {
-    ExtractPartition(disc_volume, partition, file, quiet);
+    ExtractPartition(disc_volume, partition, file, settings);
     return true;
   }
 
@@ -180,7 +290,7 @@ static bool HandleExtractPartition(const std::string& output, const std::string&
     if (file_info->IsDirectory())
     {
       file = PathToString(StringToPath(file).remove_filename());
-      ExtractDirectory(disc_volume, partition, single_file_path, file, quiet);
+      ExtractDirectory(disc_volume, partition, single_file_path, file, settings);
     }
     else
     {
@@ -226,6 +336,11 @@ int Extract(const std::vector<std::string>& args)
   parser.add_option("-g", "--gameonly")
       .action("store_true")
       .help("Only extracts the DATA partition.");
+  parser.add_option("-j", "--jobs")
+      .type("int")
+      .action("store")
+      .help("Number of files to extract at the same time. Default is the number of CPU threads.")
+      .set_default(std::max(1u, std::thread::hardware_concurrency()));
 
   const optparse::Values& options = parser.parse_args(args);
 
@@ -238,6 +353,8 @@ int Extract(const std::vector<std::string>& args)
     return EXIT_FAILURE;
   }
   const std::string& input_file_path = options["input"];
+  const int jobs = std::max(1, static_cast<int>(options.get("jobs")));
+  const ExtractSettings settings{input_file_path, jobs, quiet};
 
   const std::string& output_folder_path = options["output"];
 
@@ -320,7 +437,8 @@ int Extract(const std::vector<std::string>& args)
     }
 
     extracted_one = HandleExtractPartition(output_folder_path, single_file_path, "", *disc_volume,
-                                           DiscIO::PARTITION_NONE, quiet, options.is_set("single"));
+                                           DiscIO::PARTITION_NONE, settings,
+                                           options.is_set("single"));
   }
   else
   {
@@ -338,7 +456,7 @@ int Extract(const std::vector<std::string>& args)
 
         extracted_one |=
             HandleExtractPartition(output_folder_path, single_file_path, partition_name,
-                                   *disc_volume, p, quiet, options.is_set("single"));
+                                   *disc_volume, p, settings, options.is_set("single"));
       }
     }
   }
@@ -0,0 +1,159 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DolphinTool/PackTexturesCommand.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <OptionParser.h>
+#include <fmt/format.h>
+#include <fmt/ostream.h>
+
+#include "Common/FileSearch.h"
+#include "Common/FileUtil.h"
+#include "Common/StringUtil.h"
+#include "VideoCommon/Assets/CustomTextureData.h"
+#include "VideoCommon/Assets/PackedTextureAssetLibrary.h"
+
+namespace DolphinTool
+{
+namespace
+{
+constexpr std::string_view TEXTURE_PREFIX = "tex1_";
+
+bool LoadLevel(VideoCommon::CustomTextureData::ArraySlice::Level* level, const std::string& path,
+               bool is_dds, u32 mip_level)
+{
+  return is_dds ? VideoCommon::LoadDDSTexture(level, path, mip_level) :
+                  VideoCommon::LoadPNGTexture(level, path);
+}
+
+bool LoadTexture(const std::string& path, VideoCommon::CustomTextureData::ArraySlice* slice)
+{
+  std::string directory;
+  std::string filename;
+  std::string extension;
+  SplitPath(path, &directory, &filename, &extension);
+
+  std::string extension_lower = extension;
+  Common::ToLower(&extension_lower);
+  const bool is_dds = extension_lower == ".dds";
+
+  if (is_dds)
+  {
+    VideoCommon::CustomTextureData data;
+    if (!VideoCommon::LoadDDSTexture(&data, path) || data.m_slices.size() != 1)
+      return false;
+    *slice = std::move(data.m_slices[0]);
+  }
+  else
+  {
+    slice->m_levels.emplace_back();
+    if (!LoadLevel(&slice->m_levels[0], path, false, 0))
+      return false;
+  }
+
+  // Mip levels stored as separate files, see DirectFilesystemAssetLibrary::LoadMips
+  for (u32 mip_level = static_cast<u32>(slice->m_levels.size());; mip_level++)
+  {
+    const std::string mip_path =
+        fmt::format("{}{}_mip{}{}", directory, filename, mip_level, extension);
+    if (!File::Exists(mip_path))
+      return true;
+
+    VideoCommon::CustomTextureData::ArraySlice::Level level;
+    if (!LoadLevel(&level, mip_path, is_dds, mip_level))
+    {
+      fmt::print(std::cerr, "Error: Failed to load mipmap '{}'\n", mip_path);
+      return false;
+    }
+    slice->m_levels.push_back(std::move(level));
+  }
+}
+}  // namespace
+
+int PackTexturesCommand(const std::vector<std::string>& args)
+{
+  optparse::OptionParser parser;
+
+  parser.usage("usage: packtextures [options]...");
+
+  parser.add_option("-i", "--input")
+      .type("string")
+      .action("store")
+      .help("Path to the texture pack DIRECTORY.")
+      .metavar("DIRECTORY");
+
+  parser.add_option("-o", "--output")
+      .type("string")
+      .action("store")
+      .help("Path to the destination FILE, usually named after the game ID with a \".dtp\" "
+            "extension.")
+      .metavar("FILE");
+
+  const optparse::Values& options = parser.parse_args(args);
+
+  // Validate options
+  const std::string& input_directory = options["input"];
+  if (input_directory.empty())
+  {
+    fmt::print(std::cerr, "Error: No input set\n");
+    return EXIT_FAILURE;
+  }
+
+  const std::string& output_file_path = options["output"];
+  if (output_file_path.empty())
+  {
+    fmt::print(std::cerr, "Error: No output set\n");
+    return EXIT_FAILURE;
+  }
+
+  VideoCommon::PackedTextureArchive::Writer writer;
+  if (!writer.Open(output_file_path))
+  {
+    fmt::print(std::cerr, "Error: Unable to open output file\n");
+    return EXIT_FAILURE;
+  }
+
+  u32 num_textures = 0;
+  const auto texture_paths =
+      Common::DoFileSearch({input_directory}, {".png", ".dds"}, /*recursive*/ true);
+  for (const std::string& path : texture_paths)
+  {
+    std::string filename;
+    SplitPath(path, nullptr, &filename, nullptr);
+
+    // Mip levels are packed together with their base level
+    if (!filename.starts_with(TEXTURE_PREFIX) || filename.find("_mip") != std::string::npos)
+      continue;
+
+    VideoCommon::CustomTextureData::ArraySlice slice;
+    if (!LoadTexture(path, &slice))
+    {
+      fmt::print(std::cerr, "Warning: Skipping texture '{}', it failed to load\n", path);
+      continue;
+    }
+
+    if (!writer.AddTexture(filename, slice))
+    {
+      fmt::print(std::cerr, "Warning: Skipping texture '{}', it is a duplicate or failed to write\n",
+                 path);
+      continue;
+    }
+    num_textures++;
+  }
+
+  if (!writer.Finish())
+  {
+    fmt::print(std::cerr, "Error: Failed to write the texture archive\n");
+    return EXIT_FAILURE;
+  }
+
+  fmt::print(std::cout, "Packed {} textures into '{}'\n", num_textures, output_file_path);
+  return EXIT_SUCCESS;
+}
+}  // namespace DolphinTool
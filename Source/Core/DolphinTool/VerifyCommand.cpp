@@ -99,6 +99,13 @@ int VerifyCommand(const std::vector<std::string>& args)
             "[%choices]")
       .choices({"crc32", "md5", "sha1"});
 
+  parser.add_option("-c", "--checkpoint")
+      .type("string")
+      .action("store")
+      .help("Optional. Regularly save the progress to this file, so that an interrupted "
+            "verification can be resumed by running the same command again.")
+      .metavar("FILE");
+
   const optparse::Values& options = parser.parse_args(args);
 
   // Initialize the dolphin user directory, required for temporary processing files
@@ -148,6 +155,8 @@ int VerifyCommand(const std::vector<std::string>& args)
 
   // Verify the volume
   DiscIO::VolumeVerifier verifier(*volume, false, hashes_to_calculate);
+  if (options.is_set("checkpoint"))
+    verifier.SetCheckpointPath(options["checkpoint"]);
   verifier.Start();
   while (verifier.GetBytesProcessed() != verifier.GetTotalBytes())
   {
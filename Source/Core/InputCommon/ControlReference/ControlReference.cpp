@@ -28,9 +28,17 @@ void ControlReference::UpdateReference(ciface::ExpressionParser::ControlEnvironm
   if (m_parsed_expression)
   {
     m_parsed_expression->UpdateReferences(env);
+    CompileExpression();
   }
 }
 
+void ControlReference::CompileExpression()
+{
+  m_compiled_expression.reset();
+  if (m_parsed_expression && IsInput())
+    m_compiled_expression = ciface::ExpressionParser::CompileExpression(*m_parsed_expression);
+}
+
 int ControlReference::BoundCount() const
 {
   if (m_parsed_expression)
@@ -52,9 +60,13 @@ std::string ControlReference::GetExpression() const
 std::optional<std::string> ControlReference::SetExpression(std::string expr)
 {
   m_expression = std::move(expr);
+  m_expression_empty.store(m_expression.empty(), std::memory_order_relaxed);
   auto parse_result = ParseExpression(m_expression);
   m_parse_status = parse_result.status;
+  // The compiled expression points into the old one
+  m_compiled_expression.reset();
   m_parsed_expression = std::move(parse_result.expr);
+  CompileExpression();
   return parse_result.description;
 }
 
@@ -87,9 +99,12 @@ bool OutputReference::IsInput() const
 //
 ControlState InputReference::State(const ControlState ignore)
 {
-  if (m_parsed_expression && GetInputGate())
-    return m_parsed_expression->GetValue() * range;
-  return 0.0;
+  if (!m_parsed_expression || !GetInputGate())
+    return 0.0;
+
+  if (m_compiled_expression)
+    return m_compiled_expression->GetValue() * range;
+  return m_parsed_expression->GetValue() * range;
 }
 
 //
@@ -3,8 +3,10 @@
 
 #pragma once
 
+#include <atomic>
 #include <cmath>
 #include <memory>
+#include <optional>
 
 #include "InputCommon/ControlReference/ExpressionParser.h"
 #include "InputCommon/ControllerInterface/CoreDevice.h"
@@ -46,6 +48,9 @@ public:
   ciface::ExpressionParser::ParseStatus GetParseStatus() const;
   void UpdateReference(ciface::ExpressionParser::ControlEnvironment& env);
   std::string GetExpression() const;
+  // Cheaper than GetExpression().empty(), which copies the expression. Settings check it whenever
+  // their value is read.
+  bool IsExpressionEmpty() const { return m_expression_empty.load(std::memory_order_relaxed); }
 
   // Returns a human-readable error description when the given expression is invalid.
   std::optional<std::string> SetExpression(std::string expr);
@@ -54,8 +59,12 @@ public:
 
 protected:
   ControlReference();
+  void CompileExpression();
   std::string m_expression;
+  std::atomic<bool> m_expression_empty = true;
   std::unique_ptr<ciface::ExpressionParser::Expression> m_parsed_expression;
+  // Inputs are evaluated through this, compiled whenever the expression or its references change.
+  std::optional<ciface::ExpressionParser::CompiledExpression> m_compiled_expression;
   ciface::ExpressionParser::ParseStatus m_parse_status =
       ciface::ExpressionParser::ParseStatus::EmptyExpression;
 };
@@ -4,6 +4,7 @@
 #include "InputCommon/ControlReference/ExpressionParser.h"
 
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <functional>
 #include <iostream>
@@ -45,6 +46,10 @@ public:
 
   bool IsSuppressed(Device::Input* input) const
   {
+    // This is checked for every control on every poll while hotkeys rarely suppress anything.
+    if (m_suppressions.empty())
+      return false;
+
     // Input is suppressed if it exists in the map at all.
     return m_suppressions.lower_bound({input, nullptr}) !=
            m_suppressions.lower_bound({input + 1, nullptr});
@@ -74,6 +79,150 @@ private:
 
 static HotkeySuppressions s_hotkey_suppressions;
 
+static ControlState ApplyBinaryOp(TokenType op, ControlState lhs, ControlState rhs)
+{
+  switch (op)
+  {
+  case TOK_AND:
+    return std::min(lhs, rhs);
+  case TOK_OR:
+    return std::max(lhs, rhs);
+  case TOK_ADD:
+    return lhs + rhs;
+  case TOK_SUB:
+    return lhs - rhs;
+  case TOK_MUL:
+    return lhs * rhs;
+  case TOK_DIV:
+  {
+    const ControlState result = lhs / rhs;
+    return std::isinf(result) ? 0.0 : result;
+  }
+  case TOK_MOD:
+  {
+    const ControlState result = std::fmod(lhs, rhs);
+    return std::isnan(result) ? 0.0 : result;
+  }
+  case TOK_LTHAN:
+    return lhs < rhs;
+  case TOK_GTHAN:
+    return lhs > rhs;
+  case TOK_COMMA:
+    // lhs was evaluated and is discarded
+    return rhs;
+  case TOK_XOR:
+    return std::max(std::min(1 - lhs, rhs), std::min(lhs, 1 - rhs));
+  default:
+    ASSERT(false);
+    return 0;
+  }
+}
+
+// Deeper expressions are evaluated through the tree.
+constexpr size_t COMPILED_EXPRESSION_MAX_DEPTH = 32;
+
+class ExpressionCompiler
+{
+public:
+  using Instruction = CompiledExpression::Instruction;
+  using Opcode = CompiledExpression::Opcode;
+
+  void EmitLiteral(ControlState value) { Push(Opcode::Literal).literal = value; }
+  void EmitInput(Device::Input* input) { Push(Opcode::Input).input = input; }
+  void EmitVariable(const ControlState* variable) { Push(Opcode::Variable).variable = variable; }
+  void EmitTree(const Expression& expr) { Push(Opcode::Tree).tree = &expr; }
+
+  // Combines the values of the two previously compiled operands.
+  void EmitBinary(TokenType op)
+  {
+    auto& instructions = m_compiled.m_instructions;
+    const size_t size = instructions.size();
+
+    // An operand that isn't a single literal ends with the instruction that computes it.
+    if (instructions[size - 2].opcode == Opcode::Literal &&
+        instructions[size - 1].opcode == Opcode::Literal)
+    {
+      const ControlState value =
+          ApplyBinaryOp(op, instructions[size - 2].literal, instructions[size - 1].literal);
+      instructions.resize(size - 2);
+      m_depth -= 2;
+      EmitLiteral(value);
+      return;
+    }
+
+    Instruction& instruction = instructions.emplace_back();
+    instruction.opcode = Opcode::Binary;
+    instruction.binary_op = op;
+    --m_depth;
+  }
+
+  std::optional<CompiledExpression> Finish()
+  {
+    if (m_max_depth > COMPILED_EXPRESSION_MAX_DEPTH)
+      return std::nullopt;
+    return std::move(m_compiled);
+  }
+
+private:
+  Instruction& Push(Opcode opcode)
+  {
+    m_max_depth = std::max(m_max_depth, ++m_depth);
+    Instruction& instruction = m_compiled.m_instructions.emplace_back();
+    instruction.opcode = opcode;
+    return instruction;
+  }
+
+  CompiledExpression m_compiled;
+  size_t m_depth = 0;
+  size_t m_max_depth = 0;
+};
+
+void Expression::Compile(ExpressionCompiler& compiler) const
+{
+  compiler.EmitTree(*this);
+}
+
+ControlState CompiledExpression::GetValue() const
+{
+  std::array<ControlState, COMPILED_EXPRESSION_MAX_DEPTH> stack;
+  size_t depth = 0;
+
+  for (const Instruction& instruction : m_instructions)
+  {
+    switch (instruction.opcode)
+    {
+    case Opcode::Literal:
+      stack[depth++] = instruction.literal;
+      break;
+    case Opcode::Input:
+      // Same as ControlExpression::GetValue
+      stack[depth++] = s_hotkey_suppressions.IsSuppressed(instruction.input) ?
+                           0.0 :
+                           std::max(0.0, instruction.input->GetState());
+      break;
+    case Opcode::Variable:
+      stack[depth++] = *instruction.variable;
+      break;
+    case Opcode::Tree:
+      stack[depth++] = instruction.tree->GetValue();
+      break;
+    case Opcode::Binary:
+      --depth;
+      stack[depth - 1] = ApplyBinaryOp(instruction.binary_op, stack[depth - 1], stack[depth]);
+      break;
+    }
+  }
+
+  return stack[0];
+}
+
+std::optional<CompiledExpression> CompileExpression(const Expression& expr)
+{
+  ExpressionCompiler compiler;
+  expr.Compile(compiler);
+  return compiler.Finish();
+}
+
 Token::Token(TokenType type_) : type(type_)
 {
 }
@@ -283,6 +432,14 @@ public:
     m_output = env.FindOutput(m_qualifier);
   }
 
+  void Compile(ExpressionCompiler& compiler) const override
+  {
+    if (m_input)
+      compiler.EmitInput(m_input);
+    else
+      compiler.EmitLiteral(0.0);
+  }
+
   Device::Input* GetInput() const { return m_input; };
 
 private:
@@ -346,54 +503,29 @@ public:
 
   ControlState GetValue() const override
   {
-    switch (op)
-    {
-    case TOK_AND:
-      return std::min(lhs->GetValue(), rhs->GetValue());
-    case TOK_OR:
-      return std::max(lhs->GetValue(), rhs->GetValue());
-    case TOK_ADD:
-      return lhs->GetValue() + rhs->GetValue();
-    case TOK_SUB:
-      return lhs->GetValue() - rhs->GetValue();
-    case TOK_MUL:
-      return lhs->GetValue() * rhs->GetValue();
-    case TOK_DIV:
-    {
-      const ControlState result = lhs->GetValue() / rhs->GetValue();
-      return std::isinf(result) ? 0.0 : result;
-    }
-    case TOK_MOD:
-    {
-      const ControlState result = std::fmod(lhs->GetValue(), rhs->GetValue());
-      return std::isnan(result) ? 0.0 : result;
-    }
-    case TOK_ASSIGN:
+    if (op == TOK_ASSIGN)
     {
       // Use this carefully as it's extremely powerful and can end up in unforeseen situations
       lhs->SetValue(rhs->GetValue());
       return lhs->GetValue();
     }
-    case TOK_LTHAN:
-      return lhs->GetValue() < rhs->GetValue();
-    case TOK_GTHAN:
-      return lhs->GetValue() > rhs->GetValue();
-    case TOK_COMMA:
-    {
-      // Eval and discard lhs:
-      lhs->GetValue();
-      return rhs->GetValue();
-    }
-    case TOK_XOR:
+
+    const ControlState lhs_value = lhs->GetValue();
+    return ApplyBinaryOp(op, lhs_value, rhs->GetValue());
+  }
+
+  void Compile(ExpressionCompiler& compiler) const override
+  {
+    // Assignments need the tree to set the value of lhs
+    if (op == TOK_ASSIGN)
     {
-      const auto lval = lhs->GetValue();
-      const auto rval = rhs->GetValue();
-      return std::max(std::min(1 - lval, rval), std::min(lval, 1 - rval));
-    }
-    default:
-      ASSERT(false);
-      return 0;
+      compiler.EmitTree(*this);
+      return;
     }
+
+    lhs->Compile(compiler);
+    rhs->Compile(compiler);
+    compiler.EmitBinary(op);
   }
 
   void SetValue(ControlState value) override
@@ -442,6 +574,8 @@ public:
 
   ControlState GetValue() const override { return m_value; }
 
+  void Compile(ExpressionCompiler& compiler) const override { compiler.EmitLiteral(m_value); }
+
   std::string GetName() const override { return ValueToString(m_value); }
 
 private:
@@ -477,6 +611,14 @@ public:
     m_variable_ptr = env.GetVariablePtr(m_name);
   }
 
+  void Compile(ExpressionCompiler& compiler) const override
+  {
+    if (m_variable_ptr)
+      compiler.EmitVariable(m_variable_ptr.get());
+    else
+      compiler.EmitLiteral(0.0);
+  }
+
 protected:
   const std::string m_name;
   std::shared_ptr<ControlState> m_variable_ptr;
@@ -583,6 +725,9 @@ public:
   ControlState GetValue() const override { return GetActiveChild()->GetValue(); }
   void SetValue(ControlState value) override { GetActiveChild()->SetValue(value); }
 
+  // The active child only changes when the references are updated
+  void Compile(ExpressionCompiler& compiler) const override { GetActiveChild()->Compile(compiler); }
+
   int CountNumControls() const override { return GetActiveChild()->CountNumControls(); }
   void UpdateReferences(ControlEnvironment& env) override
   {
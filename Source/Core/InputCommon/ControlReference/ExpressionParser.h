@@ -7,6 +7,7 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <vector>
 
 #include "InputCommon/ControllerInterface/CoreDevice.h"
 
@@ -164,6 +165,8 @@ private:
   const Core::DeviceQualifier& default_device;
 };
 
+class ExpressionCompiler;
+
 class Expression
 {
 public:
@@ -172,8 +175,53 @@ public:
   virtual void SetValue(ControlState state) = 0;
   virtual int CountNumControls() const = 0;
   virtual void UpdateReferences(ControlEnvironment& finder) = 0;
+
+  // Appends the instructions that compute GetValue(), see CompiledExpression. By default the
+  // compiled expression calls GetValue() itself.
+  virtual void Compile(ExpressionCompiler& compiler) const;
 };
 
+// Flat, stack-based form of an input expression. Literals, controls, variables and operators are
+// evaluated in a single loop with direct pointers to the bound inputs, and operations on constants
+// are folded. Other parts of the expression (e.g. functions) are still evaluated through the tree.
+// The compiled form points into the expression it was compiled from, so it has to be compiled
+// again whenever the expression's references are updated.
+class CompiledExpression
+{
+public:
+  ControlState GetValue() const;
+
+private:
+  friend class ExpressionCompiler;
+
+  enum class Opcode : u8
+  {
+    Literal,
+    Input,
+    Variable,
+    Tree,
+    Binary,
+  };
+
+  struct Instruction
+  {
+    Opcode opcode = Opcode::Literal;
+    TokenType binary_op = TOK_INVALID;
+    union
+    {
+      ControlState literal = 0;
+      Core::Device::Input* input;
+      const ControlState* variable;
+      const Expression* tree;
+    };
+  };
+
+  std::vector<Instruction> m_instructions;
+};
+
+// Returns nothing when the expression is too deeply nested to be compiled.
+std::optional<CompiledExpression> CompileExpression(const Expression& expr);
+
 class ParseResult
 {
 public:
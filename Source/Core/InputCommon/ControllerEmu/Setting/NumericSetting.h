@@ -184,7 +184,7 @@ public:
     return m_value;
   }
 
-  bool IsSimpleValue() const { return m_input.GetExpression().empty(); }
+  bool IsSimpleValue() const { return m_input.IsExpressionEmpty(); }
 
   void SetValue(ValueType value)
   {
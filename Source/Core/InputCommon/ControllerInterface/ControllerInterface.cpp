@@ -4,9 +4,13 @@
 #include "InputCommon/ControllerInterface/ControllerInterface.h"
 
 #include <algorithm>
+#include <chrono>
 
 #include "Common/Assert.h"
+#include "Common/Config/Config.h"
 #include "Common/Logging/Log.h"
+#include "Common/Thread.h"
+#include "Core/Config/MainSettings.h"
 #include "Core/HW/WiimoteReal/WiimoteReal.h"
 
 #ifdef CIFACE_USE_WIN32
@@ -99,6 +103,9 @@ void ControllerInterface::Initialize(const WindowSystemInfo& wsi)
 
   if (m_populating_devices_counter.fetch_sub(1) == 1 && !devices_empty)
     InvokeDevicesChangedCallbacks();
+
+  if (Config::Get(Config::MAIN_INPUT_POLLING_THREAD))
+    StartPollingThread();
 }
 
 void ControllerInterface::ChangeWindow(void* hwnd, WindowChangeReason reason)
@@ -187,6 +194,8 @@ void ControllerInterface::Shutdown()
   if (!m_is_init)
     return;
 
+  StopPollingThread();
+
   // Prevent additional devices from being added during shutdown.
   m_is_init = false;
   // Additional safety measure to avoid InvokeDevicesChangedCallbacks()
@@ -333,6 +342,17 @@ void ControllerInterface::UpdateInput()
   if (!m_is_init)
     return;
 
+  UpdateDevices(false);
+}
+
+void ControllerInterface::UpdateDevices(bool from_polling_thread)
+{
+  // While the polling thread runs, it exclusively updates the devices that support it.
+  const bool polling_thread_running = m_polling_thread_running.IsSet();
+  const auto should_update = [&](const auto& object) {
+    return !polling_thread_running || object.CanUpdateInBackground() == from_polling_thread;
+  };
+
   // We add the devices to remove while we still have the "m_devices_mutex" locked.
   // This guarantees that:
   // -We won't try to lock "m_devices_population_mutex" while it was already locked and waiting
@@ -345,8 +365,10 @@ void ControllerInterface::UpdateInput()
   {
     // TODO: if we are an emulation input channel, we should probably always lock.
     // Prefer outdated values over blocking UI or CPU thread (this avoids short but noticeable frame
-    // drops)
-    if (!m_devices_mutex.try_lock())
+    // drops). The polling thread isn't in a hurry, so it waits.
+    if (from_polling_thread)
+      m_devices_mutex.lock();
+    else if (!m_devices_mutex.try_lock())
       return;
 
     std::lock_guard lk_devices(m_devices_mutex, std::adopt_lock);
@@ -354,13 +376,16 @@ void ControllerInterface::UpdateInput()
     tls_is_updating_devices = true;
 
     for (auto& backend : m_input_backends)
-      backend->UpdateInput(devices_to_remove);
+    {
+      if (should_update(*backend))
+        backend->UpdateInput(devices_to_remove);
+    }
 
     for (const auto& d : m_devices)
     {
       // Theoretically we could avoid updating input on devices that don't have any references to
       // them, but in practice a few devices types could break in different ways, so we don't
-      if (d->UpdateInput() == ciface::Core::DeviceRemoval::Remove)
+      if (should_update(*d) && d->UpdateInput() == ciface::Core::DeviceRemoval::Remove)
         devices_to_remove.push_back(d);
     }
 
@@ -378,6 +403,36 @@ void ControllerInterface::UpdateInput()
   }
 }
 
+void ControllerInterface::StartPollingThread()
+{
+  if (m_polling_thread_running.TestAndSet())
+    m_polling_thread = std::thread(&ControllerInterface::PollingThreadLoop, this);
+}
+
+void ControllerInterface::StopPollingThread()
+{
+  if (m_polling_thread_running.TestAndClear())
+    m_polling_thread.join();
+}
+
+void ControllerInterface::PollingThreadLoop()
+{
+  Common::SetCurrentThreadName("Input Polling");
+  INFO_LOG_FMT(CONTROLLERINTERFACE, "Input polling thread started");
+
+  // Roughly the polling rate of most USB controllers.
+  constexpr auto POLLING_PERIOD = std::chrono::milliseconds(1);
+
+  auto next_poll = std::chrono::steady_clock::now();
+  while (m_polling_thread_running.IsSet())
+  {
+    UpdateDevices(true);
+
+    next_poll = std::max(next_poll + POLLING_PERIOD, std::chrono::steady_clock::now());
+    std::this_thread::sleep_until(next_poll);
+  }
+}
+
 void ControllerInterface::SetCurrentInputChannel(ciface::InputChannel input_channel)
 {
   tls_input_channel = input_channel;
@@ -8,7 +8,9 @@
 #include <list>
 #include <memory>
 #include <mutex>
+#include <thread>
 
+#include "Common/Flag.h"
 #include "Common/Matrix.h"
 #include "Common/WindowSystemInfo.h"
 #include "InputCommon/ControllerInterface/CoreDevice.h"
@@ -126,6 +128,11 @@ public:
 
 private:
   void ClearDevices();
+  void UpdateDevices(bool from_polling_thread);
+
+  void StartPollingThread();
+  void StopPollingThread();
+  void PollingThreadLoop();
 
   std::list<std::function<void()>> m_devices_changed_callbacks;
   mutable std::recursive_mutex m_devices_population_mutex;
@@ -140,6 +147,12 @@ private:
   std::atomic<bool> m_requested_mouse_centering = false;
 
   std::vector<std::unique_ptr<ciface::InputBackend>> m_input_backends;
+
+  // Updates the devices and backends that can be updated in the background, so that a slow
+  // controller driver doesn't stall the CPU thread. The other ones are still updated by the input
+  // channels, as their state depends on which channel is reading it.
+  std::thread m_polling_thread;
+  Common::Flag m_polling_thread_running;
 };
 
 namespace ciface
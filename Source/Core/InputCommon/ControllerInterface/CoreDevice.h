@@ -131,6 +131,10 @@ public:
   std::string GetQualifiedName() const;
   virtual DeviceRemoval UpdateInput() { return DeviceRemoval::Keep; }
 
+  // Whether UpdateInput() may be called from the input polling thread. The state of such devices
+  // must not depend on the input channel or on how often they are updated.
+  virtual bool CanUpdateInBackground() const { return false; }
+
   // May be overridden to implement hotplug removal.
   // Currently handled on a per-backend basis but this could change.
   virtual bool IsValid() const { return true; }
@@ -58,6 +58,7 @@ private:
 
 public:
   Core::DeviceRemoval UpdateInput() override;
+  bool CanUpdateInBackground() const override { return true; }
 
   Joystick(const LPDIRECTINPUTDEVICE8 device);
   ~Joystick();
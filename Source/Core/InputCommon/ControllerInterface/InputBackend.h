@@ -28,6 +28,9 @@ public:
   // just add them to the removal list if necessary.
   virtual void UpdateInput(std::vector<std::weak_ptr<ciface::Core::Device>>& devices_to_remove);
 
+  // Whether UpdateInput() may be called from the input polling thread.
+  virtual bool CanUpdateInBackground() const { return false; }
+
   virtual void HandleWindowChange();
 
   ControllerInterface& GetControllerInterface();
@@ -284,6 +284,7 @@ public:
   ~InputBackend();
   void PopulateDevices() override;
   void UpdateInput(std::vector<std::weak_ptr<ciface::Core::Device>>& devices_to_remove) override;
+  bool CanUpdateInBackground() const override { return true; }
 
 private:
   void OpenAndAddDevice(int index);
@@ -34,6 +34,7 @@ public:
   int GetSortPriority() const override { return -2; }
 
   Core::DeviceRemoval UpdateInput() override;
+  bool CanUpdateInBackground() const override { return true; }
 
   void UpdateMotors();
 
@@ -4,17 +4,22 @@
 #include "InputCommon/ControllerInterface/evdev/evdev.h"
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cstring>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 
 #include <fcntl.h>
 #include <libudev.h>
+#include <sys/epoll.h>
 #include <sys/eventfd.h>
 #include <unistd.h>
 
 #include "Common/Assert.h"
+#include "Common/CommonFuncs.h"
 #include "Common/Flag.h"
 #include "Common/Logging/Log.h"
 #include "Common/MathUtil.h"
@@ -41,6 +46,12 @@ public:
   // separate thread *shrug*
   void CloseDescriptor(int fd) { m_cleanup_thread.Push(fd); }
 
+  // The hotplug thread also waits for events on the device descriptors and sets their readable
+  // flag, so that updates don't have to read every idle device. Returns false if the descriptor
+  // couldn't be watched.
+  bool WatchDescriptor(int fd, std::shared_ptr<std::atomic<bool>> readable);
+  void UnwatchDescriptor(int fd);
+
 private:
   std::shared_ptr<evdevDevice>
   FindDeviceWithUniqueIDAndPhysicalLocation(const char* unique_id, const char* physical_location);
@@ -50,10 +61,16 @@ private:
   void StartHotplugThread();
   void StopHotplugThread();
   void HotplugThreadFunc();
+  void HandleUdevEvent(udev_monitor* monitor);
+  void MarkDescriptorReadable(int fd);
 
   std::thread m_hotplug_thread;
   Common::Flag m_hotplug_thread_running;
   int m_wakeup_eventfd;
+  int m_epoll_fd = -1;
+
+  std::mutex m_watched_descriptors_mutex;
+  std::map<int, std::shared_ptr<std::atomic<bool>>> m_watched_descriptors;
 
   // There is no easy way to get the device name from only a dev node
   // during a device removed event, since libevdev can't work on removed devices;
@@ -341,55 +358,114 @@ void InputBackend::HotplugThreadFunc()
   udev_monitor_enable_receiving(monitor);
   const int monitor_fd = udev_monitor_get_fd(monitor);
 
+  for (const int fd : {monitor_fd, m_wakeup_eventfd})
+  {
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.fd = fd;
+    if (epoll_ctl(m_epoll_fd, EPOLL_CTL_ADD, fd, &event) != 0)
+    {
+      ERROR_LOG_FMT(CONTROLLERINTERFACE, "evdev epoll_ctl failed: {}",
+                    Common::LastStrerrorString());
+    }
+  }
+
+  std::array<epoll_event, 32> events;
   while (m_hotplug_thread_running.IsSet())
   {
-    fd_set fds;
+    const int count = epoll_wait(m_epoll_fd, events.data(), int(events.size()), -1);
 
-    FD_ZERO(&fds);
-    FD_SET(monitor_fd, &fds);
-    FD_SET(m_wakeup_eventfd, &fds);
+    // Flag all the devices first, the udev events may take a while to handle.
+    bool monitor_ready = false;
+    for (int i = 0; i < count; ++i)
+    {
+      const int fd = events[i].data.fd;
+      if (fd == monitor_fd)
+        monitor_ready = true;
+      else if (fd != m_wakeup_eventfd)
+        MarkDescriptorReadable(fd);
+    }
 
-    const int ret =
-        select(std::max(monitor_fd, m_wakeup_eventfd) + 1, &fds, nullptr, nullptr, nullptr);
-    if (ret < 1 || !FD_ISSET(monitor_fd, &fds))
-      continue;
+    if (monitor_ready)
+      HandleUdevEvent(monitor);
+  }
+  NOTICE_LOG_FMT(CONTROLLERINTERFACE, "evdev hotplug thread stopped");
+}
 
-    udev_device* const dev = udev_monitor_receive_device(monitor);
-    Common::ScopeGuard dev_guard([dev] { udev_device_unref(dev); });
+void InputBackend::HandleUdevEvent(udev_monitor* monitor)
+{
+  udev_device* const dev = udev_monitor_receive_device(monitor);
+  if (!dev)
+    return;
+  Common::ScopeGuard dev_guard([dev] { udev_device_unref(dev); });
 
-    const char* const action = udev_device_get_action(dev);
-    const char* const devnode = udev_device_get_devnode(dev);
-    if (!devnode)
-      continue;
+  const char* const action = udev_device_get_action(dev);
+  const char* const devnode = udev_device_get_devnode(dev);
+  if (!devnode)
+    return;
 
-    // Use GetControllerInterface().PlatformPopulateDevices() to protect access around
-    // m_devnode_objects. Note that even if we get these events at the same time as a
-    // a PopulateDevices() request (e.g. on start up, we might get all the add events
-    // for connected devices), this won't ever cause duplicate devices as AddDeviceNode()
-    // automatically removes the old one if it already existed
-    if (strcmp(action, "remove") == 0)
-    {
-      GetControllerInterface().PlatformPopulateDevices([&devnode, this] {
-        std::shared_ptr<evdevDevice> ptr;
+  // Use GetControllerInterface().PlatformPopulateDevices() to protect access around
+  // m_devnode_objects. Note that even if we get these events at the same time as a
+  // a PopulateDevices() request (e.g. on start up, we might get all the add events
+  // for connected devices), this won't ever cause duplicate devices as AddDeviceNode()
+  // automatically removes the old one if it already existed
+  if (strcmp(action, "remove") == 0)
+  {
+    GetControllerInterface().PlatformPopulateDevices([&devnode, this] {
+      std::shared_ptr<evdevDevice> ptr;
 
-        const auto it = m_devnode_objects.find(devnode);
-        if (it != m_devnode_objects.end())
-          ptr = it->second.lock();
+      const auto it = m_devnode_objects.find(devnode);
+      if (it != m_devnode_objects.end())
+        ptr = it->second.lock();
 
-        // If we don't recognize this device, ptr will be null and no device will be removed.
+      // If we don't recognize this device, ptr will be null and no device will be removed.
 
-        GetControllerInterface().RemoveDevice([&ptr](const auto* device) {
-          return static_cast<const evdevDevice*>(device) == ptr.get();
-        });
+      GetControllerInterface().RemoveDevice([&ptr](const auto* device) {
+        return static_cast<const evdevDevice*>(device) == ptr.get();
       });
-    }
-    else if (strcmp(action, "add") == 0)
-    {
-      GetControllerInterface().PlatformPopulateDevices(
-          [&devnode, this] { AddDeviceNode(devnode); });
-    }
+    });
+  }
+  else if (strcmp(action, "add") == 0)
+  {
+    GetControllerInterface().PlatformPopulateDevices(
+        [&devnode, this] { AddDeviceNode(devnode); });
   }
-  NOTICE_LOG_FMT(CONTROLLERINTERFACE, "evdev hotplug thread stopped");
+}
+
+void InputBackend::MarkDescriptorReadable(int fd)
+{
+  std::lock_guard lk(m_watched_descriptors_mutex);
+  const auto it = m_watched_descriptors.find(fd);
+  if (it != m_watched_descriptors.end())
+    it->second->store(true);
+}
+
+bool InputBackend::WatchDescriptor(int fd, std::shared_ptr<std::atomic<bool>> readable)
+{
+  std::lock_guard lk(m_watched_descriptors_mutex);
+  if (m_epoll_fd == -1)
+    return false;
+
+  // Edge triggered, the flag is cleared by whoever drains the descriptor.
+  epoll_event event{};
+  event.events = EPOLLIN | EPOLLET;
+  event.data.fd = fd;
+  if (epoll_ctl(m_epoll_fd, EPOLL_CTL_ADD, fd, &event) != 0)
+  {
+    WARN_LOG_FMT(CONTROLLERINTERFACE, "evdev couldn't watch descriptor: {}",
+                 Common::LastStrerrorString());
+    return false;
+  }
+
+  m_watched_descriptors.emplace(fd, std::move(readable));
+  return true;
+}
+
+void InputBackend::UnwatchDescriptor(int fd)
+{
+  std::lock_guard lk(m_watched_descriptors_mutex);
+  if (m_watched_descriptors.erase(fd) != 0 && m_epoll_fd != -1)
+    epoll_ctl(m_epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
 }
 
 void InputBackend::StartHotplugThread()
@@ -403,6 +479,8 @@ void InputBackend::StartHotplugThread()
 
   m_wakeup_eventfd = eventfd(0, 0);
   ASSERT_MSG(CONTROLLERINTERFACE, m_wakeup_eventfd != -1, "Couldn't create eventfd.");
+  m_epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+  ASSERT_MSG(CONTROLLERINTERFACE, m_epoll_fd != -1, "Couldn't create epoll instance.");
   m_hotplug_thread = std::thread(&InputBackend::HotplugThreadFunc, this);
 }
 
@@ -415,12 +493,17 @@ void InputBackend::StopHotplugThread()
     return;
   }
 
-  // Write something to efd so that select() stops blocking.
+  // Write something to efd so that epoll_wait() stops blocking.
   const uint64_t value = 1;
   static_cast<void>(!write(m_wakeup_eventfd, &value, sizeof(uint64_t)));
 
   m_hotplug_thread.join();
   close(m_wakeup_eventfd);
+
+  std::lock_guard lk(m_watched_descriptors_mutex);
+  close(m_epoll_fd);
+  m_epoll_fd = -1;
+  m_watched_descriptors.clear();
 }
 
 InputBackend::InputBackend(ControllerInterface* controller_interface)
@@ -475,7 +558,10 @@ InputBackend::~InputBackend()
 
 bool evdevDevice::AddNode(std::string devnode, int fd, libevdev* dev)
 {
-  m_nodes.emplace_back(Node{std::move(devnode), fd, dev});
+  auto readable = std::make_shared<std::atomic<bool>>(true);
+  if (!m_input_backend.WatchDescriptor(fd, readable))
+    readable.reset();
+  m_nodes.emplace_back(Node{std::move(devnode), fd, dev, std::move(readable)});
 
   // Take on the alphabetically first name.
   const auto potential_new_name = StripWhitespace(libevdev_get_name(dev));
@@ -673,6 +759,7 @@ evdevDevice::~evdevDevice()
   for (auto& node : m_nodes)
   {
     m_input_backend.RemoveDevnodeObject(node.devnode);
+    m_input_backend.UnwatchDescriptor(node.fd);
     libevdev_free(node.device);
     m_input_backend.CloseDescriptor(node.fd);
   }
@@ -690,6 +777,11 @@ Core::DeviceRemoval evdevDevice::UpdateInput()
   // later with libevdev_fetch_event_value()
   for (auto& node : m_nodes)
   {
+    // Skip the nodes that haven't had any events since they were last drained. The flag is
+    // cleared first so that events arriving while we read set it again.
+    if (node.readable && !node.readable->exchange(false))
+      continue;
+
     int rc = LIBEVDEV_READ_STATUS_SUCCESS;
     while (rc >= 0)
     {
@@ -4,6 +4,8 @@
 #pragma once
 
 #include <libevdev/libevdev.h>
+#include <atomic>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -73,6 +75,7 @@ private:
 
 public:
   Core::DeviceRemoval UpdateInput() override;
+  bool CanUpdateInBackground() const override { return true; }
   bool IsValid() const override;
 
   evdevDevice(InputBackend* input_backend);
@@ -95,6 +98,9 @@ private:
     std::string devnode;
     int fd;
     libevdev* device;
+    // Set by the backend's event thread when the descriptor has new events. Nodes that couldn't
+    // be watched have no flag and are read on every update.
+    std::shared_ptr<std::atomic<bool>> readable;
   };
 
   std::vector<Node> m_nodes;
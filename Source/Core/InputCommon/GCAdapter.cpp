@@ -13,6 +13,8 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
+#include <chrono>
 #include <mutex>
 #include <optional>
 
@@ -64,10 +66,12 @@ constexpr unsigned int USB_TIMEOUT_MS = 100;
 static bool CheckDeviceAccess(libusb_device* device);
 static void AddGCAdapter(libusb_device* device);
 static void ResetRumbleLockNeeded();
+static void RunReadTransfers();
 #endif
 
 static void Reset();
 static void Setup();
+static void ResetPortStates();
 static void ProcessInputPayload(const u8* data, std::size_t size);
 static void ReadThreadFunc();
 static void WriteThreadFunc();
@@ -106,18 +110,34 @@ constexpr size_t CONTROLLER_OUTPUT_INIT_PAYLOAD_SIZE = 1;
 #endif
 constexpr size_t CONTROLLER_OUTPUT_RUMBLE_PAYLOAD_SIZE = 5;
 
+// Written by the thread receiving the payloads and read by the CPU thread without locking. The
+// pad statuses are packed with PackPadStatus().
 struct PortState
 {
-  GCPadStatus origin = {};
-  GCPadStatus status = {};
+  std::atomic<u64> origin{0};
+  std::atomic<u64> status{0};
 
-  ControllerType controller_type = ControllerType::None;
-  bool is_new_connection = false;
+  std::atomic<ControllerType> controller_type{ControllerType::None};
+  std::atomic<bool> is_new_connection{false};
 };
 
-// Only access with s_mutex held!
 static std::array<PortState, SerialInterface::MAX_SI_CHANNELS> s_port_states;
 
+// Time between a payload arriving from the adapter and it being read by Input(). The statistics
+// are only accessed by Input(), which is called from the CPU thread.
+struct InputLatencyStats
+{
+  std::array<u64, SerialInterface::MAX_SI_CHANNELS> last_read_sequence{};
+  u64 read_payloads = 0;
+  std::chrono::steady_clock::duration total_age{};
+  std::chrono::steady_clock::duration max_age{};
+  std::chrono::steady_clock::time_point last_report;
+};
+
+static std::atomic<u64> s_payload_sequence{0};
+static std::atomic<std::chrono::steady_clock::rep> s_payload_time{0};
+static InputLatencyStats s_latency_stats;
+
 static std::array<u8, CONTROLLER_OUTPUT_RUMBLE_PAYLOAD_SIZE> s_controller_write_payload;
 static std::atomic<int> s_controller_write_payload_size{0};
 
@@ -127,7 +147,6 @@ static std::thread s_write_adapter_thread;
 static Common::Flag s_write_adapter_thread_running;
 static Common::Event s_write_happened;
 
-static std::mutex s_read_mutex;
 #if GCADAPTER_USE_LIBUSB_IMPLEMENTATION
 static std::mutex s_init_mutex;
 #elif GCADAPTER_USE_ANDROID_IMPLEMENTATION
@@ -155,6 +174,21 @@ static std::unique_ptr<LibusbUtils::Context> s_libusb_context;
 
 static u8 s_endpoint_in = 0;
 static u8 s_endpoint_out = 0;
+
+// The adapter can be overclocked to report at 1 kHz. Keeping several reads submitted means the
+// next one is already queued on the host controller when a payload arrives.
+constexpr size_t READ_TRANSFER_COUNT = 3;
+
+struct ReadTransfer
+{
+  libusb_transfer* transfer = nullptr;
+  std::array<u8, CONTROLLER_INPUT_PAYLOAD_EXPECTED_SIZE> buffer{};
+};
+
+static std::array<ReadTransfer, READ_TRANSFER_COUNT> s_read_transfers;
+static std::atomic<int> s_read_transfers_in_flight{0};
+static Common::Flag s_read_reset_requested;
+static Common::Event s_read_transfers_stopped;
 #endif
 
 static u64 s_last_init = 0;
@@ -200,35 +234,11 @@ static void ReadThreadFunc()
   // Reset rumble once on initial reading
   ResetRumble();
 
-  while (s_read_adapter_thread_running.IsSet())
-  {
 #if GCADAPTER_USE_LIBUSB_IMPLEMENTATION
-    std::array<u8, CONTROLLER_INPUT_PAYLOAD_EXPECTED_SIZE> input_buffer;
-
-    int payload_size = 0;
-    int error = libusb_interrupt_transfer(s_handle, s_endpoint_in, input_buffer.data(),
-                                          int(input_buffer.size()), &payload_size, USB_TIMEOUT_MS);
-    if (error != LIBUSB_SUCCESS)
-    {
-      ERROR_LOG_FMT(CONTROLLERINTERFACE, "Read: libusb_interrupt_transfer failed: {}",
-                    LibusbUtils::ErrorWrap(error));
-    }
-    if (error == LIBUSB_ERROR_IO)
-    {
-      // s_read_adapter_thread_running is cleared by the joiner, not the stopper.
-
-      // Reset the device, which may trigger a replug.
-      error = libusb_reset_device(s_handle);
-      ERROR_LOG_FMT(CONTROLLERINTERFACE, "Read: libusb_reset_device: {}",
-                    LibusbUtils::ErrorWrap(error));
-
-      // If error is nonzero, try fixing it next loop iteration. We can't easily return
-      // and cleanup program state without getting another thread to call Reset().
-    }
-
-    ProcessInputPayload(input_buffer.data(), payload_size);
-
+  RunReadTransfers();
 #elif GCADAPTER_USE_ANDROID_IMPLEMENTATION
+  while (s_read_adapter_thread_running.IsSet())
+  {
     const int payload_size = env->CallStaticIntMethod(s_adapter_class, input_func);
     jbyte* const java_data = env->GetByteArrayElements(*java_controller_payload, nullptr);
 
@@ -241,10 +251,10 @@ static void ReadThreadFunc()
       first_read = false;
       s_fd = env->CallStaticIntMethod(s_adapter_class, getfd_func);
     }
-#endif
 
     Common::YieldCPU();
   }
+#endif
 
   // Terminate the write thread on leaving
   if (s_write_adapter_thread_running.TestAndClear())
@@ -312,6 +322,112 @@ static void WriteThreadFunc()
 }
 
 #if GCADAPTER_USE_LIBUSB_IMPLEMENTATION
+static void ReadTransferCallback(libusb_transfer* transfer)
+{
+  switch (transfer->status)
+  {
+  case LIBUSB_TRANSFER_COMPLETED:
+    ProcessInputPayload(transfer->buffer, transfer->actual_length);
+    break;
+  case LIBUSB_TRANSFER_TIMED_OUT:
+  case LIBUSB_TRANSFER_CANCELLED:
+    break;
+  default:
+    ERROR_LOG_FMT(CONTROLLERINTERFACE, "Read: transfer failed with status {}",
+                  static_cast<int>(transfer->status));
+    // The read thread resets the device once all the transfers are back.
+    if (transfer->status == LIBUSB_TRANSFER_ERROR)
+      s_read_reset_requested.Set();
+    break;
+  }
+
+  // s_read_adapter_thread_running is cleared by the joiner, not the stopper.
+  if (s_read_adapter_thread_running.IsSet() && transfer->status != LIBUSB_TRANSFER_NO_DEVICE &&
+      !s_read_reset_requested.IsSet())
+  {
+    const int error = libusb_submit_transfer(transfer);
+    if (error == LIBUSB_SUCCESS)
+      return;
+
+    ERROR_LOG_FMT(CONTROLLERINTERFACE, "Read: libusb_submit_transfer failed: {}",
+                  LibusbUtils::ErrorWrap(error));
+  }
+
+  // The transfer must not be touched after this, the read thread may free it.
+  if (s_read_transfers_in_flight.fetch_sub(1) == 1)
+    s_read_transfers_stopped.Set();
+}
+
+static void SubmitReadTransfers()
+{
+  for (ReadTransfer& read_transfer : s_read_transfers)
+  {
+    libusb_fill_interrupt_transfer(read_transfer.transfer, s_handle, s_endpoint_in,
+                                   read_transfer.buffer.data(), int(read_transfer.buffer.size()),
+                                   ReadTransferCallback, nullptr, USB_TIMEOUT_MS);
+
+    ++s_read_transfers_in_flight;
+    const int error = libusb_submit_transfer(read_transfer.transfer);
+    if (error != LIBUSB_SUCCESS)
+    {
+      --s_read_transfers_in_flight;
+      ERROR_LOG_FMT(CONTROLLERINTERFACE, "Read: libusb_submit_transfer failed: {}",
+                    LibusbUtils::ErrorWrap(error));
+    }
+  }
+}
+
+// Reads are handled by the libusb event thread, each completed transfer is processed and
+// resubmitted right away. This thread only restarts them after errors and cancels them on exit.
+static void RunReadTransfers()
+{
+  for (ReadTransfer& read_transfer : s_read_transfers)
+    read_transfer.transfer = libusb_alloc_transfer(0);
+
+  s_read_reset_requested.Clear();
+  s_read_transfers_stopped.Reset();
+
+  SubmitReadTransfers();
+
+  while (s_read_adapter_thread_running.IsSet())
+  {
+    s_read_transfers_stopped.WaitFor(std::chrono::milliseconds(USB_TIMEOUT_MS));
+    if (!s_read_adapter_thread_running.IsSet() || s_read_transfers_in_flight.load() != 0)
+      continue;
+
+    // All the transfers stopped because of errors.
+    if (s_read_reset_requested.TestAndClear())
+    {
+      // Reset the device, which may trigger a replug.
+      const int error = libusb_reset_device(s_handle);
+      ERROR_LOG_FMT(CONTROLLERINTERFACE, "Read: libusb_reset_device: {}",
+                    LibusbUtils::ErrorWrap(error));
+
+      // If error is nonzero, try fixing it next time. We can't easily return and cleanup
+      // program state without getting another thread to call Reset().
+    }
+    else
+    {
+      // Don't retry a failing adapter in a busy loop.
+      Common::SleepCurrentThread(USB_TIMEOUT_MS);
+    }
+
+    SubmitReadTransfers();
+  }
+
+  for (ReadTransfer& read_transfer : s_read_transfers)
+    libusb_cancel_transfer(read_transfer.transfer);
+
+  while (s_read_transfers_in_flight.load() != 0)
+    s_read_transfers_stopped.WaitFor(std::chrono::milliseconds(USB_TIMEOUT_MS));
+
+  for (ReadTransfer& read_transfer : s_read_transfers)
+  {
+    libusb_free_transfer(read_transfer.transfer);
+    read_transfer.transfer = nullptr;
+  }
+}
+
 #if LIBUSB_API_HAS_HOTPLUG
 static int HotplugCallback(libusb_context* ctx, libusb_device* dev, libusb_hotplug_event event,
                            void* user_data)
@@ -493,7 +609,7 @@ static void Setup()
   if (s_status == AdapterStatus::Error)
     s_status = AdapterStatus::NotDetected;
 
-  s_port_states.fill({});
+  ResetPortStates();
   s_controller_rumble.fill(0);
 
   const int ret = s_libusb_context->GetDeviceList([](libusb_device* device) {
@@ -713,7 +829,7 @@ static void Reset()
     s_read_adapter_thread.join();
   // The read thread will close the write thread
 
-  s_port_states.fill({});
+  ResetPortStates();
 
 #if GCADAPTER_USE_LIBUSB_IMPLEMENTATION
   s_status = AdapterStatus::NotDetected;
@@ -739,6 +855,69 @@ static void Reset()
   NOTICE_LOG_FMT(CONTROLLERINTERFACE, "GC Adapter detached");
 }
 
+// Only the values the adapter reports are packed, the other members keep their defaults.
+static u64 PackPadStatus(const GCPadStatus& pad)
+{
+  return u64(pad.button) | u64(pad.stickX) << 16 | u64(pad.stickY) << 24 |
+         u64(pad.substickX) << 32 | u64(pad.substickY) << 40 | u64(pad.triggerLeft) << 48 |
+         u64(pad.triggerRight) << 56;
+}
+
+static GCPadStatus UnpackPadStatus(u64 packed)
+{
+  GCPadStatus pad;
+  pad.button = static_cast<u16>(packed);
+  pad.stickX = static_cast<u8>(packed >> 16);
+  pad.stickY = static_cast<u8>(packed >> 24);
+  pad.substickX = static_cast<u8>(packed >> 32);
+  pad.substickY = static_cast<u8>(packed >> 40);
+  pad.triggerLeft = static_cast<u8>(packed >> 48);
+  pad.triggerRight = static_cast<u8>(packed >> 56);
+  return pad;
+}
+
+static void ResetPortStates()
+{
+  for (auto& pad_state : s_port_states)
+  {
+    pad_state.origin.store(0);
+    pad_state.status.store(0);
+    pad_state.controller_type.store(ControllerType::None);
+    pad_state.is_new_connection.store(false);
+  }
+}
+
+static void RecordInputLatency(int chan)
+{
+  // Only count each payload once per port, the CPU thread usually polls faster than the adapter.
+  const u64 sequence = s_payload_sequence.load();
+  if (sequence == s_latency_stats.last_read_sequence[chan])
+    return;
+  s_latency_stats.last_read_sequence[chan] = sequence;
+
+  const auto now = std::chrono::steady_clock::now();
+  const std::chrono::steady_clock::time_point payload_time{
+      std::chrono::steady_clock::duration(s_payload_time.load())};
+  const auto age = now - payload_time;
+  ++s_latency_stats.read_payloads;
+  s_latency_stats.total_age += age;
+  s_latency_stats.max_age = std::max(s_latency_stats.max_age, age);
+
+  constexpr auto REPORT_INTERVAL = std::chrono::seconds(10);
+  if (now - s_latency_stats.last_report < REPORT_INTERVAL)
+    return;
+
+  using Microseconds = std::chrono::duration<double, std::micro>;
+  INFO_LOG_FMT(CONTROLLERINTERFACE, "Read {} payloads, age avg {:.0f} us, max {:.0f} us",
+               s_latency_stats.read_payloads,
+               Microseconds(s_latency_stats.total_age).count() / s_latency_stats.read_payloads,
+               Microseconds(s_latency_stats.max_age).count());
+  s_latency_stats.read_payloads = 0;
+  s_latency_stats.total_age = {};
+  s_latency_stats.max_age = {};
+  s_latency_stats.last_report = now;
+}
+
 GCPadStatus Input(int chan)
 {
   if (!UseAdapter())
@@ -752,18 +931,15 @@ GCPadStatus Input(int chan)
     return {};
 #endif
 
-  std::lock_guard lk(s_read_mutex);
-
   auto& pad_state = s_port_states[chan];
 
+  RecordInputLatency(chan);
+
   // Return the "origin" state for the first input on a new connection.
-  if (pad_state.is_new_connection)
-  {
-    pad_state.is_new_connection = false;
-    return pad_state.origin;
-  }
+  if (pad_state.is_new_connection.exchange(false))
+    return UnpackPadStatus(pad_state.origin.load());
 
-  return pad_state.status;
+  return UnpackPadStatus(pad_state.status.load());
 }
 
 // Get ControllerType from first byte in input payload.
@@ -795,8 +971,6 @@ void ProcessInputPayload(const u8* data, std::size_t size)
   }
   else
   {
-    std::lock_guard lk(s_read_mutex);
-
     for (int chan = 0; chan != SerialInterface::MAX_SI_CHANNELS; ++chan)
     {
       const u8* const channel_data = &data[1 + (9 * chan)];
@@ -860,26 +1034,28 @@ void ProcessInputPayload(const u8* data, std::size_t size)
                        chan + 1, channel_data[0]);
 
         pad.button |= PAD_GET_ORIGIN;
-        pad_state.origin = pad;
-        pad_state.is_new_connection = true;
+        // The origin must be visible before the new connection flag.
+        pad_state.origin.store(PackPadStatus(pad));
+        pad_state.is_new_connection.store(true);
       }
 
-      pad_state.controller_type = type;
-      pad_state.status = pad;
+      pad_state.controller_type.store(type);
+      pad_state.status.store(PackPadStatus(pad));
     }
+
+    s_payload_time.store(std::chrono::steady_clock::now().time_since_epoch().count());
+    s_payload_sequence.fetch_add(1);
   }
 }
 
 bool DeviceConnected(int chan)
 {
-  std::lock_guard lk(s_read_mutex);
   return s_port_states[chan].controller_type != ControllerType::None;
 }
 
 void ResetDeviceType(int chan)
 {
-  std::lock_guard lk(s_read_mutex);
-  s_port_states[chan].controller_type = ControllerType::None;
+  s_port_states[chan].controller_type.store(ControllerType::None);
 }
 
 bool UseAdapter()
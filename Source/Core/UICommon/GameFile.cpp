@@ -7,6 +7,7 @@
 #include <array>
 #include <cstdio>
 #include <cstring>
+#include <filesystem>
 #include <iterator>
 #include <map>
 #include <memory>
@@ -99,11 +100,26 @@ GameFile::LookupUsingConfigLanguage(const std::map<DiscIO::Language, std::string
   return Lookup(GetConfigLanguage(), strings);
 }
 
+// Lets the game list cache tell whether a file was replaced without having to open it
+static void GetFileSizeAndMTime(const std::string& path, u64* size, s64* mtime)
+{
+  const std::filesystem::path fs_path = StringToPath(path);
+  std::error_code error;
+
+  const std::uintmax_t file_size = std::filesystem::file_size(fs_path, error);
+  *size = error ? 0 : static_cast<u64>(file_size);
+
+  const std::filesystem::file_time_type file_time =
+      std::filesystem::last_write_time(fs_path, error);
+  *mtime = error ? 0 : static_cast<s64>(file_time.time_since_epoch().count());
+}
+
 GameFile::GameFile() = default;
 
 GameFile::GameFile(std::string path) : m_file_path(std::move(path))
 {
   m_file_name = PathToFileName(m_file_path);
+  GetFileSizeAndMTime(m_file_path, &m_file_size_on_disk, &m_file_mtime);
 
   {
     std::unique_ptr<DiscIO::Volume> volume(DiscIO::CreateVolume(m_file_path));
@@ -187,6 +203,14 @@ GameFile::GameFile(std::string path) : m_file_path(std::move(path))
 
 GameFile::~GameFile() = default;
 
+bool GameFile::FileChanged() const
+{
+  u64 size;
+  s64 mtime;
+  GetFileSizeAndMTime(m_file_path, &size, &mtime);
+  return size != m_file_size_on_disk || mtime != m_file_mtime;
+}
+
 bool GameFile::IsValid() const
 {
   if (!m_valid)
@@ -298,6 +322,8 @@ void GameFile::DoState(PointerWrap& p)
   p.Do(m_file_name);
 
   p.Do(m_file_size);
+  p.Do(m_file_size_on_disk);
+  p.Do(m_file_mtime);
   p.Do(m_volume_size);
   p.Do(m_volume_size_type);
   p.Do(m_is_datel_disc);
@@ -57,6 +57,8 @@ public:
   ~GameFile();
 
   bool IsValid() const;
+  // Whether the size or modification time of the file differs from when this object was created
+  bool FileChanged() const;
   const std::string& GetFilePath() const { return m_file_path; }
   const std::string& GetFileName() const { return m_file_name; }
   const std::string& GetName(const Core::TitleDatabase& title_database) const;
@@ -146,6 +148,8 @@ private:
   std::string m_file_name;
 
   u64 m_file_size{};
+  u64 m_file_size_on_disk{};
+  s64 m_file_mtime{};
   u64 m_volume_size{};
   DiscIO::DataSizeType m_volume_size_type{};
   bool m_is_datel_disc{};
@@ -4,12 +4,15 @@
 #include "UICommon/GameFileCache.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cstddef>
+#include <cstring>
 #include <functional>
 #include <list>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <thread>
 #include <unordered_set>
 #include <utility>
 #include <vector>
@@ -26,7 +29,31 @@
 
 namespace UICommon
 {
-static constexpr u32 CACHE_REVISION = 25;  // Last changed in PR 12702
+static constexpr u32 CACHE_REVISION = 26;  // Last changed when adding the file modification time
+
+// How many games are parsed in parallel before the callers of the update functions are notified
+static constexpr size_t PARSE_BATCH_SIZE = 64;
+
+// Calls function for every index in [0, count) using a few threads.
+template <typename Function>
+static void ParallelFor(size_t count, const std::atomic_bool& processing_halted,
+                        const Function& function)
+{
+  std::atomic<size_t> next_index = 0;
+  const auto work = [&] {
+    for (size_t i = next_index++; i < count && !processing_halted; i = next_index++)
+      function(i);
+  };
+
+  const size_t thread_count =
+      std::min<size_t>(count, std::max(1U, std::thread::hardware_concurrency()));
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < thread_count; ++i)
+    threads.emplace_back(work);
+  work();
+  for (std::thread& thread : threads)
+    thread.join();
+}
 
 std::vector<std::string> FindAllGamePaths(const std::vector<std::string>& directories_to_scan,
                                           bool recursive_scan)
@@ -60,6 +87,7 @@ void GameFileCache::Clear(DeleteOnDisk delete_on_disk)
     File::Delete(m_path);
 
   m_cached_files.clear();
+  m_cache_file_outdated = true;
 }
 
 std::shared_ptr<const GameFile> GameFileCache::AddOrGet(const std::string& path,
@@ -78,7 +106,11 @@ std::shared_ptr<const GameFile> GameFileCache::AddOrGet(const std::string& path,
   }
   std::shared_ptr<GameFile>& result = found ? *it : m_cached_files.back();
   if (UpdateAdditionalMetadata(&result) || !found)
+  {
     *cache_changed = true;
+    if (found && static_cast<size_t>(it - m_cached_files.begin()) < m_saved_files)
+      m_cache_file_outdated = true;
+  }
 
   return result;
 }
@@ -103,6 +135,8 @@ bool GameFileCache::Update(std::span<const std::string> all_game_paths,
 
   // Delete paths that aren't in game_paths from m_cached_files,
   // while simultaneously deleting paths that are in m_cached_files from game_paths.
+  // Files that have been changed since they were cached are deleted from m_cached_files
+  // but kept in game_paths, so that they get parsed again.
   // For the sake of speed, we don't care about maintaining the order of m_cached_files.
   {
     auto it = m_cached_files.begin();
@@ -112,8 +146,10 @@ bool GameFileCache::Update(std::span<const std::string> all_game_paths,
       if (processing_halted)
         break;
 
-      if (game_paths.erase((*it)->GetFilePath()))
+      const bool in_game_paths = game_paths.contains((*it)->GetFilePath());
+      if (in_game_paths && !(*it)->FileChanged())
       {
+        game_paths.erase((*it)->GetFilePath());
         ++it;
       }
       else
@@ -122,6 +158,7 @@ bool GameFileCache::Update(std::span<const std::string> all_game_paths,
           game_removed_from_cache((*it)->GetFilePath());
 
         cache_changed = true;
+        m_cache_file_outdated = true;
         --end;
         *it = std::move(*end);
       }
@@ -131,20 +168,31 @@ bool GameFileCache::Update(std::span<const std::string> all_game_paths,
 
   // Now that the previous loop has run, game_paths only contains paths that
   // aren't in m_cached_files, so we simply add all of them to m_cached_files.
-  for (const std::string& path : game_paths)
+  // They are parsed in parallel, a batch at a time so that the callers are notified as we go.
+  const std::vector<std::string> new_paths(game_paths.begin(), game_paths.end());
+  std::vector<std::shared_ptr<GameFile>> new_files(PARSE_BATCH_SIZE);
+  for (size_t batch_start = 0; batch_start < new_paths.size(); batch_start += PARSE_BATCH_SIZE)
   {
-    if (processing_halted)
-      break;
+    const size_t batch_size = std::min(PARSE_BATCH_SIZE, new_paths.size() - batch_start);
+    ParallelFor(batch_size, processing_halted, [&](size_t i) {
+      new_files[i] = std::make_shared<GameFile>(new_paths[batch_start + i]);
+    });
 
-    auto file = std::make_shared<GameFile>(path);
-    if (file->IsValid())
+    for (size_t i = 0; i < batch_size; ++i)
     {
-      if (game_added_to_cache)
-        game_added_to_cache(file);
+      std::shared_ptr<GameFile> file = std::move(new_files[i]);
+      if (file && file->IsValid())
+      {
+        if (game_added_to_cache)
+          game_added_to_cache(file);
 
-      cache_changed = true;
-      m_cached_files.push_back(std::move(file));
+        cache_changed = true;
+        m_cached_files.push_back(std::move(file));
+      }
     }
+
+    if (processing_halted)
+      break;
   }
 
   return cache_changed;
@@ -155,15 +203,30 @@ bool GameFileCache::UpdateAdditionalMetadata(const GameUpdatedFn& game_updated,
 {
   bool cache_changed = false;
 
-  for (std::shared_ptr<GameFile>& file : m_cached_files)
+  std::vector<char> updated(PARSE_BATCH_SIZE);
+  for (size_t batch_start = 0; batch_start < m_cached_files.size();
+       batch_start += PARSE_BATCH_SIZE)
   {
+    const size_t batch_size = std::min(PARSE_BATCH_SIZE, m_cached_files.size() - batch_start);
+    std::fill(updated.begin(), updated.end(), false);
+    ParallelFor(batch_size, processing_halted, [&](size_t i) {
+      updated[i] = UpdateAdditionalMetadata(&m_cached_files[batch_start + i]);
+    });
+
+    for (size_t i = 0; i < batch_size; ++i)
+    {
+      if (!updated[i])
+        continue;
+
+      cache_changed = true;
+      if (batch_start + i < m_saved_files)
+        m_cache_file_outdated = true;
+      if (game_updated)
+        game_updated(m_cached_files[batch_start + i]);
+    }
+
     if (processing_halted)
       break;
-
-    const bool updated = UpdateAdditionalMetadata(&file);
-    cache_changed |= updated;
-    if (game_updated && updated)
-      game_updated(file);
   }
 
   return cache_changed;
@@ -206,81 +269,120 @@ bool GameFileCache::UpdateAdditionalMetadata(std::shared_ptr<GameFile>* game_fil
   return true;
 }
 
-bool GameFileCache::Load()
-{
-  return SyncCacheFile(false);
-}
+// The cache file consists of the cache revision followed by one record per game. Each record is
+// the size of its data followed by the data of GameFile::DoState. This lets Save append the games
+// that were added since the last save, and lets Load parse the records in parallel.
 
-bool GameFileCache::Save()
+bool GameFileCache::Load()
 {
-  return SyncCacheFile(true);
-}
+  m_cached_files.clear();
+  m_saved_files = 0;
+  m_cache_file_outdated = true;
 
-bool GameFileCache::SyncCacheFile(bool save)
-{
-  const char* open_mode = save ? "wb" : "rb";
-  File::IOFile f(m_path, open_mode);
+  File::IOFile f(m_path, "rb");
   if (!f)
     return false;
-  bool success = false;
-  if (save)
-  {
-    // Measure the size of the buffer.
-    u8* ptr = nullptr;
-    PointerWrap p_measure(&ptr, 0, PointerWrap::Mode::Measure);
-    DoState(&p_measure);
-    const size_t buffer_size = reinterpret_cast<size_t>(ptr);
 
-    // Then actually do the write.
-    std::vector<u8> buffer(buffer_size);
-    ptr = buffer.data();
-    PointerWrap p(&ptr, buffer_size, PointerWrap::Mode::Write);
-    DoState(&p, buffer_size);
-    if (f.WriteBytes(buffer.data(), buffer.size()))
-      success = true;
+  std::vector<u8> buffer(f.GetSize());
+  u32 revision = 0;
+  bool success = buffer.size() >= sizeof(revision) && f.ReadBytes(buffer.data(), buffer.size());
+  if (success)
+  {
+    std::memcpy(&revision, buffer.data(), sizeof(revision));
+    success = revision == CACHE_REVISION;
   }
-  else
+
+  // Find the records, then parse them on several threads
+  std::vector<std::pair<size_t, u32>> records;
+  for (size_t offset = sizeof(revision); success && offset != buffer.size();)
   {
-    std::vector<u8> buffer(f.GetSize());
-    if (!buffer.empty() && f.ReadBytes(buffer.data(), buffer.size()))
+    u32 record_size;
+    if (buffer.size() - offset < sizeof(record_size))
     {
-      u8* ptr = buffer.data();
-      PointerWrap p(&ptr, buffer.size(), PointerWrap::Mode::Read);
-      DoState(&p, buffer.size());
-      if (p.IsReadMode())
-        success = true;
+      success = false;
+      break;
     }
+    std::memcpy(&record_size, buffer.data() + offset, sizeof(record_size));
+    offset += sizeof(record_size);
+
+    if (buffer.size() - offset < record_size)
+    {
+      success = false;
+      break;
+    }
+    records.emplace_back(offset, record_size);
+    offset += record_size;
   }
-  if (!success)
+
+  std::vector<std::shared_ptr<GameFile>> files(success ? records.size() : 0);
+  std::atomic<bool> records_valid = true;
+  ParallelFor(files.size(), false, [&](size_t i) {
+    u8* ptr = buffer.data() + records[i].first;
+    PointerWrap p(&ptr, records[i].second, PointerWrap::Mode::Read);
+    files[i] = std::make_shared<GameFile>();
+    files[i]->DoState(p);
+    if (!p.IsReadMode() || ptr != buffer.data() + records[i].first + records[i].second)
+      records_valid = false;
+  });
+
+  if (!success || !records_valid)
   {
-    // If some file operation failed, try to delete the probably-corrupted cache
+    // The cache is probably corrupted
     f.Close();
     File::Delete(m_path);
+    return false;
   }
-  return success;
+
+  m_cached_files = std::move(files);
+  m_saved_files = m_cached_files.size();
+  m_cache_file_outdated = false;
+  return true;
 }
 
-void GameFileCache::DoState(PointerWrap* p, u64 size)
+bool GameFileCache::Save()
 {
-  struct
+  // If games have only been added since the cache file was last synced, they are appended to it
+  const bool append = !m_cache_file_outdated && File::Exists(m_path);
+  const size_t first_file = append ? m_saved_files : 0;
+
+  std::vector<u8> buffer;
+  if (!append)
+  {
+    const u32 revision = CACHE_REVISION;
+    buffer.resize(sizeof(revision));
+    std::memcpy(buffer.data(), &revision, sizeof(revision));
+  }
+
+  for (size_t i = first_file; i < m_cached_files.size(); ++i)
   {
-    u32 revision;
-    u64 expected_size;
-  } header = {CACHE_REVISION, size};
-  p->Do(header);
-  if (p->IsReadMode())
+    // Measure the size of the record.
+    u8* ptr = nullptr;
+    PointerWrap p_measure(&ptr, 0, PointerWrap::Mode::Measure);
+    m_cached_files[i]->DoState(p_measure);
+    const u32 record_size = static_cast<u32>(reinterpret_cast<size_t>(ptr));
+
+    // Then actually do the write.
+    const size_t record_offset = buffer.size();
+    buffer.resize(record_offset + sizeof(record_size) + record_size);
+    std::memcpy(buffer.data() + record_offset, &record_size, sizeof(record_size));
+    ptr = buffer.data() + record_offset + sizeof(record_size);
+    PointerWrap p(&ptr, record_size, PointerWrap::Mode::Write);
+    m_cached_files[i]->DoState(p);
+  }
+
+  File::IOFile f(m_path, append ? "ab" : "wb");
+  if (!f || !f.WriteBytes(buffer.data(), buffer.size()))
   {
-    if (header.revision != CACHE_REVISION || header.expected_size != size)
-    {
-      p->SetMeasureMode();
-      return;
-    }
+    // If some file operation failed, try to delete the probably-corrupted cache
+    f.Close();
+    File::Delete(m_path);
+    m_cache_file_outdated = true;
+    return false;
   }
-  p->DoEachElement(m_cached_files, [](PointerWrap& state, std::shared_ptr<GameFile>& elem) {
-    if (state.IsReadMode())
-      elem = std::make_shared<GameFile>();
-    elem->DoState(state);
-  });
+
+  m_saved_files = m_cached_files.size();
+  m_cache_file_outdated = false;
+  return true;
 }
 
 }  // namespace UICommon
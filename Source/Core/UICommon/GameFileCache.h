@@ -13,8 +13,6 @@
 
 #include "Common/CommonTypes.h"
 
-class PointerWrap;
-
 namespace UICommon
 {
 class GameFile;
@@ -58,13 +56,14 @@ public:
   bool Save();
 
 private:
-  bool UpdateAdditionalMetadata(std::shared_ptr<GameFile>* game_file);
-
-  bool SyncCacheFile(bool save);
-  void DoState(PointerWrap* p, u64 size = 0);
+  static bool UpdateAdditionalMetadata(std::shared_ptr<GameFile>* game_file);
 
   std::string m_path;
   std::vector<std::shared_ptr<GameFile>> m_cached_files;
+
+  // The first m_saved_files entries of m_cached_files are in the cache file, unless it's outdated
+  size_t m_saved_files = 0;
+  bool m_cache_file_outdated = true;
 };
 
 }  // namespace UICommon
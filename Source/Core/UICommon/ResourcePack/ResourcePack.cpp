@@ -4,10 +4,15 @@
 #include "UICommon/ResourcePack/ResourcePack.h"
 
 #include <algorithm>
+#include <filesystem>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_set>
+#include <utility>
 
 #include <mz_compat.h>
-#include <mz_os.h>
 
 #include "Common/CommonPaths.h"
 #include "Common/FileSearch.h"
@@ -23,10 +28,83 @@
 namespace ResourcePack
 {
 constexpr char TEXTURE_PATH[] = HIRES_TEXTURES_DIR DIR_SEP;
+constexpr char TEXTURE_ZIP_PATH_PREFIX[] = "textures/";
+
+namespace
+{
+struct PackFileStamp
+{
+  std::uintmax_t size = 0;
+  std::filesystem::file_time_type time{};
+
+  bool operator==(const PackFileStamp&) const = default;
+};
+
+std::optional<PackFileStamp> GetPackFileStamp(const std::string& path)
+{
+  const std::filesystem::path fs_path = StringToPath(path);
+  std::error_code error;
+  PackFileStamp stamp;
+  stamp.time = std::filesystem::last_write_time(fs_path, error);
+  if (error)
+    return std::nullopt;
+  stamp.size = std::filesystem::file_size(fs_path, error);
+  if (error)
+    return std::nullopt;
+  return stamp;
+}
+
+struct CachedPack
+{
+  PackFileStamp stamp;
+  ResourcePack pack;
+};
+
+// Packs are constructed again whenever the pack list is reloaded or reordered, so what was read
+// from each archive is kept for as long as the archive doesn't change.
+std::mutex s_pack_cache_mutex;
+std::map<std::string, CachedPack> s_pack_cache;
+
+std::unordered_set<std::string> GetTextureSet(const ResourcePack& pack)
+{
+  return {pack.GetTextures().begin(), pack.GetTextures().end()};
+}
+
+std::unordered_set<std::string> GetTextureSet(const std::vector<ResourcePack*>& packs)
+{
+  std::unordered_set<std::string> textures;
+  for (const ResourcePack* pack : packs)
+    textures.insert(pack->GetTextures().begin(), pack->GetTextures().end());
+  return textures;
+}
+}  // namespace
 
 ResourcePack::ResourcePack(const std::string& path) : m_path(path)
 {
-  auto file = unzOpen(path.c_str());
+  const std::optional<PackFileStamp> stamp = GetPackFileStamp(path);
+  if (stamp)
+  {
+    std::lock_guard lk(s_pack_cache_mutex);
+    const auto it = s_pack_cache.find(path);
+    if (it != s_pack_cache.end() && it->second.stamp == *stamp)
+    {
+      *this = it->second.pack;
+      return;
+    }
+  }
+
+  Load();
+
+  if (stamp)
+  {
+    std::lock_guard lk(s_pack_cache_mutex);
+    s_pack_cache.insert_or_assign(path, CachedPack{*stamp, *this});
+  }
+}
+
+void ResourcePack::Load()
+{
+  auto file = unzOpen(m_path.c_str());
   Common::ScopeGuard file_guard{[&] { unzClose(file); }};
 
   if (file == nullptr)
@@ -80,15 +158,17 @@ ResourcePack::ResourcePack(const std::string& path) : m_path(path)
 
   unzGoToFirstFile(file);
 
+  std::string filename;
   do
   {
-    std::string filename(256, '\0');
+    filename.resize(UINT16_MAX + 1, '\0');
 
     unz_file_info64 texture_info{};
-    unzGetCurrentFileInfo64(file, &texture_info, filename.data(), static_cast<u16>(filename.size()),
-                            nullptr, 0, nullptr, 0);
+    unzGetCurrentFileInfo64(file, &texture_info, filename.data(), UINT16_MAX, nullptr, 0, nullptr,
+                            0);
+    TruncateToCString(&filename);
 
-    if (!filename.starts_with("textures/") || texture_info.uncompressed_size == 0)
+    if (!filename.starts_with(TEXTURE_ZIP_PATH_PREFIX) || texture_info.uncompressed_size == 0)
       continue;
 
     // If a texture is compressed and the manifest doesn't state that, abort.
@@ -99,7 +179,7 @@ ResourcePack::ResourcePack(const std::string& path) : m_path(path)
       return;
     }
 
-    m_textures.push_back(filename.substr(9));
+    m_textures.push_back(filename.substr(sizeof(TEXTURE_ZIP_PATH_PREFIX) - 1));
   } while (unzGoToNextFile(file) != UNZ_END_OF_LIST_OF_FILE);
 }
 
@@ -134,6 +214,16 @@ const std::vector<std::string>& ResourcePack::GetTextures() const
 }
 
 bool ResourcePack::Install(const std::string& path)
+{
+  if (!InstallTextures(path, nullptr))
+    return false;
+
+  SetInstalled(*this, true);
+  return true;
+}
+
+bool ResourcePack::InstallTextures(const std::string& path,
+                                   const std::set<std::string>* textures)
 {
   if (!IsValid())
   {
@@ -153,6 +243,10 @@ bool ResourcePack::Install(const std::string& path)
   if (unzGoToFirstFile(file) != MZ_OK)
     return false;
 
+  // Don't overwrite textures that a higher priority pack provides.
+  const std::unordered_set<std::string> provided_by_other_packs =
+      GetTextureSet(GetHigherPriorityPacks(*this));
+
   std::string texture_zip_path;
   do
   {
@@ -165,31 +259,17 @@ bool ResourcePack::Install(const std::string& path)
     }
     TruncateToCString(&texture_zip_path);
 
-    const std::string texture_zip_path_prefix = "textures/";
-    if (!texture_zip_path.starts_with(texture_zip_path_prefix))
+    // Only the entries that were listed as textures when the pack was loaded.
+    if (!texture_zip_path.starts_with(TEXTURE_ZIP_PATH_PREFIX) ||
+        texture_info.uncompressed_size == 0)
+    {
       continue;
-    const std::string texture_name = texture_zip_path.substr(texture_zip_path_prefix.size());
+    }
+    const std::string texture = texture_zip_path.substr(sizeof(TEXTURE_ZIP_PATH_PREFIX) - 1);
 
-    auto texture_it = std::find_if(
-        m_textures.cbegin(), m_textures.cend(), [&texture_name](const std::string& texture) {
-          return mz_path_compare_wc(texture.c_str(), texture_name.c_str(), 1) == MZ_OK;
-        });
-    if (texture_it == m_textures.cend())
+    if (textures && !textures->contains(texture))
       continue;
-    const auto texture = *texture_it;
-
-    // Check if a higher priority pack already provides a given texture, don't overwrite it
-    bool provided_by_other_pack = false;
-    for (const auto& pack : GetHigherPriorityPacks(*this))
-    {
-      if (std::find(pack->GetTextures().begin(), pack->GetTextures().end(), texture) !=
-          pack->GetTextures().end())
-      {
-        provided_by_other_pack = true;
-        break;
-      }
-    }
-    if (provided_by_other_pack)
+    if (provided_by_other_packs.contains(texture))
       continue;
 
     const std::string texture_path = path + TEXTURE_PATH + texture;
@@ -224,7 +304,6 @@ bool ResourcePack::Install(const std::string& path)
     }
   } while (unzGoToNextFile(file) == MZ_OK);
 
-  SetInstalled(*this, true);
   return true;
 }
 
@@ -240,41 +319,34 @@ bool ResourcePack::Uninstall(const std::string& path)
 
   SetInstalled(*this, false);
 
-  for (const auto& texture : m_textures)
+  // Check if a higher priority pack already provides a given texture, don't delete it
+  const std::unordered_set<std::string> provided_by_higher_packs =
+      GetTextureSet(GetHigherPriorityPacks(*this));
+
+  std::vector<std::pair<ResourcePack*, std::unordered_set<std::string>>> installed_lower;
+  for (ResourcePack* pack : lower)
   {
-    bool provided_by_other_pack = false;
+    if (::ResourcePack::IsInstalled(*pack))
+      installed_lower.emplace_back(pack, GetTextureSet(*pack));
+  }
 
-    // Check if a higher priority pack already provides a given texture, don't delete it
-    for (const auto& pack : GetHigherPriorityPacks(*this))
-    {
-      if (::ResourcePack::IsInstalled(*pack) &&
-          std::find(pack->GetTextures().begin(), pack->GetTextures().end(), texture) !=
-              pack->GetTextures().end())
-      {
-        provided_by_other_pack = true;
-        break;
-      }
-    }
+  // Textures that a lower priority pack provides are extracted from it again, once per pack.
+  std::map<ResourcePack*, std::set<std::string>> textures_to_restore;
 
-    if (provided_by_other_pack)
+  for (const auto& texture : m_textures)
+  {
+    if (provided_by_higher_packs.contains(texture))
       continue;
 
-    // Check if a lower priority pack provides a given texture - if so, install it.
-    for (auto& pack : lower)
+    const auto lower_it = std::find_if(installed_lower.begin(), installed_lower.end(),
+                                       [&texture](const auto& entry) {
+                                         return entry.second.contains(texture);
+                                       });
+    if (lower_it != installed_lower.end())
     {
-      if (::ResourcePack::IsInstalled(*pack) &&
-          std::find(pack->GetTextures().rbegin(), pack->GetTextures().rend(), texture) !=
-              pack->GetTextures().rend())
-      {
-        pack->Install(path);
-
-        provided_by_other_pack = true;
-        break;
-      }
-    }
-
-    if (provided_by_other_pack)
+      textures_to_restore[lower_it->first].insert(texture);
       continue;
+    }
 
     const std::string texture_path = path + TEXTURE_PATH + texture;
     if (File::Exists(texture_path) && !File::Delete(texture_path))
@@ -299,6 +371,9 @@ bool ResourcePack::Uninstall(const std::string& path)
     }
   }
 
+  for (const auto& [pack, textures] : textures_to_restore)
+    pack->InstallTextures(path, &textures);
+
   return true;
 }
 
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <memory>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -33,6 +34,11 @@ public:
   bool operator!=(const ResourcePack& pack) const;
 
 private:
+  void Load();
+  // Extracts the textures of this pack that no higher priority pack provides, or only those in
+  // textures if that is given.
+  bool InstallTextures(const std::string& path, const std::set<std::string>* textures);
+
   bool m_valid = true;
 
   std::string m_path;
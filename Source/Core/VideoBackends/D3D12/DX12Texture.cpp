@@ -785,6 +785,15 @@ void DXStagingTexture::Flush()
     g_dx_context->WaitForFence(m_completed_fence);
 }
 
+bool DXStagingTexture::IsCopyComplete() const
+{
+  if (!m_needs_flush)
+    return true;
+
+  return m_completed_fence != g_dx_context->GetCurrentFenceValue() &&
+         g_dx_context->GetCompletedFenceValue() >= m_completed_fence;
+}
+
 std::unique_ptr<DXStagingTexture> DXStagingTexture::Create(StagingTextureType type,
                                                            const TextureConfig& config)
 {
@@ -9,6 +9,13 @@
 
 namespace DX12
 {
+struct TextureDescriptorSet final
+{
+  D3D12_CPU_DESCRIPTOR_HANDLE handles[VideoCommon::MAX_PIXEL_SHADER_SAMPLERS];
+};
+
+bool operator<(const TextureDescriptorSet& lhs, const TextureDescriptorSet& rhs);
+
 class DescriptorAllocator
 {
 public:
@@ -21,6 +28,11 @@ public:
   bool Create(ID3D12Device* device, D3D12_DESCRIPTOR_HEAP_TYPE type, u32 num_descriptors);
 
   bool Allocate(u32 num_handles, DescriptorHandle* out_base_handle);
+
+  // Returns a table containing copies of the specified shadow heap descriptors. Tables are kept
+  // until the allocator is reset, so switching back to a set of textures used earlier in the
+  // command list does not copy the descriptors again.
+  bool GetTextureGroupHandle(const TextureDescriptorSet& tds, D3D12_GPU_DESCRIPTOR_HANDLE* handle);
   void Reset();
 
 protected:
@@ -31,6 +43,9 @@ protected:
 
   D3D12_CPU_DESCRIPTOR_HANDLE m_heap_base_cpu = {};
   D3D12_GPU_DESCRIPTOR_HANDLE m_heap_base_gpu = {};
+
+private:
+  std::map<TextureDescriptorSet, D3D12_GPU_DESCRIPTOR_HANDLE> m_texture_map;
 };
 
 struct SamplerStateSet final
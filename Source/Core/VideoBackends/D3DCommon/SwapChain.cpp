@@ -44,6 +44,9 @@ SwapChain::~SwapChain()
   // Can't destroy swap chain while it's fullscreen.
   if (m_swap_chain && GetFullscreenState(m_swap_chain.Get()))
     m_swap_chain->SetFullscreenState(FALSE, nullptr);
+
+  if (m_frame_latency_waitable)
+    CloseHandle(m_frame_latency_waitable);
 }
 
 bool SwapChain::WantsStereo()
@@ -59,7 +62,10 @@ bool SwapChain::WantsHDR()
 u32 SwapChain::GetSwapChainFlags() const
 {
   // This flag is necessary if we want to use a flip-model swapchain without locking the framerate
-  return m_allow_tearing_supported ? DXGI_SWAP_CHAIN_FLAG_ALLOW_TEARING : 0;
+  u32 flags = m_allow_tearing_supported ? DXGI_SWAP_CHAIN_FLAG_ALLOW_TEARING : 0;
+  if (m_low_latency_supported)
+    flags |= DXGI_SWAP_CHAIN_FLAG_FRAME_LATENCY_WAITABLE_OBJECT;
+  return flags;
 }
 
 bool SwapChain::CreateSwapChain(bool stereo, bool hdr)
@@ -80,6 +86,7 @@ bool SwapChain::CreateSwapChain(bool stereo, bool hdr)
   if (SUCCEEDED(hr))
   {
     m_allow_tearing_supported = IsTearingSupported(dxgi_factory2.Get());
+    m_low_latency_supported = g_ActiveConfig.bLowLatencyPresent;
 
     DXGI_SWAP_CHAIN_DESC1 swap_chain_desc = {};
     swap_chain_desc.Width = m_width;
@@ -133,6 +140,7 @@ bool SwapChain::CreateSwapChain(bool stereo, bool hdr)
     desc.Flags = 0;
 
     m_allow_tearing_supported = false;
+    m_low_latency_supported = false;
     hr = m_dxgi_factory->CreateSwapChain(m_d3d_device.Get(), &desc, &m_swap_chain);
   }
 
@@ -150,6 +158,20 @@ bool SwapChain::CreateSwapChain(bool stereo, bool hdr)
 
   m_stereo = stereo;
 
+  if (m_low_latency_supported)
+  {
+    // Only keep a single frame queued, and wait for it to be displayed before starting the next
+    // one, instead of letting the present queue add up to three frames of latency.
+    Microsoft::WRL::ComPtr<IDXGISwapChain2> swap_chain2;
+    hr = m_swap_chain.As(&swap_chain2);
+    if (SUCCEEDED(hr))
+      hr = swap_chain2->SetMaximumFrameLatency(1);
+    if (SUCCEEDED(hr))
+      m_frame_latency_waitable = swap_chain2->GetFrameLatencyWaitableObject();
+    else
+      WARN_LOG_FMT(VIDEO, "Failed to set up frame latency waitable object: {}", Common::HRWrap(hr));
+  }
+
   if (hdr)
   {
     // Only try to activate HDR here, to avoid failing when creating the swapchain
@@ -199,6 +221,12 @@ void SwapChain::DestroySwapChain()
   if (m_swap_chain && GetFullscreenState(m_swap_chain.Get()))
     m_swap_chain->SetFullscreenState(FALSE, nullptr);
 
+  if (m_frame_latency_waitable)
+  {
+    CloseHandle(m_frame_latency_waitable);
+    m_frame_latency_waitable = nullptr;
+  }
+
   m_swap_chain.Reset();
 }
 
@@ -309,6 +337,11 @@ bool SwapChain::Present()
     return false;
   }
 
+  // Block until the frame we just queued has been picked up, so the next frame's commands are
+  // recorded with the most recent emulated state rather than sitting in the queue.
+  if (m_frame_latency_waitable)
+    WaitForSingleObjectEx(m_frame_latency_waitable, 1000, TRUE);
+
   return true;
 }
 
@@ -71,8 +71,12 @@ protected:
   bool m_stereo = false;
   bool m_hdr = false;
   bool m_allow_tearing_supported = false;
+  bool m_low_latency_supported = false;
   bool m_has_fullscreen = false;
   bool m_fullscreen_request = false;
+
+  // Signalled by DXGI when the present queue has room for another frame.
+  HANDLE m_frame_latency_waitable = nullptr;
 };
 
 }  // namespace D3DCommon
@@ -277,6 +277,18 @@ private:
     u32 perf_query_id;
   } m_state;
 
+  /// Most recent upload of a GX uniform block.
+  /// New encoders rebind it instead of uploading the same constants again, as long as they haven't
+  /// changed and the upload belongs to the current command buffer.
+  struct UniformUpload
+  {
+    MRCOwned<id<MTLBuffer>> buffer;
+    u32 offset = 0;
+    u64 drawno = 0;
+  };
+  UniformUpload m_gx_vs_uniform;
+  UniformUpload m_gx_ps_uniform;
+
   u32 m_perf_query_tracker_counter = 0;
   bool m_manual_buffer_upload = false;
 
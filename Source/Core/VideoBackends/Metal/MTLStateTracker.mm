@@ -553,6 +553,10 @@ void Metal::StateTracker::InvalidateUniforms(bool vertex, bool geometry, bool fr
   m_flags.has_gx_vs_uniform &= !vertex;
   m_flags.has_gx_gs_uniform &= !geometry;
   m_flags.has_gx_ps_uniform &= !fragment;
+  if (vertex)
+    m_gx_vs_uniform.drawno = 0;
+  if (fragment)
+    m_gx_ps_uniform.drawno = 0;
 }
 
 void Metal::StateTracker::SetUtilityUniform(const void* buffer, size_t size)
@@ -818,15 +822,22 @@ void Metal::StateTracker::PrepareRender()
     if (!m_flags.has_gx_vs_uniform)
     {
       m_flags.has_gx_vs_uniform = true;
-      Map map = Allocate(UploadBuffer::Uniform, sizeof(VertexShaderConstants), AlignMask::Uniform);
-      auto& system = Core::System::GetInstance();
-      auto& vertex_shader_manager = system.GetVertexShaderManager();
-      memcpy(map.cpu_buffer, &vertex_shader_manager.constants, sizeof(VertexShaderConstants));
-      SetVertexBufferNow(1, map.gpu_buffer, map.gpu_offset);
+      if (m_gx_vs_uniform.drawno != m_current_draw)
+      {
+        Map map =
+            Allocate(UploadBuffer::Uniform, sizeof(VertexShaderConstants), AlignMask::Uniform);
+        auto& system = Core::System::GetInstance();
+        auto& vertex_shader_manager = system.GetVertexShaderManager();
+        memcpy(map.cpu_buffer, &vertex_shader_manager.constants, sizeof(VertexShaderConstants));
+        m_gx_vs_uniform.buffer = MRCRetain(map.gpu_buffer);
+        m_gx_vs_uniform.offset = static_cast<u32>(map.gpu_offset);
+        m_gx_vs_uniform.drawno = m_current_draw;
+        ADDSTAT(g_stats.this_frame.bytes_uniform_streamed,
+                Align(sizeof(VertexShaderConstants), AlignMask::Uniform));
+      }
+      SetVertexBufferNow(1, m_gx_vs_uniform.buffer, m_gx_vs_uniform.offset);
       if (pipe->UsesFragmentBuffer(1))
-        SetFragmentBufferNow(1, map.gpu_buffer, map.gpu_offset);
-      ADDSTAT(g_stats.this_frame.bytes_uniform_streamed,
-              Align(sizeof(VertexShaderConstants), AlignMask::Uniform));
+        SetFragmentBufferNow(1, m_gx_vs_uniform.buffer, m_gx_vs_uniform.offset);
     }
     if (!m_flags.has_gx_gs_uniform && pipe->UsesVertexBuffer(2))
     {
@@ -841,13 +852,20 @@ void Metal::StateTracker::PrepareRender()
     if (!m_flags.has_gx_ps_uniform)
     {
       m_flags.has_gx_ps_uniform = true;
-      Map map = Allocate(UploadBuffer::Uniform, sizeof(PixelShaderConstants), AlignMask::Uniform);
-      auto& system = Core::System::GetInstance();
-      auto& pixel_shader_manager = system.GetPixelShaderManager();
-      memcpy(map.cpu_buffer, &pixel_shader_manager.constants, sizeof(PixelShaderConstants));
-      SetFragmentBufferNow(0, map.gpu_buffer, map.gpu_offset);
-      ADDSTAT(g_stats.this_frame.bytes_uniform_streamed,
-              Align(sizeof(PixelShaderConstants), AlignMask::Uniform));
+      if (m_gx_ps_uniform.drawno != m_current_draw)
+      {
+        Map map =
+            Allocate(UploadBuffer::Uniform, sizeof(PixelShaderConstants), AlignMask::Uniform);
+        auto& system = Core::System::GetInstance();
+        auto& pixel_shader_manager = system.GetPixelShaderManager();
+        memcpy(map.cpu_buffer, &pixel_shader_manager.constants, sizeof(PixelShaderConstants));
+        m_gx_ps_uniform.buffer = MRCRetain(map.gpu_buffer);
+        m_gx_ps_uniform.offset = static_cast<u32>(map.gpu_offset);
+        m_gx_ps_uniform.drawno = m_current_draw;
+        ADDSTAT(g_stats.this_frame.bytes_uniform_streamed,
+                Align(sizeof(PixelShaderConstants), AlignMask::Uniform));
+      }
+      SetFragmentBufferNow(0, m_gx_ps_uniform.buffer, m_gx_ps_uniform.offset);
     }
   }
   else
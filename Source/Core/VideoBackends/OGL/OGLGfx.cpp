@@ -192,6 +192,12 @@ OGLGfx::OGLGfx(std::unique_ptr<GLContext> main_gl_context, float backbuffer_scal
   glGenFramebuffers(1, &m_shared_read_framebuffer);
   glGenFramebuffers(1, &m_shared_draw_framebuffer);
 
+  if (GLExtensions::Supports("GL_ARB_timer_query"))
+  {
+    m_timestamp_queries.resize(MAX_TIMESTAMP_QUERIES);
+    glGenQueries(MAX_TIMESTAMP_QUERIES, m_timestamp_queries.data());
+  }
+
   if (g_ActiveConfig.backend_info.bSupportsPrimitiveRestart)
     GLUtil::EnablePrimitiveRestart(m_main_gl_context.get());
 
@@ -200,6 +206,11 @@ OGLGfx::OGLGfx(std::unique_ptr<GLContext> main_gl_context, float backbuffer_scal
 
 OGLGfx::~OGLGfx()
 {
+  if (!m_timestamp_queries.empty())
+  {
+    glDeleteQueries(static_cast<GLsizei>(m_timestamp_queries.size()),
+                    m_timestamp_queries.data());
+  }
   glDeleteFramebuffers(1, &m_shared_draw_framebuffer);
   glDeleteFramebuffers(1, &m_shared_read_framebuffer);
 }
@@ -456,6 +467,23 @@ void OGLGfx::WaitForGPUIdle()
   glFinish();
 }
 
+void OGLGfx::WriteTimestampQuery(u32 index)
+{
+  glQueryCounter(m_timestamp_queries[index], GL_TIMESTAMP);
+}
+
+std::optional<u64> OGLGfx::GetTimestampQueryResult(u32 index)
+{
+  GLuint available = GL_FALSE;
+  glGetQueryObjectuiv(m_timestamp_queries[index], GL_QUERY_RESULT_AVAILABLE, &available);
+  if (!available)
+    return std::nullopt;
+
+  GLuint64 timestamp = 0;
+  glGetQueryObjectui64v(m_timestamp_queries[index], GL_QUERY_RESULT, &timestamp);
+  return timestamp;
+}
+
 void OGLGfx::CheckForSurfaceChange()
 {
   if (!g_presenter->SurfaceChangedTestAndClear())
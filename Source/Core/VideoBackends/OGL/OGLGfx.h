@@ -3,6 +3,10 @@
 
 #pragma once
 
+#include <optional>
+#include <vector>
+
+#include "Common/GL/GLExtensions/GLExtensions.h"
 #include "VideoCommon/AbstractGfx.h"
 #include "VideoCommon/Constants.h"
 
@@ -67,6 +71,10 @@ public:
   void WaitForGPUIdle() override;
   void OnConfigChanged(u32 bits) override;
 
+  bool SupportsTimestampQueries() const override { return !m_timestamp_queries.empty(); }
+  void WriteTimestampQuery(u32 index) override;
+  std::optional<u64> GetTimestampQueryResult(u32 index) override;
+
   virtual void SelectLeftBuffer() override;
   virtual void SelectRightBuffer() override;
   virtual void SelectMainBuffer() override;
@@ -111,6 +119,7 @@ private:
   BlendingState m_current_blend_state;
   u32 m_shared_read_framebuffer = 0;
   u32 m_shared_draw_framebuffer = 0;
+  std::vector<GLuint> m_timestamp_queries;
   float m_backbuffer_scale;
 };
 
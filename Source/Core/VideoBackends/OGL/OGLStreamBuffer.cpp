@@ -12,6 +12,7 @@
 
 #include "VideoCommon/DriverDetails.h"
 #include "VideoCommon/OnScreenDisplay.h"
+#include "VideoCommon/Statistics.h"
 
 namespace OGL
 {
@@ -81,6 +82,17 @@ void StreamBuffer::DeleteFences()
     glDeleteSync(m_fences[i]);
   }
 }
+void StreamBuffer::WaitForFence(int slot)
+{
+  // Poll the fence first, so that we can tell when the CPU has caught up with the GPU and has to
+  // wait for a chunk to be released. These stalls are reported in the statistics.
+  if (glClientWaitSync(m_fences[slot], GL_SYNC_FLUSH_COMMANDS_BIT, 0) == GL_TIMEOUT_EXPIRED)
+  {
+    INCSTAT(g_stats.this_frame.num_stream_buffer_stalls);
+    glClientWaitSync(m_fences[slot], 0, GL_TIMEOUT_IGNORED);
+  }
+  glDeleteSync(m_fences[slot]);
+}
 void StreamBuffer::AllocMemory(u32 size)
 {
   // insert waiting slots for used memory
@@ -92,10 +104,7 @@ void StreamBuffer::AllocMemory(u32 size)
 
   // wait for new slots to end of buffer
   for (int i = Slot(m_free_iterator) + 1; i <= Slot(m_iterator + size) && i < SYNC_POINTS; i++)
-  {
-    glClientWaitSync(m_fences[i], GL_SYNC_FLUSH_COMMANDS_BIT, GL_TIMEOUT_IGNORED);
-    glDeleteSync(m_fences[i]);
-  }
+    WaitForFence(i);
 
   // If we allocate a large amount of memory (A), commit a smaller amount, then allocate memory
   // smaller than allocation A, we will have already waited for these fences in A, but not used
@@ -118,10 +127,7 @@ void StreamBuffer::AllocMemory(u32 size)
 
     // wait for space at the start
     for (int i = 0; i <= Slot(m_iterator + size); i++)
-    {
-      glClientWaitSync(m_fences[i], GL_SYNC_FLUSH_COMMANDS_BIT, GL_TIMEOUT_IGNORED);
-      glDeleteSync(m_fences[i]);
-    }
+      WaitForFence(i);
     m_free_iterator = m_iterator + size;
   }
 }
@@ -61,6 +61,7 @@ protected:
 private:
   static constexpr int SYNC_POINTS = 16;
   int Slot(u32 x) const { return x >> m_bit_per_slot; }
+  void WaitForFence(int slot);
   const int m_bit_per_slot;
 
   std::array<GLsync, SYNC_POINTS> m_fences{};
@@ -625,6 +625,16 @@ void OGLStagingTexture::Flush()
   m_needs_flush = false;
 }
 
+bool OGLStagingTexture::IsCopyComplete() const
+{
+  if (m_fence == nullptr)
+    return true;
+
+  // Poll the fence without flushing the command stream.
+  const GLenum status = glClientWaitSync(m_fence, 0, 0);
+  return status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED;
+}
+
 bool OGLStagingTexture::Map()
 {
   if (m_map_pointer)
@@ -39,7 +39,6 @@
 
 namespace OGL
 {
-u32 ProgramShaderCache::s_ubo_buffer_size;
 s32 ProgramShaderCache::s_ubo_align = 1;
 GLuint ProgramShaderCache::s_attributeless_VBO = 0;
 GLuint ProgramShaderCache::s_attributeless_VAO = 0;
@@ -226,60 +225,48 @@ u32 ProgramShaderCache::GetUniformBufferAlignment()
   return s_ubo_align;
 }
 
+void ProgramShaderCache::UploadConstantBlock(u32 index, const void* data, u32 data_size)
+{
+  const u32 alloc_size = Common::AlignUp(data_size, s_ubo_align);
+  auto buffer = s_buffer->Map(alloc_size, s_ubo_align);
+  std::memcpy(buffer.first, data, data_size);
+  s_buffer->Unmap(alloc_size);
+  glBindBufferRange(GL_UNIFORM_BUFFER, index, s_buffer->m_buffer, buffer.second, data_size);
+
+  ADDSTAT(g_stats.this_frame.bytes_uniform_streamed, data_size);
+}
+
 void ProgramShaderCache::UploadConstants()
 {
+  // Each block is streamed and bound on its own, so a draw that only changes e.g. pixel shader
+  // constants doesn't re-upload the much larger vertex shader block.
   auto& system = Core::System::GetInstance();
   auto& pixel_shader_manager = system.GetPixelShaderManager();
   auto& vertex_shader_manager = system.GetVertexShaderManager();
   auto& geometry_shader_manager = system.GetGeometryShaderManager();
-  if (pixel_shader_manager.dirty || vertex_shader_manager.dirty || geometry_shader_manager.dirty ||
-      pixel_shader_manager.custom_constants_dirty)
+  if (pixel_shader_manager.dirty)
+  {
+    UploadConstantBlock(1, &pixel_shader_manager.constants, sizeof(PixelShaderConstants));
+    pixel_shader_manager.dirty = false;
+  }
+  if (vertex_shader_manager.dirty)
+  {
+    UploadConstantBlock(2, &vertex_shader_manager.constants, sizeof(VertexShaderConstants));
+    vertex_shader_manager.dirty = false;
+  }
+  if (pixel_shader_manager.custom_constants_dirty)
   {
-    const u32 custom_constants_size = static_cast<u32>(
-        Common::AlignUp(pixel_shader_manager.custom_constants.size(), s_ubo_align));
-    auto buffer = s_buffer->Map(s_ubo_buffer_size + custom_constants_size, s_ubo_align);
-
-    memcpy(buffer.first, &pixel_shader_manager.constants, sizeof(PixelShaderConstants));
-
-    u64 size = Common::AlignUp(sizeof(PixelShaderConstants), s_ubo_align);
-
-    memcpy(buffer.first + size, &vertex_shader_manager.constants, sizeof(VertexShaderConstants));
-    size += Common::AlignUp(sizeof(VertexShaderConstants), s_ubo_align);
-
-    if (!pixel_shader_manager.custom_constants.empty())
-    {
-      memcpy(buffer.first + size, pixel_shader_manager.custom_constants.data(),
-             pixel_shader_manager.custom_constants.size());
-      size += custom_constants_size;
-    }
-
-    memcpy(buffer.first + size, &geometry_shader_manager.constants,
-           sizeof(GeometryShaderConstants));
-
-    s_buffer->Unmap(s_ubo_buffer_size + custom_constants_size);
-
-    glBindBufferRange(GL_UNIFORM_BUFFER, 1, s_buffer->m_buffer, buffer.second,
-                      sizeof(PixelShaderConstants));
-    size = Common::AlignUp(sizeof(PixelShaderConstants), s_ubo_align);
-    glBindBufferRange(GL_UNIFORM_BUFFER, 2, s_buffer->m_buffer, buffer.second + size,
-                      sizeof(VertexShaderConstants));
-    size += Common::AlignUp(sizeof(VertexShaderConstants), s_ubo_align);
-
     if (!pixel_shader_manager.custom_constants.empty())
     {
-      glBindBufferRange(GL_UNIFORM_BUFFER, 3, s_buffer->m_buffer, buffer.second + size,
-                        pixel_shader_manager.custom_constants.size());
-      size += Common::AlignUp(pixel_shader_manager.custom_constants.size(), s_ubo_align);
+      UploadConstantBlock(3, pixel_shader_manager.custom_constants.data(),
+                          static_cast<u32>(pixel_shader_manager.custom_constants.size()));
     }
-    glBindBufferRange(GL_UNIFORM_BUFFER, 4, s_buffer->m_buffer, buffer.second + size,
-                      sizeof(GeometryShaderConstants));
-
-    pixel_shader_manager.dirty = false;
-    vertex_shader_manager.dirty = false;
-    geometry_shader_manager.dirty = false;
     pixel_shader_manager.custom_constants_dirty = false;
-
-    ADDSTAT(g_stats.this_frame.bytes_uniform_streamed, s_ubo_buffer_size + custom_constants_size);
+  }
+  if (geometry_shader_manager.dirty)
+  {
+    UploadConstantBlock(4, &geometry_shader_manager.constants, sizeof(GeometryShaderConstants));
+    geometry_shader_manager.dirty = false;
   }
 }
 
@@ -467,11 +454,6 @@ void ProgramShaderCache::Init()
   // then the UBO will fail.
   glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &s_ubo_align);
 
-  s_ubo_buffer_size =
-      static_cast<u32>(Common::AlignUp(sizeof(PixelShaderConstants), s_ubo_align) +
-                       Common::AlignUp(sizeof(VertexShaderConstants), s_ubo_align) +
-                       Common::AlignUp(sizeof(GeometryShaderConstants), s_ubo_align));
-
   // We multiply by *4*4 because we need to get down to basic machine units.
   // So multiply by four to get how many floats we have from vec4s
   // Then once more to get bytes
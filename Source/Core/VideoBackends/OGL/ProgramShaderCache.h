@@ -110,11 +110,11 @@ private:
                          PipelineProgramKeyHash>;
 
   static void CreateAttributelessVAO();
+  static void UploadConstantBlock(u32 index, const void* data, u32 data_size);
 
   static PipelineProgramMap s_pipeline_programs;
   static std::mutex s_pipeline_program_lock;
 
-  static u32 s_ubo_buffer_size;
   static s32 s_ubo_align;
 
   static GLuint s_attributeless_VBO;
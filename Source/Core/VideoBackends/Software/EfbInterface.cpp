@@ -704,16 +704,15 @@ void ResetPerfQuery()
   perf_values = {};
 }
 
-void IncPerfCounterQuadCount(PerfQueryType type)
+void IncPerfCounterQuadCount(PerfQueryType type, u32 pixel_count)
 {
   // NOTE: hardware doesn't process individual pixels but quads instead.
   // Current software renderer architecture works on pixels though, so
   // we have this "quad" hack here to only increment the registers on
   // every fourth rendered pixel
   static u32 quad[PQ_NUM_MEMBERS];
-  if (++quad[type] != 3)
-    return;
-  quad[type] = 0;
-  ++perf_values[type];
+  const u32 total = quad[type] + pixel_count;
+  quad[type] = total % 3;
+  perf_values[type] += total / 3;
 }
 }  // namespace EfbInterface
@@ -4,13 +4,25 @@
 #include "VideoBackends/Software/Rasterizer.h"
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
 #include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
 #include <vector>
 
 #include "Common/Assert.h"
+#include "Common/CPUDetect.h"
 #include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
+#include "Common/Thread.h"
+
+#include "Core/Config/GraphicsSettings.h"
 
 #include "VideoBackends/Software/EfbInterface.h"
+#include "VideoBackends/Software/SWBoundingBox.h"
 #include "VideoBackends/Software/NativeVertexFormat.h"
 #include "VideoBackends/Software/Tev.h"
 #include "VideoCommon/BPFunctions.h"
@@ -25,6 +37,15 @@ namespace Rasterizer
 {
 static constexpr int BLOCK_SIZE = 2;
 
+// Triangles are binned into tiles of the EFB which are rasterized in parallel. Tile edges are
+// aligned to BLOCK_SIZE so that every 2x2 block, and with it the LOD calculation, stays within a
+// single tile.
+static constexpr s32 TILE_WIDTH = 64;
+static constexpr s32 TILE_HEIGHT = 32;
+static constexpr s32 NUM_TILES_X = (EFB_WIDTH + TILE_WIDTH - 1) / TILE_WIDTH;
+static constexpr s32 NUM_TILES_Y = (EFB_HEIGHT + TILE_HEIGHT - 1) / TILE_HEIGHT;
+static_assert(TILE_WIDTH % BLOCK_SIZE == 0 && TILE_HEIGHT % BLOCK_SIZE == 0);
+
 struct SlopeContext
 {
   SlopeContext(const OutputVertexData* v0, const OutputVertexData* v1, const OutputVertexData* v2,
@@ -96,21 +117,120 @@ struct Slope
   }
 };
 
-static Slope ZSlope;
-static Slope WSlope;
-static Slope ColorSlopes[2][4];
-static Slope TexSlopes[8][3];
+// Everything needed to rasterize one triangle against one scissor rectangle. It is captured when
+// the triangle is submitted, as the triangle may be drawn later on a worker thread.
+struct TriangleSetup
+{
+  Slope ZSlope;
+  Slope WSlope;
+  Slope ColorSlopes[2][4];
+  Slope TexSlopes[8][3];
+
+  // Half-edge constants and deltas in 28.4 fixed point
+  s32 C1, C2, C3;
+  s32 DX12, DX23, DX31;
+  s32 DY12, DY23, DY31;
+
+  // Bounding rectangle, already clipped to the scissor
+  s32 minx, maxx, miny, maxy;
+};
 
-static Tev tev;
-static RasterBlock rasterBlock;
+// Per-thread rasterization state
+struct RasterContext
+{
+  Tev tev;
+  RasterBlock rasterBlock;
+  u32 rasterizedPixels = 0;
+};
+
+static Slope ZSlope;
 
 static std::vector<BPFunctions::ScissorRect> scissors;
 
+// contexts[0] is used by the GPU thread, the others by the worker threads.
+static std::vector<std::unique_ptr<RasterContext>> contexts;
+
+// Triangles submitted since the last Flush(), and the indices of the ones touching each tile.
+static std::vector<TriangleSetup> triangles;
+static std::array<std::vector<u32>, NUM_TILES_X * NUM_TILES_Y> tileBins;
+static u32 numBinnedTiles = 0;
+
+static std::vector<std::thread> workerThreads;
+static std::mutex workerMutex;
+static std::condition_variable workerWake;
+static std::condition_variable workerDone;
+static u64 workerGeneration = 0;
+static u32 workersBusy = 0;
+static bool workersExit = false;
+static std::atomic<u32> nextTile = 0;
+
+static void DrawTile(RasterContext& ctx, u32 tile);
+
+static void WorkerThread(RasterContext& ctx, u64 generation)
+{
+  Common::SetCurrentThreadName("SWRasterizer Worker");
+
+  while (true)
+  {
+    {
+      std::unique_lock lk(workerMutex);
+      workerWake.wait(lk, [&] { return workersExit || workerGeneration != generation; });
+      if (workersExit)
+        return;
+      generation = workerGeneration;
+    }
+
+    for (u32 tile; (tile = nextTile.fetch_add(1, std::memory_order_relaxed)) < tileBins.size();)
+      DrawTile(ctx, tile);
+
+    std::lock_guard lk(workerMutex);
+    if (--workersBusy == 0)
+      workerDone.notify_one();
+  }
+}
+
+static u32 GetNumWorkerThreads()
+{
+  const int threads = Config::Get(Config::GFX_SW_RASTERIZER_THREADS);
+  if (threads >= 0)
+    return static_cast<u32>(threads);
+
+  // Automatic number. The CPU and GPU threads already occupy two cores.
+  return static_cast<u32>(std::clamp(cpu_info.num_cores - 2, 0, 7));
+}
+
 void Init()
 {
   // The other slopes are set each for each primitive drawn, but zfreeze means that the z slope
   // needs to be set to an (untested) default value.
   ZSlope = Slope();
+
+  const u32 num_workers = GetNumWorkerThreads();
+  contexts.clear();
+  for (u32 i = 0; i <= num_workers; i++)
+    contexts.push_back(std::make_unique<RasterContext>());
+
+  workersExit = false;
+  for (u32 i = 1; i <= num_workers; i++)
+    workerThreads.emplace_back(WorkerThread, std::ref(*contexts[i]), workerGeneration);
+}
+
+void Shutdown()
+{
+  {
+    std::lock_guard lk(workerMutex);
+    workersExit = true;
+  }
+  workerWake.notify_all();
+  for (std::thread& thread : workerThreads)
+    thread.join();
+  workerThreads.clear();
+
+  contexts.clear();
+  triangles.clear();
+  for (std::vector<u32>& bin : tileBins)
+    bin.clear();
+  numBinnedTiles = 0;
 }
 
 void ScissorChanged()
@@ -142,29 +262,32 @@ static inline int iround(float x)
 
 void SetTevKonstColors()
 {
-  tev.SetKonstColors();
+  for (const auto& ctx : contexts)
+    ctx->tev.SetKonstColors();
 }
 
-static void Draw(s32 x, s32 y, s32 xi, s32 yi)
+static void Draw(RasterContext& ctx, const TriangleSetup& tri, s32 x, s32 y, s32 xi, s32 yi)
 {
-  INCSTAT(g_stats.this_frame.rasterized_pixels);
+  Tev& tev = ctx.tev;
+  ++ctx.rasterizedPixels;
 
-  s32 z = (s32)std::clamp<float>(ZSlope.GetValue(x, y), 0.0f, 16777215.0f);
+  s32 z = (s32)std::clamp<float>(tri.ZSlope.GetValue(x, y), 0.0f, 16777215.0f);
 
   if (bpmem.GetEmulatedZ() == EmulatedZ::Early)
   {
     // TODO: Test if perf regs are incremented even if test is disabled
-    EfbInterface::IncPerfCounterQuadCount(PQ_ZCOMP_INPUT_ZCOMPLOC);
+    ++tev.PerfPixelCounts[PQ_ZCOMP_INPUT_ZCOMPLOC];
     if (bpmem.zmode.testenable)
     {
       // early z
       if (!EfbInterface::ZCompare(x, y, z))
         return;
     }
-    EfbInterface::IncPerfCounterQuadCount(PQ_ZCOMP_OUTPUT_ZCOMPLOC);
+    ++tev.PerfPixelCounts[PQ_ZCOMP_OUTPUT_ZCOMPLOC];
   }
 
-  RasterBlockPixel& pixel = rasterBlock.Pixel[xi][yi];
+  const RasterBlock& rasterBlock = ctx.rasterBlock;
+  const RasterBlockPixel& pixel = rasterBlock.Pixel[xi][yi];
 
   tev.Position[0] = x;
   tev.Position[1] = y;
@@ -175,7 +298,7 @@ static void Draw(s32 x, s32 y, s32 xi, s32 yi)
   {
     for (int comp = 0; comp < 4; comp++)
     {
-      u16 color = (u16)ColorSlopes[i][comp].GetValue(x, y);
+      u16 color = (u16)tri.ColorSlopes[i][comp].GetValue(x, y);
 
       // clamp color value to 0
       u16 mask = ~(color >> 8);
@@ -207,7 +330,8 @@ static void Draw(s32 x, s32 y, s32 xi, s32 yi)
   tev.Draw();
 }
 
-static inline void CalculateLOD(s32* lodp, bool* linear, u32 texmap, u32 texcoord)
+static inline void CalculateLOD(const RasterBlock& rasterBlock, s32* lodp, bool* linear,
+                                u32 texmap, u32 texcoord)
 {
   auto texUnit = bpmem.tex.GetUnit(texmap);
 
@@ -218,9 +342,9 @@ static inline void CalculateLOD(s32* lodp, bool* linear, u32 texmap, u32 texcoor
 
   float sDelta, tDelta;
 
-  float* uv00 = rasterBlock.Pixel[0][0].Uv[texcoord];
-  float* uv10 = rasterBlock.Pixel[1][0].Uv[texcoord];
-  float* uv01 = rasterBlock.Pixel[0][1].Uv[texcoord];
+  const float* uv00 = rasterBlock.Pixel[0][0].Uv[texcoord];
+  const float* uv10 = rasterBlock.Pixel[1][0].Uv[texcoord];
+  const float* uv01 = rasterBlock.Pixel[0][1].Uv[texcoord];
 
   float dudx = fabsf(uv00[0] - uv10[0]);
   float dvdx = fabsf(uv00[1] - uv10[1]);
@@ -258,7 +382,7 @@ static inline void CalculateLOD(s32* lodp, bool* linear, u32 texmap, u32 texcoor
   *lodp = lod;
 }
 
-static void BuildBlock(s32 blockX, s32 blockY)
+static void BuildBlock(RasterBlock& rasterBlock, const TriangleSetup& tri, s32 blockX, s32 blockY)
 {
   for (s32 yi = 0; yi < BLOCK_SIZE; yi++)
   {
@@ -269,19 +393,19 @@ static void BuildBlock(s32 blockX, s32 blockY)
       s32 x = xi + blockX;
       s32 y = yi + blockY;
 
-      float invW = 1.0f / WSlope.GetValue(x, y);
+      float invW = 1.0f / tri.WSlope.GetValue(x, y);
       pixel.InvW = invW;
 
       // tex coords
       for (unsigned int i = 0; i < bpmem.genMode.numtexgens; i++)
       {
         float projection = invW;
-        float q = TexSlopes[i][2].GetValue(x, y) * invW;
+        float q = tri.TexSlopes[i][2].GetValue(x, y) * invW;
         if (q != 0.0f)
           projection = invW / q;
 
-        pixel.Uv[i][0] = TexSlopes[i][0].GetValue(x, y) * projection;
-        pixel.Uv[i][1] = TexSlopes[i][1].GetValue(x, y) * projection;
+        pixel.Uv[i][0] = tri.TexSlopes[i][0].GetValue(x, y) * projection;
+        pixel.Uv[i][1] = tri.TexSlopes[i][1].GetValue(x, y) * projection;
       }
     }
   }
@@ -291,7 +415,8 @@ static void BuildBlock(s32 blockX, s32 blockY)
     u32 texmap = bpmem.tevindref.getTexMap(i);
     u32 texcoord = bpmem.tevindref.getTexCoord(i);
 
-    CalculateLOD(&rasterBlock.IndirectLod[i], &rasterBlock.IndirectLinear[i], texmap, texcoord);
+    CalculateLOD(rasterBlock, &rasterBlock.IndirectLod[i], &rasterBlock.IndirectLinear[i], texmap,
+                 texcoord);
   }
 
   for (unsigned int i = 0; i <= bpmem.genMode.numtevstages; i++)
@@ -303,7 +428,8 @@ static void BuildBlock(s32 blockX, s32 blockY)
       u32 texmap = order.getTexMap(stageOdd);
       u32 texcoord = order.getTexCoord(stageOdd);
 
-      CalculateLOD(&rasterBlock.TextureLod[i], &rasterBlock.TextureLinear[i], texmap, texcoord);
+      CalculateLOD(rasterBlock, &rasterBlock.TextureLod[i], &rasterBlock.TextureLinear[i], texmap,
+                   texcoord);
     }
   }
 }
@@ -320,34 +446,27 @@ void UpdateZSlope(const OutputVertexData* v0, const OutputVertexData* v1,
   }
 }
 
-static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertexData* v1,
-                                  const OutputVertexData* v2,
-                                  const BPFunctions::ScissorRect& scissor)
+// Draws the part of the triangle inside the given rectangle, which must be aligned to BLOCK_SIZE.
+static void DrawTriangle(RasterContext& ctx, const TriangleSetup& tri, s32 left, s32 top,
+                         s32 right, s32 bottom)
 {
-  // The zslope should be updated now, even if the triangle is rejected by the scissor test, as
-  // zfreeze depends on it
-  UpdateZSlope(v0, v1, v2, scissor.x_off, scissor.y_off);
-
-  // adapted from http://devmaster.net/posts/6145/advanced-rasterization
-
-  // 28.4 fixed-pou32 coordinates. rounded to nearest and adjusted to match hardware output
-  // could also take floor and adjust -8
-  const s32 Y1 = iround(16.0f * (v0->screenPosition.y - scissor.y_off)) - 9;
-  const s32 Y2 = iround(16.0f * (v1->screenPosition.y - scissor.y_off)) - 9;
-  const s32 Y3 = iround(16.0f * (v2->screenPosition.y - scissor.y_off)) - 9;
-
-  const s32 X1 = iround(16.0f * (v0->screenPosition.x - scissor.x_off)) - 9;
-  const s32 X2 = iround(16.0f * (v1->screenPosition.x - scissor.x_off)) - 9;
-  const s32 X3 = iround(16.0f * (v2->screenPosition.x - scissor.x_off)) - 9;
+  const s32 minx = std::max(tri.minx, left);
+  const s32 maxx = std::min(tri.maxx, right);
+  const s32 miny = std::max(tri.miny, top);
+  const s32 maxy = std::min(tri.maxy, bottom);
 
-  // Deltas
-  const s32 DX12 = X1 - X2;
-  const s32 DX23 = X2 - X3;
-  const s32 DX31 = X3 - X1;
+  if (minx >= maxx || miny >= maxy)
+    return;
 
-  const s32 DY12 = Y1 - Y2;
-  const s32 DY23 = Y2 - Y3;
-  const s32 DY31 = Y3 - Y1;
+  const s32 C1 = tri.C1;
+  const s32 C2 = tri.C2;
+  const s32 C3 = tri.C3;
+  const s32 DX12 = tri.DX12;
+  const s32 DX23 = tri.DX23;
+  const s32 DX31 = tri.DX31;
+  const s32 DY12 = tri.DY12;
+  const s32 DY23 = tri.DY23;
+  const s32 DY31 = tri.DY31;
 
   // Fixed-pos32 deltas
   const s32 FDX12 = DX12 * 16;
@@ -358,62 +477,6 @@ static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertex
   const s32 FDY23 = DY23 * 16;
   const s32 FDY31 = DY31 * 16;
 
-  // Bounding rectangle
-  s32 minx = (std::min(std::min(X1, X2), X3) + 0xF) >> 4;
-  s32 maxx = (std::max(std::max(X1, X2), X3) + 0xF) >> 4;
-  s32 miny = (std::min(std::min(Y1, Y2), Y3) + 0xF) >> 4;
-  s32 maxy = (std::max(std::max(Y1, Y2), Y3) + 0xF) >> 4;
-
-  // scissor
-  ASSERT(scissor.rect.left >= 0);
-  ASSERT(scissor.rect.right <= static_cast<int>(EFB_WIDTH));
-  ASSERT(scissor.rect.top >= 0);
-  ASSERT(scissor.rect.bottom <= static_cast<int>(EFB_HEIGHT));
-
-  minx = std::max(minx, scissor.rect.left);
-  maxx = std::min(maxx, scissor.rect.right);
-  miny = std::max(miny, scissor.rect.top);
-  maxy = std::min(maxy, scissor.rect.bottom);
-
-  if (minx >= maxx || miny >= maxy)
-    return;
-
-  // Set up the remaining slopes
-  const SlopeContext ctx(v0, v1, v2, (X1 + 0xF) >> 4, (Y1 + 0xF) >> 4, scissor.x_off,
-                         scissor.y_off);
-
-  float w[3] = {1.0f / v0->projectedPosition.w, 1.0f / v1->projectedPosition.w,
-                1.0f / v2->projectedPosition.w};
-  WSlope = Slope(w[0], w[1], w[2], ctx);
-
-  for (unsigned int i = 0; i < bpmem.genMode.numcolchans; i++)
-  {
-    for (int comp = 0; comp < 4; comp++)
-      ColorSlopes[i][comp] = Slope(v0->color[i][comp], v1->color[i][comp], v2->color[i][comp], ctx);
-  }
-
-  for (unsigned int i = 0; i < bpmem.genMode.numtexgens; i++)
-  {
-    for (int comp = 0; comp < 3; comp++)
-    {
-      TexSlopes[i][comp] = Slope(v0->texCoords[i][comp] * w[0], v1->texCoords[i][comp] * w[1],
-                                 v2->texCoords[i][comp] * w[2], ctx);
-    }
-  }
-
-  // Half-edge constants
-  s32 C1 = DY12 * X1 - DX12 * Y1;
-  s32 C2 = DY23 * X2 - DX23 * Y2;
-  s32 C3 = DY31 * X3 - DX31 * Y3;
-
-  // Correct for fill convention
-  if (DY12 < 0 || (DY12 == 0 && DX12 > 0))
-    C1++;
-  if (DY23 < 0 || (DY23 == 0 && DX23 > 0))
-    C2++;
-  if (DY31 < 0 || (DY31 == 0 && DX31 > 0))
-    C3++;
-
   // Start in corner of 2x2 block
   s32 block_minx = minx & ~(BLOCK_SIZE - 1);
   s32 block_miny = miny & ~(BLOCK_SIZE - 1);
@@ -455,7 +518,7 @@ static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertex
       if (a == 0x0 || b == 0x0 || c == 0x0)
         continue;
 
-      BuildBlock(x, y);
+      BuildBlock(ctx.rasterBlock, tri, x, y);
 
       // Accept whole block when totally covered
       // We still need to check min/max x/y because of the scissor
@@ -465,7 +528,7 @@ static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertex
         {
           for (s32 ix = 0; ix < BLOCK_SIZE; ix++)
           {
-            Draw(x + ix, y + iy, ix, iy);
+            Draw(ctx, tri, x + ix, y + iy, ix, iy);
           }
         }
       }
@@ -488,7 +551,7 @@ static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertex
               // This check enforces the scissor rectangle, since it might not be aligned with the
               // blocks
               if (x + ix >= minx && x + ix < maxx && y + iy >= miny && y + iy < maxy)
-                Draw(x + ix, y + iy, ix, iy);
+                Draw(ctx, tri, x + ix, y + iy, ix, iy);
             }
 
             CX1 -= FDY12;
@@ -505,6 +568,136 @@ static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertex
   }
 }
 
+// Draws a tile's triangles in the order they were submitted, so that the result doesn't depend on
+// which thread draws which tile.
+static void DrawTile(RasterContext& ctx, u32 tile)
+{
+  const s32 left = static_cast<s32>(tile % NUM_TILES_X) * TILE_WIDTH;
+  const s32 top = static_cast<s32>(tile / NUM_TILES_X) * TILE_HEIGHT;
+
+  for (const u32 index : tileBins[tile])
+    DrawTriangle(ctx, triangles[index], left, top, left + TILE_WIDTH, top + TILE_HEIGHT);
+}
+
+static void BinTriangle(const TriangleSetup& tri)
+{
+  const u32 index = static_cast<u32>(triangles.size());
+  triangles.push_back(tri);
+
+  for (s32 ty = tri.miny / TILE_HEIGHT; ty <= (tri.maxy - 1) / TILE_HEIGHT; ty++)
+  {
+    for (s32 tx = tri.minx / TILE_WIDTH; tx <= (tri.maxx - 1) / TILE_WIDTH; tx++)
+    {
+      std::vector<u32>& bin = tileBins[ty * NUM_TILES_X + tx];
+      if (bin.empty())
+        numBinnedTiles++;
+      bin.push_back(index);
+    }
+  }
+}
+
+static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertexData* v1,
+                                  const OutputVertexData* v2,
+                                  const BPFunctions::ScissorRect& scissor)
+{
+  // The zslope should be updated now, even if the triangle is rejected by the scissor test, as
+  // zfreeze depends on it
+  UpdateZSlope(v0, v1, v2, scissor.x_off, scissor.y_off);
+
+  // adapted from http://devmaster.net/posts/6145/advanced-rasterization
+
+  // 28.4 fixed-pou32 coordinates. rounded to nearest and adjusted to match hardware output
+  // could also take floor and adjust -8
+  const s32 Y1 = iround(16.0f * (v0->screenPosition.y - scissor.y_off)) - 9;
+  const s32 Y2 = iround(16.0f * (v1->screenPosition.y - scissor.y_off)) - 9;
+  const s32 Y3 = iround(16.0f * (v2->screenPosition.y - scissor.y_off)) - 9;
+
+  const s32 X1 = iround(16.0f * (v0->screenPosition.x - scissor.x_off)) - 9;
+  const s32 X2 = iround(16.0f * (v1->screenPosition.x - scissor.x_off)) - 9;
+  const s32 X3 = iround(16.0f * (v2->screenPosition.x - scissor.x_off)) - 9;
+
+  // Bounding rectangle
+  s32 minx = (std::min(std::min(X1, X2), X3) + 0xF) >> 4;
+  s32 maxx = (std::max(std::max(X1, X2), X3) + 0xF) >> 4;
+  s32 miny = (std::min(std::min(Y1, Y2), Y3) + 0xF) >> 4;
+  s32 maxy = (std::max(std::max(Y1, Y2), Y3) + 0xF) >> 4;
+
+  // scissor
+  ASSERT(scissor.rect.left >= 0);
+  ASSERT(scissor.rect.right <= static_cast<int>(EFB_WIDTH));
+  ASSERT(scissor.rect.top >= 0);
+  ASSERT(scissor.rect.bottom <= static_cast<int>(EFB_HEIGHT));
+
+  minx = std::max(minx, scissor.rect.left);
+  maxx = std::min(maxx, scissor.rect.right);
+  miny = std::max(miny, scissor.rect.top);
+  maxy = std::min(maxy, scissor.rect.bottom);
+
+  if (minx >= maxx || miny >= maxy)
+    return;
+
+  TriangleSetup tri;
+  tri.minx = minx;
+  tri.maxx = maxx;
+  tri.miny = miny;
+  tri.maxy = maxy;
+  tri.ZSlope = ZSlope;
+
+  // Set up the remaining slopes
+  const SlopeContext ctx(v0, v1, v2, (X1 + 0xF) >> 4, (Y1 + 0xF) >> 4, scissor.x_off,
+                         scissor.y_off);
+
+  float w[3] = {1.0f / v0->projectedPosition.w, 1.0f / v1->projectedPosition.w,
+                1.0f / v2->projectedPosition.w};
+  tri.WSlope = Slope(w[0], w[1], w[2], ctx);
+
+  for (unsigned int i = 0; i < bpmem.genMode.numcolchans; i++)
+  {
+    for (int comp = 0; comp < 4; comp++)
+    {
+      tri.ColorSlopes[i][comp] =
+          Slope(v0->color[i][comp], v1->color[i][comp], v2->color[i][comp], ctx);
+    }
+  }
+
+  for (unsigned int i = 0; i < bpmem.genMode.numtexgens; i++)
+  {
+    for (int comp = 0; comp < 3; comp++)
+    {
+      tri.TexSlopes[i][comp] = Slope(v0->texCoords[i][comp] * w[0], v1->texCoords[i][comp] * w[1],
+                                     v2->texCoords[i][comp] * w[2], ctx);
+    }
+  }
+
+  // Deltas
+  tri.DX12 = X1 - X2;
+  tri.DX23 = X2 - X3;
+  tri.DX31 = X3 - X1;
+
+  tri.DY12 = Y1 - Y2;
+  tri.DY23 = Y2 - Y3;
+  tri.DY31 = Y3 - Y1;
+
+  // Half-edge constants
+  tri.C1 = tri.DY12 * X1 - tri.DX12 * Y1;
+  tri.C2 = tri.DY23 * X2 - tri.DX23 * Y2;
+  tri.C3 = tri.DY31 * X3 - tri.DX31 * Y3;
+
+  // Correct for fill convention
+  if (tri.DY12 < 0 || (tri.DY12 == 0 && tri.DX12 > 0))
+    tri.C1++;
+  if (tri.DY23 < 0 || (tri.DY23 == 0 && tri.DX23 > 0))
+    tri.C2++;
+  if (tri.DY31 < 0 || (tri.DY31 == 0 && tri.DX31 > 0))
+    tri.C3++;
+
+  // Without worker threads there is nothing to gain from binning.
+  if (workerThreads.empty())
+    DrawTriangle(*contexts[0], tri, 0, 0, EFB_WIDTH, EFB_HEIGHT);
+  else
+    BinTriangle(tri);
+}
+
 void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertexData* v1,
                            const OutputVertexData* v2)
 {
@@ -513,4 +706,70 @@ void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertexData* v
   for (const auto& scissor : scissors)
     DrawTriangleFrontFace(v0, v1, v2, scissor);
 }
+
+void Flush()
+{
+  if (numBinnedTiles == 1)
+  {
+    // Not worth waking up the workers for.
+    for (u32 tile = 0; tile < tileBins.size(); tile++)
+      DrawTile(*contexts[0], tile);
+  }
+  else if (numBinnedTiles != 0)
+  {
+    nextTile.store(0, std::memory_order_relaxed);
+    {
+      std::lock_guard lk(workerMutex);
+      workersBusy = static_cast<u32>(workerThreads.size());
+      workerGeneration++;
+    }
+    workerWake.notify_all();
+
+    for (u32 tile; (tile = nextTile.fetch_add(1, std::memory_order_relaxed)) < tileBins.size();)
+      DrawTile(*contexts[0], tile);
+
+    std::unique_lock lk(workerMutex);
+    workerDone.wait(lk, [] { return workersBusy == 0; });
+  }
+
+  if (numBinnedTiles != 0)
+  {
+    triangles.clear();
+    for (std::vector<u32>& bin : tileBins)
+      bin.clear();
+    numBinnedTiles = 0;
+  }
+
+  // Merge the side effects of every context. These only depend on the totals, so they are the
+  // same no matter how the tiles were distributed.
+  for (const auto& ctx : contexts)
+  {
+    Tev& tev = ctx->tev;
+    for (u32 i = 0; i < PQ_NUM_MEMBERS; i++)
+    {
+      if (tev.PerfPixelCounts[i] != 0)
+      {
+        EfbInterface::IncPerfCounterQuadCount(static_cast<PerfQueryType>(i),
+                                              tev.PerfPixelCounts[i]);
+      }
+    }
+    tev.PerfPixelCounts = {};
+
+    if (tev.PixelsOut != 0)
+    {
+      BBoxManager::Update(tev.BBoxLeft, tev.BBoxRight, tev.BBoxTop, tev.BBoxBottom);
+      tev.BBoxLeft = 0xFFFF;
+      tev.BBoxRight = 0;
+      tev.BBoxTop = 0xFFFF;
+      tev.BBoxBottom = 0;
+    }
+
+    ADDSTAT(g_stats.this_frame.rasterized_pixels, ctx->rasterizedPixels);
+    ADDSTAT(g_stats.this_frame.tev_pixels_in, tev.PixelsIn);
+    ADDSTAT(g_stats.this_frame.tev_pixels_out, tev.PixelsOut);
+    ctx->rasterizedPixels = 0;
+    tev.PixelsIn = 0;
+    tev.PixelsOut = 0;
+  }
+}
 }  // namespace Rasterizer
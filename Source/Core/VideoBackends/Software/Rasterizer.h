@@ -10,12 +10,17 @@ struct OutputVertexData;
 namespace Rasterizer
 {
 void Init();
+void Shutdown();
 void ScissorChanged();
 
 void UpdateZSlope(const OutputVertexData* v0, const OutputVertexData* v1,
                   const OutputVertexData* v2, s32 x_off, s32 y_off);
+// The triangle may not be drawn until Flush() is called.
 void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertexData* v1,
                            const OutputVertexData* v2);
+// Draws all pending triangles. Must be called before anything else accesses the EFB, the bounding
+// box or the perf query counters.
+void Flush();
 
 void SetTevKonstColors();
 
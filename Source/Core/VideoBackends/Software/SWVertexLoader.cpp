@@ -16,6 +16,7 @@
 #include "VideoBackends/Software/Rasterizer.h"
 #include "VideoBackends/Software/SWRenderer.h"
 #include "VideoBackends/Software/Tev.h"
+#include "VideoBackends/Software/TextureSampler.h"
 #include "VideoBackends/Software/TransformUnit.h"
 
 #include "VideoCommon/BoundingBox.h"
@@ -68,24 +69,42 @@ void SWVertexLoader::DrawCurrentBatch(u32 base_index, u32 num_indices, u32 base_
 
   m_setup_unit.Init(primitive_type);
   Rasterizer::SetTevKonstColors();
+  TextureSampler::PrepareTextures();
+
+  // The transform state can change between batches, so nothing carries over.
+  for (TransformedVertex& cached : m_transformed_vertices)
+    cached.index = UINT32_MAX;
 
   for (u32 i = 0; i < m_index_generator.GetIndexLen(); i++)
   {
     const u16 index = m_cpu_index_buffer[i];
-    memset(static_cast<void*>(&m_vertex), 0, sizeof(m_vertex));
-
-    // parse the videocommon format to our own struct format (m_vertex)
-    SetFormat();
-    ParseVertex(VertexLoaderManager::GetCurrentVertexFormat()->GetVertexDeclaration(), index);
-
-    // transform this vertex so that it can be used for rasterization (outVertex)
     OutputVertexData* outVertex = m_setup_unit.GetVertex();
-    TransformUnit::TransformPosition(&m_vertex, outVertex);
-    outVertex->normal = {};
-    if (VertexLoaderManager::g_current_components & VB_HAS_NORMAL)
-      TransformUnit::TransformNormal(&m_vertex, outVertex);
-    TransformUnit::TransformColor(&m_vertex, outVertex);
-    TransformUnit::TransformTexCoord(&m_vertex, outVertex);
+
+    // The setup unit modifies its vertices while clipping, so they're copied out of the cache.
+    TransformedVertex& cached = m_transformed_vertices[index % TRANSFORMED_VERTEX_CACHE_SIZE];
+    if (cached.index == index)
+    {
+      *outVertex = cached.vertex;
+    }
+    else
+    {
+      memset(static_cast<void*>(&m_vertex), 0, sizeof(m_vertex));
+
+      // parse the videocommon format to our own struct format (m_vertex)
+      SetFormat();
+      ParseVertex(VertexLoaderManager::GetCurrentVertexFormat()->GetVertexDeclaration(), index);
+
+      // transform this vertex so that it can be used for rasterization (outVertex)
+      TransformUnit::TransformPosition(&m_vertex, outVertex);
+      outVertex->normal = {};
+      if (VertexLoaderManager::g_current_components & VB_HAS_NORMAL)
+        TransformUnit::TransformNormal(&m_vertex, outVertex);
+      TransformUnit::TransformColor(&m_vertex, outVertex);
+      TransformUnit::TransformTexCoord(&m_vertex, outVertex);
+
+      cached.index = index;
+      cached.vertex = *outVertex;
+    }
 
     // assemble and rasterize the primitive
     m_setup_unit.SetupVertex();
@@ -93,6 +112,9 @@ void SWVertexLoader::DrawCurrentBatch(u32 base_index, u32 num_indices, u32 base_
     INCSTAT(g_stats.this_frame.num_vertices_loaded);
   }
 
+  // The next batch may come with different render state
+  Rasterizer::Flush();
+
   INCSTAT(g_stats.this_frame.num_drawn_objects);
 }
 
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <array>
 #include <memory>
 #include <vector>
 
@@ -30,4 +31,15 @@ protected:
 
   InputVertexData m_vertex{};
   SetupUnit m_setup_unit;
+
+  // Transformed vertices of the current batch by index, like a GPU's post-transform cache. The
+  // index generator turns strips, fans and quads into triangle lists, which reference most
+  // vertices more than once.
+  struct TransformedVertex
+  {
+    u32 index = UINT32_MAX;
+    OutputVertexData vertex;
+  };
+  static constexpr u32 TRANSFORMED_VERTEX_CACHE_SIZE = 32;
+  std::array<TransformedVertex, TRANSFORMED_VERTEX_CACHE_SIZE> m_transformed_vertices;
 };
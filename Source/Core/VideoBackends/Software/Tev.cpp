@@ -13,12 +13,10 @@
 #include "Core/System.h"
 
 #include "VideoBackends/Software/EfbInterface.h"
-#include "VideoBackends/Software/SWBoundingBox.h"
 #include "VideoBackends/Software/TextureSampler.h"
 
 #include "VideoCommon/PerfQueryBase.h"
 #include "VideoCommon/PixelShaderManager.h"
-#include "VideoCommon/Statistics.h"
 #include "VideoCommon/VideoCommon.h"
 #include "VideoCommon/VideoConfig.h"
 #include "VideoCommon/XFMemory.h"
@@ -397,7 +395,7 @@ void Tev::Draw()
   ASSERT(Position[0] >= 0 && Position[0] < s32(EFB_WIDTH));
   ASSERT(Position[1] >= 0 && Position[1] < s32(EFB_HEIGHT));
 
-  INCSTAT(g_stats.this_frame.tev_pixels_in);
+  ++PixelsIn;
 
   auto& system = Core::System::GetInstance();
   auto& pixel_shader_manager = system.GetPixelShaderManager();
@@ -666,21 +664,23 @@ void Tev::Draw()
   if (bpmem.GetEmulatedZ() == EmulatedZ::Late)
   {
     // TODO: Check against hw if these values get incremented even if depth testing is disabled
-    EfbInterface::IncPerfCounterQuadCount(PQ_ZCOMP_INPUT);
+    ++PerfPixelCounts[PQ_ZCOMP_INPUT];
 
     if (!EfbInterface::ZCompare(Position[0], Position[1], Position[2]))
       return;
 
-    EfbInterface::IncPerfCounterQuadCount(PQ_ZCOMP_OUTPUT);
+    ++PerfPixelCounts[PQ_ZCOMP_OUTPUT];
   }
 
   // The GC/Wii GPU rasterizes in 2x2 pixel groups, so bounding box values will be rounded to the
   // extents of these groups, rather than the exact pixel.
-  BBoxManager::Update(static_cast<u16>(Position[0] & ~1), static_cast<u16>(Position[0] | 1),
-                      static_cast<u16>(Position[1] & ~1), static_cast<u16>(Position[1] | 1));
+  BBoxLeft = std::min(BBoxLeft, static_cast<u16>(Position[0] & ~1));
+  BBoxRight = std::max(BBoxRight, static_cast<u16>(Position[0] | 1));
+  BBoxTop = std::min(BBoxTop, static_cast<u16>(Position[1] & ~1));
+  BBoxBottom = std::max(BBoxBottom, static_cast<u16>(Position[1] | 1));
 
-  INCSTAT(g_stats.this_frame.tev_pixels_out);
-  EfbInterface::IncPerfCounterQuadCount(PQ_BLEND_INPUT);
+  ++PixelsOut;
+  ++PerfPixelCounts[PQ_BLEND_INPUT];
 
   EfbInterface::BlendTev(Position[0], Position[1], output);
 }
@@ -7,6 +7,7 @@
 
 #include "Common/EnumMap.h"
 #include "VideoCommon/BPMemory.h"
+#include "VideoCommon/PerfQueryBase.h"
 
 class Tev
 {
@@ -221,6 +222,16 @@ public:
   s32 TextureLod[16]{};
   bool TextureLinear[16]{};
 
+  // Side effects of Draw() that are shared by the whole EFB. Each rasterizer thread has its own
+  // Tev, so these are accumulated here and merged by Rasterizer::Flush().
+  std::array<u32, PQ_NUM_MEMBERS> PerfPixelCounts{};
+  u32 PixelsIn = 0;
+  u32 PixelsOut = 0;
+  u16 BBoxLeft = 0xFFFF;
+  u16 BBoxRight = 0;
+  u16 BBoxTop = 0xFFFF;
+  u16 BBoxBottom = 0;
+
   enum
   {
     ALP_C,
@@ -4,10 +4,20 @@
 #include "VideoBackends/Software/TextureSampler.h"
 
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstring>
 #include <span>
+#include <vector>
+
+#if defined(_M_X86_64)
+#include <emmintrin.h>
+#elif defined(_M_ARM_64)
+#include <arm_neon.h>
+#endif
 
 #include "Common/CommonTypes.h"
+#include "Common/Hash.h"
 #include "Common/MsgHandler.h"
 #include "Common/SpanUtils.h"
 #include "Core/HW/Memmap.h"
@@ -15,11 +25,262 @@
 
 #include "VideoCommon/BPMemory.h"
 #include "VideoCommon/TextureDecoder.h"
+#include "VideoCommon/VideoConfig.h"
 
 #define ALLOW_MIPMAP 1
 
 namespace TextureSampler
 {
+namespace
+{
+// Where the texels of one mip level of a texmap come from
+struct MipSource
+{
+  std::span<const u8> src;
+  std::span<const u8> src_odd;
+  std::span<const u8> tlut;
+  TextureFormat format;
+  TLUTFormat tlut_format;
+  bool from_tmem_rgba8;
+  int width;
+  int height;
+};
+
+// A mip level fully decoded to RGBA8 by TexDecoder_DecodeTexel. Entries are checked against the
+// texture's hash at the start of every batch, so sampling within a batch only reads this array.
+struct DecodedMip
+{
+  const u8* src = nullptr;
+  const u8* tlut = nullptr;
+  TextureFormat format{};
+  TLUTFormat tlut_format{};
+  bool from_tmem_rgba8 = false;
+  int width = 0;
+  int height = 0;
+  u64 hash = 0;
+
+  // Whether the entry was validated for the current batch
+  bool valid = false;
+  std::vector<u8> texels;
+};
+
+// 1024x1024 down to 1x1
+constexpr s32 MAX_CACHED_MIPS = 11;
+
+std::array<std::array<DecodedMip, MAX_CACHED_MIPS>, 8> s_decoded_mips;
+}  // Anonymous namespace
+
+static MipSource GetMipSource(u8 texmap, s32 mip)
+{
+  auto texUnit = bpmem.tex.GetUnit(texmap);
+
+  const TexImage0& ti0 = texUnit.texImage0;
+  const TexTLUT& texTlut = texUnit.texTlut;
+  const TextureFormat texfmt = ti0.format;
+
+  MipSource source;
+  source.format = texfmt;
+  source.tlut_format = texTlut.tlut_format;
+  source.from_tmem_rgba8 =
+      texfmt == TextureFormat::RGBA8 && texUnit.texImage1.cache_manually_managed;
+
+  if (texUnit.texImage1.cache_manually_managed)
+  {
+    source.src = TexDecoder_GetTmemSpan(texUnit.texImage1.tmem_even * TMEM_LINE_SIZE);
+    if (texfmt == TextureFormat::RGBA8)
+      source.src_odd = TexDecoder_GetTmemSpan(texUnit.texImage2.tmem_odd * TMEM_LINE_SIZE);
+  }
+  else
+  {
+    auto& system = Core::System::GetInstance();
+    auto& memory = system.GetMemory();
+
+    const u32 imageBase = texUnit.texImage3.image_base << 5;
+    source.src = memory.GetSpanForAddress(imageBase);
+  }
+
+  int image_width_minus_1 = ti0.width;
+  int image_height_minus_1 = ti0.height;
+
+  const int tlutAddress = texTlut.tmem_offset << 9;
+  source.tlut = TexDecoder_GetTmemSpan(tlutAddress);
+
+  // reduce texture size to mip level
+  // move texture pointer to mip location
+  if (mip)
+  {
+    int mipWidth = image_width_minus_1 + 1;
+    int mipHeight = image_height_minus_1 + 1;
+
+    const int fmtWidth = TexDecoder_GetBlockWidthInTexels(texfmt);
+    const int fmtHeight = TexDecoder_GetBlockHeightInTexels(texfmt);
+    const int fmtDepth = TexDecoder_GetTexelSizeInNibbles(texfmt);
+
+    image_width_minus_1 >>= mip;
+    image_height_minus_1 >>= mip;
+
+    while (mip)
+    {
+      mipWidth = std::max(mipWidth, fmtWidth);
+      mipHeight = std::max(mipHeight, fmtHeight);
+      const u32 size = (mipWidth * mipHeight * fmtDepth) >> 1;
+
+      source.src = Common::SafeSubspan(source.src, size);
+      mipWidth >>= 1;
+      mipHeight >>= 1;
+      mip--;
+    }
+  }
+
+  source.width = image_width_minus_1 + 1;
+  source.height = image_height_minus_1 + 1;
+  return source;
+}
+
+static void DecodeTexel(const MipSource& source, int s, int t, u8* texel)
+{
+  if (source.from_tmem_rgba8)
+  {
+    TexDecoder_DecodeTexelRGBA8FromTmem(texel, source.src, source.src_odd, s, t, source.width - 1);
+  }
+  else
+  {
+    TexDecoder_DecodeTexel(texel, source.src, s, t, source.width - 1, source.format, source.tlut,
+                           source.tlut_format);
+  }
+}
+
+// Hashed the same way as TextureCacheBase, including its safe texture cache sample count.
+static u64 HashMipSource(const MipSource& source)
+{
+  const u32 samples = g_ActiveConfig.iSafeTextureCache_ColorSamples;
+  const auto hash_span = [samples](std::span<const u8> span, size_t size) {
+    span = Common::SafeSubspan(span, 0, size);
+    return Common::GetHash64(span.data(), static_cast<u32>(span.size()), samples);
+  };
+
+  const size_t size =
+      TexDecoder_GetTextureSizeInBytes(source.width, source.height, source.format);
+  u64 hash = hash_span(source.src, size);
+  if (!source.src_odd.empty())
+    hash = (hash * 397) ^ hash_span(source.src_odd, size);
+  if (IsColorIndexed(source.format))
+    hash ^= hash_span(source.tlut, TexDecoder_GetPaletteSize(source.format));
+  return hash;
+}
+
+static void PrepareMip(u8 texmap, s32 mip)
+{
+  const MipSource source = GetMipSource(texmap, mip);
+  const u64 hash = HashMipSource(source);
+
+  DecodedMip& decoded = s_decoded_mips[texmap][mip];
+  decoded.valid = true;
+  if (decoded.src == source.src.data() && decoded.tlut == source.tlut.data() &&
+      decoded.format == source.format && decoded.tlut_format == source.tlut_format &&
+      decoded.from_tmem_rgba8 == source.from_tmem_rgba8 && decoded.width == source.width &&
+      decoded.height == source.height && decoded.hash == hash)
+  {
+    return;
+  }
+
+  decoded.src = source.src.data();
+  decoded.tlut = source.tlut.data();
+  decoded.format = source.format;
+  decoded.tlut_format = source.tlut_format;
+  decoded.from_tmem_rgba8 = source.from_tmem_rgba8;
+  decoded.width = source.width;
+  decoded.height = source.height;
+  decoded.hash = hash;
+
+  decoded.texels.resize(static_cast<size_t>(source.width) * source.height * 4);
+  u8* texel = decoded.texels.data();
+  for (int t = 0; t < source.height; t++)
+  {
+    for (int s = 0; s < source.width; s++, texel += 4)
+      DecodeTexel(source, s, t, texel);
+  }
+}
+
+void PrepareTextures()
+{
+  for (auto& mips : s_decoded_mips)
+  {
+    for (DecodedMip& decoded : mips)
+      decoded.valid = false;
+  }
+
+  std::array<bool, 8> used{};
+  for (u32 i = 0; i < bpmem.genMode.numindstages; i++)
+    used[bpmem.tevindref.getTexMap(i)] = true;
+  for (u32 i = 0; i <= bpmem.genMode.numtevstages; i++)
+  {
+    const TwoTevStageOrders& order = bpmem.tevorders[i >> 1];
+    if (order.getEnable(i & 1))
+      used[order.getTexMap(i & 1)] = true;
+  }
+
+  for (u8 texmap = 0; texmap < used.size(); texmap++)
+  {
+    if (!used[texmap])
+      continue;
+
+    // Sample() never goes past the mip after max_lod
+    auto texUnit = bpmem.tex.GetUnit(texmap);
+    s32 max_mip = 0;
+    if (texUnit.texMode0.mipmap_filter != MipMode::None)
+      max_mip = std::min<s32>((texUnit.texMode1.max_lod >> 4) + 1, MAX_CACHED_MIPS - 1);
+
+    for (s32 mip = 0; mip <= max_mip; mip++)
+      PrepareMip(texmap, mip);
+  }
+}
+
+// sample = (t00 * w00 + t10 * w10 + t01 * w01 + t11 * w11) >> 14 for each channel, where the
+// weights are the products of the 7-bit fractions and sum up to 128 * 128.
+static inline void BilinearBlend(const u8* t00, const u8* t10, const u8* t01, const u8* t11,
+                                 u32 fractS, u32 fractT, u8* sample)
+{
+  const u32 w00 = (128 - fractS) * (128 - fractT);
+  const u32 w10 = fractS * (128 - fractT);
+  const u32 w01 = (128 - fractS) * fractT;
+  const u32 w11 = fractS * fractT;
+
+  u32 p00, p10, p01, p11;
+  std::memcpy(&p00, t00, sizeof(u32));
+  std::memcpy(&p10, t10, sizeof(u32));
+  std::memcpy(&p01, t01, sizeof(u32));
+  std::memcpy(&p11, t11, sizeof(u32));
+
+#if defined(_M_X86_64)
+  // Interleave the channels of horizontally adjacent texels as u16 so that each pmaddwd lane
+  // computes left * w_left + right * w_right. The weights never exceed 2^14, so they fit in s16.
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i top = _mm_unpacklo_epi8(
+      _mm_unpacklo_epi8(_mm_cvtsi32_si128(p00), _mm_cvtsi32_si128(p10)), zero);
+  const __m128i bottom = _mm_unpacklo_epi8(
+      _mm_unpacklo_epi8(_mm_cvtsi32_si128(p01), _mm_cvtsi32_si128(p11)), zero);
+  const __m128i sum =
+      _mm_add_epi32(_mm_madd_epi16(top, _mm_set1_epi32((w10 << 16) | w00)),
+                    _mm_madd_epi16(bottom, _mm_set1_epi32((w11 << 16) | w01)));
+  const __m128i result = _mm_srli_epi32(sum, 14);
+  const u32 packed = _mm_cvtsi128_si32(_mm_packus_epi16(_mm_packs_epi32(result, zero), zero));
+  std::memcpy(sample, &packed, sizeof(u32));
+#elif defined(_M_ARM_64)
+  const auto widen = [](u32 p) { return vget_low_u16(vmovl_u8(vcreate_u8(p))); };
+  uint32x4_t sum = vmull_n_u16(widen(p00), static_cast<u16>(w00));
+  sum = vmlal_n_u16(sum, widen(p10), static_cast<u16>(w10));
+  sum = vmlal_n_u16(sum, widen(p01), static_cast<u16>(w01));
+  sum = vmlal_n_u16(sum, widen(p11), static_cast<u16>(w11));
+  const uint16x4_t result = vshrn_n_u32(sum, 14);
+  const u32 packed = vget_lane_u32(vreinterpret_u32_u8(vmovn_u16(vcombine_u16(result, result))), 0);
+  std::memcpy(sample, &packed, sizeof(u32));
+#else
+  for (int i = 0; i < 4; i++)
+    sample[i] = static_cast<u8>((t00[i] * w00 + t10[i] * w10 + t01[i] * w01 + t11[i] * w11) >> 14);
+#endif
+}
+
 static inline void WrapCoord(int* coordp, WrapMode wrap_mode, int image_size)
 {
   int coord = *coordp;
@@ -115,68 +376,10 @@ void Sample(s32 s, s32 t, s32 lod, bool linear, u8 texmap, u8* sample)
   }
 }
 
-void SampleMip(s32 s, s32 t, s32 mip, bool linear, u8 texmap, u8* sample)
+template <typename FetchTexel>
+static void SampleTexels(s32 s, s32 t, bool linear, const TexMode0& tm0, int width, int height,
+                         FetchTexel fetch, u8* sample)
 {
-  auto texUnit = bpmem.tex.GetUnit(texmap);
-
-  const TexMode0& tm0 = texUnit.texMode0;
-  const TexImage0& ti0 = texUnit.texImage0;
-  const TexTLUT& texTlut = texUnit.texTlut;
-  const TextureFormat texfmt = ti0.format;
-  const TLUTFormat tlutfmt = texTlut.tlut_format;
-
-  std::span<const u8> image_src;
-  std::span<const u8> image_src_odd;
-  if (texUnit.texImage1.cache_manually_managed)
-  {
-    image_src = TexDecoder_GetTmemSpan(texUnit.texImage1.tmem_even * TMEM_LINE_SIZE);
-    if (texfmt == TextureFormat::RGBA8)
-      image_src_odd = TexDecoder_GetTmemSpan(texUnit.texImage2.tmem_odd * TMEM_LINE_SIZE);
-  }
-  else
-  {
-    auto& system = Core::System::GetInstance();
-    auto& memory = system.GetMemory();
-
-    const u32 imageBase = texUnit.texImage3.image_base << 5;
-    image_src = memory.GetSpanForAddress(imageBase);
-  }
-
-  int image_width_minus_1 = ti0.width;
-  int image_height_minus_1 = ti0.height;
-
-  const int tlutAddress = texTlut.tmem_offset << 9;
-  const std::span<const u8> tlut = TexDecoder_GetTmemSpan(tlutAddress);
-
-  // reduce sample location and texture size to mip level
-  // move texture pointer to mip location
-  if (mip)
-  {
-    int mipWidth = image_width_minus_1 + 1;
-    int mipHeight = image_height_minus_1 + 1;
-
-    const int fmtWidth = TexDecoder_GetBlockWidthInTexels(texfmt);
-    const int fmtHeight = TexDecoder_GetBlockHeightInTexels(texfmt);
-    const int fmtDepth = TexDecoder_GetTexelSizeInNibbles(texfmt);
-
-    image_width_minus_1 >>= mip;
-    image_height_minus_1 >>= mip;
-    s >>= mip;
-    t >>= mip;
-
-    while (mip)
-    {
-      mipWidth = std::max(mipWidth, fmtWidth);
-      mipHeight = std::max(mipHeight, fmtHeight);
-      const u32 size = (mipWidth * mipHeight * fmtDepth) >> 1;
-
-      image_src = Common::SafeSubspan(image_src, size);
-      mipWidth >>= 1;
-      mipHeight >>= 1;
-      mip--;
-    }
-  }
-
   if (linear)
   {
     // offset linear sampling
@@ -194,55 +397,17 @@ void SampleMip(s32 s, s32 t, s32 mip, bool linear, u8 texmap, u8* sample)
     int imageTPlus1 = imageT + 1;
     const int fractT = t & 0x7f;
 
-    u8 sampledTex[4];
-    u32 texel[4];
-
-    WrapCoord(&imageS, tm0.wrap_s, image_width_minus_1 + 1);
-    WrapCoord(&imageT, tm0.wrap_t, image_height_minus_1 + 1);
-    WrapCoord(&imageSPlus1, tm0.wrap_s, image_width_minus_1 + 1);
-    WrapCoord(&imageTPlus1, tm0.wrap_t, image_height_minus_1 + 1);
-
-    if (!(texfmt == TextureFormat::RGBA8 && texUnit.texImage1.cache_manually_managed))
-    {
-      TexDecoder_DecodeTexel(sampledTex, image_src, imageS, imageT, image_width_minus_1, texfmt,
-                             tlut, tlutfmt);
-      SetTexel(sampledTex, texel, (128 - fractS) * (128 - fractT));
-
-      TexDecoder_DecodeTexel(sampledTex, image_src, imageSPlus1, imageT, image_width_minus_1,
-                             texfmt, tlut, tlutfmt);
-      AddTexel(sampledTex, texel, (fractS) * (128 - fractT));
-
-      TexDecoder_DecodeTexel(sampledTex, image_src, imageS, imageTPlus1, image_width_minus_1,
-                             texfmt, tlut, tlutfmt);
-      AddTexel(sampledTex, texel, (128 - fractS) * (fractT));
-
-      TexDecoder_DecodeTexel(sampledTex, image_src, imageSPlus1, imageTPlus1, image_width_minus_1,
-                             texfmt, tlut, tlutfmt);
-      AddTexel(sampledTex, texel, (fractS) * (fractT));
-    }
-    else
-    {
-      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex, image_src, image_src_odd, imageS, imageT,
-                                          image_width_minus_1);
-      SetTexel(sampledTex, texel, (128 - fractS) * (128 - fractT));
-
-      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex, image_src, image_src_odd, imageSPlus1, imageT,
-                                          image_width_minus_1);
-      AddTexel(sampledTex, texel, (fractS) * (128 - fractT));
-
-      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex, image_src, image_src_odd, imageS, imageTPlus1,
-                                          image_width_minus_1);
-      AddTexel(sampledTex, texel, (128 - fractS) * (fractT));
-
-      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex, image_src, image_src_odd, imageSPlus1,
-                                          imageTPlus1, image_width_minus_1);
-      AddTexel(sampledTex, texel, (fractS) * (fractT));
-    }
-
-    sample[0] = (u8)(texel[0] >> 14);
-    sample[1] = (u8)(texel[1] >> 14);
-    sample[2] = (u8)(texel[2] >> 14);
-    sample[3] = (u8)(texel[3] >> 14);
+    WrapCoord(&imageS, tm0.wrap_s, width);
+    WrapCoord(&imageT, tm0.wrap_t, height);
+    WrapCoord(&imageSPlus1, tm0.wrap_s, width);
+    WrapCoord(&imageTPlus1, tm0.wrap_t, height);
+
+    u8 texels[4][4];
+    fetch(imageS, imageT, texels[0]);
+    fetch(imageSPlus1, imageT, texels[1]);
+    fetch(imageS, imageTPlus1, texels[2]);
+    fetch(imageSPlus1, imageTPlus1, texels[3]);
+    BilinearBlend(texels[0], texels[1], texels[2], texels[3], fractS, fractT, sample);
   }
   else
   {
@@ -251,19 +416,34 @@ void SampleMip(s32 s, s32 t, s32 mip, bool linear, u8 texmap, u8* sample)
     int imageT = t >> 7;
 
     // nearest neighbor sampling
-    WrapCoord(&imageS, tm0.wrap_s, image_width_minus_1 + 1);
-    WrapCoord(&imageT, tm0.wrap_t, image_height_minus_1 + 1);
+    WrapCoord(&imageS, tm0.wrap_s, width);
+    WrapCoord(&imageT, tm0.wrap_t, height);
 
-    if (!(texfmt == TextureFormat::RGBA8 && texUnit.texImage1.cache_manually_managed))
-    {
-      TexDecoder_DecodeTexel(sample, image_src, imageS, imageT, image_width_minus_1, texfmt, tlut,
-                             tlutfmt);
-    }
-    else
-    {
-      TexDecoder_DecodeTexelRGBA8FromTmem(sample, image_src, image_src_odd, imageS, imageT,
-                                          image_width_minus_1);
-    }
+    fetch(imageS, imageT, sample);
+  }
+}
+
+void SampleMip(s32 s, s32 t, s32 mip, bool linear, u8 texmap, u8* sample)
+{
+  const TexMode0& tm0 = bpmem.tex.GetUnit(texmap).texMode0;
+
+  // reduce sample location to mip level
+  s >>= mip;
+  t >>= mip;
+
+  if (mip < MAX_CACHED_MIPS && s_decoded_mips[texmap][mip].valid)
+  {
+    const DecodedMip& decoded = s_decoded_mips[texmap][mip];
+    const auto fetch = [&decoded](int x, int y, u8* texel) {
+      std::memcpy(texel, &decoded.texels[(static_cast<size_t>(y) * decoded.width + x) * 4], 4);
+    };
+    SampleTexels(s, t, linear, tm0, decoded.width, decoded.height, fetch, sample);
+  }
+  else
+  {
+    const MipSource source = GetMipSource(texmap, mip);
+    const auto fetch = [&source](int x, int y, u8* texel) { DecodeTexel(source, x, y, texel); };
+    SampleTexels(s, t, linear, tm0, source.width, source.height, fetch, sample);
   }
 }
 }  // namespace TextureSampler
@@ -11,6 +11,10 @@ void Sample(s32 s, s32 t, s32 lod, bool linear, u8 texmap, u8* sample);
 
 void SampleMip(s32 s, s32 t, s32 mip, bool linear, u8 texmap, u8* sample);
 
+// Decodes the textures used by the current render state. Must be called at the start of every
+// batch, as texture memory or texture state may have changed since the last one.
+void PrepareTextures();
+
 enum
 {
   RED_SMP,
@@ -120,6 +120,11 @@ void CommandBufferManager::DestroyCommandBuffers()
     // objects which are pending destruction being in-use.
     if (resources.command_pool != VK_NULL_HANDLE)
       vkDestroyCommandPool(device, resources.command_pool, nullptr);
+    for (SecondaryCommandPool& pool : resources.secondary_pools)
+    {
+      if (pool.command_pool != VK_NULL_HANDLE)
+        vkDestroyCommandPool(device, pool.command_pool, nullptr);
+    }
 
     // Destroy any pending objects.
     for (auto& it : resources.cleanup_resources)
@@ -482,6 +487,16 @@ void CommandBufferManager::BeginCommandBuffer()
   res = vkResetCommandPool(g_vulkan_context->GetDevice(), resources.command_pool, 0);
   if (res != VK_SUCCESS)
     LOG_VULKAN_ERROR(res, "vkResetCommandPool failed: ");
+  for (SecondaryCommandPool& pool : resources.secondary_pools)
+  {
+    if (pool.command_pool == VK_NULL_HANDLE || pool.next_command_buffer == 0)
+      continue;
+
+    res = vkResetCommandPool(g_vulkan_context->GetDevice(), pool.command_pool, 0);
+    if (res != VK_SUCCESS)
+      LOG_VULKAN_ERROR(res, "vkResetCommandPool failed: ");
+    pool.next_command_buffer = 0;
+  }
 
   // Enable commands to be recorded to the two buffers again.
   VkCommandBufferBeginInfo begin_info = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO, nullptr,
@@ -501,6 +516,41 @@ void CommandBufferManager::BeginCommandBuffer()
   m_current_cmd_buffer = next_buffer_index;
 }
 
+VkCommandBuffer CommandBufferManager::AllocateSecondaryCommandBuffer(u32 thread_index)
+{
+  SecondaryCommandPool& pool = GetCurrentCmdBufferResources().secondary_pools[thread_index];
+  if (pool.command_pool == VK_NULL_HANDLE)
+  {
+    VkCommandPoolCreateInfo pool_info = {VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO, nullptr, 0,
+                                         g_vulkan_context->GetGraphicsQueueFamilyIndex()};
+    VkResult res = vkCreateCommandPool(g_vulkan_context->GetDevice(), &pool_info, nullptr,
+                                       &pool.command_pool);
+    if (res != VK_SUCCESS)
+    {
+      LOG_VULKAN_ERROR(res, "vkCreateCommandPool failed: ");
+      return VK_NULL_HANDLE;
+    }
+  }
+
+  if (pool.next_command_buffer == pool.command_buffers.size())
+  {
+    VkCommandBufferAllocateInfo buffer_info = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+                                               nullptr, pool.command_pool,
+                                               VK_COMMAND_BUFFER_LEVEL_SECONDARY, 1};
+    VkCommandBuffer command_buffer;
+    VkResult res =
+        vkAllocateCommandBuffers(g_vulkan_context->GetDevice(), &buffer_info, &command_buffer);
+    if (res != VK_SUCCESS)
+    {
+      LOG_VULKAN_ERROR(res, "vkAllocateCommandBuffers failed: ");
+      return VK_NULL_HANDLE;
+    }
+    pool.command_buffers.push_back(command_buffer);
+  }
+
+  return pool.command_buffers[pool.next_command_buffer++];
+}
+
 void CommandBufferManager::DeferBufferViewDestruction(VkBufferView object)
 {
   CmdBufferResources& cmd_buffer_resources = GetCurrentCmdBufferResources();
@@ -47,6 +47,11 @@ public:
   // Allocates a descriptors set from the pool reserved for the current frame.
   VkDescriptorSet AllocateDescriptorSet(VkDescriptorSetLayout set_layout);
 
+  // Allocates a secondary command buffer for the current command buffer, from the pool owned by
+  // recording thread thread_index. The buffer may only be recorded on that thread, and is valid
+  // until the current command buffer is submitted.
+  VkCommandBuffer AllocateSecondaryCommandBuffer(u32 thread_index);
+
   // Fence "counters" are used to track which commands have been completed by the GPU.
   // If the last completed fence counter is greater or equal to N, it means that the work
   // associated counter N has been completed by the GPU. The value of N to associate with
@@ -109,11 +114,21 @@ private:
 
   const u32 DESCRIPTOR_SETS_PER_POOL = 1024;
 
+  // Command pools are externally synchronized, so every recording thread needs its own.
+  struct SecondaryCommandPool
+  {
+    VkCommandPool command_pool = VK_NULL_HANDLE;
+    std::vector<VkCommandBuffer> command_buffers;
+    size_t next_command_buffer = 0;
+  };
+
   struct CmdBufferResources
   {
     // [0] - Init (upload) command buffer, [1] - draw command buffer
     VkCommandPool command_pool = VK_NULL_HANDLE;
     std::array<VkCommandBuffer, 2> command_buffers = {};
+    // Created on first use
+    std::array<SecondaryCommandPool, NUM_COMMAND_RECORDING_THREADS> secondary_pools;
     VkFence fence = VK_NULL_HANDLE;
     VkSemaphore semaphore = VK_NULL_HANDLE;
     u64 fence_counter = 0;
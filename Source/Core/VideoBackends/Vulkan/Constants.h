@@ -17,6 +17,9 @@ constexpr size_t NUM_COMMAND_BUFFERS = 8;
 // Number of frames in flight, will be used to decide how many descriptor pools are used
 constexpr size_t NUM_FRAMES_IN_FLIGHT = 2;
 
+// Number of threads recording secondary command buffers, including the GPU thread.
+constexpr size_t NUM_COMMAND_RECORDING_THREADS = 4;
+
 // Staging buffer usage - optimize for uploads or readbacks
 enum STAGING_BUFFER_TYPE
 {
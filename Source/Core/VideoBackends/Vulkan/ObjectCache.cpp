@@ -5,6 +5,7 @@
 
 #include <algorithm>
 #include <array>
+#include <mutex>
 #include <type_traits>
 
 #include "Common/Assert.h"
@@ -32,6 +33,7 @@ ObjectCache::ObjectCache() = default;
 
 ObjectCache::~ObjectCache()
 {
+  DestroyPipelineLibraries();
   DestroyPipelineCache();
   DestroySamplers();
   DestroyPipelineLayouts();
@@ -507,6 +509,98 @@ void ObjectCache::DestroyRenderPassCache()
   m_render_pass_cache.clear();
 }
 
+template <typename Key>
+static VkPipeline GetPipelineLibrary(std::mutex& mutex, std::map<Key, VkPipeline>& cache,
+                                     const Key& key,
+                                     const ObjectCache::PipelineLibraryCreateFunction& create)
+{
+  {
+    std::lock_guard guard(mutex);
+    auto it = cache.find(key);
+    if (it != cache.end())
+      return it->second;
+  }
+
+  // Compiling a library can take a while, so don't block other compile threads on it. If two
+  // threads race to create the same library, the loser's copy is thrown away.
+  VkPipeline library = create();
+  if (library == VK_NULL_HANDLE)
+    return VK_NULL_HANDLE;
+
+  std::lock_guard guard(mutex);
+  auto [it, inserted] = cache.emplace(key, library);
+  if (!inserted)
+    vkDestroyPipeline(g_vulkan_context->GetDevice(), library, nullptr);
+  return it->second;
+}
+
+VkPipeline ObjectCache::GetVertexInputLibrary(const VertexInputLibraryKey& key,
+                                              const PipelineLibraryCreateFunction& create)
+{
+  return GetPipelineLibrary(m_pipeline_library_mutex, m_vertex_input_libraries, key, create);
+}
+
+VkPipeline ObjectCache::GetPreRasterizationLibrary(const PreRasterizationLibraryKey& key,
+                                                   const PipelineLibraryCreateFunction& create)
+{
+  return GetPipelineLibrary(m_pipeline_library_mutex, m_pre_rasterization_libraries, key,
+                            create);
+}
+
+VkPipeline ObjectCache::GetFragmentShaderLibrary(const FragmentShaderLibraryKey& key,
+                                                 const PipelineLibraryCreateFunction& create)
+{
+  return GetPipelineLibrary(m_pipeline_library_mutex, m_fragment_shader_libraries, key, create);
+}
+
+VkPipeline ObjectCache::GetFragmentOutputLibrary(const FragmentOutputLibraryKey& key,
+                                                 const PipelineLibraryCreateFunction& create)
+{
+  return GetPipelineLibrary(m_pipeline_library_mutex, m_fragment_output_libraries, key, create);
+}
+
+void ObjectCache::ReleasePipelineLibraries(VkShaderModule module)
+{
+  // Linked pipelines do not reference their libraries, so these can go immediately.
+  const auto release = [module](auto& cache, auto uses_module) {
+    for (auto it = cache.begin(); it != cache.end();)
+    {
+      if (uses_module(it->first))
+      {
+        vkDestroyPipeline(g_vulkan_context->GetDevice(), it->second, nullptr);
+        it = cache.erase(it);
+      }
+      else
+      {
+        ++it;
+      }
+    }
+  };
+
+  std::lock_guard guard(m_pipeline_library_mutex);
+  release(m_pre_rasterization_libraries, [module](const PreRasterizationLibraryKey& key) {
+    return std::get<0>(key) == module || std::get<1>(key) == module;
+  });
+  release(m_fragment_shader_libraries, [module](const FragmentShaderLibraryKey& key) {
+    return std::get<0>(key) == module;
+  });
+}
+
+void ObjectCache::DestroyPipelineLibraries()
+{
+  const auto destroy = [](auto& cache) {
+    for (const auto& it : cache)
+      vkDestroyPipeline(g_vulkan_context->GetDevice(), it.second, nullptr);
+    cache.clear();
+  };
+
+  std::lock_guard guard(m_pipeline_library_mutex);
+  destroy(m_vertex_input_libraries);
+  destroy(m_pre_rasterization_libraries);
+  destroy(m_fragment_shader_libraries);
+  destroy(m_fragment_output_libraries);
+}
+
 class PipelineCacheReadCallback : public Common::LinearDiskCacheReader<u32, u8>
 {
 public:
@@ -5,8 +5,10 @@
 
 #include <array>
 #include <cstddef>
+#include <functional>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <tuple>
 #include <unordered_map>
@@ -16,7 +18,9 @@
 
 #include "VideoBackends/Vulkan/Constants.h"
 
+#include "VideoCommon/AbstractPipeline.h"
 #include "VideoCommon/GeometryShaderGen.h"
+#include "VideoCommon/NativeVertexFormat.h"
 #include "VideoCommon/PixelShaderGen.h"
 #include "VideoCommon/RenderState.h"
 #include "VideoCommon/VertexShaderGen.h"
@@ -65,6 +69,30 @@ public:
   // Pipeline cache. Used when creating pipelines for drivers to store compiled programs.
   VkPipelineCache GetPipelineCache() const { return m_pipeline_cache; }
 
+  // Graphics pipeline library cache. Each library holds one pipeline stage group, so pipelines
+  // sharing a group only have to link it. The create function is called without the lock held
+  // when there is no library for the key yet, and may return VK_NULL_HANDLE on failure.
+  using PipelineLibraryCreateFunction = std::function<VkPipeline()>;
+  using VertexInputLibraryKey =
+      std::tuple<bool, PortableVertexDeclaration, VkPrimitiveTopology, VkBool32>;
+  using PreRasterizationLibraryKey =
+      std::tuple<VkShaderModule, VkShaderModule, u32, VkPipelineLayout, VkRenderPass>;
+  using FragmentShaderLibraryKey =
+      std::tuple<VkShaderModule, u32, u32, VkPipelineLayout, VkRenderPass>;
+  using FragmentOutputLibraryKey = std::tuple<u32, u32, AbstractPipelineUsage, VkRenderPass>;
+  VkPipeline GetVertexInputLibrary(const VertexInputLibraryKey& key,
+                                   const PipelineLibraryCreateFunction& create);
+  VkPipeline GetPreRasterizationLibrary(const PreRasterizationLibraryKey& key,
+                                        const PipelineLibraryCreateFunction& create);
+  VkPipeline GetFragmentShaderLibrary(const FragmentShaderLibraryKey& key,
+                                      const PipelineLibraryCreateFunction& create);
+  VkPipeline GetFragmentOutputLibrary(const FragmentOutputLibraryKey& key,
+                                      const PipelineLibraryCreateFunction& create);
+
+  // Destroys any pipeline libraries built from the specified shader module, call before the
+  // module is destroyed so that a recycled handle cannot match a stale library.
+  void ReleasePipelineLibraries(VkShaderModule module);
+
   // Clear sampler cache, use when anisotropy mode changes
   // WARNING: Ensure none of the objects from here are in use when calling
   void ClearSamplerCache();
@@ -83,6 +111,7 @@ private:
   bool CreateStaticSamplers();
   void DestroySamplers();
   void DestroyRenderPassCache();
+  void DestroyPipelineLibraries();
   bool CreatePipelineCache();
   bool LoadPipelineCache();
   bool ValidatePipelineCache(const u8* data, size_t data_length);
@@ -105,6 +134,13 @@ private:
   using RenderPassCacheKey = std::tuple<VkFormat, VkFormat, u32, VkAttachmentLoadOp, std::size_t>;
   std::map<RenderPassCacheKey, VkRenderPass> m_render_pass_cache;
 
+  // Graphics pipeline libraries
+  std::mutex m_pipeline_library_mutex;
+  std::map<VertexInputLibraryKey, VkPipeline> m_vertex_input_libraries;
+  std::map<PreRasterizationLibraryKey, VkPipeline> m_pre_rasterization_libraries;
+  std::map<FragmentShaderLibraryKey, VkPipeline> m_fragment_shader_libraries;
+  std::map<FragmentOutputLibraryKey, VkPipeline> m_fragment_output_libraries;
+
   // pipeline cache
   VkPipelineCache m_pipeline_cache = VK_NULL_HANDLE;
   std::string m_pipeline_cache_filename;
@@ -3,6 +3,9 @@
 
 #include "VideoBackends/Vulkan/StateTracker.h"
 
+#include <algorithm>
+#include <cstring>
+
 #include "Common/Assert.h"
 
 #include "VideoBackends/Vulkan/CommandBufferManager.h"
@@ -14,6 +17,7 @@
 #include "VideoBackends/Vulkan/VKVertexFormat.h"
 #include "VideoBackends/Vulkan/VulkanContext.h"
 #include "VideoCommon/Constants.h"
+#include "VideoCommon/VideoConfig.h"
 
 namespace Vulkan
 {
@@ -283,6 +287,9 @@ void StateTracker::InvalidateCachedState()
 
 void StateTracker::BeginRenderPass()
 {
+  // Callers record commands inline after this, which can't be mixed with secondary buffers.
+  if (m_deferring_draws)
+    EndDeferredRenderPass();
   if (InRenderPass())
     return;
 
@@ -303,6 +310,8 @@ void StateTracker::BeginRenderPass()
 
 void StateTracker::BeginDiscardRenderPass()
 {
+  if (m_deferring_draws)
+    EndDeferredRenderPass();
   if (InRenderPass())
     return;
 
@@ -323,6 +332,11 @@ void StateTracker::BeginDiscardRenderPass()
 
 void StateTracker::EndRenderPass()
 {
+  if (m_deferring_draws)
+  {
+    EndDeferredRenderPass();
+    return;
+  }
   if (!InRenderPass())
     return;
 
@@ -378,6 +392,10 @@ bool StateTracker::Bind()
   if (m_current_render_pass == m_framebuffer->GetClearRenderPass() && !IsViewportWithinRenderArea())
     EndRenderPass();
 
+  // Draws of a render pass started here can be recorded in parallel when the pass ends.
+  if (!InRenderPass() && g_ActiveConfig.bParallelCommandRecording)
+    BeginDeferredRenderPass();
+
   // Get a new descriptor set if any parts have changed
   UpdateDescriptorSet();
 
@@ -385,6 +403,14 @@ bool StateTracker::Bind()
   if (!InRenderPass())
     BeginRenderPass();
 
+  if (m_deferring_draws)
+  {
+    // State is captured per draw in DeferDraw instead.
+    m_dirty_flags &= ~(DIRTY_FLAG_VERTEX_BUFFER | DIRTY_FLAG_INDEX_BUFFER | DIRTY_FLAG_PIPELINE |
+                       DIRTY_FLAG_VIEWPORT | DIRTY_FLAG_SCISSOR);
+    return true;
+  }
+
   // Re-bind parts of the pipeline
   const VkCommandBuffer command_buffer = g_command_buffer_mgr->GetCurrentCommandBuffer();
   const bool needs_vertex_buffer = !g_ActiveConfig.backend_info.bSupportsDynamicVertexLoader ||
@@ -412,6 +438,29 @@ bool StateTracker::Bind()
   return true;
 }
 
+void StateTracker::Draw(u32 num_vertices, u32 base_vertex)
+{
+  if (m_deferring_draws)
+  {
+    DeferDraw(false, num_vertices, base_vertex, 0);
+    return;
+  }
+
+  vkCmdDraw(g_command_buffer_mgr->GetCurrentCommandBuffer(), num_vertices, 1, base_vertex, 0);
+}
+
+void StateTracker::DrawIndexed(u32 base_index, u32 num_indices, u32 base_vertex)
+{
+  if (m_deferring_draws)
+  {
+    DeferDraw(true, num_indices, base_index, static_cast<s32>(base_vertex));
+    return;
+  }
+
+  vkCmdDrawIndexed(g_command_buffer_mgr->GetCurrentCommandBuffer(), num_indices, 1, base_index,
+                   base_vertex, 0);
+}
+
 bool StateTracker::BindCompute()
 {
   if (!m_compute_shader)
@@ -573,7 +622,20 @@ void StateTracker::UpdateGXDescriptorSet()
   if (num_writes > 0)
     vkUpdateDescriptorSets(g_vulkan_context->GetDevice(), num_writes, writes.data(), 0, nullptr);
 
-  if (m_dirty_flags & DIRTY_FLAG_DESCRIPTOR_SETS)
+  if (m_deferring_draws)
+  {
+    const u32 num_sets = needs_ssbo ? NUM_GX_DESCRIPTOR_SETS : (NUM_GX_DESCRIPTOR_SETS - 1);
+    const u32 num_offsets =
+        needs_gs_ubo ? NUM_UBO_DESCRIPTOR_SET_BINDINGS : (NUM_UBO_DESCRIPTOR_SET_BINDINGS - 1);
+    std::copy_n(m_gx_descriptor_sets.begin(), num_sets,
+                m_deferred_draw_state.descriptor_sets.begin());
+    m_deferred_draw_state.num_descriptor_sets = num_sets;
+    std::copy_n(m_bindings.gx_ubo_offsets.begin(), num_offsets,
+                m_deferred_draw_state.dynamic_offsets.begin());
+    m_deferred_draw_state.num_dynamic_offsets = num_offsets;
+    m_dirty_flags &= ~(DIRTY_FLAG_DESCRIPTOR_SETS | DIRTY_FLAG_GX_UBO_OFFSETS);
+  }
+  else if (m_dirty_flags & DIRTY_FLAG_DESCRIPTOR_SETS)
   {
     vkCmdBindDescriptorSets(g_command_buffer_mgr->GetCurrentCommandBuffer(),
                             VK_PIPELINE_BIND_POINT_GRAPHICS, m_pipeline->GetVkPipelineLayout(), 0,
@@ -653,7 +715,16 @@ void StateTracker::UpdateUtilityDescriptorSet()
   if (writes > 0)
     vkUpdateDescriptorSets(g_vulkan_context->GetDevice(), writes, dswrites.data(), 0, nullptr);
 
-  if (m_dirty_flags & DIRTY_FLAG_DESCRIPTOR_SETS)
+  if (m_deferring_draws)
+  {
+    std::copy(m_utility_descriptor_sets.begin(), m_utility_descriptor_sets.end(),
+              m_deferred_draw_state.descriptor_sets.begin());
+    m_deferred_draw_state.num_descriptor_sets = NUM_UTILITY_DESCRIPTOR_SETS;
+    m_deferred_draw_state.dynamic_offsets[0] = m_bindings.utility_ubo_offset;
+    m_deferred_draw_state.num_dynamic_offsets = 1;
+    m_dirty_flags &= ~(DIRTY_FLAG_DESCRIPTOR_SETS | DIRTY_FLAG_UTILITY_UBO_OFFSET);
+  }
+  else if (m_dirty_flags & DIRTY_FLAG_DESCRIPTOR_SETS)
   {
     vkCmdBindDescriptorSets(g_command_buffer_mgr->GetCurrentCommandBuffer(),
                             VK_PIPELINE_BIND_POINT_GRAPHICS, m_pipeline->GetVkPipelineLayout(), 0,
@@ -737,4 +808,189 @@ void StateTracker::UpdateComputeDescriptorSet()
   }
 }
 
+void StateTracker::BeginDeferredRenderPass()
+{
+  if (!m_recording_threads[0])
+  {
+    for (auto& thread : m_recording_threads)
+    {
+      thread = std::make_unique<Common::WorkQueueThread<RecordRequest>>(
+          "Vulkan Recording", [](RecordRequest request) { RecordSecondaryCommandBuffer(request); });
+    }
+  }
+
+  m_current_render_pass = m_framebuffer->GetLoadRenderPass();
+  m_framebuffer_render_area = m_framebuffer->GetRect();
+  m_deferring_draws = true;
+}
+
+void StateTracker::EndDeferredRenderPass()
+{
+  m_deferring_draws = false;
+
+  const VkCommandBuffer command_buffer = g_command_buffer_mgr->GetCurrentCommandBuffer();
+  const std::span<const DeferredDraw> draws = m_deferred_draws;
+  const size_t num_secondaries = std::min(
+      NUM_COMMAND_RECORDING_THREADS, draws.size() / MIN_DRAWS_PER_SECONDARY_COMMAND_BUFFER);
+
+  std::array<VkCommandBuffer, NUM_COMMAND_RECORDING_THREADS> secondaries;
+  bool use_secondaries = num_secondaries > 1;
+  for (size_t i = 0; i < num_secondaries && use_secondaries; i++)
+  {
+    secondaries[i] = g_command_buffer_mgr->AllocateSecondaryCommandBuffer(static_cast<u32>(i));
+    use_secondaries = secondaries[i] != VK_NULL_HANDLE;
+  }
+
+  const VkRenderPassBeginInfo begin_info = {VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO,
+                                            nullptr,
+                                            m_current_render_pass,
+                                            m_framebuffer->GetFB(),
+                                            m_framebuffer_render_area,
+                                            0,
+                                            nullptr};
+  if (use_secondaries)
+  {
+    const VkCommandBufferInheritanceInfo inheritance_info = {
+        VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO,
+        nullptr,
+        m_current_render_pass,
+        0,
+        m_framebuffer->GetFB(),
+        VK_FALSE,
+        0,
+        0};
+
+    // Split into contiguous ranges so every secondary buffer keeps submission order.
+    const size_t draws_per_secondary = (draws.size() + num_secondaries - 1) / num_secondaries;
+    for (size_t i = 1; i < num_secondaries; i++)
+    {
+      m_recording_threads[i - 1]->Push(
+          RecordRequest{secondaries[i], inheritance_info,
+                        draws.subspan(i * draws_per_secondary,
+                                      std::min(draws_per_secondary,
+                                               draws.size() - i * draws_per_secondary))});
+    }
+    RecordSecondaryCommandBuffer(
+        RecordRequest{secondaries[0], inheritance_info, draws.first(draws_per_secondary)});
+    for (size_t i = 1; i < num_secondaries; i++)
+      m_recording_threads[i - 1]->WaitForCompletion();
+
+    vkCmdBeginRenderPass(command_buffer, &begin_info,
+                         VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+    vkCmdExecuteCommands(command_buffer, static_cast<u32>(num_secondaries), secondaries.data());
+  }
+  else
+  {
+    vkCmdBeginRenderPass(command_buffer, &begin_info, VK_SUBPASS_CONTENTS_INLINE);
+    RecordDeferredDraws(command_buffer, draws);
+  }
+  vkCmdEndRenderPass(command_buffer);
+
+  m_deferred_draws.clear();
+  m_current_render_pass = VK_NULL_HANDLE;
+
+  // Nothing was bound to the primary command buffer, and executing secondary command buffers
+  // leaves its state undefined anyway.
+  m_dirty_flags |= DIRTY_FLAG_PIPELINE | DIRTY_FLAG_VIEWPORT | DIRTY_FLAG_SCISSOR |
+                   DIRTY_FLAG_DESCRIPTOR_SETS;
+  if (m_vertex_buffer != VK_NULL_HANDLE)
+    m_dirty_flags |= DIRTY_FLAG_VERTEX_BUFFER;
+  if (m_index_buffer != VK_NULL_HANDLE)
+    m_dirty_flags |= DIRTY_FLAG_INDEX_BUFFER;
+}
+
+void StateTracker::DeferDraw(bool indexed, u32 count, u32 first, s32 vertex_offset)
+{
+  const bool needs_vertex_buffer = !g_ActiveConfig.backend_info.bSupportsDynamicVertexLoader ||
+                                   m_pipeline->GetUsage() != AbstractPipelineUsage::GXUber;
+
+  DeferredDraw& draw = m_deferred_draws.emplace_back(m_deferred_draw_state);
+  draw.pipeline = m_pipeline->GetVkPipeline();
+  draw.pipeline_layout = m_pipeline->GetVkPipelineLayout();
+  draw.vertex_buffer = needs_vertex_buffer ? m_vertex_buffer : VK_NULL_HANDLE;
+  draw.vertex_buffer_offset = m_vertex_buffer_offset;
+  draw.index_buffer = m_index_buffer;
+  draw.index_buffer_offset = m_index_buffer_offset;
+  draw.index_type = m_index_type;
+  draw.viewport = m_viewport;
+  draw.scissor = m_scissor;
+  draw.indexed = indexed;
+  draw.count = count;
+  draw.first = first;
+  draw.vertex_offset = vertex_offset;
+}
+
+// May run on any recording thread, so only touches the command buffer and the draws.
+void StateTracker::RecordDeferredDraws(VkCommandBuffer command_buffer,
+                                       std::span<const DeferredDraw> draws)
+{
+  const DeferredDraw* last = nullptr;
+  for (const DeferredDraw& draw : draws)
+  {
+    if (!last || last->pipeline != draw.pipeline)
+      vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, draw.pipeline);
+
+    if (draw.vertex_buffer != VK_NULL_HANDLE &&
+        (!last || last->vertex_buffer != draw.vertex_buffer ||
+         last->vertex_buffer_offset != draw.vertex_buffer_offset))
+    {
+      vkCmdBindVertexBuffers(command_buffer, 0, 1, &draw.vertex_buffer,
+                             &draw.vertex_buffer_offset);
+    }
+
+    if (draw.indexed && (!last || last->index_buffer != draw.index_buffer ||
+                         last->index_buffer_offset != draw.index_buffer_offset ||
+                         last->index_type != draw.index_type))
+    {
+      vkCmdBindIndexBuffer(command_buffer, draw.index_buffer, draw.index_buffer_offset,
+                           draw.index_type);
+    }
+
+    if (!last || memcmp(&last->viewport, &draw.viewport, sizeof(draw.viewport)) != 0)
+      vkCmdSetViewport(command_buffer, 0, 1, &draw.viewport);
+
+    if (!last || memcmp(&last->scissor, &draw.scissor, sizeof(draw.scissor)) != 0)
+      vkCmdSetScissor(command_buffer, 0, 1, &draw.scissor);
+
+    if (!last || last->pipeline_layout != draw.pipeline_layout ||
+        last->num_descriptor_sets != draw.num_descriptor_sets ||
+        last->num_dynamic_offsets != draw.num_dynamic_offsets ||
+        !std::equal(draw.descriptor_sets.begin(),
+                    draw.descriptor_sets.begin() + draw.num_descriptor_sets,
+                    last->descriptor_sets.begin()) ||
+        !std::equal(draw.dynamic_offsets.begin(),
+                    draw.dynamic_offsets.begin() + draw.num_dynamic_offsets,
+                    last->dynamic_offsets.begin()))
+    {
+      vkCmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
+                              draw.pipeline_layout, 0, draw.num_descriptor_sets,
+                              draw.descriptor_sets.data(), draw.num_dynamic_offsets,
+                              draw.dynamic_offsets.data());
+    }
+
+    if (draw.indexed)
+      vkCmdDrawIndexed(command_buffer, draw.count, 1, draw.first, draw.vertex_offset, 0);
+    else
+      vkCmdDraw(command_buffer, draw.count, 1, draw.first, 0);
+
+    last = &draw;
+  }
+}
+
+void StateTracker::RecordSecondaryCommandBuffer(const RecordRequest& request)
+{
+  const VkCommandBufferBeginInfo begin_info = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO, nullptr,
+                                               VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT |
+                                                   VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT,
+                                               &request.inheritance_info};
+  VkResult res = vkBeginCommandBuffer(request.command_buffer, &begin_info);
+  if (res != VK_SUCCESS)
+    LOG_VULKAN_ERROR(res, "vkBeginCommandBuffer failed: ");
+
+  RecordDeferredDraws(request.command_buffer, request.draws);
+
+  res = vkEndCommandBuffer(request.command_buffer);
+  if (res != VK_SUCCESS)
+    LOG_VULKAN_ERROR(res, "vkEndCommandBuffer failed: ");
+}
 }  // namespace Vulkan
@@ -6,8 +6,11 @@
 #include <array>
 #include <cstddef>
 #include <memory>
+#include <span>
+#include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Common/WorkQueueThread.h"
 #include "VideoBackends/Vulkan/Constants.h"
 #include "VideoCommon/Constants.h"
 
@@ -70,6 +73,11 @@ public:
   // If this returns false, you should not issue the draw.
   bool Bind();
 
+  // Issues a draw with the state from the last Bind(). With parallel command recording, draws in
+  // a render pass that Bind() started are only recorded when the pass ends.
+  void Draw(u32 num_vertices, u32 base_vertex);
+  void DrawIndexed(u32 base_index, u32 num_indices, u32 base_vertex);
+
   // Binds all dirty compute state to the command buffer.
   // If this returns false, you should not dispatch the shader.
   bool BindCompute();
@@ -110,8 +118,47 @@ private:
                                  DIRTY_FLAG_UTILITY_BINDINGS | DIRTY_FLAG_COMPUTE_BINDINGS
   };
 
+  // Everything needed to record a draw into any command buffer on its own.
+  struct DeferredDraw
+  {
+    VkPipeline pipeline;
+    VkPipelineLayout pipeline_layout;
+    VkBuffer vertex_buffer;
+    VkDeviceSize vertex_buffer_offset;
+    VkBuffer index_buffer;
+    VkDeviceSize index_buffer_offset;
+    VkIndexType index_type;
+    VkViewport viewport;
+    VkRect2D scissor;
+    std::array<VkDescriptorSet, NUM_GX_DESCRIPTOR_SETS> descriptor_sets;
+    u32 num_descriptor_sets;
+    std::array<u32, NUM_UBO_DESCRIPTOR_SET_BINDINGS> dynamic_offsets;
+    u32 num_dynamic_offsets;
+    bool indexed;
+    u32 count;
+    u32 first;
+    s32 vertex_offset;
+  };
+
+  struct RecordRequest
+  {
+    VkCommandBuffer command_buffer;
+    VkCommandBufferInheritanceInfo inheritance_info;
+    std::span<const DeferredDraw> draws;
+  };
+
+  // Render passes with fewer draws than this are recorded inline on the GPU thread.
+  static constexpr size_t MIN_DRAWS_PER_SECONDARY_COMMAND_BUFFER = 64;
+
   bool Initialize();
 
+  void BeginDeferredRenderPass();
+  void EndDeferredRenderPass();
+  void DeferDraw(bool indexed, u32 count, u32 first, s32 vertex_offset);
+  static void RecordDeferredDraws(VkCommandBuffer command_buffer,
+                                  std::span<const DeferredDraw> draws);
+  static void RecordSecondaryCommandBuffer(const RecordRequest& request);
+
   // Check that the specified viewport is within the render area.
   // If not, ends the render pass if it is a clear render pass.
   bool IsViewportWithinRenderArea() const;
@@ -163,5 +210,14 @@ private:
   VKFramebuffer* m_framebuffer = nullptr;
   VkRenderPass m_current_render_pass = VK_NULL_HANDLE;
   VkRect2D m_framebuffer_render_area = {};
+
+  // Parallel command recording. The descriptor sets bound by the last Bind() are kept in
+  // m_deferred_draw_state, as nothing is bound to the command buffer itself.
+  bool m_deferring_draws = false;
+  DeferredDraw m_deferred_draw_state = {};
+  std::vector<DeferredDraw> m_deferred_draws;
+  std::array<std::unique_ptr<Common::WorkQueueThread<RecordRequest>>,
+             NUM_COMMAND_RECORDING_THREADS - 1>
+      m_recording_threads;
 };
 }  // namespace Vulkan
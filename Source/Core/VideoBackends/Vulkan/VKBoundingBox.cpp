@@ -38,6 +38,47 @@ bool VKBoundingBox::Initialize()
 }
 
 std::vector<BBoxType> VKBoundingBox::Read(u32 index, u32 length)
+{
+  CopyToReadbackBuffer();
+
+  // Wait until these commands complete.
+  VKGfx::GetInstance()->ExecuteCommandBuffer(false, true);
+
+  // Cache is now valid.
+  m_readback_buffer->InvalidateCPUCache();
+
+  // Read out the values and return
+  std::vector<BBoxType> values(length);
+  m_readback_buffer->Read(index * sizeof(BBoxType), values.data(), length * sizeof(BBoxType),
+                          false);
+  return values;
+}
+
+bool VKBoundingBox::QueueRead()
+{
+  CopyToReadbackBuffer();
+  m_readback_fence_counter = g_command_buffer_mgr->GetCurrentFenceCounter();
+
+  // Kick the command buffer so the copy executes while the CPU carries on.
+  VKGfx::GetInstance()->ExecuteCommandBuffer(true, false);
+  return true;
+}
+
+std::vector<BBoxType> VKBoundingBox::ReadQueued()
+{
+  if (m_readback_fence_counter == g_command_buffer_mgr->GetCurrentFenceCounter())
+    VKGfx::GetInstance()->ExecuteCommandBuffer(false, true);
+  else
+    g_command_buffer_mgr->WaitForFenceCounter(m_readback_fence_counter);
+
+  m_readback_buffer->InvalidateCPUCache();
+
+  std::vector<BBoxType> values(NUM_BBOX_VALUES);
+  m_readback_buffer->Read(0, values.data(), BUFFER_SIZE, false);
+  return values;
+}
+
+void VKBoundingBox::CopyToReadbackBuffer()
 {
   // Can't be done within a render pass.
   StateTracker::GetInstance()->EndRenderPass();
@@ -63,18 +104,6 @@ std::vector<BBoxType> VKBoundingBox::Read(u32 index, u32 length)
       VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
   m_readback_buffer->FlushGPUCache(g_command_buffer_mgr->GetCurrentCommandBuffer(),
                                    VK_ACCESS_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT);
-
-  // Wait until these commands complete.
-  VKGfx::GetInstance()->ExecuteCommandBuffer(false, true);
-
-  // Cache is now valid.
-  m_readback_buffer->InvalidateCPUCache();
-
-  // Read out the values and return
-  std::vector<BBoxType> values(length);
-  m_readback_buffer->Read(index * sizeof(BBoxType), values.data(), length * sizeof(BBoxType),
-                          false);
-  return values;
 }
 
 void VKBoundingBox::Write(u32 index, std::span<const BBoxType> values)
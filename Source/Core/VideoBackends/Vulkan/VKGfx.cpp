@@ -24,6 +24,7 @@
 #include "VideoBackends/Vulkan/VKSwapChain.h"
 #include "VideoBackends/Vulkan/VKTexture.h"
 #include "VideoBackends/Vulkan/VKVertexFormat.h"
+#include "VideoBackends/Vulkan/VulkanContext.h"
 
 #include "VideoCommon/DriverDetails.h"
 #include "VideoCommon/FramebufferManager.h"
@@ -40,12 +41,18 @@ VKGfx::VKGfx(std::unique_ptr<SwapChain> swap_chain, float backbuffer_scale)
   for (SamplerState& sampler_state : m_sampler_states)
     sampler_state = RenderState::GetPointSamplerState();
 
+  CreateTimestampQueryPool();
+
   // Various initialization routines will have executed commands on the command buffer.
   // Execute what we have done before beginning the first frame.
   ExecuteCommandBuffer(true, false);
 }
 
-VKGfx::~VKGfx() = default;
+VKGfx::~VKGfx()
+{
+  if (m_timestamp_query_pool != VK_NULL_HANDLE)
+    vkDestroyQueryPool(g_vulkan_context->GetDevice(), m_timestamp_query_pool, nullptr);
+}
 
 bool VKGfx::IsHeadless() const
 {
@@ -221,6 +228,63 @@ void VKGfx::WaitForGPUIdle()
   ExecuteCommandBuffer(false, true);
 }
 
+void VKGfx::CreateTimestampQueryPool()
+{
+  if (!g_vulkan_context->GetDeviceLimits().timestampComputeAndGraphics ||
+      g_vulkan_context->GetGraphicsQueueProperties().timestampValidBits == 0)
+  {
+    return;
+  }
+
+  const VkQueryPoolCreateInfo info = {
+      VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO,  // VkStructureType                  sType
+      nullptr,                                   // const void*                      pNext
+      0,                                         // VkQueryPoolCreateFlags           flags
+      VK_QUERY_TYPE_TIMESTAMP,                   // VkQueryType                      queryType
+      MAX_TIMESTAMP_QUERIES,                     // uint32_t                         queryCount
+      0  // VkQueryPipelineStatisticFlags    pipelineStatistics;
+  };
+
+  VkResult res =
+      vkCreateQueryPool(g_vulkan_context->GetDevice(), &info, nullptr, &m_timestamp_query_pool);
+  if (res != VK_SUCCESS)
+  {
+    LOG_VULKAN_ERROR(res, "vkCreateQueryPool failed: ");
+    m_timestamp_query_pool = VK_NULL_HANDLE;
+    return;
+  }
+
+  m_timestamp_query_fences.resize(MAX_TIMESTAMP_QUERIES, 0);
+}
+
+void VKGfx::WriteTimestampQuery(u32 index)
+{
+  // The init command buffer is submitted ahead of the draw command buffer, so the reset is
+  // ordered before the write without having to end the current render pass.
+  vkCmdResetQueryPool(g_command_buffer_mgr->GetCurrentInitCommandBuffer(), m_timestamp_query_pool,
+                      index, 1);
+  vkCmdWriteTimestamp(g_command_buffer_mgr->GetCurrentCommandBuffer(),
+                      VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, m_timestamp_query_pool, index);
+  m_timestamp_query_fences[index] = g_command_buffer_mgr->GetCurrentFenceCounter();
+}
+
+std::optional<u64> VKGfx::GetTimestampQueryResult(u32 index)
+{
+  if (m_timestamp_query_fences[index] > g_command_buffer_mgr->GetCompletedFenceCounter())
+    return std::nullopt;
+
+  u64 timestamp = 0;
+  VkResult res = vkGetQueryPoolResults(g_vulkan_context->GetDevice(), m_timestamp_query_pool,
+                                       index, 1, sizeof(timestamp), &timestamp, sizeof(timestamp),
+                                       VK_QUERY_RESULT_64_BIT);
+  if (res != VK_SUCCESS)
+    return std::nullopt;
+
+  // Convert from ticks to nanoseconds, like the other backends report.
+  return static_cast<u64>(static_cast<double>(timestamp) *
+                          g_vulkan_context->GetDeviceLimits().timestampPeriod);
+}
+
 void VKGfx::BindBackbuffer(const ClearColor& clear_color)
 {
   StateTracker::GetInstance()->EndRenderPass();
@@ -580,7 +644,7 @@ void VKGfx::Draw(u32 base_vertex, u32 num_vertices)
   if (!StateTracker::GetInstance()->Bind())
     return;
 
-  vkCmdDraw(g_command_buffer_mgr->GetCurrentCommandBuffer(), num_vertices, 1, base_vertex, 0);
+  StateTracker::GetInstance()->Draw(num_vertices, base_vertex);
 }
 
 void VKGfx::DrawIndexed(u32 base_index, u32 num_indices, u32 base_vertex)
@@ -588,8 +652,7 @@ void VKGfx::DrawIndexed(u32 base_index, u32 num_indices, u32 base_vertex)
   if (!StateTracker::GetInstance()->Bind())
     return;
 
-  vkCmdDrawIndexed(g_command_buffer_mgr->GetCurrentCommandBuffer(), num_indices, 1, base_index,
-                   base_vertex, 0);
+  StateTracker::GetInstance()->DrawIndexed(base_index, num_indices, base_vertex);
 }
 
 void VKGfx::DispatchComputeShader(const AbstractShader* shader, u32 groupsize_x, u32 groupsize_y,
@@ -5,7 +5,9 @@
 
 #include <array>
 #include <memory>
+#include <optional>
 #include <string_view>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "VideoBackends/Vulkan/Constants.h"
@@ -55,6 +57,13 @@ public:
   void WaitForGPUIdle() override;
   void OnConfigChanged(u32 bits) override;
 
+  bool SupportsTimestampQueries() const override
+  {
+    return m_timestamp_query_pool != VK_NULL_HANDLE;
+  }
+  void WriteTimestampQuery(u32 index) override;
+  std::optional<u64> GetTimestampQueryResult(u32 index) override;
+
   void ClearRegion(const MathUtil::Rectangle<int>& target_rc, bool color_enable, bool alpha_enable,
                    bool z_enable, u32 color, u32 z) override;
 
@@ -94,10 +103,17 @@ private:
   void OnSwapChainResized();
   void BindFramebuffer(VKFramebuffer* fb);
 
+  void CreateTimestampQueryPool();
+
   std::unique_ptr<SwapChain> m_swap_chain;
   float m_backbuffer_scale;
 
   // Keep a copy of sampler states to avoid cache lookups every draw
   std::array<SamplerState, VideoCommon::MAX_PIXEL_SHADER_SAMPLERS> m_sampler_states = {};
+
+  VkQueryPool m_timestamp_query_pool = VK_NULL_HANDLE;
+
+  // Fence counter of the command buffer each timestamp query was last written in
+  std::vector<u64> m_timestamp_query_fences;
 };
 }  // namespace Vulkan
@@ -3,7 +3,9 @@
 
 #include "VideoBackends/Vulkan/VKPipeline.h"
 
+#include <algorithm>
 #include <array>
+#include <vector>
 
 #include "Common/Assert.h"
 #include "Common/EnumMap.h"
@@ -240,6 +242,132 @@ GetVulkanColorBlendState(const BlendingState& state,
   return vk_state;
 }
 
+static VkPipeline CreatePipelineLibrary(VkGraphicsPipelineLibraryFlagsEXT flags,
+                                        VkGraphicsPipelineCreateInfo* library_info)
+{
+  VkGraphicsPipelineLibraryCreateInfoEXT library_create_info = {
+      VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_LIBRARY_CREATE_INFO_EXT, nullptr, flags};
+  library_info->sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+  library_info->pNext = &library_create_info;
+  library_info->flags = VK_PIPELINE_CREATE_LIBRARY_BIT_KHR;
+  library_info->basePipelineIndex = -1;
+
+  VkPipeline library;
+  VkResult res =
+      vkCreateGraphicsPipelines(g_vulkan_context->GetDevice(), g_object_cache->GetPipelineCache(),
+                                1, library_info, nullptr, &library);
+  if (res != VK_SUCCESS)
+  {
+    LOG_VULKAN_ERROR(res, "vkCreateGraphicsPipelines (library) failed: ");
+    return VK_NULL_HANDLE;
+  }
+
+  return library;
+}
+
+// Splits a pipeline into the four stage groups of VK_EXT_graphics_pipeline_library, and links it
+// from cached libraries. Pipelines which only differ in e.g. blend state then reuse the compiled
+// shader stages, and only pay for the (fast) link instead of a full compile.
+static VkPipeline LinkPipelineLibraries(const AbstractPipelineConfig& config,
+                                        const VkGraphicsPipelineCreateInfo& info)
+{
+  const auto get_module = [](const AbstractShader* shader) {
+    return shader ? static_cast<const VKShader*>(shader)->GetShaderModule() : VK_NULL_HANDLE;
+  };
+  const auto get_stages = [&info](VkShaderStageFlags stages) {
+    std::vector<VkPipelineShaderStageCreateInfo> result;
+    for (u32 i = 0; i < info.stageCount; i++)
+    {
+      if (info.pStages[i].stage & stages)
+        result.push_back(info.pStages[i]);
+    }
+    return result;
+  };
+
+  std::array<VkPipeline, 4> libraries;
+  libraries[0] = g_object_cache->GetVertexInputLibrary(
+      {config.vertex_format != nullptr,
+       config.vertex_format ? config.vertex_format->GetVertexDeclaration() :
+                              PortableVertexDeclaration{},
+       info.pInputAssemblyState->topology, info.pInputAssemblyState->primitiveRestartEnable},
+      [&info] {
+        VkGraphicsPipelineCreateInfo library_info = {};
+        library_info.pVertexInputState = info.pVertexInputState;
+        library_info.pInputAssemblyState = info.pInputAssemblyState;
+        return CreatePipelineLibrary(VK_GRAPHICS_PIPELINE_LIBRARY_VERTEX_INPUT_INTERFACE_BIT_EXT,
+                                     &library_info);
+      });
+
+  libraries[1] = g_object_cache->GetPreRasterizationLibrary(
+      {get_module(config.vertex_shader), get_module(config.geometry_shader),
+       config.rasterization_state.hex, info.layout, info.renderPass},
+      [&info, &get_stages] {
+        const auto stages = get_stages(VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_GEOMETRY_BIT);
+        VkGraphicsPipelineCreateInfo library_info = {};
+        library_info.stageCount = static_cast<u32>(stages.size());
+        library_info.pStages = stages.data();
+        library_info.pViewportState = info.pViewportState;
+        library_info.pRasterizationState = info.pRasterizationState;
+        library_info.pDynamicState = info.pDynamicState;
+        library_info.layout = info.layout;
+        library_info.renderPass = info.renderPass;
+        return CreatePipelineLibrary(VK_GRAPHICS_PIPELINE_LIBRARY_PRE_RASTERIZATION_SHADERS_BIT_EXT,
+                                     &library_info);
+      });
+
+  libraries[2] = g_object_cache->GetFragmentShaderLibrary(
+      {get_module(config.pixel_shader), config.depth_state.hex, config.framebuffer_state.hex,
+       info.layout, info.renderPass},
+      [&info, &get_stages] {
+        const auto stages = get_stages(VK_SHADER_STAGE_FRAGMENT_BIT);
+        VkGraphicsPipelineCreateInfo library_info = {};
+        library_info.stageCount = static_cast<u32>(stages.size());
+        library_info.pStages = stages.data();
+        library_info.pMultisampleState = info.pMultisampleState;
+        library_info.pDepthStencilState = info.pDepthStencilState;
+        library_info.layout = info.layout;
+        library_info.renderPass = info.renderPass;
+        return CreatePipelineLibrary(VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_SHADER_BIT_EXT,
+                                     &library_info);
+      });
+
+  libraries[3] = g_object_cache->GetFragmentOutputLibrary(
+      {config.blending_state.hex, config.framebuffer_state.hex, config.usage, info.renderPass},
+      [&info] {
+        VkGraphicsPipelineCreateInfo library_info = {};
+        library_info.pMultisampleState = info.pMultisampleState;
+        library_info.pColorBlendState = info.pColorBlendState;
+        library_info.renderPass = info.renderPass;
+        return CreatePipelineLibrary(VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_OUTPUT_INTERFACE_BIT_EXT,
+                                     &library_info);
+      });
+
+  if (std::find(libraries.begin(), libraries.end(), VK_NULL_HANDLE) != libraries.end())
+    return VK_NULL_HANDLE;
+
+  // No link-time optimization, we want the link to be as fast as possible.
+  VkPipelineLibraryCreateInfoKHR link_info = {VK_STRUCTURE_TYPE_PIPELINE_LIBRARY_CREATE_INFO_KHR,
+                                              nullptr, static_cast<u32>(libraries.size()),
+                                              libraries.data()};
+  VkGraphicsPipelineCreateInfo linked_info = {};
+  linked_info.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+  linked_info.pNext = &link_info;
+  linked_info.layout = info.layout;
+  linked_info.basePipelineIndex = -1;
+
+  VkPipeline pipeline;
+  VkResult res =
+      vkCreateGraphicsPipelines(g_vulkan_context->GetDevice(), g_object_cache->GetPipelineCache(),
+                                1, &linked_info, nullptr, &pipeline);
+  if (res != VK_SUCCESS)
+  {
+    LOG_VULKAN_ERROR(res, "vkCreateGraphicsPipelines (link) failed: ");
+    return VK_NULL_HANDLE;
+  }
+
+  return pipeline;
+}
+
 std::unique_ptr<VKPipeline> VKPipeline::Create(const AbstractPipelineConfig& config)
 {
   DEBUG_ASSERT(config.vertex_shader && config.pixel_shader);
@@ -416,14 +544,20 @@ std::unique_ptr<VKPipeline> VKPipeline::Create(const AbstractPipelineConfig& con
       -1                     // int32_t                                          basePipelineIndex
   };
 
-  VkPipeline pipeline;
-  VkResult res =
-      vkCreateGraphicsPipelines(g_vulkan_context->GetDevice(), g_object_cache->GetPipelineCache(),
-                                1, &pipeline_info, nullptr, &pipeline);
-  if (res != VK_SUCCESS)
+  // Try linking from pipeline libraries first, falling back to a full compile if that fails.
+  VkPipeline pipeline = VK_NULL_HANDLE;
+  if (g_vulkan_context->SupportsGraphicsPipelineLibrary())
+    pipeline = LinkPipelineLibraries(config, pipeline_info);
+  if (pipeline == VK_NULL_HANDLE)
   {
-    LOG_VULKAN_ERROR(res, "vkCreateGraphicsPipelines failed: ");
-    return VK_NULL_HANDLE;
+    VkResult res =
+        vkCreateGraphicsPipelines(g_vulkan_context->GetDevice(), g_object_cache->GetPipelineCache(),
+                                  1, &pipeline_info, nullptr, &pipeline);
+    if (res != VK_SUCCESS)
+    {
+      LOG_VULKAN_ERROR(res, "vkCreateGraphicsPipelines failed: ");
+      return VK_NULL_HANDLE;
+    }
   }
 
   return std::make_unique<VKPipeline>(config, pipeline, pipeline_layout, config.usage);
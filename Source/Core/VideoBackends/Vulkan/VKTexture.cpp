@@ -1009,6 +1009,16 @@ void VKStagingTexture::Flush()
   m_needs_flush = false;
 }
 
+bool VKStagingTexture::IsCopyComplete() const
+{
+  if (!m_needs_flush)
+    return true;
+
+  // The copy can't have completed if its command buffer hasn't been submitted yet.
+  return g_command_buffer_mgr->GetCurrentFenceCounter() != m_flush_fence_counter &&
+         g_command_buffer_mgr->GetCompletedFenceCounter() >= m_flush_fence_counter;
+}
+
 VKFramebuffer::VKFramebuffer(VKTexture* color_attachment, VKTexture* depth_attachment,
                              std::vector<AbstractTexture*> additional_color_attachments, u32 width,
                              u32 height, u32 layers, u32 samples, VkFramebuffer fb,
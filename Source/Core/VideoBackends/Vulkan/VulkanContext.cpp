@@ -596,6 +596,10 @@ bool VulkanContext::SelectDeviceExtensions(bool enable_surface)
   AddExtension(VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME, false);
   AddExtension(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME, false);
 
+  // VK_EXT_graphics_pipeline_library depends on VK_KHR_pipeline_library.
+  if (AddExtension(VK_KHR_PIPELINE_LIBRARY_EXTENSION_NAME, false))
+    AddExtension(VK_EXT_GRAPHICS_PIPELINE_LIBRARY_EXTENSION_NAME, false);
+
   return true;
 }
 
@@ -755,6 +759,17 @@ bool VulkanContext::CreateDevice(VkSurfaceKHR surface, bool enable_validation_la
 
   device_info.pEnabledFeatures = &m_device_features;
 
+  // Pipeline libraries are an extension feature, so they have to be chained in separately.
+  PopulateGraphicsPipelineLibrarySupport();
+  VkPhysicalDeviceGraphicsPipelineLibraryFeaturesEXT pipeline_library_features = {};
+  pipeline_library_features.sType =
+      VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_GRAPHICS_PIPELINE_LIBRARY_FEATURES_EXT;
+  if (m_supports_graphics_pipeline_library)
+  {
+    pipeline_library_features.graphicsPipelineLibrary = VK_TRUE;
+    device_info.pNext = &pipeline_library_features;
+  }
+
   // Enable debug layer on debug builds
   if (enable_validation_layer)
   {
@@ -1003,6 +1018,41 @@ void VulkanContext::PopulateShaderSubgroupSupport()
       subgroup_properties.supportedStages & VK_SHADER_STAGE_FRAGMENT_BIT;
 }
 
+void VulkanContext::PopulateGraphicsPipelineLibrarySupport()
+{
+  m_supports_graphics_pipeline_library = false;
+  if (!SupportsDeviceExtension(VK_EXT_GRAPHICS_PIPELINE_LIBRARY_EXTENSION_NAME) ||
+      !vkGetPhysicalDeviceFeatures2 || !vkGetPhysicalDeviceProperties2 ||
+      (VK_VERSION_MAJOR(m_device_properties.apiVersion) == 1 &&
+       VK_VERSION_MINOR(m_device_properties.apiVersion) < 1))
+  {
+    return;
+  }
+
+  VkPhysicalDeviceGraphicsPipelineLibraryFeaturesEXT library_features = {};
+  library_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_GRAPHICS_PIPELINE_LIBRARY_FEATURES_EXT;
+  VkPhysicalDeviceFeatures2 features_2 = {};
+  features_2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+  features_2.pNext = &library_features;
+  vkGetPhysicalDeviceFeatures2(m_physical_device, &features_2);
+
+  VkPhysicalDeviceGraphicsPipelineLibraryPropertiesEXT library_properties = {};
+  library_properties.sType =
+      VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_GRAPHICS_PIPELINE_LIBRARY_PROPERTIES_EXT;
+  VkPhysicalDeviceProperties2 properties_2 = {};
+  properties_2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+  properties_2.pNext = &library_properties;
+  vkGetPhysicalDeviceProperties2(m_physical_device, &properties_2);
+
+  // Linking without link-time optimization is only worthwhile if the driver can do it quickly,
+  // otherwise we are better off compiling the whole pipeline in one go.
+  m_supports_graphics_pipeline_library =
+      library_features.graphicsPipelineLibrary == VK_TRUE &&
+      library_properties.graphicsPipelineLibraryFastLinking == VK_TRUE;
+  if (m_supports_graphics_pipeline_library)
+    INFO_LOG_FMT(VIDEO, "Using VK_EXT_graphics_pipeline_library for pipeline creation.");
+}
+
 bool VulkanContext::SupportsExclusiveFullscreen(const WindowSystemInfo& wsi, VkSurfaceKHR surface)
 {
 #ifdef SUPPORTS_VULKAN_EXCLUSIVE_FULLSCREEN
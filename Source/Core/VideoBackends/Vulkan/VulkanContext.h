@@ -83,6 +83,7 @@ public:
   }
   u32 GetShaderSubgroupSize() const { return m_shader_subgroup_size; }
   bool SupportsShaderSubgroupOperations() const { return m_supports_shader_subgroup_operations; }
+  bool SupportsGraphicsPipelineLibrary() const { return m_supports_graphics_pipeline_library; }
 
   // Helpers for getting constants
   VkDeviceSize GetUniformBufferAlignment() const
@@ -122,6 +123,7 @@ private:
   bool CreateDevice(VkSurfaceKHR surface, bool enable_validation_layer);
   void InitDriverDetails();
   void PopulateShaderSubgroupSupport();
+  void PopulateGraphicsPipelineLibrarySupport();
   bool CreateAllocator(u32 vk_api_version);
 
   VkInstance m_instance = VK_NULL_HANDLE;
@@ -143,6 +145,7 @@ private:
 
   u32 m_shader_subgroup_size = 1;
   bool m_supports_shader_subgroup_operations = false;
+  bool m_supports_graphics_pipeline_library = false;
 
   std::vector<std::string> m_device_extensions;
 };
@@ -10,6 +10,7 @@
 
 #include <array>
 #include <memory>
+#include <optional>
 #include <vector>
 
 class AbstractFramebuffer;
@@ -143,6 +144,15 @@ public:
   virtual void Flush() {}
   virtual void WaitForGPUIdle() {}
 
+  // GPU timestamp queries, used by GPUTiming. Indices are in [0, MAX_TIMESTAMP_QUERIES), and a
+  // query is only written again after its previous result has been read.
+  static constexpr u32 MAX_TIMESTAMP_QUERIES = 2048;
+  virtual bool SupportsTimestampQueries() const { return false; }
+  // Records the time at which the GPU has finished all previously submitted commands.
+  virtual void WriteTimestampQuery(u32 index) {}
+  // Returns the recorded time in nanoseconds, or nullopt if the GPU has not reached the query yet.
+  virtual std::optional<u64> GetTimestampQueryResult(u32 index) { return std::nullopt; }
+
   // For opengl's glDrawBuffer
   virtual void SelectLeftBuffer() {}
   virtual void SelectRightBuffer() {}
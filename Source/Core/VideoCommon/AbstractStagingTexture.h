@@ -67,6 +67,10 @@ public:
   // call to CopyFromTexture()/CopyToTexture() and the Flush() call.
   virtual void Flush() = 0;
 
+  // Returns true if the GPU has finished the last copy, so that Flush() will not stall. This never
+  // submits work itself, so it may report the copy as incomplete when it has actually finished.
+  virtual bool IsCopyComplete() const { return !m_needs_flush; }
+
   // Reads the specified rectangle from the staging texture to out_ptr, with the specified stride
   // (length in bytes of each row). CopyFromTexture must be called first. The contents of any
   // texels outside of the rectangle used for CopyFromTexture is undefined.
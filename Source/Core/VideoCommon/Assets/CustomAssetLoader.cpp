@@ -3,7 +3,11 @@
 
 #include "VideoCommon/Assets/CustomAssetLoader.h"
 
+#include <algorithm>
+
+#include "Common/MemoryAccounting.h"
 #include "Common/MemoryUtil.h"
+#include "Core/Config/GraphicsSettings.h"
 #include "VideoCommon/Assets/CustomAssetLibrary.h"
 
 namespace VideoCommon
@@ -17,6 +21,10 @@ void CustomAssetLoader::Init()
   // keep 2GB memory for system stability if system RAM is 4GB+ - use half of memory in other cases
   m_max_memory_available =
       (sys_mem / 2 < recommended_min_mem) ? (sys_mem / 2) : (sys_mem - recommended_min_mem);
+  if (const int limit_mib = Config::Get(Config::GFX_HIRES_TEXTURE_MEMORY_LIMIT); limit_mib > 0)
+    m_max_memory_available = std::min(m_max_memory_available, size_t(limit_mib) * 1024 * 1024);
+  Common::MemoryAccounting::SetBudget(Common::MemoryAccounting::Subsystem::CustomAssets,
+                                      m_max_memory_available);
 
   m_asset_monitor_thread = std::thread([this]() {
     Common::SetCurrentThreadName("Asset monitor");
@@ -48,13 +56,23 @@ void CustomAssetLoader::Init()
     if (auto ptr = asset.lock())
     {
       if (m_memory_exceeded)
-        return;
+      {
+        // Try again once enough assets have been released
+        std::lock_guard lk(m_asset_load_lock);
+        if (m_memory_exceeded)
+        {
+          m_deferred_assets.push_back(ptr);
+          return;
+        }
+      }
 
       if (ptr->Load())
       {
         std::lock_guard lk(m_asset_load_lock);
         const std::size_t asset_memory_size = ptr->GetByteSizeInMemory();
         m_total_bytes_loaded += asset_memory_size;
+        Common::MemoryAccounting::Set(Common::MemoryAccounting::Subsystem::CustomAssets,
+                                      m_total_bytes_loaded);
         m_assets_to_monitor.try_emplace(ptr->GetAssetId(), ptr);
         if (m_total_bytes_loaded > m_max_memory_available)
         {
@@ -76,7 +94,19 @@ void CustomAssetLoader ::Shutdown()
   m_asset_monitor_thread_shutdown.Set();
   m_asset_monitor_thread.join();
   m_assets_to_monitor.clear();
+  m_deferred_assets.clear();
   m_total_bytes_loaded = 0;
+  Common::MemoryAccounting::Set(Common::MemoryAccounting::Subsystem::CustomAssets, 0);
+}
+
+void CustomAssetLoader::QueueDeferredAssets()
+{
+  for (auto& asset : m_deferred_assets)
+  {
+    if (!asset.expired())
+      m_asset_load_thread.Push(std::move(asset));
+  }
+  m_deferred_assets.clear();
 }
 
 std::shared_ptr<GameTextureAsset>
@@ -8,9 +8,11 @@
 #include <memory>
 #include <mutex>
 #include <thread>
+#include <vector>
 
 #include "Common/Flag.h"
 #include "Common/Logging/Log.h"
+#include "Common/MemoryAccounting.h"
 #include "Common/WorkQueueThread.h"
 #include "VideoCommon/Assets/CustomAsset.h"
 #include "VideoCommon/Assets/MaterialAsset.h"
@@ -71,11 +73,14 @@ private:
       {
         std::lock_guard lk(m_asset_load_lock);
         m_total_bytes_loaded -= a->GetByteSizeInMemory();
+        Common::MemoryAccounting::Set(Common::MemoryAccounting::Subsystem::CustomAssets,
+                                      m_total_bytes_loaded);
         m_assets_to_monitor.erase(a->GetAssetId());
         if (m_max_memory_available >= m_total_bytes_loaded && m_memory_exceeded)
         {
           INFO_LOG_FMT(VIDEO, "Asset memory went below limit, new assets can begin loading.");
           m_memory_exceeded = false;
+          QueueDeferredAssets();
         }
       }
       delete a;
@@ -85,6 +90,10 @@ private:
     return ptr;
   }
 
+  // Requeues the assets that were requested while the memory limit was exceeded.
+  // Must be called with 'm_asset_load_lock' held.
+  void QueueDeferredAssets();
+
   static constexpr auto TIME_BETWEEN_ASSET_MONITOR_CHECKS = std::chrono::milliseconds{500};
 
   std::map<CustomAssetLibrary::AssetID, std::weak_ptr<GameTextureAsset>> m_game_textures;
@@ -100,6 +109,9 @@ private:
 
   std::map<CustomAssetLibrary::AssetID, std::weak_ptr<CustomAsset>> m_assets_to_monitor;
 
+  // Assets that were skipped because the memory limit was exceeded
+  std::vector<std::weak_ptr<CustomAsset>> m_deferred_assets;
+
   // Use a recursive mutex to handle the scenario where an asset goes out of scope while
   // iterating over the assets to monitor which calls the lock above in 'LoadOrCreateAsset'
   std::recursive_mutex m_asset_load_lock;
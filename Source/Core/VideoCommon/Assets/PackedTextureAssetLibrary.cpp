@@ -0,0 +1,228 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "VideoCommon/Assets/PackedTextureAssetLibrary.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include "Common/Align.h"
+#include "Common/Logging/Log.h"
+#include "VideoCommon/Assets/TextureAsset.h"
+#include "VideoCommon/RenderState.h"
+
+namespace VideoCommon
+{
+namespace PackedTextureArchive
+{
+bool Writer::Open(const std::string& path)
+{
+  m_textures.clear();
+  if (!m_file.Open(path, "wb"))
+    return false;
+
+  // The header is rewritten once the table offsets are known.
+  const Header header{};
+  return m_file.WriteArray(&header, 1);
+}
+
+bool Writer::AddTexture(std::string name, const CustomTextureData::ArraySlice& slice)
+{
+  if (slice.m_levels.empty() || m_textures.contains(name))
+    return false;
+
+  std::vector<Level> levels;
+  levels.reserve(slice.m_levels.size());
+  for (const auto& level : slice.m_levels)
+  {
+    const u64 offset = Common::AlignUp(m_file.Tell(), PAYLOAD_ALIGNMENT);
+    if (!m_file.Seek(offset, File::SeekOrigin::Begin) ||
+        !m_file.WriteBytes(level.data.data(), level.data.size()))
+    {
+      return false;
+    }
+
+    levels.push_back({offset, level.data.size(), static_cast<u32>(level.format), level.width,
+                      level.height, level.row_length});
+  }
+
+  m_textures.emplace(std::move(name), std::move(levels));
+  return true;
+}
+
+bool Writer::Finish()
+{
+  std::vector<Entry> entries;
+  std::vector<Level> levels;
+  std::string strings;
+  entries.reserve(m_textures.size());
+  for (const auto& [name, texture_levels] : m_textures)
+  {
+    entries.push_back({static_cast<u32>(strings.size()), static_cast<u32>(name.size()),
+                       static_cast<u32>(levels.size()), static_cast<u32>(texture_levels.size())});
+    strings += name;
+    levels.insert(levels.end(), texture_levels.begin(), texture_levels.end());
+  }
+
+  Header header{};
+  header.magic = MAGIC;
+  header.version = VERSION;
+  header.num_entries = static_cast<u32>(entries.size());
+  header.num_levels = static_cast<u32>(levels.size());
+  header.entry_table_offset = Common::AlignUp(m_file.Tell(), PAYLOAD_ALIGNMENT);
+  header.level_table_offset = header.entry_table_offset + entries.size() * sizeof(Entry);
+  header.string_table_offset = header.level_table_offset + levels.size() * sizeof(Level);
+  header.string_table_size = strings.size();
+
+  const bool success = m_file.Seek(header.entry_table_offset, File::SeekOrigin::Begin) &&
+                       m_file.WriteArray(entries.data(), entries.size()) &&
+                       m_file.WriteArray(levels.data(), levels.size()) &&
+                       m_file.WriteBytes(strings.data(), strings.size()) &&
+                       m_file.Seek(0, File::SeekOrigin::Begin) && m_file.WriteArray(&header, 1);
+  m_file.Close();
+  m_textures.clear();
+  return success;
+}
+}  // namespace PackedTextureArchive
+
+bool PackedTextureAssetLibrary::Open(const std::string& path)
+{
+  using namespace PackedTextureArchive;
+
+  std::lock_guard lk(m_lock);
+  m_path = path;
+  m_write_time = std::chrono::system_clock::now();
+  if (!m_file.Open(path, "rb"))
+  {
+    ERROR_LOG_FMT(VIDEO, "Failed to open texture archive '{}'", path);
+    return false;
+  }
+
+  const u64 file_size = m_file.GetSize();
+  Header header;
+  if (!m_file.ReadArray(&header, 1) || header.magic != MAGIC || header.version != VERSION)
+  {
+    ERROR_LOG_FMT(VIDEO, "Texture archive '{}' has an invalid header", path);
+    return false;
+  }
+
+  if (header.entry_table_offset + header.num_entries * sizeof(Entry) > file_size ||
+      header.level_table_offset + header.num_levels * sizeof(Level) > file_size ||
+      header.string_table_offset + header.string_table_size > file_size)
+  {
+    ERROR_LOG_FMT(VIDEO, "Texture archive '{}' is truncated", path);
+    return false;
+  }
+
+  m_entries.resize(header.num_entries);
+  m_levels.resize(header.num_levels);
+  std::string strings(header.string_table_size, '\0');
+  if (!m_file.Seek(header.entry_table_offset, File::SeekOrigin::Begin) ||
+      !m_file.ReadArray(m_entries.data(), m_entries.size()) ||
+      !m_file.Seek(header.level_table_offset, File::SeekOrigin::Begin) ||
+      !m_file.ReadArray(m_levels.data(), m_levels.size()) ||
+      !m_file.Seek(header.string_table_offset, File::SeekOrigin::Begin) ||
+      !m_file.ReadBytes(strings.data(), strings.size()))
+  {
+    ERROR_LOG_FMT(VIDEO, "Failed to read the tables of texture archive '{}'", path);
+    return false;
+  }
+
+  m_names.clear();
+  m_names.reserve(m_entries.size());
+  for (const Entry& entry : m_entries)
+  {
+    const u64 last_level = u64(entry.first_level) + entry.num_levels;
+    if (u64(entry.name_offset) + entry.name_size > strings.size() || last_level > m_levels.size())
+    {
+      ERROR_LOG_FMT(VIDEO, "Texture archive '{}' has an invalid entry", path);
+      m_entries.clear();
+      m_names.clear();
+      return false;
+    }
+    m_names.push_back(strings.substr(entry.name_offset, entry.name_size));
+  }
+
+  return true;
+}
+
+void PackedTextureAssetLibrary::SetAssetIDTexture(const AssetID& asset_id, u32 texture_index)
+{
+  std::lock_guard lk(m_lock);
+  m_assetid_to_entry[asset_id] = texture_index;
+}
+
+CustomAssetLibrary::LoadInfo PackedTextureAssetLibrary::LoadTexture(const AssetID& asset_id,
+                                                                    TextureData* data)
+{
+  std::lock_guard lk(m_lock);
+  const auto iter = m_assetid_to_entry.find(asset_id);
+  if (iter == m_assetid_to_entry.end() || iter->second >= m_entries.size())
+  {
+    ERROR_LOG_FMT(VIDEO, "Asset '{}' error - not found in texture archive '{}'!", asset_id,
+                  m_path);
+    return {};
+  }
+
+  const PackedTextureArchive::Entry& entry = m_entries[iter->second];
+  data->m_sampler = RenderState::GetLinearSamplerState();
+  data->m_type = TextureData::Type::Type_Texture2D;
+  data->m_texture.m_slices.clear();
+  auto& slice = data->m_texture.m_slices.emplace_back();
+
+  std::size_t bytes_loaded = 0;
+  for (u32 i = 0; i < entry.num_levels; i++)
+  {
+    const PackedTextureArchive::Level& level = m_levels[entry.first_level + i];
+    if (level.format >= static_cast<u32>(AbstractTextureFormat::Undefined))
+    {
+      ERROR_LOG_FMT(VIDEO, "Asset '{}' error - invalid format in texture archive!", asset_id);
+      return {};
+    }
+
+    auto& out_level = slice.m_levels.emplace_back();
+    out_level.format = static_cast<AbstractTextureFormat>(level.format);
+    out_level.width = level.width;
+    out_level.height = level.height;
+    out_level.row_length = level.row_length;
+    out_level.data.resize(level.data_size);
+    if (!m_file.Seek(level.data_offset, File::SeekOrigin::Begin) ||
+        !m_file.ReadBytes(out_level.data.data(), out_level.data.size()))
+    {
+      ERROR_LOG_FMT(VIDEO, "Asset '{}' error - failed to read level {} from texture archive!",
+                    asset_id, i);
+      return {};
+    }
+    bytes_loaded += out_level.data.size();
+  }
+
+  return LoadInfo{bytes_loaded, m_write_time};
+}
+
+CustomAssetLibrary::LoadInfo PackedTextureAssetLibrary::LoadPixelShader(const AssetID& asset_id,
+                                                                        PixelShaderData*)
+{
+  ERROR_LOG_FMT(VIDEO, "Asset '{}' error - texture archives only contain textures!", asset_id);
+  return {};
+}
+
+CustomAssetLibrary::LoadInfo PackedTextureAssetLibrary::LoadMaterial(const AssetID& asset_id,
+                                                                     MaterialData*)
+{
+  ERROR_LOG_FMT(VIDEO, "Asset '{}' error - texture archives only contain textures!", asset_id);
+  return {};
+}
+
+CustomAssetLibrary::LoadInfo PackedTextureAssetLibrary::LoadMesh(const AssetID& asset_id,
+                                                                 MeshData*)
+{
+  ERROR_LOG_FMT(VIDEO, "Asset '{}' error - texture archives only contain textures!", asset_id);
+  return {};
+}
+
+CustomAssetLibrary::TimeType
+PackedTextureAssetLibrary::GetLastAssetWriteTime(const AssetID&) const
+{
+  return m_write_time;
+}
+}  // namespace VideoCommon
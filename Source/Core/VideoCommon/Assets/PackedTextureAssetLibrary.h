@@ -0,0 +1,116 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/IOFile.h"
+#include "VideoCommon/Assets/CustomAssetLibrary.h"
+#include "VideoCommon/Assets/CustomTextureData.h"
+
+namespace VideoCommon
+{
+// A texture pack stored in a single file, so that large packs don't require a filesystem lookup
+// for every texture and mip level.
+//
+// On disk format (little endian):
+//   Header
+//   texture level payloads, each aligned to PAYLOAD_ALIGNMENT
+//   Entry[num_entries], sorted by name
+//   Level[num_levels]
+//   string table containing the texture names
+//
+// Payloads are stored exactly as they are uploaded (RGBA8 or a block compressed format), so
+// loading a texture is a single read without any decoding.
+namespace PackedTextureArchive
+{
+constexpr u32 MAGIC = 0x4B505444;  // "DTPK"
+constexpr u32 VERSION = 1;
+constexpr u64 PAYLOAD_ALIGNMENT = 16;
+constexpr const char* FILE_EXTENSION = ".dtp";
+
+struct Header
+{
+  u32 magic;
+  u32 version;
+  u32 num_entries;
+  u32 num_levels;
+  u64 entry_table_offset;
+  u64 level_table_offset;
+  u64 string_table_offset;
+  u64 string_table_size;
+};
+
+struct Entry
+{
+  u32 name_offset;
+  u32 name_size;
+  u32 first_level;
+  u32 num_levels;
+};
+
+struct Level
+{
+  u64 data_offset;
+  u64 data_size;
+  u32 format;
+  u32 width;
+  u32 height;
+  u32 row_length;
+};
+
+static_assert(sizeof(Header) == 48);
+static_assert(sizeof(Entry) == 16);
+static_assert(sizeof(Level) == 32);
+
+// Builds an archive, payloads are written as textures are added.
+class Writer
+{
+public:
+  bool Open(const std::string& path);
+  bool AddTexture(std::string name, const CustomTextureData::ArraySlice& slice);
+  bool Finish();
+
+private:
+  File::IOFile m_file;
+  std::map<std::string, std::vector<Level>> m_textures;
+};
+}  // namespace PackedTextureArchive
+
+// This class implements 'CustomAssetLibrary' and loads raw textures from a packed archive
+class PackedTextureAssetLibrary final : public CustomAssetLibrary
+{
+public:
+  bool Open(const std::string& path);
+
+  // Names of the textures in the archive, as they were named in the original texture pack
+  const std::vector<std::string>& GetTextureNames() const { return m_names; }
+
+  // Assigns the asset id to the texture with the given index in 'GetTextureNames()'
+  void SetAssetIDTexture(const AssetID& asset_id, u32 texture_index);
+
+  LoadInfo LoadTexture(const AssetID& asset_id, TextureData* data) override;
+  LoadInfo LoadPixelShader(const AssetID& asset_id, PixelShaderData* data) override;
+  LoadInfo LoadMaterial(const AssetID& asset_id, MaterialData* data) override;
+  LoadInfo LoadMesh(const AssetID& asset_id, MeshData* data) override;
+
+  // Archives aren't modified while in use, so this is the time the archive was opened
+  TimeType GetLastAssetWriteTime(const AssetID& asset_id) const override;
+
+private:
+  std::string m_path;
+  TimeType m_write_time = {};
+  std::vector<PackedTextureArchive::Entry> m_entries;
+  std::vector<PackedTextureArchive::Level> m_levels;
+  std::vector<std::string> m_names;
+
+  mutable std::mutex m_lock;
+  File::IOFile m_file;
+  std::map<AssetID, u32> m_assetid_to_entry;
+};
+}  // namespace VideoCommon
@@ -3,6 +3,7 @@
 
 #include "VideoCommon/AsyncShaderCompiler.h"
 
+#include <algorithm>
 #include <thread>
 
 #include "Common/Assert.h"
@@ -14,6 +15,12 @@
 
 namespace VideoCommon
 {
+// Time the front item of a priority level has to wait to gain one priority point.
+constexpr auto PRIORITY_AGING_INTERVAL = std::chrono::milliseconds(5);
+
+// Number of pending items per active worker before a parked worker is woken.
+constexpr size_t BACKLOG_PER_WORKER = 4;
+
 AsyncShaderCompiler::AsyncShaderCompiler()
 {
 }
@@ -37,7 +44,22 @@ void AsyncShaderCompiler::QueueWorkItem(WorkItemPtr item, u32 priority)
   {
     std::lock_guard<std::mutex> guard(m_pending_work_lock);
     m_pending_work.emplace(priority, std::move(item));
-    m_worker_thread_wake.notify_one();
+    m_pending_level_times.try_emplace(priority, Clock::now());
+
+    // Bring in another worker if the backlog is more than the active workers can get through
+    // quickly, or if they are all busy and the new item would have to wait for one of them.
+    if (m_active_workers < m_worker_threads.size() &&
+        (m_pending_work.size() > m_active_workers * BACKLOG_PER_WORKER ||
+         m_busy_workers.load() >= m_active_workers))
+    {
+      m_active_workers++;
+    }
+
+    // Parked workers share the condition variable, so a single notify could be swallowed.
+    if (m_worker_threads.size() > m_min_active_workers)
+      m_worker_thread_wake.notify_all();
+    else
+      m_worker_thread_wake.notify_one();
   }
 }
 
@@ -114,12 +136,19 @@ bool AsyncShaderCompiler::WaitUntilCompletion(
   return true;
 }
 
-bool AsyncShaderCompiler::StartWorkerThreads(u32 num_worker_threads)
+bool AsyncShaderCompiler::StartWorkerThreads(u32 num_worker_threads, u32 max_worker_threads)
 {
   if (num_worker_threads == 0)
     return true;
 
-  for (u32 i = 0; i < num_worker_threads; i++)
+  {
+    std::lock_guard<std::mutex> guard(m_pending_work_lock);
+    m_min_active_workers = num_worker_threads;
+    m_active_workers = num_worker_threads;
+  }
+
+  const u32 total_worker_threads = std::max(num_worker_threads, max_worker_threads);
+  for (u32 i = 0; i < total_worker_threads; i++)
   {
     void* thread_param = nullptr;
     if (!WorkerThreadInitMainThread(&thread_param))
@@ -130,7 +159,7 @@ bool AsyncShaderCompiler::StartWorkerThreads(u32 num_worker_threads)
 
     m_worker_thread_start_result.store(false);
 
-    std::thread thr(&AsyncShaderCompiler::WorkerThreadEntryPoint, this, thread_param);
+    std::thread thr(&AsyncShaderCompiler::WorkerThreadEntryPoint, this, thread_param, i);
     m_init_event.Wait();
 
     if (!m_worker_thread_start_result.load())
@@ -143,16 +172,33 @@ bool AsyncShaderCompiler::StartWorkerThreads(u32 num_worker_threads)
     m_worker_threads.push_back(std::move(thr));
   }
 
+  // Threads which failed to start can't be activated.
+  {
+    std::lock_guard<std::mutex> guard(m_pending_work_lock);
+    m_min_active_workers = std::min(m_min_active_workers, m_worker_threads.size());
+    m_active_workers = m_min_active_workers;
+  }
+
   return HasWorkerThreads();
 }
 
-bool AsyncShaderCompiler::ResizeWorkerThreads(u32 num_worker_threads)
+bool AsyncShaderCompiler::ResizeWorkerThreads(u32 num_worker_threads, u32 max_worker_threads)
 {
-  if (m_worker_threads.size() == num_worker_threads)
+  // If only the number of active workers changes, the threads can be kept, which avoids
+  // recreating backend contexts when switching between precompiling and gameplay.
+  const size_t total_worker_threads =
+      num_worker_threads != 0 ? std::max(num_worker_threads, max_worker_threads) : 0;
+  if (m_worker_threads.size() == total_worker_threads)
+  {
+    std::lock_guard<std::mutex> guard(m_pending_work_lock);
+    m_min_active_workers = num_worker_threads;
+    m_active_workers = std::max(m_active_workers, m_min_active_workers);
+    m_worker_thread_wake.notify_all();
     return true;
+  }
 
   StopWorkerThreads();
-  return StartWorkerThreads(num_worker_threads);
+  return StartWorkerThreads(num_worker_threads, max_worker_threads);
 }
 
 bool AsyncShaderCompiler::HasWorkerThreads() const
@@ -177,6 +223,8 @@ void AsyncShaderCompiler::StopWorkerThreads()
     thr.join();
   m_worker_threads.clear();
   m_exit_flag.Clear();
+  m_min_active_workers = 0;
+  m_active_workers = 0;
 }
 
 bool AsyncShaderCompiler::WorkerThreadInitMainThread(void** param)
@@ -193,7 +241,7 @@ void AsyncShaderCompiler::WorkerThreadExit(void* param)
 {
 }
 
-void AsyncShaderCompiler::WorkerThreadEntryPoint(void* param)
+void AsyncShaderCompiler::WorkerThreadEntryPoint(void* param, u32 index)
 {
   Common::SetCurrentThreadName("AsyncShaderCompiler Worker");
 
@@ -209,24 +257,53 @@ void AsyncShaderCompiler::WorkerThreadEntryPoint(void* param)
   m_worker_thread_start_result.store(true);
   m_init_event.Set();
 
-  WorkerThreadRun();
+  WorkerThreadRun(index);
 
   WorkerThreadExit(param);
 }
 
-void AsyncShaderCompiler::WorkerThreadRun()
+AsyncShaderCompiler::WorkItemPtr AsyncShaderCompiler::PopNextWorkItem()
+{
+  // Items within a priority level are compiled in order, so only the front of each level needs
+  // to be considered. Only aging the front item means a large backlog of low priority work gets
+  // one promoted item at a time, rather than all of it overtaking newer high priority work.
+  const Clock::time_point now = Clock::now();
+  auto best = m_pending_work.end();
+  s64 best_priority = 0;
+  for (auto it = m_pending_work.begin(); it != m_pending_work.end();
+       it = m_pending_work.upper_bound(it->first))
+  {
+    const s64 promotion = (now - m_pending_level_times[it->first]) / PRIORITY_AGING_INTERVAL;
+    const s64 priority = static_cast<s64>(it->first) - promotion;
+    if (best == m_pending_work.end() || priority < best_priority)
+    {
+      best = it;
+      best_priority = priority;
+    }
+  }
+
+  const u32 level = best->first;
+  WorkItemPtr item(std::move(best->second));
+  const auto next = m_pending_work.erase(best);
+  if (next != m_pending_work.end() && next->first == level)
+    m_pending_level_times[level] = now;
+  else
+    m_pending_level_times.erase(level);
+
+  return item;
+}
+
+void AsyncShaderCompiler::WorkerThreadRun(u32 index)
 {
   std::unique_lock<std::mutex> pending_lock(m_pending_work_lock);
   while (!m_exit_flag.IsSet())
   {
     m_worker_thread_wake.wait(pending_lock);
 
-    while (!m_pending_work.empty() && !m_exit_flag.IsSet())
+    while (!m_pending_work.empty() && index < m_active_workers && !m_exit_flag.IsSet())
     {
       m_busy_workers++;
-      auto iter = m_pending_work.begin();
-      WorkItemPtr item(std::move(iter->second));
-      m_pending_work.erase(iter);
+      WorkItemPtr item = PopNextWorkItem();
       pending_lock.unlock();
 
       if (item->Compile())
@@ -238,6 +315,10 @@ void AsyncShaderCompiler::WorkerThreadRun()
       pending_lock.lock();
       m_busy_workers--;
     }
+
+    // The backlog is gone, park the extra workers to leave the cores to the emulation threads.
+    if (m_pending_work.empty())
+      m_active_workers = m_min_active_workers;
   }
 }
 
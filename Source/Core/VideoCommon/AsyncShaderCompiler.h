@@ -4,6 +4,7 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <deque>
 #include <functional>
@@ -43,7 +44,8 @@ public:
   }
 
   // Queues a new work item to the compiler threads. The lower the priority, the sooner
-  // this work item will be compiled, relative to the other work items.
+  // this work item will be compiled, relative to the other work items. The oldest item of each
+  // priority is promoted the longer it waits, so low priority work is never starved completely.
   void QueueWorkItem(WorkItemPtr item, u32 priority);
   void RetrieveWorkItems();
   bool HasPendingWork();
@@ -54,8 +56,10 @@ public:
   bool WaitUntilCompletion(const std::function<void(size_t, size_t)>& progress_callback);
 
   // Needed because of calling virtual methods in shutdown procedure.
-  bool StartWorkerThreads(u32 num_worker_threads);
-  bool ResizeWorkerThreads(u32 num_worker_threads);
+  // If max_worker_threads is larger than num_worker_threads, the extra threads are parked, and
+  // only take work while the queue is backed up. They are parked again once it has drained.
+  bool StartWorkerThreads(u32 num_worker_threads, u32 max_worker_threads = 0);
+  bool ResizeWorkerThreads(u32 num_worker_threads, u32 max_worker_threads = 0);
   bool HasWorkerThreads() const;
   void StopWorkerThreads();
 
@@ -65,8 +69,11 @@ protected:
   virtual void WorkerThreadExit(void* param);
 
 private:
-  void WorkerThreadEntryPoint(void* param);
-  void WorkerThreadRun();
+  using Clock = std::chrono::steady_clock;
+
+  void WorkerThreadEntryPoint(void* param, u32 index);
+  void WorkerThreadRun(u32 index);
+  WorkItemPtr PopNextWorkItem();
 
   Common::Flag m_exit_flag;
   Common::Event m_init_event;
@@ -81,6 +88,14 @@ private:
   std::condition_variable m_worker_thread_wake;
   std::atomic_size_t m_busy_workers{0};
 
+  // When the front item of each priority level started waiting there.
+  std::map<u32, Clock::time_point> m_pending_level_times;
+
+  // Workers with an index below m_active_workers take work, the rest are parked. Guarded by
+  // m_pending_work_lock.
+  size_t m_min_active_workers = 0;
+  size_t m_active_workers = 0;
+
   std::deque<WorkItemPtr> m_completed_work;
   std::mutex m_completed_work_lock;
 };
@@ -37,6 +37,7 @@
 #include "VideoCommon/TMEM.h"
 #include "VideoCommon/TextureCacheBase.h"
 #include "VideoCommon/TextureDecoder.h"
+#include "VideoCommon/VertexManagerBase.h"
 #include "VideoCommon/VideoBackendBase.h"
 #include "VideoCommon/VideoCommon.h"
 #include "VideoCommon/VideoConfig.h"
@@ -54,6 +55,61 @@ void BPInit()
   bpmem.bpMask = 0xFFFFFF;
 }
 
+// Registers which are only latched for a later trigger (EFB copies, TLUT loads, TMEM preloads) or
+// which are not used at all. Their contents never affect primitives that are already queued, so
+// writing them does not need to flush the pipeline.
+static bool IsLatchedRegister(u32 address)
+{
+  switch (address)
+  {
+  case BPMEM_DISPLAYCOPYFILTER:
+  case BPMEM_DISPLAYCOPYFILTER + 1:
+  case BPMEM_DISPLAYCOPYFILTER + 2:
+  case BPMEM_DISPLAYCOPYFILTER + 3:
+  case BPMEM_COPYFILTER0:
+  case BPMEM_COPYFILTER1:
+  case BPMEM_EFB_TL:
+  case BPMEM_EFB_WH:
+  case BPMEM_EFB_ADDR:
+  case BPMEM_EFB_STRIDE:
+  case BPMEM_COPYYSCALE:
+  case BPMEM_CLEAR_AR:
+  case BPMEM_CLEAR_GB:
+  case BPMEM_CLEAR_Z:
+  case BPMEM_LOADTLUT0:
+  case BPMEM_BP_MASK:
+  case BPMEM_IND_IMASK:
+  case BPMEM_REVBITS:
+  case BPMEM_PRELOAD_ADDR:
+  case BPMEM_PRELOAD_TMEMEVEN:
+  case BPMEM_PRELOAD_TMEMODD:
+    return true;
+  default:
+    return false;
+  }
+}
+
+// Registers which only feed shader constants or sampler state. Games commonly rewrite these between
+// draws, and they don't require the pixel shader UID to be regenerated.
+static bool IsUniformOnlyRegister(u32 address)
+{
+  return (address >= BPMEM_IND_MTXA && address < BPMEM_IND_MTXA + 9) ||
+         address == BPMEM_SCISSORTL || address == BPMEM_SCISSORBR ||
+         address == BPMEM_SCISSOROFFSET ||
+         (address >= BPMEM_SU_SSIZE && address < BPMEM_SU_SSIZE + 16) ||
+         (address >= BPMEM_TX_SETMODE0 && address < BPMEM_TX_SETTLUT_4 + 4) ||
+         (address >= BPMEM_TEV_COLOR_RA && address < BPMEM_TEV_COLOR_RA + 8) ||
+         (address > BPMEM_FOGRANGE && address < BPMEM_FOGRANGE + 6) ||
+         address == BPMEM_FOGPARAM0 || address == BPMEM_FOGBMAGNITUDE ||
+         address == BPMEM_FOGBEXPONENT || address == BPMEM_FOGCOLOR || address == BPMEM_BIAS;
+}
+
+static void SkipFlush()
+{
+  if (g_vertex_manager->HasSendableVertices())
+    INCSTAT(g_stats.this_frame.num_flushes_avoided);
+}
+
 static void BPWritten(PixelShaderManager& pixel_shader_manager, XFStateManager& xf_state_manager,
                       GeometryShaderManager& geometry_shader_manager, const BPCmd& bp,
                       int cycles_into_future)
@@ -88,14 +144,21 @@ static void BPWritten(PixelShaderManager& pixel_shader_manager, XFStateManager&
           bp.address == BPMEM_TEXINVALIDATE || bp.address == BPMEM_PRELOAD_MODE ||
           bp.address == BPMEM_CLEAR_PIXEL_PERF))
     {
+      SkipFlush();
       return;
     }
   }
 
-  FlushPipeline();
+  if (IsLatchedRegister(bp.address))
+    SkipFlush();
+  else
+    FlushPipeline();
 
   ((u32*)&bpmem)[bp.address] = bp.newvalue;
 
+  if (!IsLatchedRegister(bp.address) && !IsUniformOnlyRegister(bp.address))
+    g_vertex_manager->SetPixelShaderUidChanged();
+
   switch (bp.address)
   {
   case BPMEM_GENMODE:  // Set the Generation Mode
@@ -183,10 +246,11 @@ static void BPWritten(PixelShaderManager& pixel_shader_manager, XFStateManager&
     case 0x02:
     {
       INCSTAT(g_stats.this_frame.num_draw_done);
-      g_texture_cache->FlushEFBCopies();
+      g_texture_cache->FlushCompletedEFBCopies();
       g_texture_cache->FlushStaleBinds();
       g_framebuffer_manager->InvalidatePeekCache(false);
       g_framebuffer_manager->RefreshPeekCache();
+      g_bounding_box->QueueReadback();
       auto& system = Core::System::GetInstance();
       if (!system.GetFifo().UseDeterministicGPUThread())
         system.GetPixelEngine().SetFinish(cycles_into_future);  // may generate interrupt
@@ -202,10 +266,11 @@ static void BPWritten(PixelShaderManager& pixel_shader_manager, XFStateManager&
   case BPMEM_PE_TOKEN_ID:  // Pixel Engine Token ID
   {
     INCSTAT(g_stats.this_frame.num_token);
-    g_texture_cache->FlushEFBCopies();
+    g_texture_cache->FlushCompletedEFBCopies();
     g_texture_cache->FlushStaleBinds();
     g_framebuffer_manager->InvalidatePeekCache(false);
     g_framebuffer_manager->RefreshPeekCache();
+    g_bounding_box->QueueReadback();
     auto& system = Core::System::GetInstance();
     if (!system.GetFifo().UseDeterministicGPUThread())
     {
@@ -218,10 +283,11 @@ static void BPWritten(PixelShaderManager& pixel_shader_manager, XFStateManager&
   case BPMEM_PE_TOKEN_INT_ID:  // Pixel Engine Interrupt Token ID
   {
     INCSTAT(g_stats.this_frame.num_token_int);
-    g_texture_cache->FlushEFBCopies();
+    g_texture_cache->FlushCompletedEFBCopies();
     g_texture_cache->FlushStaleBinds();
     g_framebuffer_manager->InvalidatePeekCache(false);
     g_framebuffer_manager->RefreshPeekCache();
+    g_bounding_box->QueueReadback();
     auto& system = Core::System::GetInstance();
     if (!system.GetFifo().UseDeterministicGPUThread())
     {
@@ -315,6 +381,7 @@ static void BPWritten(PixelShaderManager& pixel_shader_manager, XFStateManager&
       // We should be able to get away with deactivating the current bbox tracking
       // here. Not sure if there's a better spot to put this.
       // the number of lines copied is determined by the y scale * source efb height
+      g_bounding_box->QueueReadback();
       g_bounding_box->Disable(pixel_shader_manager);
 
       float yScale;
@@ -567,7 +634,10 @@ static void BPWritten(PixelShaderManager& pixel_shader_manager, XFStateManager&
     // GXClearPixMetric writes 0xAAA here, Sunshine alternates this register between values 0x000
     // and 0xAAA
     if (PerfQueryBase::ShouldEmulate())
+    {
+      g_perf_query->PublishResults();
       g_perf_query->ResetQuery();
+    }
     return;
 
   case BPMEM_PRELOAD_ADDR:
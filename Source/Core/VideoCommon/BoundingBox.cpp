@@ -8,7 +8,9 @@
 #include "Common/Assert.h"
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
+#include "VideoCommon/GPUTiming.h"
 #include "VideoCommon/PixelShaderManager.h"
+#include "VideoCommon/VertexManagerBase.h"
 #include "VideoCommon/VideoConfig.h"
 
 #include <algorithm>
@@ -19,12 +21,14 @@ void BoundingBox::Enable(PixelShaderManager& pixel_shader_manager)
 {
   m_is_active = true;
   pixel_shader_manager.SetBoundingBoxActive(m_is_active);
+  g_vertex_manager->SetPixelShaderUidChanged();
 }
 
 void BoundingBox::Disable(PixelShaderManager& pixel_shader_manager)
 {
   m_is_active = false;
   pixel_shader_manager.SetBoundingBoxActive(m_is_active);
+  g_vertex_manager->SetPixelShaderUidChanged();
 }
 
 void BoundingBox::Flush()
@@ -33,10 +37,13 @@ void BoundingBox::Flush()
     return;
 
   m_is_valid = false;
+  m_readback_queued = false;
 
   if (std::none_of(m_dirty.begin(), m_dirty.end(), [](bool dirty) { return dirty; }))
     return;
 
+  GPUTimingScope timing_scope(GPUTimingPass::BoundingBox);
+
   // TODO: Does this make any difference over just writing all the values?
   // Games only ever seem to write all 4 values at once anyways.
   for (u32 start = 0; start < NUM_BBOX_VALUES; ++start)
@@ -55,12 +62,29 @@ void BoundingBox::Flush()
   }
 }
 
+void BoundingBox::QueueReadback()
+{
+  if (!g_ActiveConfig.bBBoxEnable || !g_ActiveConfig.backend_info.bSupportsBBox)
+    return;
+
+  if (m_is_valid || m_readback_queued)
+    return;
+
+  GPUTimingScope timing_scope(GPUTimingPass::BoundingBox);
+  m_readback_queued = QueueRead();
+}
+
 void BoundingBox::Readback()
 {
   if (!g_ActiveConfig.backend_info.bSupportsBBox)
     return;
 
-  auto read_values = Read(0, NUM_BBOX_VALUES);
+  std::vector<BBoxType> read_values;
+  {
+    GPUTimingScope timing_scope(GPUTimingPass::BoundingBox);
+    read_values = m_readback_queued ? ReadQueued() : Read(0, NUM_BBOX_VALUES);
+    m_readback_queued = false;
+  }
 
   // Preserve dirty values, that way we don't need to sync.
   for (u32 i = 0; i < NUM_BBOX_VALUES; i++)
@@ -120,6 +144,8 @@ void BoundingBox::DoState(PointerWrap& p)
   {
     p.Do(backend_values);
 
+    // Any queued copy predates the loaded state.
+    m_readback_queued = false;
     if (g_ActiveConfig.backend_info.bSupportsBBox)
       Write(0, backend_values);
   }
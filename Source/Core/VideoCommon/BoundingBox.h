@@ -28,6 +28,11 @@ public:
 
   void Flush();
 
+  // Starts copying the current values back from the GPU without waiting for the copy, so that a
+  // later Get() does not have to stall the pipeline. Called at points where the game is likely to
+  // read the bounding box registers soon, e.g. draw done or PE tokens.
+  void QueueReadback();
+
   u16 Get(u32 index);
   void Set(u32 index, u16 value);
 
@@ -41,6 +46,11 @@ protected:
   virtual std::vector<BBoxType> Read(u32 index, u32 length) = 0;
   virtual void Write(u32 index, std::span<const BBoxType> values) = 0;
 
+  // Backends which support asynchronous readback record a copy of all values and return true.
+  // ReadQueued() then waits for that copy, which must not be invalidated by further draws.
+  virtual bool QueueRead() { return false; }
+  virtual std::vector<BBoxType> ReadQueued() { return Read(0, NUM_BBOX_VALUES); }
+
 private:
   void Readback();
 
@@ -49,6 +59,7 @@ private:
   std::array<BBoxType, NUM_BBOX_VALUES> m_values = {};
   std::array<bool, NUM_BBOX_VALUES> m_dirty = {};
   bool m_is_valid = true;
+  bool m_readback_queued = false;
 
   // Nintendo's SDK seems to write "default" bounding box values before every draw (1023 0 1023 0
   // are the only values encountered so far, which happen to be the extents allowed by the BP
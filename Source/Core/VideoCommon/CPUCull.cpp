@@ -54,10 +54,14 @@
 #include "VideoCommon/CPUCullImpl.h"
 #define USE_FMA
 #include "VideoCommon/CPUCullImpl.h"
+#define USE_AVX512
+#include "VideoCommon/CPUCullImpl.h"
 #endif
 
 #if defined(USE_SSE)
-#if defined(__AVX__) && defined(__FMA__)
+#if defined(__AVX512F__) && defined(__FMA__)
+static constexpr int MIN_SSE = 52;
+#elif defined(__AVX__) && defined(__FMA__)
 static constexpr int MIN_SSE = 51;
 #elif defined(__AVX__)
 static constexpr int MIN_SSE = 50;
@@ -74,7 +78,9 @@ template <bool PositionHas3Elems, bool PerVertexPosMtx>
 static CPUCull::TransformFunction GetTransformFunction()
 {
 #if defined(USE_SSE)
-  if (MIN_SSE >= 51 || (cpu_info.bAVX && cpu_info.bFMA))
+  if (MIN_SSE >= 52 || (cpu_info.bAVX512F && cpu_info.bFMA))
+    return CPUCull_AVX512::TransformVertices<PositionHas3Elems, PerVertexPosMtx>;
+  else if (MIN_SSE >= 51 || (cpu_info.bAVX && cpu_info.bFMA))
     return CPUCull_FMA::TransformVertices<PositionHas3Elems, PerVertexPosMtx>;
   else if (MIN_SSE >= 50 || cpu_info.bAVX)
     return CPUCull_AVX::TransformVertices<PositionHas3Elems, PerVertexPosMtx>;
@@ -121,6 +127,34 @@ static Common::EnumMap<CPUCull::CullFunction, CullMode::All> GetCullFunction1()
   };
 }
 
+template <OpcodeDecoder::Primitive Primitive, CullMode Mode>
+static CPUCull::VisibleTrianglesFunction GetVisibleFunction0()
+{
+#if defined(USE_SSE)
+  if (MIN_SSE >= 50 || cpu_info.bAVX)
+    return CPUCull_AVX::GetVisibleTriangles<Primitive, Mode>;
+  else if (MIN_SSE >= 30 || cpu_info.bSSE3)
+    return CPUCull_SSE3::GetVisibleTriangles<Primitive, Mode>;
+  else
+    return CPUCull_SSE::GetVisibleTriangles<Primitive, Mode>;
+#elif defined(USE_NEON)
+  return CPUCull_NEON::GetVisibleTriangles<Primitive, Mode>;
+#else
+  return CPUCull_Scalar::GetVisibleTriangles<Primitive, Mode>;
+#endif
+}
+
+template <OpcodeDecoder::Primitive Primitive>
+static Common::EnumMap<CPUCull::VisibleTrianglesFunction, CullMode::All> GetVisibleFunction1()
+{
+  return {
+      GetVisibleFunction0<Primitive, CullMode::None>(),
+      GetVisibleFunction0<Primitive, CullMode::Back>(),
+      GetVisibleFunction0<Primitive, CullMode::Front>(),
+      GetVisibleFunction0<Primitive, CullMode::All>(),
+  };
+}
+
 CPUCull::~CPUCull() = default;
 
 void CPUCull::Init()
@@ -135,13 +169,16 @@ void CPUCull::Init()
   m_cull_table[Prim::GX_DRAW_TRIANGLES] = GetCullFunction1<Prim::GX_DRAW_TRIANGLES>();
   m_cull_table[Prim::GX_DRAW_TRIANGLE_STRIP] = GetCullFunction1<Prim::GX_DRAW_TRIANGLE_STRIP>();
   m_cull_table[Prim::GX_DRAW_TRIANGLE_FAN] = GetCullFunction1<Prim::GX_DRAW_TRIANGLE_FAN>();
+  m_visible_table[Prim::GX_DRAW_QUADS] = GetVisibleFunction1<Prim::GX_DRAW_QUADS>();
+  m_visible_table[Prim::GX_DRAW_QUADS_2] = GetVisibleFunction1<Prim::GX_DRAW_QUADS>();
+  m_visible_table[Prim::GX_DRAW_TRIANGLES] = GetVisibleFunction1<Prim::GX_DRAW_TRIANGLES>();
+  m_visible_table[Prim::GX_DRAW_TRIANGLE_STRIP] =
+      GetVisibleFunction1<Prim::GX_DRAW_TRIANGLE_STRIP>();
+  m_visible_table[Prim::GX_DRAW_TRIANGLE_FAN] = GetVisibleFunction1<Prim::GX_DRAW_TRIANGLE_FAN>();
 }
 
-bool CPUCull::AreAllVerticesCulled(VertexLoaderBase* loader, OpcodeDecoder::Primitive primitive,
-                                   const u8* src, u32 count)
+CullMode CPUCull::TransformVertices(VertexLoaderBase* loader, const u8* src, u32 count)
 {
-  ASSERT_MSG(VIDEO, primitive < OpcodeDecoder::Primitive::GX_DRAW_LINES,
-             "CPUCull should not be called on lines or points");
   const u32 stride = loader->m_native_vtx_decl.stride;
   const bool posHas3Elems = loader->m_native_vtx_decl.position.components >= 3;
   const bool perVertexPosMtx = loader->m_native_vtx_decl.posmtx.enable;
@@ -150,7 +187,9 @@ bool CPUCull::AreAllVerticesCulled(VertexLoaderBase* loader, OpcodeDecoder::Prim
     u32 new_size = MathUtil::NextPowerOf2(count);
     m_transform_buffer_size = new_size;
     m_transform_buffer.reset(static_cast<TransformedVertex*>(
-        Common::AllocateAlignedMemory(new_size * sizeof(TransformedVertex), 32)));
+        Common::AllocateAlignedMemory(new_size * sizeof(TransformedVertex), 64)));
+    // No primitive has more triangles than vertices
+    m_visibility_buffer = std::make_unique<u8[]>(new_size);
   }
 
   // transform functions need the projection matrix to tranform to clip space
@@ -165,10 +204,29 @@ bool CPUCull::AreAllVerticesCulled(VertexLoaderBase* loader, OpcodeDecoder::Prim
     cullmode = cullmode_invert[cullmode];
   const TransformFunction transform = m_transform_table[posHas3Elems][perVertexPosMtx];
   transform(m_transform_buffer.get(), src, stride, count);
+  return cullmode;
+}
+
+bool CPUCull::AreAllVerticesCulled(VertexLoaderBase* loader, OpcodeDecoder::Primitive primitive,
+                                   const u8* src, u32 count)
+{
+  ASSERT_MSG(VIDEO, primitive < OpcodeDecoder::Primitive::GX_DRAW_LINES,
+             "CPUCull should not be called on lines or points");
+  const CullMode cullmode = TransformVertices(loader, src, count);
   const CullFunction cull = m_cull_table[primitive][cullmode];
   return cull(m_transform_buffer.get(), count);
 }
 
+u32 CPUCull::CullTriangles(VertexLoaderBase* loader, OpcodeDecoder::Primitive primitive,
+                           const u8* src, u32 count)
+{
+  ASSERT_MSG(VIDEO, primitive < OpcodeDecoder::Primitive::GX_DRAW_LINES,
+             "CPUCull should not be called on lines or points");
+  const CullMode cullmode = TransformVertices(loader, src, count);
+  const VisibleTrianglesFunction visible = m_visible_table[primitive][cullmode];
+  return visible(m_transform_buffer.get(), count, m_visibility_buffer.get());
+}
+
 template <typename T>
 void CPUCull::BufferDeleter<T>::operator()(T* ptr)
 {
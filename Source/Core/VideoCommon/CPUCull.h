@@ -14,6 +14,11 @@ public:
   void Init();
   bool AreAllVerticesCulled(VertexLoaderBase* loader, OpcodeDecoder::Primitive primitive,
                             const u8* src, u32 count);
+  // Tests every triangle separately instead, and returns how many of them survive.
+  // GetTriangleVisibility() then has one entry per triangle, in IndexGenerator order.
+  u32 CullTriangles(VertexLoaderBase* loader, OpcodeDecoder::Primitive primitive, const u8* src,
+                    u32 count);
+  const u8* GetTriangleVisibility() const { return m_visibility_buffer.get(); }
 
   struct alignas(16) TransformedVertex
   {
@@ -22,17 +27,24 @@ public:
 
   using TransformFunction = void (*)(void*, const void*, u32, int);
   using CullFunction = bool (*)(const CPUCull::TransformedVertex*, int);
+  using VisibleTrianglesFunction = u32 (*)(const CPUCull::TransformedVertex*, int, u8*);
 
 private:
+  CullMode TransformVertices(VertexLoaderBase* loader, const u8* src, u32 count);
+
   template <typename T>
   struct BufferDeleter
   {
     void operator()(T* ptr);
   };
   std::unique_ptr<TransformedVertex[], BufferDeleter<TransformedVertex>> m_transform_buffer{};
+  std::unique_ptr<u8[]> m_visibility_buffer{};
   u32 m_transform_buffer_size = 0;
   std::array<std::array<TransformFunction, 2>, 2> m_transform_table{};
   Common::EnumMap<Common::EnumMap<CullFunction, CullMode::All>,
                   OpcodeDecoder::Primitive::GX_DRAW_TRIANGLE_FAN>
       m_cull_table{};
+  Common::EnumMap<Common::EnumMap<VisibleTrianglesFunction, CullMode::All>,
+                  OpcodeDecoder::Primitive::GX_DRAW_TRIANGLE_FAN>
+      m_visible_table{};
 };
@@ -1,7 +1,9 @@
 // Copyright 2022 Dolphin Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
-#if defined(USE_FMA)
+#if defined(USE_AVX512)
+#define VECTOR_NAMESPACE CPUCull_AVX512
+#elif defined(USE_FMA)
 #define VECTOR_NAMESPACE CPUCull_FMA
 #elif defined(USE_AVX)
 #define VECTOR_NAMESPACE CPUCull_AVX
@@ -19,7 +21,9 @@
 #error This file is meant to be used by CPUCull.cpp only!
 #endif
 
-#if defined(__GNUC__) && defined(USE_FMA) && !(defined(__AVX__) && defined(__FMA__))
+#if defined(__GNUC__) && defined(USE_AVX512) && !(defined(__AVX512F__) && defined(__FMA__))
+#define ATTR_TARGET __attribute__((target("avx512f,fma")))
+#elif defined(__GNUC__) && defined(USE_FMA) && !(defined(__AVX__) && defined(__FMA__))
 #define ATTR_TARGET __attribute__((target("avx,fma")))
 #elif defined(__GNUC__) && defined(USE_AVX) && !defined(__AVX__)
 #define ATTR_TARGET __attribute__((target("avx")))
@@ -236,6 +240,84 @@ LoadTransform2Vertices(const u8* v0data, const u8* v1data,                  //
 
 #endif
 
+#ifdef USE_AVX512
+template <int i>
+ATTR_TARGET DOLPHIN_FORCE_INLINE static __m512 vector_broadcast(__m512 v)
+{
+  return _mm512_shuffle_ps(v, v, _MM_SHUFFLE(i, i, i, i));
+}
+
+ATTR_TARGET DOLPHIN_FORCE_INLINE static void TransposeZMM(__m512& o0, __m512& o1,  //
+                                                          __m512& o2, __m512& o3)
+{
+  __m512d tmp0 = _mm512_castps_pd(_mm512_unpacklo_ps(o0, o1));
+  __m512d tmp1 = _mm512_castps_pd(_mm512_unpacklo_ps(o2, o3));
+  __m512d tmp2 = _mm512_castps_pd(_mm512_unpackhi_ps(o0, o1));
+  __m512d tmp3 = _mm512_castps_pd(_mm512_unpackhi_ps(o2, o3));
+  o0 = _mm512_castpd_ps(_mm512_unpacklo_pd(tmp0, tmp1));
+  o1 = _mm512_castpd_ps(_mm512_unpackhi_pd(tmp0, tmp1));
+  o2 = _mm512_castpd_ps(_mm512_unpacklo_pd(tmp2, tmp3));
+  o3 = _mm512_castpd_ps(_mm512_unpackhi_pd(tmp2, tmp3));
+}
+
+ATTR_TARGET DOLPHIN_FORCE_INLINE static void LoadTransposedZMM(const void* source, __m512& o0,
+                                                               __m512& o1, __m512& o2, __m512& o3)
+{
+  const Vector* vsource = static_cast<const Vector*>(source);
+  o0 = _mm512_broadcast_f32x4(vsource[0]);
+  o1 = _mm512_broadcast_f32x4(vsource[1]);
+  o2 = _mm512_broadcast_f32x4(vsource[2]);
+  o3 = _mm512_broadcast_f32x4(vsource[3]);
+  TransposeZMM(o0, o1, o2, o3);
+}
+
+ATTR_TARGET DOLPHIN_FORCE_INLINE static void
+LoadTransposedPosZMM(const void* source, __m512& o0, __m512& o1, __m512& o2, __m512& o3)
+{
+  const Vector* vsource = static_cast<const Vector*>(source);
+  o0 = _mm512_broadcast_f32x4(vsource[0]);
+  o1 = _mm512_broadcast_f32x4(vsource[1]);
+  o2 = _mm512_broadcast_f32x4(vsource[2]);
+  o3 = _mm512_broadcast_f32x4(_mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f));
+  TransposeZMM(o0, o1, o2, o3);
+}
+
+template <bool PositionHas3Elems>
+ATTR_TARGET DOLPHIN_FORCE_INLINE static __m128 LoadPosXMM(const u8* data)
+{
+  const float* fdata = reinterpret_cast<const float*>(data);
+  if constexpr (PositionHas3Elems)
+    return _mm_loadu_ps(fdata);
+  else
+    return _mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(fdata));
+}
+
+template <bool PositionHas3Elems>
+ATTR_TARGET DOLPHIN_FORCE_INLINE static __m512
+LoadTransform4Vertices(const u8* data, u32 stride,                        //
+                       __m512 pos0, __m512 pos1, __m512 pos2, __m512 pos3,  //
+                       __m512 proj0, __m512 proj1, __m512 proj2, __m512 proj3)
+{
+  // Only used without per-vertex position matrices, so every vertex shares pos0-3
+  __m512 v = _mm512_castps128_ps512(LoadPosXMM<PositionHas3Elems>(data));
+  v = _mm512_insertf32x4(v, LoadPosXMM<PositionHas3Elems>(data + stride), 1);
+  v = _mm512_insertf32x4(v, LoadPosXMM<PositionHas3Elems>(data + stride * 2), 2);
+  v = _mm512_insertf32x4(v, LoadPosXMM<PositionHas3Elems>(data + stride * 3), 3);
+
+  __m512 output = pos3;  // vertex.w is always 1.0
+  output = _mm512_fmadd_ps(vector_broadcast<0>(v), pos0, output);
+  output = _mm512_fmadd_ps(vector_broadcast<1>(v), pos1, output);
+  if constexpr (PositionHas3Elems)
+    output = _mm512_fmadd_ps(vector_broadcast<2>(v), pos2, output);
+
+  __m512 clip = _mm512_mul_ps(vector_broadcast<0>(output), proj0);
+  clip = _mm512_fmadd_ps(vector_broadcast<1>(output), proj1, clip);
+  clip = _mm512_fmadd_ps(vector_broadcast<2>(output), proj2, clip);
+  clip = _mm512_fmadd_ps(vector_broadcast<3>(output), proj3, clip);
+  return clip;
+}
+#endif
+
 #ifndef USE_AVX
 // Note: Assumes 16-byte aligned source
 ATTR_TARGET DOLPHIN_FORCE_INLINE static void LoadTransposed(const void* source, Vector& o0,
@@ -517,7 +599,25 @@ ATTR_TARGET static void TransformVertices(void* output, const void* vertices, u3
   __m256 pos0, pos1, pos2, pos3;
   LoadTransposedYMM(vsmanager.constants.projection.data(), proj0, proj1, proj2, proj3);
   LoadTransposedPosYMM(&xfmem.posMatrices[idx * 4], pos0, pos1, pos2, pos3);
-  for (int i = 1; i < count; i += 2)
+  int i = 1;
+#ifdef USE_AVX512
+  if constexpr (!PerVertexPosMtx)
+  {
+    __m512 zproj0, zproj1, zproj2, zproj3;
+    __m512 zpos0, zpos1, zpos2, zpos3;
+    LoadTransposedZMM(vsmanager.constants.projection.data(), zproj0, zproj1, zproj2, zproj3);
+    LoadTransposedPosZMM(&xfmem.posMatrices[idx * 4], zpos0, zpos1, zpos2, zpos3);
+    for (; i + 2 < count; i += 4)
+    {
+      __m512 v0123 = LoadTransform4Vertices<PositionHas3Elems>(
+          cvertices, stride, zpos0, zpos1, zpos2, zpos3, zproj0, zproj1, zproj2, zproj3);
+      _mm512_store_ps(reinterpret_cast<float*>(voutput), v0123);
+      cvertices += stride * 4;
+      voutput += 4;
+    }
+  }
+#endif
+  for (; i < count; i += 2)
   {
     const u8* v0data = cvertices;
     const u8* v1data = cvertices + stride;
@@ -708,6 +808,62 @@ ATTR_TARGET static bool AreAllVerticesCulled(const CPUCull::TransformedVertex* t
   return true;
 }
 
+// Same triangle order as AreAllVerticesCulled and IndexGenerator::AddIndicesCulled
+template <OpcodeDecoder::Primitive Primitive, CullMode Mode>
+ATTR_TARGET static u32 GetVisibleTriangles(const CPUCull::TransformedVertex* transformed, int count,
+                                           u8* visible)
+{
+  u32 num_visible = 0;
+  switch (Primitive)
+  {
+  case OpcodeDecoder::Primitive::GX_DRAW_QUADS:
+  case OpcodeDecoder::Primitive::GX_DRAW_QUADS_2:
+  {
+    int i = 3;
+    for (; i < count; i += 4)
+    {
+      num_visible += *visible++ =
+          !CullTriangle<Mode>(transformed[i - 3], transformed[i - 2], transformed[i - 1]);
+      num_visible += *visible++ =
+          !CullTriangle<Mode>(transformed[i - 3], transformed[i - 1], transformed[i - 0]);
+    }
+    if (i == count)
+    {
+      num_visible += *visible++ =
+          !CullTriangle<Mode>(transformed[i - 3], transformed[i - 2], transformed[i - 1]);
+    }
+    break;
+  }
+  case OpcodeDecoder::Primitive::GX_DRAW_TRIANGLES:
+    for (int i = 2; i < count; i += 3)
+    {
+      num_visible += *visible++ =
+          !CullTriangle<Mode>(transformed[i - 2], transformed[i - 1], transformed[i - 0]);
+    }
+    break;
+  case OpcodeDecoder::Primitive::GX_DRAW_TRIANGLE_STRIP:
+  {
+    bool wind = false;
+    for (int i = 2; i < count; ++i)
+    {
+      num_visible += *visible++ =
+          !CullTriangle<Mode>(transformed[i - 2], transformed[i - !wind], transformed[i - wind]);
+      wind = !wind;
+    }
+    break;
+  }
+  case OpcodeDecoder::Primitive::GX_DRAW_TRIANGLE_FAN:
+    for (int i = 2; i < count; ++i)
+    {
+      num_visible += *visible++ =
+          !CullTriangle<Mode>(transformed[0], transformed[i - 1], transformed[i]);
+    }
+    break;
+  }
+
+  return num_visible;
+}
+
 }  // namespace VECTOR_NAMESPACE
 
 #undef ATTR_TARGET
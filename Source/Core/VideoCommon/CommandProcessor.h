@@ -174,7 +174,8 @@ public:
 
   void SetCPStatusFromGPU();
   void SetCPStatusFromCPU();
-  void GatherPipeBursted();
+  // Called once the gather pipe has written the given number of 32-byte bursts to the FIFO.
+  void GatherPipeBursted(u32 bursts = 1);
   void UpdateInterrupts(u64 userdata);
   void UpdateInterruptsFromVideoBackend(u64 userdata);
 
@@ -3,16 +3,22 @@
 
 #include "VideoCommon/Fifo.h"
 
+#include <algorithm>
 #include <atomic>
+#include <climits>
 #include <cstring>
+#include <span>
 
 #include "Common/Assert.h"
 #include "Common/BlockingLoop.h"
 #include "Common/ChunkFile.h"
 #include "Common/Event.h"
 #include "Common/FPURoundMode.h"
+#include "Common/Logging/Log.h"
 #include "Common/MemoryUtil.h"
 #include "Common/MsgHandler.h"
+#include "Common/ScopeGuard.h"
+#include "Common/TraceZone.h"
 
 #include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
@@ -27,7 +33,9 @@
 #include "VideoCommon/CommandProcessor.h"
 #include "VideoCommon/DataReader.h"
 #include "VideoCommon/FramebufferManager.h"
+#include "VideoCommon/FrameTimeReport.h"
 #include "VideoCommon/OpcodeDecoding.h"
+#include "VideoCommon/PerformanceMetrics.h"
 #include "VideoCommon/VertexLoaderManager.h"
 #include "VideoCommon/VertexManagerBase.h"
 #include "VideoCommon/VideoBackendBase.h"
@@ -36,6 +44,33 @@ namespace Fifo
 {
 static constexpr int GPU_TIME_SLOT_SIZE = 1000;
 
+// With MAIN_SYNC_GPU_ADAPTIVE, the distance is reconsidered after this many emulated CPU ticks,
+// and can grow up to this many times the configured one.
+static constexpr s64 ADAPTIVE_WINDOW_TICKS = 4'000'000;
+static constexpr s64 ADAPTIVE_MAX_DISTANCE_FACTOR = 8;
+// The distance grows when the CPU thread spent more than 1/n of a window waiting for the GPU
+// thread.
+static constexpr int ADAPTIVE_STALL_DIVISOR = 20;
+// Windows to wait before growing the distance again after the game had to read back GPU state,
+// which doubles every time that happens.
+static constexpr u32 ADAPTIVE_MAX_BACKOFF = 256;
+
+// The state that a sync reads back, if it only has to wait for commands that change it.
+static std::optional<GPUDependency> GetReadbackDependency(SyncGPUReason reason)
+{
+  switch (reason)
+  {
+  case SyncGPUReason::EFBPeek:
+    return GPUDependency::EFB;
+  case SyncGPUReason::PerfQuery:
+    return GPUDependency::PerfQuery;
+  case SyncGPUReason::BBox:
+    return GPUDependency::BoundingBox;
+  default:
+    return std::nullopt;
+  }
+}
+
 FifoManager::FifoManager(Core::System& system) : m_system{system}
 {
 }
@@ -48,10 +83,25 @@ void FifoManager::RefreshConfig()
   m_config_sync_gpu_max_distance = Config::Get(Config::MAIN_SYNC_GPU_MAX_DISTANCE);
   m_config_sync_gpu_min_distance = Config::Get(Config::MAIN_SYNC_GPU_MIN_DISTANCE);
   m_config_sync_gpu_overclock = Config::Get(Config::MAIN_SYNC_GPU_OVERCLOCK);
+  m_config_sync_gpu_adaptive = Config::Get(Config::MAIN_SYNC_GPU_ADAPTIVE);
+
+  const int lower = m_config_sync_gpu_max_distance;
+  const int upper = m_config_sync_gpu_adaptive ? GetAdaptiveDistanceLimit(lower) : lower;
+  m_sync_max_distance.store(
+      std::clamp(m_sync_max_distance.load(std::memory_order_relaxed), lower, upper));
+}
+
+int FifoManager::GetAdaptiveDistanceLimit(int configured_distance)
+{
+  return static_cast<int>(std::clamp<s64>(configured_distance * ADAPTIVE_MAX_DISTANCE_FACTOR,
+                                          configured_distance, INT_MAX));
 }
 
 void FifoManager::DoState(PointerWrap& p)
 {
+  // Prefetched data hasn't been read from the FIFO yet, so it isn't part of the state.
+  DiscardPrefetch();
+
   p.DoArray(m_video_buffer, FIFO_SIZE);
   u8* write_ptr = m_video_buffer_write_ptr;
   p.DoPointer(write_ptr, m_video_buffer);
@@ -61,6 +111,7 @@ void FifoManager::DoState(PointerWrap& p)
   {
     // We're good and paused, right?
     m_video_buffer_seen_ptr = m_video_buffer_pp_read_ptr = m_video_buffer_read_ptr;
+    m_pending_gpu_dependencies = {};
   }
 
   p.Do(m_sync_ticks);
@@ -94,10 +145,26 @@ void FifoManager::Init()
 
   // Padded so that SIMD overreads in the vertex loader are safe
   m_video_buffer = static_cast<u8*>(Common::AllocateMemoryPages(FIFO_SIZE + 4));
+  m_use_preparse_thread = m_system.IsDualCoreMode() && Config::Get(Config::MAIN_PREPARSE_GPU_FIFO);
+  if (m_use_preparse_thread)
+  {
+    m_preparse_thread.Reset("FIFO Preparse",
+                            [this](PrefetchRequest request) { PrefetchFifo(request); });
+  }
   ResetVideoBuffer();
   if (m_system.IsDualCoreMode())
     m_gpu_mainloop.Prepare();
   m_sync_ticks.store(0);
+
+  m_sync_max_distance.store(m_config_sync_gpu_max_distance);
+  m_sync_stats = {};
+  m_distance_stats = {};
+  m_adaptive_window_ticks = 0;
+  m_adaptive_window_start = Clock::now();
+  m_adaptive_window_stall = DT::zero();
+  m_adaptive_window_readback_lag = 0;
+  m_adaptive_hold_windows = 0;
+  m_adaptive_backoff = 1;
 }
 
 void FifoManager::Shutdown()
@@ -105,6 +172,15 @@ void FifoManager::Shutdown()
   if (m_gpu_mainloop.IsRunning())
     PanicAlertFmt("FIFO shutting down while active");
 
+  LogSyncStats();
+
+  m_preparse_thread.Shutdown(true);
+  m_use_preparse_thread = false;
+  m_preparsed_commands.clear();
+  m_prefetched_commands.clear();
+  m_prefetch_write_ptr = nullptr;
+  m_preparse_ptr = nullptr;
+
   Common::FreeMemoryPages(m_video_buffer, FIFO_SIZE + 4);
   m_video_buffer = nullptr;
   m_video_buffer_write_ptr = nullptr;
@@ -146,13 +222,37 @@ void FifoManager::EmulatorState(bool running)
     m_gpu_mainloop.AllowSleep();
 }
 
+static_assert(static_cast<int>(StutterCause::SyncGPUAuxSpace) -
+                      static_cast<int>(StutterCause::SyncGPUOther) ==
+                  static_cast<int>(SyncGPUReason::AuxSpace),
+              "StutterCause must have one SyncGPU cause for each SyncGPUReason");
+
 void FifoManager::SyncGPU(SyncGPUReason reason, bool may_move_read_ptr)
 {
+  SyncStats& stats = m_sync_stats[static_cast<size_t>(reason)];
+  ++stats.count;
+  const std::optional<GPUDependency> dependency = GetReadbackDependency(reason);
+  if (dependency)
+    NoteGPUReadback();
+
   if (m_use_deterministic_gpu_thread)
   {
-    m_gpu_mainloop.Wait();
+    if (dependency && !m_pending_gpu_dependencies[static_cast<size_t>(*dependency)])
+    {
+      ++stats.skipped;
+      return;
+    }
+
+    {
+      const FrameTimeReport::CauseScope stutter_scope(static_cast<StutterCause>(
+          static_cast<int>(StutterCause::SyncGPUOther) + static_cast<int>(reason)));
+      const TimePoint start = Clock::now();
+      m_gpu_mainloop.Wait();
+      stats.stall_time += Clock::now() - start;
+    }
     if (!m_gpu_mainloop.IsRunning())
       return;
+    m_pending_gpu_dependencies = {};
 
     // Opportunistically reset FIFOs so we don't wrap around.
     if (may_move_read_ptr && m_fifo_aux_write_ptr != m_fifo_aux_read_ptr)
@@ -273,6 +373,178 @@ void FifoManager::ReadDataFromFifoOnCPU(u32 read_ptr)
   m_video_buffer_write_ptr = write_ptr + GPFifo::GATHER_PIPE_SIZE;
 }
 
+// The preparse thread version.
+void FifoManager::ReadPreparsedDataFromFifo(u32 read_ptr)
+{
+  auto& fifo = m_system.GetCommandProcessor().GetFifo();
+  const u32 base = fifo.CPBase.load(std::memory_order_relaxed);
+  const u32 end = fifo.CPEnd.load(std::memory_order_relaxed);
+  if (!m_prefetch_valid || read_ptr != m_prefetch_next_chunk || base != m_prefetch_base ||
+      end != m_prefetch_end)
+  {
+    // The FIFO was moved or reconfigured, so whatever was prefetched is stale.
+    DiscardPrefetch();
+    m_prefetch_valid = true;
+    m_prefetch_next_chunk = read_ptr;
+    m_prefetch_read_ptr = read_ptr;
+    m_prefetch_base = base;
+    m_prefetch_end = end;
+  }
+
+  const u32 available_chunks =
+      fifo.CPReadWriteDistance.load(std::memory_order_relaxed) / GPFifo::GATHER_PIPE_SIZE;
+  if (m_ready_chunks == 0)
+  {
+    if (m_in_flight_chunks == 0)
+      StartPrefetch(available_chunks);
+    WaitForPrefetch();
+    if (m_ready_chunks == 0)
+      return;
+  }
+
+  m_ready_chunks--;
+  m_video_buffer_write_ptr += GPFifo::GATHER_PIPE_SIZE;
+  m_prefetch_next_chunk = read_ptr == end ? base : read_ptr + GPFifo::GATHER_PIPE_SIZE;
+
+  // Let the preparse thread work on whatever else the CPU has written while we run this chunk.
+  if (m_in_flight_chunks == 0 && available_chunks > m_ready_chunks + 1)
+    StartPrefetch(available_chunks - m_ready_chunks - 1);
+}
+
+u8* FifoManager::RunPreparsedFifo(u8* write_ptr, u32* cycles)
+{
+  u8* read_ptr = m_video_buffer_read_ptr;
+
+  // Only commands that were completed by the chunks read so far may run.
+  size_t count = 0;
+  while (m_next_preparsed_command + count < m_preparsed_commands.size())
+  {
+    const auto& command = m_preparsed_commands[m_next_preparsed_command + count];
+    if (command.data + command.size > write_ptr)
+      break;
+    count++;
+  }
+  if (count == 0)
+    return read_ptr;
+
+  const std::span commands(&m_preparsed_commands[m_next_preparsed_command], count);
+  const size_t executed = OpcodeDecoder::RunPreparsedFifo(commands, cycles);
+  if (executed != 0)
+    read_ptr += commands[executed - 1].data + commands[executed - 1].size - commands[0].data;
+  m_next_preparsed_command += executed;
+
+  if (executed != count)
+  {
+    // The CP state diverged from what the commands were framed with, e.g. because a display list
+    // was modified after it was preparsed. Run the rest of the data normally and start over.
+    u32 fallback_cycles = 0;
+    read_ptr = OpcodeDecoder::RunFifo(DataReader(read_ptr, write_ptr), &fallback_cycles);
+    *cycles += fallback_cycles;
+    m_video_buffer_read_ptr = read_ptr;
+    DiscardPrefetch();
+  }
+  return read_ptr;
+}
+
+void FifoManager::StartPrefetch(u32 count)
+{
+  if (m_ready_chunks == 0 && m_in_flight_chunks == 0 &&
+      GPFifo::GATHER_PIPE_SIZE >
+          static_cast<size_t>(m_video_buffer + FIFO_SIZE - m_video_buffer_write_ptr))
+  {
+    // Nothing is prefetched, so everything that was framed has run and only the command at the
+    // read pointer is left; move it to the start of the buffer like ReadDataFromFifo does.
+    const size_t existing_len = m_video_buffer_write_ptr - m_video_buffer_read_ptr;
+    if (GPFifo::GATHER_PIPE_SIZE > static_cast<size_t>(FIFO_SIZE - existing_len))
+    {
+      PanicAlertFmt("FIFO out of bounds (existing {} + new {} > {})", existing_len,
+                    GPFifo::GATHER_PIPE_SIZE, FIFO_SIZE);
+      return;
+    }
+    memmove(m_video_buffer, m_video_buffer_read_ptr, existing_len);
+    m_video_buffer_write_ptr = m_video_buffer + existing_len;
+    m_video_buffer_read_ptr = m_video_buffer;
+    m_preparsed_commands.clear();
+    m_next_preparsed_command = 0;
+    m_prefetch_write_ptr = m_video_buffer_write_ptr;
+    m_preparse_ptr = m_video_buffer_read_ptr;
+  }
+
+  const u32 free_chunks = static_cast<u32>((m_video_buffer + FIFO_SIZE - m_prefetch_write_ptr) /
+                                           GPFifo::GATHER_PIPE_SIZE);
+  count = std::min(count, free_chunks);
+  if (count == 0)
+    return;
+
+  m_preparse_thread.Push(
+      PrefetchRequest{m_prefetch_read_ptr, count, m_prefetch_write_ptr, m_prefetch_base,
+                      m_prefetch_end});
+  for (u32 i = 0; i < count; i++)
+  {
+    m_prefetch_read_ptr = m_prefetch_read_ptr == m_prefetch_end ?
+                              m_prefetch_base :
+                              m_prefetch_read_ptr + GPFifo::GATHER_PIPE_SIZE;
+  }
+  m_prefetch_write_ptr += count * GPFifo::GATHER_PIPE_SIZE;
+  m_in_flight_chunks = count;
+}
+
+void FifoManager::WaitForPrefetch()
+{
+  if (m_in_flight_chunks == 0)
+    return;
+
+  m_preparse_thread.WaitForCompletion();
+
+  m_preparsed_commands.erase(m_preparsed_commands.begin(),
+                             m_preparsed_commands.begin() + m_next_preparsed_command);
+  m_next_preparsed_command = 0;
+  m_preparsed_commands.insert(m_preparsed_commands.end(), m_prefetched_commands.begin(),
+                              m_prefetched_commands.end());
+  m_prefetched_commands.clear();
+
+  m_ready_chunks += m_in_flight_chunks;
+  m_in_flight_chunks = 0;
+}
+
+// Drops everything past the write pointer. The next chunk restarts preparsing from the read
+// pointer with the main CP state.
+void FifoManager::DiscardPrefetch()
+{
+  if (!m_use_preparse_thread || m_use_deterministic_gpu_thread)
+    return;
+
+  WaitForPrefetch();
+
+  m_preparsed_commands.clear();
+  m_next_preparsed_command = 0;
+  m_ready_chunks = 0;
+  m_prefetch_write_ptr = m_video_buffer_write_ptr;
+  m_prefetch_valid = false;
+  m_preparse_ptr = m_video_buffer_read_ptr;
+
+  CopyPreprocessCPStateFromMain();
+  VertexLoaderManager::g_preprocess_vat_dirty = BitSet8::AllTrue(CP_NUM_VAT_REG);
+}
+
+// Runs on the preparse thread.
+void FifoManager::PrefetchFifo(const PrefetchRequest& request)
+{
+  auto& memory = m_system.GetMemory();
+  u32 read_ptr = request.read_ptr;
+  u8* write_ptr = request.dst;
+  for (u32 i = 0; i < request.count; i++)
+  {
+    memory.CopyFromEmu(write_ptr, read_ptr, GPFifo::GATHER_PIPE_SIZE);
+    write_ptr += GPFifo::GATHER_PIPE_SIZE;
+    read_ptr = read_ptr == request.end ? request.base : read_ptr + GPFifo::GATHER_PIPE_SIZE;
+
+    // Frame per chunk, so that every command only depends on the chunks up to the one it ends in.
+    m_preparse_ptr =
+        OpcodeDecoder::PreparseFifo(DataReader(m_preparse_ptr, write_ptr), &m_prefetched_commands);
+  }
+}
+
 void FifoManager::ResetVideoBuffer()
 {
   m_video_buffer_read_ptr = m_video_buffer;
@@ -281,6 +553,8 @@ void FifoManager::ResetVideoBuffer()
   m_video_buffer_pp_read_ptr = m_video_buffer;
   m_fifo_aux_write_ptr = m_fifo_aux_data;
   m_fifo_aux_read_ptr = m_fifo_aux_data;
+  m_pending_gpu_dependencies = {};
+  DiscardPrefetch();
 }
 
 // Description: Main FIFO update loop
@@ -292,6 +566,15 @@ void FifoManager::RunGpuLoop()
 
   m_gpu_mainloop.Run(
       [this] {
+        TRACE_ZONE("FifoManager::RunGpuLoop");
+
+        const bool sample_busy_time = g_perf_metrics.IsBusySamplingEnabled();
+        const TimePoint busy_start = sample_busy_time ? Clock::now() : TimePoint{};
+        Common::ScopeGuard busy_guard{[&] {
+          if (sample_busy_time)
+            g_perf_metrics.CountGPUBusyTime(Clock::now() - busy_start);
+        }};
+
         // Run events from the CPU thread.
         AsyncRequests::GetInstance()->PullEvents();
 
@@ -329,7 +612,10 @@ void FifoManager::RunGpuLoop()
 
             u32 cyclesExecuted = 0;
             u32 readPtr = fifo.CPReadPointer.load(std::memory_order_relaxed);
-            ReadDataFromFifo(readPtr);
+            if (m_use_preparse_thread)
+              ReadPreparsedDataFromFifo(readPtr);
+            else
+              ReadDataFromFifo(readPtr);
 
             if (readPtr == fifo.CPEnd.load(std::memory_order_relaxed))
               readPtr = fifo.CPBase.load(std::memory_order_relaxed);
@@ -345,8 +631,15 @@ void FifoManager::RunGpuLoop()
                        distance);
 
             u8* write_ptr = m_video_buffer_write_ptr;
-            m_video_buffer_read_ptr = OpcodeDecoder::RunFifo(
-                DataReader(m_video_buffer_read_ptr, write_ptr), &cyclesExecuted);
+            if (m_use_preparse_thread)
+            {
+              m_video_buffer_read_ptr = RunPreparsedFifo(write_ptr, &cyclesExecuted);
+            }
+            else
+            {
+              m_video_buffer_read_ptr = OpcodeDecoder::RunFifo(
+                  DataReader(m_video_buffer_read_ptr, write_ptr), &cyclesExecuted);
+            }
 
             fifo.CPReadPointer.store(readPtr, std::memory_order_relaxed);
             fifo.CPReadWriteDistance.fetch_sub(GPFifo::GATHER_PIPE_SIZE, std::memory_order_seq_cst);
@@ -362,8 +655,10 @@ void FifoManager::RunGpuLoop()
             {
               cyclesExecuted = (int)(cyclesExecuted / m_config_sync_gpu_overclock);
               int old = m_sync_ticks.fetch_sub(cyclesExecuted);
-              if (old >= m_config_sync_gpu_max_distance &&
-                  old - (int)cyclesExecuted < m_config_sync_gpu_max_distance)
+              // Loaded after the update, so that a distance the CPU thread lowered before it
+              // started waiting is always seen.
+              const int max_distance = m_sync_max_distance.load();
+              if (old >= max_distance && old - (int)cyclesExecuted < max_distance)
               {
                 m_sync_wakeup_event.Set();
               }
@@ -380,7 +675,7 @@ void FifoManager::RunGpuLoop()
           if (m_sync_ticks.load() > 0)
           {
             int old = m_sync_ticks.exchange(0);
-            if (old >= m_config_sync_gpu_max_distance)
+            if (old >= m_sync_max_distance.load())
               m_sync_wakeup_event.Set();
           }
 
@@ -524,6 +819,8 @@ void FifoManager::UpdateWantDeterminism(bool want)
 
   if (m_use_deterministic_gpu_thread != gpu_thread)
   {
+    // The preparse thread must be done with the preprocess CP state before the CPU thread uses it.
+    DiscardPrefetch();
     m_use_deterministic_gpu_thread = gpu_thread;
     if (gpu_thread)
     {
@@ -540,8 +837,12 @@ void FifoManager::UpdateWantDeterminism(bool want)
  * @ticks The gone emulated CPU time.
  * @return A good time to call WaitForGpuThread() next.
  */
-int FifoManager::WaitForGpuThread(int ticks)
+int FifoManager::WaitForGpuThread(int ticks, std::optional<SyncGPUReason> reason)
 {
+  if (m_config_sync_gpu_adaptive)
+    UpdateAdaptiveSyncDistance(ticks);
+  const int max_distance = m_sync_max_distance.load(std::memory_order_relaxed);
+
   int old = m_sync_ticks.fetch_add(ticks);
   int now = old + ticks;
 
@@ -558,12 +859,116 @@ int FifoManager::WaitForGpuThread(int ticks)
     return GPU_TIME_SLOT_SIZE + m_config_sync_gpu_min_distance - now;
 
   // Wait for GPU
-  if (now >= m_config_sync_gpu_max_distance)
+  if (now >= max_distance)
+  {
+    const FrameTimeReport::CauseScope stutter_scope(StutterCause::GPUThreadDistance);
+    const TimePoint start = Clock::now();
     m_sync_wakeup_event.Wait();
+    const DT stall_time = Clock::now() - start;
+
+    // Waits while the game reads back GPU state are already counted under their reason, and
+    // aren't a sign that the GPU thread could be given more room.
+    if (reason)
+    {
+      m_sync_stats[static_cast<size_t>(*reason)].stall_time += stall_time;
+    }
+    else
+    {
+      ++m_distance_stats.count;
+      m_distance_stats.stall_time += stall_time;
+      m_adaptive_window_stall += stall_time;
+    }
+  }
 
   return GPU_TIME_SLOT_SIZE;
 }
 
+void FifoManager::NoteGPUReadback()
+{
+  if (m_config_sync_gpu_adaptive)
+  {
+    m_adaptive_window_readback_lag =
+        std::max(m_adaptive_window_readback_lag, m_sync_ticks.load(std::memory_order_relaxed));
+  }
+}
+
+// Lets the GPU thread fall further behind while that saves the CPU thread from waiting for it,
+// and returns to the configured distance as soon as the game reads back GPU state while the GPU
+// thread is further behind than that distance would have allowed.
+void FifoManager::UpdateAdaptiveSyncDistance(int ticks)
+{
+  m_adaptive_window_ticks += ticks;
+  if (m_adaptive_window_ticks < ADAPTIVE_WINDOW_TICKS)
+    return;
+
+  const TimePoint now = Clock::now();
+  const DT window_time = now - m_adaptive_window_start;
+  const int configured_distance = m_config_sync_gpu_max_distance;
+  const int distance = m_sync_max_distance.load(std::memory_order_relaxed);
+  int new_distance = distance;
+
+  if (m_adaptive_window_readback_lag > configured_distance)
+  {
+    new_distance = configured_distance;
+    m_adaptive_backoff = std::min(m_adaptive_backoff * 2, ADAPTIVE_MAX_BACKOFF);
+    m_adaptive_hold_windows = m_adaptive_backoff;
+  }
+  else if (m_adaptive_hold_windows != 0)
+  {
+    --m_adaptive_hold_windows;
+  }
+  else if (m_adaptive_window_stall * ADAPTIVE_STALL_DIVISOR > window_time)
+  {
+    const int step = std::max(distance / 4, GPU_TIME_SLOT_SIZE);
+    new_distance = static_cast<int>(
+        std::min<s64>(s64{distance} + step, GetAdaptiveDistanceLimit(configured_distance)));
+    m_adaptive_backoff = std::max(m_adaptive_backoff / 2, 1u);
+  }
+
+  if (new_distance != distance)
+  {
+    // Stored before the CPU thread adds its ticks, see RunGpuLoop.
+    m_sync_max_distance.store(new_distance);
+    DEBUG_LOG_FMT(VIDEO, "Sync GPU distance changed from {} to {}", distance, new_distance);
+  }
+
+  m_adaptive_window_ticks = 0;
+  m_adaptive_window_start = now;
+  m_adaptive_window_stall = DT::zero();
+  m_adaptive_window_readback_lag = 0;
+}
+
+void FifoManager::LogSyncStats() const
+{
+  static constexpr std::array<const char*, SYNC_GPU_REASON_COUNT> REASON_NAMES = {
+      "other", "wraparound", "EFB peek", "perf query", "bbox", "swap", "aux space",
+  };
+  static_assert(REASON_NAMES.back() != nullptr, "Every SyncGPUReason needs a name");
+
+  for (size_t i = 0; i < SYNC_GPU_REASON_COUNT; ++i)
+  {
+    const SyncStats& stats = m_sync_stats[i];
+    if (stats.count == 0)
+      continue;
+    INFO_LOG_FMT(VIDEO,
+                 "SyncGPU ({}): {} syncs, {} without waiting, {:.2f} ms waiting for the GPU thread",
+                 REASON_NAMES[i], stats.count, stats.skipped, DT_ms(stats.stall_time).count());
+  }
+
+  if (m_distance_stats.count != 0)
+  {
+    INFO_LOG_FMT(VIDEO, "GPU thread distance: {} waits, {:.2f} ms waiting for the GPU thread",
+                 m_distance_stats.count, DT_ms(m_distance_stats.stall_time).count());
+  }
+
+  if (m_config_sync_gpu_adaptive)
+  {
+    INFO_LOG_FMT(VIDEO, "Adaptive sync GPU distance: {} (configured {})",
+                 m_sync_max_distance.load(std::memory_order_relaxed),
+                 m_config_sync_gpu_max_distance);
+  }
+}
+
 void FifoManager::SyncGPUCallback(Core::System& system, u64 ticks, s64 cyclesLate)
 {
   ticks += cyclesLate;
@@ -586,12 +991,23 @@ void FifoManager::SyncGPUCallback(Core::System& system, u64 ticks, s64 cyclesLat
 
 void FifoManager::SyncGPUForRegisterAccess()
 {
-  SyncGPU(SyncGPUReason::Other);
+  // The CP state is kept by the CPU thread in deterministic GPU thread mode, so the GPU thread only
+  // has to catch up if the game might go on to read what it copies to RAM.
+  if (!m_use_deterministic_gpu_thread ||
+      m_pending_gpu_dependencies[static_cast<size_t>(GPUDependency::MemoryWrite)])
+  {
+    SyncGPU(SyncGPUReason::Other);
+  }
 
   if (!m_system.IsDualCoreMode() || m_use_deterministic_gpu_thread)
+  {
     RunGpuOnCpu(GPU_TIME_SLOT_SIZE);
+  }
   else if (m_config_sync_gpu)
-    WaitForGpuThread(GPU_TIME_SLOT_SIZE);
+  {
+    NoteGPUReadback();
+    WaitForGpuThread(GPU_TIME_SLOT_SIZE, SyncGPUReason::Other);
+  }
 }
 
 // Initialize GPU - CPU thread syncing, this gives us a deterministic way to start the GPU thread.
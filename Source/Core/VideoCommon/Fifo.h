@@ -3,15 +3,19 @@
 
 #pragma once
 
+#include <array>
 #include <atomic>
 #include <cstddef>
 #include <optional>
+#include <vector>
 
+#include "Common/BitSet.h"
 #include "Common/BlockingLoop.h"
 #include "Common/CommonTypes.h"
 #include "Common/Config/Config.h"
 #include "Common/Event.h"
 #include "Common/Flag.h"
+#include "Common/WorkQueueThread.h"
 
 class PointerWrap;
 
@@ -23,21 +27,39 @@ namespace CoreTiming
 {
 struct EventType;
 }
+namespace OpcodeDecoder
+{
+struct PreparsedCommand;
+}
 
 namespace Fifo
 {
-// Used for diagnostics.
+// Used for diagnostics, and to tell which readbacks don't need to wait for the GPU thread in
+// deterministic GPU thread mode, see GPUDependency.
 enum class SyncGPUReason
 {
   Other,
   Wraparound,
-  EFBPoke,
+  EFBPeek,
   PerfQuery,
   BBox,
   Swap,
   AuxSpace,
 };
 
+// GPU state that the CPU can observe. In deterministic GPU thread mode, the CPU thread notes which
+// of it the commands it has preprocessed can change, and only waits for the GPU thread to execute
+// them before reading back state that they change.
+enum class GPUDependency
+{
+  // Drawing, clearing and changing the pixel format.
+  EFB,
+  BoundingBox,
+  PerfQuery,
+  // EFB copies to RAM, which the CPU may read once it has seen the CP go idle.
+  MemoryWrite,
+};
+
 class FifoManager final
 {
 public:
@@ -64,6 +86,12 @@ public:
   // In dual core mode, this synchronizes with the GPU thread.
   void SyncGPUForRegisterAccess();
 
+  // Called by the preprocessor in deterministic GPU thread mode.
+  void AddPendingGPUDependencies(BitSet32 dependencies)
+  {
+    m_pending_gpu_dependencies |= dependencies;
+  }
+
   void PushFifoAuxBuffer(const void* ptr, size_t size);
   void* PopFifoAuxBuffer(size_t size);
 
@@ -76,14 +104,44 @@ public:
   void ResetVideoBuffer();
 
 private:
+  // A range of FIFO chunks for the preparse thread to copy into the video buffer and frame.
+  struct PrefetchRequest
+  {
+    u32 read_ptr;
+    u32 count;
+    u8* dst;
+    u32 base;
+    u32 end;
+  };
+
   void RefreshConfig();
   void ReadDataFromFifo(u32 read_ptr);
   void ReadDataFromFifoOnCPU(u32 read_ptr);
+  void ReadPreparsedDataFromFifo(u32 read_ptr);
+  u8* RunPreparsedFifo(u8* write_ptr, u32* cycles);
+  void StartPrefetch(u32 count);
+  void WaitForPrefetch();
+  void DiscardPrefetch();
+  void PrefetchFifo(const PrefetchRequest& request);
   int RunGpuOnCpu(int ticks);
-  int WaitForGpuThread(int ticks);
+  int WaitForGpuThread(int ticks, std::optional<SyncGPUReason> reason = std::nullopt);
+  void NoteGPUReadback();
+  void UpdateAdaptiveSyncDistance(int ticks);
+  static int GetAdaptiveDistanceLimit(int configured_distance);
+  void LogSyncStats() const;
   static void SyncGPUCallback(Core::System& system, u64 ticks, s64 cyclesLate);
 
   static constexpr u32 FIFO_SIZE = 2 * 1024 * 1024;
+  static constexpr size_t SYNC_GPU_REASON_COUNT = static_cast<size_t>(SyncGPUReason::AuxSpace) + 1;
+
+  struct SyncStats
+  {
+    u64 count = 0;
+    // Syncs that didn't have to wait since no pending command changed the state being read.
+    u64 skipped = 0;
+    // Time the CPU thread spent waiting for the GPU thread.
+    DT stall_time{};
+  };
 
   Common::BlockingLoop m_gpu_mainloop;
 
@@ -118,15 +176,52 @@ private:
   // polls, it's just atomic.
   // - The pp_read_ptr is the CPU preprocessing version of the read_ptr.
 
+  // With the preparse thread, FIFO chunks are copied to the video buffer and framed into
+  // m_preparsed_commands ahead of the GPU thread, which then only has to execute them. Data past
+  // m_video_buffer_write_ptr belongs to chunks the GPU thread hasn't read from the FIFO yet, and is
+  // dropped whenever the FIFO read pointer doesn't continue where the prefetch left off.
+  bool m_use_preparse_thread = false;
+  Common::WorkQueueThread<PrefetchRequest> m_preparse_thread;
+  std::vector<OpcodeDecoder::PreparsedCommand> m_preparsed_commands;
+  size_t m_next_preparsed_command = 0;
+  u32 m_ready_chunks = 0;
+  u32 m_in_flight_chunks = 0;
+  u8* m_prefetch_write_ptr = nullptr;
+  bool m_prefetch_valid = false;
+  u32 m_prefetch_next_chunk = 0;
+  u32 m_prefetch_read_ptr = 0;
+  u32 m_prefetch_base = 0;
+  u32 m_prefetch_end = 0;
+  // Owned by the preparse thread while a prefetch is in flight.
+  std::vector<OpcodeDecoder::PreparsedCommand> m_prefetched_commands;
+  u8* m_preparse_ptr = nullptr;
+
   std::atomic<int> m_sync_ticks = 0;
   bool m_syncing_suspended = false;
   Common::Event m_sync_wakeup_event;
+  // The distance at which the CPU thread waits for the GPU thread. Only written by the CPU
+  // thread, and only differs from the configured one with MAIN_SYNC_GPU_ADAPTIVE.
+  std::atomic<int> m_sync_max_distance = 0;
+
+  // Owned by the CPU thread.
+  // The GPUDependency bits of the commands given to the GPU thread since it was last waited for.
+  BitSet32 m_pending_gpu_dependencies;
+  std::array<SyncStats, SYNC_GPU_REASON_COUNT> m_sync_stats{};
+  SyncStats m_distance_stats;
+  s64 m_adaptive_window_ticks = 0;
+  TimePoint m_adaptive_window_start{};
+  DT m_adaptive_window_stall{};
+  // The largest distance the GPU thread was behind when the game read back GPU state.
+  int m_adaptive_window_readback_lag = 0;
+  u32 m_adaptive_hold_windows = 0;
+  u32 m_adaptive_backoff = 1;
 
   std::optional<Config::ConfigChangedCallbackID> m_config_callback_id = std::nullopt;
   bool m_config_sync_gpu = false;
   int m_config_sync_gpu_max_distance = 0;
   int m_config_sync_gpu_min_distance = 0;
   float m_config_sync_gpu_overclock = 0.0f;
+  bool m_config_sync_gpu_adaptive = false;
 
   Core::System& m_system;
 };
@@ -62,13 +62,14 @@ void FrameDumper::DumpCurrentFrame(const AbstractTexture* src_texture,
     copy_rect = src_texture->GetRect();
   }
 
-  if (!CheckFrameDumpReadbackTexture(target_width, target_height))
+  std::unique_ptr<AbstractStagingTexture> readback_texture =
+      GetFrameDumpReadbackTexture(target_width, target_height);
+  if (!readback_texture)
     return;
 
-  m_frame_dump_readback_texture->CopyFromTexture(src_texture, copy_rect, 0, 0,
-                                                 m_frame_dump_readback_texture->GetRect());
-  m_last_frame_state = m_ffmpeg_dump.FetchState(ticks, frame_number);
-  m_frame_dump_needs_flush = true;
+  readback_texture->CopyFromTexture(src_texture, copy_rect, 0, 0, readback_texture->GetRect());
+  m_frame_dump_pending_readbacks.push_back(
+      {std::move(readback_texture), m_ffmpeg_dump.FetchState(ticks, frame_number)});
 }
 
 bool FrameDumper::CheckFrameDumpRenderTexture(u32 target_width, u32 target_height)
@@ -99,57 +100,72 @@ bool FrameDumper::CheckFrameDumpRenderTexture(u32 target_width, u32 target_heigh
   return true;
 }
 
-bool FrameDumper::CheckFrameDumpReadbackTexture(u32 target_width, u32 target_height)
+std::unique_ptr<AbstractStagingTexture>
+FrameDumper::GetFrameDumpReadbackTexture(u32 target_width, u32 target_height)
 {
-  std::unique_ptr<AbstractStagingTexture>& rbtex = m_frame_dump_readback_texture;
-  if (rbtex && rbtex->GetWidth() == target_width && rbtex->GetHeight() == target_height)
-    return true;
-
-  rbtex.reset();
-  rbtex = g_gfx->CreateStagingTexture(StagingTextureType::Readback,
-                                      TextureConfig(target_width, target_height, 1, 1, 1,
-                                                    AbstractTextureFormat::RGBA8, 0,
-                                                    AbstractTextureType::Texture_2DArray));
-  if (!rbtex)
-    return false;
+  // Textures of a different size are left over from a resolution change and can be dropped.
+  auto& free_textures = m_frame_dump_free_readback_textures;
+  while (!free_textures.empty())
+  {
+    std::unique_ptr<AbstractStagingTexture> rbtex = std::move(free_textures.back());
+    free_textures.pop_back();
+    if (rbtex->GetWidth() == target_width && rbtex->GetHeight() == target_height)
+      return rbtex;
+  }
 
-  return true;
+  return g_gfx->CreateStagingTexture(StagingTextureType::Readback,
+                                     TextureConfig(target_width, target_height, 1, 1, 1,
+                                                   AbstractTextureFormat::RGBA8, 0,
+                                                   AbstractTextureType::Texture_2DArray));
 }
 
 void FrameDumper::FlushFrameDump()
 {
-  if (!m_frame_dump_needs_flush)
+  if (m_frame_dump_pending_readbacks.empty())
     return;
 
-  // Ensure dumping thread is done with output texture before swapping.
-  FinishFrameData();
+  // Screenshots and the end of frame dumping need every queued frame, otherwise only map the
+  // oldest readbacks, which the GPU has most likely finished by now.
+  FlushFrameDumpReadbacks(!Config::Get(Config::MAIN_MOVIE_DUMP_FRAMES) ||
+                          m_screenshot_request.IsSet());
 
-  std::swap(m_frame_dump_output_texture, m_frame_dump_readback_texture);
+  // Shutdown frame dumping if it is no longer active.
+  if (!IsFrameDumping())
+    ShutdownFrameDumping();
+}
 
-  // Queue encoding of the last frame dumped.
-  auto& output = m_frame_dump_output_texture;
-  output->Flush();
-  if (output->Map())
-  {
-    DumpFrameData(reinterpret_cast<u8*>(output->GetMappedPointer()), output->GetConfig().width,
-                  output->GetConfig().height, static_cast<int>(output->GetMappedStride()));
-  }
-  else
+void FrameDumper::FlushFrameDumpReadbacks(bool flush_all)
+{
+  while (!m_frame_dump_pending_readbacks.empty() &&
+         (flush_all || m_frame_dump_pending_readbacks.size() >= FRAME_DUMP_READBACK_DEPTH))
   {
-    ERROR_LOG_FMT(VIDEO, "Failed to map texture for dumping.");
-  }
+    // Ensure dumping thread is done with output texture before replacing it.
+    FinishFrameData();
 
-  m_frame_dump_needs_flush = false;
+    PendingReadback readback = std::move(m_frame_dump_pending_readbacks.front());
+    m_frame_dump_pending_readbacks.pop_front();
+    m_frame_dump_output_texture = std::move(readback.texture);
 
-  // Shutdown frame dumping if it is no longer active.
-  if (!IsFrameDumping())
-    ShutdownFrameDumping();
+    // Queue encoding of the oldest frame dumped.
+    auto& output = m_frame_dump_output_texture;
+    output->Flush();
+    if (output->Map())
+    {
+      DumpFrameData(reinterpret_cast<u8*>(output->GetMappedPointer()), output->GetConfig().width,
+                    output->GetConfig().height, static_cast<int>(output->GetMappedStride()),
+                    readback.state);
+    }
+    else
+    {
+      ERROR_LOG_FMT(VIDEO, "Failed to map texture for dumping.");
+    }
+  }
 }
 
 void FrameDumper::ShutdownFrameDumping()
 {
-  // Ensure the last queued readback has been sent to the encoder.
-  FlushFrameDump();
+  // Ensure the queued readbacks have been sent to the encoder.
+  FlushFrameDumpReadbacks(true);
 
   if (!m_frame_dump_thread_running.IsSet())
     return;
@@ -165,13 +181,14 @@ void FrameDumper::ShutdownFrameDumping()
   m_frame_dump_render_framebuffer.reset();
   m_frame_dump_render_texture.reset();
 
-  m_frame_dump_readback_texture.reset();
+  m_frame_dump_pending_readbacks.clear();
+  m_frame_dump_free_readback_textures.clear();
   m_frame_dump_output_texture.reset();
 }
 
-void FrameDumper::DumpFrameData(const u8* data, int w, int h, int stride)
+void FrameDumper::DumpFrameData(const u8* data, int w, int h, int stride, const FrameState& state)
 {
-  m_frame_dump_data = FrameData{data, w, h, stride, m_last_frame_state};
+  m_frame_dump_data = FrameData{data, w, h, stride, state};
 
   if (!m_frame_dump_thread_running.IsSet())
   {
@@ -195,6 +212,7 @@ void FrameDumper::FinishFrameData()
   m_frame_dump_frame_running = false;
 
   m_frame_dump_output_texture->Unmap();
+  m_frame_dump_free_readback_textures.push_back(std::move(m_frame_dump_output_texture));
 }
 
 void FrameDumper::FrameDumpThreadFunc()
@@ -3,6 +3,10 @@
 
 #pragma once
 
+#include <deque>
+#include <memory>
+#include <vector>
+
 #include "Common/CommonTypes.h"
 #include "Common/Event.h"
 #include "Common/Flag.h"
@@ -49,14 +53,18 @@ private:
 
   void ShutdownFrameDumping();
 
+  // Queues encoding of pending readbacks, leaving the most recent ones in flight unless flush_all.
+  void FlushFrameDumpReadbacks(bool flush_all);
+
   // Checks that the frame dump render texture exists and is the correct size.
   bool CheckFrameDumpRenderTexture(u32 target_width, u32 target_height);
 
-  // Checks that the frame dump readback texture exists and is the correct size.
-  bool CheckFrameDumpReadbackTexture(u32 target_width, u32 target_height);
+  // Returns an unused readback texture of the correct size, creating one if needed.
+  std::unique_ptr<AbstractStagingTexture> GetFrameDumpReadbackTexture(u32 target_width,
+                                                                      u32 target_height);
 
   // Asynchronously encodes the specified pointer of frame data to the frame dump.
-  void DumpFrameData(const u8* data, int w, int h, int stride);
+  void DumpFrameData(const u8* data, int w, int h, int stride, const FrameState& state);
 
   // Ensures all encoded frames have been written to the output file.
   void FinishFrameData();
@@ -70,9 +78,6 @@ private:
   // Set by frame dump thread on frame completion.
   Common::Event m_frame_dump_done;
 
-  // Holds emulation state during the last swap when dumping.
-  FrameState m_last_frame_state;
-
   // Communication of frame between video and dump threads.
   FrameData m_frame_dump_data;
 
@@ -80,11 +85,21 @@ private:
   std::unique_ptr<AbstractTexture> m_frame_dump_render_texture;
   std::unique_ptr<AbstractFramebuffer> m_frame_dump_render_framebuffer;
 
-  // Double buffer:
-  std::unique_ptr<AbstractStagingTexture> m_frame_dump_readback_texture;
+  // Number of frames that may be waiting for their readback to complete while dumping.
+  // Mapping a readback at the end of the frame that issued the copy would stall the GPU thread
+  // until the GPU caught up, so frames are only mapped once this many are queued.
+  static constexpr size_t FRAME_DUMP_READBACK_DEPTH = 3;
+
+  struct PendingReadback
+  {
+    std::unique_ptr<AbstractStagingTexture> texture;
+    // Emulation state during the swap which was copied to the texture.
+    FrameState state;
+  };
+  std::deque<PendingReadback> m_frame_dump_pending_readbacks;
+  std::vector<std::unique_ptr<AbstractStagingTexture>> m_frame_dump_free_readback_textures;
+  // Mapped texture that is being encoded by the dump thread.
   std::unique_ptr<AbstractStagingTexture> m_frame_dump_output_texture;
-  // Set when readback texture holds a frame that needs to be dumped.
-  bool m_frame_dump_needs_flush = false;
   // Set when thread is processing output texture.
   bool m_frame_dump_frame_running = false;
 
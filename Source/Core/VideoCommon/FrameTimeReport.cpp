@@ -0,0 +1,268 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "VideoCommon/FrameTimeReport.h"
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <iterator>
+#include <utility>
+
+#include <fmt/format.h>
+
+#include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
+
+FrameTimeReport g_frame_time_report;
+
+namespace
+{
+constexpr std::array<const char*, static_cast<size_t>(StutterCause::Count)> CAUSE_NAMES = {
+    "JIT compilation",
+    "Shader compilation",
+    "Texture load",
+    "DVD read",
+    "Savestate",
+    "GPU thread distance",
+    "SyncGPU (other)",
+    "SyncGPU (wraparound)",
+    "SyncGPU (EFB peek)",
+    "SyncGPU (perf query)",
+    "SyncGPU (bbox)",
+    "SyncGPU (swap)",
+    "SyncGPU (aux space)",
+    "Audio backpressure",
+};
+
+double ToMs(DT time)
+{
+  return DT_ms(time).count();
+}
+}  // namespace
+
+void FrameTimeReport::Start()
+{
+  std::lock_guard lk(m_lock);
+  for (auto& time : m_frame_cause_ns)
+    time.store(0, std::memory_order_relaxed);
+  for (auto& flags : m_frame_cause_flags)
+    flags.store(0, std::memory_order_relaxed);
+
+  m_last_frame = TimePoint{};
+  m_histogram.fill(0);
+  m_frame_count = 0;
+  m_total_frame_time = DT::zero();
+  m_max_frame_time = DT::zero();
+  m_stutter_frames = 0;
+  m_unattributed_stutter_frames = 0;
+  m_cause_totals.fill({});
+  m_worst_frames.clear();
+
+  m_enabled.store(true, std::memory_order_relaxed);
+}
+
+bool FrameTimeReport::StopAndWrite(const std::string& path)
+{
+  if (!m_enabled.exchange(false, std::memory_order_relaxed))
+    return false;
+
+  std::string report;
+  {
+    std::lock_guard lk(m_lock);
+    if (m_frame_count == 0)
+      return false;
+    report = FormatReport();
+  }
+
+  File::IOFile file(path, "w");
+  if (!file || !file.WriteString(report))
+  {
+    ERROR_LOG_FMT(VIDEO, "Failed to write the frame time report to {}", path);
+    return false;
+  }
+
+  INFO_LOG_FMT(VIDEO, "Wrote the frame time report to {}", path);
+  return true;
+}
+
+void FrameTimeReport::CountFrame()
+{
+  if (!IsEnabled())
+    return;
+
+  std::array<DT, CAUSE_COUNT> cause_times;
+  std::array<u32, CAUSE_COUNT> cause_flags;
+  for (size_t i = 0; i < CAUSE_COUNT; ++i)
+  {
+    cause_times[i] = std::chrono::duration_cast<DT>(
+        std::chrono::nanoseconds(m_frame_cause_ns[i].exchange(0, std::memory_order_relaxed)));
+    cause_flags[i] = m_frame_cause_flags[i].exchange(0, std::memory_order_relaxed);
+  }
+
+  const TimePoint now = Clock::now();
+  std::lock_guard lk(m_lock);
+
+  for (size_t i = 0; i < CAUSE_COUNT; ++i)
+  {
+    m_cause_totals[i].total_time += cause_times[i];
+    m_cause_totals[i].flags += cause_flags[i];
+  }
+
+  const TimePoint last_frame = std::exchange(m_last_frame, now);
+  if (last_frame == TimePoint{})
+    return;
+
+  const DT frame_time = now - last_frame;
+  const u64 frame_time_us =
+      std::chrono::duration_cast<std::chrono::microseconds>(frame_time).count();
+  const bool judge = m_frame_count >= WARMUP_FRAMES;
+  const u64 median_us = judge ? GetPercentileUs(0.5) : 0;
+
+  ++m_histogram[GetBucket(frame_time_us)];
+  ++m_frame_count;
+  m_total_frame_time += frame_time;
+  m_max_frame_time = std::max(m_max_frame_time, frame_time);
+
+  if (!judge || frame_time_us <= median_us * STUTTER_FACTOR)
+    return;
+
+  ++m_stutter_frames;
+
+  // Blame the cause that took the most time, or failing that, one that was flagged.
+  const auto longest = std::max_element(cause_times.begin(), cause_times.end());
+  const auto flagged =
+      std::find_if(cause_flags.begin(), cause_flags.end(), [](u32 flags) { return flags != 0; });
+  size_t cause = CAUSE_COUNT;
+  if (*longest > DT::zero())
+    cause = static_cast<size_t>(longest - cause_times.begin());
+  else if (flagged != cause_flags.end())
+    cause = static_cast<size_t>(flagged - cause_flags.begin());
+
+  for (size_t i = 0; i < CAUSE_COUNT; ++i)
+    m_cause_totals[i].stutter_time += cause_times[i];
+
+  if (cause == CAUSE_COUNT)
+    ++m_unattributed_stutter_frames;
+  else
+    ++m_cause_totals[cause].stutter_frames;
+
+  AddWorstFrame({m_frame_count, frame_time, static_cast<StutterCause>(cause), cause_times});
+}
+
+void FrameTimeReport::AddCauseTime(StutterCause cause, DT time)
+{
+  m_frame_cause_ns[static_cast<size_t>(cause)].fetch_add(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(time).count(),
+      std::memory_order_relaxed);
+}
+
+void FrameTimeReport::FlagCause(StutterCause cause)
+{
+  if (IsEnabled())
+    m_frame_cause_flags[static_cast<size_t>(cause)].fetch_add(1, std::memory_order_relaxed);
+}
+
+FrameTimeReport::CauseScope::CauseScope(StutterCause cause) : m_cause(cause)
+{
+  if (g_frame_time_report.IsEnabled())
+    m_start = Clock::now();
+}
+
+FrameTimeReport::CauseScope::~CauseScope()
+{
+  if (m_start != TimePoint{})
+    g_frame_time_report.AddCauseTime(m_cause, Clock::now() - m_start);
+}
+
+size_t FrameTimeReport::GetBucket(u64 us)
+{
+  if (us < 2 * SUB_BUCKETS)
+    return static_cast<size_t>(us);
+
+  const u32 msb = std::min<u32>(std::bit_width(us) - 1, MAX_EXPONENT);
+  const u32 shift = msb - SUB_BUCKET_BITS;
+  const u64 mantissa = std::min<u64>(us >> shift, 2 * SUB_BUCKETS - 1);
+  return static_cast<size_t>(shift * SUB_BUCKETS + mantissa);
+}
+
+u64 FrameTimeReport::GetBucketMidpoint(size_t bucket)
+{
+  if (bucket < 2 * SUB_BUCKETS)
+    return bucket;
+
+  const u32 shift = static_cast<u32>(bucket / SUB_BUCKETS) - 1;
+  const u64 lower = (bucket % SUB_BUCKETS + SUB_BUCKETS) << shift;
+  return lower + ((u64{1} << shift) >> 1);
+}
+
+u64 FrameTimeReport::GetPercentileUs(double percentile) const
+{
+  const u64 rank = std::max<u64>(1, static_cast<u64>(percentile * m_frame_count + 0.5));
+  u64 seen = 0;
+  for (size_t i = 0; i < BUCKET_COUNT; ++i)
+  {
+    seen += m_histogram[i];
+    if (seen >= rank)
+      return GetBucketMidpoint(i);
+  }
+  return GetBucketMidpoint(BUCKET_COUNT - 1);
+}
+
+void FrameTimeReport::AddWorstFrame(const WorstFrame& frame)
+{
+  const auto by_time = [](const WorstFrame& a, const WorstFrame& b) {
+    return a.frame_time > b.frame_time;
+  };
+  if (m_worst_frames.size() == WORST_FRAME_COUNT)
+  {
+    if (frame.frame_time <= m_worst_frames.back().frame_time)
+      return;
+    m_worst_frames.pop_back();
+  }
+  m_worst_frames.insert(
+      std::upper_bound(m_worst_frames.begin(), m_worst_frames.end(), frame, by_time), frame);
+}
+
+std::string FrameTimeReport::FormatReport() const
+{
+  std::string out;
+  const auto it = std::back_inserter(out);
+
+  fmt::format_to(it, "Frames: {}\n", m_frame_count);
+  fmt::format_to(it, "Mean: {:.2f} ms, max: {:.2f} ms\n",
+                 ToMs(m_total_frame_time) / m_frame_count, ToMs(m_max_frame_time));
+  fmt::format_to(it, "p50: {:.2f} ms, p90: {:.2f} ms, p99: {:.2f} ms, p99.9: {:.2f} ms\n",
+                 GetPercentileUs(0.5) / 1000.0, GetPercentileUs(0.9) / 1000.0,
+                 GetPercentileUs(0.99) / 1000.0, GetPercentileUs(0.999) / 1000.0);
+  fmt::format_to(it, "Stutter frames (over {}x the median): {}, unattributed: {}\n\n",
+                 STUTTER_FACTOR, m_stutter_frames, m_unattributed_stutter_frames);
+
+  fmt::format_to(it, "{:<22} {:>9} {:>14} {:>16} {:>8}\n", "Cause", "Stutters", "Total (ms)",
+                 "In stutters (ms)", "Flags");
+  for (size_t i = 0; i < CAUSE_COUNT; ++i)
+  {
+    const CauseTotals& totals = m_cause_totals[i];
+    if (totals.total_time == DT::zero() && totals.flags == 0)
+      continue;
+    fmt::format_to(it, "{:<22} {:>9} {:>14.2f} {:>16.2f} {:>8}\n", CAUSE_NAMES[i],
+                   totals.stutter_frames, ToMs(totals.total_time), ToMs(totals.stutter_time),
+                   totals.flags);
+  }
+
+  fmt::format_to(it, "\nWorst stutter frames:\n");
+  for (const WorstFrame& frame : m_worst_frames)
+  {
+    const size_t cause = static_cast<size_t>(frame.cause);
+    fmt::format_to(it, "  frame {}: {:.2f} ms, blamed on {}", frame.frame,
+                   ToMs(frame.frame_time),
+                   cause < CAUSE_COUNT ? CAUSE_NAMES[cause] : "nothing tagged");
+    for (size_t i = 0; i < CAUSE_COUNT; ++i)
+    {
+      if (frame.cause_times[i] != DT::zero())
+        fmt::format_to(it, ", {} {:.2f} ms", CAUSE_NAMES[i], ToMs(frame.cause_times[i]));
+    }
+    fmt::format_to(it, "\n");
+  }
+  return out;
+}
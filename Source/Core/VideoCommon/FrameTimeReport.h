@@ -0,0 +1,133 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+// Records a histogram of every frame time in a session, and attributes frames that take much
+// longer than usual to whatever was blocking emulation or the GPU thread during them.
+//
+// Subsystems tag the time they spend on things that are known to cause stutter with a CauseScope.
+// When the report isn't enabled, that costs a relaxed atomic load.
+enum class StutterCause
+{
+  JitCompile,
+  ShaderCompile,
+  TextureLoad,
+  DVDRead,
+  SaveState,
+  // Waits for the GPU thread when it's too far behind, with Sync GPU Thread enabled.
+  GPUThreadDistance,
+  // One for each Fifo::SyncGPUReason, in the same order.
+  SyncGPUOther,
+  SyncGPUWraparound,
+  SyncGPUEFBPeek,
+  SyncGPUPerfQuery,
+  SyncGPUBBox,
+  SyncGPUSwap,
+  SyncGPUAuxSpace,
+  // Samples dropped because the audio backend isn't consuming them. Nothing blocks on this, so
+  // it's only flagged, and only blamed for a frame when there is no timed cause.
+  AudioBackpressure,
+
+  Count,
+};
+
+class FrameTimeReport
+{
+public:
+  FrameTimeReport() = default;
+
+  FrameTimeReport(const FrameTimeReport&) = delete;
+  FrameTimeReport& operator=(const FrameTimeReport&) = delete;
+
+  void Start();
+  // Stops recording and writes the report to the given file. Returns false if nothing was
+  // recorded or the file couldn't be written.
+  bool StopAndWrite(const std::string& path);
+  bool IsEnabled() const { return m_enabled.load(std::memory_order_relaxed); }
+
+  // Called when a frame is presented.
+  void CountFrame();
+
+  void AddCauseTime(StutterCause cause, DT time);
+  void FlagCause(StutterCause cause);
+
+  class CauseScope
+  {
+  public:
+    explicit CauseScope(StutterCause cause);
+    ~CauseScope();
+
+    CauseScope(const CauseScope&) = delete;
+    CauseScope& operator=(const CauseScope&) = delete;
+
+  private:
+    StutterCause m_cause;
+    TimePoint m_start{};
+  };
+
+private:
+  static constexpr size_t CAUSE_COUNT = static_cast<size_t>(StutterCause::Count);
+
+  // Log-linear buckets of microseconds with 16 sub-buckets per power of two, which keeps
+  // percentiles within about 6% up to a minute.
+  static constexpr u32 SUB_BUCKET_BITS = 4;
+  static constexpr u32 SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+  static constexpr u32 MAX_EXPONENT = 26;
+  static constexpr size_t BUCKET_COUNT = (MAX_EXPONENT - SUB_BUCKET_BITS + 2) * SUB_BUCKETS;
+
+  // Frames are only judged once the median is meaningful.
+  static constexpr u64 WARMUP_FRAMES = 60;
+  static constexpr double STUTTER_FACTOR = 1.5;
+  static constexpr size_t WORST_FRAME_COUNT = 10;
+
+  struct CauseTotals
+  {
+    DT total_time{};
+    DT stutter_time{};
+    u64 flags = 0;
+    u64 stutter_frames = 0;
+  };
+
+  struct WorstFrame
+  {
+    u64 frame;
+    DT frame_time;
+    StutterCause cause;
+    std::array<DT, CAUSE_COUNT> cause_times;
+  };
+
+  static size_t GetBucket(u64 us);
+  static u64 GetBucketMidpoint(size_t bucket);
+
+  u64 GetPercentileUs(double percentile) const;
+  void AddWorstFrame(const WorstFrame& frame);
+  std::string FormatReport() const;
+
+  std::atomic<bool> m_enabled = false;
+
+  // Written by any thread, and swapped out whenever a frame ends.
+  std::array<std::atomic<s64>, CAUSE_COUNT> m_frame_cause_ns{};
+  std::array<std::atomic<u32>, CAUSE_COUNT> m_frame_cause_flags{};
+
+  mutable std::mutex m_lock;
+  TimePoint m_last_frame{};
+  std::array<u64, BUCKET_COUNT> m_histogram{};
+  u64 m_frame_count = 0;
+  DT m_total_frame_time{};
+  DT m_max_frame_time{};
+  u64 m_stutter_frames = 0;
+  u64 m_unattributed_stutter_frames = 0;
+  std::array<CauseTotals, CAUSE_COUNT> m_cause_totals{};
+  std::vector<WorstFrame> m_worst_frames;
+};
+
+extern FrameTimeReport g_frame_time_report;
@@ -3,8 +3,10 @@
 
 #include "VideoCommon/FramebufferManager.h"
 
+#include <algorithm>
 #include <fmt/format.h>
 #include <memory>
+#include <utility>
 
 #include "Common/ChunkFile.h"
 #include "Common/Logging/Log.h"
@@ -93,6 +95,7 @@ bool FramebufferManager::Initialize()
 void FramebufferManager::RecreateEFBFramebuffer()
 {
   FlushEFBPokes();
+  m_pending_reinterpret.reset();
   InvalidatePeekCache(true);
 
   DestroyReadbackFramebuffer();
@@ -315,6 +318,8 @@ void FramebufferManager::BindEFBFramebuffer()
 
 AbstractTexture* FramebufferManager::ResolveEFBColorTexture(const MathUtil::Rectangle<int>& region)
 {
+  ApplyPendingReinterpret();
+
   // Return the normal EFB texture if multisampling is off.
   if (!IsEFBMultisampled())
     return m_efb_color_texture.get();
@@ -382,6 +387,34 @@ bool FramebufferManager::ReinterpretPixelData(EFBReinterpretType convtype)
   if (!m_format_conversion_pipelines[static_cast<u32>(convtype)])
     return false;
 
+  // RGB8 and RGBA6 are both 24 bits, so converting between them and back is lossless. Drop the
+  // round trip instead of drawing it. Conversions involving RGB565 aren't, and are kept in order.
+  if (m_pending_reinterpret)
+  {
+    const EFBReinterpretType pending = *m_pending_reinterpret;
+    if ((pending == EFBReinterpretType::RGB8ToRGBA6 &&
+         convtype == EFBReinterpretType::RGBA6ToRGB8) ||
+        (pending == EFBReinterpretType::RGBA6ToRGB8 &&
+         convtype == EFBReinterpretType::RGB8ToRGBA6))
+    {
+      m_pending_reinterpret.reset();
+      return true;
+    }
+
+    DrawPendingReinterpret();
+  }
+
+  // Peeks have to see the converted data, even though it hasn't been drawn yet.
+  InvalidatePeekCache(true);
+  m_pending_reinterpret = convtype;
+  return true;
+}
+
+void FramebufferManager::DrawPendingReinterpret()
+{
+  const EFBReinterpretType convtype = *m_pending_reinterpret;
+  m_pending_reinterpret.reset();
+
   // Draw to the secondary framebuffer.
   // We don't discard here because discarding the framebuffer also throws away the depth
   // buffer, which we want to preserve. If we find this to be hindering performance in the
@@ -399,7 +432,6 @@ bool FramebufferManager::ReinterpretPixelData(EFBReinterpretType convtype)
   std::swap(m_efb_framebuffer, m_efb_convert_framebuffer);
   g_gfx->EndUtilityDrawing();
   InvalidatePeekCache(true);
-  return true;
 }
 
 bool FramebufferManager::CompileConversionPipelines()
@@ -480,9 +512,13 @@ u32 FramebufferManager::PeekEFBColor(u32 x, u32 y)
 
   u32 tile_index;
   if (!IsEFBCacheTilePresent(false, x, y, &tile_index))
+  {
+    PrefetchPredictedEFBTiles(false, tile_index);
     PopulateEFBCache(false, tile_index);
+  }
 
   m_efb_color_cache.tiles[tile_index].frame_access_mask |= 1;
+  RecordEFBPeek(false, tile_index);
 
   if (m_efb_color_cache.needs_flush)
   {
@@ -503,9 +539,13 @@ float FramebufferManager::PeekEFBDepth(u32 x, u32 y)
 
   u32 tile_index;
   if (!IsEFBCacheTilePresent(true, x, y, &tile_index))
+  {
+    PrefetchPredictedEFBTiles(true, tile_index);
     PopulateEFBCache(true, tile_index);
+  }
 
   m_efb_depth_cache.tiles[tile_index].frame_access_mask |= 1;
+  RecordEFBPeek(true, tile_index);
 
   if (m_efb_depth_cache.needs_flush)
   {
@@ -525,6 +565,8 @@ void FramebufferManager::SetEFBCacheTileSize(u32 size)
 
   InvalidatePeekCache(true);
   m_efb_cache_tile_size = size;
+  m_efb_peeks_this_frame.clear();
+  m_efb_peeks_last_frame.clear();
   DestroyReadbackFramebuffer();
   if (!CreateReadbackFramebuffer())
     PanicAlertFmt("Failed to create EFB readback framebuffers");
@@ -614,6 +656,45 @@ void FramebufferManager::EndOfFrame()
     m_efb_color_cache.tiles[i].frame_access_mask <<= 1;
     m_efb_depth_cache.tiles[i].frame_access_mask <<= 1;
   }
+
+  std::swap(m_efb_peeks_this_frame, m_efb_peeks_last_frame);
+  m_efb_peeks_this_frame.clear();
+}
+
+void FramebufferManager::RecordEFBPeek(bool depth, u32 tile_index)
+{
+  // Only record each tile once per draw. The records are in draw order, so any earlier record
+  // for this draw is at the end of the list.
+  const u32 draw_counter = g_vertex_manager->GetDrawCounter();
+  for (auto it = m_efb_peeks_this_frame.rbegin();
+       it != m_efb_peeks_this_frame.rend() && it->draw_counter == draw_counter; ++it)
+  {
+    if (it->tile_index == tile_index && it->depth == depth)
+      return;
+  }
+
+  m_efb_peeks_this_frame.push_back({draw_counter, tile_index, depth});
+}
+
+void FramebufferManager::PrefetchPredictedEFBTiles(bool depth, u32 tile_index)
+{
+  // Find the tiles which were peeked after the same number of draws in the previous frame.
+  const u32 draw_counter = g_vertex_manager->GetDrawCounter();
+  auto it = std::lower_bound(
+      m_efb_peeks_last_frame.begin(), m_efb_peeks_last_frame.end(), draw_counter,
+      [](const EFBPeekRecord& record, u32 value) { return record.draw_counter < value; });
+
+  // Queue the readbacks in the same command buffer as the upcoming synchronous one, so that the
+  // remaining peeks only have to wait for that submission to complete.
+  for (; it != m_efb_peeks_last_frame.end() && it->draw_counter == draw_counter; ++it)
+  {
+    if (it->depth == depth && it->tile_index == tile_index)
+      continue;
+
+    const EFBCacheData& data = it->depth ? m_efb_depth_cache : m_efb_color_cache;
+    if (it->tile_index < data.tiles.size() && !data.tiles[it->tile_index].present)
+      PopulateEFBCache(it->depth, it->tile_index, true);
+  }
 }
 
 bool FramebufferManager::CompileReadbackPipelines()
@@ -783,6 +864,8 @@ void FramebufferManager::DestroyReadbackFramebuffer()
 void FramebufferManager::PopulateEFBCache(bool depth, u32 tile_index, bool async)
 {
   FlushEFBPokes();
+  if (!depth)
+    ApplyPendingReinterpret();
   g_vertex_manager->OnCPUEFBAccess();
 
   // Force the path through the intermediate texture, as we can't do an image copy from a depth
@@ -877,6 +960,20 @@ void FramebufferManager::ClearEFB(const MathUtil::Rectangle<int>& rc, bool color
     color &= 0x00FFFFFF;
   }
 
+  // A clear of all of the color in the EFB makes a pending reinterpretation redundant.
+  if (m_pending_reinterpret)
+  {
+    if (color_enable && alpha_enable && rc.left <= 0 && rc.top <= 0 &&
+        rc.right >= static_cast<int>(EFB_WIDTH) && rc.bottom >= static_cast<int>(EFB_HEIGHT))
+    {
+      m_pending_reinterpret.reset();
+    }
+    else
+    {
+      ApplyPendingReinterpret();
+    }
+  }
+
   g_gfx->ClearRegion(target_rc, color_enable, alpha_enable, z_enable, color, z);
 
   // Scissor rect must be restored.
@@ -1011,6 +1108,7 @@ void FramebufferManager::FlushEFBPokes()
 {
   if (!m_color_poke_vertices.empty())
   {
+    ApplyPendingReinterpret();
     DrawPokeVertices(m_color_poke_vertices.data(), static_cast<u32>(m_color_poke_vertices.size()),
                      m_color_poke_pipeline.get());
     m_color_poke_vertices.clear();
@@ -1102,6 +1200,7 @@ void FramebufferManager::DestroyPokePipelines()
 void FramebufferManager::DoState(PointerWrap& p)
 {
   FlushEFBPokes();
+  ApplyPendingReinterpret();
   p.Do(m_prev_efb_format);
 
   bool save_efb_state = Config::Get(Config::GFX_SAVE_TEXTURE_CACHE_TO_STATE);
@@ -7,6 +7,7 @@
 #include <memory>
 #include <optional>
 #include <tuple>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/EnumFormatter.h"
@@ -102,9 +103,18 @@ public:
                                           bool force_r32f = false);
 
   // Reinterpret pixel format of EFB color texture.
+  // The conversion is deferred until the EFB color is next drawn to or read, so a format change
+  // which is undone before then, or which is followed by a full clear, doesn't cost a pass.
+  bool ReinterpretPixelData(EFBReinterpretType convtype);
+
+  // Performs a deferred reinterpretation, if there is one.
   // Assumes no render pass is currently in progress.
   // Swaps EFB framebuffers, so re-bind afterwards.
-  bool ReinterpretPixelData(EFBReinterpretType convtype);
+  void ApplyPendingReinterpret()
+  {
+    if (m_pending_reinterpret) [[unlikely]]
+      DrawPendingReinterpret();
+  }
   PixelFormat GetPrevPixelFormat() const { return m_prev_efb_format; }
   void StorePixelFormat(PixelFormat new_format) { m_prev_efb_format = new_format; }
 
@@ -160,9 +170,18 @@ protected:
     bool needs_flush;
   };
 
+  // A tile which was peeked after the given number of draws in a frame.
+  struct EFBPeekRecord
+  {
+    u32 draw_counter;
+    u32 tile_index;
+    bool depth;
+  };
+
   bool CreateEFBFramebuffer();
   void DestroyEFBFramebuffer();
 
+  void DrawPendingReinterpret();
   bool CompileConversionPipelines();
   void DestroyConversionPipelines();
 
@@ -182,6 +201,8 @@ protected:
   bool IsEFBCacheTilePresent(bool depth, u32 x, u32 y, u32* tile_index) const;
   MathUtil::Rectangle<int> GetEFBCacheTileRect(u32 tile_index) const;
   void PopulateEFBCache(bool depth, u32 tile_index, bool async = false);
+  void RecordEFBPeek(bool depth, u32 tile_index);
+  void PrefetchPredictedEFBTiles(bool depth, u32 tile_index);
 
   void CreatePokeVertices(std::vector<EFBPokeVertex>* destination_list, u32 x, u32 y, float z,
                           u32 color);
@@ -196,6 +217,7 @@ protected:
 
   float m_efb_scale = 1.0f;
   PixelFormat m_prev_efb_format;
+  std::optional<EFBReinterpretType> m_pending_reinterpret;
 
   std::unique_ptr<AbstractTexture> m_efb_color_texture;
   std::unique_ptr<AbstractTexture> m_efb_convert_color_texture;
@@ -227,6 +249,12 @@ protected:
   EFBCacheData m_efb_color_cache = {};
   EFBCacheData m_efb_depth_cache = {};
 
+  // Tiles peeked in the current and the previous frame, in draw order. When a peek misses the
+  // cache, the tiles which were peeked after the same draw in the previous frame are read back
+  // along with it, so that scattered peeks (e.g. lens flare visibility tests) only stall once.
+  std::vector<EFBPeekRecord> m_efb_peeks_this_frame;
+  std::vector<EFBPeekRecord> m_efb_peeks_last_frame;
+
   // EFB clear pipelines
   // Indexed by [color_write_enabled][alpha_write_enabled][depth_write_enabled]
   std::array<std::array<std::array<std::unique_ptr<AbstractPipeline>, 2>, 2>, 2> m_clear_pipelines;
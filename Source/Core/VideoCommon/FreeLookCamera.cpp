@@ -45,16 +45,19 @@ public:
   void MoveVertical(float amt) override
   {
     m_mat = Common::Matrix44::Translate(Common::Vec3{0, amt, 0}) * m_mat;
+    SetDirty();
   }
 
   void MoveHorizontal(float amt) override
   {
     m_mat = Common::Matrix44::Translate(Common::Vec3{amt, 0, 0}) * m_mat;
+    SetDirty();
   }
 
   void MoveForward(float amt) override
   {
     m_mat = Common::Matrix44::Translate(Common::Vec3{0, 0, amt}) * m_mat;
+    SetDirty();
   }
 
   void Rotate(const Common::Vec3& amt) override { Rotate(Common::Quaternion::RotateXYZ(amt)); }
@@ -62,6 +65,7 @@ public:
   void Rotate(const Common::Quaternion& quat) override
   {
     m_mat = Common::Matrix44::FromQuaternion(quat) * m_mat;
+    SetDirty();
   }
 
   void Reset() override
@@ -93,18 +97,21 @@ public:
   {
     const Common::Vec3 up = m_rotate_quat.Conjugate() * Common::Vec3{0, 1, 0};
     m_position += up * amt;
+    SetDirty();
   }
 
   void MoveHorizontal(float amt) override
   {
     const Common::Vec3 right = m_rotate_quat.Conjugate() * Common::Vec3{1, 0, 0};
     m_position += right * amt;
+    SetDirty();
   }
 
   void MoveForward(float amt) override
   {
     const Common::Vec3 forward = m_rotate_quat.Conjugate() * Common::Vec3{0, 0, 1};
     m_position += forward * amt;
+    SetDirty();
   }
 
   void Rotate(const Common::Vec3& amt) override
@@ -117,6 +124,7 @@ public:
     using Common::Quaternion;
     m_rotate_quat =
         (Quaternion::RotateX(m_rotation.x) * Quaternion::RotateY(m_rotation.y)).Normalized();
+    SetDirty();
   }
 
   void Rotate(const Common::Quaternion& quat) override
@@ -163,6 +171,7 @@ public:
   {
     m_distance += -1 * amt;
     m_distance = std::max(m_distance, MIN_DISTANCE);
+    SetDirty();
   }
 
   void Rotate(const Common::Vec3& amt) override
@@ -175,6 +184,7 @@ public:
     using Common::Quaternion;
     m_rotate_quat =
         (Quaternion::RotateX(m_rotation.x) * Quaternion::RotateY(m_rotation.y)).Normalized();
+    SetDirty();
   }
 
   void Rotate(const Common::Quaternion& quat) override
@@ -216,18 +226,22 @@ void CameraControllerInput::DoState(PointerWrap& p)
   p.Do(m_speed);
   p.Do(m_fov_x_multiplier);
   p.Do(m_fov_y_multiplier);
+  if (p.IsReadMode())
+    m_dirty = true;
 }
 
 void CameraControllerInput::IncreaseFovX(float fov)
 {
   m_fov_x_multiplier += fov;
   m_fov_x_multiplier = std::max(m_fov_x_multiplier, MIN_FOV_MULTIPLIER);
+  m_dirty = true;
 }
 
 void CameraControllerInput::IncreaseFovY(float fov)
 {
   m_fov_y_multiplier += fov;
   m_fov_y_multiplier = std::max(m_fov_y_multiplier, MIN_FOV_MULTIPLIER);
+  m_dirty = true;
 }
 
 float CameraControllerInput::GetFovStepSize() const
@@ -64,6 +64,9 @@ public:
   void ResetSpeed();
   float GetSpeed() const;
 
+protected:
+  void SetDirty() { m_dirty = true; }
+
 private:
   static constexpr float MIN_FOV_MULTIPLIER = 0.025f;
   static constexpr float DEFAULT_SPEED = 60.0f;
@@ -72,7 +75,8 @@ private:
   float m_fov_x_multiplier = DEFAULT_FOV_MULTIPLIER;
   float m_fov_y_multiplier = DEFAULT_FOV_MULTIPLIER;
   float m_speed = DEFAULT_SPEED;
-  bool m_dirty = false;
+  // A new controller's view hasn't been used yet.
+  bool m_dirty = true;
 };
 
 class FreeLookCamera
@@ -0,0 +1,158 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "VideoCommon/GPUTiming.h"
+
+#include "VideoCommon/AbstractGfx.h"
+#include "VideoCommon/VideoConfig.h"
+#include "VideoCommon/VideoEvents.h"
+
+std::unique_ptr<GPUTiming> g_gpu_timing;
+
+// Frames that still haven't completed on the GPU after this many presents are dropped, so that a
+// stuck query can't block timing forever.
+static constexpr size_t MAX_PENDING_FRAMES = 16;
+
+GPUTiming::GPUTiming()
+{
+  m_after_present_handler =
+      AfterPresentEvent::Register([this](PresentInfo&) { EndFrame(); }, "GPUTiming");
+}
+
+const char* GPUTiming::GetPassName(GPUTimingPass pass)
+{
+  switch (pass)
+  {
+  case GPUTimingPass::Draws:
+    return "Draws";
+  case GPUTimingPass::EFBCopies:
+    return "EFB copies";
+  case GPUTimingPass::PostProcessing:
+    return "Post-processing";
+  case GPUTimingPass::PostProcessingIntermediary:
+    return "Color correction";
+  case GPUTimingPass::BoundingBox:
+    return "Bounding box";
+  case GPUTimingPass::Present:
+    return "Present";
+  default:
+    return "Unknown";
+  }
+}
+
+std::optional<u32> GPUTiming::AllocateQuery()
+{
+  // Queries are released in the order they were allocated, so the in-flight ones are always a
+  // contiguous range ending at m_next_query.
+  if (m_queries_in_flight == AbstractGfx::MAX_TIMESTAMP_QUERIES)
+    return std::nullopt;
+
+  const u32 query = m_next_query;
+  m_next_query = (m_next_query + 1) % AbstractGfx::MAX_TIMESTAMP_QUERIES;
+  m_queries_in_flight++;
+  m_current_frame.num_queries++;
+  return query;
+}
+
+void GPUTiming::BeginPass(GPUTimingPass pass)
+{
+  if (pass != GPUTimingPass::Draws)
+    EndDrawSpan();
+
+  const u32 index = static_cast<u32>(pass);
+  if (!m_enabled || m_pass_depth[index]++ != 0)
+    return;
+
+  m_pass_begin_query[index] = AllocateQuery();
+  if (m_pass_begin_query[index])
+    g_gfx->WriteTimestampQuery(*m_pass_begin_query[index]);
+}
+
+void GPUTiming::EndPass(GPUTimingPass pass)
+{
+  const u32 index = static_cast<u32>(pass);
+  if (m_pass_depth[index] == 0 || --m_pass_depth[index] != 0 || !m_pass_begin_query[index])
+    return;
+
+  const std::optional<u32> end_query = AllocateQuery();
+  if (end_query)
+  {
+    g_gfx->WriteTimestampQuery(*end_query);
+    m_current_frame.spans.push_back({pass, *m_pass_begin_query[index], *end_query});
+  }
+  m_pass_begin_query[index].reset();
+}
+
+void GPUTiming::OnDraw()
+{
+  if (!m_enabled || m_draw_span_open)
+    return;
+
+  BeginPass(GPUTimingPass::Draws);
+  m_draw_span_open = true;
+}
+
+void GPUTiming::EndDrawSpan()
+{
+  if (!m_draw_span_open)
+    return;
+
+  m_draw_span_open = false;
+  EndPass(GPUTimingPass::Draws);
+}
+
+void GPUTiming::EndFrame()
+{
+  EndDrawSpan();
+
+  if (m_current_frame.num_queries > 0)
+    m_pending_frames.push_back(std::move(m_current_frame));
+  m_current_frame = {};
+
+  while (!m_pending_frames.empty() &&
+         (ResolveFrame(m_pending_frames.front()) || m_pending_frames.size() > MAX_PENDING_FRAMES))
+  {
+    ReleaseFrame(m_pending_frames.front());
+    m_pending_frames.pop_front();
+  }
+
+  m_enabled = g_ActiveConfig.bShowGPUPassTimes && g_gfx->SupportsTimestampQueries();
+  if (!m_enabled)
+    m_last_frame_times.reset();
+}
+
+bool GPUTiming::ResolveFrame(const Frame& frame)
+{
+  PassTimes times{};
+  for (const Span& span : frame.spans)
+  {
+    const std::optional<u64> begin = g_gfx->GetTimestampQueryResult(span.begin_query);
+    const std::optional<u64> end = g_gfx->GetTimestampQueryResult(span.end_query);
+    if (!begin || !end)
+      return false;
+
+    if (*end > *begin)
+      times[static_cast<u32>(span.pass)] += static_cast<double>(*end - *begin) / 1000000.0;
+  }
+
+  if (m_enabled)
+    m_last_frame_times = times;
+  return true;
+}
+
+void GPUTiming::ReleaseFrame(const Frame& frame)
+{
+  m_queries_in_flight -= frame.num_queries;
+}
+
+GPUTimingScope::GPUTimingScope(GPUTimingPass pass) : m_pass(pass)
+{
+  if (g_gpu_timing)
+    g_gpu_timing->BeginPass(m_pass);
+}
+
+GPUTimingScope::~GPUTimingScope()
+{
+  if (g_gpu_timing)
+    g_gpu_timing->EndPass(m_pass);
+}
@@ -0,0 +1,100 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <deque>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/HookableEvent.h"
+
+enum class GPUTimingPass : u32
+{
+  Draws,
+  EFBCopies,
+  PostProcessing,
+  // The color correction and resampling pass that runs before a user post-processing shader,
+  // also counted in PostProcessing
+  PostProcessingIntermediary,
+  BoundingBox,
+  // Everything drawn to the backbuffer, including post-processing
+  Present,
+  Count
+};
+
+// Measures how long the GPU spends in each pass of a frame, using the timestamp queries of
+// AbstractGfx. Passes can be entered many times per frame and their times are summed up.
+// Results are read back without waiting for the GPU, so they lag a few frames behind.
+class GPUTiming
+{
+public:
+  static constexpr u32 NUM_PASSES = static_cast<u32>(GPUTimingPass::Count);
+  using PassTimes = std::array<double, NUM_PASSES>;
+
+  GPUTiming();
+
+  void BeginPass(GPUTimingPass pass);
+  void EndPass(GPUTimingPass pass);
+
+  // Draws are too frequent to be timed individually, so consecutive draws share one span, which
+  // ends when another pass begins or the frame ends.
+  void OnDraw();
+
+  // Milliseconds spent in each pass in the most recent frame with complete results
+  const std::optional<PassTimes>& GetLastFrameTimes() const { return m_last_frame_times; }
+
+  static const char* GetPassName(GPUTimingPass pass);
+
+private:
+  struct Span
+  {
+    GPUTimingPass pass;
+    u32 begin_query;
+    u32 end_query;
+  };
+
+  struct Frame
+  {
+    std::vector<Span> spans;
+    u32 num_queries = 0;
+  };
+
+  void EndDrawSpan();
+  void EndFrame();
+  bool ResolveFrame(const Frame& frame);
+  void ReleaseFrame(const Frame& frame);
+  std::optional<u32> AllocateQuery();
+
+  bool m_enabled = false;
+  bool m_draw_span_open = false;
+  std::array<u32, NUM_PASSES> m_pass_depth{};
+  std::array<std::optional<u32>, NUM_PASSES> m_pass_begin_query{};
+  Frame m_current_frame;
+  std::deque<Frame> m_pending_frames;
+
+  u32 m_next_query = 0;
+  u32 m_queries_in_flight = 0;
+
+  std::optional<PassTimes> m_last_frame_times;
+
+  Common::EventHook m_after_present_handler;
+};
+
+// Times the GPU work submitted during its lifetime as the given pass
+class GPUTimingScope
+{
+public:
+  explicit GPUTimingScope(GPUTimingPass pass);
+  ~GPUTimingScope();
+  GPUTimingScope(const GPUTimingScope&) = delete;
+  GPUTimingScope& operator=(const GPUTimingScope&) = delete;
+
+private:
+  GPUTimingPass m_pass;
+};
+
+extern std::unique_ptr<GPUTiming> g_gpu_timing;
@@ -3,8 +3,10 @@
 
 #include "VideoCommon/GraphicsModSystem/Runtime/GraphicsModManager.h"
 
+#include <algorithm>
 #include <string>
 #include <string_view>
+#include <tuple>
 #include <variant>
 
 #include "Common/Logging/Log.h"
@@ -102,25 +104,38 @@ bool GraphicsModManager::Initialize()
   return true;
 }
 
+static bool FBInfoLess(const FBInfo& lhs, const FBInfo& rhs)
+{
+  return std::tie(lhs.m_width, lhs.m_height, lhs.m_texture_format) <
+         std::tie(rhs.m_width, rhs.m_height, rhs.m_texture_format);
+}
+
 const std::vector<GraphicsModAction*>&
 GraphicsModManager::GetProjectionActions(ProjectionType projection_type) const
 {
-  if (const auto it = m_projection_target_to_actions.find(projection_type);
-      it != m_projection_target_to_actions.end())
-  {
-    return it->second;
-  }
+  if (!HasActions(ActionEvent::Projection))
+    return m_default;
 
-  return m_default;
+  const auto index = static_cast<std::size_t>(projection_type);
+  if (index >= NUM_PROJECTION_TYPES)
+    return m_default;
+
+  return m_projection_target_to_actions[index];
 }
 
 const std::vector<GraphicsModAction*>&
 GraphicsModManager::GetProjectionTextureActions(ProjectionType projection_type,
                                                 const std::string& texture_name) const
 {
-  const auto lookup = fmt::format("{}_{}", texture_name, static_cast<int>(projection_type));
-  if (const auto it = m_projection_texture_target_to_actions.find(lookup);
-      it != m_projection_texture_target_to_actions.end())
+  if (!HasActions(ActionEvent::ProjectionTexture))
+    return m_default;
+
+  const auto index = static_cast<std::size_t>(projection_type);
+  if (index >= NUM_PROJECTION_TYPES)
+    return m_default;
+
+  const auto& targets = m_projection_texture_target_to_actions[index];
+  if (const auto it = targets.find(texture_name); it != targets.end())
   {
     return it->second;
   }
@@ -131,6 +146,9 @@ GraphicsModManager::GetProjectionTextureActions(ProjectionType projection_type,
 const std::vector<GraphicsModAction*>&
 GraphicsModManager::GetDrawStartedActions(const std::string& texture_name) const
 {
+  if (!HasActions(ActionEvent::DrawStarted))
+    return m_default;
+
   if (const auto it = m_draw_started_target_to_actions.find(texture_name);
       it != m_draw_started_target_to_actions.end())
   {
@@ -143,6 +161,9 @@ GraphicsModManager::GetDrawStartedActions(const std::string& texture_name) const
 const std::vector<GraphicsModAction*>&
 GraphicsModManager::GetTextureLoadActions(const std::string& texture_name) const
 {
+  if (!HasActions(ActionEvent::TextureLoad))
+    return m_default;
+
   if (const auto it = m_load_texture_target_to_actions.find(texture_name);
       it != m_load_texture_target_to_actions.end())
   {
@@ -155,6 +176,9 @@ GraphicsModManager::GetTextureLoadActions(const std::string& texture_name) const
 const std::vector<GraphicsModAction*>&
 GraphicsModManager::GetTextureCreateActions(const std::string& texture_name) const
 {
+  if (!HasActions(ActionEvent::TextureCreate))
+    return m_default;
+
   if (const auto it = m_create_texture_target_to_actions.find(texture_name);
       it != m_create_texture_target_to_actions.end())
   {
@@ -166,20 +190,28 @@ GraphicsModManager::GetTextureCreateActions(const std::string& texture_name) con
 
 const std::vector<GraphicsModAction*>& GraphicsModManager::GetEFBActions(const FBInfo& efb) const
 {
-  if (const auto it = m_efb_target_to_actions.find(efb); it != m_efb_target_to_actions.end())
-  {
-    return it->second;
-  }
+  if (!HasActions(ActionEvent::EFB))
+    return m_default;
 
-  return m_default;
+  return FindFBActions(m_efb_target_to_actions, efb);
 }
 
 const std::vector<GraphicsModAction*>& GraphicsModManager::GetXFBActions(const FBInfo& xfb) const
 {
-  if (const auto it = m_efb_target_to_actions.find(xfb); it != m_efb_target_to_actions.end())
-  {
+  if (!HasActions(ActionEvent::XFB))
+    return m_default;
+
+  return FindFBActions(m_xfb_target_to_actions, xfb);
+}
+
+const std::vector<GraphicsModAction*>&
+GraphicsModManager::FindFBActions(const FBActionTable& table, const FBInfo& info)
+{
+  const auto it = std::lower_bound(
+      table.begin(), table.end(), info,
+      [](const auto& entry, const FBInfo& value) { return FBInfoLess(entry.first, value); });
+  if (it != table.end() && it->first == info)
     return it->second;
-  }
 
   return m_default;
 }
@@ -191,6 +223,8 @@ void GraphicsModManager::Load(const GraphicsModGroupConfig& config)
   const auto& mods = config.GetMods();
 
   auto filesystem_library = std::make_shared<VideoCommon::DirectFilesystemAssetLibrary>();
+  FBTargetMap efb_targets;
+  FBTargetMap xfb_targets;
 
   std::map<std::string, std::vector<GraphicsTargetConfig>> group_to_targets;
   for (const auto& mod : mods)
@@ -277,27 +311,28 @@ void GraphicsModManager::Load(const GraphicsModGroupConfig& config)
                   info.m_height = the_target.m_height;
                   info.m_width = the_target.m_width;
                   info.m_texture_format = the_target.m_texture_format;
-                  m_efb_target_to_actions[info].push_back(m_actions.back().get());
+                  efb_targets[info].push_back(m_actions.back().get());
                 },
                 [&](const XFBTarget& the_target) {
                   FBInfo info;
                   info.m_height = the_target.m_height;
                   info.m_width = the_target.m_width;
                   info.m_texture_format = the_target.m_texture_format;
-                  m_xfb_target_to_actions[info].push_back(m_actions.back().get());
+                  xfb_targets[info].push_back(m_actions.back().get());
                 },
                 [&](const ProjectionTarget& the_target) {
+                  const auto index = static_cast<std::size_t>(the_target.m_projection_type);
+                  if (index >= NUM_PROJECTION_TYPES)
+                    return;
+
                   if (the_target.m_texture_info_string)
                   {
-                    const auto lookup = fmt::format("{}_{}", *the_target.m_texture_info_string,
-                                                    static_cast<int>(the_target.m_projection_type));
-                    m_projection_texture_target_to_actions[lookup].push_back(
-                        m_actions.back().get());
+                    m_projection_texture_target_to_actions[index][*the_target.m_texture_info_string]
+                        .push_back(m_actions.back().get());
                   }
                   else
                   {
-                    m_projection_target_to_actions[the_target.m_projection_type].push_back(
-                        m_actions.back().get());
+                    m_projection_target_to_actions[index].push_back(m_actions.back().get());
                   }
                 },
             },
@@ -346,6 +381,40 @@ void GraphicsModManager::Load(const GraphicsModGroupConfig& config)
       }
     }
   }
+
+  CompileLookupTables(std::move(efb_targets), std::move(xfb_targets));
+}
+
+void GraphicsModManager::CompileLookupTables(FBTargetMap efb_targets, FBTargetMap xfb_targets)
+{
+  const auto compile_fb_table = [](FBTargetMap targets) {
+    FBActionTable table(std::make_move_iterator(targets.begin()),
+                        std::make_move_iterator(targets.end()));
+    std::sort(table.begin(), table.end(),
+              [](const auto& lhs, const auto& rhs) { return FBInfoLess(lhs.first, rhs.first); });
+    return table;
+  };
+  m_efb_target_to_actions = compile_fb_table(std::move(efb_targets));
+  m_xfb_target_to_actions = compile_fb_table(std::move(xfb_targets));
+
+  const auto set_active = [this](ActionEvent event, bool active) {
+    if (active)
+      m_active_events |= 1u << static_cast<u32>(event);
+  };
+  m_active_events = 0;
+  set_active(ActionEvent::Projection,
+             std::any_of(m_projection_target_to_actions.begin(),
+                         m_projection_target_to_actions.end(),
+                         [](const auto& actions) { return !actions.empty(); }));
+  set_active(ActionEvent::ProjectionTexture,
+             std::any_of(m_projection_texture_target_to_actions.begin(),
+                         m_projection_texture_target_to_actions.end(),
+                         [](const auto& targets) { return !targets.empty(); }));
+  set_active(ActionEvent::DrawStarted, !m_draw_started_target_to_actions.empty());
+  set_active(ActionEvent::TextureLoad, !m_load_texture_target_to_actions.empty());
+  set_active(ActionEvent::TextureCreate, !m_create_texture_target_to_actions.empty());
+  set_active(ActionEvent::EFB, !m_efb_target_to_actions.empty());
+  set_active(ActionEvent::XFB, !m_xfb_target_to_actions.empty());
 }
 
 void GraphicsModManager::EndOfFrame()
@@ -360,8 +429,11 @@ void GraphicsModManager::Reset()
 {
   m_actions.clear();
   m_groups.clear();
-  m_projection_target_to_actions.clear();
-  m_projection_texture_target_to_actions.clear();
+  m_active_events = 0;
+  for (auto& actions : m_projection_target_to_actions)
+    actions.clear();
+  for (auto& targets : m_projection_texture_target_to_actions)
+    targets.clear();
   m_draw_started_target_to_actions.clear();
   m_load_texture_target_to_actions.clear();
   m_create_texture_target_to_actions.clear();
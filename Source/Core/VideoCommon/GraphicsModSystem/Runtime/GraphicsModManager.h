@@ -3,11 +3,13 @@
 
 #pragma once
 
+#include <array>
 #include <list>
 #include <memory>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include "VideoCommon/GraphicsModSystem/Runtime/FBInfo.h"
@@ -38,23 +40,52 @@ public:
   void Load(const GraphicsModGroupConfig& config);
 
 private:
+  // Events which have at least one action, checked before any table lookup so that the hot paths
+  // cost a single bit test when no mod targets them.
+  enum class ActionEvent : u32
+  {
+    Projection,
+    ProjectionTexture,
+    DrawStarted,
+    TextureLoad,
+    TextureCreate,
+    EFB,
+    XFB,
+  };
+
+  using FBActionTable = std::vector<std::pair<FBInfo, std::vector<GraphicsModAction*>>>;
+  using FBTargetMap = std::unordered_map<FBInfo, std::vector<GraphicsModAction*>, FBInfoHasher>;
+
   void EndOfFrame();
   void Reset();
 
+  bool HasActions(ActionEvent event) const
+  {
+    return (m_active_events & (1u << static_cast<u32>(event))) != 0;
+  }
+  void CompileLookupTables(FBTargetMap efb_targets, FBTargetMap xfb_targets);
+  static const std::vector<GraphicsModAction*>& FindFBActions(const FBActionTable& table,
+                                                              const FBInfo& info);
+
   class DecoratedAction;
 
+  static constexpr std::size_t NUM_PROJECTION_TYPES = 2;
+
   static inline const std::vector<GraphicsModAction*> m_default = {};
   std::list<std::unique_ptr<GraphicsModAction>> m_actions;
-  std::unordered_map<ProjectionType, std::vector<GraphicsModAction*>>
-      m_projection_target_to_actions;
-  std::unordered_map<std::string, std::vector<GraphicsModAction*>>
+  u32 m_active_events = 0;
+  std::array<std::vector<GraphicsModAction*>, NUM_PROJECTION_TYPES> m_projection_target_to_actions;
+  std::array<std::unordered_map<std::string, std::vector<GraphicsModAction*>>,
+             NUM_PROJECTION_TYPES>
       m_projection_texture_target_to_actions;
   std::unordered_map<std::string, std::vector<GraphicsModAction*>> m_draw_started_target_to_actions;
   std::unordered_map<std::string, std::vector<GraphicsModAction*>> m_load_texture_target_to_actions;
   std::unordered_map<std::string, std::vector<GraphicsModAction*>>
       m_create_texture_target_to_actions;
-  std::unordered_map<FBInfo, std::vector<GraphicsModAction*>, FBInfoHasher> m_efb_target_to_actions;
-  std::unordered_map<FBInfo, std::vector<GraphicsModAction*>, FBInfoHasher> m_xfb_target_to_actions;
+
+  // Sorted by FBInfo, there are usually only a handful of framebuffer targets.
+  FBActionTable m_efb_target_to_actions;
+  FBActionTable m_xfb_target_to_actions;
 
   std::unordered_set<std::string> m_groups;
 
@@ -27,6 +27,7 @@
 #include "VideoCommon/Assets/CustomAsset.h"
 #include "VideoCommon/Assets/CustomAssetLoader.h"
 #include "VideoCommon/Assets/DirectFilesystemAssetLibrary.h"
+#include "VideoCommon/Assets/PackedTextureAssetLibrary.h"
 #include "VideoCommon/OnScreenDisplay.h"
 #include "VideoCommon/VideoConfig.h"
 
@@ -37,8 +38,22 @@ static std::unordered_map<std::string, bool> s_hires_texture_id_to_arbmipmap;
 
 static auto s_file_library = std::make_shared<VideoCommon::DirectFilesystemAssetLibrary>();
 
+// Textures that come from a packed archive instead of loose files
+static std::unordered_map<std::string, std::shared_ptr<VideoCommon::CustomAssetLibrary>>
+    s_hires_texture_id_to_library;
+
 namespace
 {
+std::shared_ptr<VideoCommon::CustomAssetLibrary> GetLibrary(const std::string& texture_id)
+{
+  if (auto iter = s_hires_texture_id_to_library.find(texture_id);
+      iter != s_hires_texture_id_to_library.end())
+  {
+    return iter->second;
+  }
+  return s_file_library;
+}
+
 std::pair<std::string, bool> GetNameArbPair(const TextureInfo& texture_info)
 {
   if (s_hires_texture_id_to_arbmipmap.empty())
@@ -98,7 +113,8 @@ void HiresTexture::Update()
   const std::string& game_id = SConfig::GetInstance().GetGameID();
   const std::set<std::string> texture_directories =
       GetTextureDirectoriesWithGameId(File::GetUserPath(D_HIRESTEXTURES_IDX), game_id);
-  const std::vector<std::string> extensions{".png", ".dds"};
+  const std::vector<std::string> extensions{".png", ".dds",
+                                            VideoCommon::PackedTextureArchive::FILE_EXTENSION};
 
   auto& system = Core::System::GetInstance();
 
@@ -111,9 +127,47 @@ void HiresTexture::Update()
     for (auto& path : texture_paths)
     {
       std::string filename;
-      SplitPath(path, nullptr, &filename, nullptr);
+      std::string extension;
+      SplitPath(path, nullptr, &filename, &extension);
+
+      if (extension == VideoCommon::PackedTextureArchive::FILE_EXTENSION)
+      {
+        auto library = std::make_shared<VideoCommon::PackedTextureAssetLibrary>();
+        if (!library->Open(path))
+          continue;
+
+        const auto& names = library->GetTextureNames();
+        for (u32 i = 0; i < names.size(); i++)
+        {
+          std::string name = names[i];
+          if (name.substr(0, s_format_prefix.length()) != s_format_prefix)
+            continue;
+
+          const size_t arb_index = name.rfind("_arb");
+          const bool has_arbitrary_mipmaps = arb_index != std::string::npos;
+          if (has_arbitrary_mipmaps)
+            name.erase(arb_index, 4);
+
+          const auto [it, inserted] =
+              s_hires_texture_id_to_arbmipmap.try_emplace(name, has_arbitrary_mipmaps);
+          if (!inserted)
+          {
+            failed_insert = true;
+            continue;
+          }
 
-      if (filename.substr(0, s_format_prefix.length()) == s_format_prefix)
+          library->SetAssetIDTexture(name, i);
+          s_hires_texture_id_to_library.emplace(name, library);
+          if (g_ActiveConfig.bCacheHiresTextures)
+          {
+            auto hires_texture = std::make_shared<HiresTexture>(
+                has_arbitrary_mipmaps,
+                system.GetCustomAssetLoader().LoadGameTexture(name, library));
+            s_hires_texture_cache.try_emplace(name, std::move(hires_texture));
+          }
+        }
+      }
+      else if (filename.substr(0, s_format_prefix.length()) == s_format_prefix)
       {
         const size_t arb_index = filename.rfind("_arb");
         const bool has_arbitrary_mipmaps = arb_index != std::string::npos;
@@ -167,6 +221,7 @@ void HiresTexture::Clear()
 {
   s_hires_texture_cache.clear();
   s_hires_texture_id_to_arbmipmap.clear();
+  s_hires_texture_id_to_library.clear();
   s_file_library = std::make_shared<VideoCommon::DirectFilesystemAssetLibrary>();
 }
 
@@ -185,7 +240,7 @@ std::shared_ptr<HiresTexture> HiresTexture::Search(const TextureInfo& texture_in
     auto& system = Core::System::GetInstance();
     auto hires_texture = std::make_shared<HiresTexture>(
         has_arb_mipmaps,
-        system.GetCustomAssetLoader().LoadGameTexture(base_filename, s_file_library));
+        system.GetCustomAssetLoader().LoadGameTexture(base_filename, GetLibrary(base_filename)));
     if (g_ActiveConfig.bCacheHiresTextures)
     {
       s_hires_texture_cache.try_emplace(base_filename, hires_texture);
@@ -3,6 +3,7 @@
 
 #include "VideoCommon/IndexGenerator.h"
 
+#include <algorithm>
 #include <array>
 #include <cstddef>
 #include <cstring>
@@ -168,6 +169,56 @@ u16* AddQuads_nonstandard(u16* index_ptr, u32 num_verts, u32 index)
   return AddQuads<pr>(index_ptr, num_verts, index);
 }
 
+// Triangle order must match CPUCull's GetVisibleTriangles
+template <bool pr>
+u16* AddCulledTriangles(u16* index_ptr, OpcodeDecoder::Primitive primitive, u32 num_verts,
+                        u32 index, const u8* visible)
+{
+  using OpcodeDecoder::Primitive;
+  const auto add = [&](u32 index1, u32 index2, u32 index3) {
+    if (*visible++)
+      index_ptr = WriteTriangle<pr>(index_ptr, index + index1, index + index2, index + index3);
+  };
+
+  switch (primitive)
+  {
+  case Primitive::GX_DRAW_QUADS:
+  case Primitive::GX_DRAW_QUADS_2:
+  {
+    u32 i = 3;
+    for (; i < num_verts; i += 4)
+    {
+      add(i - 3, i - 2, i - 1);
+      add(i - 3, i - 1, i - 0);
+    }
+    if (i == num_verts)
+      add(i - 3, i - 2, i - 1);
+    break;
+  }
+  case Primitive::GX_DRAW_TRIANGLES:
+    for (u32 i = 2; i < num_verts; i += 3)
+      add(i - 2, i - 1, i);
+    break;
+  case Primitive::GX_DRAW_TRIANGLE_STRIP:
+  {
+    bool wind = false;
+    for (u32 i = 2; i < num_verts; ++i)
+    {
+      add(i - 2, i - !wind, i - wind);
+      wind ^= true;
+    }
+    break;
+  }
+  case Primitive::GX_DRAW_TRIANGLE_FAN:
+    for (u32 i = 2; i < num_verts; ++i)
+      add(0, i - 1, i);
+    break;
+  default:
+    break;
+  }
+  return index_ptr;
+}
+
 u16* AddLineList(u16* index_ptr, u32 num_verts, u32 index)
 {
   for (u32 i = 1; i < num_verts; i += 2)
@@ -266,7 +317,8 @@ void IndexGenerator::Init()
 {
   using OpcodeDecoder::Primitive;
 
-  if (g_Config.backend_info.bSupportsPrimitiveRestart)
+  m_primitive_restart = g_Config.backend_info.bSupportsPrimitiveRestart;
+  if (m_primitive_restart)
   {
     m_primitive_table[Primitive::GX_DRAW_QUADS] = AddQuads<true>;
     m_primitive_table[Primitive::GX_DRAW_QUADS_2] = AddQuads_nonstandard<true>;
@@ -303,6 +355,19 @@ void IndexGenerator::Init()
     m_primitive_table[Primitive::GX_DRAW_LINE_STRIP] = AddLineStrip;
     m_primitive_table[Primitive::GX_DRAW_POINTS] = AddPoints;
   }
+
+  // Triangle indices are linear in the base index, unlike the VS expand line and point ones, so
+  // their patterns only need to be offset. Most GameCube strips, fans and quads are short.
+  std::array<u16, MAX_PATTERN_VERTICES * 3> scratch;
+  for (Primitive primitive = Primitive::GX_DRAW_QUADS; primitive <= Primitive::GX_DRAW_TRIANGLE_FAN;
+       primitive = static_cast<Primitive>(static_cast<u8>(primitive) + 1))
+  {
+    for (u32 num_vertices = 0; num_vertices <= MAX_PATTERN_VERTICES; ++num_vertices)
+    {
+      u16* const end = m_primitive_table[primitive](scratch.data(), num_vertices, 0);
+      m_index_patterns[primitive][num_vertices].assign(scratch.data(), end);
+    }
+  }
 }
 
 void IndexGenerator::Start(u16* index_ptr)
@@ -312,10 +377,48 @@ void IndexGenerator::Start(u16* index_ptr)
   m_base_index = 0;
 }
 
+u16* IndexGenerator::GenerateIndices(OpcodeDecoder::Primitive primitive, u32 num_vertices,
+                                     u16* index_ptr) const
+{
+  if (primitive > OpcodeDecoder::Primitive::GX_DRAW_TRIANGLE_FAN ||
+      num_vertices > MAX_PATTERN_VERTICES)
+  {
+    return m_primitive_table[primitive](index_ptr, num_vertices, m_base_index);
+  }
+
+  // Valid indices never reach the restart index, so a saturating add leaves restarts untouched
+  // and the loop stays branchless.
+  const std::vector<u16>& pattern = m_index_patterns[primitive][num_vertices];
+  for (const u16 index : pattern)
+    *index_ptr++ = static_cast<u16>(std::min<u32>(index + m_base_index, s_primitive_restart));
+  return index_ptr;
+}
+
 void IndexGenerator::AddIndices(OpcodeDecoder::Primitive primitive, u32 num_vertices)
 {
-  m_index_buffer_current =
-      m_primitive_table[primitive](m_index_buffer_current, num_vertices, m_base_index);
+  m_index_buffer_current = GenerateIndices(primitive, num_vertices, m_index_buffer_current);
+  m_base_index += num_vertices;
+}
+
+void IndexGenerator::AddIndicesCulled(OpcodeDecoder::Primitive primitive, u32 num_vertices,
+                                      const u8* visible, u32 num_visible)
+{
+  // The full primitive is generated first, both to bound the space the culled one may use and as
+  // the fallback when strips or fans would grow from being split into separate triangles.
+  u16* const start = m_index_buffer_current;
+  u16* const full_end = GenerateIndices(primitive, num_vertices, start);
+  const u32 indices_per_triangle = m_primitive_restart ? 4 : 3;
+  if (num_visible * indices_per_triangle < static_cast<u32>(full_end - start))
+  {
+    m_index_buffer_current =
+        m_primitive_restart ?
+            AddCulledTriangles<true>(start, primitive, num_vertices, m_base_index, visible) :
+            AddCulledTriangles<false>(start, primitive, num_vertices, m_base_index, visible);
+  }
+  else
+  {
+    m_index_buffer_current = full_end;
+  }
   m_base_index += num_vertices;
 }
 
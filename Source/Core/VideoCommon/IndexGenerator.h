@@ -6,6 +6,9 @@
 
 #pragma once
 
+#include <array>
+#include <vector>
+
 #include "Common/CommonTypes.h"
 #include "Common/EnumMap.h"
 #include "VideoCommon/OpcodeDecoding.h"
@@ -17,6 +20,10 @@ public:
   void Start(u16* index_ptr);
 
   void AddIndices(OpcodeDecoder::Primitive primitive, u32 num_vertices);
+  // Only emits the triangles flagged in visible (one entry per triangle, see CPUCull). Falls back
+  // to the whole primitive if separate triangles would take more indices than that.
+  void AddIndicesCulled(OpcodeDecoder::Primitive primitive, u32 num_vertices, const u8* visible,
+                        u32 num_visible);
 
   void AddExternalIndices(const u16* indices, u32 num_indices, u32 num_vertices);
 
@@ -26,10 +33,20 @@ public:
   u32 GetRemainingIndices(OpcodeDecoder::Primitive primitive) const;
 
 private:
+  u16* GenerateIndices(OpcodeDecoder::Primitive primitive, u32 num_vertices, u16* index_ptr) const;
+
+  // Triangle draws of up to this many vertices are copied from precomputed index patterns
+  static constexpr u32 MAX_PATTERN_VERTICES = 64;
+
   u16* m_index_buffer_current = nullptr;
   u16* m_base_index_ptr = nullptr;
   u32 m_base_index = 0;
+  bool m_primitive_restart = false;
 
   using PrimitiveFunction = u16* (*)(u16*, u32, u32);
   Common::EnumMap<PrimitiveFunction, OpcodeDecoder::Primitive::GX_DRAW_POINTS> m_primitive_table{};
+  // Indices of each triangle primitive and vertex count, relative to a base index of 0
+  Common::EnumMap<std::array<std::vector<u16>, MAX_PATTERN_VERTICES + 1>,
+                  OpcodeDecoder::Primitive::GX_DRAW_TRIANGLE_FAN>
+      m_index_patterns{};
 };
@@ -108,6 +108,24 @@ public:
     if constexpr (is_preprocess)
     {
       LoadBPRegPreprocess(command, value, m_cycles);
+
+      switch (command)
+      {
+      case BPMEM_TRIGGER_EFB_COPY:
+        AddGPUDependency(Fifo::GPUDependency::EFB);
+        AddGPUDependency(Fifo::GPUDependency::MemoryWrite);
+        break;
+      case BPMEM_ZCOMPARE:
+        AddGPUDependency(Fifo::GPUDependency::EFB);
+        break;
+      case BPMEM_CLEARBBOX1:
+      case BPMEM_CLEARBBOX2:
+        AddGPUDependency(Fifo::GPUDependency::BoundingBox);
+        break;
+      case BPMEM_CLEAR_PIXEL_PERF:
+        AddGPUDependency(Fifo::GPUDependency::PerfQuery);
+        break;
+      }
     }
     else
     {
@@ -135,6 +153,13 @@ public:
 
     ASSERT(bytes == size);
 
+    if constexpr (is_preprocess)
+    {
+      AddGPUDependency(Fifo::GPUDependency::EFB);
+      AddGPUDependency(Fifo::GPUDependency::BoundingBox);
+      AddGPUDependency(Fifo::GPUDependency::PerfQuery);
+    }
+
     // 4 GPU ticks per vertex, 3 CPU ticks per GPU tick
     m_cycles += num_vertices * 4 * 3 + 6;
   }
@@ -158,7 +183,7 @@ public:
       if constexpr (is_preprocess)
       {
         auto& memory = system.GetMemory();
-        const u8* const start_address = memory.GetPointerForRange(address, size);
+        const u8* const start_address = memory.GetReadOnlyPointerForRange(address, size);
 
         system.GetFifo().PushFifoAuxBuffer(start_address, size);
 
@@ -179,10 +204,10 @@ public:
         else
         {
           auto& memory = system.GetMemory();
-          start_address = memory.GetPointerForRange(address, size);
+          start_address = memory.GetReadOnlyPointerForRange(address, size);
         }
 
-        // Avoid the crash if memory.GetPointerForRange failed ..
+        // Avoid the crash if memory.GetReadOnlyPointerForRange failed ..
         if (start_address != nullptr)
         {
           // temporarily swap dl and non-dl (small "hack" for the stats)
@@ -253,8 +278,15 @@ public:
     return loader->m_vertex_size;
   }
 
+  void AddGPUDependency(Fifo::GPUDependency dependency)
+  {
+    m_gpu_dependencies[static_cast<size_t>(dependency)] = true;
+  }
+
   u32 m_cycles = 0;
   bool m_in_display_list = false;
+  // The CPU-visible state that the preprocessed commands can change.
+  BitSet32 m_gpu_dependencies;
 };
 
 template <bool is_preprocess>
@@ -267,6 +299,9 @@ u8* RunFifo(DataReader src, u32* cycles)
   if (cycles != nullptr)
     *cycles = callback.m_cycles;
 
+  if constexpr (is_preprocess)
+    Core::System::GetInstance().GetFifo().AddPendingGPUDependencies(callback.m_gpu_dependencies);
+
   src.Skip(size);
   return src.GetPointer();
 }
@@ -274,4 +309,143 @@ u8* RunFifo(DataReader src, u32* cycles)
 template u8* RunFifo<true>(DataReader src, u32* cycles);
 template u8* RunFifo<false>(DataReader src, u32* cycles);
 
+static bool IsPrimitiveCommand(u8 opcode)
+{
+  return opcode >= static_cast<u8>(Opcode::GX_PRIMITIVE_START) &&
+         opcode <= static_cast<u8>(Opcode::GX_PRIMITIVE_END);
+}
+
+// Only tracks the CP state needed to frame primitives; everything else is left for the GPU thread.
+class PreparseCallback final : public Callback
+{
+public:
+  explicit PreparseCallback(std::vector<PreparsedCommand>* commands) : m_commands(commands) {}
+
+  OPCODE_CALLBACK(void OnXF(u16 address, u8 count, const u8* data)) {}
+  OPCODE_CALLBACK(void OnCP(u8 command, u32 value))
+  {
+    const u8 sub_command = command & CP_COMMAND_MASK;
+    if (sub_command == VCD_LO || sub_command == VCD_HI)
+    {
+      VertexLoaderManager::g_preprocess_vat_dirty = BitSet8::AllTrue(CP_NUM_VAT_REG);
+    }
+    else if (sub_command == CP_VAT_REG_A || sub_command == CP_VAT_REG_B ||
+             sub_command == CP_VAT_REG_C)
+    {
+      VertexLoaderManager::g_preprocess_vat_dirty[command & CP_VAT_MASK] = true;
+    }
+    GetCPState().LoadCPReg(command, value);
+  }
+  OPCODE_CALLBACK(void OnBP(u8 command, u32 value)) {}
+  OPCODE_CALLBACK(void OnIndexedLoad(CPArray array, u32 index, u16 address, u8 size)) {}
+  OPCODE_CALLBACK(void OnPrimitiveCommand(OpcodeDecoder::Primitive primitive, u8 vat,
+                                          u32 vertex_size, u16 num_vertices, const u8* vertex_data))
+  {
+  }
+  OPCODE_CALLBACK_NOINLINE(void OnDisplayList(u32 address, u32 size))
+  {
+    if (m_in_display_list)
+      return;
+
+    auto& memory = Core::System::GetInstance().GetMemory();
+    const u8* const start_address = memory.GetReadOnlyPointerForRange(address, size);
+    if (start_address != nullptr)
+    {
+      m_in_display_list = true;
+      Run(start_address, size, *this);
+      m_in_display_list = false;
+    }
+  }
+  OPCODE_CALLBACK(void OnNop(u32 count)) {}
+  OPCODE_CALLBACK(void OnUnknown(u8 opcode, const u8* data)) {}
+
+  OPCODE_CALLBACK(void OnCommand(const u8* data, u32 size))
+  {
+    if (m_in_display_list)
+      return;
+
+    if (IsPrimitiveCommand(data[0]))
+    {
+      FlushRun();
+      m_commands->push_back({data, size, m_loader});
+    }
+    else if (m_run_data != nullptr)
+    {
+      m_run_size += size;
+    }
+    else
+    {
+      m_run_data = data;
+      m_run_size = size;
+    }
+  }
+
+  OPCODE_CALLBACK(CPState& GetCPState()) { return g_preprocess_cp_state; }
+
+  OPCODE_CALLBACK(u32 GetVertexSize(u8 vat))
+  {
+    m_loader = VertexLoaderManager::RefreshLoader<true>(vat);
+    return m_loader->m_vertex_size;
+  }
+
+  void FlushRun()
+  {
+    if (m_run_data == nullptr)
+      return;
+
+    m_commands->push_back({m_run_data, m_run_size, nullptr});
+    m_run_data = nullptr;
+  }
+
+private:
+  std::vector<PreparsedCommand>* m_commands;
+  const u8* m_run_data = nullptr;
+  u32 m_run_size = 0;
+  VertexLoaderBase* m_loader = nullptr;
+  bool m_in_display_list = false;
+};
+
+u8* PreparseFifo(DataReader src, std::vector<PreparsedCommand>* commands)
+{
+  auto callback = PreparseCallback{commands};
+  const u32 size = Run(src.GetPointer(), static_cast<u32>(src.size()), callback);
+  callback.FlushRun();
+
+  src.Skip(size);
+  return src.GetPointer();
+}
+
+size_t RunPreparsedFifo(std::span<const PreparsedCommand> commands, u32* cycles)
+{
+  auto callback = RunCallback<false>{};
+  size_t executed = 0;
+  for (const PreparsedCommand& command : commands)
+  {
+    if (command.loader == nullptr)
+    {
+      [[maybe_unused]] const u32 size = Run(command.data, command.size, callback);
+      ASSERT(size == command.size);
+    }
+    else
+    {
+      const u8 vat = command.data[0] & GX_VAT_MASK;
+      VertexLoaderBase* loader = VertexLoaderManager::RefreshLoader<false>(vat);
+      if (loader != command.loader)
+        break;
+
+      const auto primitive =
+          static_cast<Primitive>((command.data[0] & GX_PRIMITIVE_MASK) >> GX_PRIMITIVE_SHIFT);
+      const u16 num_vertices = Common::swap16(&command.data[1]);
+      callback.OnPrimitiveCommand(primitive, vat, loader->m_vertex_size, num_vertices,
+                                  &command.data[3]);
+      callback.OnCommand(command.data, command.size);
+    }
+    executed++;
+  }
+
+  if (cycles != nullptr)
+    *cycles = callback.m_cycles;
+  return executed;
+}
+
 }  // namespace OpcodeDecoder
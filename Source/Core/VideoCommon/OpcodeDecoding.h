@@ -3,7 +3,9 @@
 
 #pragma once
 
+#include <span>
 #include <type_traits>
+#include <vector>
 
 #include "Common/Assert.h"
 #include "Common/CommonTypes.h"
@@ -276,6 +278,26 @@ DOLPHIN_FORCE_INLINE u32 Run(const u8* data, u32 available, T& callback)
 template <bool is_preprocess = false>
 u8* RunFifo(DataReader src, u32* cycles);
 
+// A command framed ahead of time by PreparseFifo: either a run of consecutive non-primitive
+// commands (BP/CP/XF loads, display lists, NOPs...), or a single primitive command.
+struct PreparsedCommand
+{
+  const u8* data;
+  u32 size;
+  // The vertex loader the primitive was framed with, or nullptr for non-primitive runs.
+  VertexLoaderBase* loader;
+};
+
+// Frames the commands in src using the preprocess CP state, appending them to commands without
+// executing them. Display lists are followed to keep the CP state current, but are not expanded.
+// Returns a pointer to the first command that is not complete yet.
+u8* PreparseFifo(DataReader src, std::vector<PreparsedCommand>* commands);
+
+// Executes commands framed by PreparseFifo. Stops before the first primitive whose vertex loader
+// no longer matches the main CP state, as its framing can't be trusted. Returns the number of
+// commands that were executed.
+size_t RunPreparsedFifo(std::span<const PreparsedCommand> commands, u32* cycles);
+
 }  // namespace OpcodeDecoder
 
 template <>
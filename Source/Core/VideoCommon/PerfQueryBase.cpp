@@ -4,10 +4,52 @@
 #include "VideoCommon/PerfQueryBase.h"
 #include <memory>
 #include "VideoCommon/VideoConfig.h"
+#include "VideoCommon/VideoEvents.h"
 
 std::unique_ptr<PerfQueryBase> g_perf_query;
 
+PerfQueryBase::PerfQueryBase() : m_query_count(0)
+{
+  m_after_present_handler = AfterPresentEvent::Register(
+      [this](PresentInfo&) { m_frame_count.fetch_add(1, std::memory_order_relaxed); },
+      "PerfQueryBase");
+}
+
 bool PerfQueryBase::ShouldEmulate()
 {
   return g_ActiveConfig.bPerfQueriesEnable;
 }
+
+void PerfQueryBase::PublishResults()
+{
+  if (g_ActiveConfig.iPerfQueryReadbackLag == 0)
+    return;
+
+  // The queries were issued before the game cleared the counters, usually a frame ago, so the GPU
+  // has most likely finished them already and this doesn't stall for long.
+  if (!IsFlushed())
+    FlushResults();
+
+  for (u32 i = 0; i < PQ_NUM_MEMBERS; i++)
+  {
+    m_published_results[i].store(GetQueryResult(static_cast<PerfQueryType>(i)),
+                                 std::memory_order_relaxed);
+  }
+  m_published_frame.store(m_frame_count.load(std::memory_order_relaxed),
+                          std::memory_order_relaxed);
+  m_has_published_results.store(true, std::memory_order_release);
+}
+
+std::optional<u32> PerfQueryBase::GetPublishedResult(PerfQueryType type) const
+{
+  const int lag = g_ActiveConfig.iPerfQueryReadbackLag;
+  if (lag == 0 || !m_has_published_results.load(std::memory_order_acquire))
+    return std::nullopt;
+
+  const u64 age = m_frame_count.load(std::memory_order_relaxed) -
+                  m_published_frame.load(std::memory_order_relaxed);
+  if (age > static_cast<u64>(lag))
+    return std::nullopt;
+
+  return m_published_results[type].load(std::memory_order_relaxed);
+}
@@ -6,8 +6,10 @@
 #include <array>
 #include <atomic>
 #include <memory>
+#include <optional>
 
 #include "Common/CommonTypes.h"
+#include "Common/HookableEvent.h"
 
 enum PerfQueryType
 {
@@ -31,7 +33,7 @@ enum PerfQueryGroup
 class PerfQueryBase
 {
 public:
-  PerfQueryBase() : m_query_count(0) {}
+  PerfQueryBase();
   virtual ~PerfQueryBase() {}
 
   virtual bool Initialize() { return true; }
@@ -64,9 +66,25 @@ public:
   // NOTE: Called from CPU thread
   virtual bool IsFlushed() const { return true; }
 
+  // Completes the pending queries and keeps their results before the game clears the counters, so
+  // that later reads can return them without synchronizing. Does nothing without a readback lag.
+  // NOTE: Called from GPU thread
+  void PublishResults();
+
+  // Returns the last published result if it is at most the configured readback lag in frames old.
+  // NOTE: Called from CPU thread
+  std::optional<u32> GetPublishedResult(PerfQueryType type) const;
+
 protected:
   std::atomic<u32> m_query_count;
   std::array<std::atomic<u32>, PQG_NUM_MEMBERS> m_results;
+
+private:
+  std::array<std::atomic<u32>, PQ_NUM_MEMBERS> m_published_results{};
+  std::atomic<u64> m_published_frame = 0;
+  std::atomic<bool> m_has_published_results = false;
+  std::atomic<u64> m_frame_count = 0;
+  Common::EventHook m_after_present_handler;
 };
 
 extern std::unique_ptr<PerfQueryBase> g_perf_query;
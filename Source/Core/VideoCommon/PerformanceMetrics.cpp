@@ -3,14 +3,24 @@
 
 #include "VideoCommon/PerformanceMetrics.h"
 
+#include <algorithm>
 #include <mutex>
+#include <string>
 
+#include <fmt/format.h>
 #include <imgui.h>
 #include <implot.h>
 
+#include "AudioCommon/SoundStream.h"
+#include "Common/CommonPaths.h"
+#include "Common/FileUtil.h"
+#include "Common/MemoryAccounting.h"
+#include "Core/Config/MainSettings.h"
+#include "Core/ConfigManager.h"
 #include "Core/CoreTiming.h"
 #include "Core/HW/VideoInterface.h"
 #include "Core/System.h"
+#include "VideoCommon/GPUTiming.h"
 #include "VideoCommon/VideoConfig.h"
 
 PerformanceMetrics g_perf_metrics;
@@ -21,7 +31,12 @@ void PerformanceMetrics::Reset()
   m_vps_counter.Reset();
   m_speed_counter.Reset();
 
-  m_time_sleeping = DT::zero();
+  {
+    std::unique_lock lock(m_time_lock);
+    m_time_sleeping = DT::zero();
+    m_reset_time = Clock::now();
+  }
+  m_gpu_busy_ns.store(0, std::memory_order_relaxed);
   m_real_times.fill(Clock::now());
   m_cpu_times.fill(Core::System::GetInstance().GetCoreTiming().GetCPUTimePoint(0));
 }
@@ -42,6 +57,22 @@ void PerformanceMetrics::CountThrottleSleep(DT sleep)
   m_time_sleeping += sleep;
 }
 
+void PerformanceMetrics::SetBusySamplingEnabled(bool enabled)
+{
+  m_busy_sampling_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool PerformanceMetrics::IsBusySamplingEnabled() const
+{
+  return m_busy_sampling_enabled.load(std::memory_order_relaxed);
+}
+
+void PerformanceMetrics::CountGPUBusyTime(DT busy)
+{
+  m_gpu_busy_ns.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(busy).count(),
+                          std::memory_order_relaxed);
+}
+
 void PerformanceMetrics::CountPerformanceMarker(Core::System& system, s64 cyclesLate)
 {
   std::unique_lock lock(m_time_lock);
@@ -80,6 +111,25 @@ double PerformanceMetrics::GetLastSpeedDenominator() const
          Core::System::GetInstance().GetVideoInterface().GetTargetRefreshRate();
 }
 
+DT PerformanceMetrics::GetFrameTimePercentile(double percentile) const
+{
+  return m_fps_counter.GetDtPercentile(percentile);
+}
+
+DT PerformanceMetrics::GetCPUBusyTime() const
+{
+  std::shared_lock lock(m_time_lock);
+  if (m_reset_time == TimePoint{})
+    return DT::zero();
+  return std::max(DT::zero(), Clock::now() - m_reset_time - m_time_sleeping);
+}
+
+DT PerformanceMetrics::GetGPUBusyTime() const
+{
+  return std::chrono::duration_cast<DT>(
+      std::chrono::nanoseconds(m_gpu_busy_ns.load(std::memory_order_relaxed)));
+}
+
 void PerformanceMetrics::DrawImGuiStats(const float backbuffer_scale)
 {
   const float bg_alpha = 0.7f;
@@ -209,6 +259,36 @@ void PerformanceMetrics::DrawImGuiStats(const float backbuffer_scale)
     }
   }
 
+  SoundStream* const sound_stream = Core::System::GetInstance().GetSoundStream();
+  if (g_ActiveConfig.bShowAudioLatency && sound_stream)
+  {
+    const bool show_dpl2 = Config::ShouldUseDPL2Decoder();
+
+    // Position in the top-right corner of the screen.
+    float window_height = (show_dpl2 ? 47.f : 29.f) * backbuffer_scale;
+
+    ImGui::SetNextWindowPos(ImVec2(window_x, window_y), ImGuiCond_Always, ImVec2(1.0f, 0.0f));
+    ImGui::SetNextWindowSize(ImVec2(window_width, window_height));
+    ImGui::SetNextWindowBgAlpha(bg_alpha);
+
+    if (stack_vertically)
+      window_y += window_height + window_padding;
+    else
+      window_x -= window_width + window_padding;
+
+    if (ImGui::Begin("AudioStats", nullptr, imgui_flags))
+    {
+      const Mixer* mixer = sound_stream->GetMixer();
+      ImGui::TextColored(ImVec4(0.0f, 1.0f, 1.0f, 1.0f), "Audio:%4.0lfms", mixer->GetLatencyMs());
+      if (show_dpl2)
+      {
+        ImGui::TextColored(ImVec4(0.0f, 1.0f, 1.0f, 1.0f), "DPL2:%5.1lf%%",
+                           100.0 * mixer->GetSurroundDecoderLoad());
+      }
+      ImGui::End();
+    }
+  }
+
   if (g_ActiveConfig.bShowFPS || g_ActiveConfig.bShowFTimes)
   {
     int count = g_ActiveConfig.bShowFPS + 2 * g_ActiveConfig.bShowFTimes;
@@ -269,5 +349,146 @@ void PerformanceMetrics::DrawImGuiStats(const float backbuffer_scale)
     }
   }
 
+  if (g_ActiveConfig.bShowGPUPassTimes && g_gpu_timing)
+  {
+    // Position in the top-right corner of the screen.
+    ImGui::SetNextWindowPos(ImVec2(window_x, window_y), ImGuiCond_Always, ImVec2(1.0f, 0.0f));
+    ImGui::SetNextWindowBgAlpha(bg_alpha);
+
+    if (ImGui::Begin("GPUPassTimes", nullptr, imgui_flags))
+    {
+      const auto& times = g_gpu_timing->GetLastFrameTimes();
+      if (!times)
+      {
+        ImGui::TextColored(ImVec4(r, g, b, 1.0f), "GPU timing unavailable");
+      }
+      else
+      {
+        for (u32 i = 0; i < GPUTiming::NUM_PASSES; i++)
+        {
+          ImGui::TextColored(ImVec4(r, g, b, 1.0f), "%s:%6.2lfms",
+                             GPUTiming::GetPassName(static_cast<GPUTimingPass>(i)), (*times)[i]);
+        }
+      }
+      ImGui::End();
+    }
+  }
+
   ImGui::PopStyleVar(2);
+
+  DrawCoreTimingStats(backbuffer_scale);
+  if (g_ActiveConfig.bShowMemoryUsage)
+    DrawMemoryUsage(backbuffer_scale);
+}
+
+void PerformanceMetrics::DrawCoreTimingStats(const float backbuffer_scale)
+{
+  auto& core_timing = Core::System::GetInstance().GetCoreTiming();
+  const auto event_stats = core_timing.GetEventStats();
+  if (event_stats.empty())
+    return;
+
+  static constexpr size_t max_rows = 12;
+  const float window_padding = 8.f * backbuffer_scale;
+
+  // Position in the bottom-left corner of the screen, away from the other stats.
+  ImGui::SetNextWindowPos(ImVec2(window_padding, ImGui::GetIO().DisplaySize.y - window_padding),
+                          ImGuiCond_Always, ImVec2(0.0f, 1.0f));
+  ImGui::SetNextWindowBgAlpha(0.7f);
+
+  if (ImGui::Begin("CoreTimingStats", nullptr,
+                   ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoMove |
+                       ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_NoNav |
+                       ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoFocusOnAppearing))
+  {
+    if (ImGui::BeginTable("CoreTimingStatsTable", 4))
+    {
+      ImGui::TableSetupColumn("Event");
+      ImGui::TableSetupColumn("Calls");
+      ImGui::TableSetupColumn("Host ms");
+      ImGui::TableSetupColumn("us/call");
+      ImGui::TableHeadersRow();
+
+      for (size_t i = 0; i < std::min(event_stats.size(), max_rows); ++i)
+      {
+        const auto& [name, stats] = event_stats[i];
+        ImGui::TableNextRow();
+        ImGui::TableNextColumn();
+        ImGui::TextUnformatted(name.c_str());
+        ImGui::TableNextColumn();
+        ImGui::Text("%llu", static_cast<unsigned long long>(stats.invocations));
+        ImGui::TableNextColumn();
+        ImGui::Text("%.2f", stats.host_ns / 1e6);
+        ImGui::TableNextColumn();
+        ImGui::Text("%.2f", stats.host_ns / 1e3 / stats.invocations);
+      }
+      ImGui::EndTable();
+    }
+
+    if (ImGui::Button("Reset"))
+      core_timing.ResetEventStats();
+    ImGui::SameLine();
+    if (ImGui::Button("Dump to JSON"))
+    {
+      const std::string path = fmt::format("{}{}_coretiming_events.json",
+                                           File::GetUserPath(D_DUMPDEBUG_IDX),
+                                           SConfig::GetInstance().GetGameID());
+      File::CreateFullPath(path);
+      core_timing.DumpEventStats(path);
+    }
+  }
+  ImGui::End();
+}
+
+void PerformanceMetrics::DrawMemoryUsage(const float backbuffer_scale)
+{
+  const float window_padding = 8.f * backbuffer_scale;
+
+  // Position in the bottom-right corner of the screen.
+  const ImVec2& display_size = ImGui::GetIO().DisplaySize;
+  ImGui::SetNextWindowPos(
+      ImVec2(display_size.x - window_padding, display_size.y - window_padding), ImGuiCond_Always,
+      ImVec2(1.0f, 1.0f));
+  ImGui::SetNextWindowBgAlpha(0.7f);
+
+  if (ImGui::Begin("MemoryUsage", nullptr,
+                   ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoMove |
+                       ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_NoNav |
+                       ImGuiWindowFlags_NoInputs | ImGuiWindowFlags_AlwaysAutoResize |
+                       ImGuiWindowFlags_NoFocusOnAppearing))
+  {
+    if (ImGui::BeginTable("MemoryUsageTable", 4))
+    {
+      ImGui::TableSetupColumn("Memory");
+      ImGui::TableSetupColumn("MiB");
+      ImGui::TableSetupColumn("Peak");
+      ImGui::TableSetupColumn("Budget");
+      ImGui::TableHeadersRow();
+
+      constexpr double MIB = 1024.0 * 1024.0;
+      constexpr size_t num_subsystems =
+          static_cast<size_t>(Common::MemoryAccounting::Subsystem::NumSubsystems);
+      for (size_t i = 0; i < num_subsystems; ++i)
+      {
+        const auto subsystem = static_cast<Common::MemoryAccounting::Subsystem>(i);
+        const Common::MemoryAccounting::Usage usage = Common::MemoryAccounting::GetUsage(subsystem);
+        const std::string_view name = Common::MemoryAccounting::GetName(subsystem);
+
+        ImGui::TableNextRow();
+        ImGui::TableNextColumn();
+        ImGui::TextUnformatted(name.data(), name.data() + name.size());
+        ImGui::TableNextColumn();
+        ImGui::Text("%.1f", usage.current / MIB);
+        ImGui::TableNextColumn();
+        ImGui::Text("%.1f", usage.peak / MIB);
+        ImGui::TableNextColumn();
+        if (usage.budget != 0)
+          ImGui::Text("%.1f", usage.budget / MIB);
+        else
+          ImGui::TextUnformatted("-");
+      }
+      ImGui::EndTable();
+    }
+  }
+  ImGui::End();
 }
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 #include <shared_mutex>
 
 #include "Common/CommonTypes.h"
@@ -33,6 +34,12 @@ public:
   void CountThrottleSleep(DT sleep);
   void CountPerformanceMarker(Core::System& system, s64 cyclesLate);
 
+  // Timing the GPU thread costs two clock reads per loop, so it's only done while something is
+  // reading the busy time, such as a client of the metrics server.
+  void SetBusySamplingEnabled(bool enabled);
+  bool IsBusySamplingEnabled() const;
+  void CountGPUBusyTime(DT busy);
+
   // Getter Functions
   double GetFPS() const;
   double GetVPS() const;
@@ -41,10 +48,19 @@ public:
 
   double GetLastSpeedDenominator() const;
 
+  DT GetFrameTimePercentile(double percentile) const;
+
+  // Totals since the last Reset(). The CPU thread counts as busy whenever it isn't throttling.
+  DT GetCPUBusyTime() const;
+  DT GetGPUBusyTime() const;
+
   // ImGui Functions
   void DrawImGuiStats(const float backbuffer_scale);
 
 private:
+  void DrawCoreTimingStats(const float backbuffer_scale);
+  void DrawMemoryUsage(const float backbuffer_scale);
+
   PerformanceTracker m_fps_counter{"render_times.txt"};
   PerformanceTracker m_vps_counter{"vblank_times.txt"};
   PerformanceTracker m_speed_counter{std::nullopt, 1000000};
@@ -57,6 +73,10 @@ private:
   std::array<TimePoint, 256> m_real_times{};
   std::array<TimePoint, 256> m_cpu_times{};
   DT m_time_sleeping{};
+  TimePoint m_reset_time{};
+
+  std::atomic<bool> m_busy_sampling_enabled = false;
+  std::atomic<s64> m_gpu_busy_ns = 0;
 };
 
 extern PerformanceMetrics g_perf_metrics;
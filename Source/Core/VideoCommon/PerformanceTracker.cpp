@@ -7,6 +7,7 @@
 #include <cmath>
 #include <iomanip>
 #include <mutex>
+#include <vector>
 
 #include <implot.h>
 
@@ -129,6 +130,26 @@ DT PerformanceTracker::GetDtStd() const
   return *(m_dt_std = std::chrono::duration_cast<DT>(DT_s(std::sqrt(total / QueueSize()))));
 }
 
+DT PerformanceTracker::GetDtPercentile(double percentile) const
+{
+  std::vector<DT> dts;
+  {
+    std::shared_lock lock{m_mutex};
+    dts.reserve(QueueSize());
+    for (std::size_t i = m_dt_queue_begin; i != m_dt_queue_end; i = IncrementIndex(i))
+      dts.push_back(m_dt_queue[i]);
+  }
+
+  if (dts.empty())
+    return DT::zero();
+
+  const std::size_t rank = static_cast<std::size_t>(
+      std::ceil(std::clamp(percentile, 0.0, 1.0) * static_cast<double>(dts.size())));
+  const auto nth = dts.begin() + (std::max<std::size_t>(rank, 1) - 1);
+  std::nth_element(dts.begin(), nth, dts.end());
+  return *nth;
+}
+
 DT PerformanceTracker::GetLastRawDt() const
 {
   std::shared_lock lock{m_mutex};
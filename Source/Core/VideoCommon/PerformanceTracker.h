@@ -54,6 +54,8 @@ public:
 
   DT GetDtAvg() const;
   DT GetDtStd() const;
+  // Nearest-rank percentile of the dt's in the window, with percentile in [0, 1].
+  DT GetDtPercentile(double percentile) const;
 
   DT GetLastRawDt() const;
 
@@ -178,6 +178,8 @@ void PixelShaderManager::SetConstants()
 void PixelShaderManager::SetTevColor(int index, int component, s32 value)
 {
   auto& c = constants.colors[index];
+  if (c[component] == value)
+    return;
   c[component] = value;
   dirty = true;
 
@@ -187,6 +189,8 @@ void PixelShaderManager::SetTevColor(int index, int component, s32 value)
 void PixelShaderManager::SetTevKonstColor(int index, int component, s32 value)
 {
   auto& c = constants.kcolors[index];
+  if (c[component] == value)
+    return;
   c[component] = value;
   dirty = true;
 
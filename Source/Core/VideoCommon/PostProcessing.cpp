@@ -25,6 +25,7 @@
 #include "VideoCommon/AbstractShader.h"
 #include "VideoCommon/AbstractTexture.h"
 #include "VideoCommon/FramebufferManager.h"
+#include "VideoCommon/GPUTiming.h"
 #include "VideoCommon/Present.h"
 #include "VideoCommon/ShaderCache.h"
 #include "VideoCommon/VertexManagerBase.h"
@@ -510,6 +511,7 @@ void PostProcessing::BlitFromTexture(const MathUtil::Rectangle<int>& dst,
   // -Keep the post process phase in linear space, to better operate with colors
   if (m_default_pipeline && needs_default_pipeline && needs_intermediary_buffer)
   {
+    GPUTimingScope timing_scope(GPUTimingPass::PostProcessingIntermediary);
     AbstractFramebuffer* const previous_framebuffer = g_gfx->GetCurrentFramebuffer();
 
     // We keep the min number of layers as the render target,
@@ -4,6 +4,7 @@
 #include "VideoCommon/Present.h"
 
 #include "Common/ChunkFile.h"
+#include "Common/TraceZone.h"
 #include "Core/Config/GraphicsSettings.h"
 #include "Core/HW/VideoInterface.h"
 #include "Core/Host.h"
@@ -15,6 +16,7 @@
 #include "VideoCommon/AbstractGfx.h"
 #include "VideoCommon/FrameDumper.h"
 #include "VideoCommon/FramebufferManager.h"
+#include "VideoCommon/GPUTiming.h"
 #include "VideoCommon/OnScreenUI.h"
 #include "VideoCommon/PostProcessing.h"
 #include "VideoCommon/Statistics.h"
@@ -758,6 +760,8 @@ void Presenter::RenderXFBToScreen(const MathUtil::Rectangle<int>& target_rc,
                                   const AbstractTexture* source_texture,
                                   const MathUtil::Rectangle<int>& source_rc)
 {
+  GPUTimingScope timing_scope(GPUTimingPass::PostProcessing);
+
   if (g_ActiveConfig.stereo_mode == StereoMode::QuadBuffer &&
       g_ActiveConfig.backend_info.bUsesExplictQuadBuffering)
   {
@@ -788,6 +792,7 @@ void Presenter::RenderXFBToScreen(const MathUtil::Rectangle<int>& target_rc,
 
 void Presenter::Present()
 {
+  TRACE_ZONE("Presenter::Present");
   m_present_count++;
 
   if (g_gfx->IsHeadless() || (!m_onscreen_ui && !m_xfb_entry))
@@ -816,6 +821,7 @@ void Presenter::Present()
   UpdateDrawRectangle();
 
   g_gfx->BeginUtilityDrawing();
+  g_gpu_timing->BeginPass(GPUTimingPass::Present);
   g_gfx->BindBackbuffer({{0.0f, 0.0f, 0.0f, 1.0f}});
 
   // Render the XFB to the screen.
@@ -836,6 +842,7 @@ void Presenter::Present()
   }
 
   // Present to the window system.
+  g_gpu_timing->EndPass(GPUTimingPass::Present);
   {
     std::lock_guard<std::mutex> guard(m_swap_mutex);
     g_gfx->PresentBackbuffer();
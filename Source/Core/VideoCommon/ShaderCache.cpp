@@ -6,8 +6,10 @@
 #include <fmt/format.h>
 
 #include "Common/Assert.h"
+#include "Common/CommonPaths.h"
 #include "Common/FileUtil.h"
 #include "Common/MsgHandler.h"
+#include "Common/TraceZone.h"
 #include "Core/ConfigManager.h"
 
 #include "VideoCommon/AbstractGfx.h"
@@ -15,7 +17,9 @@
 #include "VideoCommon/DriverDetails.h"
 #include "VideoCommon/FramebufferManager.h"
 #include "VideoCommon/FramebufferShaderGen.h"
+#include "VideoCommon/FrameTimeReport.h"
 #include "VideoCommon/Present.h"
+#include "VideoCommon/Spirv.h"
 #include "VideoCommon/Statistics.h"
 #include "VideoCommon/VertexLoaderManager.h"
 #include "VideoCommon/VertexManagerBase.h"
@@ -46,14 +50,19 @@ bool ShaderCache::Initialize()
     return false;
 
   m_async_shader_compiler = g_gfx->CreateAsyncShaderCompiler();
-  m_frame_end_handler = AfterFrameEvent::Register([this](Core::System&) { RetrieveAsyncShaders(); },
-                                                  "RetrieveAsyncShaders");
+  m_frame_end_handler = AfterFrameEvent::Register(
+      [this](Core::System&) {
+        RetrieveAsyncShaders();
+        m_frame_count++;
+      },
+      "RetrieveAsyncShaders");
   return true;
 }
 
 void ShaderCache::InitializeShaderCache()
 {
-  m_async_shader_compiler->ResizeWorkerThreads(g_ActiveConfig.GetShaderPrecompilerThreads());
+  m_async_shader_compiler->ResizeWorkerThreads(g_ActiveConfig.GetShaderPrecompilerThreads(),
+                                              g_ActiveConfig.GetMaxShaderCompilerThreads());
 
   // Load shader and UID caches.
   if (g_ActiveConfig.bShaderCache && m_api_type != APIType::Nothing)
@@ -62,6 +71,10 @@ void ShaderCache::InitializeShaderCache()
     LoadPipelineUIDCache();
   }
 
+  // Pipelines seen on other machines, these are compiled along with the local UID cache.
+  if (m_api_type != APIType::Nothing)
+    ImportPipelineManifest();
+
   // Queue ubershader precompiling if required.
   if (g_ActiveConfig.UsingUberShaders())
     QueueUberShaderPipelines();
@@ -72,7 +85,8 @@ void ShaderCache::InitializeShaderCache()
     WaitForAsyncCompiler();
 
   // Switch to the runtime shader compiler thread configuration.
-  m_async_shader_compiler->ResizeWorkerThreads(g_ActiveConfig.GetShaderCompilerThreads());
+  m_async_shader_compiler->ResizeWorkerThreads(g_ActiveConfig.GetShaderCompilerThreads(),
+                                              g_ActiveConfig.GetMaxShaderCompilerThreads());
 }
 
 void ShaderCache::Reload()
@@ -88,7 +102,8 @@ void ShaderCache::Reload()
     LoadCaches();
 
   // Switch to the precompiling shader configuration while we rebuild.
-  m_async_shader_compiler->ResizeWorkerThreads(g_ActiveConfig.GetShaderPrecompilerThreads());
+  m_async_shader_compiler->ResizeWorkerThreads(g_ActiveConfig.GetShaderPrecompilerThreads(),
+                                              g_ActiveConfig.GetMaxShaderCompilerThreads());
 
   // We don't need to explicitly recompile the individual ubershaders here, as the pipelines
   // UIDs are still be in the map. Therefore, when these are rebuilt, the shaders will also
@@ -96,7 +111,8 @@ void ShaderCache::Reload()
   CompileMissingPipelines();
   if (g_ActiveConfig.bWaitForShadersBeforeStarting)
     WaitForAsyncCompiler();
-  m_async_shader_compiler->ResizeWorkerThreads(g_ActiveConfig.GetShaderCompilerThreads());
+  m_async_shader_compiler->ResizeWorkerThreads(g_ActiveConfig.GetShaderCompilerThreads(),
+                                              g_ActiveConfig.GetMaxShaderCompilerThreads());
 }
 
 void ShaderCache::RetrieveAsyncShaders()
@@ -112,14 +128,46 @@ void ShaderCache::Shutdown()
     m_async_shader_compiler->StopWorkerThreads();
 
   ClosePipelineUIDCache();
+  SPIRV::CloseCache();
+
+  if (g_ActiveConfig.bExportPipelineManifest)
+    ExportPipelineManifest();
+}
+
+ShaderCache::RecentGXPipeline& ShaderCache::GetRecentGXPipelineSlot(const GXPipelineUid& uid,
+                                                                     u64* hash)
+{
+  // The padding in the UID is zeroed (see GXPipelineUid), so it can be hashed a word at a time.
+  static_assert(sizeof(GXPipelineUid) % sizeof(u64) == 0);
+  const u8* const data = reinterpret_cast<const u8*>(&uid);
+  u64 value = 0;
+  for (size_t offset = 0; offset < sizeof(GXPipelineUid); offset += sizeof(u64))
+  {
+    u64 word;
+    std::memcpy(&word, data + offset, sizeof(word));
+    value = (value ^ word) * 0x9E3779B97F4A7C15ULL;
+  }
+  value ^= value >> 32;
+
+  *hash = value;
+  return m_recent_gx_pipelines[value & (RECENT_GX_PIPELINE_COUNT - 1)];
 }
 
 const AbstractPipeline* ShaderCache::GetPipelineForUid(const GXPipelineUid& uid)
 {
+  u64 hash;
+  RecentGXPipeline& recent = GetRecentGXPipelineSlot(uid, &hash);
+  if (recent.pipeline && recent.hash == hash && recent.uid == uid)
+    return recent.pipeline;
+
   auto it = m_gx_pipeline_cache.find(uid);
   if (it != m_gx_pipeline_cache.end() && !it->second.second)
+  {
+    recent = {hash, uid, it->second.first.get(), nullptr};
     return it->second.first.get();
+  }
 
+  const FrameTimeReport::CauseScope stutter_scope(StutterCause::ShaderCompile);
   const bool exists_in_cache = it != m_gx_pipeline_cache.end();
   std::unique_ptr<AbstractPipeline> pipeline;
   std::optional<AbstractPipelineConfig> pipeline_config = GetGXPipelineConfig(uid);
@@ -132,17 +180,54 @@ const AbstractPipeline* ShaderCache::GetPipelineForUid(const GXPipelineUid& uid)
 
 std::optional<const AbstractPipeline*> ShaderCache::GetPipelineForUidAsync(const GXPipelineUid& uid)
 {
+  u64 hash;
+  RecentGXPipeline& recent = GetRecentGXPipelineSlot(uid, &hash);
+  const bool recent_hit = recent.pipeline && recent.hash == hash && recent.uid == uid;
+
+  PipelineUsageStats& stats =
+      recent_hit && recent.stats ? *recent.stats : m_gx_pipeline_stats[uid];
+  const bool first_use_this_frame =
+      stats.frames_used == 0 || stats.last_used_frame != m_frame_count;
+  if (first_use_this_frame)
+  {
+    stats.frames_used++;
+    stats.last_used_frame = m_frame_count;
+  }
+
+  if (recent_hit)
+  {
+    recent.stats = &stats;
+    return recent.pipeline;
+  }
+
   auto it = m_gx_pipeline_cache.find(uid);
   if (it != m_gx_pipeline_cache.end())
   {
     // .second is the pending flag, i.e. compiling in the background.
     if (!it->second.second)
+    {
+      recent = {hash, uid, it->second.first.get(), &stats};
       return it->second.first.get();
-    else
-      return {};
+    }
+
+    if (first_use_this_frame)
+      stats.ubershader_frames++;
+    return {};
+  }
+
+  if (first_use_this_frame)
+    stats.ubershader_frames++;
+
+  // Pipelines which are only drawn with briefly aren't worth compiling, keep them on the
+  // ubershaders until they have been used for long enough.
+  if (g_ActiveConfig.iShaderCompilationMode == ShaderCompilationMode::AsynchronousUberShaders &&
+      stats.frames_used < static_cast<u32>(g_ActiveConfig.iHybridUberShaderSpecializationFrames))
+  {
+    return {};
   }
 
   AppendGXPipelineUID(uid);
+  stats.queued_time = std::chrono::steady_clock::now();
   QueuePipelineCompile(uid, COMPILE_PRIORITY_ONDEMAND_PIPELINE);
   return {};
 }
@@ -153,6 +238,7 @@ const AbstractPipeline* ShaderCache::GetUberPipelineForUid(const GXUberPipelineU
   if (it != m_gx_uber_pipeline_cache.end() && !it->second.second)
     return it->second.first.get();
 
+  const FrameTimeReport::CauseScope stutter_scope(StutterCause::ShaderCompile);
   std::unique_ptr<AbstractPipeline> pipeline;
   std::optional<AbstractPipelineConfig> pipeline_config = GetGXPipelineConfig(uid);
   if (pipeline_config)
@@ -383,6 +469,7 @@ void ShaderCache::LoadCaches()
 
 void ShaderCache::ClearCaches()
 {
+  m_recent_gx_pipelines.fill({});
   ClearPipelineCache(m_gx_pipeline_cache, m_gx_pipeline_disk_cache);
   ClearShaderCache(m_vs_cache);
   ClearShaderCache(m_gs_cache);
@@ -432,6 +519,7 @@ void ShaderCache::CompileMissingPipelines()
 
 std::unique_ptr<AbstractShader> ShaderCache::CompileVertexShader(const VertexShaderUid& uid) const
 {
+  TRACE_ZONE("ShaderCache::CompileVertexShader");
   const ShaderCode source_code =
       GenerateVertexShaderCode(m_api_type, m_host_config, uid.GetUidData());
   return g_gfx->CreateShaderFromSource(ShaderStage::Vertex, source_code.GetBuffer());
@@ -440,6 +528,7 @@ std::unique_ptr<AbstractShader> ShaderCache::CompileVertexShader(const VertexSha
 std::unique_ptr<AbstractShader>
 ShaderCache::CompileVertexUberShader(const UberShader::VertexShaderUid& uid) const
 {
+  TRACE_ZONE("ShaderCache::CompileVertexUberShader");
   const ShaderCode source_code =
       UberShader::GenVertexShader(m_api_type, m_host_config, uid.GetUidData());
   return g_gfx->CreateShaderFromSource(ShaderStage::Vertex, source_code.GetBuffer(),
@@ -448,6 +537,7 @@ ShaderCache::CompileVertexUberShader(const UberShader::VertexShaderUid& uid) con
 
 std::unique_ptr<AbstractShader> ShaderCache::CompilePixelShader(const PixelShaderUid& uid) const
 {
+  TRACE_ZONE("ShaderCache::CompilePixelShader");
   const ShaderCode source_code =
       GeneratePixelShaderCode(m_api_type, m_host_config, uid.GetUidData(), {});
   return g_gfx->CreateShaderFromSource(ShaderStage::Pixel, source_code.GetBuffer());
@@ -456,6 +546,7 @@ std::unique_ptr<AbstractShader> ShaderCache::CompilePixelShader(const PixelShade
 std::unique_ptr<AbstractShader>
 ShaderCache::CompilePixelUberShader(const UberShader::PixelShaderUid& uid) const
 {
+  TRACE_ZONE("ShaderCache::CompilePixelUberShader");
   const ShaderCode source_code =
       UberShader::GenPixelShader(m_api_type, m_host_config, uid.GetUidData(), {});
   return g_gfx->CreateShaderFromSource(ShaderStage::Pixel, source_code.GetBuffer(),
@@ -552,6 +643,7 @@ const AbstractShader* ShaderCache::InsertPixelUberShader(const UberShader::Pixel
 
 const AbstractShader* ShaderCache::CreateGeometryShader(const GeometryShaderUid& uid)
 {
+  TRACE_ZONE("ShaderCache::CreateGeometryShader");
   const ShaderCode source_code =
       GenerateGeometryShaderCode(m_api_type, m_host_config, uid.GetUidData());
   std::unique_ptr<AbstractShader> shader =
@@ -874,6 +966,17 @@ const AbstractPipeline* ShaderCache::InsertGXPipeline(const GXPipelineUid& confi
 {
   auto& entry = m_gx_pipeline_cache[config];
   entry.second = false;
+
+  if (const auto stats_it = m_gx_pipeline_stats.find(config);
+      stats_it != m_gx_pipeline_stats.end() && stats_it->second.queued_time)
+  {
+    PipelineUsageStats& stats = stats_it->second;
+    stats.compile_latency_ms = std::chrono::duration<float, std::milli>(
+                                   std::chrono::steady_clock::now() - *stats.queued_time)
+                                   .count();
+    stats.queued_time.reset();
+  }
+
   if (!entry.first && pipeline)
   {
     entry.first = std::move(pipeline);
@@ -999,6 +1102,114 @@ void ShaderCache::ClosePipelineUIDCache()
   m_gx_pipeline_uid_cache_file.Close();
 }
 
+// Pipeline manifests contain only pipeline UIDs, which do not depend on the GPU, driver or backend,
+// so they can be shared between machines. The layout is the same as the UID cache.
+constexpr u32 PIPELINE_MANIFEST_MAGIC = 0x4E414D50;  // PMAN
+
+static std::string GetPipelineManifestFileName(unsigned int path_index)
+{
+  return fmt::format("{}" PIPELINE_MANIFESTS_DIR DIR_SEP "{}.pipelines",
+                     File::GetUserPath(path_index), SConfig::GetInstance().GetGameID());
+}
+
+void ShaderCache::ImportPipelineManifest()
+{
+  const std::string filename = GetPipelineManifestFileName(D_LOAD_IDX);
+  File::IOFile file(filename, "rb");
+  if (!file)
+    return;
+
+  u32 magic;
+  u32 version;
+  if (!file.ReadBytes(&magic, sizeof(magic)) || !file.ReadBytes(&version, sizeof(version)) ||
+      magic != PIPELINE_MANIFEST_MAGIC || version != GX_PIPELINE_UID_VERSION)
+  {
+    WARN_LOG_FMT(VIDEO, "Ignoring pipeline manifest {} from a different version.", filename);
+    return;
+  }
+
+  const size_t known_count = m_gx_pipeline_cache.size();
+  SerializedGXPipelineUid serialized_uid;
+  while (file.ReadBytes(&serialized_uid, sizeof(serialized_uid)))
+  {
+    // Manifest entries are also written to the local UID cache, so they survive without it.
+    GXPipelineUid real_uid;
+    UnserializePipelineUid(serialized_uid, real_uid);
+    if (m_gx_pipeline_cache.find(real_uid) != m_gx_pipeline_cache.end())
+      continue;
+
+    AddSerializedGXPipelineUID(serialized_uid);
+    AppendGXPipelineUID(real_uid);
+  }
+
+  INFO_LOG_FMT(VIDEO, "Imported {} new pipeline UIDs from {}",
+               m_gx_pipeline_cache.size() - known_count, filename);
+}
+
+void ShaderCache::ExportPipelineManifest() const
+{
+  // Pipelines which were never compiled because they stayed on the ubershaders are exported too,
+  // the usage statistics can be used to decide which ones are worth precompiling.
+  std::vector<const GXPipelineUid*> uids;
+  uids.reserve(m_gx_pipeline_cache.size());
+  for (const auto& [uid, entry] : m_gx_pipeline_cache)
+    uids.push_back(&uid);
+  for (const auto& [uid, stats] : m_gx_pipeline_stats)
+  {
+    if (!m_gx_pipeline_cache.contains(uid))
+      uids.push_back(&uid);
+  }
+
+  const std::string filename = GetPipelineManifestFileName(D_DUMP_IDX);
+  File::CreateFullPath(filename);
+
+  File::IOFile file(filename, "wb");
+  bool success = file.WriteBytes(&PIPELINE_MANIFEST_MAGIC, sizeof(PIPELINE_MANIFEST_MAGIC)) &&
+                 file.WriteBytes(&GX_PIPELINE_UID_VERSION, sizeof(GX_PIPELINE_UID_VERSION));
+  for (auto it = uids.begin(); success && it != uids.end(); ++it)
+  {
+    SerializedGXPipelineUid disk_uid;
+    SerializePipelineUid(**it, disk_uid);
+    success = file.WriteBytes(&disk_uid, sizeof(disk_uid));
+  }
+
+  if (!success)
+  {
+    ERROR_LOG_FMT(VIDEO, "Failed to write pipeline manifest {}", filename);
+    return;
+  }
+
+  INFO_LOG_FMT(VIDEO, "Exported {} pipeline UIDs to {}", uids.size(), filename);
+  ExportPipelineStats(uids);
+}
+
+void ShaderCache::ExportPipelineStats(const std::vector<const GXPipelineUid*>& uids) const
+{
+  // One row per pipeline which was requested at runtime, indexed by its position in the manifest.
+  std::string csv = "manifest_index,frames_used,ubershader_frames,compile_latency_ms\n";
+  for (size_t i = 0; i < uids.size(); i++)
+  {
+    const auto it = m_gx_pipeline_stats.find(*uids[i]);
+    if (it == m_gx_pipeline_stats.end())
+      continue;
+
+    const PipelineUsageStats& stats = it->second;
+    csv += fmt::format("{},{},{},{}\n", i, stats.frames_used, stats.ubershader_frames,
+                       stats.compile_latency_ms ? fmt::format("{:.2f}", *stats.compile_latency_ms) :
+                                                  "");
+  }
+
+  const std::string filename = GetPipelineManifestFileName(D_DUMP_IDX) + ".csv";
+  if (!File::WriteStringToFile(filename, csv))
+  {
+    ERROR_LOG_FMT(VIDEO, "Failed to write pipeline statistics {}", filename);
+    return;
+  }
+
+  INFO_LOG_FMT(VIDEO, "Exported statistics of {} pipelines to {}", m_gx_pipeline_stats.size(),
+               filename);
+}
+
 void ShaderCache::AddSerializedGXPipelineUID(const SerializedGXPipelineUid& uid)
 {
   GXPipelineUid real_uid;
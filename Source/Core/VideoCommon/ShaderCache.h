@@ -4,6 +4,7 @@
 #pragma once
 
 #include <array>
+#include <chrono>
 #include <cstddef>
 #include <cstring>
 #include <map>
@@ -12,6 +13,7 @@
 #include <string>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/IOFile.h"
@@ -122,6 +124,9 @@ private:
   void ClearCaches();
   void LoadPipelineUIDCache();
   void ClosePipelineUIDCache();
+  void ImportPipelineManifest();
+  void ExportPipelineManifest() const;
+  void ExportPipelineStats(const std::vector<const GXPipelineUid*>& uids) const;
   void CompileMissingPipelines();
   void QueueUberShaderPipelines();
   bool CompileSharedPipelines();
@@ -216,7 +221,7 @@ private:
       bool pending = false;
     };
     std::map<Uid, Shader> shader_map;
-    Common::LinearDiskCache<Uid, u8> disk_cache;
+    Common::LinearDiskCache<Uid, u8> disk_cache{true};
   };
   ShaderModuleCache<VertexShaderUid> m_vs_cache;
   ShaderModuleCache<GeometryShaderUid> m_gs_cache;
@@ -229,8 +234,34 @@ private:
   std::map<GXUberPipelineUid, std::pair<std::unique_ptr<AbstractPipeline>, bool>>
       m_gx_uber_pipeline_cache;
   File::IOFile m_gx_pipeline_uid_cache_file;
-  Common::LinearDiskCache<SerializedGXPipelineUid, u8> m_gx_pipeline_disk_cache;
-  Common::LinearDiskCache<SerializedGXUberPipelineUid, u8> m_gx_uber_pipeline_disk_cache;
+
+  // Hybrid ubershader accounting for specialized pipelines. Frames are counted once per frame in
+  // which the pipeline was bound, whether or not the specialized pipeline was ready.
+  struct PipelineUsageStats
+  {
+    u64 last_used_frame = 0;
+    u32 frames_used = 0;
+    u32 ubershader_frames = 0;
+    std::optional<std::chrono::steady_clock::time_point> queued_time;
+    std::optional<float> compile_latency_ms;
+  };
+  std::map<GXPipelineUid, PipelineUsageStats> m_gx_pipeline_stats;
+  u64 m_frame_count = 0;
+
+  // Direct-mapped cache of recently bound specialized pipelines, indexed by a hash of the UID.
+  // Games which switch between a handful of pipelines every draw hit this instead of the maps.
+  struct RecentGXPipeline
+  {
+    u64 hash = 0;
+    GXPipelineUid uid;
+    const AbstractPipeline* pipeline = nullptr;
+    PipelineUsageStats* stats = nullptr;
+  };
+  static constexpr size_t RECENT_GX_PIPELINE_COUNT = 64;
+  RecentGXPipeline& GetRecentGXPipelineSlot(const GXPipelineUid& uid, u64* hash);
+  std::array<RecentGXPipeline, RECENT_GX_PIPELINE_COUNT> m_recent_gx_pipelines;
+  Common::LinearDiskCache<SerializedGXPipelineUid, u8> m_gx_pipeline_disk_cache{true};
+  Common::LinearDiskCache<SerializedGXUberPipelineUid, u8> m_gx_uber_pipeline_disk_cache{true};
 
   // EFB copy to VRAM/RAM pipelines
   std::map<TextureConversionShaderGen::TCShaderUid, std::unique_ptr<AbstractPipeline>>
@@ -8,17 +8,37 @@
 #include "ResourceLimits.h"
 #include "disassemble.h"
 
+#include <mutex>
+
+#include "Common/Crypto/SHA1.h"
 #include "Common/FileUtil.h"
+#include "Common/LinearDiskCache.h"
 #include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
 #include "Common/StringUtil.h"
 #include "Common/Version.h"
 
+#include "VideoCommon/ShaderGenCommon.h"
 #include "VideoCommon/VideoBackendBase.h"
 #include "VideoCommon/VideoConfig.h"
 
 namespace
 {
+// SPIR-V only depends on the source and on how glslang was invoked, so one cache is shared by all
+// backends and survives driver changes. D3D and Metal then only have to translate it further.
+struct SPIRVCacheKey
+{
+  Common::SHA1::Digest source_digest;
+  u32 stage;
+  u32 api_type;
+  u32 language_version;
+};
+static_assert(sizeof(SPIRVCacheKey) == Common::SHA1::DIGEST_LEN + 3 * sizeof(u32));
+
+std::mutex s_spirv_cache_mutex;
+Common::LinearDiskCache<SPIRVCacheKey, SPIRV::CodeType> s_spirv_cache{true};
+bool s_spirv_cache_open = false;
+
 bool InitializeGlslang()
 {
   static bool glslang_initialized = false;
@@ -158,6 +178,44 @@ CompileShaderToSPV(EShLanguage stage, APIType api_type,
 
   return out_code;
 }
+
+std::optional<SPIRV::CodeVector>
+CompileShaderToSPVCached(EShLanguage stage, APIType api_type,
+                         glslang::EShTargetLanguageVersion language_version,
+                         const char* stage_filename, std::string_view source)
+{
+  // Debug builds of shaders embed the source and skip the optimizer, there's no point caching them.
+  if (!g_ActiveConfig.bShaderCache || g_ActiveConfig.bEnableValidationLayer)
+    return CompileShaderToSPV(stage, api_type, language_version, stage_filename, source);
+
+  const SPIRVCacheKey key{Common::SHA1::CalculateDigest(source), static_cast<u32>(stage),
+                          static_cast<u32>(api_type), static_cast<u32>(language_version)};
+  {
+    std::lock_guard lk(s_spirv_cache_mutex);
+    if (!s_spirv_cache_open)
+    {
+      const std::string filename =
+          GetDiskShaderCacheFileName(api_type, "spirv", false, false, false);
+      const u32 count = s_spirv_cache.Open(filename);
+      INFO_LOG_FMT(VIDEO, "Opened SPIR-V cache {} with {} entries", filename, count);
+      s_spirv_cache_open = true;
+    }
+
+    SPIRV::CodeVector cached_code;
+    if (s_spirv_cache.Lookup(key, &cached_code))
+      return cached_code;
+  }
+
+  // Compile outside of the lock, so that the worker threads still compile in parallel.
+  std::optional<SPIRV::CodeVector> code =
+      CompileShaderToSPV(stage, api_type, language_version, stage_filename, source);
+  if (code)
+  {
+    std::lock_guard lk(s_spirv_cache_mutex);
+    s_spirv_cache.Append(key, code->data(), static_cast<u32>(code->size()));
+  }
+  return code;
+}
 }  // namespace
 
 namespace SPIRV
@@ -165,24 +223,31 @@ namespace SPIRV
 std::optional<CodeVector> CompileVertexShader(std::string_view source_code, APIType api_type,
                                               glslang::EShTargetLanguageVersion language_version)
 {
-  return CompileShaderToSPV(EShLangVertex, api_type, language_version, "vs", source_code);
+  return CompileShaderToSPVCached(EShLangVertex, api_type, language_version, "vs", source_code);
 }
 
 std::optional<CodeVector> CompileGeometryShader(std::string_view source_code, APIType api_type,
                                                 glslang::EShTargetLanguageVersion language_version)
 {
-  return CompileShaderToSPV(EShLangGeometry, api_type, language_version, "gs", source_code);
+  return CompileShaderToSPVCached(EShLangGeometry, api_type, language_version, "gs", source_code);
 }
 
 std::optional<CodeVector> CompileFragmentShader(std::string_view source_code, APIType api_type,
                                                 glslang::EShTargetLanguageVersion language_version)
 {
-  return CompileShaderToSPV(EShLangFragment, api_type, language_version, "ps", source_code);
+  return CompileShaderToSPVCached(EShLangFragment, api_type, language_version, "ps", source_code);
 }
 
 std::optional<CodeVector> CompileComputeShader(std::string_view source_code, APIType api_type,
                                                glslang::EShTargetLanguageVersion language_version)
 {
-  return CompileShaderToSPV(EShLangCompute, api_type, language_version, "cs", source_code);
+  return CompileShaderToSPVCached(EShLangCompute, api_type, language_version, "cs", source_code);
+}
+
+void CloseCache()
+{
+  std::lock_guard lk(s_spirv_cache_mutex);
+  s_spirv_cache.Close();
+  s_spirv_cache_open = false;
 }
 }  // namespace SPIRV
@@ -34,4 +34,7 @@ std::optional<CodeVector> CompileFragmentShader(std::string_view source_code, AP
 // Compile a compute shader to SPIR-V.
 std::optional<CodeVector> CompileComputeShader(std::string_view source_code, APIType api_type,
                                                glslang::EShTargetLanguageVersion language_version);
+
+// Writes out and closes the cache of compiled SPIR-V, which is opened again on the next compile.
+void CloseCache();
 }  // namespace SPIRV
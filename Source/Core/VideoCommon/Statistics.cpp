@@ -90,6 +90,8 @@ void Statistics::Display() const
   draw_statistic("Textures created", "%d", num_textures_created);
   draw_statistic("Textures uploaded", "%d", num_textures_uploaded);
   draw_statistic("Textures alive", "%d", num_textures_alive);
+  draw_statistic("Textures created (frame)", "%d", this_frame.num_textures_created);
+  draw_statistic("Textures destroyed (frame)", "%d", this_frame.num_textures_destroyed);
   draw_statistic("pshaders created", "%d", num_pixel_shaders_created);
   draw_statistic("pshaders alive", "%d", num_pixel_shaders_alive);
   draw_statistic("vshaders created", "%d", num_vertex_shaders_created);
@@ -98,6 +100,7 @@ void Statistics::Display() const
   draw_statistic("dlists called", "%d", this_frame.num_dlists_called);
   draw_statistic("Primitive joins", "%d", this_frame.num_primitive_joins);
   draw_statistic("Draw calls", "%d", this_frame.num_draw_calls);
+  draw_statistic("Flushes avoided", "%d", this_frame.num_flushes_avoided);
   draw_statistic("Primitives", "%d", this_frame.num_prims);
   draw_statistic("Primitives (DL)", "%d", this_frame.num_dl_prims);
   draw_statistic("XF loads", "%d", this_frame.num_xf_loads);
@@ -109,6 +112,7 @@ void Statistics::Display() const
   draw_statistic("Vertex streamed", "%i kB", this_frame.bytes_vertex_streamed / 1024);
   draw_statistic("Index streamed", "%i kB", this_frame.bytes_index_streamed / 1024);
   draw_statistic("Uniform streamed", "%i kB", this_frame.bytes_uniform_streamed / 1024);
+  draw_statistic("Stream buffer stalls", "%d", this_frame.num_stream_buffer_stalls);
   draw_statistic("Vertex Loaders", "%d", num_vertex_loaders);
   draw_statistic("EFB peeks:", "%d", this_frame.num_efb_peeks);
   draw_statistic("EFB pokes:", "%d", this_frame.num_efb_pokes);
@@ -55,12 +55,17 @@ struct Statistics
 
     int num_primitive_joins = 0;
     int num_draw_calls = 0;
+    int num_flushes_avoided = 0;
 
     int num_dlists_called = 0;
 
     int bytes_vertex_streamed = 0;
     int bytes_index_streamed = 0;
     int bytes_uniform_streamed = 0;
+    int num_stream_buffer_stalls = 0;
+
+    int num_textures_created = 0;
+    int num_textures_destroyed = 0;
 
     int num_triangles_clipped = 0;
     int num_triangles_in = 0;
@@ -99,6 +99,29 @@ static u32 CalculateUnitSize(TextureUnitState::BankConfig bank_config);
 
 static std::array<TextureUnitState, 8> s_unit;
 
+// The state of every unit as bitsets, so that the texture cache's queries and invalidations don't
+// have to walk the units. Derived from s_unit, and kept in sync by SetState.
+static BitSet32 s_valid_units;
+static BitSet32 s_cached_units;
+
+static void SetState(u32 unit, TextureUnitState::State state)
+{
+  s_unit[unit].state = state;
+  s_valid_units[unit] = state != TextureUnitState::State::INVALID;
+  s_cached_units[unit] = state == TextureUnitState::State::CACHED;
+}
+
+static void UpdateStateBits()
+{
+  s_valid_units = {};
+  s_cached_units = {};
+  for (u32 i = 0; i < s_unit.size(); i++)
+  {
+    s_valid_units[i] = s_unit[i].state != TextureUnitState::State::INVALID;
+    s_cached_units[i] = s_unit[i].state == TextureUnitState::State::CACHED;
+  }
+}
+
 // On TMEM configuration changed:
 // 1. invalidate stage.
 
@@ -107,7 +130,7 @@ void ConfigurationChanged(TexUnitAddress bp_addr, u32 config)
   TextureUnitState& unit_state = s_unit[bp_addr.GetUnitID()];
 
   // If anything has changed, we can't assume existing state is still valid.
-  unit_state.state = TextureUnitState::State::INVALID;
+  SetState(bp_addr.GetUnitID(), TextureUnitState::State::INVALID);
 
   // Note: BPStructs has already filtered out NOP changes before calling us
   switch (bp_addr.Reg)
@@ -134,10 +157,15 @@ void ConfigurationChanged(TexUnitAddress bp_addr, u32 config)
 
 void InvalidateAll()
 {
-  for (auto& unit : s_unit)
-  {
-    unit.state = TextureUnitState::State::INVALID;
-  }
+  // Games invalidate TMEM far more often than they bind textures, don't touch the units when
+  // nothing is valid anyway.
+  if (!s_valid_units)
+    return;
+
+  for (u32 i : s_valid_units)
+    s_unit[i].state = TextureUnitState::State::INVALID;
+  s_valid_units = {};
+  s_cached_units = {};
 }
 
 // On invalidate cache:
@@ -198,7 +226,7 @@ void Bind(u32 unit, int width, int height, bool is_mipmapped, bool is_32_bit)
     }
   }
 
-  unit_state.state = fits ? TextureUnitState::State::CACHED : TextureUnitState::State::VALID;
+  SetState(unit, fits ? TextureUnitState::State::CACHED : TextureUnitState::State::VALID);
 }
 
 static u32 CalculateUnitSize(TextureUnitState::BankConfig bank_config)
@@ -252,16 +280,20 @@ void FinalizeBinds(BitSet32 used_textures)
   {
     if (s_unit[i].even.Overlaps(s_unit[i].odd))
     {  // Self-overlap
-      s_unit[i].state = TextureUnitState::State::VALID;
+      SetState(i, TextureUnitState::State::VALID);
     }
-    for (size_t j = 0; j < s_unit.size(); j++)
+
+    // Only units that are valid or cached can overlap, and only cached ones need downgrading.
+    if (!s_cached_units || !s_valid_units[i])
+      continue;
+    for (u32 j : s_valid_units)
     {
       if (j != i && s_unit[i].Overlaps(s_unit[j]))
       {
         // There is an overlap, downgrade both from CACHED
         // (for there to be an overlap, both must have started as valid or cached)
-        s_unit[i].state = TextureUnitState::State::VALID;
-        s_unit[j].state = TextureUnitState::State::VALID;
+        SetState(i, TextureUnitState::State::VALID);
+        SetState(j, TextureUnitState::State::VALID);
       }
     }
   }
@@ -269,22 +301,25 @@ void FinalizeBinds(BitSet32 used_textures)
 
 bool IsCached(u32 unit)
 {
-  return s_unit[unit].state == TextureUnitState::State::CACHED;
+  return s_cached_units[unit];
 }
 
 bool IsValid(u32 unit)
 {
-  return s_unit[unit].state != TextureUnitState::State::INVALID;
+  return s_valid_units[unit];
 }
 
 void Init()
 {
   s_unit.fill({});
+  UpdateStateBits();
 }
 
 void DoState(PointerWrap& p)
 {
   p.DoArray(s_unit);
+  if (p.IsReadMode())
+    UpdateStateBits();
 }
 
 }  // namespace TMEM
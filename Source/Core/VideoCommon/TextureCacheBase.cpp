@@ -24,7 +24,9 @@
 #include "Common/Hash.h"
 #include "Common/Logging/Log.h"
 #include "Common/MathUtil.h"
+#include "Common/MemoryAccounting.h"
 #include "Common/MemoryUtil.h"
+#include "Common/TraceZone.h"
 
 #include "Core/Config/GraphicsSettings.h"
 #include "Core/ConfigManager.h"
@@ -39,6 +41,8 @@
 #include "VideoCommon/Assets/CustomTextureData.h"
 #include "VideoCommon/BPMemory.h"
 #include "VideoCommon/FramebufferManager.h"
+#include "VideoCommon/FrameTimeReport.h"
+#include "VideoCommon/GPUTiming.h"
 #include "VideoCommon/GraphicsModSystem/Runtime/FBInfo.h"
 #include "VideoCommon/GraphicsModSystem/Runtime/GraphicsModActionData.h"
 #include "VideoCommon/GraphicsModSystem/Runtime/GraphicsModManager.h"
@@ -60,6 +64,9 @@ static const u64 TEXHASH_INVALID = 0;
 // Sonic the Fighters (inside Sonic Gems Collection) loops a 64 frames animation
 static const int TEXTURE_KILL_THRESHOLD = 64;
 static const int TEXTURE_POOL_KILL_THRESHOLD = 3;
+// Textures in the pool are destroyed early, oldest first, once they use more than this, unless
+// GFX_TEXTURE_POOL_MEMORY_LIMIT is set
+static const u64 DEFAULT_TEXTURE_POOL_MEMORY_BUDGET = 512 * 1024 * 1024;
 
 static int xfb_count = 0;
 
@@ -98,6 +105,7 @@ TextureCacheBase::TextureCacheBase()
 
   TexDecoder_SetTexFmtOverlayOptions(m_backup_config.texfmt_overlay,
                                      m_backup_config.texfmt_overlay_center);
+  Common::SetTextureHashAlgorithm(m_backup_config.hash_algorithm);
 
   HiresTexture::Init();
 
@@ -143,6 +151,8 @@ void TextureCacheBase::Invalidate()
   m_textures_by_address.clear();
 
   m_texture_pool.clear();
+  m_texture_pool_memory_usage = 0;
+  Common::MemoryAccounting::Set(Common::MemoryAccounting::Subsystem::TexturePool, 0);
 }
 
 void TextureCacheBase::OnConfigChanged(const VideoConfig& config)
@@ -158,16 +168,19 @@ void TextureCacheBase::OnConfigChanged(const VideoConfig& config)
 
   // TODO: Invalidating texcache is really stupid in some of these cases
   if (config.iSafeTextureCache_ColorSamples != m_backup_config.color_samples ||
+      config.texture_hash_algorithm != m_backup_config.hash_algorithm ||
       config.bTexFmtOverlayEnable != m_backup_config.texfmt_overlay ||
       config.bTexFmtOverlayCenter != m_backup_config.texfmt_overlay_center ||
       config.bHiresTextures != m_backup_config.hires_textures ||
       config.bEnableGPUTextureDecoding != m_backup_config.gpu_texture_decoding ||
+      config.iGPUTextureDecodingMinTexels != m_backup_config.gpu_texture_decoding_min_texels ||
       config.bDisableCopyToVRAM != m_backup_config.disable_vram_copies ||
       config.bArbitraryMipmapDetection != m_backup_config.arbitrary_mipmap_detection ||
       config.bGraphicMods != m_backup_config.graphics_mods ||
       change_count != m_backup_config.graphics_mod_change_count)
   {
     Invalidate();
+    Common::SetTextureHashAlgorithm(config.texture_hash_algorithm);
     TexDecoder_SetTexFmtOverlayOptions(config.bTexFmtOverlayEnable, config.bTexFmtOverlayCenter);
   }
 
@@ -224,13 +237,36 @@ void TextureCacheBase::Cleanup(int _frameCount)
     }
     if (_frameCount > TEXTURE_POOL_KILL_THRESHOLD + iter2->second.frameCount)
     {
-      iter2 = m_texture_pool.erase(iter2);
+      INCSTAT(g_stats.this_frame.num_textures_destroyed);
+      iter2 = RemoveFromPool(iter2);
     }
     else
     {
       ++iter2;
     }
   }
+
+  if (m_texture_pool_memory_usage > m_texture_pool_memory_budget)
+  {
+    // Textures released this frame still have FRAMECOUNT_INVALID and are kept, they're the most
+    // likely ones to be reused.
+    std::vector<TexPool::iterator> candidates;
+    for (auto pool_iter = m_texture_pool.begin(); pool_iter != m_texture_pool.end(); ++pool_iter)
+    {
+      if (pool_iter->second.frameCount != FRAMECOUNT_INVALID)
+        candidates.push_back(pool_iter);
+    }
+    std::sort(candidates.begin(), candidates.end(), [](const auto& a, const auto& b) {
+      return a->second.frameCount < b->second.frameCount;
+    });
+    for (const auto& candidate : candidates)
+    {
+      if (m_texture_pool_memory_usage <= m_texture_pool_memory_budget)
+        break;
+      INCSTAT(g_stats.this_frame.num_textures_destroyed);
+      RemoveFromPool(candidate);
+    }
+  }
 }
 
 bool TCacheEntry::OverlapsMemoryRange(u32 range_address, u32 range_size) const
@@ -247,6 +283,7 @@ bool TCacheEntry::OverlapsMemoryRange(u32 range_address, u32 range_size) const
 void TextureCacheBase::SetBackupConfig(const VideoConfig& config)
 {
   m_backup_config.color_samples = config.iSafeTextureCache_ColorSamples;
+  m_backup_config.hash_algorithm = config.texture_hash_algorithm;
   m_backup_config.texfmt_overlay = config.bTexFmtOverlayEnable;
   m_backup_config.texfmt_overlay_center = config.bTexFmtOverlayCenter;
   m_backup_config.hires_textures = config.bHiresTextures;
@@ -254,11 +291,18 @@ void TextureCacheBase::SetBackupConfig(const VideoConfig& config)
   m_backup_config.stereo_3d = config.stereo_mode != StereoMode::Off;
   m_backup_config.efb_mono_depth = config.bStereoEFBMonoDepth;
   m_backup_config.gpu_texture_decoding = config.bEnableGPUTextureDecoding;
+  m_backup_config.gpu_texture_decoding_min_texels = config.iGPUTextureDecodingMinTexels;
   m_backup_config.disable_vram_copies = config.bDisableCopyToVRAM;
   m_backup_config.arbitrary_mipmap_detection = config.bArbitraryMipmapDetection;
   m_backup_config.graphics_mods = config.bGraphicMods;
   m_backup_config.graphics_mod_change_count =
       config.graphics_mod_config ? config.graphics_mod_config->GetChangeCount() : 0;
+
+  m_texture_pool_memory_budget = config.iTexturePoolMemoryLimit > 0 ?
+                                     u64(config.iTexturePoolMemoryLimit) * 1024 * 1024 :
+                                     DEFAULT_TEXTURE_POOL_MEMORY_BUDGET;
+  Common::MemoryAccounting::SetBudget(Common::MemoryAccounting::Subsystem::TexturePool,
+                                      m_texture_pool_memory_budget);
 }
 
 bool TextureCacheBase::DidLinkedAssetsChange(const TCacheEntry& entry)
@@ -431,9 +475,7 @@ void TextureCacheBase::ScaleTextureCacheEntryTo(RcTcacheEntry& entry, u32 new_wi
 
   // At this point new_texture has the old texture in it,
   // we can potentially reuse this, so let's move it back to the pool
-  auto config = new_texture->texture->GetConfig();
-  m_texture_pool.emplace(
-      config, TexPoolEntry(std::move(new_texture->texture), std::move(new_texture->framebuffer)));
+  AddToPool(std::move(*new_texture));
 }
 
 bool TextureCacheBase::CheckReadbackTexture(u32 width, u32 height, AbstractTextureFormat format)
@@ -459,7 +501,9 @@ void TextureCacheBase::SerializeTexture(AbstractTexture* tex, const TextureConfi
   const bool skip_readback = p.IsMeasureMode();
   p.Do(config);
 
-  if (skip_readback || CheckReadbackTexture(config.width, config.height, config.format))
+  auto readbacks = m_savestate_readbacks.extract(tex);
+  if (skip_readback || readbacks ||
+      CheckReadbackTexture(config.width, config.height, config.format))
   {
     // First, measure the amount of memory needed.
     u32 total_size = 0;
@@ -499,11 +543,19 @@ void TextureCacheBase::SerializeTexture(AbstractTexture* tex, const TextureConfi
           u32 level_width = std::max(config.width >> level, 1u);
           u32 level_height = std::max(config.height >> level, 1u);
           auto rect = tex->GetConfig().GetMipRect(level);
-          m_readback_texture->CopyFromTexture(tex, rect, layer, level, rect);
 
           u32 stride = AbstractTexture::CalculateStrideForFormat(config.format, level_width);
           u32 size = stride * level_height;
-          m_readback_texture->ReadTexels(rect, texture_data, stride);
+          if (readbacks)
+          {
+            readbacks.mapped()[layer * config.levels + level]->ReadTexels(rect, texture_data,
+                                                                          stride);
+          }
+          else
+          {
+            m_readback_texture->CopyFromTexture(tex, rect, layer, level, rect);
+            m_readback_texture->ReadTexels(rect, texture_data, stride);
+          }
 
           texture_data += size;
         }
@@ -559,6 +611,46 @@ std::optional<TextureCacheBase::TexPoolEntry> TextureCacheBase::DeserializeTextu
   return tex;
 }
 
+// Copies are issued until this many bytes of staging textures are in flight.
+constexpr u64 SAVESTATE_READBACK_BATCH_SIZE = 256 * 1024 * 1024;
+
+// Issues the copies of the textures starting at 'first' into staging textures, without waiting
+// for any of them. Textures that don't get a staging copy are read back one by one instead.
+void TextureCacheBase::IssueSaveStateReadbacks(const std::vector<TCacheEntry*>& entries,
+                                               size_t first)
+{
+  u64 batch_size = 0;
+  for (size_t i = first; i < entries.size() && batch_size < SAVESTATE_READBACK_BATCH_SIZE; i++)
+  {
+    AbstractTexture* tex = entries[i]->texture.get();
+    const TextureConfig& config = tex->GetConfig();
+
+    std::vector<std::unique_ptr<AbstractStagingTexture>> readbacks;
+    readbacks.reserve(config.layers * config.levels);
+    for (u32 layer = 0; layer < config.layers; layer++)
+    {
+      for (u32 level = 0; level < config.levels; level++)
+      {
+        const u32 level_width = std::max(config.width >> level, 1u);
+        const u32 level_height = std::max(config.height >> level, 1u);
+        const TextureConfig staging_config(level_width, level_height, 1, 1, 1, config.format, 0,
+                                           AbstractTextureType::Texture_2DArray);
+        auto staging = g_gfx->CreateStagingTexture(StagingTextureType::Readback, staging_config);
+        if (!staging)
+          return;
+
+        const auto rect = config.GetMipRect(level);
+        staging->CopyFromTexture(tex, rect, layer, level, rect);
+        batch_size +=
+            AbstractTexture::CalculateStrideForFormat(config.format, level_width) * level_height;
+        readbacks.push_back(std::move(staging));
+      }
+    }
+
+    m_savestate_readbacks.emplace(tex, std::move(readbacks));
+  }
+}
+
 void TextureCacheBase::DoState(PointerWrap& p)
 {
   // Flush all pending XFB copies before either loading or saving.
@@ -640,11 +732,16 @@ void TextureCacheBase::DoSaveState(PointerWrap& p)
   // Save the texture cache entries out in the order the were referenced.
   u32 size = static_cast<u32>(entries_to_save.size());
   p.Do(size);
-  for (TCacheEntry* entry : entries_to_save)
+  for (size_t i = 0; i < entries_to_save.size(); i++)
   {
+    TCacheEntry* entry = entries_to_save[i];
+    if (p.IsWriteMode() && !m_savestate_readbacks.contains(entry->texture.get()))
+      IssueSaveStateReadbacks(entries_to_save, i);
+
     SerializeTexture(entry->texture.get(), entry->texture->GetConfig(), p);
     entry->DoState(p);
   }
+  m_savestate_readbacks.clear();
   p.DoMarker("TextureCacheEntries");
 
   // Save references for each cache entry.
@@ -788,8 +885,8 @@ void TextureCacheBase::OnFrameEnd()
 {
   // Flush any outstanding EFB copies to RAM, in case the game is running at an uncapped frame
   // rate and not waiting for vblank. Otherwise, we'd end up with a huge list of pending
-  // copies.
-  FlushEFBCopies();
+  // copies. With a readback lag, the copies older than the lag are flushed here instead.
+  FlushCompletedEFBCopies();
 
   Cleanup(g_presenter->FrameCount());
 }
@@ -1245,6 +1342,7 @@ private:
 
 TCacheEntry* TextureCacheBase::Load(const TextureInfo& texture_info)
 {
+  TRACE_ZONE("TextureCacheBase::Load");
   if (auto entry = LoadImpl(texture_info, false))
   {
     if (!DidLinkedAssetsChange(*entry))
@@ -1280,9 +1378,13 @@ TCacheEntry* TextureCacheBase::LoadImpl(const TextureInfo& texture_info, bool fo
       return entry;
     }
 
-    // Otherwise, hash the backing memory and check it's unchanged.
+    // Otherwise, hash the backing memory and check it's unchanged. With write tracking, the hash
+    // only needs to be recalculated if the pages backing the texture were written to.
     // FIXME: this doesn't correctly handle textures from tmem.
-    if (!entry->invalidated && entry->base_hash == entry->CalculateHash())
+    if (!entry->invalidated &&
+        (!Core::System::GetInstance().GetMemory().WasRangeWrittenSince(
+             entry->addr, entry->size_in_bytes, entry->write_stamp) ||
+         entry->base_hash == entry->CalculateHash()))
     {
       return entry;
     }
@@ -1349,10 +1451,37 @@ RcTcacheEntry TextureCacheBase::GetTexture(const int textureCacheSafetyColorSamp
                                                             MemoryUpdate::Type::TextureMap);
   }
 
+  // With write tracking, an existing entry for the same memory range which hasn't been written to
+  // since it was hashed already has the hash of the texture data.
+  auto& memory = Core::System::GetInstance().GetMemory();
+  u64 write_stamp = 0;
+  if (!texture_info.IsFromTmem() && memory.IsWriteTrackingActive())
+  {
+    const auto candidates = m_textures_by_address.equal_range(texture_info.GetRawAddress());
+    for (auto candidate = candidates.first; candidate != candidates.second; ++candidate)
+    {
+      const RcTcacheEntry& entry = candidate->second;
+      if (entry->write_stamp != 0 && !entry->IsCopy() &&
+          entry->size_in_bytes == texture_info.GetTextureSize() &&
+          !memory.WasRangeWrittenSince(entry->addr, entry->size_in_bytes, entry->write_stamp))
+      {
+        base_hash = entry->base_hash;
+        write_stamp = entry->write_stamp;
+        break;
+      }
+    }
+
+    if (write_stamp == 0)
+      write_stamp = memory.WatchRange(texture_info.GetRawAddress(), texture_info.GetTextureSize());
+  }
+
   // TODO: This doesn't hash GB tiles for preloaded RGBA8 textures (instead, it's hashing more data
   // from the low tmem bank than it should)
-  base_hash = Common::GetHash64(texture_info.GetData(), texture_info.GetTextureSize(),
-                                textureCacheSafetyColorSampleSize);
+  if (base_hash == TEXHASH_INVALID)
+  {
+    base_hash = Common::GetHash64(texture_info.GetData(), texture_info.GetTextureSize(),
+                                  textureCacheSafetyColorSampleSize);
+  }
   u32 palette_size = 0;
   if (texture_info.GetPaletteSize())
   {
@@ -1484,6 +1613,7 @@ RcTcacheEntry TextureCacheBase::GetTexture(const int textureCacheSafetyColorSamp
                                         texture_info.GetTlutFormat());
         if (entry)
         {
+          entry->write_stamp = write_stamp;
           entry->texture->FinishedRendering();
           return entry;
         }
@@ -1639,7 +1769,8 @@ RcTcacheEntry TextureCacheBase::GetTexture(const int textureCacheSafetyColorSamp
   }
 
   auto entry =
-      CreateTextureEntry(TextureCreationInfo{base_hash, full_hash, bytes_per_block, palette_size},
+      CreateTextureEntry(TextureCreationInfo{base_hash, full_hash, bytes_per_block, palette_size,
+                                             write_stamp},
                          texture_info, textureCacheSafetyColorSampleSize,
                          std::move(data_for_assets), has_arbitrary_mipmaps, skip_texture_dump);
   entry->linked_game_texture_assets = std::move(cached_game_assets);
@@ -1657,6 +1788,8 @@ RcTcacheEntry TextureCacheBase::CreateTextureEntry(
     std::vector<std::shared_ptr<VideoCommon::TextureData>> assets_data,
     const bool custom_arbitrary_mipmaps, bool skip_texture_dump)
 {
+  const FrameTimeReport::CauseScope stutter_scope(StutterCause::TextureLoad);
+
 #ifdef __APPLE__
   const bool no_mips = g_ActiveConfig.bNoMipmapping;
 #else
@@ -1714,14 +1847,27 @@ RcTcacheEntry TextureCacheBase::CreateTextureEntry(
     if (!entry) [[unlikely]]
       return entry;
 
-    // We can decode on the GPU if it is a supported format and the flag is enabled.
-    // Currently we don't decode RGBA8 textures from TMEM, as that would require copying from both
-    // banks, and if we're doing an copy we may as well just do the whole thing on the CPU, since
-    // there's no conversion between formats. In the future this could be extended with a separate
-    // shader, however.
+    // We can decode on the GPU if it is a supported format and either the flag is enabled or the
+    // texture is large enough to pass the size threshold.
     const bool decode_on_gpu =
-        g_ActiveConfig.UseGPUTextureDecoding() &&
-        !(texture_info.IsFromTmem() && texture_info.GetTextureFormat() == TextureFormat::RGBA8);
+        g_ActiveConfig.UseGPUTextureDecoding(expanded_width, expanded_height);
+
+    // RGBA8 textures from TMEM keep the AR and GB halves of each block in separate banks.
+    // Stitching them back into the regular tiled layout is a plain copy, after which the RGBA8
+    // decoding shader applies as usual.
+    const u8* gpu_src_data = texture_info.GetData();
+    if (decode_on_gpu && texture_info.IsFromTmem() &&
+        texture_info.GetTextureFormat() == TextureFormat::RGBA8)
+    {
+      const u32 num_blocks = texture_info.GetTextureSize() / 64;
+      CheckTempSize(texture_info.GetTextureSize());
+      for (u32 i = 0; i < num_blocks; i++)
+      {
+        std::memcpy(m_temp + i * 64, texture_info.GetData() + i * 32, 32);
+        std::memcpy(m_temp + i * 64 + 32, texture_info.GetTmemOddAddress() + i * 32, 32);
+      }
+      gpu_src_data = m_temp;
+    }
 
     ArbitraryMipmapDetector arbitrary_mip_detector;
 
@@ -1730,7 +1876,7 @@ RcTcacheEntry TextureCacheBase::CreateTextureEntry(
 
     if (!decode_on_gpu ||
         !DecodeTextureOnGPU(
-            entry, 0, texture_info.GetData(), texture_info.GetTextureSize(),
+            entry, 0, gpu_src_data, texture_info.GetTextureSize(),
             texture_info.GetTextureFormat(), width, height, expanded_width, expanded_height,
             creation_info.bytes_per_block * (expanded_width / texture_info.GetBlockWidth()),
             texture_info.GetTlutAddress(), texture_info.GetTlutFormat()))
@@ -1840,6 +1986,7 @@ RcTcacheEntry TextureCacheBase::CreateTextureEntry(
   entry->SetDimensions(texture_info.GetRawWidth(), texture_info.GetRawHeight(),
                        texture_info.GetLevelCount());
   entry->SetHashes(creation_info.base_hash, creation_info.full_hash);
+  entry->write_stamp = creation_info.write_stamp;
   entry->memory_stride = entry->BytesPerRow();
   entry->SetNotCopy();
 
@@ -1873,7 +2020,7 @@ RcTcacheEntry TextureCacheBase::GetXFBTexture(u32 address, u32 width, u32 height
 
   auto& system = Core::System::GetInstance();
   auto& memory = system.GetMemory();
-  const u8* src_data = memory.GetPointerForRange(address, total_size);
+  const u8* src_data = memory.GetReadOnlyPointerForRange(address, total_size);
   if (!src_data)
   {
     ERROR_LOG_FMT(VIDEO, "Trying to load XFB texture from invalid address {:#010x}", address);
@@ -1910,7 +2057,7 @@ RcTcacheEntry TextureCacheBase::GetXFBTexture(u32 address, u32 width, u32 height
   entry->is_custom_tex = false;
   entry->may_have_overlapping_textures = false;
   entry->frameCount = FRAMECOUNT_INVALID;
-  if (!g_ActiveConfig.UseGPUTextureDecoding() ||
+  if (!g_ActiveConfig.UseGPUTextureDecoding(width, height) ||
       !DecodeTextureOnGPU(entry, 0, src_data, total_size, entry->format.texfmt, width, height,
                           width, height, stride, s_tex_mem.data(), entry->format.tlutfmt))
   {
@@ -2031,6 +2178,15 @@ void TextureCacheBase::StitchXFBCopy(RcTcacheEntry& stitched_entry)
   std::sort(candidates.begin(), candidates.end(),
             [](const TCacheEntry* a, const TCacheEntry* b) { return a->id < b->id; });
 
+  // Copies are never modified after the fact, a new copy always gets a new id. So if the same
+  // copies were stitched last time, the container already holds the result.
+  std::vector<u64> candidate_ids(candidates.size());
+  std::transform(candidates.begin(), candidates.end(), candidate_ids.begin(),
+                 [](const TCacheEntry* entry) { return entry->id; });
+  if (candidate_ids == stitched_entry->stitched_xfb_ids)
+    return;
+  stitched_entry->stitched_xfb_ids = std::move(candidate_ids);
+
   // We only upscale when necessary to preserve resolution. i.e. when there are upscaled partial
   // copies to be stitched together.
   if (create_upscaled_copy)
@@ -2443,6 +2599,12 @@ void TextureCacheBase::CopyRenderTargetToTexture(
         entry->pending_efb_copy = std::move(staging_texture);
         entry->pending_efb_copy_width = bytes_per_row / sizeof(u32);
         entry->pending_efb_copy_height = num_blocks_y;
+        entry->pending_efb_copy_frame = g_presenter->FrameCount();
+        entry->pending_efb_copy_write_stamp =
+            g_ActiveConfig.iEFBCopyReadbackLag > 0 ?
+                Core::System::GetInstance().GetMemory().WatchRange(dstAddr,
+                                                                   num_blocks_y * dstStride) :
+                0;
         m_pending_efb_copies.push_back(entry);
       }
     }
@@ -2554,6 +2716,33 @@ void TextureCacheBase::FlushEFBCopies()
   m_pending_efb_copies.clear();
 }
 
+void TextureCacheBase::FlushCompletedEFBCopies()
+{
+  const int lag = g_ActiveConfig.iEFBCopyReadbackLag;
+  if (lag <= 0)
+  {
+    FlushEFBCopies();
+    return;
+  }
+
+  // Copies must reach RAM in the order they were made, as they may overlap. So stop at the first
+  // copy which isn't ready yet, even if later ones are.
+  const u64 frame = g_presenter->FrameCount();
+  auto it = m_pending_efb_copies.begin();
+  for (; it != m_pending_efb_copies.end(); ++it)
+  {
+    TCacheEntry* entry = it->get();
+    if (frame - entry->pending_efb_copy_frame < static_cast<u64>(lag) &&
+        !entry->pending_efb_copy->IsCopyComplete())
+    {
+      break;
+    }
+
+    FlushEFBCopy(entry);
+  }
+  m_pending_efb_copies.erase(m_pending_efb_copies.begin(), it);
+}
+
 void TextureCacheBase::FlushStaleBinds()
 {
   for (u32 i = 0; i < m_bound_textures.size(); i++)
@@ -2571,6 +2760,27 @@ void TextureCacheBase::WriteEFBCopyToRAM(u8* dst_ptr, u32 width, u32 height, u32
   ReleaseEFBCopyStagingTexture(std::move(staging_texture));
 }
 
+void TextureCacheBase::WritePartialEFBCopyToRAM(TCacheEntry* entry, u64 write_stamp)
+{
+  auto& memory = Core::System::GetInstance().GetMemory();
+  const u32 width = entry->pending_efb_copy_width;
+  const u32 row_size = width * sizeof(u32);
+  const u32 stride = entry->memory_stride;
+
+  std::unique_ptr<AbstractStagingTexture> staging_texture = std::move(entry->pending_efb_copy);
+  for (u32 y = 0; y < entry->pending_efb_copy_height; y++)
+  {
+    const u32 row_address = entry->addr + y * stride;
+    if (memory.WasRangeWrittenSince(row_address, row_size, write_stamp))
+      continue;
+
+    const MathUtil::Rectangle<int> row_rect(0, static_cast<int>(y), static_cast<int>(width),
+                                            static_cast<int>(y + 1));
+    staging_texture->ReadTexels(row_rect, memory.GetPointerForRange(row_address, stride), stride);
+  }
+  ReleaseEFBCopyStagingTexture(std::move(staging_texture));
+}
+
 void TextureCacheBase::FlushEFBCopy(TCacheEntry* entry)
 {
   const u32 covered_range = entry->pending_efb_copy_height * entry->memory_stride;
@@ -2578,9 +2788,33 @@ void TextureCacheBase::FlushEFBCopy(TCacheEntry* entry)
   // Copy from texture -> guest memory.
   auto& system = Core::System::GetInstance();
   auto& memory = system.GetMemory();
-  u8* const dst = memory.GetPointerForRange(entry->addr, covered_range);
-  WriteEFBCopyToRAM(dst, entry->pending_efb_copy_width, entry->pending_efb_copy_height,
-                    entry->memory_stride, std::move(entry->pending_efb_copy));
+  const u64 write_stamp = entry->pending_efb_copy_write_stamp;
+  if (write_stamp != 0 && memory.WasRangeWrittenSince(entry->addr, covered_range, write_stamp))
+  {
+    // The copy was kept pending across sync points, and the CPU has since written to the range.
+    // Writing the whole copy back now would clobber the newer data, so only write the rows which
+    // the CPU hasn't touched. If it has written all of them, the readback is skipped entirely.
+    WritePartialEFBCopyToRAM(entry, write_stamp);
+  }
+  else
+  {
+    u8* const dst = memory.GetPointerForRange(entry->addr, covered_range);
+    WriteEFBCopyToRAM(dst, entry->pending_efb_copy_width, entry->pending_efb_copy_height,
+                      entry->memory_stride, std::move(entry->pending_efb_copy));
+  }
+  entry->pending_efb_copy_write_stamp = 0;
+
+  // Our own write above marks the range as written, so re-arm the tracking of the pending copies
+  // which overlap it. Otherwise they'd mistake this write for a CPU one.
+  for (auto& pending : m_pending_efb_copies)
+  {
+    if (pending.get() != entry && pending->pending_efb_copy_write_stamp != 0 &&
+        pending->OverlapsMemoryRange(entry->addr, covered_range))
+    {
+      pending->pending_efb_copy_write_stamp = memory.WatchRange(
+          pending->addr, pending->pending_efb_copy_height * pending->memory_stride);
+    }
+  }
 
   // If the EFB copy was invalidated (e.g. the bloom case mentioned in InvalidateTexture), we don't
   // need to do anything more. The entry will be automatically deleted by smart pointers
@@ -2709,7 +2943,7 @@ TextureCacheBase::AllocateTexture(const TextureConfig& config)
   if (iter != m_texture_pool.end())
   {
     auto entry = std::move(iter->second);
-    m_texture_pool.erase(iter);
+    RemoveFromPool(iter);
     return std::move(entry);
   }
 
@@ -2734,6 +2968,7 @@ TextureCacheBase::AllocateTexture(const TextureConfig& config)
   }
 
   INCSTAT(g_stats.num_textures_created);
+  INCSTAT(g_stats.this_frame.num_textures_created);
   return TexPoolEntry(std::move(texture), std::move(framebuffer));
 }
 
@@ -2835,9 +3070,38 @@ void TextureCacheBase::ReleaseToPool(TCacheEntry* entry)
 {
   if (!entry->texture)
     return;
-  auto config = entry->texture->GetConfig();
-  m_texture_pool.emplace(config,
-                         TexPoolEntry(std::move(entry->texture), std::move(entry->framebuffer)));
+  AddToPool(TexPoolEntry(std::move(entry->texture), std::move(entry->framebuffer)));
+}
+
+void TextureCacheBase::AddToPool(TexPoolEntry entry)
+{
+  const TextureConfig& config = entry.texture->GetConfig();
+  m_texture_pool_memory_usage += GetTextureMemorySize(config);
+  m_texture_pool.emplace(config, std::move(entry));
+  Common::MemoryAccounting::Set(Common::MemoryAccounting::Subsystem::TexturePool,
+                                m_texture_pool_memory_usage);
+}
+
+TextureCacheBase::TexPool::iterator TextureCacheBase::RemoveFromPool(TexPool::iterator iter)
+{
+  m_texture_pool_memory_usage -= GetTextureMemorySize(iter->first);
+  Common::MemoryAccounting::Set(Common::MemoryAccounting::Subsystem::TexturePool,
+                                m_texture_pool_memory_usage);
+  return m_texture_pool.erase(iter);
+}
+
+u64 TextureCacheBase::GetTextureMemorySize(const TextureConfig& config)
+{
+  const u32 block_size = AbstractTexture::GetBlockSizeForFormat(config.format);
+  u64 size = 0;
+  for (u32 level = 0; level < config.levels; level++)
+  {
+    const u32 width = std::max(config.width >> level, 1u);
+    const u32 height = std::max(config.height >> level, 1u);
+    const u32 rows = (height + block_size - 1) / block_size;
+    size += u64(AbstractTexture::CalculateStrideForFormat(config.format, width)) * rows;
+  }
+  return size * config.layers * config.samples;
 }
 
 bool TextureCacheBase::CreateUtilityTextures()
@@ -2874,6 +3138,8 @@ void TextureCacheBase::CopyEFBToCacheEntry(RcTcacheEntry& entry, bool is_depth_c
                                            bool clamp_top, bool clamp_bottom,
                                            const std::array<u32, 3>& filter_coefficients)
 {
+  GPUTimingScope timing_scope(GPUTimingPass::EFBCopies);
+
   // Flush EFB pokes first, as they're expected to be included.
   g_framebuffer_manager->FlushEFBPokes();
 
@@ -2950,6 +3216,8 @@ void TextureCacheBase::CopyEFB(AbstractStagingTexture* dst, const EFBCopyParams&
                                bool clamp_top, bool clamp_bottom,
                                const std::array<u32, 3>& filter_coefficients)
 {
+  GPUTimingScope timing_scope(GPUTimingPass::EFBCopies);
+
   // Flush EFB pokes first, as they're expected to be included.
   g_framebuffer_manager->FlushEFBPokes();
 
@@ -3162,7 +3430,7 @@ u64 TCacheEntry::CalculateHash() const
   // FIXME: textures from tmem won't get the correct hash.
   auto& system = Core::System::GetInstance();
   auto& memory = system.GetMemory();
-  u8* ptr = memory.GetPointerForRange(addr, size_in_bytes);
+  const u8* ptr = memory.GetReadOnlyPointerForRange(addr, size_in_bytes);
   if (memory_stride == bytes_per_row)
   {
     return Common::GetHash64(ptr, size_in_bytes, hash_sample_size);
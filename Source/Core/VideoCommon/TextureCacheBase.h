@@ -19,6 +19,7 @@
 #include "Common/BitSet.h"
 #include "Common/CommonTypes.h"
 #include "Common/Flag.h"
+#include "Common/Hash.h"
 #include "Common/MathUtil.h"
 
 #include "VideoCommon/AbstractTexture.h"
@@ -126,6 +127,8 @@ struct TCacheEntry
   u32 size_in_bytes = 0;
   u64 base_hash = 0;
   u64 hash = 0;  // for paletted textures, hash = base_hash ^ palette_hash
+  // Memory write tracking stamp taken when base_hash was last known to be valid, 0 if untracked
+  u64 write_stamp = 0;
   TextureAndTLUTFormat format;
   u32 memory_stride = 0;
   bool is_efb_copy = false;
@@ -144,6 +147,9 @@ struct TCacheEntry
 
   bool reference_changed = false;  // used by xfb to determine when a reference xfb changed
 
+  // ids of the copies last stitched into this xfb container, in stitching order
+  std::vector<u64> stitched_xfb_ids;
+
   // Texture dimensions from the GameCube's point of view
   u32 native_width = 0;
   u32 native_height = 0;
@@ -165,6 +171,8 @@ struct TCacheEntry
   std::unique_ptr<AbstractStagingTexture> pending_efb_copy;
   u32 pending_efb_copy_width = 0;
   u32 pending_efb_copy_height = 0;
+  u64 pending_efb_copy_frame = 0;
+  u64 pending_efb_copy_write_stamp = 0;
 
   std::string texture_info_name = "";
 
@@ -260,6 +268,7 @@ public:
     u64 full_hash;
     u32 bytes_per_block;
     u32 palette_size;
+    u64 write_stamp;
   };
 
   TextureCacheBase();
@@ -296,6 +305,11 @@ public:
   // Flushes all pending EFB copies to emulated RAM.
   void FlushEFBCopies();
 
+  // Flushes the pending EFB copies which can be read back without stalling. When the readback lag
+  // is disabled this is the same as FlushEFBCopies(), otherwise copies are kept pending until the
+  // GPU has finished them or they are older than the configured number of frames.
+  void FlushCompletedEFBCopies();
+
   // Flush any Bound textures that can't be reused
   void FlushStaleBinds();
 
@@ -373,6 +387,9 @@ private:
   RcTcacheEntry AllocateCacheEntry(const TextureConfig& config);
   std::optional<TexPoolEntry> AllocateTexture(const TextureConfig& config);
   TexPool::iterator FindMatchingTextureFromPool(const TextureConfig& config);
+  void AddToPool(TexPoolEntry entry);
+  TexPool::iterator RemoveFromPool(TexPool::iterator iter);
+  static u64 GetTextureMemorySize(const TextureConfig& config);
   TexAddrCache::iterator GetTexCacheIter(TCacheEntry* entry);
 
   // Return all possible overlapping textures. As addr+size of the textures is not
@@ -396,6 +413,7 @@ private:
   // Flushes a pending EFB copy to RAM from the host to the guest RAM.
   void WriteEFBCopyToRAM(u8* dst_ptr, u32 width, u32 height, u32 stride,
                          std::unique_ptr<AbstractStagingTexture> staging_texture);
+  void WritePartialEFBCopyToRAM(TCacheEntry* entry, u64 write_stamp);
   void FlushEFBCopy(TCacheEntry* entry);
 
   // Returns a staging texture of the maximum EFB copy size.
@@ -405,6 +423,7 @@ private:
   void ReleaseEFBCopyStagingTexture(std::unique_ptr<AbstractStagingTexture> tex);
 
   bool CheckReadbackTexture(u32 width, u32 height, AbstractTextureFormat format);
+  void IssueSaveStateReadbacks(const std::vector<TCacheEntry*>& entries, size_t first);
   void DoSaveState(PointerWrap& p);
   void DoLoadState(PointerWrap& p);
 
@@ -421,12 +440,15 @@ private:
   std::array<RcTcacheEntry, 8> m_bound_textures{};
 
   TexPool m_texture_pool;
+  u64 m_texture_pool_memory_usage = 0;
+  u64 m_texture_pool_memory_budget = 0;
   u64 m_last_entry_id = 0;
 
   // Backup configuration values
   struct BackupConfig
   {
     int color_samples;
+    Common::TextureHashAlgorithm hash_algorithm;
     bool texfmt_overlay;
     bool texfmt_overlay_center;
     bool hires_textures;
@@ -435,6 +457,7 @@ private:
     bool stereo_3d;
     bool efb_mono_depth;
     bool gpu_texture_decoding;
+    u32 gpu_texture_decoding_min_texels;
     bool disable_vram_copies;
     bool arbitrary_mipmap_detection;
     bool graphics_mods;
@@ -462,6 +485,11 @@ private:
   // readbacks, saving the overhead of allocating a new buffer every time.
   std::unique_ptr<AbstractStagingTexture> m_readback_texture;
 
+  // Staging copies of the textures that are being serialized into a savestate, one for each layer
+  // and level. They are issued in batches, so that the GPU is only waited on once per batch.
+  std::map<const AbstractTexture*, std::vector<std::unique_ptr<AbstractStagingTexture>>>
+      m_savestate_readbacks;
+
   void OnFrameEnd();
 
   Common::EventHook m_frame_event =
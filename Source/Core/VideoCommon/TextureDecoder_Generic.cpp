@@ -5,6 +5,11 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstring>
+
+#ifdef _M_ARM_64
+#include <arm_neon.h>
+#endif
 
 #include "Common/CPUDetect.h"
 #include "Common/CommonTypes.h"
@@ -71,6 +76,79 @@ static inline u32 DecodePixel_Paletted(u16 pixel, TLUTFormat tlutfmt)
   }
 }
 
+#ifdef _M_ARM_64
+// Expands the 16-bit value held in the low half of each 32-bit lane.
+static inline uint32x4_t DecodeRGB565_NEON(uint32x4_t v)
+{
+  const uint32x4_t r = vorrq_u32(vandq_u32(vshrq_n_u32(v, 8), vdupq_n_u32(0xF8)),
+                                 vandq_u32(vshrq_n_u32(v, 13), vdupq_n_u32(0x07)));
+  const uint32x4_t g = vorrq_u32(vandq_u32(vshlq_n_u32(v, 5), vdupq_n_u32(0xFC00)),
+                                 vandq_u32(vshrq_n_u32(v, 1), vdupq_n_u32(0x0300)));
+  const uint32x4_t b = vorrq_u32(vandq_u32(vshlq_n_u32(v, 19), vdupq_n_u32(0xF80000)),
+                                 vandq_u32(vshlq_n_u32(v, 14), vdupq_n_u32(0x070000)));
+  return vorrq_u32(vorrq_u32(r, g), vorrq_u32(b, vdupq_n_u32(0xFF000000)));
+}
+
+static inline uint32x4_t DecodeRGB5A3_NEON(uint32x4_t v)
+{
+  // RGB555, opaque.
+  const uint32x4_t r5 = vorrq_u32(vandq_u32(vshrq_n_u32(v, 7), vdupq_n_u32(0xF8)),
+                                  vandq_u32(vshrq_n_u32(v, 12), vdupq_n_u32(0x07)));
+  const uint32x4_t g5 = vorrq_u32(vandq_u32(vshlq_n_u32(v, 6), vdupq_n_u32(0xF800)),
+                                  vandq_u32(vshlq_n_u32(v, 1), vdupq_n_u32(0x0700)));
+  const uint32x4_t b5 = vorrq_u32(vandq_u32(vshlq_n_u32(v, 19), vdupq_n_u32(0xF80000)),
+                                  vandq_u32(vshlq_n_u32(v, 14), vdupq_n_u32(0x070000)));
+  const uint32x4_t rgb555 = vorrq_u32(vorrq_u32(r5, g5), vorrq_u32(b5, vdupq_n_u32(0xFF000000)));
+
+  // RGB4A3: spread the nibbles 8 bits apart, then duplicate each one into the high half.
+  const uint32x4_t nibbles =
+      vorrq_u32(vorrq_u32(vandq_u32(vshrq_n_u32(v, 8), vdupq_n_u32(0x0F)),
+                          vandq_u32(vshlq_n_u32(v, 4), vdupq_n_u32(0x0F00))),
+                vandq_u32(vshlq_n_u32(v, 16), vdupq_n_u32(0x0F0000)));
+  const uint32x4_t a3 = vorrq_u32(vorrq_u32(vandq_u32(vshrq_n_u32(v, 7), vdupq_n_u32(0xE0)),
+                                            vandq_u32(vshrq_n_u32(v, 10), vdupq_n_u32(0x1C))),
+                                  vandq_u32(vshrq_n_u32(v, 13), vdupq_n_u32(0x03)));
+  const uint32x4_t rgb4a3 =
+      vorrq_u32(vorrq_u32(nibbles, vshlq_n_u32(nibbles, 4)), vshlq_n_u32(a3, 24));
+
+  return vbslq_u32(vtstq_u32(v, vdupq_n_u32(0x8000)), rgb555, rgb4a3);
+}
+
+// Four big-endian u16s -> four zero-extended host-order u32s.
+static inline uint32x4_t LoadSwappedU16x4_NEON(const u16* src)
+{
+  return vmovl_u16(vreinterpret_u16_u8(vrev16_u8(vld1_u8(reinterpret_cast<const u8*>(src)))));
+}
+
+// The palettized formats expand their TLUT once per texture instead of once per texel.
+static void DecodePalette(u32* palette, const u8* tlut_, TLUTFormat tlutfmt, int count)
+{
+  const u16* tlut = (const u16*)tlut_;
+  for (int i = 0; i < count; i++)
+    palette[i] = DecodePixel_Paletted(tlut[i], tlutfmt);
+}
+
+static inline void DecodeBytes_C4_NEON(u32* dst, const u8* src, const uint8x16x4_t& palette)
+{
+  u32 packed;
+  std::memcpy(&packed, src, sizeof(packed));
+  const uint8x8_t val = vreinterpret_u8_u32(vdup_n_u32(packed));
+  // Palette indices in texel order, scaled to byte offsets into the 64-byte table.
+  const uint8x8_t idx =
+      vshl_n_u8(vzip_u8(vshr_n_u8(val, 4), vand_u8(val, vdup_n_u8(0x0F))).val[0], 2);
+  const uint8x16_t both = vcombine_u8(idx, idx);
+  static constexpr u8 bytes_table[16] = {0, 1, 2, 3, 0, 1, 2, 3, 0, 1, 2, 3, 0, 1, 2, 3};
+  static constexpr u8 spread_table[32] = {0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3,
+                                          4, 4, 4, 4, 5, 5, 5, 5, 6, 6, 6, 6, 7, 7, 7, 7};
+  const uint8x16_t bytes = vld1q_u8(bytes_table);
+  const uint8x16_t spread0 = vld1q_u8(spread_table);
+  const uint8x16_t spread1 = vld1q_u8(spread_table + 16);
+  u8* dst8 = reinterpret_cast<u8*>(dst);
+  vst1q_u8(dst8, vqtbl4q_u8(palette, vaddq_u8(vqtbl1q_u8(both, spread0), bytes)));
+  vst1q_u8(dst8 + 16, vqtbl4q_u8(palette, vaddq_u8(vqtbl1q_u8(both, spread1), bytes)));
+}
+#endif
+
 static inline void DecodeBytes_C4(u32* dst, const u8* src, const u8* tlut_, TLUTFormat tlutfmt)
 {
   const u16* tlut = (u16*)tlut_;
@@ -95,15 +173,54 @@ static inline void DecodeBytes_C8(u32* dst, const u8* src, const u8* tlut_, TLUT
 static inline void DecodeBytes_C14X2(u32* dst, const u16* src, const u8* tlut_, TLUTFormat tlutfmt)
 {
   const u16* tlut = (u16*)tlut_;
+#ifdef _M_ARM_64
+  // The lookups stay scalar, but the entries are converted four at a time.
+  alignas(16) u32 entries[4];
+  for (int x = 0; x < 4; x++)
+    entries[x] = Common::swap16(tlut[Common::swap16(src[x]) & 0x3FFF]);
+  const uint32x4_t v = vld1q_u32(entries);
+  switch (tlutfmt)
+  {
+  case TLUTFormat::IA8:
+  {
+    // Undo the swap above; IA8 entries are stored as (alpha, intensity).
+    static constexpr u8 mask[16] = {0, 0, 0, 1, 4, 4, 4, 5, 8, 8, 8, 9, 12, 12, 12, 13};
+    vst1q_u8(reinterpret_cast<u8*>(dst), vqtbl1q_u8(vreinterpretq_u8_u32(v), vld1q_u8(mask)));
+    break;
+  }
+  case TLUTFormat::RGB565:
+    vst1q_u32(dst, DecodeRGB565_NEON(v));
+    break;
+  case TLUTFormat::RGB5A3:
+    vst1q_u32(dst, DecodeRGB5A3_NEON(v));
+    break;
+  default:
+    vst1q_u32(dst, vdupq_n_u32(0));
+    break;
+  }
+#else
   for (int x = 0; x < 4; x++)
   {
     u16 val = Common::swap16(src[x]);
     *dst++ = DecodePixel_Paletted(tlut[(val & 0x3FFF)], tlutfmt);
   }
+#endif
 }
 
 static inline void DecodeBytes_IA4(u32* dst, const u8* src)
 {
+#ifdef _M_ARM_64
+  const uint8x8_t val = vld1_u8(src);
+  const uint8x8_t a = vand_u8(val, vdup_n_u8(0xF0));
+  const uint8x8_t l = vand_u8(val, vdup_n_u8(0x0F));
+  const uint8x8_t l8 = vorr_u8(l, vshl_n_u8(l, 4));
+  uint8x8x4_t texels;
+  texels.val[0] = l8;
+  texels.val[1] = l8;
+  texels.val[2] = l8;
+  texels.val[3] = vorr_u8(a, vshr_n_u8(a, 4));
+  vst4_u8(reinterpret_cast<u8*>(dst), texels);
+#else
   for (int x = 0; x < 8; x++)
   {
     const u8 val = src[x];
@@ -111,11 +228,14 @@ static inline void DecodeBytes_IA4(u32* dst, const u8* src)
     u8 l = Convert4To8(val & 0xF);
     dst[x] = (a << 24) | l << 16 | l << 8 | l;
   }
+#endif
 }
 
 static inline void DecodeBytes_RGB5A3(u32* dst, const u16* src)
 {
-#if 0
+#ifdef _M_ARM_64
+  vst1q_u32(dst, DecodeRGB5A3_NEON(LoadSwappedU16x4_NEON(src)));
+#elif 0
   for (int x = 0; x < 4; x++)
     dst[x] = DecodePixel_RGB5A3(Common::swap16(src[x]));
 #else
@@ -141,10 +261,8 @@ static inline void DecodeBytes_RGBA8(u32* dst, const u16* src, const u16* src2)
 #endif
 }
 
-static void DecodeDXTBlock(u32* dst, const DXTBlock* src, int pitch)
+static inline void DecodeDXTColors(u32* colors, const DXTBlock* src)
 {
-  // S3TC Decoder (Note: GCN decodes differently from PC so we can't use native support)
-  // Needs more speed.
   u16 c1 = Common::swap16(src->color1);
   u16 c2 = Common::swap16(src->color2);
   int blue1 = Convert5To8(c1 & 0x1F);
@@ -153,7 +271,6 @@ static void DecodeDXTBlock(u32* dst, const DXTBlock* src, int pitch)
   int green2 = Convert6To8((c2 >> 5) & 0x3F);
   int red1 = Convert5To8((c1 >> 11) & 0x1F);
   int red2 = Convert5To8((c2 >> 11) & 0x1F);
-  int colors[4];
   colors[0] = MakeRGBA(red1, green1, blue1, 255);
   colors[1] = MakeRGBA(red2, green2, blue2, 255);
   if (c1 > c2)
@@ -170,7 +287,28 @@ static void DecodeDXTBlock(u32* dst, const DXTBlock* src, int pitch)
     colors[2] = MakeRGBA((red1 + red2) / 2, (green1 + green2) / 2, (blue1 + blue2) / 2, 255);
     colors[3] = MakeRGBA((red1 + red2) / 2, (green1 + green2) / 2, (blue1 + blue2) / 2, 0);
   }
+}
+
+static void DecodeDXTBlock(u32* dst, const DXTBlock* src, int pitch)
+{
+  // S3TC Decoder (Note: GCN decodes differently from PC so we can't use native support)
+  alignas(16) u32 colors[4];
+  DecodeDXTColors(colors, src);
 
+#ifdef _M_ARM_64
+  // Turn each 2-bit selector into the byte offsets of its color, then look up a whole row.
+  const uint8x16_t palette = vld1q_u8(reinterpret_cast<const u8*>(colors));
+  static constexpr s32 shift_table[4] = {-6, -4, -2, 0};
+  const int32x4_t shifts = vld1q_s32(shift_table);
+  for (int y = 0; y < 4; y++)
+  {
+    const uint32x4_t sel =
+        vandq_u32(vshlq_u32(vdupq_n_u32(src->lines[y]), shifts), vdupq_n_u32(3));
+    const uint32x4_t offsets = vmlaq_n_u32(vdupq_n_u32(0x03020100), sel, 0x04040404);
+    vst1q_u8(reinterpret_cast<u8*>(dst), vqtbl1q_u8(palette, vreinterpretq_u8_u32(offsets)));
+    dst += pitch;
+  }
+#else
   for (int y = 0; y < 4; y++)
   {
     int val = src->lines[y];
@@ -181,6 +319,7 @@ static void DecodeDXTBlock(u32* dst, const DXTBlock* src, int pitch)
     }
     dst += pitch;
   }
+#endif
 }
 
 // JSD 01/06/11:
@@ -203,13 +342,47 @@ void _TexDecoder_DecodeImpl(u32* dst, const u8* src, int width, int height, Text
   switch (texformat)
   {
   case TextureFormat::C4:
+  {
+#ifdef _M_ARM_64
+    alignas(16) u32 palette[16];
+    DecodePalette(palette, tlut, tlutfmt, 16);
+    uint8x16x4_t table;
+    for (int i = 0; i < 4; i++)
+      table.val[i] = vld1q_u8(reinterpret_cast<const u8*>(palette + 4 * i));
+    for (int y = 0; y < height; y += 8)
+      for (int x = 0, yStep = (y / 8) * Wsteps8; x < width; x += 8, yStep++)
+        for (int iy = 0, xStep = 8 * yStep; iy < 8; iy++, xStep++)
+          DecodeBytes_C4_NEON(dst + (y + iy) * width + x, src + 4 * xStep, table);
+#else
     for (int y = 0; y < height; y += 8)
       for (int x = 0, yStep = (y / 8) * Wsteps8; x < width; x += 8, yStep++)
         for (int iy = 0, xStep = 8 * yStep; iy < 8; iy++, xStep++)
           DecodeBytes_C4(dst + (y + iy) * width + x, src + 4 * xStep, tlut, tlutfmt);
-    break;
+#endif
+  }
+  break;
   case TextureFormat::I4:
   {
+#ifdef _M_ARM_64
+    for (int y = 0; y < height; y += 8)
+      for (int x = 0; x < width; x += 8)
+        for (int iy = 0; iy < 8; iy += 2, src += 8)
+        {
+          // Two rows per load; interleaving the expanded nibbles puts the texels in row order.
+          const uint8x8_t val = vld1_u8(src);
+          const uint8x8_t hi = vand_u8(val, vdup_n_u8(0xF0));
+          const uint8x8_t lo = vand_u8(val, vdup_n_u8(0x0F));
+          const uint8x8x2_t rows =
+              vzip_u8(vorr_u8(hi, vshr_n_u8(hi, 4)), vorr_u8(lo, vshl_n_u8(lo, 4)));
+          for (int row = 0; row < 2; row++)
+          {
+            uint8x8x4_t texels;
+            for (int i = 0; i < 4; i++)
+              texels.val[i] = rows.val[row];
+            vst4_u8(reinterpret_cast<u8*>(dst + (y + iy + row) * width + x), texels);
+          }
+        }
+#else
     // Reference C implementation:
     for (int y = 0; y < height; y += 8)
       for (int x = 0; x < width; x += 8)
@@ -222,10 +395,23 @@ void _TexDecoder_DecodeImpl(u32* dst, const u8* src, int width, int height, Text
             memset(dst + (y + iy) * width + x + ix * 2, i1, 4);
             memset(dst + (y + iy) * width + x + ix * 2 + 1, i2, 4);
           }
+#endif
   }
   break;
   case TextureFormat::I8:  // speed critical
   {
+#ifdef _M_ARM_64
+    for (int y = 0; y < height; y += 4)
+      for (int x = 0; x < width; x += 8)
+        for (int iy = 0; iy < 4; ++iy, src += 8)
+        {
+          const uint8x8_t val = vld1_u8(src);
+          uint8x8x4_t texels;
+          for (int i = 0; i < 4; i++)
+            texels.val[i] = val;
+          vst4_u8(reinterpret_cast<u8*>(dst + (y + iy) * width + x), texels);
+        }
+#else
     // Reference C implementation
     for (int y = 0; y < height; y += 4)
       for (int x = 0; x < width; x += 8)
@@ -252,9 +438,28 @@ void _TexDecoder_DecodeImpl(u32* dst, const u8* src, int width, int height, Text
           srcval = newsrc[0];
           newdst[0] = srcval | (srcval << 8) | (srcval << 16) | (srcval << 24);
         }
+#endif
   }
   break;
   case TextureFormat::C8:
+#ifdef _M_ARM_64
+    // Expanding the 256-entry palette costs more than it saves on the smallest mip levels.
+    if (width * height >= 256)
+    {
+      u32 palette[256];
+      DecodePalette(palette, tlut, tlutfmt, 256);
+      for (int y = 0; y < height; y += 4)
+        for (int x = 0, yStep = (y / 4) * Wsteps8; x < width; x += 8, yStep++)
+          for (int iy = 0, xStep = 4 * yStep; iy < 4; iy++, xStep++)
+          {
+            u32* row = dst + (y + iy) * width + x;
+            const u8* indices = src + 8 * xStep;
+            for (int ix = 0; ix < 8; ix++)
+              row[ix] = palette[indices[ix]];
+          }
+      break;
+    }
+#endif
     for (int y = 0; y < height; y += 4)
       for (int x = 0, yStep = (y / 4) * Wsteps8; x < width; x += 8, yStep++)
         for (int iy = 0, xStep = 4 * yStep; iy < 4; iy++, xStep++)
@@ -270,6 +475,21 @@ void _TexDecoder_DecodeImpl(u32* dst, const u8* src, int width, int height, Text
   break;
   case TextureFormat::IA8:
   {
+#ifdef _M_ARM_64
+    static constexpr u8 mask_table[32] = {1,  1,  1,  0,  3,  3,  3,  2,  5,  5,  5,
+                                          4,  7,  7,  7,  6,  9,  9,  9,  8,  11, 11,
+                                          11, 10, 13, 13, 13, 12, 15, 15, 15, 14};
+    const uint8x16_t mask0 = vld1q_u8(mask_table);
+    const uint8x16_t mask1 = vld1q_u8(mask_table + 16);
+    for (int y = 0; y < height; y += 4)
+      for (int x = 0; x < width; x += 4)
+        for (int iy = 0; iy < 4; iy += 2, src += 16)
+        {
+          const uint8x16_t val = vld1q_u8(src);
+          vst1q_u8(reinterpret_cast<u8*>(dst + (y + iy) * width + x), vqtbl1q_u8(val, mask0));
+          vst1q_u8(reinterpret_cast<u8*>(dst + (y + iy + 1) * width + x), vqtbl1q_u8(val, mask1));
+        }
+#else
     // Reference C implementation:
     for (int y = 0; y < height; y += 4)
       for (int x = 0; x < width; x += 4)
@@ -282,6 +502,7 @@ void _TexDecoder_DecodeImpl(u32* dst, const u8* src, int width, int height, Text
           ptr[2] = DecodePixel_IA8(s[2]);
           ptr[3] = DecodePixel_IA8(s[3]);
         }
+#endif
   }
   break;
   case TextureFormat::C14X2:
@@ -1413,6 +1413,443 @@ static void TexDecoder_DecodeImpl_CMPR(u32* dst, const u8* src, int width, int h
   }
 }
 
+// AVX2 decoders. The palettized formats expand their TLUT once per texture (or gather straight
+// from it for C14X2), so all of the per-texel work happens in 256-bit registers.
+static void DecodePalette(u32* palette, const u8* tlut_, TLUTFormat tlutfmt, int count)
+{
+  const u16* tlut = (const u16*)tlut_;
+  for (int i = 0; i < count; i++)
+  {
+    switch (tlutfmt)
+    {
+    case TLUTFormat::IA8:
+      palette[i] = DecodePixel_IA8(tlut[i]);
+      break;
+    case TLUTFormat::RGB565:
+      palette[i] = DecodePixel_RGB565(Common::swap16(tlut[i]));
+      break;
+    case TLUTFormat::RGB5A3:
+      palette[i] = DecodePixel_RGB5A3(Common::swap16(tlut[i]));
+      break;
+    default:
+      palette[i] = 0;
+      break;
+    }
+  }
+}
+
+// Expands the 16-bit value held in the low half of each 32-bit lane.
+FUNCTION_TARGET_AVX2
+static inline __m256i DecodeRGB565_AVX2(__m256i v)
+{
+  const __m256i r =
+      _mm256_or_si256(_mm256_and_si256(_mm256_srli_epi32(v, 8), _mm256_set1_epi32(0xF8)),
+                      _mm256_and_si256(_mm256_srli_epi32(v, 13), _mm256_set1_epi32(0x07)));
+  const __m256i g =
+      _mm256_or_si256(_mm256_and_si256(_mm256_slli_epi32(v, 5), _mm256_set1_epi32(0xFC00)),
+                      _mm256_and_si256(_mm256_srli_epi32(v, 1), _mm256_set1_epi32(0x0300)));
+  const __m256i b =
+      _mm256_or_si256(_mm256_and_si256(_mm256_slli_epi32(v, 19), _mm256_set1_epi32(0xF80000)),
+                      _mm256_and_si256(_mm256_slli_epi32(v, 14), _mm256_set1_epi32(0x070000)));
+  return _mm256_or_si256(_mm256_or_si256(r, g),
+                         _mm256_or_si256(b, _mm256_set1_epi32(0xFF000000)));
+}
+
+FUNCTION_TARGET_AVX2
+static inline __m256i DecodeRGB5A3_AVX2(__m256i v)
+{
+  // RGB555, opaque.
+  const __m256i r5 =
+      _mm256_or_si256(_mm256_and_si256(_mm256_srli_epi32(v, 7), _mm256_set1_epi32(0xF8)),
+                      _mm256_and_si256(_mm256_srli_epi32(v, 12), _mm256_set1_epi32(0x07)));
+  const __m256i g5 =
+      _mm256_or_si256(_mm256_and_si256(_mm256_slli_epi32(v, 6), _mm256_set1_epi32(0xF800)),
+                      _mm256_and_si256(_mm256_slli_epi32(v, 1), _mm256_set1_epi32(0x0700)));
+  const __m256i b5 =
+      _mm256_or_si256(_mm256_and_si256(_mm256_slli_epi32(v, 19), _mm256_set1_epi32(0xF80000)),
+                      _mm256_and_si256(_mm256_slli_epi32(v, 14), _mm256_set1_epi32(0x070000)));
+  const __m256i rgb555 = _mm256_or_si256(_mm256_or_si256(r5, g5),
+                                         _mm256_or_si256(b5, _mm256_set1_epi32(0xFF000000)));
+
+  // RGB4A3: spread the nibbles 8 bits apart, then duplicate each one into the high half.
+  const __m256i nibbles = _mm256_or_si256(
+      _mm256_or_si256(_mm256_and_si256(_mm256_srli_epi32(v, 8), _mm256_set1_epi32(0x0F)),
+                      _mm256_and_si256(_mm256_slli_epi32(v, 4), _mm256_set1_epi32(0x0F00))),
+      _mm256_and_si256(_mm256_slli_epi32(v, 16), _mm256_set1_epi32(0x0F0000)));
+  const __m256i rgb4 = _mm256_or_si256(nibbles, _mm256_slli_epi32(nibbles, 4));
+  const __m256i a3 = _mm256_or_si256(
+      _mm256_or_si256(_mm256_and_si256(_mm256_srli_epi32(v, 7), _mm256_set1_epi32(0xE0)),
+                      _mm256_and_si256(_mm256_srli_epi32(v, 10), _mm256_set1_epi32(0x1C))),
+      _mm256_and_si256(_mm256_srli_epi32(v, 13), _mm256_set1_epi32(0x03)));
+  const __m256i rgb4a3 = _mm256_or_si256(rgb4, _mm256_slli_epi32(a3, 24));
+
+  const __m256i opaque = _mm256_cmpeq_epi32(_mm256_and_si256(v, _mm256_set1_epi32(0x8000)),
+                                            _mm256_set1_epi32(0x8000));
+  return _mm256_blendv_epi8(rgb4a3, rgb555, opaque);
+}
+
+// Two rows of four big-endian u16s -> eight zero-extended host-order u32s.
+FUNCTION_TARGET_AVX2
+static inline __m256i LoadSwappedU16x8_AVX2(const u8* src)
+{
+  const __m256i mask =
+      _mm256_setr_epi8(1, 0, -128, -128, 3, 2, -128, -128, 5, 4, -128, -128, 7, 6, -128, -128, 9,
+                       8, -128, -128, 11, 10, -128, -128, 13, 12, -128, -128, 15, 14, -128, -128);
+  return _mm256_shuffle_epi8(
+      _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)src)), mask);
+}
+
+FUNCTION_TARGET_AVX2
+static inline void StoreTwoRows_AVX2(u32* dst, int width, __m256i v)
+{
+  _mm_storeu_si128((__m128i*)dst, _mm256_castsi256_si128(v));
+  _mm_storeu_si128((__m128i*)(dst + width), _mm256_extracti128_si256(v, 1));
+}
+
+FUNCTION_TARGET_AVX2
+static void TexDecoder_DecodeImpl_C4_AVX2(u32* dst, const u8* src, int width, int height,
+                                          TextureFormat texformat, const u8* tlut,
+                                          TLUTFormat tlutfmt, int Wsteps4, int Wsteps8)
+{
+  alignas(32) u32 palette[16];
+  DecodePalette(palette, tlut, tlutfmt, 16);
+  const __m256i pal_lo = _mm256_load_si256((const __m256i*)palette);
+  const __m256i pal_hi = _mm256_load_si256((const __m256i*)(palette + 8));
+  const __m256i shifts = _mm256_setr_epi32(4, 0, 4, 0, 4, 0, 4, 0);
+  const __m256i kMask_x0f = _mm256_set1_epi32(0x0F);
+  const __m256i kSeven = _mm256_set1_epi32(7);
+
+  for (int y = 0; y < height; y += 8)
+  {
+    for (int x = 0, yStep = (y / 8) * Wsteps8; x < width; x += 8, yStep++)
+    {
+      for (int iy = 0, xStep = 8 * yStep; iy < 8; iy++, xStep++)
+      {
+        u32 packed;
+        std::memcpy(&packed, src + 4 * xStep, sizeof(packed));
+        // Each byte holds two texels, high nibble first.
+        const __m128i bytes = _mm_cvtsi32_si128(static_cast<int>(packed));
+        const __m256i idx = _mm256_and_si256(
+            _mm256_srlv_epi32(_mm256_cvtepu8_epi32(_mm_unpacklo_epi8(bytes, bytes)), shifts),
+            kMask_x0f);
+        const __m256i lo = _mm256_permutevar8x32_epi32(pal_lo, idx);
+        const __m256i hi = _mm256_permutevar8x32_epi32(pal_hi, idx);
+        _mm256_storeu_si256((__m256i*)(dst + (y + iy) * width + x),
+                            _mm256_blendv_epi8(lo, hi, _mm256_cmpgt_epi32(idx, kSeven)));
+      }
+    }
+  }
+}
+
+FUNCTION_TARGET_AVX2
+static void TexDecoder_DecodeImpl_I4_AVX2(u32* dst, const u8* src, int width, int height,
+                                          TextureFormat texformat, const u8* tlut,
+                                          TLUTFormat tlutfmt, int Wsteps4, int Wsteps8)
+{
+  const __m128i kMask_x0f = _mm_set1_epi8(0x0f);
+  const __m128i kMask_xf0 = _mm_set1_epi8(static_cast<char>(0xf0));
+  // Splats texels 0-7 (row 0) and 8-15 (row 1) of a broadcast register to 32 bits each.
+  const __m256i mask_row0 = _mm256_setr_epi8(0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4,
+                                             4, 4, 5, 5, 5, 5, 6, 6, 6, 6, 7, 7, 7, 7);
+  const __m256i mask_row1 =
+      _mm256_setr_epi8(8, 8, 8, 8, 9, 9, 9, 9, 10, 10, 10, 10, 11, 11, 11, 11, 12, 12, 12, 12, 13,
+                       13, 13, 13, 14, 14, 14, 14, 15, 15, 15, 15);
+  for (int y = 0; y < height; y += 8)
+  {
+    for (int x = 0, yStep = (y / 8) * Wsteps8; x < width; x += 8, yStep++)
+    {
+      for (int iy = 0, xStep = 4 * yStep; iy < 8; iy += 2, xStep++)
+      {
+        const __m128i r0 = _mm_loadl_epi64((const __m128i*)(src + 8 * xStep));
+        const __m128i i1 = _mm_and_si128(r0, kMask_xf0);
+        const __m128i i2 = _mm_and_si128(r0, kMask_x0f);
+        // Interleaving the expanded high and low nibbles yields the texels in row order.
+        const __m128i texels = _mm_unpacklo_epi8(_mm_or_si128(i1, _mm_srli_epi16(i1, 4)),
+                                                 _mm_or_si128(i2, _mm_slli_epi16(i2, 4)));
+        const __m256i both = _mm256_broadcastsi128_si256(texels);
+        _mm256_storeu_si256((__m256i*)(dst + (y + iy) * width + x),
+                            _mm256_shuffle_epi8(both, mask_row0));
+        _mm256_storeu_si256((__m256i*)(dst + (y + iy + 1) * width + x),
+                            _mm256_shuffle_epi8(both, mask_row1));
+      }
+    }
+  }
+}
+
+FUNCTION_TARGET_AVX2
+static void TexDecoder_DecodeImpl_I8_AVX2(u32* dst, const u8* src, int width, int height,
+                                          TextureFormat texformat, const u8* tlut,
+                                          TLUTFormat tlutfmt, int Wsteps4, int Wsteps8)
+{
+  const __m256i mask_row0 = _mm256_setr_epi8(0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4,
+                                             4, 4, 5, 5, 5, 5, 6, 6, 6, 6, 7, 7, 7, 7);
+  const __m256i mask_row1 =
+      _mm256_setr_epi8(8, 8, 8, 8, 9, 9, 9, 9, 10, 10, 10, 10, 11, 11, 11, 11, 12, 12, 12, 12, 13,
+                       13, 13, 13, 14, 14, 14, 14, 15, 15, 15, 15);
+  for (int y = 0; y < height; y += 4)
+  {
+    for (int x = 0, yStep = (y / 4) * Wsteps8; x < width; x += 8, yStep++)
+    {
+      for (int iy = 0, xStep = 4 * yStep; iy < 4; iy += 2, xStep += 2)
+      {
+        const __m256i both =
+            _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)(src + 8 * xStep)));
+        _mm256_storeu_si256((__m256i*)(dst + (y + iy) * width + x),
+                            _mm256_shuffle_epi8(both, mask_row0));
+        _mm256_storeu_si256((__m256i*)(dst + (y + iy + 1) * width + x),
+                            _mm256_shuffle_epi8(both, mask_row1));
+      }
+    }
+  }
+}
+
+FUNCTION_TARGET_AVX2
+static void TexDecoder_DecodeImpl_C8_AVX2(u32* dst, const u8* src, int width, int height,
+                                          TextureFormat texformat, const u8* tlut,
+                                          TLUTFormat tlutfmt, int Wsteps4, int Wsteps8)
+{
+  alignas(32) u32 palette[256];
+  DecodePalette(palette, tlut, tlutfmt, 256);
+
+  for (int y = 0; y < height; y += 4)
+  {
+    for (int x = 0, yStep = (y / 4) * Wsteps8; x < width; x += 8, yStep++)
+    {
+      for (int iy = 0, xStep = 4 * yStep; iy < 4; iy++, xStep++)
+      {
+        const __m256i idx =
+            _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(src + 8 * xStep)));
+        _mm256_storeu_si256((__m256i*)(dst + (y + iy) * width + x),
+                            _mm256_i32gather_epi32((const int*)palette, idx, 4));
+      }
+    }
+  }
+}
+
+FUNCTION_TARGET_AVX2
+static void TexDecoder_DecodeImpl_IA4_AVX2(u32* dst, const u8* src, int width, int height,
+                                           TextureFormat texformat, const u8* tlut,
+                                           TLUTFormat tlutfmt, int Wsteps4, int Wsteps8)
+{
+  const __m128i kMask_x0f = _mm_set1_epi8(0x0f);
+  const __m128i kMask_xf0 = _mm_set1_epi8(static_cast<char>(0xf0));
+  // (l0 a0 l1 a1 ... l7 a7) -> (l0 l0 l0 a0 ... l7 l7 l7 a7)
+  const __m256i mask = _mm256_setr_epi8(0, 0, 0, 1, 2, 2, 2, 3, 4, 4, 4, 5, 6, 6, 6, 7, 8, 8, 8, 9,
+                                        10, 10, 10, 11, 12, 12, 12, 13, 14, 14, 14, 15);
+  for (int y = 0; y < height; y += 4)
+  {
+    for (int x = 0, yStep = (y / 4) * Wsteps8; x < width; x += 8, yStep++)
+    {
+      for (int iy = 0, xStep = 4 * yStep; iy < 4; iy += 2, xStep += 2)
+      {
+        const __m128i r0 = _mm_loadu_si128((const __m128i*)(src + 8 * xStep));
+        const __m128i a = _mm_and_si128(r0, kMask_xf0);
+        const __m128i l = _mm_and_si128(r0, kMask_x0f);
+        const __m128i a8 = _mm_or_si128(a, _mm_srli_epi16(a, 4));
+        const __m128i l8 = _mm_or_si128(l, _mm_slli_epi16(l, 4));
+        const __m256i row0 = _mm256_broadcastsi128_si256(_mm_unpacklo_epi8(l8, a8));
+        const __m256i row1 = _mm256_broadcastsi128_si256(_mm_unpackhi_epi8(l8, a8));
+        _mm256_storeu_si256((__m256i*)(dst + (y + iy) * width + x),
+                            _mm256_shuffle_epi8(row0, mask));
+        _mm256_storeu_si256((__m256i*)(dst + (y + iy + 1) * width + x),
+                            _mm256_shuffle_epi8(row1, mask));
+      }
+    }
+  }
+}
+
+FUNCTION_TARGET_AVX2
+static void TexDecoder_DecodeImpl_IA8_AVX2(u32* dst, const u8* src, int width, int height,
+                                           TextureFormat texformat, const u8* tlut,
+                                           TLUTFormat tlutfmt, int Wsteps4, int Wsteps8)
+{
+  // Same shuffle as the SSSE3 version, with the upper lane reading the second row.
+  const __m256i mask = _mm256_setr_epi8(1, 1, 1, 0, 3, 3, 3, 2, 5, 5, 5, 4, 7, 7, 7, 6, 9, 9, 9, 8,
+                                        11, 11, 11, 10, 13, 13, 13, 12, 15, 15, 15, 14);
+  for (int y = 0; y < height; y += 4)
+  {
+    for (int x = 0, yStep = (y / 4) * Wsteps4; x < width; x += 4, yStep++)
+    {
+      for (int iy = 0, xStep = 4 * yStep; iy < 4; iy += 2, xStep += 2)
+      {
+        const __m256i both =
+            _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)(src + 8 * xStep)));
+        StoreTwoRows_AVX2(dst + (y + iy) * width + x, width, _mm256_shuffle_epi8(both, mask));
+      }
+    }
+  }
+}
+
+FUNCTION_TARGET_AVX2
+static void TexDecoder_DecodeImpl_C14X2_AVX2(u32* dst, const u8* src, int width, int height,
+                                             TextureFormat texformat, const u8* tlut,
+                                             TLUTFormat tlutfmt, int Wsteps4, int Wsteps8)
+{
+  // 16K entries is too many to expand up front, so gather the raw entries instead. Each gather
+  // reads the entry plus the two bytes after it; the extra half is discarded by the shuffles.
+  const __m256i kMask_x3fff = _mm256_set1_epi32(0x3FFF);
+  const __m256i ia8_mask =
+      _mm256_setr_epi8(1, 1, 1, 0, 5, 5, 5, 4, 9, 9, 9, 8, 13, 13, 13, 12, 1, 1, 1, 0, 5, 5, 5, 4,
+                       9, 9, 9, 8, 13, 13, 13, 12);
+  const __m256i swap_mask =
+      _mm256_setr_epi8(1, 0, -128, -128, 5, 4, -128, -128, 9, 8, -128, -128, 13, 12, -128, -128, 1,
+                       0, -128, -128, 5, 4, -128, -128, 9, 8, -128, -128, 13, 12, -128, -128);
+  for (int y = 0; y < height; y += 4)
+  {
+    for (int x = 0, yStep = (y / 4) * Wsteps4; x < width; x += 4, yStep++)
+    {
+      for (int iy = 0, xStep = 4 * yStep; iy < 4; iy += 2, xStep += 2)
+      {
+        const __m256i idx = _mm256_and_si256(LoadSwappedU16x8_AVX2(src + 8 * xStep), kMask_x3fff);
+        const __m256i entries = _mm256_i32gather_epi32((const int*)tlut, idx, 2);
+        __m256i texels;
+        switch (tlutfmt)
+        {
+        case TLUTFormat::IA8:
+          texels = _mm256_shuffle_epi8(entries, ia8_mask);
+          break;
+        case TLUTFormat::RGB565:
+          texels = DecodeRGB565_AVX2(_mm256_shuffle_epi8(entries, swap_mask));
+          break;
+        case TLUTFormat::RGB5A3:
+          texels = DecodeRGB5A3_AVX2(_mm256_shuffle_epi8(entries, swap_mask));
+          break;
+        default:
+          texels = _mm256_setzero_si256();
+          break;
+        }
+        StoreTwoRows_AVX2(dst + (y + iy) * width + x, width, texels);
+      }
+    }
+  }
+}
+
+FUNCTION_TARGET_AVX2
+static void TexDecoder_DecodeImpl_RGB5A3_AVX2(u32* dst, const u8* src, int width, int height,
+                                              TextureFormat texformat, const u8* tlut,
+                                              TLUTFormat tlutfmt, int Wsteps4, int Wsteps8)
+{
+  for (int y = 0; y < height; y += 4)
+  {
+    for (int x = 0, yStep = (y / 4) * Wsteps4; x < width; x += 4, yStep++)
+    {
+      for (int iy = 0, xStep = 4 * yStep; iy < 4; iy += 2, xStep += 2)
+      {
+        StoreTwoRows_AVX2(dst + (y + iy) * width + x, width,
+                          DecodeRGB5A3_AVX2(LoadSwappedU16x8_AVX2(src + 8 * xStep)));
+      }
+    }
+  }
+}
+
+FUNCTION_TARGET_AVX2
+static inline __m256i Convert5To8_AVX2(__m256i v)
+{
+  return _mm256_or_si256(_mm256_slli_epi32(v, 3), _mm256_srli_epi32(v, 2));
+}
+
+FUNCTION_TARGET_AVX2
+static inline __m256i Convert6To8_AVX2(__m256i v)
+{
+  return _mm256_or_si256(_mm256_slli_epi32(v, 2), _mm256_srli_epi32(v, 4));
+}
+
+// Decodes the four colors of each block in a pair of DXT blocks into one register, without
+// branching on which of the two palette modes each block uses.
+FUNCTION_TARGET_AVX2
+static inline __m256i DecodeDXTPalettes_AVX2(__m128i pair)
+{
+  // a = (c1, c2, c2, c1) and b = (c2, c1, c1, c2) per block, so that 3/8 * a + 5/8 * b yields
+  // colors 2 and 3 of the four-color mode in the upper two slots.
+  const __m256i a_mask =
+      _mm256_setr_epi8(1, 0, -128, -128, 3, 2, -128, -128, 3, 2, -128, -128, 1, 0, -128, -128, 9,
+                       8, -128, -128, 11, 10, -128, -128, 11, 10, -128, -128, 9, 8, -128, -128);
+  const __m256i b_mask =
+      _mm256_setr_epi8(3, 2, -128, -128, 1, 0, -128, -128, 1, 0, -128, -128, 3, 2, -128, -128, 11,
+                       10, -128, -128, 9, 8, -128, -128, 9, 8, -128, -128, 11, 10, -128, -128);
+  const __m256i both = _mm256_broadcastsi128_si256(pair);
+  const __m256i a = _mm256_shuffle_epi8(both, a_mask);
+  const __m256i b = _mm256_shuffle_epi8(both, b_mask);
+
+  const __m256i kMask_x1f = _mm256_set1_epi32(0x1F);
+  const __m256i kMask_x3f = _mm256_set1_epi32(0x3F);
+  const __m256i channels_a[3] = {
+      Convert5To8_AVX2(_mm256_srli_epi32(a, 11)),
+      Convert6To8_AVX2(_mm256_and_si256(_mm256_srli_epi32(a, 5), kMask_x3f)),
+      Convert5To8_AVX2(_mm256_and_si256(a, kMask_x1f)),
+  };
+  const __m256i channels_b[3] = {
+      Convert5To8_AVX2(_mm256_srli_epi32(b, 11)),
+      Convert6To8_AVX2(_mm256_and_si256(_mm256_srli_epi32(b, 5), kMask_x3f)),
+      Convert5To8_AVX2(_mm256_and_si256(b, kMask_x1f)),
+  };
+
+  // Four-color mode when c1 > c2, taken from slot 0 of each block.
+  const __m256i four_color = _mm256_shuffle_epi32(_mm256_cmpgt_epi32(a, b), 0);
+  const __m256i upper_slots = _mm256_setr_epi32(0, 0, -1, -1, 0, 0, -1, -1);
+  __m256i colors = _mm256_setzero_si256();
+  for (int i = 0; i < 3; i++)
+  {
+    const __m256i ca = channels_a[i];
+    const __m256i cb = channels_b[i];
+    const __m256i blend = _mm256_srli_epi32(
+        _mm256_add_epi32(_mm256_mullo_epi32(ca, _mm256_set1_epi32(3)),
+                         _mm256_mullo_epi32(cb, _mm256_set1_epi32(5))),
+        3);
+    const __m256i average = _mm256_srli_epi32(_mm256_add_epi32(ca, cb), 1);
+    const __m256i derived = _mm256_blendv_epi8(average, blend, four_color);
+    colors = _mm256_or_si256(colors,
+                             _mm256_slli_epi32(_mm256_blendv_epi8(ca, derived, upper_slots),
+                                               8 * i));
+  }
+
+  // Color 3 is transparent in the three-color mode.
+  const __m256i slot3 = _mm256_setr_epi32(0, 0, 0, -1, 0, 0, 0, -1);
+  const __m256i alpha =
+      _mm256_andnot_si256(_mm256_andnot_si256(four_color, slot3), _mm256_set1_epi32(0xFF000000));
+  return _mm256_or_si256(colors, alpha);
+}
+
+FUNCTION_TARGET_AVX2
+static void TexDecoder_DecodeImpl_CMPR_AVX2(u32* dst, const u8* src, int width, int height,
+                                            TextureFormat texformat, const u8* tlut,
+                                            TLUTFormat tlutfmt, int Wsteps4, int Wsteps8)
+{
+  // Both blocks of a pair share one register: colors 0-3 belong to the left block and 4-7 to
+  // the right one, so a single permute resolves a whole 8-texel row.
+  const __m256i shifts = _mm256_setr_epi32(6, 4, 2, 0, 6, 4, 2, 0);
+  const __m256i block_offset = _mm256_setr_epi32(0, 0, 0, 0, 4, 4, 4, 4);
+  const __m256i sel_words = _mm256_setr_epi32(1, 1, 1, 1, 3, 3, 3, 3);
+  const __m256i kMask_x03 = _mm256_set1_epi32(3);
+  for (int y = 0; y < height; y += 8)
+  {
+    for (int x = 0, yStep = (y / 8) * Wsteps8; x < width; x += 8, yStep++)
+    {
+      for (int z = 0, xStep = 2 * yStep; z < 2; ++z, xStep++)
+      {
+        const __m128i pair =
+            _mm_loadu_si128((const __m128i*)(src + sizeof(DXTBlock) * 2 * xStep));
+        const __m256i palette = DecodeDXTPalettes_AVX2(pair);
+        // Splat each block's selector word across its half of the register.
+        const __m256i sel = _mm256_permutevar8x32_epi32(
+            _mm256_castsi128_si256(pair), sel_words);
+
+        u32* dst32 = dst + (y + z * 4) * width + x;
+        for (int row = 0; row < 4; row++)
+        {
+          const __m256i idx = _mm256_add_epi32(
+              _mm256_and_si256(
+                  _mm256_srlv_epi32(sel, _mm256_add_epi32(shifts, _mm256_set1_epi32(8 * row))),
+                  kMask_x03),
+              block_offset);
+          _mm256_storeu_si256((__m256i*)(dst32 + width * row),
+                              _mm256_permutevar8x32_epi32(palette, idx));
+        }
+      }
+    }
+  }
+}
+
 void _TexDecoder_DecodeImpl(u32* dst, const u8* src, int width, int height, TextureFormat texformat,
                             const u8* tlut, TLUTFormat tlutfmt)
 {
@@ -1422,11 +1859,18 @@ void _TexDecoder_DecodeImpl(u32* dst, const u8* src, int width, int height, Text
   switch (texformat)
   {
   case TextureFormat::C4:
-    TexDecoder_DecodeImpl_C4(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4, Wsteps8);
+    if (cpu_info.bAVX2)
+      TexDecoder_DecodeImpl_C4_AVX2(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
+                                    Wsteps8);
+    else
+      TexDecoder_DecodeImpl_C4(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4, Wsteps8);
     break;
 
   case TextureFormat::I4:
-    if (cpu_info.bSSSE3)
+    if (cpu_info.bAVX2)
+      TexDecoder_DecodeImpl_I4_AVX2(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
+                                    Wsteps8);
+    else if (cpu_info.bSSSE3)
       TexDecoder_DecodeImpl_I4_SSSE3(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
                                      Wsteps8);
     else
@@ -1434,7 +1878,10 @@ void _TexDecoder_DecodeImpl(u32* dst, const u8* src, int width, int height, Text
     break;
 
   case TextureFormat::I8:
-    if (cpu_info.bSSSE3)
+    if (cpu_info.bAVX2)
+      TexDecoder_DecodeImpl_I8_AVX2(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
+                                    Wsteps8);
+    else if (cpu_info.bSSSE3)
       TexDecoder_DecodeImpl_I8_SSSE3(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
                                      Wsteps8);
     else
@@ -1442,15 +1889,28 @@ void _TexDecoder_DecodeImpl(u32* dst, const u8* src, int width, int height, Text
     break;
 
   case TextureFormat::C8:
-    TexDecoder_DecodeImpl_C8(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4, Wsteps8);
+    // Expanding the 256-entry palette costs more than it saves on the smallest mip levels.
+    if (cpu_info.bAVX2 && width * height >= 256)
+      TexDecoder_DecodeImpl_C8_AVX2(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
+                                    Wsteps8);
+    else
+      TexDecoder_DecodeImpl_C8(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4, Wsteps8);
     break;
 
   case TextureFormat::IA4:
-    TexDecoder_DecodeImpl_IA4(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4, Wsteps8);
+    if (cpu_info.bAVX2)
+      TexDecoder_DecodeImpl_IA4_AVX2(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
+                                     Wsteps8);
+    else
+      TexDecoder_DecodeImpl_IA4(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
+                                Wsteps8);
     break;
 
   case TextureFormat::IA8:
-    if (cpu_info.bSSSE3)
+    if (cpu_info.bAVX2)
+      TexDecoder_DecodeImpl_IA8_AVX2(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
+                                     Wsteps8);
+    else if (cpu_info.bSSSE3)
       TexDecoder_DecodeImpl_IA8_SSSE3(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
                                       Wsteps8);
     else
@@ -1459,8 +1919,12 @@ void _TexDecoder_DecodeImpl(u32* dst, const u8* src, int width, int height, Text
     break;
 
   case TextureFormat::C14X2:
-    TexDecoder_DecodeImpl_C14X2(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
-                                Wsteps8);
+    if (cpu_info.bAVX2)
+      TexDecoder_DecodeImpl_C14X2_AVX2(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
+                                       Wsteps8);
+    else
+      TexDecoder_DecodeImpl_C14X2(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
+                                  Wsteps8);
     break;
 
   case TextureFormat::RGB565:
@@ -1469,7 +1933,10 @@ void _TexDecoder_DecodeImpl(u32* dst, const u8* src, int width, int height, Text
     break;
 
   case TextureFormat::RGB5A3:
-    if (cpu_info.bSSSE3)
+    if (cpu_info.bAVX2)
+      TexDecoder_DecodeImpl_RGB5A3_AVX2(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
+                                        Wsteps8);
+    else if (cpu_info.bSSSE3)
       TexDecoder_DecodeImpl_RGB5A3_SSSE3(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
                                          Wsteps8);
     else
@@ -1487,7 +1954,12 @@ void _TexDecoder_DecodeImpl(u32* dst, const u8* src, int width, int height, Text
     break;
 
   case TextureFormat::CMPR:
-    TexDecoder_DecodeImpl_CMPR(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4, Wsteps8);
+    if (cpu_info.bAVX2)
+      TexDecoder_DecodeImpl_CMPR_AVX2(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
+                                      Wsteps8);
+    else
+      TexDecoder_DecodeImpl_CMPR(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
+                                 Wsteps8);
     break;
 
   case TextureFormat::XFB:
@@ -14,7 +14,11 @@
 
 class VertexLoaderUID
 {
-  std::array<u32, 5> vid{};
+public:
+  using ID = std::array<u32, 5>;
+
+private:
+  ID vid{};
   size_t hash = 0;
 
 public:
@@ -31,6 +35,7 @@ public:
 
   bool operator==(const VertexLoaderUID& rh) const { return vid == rh.vid; }
   size_t GetHash() const { return hash; }
+  const ID& GetID() const { return vid; }
 
 private:
   size_t CalculateHash() const
@@ -15,6 +15,7 @@
 
 #include "Common/CommonTypes.h"
 #include "Common/EnumMap.h"
+#include "Common/LinearDiskCache.h"
 #include "Common/Logging/Log.h"
 
 #include "Core/DolphinAnalytics.h"
@@ -27,6 +28,7 @@
 #include "VideoCommon/DataReader.h"
 #include "VideoCommon/IndexGenerator.h"
 #include "VideoCommon/NativeVertexFormat.h"
+#include "VideoCommon/ShaderGenCommon.h"
 #include "VideoCommon/Statistics.h"
 #include "VideoCommon/VertexLoaderBase.h"
 #include "VideoCommon/VertexManagerBase.h"
@@ -50,6 +52,8 @@ u32 g_current_components;
 typedef std::unordered_map<VertexLoaderUID, std::unique_ptr<VertexLoaderBase>> VertexLoaderMap;
 static std::mutex s_vertex_loader_map_lock;
 static VertexLoaderMap s_vertex_loader_map;
+// Every TVtxDesc/VAT combination seen by the current game, so the loaders can be rebuilt at boot.
+static Common::LinearDiskCache<VertexLoaderUID::ID, u8> s_vertex_loader_disk_cache;
 // TODO - change into array of pointers. Keep a map of all seen so far.
 
 Common::EnumMap<u8*, CPArray::TexCoord7> cached_arraybases;
@@ -72,10 +76,49 @@ void Init()
 void Clear()
 {
   std::lock_guard<std::mutex> lk(s_vertex_loader_map_lock);
+  s_vertex_loader_disk_cache.Sync();
+  s_vertex_loader_disk_cache.Close();
   s_vertex_loader_map.clear();
   s_native_vertex_map.clear();
 }
 
+void LoadVertexLoaderCache()
+{
+  if (!g_ActiveConfig.bShaderCache)
+    return;
+
+  class CacheReader : public Common::LinearDiskCacheReader<VertexLoaderUID::ID, u8>
+  {
+  public:
+    void Read(const VertexLoaderUID::ID& key, const u8* value, u32 value_size) override
+    {
+      TVtxDesc vtx_desc;
+      vtx_desc.low.Hex = key[0];
+      vtx_desc.high.Hex = key[1];
+      VAT vtx_attr;
+      vtx_attr.g0.Hex = key[2];
+      vtx_attr.g1.Hex = key[3];
+      vtx_attr.g2.Hex = key[4];
+
+      auto& loader = s_vertex_loader_map[VertexLoaderUID(vtx_desc, vtx_attr)];
+      if (loader)
+        return;
+
+      loader = VertexLoaderBase::CreateVertexLoader(vtx_desc, vtx_attr);
+      loader->m_native_vertex_format = GetOrCreateMatchingFormat(loader->m_native_vtx_decl);
+      INCSTAT(g_stats.num_vertex_loaders);
+    }
+  };
+
+  // Vertex loaders don't depend on the backend, so the list is shared between all of them.
+  const std::string filename = GetDiskShaderCacheFileName(
+      g_ActiveConfig.backend_info.api_type, "VertexLoaders", true, false, false);
+  std::lock_guard<std::mutex> lk(s_vertex_loader_map_lock);
+  CacheReader reader;
+  const u32 count = s_vertex_loader_disk_cache.OpenAndRead(filename, reader);
+  INFO_LOG_FMT(VIDEO, "Loaded {} cached vertex loaders from {}", count, filename);
+}
+
 void UpdateVertexArrayPointers()
 {
   // Anything to update?
@@ -235,6 +278,8 @@ VertexLoaderBase* GetOrCreateLoader(int vtx_attr_group)
         VertexLoaderBase::CreateVertexLoader(state->vtx_desc, state->vtx_attr[vtx_attr_group]));
     loader = it->second.get();
     INCSTAT(g_stats.num_vertex_loaders);
+    if (g_ActiveConfig.bShaderCache)
+      s_vertex_loader_disk_cache.Append(uid.GetID(), nullptr, 0);
   }
   if (check_for_native_format)
   {
@@ -413,9 +458,14 @@ int RunVertices(int vtx_attr_group, OpcodeDecoder::Primitive primitive, int coun
 
     // CPUCull's performance increase comes from encoding fewer GPU commands, not sending less data
     // Therefore it's only useful to check if culling could remove a flush
-    const bool can_cpu_cull = g_ActiveConfig.bCPUCull &&
-                              primitive < OpcodeDecoder::Primitive::GX_DRAW_LINES &&
-                              !g_vertex_manager->HasSendableVertices();
+    // Per-triangle culling also drops culled triangles from the index buffer, so it can be worth
+    // running when the draw gets merged anyway, to save GPU vertex work.
+    const bool cull_triangles = g_ActiveConfig.bCPUCull && g_ActiveConfig.bCPUCullTriangles &&
+                                primitive < OpcodeDecoder::Primitive::GX_DRAW_LINES;
+    const bool cull_to_cpu_buffer = g_ActiveConfig.bCPUCull &&
+                                    primitive < OpcodeDecoder::Primitive::GX_DRAW_LINES &&
+                                    !g_vertex_manager->HasSendableVertices();
+    const bool can_cpu_cull = cull_triangles || cull_to_cpu_buffer;
 
     // if cull mode is CULL_ALL, tell VertexManager to skip triangles and quads.
     // They still need to go through vertex loading, because we need to calculate a zfreeze
@@ -425,11 +475,25 @@ int RunVertices(int vtx_attr_group, OpcodeDecoder::Primitive primitive, int coun
 
     const int stride = loader->m_native_vtx_decl.stride;
     DataReader dst = g_vertex_manager->PrepareForAdditionalData(primitive, count, stride,
-                                                                cullall || can_cpu_cull);
+                                                                cullall || cull_to_cpu_buffer);
 
     count = loader->RunVertices(src, dst.GetPointer(), count);
 
-    if (can_cpu_cull && !cullall)
+    u32 num_visible_triangles = 0;
+    bool use_culled_indices = false;
+    if (cull_triangles && !cullall)
+    {
+      num_visible_triangles =
+          g_vertex_manager->CullTriangles(loader, primitive, dst.GetPointer(), count);
+      // Vertices in the CPU-side buffer are simply dropped if nothing is visible
+      use_culled_indices = num_visible_triangles != 0 || !cull_to_cpu_buffer;
+      if (num_visible_triangles != 0 && cull_to_cpu_buffer)
+      {
+        DataReader new_dst = g_vertex_manager->DisableCullAll(stride);
+        memmove(new_dst.GetPointer(), dst.GetPointer(), count * stride);
+      }
+    }
+    else if (can_cpu_cull && !cullall)
     {
       if (!g_vertex_manager->AreAllVerticesCulled(loader, primitive, dst.GetPointer(), count))
       {
@@ -438,7 +502,10 @@ int RunVertices(int vtx_attr_group, OpcodeDecoder::Primitive primitive, int coun
       }
     }
 
-    g_vertex_manager->AddIndices(primitive, count);
+    if (use_culled_indices)
+      g_vertex_manager->AddCulledIndices(primitive, count, num_visible_triangles);
+    else
+      g_vertex_manager->AddIndices(primitive, count);
     g_vertex_manager->FlushData(count, loader->m_native_vtx_decl.stride);
 
     ADDSTAT(g_stats.this_frame.num_prims, count);
@@ -28,6 +28,10 @@ using NativeVertexFormatMap =
 void Init();
 void Clear();
 
+// Recreates the vertex loaders recorded for the running game in previous sessions, so that they
+// don't have to be generated the first time a draw uses them. Requires the backend to be ready.
+void LoadVertexLoaderCache();
+
 void MarkAllDirty();
 
 // Creates or obtains a pointer to a VertexFormat representing decl.
@@ -6,6 +6,7 @@
 #include <array>
 #include <cstring>
 #include <string>
+#include <utility>
 
 #include "Common/BitSet.h"
 #include "Common/CPUDetect.h"
@@ -46,7 +47,7 @@ static OpArg MPIC(const void* ptr)
 VertexLoaderX64::VertexLoaderX64(const TVtxDesc& vtx_desc, const VAT& vtx_att)
     : VertexLoaderBase(vtx_desc, vtx_att)
 {
-  AllocCodeSpace(4096);
+  AllocCodeSpace(8192);
   ClearCodeSpace();
   GenerateVertexLoader();
   WriteProtect(true);
@@ -170,6 +171,62 @@ void VertexLoaderX64::ReadVertex(OpArg data, VertexComponentFormat attribute,
   if (attribute == VertexComponentFormat::Direct)
     m_src_ofs += load_bytes;
 
+  if (m_load_pairs)
+  {
+    // The second vertex goes into the upper lane, so that both are converted at once. No zfreeze
+    // stores are needed, as the pair loop stops before the last three vertices.
+    const auto load = [&](X64Reg reg, const OpArg& src) {
+      if (load_bytes > 8)
+        VMOVDQU(reg, src);
+      else if (load_bytes > 4)
+        VMOVQ_xmm(reg, src);
+      else
+        VMOVD_xmm(reg, src);
+    };
+    OpArg data_b = data;
+    data_b.AddMemOffset(m_vertex_size);
+    load(coords, data);
+    load(XMM1, data_b);
+    VINSERTI128(coords, coords, R(XMM1), 1);
+
+    VBROADCASTI128(XMM1, MPIC(&shuffle_lut[format][count_in - 1]));
+    VPSHUFB_256(coords, coords, R(XMM1));
+    if (format == ComponentFormat::Byte)
+      VPSRAD_256(coords, coords, 24);
+    if (format == ComponentFormat::Short)
+      VPSRAD_256(coords, coords, 16);
+
+    if (format < ComponentFormat::Float)
+    {
+      VCVTDQ2PS_256(coords, R(coords));
+      if (dequantize && scaling_exponent)
+      {
+        VBROADCASTI128(XMM1, MPIC(&scale_factors[scaling_exponent]));
+        VMULPS_256(coords, coords, R(XMM1));
+      }
+    }
+
+    VEXTRACTI128(R(XMM1), coords, 1);
+    OpArg dest_b = dest;
+    dest_b.AddMemOffset(m_pair_dst_stride);
+    for (const auto& [reg, out] : {std::pair(coords, dest), std::pair(XMM1, dest_b)})
+    {
+      switch (count_out)
+      {
+      case 1:
+        VMOVSS(out, reg);
+        break;
+      case 2:
+        VMOVLPS(out, reg);
+        break;
+      case 3:
+        VMOVUPS(out, reg);
+        break;
+      }
+    }
+    return;
+  }
+
   if (cpu_info.bSSSE3)
   {
     if (load_bytes > 8)
@@ -410,43 +467,52 @@ void VertexLoaderX64::ReadColor(OpArg data, VertexComponentFormat attribute, Col
     m_src_ofs += load_bytes;
 }
 
-void VertexLoaderX64::GenerateVertexLoader()
+bool VertexLoaderX64::CanLoadVertexPairs() const
 {
-  BitSet32 regs = {src_reg,  dst_reg,       scratch1,    scratch2,
-                   scratch3, remaining_reg, skipped_reg, base_reg};
-  regs &= ABI_ALL_CALLEE_SAVED;
-  regs[RBP] = true;  // Give us a stack frame
-  ABI_PushRegistersAndAdjustStack(regs, 0);
-
-  // Backup count since we're going to count it down.
-  PUSH(32, R(ABI_PARAM3));
+  if (!cpu_info.bAVX2)
+    return false;
 
-  // ABI_PARAM3 is one of the lower registers, so free it for scratch2.
-  // We also have it end at a value of 0, to simplify indexing for zfreeze;
-  // this requires subtracting 1 at the start.
-  LEA(32, remaining_reg, MDisp(ABI_PARAM3, -1));
-
-  MOV(64, R(base_reg), R(ABI_PARAM4));
-
-  if (IsIndexed(m_VtxDesc.low.Position))
-    XOR(32, R(skipped_reg), R(skipped_reg));
-
-  // TODO: load constants into registers outside the main loop
-
-  const u8* loop_start = GetCodePtr();
+  // Indexed attributes can skip vertices, and texture matrix indices are merged into the texture
+  // coordinates with scalar code, so only formats without either of them are loaded in pairs.
+  if (IsIndexed(m_VtxDesc.low.Position) || IsIndexed(m_VtxDesc.low.Normal))
+    return false;
+  for (u8 i = 0; i < m_VtxDesc.low.Color.Size(); i++)
+  {
+    if (IsIndexed(m_VtxDesc.low.Color[i]))
+      return false;
+  }
+  for (u8 i = 0; i < m_VtxDesc.high.TexCoord.Size(); i++)
+  {
+    if (IsIndexed(m_VtxDesc.high.TexCoord[i]) || m_VtxDesc.low.TexMatIdx[i])
+      return false;
+  }
+  return true;
+}
 
+void VertexLoaderX64::GenerateVertexBody()
+{
   if (m_VtxDesc.low.PosMatIdx)
   {
+    if (m_load_pairs)
+    {
+      MOVZX(32, 8, scratch1, MDisp(src_reg, m_src_ofs + m_vertex_size));
+      AND(32, R(scratch1), Imm8(0x3F));
+      MOV(32, MDisp(dst_reg, m_dst_ofs + m_pair_dst_stride), R(scratch1));
+    }
+
     MOVZX(32, 8, scratch1, MDisp(src_reg, m_src_ofs));
     AND(32, R(scratch1), Imm8(0x3F));
     MOV(32, MDisp(dst_reg, m_dst_ofs), R(scratch1));
 
     // zfreeze
-    CMP(32, R(remaining_reg), Imm8(3));
-    FixupBranch dont_store = J_CC(CC_AE);
-    MOV(32, MPIC(VertexLoaderManager::position_matrix_index_cache.data(), remaining_reg, SCALE_4),
-        R(scratch1));
-    SetJumpTarget(dont_store);
+    if (!m_load_pairs)
+    {
+      CMP(32, R(remaining_reg), Imm8(3));
+      FixupBranch dont_store = J_CC(CC_AE);
+      MOV(32, MPIC(VertexLoaderManager::position_matrix_index_cache.data(), remaining_reg, SCALE_4),
+          R(scratch1));
+      SetJumpTarget(dont_store);
+    }
 
     m_native_vtx_decl.posmtx.components = 4;
     m_native_vtx_decl.posmtx.enable = true;
@@ -518,6 +584,17 @@ void VertexLoaderX64::GenerateVertexLoader()
     if (m_VtxDesc.low.Color[i] != VertexComponentFormat::NotPresent)
     {
       data = GetVertexAddr(CPArray::Color0 + i, m_VtxDesc.low.Color[i]);
+      if (m_load_pairs)
+      {
+        // Colors are converted in general purpose registers, one vertex at a time.
+        OpArg data_b = data;
+        data_b.AddMemOffset(m_vertex_size);
+        const u32 src_ofs = m_src_ofs;
+        m_dst_ofs += m_pair_dst_stride;
+        ReadColor(data_b, m_VtxDesc.low.Color[i], m_VtxAttr.GetColorFormat(i));
+        m_dst_ofs -= m_pair_dst_stride;
+        m_src_ofs = src_ofs;
+      }
       ReadColor(data, m_VtxDesc.low.Color[i], m_VtxAttr.GetColorFormat(i));
       m_native_vtx_decl.colors[i].components = 4;
       m_native_vtx_decl.colors[i].enable = true;
@@ -563,6 +640,38 @@ void VertexLoaderX64::GenerateVertexLoader()
       }
     }
   }
+}
+
+void VertexLoaderX64::GenerateVertexLoader()
+{
+  BitSet32 regs = {src_reg,  dst_reg,       scratch1,    scratch2,
+                   scratch3, remaining_reg, skipped_reg, base_reg};
+  regs &= ABI_ALL_CALLEE_SAVED;
+  regs[RBP] = true;  // Give us a stack frame
+  ABI_PushRegistersAndAdjustStack(regs, 0);
+
+  // Backup count since we're going to count it down.
+  PUSH(32, R(ABI_PARAM3));
+
+  // ABI_PARAM3 is one of the lower registers, so free it for scratch2.
+  // We also have it end at a value of 0, to simplify indexing for zfreeze;
+  // this requires subtracting 1 at the start.
+  LEA(32, remaining_reg, MDisp(ABI_PARAM3, -1));
+
+  MOV(64, R(base_reg), R(ABI_PARAM4));
+
+  if (IsIndexed(m_VtxDesc.low.Position))
+    XOR(32, R(skipped_reg), R(skipped_reg));
+
+  // TODO: load constants into registers outside the main loop
+
+  const bool load_pairs = CanLoadVertexPairs();
+  FixupBranch pair_loop_entry;
+  if (load_pairs)
+    pair_loop_entry = J(Jump::Near);
+
+  const u8* loop_start = GetCodePtr();
+  GenerateVertexBody();
 
   // Prepare for the next vertex.
   ADD(64, R(dst_reg), Imm32(m_dst_ofs));
@@ -597,6 +706,33 @@ void VertexLoaderX64::GenerateVertexLoader()
              m_src_ofs, m_vertex_size, m_VtxDesc.low.Hex, m_VtxDesc.high.Hex, m_VtxAttr.g0.Hex,
              m_VtxAttr.g1.Hex, m_VtxAttr.g2.Hex);
   m_native_vtx_decl.stride = m_dst_ofs;
+
+  if (load_pairs)
+  {
+    // Convert two vertices per iteration while at least four remain, then finish the rest (which
+    // includes the three vertices that need zfreeze stores) with the loop above.
+    SetJumpTarget(pair_loop_entry);
+    const u8* pair_loop_start = GetCodePtr();
+    CMP(32, R(remaining_reg), Imm8(4));
+    FixupBranch pairs_done = J_CC(CC_L, Jump::Near);
+
+    m_pair_dst_stride = m_dst_ofs;
+    m_src_ofs = 0;
+    m_dst_ofs = 0;
+    m_load_pairs = true;
+    GenerateVertexBody();
+    m_load_pairs = false;
+
+    ADD(64, R(dst_reg), Imm32(2 * m_dst_ofs));
+    ADD(64, R(src_reg), Imm32(2 * m_src_ofs));
+    SUB(32, R(remaining_reg), Imm8(2));
+    JMP(pair_loop_start, Jump::Near);
+
+    // The scalar loop uses legacy SSE encodings.
+    SetJumpTarget(pairs_done);
+    VZEROUPPER();
+    JMP(loop_start, Jump::Near);
+  }
 }
 
 int VertexLoaderX64::RunVertices(const u8* src, u8* dst, int count)
@@ -23,11 +23,16 @@ protected:
 private:
   u32 m_src_ofs = 0;
   u32 m_dst_ofs = 0;
+  // Set while generating the loop body which loads two vertices per iteration.
+  bool m_load_pairs = false;
+  u32 m_pair_dst_stride = 0;
   Gen::FixupBranch m_skip_vertex;
+  bool CanLoadVertexPairs() const;
   Gen::OpArg GetVertexAddr(CPArray array, VertexComponentFormat attribute);
   void ReadVertex(Gen::OpArg data, VertexComponentFormat attribute, ComponentFormat format,
                   int count_in, int count_out, bool dequantize, u8 scaling_exponent,
                   AttributeFormat* native_format);
   void ReadColor(Gen::OpArg data, VertexComponentFormat attribute, ColorFormat format);
+  void GenerateVertexBody();
   void GenerateVertexLoader();
 };
@@ -13,6 +13,7 @@
 #include "Common/Logging/Log.h"
 #include "Common/MathUtil.h"
 #include "Common/SmallVector.h"
+#include "Common/TraceZone.h"
 
 #include "Core/DolphinAnalytics.h"
 #include "Core/HW/SystemTimers.h"
@@ -23,6 +24,7 @@
 #include "VideoCommon/BoundingBox.h"
 #include "VideoCommon/DataReader.h"
 #include "VideoCommon/FramebufferManager.h"
+#include "VideoCommon/GPUTiming.h"
 #include "VideoCommon/GeometryShaderManager.h"
 #include "VideoCommon/GraphicsModSystem/Runtime/CustomShaderCache.h"
 #include "VideoCommon/GraphicsModSystem/Runtime/GraphicsModActionData.h"
@@ -145,6 +147,19 @@ bool VertexManagerBase::AreAllVerticesCulled(VertexLoaderBase* loader,
   return m_cpu_cull.AreAllVerticesCulled(loader, primitive, src, count);
 }
 
+u32 VertexManagerBase::CullTriangles(VertexLoaderBase* loader, OpcodeDecoder::Primitive primitive,
+                                     const u8* src, u32 count)
+{
+  return m_cpu_cull.CullTriangles(loader, primitive, src, count);
+}
+
+void VertexManagerBase::AddCulledIndices(OpcodeDecoder::Primitive primitive, u32 num_vertices,
+                                         u32 num_visible)
+{
+  m_index_generator.AddIndicesCulled(primitive, num_vertices, m_cpu_cull.GetTriangleVisibility(),
+                                     num_visible);
+}
+
 DataReader VertexManagerBase::PrepareForAdditionalData(OpcodeDecoder::Primitive primitive,
                                                        u32 count, u32 stride, bool cullall)
 {
@@ -165,6 +180,7 @@ DataReader VertexManagerBase::PrepareForAdditionalData(OpcodeDecoder::Primitive
     // Have to update the rasterization state for point/line cull modes.
     m_current_primitive_type = new_primitive_type;
     SetRasterizationStateChanged();
+    m_geometry_shader_uid_changed = true;
   }
 
   u32 remaining_indices = GetRemainingIndices(primitive);
@@ -182,6 +198,10 @@ DataReader VertexManagerBase::PrepareForAdditionalData(OpcodeDecoder::Primitive
   // need to alloc new buffer
   if (m_is_flushed) [[unlikely]]
   {
+    // Any deferred EFB format conversion has to happen before the new primitives are drawn. This
+    // is done before the buffer is mapped, as it flushes the vertex manager itself.
+    g_framebuffer_manager->ApplyPendingReinterpret();
+
     if (cullall)
     {
       // This buffer isn't getting sent to the GPU. Just allocate it on the cpu.
@@ -353,6 +373,7 @@ void VertexManagerBase::DrawCurrentBatch(u32 base_index, u32 num_indices, u32 ba
     g_bounding_box->Flush();
   }
 
+  g_gpu_timing->OnDraw();
   g_gfx->DrawIndexed(base_index, num_indices, base_vertex);
 }
 
@@ -369,6 +390,7 @@ void VertexManagerBase::InvalidateConstants()
   vertex_shader_manager.dirty = true;
   geometry_shader_manager.dirty = true;
   pixel_shader_manager.dirty = true;
+  pixel_shader_manager.custom_constants_dirty = true;
 }
 
 void VertexManagerBase::UploadUtilityUniforms(const void* uniforms, u32 uniforms_size)
@@ -437,6 +459,8 @@ void VertexManagerBase::Flush()
   if (m_is_flushed)
     return;
 
+  TRACE_ZONE("VertexManagerBase::Flush");
+
   m_is_flushed = true;
 
   if (m_draw_counter == 0)
@@ -525,24 +549,41 @@ void VertexManagerBase::Flush()
     // This way a small minimap would have less effect than a fullscreen projection.
     const auto& viewport = xfmem.viewport;
 
+    ProjectionAspectCache& aspect_cache = m_projection_aspect_cache;
+    if (!aspect_cache.valid || aspect_cache.projection != projection ||
+        aspect_cache.viewport_width != viewport.wd || aspect_cache.viewport_height != viewport.ht)
+    {
+      aspect_cache.valid = true;
+      aspect_cache.projection = projection;
+      aspect_cache.viewport_width = viewport.wd;
+      aspect_cache.viewport_height = viewport.ht;
+      aspect_cache.ratio = CalculateProjectionViewportRatio(projection, viewport);
+      if (IsAnamorphicProjection(projection, viewport, g_ActiveConfig))
+        aspect_cache.aspect = ProjectionAspect::Anamorphic;
+      else if (IsNormalProjection(projection, viewport, g_ActiveConfig))
+        aspect_cache.aspect = ProjectionAspect::Normal;
+      else
+        aspect_cache.aspect = ProjectionAspect::Other;
+    }
+
     // FYI: This average is based on flushes.
     // It doesn't look at vertex counts like the heuristic does.
-    counts.average_ratio.Push(CalculateProjectionViewportRatio(projection, viewport));
+    counts.average_ratio.Push(aspect_cache.ratio);
 
-    if (IsAnamorphicProjection(projection, viewport, g_ActiveConfig))
+    switch (aspect_cache.aspect)
     {
+    case ProjectionAspect::Anamorphic:
       ++counts.anamorphic_flush_count;
       counts.anamorphic_vertex_count += m_index_generator.GetIndexLen();
-    }
-    else if (IsNormalProjection(projection, viewport, g_ActiveConfig))
-    {
+      break;
+    case ProjectionAspect::Normal:
       ++counts.normal_flush_count;
       counts.normal_vertex_count += m_index_generator.GetIndexLen();
-    }
-    else
-    {
+      break;
+    case ProjectionAspect::Other:
       ++counts.other_flush_count;
       counts.other_vertex_count += m_index_generator.GetIndexLen();
+      break;
     }
   }
 
@@ -701,6 +742,9 @@ void VertexManagerBase::DoState(PointerWrap& p)
   p.Do(m_zslope);
   p.Do(VertexLoaderManager::tangent_cache);
   p.Do(VertexLoaderManager::binormal_cache);
+
+  if (p.IsReadMode())
+    SetShaderUidsChanged();
 }
 
 void VertexManagerBase::CalculateZSlope(NativeVertexFormat* format)
@@ -807,28 +851,49 @@ void VertexManagerBase::UpdatePipelineConfig()
     m_pipeline_config_changed = true;
   }
 
-  VertexShaderUid vs_uid = GetVertexShaderUid();
-  if (vs_uid != m_current_pipeline_config.vs_uid)
+  if (VertexLoaderManager::g_current_components != m_current_components)
   {
-    m_current_pipeline_config.vs_uid = vs_uid;
-    m_current_uber_pipeline_config.vs_uid = UberShader::GetVertexShaderUid();
-    m_pipeline_config_changed = true;
+    m_current_components = VertexLoaderManager::g_current_components;
+    m_vertex_shader_uid_changed = true;
   }
 
-  PixelShaderUid ps_uid = GetPixelShaderUid();
-  if (ps_uid != m_current_pipeline_config.ps_uid)
+  if (m_vertex_shader_uid_changed)
   {
-    m_current_pipeline_config.ps_uid = ps_uid;
-    m_current_uber_pipeline_config.ps_uid = UberShader::GetPixelShaderUid();
-    m_pipeline_config_changed = true;
+    m_vertex_shader_uid_changed = false;
+
+    VertexShaderUid vs_uid = GetVertexShaderUid();
+    if (vs_uid != m_current_pipeline_config.vs_uid)
+    {
+      m_current_pipeline_config.vs_uid = vs_uid;
+      m_current_uber_pipeline_config.vs_uid = UberShader::GetVertexShaderUid();
+      m_pipeline_config_changed = true;
+    }
   }
 
-  GeometryShaderUid gs_uid = GetGeometryShaderUid(GetCurrentPrimitiveType());
-  if (gs_uid != m_current_pipeline_config.gs_uid)
+  if (m_pixel_shader_uid_changed)
   {
-    m_current_pipeline_config.gs_uid = gs_uid;
-    m_current_uber_pipeline_config.gs_uid = gs_uid;
-    m_pipeline_config_changed = true;
+    m_pixel_shader_uid_changed = false;
+
+    PixelShaderUid ps_uid = GetPixelShaderUid();
+    if (ps_uid != m_current_pipeline_config.ps_uid)
+    {
+      m_current_pipeline_config.ps_uid = ps_uid;
+      m_current_uber_pipeline_config.ps_uid = UberShader::GetPixelShaderUid();
+      m_pipeline_config_changed = true;
+    }
+  }
+
+  if (m_geometry_shader_uid_changed)
+  {
+    m_geometry_shader_uid_changed = false;
+
+    GeometryShaderUid gs_uid = GetGeometryShaderUid(GetCurrentPrimitiveType());
+    if (gs_uid != m_current_pipeline_config.gs_uid)
+    {
+      m_current_pipeline_config.gs_uid = gs_uid;
+      m_current_uber_pipeline_config.gs_uid = gs_uid;
+      m_pipeline_config_changed = true;
+    }
   }
 
   if (m_rasterization_state_changed)
@@ -932,6 +997,12 @@ void VertexManagerBase::OnConfigChange()
 {
   // Reload index generator function tables in case VS expand config changed
   m_index_generator.Init();
+
+  // The shader UIDs also depend on some of the config.
+  SetShaderUidsChanged();
+
+  // So do the widescreen heuristic's thresholds.
+  m_projection_aspect_cache.valid = false;
 }
 
 void VertexManagerBase::OnDraw()
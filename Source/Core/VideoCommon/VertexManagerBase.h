@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <array>
 #include <memory>
 #include <vector>
 
@@ -110,6 +111,11 @@ public:
   void AddIndices(OpcodeDecoder::Primitive primitive, u32 num_vertices);
   bool AreAllVerticesCulled(VertexLoaderBase* loader, OpcodeDecoder::Primitive primitive,
                             const u8* src, u32 count);
+  /// Returns the number of triangles left after culling each one separately on the CPU
+  u32 CullTriangles(VertexLoaderBase* loader, OpcodeDecoder::Primitive primitive, const u8* src,
+                    u32 count);
+  /// Like AddIndices, but only for the triangles that survived the last CullTriangles call
+  void AddCulledIndices(OpcodeDecoder::Primitive primitive, u32 num_vertices, u32 num_visible);
   virtual DataReader PrepareForAdditionalData(OpcodeDecoder::Primitive primitive, u32 count,
                                               u32 stride, bool cullall);
   /// Switch cullall off after a call to PrepareForAdditionalData with cullall true
@@ -129,6 +135,17 @@ public:
   void SetRasterizationStateChanged() { m_rasterization_state_changed = true; }
   void SetDepthStateChanged() { m_depth_state_changed = true; }
   void SetBlendingStateChanged() { m_blending_state_changed = true; }
+  void SetVertexShaderUidChanged()
+  {
+    m_vertex_shader_uid_changed = true;
+    m_geometry_shader_uid_changed = true;
+  }
+  void SetPixelShaderUidChanged() { m_pixel_shader_uid_changed = true; }
+  void SetShaderUidsChanged()
+  {
+    SetVertexShaderUidChanged();
+    SetPixelShaderUidChanged();
+  }
   void InvalidatePipelineObject()
   {
     m_current_pipeline_object = nullptr;
@@ -165,6 +182,9 @@ public:
   // Call after CPU access is requested.
   void OnCPUEFBAccess();
 
+  // Number of draws made so far in the current frame.
+  u32 GetDrawCounter() const { return m_draw_counter; }
+
   // Call after an EFB copy to RAM. If true, the current command buffer should be executed.
   void OnEFBCopyToRAM();
 
@@ -214,6 +234,11 @@ protected:
   bool m_rasterization_state_changed = true;
   bool m_depth_state_changed = true;
   bool m_blending_state_changed = true;
+  // The shader UIDs are only regenerated when a register they are built from is written.
+  bool m_vertex_shader_uid_changed = true;
+  bool m_geometry_shader_uid_changed = true;
+  bool m_pixel_shader_uid_changed = true;
+  u32 m_current_components = 0;
   bool m_cull_all = false;
 
   IndexGenerator m_index_generator;
@@ -240,6 +265,25 @@ private:
   bool m_is_flushed = true;
   FlushStatistics m_flush_statistics = {};
 
+  // How the projection and viewport of the last flush were classified for the widescreen
+  // heuristic. They rarely change between flushes, so they are only classified again when they do.
+  enum class ProjectionAspect
+  {
+    Normal,
+    Anamorphic,
+    Other,
+  };
+  struct ProjectionAspectCache
+  {
+    bool valid = false;
+    std::array<float, 6> projection{};
+    float viewport_width = 0;
+    float viewport_height = 0;
+    float ratio = 0;
+    ProjectionAspect aspect = ProjectionAspect::Other;
+  };
+  ProjectionAspectCache m_projection_aspect_cache;
+
   // CPU access tracking
   u32 m_draw_counter = 0;
   u32 m_last_efb_copy_draw_counter = 0;
@@ -119,8 +119,12 @@ Common::Matrix44 VertexShaderManager::LoadProjectionMatrix()
 
   auto corrected_matrix = m_viewport_correction * Common::Matrix44::FromArray(m_projection_matrix);
 
+  // Games can change the projection many times per frame, but the camera only moves on input.
+  if (g_freelook_camera.GetController()->IsDirty())
+    m_freelook_view = g_freelook_camera.GetView();
+
   if (g_freelook_camera.IsActive() && xfmem.projection.type == ProjectionType::Perspective)
-    corrected_matrix *= g_freelook_camera.GetView();
+    corrected_matrix *= m_freelook_view;
 
   g_freelook_camera.GetController()->SetClean();
 
@@ -179,9 +183,12 @@ void VertexShaderManager::SetConstants(const std::vector<std::string>& textures,
   {
     int startn = per_vertex_transform_matrix_changes[0] / 4;
     int endn = (per_vertex_transform_matrix_changes[1] + 3) / 4;
-    memcpy(constants.transformmatrices[startn].data(), &xfmem.posMatrices[startn * 4],
-           (endn - startn) * sizeof(float4));
-    dirty = true;
+    // Compared row by row, as skinning usually only rewrites a few of the matrices
+    for (int i = startn; i < endn; i++)
+    {
+      UpdateBytes(&dirty, constants.transformmatrices[i].data(), &xfmem.posMatrices[i * 4],
+                  sizeof(float4));
+    }
     xf_state_manager.ResetPerVertexTransformMatrixChanges();
   }
 
@@ -192,10 +199,7 @@ void VertexShaderManager::SetConstants(const std::vector<std::string>& textures,
     int startn = per_vertex_normal_matrices_changed[0] / 3;
     int endn = (per_vertex_normal_matrices_changed[1] + 2) / 3;
     for (int i = startn; i < endn; i++)
-    {
-      memcpy(constants.normalmatrices[i].data(), &xfmem.normalMatrices[3 * i], 12);
-    }
-    dirty = true;
+      UpdateBytes(&dirty, constants.normalmatrices[i].data(), &xfmem.normalMatrices[3 * i], 12);
     xf_state_manager.ResetPerVertexNormalMatrixChanges();
   }
 
@@ -204,9 +208,8 @@ void VertexShaderManager::SetConstants(const std::vector<std::string>& textures,
   {
     int startn = post_transform_matrices_changed[0] / 4;
     int endn = (post_transform_matrices_changed[1] + 3) / 4;
-    memcpy(constants.posttransformmatrices[startn].data(), &xfmem.postMatrices[startn * 4],
-           (endn - startn) * sizeof(float4));
-    dirty = true;
+    UpdateBytes(&dirty, constants.posttransformmatrices[startn].data(),
+                &xfmem.postMatrices[startn * 4], (endn - startn) * sizeof(float4));
     xf_state_manager.ResetPostTransformMatrixChanges();
   }
 
@@ -221,7 +224,8 @@ void VertexShaderManager::SetConstants(const std::vector<std::string>& textures,
     for (int i = istart; i < iend; ++i)
     {
       const Light& light = xfmem.lights[i];
-      VertexShaderConstants::Light& dstlight = constants.lights[i];
+      // Built in a copy, so that lights which didn't actually change aren't uploaded again
+      VertexShaderConstants::Light dstlight = constants.lights[i];
 
       // xfmem.light.color is packed as abgr in u8[4], so we have to swap the order
       dstlight.color[0] = light.color[3];
@@ -266,8 +270,8 @@ void VertexShaderManager::SetConstants(const std::vector<std::string>& textures,
       dstlight.dir[0] = sanitize(static_cast<float>(light.ddir[0] * norm));
       dstlight.dir[1] = sanitize(static_cast<float>(light.ddir[1] * norm));
       dstlight.dir[2] = sanitize(static_cast<float>(light.ddir[2] * norm));
+      UpdateBytes(&dirty, &constants.lights[i], &dstlight, sizeof(dstlight));
     }
-    dirty = true;
 
     xf_state_manager.ResetLightsChanged();
   }
@@ -275,11 +279,10 @@ void VertexShaderManager::SetConstants(const std::vector<std::string>& textures,
   for (int i : xf_state_manager.GetMaterialChanges())
   {
     u32 data = i >= 2 ? xfmem.matColor[i - 2] : xfmem.ambColor[i];
-    constants.materials[i][0] = (data >> 24) & 0xFF;
-    constants.materials[i][1] = (data >> 16) & 0xFF;
-    constants.materials[i][2] = (data >> 8) & 0xFF;
-    constants.materials[i][3] = data & 0xFF;
-    dirty = true;
+    const int4 material = {static_cast<s32>((data >> 24) & 0xFF),
+                           static_cast<s32>((data >> 16) & 0xFF),
+                           static_cast<s32>((data >> 8) & 0xFF), static_cast<s32>(data & 0xFF)};
+    UpdateBytes(&dirty, constants.materials[i].data(), material.data(), sizeof(material));
   }
   xf_state_manager.ResetMaterialChanges();
 
@@ -290,11 +293,10 @@ void VertexShaderManager::SetConstants(const std::vector<std::string>& textures,
     const float* norm =
         &xfmem.normalMatrices[3 * (g_main_cp_state.matrix_index_a.PosNormalMtxIdx & 31)];
 
-    memcpy(constants.posnormalmatrix.data(), pos, 3 * sizeof(float4));
-    memcpy(constants.posnormalmatrix[3].data(), norm, 3 * sizeof(float));
-    memcpy(constants.posnormalmatrix[4].data(), norm + 3, 3 * sizeof(float));
-    memcpy(constants.posnormalmatrix[5].data(), norm + 6, 3 * sizeof(float));
-    dirty = true;
+    UpdateBytes(&dirty, constants.posnormalmatrix.data(), pos, 3 * sizeof(float4));
+    UpdateBytes(&dirty, constants.posnormalmatrix[3].data(), norm, 3 * sizeof(float));
+    UpdateBytes(&dirty, constants.posnormalmatrix[4].data(), norm + 3, 3 * sizeof(float));
+    UpdateBytes(&dirty, constants.posnormalmatrix[5].data(), norm + 6, 3 * sizeof(float));
   }
 
   if (xf_state_manager.DidTexMatrixAChange())
@@ -309,9 +311,9 @@ void VertexShaderManager::SetConstants(const std::vector<std::string>& textures,
 
     for (size_t i = 0; i < pos_matrix_ptrs.size(); ++i)
     {
-      memcpy(constants.texmatrices[3 * i].data(), pos_matrix_ptrs[i], 3 * sizeof(float4));
+      UpdateBytes(&dirty, constants.texmatrices[3 * i].data(), pos_matrix_ptrs[i],
+                  3 * sizeof(float4));
     }
-    dirty = true;
   }
 
   if (xf_state_manager.DidTexMatrixBChange())
@@ -326,9 +328,9 @@ void VertexShaderManager::SetConstants(const std::vector<std::string>& textures,
 
     for (size_t i = 0; i < pos_matrix_ptrs.size(); ++i)
     {
-      memcpy(constants.texmatrices[3 * i + 12].data(), pos_matrix_ptrs[i], 3 * sizeof(float4));
+      UpdateBytes(&dirty, constants.texmatrices[3 * i + 12].data(), pos_matrix_ptrs[i],
+                  3 * sizeof(float4));
     }
-    dirty = true;
   }
 
   if (xf_state_manager.DidViewportChange())
@@ -421,8 +423,8 @@ void VertexShaderManager::SetConstants(const std::vector<std::string>& textures,
       action->OnProjection(&projection);
     }
 
-    memcpy(constants.projection.data(), corrected_matrix.data.data(), 4 * sizeof(float4));
-    dirty = true;
+    UpdateBytes(&dirty, constants.projection.data(), corrected_matrix.data.data(),
+                4 * sizeof(float4));
   }
 
   if (xf_state_manager.DidTexMatrixInfoChange())
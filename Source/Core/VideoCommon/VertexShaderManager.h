@@ -4,6 +4,7 @@
 #pragma once
 
 #include <array>
+#include <cstring>
 #include <string>
 #include <vector>
 
@@ -47,6 +48,17 @@ public:
     *dirty = true;
   }
 
+  // Games often rewrite matrices and lights with the values they already have, which shouldn't
+  // cause the whole constant block to be uploaded again.
+  static DOLPHIN_FORCE_INLINE void UpdateBytes(bool* dirty, void* old_value, const void* new_value,
+                                               size_t size)
+  {
+    if (std::memcmp(old_value, new_value, size) == 0)
+      return;
+    std::memcpy(old_value, new_value, size);
+    *dirty = true;
+  }
+
   static DOLPHIN_FORCE_INLINE void UpdateOffset(bool* dirty, bool include_components,
                                                 u32* old_value, const AttributeFormat& attribute)
   {
@@ -86,5 +98,8 @@ private:
 
   Common::Matrix44 m_viewport_correction{};
 
+  // The free look view as of the last time the camera controller was dirty
+  Common::Matrix44 m_freelook_view = Common::Matrix44::Identity();
+
   Common::Matrix44 LoadProjectionMatrix();
 };
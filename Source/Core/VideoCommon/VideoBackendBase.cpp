@@ -6,6 +6,7 @@
 #include <algorithm>
 #include <cstring>
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -49,6 +50,7 @@
 #include "VideoCommon/Fifo.h"
 #include "VideoCommon/FrameDumper.h"
 #include "VideoCommon/FramebufferManager.h"
+#include "VideoCommon/GPUTiming.h"
 #include "VideoCommon/GeometryShaderManager.h"
 #include "VideoCommon/GraphicsModSystem/Runtime/GraphicsModManager.h"
 #include "VideoCommon/IndexGenerator.h"
@@ -138,6 +140,9 @@ u32 VideoBackendBase::Video_AccessEFB(EFBAccessType type, u32 x, u32 y, u32 data
   }
   else
   {
+    auto& system = Core::System::GetInstance();
+    system.GetFifo().SyncGPU(Fifo::SyncGPUReason::EFBPeek);
+
     AsyncRequests::Event e;
     u32 result;
     e.type = type == EFBAccessType::PeekColor ? AsyncRequests::Event::EFB_PEEK_COLOR :
@@ -158,6 +163,11 @@ u32 VideoBackendBase::Video_GetQueryResult(PerfQueryType type)
     return 0;
   }
 
+  // With a readback lag, the results of the previous set of queries are good enough and avoid
+  // waiting for the GPU thread and the host GPU.
+  if (const std::optional<u32> result = g_perf_query->GetPublishedResult(type))
+    return *result;
+
   auto& system = Core::System::GetInstance();
   system.GetFifo().SyncGPU(Fifo::SyncGPUReason::PerfQuery);
 
@@ -364,6 +374,7 @@ bool VideoBackendBase::InitializeShared(std::unique_ptr<AbstractGfx> gfx,
   g_shader_cache = std::make_unique<VideoCommon::ShaderCache>();
   g_graphics_mod_manager = std::make_unique<GraphicsModManager>();
   g_widescreen = std::make_unique<WidescreenManager>();
+  g_gpu_timing = std::make_unique<GPUTiming>();
 
   if (!g_vertex_manager->Initialize() || !g_shader_cache->Initialize() ||
       !g_perf_query->Initialize() || !g_presenter->Initialize() ||
@@ -392,6 +403,7 @@ bool VideoBackendBase::InitializeShared(std::unique_ptr<AbstractGfx> gfx,
   g_Config.VerifyValidity();
   UpdateActiveConfig();
 
+  VertexLoaderManager::LoadVertexLoaderCache();
   g_shader_cache->InitializeShaderCache();
 
   return true;
@@ -417,6 +429,7 @@ void VideoBackendBase::ShutdownShared()
   g_renderer.reset();
   g_widescreen.reset();
   g_presenter.reset();
+  g_gpu_timing.reset();
   g_gfx.reset();
 
   m_initialized = false;
@@ -81,6 +81,7 @@ void VideoConfig::Refresh()
 
   bVSync = Config::Get(Config::GFX_VSYNC);
   iAdapter = Config::Get(Config::GFX_ADAPTER);
+  bLowLatencyPresent = Config::Get(Config::GFX_LOW_LATENCY_PRESENT);
   iManuallyUploadBuffers = Config::Get(Config::GFX_MTL_MANUALLY_UPLOAD_BUFFERS);
   iUsePresentDrawable = Config::Get(Config::GFX_MTL_USE_PRESENT_DRAWABLE);
 
@@ -99,13 +100,17 @@ void VideoConfig::Refresh()
       Config::Get(Config::GFX_WIDESCREEN_HEURISTIC_WIDESCREEN_RATIO);
   bCrop = Config::Get(Config::GFX_CROP);
   iSafeTextureCache_ColorSamples = Config::Get(Config::GFX_SAFE_TEXTURE_CACHE_COLOR_SAMPLES);
+  texture_hash_algorithm = Config::Get(Config::GFX_TEXTURE_HASH_ALGORITHM);
   bShowFPS = Config::Get(Config::GFX_SHOW_FPS);
   bShowFTimes = Config::Get(Config::GFX_SHOW_FTIMES);
   bShowVPS = Config::Get(Config::GFX_SHOW_VPS);
   bShowVTimes = Config::Get(Config::GFX_SHOW_VTIMES);
   bShowGraphs = Config::Get(Config::GFX_SHOW_GRAPHS);
+  bShowGPUPassTimes = Config::Get(Config::GFX_SHOW_GPU_PASS_TIMES);
+  bShowMemoryUsage = Config::Get(Config::GFX_SHOW_MEMORY_USAGE);
   bShowSpeed = Config::Get(Config::GFX_SHOW_SPEED);
   bShowSpeedColors = Config::Get(Config::GFX_SHOW_SPEED_COLORS);
+  bShowAudioLatency = Config::Get(Config::GFX_SHOW_AUDIO_LATENCY);
   iPerfSampleUSec = Config::Get(Config::GFX_PERF_SAMP_WINDOW) * 1000;
   bShowNetPlayPing = Config::Get(Config::GFX_SHOW_NETPLAY_PING);
   bShowNetPlayMessages = Config::Get(Config::GFX_SHOW_NETPLAY_MESSAGES);
@@ -118,6 +123,7 @@ void VideoConfig::Refresh()
   bDumpBaseTextures = Config::Get(Config::GFX_DUMP_BASE_TEXTURES);
   bHiresTextures = Config::Get(Config::GFX_HIRES_TEXTURES);
   bCacheHiresTextures = Config::Get(Config::GFX_CACHE_HIRES_TEXTURES);
+  iTexturePoolMemoryLimit = Config::Get(Config::GFX_TEXTURE_POOL_MEMORY_LIMIT);
   bDumpEFBTarget = Config::Get(Config::GFX_DUMP_EFB_TARGET);
   bDumpXFBTarget = Config::Get(Config::GFX_DUMP_XFB_TARGET);
   bDumpFramesAsImages = Config::Get(Config::GFX_DUMP_FRAMES_AS_IMAGES);
@@ -130,6 +136,7 @@ void VideoConfig::Refresh()
   iBitrateKbps = Config::Get(Config::GFX_BITRATE_KBPS);
   frame_dumps_resolution_type = Config::Get(Config::GFX_FRAME_DUMPS_RESOLUTION_TYPE);
   bEnableGPUTextureDecoding = Config::Get(Config::GFX_ENABLE_GPU_TEXTURE_DECODING);
+  iGPUTextureDecodingMinTexels = Config::Get(Config::GFX_GPU_TEXTURE_DECODING_MIN_TEXELS);
   bPreferVSForLinePointExpansion = Config::Get(Config::GFX_PREFER_VS_FOR_LINE_POINT_EXPANSION);
   bEnablePixelLighting = Config::Get(Config::GFX_ENABLE_PIXEL_LIGHTING);
   bFastDepthCalc = Config::Get(Config::GFX_FAST_DEPTH_CALC);
@@ -143,13 +150,18 @@ void VideoConfig::Refresh()
   bBorderlessFullscreen = Config::Get(Config::GFX_BORDERLESS_FULLSCREEN);
   bEnableValidationLayer = Config::Get(Config::GFX_ENABLE_VALIDATION_LAYER);
   bBackendMultithreading = Config::Get(Config::GFX_BACKEND_MULTITHREADING);
+  bParallelCommandRecording = Config::Get(Config::GFX_PARALLEL_COMMAND_RECORDING);
   iCommandBufferExecuteInterval = Config::Get(Config::GFX_COMMAND_BUFFER_EXECUTE_INTERVAL);
   bShaderCache = Config::Get(Config::GFX_SHADER_CACHE);
   bWaitForShadersBeforeStarting = Config::Get(Config::GFX_WAIT_FOR_SHADERS_BEFORE_STARTING);
+  bExportPipelineManifest = Config::Get(Config::GFX_EXPORT_PIPELINE_MANIFEST);
   iShaderCompilationMode = Config::Get(Config::GFX_SHADER_COMPILATION_MODE);
+  iHybridUberShaderSpecializationFrames =
+      std::max(Config::Get(Config::GFX_HYBRID_UBERSHADER_SPECIALIZATION_FRAMES), 0);
   iShaderCompilerThreads = Config::Get(Config::GFX_SHADER_COMPILER_THREADS);
   iShaderPrecompilerThreads = Config::Get(Config::GFX_SHADER_PRECOMPILER_THREADS);
   bCPUCull = Config::Get(Config::GFX_CPU_CULL);
+  bCPUCullTriangles = Config::Get(Config::GFX_CPU_CULL_TRIANGLES);
 
   texture_filtering_mode = Config::Get(Config::GFX_ENHANCE_FORCE_TEXTURE_FILTERING);
   iMaxAnisotropy = Config::Get(Config::GFX_ENHANCE_MAX_ANISOTROPY);
@@ -186,6 +198,8 @@ void VideoConfig::Refresh()
   bSkipXFBCopyToRam = Config::Get(Config::GFX_HACK_SKIP_XFB_COPY_TO_RAM);
   bDisableCopyToVRAM = Config::Get(Config::GFX_HACK_DISABLE_COPY_TO_VRAM);
   bDeferEFBCopies = Config::Get(Config::GFX_HACK_DEFER_EFB_COPIES);
+  iEFBCopyReadbackLag = std::max(Config::Get(Config::GFX_HACK_EFB_COPY_READBACK_LAG), 0);
+  iPerfQueryReadbackLag = std::max(Config::Get(Config::GFX_HACK_PERF_QUERY_READBACK_LAG), 0);
   bImmediateXFB = Config::Get(Config::GFX_HACK_IMMEDIATE_XFB);
   bVISkip = Config::Get(Config::GFX_HACK_VI_SKIP);
   bSkipPresentingDuplicateXFBs = bVISkip || Config::Get(Config::GFX_HACK_SKIP_DUPLICATE_XFBS);
@@ -276,6 +290,22 @@ u32 VideoConfig::GetShaderPrecompilerThreads() const
     return 1;
 }
 
+u32 VideoConfig::GetMaxShaderCompilerThreads() const
+{
+  // Extra threads are only used while a backlog exists, so we can allow as many as precompiling.
+  const u32 compiler_threads = GetShaderCompilerThreads();
+  if (compiler_threads == 0 ||
+      DriverDetails::HasBug(DriverDetails::BUG_BROKEN_MULTITHREADED_SHADER_PRECOMPILATION))
+  {
+    return compiler_threads;
+  }
+
+  const u32 precompiler_threads = iShaderPrecompilerThreads >= 0 ?
+                                      static_cast<u32>(iShaderPrecompilerThreads) :
+                                      GetNumAutoShaderPreCompilerThreads();
+  return std::max(compiler_threads, precompiler_threads);
+}
+
 void CheckForConfigChanges()
 {
   const ShaderHostConfig old_shader_host_config = ShaderHostConfig::GetCurrent();
@@ -14,6 +14,7 @@
 #include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Common/Hash.h"
 #include "VideoCommon/GraphicsModSystem/Config/GraphicsModGroup.h"
 #include "VideoCommon/VideoCommon.h"
 
@@ -116,6 +117,7 @@ struct VideoConfig final
   // General
   bool bVSync = false;
   bool bVSyncActive = false;
+  bool bLowLatencyPresent = false;
   bool bWidescreenHack = false;
   AspectMode aspect_mode{};
   int custom_aspect_width = 1;
@@ -168,8 +170,11 @@ struct VideoConfig final
   bool bShowVPS = false;
   bool bShowVTimes = false;
   bool bShowGraphs = false;
+  bool bShowGPUPassTimes = false;
+  bool bShowMemoryUsage = false;
   bool bShowSpeed = false;
   bool bShowSpeedColors = false;
+  bool bShowAudioLatency = false;
   int iPerfSampleUSec = 0;
   bool bShowNetPlayPing = false;
   bool bShowNetPlayMessages = false;
@@ -190,6 +195,7 @@ struct VideoConfig final
   bool bDumpBaseTextures = false;
   bool bHiresTextures = false;
   bool bCacheHiresTextures = false;
+  int iTexturePoolMemoryLimit = 0;
   bool bDumpEFBTarget = false;
   bool bDumpXFBTarget = false;
   bool bDumpFramesAsImages = false;
@@ -203,6 +209,9 @@ struct VideoConfig final
       FrameDumpResolutionType::XFBAspectRatioCorrectedResolution;
   bool bBorderlessFullscreen = false;
   bool bEnableGPUTextureDecoding = false;
+  // Textures with at least this many texels are decoded on the GPU even when
+  // bEnableGPUTextureDecoding is off. Zero disables the threshold.
+  u32 iGPUTextureDecodingMinTexels = 0;
   bool bPreferVSForLinePointExpansion = false;
   int iBitrateKbps = 0;
   bool bGraphicMods = false;
@@ -215,16 +224,21 @@ struct VideoConfig final
   bool bBBoxEnable = false;
   bool bForceProgressive = false;
   bool bCPUCull = false;
+  // Drop individual culled triangles from the index buffer, not just fully culled draws.
+  bool bCPUCullTriangles = false;
 
   bool bEFBEmulateFormatChanges = false;
   bool bSkipEFBCopyToRam = false;
   bool bSkipXFBCopyToRam = false;
   bool bDisableCopyToVRAM = false;
   bool bDeferEFBCopies = false;
+  int iEFBCopyReadbackLag = 0;
+  int iPerfQueryReadbackLag = 0;
   bool bImmediateXFB = false;
   bool bSkipPresentingDuplicateXFBs = false;
   bool bCopyEFBScaled = false;
   int iSafeTextureCache_ColorSamples = 0;
+  Common::TextureHashAlgorithm texture_hash_algorithm{};
   float fAspectRatioHackW = 1;  // Initial value needed for the first frame
   float fAspectRatioHackH = 1;
   bool bEnablePixelLighting = false;
@@ -261,13 +275,23 @@ struct VideoConfig final
   // Multithreaded submission, currently only supported with Vulkan.
   bool bBackendMultithreading = true;
 
+  // Record draws into secondary command buffers on worker threads, currently only supported with
+  // Vulkan.
+  bool bParallelCommandRecording = false;
+
   // Early command buffer execution interval in number of draws.
   // Currently only supported with Vulkan.
   int iCommandBufferExecuteInterval = 0;
 
   // Shader compilation settings.
   bool bWaitForShadersBeforeStarting = false;
+  // Write the UIDs of every known pipeline and their usage statistics to Dump/PipelineManifests/
+  // on shutdown.
+  bool bExportPipelineManifest = false;
   ShaderCompilationMode iShaderCompilationMode{};
+  // With hybrid ubershaders, only compile a specialized pipeline once it has been drawn with in
+  // this many frames, so short-lived pipelines stay on the ubershaders. 0 compiles on first use.
+  int iHybridUberShaderSpecializationFrames = 0;
 
   // Number of shader compiler threads.
   // 0 disables background compilation.
@@ -357,6 +381,12 @@ struct VideoConfig final
   {
     return backend_info.bSupportsGPUTextureDecoding && bEnableGPUTextureDecoding;
   }
+  bool UseGPUTextureDecoding(u32 width, u32 height) const
+  {
+    return UseGPUTextureDecoding() ||
+           (backend_info.bSupportsGPUTextureDecoding && iGPUTextureDecodingMinTexels != 0 &&
+            width * height >= iGPUTextureDecodingMinTexels);
+  }
   bool UseVertexRounding() const { return bVertexRounding && iEFBScale != 1; }
   bool ManualTextureSamplingWithCustomTextureSizes() const
   {
@@ -381,6 +411,8 @@ struct VideoConfig final
   bool UsingUberShaders() const;
   u32 GetShaderCompilerThreads() const;
   u32 GetShaderPrecompilerThreads() const;
+  // Upper bound for the compiler threads while the compile queue is backed up.
+  u32 GetMaxShaderCompilerThreads() const;
 
   float GetCustomAspectRatio() const { return (float)custom_aspect_width / custom_aspect_height; }
 };
@@ -17,11 +17,18 @@
 #include "VideoCommon/Fifo.h"
 #include "VideoCommon/GeometryShaderManager.h"
 #include "VideoCommon/PixelShaderManager.h"
+#include "VideoCommon/Statistics.h"
 #include "VideoCommon/VertexLoaderManager.h"
 #include "VideoCommon/VertexManagerBase.h"
 #include "VideoCommon/XFMemory.h"
 #include "VideoCommon/XFStateManager.h"
 
+static void SkipFlush()
+{
+  if (g_vertex_manager->HasSendableVertices())
+    INCSTAT(g_stats.this_frame.num_flushes_avoided);
+}
+
 static void XFMemWritten(XFStateManager& xf_state_manager, u32 transferSize, u32 baseAddress)
 {
   g_vertex_manager->Flush();
@@ -33,6 +40,16 @@ static void XFRegWritten(Core::System& system, XFStateManager& xf_state_manager,
 {
   if (address >= XFMEM_REGISTERS_START && address < XFMEM_REGISTERS_END)
   {
+    // The viewport and projection only feed shader constants, everything else may be part of the
+    // vertex, geometry or pixel shader UIDs.
+    const bool viewport_or_projection =
+        address >= XFMEM_SETVIEWPORT && address < XFMEM_SETPROJECTION + 7;
+    if (!viewport_or_projection && ((u32*)&xfmem)[address] != value)
+    {
+      g_vertex_manager->SetVertexShaderUidChanged();
+      g_vertex_manager->SetPixelShaderUidChanged();
+    }
+
     switch (address)
     {
     case XFMEM_ERROR:
@@ -120,6 +137,11 @@ static void XFRegWritten(Core::System& system, XFStateManager& xf_state_manager,
     case XFMEM_SETVIEWPORT + 3:
     case XFMEM_SETVIEWPORT + 4:
     case XFMEM_SETVIEWPORT + 5:
+      if (((u32*)&xfmem)[address] == value)
+      {
+        SkipFlush();
+        break;
+      }
       g_vertex_manager->Flush();
       xf_state_manager.SetViewportChanged();
       system.GetPixelShaderManager().SetViewportChanged();
@@ -133,6 +155,11 @@ static void XFRegWritten(Core::System& system, XFStateManager& xf_state_manager,
     case XFMEM_SETPROJECTION + 4:
     case XFMEM_SETPROJECTION + 5:
     case XFMEM_SETPROJECTION + 6:
+      if (((u32*)&xfmem)[address] == value)
+      {
+        SkipFlush();
+        break;
+      }
       g_vertex_manager->Flush();
       xf_state_manager.SetProjectionChanged();
       system.GetGeometryShaderManager().SetProjectionChanged();
@@ -151,6 +178,11 @@ static void XFRegWritten(Core::System& system, XFStateManager& xf_state_manager,
     case XFMEM_SETTEXMTXINFO + 5:
     case XFMEM_SETTEXMTXINFO + 6:
     case XFMEM_SETTEXMTXINFO + 7:
+      if (((u32*)&xfmem)[address] == value)
+      {
+        SkipFlush();
+        break;
+      }
       g_vertex_manager->Flush();
       xf_state_manager.SetTexMatrixInfoChanged(address - XFMEM_SETTEXMTXINFO);
       break;
@@ -163,6 +195,11 @@ static void XFRegWritten(Core::System& system, XFStateManager& xf_state_manager,
     case XFMEM_SETPOSTMTXINFO + 5:
     case XFMEM_SETPOSTMTXINFO + 6:
     case XFMEM_SETPOSTMTXINFO + 7:
+      if (((u32*)&xfmem)[address] == value)
+      {
+        SkipFlush();
+        break;
+      }
       g_vertex_manager->Flush();
       xf_state_manager.SetTexMatrixInfoChanged(address - XFMEM_SETPOSTMTXINFO);
       break;
@@ -232,12 +269,26 @@ void LoadXFReg(u16 base_address, u8 transfer_size, const u8* data)
       base_address = XFMEM_REGISTERS_START;
     }
 
-    XFMemWritten(xf_state_manager, xf_mem_transfer_size, xf_mem_base);
-    for (u32 i = 0; i < xf_mem_transfer_size; i++)
+    // Matrix and light uploads are frequently repeated verbatim, skip the flush for those.
+    u32* xf_mem_data = reinterpret_cast<u32*>(&xfmem) + xf_mem_base;
+    u32 first_changed = 0;
+    while (first_changed < xf_mem_transfer_size &&
+           xf_mem_data[first_changed] == Common::swap32(data + first_changed * 4))
     {
-      ((u32*)&xfmem)[xf_mem_base + i] = Common::swap32(data);
-      data += 4;
+      first_changed++;
+    }
+
+    if (first_changed == xf_mem_transfer_size)
+    {
+      SkipFlush();
+    }
+    else
+    {
+      XFMemWritten(xf_state_manager, xf_mem_transfer_size, xf_mem_base);
+      for (u32 i = first_changed; i < xf_mem_transfer_size; i++)
+        xf_mem_data[i] = Common::swap32(data + i * 4);
     }
+    data += xf_mem_transfer_size * 4;
   }
 
   // write to XF regs
@@ -262,17 +313,17 @@ void LoadIndexedXF(CPArray array, u32 index, u16 address, u8 size)
 
   const u32 buf_size = size * sizeof(u32);
   u32* currData = reinterpret_cast<u32*>(&xfmem) + address;
-  u32* newData;
+  const u32* newData;
   auto& system = Core::System::GetInstance();
   auto& fifo = system.GetFifo();
   if (fifo.UseDeterministicGPUThread())
   {
-    newData = reinterpret_cast<u32*>(fifo.PopFifoAuxBuffer(buf_size));
+    newData = reinterpret_cast<const u32*>(fifo.PopFifoAuxBuffer(buf_size));
   }
   else
   {
     auto& memory = system.GetMemory();
-    newData = reinterpret_cast<u32*>(memory.GetPointerForRange(
+    newData = reinterpret_cast<const u32*>(memory.GetReadOnlyPointerForRange(
         g_main_cp_state.array_bases[array] + g_main_cp_state.array_strides[array] * index,
         buf_size));
   }
@@ -292,6 +343,16 @@ void LoadIndexedXF(CPArray array, u32 index, u16 address, u8 size)
   {
     for (u32 i = 0; i < size; ++i)
       currData[i] = Common::swap32(newData[i]);
+
+    if (address + size > XFMEM_REGISTERS_START)
+    {
+      g_vertex_manager->SetVertexShaderUidChanged();
+      g_vertex_manager->SetPixelShaderUidChanged();
+    }
+  }
+  else
+  {
+    SkipFlush();
   }
 }
 
@@ -301,7 +362,7 @@ void PreprocessIndexedXF(CPArray array, u32 index, u16 address, u8 size)
 
   auto& system = Core::System::GetInstance();
   auto& memory = system.GetMemory();
-  const u8* new_data = memory.GetPointerForRange(
+  const u8* new_data = memory.GetReadOnlyPointerForRange(
       g_preprocess_cp_state.array_bases[array] + g_preprocess_cp_state.array_strides[array] * index,
       buf_size);
 
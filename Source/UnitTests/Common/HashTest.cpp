@@ -0,0 +1,63 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <numeric>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/Hash.h"
+
+using Common::TextureHashAlgorithm;
+
+namespace
+{
+class TextureHashTest : public testing::TestWithParam<TextureHashAlgorithm>
+{
+protected:
+  void SetUp() override
+  {
+    Common::SetTextureHashAlgorithm(GetParam());
+    std::iota(m_data.begin(), m_data.end(), u8(0));
+  }
+  void TearDown() override { Common::SetTextureHashAlgorithm(TextureHashAlgorithm::XXH3); }
+
+  std::array<u8, 4099> m_data{};
+};
+}  // namespace
+
+TEST_P(TextureHashTest, Deterministic)
+{
+  const u32 size = static_cast<u32>(m_data.size());
+  EXPECT_EQ(Common::GetHash64(m_data.data(), size, 0), Common::GetHash64(m_data.data(), size, 0));
+  EXPECT_EQ(Common::GetHash64(m_data.data(), size, 16),
+            Common::GetHash64(m_data.data(), size, 16));
+}
+
+TEST_P(TextureHashTest, FullHashSeesEveryWord)
+{
+  const u32 size = static_cast<u32>(m_data.size());
+  const u64 hash = Common::GetHash64(m_data.data(), size, 0);
+
+  m_data[1000] ^= 1;
+  EXPECT_NE(hash, Common::GetHash64(m_data.data(), size, 0));
+}
+
+TEST_P(TextureHashTest, SparseHashSeesSampledWords)
+{
+  // With 16 samples of 512 words, every 32nd word starting at the first one is hashed.
+  const u32 size = static_cast<u32>(m_data.size());
+  const u64 hash = Common::GetHash64(m_data.data(), size, 16);
+
+  m_data[32 * 8 * 3] ^= 1;
+  EXPECT_NE(hash, Common::GetHash64(m_data.data(), size, 16));
+}
+
+TEST_P(TextureHashTest, SizeIsPartOfHash)
+{
+  EXPECT_NE(Common::GetHash64(m_data.data(), 64, 0), Common::GetHash64(m_data.data(), 65, 0));
+}
+
+INSTANTIATE_TEST_SUITE_P(Hash, TextureHashTest,
+                         testing::Values(TextureHashAlgorithm::Legacy, TextureHashAlgorithm::XXH3));
@@ -0,0 +1,197 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/LockFreeRing.h"
+
+namespace
+{
+constexpr u32 THROUGHPUT_ITEMS = 1 << 20;
+constexpr size_t BATCH_SIZE = 32;
+
+void PrintThroughput(const char* name, u32 items, std::chrono::steady_clock::time_point start)
+{
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  fmt::print("{}: {:.1f} M items/s\n", name, items / elapsed.count() / 1e6);
+}
+}  // namespace
+
+TEST(SPSCRing, Simple)
+{
+  Common::SPSCRing<u32, 4> ring;
+  EXPECT_TRUE(ring.Empty());
+
+  u32 v;
+  EXPECT_FALSE(ring.Pop(v));
+
+  for (u32 i = 0; i < 4; ++i)
+    EXPECT_TRUE(ring.Push(i));
+  EXPECT_FALSE(ring.Push(4u));
+  EXPECT_EQ(4u, ring.Size());
+
+  for (u32 i = 0; i < 4; ++i)
+  {
+    EXPECT_TRUE(ring.Pop(v));
+    EXPECT_EQ(i, v);
+  }
+  EXPECT_TRUE(ring.Empty());
+
+  ring.Push(5u);
+  ring.Clear();
+  EXPECT_TRUE(ring.Empty());
+}
+
+TEST(SPSCRing, Batch)
+{
+  Common::SPSCRing<std::string, 8> ring;
+  const std::array<std::string, 6> in{"a", "b", "c", "d", "e", "f"};
+  std::array<std::string, 8> out;
+
+  EXPECT_EQ(6u, ring.PushBatch(in.data(), in.size()));
+  EXPECT_EQ(4u, ring.PopBatch(out.data(), 4));
+  EXPECT_EQ("d", out[3]);
+
+  // Wraps around the end of the buffer and stops when it's full.
+  EXPECT_EQ(6u, ring.PushBatch(in.data(), in.size()));
+  EXPECT_EQ(0u, ring.PushBatch(in.data(), in.size()));
+  EXPECT_EQ(8u, ring.PopBatch(out.data(), out.size()));
+  EXPECT_EQ("e", out[0]);
+  EXPECT_EQ("f", out[1]);
+  EXPECT_EQ("a", out[2]);
+  EXPECT_EQ("f", out[7]);
+  EXPECT_EQ(0u, ring.PopBatch(out.data(), out.size()));
+}
+
+TEST(SPSCRing, MultiThreaded)
+{
+  Common::SPSCRing<u32, 64> ring;
+
+  std::thread producer([&ring] {
+    u32 batch[BATCH_SIZE];
+    for (u32 i = 0; i < THROUGHPUT_ITEMS;)
+    {
+      const size_t count = std::min<size_t>(BATCH_SIZE, THROUGHPUT_ITEMS - i);
+      for (size_t j = 0; j < count; ++j)
+        batch[j] = i + static_cast<u32>(j);
+      const size_t pushed = ring.PushBatch(batch, count);
+      if (pushed == 0)
+        std::this_thread::yield();
+      i += static_cast<u32>(pushed);
+    }
+  });
+
+  const auto start = std::chrono::steady_clock::now();
+  u32 batch[BATCH_SIZE];
+  for (u32 expected = 0; expected < THROUGHPUT_ITEMS;)
+  {
+    const size_t count = ring.PopBatch(batch, BATCH_SIZE);
+    if (count == 0)
+      std::this_thread::yield();
+    for (size_t j = 0; j < count; ++j)
+      ASSERT_EQ(expected++, batch[j]);
+  }
+  PrintThroughput("SPSCRing", THROUGHPUT_ITEMS, start);
+
+  producer.join();
+  EXPECT_TRUE(ring.Empty());
+}
+
+TEST(MPSCRing, Simple)
+{
+  Common::MPSCRing<u32, 4> ring;
+  EXPECT_TRUE(ring.Empty());
+
+  u32 v;
+  EXPECT_FALSE(ring.Pop(v));
+
+  for (u32 i = 0; i < 4; ++i)
+    EXPECT_TRUE(ring.Push(i));
+  EXPECT_FALSE(ring.Push(4u));
+
+  const std::array<u32, 3> in{10, 11, 12};
+  EXPECT_EQ(0u, ring.PushBatch(in.data(), in.size()));
+
+  for (u32 i = 0; i < 2; ++i)
+  {
+    EXPECT_TRUE(ring.Pop(v));
+    EXPECT_EQ(i, v);
+  }
+
+  // Only part of the batch fits.
+  EXPECT_EQ(2u, ring.PushBatch(in.data(), in.size()));
+
+  std::array<u32, 8> out;
+  EXPECT_EQ(4u, ring.PopBatch(out.data(), out.size()));
+  EXPECT_EQ(2u, out[0]);
+  EXPECT_EQ(3u, out[1]);
+  EXPECT_EQ(10u, out[2]);
+  EXPECT_EQ(11u, out[3]);
+  EXPECT_TRUE(ring.Empty());
+}
+
+TEST(MPSCRing, MultiThreaded)
+{
+  constexpr u32 PRODUCERS = 4;
+  constexpr u32 ITEMS_PER_PRODUCER = THROUGHPUT_ITEMS / PRODUCERS;
+
+  Common::MPSCRing<u32, 256> ring;
+
+  // Each producer pushes increasing numbers tagged with its index, so the consumer can check that
+  // nothing is lost, duplicated or reordered within a producer.
+  std::vector<std::thread> producers;
+  for (u32 p = 0; p < PRODUCERS; ++p)
+  {
+    producers.emplace_back([&ring, p] {
+      u32 batch[BATCH_SIZE];
+      bool single = true;
+      for (u32 i = 0; i < ITEMS_PER_PRODUCER; single = !single)
+      {
+        // Alternate between single and batch pushes.
+        if (single)
+        {
+          if (ring.Push(i << 2 | p))
+            ++i;
+          else
+            std::this_thread::yield();
+          continue;
+        }
+
+        const size_t count = std::min<size_t>(BATCH_SIZE, ITEMS_PER_PRODUCER - i);
+        for (size_t j = 0; j < count; ++j)
+          batch[j] = (i + static_cast<u32>(j)) << 2 | p;
+        const size_t pushed = ring.PushBatch(batch, count);
+        if (pushed == 0)
+          std::this_thread::yield();
+        i += static_cast<u32>(pushed);
+      }
+    });
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+  std::array<u32, PRODUCERS> expected{};
+  u32 batch[BATCH_SIZE];
+  for (u32 received = 0; received < ITEMS_PER_PRODUCER * PRODUCERS;)
+  {
+    const size_t count = ring.PopBatch(batch, BATCH_SIZE);
+    if (count == 0)
+      std::this_thread::yield();
+    for (size_t j = 0; j < count; ++j)
+      ASSERT_EQ(expected[batch[j] & 3]++, batch[j] >> 2);
+    received += static_cast<u32>(count);
+  }
+  PrintThroughput("MPSCRing", ITEMS_PER_PRODUCER * PRODUCERS, start);
+
+  for (std::thread& producer : producers)
+    producer.join();
+  EXPECT_TRUE(ring.Empty());
+}
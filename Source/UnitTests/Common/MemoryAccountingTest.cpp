@@ -0,0 +1,41 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <gtest/gtest.h>
+
+#include "Common/MemoryAccounting.h"
+
+using namespace Common::MemoryAccounting;
+
+TEST(MemoryAccounting, TracksCurrentAndPeak)
+{
+  Set(Subsystem::DiscCache, 0);
+  ResetPeaks();
+
+  Add(Subsystem::DiscCache, 300);
+  Add(Subsystem::DiscCache, 200);
+  Remove(Subsystem::DiscCache, 400);
+
+  Usage usage = GetUsage(Subsystem::DiscCache);
+  EXPECT_EQ(usage.current, 100u);
+  EXPECT_EQ(usage.peak, 500u);
+
+  Set(Subsystem::DiscCache, 50);
+  usage = GetUsage(Subsystem::DiscCache);
+  EXPECT_EQ(usage.current, 50u);
+  EXPECT_EQ(usage.peak, 500u);
+
+  ResetPeaks();
+  EXPECT_EQ(GetUsage(Subsystem::DiscCache).peak, 50u);
+
+  Set(Subsystem::DiscCache, 0);
+}
+
+TEST(MemoryAccounting, Budget)
+{
+  SetBudget(Subsystem::Rewind, 64 * 1024 * 1024);
+  EXPECT_EQ(GetUsage(Subsystem::Rewind).budget, 64u * 1024 * 1024);
+
+  SetBudget(Subsystem::Rewind, 0);
+  EXPECT_EQ(GetUsage(Subsystem::Rewind).budget, 0u);
+}
@@ -3,9 +3,12 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <array>
 #include <bitset>
 #include <string>
+#include <tuple>
+#include <vector>
 
 #include "Common/Config/Config.h"
 #include "Common/FileUtil.h"
@@ -401,3 +404,33 @@ TEST(CoreTiming, Overclocking)
   Config::SetCurrent(Config::MAIN_OVERCLOCK, 1.0f);
   AdvanceAndCheck(system, 4, MAX_SLICE_LENGTH);
 }
+
+TEST(CoreTiming, EventQueueOrder)
+{
+  CoreTiming::EventQueue queue;
+  std::vector<CoreTiming::Event> expected;
+
+  // Spread the events over both the timing wheel and the far-future heap, with some sharing a time.
+  u64 seed = 12345;
+  for (u64 i = 0; i < 500; ++i)
+  {
+    seed = seed * 6364136223846793005 + 1442695040888963407;
+    const s64 time = static_cast<s64>((seed >> 33) % 2000000) & ~s64(0xFF);
+    const CoreTiming::Event ev{time, i, i, nullptr};
+    queue.Insert(ev);
+    expected.push_back(ev);
+  }
+  std::sort(expected.begin(), expected.end(), [](const auto& a, const auto& b) {
+    return std::tie(a.time, a.fifo_order) < std::tie(b.time, b.fifo_order);
+  });
+
+  for (const CoreTiming::Event& ev : expected)
+  {
+    ASSERT_FALSE(queue.Empty());
+    const CoreTiming::Event popped = queue.PopFront();
+    EXPECT_EQ(ev.time, popped.time);
+    EXPECT_EQ(ev.fifo_order, popped.fifo_order);
+    queue.AdvanceTo(popped.time);
+  }
+  EXPECT_TRUE(queue.Empty());
+}
@@ -6,6 +6,7 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -272,6 +273,63 @@ TEST_F(FileSystemTest, GetDirectoryStats)
   check_stats(1u, 2u);
 }
 
+// Directory listings and stats are cached, so they must be kept in sync with changes to the tree.
+TEST_F(FileSystemTest, DirectoryCacheInvalidation)
+{
+  auto check_listing = [this](const std::string& path, std::vector<std::string> expected) {
+    Result<std::vector<std::string>> children = m_fs->ReadDirectory(Uid{0}, Gid{0}, path);
+    ASSERT_TRUE(children.Succeeded());
+    std::sort(children->begin(), children->end());
+    EXPECT_EQ(*children, expected);
+  };
+
+  ASSERT_EQ(m_fs->CreateDirectory(Uid{0}, Gid{0}, "/tmp/d", 0, modes), ResultCode::Success);
+  check_listing("/tmp", {"d"});
+  check_listing("/tmp/d", {});
+  EXPECT_EQ(m_fs->GetDirectoryStats("/tmp")->used_inodes, 2u);
+
+  ASSERT_EQ(m_fs->CreateFile(Uid{0}, Gid{0}, "/tmp/d/f", 0, modes), ResultCode::Success);
+  check_listing("/tmp/d", {"f"});
+  EXPECT_EQ(m_fs->GetDirectoryStats("/tmp")->used_inodes, 3u);
+
+  ASSERT_EQ(m_fs->Rename(Uid{0}, Gid{0}, "/tmp/d/f", "/tmp/f"), ResultCode::Success);
+  check_listing("/tmp", {"d", "f"});
+  check_listing("/tmp/d", {});
+
+  ASSERT_EQ(m_fs->Delete(Uid{0}, Gid{0}, "/tmp/d"), ResultCode::Success);
+  check_listing("/tmp", {"f"});
+  EXPECT_EQ(m_fs->ReadDirectory(Uid{0}, Gid{0}, "/tmp/d").Error(), ResultCode::NotFound);
+  EXPECT_EQ(m_fs->GetDirectoryStats("/tmp")->used_inodes, 2u);
+}
+
+TEST_F(FileSystemTest, ModificationCount)
+{
+  u64 count = m_fs->GetModificationCount();
+  const auto expect_changed = [&](bool changed) {
+    const u64 new_count = m_fs->GetModificationCount();
+    EXPECT_EQ(new_count != count, changed);
+    count = new_count;
+  };
+
+  ASSERT_EQ(m_fs->CreateFile(Uid{0}, Gid{0}, "/tmp/f", 0, modes), ResultCode::Success);
+  expect_changed(true);
+  {
+    const Result<FileHandle> file = m_fs->OpenFile(Uid{0}, Gid{0}, "/tmp/f", Mode::ReadWrite);
+    ASSERT_TRUE(file.Succeeded());
+    expect_changed(false);
+    const std::array<u8, 4> data{1, 2, 3, 4};
+    ASSERT_TRUE(file->Write(data.data(), data.size()).Succeeded());
+    expect_changed(true);
+  }
+
+  ASSERT_TRUE(m_fs->ReadDirectory(Uid{0}, Gid{0}, "/tmp").Succeeded());
+  ASSERT_TRUE(m_fs->GetMetadata(Uid{0}, Gid{0}, "/tmp/f").Succeeded());
+  expect_changed(false);
+
+  ASSERT_EQ(m_fs->Delete(Uid{0}, Gid{0}, "/tmp/f"), ResultCode::Success);
+  expect_changed(true);
+}
+
 // Files need to be explicitly created using CreateFile or CreateDirectory.
 // Automatically creating them on first use would be a bug.
 TEST_F(FileSystemTest, NonExistingFiles)
@@ -138,3 +138,31 @@ TEST_F(MappingTest, ReadWriteComplex)
   EXPECT_TRUE(read_called);
   EXPECT_TRUE(write_called);
 }
+
+TEST_F(MappingTest, ReadWriteStatelessComplex)
+{
+  static u32 s_value = 0;
+
+  m_mapping->Register(0x0C001234,
+                      MMIO::ComplexRead<u16>([](Core::System&, u32 addr) { return addr >> 16; }),
+                      MMIO::ComplexWrite<u16>([](Core::System&, u32, u16 val) { s_value = val; }));
+
+  EXPECT_EQ(0x0C00, m_mapping->Read<u16>(*m_system, 0x0C001234));
+  m_mapping->Write(*m_system, 0x0C001234, (u16)0x5678);
+  EXPECT_EQ(0x5678u, s_value);
+}
+
+TEST_F(MappingTest, ReadWriteToSmaller)
+{
+  u16 high = 0x1234, low = 0x5678;
+
+  m_mapping->Register(0x0C001234, MMIO::DirectRead<u16>(&high), MMIO::DirectWrite<u16>(&high));
+  m_mapping->Register(0x0C001236, MMIO::DirectRead<u16>(&low), MMIO::DirectWrite<u16>(&low));
+  m_mapping->Register(0x0C001234, MMIO::ReadToSmaller<u32>(m_mapping.get(), 0x0C001234, 0x0C001236),
+                      MMIO::WriteToSmaller<u32>(m_mapping.get(), 0x0C001234, 0x0C001236));
+
+  EXPECT_EQ(0x12345678u, m_mapping->Read<u32>(*m_system, 0x0C001234));
+  m_mapping->Write(*m_system, 0x0C001234, 0xdeadbeefu);
+  EXPECT_EQ(0xdead, high);
+  EXPECT_EQ(0xbeef, low);
+}
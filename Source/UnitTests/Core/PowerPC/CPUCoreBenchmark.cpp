@@ -0,0 +1,387 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "Common/Assembler/GekkoAssembler.h"
+#include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
+#include "Common/FileUtil.h"
+#include "Core/ConfigManager.h"
+#include "Core/Core.h"
+#include "Core/CoreTiming.h"
+#include "Core/HW/Memmap.h"
+#include "Core/MemTools.h"
+#include "Core/PowerPC/Interpreter/Interpreter.h"
+#include "Core/PowerPC/JitCommon/JitBase.h"
+#include "Core/PowerPC/JitCommon/JitCache.h"
+#include "Core/PowerPC/JitInterface.h"
+#include "Core/PowerPC/PowerPC.h"
+#include "Core/System.h"
+#include "UICommon/UICommon.h"
+
+// include order is important
+#include <gtest/gtest.h>  // NOLINT
+
+// Throughput of the CPU cores on small synthetic kernels, and of block compilation in the JITs.
+// The numbers are only printed, so that changes to a core can be compared in isolation; what is
+// checked is that every core leaves a kernel in the same state.
+
+namespace
+{
+constexpr u32 KERNEL_ADDRESS = 0x3000;
+constexpr u32 DATA_ADDRESS = 0x10000;
+constexpr u32 DATA_SIZE = 0x1000;
+
+// Every kernel ends by spinning on "b ." once its loop is done.
+constexpr u32 IDLE_BRANCH = 0x48000000;
+
+// Kernels loop this many times, with the count passed in r31.
+constexpr u32 KERNEL_ITERATIONS = 0x40000;
+// The first run of each kernel is a warmup, and the fastest of the rest is reported.
+constexpr int KERNEL_RUNS = 5;
+
+constexpr u32 COMPILE_BLOCK_REPEATS = 32;
+constexpr int COMPILE_RUNS = 200;
+
+struct Kernel
+{
+  const char* name;
+  const char* source;
+};
+
+constexpr std::array<Kernel, 4> KERNELS = {{
+    {"Integer", "mtctr r31\n"
+                "li r3, 0\n"
+                "li r5, 1\n"
+                "loop:\n"
+                "add r3, r3, r5\n"
+                "rlwinm r6, r3, 3, 0, 28\n"
+                "xor r5, r5, r6\n"
+                "mullw r7, r3, r5\n"
+                "addi r5, r5, 7\n"
+                "subf r3, r7, r3\n"
+                "srawi r8, r3, 2\n"
+                "or r9, r8, r5\n"
+                "bdnz loop\n"
+                "end:\n"
+                "b end\n"},
+    {"Paired single", "mtctr r31\n"
+                      "lis r4, 1\n"
+                      "psq_l f1, 0(r4), 0, 0\n"
+                      "psq_l f2, 8(r4), 0, 0\n"
+                      "ps_mr f3, f2\n"
+                      "loop:\n"
+                      "ps_madd f3, f3, f1, f2\n"
+                      "ps_merge10 f4, f3, f3\n"
+                      "ps_madds0 f5, f4, f1, f2\n"
+                      "ps_sum0 f6, f5, f2, f4\n"
+                      "ps_mul f7, f6, f1\n"
+                      "psq_st f7, 16(r4), 0, 0\n"
+                      "ps_merge01 f8, f5, f7\n"
+                      "psq_l f9, 16(r4), 0, 0\n"
+                      "bdnz loop\n"
+                      "end:\n"
+                      "b end\n"},
+    {"Load/store", "mtctr r31\n"
+                   "lis r4, 1\n"
+                   "lis r5, 2\n"
+                   "li r10, 0\n"
+                   "loop:\n"
+                   "lwzx r6, r4, r10\n"
+                   "lhz r7, 4(r4)\n"
+                   "lbz r8, 6(r4)\n"
+                   "lfd f1, 8(r4)\n"
+                   "stwx r6, r5, r10\n"
+                   "sth r7, 4(r5)\n"
+                   "stb r8, 6(r5)\n"
+                   "stfd f1, 8(r5)\n"
+                   "lwz r9, 12(r5)\n"
+                   "addi r10, r10, 16\n"
+                   "andi. r10, r10, 0xff0\n"
+                   "bdnz loop\n"
+                   "end:\n"
+                   "b end\n"},
+    {"Branchy", "mtctr r31\n"
+                "li r3, 0\n"
+                "li r4, 0\n"
+                "li r5, 0\n"
+                "loop:\n"
+                "andi. r7, r3, 1\n"
+                "beq even\n"
+                "addi r4, r4, 3\n"
+                "b next\n"
+                "even:\n"
+                "rlwinm. r7, r3, 0, 28, 29\n"
+                "bne next\n"
+                "bl func\n"
+                "next:\n"
+                "addi r3, r3, 1\n"
+                "bdnz loop\n"
+                "end:\n"
+                "b end\n"
+                "func:\n"
+                "addi r5, r5, 1\n"
+                "blr\n"},
+}};
+
+// Straight-line code that is compiled but never run, ending in a blr so it forms one block.
+constexpr std::string_view COMPILE_BLOCK_BODY = "add r3, r4, r5\n"
+                                                "lwz r6, 8(r7)\n"
+                                                "rlwinm r8, r3, 4, 0, 27\n"
+                                                "stw r8, 12(r7)\n"
+                                                "ps_madd f1, f2, f3, f4\n"
+                                                "lfs f5, 16(r7)\n"
+                                                "fmuls f6, f5, f1\n"
+                                                "cmpw r3, r6\n";
+
+struct KernelState
+{
+  std::array<u32, 32> gpr;
+  std::array<u64, 64> ps;
+
+  bool operator==(const KernelState&) const = default;
+};
+
+// Runs the function on a thread of its own declared as the CPU thread, like the emulated CPU
+// normally is. The JITs protect the bottom of the stack of the thread they run on.
+void RunOnCPUThread(const std::function<void()>& function)
+{
+  std::thread thread([&function] {
+    Core::DeclareAsCPUThread();
+    EMM::InstallExceptionHandler();
+    function();
+    EMM::UninstallExceptionHandler();
+    Core::UndeclareAsCPUThread();
+  });
+  thread.join();
+}
+
+// Just enough of the system to run guest code in real mode on one CPU core.
+class CPUCoreScope final
+{
+public:
+  CPUCoreScope(Core::System& system, PowerPC::CPUCore core) : m_system(system)
+  {
+    m_system.GetCoreTiming().Init();
+    m_system.GetMemory().Init();
+    m_system.GetPowerPC().Init(core);
+  }
+  ~CPUCoreScope()
+  {
+    m_system.GetPowerPC().Shutdown();
+    m_system.GetMemory().Shutdown();
+    m_system.GetCoreTiming().Shutdown();
+  }
+
+private:
+  Core::System& m_system;
+};
+
+// Writes the assembled kernel to memory and returns the address of its final idle branch.
+std::optional<u32> LoadKernel(Core::System& system, std::string_view source)
+{
+  const auto result = Common::GekkoAssembler::Assemble(source, KERNEL_ADDRESS);
+  if (IsFailure(result))
+  {
+    ADD_FAILURE() << "Failed to assemble kernel: " << GetFailure(result).message;
+    return std::nullopt;
+  }
+
+  auto& memory = system.GetMemory();
+  std::optional<u32> end_address;
+  for (const Common::GekkoAssembler::CodeBlock& block : GetT(result))
+  {
+    memory.CopyToEmu(block.block_address, block.instructions.data(), block.instructions.size());
+    for (u32 offset = 0; offset < block.instructions.size(); offset += sizeof(u32))
+    {
+      if (!end_address && memory.Read_U32(block.block_address + offset) == IDLE_BRANCH)
+        end_address = block.block_address + offset;
+    }
+  }
+
+  // Any blocks compiled from the previous kernel are stale now.
+  system.GetJitInterface().ClearSafe();
+
+  EXPECT_TRUE(end_address.has_value()) << "Kernel doesn't end in b .";
+  return end_address;
+}
+
+void ResetState(Core::System& system)
+{
+  auto& memory = system.GetMemory();
+  // 0.5 in both slots of the first two paired singles, followed by arbitrary data.
+  for (u32 offset = 0; offset < DATA_SIZE; offset += sizeof(u32))
+    memory.Write_U32(offset < 16 ? 0x3f000000 : offset * 0x01000193, DATA_ADDRESS + offset);
+
+  auto& ppc_state = system.GetPPCState();
+  std::fill(std::begin(ppc_state.gpr), std::end(ppc_state.gpr), 0U);
+  std::fill(std::begin(ppc_state.ps), std::end(ppc_state.ps), PowerPC::PairedSingle{});
+  ppc_state.gpr[31] = KERNEL_ITERATIONS;
+  ppc_state.pc = KERNEL_ADDRESS;
+  ppc_state.npc = KERNEL_ADDRESS;
+  ppc_state.msr.FP = 1;
+  PowerPC::MSRUpdated(ppc_state);
+  HID2(ppc_state).PSE = 1;
+  HID2(ppc_state).LSQE = 1;
+}
+
+KernelState GetState(const PowerPC::PowerPCState& ppc_state)
+{
+  KernelState state;
+  std::copy(std::begin(ppc_state.gpr), std::end(ppc_state.gpr), state.gpr.begin());
+  for (size_t i = 0; i < std::size(ppc_state.ps); ++i)
+  {
+    state.ps[i * 2] = ppc_state.ps[i].PS0AsU64();
+    state.ps[i * 2 + 1] = ppc_state.ps[i].PS1AsU64();
+  }
+  return state;
+}
+
+void RunKernel(Core::System& system, PowerPC::CPUCore core, u32 end_address)
+{
+  auto& ppc_state = system.GetPPCState();
+  if (core == PowerPC::CPUCore::Interpreter)
+  {
+    // Interpreter::SingleStep starts a new timing slice for every instruction, so run its inner
+    // loop directly instead, as Interpreter::Run does.
+    auto& interpreter = system.GetInterpreter();
+    while (ppc_state.pc != end_address)
+      interpreter.SingleStepInner();
+  }
+  else
+  {
+    // The other cores run a block, or a whole timing slice for the JITs, per step.
+    auto& power_pc = system.GetPowerPC();
+    while (ppc_state.pc != end_address)
+      power_pc.SingleStep();
+  }
+}
+}  // namespace
+
+class CPUCoreBenchmark : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    m_profile_path = File::CreateTempDir();
+    ASSERT_FALSE(m_profile_path.empty());
+    UICommon::SetUserDirectory(m_profile_path);
+    Config::Init();
+    SConfig::Init();
+  }
+
+  void TearDown() override
+  {
+    if (m_profile_path.empty())
+      return;
+    SConfig::Shutdown();
+    Config::Shutdown();
+    File::DeleteDirRecursively(m_profile_path);
+  }
+
+private:
+  std::string m_profile_path;
+};
+
+TEST_F(CPUCoreBenchmark, Kernels)
+{
+  auto& system = Core::System::GetInstance();
+  std::array<std::optional<KernelState>, KERNELS.size()> expected_states;
+
+  for (const PowerPC::CPUCore core : PowerPC::AvailableCPUCores())
+  {
+    RunOnCPUThread([&] {
+      CPUCoreScope scope(system, core);
+      const std::string core_name = system.GetPowerPC().GetCPUName();
+
+      for (size_t i = 0; i < KERNELS.size(); ++i)
+      {
+        const Kernel& kernel = KERNELS[i];
+        const std::optional<u32> end_address = LoadKernel(system, kernel.source);
+        if (!end_address)
+          continue;
+
+        std::chrono::duration<double, std::nano> best_time{};
+        for (int run = 0; run < KERNEL_RUNS + 1; ++run)
+        {
+          ResetState(system);
+          const auto start = std::chrono::steady_clock::now();
+          RunKernel(system, core, *end_address);
+          const std::chrono::duration<double, std::nano> time =
+              std::chrono::steady_clock::now() - start;
+          if (run == 1 || (run > 1 && time < best_time))
+            best_time = time;
+        }
+
+        const KernelState state = GetState(system.GetPPCState());
+        if (!expected_states[i])
+          expected_states[i] = state;
+        else
+          EXPECT_TRUE(state == *expected_states[i]) << core_name << " differs on " << kernel.name;
+
+        fmt::print("{} / {}: {:.2f} ns per iteration\n", core_name, kernel.name,
+                   best_time.count() / KERNEL_ITERATIONS);
+      }
+    });
+  }
+}
+
+TEST_F(CPUCoreBenchmark, BlockCompilation)
+{
+  auto& system = Core::System::GetInstance();
+
+  std::string source;
+  for (u32 i = 0; i < COMPILE_BLOCK_REPEATS; ++i)
+    source += COMPILE_BLOCK_BODY;
+  source += "blr\n";
+
+  for (const PowerPC::CPUCore core : PowerPC::AvailableCPUCores())
+  {
+    if (core == PowerPC::CPUCore::Interpreter)
+      continue;
+
+    RunOnCPUThread([&] {
+      CPUCoreScope scope(system, core);
+      const auto result = Common::GekkoAssembler::Assemble(source, KERNEL_ADDRESS);
+      ASSERT_FALSE(IsFailure(result)) << GetFailure(result).message;
+      for (const Common::GekkoAssembler::CodeBlock& block : GetT(result))
+      {
+        system.GetMemory().CopyToEmu(block.block_address, block.instructions.data(),
+                                     block.instructions.size());
+      }
+      ResetState(system);
+
+      // Everything but the interpreter is a JitBase.
+      auto& jit = *static_cast<JitBase*>(system.GetJitInterface().GetCore());
+      auto& ppc_state = system.GetPPCState();
+      std::chrono::duration<double> total_time{};
+      u64 instructions = 0;
+      for (int run = 0; run < COMPILE_RUNS; ++run)
+      {
+        jit.ClearCache();
+        const auto start = std::chrono::steady_clock::now();
+        jit.Jit(KERNEL_ADDRESS);
+        total_time += std::chrono::steady_clock::now() - start;
+
+        const JitBlock* block =
+            jit.GetBlockCache()->GetBlockFromStartAddress(KERNEL_ADDRESS, ppc_state.feature_flags);
+        ASSERT_NE(block, nullptr);
+        instructions += block->originalSize;
+      }
+
+      fmt::print("{}: {:.2f} million instructions compiled per second\n",
+                 system.GetPowerPC().GetCPUName(), instructions / total_time.count() / 1e6);
+    });
+  }
+}
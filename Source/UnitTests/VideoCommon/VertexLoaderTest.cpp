@@ -1,9 +1,12 @@
 // Copyright 2014 Dolphin Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
 #include <bit>
+#include <chrono>
 #include <limits>
 #include <memory>
+#include <random>
 #include <tuple>
 #include <type_traits>
 #include <unordered_set>
@@ -15,6 +18,7 @@
 #include "VideoCommon/CPMemory.h"
 #include "VideoCommon/DataReader.h"
 #include "VideoCommon/OpcodeDecoding.h"
+#include "VideoCommon/VertexLoader.h"
 #include "VideoCommon/VertexLoaderBase.h"
 #include "VideoCommon/VertexLoaderManager.h"
 
@@ -541,6 +545,207 @@ TEST_F(VertexLoaderTest, DirectAllComponents)
   ExpectOut(7.0f);
 }
 
+class VertexLoaderDirectBatchTest : public VertexLoaderTest,
+                                    public ::testing::WithParamInterface<ComponentFormat>
+{
+};
+INSTANTIATE_TEST_SUITE_P(AllFormats, VertexLoaderDirectBatchTest,
+                         ::testing::Values(ComponentFormat::UByte, ComponentFormat::Byte,
+                                           ComponentFormat::UShort, ComponentFormat::Short,
+                                           ComponentFormat::Float));
+
+// The JIT loader may convert several direct vertices per iteration; make sure every vertex of a
+// longer run (including the odd tail) matches the reference loader bit for bit.
+TEST_P(VertexLoaderDirectBatchTest, MatchesReferenceLoader)
+{
+  const ComponentFormat format = GetParam();
+  m_vtx_desc.low.PosMatIdx = 1;
+  m_vtx_desc.low.Position = VertexComponentFormat::Direct;
+  m_vtx_desc.low.Normal = VertexComponentFormat::Direct;
+  m_vtx_desc.low.Color0 = VertexComponentFormat::Direct;
+  m_vtx_desc.high.Tex0Coord = VertexComponentFormat::Direct;
+  m_vtx_desc.high.Tex1Coord = VertexComponentFormat::Direct;
+  m_vtx_attr.g0.PosElements = CoordComponentCount::XYZ;
+  m_vtx_attr.g0.PosFormat = format;
+  m_vtx_attr.g0.PosFrac = 3;
+  m_vtx_attr.g0.ByteDequant = true;
+  m_vtx_attr.g0.NormalElements = NormalComponentCount::NTB;
+  m_vtx_attr.g0.NormalFormat = format;
+  m_vtx_attr.g0.Color0Comp = ColorFormat::RGBA8888;
+  m_vtx_attr.g0.Tex0CoordElements = TexComponentCount::ST;
+  m_vtx_attr.g0.Tex0CoordFormat = format;
+  m_vtx_attr.g0.Tex0Frac = 5;
+  m_vtx_attr.g1.Tex1CoordElements = TexComponentCount::S;
+  m_vtx_attr.g1.Tex1CoordFormat = format;
+  m_vtx_attr.g1.Tex1Frac = 1;
+
+  m_loader = VertexLoaderBase::CreateVertexLoader(m_vtx_desc, m_vtx_attr);
+  VertexLoader reference(m_vtx_desc, m_vtx_attr);
+  ASSERT_EQ(reference.m_vertex_size, m_loader->m_vertex_size);
+  ASSERT_EQ(reference.m_native_vtx_decl.stride, m_loader->m_native_vtx_decl.stride);
+
+  // Keep every byte below 0x40 so that no float input is a NaN or infinity.
+  constexpr int count = 61;
+  const u32 input_size = count * m_loader->m_vertex_size;
+  for (u32 i = 0; i < input_size; ++i)
+    input_memory[i] = static_cast<u8>((i * 37 + (i >> 3)) & 0x3F);
+
+  const u32 output_size = count * m_loader->m_native_vtx_decl.stride;
+  u8* const reference_output = output_memory + sizeof(output_memory) / 2;
+  ASSERT_EQ(count, reference.RunVertices(input_memory, reference_output, count));
+  ASSERT_EQ(count, m_loader->RunVertices(input_memory, output_memory, count));
+  EXPECT_EQ(0, memcmp(output_memory, reference_output, output_size));
+}
+
+#if defined(_M_X86_64)
+constexpr const char* NATIVE_LOADER_NAME = "VertexLoaderX64";
+#elif defined(_M_ARM_64)
+constexpr const char* NATIVE_LOADER_NAME = "VertexLoaderARM64";
+#else
+constexpr const char* NATIVE_LOADER_NAME = "VertexLoader";
+#endif
+
+// Compares the native loader against the reference loader on random vertex formats. Formats are
+// limited to what the reference loader supports: no invalid color or texture coordinate formats,
+// and byte dequantization always on, which the reference loader assumes.
+TEST_F(VertexLoaderTest, DifferentialFuzz)
+{
+  constexpr int configurations = 500;
+  constexpr int count = 97;
+  constexpr u32 array_stride = 37;
+  u8* const arrays = input_memory + sizeof(input_memory) / 4;
+  u8* const reference_output = output_memory + sizeof(output_memory) / 2;
+
+  std::mt19937 rng(0x5EED);
+  for (size_t i = 0; i < sizeof(input_memory) / 2; ++i)
+    input_memory[i] = static_cast<u8>(rng() & 0x3F);
+  for (int i = 0; i < NUM_VERTEX_COMPONENT_ARRAYS; i++)
+  {
+    VertexLoaderManager::cached_arraybases[static_cast<CPArray>(i)] = arrays;
+    g_main_cp_state.array_strides[static_cast<CPArray>(i)] = array_stride;
+  }
+
+  const auto valid_format = [](ComponentFormat format) {
+    return std::min(format, ComponentFormat::Float);
+  };
+
+  for (int configuration = 0; configuration < configurations; ++configuration)
+  {
+    m_vtx_desc.low.Hex = rng();
+    m_vtx_desc.high.Hex = rng();
+    if (m_vtx_desc.low.Position == VertexComponentFormat::NotPresent)
+      m_vtx_desc.low.Position = VertexComponentFormat::Direct;
+
+    m_vtx_attr.g0.Hex = rng();
+    m_vtx_attr.g1.Hex = rng();
+    m_vtx_attr.g2.Hex = rng();
+    m_vtx_attr.g0.ByteDequant = true;
+    m_vtx_attr.g0.Color0Comp = std::min(m_vtx_attr.g0.Color0Comp.Value(), ColorFormat::RGBA8888);
+    m_vtx_attr.g0.Color1Comp = std::min(m_vtx_attr.g0.Color1Comp.Value(), ColorFormat::RGBA8888);
+    m_vtx_attr.g0.Tex0CoordFormat = valid_format(m_vtx_attr.g0.Tex0CoordFormat);
+    m_vtx_attr.g1.Tex1CoordFormat = valid_format(m_vtx_attr.g1.Tex1CoordFormat);
+    m_vtx_attr.g1.Tex2CoordFormat = valid_format(m_vtx_attr.g1.Tex2CoordFormat);
+    m_vtx_attr.g1.Tex3CoordFormat = valid_format(m_vtx_attr.g1.Tex3CoordFormat);
+    m_vtx_attr.g1.Tex4CoordFormat = valid_format(m_vtx_attr.g1.Tex4CoordFormat);
+    m_vtx_attr.g2.Tex5CoordFormat = valid_format(m_vtx_attr.g2.Tex5CoordFormat);
+    m_vtx_attr.g2.Tex6CoordFormat = valid_format(m_vtx_attr.g2.Tex6CoordFormat);
+    m_vtx_attr.g2.Tex7CoordFormat = valid_format(m_vtx_attr.g2.Tex7CoordFormat);
+    SCOPED_TRACE(fmt::format("Vertex desc:\n{}\nVertex attr:\n{}", m_vtx_desc, m_vtx_attr));
+
+    m_loader = VertexLoaderBase::CreateVertexLoader(m_vtx_desc, m_vtx_attr);
+    VertexLoader reference(m_vtx_desc, m_vtx_attr);
+    ASSERT_EQ(reference.m_vertex_size, m_loader->m_vertex_size);
+    ASSERT_EQ(reference.m_native_vtx_decl.stride, m_loader->m_native_vtx_decl.stride);
+
+    // Both loaders update the caches, so they have to start from the same state.
+    const auto position_matrix_index_cache = VertexLoaderManager::position_matrix_index_cache;
+    const auto position_cache = VertexLoaderManager::position_cache;
+    const int reference_count = reference.RunVertices(input_memory, reference_output, count);
+    const auto reference_position_matrix_index_cache =
+        VertexLoaderManager::position_matrix_index_cache;
+    const auto reference_position_cache = VertexLoaderManager::position_cache;
+
+    VertexLoaderManager::position_matrix_index_cache = position_matrix_index_cache;
+    VertexLoaderManager::position_cache = position_cache;
+    ASSERT_EQ(reference_count, m_loader->RunVertices(input_memory, output_memory, count));
+    EXPECT_EQ(0, memcmp(output_memory, reference_output,
+                        reference_count * m_loader->m_native_vtx_decl.stride));
+    EXPECT_EQ(reference_position_matrix_index_cache,
+              VertexLoaderManager::position_matrix_index_cache);
+    EXPECT_EQ(reference_position_cache, VertexLoaderManager::position_cache);
+  }
+}
+
+class VertexLoaderThroughputTest
+    : public VertexLoaderTest,
+      public ::testing::WithParamInterface<
+          std::tuple<VertexComponentFormat, ComponentFormat, CoordComponentCount, bool>>
+{
+};
+INSTANTIATE_TEST_SUITE_P(
+    Formats, VertexLoaderThroughputTest,
+    ::testing::Combine(::testing::Values(VertexComponentFormat::Direct,
+                                         VertexComponentFormat::Index8,
+                                         VertexComponentFormat::Index16),
+                       ::testing::Values(ComponentFormat::UByte, ComponentFormat::Byte,
+                                         ComponentFormat::UShort, ComponentFormat::Short,
+                                         ComponentFormat::Float),
+                       ::testing::Values(CoordComponentCount::XY, CoordComponentCount::XYZ),
+                       ::testing::Bool()));
+
+// Vertices per second of the reference and native loaders, for the position format alone and
+// with the normal, color and texture coordinate a typical game vertex has added to it.
+TEST_P(VertexLoaderThroughputTest, ReferenceAndNative)
+{
+  const auto [addr, format, elements, other_attributes] = GetParam();
+  m_vtx_desc.low.Position = addr;
+  m_vtx_attr.g0.PosFormat = format;
+  m_vtx_attr.g0.PosElements = elements;
+  m_vtx_attr.g0.PosFrac = 4;
+  m_vtx_attr.g0.ByteDequant = true;
+  if (other_attributes)
+  {
+    m_vtx_desc.low.Normal = VertexComponentFormat::Index16;
+    m_vtx_desc.low.Color0 = VertexComponentFormat::Direct;
+    m_vtx_desc.high.Tex0Coord = VertexComponentFormat::Index16;
+    m_vtx_attr.g0.NormalElements = NormalComponentCount::N;
+    m_vtx_attr.g0.NormalFormat = ComponentFormat::Byte;
+    m_vtx_attr.g0.Color0Elements = ColorComponentCount::RGBA;
+    m_vtx_attr.g0.Color0Comp = ColorFormat::RGBA8888;
+    m_vtx_attr.g0.Tex0CoordElements = TexComponentCount::ST;
+    m_vtx_attr.g0.Tex0CoordFormat = ComponentFormat::Short;
+    m_vtx_attr.g0.Tex0Frac = 8;
+  }
+
+  // Keeps indices small, so that the arrays mostly stay in cache as they would for a mesh.
+  for (size_t i = 0; i < sizeof(input_memory) / 4; ++i)
+    input_memory[i] = static_cast<u8>(i & 0x3F);
+  for (int i = 0; i < NUM_VERTEX_COMPONENT_ARRAYS; i++)
+  {
+    VertexLoaderManager::cached_arraybases[static_cast<CPArray>(i)] = input_memory;
+    g_main_cp_state.array_strides[static_cast<CPArray>(i)] = 16;
+  }
+
+  m_loader = VertexLoaderBase::CreateVertexLoader(m_vtx_desc, m_vtx_attr);
+  VertexLoader reference(m_vtx_desc, m_vtx_attr);
+
+  constexpr int count = 100000;
+  constexpr int iterations = 20;
+  const auto measure = [&](VertexLoaderBase& loader) {
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i)
+      loader.RunVertices(input_memory, output_memory, count);
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return double(count) * iterations / elapsed.count() / 1e6;
+  };
+  const double reference_speed = measure(reference);
+  const double native_speed = measure(*m_loader);
+
+  fmt::print("{} {} {}{}: VertexLoader {:.1f}, {} {:.1f} million vertices/s\n", addr, format,
+             elements, other_attributes ? " with attributes" : "", reference_speed,
+             NATIVE_LOADER_NAME, native_speed);
+}
+
 class VertexLoaderNormalTest
     : public VertexLoaderTest,
       public ::testing::WithParamInterface<